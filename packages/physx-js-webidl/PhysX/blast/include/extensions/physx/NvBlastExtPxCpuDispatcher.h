@@ -0,0 +1,106 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2025 NVIDIA Corporation. All rights reserved.
+
+//! @file
+//!
+//! @brief NvBlastExtPxCpuDispatcher blast extension, runs Blast tasks on a PhysX CPU dispatcher
+
+#ifndef NVBLASTEXTPXCPUDISPATCHER_H
+#define NVBLASTEXTPXCPUDISPATCHER_H
+
+#include "NvPreprocessor.h"
+
+
+// Forward declarations
+namespace physx
+{
+class PxCpuDispatcher;
+}
+
+namespace nvidia
+{
+namespace task
+{
+class NvCpuDispatcher;
+}
+}
+
+
+namespace Nv
+{
+namespace Blast
+{
+
+/**
+Adapter exposing a physx::PxCpuDispatcher as a nvidia::task::NvCpuDispatcher.
+
+Blast tasks submitted to the adapter are forwarded to the PhysX dispatcher, so that TkGroup processing runs on the same
+worker threads as the physics step instead of a second thread pool competing for the same cores. Typical frame:
+
+    // setup
+    ExtPxCpuDispatcher* dispatcher = ExtPxCpuDispatcher::create(*pxSceneDesc.cpuDispatcher);
+    nvidia::task::NvTaskManager* taskManager = nvidia::task::NvTaskManager::createTaskManager(errorCallback, &dispatcher->getNvCpuDispatcher());
+    TkGroupTaskManager* groupTaskManager = TkGroupTaskManager::create(*taskManager, group);
+
+    // frame
+    scene->simulate(dt);
+    scene->fetchResults(true);
+    // enqueue damage for this frame on the group's actors, then process it while the workers are idle
+    groupTaskManager->process();
+    groupTaskManager->wait();
+    // split events have been dispatched, update the scene before the next simulate()
+
+Task wrappers are pooled: the pool is sized for twice the dispatcher's worker count and only grows if more tasks are in
+flight at the same time.
+*/
+class NV_DLL_EXPORT ExtPxCpuDispatcher
+{
+public:
+    /**
+    Create a new ExtPxCpuDispatcher.
+
+    \param[in]  dispatcher  The PhysX dispatcher tasks are forwarded to. Must outlive the adapter.
+
+    \return the new ExtPxCpuDispatcher.
+    */
+    static ExtPxCpuDispatcher*              create(physx::PxCpuDispatcher& dispatcher);
+
+    /**
+    Get the dispatcher to pass to nvidia::task::NvTaskManager::createTaskManager().
+    */
+    virtual nvidia::task::NvCpuDispatcher&  getNvCpuDispatcher() = 0;
+
+    /**
+    Release this adapter. Tasks must not be in flight.
+    */
+    virtual void                            release() = 0;
+};
+
+} // namespace Blast
+} // namespace Nv
+
+
+#endif // ifndef NVBLASTEXTPXCPUDISPATCHER_H
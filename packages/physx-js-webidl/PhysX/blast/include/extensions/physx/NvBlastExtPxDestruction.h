@@ -0,0 +1,284 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2025 NVIDIA Corporation. All rights reserved.
+
+//! @file
+//!
+//! @brief NvBlastExtPxDestruction blast extension, maps Blast actors to pooled PhysX rigid bodies
+
+#ifndef NVBLASTEXTPXDESTRUCTION_H
+#define NVBLASTEXTPXDESTRUCTION_H
+
+#include "NvBlastTypes.h"
+#include "NvCTypes.h"
+#include "NvPreprocessor.h"
+
+
+// Forward declarations
+namespace physx
+{
+class PxPhysics;
+class PxScene;
+class PxShape;
+class PxRigidActor;
+class PxRigidDynamic;
+struct PxContactReportRecord;
+}
+
+
+namespace Nv
+{
+namespace Blast
+{
+
+class ExtStressSolver;
+
+
+/**
+Collision shapes of a chunk.
+
+Shapes are expressed in the asset's frame (the frame of the first actor) and are shared between the actors a chunk can
+end up in, so they must be created as non-exclusive shapes.
+*/
+struct ExtPxChunkShapes
+{
+    physx::PxShape* const*  shapes;     //!<    shapes of the chunk, may be NULL if shapeCount is 0
+    uint32_t                shapeCount; //!<    number of shapes
+};
+
+
+/**
+Debris policy of ExtPxDestruction.
+
+Fragments that are smaller than volumeThreshold, or farther than distanceThreshold from every viewer when they break off,
+become debris instead of rigid bodies. Fragments bound to the world never become debris.
+*/
+struct ExtPxDebrisSettings
+{
+    float       volumeThreshold;    //!<    fragments with a smaller volume become debris, 0 disables the test
+    float       distanceThreshold;  //!<    fragments farther from every viewer become debris, 0 disables the test, see ExtPxDestruction::setViewers()
+    float       lifetime;           //!<    debris is removed after this many seconds, 0 keeps it until maxDebrisCount is reached
+    uint32_t    maxDebrisCount;     //!<    maximum number of debris particles, the oldest is removed to make room
+    float       restitution;        //!<    restitution of debris against static geometry, range [0, 1]
+    float       friction;           //!<    fraction of the tangential and angular velocity lost per bounce, range [0, 1]
+
+    ExtPxDebrisSettings() :
+        volumeThreshold(0.0f), distanceThreshold(0.0f), lifetime(10.0f), maxDebrisCount(1024), restitution(0.3f), friction(0.5f)
+    {
+    }
+};
+
+
+/**
+Debris particle, as written by ExtPxDestruction::getDebris().
+*/
+struct ExtPxDebris
+{
+    NvcTransform    pose;           //!<    world pose of the fragment, in the frame of the asset like the pose of a PhysX actor of the bridge
+    float           radius;         //!<    radius of the sphere simulating the fragment
+    uint32_t        actorIndex;     //!<    index of the Blast actor of the fragment, see NvBlastFamilyGetActorByIndex()
+};
+
+
+/**
+ExtPxDestruction descriptor.
+*/
+struct ExtPxDestructionDesc
+{
+    physx::PxPhysics*               physics;            //!<    PhysX SDK used to create the fragment actors
+    physx::PxScene*                 scene;              //!<    scene the fragment actors are added to
+    NvBlastFamily*                  family;             //!<    family to simulate, its first actor must already be created
+    const ExtPxChunkShapes*         chunkShapes;        //!<    shapes of every chunk, NvBlastAssetGetChunkCount() entries
+    NvcTransform                    pose;               //!<    world pose of the first actor
+    float                           density;            //!<    density used to compute fragment masses
+    uint32_t                        pooledActorCount;   //!<    number of actors created up front for fragments made of several chunks
+    uint32_t                        userIndexBase;      //!<    user index of the first PhysX actor, see ExtPxDestruction::addContactReports()
+    ExtStressSolver*                stressSolver;       //!<    optional stress solver of the family, see ExtPxDestruction::updateStress(). Not owned.
+    ExtPxDebrisSettings             debris;             //!<    debris policy, disabled by default
+
+    ExtPxDestructionDesc() :
+        physics(nullptr), scene(nullptr), family(nullptr), chunkShapes(nullptr), density(1.0f), pooledActorCount(16),
+        userIndexBase(0), stressSolver(nullptr)
+    {
+        pose.q = { 0.0f, 0.0f, 0.0f, 1.0f };
+        pose.p = { 0.0f, 0.0f, 0.0f };
+    }
+};
+
+
+/**
+Destruction bridge between a Blast family and a PhysX scene.
+
+Every Blast actor of the family is represented by a PxRigidDynamic in the scene. Actors with external bonds (bonds to the
+world) are kinematic, the others are dynamic.
+
+All the PhysX actors a fracture can need are created by create(), outside of the simulation loop:
+- one actor per chunk with shapes, with that chunk's shapes attached and its mass computed. It represents the Blast actor
+  when the chunk is the only visible chunk, which is the case for most fragments of a large fracture.
+- pooledActorCount actors without shapes, used for fragments made of several chunks. The shared chunk shapes are attached
+  to them when they are taken from the pool and detached when they are returned.
+
+Fracture and split buffers are also sized once for the whole family. Applying damage thus does not allocate Blast
+memory, and the actors of a split are swapped in the scene with one PxScene::removeActors() and one PxScene::addActors()
+call. Fragments inherit the pose and velocity of the actor they come from.
+
+If the pool of multi-chunk actors runs out, additional actors are created and a warning is logged: size
+pooledActorCount for the largest expected fracture.
+
+Each PhysX actor gets a user index in its userData, starting at userIndexBase, so that it can be identified in the flat
+buffers of PxSceneExt. With a stress solver, the impulses of the contact reports are accumulated per support graph node
+and fed to the solver by updateStress(), which also breaks the overstressed bonds. The bridge notifies the solver of the
+actors it creates and destroys; the node masses must be set by the caller, e.g. with setAllNodesInfoFromLL().
+
+With a debris policy, the fragments it selects are not given a PhysX actor. They are simulated by updateDebris() as
+spheres that bounce on the static geometry of the scene and never touch each other, which bounds the number of rigid
+bodies after a large fracture. Debris cannot be fractured further.
+*/
+class NV_DLL_EXPORT ExtPxDestruction
+{
+public:
+    /**
+    Create a new ExtPxDestruction and add the actors of the family to the scene.
+
+    \param[in]  desc    The descriptor.
+
+    \return the new ExtPxDestruction if successful, NULL otherwise.
+    */
+    static ExtPxDestruction*                create(const ExtPxDestructionDesc& desc);
+
+    /**
+    Release this bridge. The PhysX actors it created are removed from the scene and released, the family is not.
+    */
+    virtual void                            release() = 0;
+
+    /**
+    Apply fracture commands to an actor of the family, then split it and update the scene.
+
+    \param[in]  actor       The actor to fracture.
+    \param[in]  commands    The fracture commands, e.g. generated by a damage program or a stress solver.
+
+    \return the number of actors the actor was split into, 0 if it did not split.
+    */
+    virtual uint32_t                        applyFracture(NvBlastActor& actor, const NvBlastFractureBuffers& commands) = 0;
+
+    /**
+    Generate fracture commands with a damage program, apply them to an actor of the family, then split it and update the scene.
+
+    \param[in]  actor           The actor to damage.
+    \param[in]  program         The damage program, e.g. from NvBlastExtDamageShaders.
+    \param[in]  programParams   Parameters of the damage program.
+
+    \return the number of actors the actor was split into, 0 if it did not split.
+    */
+    virtual uint32_t                        applyDamage(NvBlastActor& actor, const NvBlastDamageProgram& program, const void* programParams) = 0;
+
+    /**
+    Get the PhysX actor of a Blast actor.
+
+    \param[in]  actor   The Blast actor.
+
+    \return the PhysX actor, NULL if the Blast actor is not part of the family.
+    */
+    virtual physx::PxRigidDynamic*          getPxActor(const NvBlastActor& actor) const = 0;
+
+    /**
+    Get the Blast actor of a PhysX actor, e.g. one reported by a contact or a scene query.
+
+    \param[in]  actor   The PhysX actor.
+
+    \return the Blast actor, NULL if the PhysX actor is not used by this bridge.
+    */
+    virtual NvBlastActor*                   getBlastActor(const physx::PxRigidActor& actor) const = 0;
+
+    /**
+    Get the number of multi-chunk actors created on demand because the pool was empty.
+    */
+    virtual uint32_t                        getPoolOverflowCount() const = 0;
+
+    /**
+    Accumulate the contact impulses of the last simulation step on the support graph nodes of the family.
+
+    Each impulse is applied to the graph node closest to the contact point, in the actors of the pair that belong to
+    this bridge. Records of other actors are ignored. Does nothing without a stress solver.
+
+    \param[in]  records         Contact reports, as written by PxSceneExt::getContactReports(). Impulses must be reported.
+    \param[in]  recordCount     Number of records.
+    */
+    virtual void                            addContactReports(const physx::PxContactReportRecord* records, uint32_t recordCount) = 0;
+
+    /**
+    Step the stress solver, then fracture the overstressed bonds and update the scene.
+
+    The accumulated contact impulses are applied as forces over 'dt', and gravity is applied to the actors bound to the world.
+    When 'timeBudget' is positive the solver iteration count is derived from the measured cost of previous iterations,
+    capped by the stress solver's maxSolverIterationsPerFrame at the time the bridge was created. The solver is warm
+    started, so on large structures the solution converges over several frames instead of stalling one.
+
+    \param[in]  dt          Duration of the simulation step the contact reports were collected over, in seconds.
+    \param[in]  timeBudget  Time the solver may spend in this call, in seconds. 0 always runs the capped iteration count.
+
+    \return the number of actors created by the fractures.
+    */
+    virtual uint32_t                        updateStress(float dt, float timeBudget = 0.0f) = 0;
+
+    /**
+    Set the positions the distance test of the debris policy is measured from, e.g. the players' cameras.
+
+    \param[in]  positions   World positions, copied.
+    \param[in]  count       Number of positions.
+    */
+    virtual void                            setViewers(const NvcVec3* positions, uint32_t count) = 0;
+
+    /**
+    Advance the debris particles and remove the expired ones. Call it once per simulation step, outside of
+    PxScene::simulate() and PxScene::fetchResults().
+
+    Each particle is moved under the scene's gravity and raycast against the static actors of the scene.
+
+    \param[in]  dt  Duration of the step, in seconds.
+    */
+    virtual void                            updateDebris(float dt) = 0;
+
+    /**
+    Get the number of debris particles.
+    */
+    virtual uint32_t                        getDebrisCount() const = 0;
+
+    /**
+    Write the debris particles to a buffer.
+
+    \param[out] buffer      Destination buffer.
+    \param[in]  bufferSize  Number of entries in the buffer.
+
+    \return the number of entries written.
+    */
+    virtual uint32_t                        getDebris(ExtPxDebris* buffer, uint32_t bufferSize) const = 0;
+};
+
+} // namespace Blast
+} // namespace Nv
+
+
+#endif // ifndef NVBLASTEXTPXDESTRUCTION_H
@@ -0,0 +1,130 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2025 NVIDIA Corporation. All rights reserved.
+
+//! @file
+//!
+//! @brief Defines the in-place raw asset format of the NvBlastExtSerialization blast extension
+
+#pragma once
+
+
+#include "NvBlastGlobals.h"
+
+
+// Forward declarations
+struct NvBlastAsset;
+
+
+/**
+Raw asset format.
+
+A raw asset buffer holds an NvBlastAsset and per-chunk payloads, typically the cooked convex mesh streams of the chunks.
+Unlike the Cap'n Proto and RAW serializers of ExtSerialization, which deserialize into new allocations, a raw asset
+buffer is used in place: NvBlastExtRawAssetGetAsset() returns a pointer into the buffer that can be passed to
+NvBlastAssetCreateFamily() directly, for as many families as needed, and the payloads are read where they are.
+
+Layout, all offsets being relative to the start of the buffer and every section aligned to 16 bytes:
+- header
+- the NvBlastAsset
+- the payload partition: chunkCount + 1 uint32_t, the payloads of chunk i are [partition[i], partition[i + 1])
+- the payload table: one { offset, size } pair of uint32_t per payload
+- the payload data
+
+The buffer must be 16-byte aligned and must outlive the families created from it. The format has the byte order and
+layout of the platform that wrote it, like the RAW encoding of ExtSerialization.
+*/
+
+/**
+Payload of a chunk, e.g. a cooked convex mesh stream.
+*/
+struct NvBlastExtRawAssetPayload
+{
+    const void* data;   //!<    payload data
+    uint32_t    size;   //!<    payload size in bytes
+};
+
+/**
+Payloads of a chunk.
+*/
+struct NvBlastExtRawAssetChunkPayloads
+{
+    const NvBlastExtRawAssetPayload*    payloads;       //!<    payloads of the chunk, may be NULL if payloadCount is 0
+    uint32_t                            payloadCount;   //!<    number of payloads
+};
+
+
+/**
+Compute the size of the raw asset buffer for an asset and its chunk payloads.
+
+\param[in]  asset           The asset.
+\param[in]  chunkPayloads   Payloads of every chunk, NvBlastAssetGetChunkCount() entries. May be NULL if there are no payloads.
+
+\return the buffer size in bytes, 0 if the input is invalid.
+*/
+NV_C_API uint64_t NvBlastExtRawAssetGetSize(const NvBlastAsset* asset, const NvBlastExtRawAssetChunkPayloads* chunkPayloads);
+
+/**
+Write an asset and its chunk payloads into a raw asset buffer.
+
+\param[out] buffer          16-byte aligned buffer of at least NvBlastExtRawAssetGetSize() bytes.
+\param[in]  bufferSize      Size of the buffer.
+\param[in]  asset           The asset.
+\param[in]  chunkPayloads   Payloads of every chunk, NvBlastAssetGetChunkCount() entries. May be NULL if there are no payloads.
+
+\return the number of bytes written, 0 if unsuccessful.
+*/
+NV_C_API uint64_t NvBlastExtRawAssetWrite(void* buffer, uint64_t bufferSize, const NvBlastAsset* asset, const NvBlastExtRawAssetChunkPayloads* chunkPayloads);
+
+/**
+Validate a raw asset buffer and get the asset it contains. No memory is allocated and nothing is copied.
+
+\param[in]  buffer      16-byte aligned raw asset buffer, e.g. a loaded file.
+\param[in]  bufferSize  Size of the buffer.
+
+\return the asset, pointing into the buffer, NULL if the buffer is not a valid raw asset.
+*/
+NV_C_API const NvBlastAsset* NvBlastExtRawAssetGetAsset(const void* buffer, uint64_t bufferSize);
+
+/**
+Get the number of payloads of a chunk in a raw asset buffer validated by NvBlastExtRawAssetGetAsset().
+
+\param[in]  buffer      The raw asset buffer.
+\param[in]  chunkIndex  The chunk index.
+
+\return the number of payloads of the chunk, 0 if the chunk index is out of range.
+*/
+NV_C_API uint32_t NvBlastExtRawAssetGetChunkPayloadCount(const void* buffer, uint32_t chunkIndex);
+
+/**
+Get a payload of a chunk in a raw asset buffer validated by NvBlastExtRawAssetGetAsset().
+
+\param[in]  buffer          The raw asset buffer.
+\param[in]  chunkIndex      The chunk index.
+\param[in]  payloadIndex    The payload index, in [0, NvBlastExtRawAssetGetChunkPayloadCount(buffer, chunkIndex)).
+
+\return the payload, pointing into the buffer. Its data is NULL if the indices are out of range.
+*/
+NV_C_API NvBlastExtRawAssetPayload NvBlastExtRawAssetGetChunkPayload(const void* buffer, uint32_t chunkIndex, uint32_t payloadIndex);
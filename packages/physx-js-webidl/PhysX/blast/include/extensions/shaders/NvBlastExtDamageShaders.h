@@ -71,15 +71,19 @@ The idea of this 'hint' is that damage parameters are basically 2 entities: mate
 
 Also this damage program hints that there could be more than one damage event happening and processed per one shader call (for efficiency reasons).
 So different damage descriptions can be stacked and passed in one shader call (while material is kept the same obviously).
+The radial falloff, cutter and capsule shaders sum the damage of all 'damageDescCount' descriptions per bond/chunk and,
+with an accelerator, find the candidate bonds in one traversal over the union of their bounds. The other shaders only
+use the first description.
 */
 struct NvBlastExtProgramParams
 {
-    NvBlastExtProgramParams(const void* desc, const void* material_ = nullptr, NvBlastExtDamageAccelerator* accelerator_ = nullptr)
-        : damageDesc(desc), material(material_), accelerator(accelerator_) {}
+    NvBlastExtProgramParams(const void* desc, const void* material_ = nullptr, NvBlastExtDamageAccelerator* accelerator_ = nullptr, uint32_t descCount = 1)
+        : damageDesc(desc), material(material_), accelerator(accelerator_), damageDescCount(descCount) {}
 
     const void* damageDesc;         //!<    array of damage descriptions
     const void* material;           //!<    pointer to material
     NvBlastExtDamageAccelerator*    accelerator;
+    uint32_t    damageDescCount;    //!<    number of damage descriptions in damageDesc
 };
 
 
@@ -74,6 +74,7 @@ end)
 local hostDepsDir = "_build/host-deps"
 local targetDepsDir = "_build/target-deps"
 local capnp_gen_path = "source/sdk/extensions/serialization/generated"
+local physx_root = "../physx"
 
 local workspace_name = "blast-sdk"
 
@@ -481,6 +482,30 @@ group "sdk"
                 }
         filter {}
 
+    project "NvBlastExtPhysX"
+        link_dependents({"NvBlast", "NvBlastGlobals"})
+        blast_sdklib_standard_setup("extensions/physx")
+        includedirs {
+            "include/lowlevel",
+            "include/globals",
+            "include/shared/NvFoundation",
+            "source/shared/NsFoundation/include",
+            "source/shared/NvTask/include",
+            "include/extensions/stress",
+            physx_root.."/include",
+        }
+        -- PhysX SDK from the sibling physx directory, built with the same configuration name
+        filter { "system:windows" }
+            libdirs { physx_root.."/bin/win.x86_64.vc143.md/%{cfg.buildcfg}" }
+            links { "PhysX_64", "PhysXCommon_64", "PhysXFoundation_64", "PhysXExtensions_static_64" }
+        filter { "system:linux", "platforms:x86_64" }
+            libdirs { physx_root.."/bin/linux.x86_64/%{cfg.buildcfg}" }
+        filter { "system:linux", "platforms:aarch64" }
+            libdirs { physx_root.."/bin/linux.aarch64/%{cfg.buildcfg}" }
+        filter { "system:linux" }
+            links { "PhysXExtensions_static_64", "PhysX_static_64", "PhysXPvdSDK_static_64", "PhysXCommon_static_64", "PhysXFoundation_static_64" }
+        filter {}
+
     project "NvBlastExtSerialization"
         filter { "system:linux"}
             rules { "c++" }
@@ -505,6 +530,7 @@ group "sdk"
             {
                 "NvBlastExtSerialization.cpp",
                 "NvBlastExtLlSerialization.cpp",
+                "NvBlastExtRawAsset.cpp",
                 "NvBlastExtOutputStream.cpp",
                 "NvBlastExtInputStream.cpp",
             }
@@ -588,7 +614,7 @@ group "tests"
     project "UnitTests"
         kind "ConsoleApp"
         location (workspaceDir.."/%{prj.name}")
-        link_dependents({"NvBlast", "NvBlastGlobals", "NvBlastExtAssetUtils", "NvBlastExtShaders", "NvBlastTk", "NvBlastExtSerialization", "NvBlastExtTkSerialization"})
+        link_dependents({"NvBlast", "NvBlastGlobals", "NvBlastExtAssetUtils", "NvBlastExtShaders", "NvBlastTk", "NvBlastExtSerialization", "NvBlastExtTkSerialization", "NvBlastExtStress", "NvBlastExtPhysX"})
 
         filter { "system:windows" }
             -- defines { "ISOLATION_AWARE_ENABLED=1" }
@@ -604,8 +630,13 @@ group "tests"
             "ActorTests.cpp",
             "APITests.cpp",
             "CoreTests.cpp",
+            "DamageShaderTests.cpp",
             "FamilyGraphTests.cpp",
             "MultithreadingTests.cpp",
+            "PxCpuDispatcherTests.cpp",
+            "PxDestructionTests.cpp",
+            "PxRaycastCCDTests.cpp",
+            "RawAssetTests.cpp",
             "TkCompositeTests.cpp",
             "TkTests.cpp",
         })
@@ -637,10 +668,13 @@ group "tests"
             "include/extensions/assetutils",
             "include/extensions/shaders",
             "include/extensions/serialization",
+            "include/extensions/physx",
+            "include/extensions/stress",
             "source/sdk/common",
             "source/sdk/globals",
             "source/sdk/lowlevel",
             "source/sdk/extensions/serialization",
+            "source/sdk/extensions/shaders",
             "source/test/src",
             "source/test/src/unit",
             "source/test/src/utils",
@@ -650,9 +684,22 @@ group "tests"
             "source/shared/NsFoundation/include",
             "source/shared/NsFileBuffer/include",
             "source/shared/NvTask/include",
+            physx_root.."/include",
             target_deps.."/googletest/include",
         }
 
+        -- PhysX SDK for the ExtPhysX tests, see NvBlastExtPhysX
+        filter { "system:windows" }
+            libdirs { physx_root.."/bin/win.x86_64.vc143.md/%{cfg.buildcfg}" }
+            links { "PhysX_64", "PhysXCommon_64", "PhysXFoundation_64", "PhysXExtensions_static_64" }
+        filter { "system:linux", "platforms:x86_64" }
+            libdirs { physx_root.."/bin/linux.x86_64/%{cfg.buildcfg}" }
+        filter { "system:linux", "platforms:aarch64" }
+            libdirs { physx_root.."/bin/linux.aarch64/%{cfg.buildcfg}" }
+        filter { "system:linux" }
+            links { "PhysXExtensions_static_64", "PhysX_static_64", "PhysXPvdSDK_static_64", "PhysXCommon_static_64", "PhysXFoundation_static_64" }
+        filter {}
+
     filter { "system:windows", "configurations:debug" }
         libdirs { target_deps.."/googletest/lib/vc14win64-cmake/Debug" }
     filter { "system:windows", "configurations:release" }
@@ -0,0 +1,206 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2025 NVIDIA Corporation. All rights reserved.
+
+
+#include "NvBlastExtPxCpuDispatcher.h"
+#include "NvBlastGlobals.h"
+#include "NvBlastArray.h"
+#include "NvBlastAssert.h"
+
+#include "NvTask.h"
+#include "NvCpuDispatcher.h"
+
+#include "task/PxCpuDispatcher.h"
+#include "task/PxTask.h"
+
+#include <mutex>
+
+
+namespace Nv
+{
+namespace Blast
+{
+
+class ExtPxCpuDispatcherImpl;
+
+
+/**
+PhysX task running a Blast task. Returned to the adapter's pool when the PhysX dispatcher releases it.
+*/
+class ExtPxTaskWrapper final : public physx::PxBaseTask
+{
+public:
+    ExtPxTaskWrapper(ExtPxCpuDispatcherImpl& owner) : m_owner(owner), m_task(nullptr) {}
+
+    void                    setTask(nvidia::task::NvBaseTask& task)
+    {
+        m_task = &task;
+    }
+
+    virtual void            run() override
+    {
+        m_task->run();
+    }
+
+    virtual const char*     getName() const override
+    {
+        return m_task->getName();
+    }
+
+    virtual void            addReference() override
+    {
+        m_task->addReference();
+    }
+
+    virtual void            removeReference() override
+    {
+        m_task->removeReference();
+    }
+
+    virtual int32_t         getReference() const override
+    {
+        return m_task->getReference();
+    }
+
+    virtual void            release() override;
+
+private:
+    ExtPxCpuDispatcherImpl&     m_owner;
+    nvidia::task::NvBaseTask*   m_task;
+};
+
+
+class ExtPxCpuDispatcherImpl final : public ExtPxCpuDispatcher, public nvidia::task::NvCpuDispatcher
+{
+    NV_NOCOPY(ExtPxCpuDispatcherImpl)
+
+public:
+    ExtPxCpuDispatcherImpl(physx::PxCpuDispatcher& dispatcher);
+    ~ExtPxCpuDispatcherImpl();
+
+    //////// ExtPxCpuDispatcher interface ////////
+
+    virtual nvidia::task::NvCpuDispatcher&  getNvCpuDispatcher() override
+    {
+        return *this;
+    }
+
+    virtual void                            release() override;
+
+    //////// NvCpuDispatcher interface ////////
+
+    virtual void                            submitTask(nvidia::task::NvBaseTask& task) override;
+
+    virtual uint32_t                        getWorkerCount() const override
+    {
+        return m_dispatcher.getWorkerCount();
+    }
+
+    //////// internal ////////
+
+    void                                    recycle(ExtPxTaskWrapper& wrapper);
+
+private:
+    physx::PxCpuDispatcher&             m_dispatcher;
+    std::mutex                          m_mutex;
+    Array<ExtPxTaskWrapper*>::type      m_wrappers;     // all wrappers, for release
+    Array<ExtPxTaskWrapper*>::type      m_freeWrappers;
+};
+
+
+void ExtPxTaskWrapper::release()
+{
+    // recycle first: releasing the Blast task can complete the group and let the caller release the adapter
+    nvidia::task::NvBaseTask* task = m_task;
+    m_task = nullptr;
+    m_owner.recycle(*this);
+    task->release();
+}
+
+
+ExtPxCpuDispatcherImpl::ExtPxCpuDispatcherImpl(physx::PxCpuDispatcher& dispatcher) : m_dispatcher(dispatcher)
+{
+    const uint32_t wrapperCount = 2 * (dispatcher.getWorkerCount() > 0 ? dispatcher.getWorkerCount() : 1);
+    m_wrappers.reserve(wrapperCount);
+    m_freeWrappers.reserve(wrapperCount);
+    for (uint32_t i = 0; i < wrapperCount; ++i)
+    {
+        ExtPxTaskWrapper* wrapper = NVBLAST_NEW(ExtPxTaskWrapper) (*this);
+        m_wrappers.pushBack(wrapper);
+        m_freeWrappers.pushBack(wrapper);
+    }
+}
+
+
+ExtPxCpuDispatcherImpl::~ExtPxCpuDispatcherImpl()
+{
+    NVBLAST_ASSERT(m_freeWrappers.size() == m_wrappers.size());
+    for (uint32_t i = 0; i < m_wrappers.size(); ++i)
+        NVBLAST_DELETE(m_wrappers[i], ExtPxTaskWrapper);
+}
+
+
+ExtPxCpuDispatcher* ExtPxCpuDispatcher::create(physx::PxCpuDispatcher& dispatcher)
+{
+    return NVBLAST_NEW(ExtPxCpuDispatcherImpl) (dispatcher);
+}
+
+
+void ExtPxCpuDispatcherImpl::release()
+{
+    NVBLAST_DELETE(this, ExtPxCpuDispatcherImpl);
+}
+
+
+void ExtPxCpuDispatcherImpl::submitTask(nvidia::task::NvBaseTask& task)
+{
+    ExtPxTaskWrapper* wrapper;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_freeWrappers.size())
+        {
+            wrapper = m_freeWrappers.popBack();
+        }
+        else
+        {
+            wrapper = NVBLAST_NEW(ExtPxTaskWrapper) (*this);
+            m_wrappers.pushBack(wrapper);
+        }
+    }
+
+    wrapper->setTask(task);
+    m_dispatcher.submitTask(*wrapper);
+}
+
+
+void ExtPxCpuDispatcherImpl::recycle(ExtPxTaskWrapper& wrapper)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_freeWrappers.pushBack(&wrapper);
+}
+
+} // namespace Blast
+} // namespace Nv
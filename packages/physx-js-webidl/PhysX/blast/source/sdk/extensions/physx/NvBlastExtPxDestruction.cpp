@@ -0,0 +1,808 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2025 NVIDIA Corporation. All rights reserved.
+
+
+#include "NvBlastExtPxDestruction.h"
+#include "NvBlastExtStressSolver.h"
+#include "NvBlast.h"
+#include "NvBlastGlobals.h"
+#include "NvBlastArray.h"
+#include "NvBlastHashMap.h"
+#include "NvBlastAssert.h"
+#include "NvBlastIndexFns.h"
+#include "NvBlastTime.h"
+
+#include "PxPhysics.h"
+#include "PxScene.h"
+#include "PxQueryReport.h"
+#include "PxShape.h"
+#include "PxRigidDynamic.h"
+#include "extensions/PxRigidBodyExt.h"
+#include "extensions/PxSceneExt.h"
+
+
+namespace Nv
+{
+namespace Blast
+{
+
+using namespace physx;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                           ExtPxDestruction
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ExtPxDestructionImpl final : public ExtPxDestruction
+{
+    NV_NOCOPY(ExtPxDestructionImpl)
+
+public:
+    ExtPxDestructionImpl(const ExtPxDestructionDesc& desc);
+    ~ExtPxDestructionImpl();
+
+    virtual void                            release() override;
+
+    virtual uint32_t                        applyFracture(NvBlastActor& actor, const NvBlastFractureBuffers& commands) override;
+
+    virtual uint32_t                        applyDamage(NvBlastActor& actor, const NvBlastDamageProgram& program, const void* programParams) override;
+
+    virtual PxRigidDynamic*                 getPxActor(const NvBlastActor& actor) const override;
+
+    virtual NvBlastActor*                   getBlastActor(const PxRigidActor& actor) const override;
+
+    virtual uint32_t                        getPoolOverflowCount() const override
+    {
+        return m_poolOverflowCount;
+    }
+
+    virtual void                            addContactReports(const PxContactReportRecord* records, uint32_t recordCount) override;
+
+    virtual uint32_t                        updateStress(float dt, float timeBudget) override;
+
+    virtual void                            setViewers(const NvcVec3* positions, uint32_t count) override;
+
+    virtual void                            updateDebris(float dt) override;
+
+    virtual uint32_t                        getDebrisCount() const override
+    {
+        return m_debris.size();
+    }
+
+    virtual uint32_t                        getDebris(ExtPxDebris* buffer, uint32_t bufferSize) const override;
+
+    bool                                    valid() const
+    {
+        return m_valid;
+    }
+
+private:
+    struct PxActorInfo
+    {
+        uint32_t    blastActorIndex;    //!<    index of the Blast actor using the PhysX actor, invalidIndex<uint32_t>() when unused
+        bool        pooled;             //!<    true for multi-chunk actors, whose shapes are attached on demand
+    };
+
+    struct DebrisParticle
+    {
+        PxVec3      position;           //!<    world position of the fragment's center
+        PxQuat      rotation;
+        PxVec3      linearVelocity;
+        PxVec3      angularVelocity;
+        PxVec3      localCenter;        //!<    center of the fragment in the asset frame
+        float       radius;
+        float       age;
+        uint32_t    blastActorIndex;
+        bool        sleeping;
+    };
+
+    PxRigidDynamic*                         createPxActor(bool pooled);
+    PxRigidDynamic*                         acquirePxActor(const NvBlastActor& actor);
+    void                                    releasePxActor(PxRigidDynamic& pxActor);
+    uint32_t                                split(NvBlastActor& actor);
+    void                                    addContactImpulse(uint32_t userIndex, const PxVec3& point, const PxVec3& impulse);
+    bool                                    createDebris(const NvBlastActor& actor, const PxTransform& pose, const PxVec3& linearVelocity,
+                                                         const PxVec3& angularVelocity, const PxVec3& parentCenter);
+
+    PxPhysics&                                          m_physics;
+    PxScene&                                            m_scene;
+    NvBlastFamily&                                      m_family;
+    float                                               m_density;
+    bool                                                m_valid;
+    uint32_t                                            m_poolOverflowCount;
+    uint32_t                                            m_userIndexBase;
+
+    // chunk shapes, flattened: the shapes of chunk i are m_shapes[m_shapeOffsets[i] .. m_shapeOffsets[i+1]]
+    Array<PxShape*>::type                               m_shapes;
+    Array<uint32_t>::type                               m_shapeOffsets;
+
+    Array<PxRigidDynamic*>::type                        m_chunkPxActors;    // pre-shaped actor of each chunk, NULL for chunks without shapes
+    Array<PxRigidDynamic*>::type                        m_pooledPxActors;   // all multi-chunk actors
+    Array<PxRigidDynamic*>::type                        m_freePxActors;     // multi-chunk actors not in use
+    Array<PxRigidDynamic*>::type                        m_blastToPx;        // Blast actor index -> PhysX actor
+    HashMap<const PxRigidActor*, PxActorInfo>::type     m_pxToBlast;        // PhysX actor -> Blast actor index
+    Array<PxRigidDynamic*>::type                        m_userIndexToPx;    // user index - m_userIndexBase -> PhysX actor
+
+    // buffers sized for the whole family, so that fracturing does not allocate
+    Array<NvBlastActor*>::type                          m_newActors;
+    Array<char>::type                                   m_splitScratch;
+    Array<uint32_t>::type                               m_visibleChunks;
+    Array<NvBlastChunkFractureData>::type               m_chunkFractures;
+    Array<NvBlastBondFractureData>::type                m_bondFractures;
+    Array<PxActor*>::type                               m_addedPxActors;
+    Array<PxActor*>::type                               m_removedPxActors;
+
+    // stress, impulses are accumulated per support graph node until the next updateStress()
+    ExtStressSolver*                                    m_stressSolver;
+    uint32_t                                            m_maxStressIterations;  // iteration cap, the solver's setting when the bridge was created
+    double                                              m_secondsPerStressIteration;
+    Array<PxVec3>::type                                 m_nodePositions;    // support chunk centroids, in the asset frame
+    Array<PxVec3>::type                                 m_nodeImpulses;     // accumulated impulses, in the asset frame
+    Array<uint32_t>::type                               m_impulseNodes;     // nodes with a non-zero accumulated impulse
+    Array<uint32_t>::type                               m_graphNodes;
+    Array<NvBlastActor*>::type                          m_familyActors;
+    Array<const NvBlastActor*>::type                    m_stressActors;
+    Array<NvBlastFractureBuffers>::type                 m_stressCommands;
+
+    // debris, fragments simulated as spheres instead of PhysX actors
+    ExtPxDebrisSettings                                 m_debrisSettings;
+    const NvBlastChunk*                                 m_chunks;
+    Array<DebrisParticle>::type                         m_debris;
+    Array<PxVec3>::type                                 m_viewers;
+};
+
+
+ExtPxDestructionImpl::ExtPxDestructionImpl(const ExtPxDestructionDesc& desc)
+    : m_physics(*desc.physics), m_scene(*desc.scene), m_family(*desc.family), m_density(desc.density), m_valid(false),
+    m_poolOverflowCount(0), m_userIndexBase(desc.userIndexBase), m_stressSolver(desc.stressSolver), m_maxStressIterations(0),
+    m_secondsPerStressIteration(0.0), m_debrisSettings(desc.debris), m_chunks(nullptr)
+{
+    const NvBlastAsset* asset = NvBlastFamilyGetAsset(&m_family, logLL);
+    if (!asset)
+    {
+        NVBLAST_LOG_ERROR("ExtPxDestructionImpl::ExtPxDestructionImpl: family has NULL asset");
+        return;
+    }
+
+    const uint32_t chunkCount = NvBlastAssetGetChunkCount(asset, logLL);
+    m_chunks = NvBlastAssetGetChunks(asset, logLL);
+    const uint32_t bondCount = NvBlastAssetGetBondCount(asset, logLL);
+    const uint32_t maxActorCount = NvBlastFamilyGetMaxActorCount(&m_family, logLL);
+
+    // copy and reference the chunk shapes, multi-chunk actors attach them after the descriptor is gone
+    m_shapeOffsets.resize(chunkCount + 1);
+    for (uint32_t i = 0; i < chunkCount; ++i)
+    {
+        m_shapeOffsets[i] = m_shapes.size();
+        for (uint32_t j = 0; j < desc.chunkShapes[i].shapeCount; ++j)
+        {
+            PxShape* shape = desc.chunkShapes[i].shapes[j];
+            if (shape->isExclusive())
+            {
+                NVBLAST_LOG_ERROR("ExtPxDestructionImpl::ExtPxDestructionImpl: chunk shapes must not be exclusive");
+                return;
+            }
+            shape->acquireReference();
+            m_shapes.pushBack(shape);
+        }
+    }
+    m_shapeOffsets[chunkCount] = m_shapes.size();
+
+    const uint32_t pxActorCount = chunkCount + desc.pooledActorCount;
+    m_pxToBlast.reserve(pxActorCount);
+    m_userIndexToPx.reserve(pxActorCount);
+
+    // pre-shaped single-chunk actors
+    m_chunkPxActors.resize(chunkCount, nullptr);
+    for (uint32_t i = 0; i < chunkCount; ++i)
+    {
+        if (m_shapeOffsets[i] == m_shapeOffsets[i + 1])
+            continue;
+
+        PxRigidDynamic* pxActor = createPxActor(false);
+        for (uint32_t j = m_shapeOffsets[i]; j < m_shapeOffsets[i + 1]; ++j)
+            pxActor->attachShape(*m_shapes[j]);
+        PxRigidBodyExt::updateMassAndInertia(*pxActor, m_density);
+        m_chunkPxActors[i] = pxActor;
+    }
+
+    // multi-chunk actors
+    m_pooledPxActors.reserve(desc.pooledActorCount);
+    m_freePxActors.reserve(desc.pooledActorCount);
+    for (uint32_t i = 0; i < desc.pooledActorCount; ++i)
+        m_freePxActors.pushBack(createPxActor(true));
+
+    m_blastToPx.resize(maxActorCount, nullptr);
+    m_newActors.resize(chunkCount);
+    m_visibleChunks.resize(chunkCount);
+    m_chunkFractures.resize(chunkCount);
+    m_bondFractures.resize(bondCount);
+    m_addedPxActors.reserve(chunkCount);
+    m_removedPxActors.reserve(chunkCount);
+
+    if (m_stressSolver)
+    {
+        const NvBlastSupportGraph graph = NvBlastAssetGetSupportGraph(asset, logLL);
+        const NvBlastChunk* chunks = NvBlastAssetGetChunks(asset, logLL);
+        m_nodePositions.resize(graph.nodeCount);
+        for (uint32_t i = 0; i < graph.nodeCount; ++i)
+        {
+            const uint32_t chunkIndex = graph.chunkIndices[i];
+            m_nodePositions[i] = isInvalidIndex(chunkIndex) ? PxVec3(PX_MAX_F32) : PxVec3(chunks[chunkIndex].centroid[0], chunks[chunkIndex].centroid[1], chunks[chunkIndex].centroid[2]);
+        }
+        m_nodeImpulses.resize(graph.nodeCount, PxVec3(0.0f));
+        m_impulseNodes.reserve(graph.nodeCount);
+        m_graphNodes.resize(graph.nodeCount);
+        m_familyActors.resize(maxActorCount);
+        m_stressActors.resize(maxActorCount);
+        m_stressCommands.resize(maxActorCount);
+        m_maxStressIterations = m_stressSolver->getSettings().maxSolverIterationsPerFrame;
+    }
+
+    // the first actor covers the whole asset, it needs the largest split scratch
+    const uint32_t actorCount = NvBlastFamilyGetActors(m_newActors.begin(), m_newActors.size(), &m_family, logLL);
+    size_t scratchSize = 0;
+    for (uint32_t i = 0; i < actorCount; ++i)
+    {
+        const size_t actorScratchSize = NvBlastActorGetRequiredScratchForSplit(m_newActors[i], logLL);
+        scratchSize = actorScratchSize > scratchSize ? actorScratchSize : scratchSize;
+    }
+    m_splitScratch.resize(static_cast<uint32_t>(scratchSize));
+
+    const PxTransform pose(PxVec3(desc.pose.p.x, desc.pose.p.y, desc.pose.p.z), PxQuat(desc.pose.q.x, desc.pose.q.y, desc.pose.q.z, desc.pose.q.w));
+    for (uint32_t i = 0; i < actorCount; ++i)
+    {
+        PxRigidDynamic* pxActor = acquirePxActor(*m_newActors[i]);
+        pxActor->setGlobalPose(pose);
+        m_addedPxActors.pushBack(pxActor);
+        if (m_stressSolver)
+            m_stressSolver->notifyActorCreated(*m_newActors[i]);
+    }
+    m_scene.addActors(m_addedPxActors.begin(), m_addedPxActors.size());
+    m_addedPxActors.clear();
+
+    m_valid = true;
+}
+
+
+ExtPxDestructionImpl::~ExtPxDestructionImpl()
+{
+    for (uint32_t i = 0; i < m_blastToPx.size(); ++i)
+    {
+        if (m_blastToPx[i] != nullptr)
+            m_removedPxActors.pushBack(m_blastToPx[i]);
+    }
+    if (m_removedPxActors.size())
+        m_scene.removeActors(m_removedPxActors.begin(), m_removedPxActors.size());
+
+    for (uint32_t i = 0; i < m_chunkPxActors.size(); ++i)
+    {
+        if (m_chunkPxActors[i] != nullptr)
+            m_chunkPxActors[i]->release();
+    }
+    for (uint32_t i = 0; i < m_pooledPxActors.size(); ++i)
+        m_pooledPxActors[i]->release();
+    for (uint32_t i = 0; i < m_shapes.size(); ++i)
+        m_shapes[i]->release();
+}
+
+
+ExtPxDestruction* ExtPxDestruction::create(const ExtPxDestructionDesc& desc)
+{
+    if (!desc.physics || !desc.scene || !desc.family || !desc.chunkShapes)
+    {
+        NVBLAST_LOG_ERROR("ExtPxDestruction::create: physics, scene, family and chunkShapes must be set");
+        return nullptr;
+    }
+
+    ExtPxDestructionImpl* destruction = NVBLAST_NEW(ExtPxDestructionImpl) (desc);
+
+    if (!destruction->valid())
+    {
+        destruction->release();
+        destruction = nullptr;
+        NVBLAST_LOG_ERROR("ExtPxDestruction::create: could not create destruction bridge");
+    }
+
+    return destruction;
+}
+
+
+void ExtPxDestructionImpl::release()
+{
+    NVBLAST_DELETE(this, ExtPxDestructionImpl);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                           PhysX Actors
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+PxRigidDynamic* ExtPxDestructionImpl::createPxActor(bool pooled)
+{
+    PxRigidDynamic* pxActor = m_physics.createRigidDynamic(PxTransform(PxIdentity));
+    pxActor->userData = reinterpret_cast<void*>(size_t(m_userIndexBase + m_userIndexToPx.size()));
+    m_userIndexToPx.pushBack(pxActor);
+    if (pooled)
+        m_pooledPxActors.pushBack(pxActor);
+
+    const PxActorInfo info = { invalidIndex<uint32_t>(), pooled };
+    m_pxToBlast[pxActor] = info;
+    return pxActor;
+}
+
+
+PxRigidDynamic* ExtPxDestructionImpl::acquirePxActor(const NvBlastActor& actor)
+{
+    const uint32_t visibleChunkCount = NvBlastActorGetVisibleChunkIndices(m_visibleChunks.begin(), m_visibleChunks.size(), &actor, logLL);
+
+    PxRigidDynamic* pxActor = visibleChunkCount == 1 ? m_chunkPxActors[m_visibleChunks[0]] : nullptr;
+    if (!pxActor)
+    {
+        if (m_freePxActors.size())
+        {
+            pxActor = m_freePxActors.popBack();
+        }
+        else
+        {
+            NVBLAST_LOG_WARNING("ExtPxDestruction: the pool of multi-chunk actors is empty, creating a new actor. Increase ExtPxDestructionDesc::pooledActorCount.");
+            pxActor = createPxActor(true);
+            m_poolOverflowCount++;
+        }
+
+        // shapes are shared, attaching them does not copy any geometry
+        for (uint32_t i = 0; i < visibleChunkCount; ++i)
+        {
+            const uint32_t chunkIndex = m_visibleChunks[i];
+            for (uint32_t j = m_shapeOffsets[chunkIndex]; j < m_shapeOffsets[chunkIndex + 1]; ++j)
+                pxActor->attachShape(*m_shapes[j]);
+        }
+        PxRigidBodyExt::updateMassAndInertia(*pxActor, m_density);
+    }
+
+    // actors bound to the world stay in place
+    pxActor->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, NvBlastActorHasExternalBonds(&actor, logLL));
+
+    const uint32_t actorIndex = NvBlastActorGetIndex(&actor, logLL);
+    m_blastToPx[actorIndex] = pxActor;
+    m_pxToBlast[pxActor].blastActorIndex = actorIndex;
+    return pxActor;
+}
+
+
+void ExtPxDestructionImpl::releasePxActor(PxRigidDynamic& pxActor)
+{
+    PxActorInfo& info = m_pxToBlast[&pxActor];
+    m_blastToPx[info.blastActorIndex] = nullptr;
+    info.blastActorIndex = invalidIndex<uint32_t>();
+
+    if (info.pooled)
+    {
+        for (uint32_t i = pxActor.getNbShapes(); i--;)
+        {
+            PxShape* shape;
+            pxActor.getShapes(&shape, 1, i);
+            pxActor.detachShape(*shape);
+        }
+        m_freePxActors.pushBack(&pxActor);
+    }
+}
+
+
+PxRigidDynamic* ExtPxDestructionImpl::getPxActor(const NvBlastActor& actor) const
+{
+    if (NvBlastActorGetFamily(&actor, logLL) != &m_family)
+        return nullptr;
+
+    return m_blastToPx[NvBlastActorGetIndex(&actor, logLL)];
+}
+
+
+NvBlastActor* ExtPxDestructionImpl::getBlastActor(const PxRigidActor& actor) const
+{
+    const HashMap<const PxRigidActor*, PxActorInfo>::type::Entry* entry = m_pxToBlast.find(&actor);
+    if (!entry || isInvalidIndex(entry->second.blastActorIndex))
+        return nullptr;
+
+    return NvBlastFamilyGetActorByIndex(&m_family, entry->second.blastActorIndex, logLL);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                           Fracture
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t ExtPxDestructionImpl::applyFracture(NvBlastActor& actor, const NvBlastFractureBuffers& commands)
+{
+    // debris has no PhysX actor and is not fractured further
+    if (getPxActor(actor) == nullptr)
+        return 0;
+
+    NvBlastActorApplyFracture(nullptr, &actor, &commands, logLL, nullptr);
+    return split(actor);
+}
+
+
+uint32_t ExtPxDestructionImpl::applyDamage(NvBlastActor& actor, const NvBlastDamageProgram& program, const void* programParams)
+{
+    NvBlastFractureBuffers commands;
+    commands.bondFractureCount = m_bondFractures.size();
+    commands.chunkFractureCount = m_chunkFractures.size();
+    commands.bondFractures = m_bondFractures.begin();
+    commands.chunkFractures = m_chunkFractures.begin();
+
+    NvBlastActorGenerateFracture(&commands, &actor, program, programParams, logLL, nullptr);
+    if (commands.bondFractureCount == 0 && commands.chunkFractureCount == 0)
+        return 0;
+
+    return applyFracture(actor, commands);
+}
+
+
+uint32_t ExtPxDestructionImpl::split(NvBlastActor& actor)
+{
+    if (!NvBlastActorIsSplitRequired(&actor, logLL))
+        return 0;
+
+    PxRigidDynamic* parent = m_blastToPx[NvBlastActorGetIndex(&actor, logLL)];
+    NVBLAST_ASSERT(parent != nullptr);
+
+    if (m_stressSolver)
+        m_stressSolver->notifyActorDestroyed(actor);
+
+    NvBlastActorSplitEvent splitEvent = { nullptr, m_newActors.begin() };
+    const uint32_t newActorCount = NvBlastActorSplit(&splitEvent, &actor, m_newActors.size(), m_splitScratch.begin(), logLL, nullptr);
+    if (newActorCount == 0)
+    {
+        if (m_stressSolver)
+            m_stressSolver->notifyActorCreated(actor);
+        return 0;
+    }
+
+    // fragments inherit the motion of the parent, as a rigid body: v = v_parent + w_parent x (com - com_parent)
+    const PxTransform pose = parent->getGlobalPose();
+    const bool parentKinematic = parent->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC;
+    const PxVec3 linearVelocity = parentKinematic ? PxVec3(0.0f) : parent->getLinearVelocity();
+    const PxVec3 angularVelocity = parentKinematic ? PxVec3(0.0f) : parent->getAngularVelocity();
+    const PxReal wakeCounter = parentKinematic ? m_scene.getWakeCounterResetValue() : parent->getWakeCounter();
+    const PxVec3 parentCenter = pose.transform(parent->getCMassLocalPose().p);
+
+    // the parent is removed before its PhysX actor can be reused by one of the fragments
+    releasePxActor(*parent);
+    m_removedPxActors.pushBack(parent);
+    m_scene.removeActors(m_removedPxActors.begin(), m_removedPxActors.size());
+    m_removedPxActors.clear();
+
+    for (uint32_t i = 0; i < newActorCount; ++i)
+    {
+        if (m_stressSolver)
+            m_stressSolver->notifyActorCreated(*splitEvent.newActors[i]);
+
+        if (createDebris(*splitEvent.newActors[i], pose, linearVelocity, angularVelocity, parentCenter))
+            continue;
+
+        PxRigidDynamic* pxActor = acquirePxActor(*splitEvent.newActors[i]);
+        pxActor->setGlobalPose(pose);
+        if (!(pxActor->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC))
+        {
+            const PxVec3 center = pose.transform(pxActor->getCMassLocalPose().p);
+            pxActor->setLinearVelocity(linearVelocity + angularVelocity.cross(center - parentCenter));
+            pxActor->setAngularVelocity(angularVelocity);
+            pxActor->setWakeCounter(wakeCounter);
+        }
+        m_addedPxActors.pushBack(pxActor);
+    }
+
+    m_scene.addActors(m_addedPxActors.begin(), m_addedPxActors.size());
+    m_addedPxActors.clear();
+
+    return newActorCount;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                           Stress
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ExtPxDestructionImpl::addContactReports(const PxContactReportRecord* records, uint32_t recordCount)
+{
+    if (!m_stressSolver)
+        return;
+
+    for (uint32_t i = 0; i < recordCount; ++i)
+    {
+        const PxContactReportRecord& record = records[i];
+        if (record.nbContacts == 0 || record.impulse.isZero())
+            continue;
+
+        // the reported impulse acts on the first actor of the pair, its opposite on the second
+        addContactImpulse(record.userIndex0, record.point, record.impulse);
+        addContactImpulse(record.userIndex1, record.point, -record.impulse);
+    }
+}
+
+
+void ExtPxDestructionImpl::addContactImpulse(uint32_t userIndex, const PxVec3& point, const PxVec3& impulse)
+{
+    // also rejects PX_INVALID_U32, reported for removed actors
+    const uint32_t pxActorIndex = userIndex - m_userIndexBase;
+    if (userIndex < m_userIndexBase || pxActorIndex >= m_userIndexToPx.size())
+        return;
+
+    PxRigidDynamic* pxActor = m_userIndexToPx[pxActorIndex];
+    const uint32_t actorIndex = m_pxToBlast[pxActor].blastActorIndex;
+    if (isInvalidIndex(actorIndex))
+        return;
+
+    const NvBlastActor* actor = NvBlastFamilyGetActorByIndex(&m_family, actorIndex, logLL);
+    const uint32_t nodeCount = NvBlastActorGetGraphNodeIndices(m_graphNodes.begin(), m_graphNodes.size(), actor, logLL);
+    if (nodeCount < 2)
+        return; // no bonds to stress
+
+    // fragments share the asset frame, the actor's pose maps world space to it
+    const PxTransform pose = pxActor->getGlobalPose();
+    const PxVec3 localPoint = pose.transformInv(point);
+
+    uint32_t closestNode = invalidIndex<uint32_t>();
+    float closestDistanceSquared = PX_MAX_F32;
+    for (uint32_t i = 0; i < nodeCount; ++i)
+    {
+        const float distanceSquared = (m_nodePositions[m_graphNodes[i]] - localPoint).magnitudeSquared();
+        if (distanceSquared < closestDistanceSquared)
+        {
+            closestDistanceSquared = distanceSquared;
+            closestNode = m_graphNodes[i];
+        }
+    }
+    if (isInvalidIndex(closestNode))
+        return;
+
+    PxVec3& nodeImpulse = m_nodeImpulses[closestNode];
+    if (nodeImpulse.isZero())
+        m_impulseNodes.pushBack(closestNode);
+    nodeImpulse += pose.rotateInv(impulse);
+}
+
+
+uint32_t ExtPxDestructionImpl::updateStress(float dt, float timeBudget)
+{
+    if (!m_stressSolver)
+        return 0;
+
+    // impulses accumulated over the step become forces
+    const float invDt = dt > 0.0f ? 1.0f / dt : 0.0f;
+    for (uint32_t i = 0; i < m_impulseNodes.size(); ++i)
+    {
+        const uint32_t node = m_impulseNodes[i];
+        const PxVec3 force = m_nodeImpulses[node] * invDt;
+        m_stressSolver->addForce(node, { force.x, force.y, force.z }, ExtForceMode::FORCE);
+        m_nodeImpulses[node] = PxVec3(0.0f);
+    }
+    m_impulseNodes.clear();
+
+    // the actors bound to the world carry their own weight
+    const PxVec3 gravity = m_scene.getGravity();
+    const uint32_t actorCount = NvBlastFamilyGetActors(m_familyActors.begin(), m_familyActors.size(), &m_family, logLL);
+    for (uint32_t i = 0; i < actorCount; ++i)
+    {
+        const NvBlastActor& actor = *m_familyActors[i];
+        PxRigidDynamic* pxActor = m_blastToPx[NvBlastActorGetIndex(&actor, logLL)];
+        if (pxActor && NvBlastActorHasExternalBonds(&actor, logLL))
+        {
+            const PxVec3 localGravity = pxActor->getGlobalPose().rotateInv(gravity);
+            m_stressSolver->addGravity(actor, { localGravity.x, localGravity.y, localGravity.z });
+        }
+    }
+
+    // fit the iteration count to the budget, the warm-started solver resumes from this solution next frame
+    uint32_t iterationCount = m_maxStressIterations;
+    if (timeBudget > 0.0f && m_secondsPerStressIteration > 0.0)
+    {
+        const double budgetIterations = timeBudget / m_secondsPerStressIteration;
+        iterationCount = budgetIterations < 1.0 ? 1 : (budgetIterations > m_maxStressIterations ? m_maxStressIterations : static_cast<uint32_t>(budgetIterations));
+    }
+    if (iterationCount != m_stressSolver->getSettings().maxSolverIterationsPerFrame)
+    {
+        ExtStressSolverSettings settings = m_stressSolver->getSettings();
+        settings.maxSolverIterationsPerFrame = iterationCount;
+        m_stressSolver->setSettings(settings);
+    }
+
+    Time time;
+    m_stressSolver->update();
+    if (iterationCount)
+    {
+        // smoothed, frames that rebuild the solver graph after a split cost more
+        const double secondsPerIteration = Time::seconds(time.getElapsedTicks()) / iterationCount;
+        m_secondsPerStressIteration = m_secondsPerStressIteration > 0.0 ? 0.75 * m_secondsPerStressIteration + 0.25 * secondsPerIteration : secondsPerIteration;
+    }
+
+    if (m_stressSolver->getOverstressedBondCount() == 0)
+        return 0;
+
+    uint32_t newActorCount = 0;
+    const uint32_t commandCount = m_stressSolver->generateFractureCommandsPerActor(m_stressActors.begin(), m_stressCommands.begin(), m_stressActors.size());
+    for (uint32_t i = 0; i < commandCount; ++i)
+    {
+        NvBlastActor* actor = const_cast<NvBlastActor*>(m_stressActors[i]);
+        newActorCount += applyFracture(*actor, m_stressCommands[i]);
+    }
+    return newActorCount;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                           Debris
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ExtPxDestructionImpl::createDebris(const NvBlastActor& actor, const PxTransform& pose, const PxVec3& linearVelocity,
+                                        const PxVec3& angularVelocity, const PxVec3& parentCenter)
+{
+    const bool volumeTest = m_debrisSettings.volumeThreshold > 0.0f;
+    const bool distanceTest = m_debrisSettings.distanceThreshold > 0.0f && m_viewers.size() > 0;
+    if ((!volumeTest && !distanceTest) || m_debrisSettings.maxDebrisCount == 0 || NvBlastActorHasExternalBonds(&actor, logLL))
+        return false;
+
+    const uint32_t visibleChunkCount = NvBlastActorGetVisibleChunkIndices(m_visibleChunks.begin(), m_visibleChunks.size(), &actor, logLL);
+    float volume = 0.0f;
+    PxVec3 localCenter(0.0f);
+    for (uint32_t i = 0; i < visibleChunkCount; ++i)
+    {
+        const NvBlastChunk& chunk = m_chunks[m_visibleChunks[i]];
+        volume += chunk.volume;
+        localCenter += PxVec3(chunk.centroid[0], chunk.centroid[1], chunk.centroid[2]) * chunk.volume;
+    }
+    if (volume <= 0.0f)
+        return false;
+    localCenter /= volume;
+    const PxVec3 center = pose.transform(localCenter);
+
+    bool debris = volumeTest && volume < m_debrisSettings.volumeThreshold;
+    if (!debris && distanceTest)
+    {
+        const float distanceSquared = m_debrisSettings.distanceThreshold * m_debrisSettings.distanceThreshold;
+        debris = true;
+        for (uint32_t i = 0; i < m_viewers.size() && debris; ++i)
+            debris = (m_viewers[i] - center).magnitudeSquared() > distanceSquared;
+    }
+    if (!debris)
+        return false;
+
+    // make room by dropping the oldest particle
+    if (m_debris.size() >= m_debrisSettings.maxDebrisCount)
+    {
+        uint32_t oldest = 0;
+        for (uint32_t i = 1; i < m_debris.size(); ++i)
+        {
+            if (m_debris[i].age > m_debris[oldest].age)
+                oldest = i;
+        }
+        m_debris.replaceWithLast(oldest);
+    }
+
+    // a sphere of the fragment's volume, moving like the fragment would as a rigid body
+    DebrisParticle particle;
+    particle.position = center;
+    particle.rotation = pose.q;
+    particle.linearVelocity = linearVelocity + angularVelocity.cross(center - parentCenter);
+    particle.angularVelocity = angularVelocity;
+    particle.localCenter = localCenter;
+    particle.radius = PxPow(volume * (3.0f / (4.0f * PxPi)), 1.0f / 3.0f);
+    particle.age = 0.0f;
+    particle.blastActorIndex = NvBlastActorGetIndex(&actor, logLL);
+    particle.sleeping = false;
+    m_debris.pushBack(particle);
+    return true;
+}
+
+
+void ExtPxDestructionImpl::setViewers(const NvcVec3* positions, uint32_t count)
+{
+    m_viewers.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+        m_viewers[i] = PxVec3(positions[i].x, positions[i].y, positions[i].z);
+}
+
+
+void ExtPxDestructionImpl::updateDebris(float dt)
+{
+    const PxVec3 gravity = m_scene.getGravity();
+    const PxQueryFilterData filterData(PxQueryFlag::eSTATIC);
+    // below this speed after a bounce, a particle is at rest
+    const float sleepSpeedSquared = 4.0f * gravity.magnitudeSquared() * dt * dt;
+
+    for (uint32_t i = m_debris.size(); i--;)
+    {
+        DebrisParticle& particle = m_debris[i];
+        particle.age += dt;
+        if (m_debrisSettings.lifetime > 0.0f && particle.age > m_debrisSettings.lifetime)
+        {
+            m_debris.replaceWithLast(i);
+            continue;
+        }
+
+        if (particle.sleeping)
+            continue;
+
+        particle.linearVelocity += gravity * dt;
+        const PxVec3 motion = particle.linearVelocity * dt;
+        const float distance = motion.magnitude();
+        if (distance > 0.0f)
+        {
+            // the ray is extended by the radius, so that the sphere stops on the surface
+            PxRaycastBuffer hit;
+            const PxVec3 direction = motion / distance;
+            if (m_scene.raycast(particle.position, direction, distance + particle.radius, hit, PxHitFlag::ePOSITION | PxHitFlag::eNORMAL, filterData) && hit.hasBlock)
+            {
+                const PxVec3 normal = hit.block.normal;
+                particle.position = hit.block.position + normal * particle.radius;
+
+                const float normalSpeed = particle.linearVelocity.dot(normal);
+                if (normalSpeed < 0.0f)
+                {
+                    const PxVec3 tangentVelocity = particle.linearVelocity - normal * normalSpeed;
+                    particle.linearVelocity = tangentVelocity * (1.0f - m_debrisSettings.friction) - normal * (normalSpeed * m_debrisSettings.restitution);
+                    particle.angularVelocity *= 1.0f - m_debrisSettings.friction;
+                }
+
+                if (particle.linearVelocity.magnitudeSquared() < sleepSpeedSquared)
+                {
+                    particle.linearVelocity = PxVec3(0.0f);
+                    particle.angularVelocity = PxVec3(0.0f);
+                    particle.sleeping = true;
+                }
+            }
+            else
+            {
+                particle.position += motion;
+            }
+        }
+
+        const PxQuat spin(particle.angularVelocity.x, particle.angularVelocity.y, particle.angularVelocity.z, 0.0f);
+        particle.rotation = (particle.rotation + spin * particle.rotation * (0.5f * dt)).getNormalized();
+    }
+}
+
+
+uint32_t ExtPxDestructionImpl::getDebris(ExtPxDebris* buffer, uint32_t bufferSize) const
+{
+    const uint32_t count = bufferSize < m_debris.size() ? bufferSize : m_debris.size();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const DebrisParticle& particle = m_debris[i];
+        // pose of the asset frame, the particle position is the fragment's center
+        const PxVec3 p = particle.position - particle.rotation.rotate(particle.localCenter);
+        ExtPxDebris& debris = buffer[i];
+        debris.pose.q = { particle.rotation.x, particle.rotation.y, particle.rotation.z, particle.rotation.w };
+        debris.pose.p = { p.x, p.y, p.z };
+        debris.radius = particle.radius;
+        debris.actorIndex = particle.blastActorIndex;
+    }
+    return count;
+}
+
+} // namespace Blast
+} // namespace Nv
@@ -0,0 +1,305 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2025 NVIDIA Corporation. All rights reserved.
+
+
+#include "NvBlastExtRawAsset.h"
+#include "NvBlast.h"
+
+#include <cstring>
+
+
+namespace Nv
+{
+namespace Blast
+{
+
+struct ExtRawAssetHeader
+{
+    enum
+    {
+        FourCC = NVBLAST_FOURCC('B', 'R', 'A', 'W'),
+        Version = 1,
+    };
+
+    uint32_t    fourCC;
+    uint32_t    version;
+    uint64_t    size;               //!<    size of the whole buffer, including this header
+    uint32_t    assetOffset;
+    uint32_t    chunkCount;
+    uint32_t    partitionOffset;    //!<    chunkCount + 1 payload indices
+    uint32_t    payloadTableOffset; //!<    payloadCount ExtRawAssetPayloadEntry
+    uint32_t    payloadCount;
+    uint32_t    reserved[3];
+};
+
+struct ExtRawAssetPayloadEntry
+{
+    uint32_t    offset;
+    uint32_t    size;
+};
+
+
+static inline uint64_t align16(uint64_t size)
+{
+    return (size + 15) & ~uint64_t(15);
+}
+
+
+static inline const ExtRawAssetHeader& getHeader(const void* buffer)
+{
+    return *reinterpret_cast<const ExtRawAssetHeader*>(buffer);
+}
+
+
+static inline const uint32_t* getPartition(const void* buffer)
+{
+    return reinterpret_cast<const uint32_t*>(static_cast<const char*>(buffer) + getHeader(buffer).partitionOffset);
+}
+
+
+static inline const ExtRawAssetPayloadEntry* getPayloadTable(const void* buffer)
+{
+    return reinterpret_cast<const ExtRawAssetPayloadEntry*>(static_cast<const char*>(buffer) + getHeader(buffer).payloadTableOffset);
+}
+
+
+// Fills the header with the layout of the buffer, returns false if the offsets do not fit in 32 bits
+static bool computeLayout(ExtRawAssetHeader& header, const NvBlastAsset* asset, const NvBlastExtRawAssetChunkPayloads* chunkPayloads)
+{
+    header.fourCC = ExtRawAssetHeader::FourCC;
+    header.version = ExtRawAssetHeader::Version;
+    header.chunkCount = NvBlastAssetGetChunkCount(asset, logLL);
+
+    uint64_t payloadCount = 0;
+    uint64_t payloadDataSize = 0;
+    if (chunkPayloads)
+    {
+        for (uint32_t i = 0; i < header.chunkCount; ++i)
+        {
+            payloadCount += chunkPayloads[i].payloadCount;
+            for (uint32_t j = 0; j < chunkPayloads[i].payloadCount; ++j)
+                payloadDataSize += align16(chunkPayloads[i].payloads[j].size);
+        }
+    }
+
+    const uint64_t assetOffset = align16(sizeof(ExtRawAssetHeader));
+    const uint64_t partitionOffset = align16(assetOffset + NvBlastAssetGetSize(asset, logLL));
+    const uint64_t payloadTableOffset = align16(partitionOffset + (header.chunkCount + 1) * sizeof(uint32_t));
+    const uint64_t payloadDataOffset = align16(payloadTableOffset + payloadCount * sizeof(ExtRawAssetPayloadEntry));
+    header.size = payloadDataOffset + payloadDataSize;
+
+    if (header.size > UINT32_MAX)
+        return false;
+
+    header.assetOffset = static_cast<uint32_t>(assetOffset);
+    header.partitionOffset = static_cast<uint32_t>(partitionOffset);
+    header.payloadTableOffset = static_cast<uint32_t>(payloadTableOffset);
+    header.payloadCount = static_cast<uint32_t>(payloadCount);
+    memset(header.reserved, 0, sizeof(header.reserved));
+    return true;
+}
+
+}   // namespace Blast
+}   // namespace Nv
+
+
+///////////////////////////////////////
+
+
+using namespace Nv::Blast;
+
+
+uint64_t NvBlastExtRawAssetGetSize(const NvBlastAsset* asset, const NvBlastExtRawAssetChunkPayloads* chunkPayloads)
+{
+    if (asset == nullptr)
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetGetSize: NULL asset input.");
+        return 0;
+    }
+
+    ExtRawAssetHeader header;
+    if (!computeLayout(header, asset, chunkPayloads))
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetGetSize: raw assets are limited to 4GB.");
+        return 0;
+    }
+    return header.size;
+}
+
+
+uint64_t NvBlastExtRawAssetWrite(void* buffer, uint64_t bufferSize, const NvBlastAsset* asset, const NvBlastExtRawAssetChunkPayloads* chunkPayloads)
+{
+    if (buffer == nullptr || asset == nullptr)
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetWrite: NULL buffer or asset input.");
+        return 0;
+    }
+
+    if ((reinterpret_cast<uintptr_t>(buffer) & 15) != 0)
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetWrite: buffer must be 16-byte aligned.");
+        return 0;
+    }
+
+    ExtRawAssetHeader header;
+    if (!computeLayout(header, asset, chunkPayloads))
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetWrite: raw assets are limited to 4GB.");
+        return 0;
+    }
+
+    if (header.size > bufferSize)
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetWrite: buffer too small, see NvBlastExtRawAssetGetSize().");
+        return 0;
+    }
+
+    // zero the padding, so that the same input always produces the same bytes
+    char* bytes = static_cast<char*>(buffer);
+    memset(bytes, 0, static_cast<size_t>(header.size));
+    memcpy(bytes, &header, sizeof(header));
+    memcpy(bytes + header.assetOffset, asset, NvBlastAssetGetSize(asset, logLL));
+
+    uint32_t* partition = reinterpret_cast<uint32_t*>(bytes + header.partitionOffset);
+    ExtRawAssetPayloadEntry* payloadTable = reinterpret_cast<ExtRawAssetPayloadEntry*>(bytes + header.payloadTableOffset);
+    uint32_t payloadIndex = 0;
+    uint32_t dataOffset = static_cast<uint32_t>(align16(header.payloadTableOffset + header.payloadCount * sizeof(ExtRawAssetPayloadEntry)));
+    for (uint32_t i = 0; i < header.chunkCount; ++i)
+    {
+        partition[i] = payloadIndex;
+        const uint32_t chunkPayloadCount = chunkPayloads ? chunkPayloads[i].payloadCount : 0;
+        for (uint32_t j = 0; j < chunkPayloadCount; ++j)
+        {
+            const NvBlastExtRawAssetPayload& payload = chunkPayloads[i].payloads[j];
+            payloadTable[payloadIndex].offset = dataOffset;
+            payloadTable[payloadIndex].size = payload.size;
+            memcpy(bytes + dataOffset, payload.data, payload.size);
+            dataOffset += static_cast<uint32_t>(align16(payload.size));
+            ++payloadIndex;
+        }
+    }
+    partition[header.chunkCount] = payloadIndex;
+
+    return header.size;
+}
+
+
+const NvBlastAsset* NvBlastExtRawAssetGetAsset(const void* buffer, uint64_t bufferSize)
+{
+    if (buffer == nullptr || (reinterpret_cast<uintptr_t>(buffer) & 15) != 0)
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetGetAsset: buffer must be non-NULL and 16-byte aligned.");
+        return nullptr;
+    }
+
+    const ExtRawAssetHeader& header = getHeader(buffer);
+    if (bufferSize < sizeof(ExtRawAssetHeader) || header.fourCC != ExtRawAssetHeader::FourCC)
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetGetAsset: buffer does not contain a raw asset.");
+        return nullptr;
+    }
+
+    if (header.version != ExtRawAssetHeader::Version)
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetGetAsset: buffer contains a raw asset of an unknown version.");
+        return nullptr;
+    }
+
+    // every offset is checked against the buffer, a truncated or corrupt file must not be read out of bounds
+    const uint64_t payloadTableEnd = uint64_t(header.payloadTableOffset) + uint64_t(header.payloadCount) * sizeof(ExtRawAssetPayloadEntry);
+    if (header.size > bufferSize || (header.assetOffset & 15) != 0 ||
+        uint64_t(header.assetOffset) + sizeof(NvBlastDataBlock) > header.partitionOffset ||
+        uint64_t(header.partitionOffset) + (uint64_t(header.chunkCount) + 1) * sizeof(uint32_t) > header.payloadTableOffset ||
+        payloadTableEnd > header.size)
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetGetAsset: corrupt raw asset layout.");
+        return nullptr;
+    }
+
+    const NvBlastDataBlock& block = *reinterpret_cast<const NvBlastDataBlock*>(static_cast<const char*>(buffer) + header.assetOffset);
+    if (block.dataType != NvBlastDataBlock::AssetDataBlock || uint64_t(header.assetOffset) + block.size > header.partitionOffset)
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetGetAsset: corrupt asset data.");
+        return nullptr;
+    }
+
+    const NvBlastAsset* asset = reinterpret_cast<const NvBlastAsset*>(&block);
+    if (NvBlastAssetGetChunkCount(asset, logLL) != header.chunkCount)
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetGetAsset: chunk count mismatch.");
+        return nullptr;
+    }
+
+    const uint32_t* partition = getPartition(buffer);
+    for (uint32_t i = 0; i < header.chunkCount; ++i)
+    {
+        if (partition[i] > partition[i + 1])
+        {
+            NVBLAST_LOG_ERROR("NvBlastExtRawAssetGetAsset: corrupt payload partition.");
+            return nullptr;
+        }
+    }
+    if (partition[0] != 0 || partition[header.chunkCount] != header.payloadCount)
+    {
+        NVBLAST_LOG_ERROR("NvBlastExtRawAssetGetAsset: corrupt payload partition.");
+        return nullptr;
+    }
+
+    const ExtRawAssetPayloadEntry* payloadTable = getPayloadTable(buffer);
+    for (uint32_t i = 0; i < header.payloadCount; ++i)
+    {
+        if (payloadTable[i].offset < payloadTableEnd || uint64_t(payloadTable[i].offset) + payloadTable[i].size > header.size)
+        {
+            NVBLAST_LOG_ERROR("NvBlastExtRawAssetGetAsset: corrupt payload table.");
+            return nullptr;
+        }
+    }
+
+    return asset;
+}
+
+
+uint32_t NvBlastExtRawAssetGetChunkPayloadCount(const void* buffer, uint32_t chunkIndex)
+{
+    if (chunkIndex >= getHeader(buffer).chunkCount)
+        return 0;
+
+    const uint32_t* partition = getPartition(buffer);
+    return partition[chunkIndex + 1] - partition[chunkIndex];
+}
+
+
+NvBlastExtRawAssetPayload NvBlastExtRawAssetGetChunkPayload(const void* buffer, uint32_t chunkIndex, uint32_t payloadIndex)
+{
+    NvBlastExtRawAssetPayload payload = { nullptr, 0 };
+    if (payloadIndex >= NvBlastExtRawAssetGetChunkPayloadCount(buffer, chunkIndex))
+        return payload;
+
+    const ExtRawAssetPayloadEntry& entry = getPayloadTable(buffer)[getPartition(buffer)[chunkIndex] + payloadIndex];
+    payload.data = static_cast<const char*>(buffer) + entry.offset;
+    payload.size = entry.size;
+    return payload;
+}
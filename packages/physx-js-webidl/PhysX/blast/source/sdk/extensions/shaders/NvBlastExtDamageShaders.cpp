@@ -26,6 +26,7 @@
 
 
 #include "NvBlastExtDamageShaders.h"
+#include "NvBlastExtDamageShadersInternal.h"
 #include "NvBlastExtDamageAcceleratorInternal.h"
 #include "NvBlastIndexFns.h"
 #include "NvBlastMath.h"
@@ -42,48 +43,10 @@ using namespace Nv::Blast;
 using namespace Nv::Blast::VecMath;
 using namespace nvidia;
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//                                                  Profiles
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-typedef float(*ProfileFunction)(float, float, float, float);
-
-float falloffProfile(float min, float max, float x, float f = 1.0f)
-{
-    if (x > max) return 0.0f;
-    if (x < min) return f;
-
-    float y = 1.0f - (x - min) / (max - min);
-    return y * f;
-}
-
-float cutterProfile(float min, float max, float x, float f = 1.0f)
-{
-    if (x > max || x < min) return 0.0f;
-
-    return f;
-}
-
-
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                                  Damage Functions
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-typedef float(*DamageFunction)(const float pos[3], const void* damageDescBuffer);
-
-template <ProfileFunction profileFn, typename DescT = NvBlastExtRadialDamageDesc>
-float pointDistanceDamage(const float pos[3], const void* damageDescBuffer)
-{
-    const DescT& desc = *static_cast<const DescT*>(damageDescBuffer);
-
-    float relativePosition[3];
-    sub(desc.position, pos, relativePosition);
-    const float distance = sqrtf(dot(relativePosition, relativePosition));
-    const float damage = profileFn(desc.minRadius, desc.maxRadius, distance, desc.damage);
-    return damage;
-}
-
-
 // Distance from point 'p' to line segment '(a, b)'
 float distanceToSegment(const float p[3], const float a[3], const float b[3])
 {
@@ -146,7 +109,74 @@ NvBounds3 capsuleBounds(const void* damageDesc)
 //                                              Radial Graph Shader Template
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-template <DamageFunction damageFn, BoundFunction boundsFn>
+/**
+Accumulates candidate bonds, their centroids in SoA layout, and evaluates the damage of all descs for a block of them at once.
+*/
+template <BatchDamageFunction damageFn>
+class BondDamageBatch
+{
+public:
+    static const uint32_t BLOCK_SIZE = 256;
+
+    BondDamageBatch(NvBlastFractureBuffers* commandBuffers, uint32_t& outCount, const NvBlastBond* assetBonds, const NvBlastExtProgramParams* programParams) :
+        m_commandBuffers(commandBuffers),
+        m_outCount(outCount),
+        m_assetBonds(assetBonds),
+        m_programParams(programParams),
+        m_count(0)
+    {
+    }
+
+    void push(uint32_t bondIndex, uint32_t node0, uint32_t node1)
+    {
+        const NvBlastBond& bond = m_assetBonds[bondIndex];
+        m_node0[m_count] = node0;
+        m_node1[m_count] = node1;
+        m_x[m_count] = bond.centroid[0];
+        m_y[m_count] = bond.centroid[1];
+        m_z[m_count] = bond.centroid[2];
+        if (++m_count == BLOCK_SIZE)
+        {
+            flush();
+        }
+    }
+
+    void flush()
+    {
+        if (m_count == 0)
+            return;
+
+        damageFn(m_x, m_y, m_z, m_count, m_programParams->damageDesc, m_programParams->damageDescCount, m_damage);
+
+        for (uint32_t i = 0; i < m_count; i++)
+        {
+            if (m_damage[i] > 0.0f)
+            {
+                NvBlastBondFractureData& outCommand = m_commandBuffers->bondFractures[m_outCount++];
+                outCommand.nodeIndex0 = m_node0[i];
+                outCommand.nodeIndex1 = m_node1[i];
+                outCommand.health = m_damage[i];
+            }
+        }
+        m_count = 0;
+    }
+
+private:
+    NvBlastFractureBuffers* m_commandBuffers;
+    uint32_t& m_outCount;
+    const NvBlastBond* m_assetBonds;
+    const NvBlastExtProgramParams* m_programParams;
+
+    uint32_t m_count;
+    uint32_t m_node0[BLOCK_SIZE];
+    uint32_t m_node1[BLOCK_SIZE];
+    float m_x[BLOCK_SIZE];
+    float m_y[BLOCK_SIZE];
+    float m_z[BLOCK_SIZE];
+    float m_damage[BLOCK_SIZE];
+};
+
+template <BatchDamageFunction damageFn, BoundFunction boundsFn, typename DescT>
 void RadialProfileGraphShader(NvBlastFractureBuffers* commandBuffers, const NvBlastGraphShaderActor* actor, const void* params)
 {
     const uint32_t* graphNodeIndexLinks = actor->graphNodeIndexLinks;
@@ -160,43 +190,29 @@ void RadialProfileGraphShader(NvBlastFractureBuffers* commandBuffers, const NvBl
 
     uint32_t outCount = 0;
 
-    auto processBondFn = [&](uint32_t bondIndex, uint32_t node0, uint32_t node1)
-    {
-        // skip bonds that are already broken or were visited already
-        // TODO: investigate why testing against health > -1.0f seems slower
-        // could reuse the island edge bitmap instead
-        if (canTakeDamage(familyBondHealths[bondIndex]))
-        {
-            const NvBlastBond& bond = assetBonds[bondIndex];
-
-            const float totalBondDamage = damageFn(bond.centroid, programParams->damageDesc);
-            if (totalBondDamage > 0.0f)
-            {
-                NvBlastBondFractureData& outCommand = commandBuffers->bondFractures[outCount++];
-                outCommand.nodeIndex0 = node0;
-                outCommand.nodeIndex1 = node1;
-                outCommand.health = totalBondDamage;
-            }
-        }
-    };
+    BondDamageBatch<damageFn> batch(commandBuffers, outCount, assetBonds, programParams);
 
     const ExtDamageAcceleratorInternal* damageAccelerator = programParams->accelerator ? static_cast<const ExtDamageAcceleratorInternal*>(programParams->accelerator) : nullptr;
     const uint32_t ACTOR_MINIMUM_NODE_COUNT_TO_ACCELERATE = actor->assetNodeCount / 3;
     if (damageAccelerator && actor->graphNodeCount > ACTOR_MINIMUM_NODE_COUNT_TO_ACCELERATE)
     {
-        nvidia::NvBounds3 bounds = boundsFn(programParams->damageDesc);
+        // all damage events share one traversal over the union of their bounds
+        const DescT* descs = static_cast<const DescT*>(programParams->damageDesc);
+        nvidia::NvBounds3 bounds = NvBounds3::empty();
+        for (uint32_t d = 0; d < programParams->damageDescCount; d++)
+        {
+            bounds.include(boundsFn(descs + d));
+        }
 
         const uint32_t CALLBACK_BUFFER_SIZE = 1000;
 
         class AcceleratorCallback : public ExtDamageAcceleratorInternal::ResultCallback
         {
         public:
-            AcceleratorCallback(NvBlastFractureBuffers* commandBuffers, uint32_t& outCount, const NvBlastGraphShaderActor* actor, const NvBlastExtProgramParams* programParams) :
+            AcceleratorCallback(const NvBlastGraphShaderActor* actor, BondDamageBatch<damageFn>& batch) :
                 ExtDamageAcceleratorInternal::ResultCallback(m_buffer, CALLBACK_BUFFER_SIZE),
                 m_actor(actor),
-                m_commandBuffers(commandBuffers),
-                m_outCount(outCount),
-                m_programParams(programParams)
+                m_batch(batch)
             {
             }
 
@@ -209,16 +225,7 @@ void RadialProfileGraphShader(NvBlastFractureBuffers* commandBuffers, const NvBl
                     {
                         if (canTakeDamage(m_actor->familyBondHealths[bondData.bond]))
                         {
-                            const NvBlastBond& bond = m_actor->assetBonds[bondData.bond];
-
-                            const float totalBondDamage = damageFn(bond.centroid, m_programParams->damageDesc);
-                            if (totalBondDamage > 0.0f)
-                            {
-                                NvBlastBondFractureData& outCommand = m_commandBuffers->bondFractures[m_outCount++];
-                                outCommand.nodeIndex0 = bondData.node0;
-                                outCommand.nodeIndex1 = bondData.node1;
-                                outCommand.health = totalBondDamage;
-                            }
+                            m_batch.push(bondData.bond, bondData.node0, bondData.node1);
                         }
                     }
                 }
@@ -226,14 +233,12 @@ void RadialProfileGraphShader(NvBlastFractureBuffers* commandBuffers, const NvBl
 
         private:
             const NvBlastGraphShaderActor* m_actor;
-            NvBlastFractureBuffers* m_commandBuffers;
-            uint32_t& m_outCount;
-            const NvBlastExtProgramParams* m_programParams;
+            BondDamageBatch<damageFn>& m_batch;
 
             ExtDamageAcceleratorInternal::QueryBondData m_buffer[CALLBACK_BUFFER_SIZE];
         };
 
-        AcceleratorCallback cb(commandBuffers, outCount, actor, programParams);
+        AcceleratorCallback cb(actor, batch);
 
         damageAccelerator->findBondCentroidsInBounds(bounds, cb);
     }
@@ -248,13 +253,21 @@ void RadialProfileGraphShader(NvBlastFractureBuffers* commandBuffers, const NvBl
                 if (currentNodeIndex < adjacentNodeIndex)
                 {
                     uint32_t bondIndex = adjacentBondIndices[adj];
-                    processBondFn(bondIndex, currentNodeIndex, adjacentNodeIndex);
+                    // skip bonds that are already broken or were visited already
+                    // TODO: investigate why testing against health > -1.0f seems slower
+                    // could reuse the island edge bitmap instead
+                    if (canTakeDamage(familyBondHealths[bondIndex]))
+                    {
+                        batch.push(bondIndex, currentNodeIndex, adjacentNodeIndex);
+                    }
                 }
             }
             currentNodeIndex = graphNodeIndexLinks[currentNodeIndex];
         }
     }
 
+    batch.flush();
+
     commandBuffers->bondFractureCount = outCount;
     commandBuffers->chunkFractureCount = 0;
 }
@@ -264,7 +277,7 @@ void RadialProfileGraphShader(NvBlastFractureBuffers* commandBuffers, const NvBl
 //                                          Radial Single Shader Template
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-template <DamageFunction damageFn>
+template <BatchDamageFunction damageFn>
 void RadialProfileSubgraphShader(NvBlastFractureBuffers* commandBuffers, const NvBlastSubgraphShaderActor* actor, const void* params)
 {
     uint32_t chunkFractureCount = 0;
@@ -274,7 +287,8 @@ void RadialProfileSubgraphShader(NvBlastFractureBuffers* commandBuffers, const N
     const NvBlastChunk& chunk = assetChunks[chunkIndex];
     const NvBlastExtProgramParams* programParams = static_cast<const NvBlastExtProgramParams*>(params);
 
-    const float totalDamage = damageFn(chunk.centroid, programParams->damageDesc);
+    float totalDamage;
+    damageFn(&chunk.centroid[0], &chunk.centroid[1], &chunk.centroid[2], 1, programParams->damageDesc, programParams->damageDescCount, &totalDamage);
     if (totalDamage > 0.0f && chunkFractureCount < chunkFractureCountMax)
     {
         NvBlastChunkFractureData& frac = commandBuffers->chunkFractures[chunkFractureCount++];
@@ -293,32 +307,32 @@ void RadialProfileSubgraphShader(NvBlastFractureBuffers* commandBuffers, const N
 
 void NvBlastExtFalloffGraphShader(NvBlastFractureBuffers* commandBuffers, const NvBlastGraphShaderActor* actor, const void* params)
 {
-    RadialProfileGraphShader<pointDistanceDamage<falloffProfile>, sphereBounds>(commandBuffers, actor, params);
+    RadialProfileGraphShader<pointDistanceDamageBatch<true>, sphereBounds, NvBlastExtRadialDamageDesc>(commandBuffers, actor, params);
 }
 
 void NvBlastExtFalloffSubgraphShader(NvBlastFractureBuffers* commandBuffers, const NvBlastSubgraphShaderActor* actor, const void* params)
 {
-    RadialProfileSubgraphShader<pointDistanceDamage<falloffProfile>>(commandBuffers, actor, params);
+    RadialProfileSubgraphShader<pointDistanceDamageBatch<true>>(commandBuffers, actor, params);
 }
 
 void NvBlastExtCutterGraphShader(NvBlastFractureBuffers* commandBuffers, const NvBlastGraphShaderActor* actor, const void* params)
 {
-    RadialProfileGraphShader<pointDistanceDamage<cutterProfile>, sphereBounds>(commandBuffers, actor, params);
+    RadialProfileGraphShader<pointDistanceDamageBatch<false>, sphereBounds, NvBlastExtRadialDamageDesc>(commandBuffers, actor, params);
 }
 
 void NvBlastExtCutterSubgraphShader(NvBlastFractureBuffers* commandBuffers, const NvBlastSubgraphShaderActor* actor, const void* params)
 {
-    RadialProfileSubgraphShader<pointDistanceDamage<cutterProfile>>(commandBuffers, actor, params);
+    RadialProfileSubgraphShader<pointDistanceDamageBatch<false>>(commandBuffers, actor, params);
 }
 
 void NvBlastExtCapsuleFalloffGraphShader(NvBlastFractureBuffers* commandBuffers, const NvBlastGraphShaderActor* actor, const void* params)
 {
-    RadialProfileGraphShader<capsuleDistanceDamage<falloffProfile>, capsuleBounds>(commandBuffers, actor, params);
+    RadialProfileGraphShader<batchDamage<capsuleDistanceDamage<falloffProfile>, NvBlastExtCapsuleRadialDamageDesc>, capsuleBounds, NvBlastExtCapsuleRadialDamageDesc>(commandBuffers, actor, params);
 }
 
 void NvBlastExtCapsuleFalloffSubgraphShader(NvBlastFractureBuffers* commandBuffers, const NvBlastSubgraphShaderActor* actor, const void* params)
 {
-    RadialProfileSubgraphShader<capsuleDistanceDamage<falloffProfile>>(commandBuffers, actor, params);
+    RadialProfileSubgraphShader<batchDamage<capsuleDistanceDamage<falloffProfile>, NvBlastExtCapsuleRadialDamageDesc>>(commandBuffers, actor, params);
 }
 
 
@@ -414,7 +428,7 @@ void NvBlastExtShearGraphShader(NvBlastFractureBuffers* commandBuffers, const Nv
 
 void NvBlastExtShearSubgraphShader(NvBlastFractureBuffers* commandBuffers, const NvBlastSubgraphShaderActor* actor, const void* params)
 {
-    RadialProfileSubgraphShader<pointDistanceDamage<falloffProfile, NvBlastExtShearDamageDesc>>(commandBuffers, actor, params);
+    RadialProfileSubgraphShader<batchDamage<pointDistanceDamage<falloffProfile, NvBlastExtShearDamageDesc>, NvBlastExtShearDamageDesc>>(commandBuffers, actor, params);
 }
 
 
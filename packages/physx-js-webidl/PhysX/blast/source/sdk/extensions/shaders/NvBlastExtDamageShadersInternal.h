@@ -0,0 +1,193 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2024 NVIDIA Corporation. All rights reserved.
+
+#pragma once
+
+#include "NvBlastExtDamageShaders.h"
+#include "NvBlastMath.h"
+#include "NvPreprocessor.h"
+#include <cmath>
+
+#if NV_SSE2
+#include <xmmintrin.h>
+#endif
+
+
+namespace Nv
+{
+namespace Blast
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                  Profiles
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef float(*ProfileFunction)(float, float, float, float);
+
+inline float falloffProfile(float min, float max, float x, float f = 1.0f)
+{
+    if (x > max) return 0.0f;
+    if (x < min) return f;
+
+    float y = 1.0f - (x - min) / (max - min);
+    return y * f;
+}
+
+inline float cutterProfile(float min, float max, float x, float f = 1.0f)
+{
+    if (x > max || x < min) return 0.0f;
+
+    return f;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                  Damage Functions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef float(*DamageFunction)(const float pos[3], const void* damageDescBuffer);
+
+template <ProfileFunction profileFn, typename DescT = NvBlastExtRadialDamageDesc>
+float pointDistanceDamage(const float pos[3], const void* damageDescBuffer)
+{
+    const DescT& desc = *static_cast<const DescT*>(damageDescBuffer);
+
+    float relativePosition[3];
+    VecMath::sub(desc.position, pos, relativePosition);
+    const float distance = sqrtf(VecMath::dot(relativePosition, relativePosition));
+    const float damage = profileFn(desc.minRadius, desc.maxRadius, distance, desc.damage);
+    return damage;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                              Batch Damage Functions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+Evaluates the summed damage of 'damageDescCount' damage descs at 'count' points given in SoA layout.
+*/
+typedef void(*BatchDamageFunction)(const float* x, const float* y, const float* z, uint32_t count, const void* damageDescs, uint32_t damageDescCount, float* damage);
+
+template <DamageFunction damageFn, typename DescT>
+void batchDamage(const float* x, const float* y, const float* z, uint32_t count, const void* damageDescs, uint32_t damageDescCount, float* damage)
+{
+    const DescT* descs = static_cast<const DescT*>(damageDescs);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const float pos[3] = { x[i], y[i], z[i] };
+        float totalDamage = 0.0f;
+        for (uint32_t d = 0; d < damageDescCount; d++)
+        {
+            totalDamage += damageFn(pos, descs + d);
+        }
+        damage[i] = totalDamage;
+    }
+}
+
+/**
+Point radial damage, branch-free over the points so that every desc is evaluated 4 points at a time.
+Falloff is clamp(1 - (distance - minRadius) / (maxRadius - minRadius), 0, 1) masked by distance < maxRadius,
+cutter is the [minRadius, maxRadius] mask. Both give the same bonds as falloffProfile and cutterProfile.
+
+'simd' selects the SSE2 kernel, it is only there so that tests can run the scalar path on SSE2 targets.
+*/
+template <bool falloff, bool simd = NV_SSE2 != 0>
+void pointDistanceDamageBatch(const float* x, const float* y, const float* z, uint32_t count, const void* damageDescs, uint32_t damageDescCount, float* damage)
+{
+    const NvBlastExtRadialDamageDesc* descs = static_cast<const NvBlastExtRadialDamageDesc*>(damageDescs);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        damage[i] = 0.0f;
+    }
+
+    for (uint32_t d = 0; d < damageDescCount; d++)
+    {
+        const NvBlastExtRadialDamageDesc& desc = descs[d];
+        const float minRadius = desc.minRadius;
+        const float maxRadius = desc.maxRadius;
+        const float invRange = maxRadius > minRadius ? 1.0f / (maxRadius - minRadius) : 0.0f;
+
+        uint32_t i = 0;
+#if NV_SSE2
+        if (simd)
+        {
+            const __m128 px = _mm_set1_ps(desc.position[0]);
+            const __m128 py = _mm_set1_ps(desc.position[1]);
+            const __m128 pz = _mm_set1_ps(desc.position[2]);
+            const __m128 vMin = _mm_set1_ps(minRadius);
+            const __m128 vMax = _mm_set1_ps(maxRadius);
+            const __m128 vInvRange = _mm_set1_ps(invRange);
+            const __m128 vDamage = _mm_set1_ps(desc.damage);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), px);
+                const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), py);
+                const __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), pz);
+                const __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+                __m128 value;
+                if (falloff)
+                {
+                    value = _mm_sub_ps(one, _mm_mul_ps(_mm_sub_ps(distance, vMin), vInvRange));
+                    value = _mm_min_ps(_mm_max_ps(value, zero), one);
+                    value = _mm_and_ps(value, _mm_cmplt_ps(distance, vMax));
+                }
+                else
+                {
+                    value = _mm_and_ps(one, _mm_and_ps(_mm_cmpge_ps(distance, vMin), _mm_cmple_ps(distance, vMax)));
+                }
+                _mm_storeu_ps(damage + i, _mm_add_ps(_mm_loadu_ps(damage + i), _mm_mul_ps(value, vDamage)));
+            }
+        }
+#endif
+        for (; i < count; i++)
+        {
+            const float dx = x[i] - desc.position[0];
+            const float dy = y[i] - desc.position[1];
+            const float dz = z[i] - desc.position[2];
+            const float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+            float value;
+            if (falloff)
+            {
+                value = 1.0f - (distance - minRadius) * invRange;
+                value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+                // falloffProfile is 0 at maxRadius, where the reciprocal can leave a residue
+                value = distance < maxRadius ? value : 0.0f;
+            }
+            else
+            {
+                value = distance >= minRadius && distance <= maxRadius ? 1.0f : 0.0f;
+            }
+            damage[i] += value * desc.damage;
+        }
+    }
+}
+
+} // namespace Blast
+} // namespace Nv
@@ -34,6 +34,12 @@
 #define _mm256_set_m128(vh, vl) _mm256_insertf128_ps(_mm256_castps128_ps256(vl), (vh), 1)
 #endif
 
+#if defined(__EMSCRIPTEN__) && !defined(__FMA__)   // wasm SIMD128 has no fused multiply-add, emulated unfused
+#define _mm256_fmadd_ps(a, b, c) _mm256_add_ps(_mm256_mul_ps((a), (b)), (c))
+#define _mm256_fmsub_ps(a, b, c) _mm256_sub_ps(_mm256_mul_ps((a), (b)), (c))
+#define _mm256_fnmadd_ps(a, b, c) _mm256_sub_ps((c), _mm256_mul_ps((a), (b)))
+#endif
+
 
 #define SIMD_ALIGN_16(code) NV_ALIGN_PREFIX(16) code NV_ALIGN_SUFFIX(16)
 #define SIMD_ALIGN_32(code) NV_ALIGN_PREFIX(32) code NV_ALIGN_SUFFIX(32)
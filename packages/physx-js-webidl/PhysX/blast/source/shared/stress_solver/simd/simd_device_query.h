@@ -87,6 +87,15 @@ constexpr std::pair<const char*, uint32_t> sInstructionSetLookup[] =
 };
 
 
+#if defined(__EMSCRIPTEN__)
+// No cpuid in WebAssembly. Emscripten lowers the SSE/AVX intrinsics to wasm SIMD128 and simd.h emulates the FMA ones,
+// so every instruction set is available once the module is built with SIMD128.
+#if !defined(__wasm_simd128__) || !defined(__AVX__)
+#error "The stress solver must be built with -msimd128 -mavx for WebAssembly"
+#endif
+static bool device_supports_instruction_set(uint32_t) { return true; }
+inline bool os_supports_avx_restore() { return true; }
+#else
 #if NV_WINDOWS_FAMILY
 #include <intrin.h> // for __cpuidex
 inline void cpuid(int cpui[4], int fn) { __cpuidex(cpui, fn, 0); }
@@ -118,6 +127,8 @@ device_supports_instruction_set(uint32_t inst_set)
     return !!((cpui[bitset] >> bit) & 1);
 }
 
+#endif
+
 static void
 print_supported_instruction_sets()
 {
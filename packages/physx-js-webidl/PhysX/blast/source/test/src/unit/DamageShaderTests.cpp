@@ -0,0 +1,399 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2024 NVIDIA Corporation. All rights reserved.
+
+
+
+#include "BlastBaseTest.h"
+#include "TestAssets.h"
+#include "NvBlastExtDamageShaders.h"
+#include "NvBlastExtDamageShadersInternal.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                  Utils / Tests Common
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace Nv::Blast;
+
+typedef std::map<std::pair<uint32_t, uint32_t>, float> BondDamageMap;
+
+class DamageShaderTest : public BlastBaseTest < NvBlastMessage::Error, 1 >
+{
+public:
+    DamageShaderTest() : m_asset(nullptr), m_family(nullptr), m_actor(nullptr)
+    {
+    }
+
+    ~DamageShaderTest()
+    {
+        alignedFree(m_family);
+        alignedFree(m_asset);
+    }
+
+    // width^3 support chunks, 3 * width^2 * (width - 1) bonds
+    void createCubeActor(size_t width)
+    {
+        NvBlastAssetDesc assetDesc;
+        generateCube(m_cube, assetDesc, 2, width);
+
+        std::vector<char> scratch((size_t)NvBlastGetRequiredScratchForCreateAsset(&assetDesc, messageLog));
+        void* amem = alignedZeroedAlloc(NvBlastGetAssetMemorySize(&assetDesc, messageLog));
+        m_asset = NvBlastCreateAsset(amem, &assetDesc, scratch.data(), messageLog);
+        ASSERT_TRUE(m_asset != nullptr);
+
+        NvBlastActorDesc actorDesc;
+        actorDesc.initialBondHealths = actorDesc.initialSupportChunkHealths = nullptr;
+        actorDesc.uniformInitialBondHealth = actorDesc.uniformInitialLowerSupportChunkHealth = 1.0f;
+        void* fmem = alignedZeroedAlloc(NvBlastAssetGetFamilyMemorySize(m_asset, messageLog));
+        m_family = NvBlastAssetCreateFamily(fmem, m_asset, messageLog);
+        scratch.resize((size_t)NvBlastFamilyGetRequiredScratchForCreateFirstActor(m_family, messageLog));
+        m_actor = NvBlastFamilyCreateFirstActor(m_family, &actorDesc, scratch.data(), messageLog);
+        ASSERT_TRUE(m_actor != nullptr);
+    }
+
+    uint32_t bondCount() const
+    {
+        return NvBlastAssetGetBondCount(m_asset, messageLog);
+    }
+
+    // Runs the graph shader and returns its bond fracture commands keyed by the sorted node pair
+    BondDamageMap generateFracture(NvBlastGraphShaderFunction shader, const NvBlastExtProgramParams& params)
+    {
+        std::vector<NvBlastBondFractureData> bondFractures(bondCount());
+        NvBlastFractureBuffers commands;
+        commands.bondFractureCount = (uint32_t)bondFractures.size();
+        commands.bondFractures = bondFractures.data();
+        commands.chunkFractureCount = 0;
+        commands.chunkFractures = nullptr;
+
+        const NvBlastDamageProgram program = { shader, nullptr };
+        NvBlastActorGenerateFracture(&commands, m_actor, program, &params, messageLog, nullptr);
+        EXPECT_EQ(0, commands.chunkFractureCount);
+
+        BondDamageMap result;
+        for (uint32_t i = 0; i < commands.bondFractureCount; i++)
+        {
+            const NvBlastBondFractureData& command = commands.bondFractures[i];
+            const std::pair<uint32_t, uint32_t> key(std::min(command.nodeIndex0, command.nodeIndex1), std::max(command.nodeIndex0, command.nodeIndex1));
+            EXPECT_TRUE(result.find(key) == result.end());
+            result[key] = command.health;
+        }
+        return result;
+    }
+
+    // The commands the shaders generated before batching: one pointDistanceDamage call per bond and desc
+    template <ProfileFunction profileFn>
+    BondDamageMap referenceFracture(const NvBlastExtRadialDamageDesc* descs, uint32_t descCount) const
+    {
+        const NvBlastSupportGraph graph = NvBlastAssetGetSupportGraph(m_asset, messageLog);
+        const NvBlastBond* bonds = NvBlastAssetGetBonds(m_asset, messageLog);
+
+        BondDamageMap result;
+        for (uint32_t node = 0; node < graph.nodeCount; node++)
+        {
+            for (uint32_t adj = graph.adjacencyPartition[node]; adj < graph.adjacencyPartition[node + 1]; adj++)
+            {
+                const uint32_t adjacentNode = graph.adjacentNodeIndices[adj];
+                if (node < adjacentNode)
+                {
+                    float damage = 0.0f;
+                    for (uint32_t d = 0; d < descCount; d++)
+                    {
+                        damage += pointDistanceDamage<profileFn>(bonds[graph.adjacentBondIndices[adj]].centroid, descs + d);
+                    }
+                    if (damage > 0.0f)
+                    {
+                        result[std::make_pair(node, adjacentNode)] = damage;
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+protected:
+    GeneratorAsset  m_cube;
+    NvBlastAsset*   m_asset;
+    NvBlastFamily*  m_family;
+    NvBlastActor*   m_actor;
+};
+
+static void expectSameBonds(const BondDamageMap& expected, const BondDamageMap& actual, float tolerance)
+{
+    EXPECT_EQ(expected.size(), actual.size());
+    for (BondDamageMap::const_iterator it = expected.begin(); it != expected.end(); ++it)
+    {
+        BondDamageMap::const_iterator found = actual.find(it->first);
+        ASSERT_TRUE(found != actual.end()) << "missing bond " << it->first.first << "-" << it->first.second;
+        EXPECT_NEAR(it->second, found->second, tolerance);
+    }
+}
+
+struct PointSet
+{
+    std::vector<float> x, y, z;
+
+    // Random points around the origin, plus points exactly at 'radii' along the axes
+    PointSet(uint32_t count, const std::vector<float>& radii)
+    {
+        srand(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (i < radii.size() * 3)
+            {
+                const float r = radii[i / 3];
+                x.push_back(i % 3 == 0 ? r : 0.0f);
+                y.push_back(i % 3 == 1 ? -r : 0.0f);
+                z.push_back(i % 3 == 2 ? r : 0.0f);
+            }
+            else
+            {
+                x.push_back(8.0f * rand() / RAND_MAX - 4.0f);
+                y.push_back(8.0f * rand() / RAND_MAX - 4.0f);
+                z.push_back(8.0f * rand() / RAND_MAX - 4.0f);
+            }
+        }
+    }
+};
+
+static const uint32_t s_pointCounts[] = { 1, 3, 4, 5, 7, 255, 256, 257, 1023 };
+
+static const NvBlastExtRadialDamageDesc s_radialDescs[] =
+{
+    //  damage  position                min     max
+    {   1.0f,   { 0.0f, 0.0f, 0.0f },   1.0f,   3.0f },
+    {   0.5f,   { 0.5f, -1.0f, 0.25f }, 0.0f,   2.0f },
+    {   2.0f,   { -1.0f, 1.0f, 1.0f },  1.5f,   1.75f },
+    // 1 - maxRadius * (1 / maxRadius) leaves a residue
+    {   1.0f,   { 0.0f, 0.0f, 0.0f },   0.0f,   1.7f },
+};
+static const uint32_t s_radialDescCount = sizeof(s_radialDescs) / sizeof(s_radialDescs[0]);
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                              Batch Damage Functions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <bool falloff, ProfileFunction profileFn>
+static void testPointDistanceDamageBatch()
+{
+    const std::vector<float> radii = { 0.0f, 1.0f, 1.5f, 1.7f, 2.0f, 3.0f, 4.0f };
+
+    for (uint32_t count : s_pointCounts)
+    {
+        const PointSet points(count, radii);
+        // every contiguous range of descs, so that single descs are checked without the others' damage
+        for (uint32_t first = 0; first < s_radialDescCount; first++)
+        for (uint32_t descCount = 0; first + descCount <= s_radialDescCount; descCount++)
+        {
+            const NvBlastExtRadialDamageDesc* descs = s_radialDescs + first;
+            std::vector<float> simd(count, -1.0f), scalar(count, -1.0f), reference(count, -1.0f);
+            pointDistanceDamageBatch<falloff, true>(points.x.data(), points.y.data(), points.z.data(), count, descs, descCount, simd.data());
+            pointDistanceDamageBatch<falloff, false>(points.x.data(), points.y.data(), points.z.data(), count, descs, descCount, scalar.data());
+            batchDamage<pointDistanceDamage<profileFn>, NvBlastExtRadialDamageDesc>(points.x.data(), points.y.data(), points.z.data(), count, descs, descCount, reference.data());
+
+            for (uint32_t i = 0; i < count; i++)
+            {
+                EXPECT_FLOAT_EQ(scalar[i], simd[i]) << "count " << count << ", descs " << first << "+" << descCount << ", point " << i;
+                EXPECT_NEAR(reference[i], scalar[i], 1e-5f) << "count " << count << ", descs " << first << "+" << descCount << ", point " << i;
+                // a bond gets a fracture command when its damage is positive
+                EXPECT_EQ(reference[i] > 0.0f, scalar[i] > 0.0f) << "count " << count << ", descs " << first << "+" << descCount << ", point " << i;
+                EXPECT_EQ(reference[i] > 0.0f, simd[i] > 0.0f) << "count " << count << ", descs " << first << "+" << descCount << ", point " << i;
+            }
+        }
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                      Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DamageShaderTest, FalloffBatchMatchesProfile)
+{
+    testPointDistanceDamageBatch<true, falloffProfile>();
+}
+
+TEST_F(DamageShaderTest, CutterBatchMatchesProfile)
+{
+    testPointDistanceDamageBatch<false, cutterProfile>();
+}
+
+TEST_F(DamageShaderTest, GraphShadersMatchPerBondProfile)
+{
+    // 882 bonds: 3 full blocks of 256 and a tail that is not a multiple of 4
+    createCubeActor(7);
+    ASSERT_EQ(882, bondCount());
+
+    for (int acceleratorType = 0; acceleratorType <= 1; acceleratorType++)
+    {
+        NvBlastExtDamageAccelerator* accelerator = NvBlastExtDamageAcceleratorCreate(m_asset, acceleratorType);
+        EXPECT_EQ(acceleratorType != 0, accelerator != nullptr);
+
+        for (uint32_t d = 0; d < s_radialDescCount; d++)
+        {
+            const NvBlastExtRadialDamageDesc desc = s_radialDescs[d];
+            const NvBlastExtProgramParams params(&desc, nullptr, accelerator);
+
+            expectSameBonds(referenceFracture<falloffProfile>(&desc, 1), generateFracture(NvBlastExtFalloffGraphShader, params), 1e-5f);
+            expectSameBonds(referenceFracture<cutterProfile>(&desc, 1), generateFracture(NvBlastExtCutterGraphShader, params), 0.0f);
+        }
+
+        // covers the whole cube, so every bond is damaged
+        const NvBlastExtRadialDamageDesc wide = { 1.0f, { 0.0f, 0.0f, 0.0f }, 0.25f, 2.0f };
+        const NvBlastExtProgramParams params(&wide, nullptr, accelerator);
+        const BondDamageMap all = generateFracture(NvBlastExtFalloffGraphShader, params);
+        EXPECT_EQ(bondCount(), all.size());
+        expectSameBonds(referenceFracture<falloffProfile>(&wide, 1), all, 1e-5f);
+
+        if (accelerator)
+        {
+            accelerator->release();
+        }
+    }
+}
+
+TEST_F(DamageShaderTest, GraphShadersSumDamageDescs)
+{
+    createCubeActor(8);
+    EXPECT_LT(256u, bondCount());
+
+    const NvBlastExtRadialDamageDesc descs[] =
+    {
+        { 1.0f, { -0.3f, -0.3f, -0.3f }, 0.1f, 0.5f },
+        { 0.5f, { 0.2f, 0.1f, 0.3f },    0.2f, 0.6f },
+        { 2.0f, { 0.4f, -0.4f, 0.0f },   0.0f, 0.3f },
+    };
+    const uint32_t descCount = sizeof(descs) / sizeof(descs[0]);
+
+    for (int acceleratorType = 0; acceleratorType <= 1; acceleratorType++)
+    {
+        NvBlastExtDamageAccelerator* accelerator = NvBlastExtDamageAcceleratorCreate(m_asset, acceleratorType);
+
+        const NvBlastGraphShaderFunction shaders[] = { NvBlastExtFalloffGraphShader, NvBlastExtCutterGraphShader };
+        for (NvBlastGraphShaderFunction shader : shaders)
+        {
+            BondDamageMap summed;
+            for (uint32_t d = 0; d < descCount; d++)
+            {
+                const BondDamageMap single = generateFracture(shader, NvBlastExtProgramParams(descs + d, nullptr, accelerator));
+                EXPECT_FALSE(single.empty());
+                for (BondDamageMap::const_iterator it = single.begin(); it != single.end(); ++it)
+                {
+                    summed[it->first] += it->second;
+                }
+            }
+
+            expectSameBonds(summed, generateFracture(shader, NvBlastExtProgramParams(descs, nullptr, accelerator, descCount)), 1e-6f);
+        }
+
+        expectSameBonds(referenceFracture<falloffProfile>(descs, descCount), generateFracture(NvBlastExtFalloffGraphShader, NvBlastExtProgramParams(descs, nullptr, accelerator, descCount)), 1e-5f);
+        expectSameBonds(referenceFracture<cutterProfile>(descs, descCount), generateFracture(NvBlastExtCutterGraphShader, NvBlastExtProgramParams(descs, nullptr, accelerator, descCount)), 0.0f);
+
+        if (accelerator)
+        {
+            accelerator->release();
+        }
+    }
+}
+
+TEST_F(DamageShaderTest, ProgramParamsDescCount)
+{
+    createCubeActor(7);
+
+    const NvBlastExtRadialDamageDesc desc = { 1.0f, { 0.0f, 0.0f, 0.0f }, 0.2f, 0.6f };
+
+    // existing callers brace-initialize the first two members and get a single desc
+    NvBlastExtProgramParams braced = { &desc, nullptr };
+    EXPECT_EQ(1u, braced.damageDescCount);
+    EXPECT_TRUE(braced.accelerator == nullptr);
+
+    const NvBlastExtProgramParams one(&desc, nullptr, nullptr, 1);
+    const BondDamageMap expected = generateFracture(NvBlastExtFalloffGraphShader, one);
+    EXPECT_FALSE(expected.empty());
+    expectSameBonds(expected, generateFracture(NvBlastExtFalloffGraphShader, braced), 0.0f);
+
+    // no descs, no damage
+    const NvBlastExtProgramParams none(&desc, nullptr, nullptr, 0);
+    EXPECT_TRUE(generateFracture(NvBlastExtFalloffGraphShader, none).empty());
+    EXPECT_TRUE(generateFracture(NvBlastExtCutterGraphShader, none).empty());
+
+    NvBlastExtDamageAccelerator* accelerator = NvBlastExtDamageAcceleratorCreate(m_asset, 1);
+    const NvBlastExtProgramParams noneAccelerated(&desc, nullptr, accelerator, 0);
+    EXPECT_TRUE(generateFracture(NvBlastExtFalloffGraphShader, noneAccelerated).empty());
+    accelerator->release();
+}
+
+TEST_F(DamageShaderTest, SubgraphShadersSumDamageDescs)
+{
+    NvBlastChunk chunk;
+    memset(&chunk, 0, sizeof(chunk));
+    chunk.centroid[0] = 0.5f;
+
+    NvBlastSubgraphShaderActor actor;
+    actor.chunkIndex = 0;
+    actor.assetChunks = &chunk;
+
+    const NvBlastSubgraphShaderFunction shaders[] = { NvBlastExtFalloffSubgraphShader, NvBlastExtCutterSubgraphShader };
+    for (NvBlastSubgraphShaderFunction shader : shaders)
+    {
+        float expected = 0.0f;
+        for (uint32_t descCount = 0; descCount <= s_radialDescCount; descCount++)
+        {
+            NvBlastChunkFractureData chunkFracture;
+            NvBlastFractureBuffers commands;
+            commands.bondFractureCount = 0;
+            commands.bondFractures = nullptr;
+            commands.chunkFractureCount = 1;
+            commands.chunkFractures = &chunkFracture;
+
+            const NvBlastExtProgramParams params(s_radialDescs, nullptr, nullptr, descCount);
+            shader(&commands, &actor, &params);
+
+            if (descCount > 0)
+            {
+                expected += shader == NvBlastExtFalloffSubgraphShader ?
+                    pointDistanceDamage<falloffProfile>(chunk.centroid, s_radialDescs + descCount - 1) :
+                    pointDistanceDamage<cutterProfile>(chunk.centroid, s_radialDescs + descCount - 1);
+            }
+
+            if (expected > 0.0f)
+            {
+                ASSERT_EQ(1, commands.chunkFractureCount);
+                EXPECT_EQ(0, chunkFracture.chunkIndex);
+                EXPECT_NEAR(expected, chunkFracture.health, 1e-5f);
+            }
+            else
+            {
+                EXPECT_EQ(0, commands.chunkFractureCount);
+            }
+        }
+    }
+}
@@ -0,0 +1,339 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2024 NVIDIA Corporation. All rights reserved.
+
+
+#include "TkBaseTest.h"
+#include "NvBlastExtPxCpuDispatcher.h"
+
+#include "PxPhysicsAPI.h"
+
+#include <chrono>
+#include <set>
+#include <string>
+#include <vector>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                  Utils / Tests Common
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Forwards to a PhysX dispatcher, recording the tasks it receives
+class CountingPxCpuDispatcher : public physx::PxCpuDispatcher
+{
+public:
+    CountingPxCpuDispatcher(physx::PxCpuDispatcher& dispatcher) : submitCount(0), m_dispatcher(dispatcher) {}
+
+    virtual void submitTask(physx::PxBaseTask& task) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.insert(&task);
+            names.insert(task.getName());
+        }
+        ++submitCount;
+        m_dispatcher.submitTask(task);
+    }
+
+    virtual uint32_t getWorkerCount() const override
+    {
+        return m_dispatcher.getWorkerCount();
+    }
+
+    std::atomic<uint32_t>           submitCount;
+    std::mutex                      mutex;
+    std::set<physx::PxBaseTask*>    tasks;  // distinct task wrappers seen
+    std::set<std::string>           names;
+
+private:
+    physx::PxCpuDispatcher&         m_dispatcher;
+};
+
+
+struct TaskCounters
+{
+    TaskCounters() : runCount(0), callerThreadRunCount(0), releaseCount(0), gateOpen(true), callerThread(std::this_thread::get_id()) {}
+
+    std::atomic<uint32_t>   runCount;
+    std::atomic<uint32_t>   callerThreadRunCount;
+    std::atomic<uint32_t>   releaseCount;
+    std::atomic<bool>       gateOpen;       // tasks wait in run() until the gate opens
+    std::thread::id         callerThread;
+};
+
+
+class CountingTask : public NvBaseTask
+{
+public:
+    CountingTask() : m_counters(nullptr), m_refCount(0), m_releaseCount(0) {}
+
+    void                setCounters(TaskCounters& counters) { m_counters = &counters; }
+
+    uint32_t            getReleaseCount() const { return m_releaseCount; }
+
+    virtual void        run() override
+    {
+        while (!m_counters->gateOpen)
+        {
+            std::this_thread::yield();
+        }
+        if (std::this_thread::get_id() == m_counters->callerThread)
+        {
+            ++m_counters->callerThreadRunCount;
+        }
+        ++m_counters->runCount;
+    }
+
+    virtual const char* getName() const override { return "CountingTask"; }
+
+    virtual void        addReference() override { ++m_refCount; }
+
+    virtual void        removeReference() override { --m_refCount; }
+
+    virtual int32_t     getReference() const override { return m_refCount; }
+
+    virtual void        release() override
+    {
+        ++m_releaseCount;
+        ++m_counters->releaseCount;
+    }
+
+private:
+    TaskCounters*           m_counters;
+    std::atomic<int32_t>    m_refCount;
+    std::atomic<uint32_t>   m_releaseCount;
+};
+
+
+template<int FailLevel, int Verbosity>
+class PxCpuDispatcherTest : public TkBaseTest<FailLevel, Verbosity>
+{
+public:
+    PxCpuDispatcherTest() : m_foundation(nullptr)
+    {
+    }
+
+    virtual void SetUp() override
+    {
+        TkBaseTest<FailLevel, Verbosity>::SetUp();
+        m_foundation = PxCreateFoundation(PX_PHYSICS_VERSION, m_allocator, m_errorCallback);
+        ASSERT_TRUE(m_foundation != nullptr);
+    }
+
+    virtual void TearDown() override
+    {
+        m_foundation->release();
+        TkBaseTest<FailLevel, Verbosity>::TearDown();
+    }
+
+    // Waits for count task releases, fails after a few seconds instead of hanging
+    static bool waitForReleases(const TaskCounters& counters, uint32_t count)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (counters.releaseCount < count)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    physx::PxDefaultAllocator       m_allocator;
+    physx::PxDefaultErrorCallback   m_errorCallback;
+    physx::PxFoundation*            m_foundation;
+};
+
+typedef PxCpuDispatcherTest<NvBlastMessage::Warning, 1> PxCpuDispatcherTestStrict;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                  Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(PxCpuDispatcherTestStrict, TasksRunOnThePhysXWorkers)
+{
+    physx::PxDefaultCpuDispatcher* pxDispatcher = physx::PxDefaultCpuDispatcherCreate(2);
+    ASSERT_TRUE(pxDispatcher != nullptr);
+    CountingPxCpuDispatcher counting(*pxDispatcher);
+    ExtPxCpuDispatcher* dispatcher = ExtPxCpuDispatcher::create(counting);
+    ASSERT_TRUE(dispatcher != nullptr);
+    NvCpuDispatcher& nvDispatcher = dispatcher->getNvCpuDispatcher();
+
+    EXPECT_EQ(2u, nvDispatcher.getWorkerCount());
+
+    const uint32_t taskCount = 64;
+    TaskCounters counters;
+    std::vector<CountingTask> tasks(taskCount);
+    for (CountingTask& task : tasks)
+    {
+        task.setCounters(counters);
+        nvDispatcher.submitTask(task);
+    }
+    ASSERT_TRUE(waitForReleases(counters, taskCount));
+
+    EXPECT_EQ(taskCount, counting.submitCount);
+    EXPECT_EQ(taskCount, counters.runCount);
+    EXPECT_EQ(0u, counters.callerThreadRunCount);
+    for (const CountingTask& task : tasks)
+    {
+        EXPECT_EQ(1u, task.getReleaseCount());
+    }
+
+    // PhysX sees the Blast task names
+    EXPECT_EQ(std::set<std::string>({ "CountingTask" }), counting.names);
+
+    dispatcher->release();
+    pxDispatcher->release();
+}
+
+TEST_F(PxCpuDispatcherTestStrict, TasksRunInlineWithoutWorkers)
+{
+    physx::PxDefaultCpuDispatcher* pxDispatcher = physx::PxDefaultCpuDispatcherCreate(0);
+    ASSERT_TRUE(pxDispatcher != nullptr);
+    ExtPxCpuDispatcher* dispatcher = ExtPxCpuDispatcher::create(*pxDispatcher);
+    NvCpuDispatcher& nvDispatcher = dispatcher->getNvCpuDispatcher();
+
+    EXPECT_EQ(0u, nvDispatcher.getWorkerCount());
+
+    TaskCounters counters;
+    std::vector<CountingTask> tasks(8);
+    for (uint32_t i = 0; i < tasks.size(); ++i)
+    {
+        tasks[i].setCounters(counters);
+        nvDispatcher.submitTask(tasks[i]);
+
+        // run and released before submitTask returns
+        EXPECT_EQ(i + 1, counters.runCount);
+        EXPECT_EQ(i + 1, counters.callerThreadRunCount);
+        EXPECT_EQ(1u, tasks[i].getReleaseCount());
+    }
+
+    dispatcher->release();
+    pxDispatcher->release();
+}
+
+TEST_F(PxCpuDispatcherTestStrict, TaskWrappersArePooled)
+{
+    physx::PxDefaultCpuDispatcher* pxDispatcher = physx::PxDefaultCpuDispatcherCreate(2);
+    CountingPxCpuDispatcher counting(*pxDispatcher);
+    ExtPxCpuDispatcher* dispatcher = ExtPxCpuDispatcher::create(counting);
+    NvCpuDispatcher& nvDispatcher = dispatcher->getNvCpuDispatcher();
+
+    // Tasks held in run() keep their wrappers in flight, so the pool of 2 * workers grows to the task count
+    const uint32_t taskCount = 32;
+    TaskCounters counters;
+    counters.gateOpen = false;
+    std::vector<CountingTask> tasks(taskCount);
+    for (CountingTask& task : tasks)
+    {
+        task.setCounters(counters);
+        nvDispatcher.submitTask(task);
+    }
+    EXPECT_EQ(taskCount, counting.tasks.size());
+    counters.gateOpen = true;
+    ASSERT_TRUE(waitForReleases(counters, taskCount));
+
+    // The next batch reuses the grown pool
+    const std::set<physx::PxBaseTask*> wrappers = counting.tasks;
+    TaskCounters counters2;
+    counters2.gateOpen = false;
+    for (CountingTask& task : tasks)
+    {
+        task.setCounters(counters2);
+        nvDispatcher.submitTask(task);
+    }
+    counters2.gateOpen = true;
+    ASSERT_TRUE(waitForReleases(counters2, taskCount));
+
+    EXPECT_EQ(2 * taskCount, counting.submitCount);
+    EXPECT_EQ(wrappers, counting.tasks);
+    EXPECT_EQ(taskCount, counters2.runCount);
+    for (const CountingTask& task : tasks)
+    {
+        EXPECT_EQ(2u, task.getReleaseCount());
+    }
+
+    dispatcher->release();
+    pxDispatcher->release();
+}
+
+TEST_F(PxCpuDispatcherTestStrict, GroupProcessesOnThePhysXWorkers)
+{
+    this->createFramework();
+    TkFramework* fwk = NvBlastTkFrameworkGet();
+
+    physx::PxDefaultCpuDispatcher* pxDispatcher = physx::PxDefaultCpuDispatcherCreate(2);
+    CountingPxCpuDispatcher counting(*pxDispatcher);
+    ExtPxCpuDispatcher* dispatcher = ExtPxCpuDispatcher::create(counting);
+    NvTaskManager* taskman = NvTaskManager::createTaskManager(*NvBlastGlobalGetErrorCallback(), &dispatcher->getNvCpuDispatcher());
+    ASSERT_TRUE(taskman != nullptr);
+
+    TkGroupDesc gdesc;
+    gdesc.workerCount = taskman->getCpuDispatcher()->getWorkerCount();
+    EXPECT_EQ(2u, gdesc.workerCount);
+    TkGroup* group = fwk->createGroup(gdesc);
+    TkGroupTaskManager* groupTM = TkGroupTaskManager::create(*taskman, group);
+
+    // 64 support chunks each, shattered by the falloff damage
+    const TkAsset* cubeAsset = this->createCubeAsset(2, 4);
+    const uint32_t actorCount = 8;
+    std::vector<TkFamily*> families;
+    for (uint32_t i = 0; i < actorCount; ++i)
+    {
+        TkActor* actor = fwk->createActor(TkActorDesc(cubeAsset));
+        ASSERT_TRUE(actor != nullptr);
+        group->addActor(*actor);
+        families.push_back(&actor->getFamily());
+    }
+
+    NvBlastExtRadialDamageDesc radialDamage = this->getRadialDamageDesc(0, 0, 0);
+    NvBlastExtProgramParams radialDamageParams = { &radialDamage, nullptr };
+    for (TkFamily* family : families)
+    {
+        TkActor* actor;
+        family->getActors(&actor, 1);
+        actor->damage(this->getFalloffProgram(), &radialDamageParams);
+    }
+
+    EXPECT_GT(groupTM->process(), 0u);
+    EXPECT_TRUE(groupTM->wait());
+
+    EXPECT_GT(counting.submitCount, 0u);
+    for (TkFamily* family : families)
+    {
+        EXPECT_EQ(64u, family->getActorCount());
+    }
+
+    groupTM->release();
+    group->release();
+    taskman->release();
+    dispatcher->release();
+    pxDispatcher->release();
+
+    this->releaseFramework();
+}
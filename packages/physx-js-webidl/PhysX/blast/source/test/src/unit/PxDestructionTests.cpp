@@ -0,0 +1,878 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2024 NVIDIA Corporation. All rights reserved.
+
+
+
+#include "BlastBaseTest.h"
+#include "TestAssets.h"
+#include "NvBlastExtPxDestruction.h"
+#include "NvBlastExtDamageShaders.h"
+#include "NvBlastExtStressSolver.h"
+#include "NvBlastIndexFns.h"
+
+#include "PxPhysicsAPI.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <vector>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                  Utils / Tests Common
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace Nv::Blast;
+using namespace physx;
+
+// Fails the test on PhysX errors, warnings are only printed
+class PhysXTestErrorCallback : public PxErrorCallback
+{
+public:
+    virtual void reportError(PxErrorCode::Enum code, const char* message, const char* file, int line) override
+    {
+        if (code & (PxErrorCode::eINVALID_PARAMETER | PxErrorCode::eINVALID_OPERATION | PxErrorCode::eINTERNAL_ERROR | PxErrorCode::eABORT | PxErrorCode::eOUT_OF_MEMORY))
+        {
+            ADD_FAILURE() << "PhysX error in " << file << "(" << line << "): " << message;
+        }
+        else
+        {
+            std::cout << "PhysX message in " << file << "(" << line << "): " << message << "\n";
+        }
+    }
+};
+
+struct BondSlicerParams
+{
+    uint32_t    axis;
+    float       coord;
+};
+
+// Breaks the bonds whose centroid lies on the plane { axis = coord }
+static void BondSlicer(NvBlastFractureBuffers* commandBuffers, const NvBlastGraphShaderActor* actor, const void* params)
+{
+    const BondSlicerParams& p = *static_cast<const BondSlicerParams*>(params);
+
+    uint32_t bondFractureCount = 0;
+    for (uint32_t node = actor->firstGraphNodeIndex; !isInvalidIndex(node); node = actor->graphNodeIndexLinks[node])
+    {
+        for (uint32_t adj = actor->adjacencyPartition[node]; adj < actor->adjacencyPartition[node + 1]; ++adj)
+        {
+            const uint32_t bondIndex = actor->adjacentBondIndices[adj];
+            if (node < actor->adjacentNodeIndices[adj] && actor->assetBonds[bondIndex].centroid[p.axis] == p.coord &&
+                actor->familyBondHealths[bondIndex] > 0.0f && bondFractureCount < commandBuffers->bondFractureCount)
+            {
+                NvBlastBondFractureData& data = commandBuffers->bondFractures[bondFractureCount++];
+                data.userdata = 0;
+                data.nodeIndex0 = node;
+                data.nodeIndex1 = actor->adjacentNodeIndices[adj];
+                data.health = 1.0f;
+            }
+        }
+    }
+
+    commandBuffers->bondFractureCount = bondFractureCount;
+    commandBuffers->chunkFractureCount = 0;
+}
+
+template<int FailLevel, int Verbosity>
+class PxDestructionTest : public BlastBaseTest<FailLevel, Verbosity>
+{
+public:
+    PxDestructionTest() : m_foundation(nullptr), m_physics(nullptr), m_dispatcher(nullptr), m_scene(nullptr), m_material(nullptr),
+        m_asset(nullptr), m_family(nullptr), m_destruction(nullptr), m_stressSolver(nullptr)
+    {
+    }
+
+    virtual void SetUp() override
+    {
+        m_foundation = PxCreateFoundation(PX_PHYSICS_VERSION, m_allocator, m_errorCallback);
+        ASSERT_TRUE(m_foundation != nullptr);
+        m_physics = PxCreatePhysics(PX_PHYSICS_VERSION, *m_foundation, PxTolerancesScale());
+        ASSERT_TRUE(m_physics != nullptr);
+
+        m_dispatcher = PxDefaultCpuDispatcherCreate(0);
+        PxSceneDesc sceneDesc(m_physics->getTolerancesScale());
+        sceneDesc.gravity = PxVec3(0.0f, -10.0f, 0.0f);
+        sceneDesc.cpuDispatcher = m_dispatcher;
+        sceneDesc.filterShader = PxDefaultSimulationFilterShader;
+        m_scene = m_physics->createScene(sceneDesc);
+        ASSERT_TRUE(m_scene != nullptr);
+
+        m_material = m_physics->createMaterial(0.5f, 0.5f, 0.1f);
+    }
+
+    virtual void TearDown() override
+    {
+        if (m_destruction)
+        {
+            m_destruction->release();
+        }
+        if (m_stressSolver)
+        {
+            m_stressSolver->release();
+        }
+        releaseChunkShapes();
+        this->alignedFree(m_family);
+        this->alignedFree(m_asset);
+
+        if (m_material)
+        {
+            m_material->release();
+        }
+        if (m_scene)
+        {
+            m_scene->release();
+        }
+        if (m_dispatcher)
+        {
+            m_dispatcher->release();
+        }
+        if (m_physics)
+        {
+            m_physics->release();
+        }
+        if (m_foundation)
+        {
+            m_foundation->release();
+        }
+    }
+
+    // Cube of width^3 support chunks with an edge of 1, centered on the origin, and a box shape per chunk
+    void createCube(size_t width, CubeAssetGenerator::BondFlags bondFlags = CubeAssetGenerator::ALL_INTERNAL_BONDS)
+    {
+        NvBlastAssetDesc assetDesc;
+        generateCube(m_cube, assetDesc, 2, width, -1, bondFlags);
+
+        std::vector<char> scratch((size_t)NvBlastGetRequiredScratchForCreateAsset(&assetDesc, this->messageLog));
+        void* amem = this->alignedZeroedAlloc(NvBlastGetAssetMemorySize(&assetDesc, this->messageLog));
+        m_asset = NvBlastCreateAsset(amem, &assetDesc, scratch.data(), this->messageLog);
+        ASSERT_TRUE(m_asset != nullptr);
+
+        NvBlastActorDesc actorDesc;
+        actorDesc.initialBondHealths = actorDesc.initialSupportChunkHealths = nullptr;
+        actorDesc.uniformInitialBondHealth = actorDesc.uniformInitialLowerSupportChunkHealth = 1.0f;
+        m_family = NvBlastAssetCreateFamily(this->alignedZeroedAlloc(NvBlastAssetGetFamilyMemorySize(m_asset, this->messageLog)), m_asset, this->messageLog);
+        scratch.resize((size_t)NvBlastFamilyGetRequiredScratchForCreateFirstActor(m_family, this->messageLog));
+        ASSERT_TRUE(NvBlastFamilyCreateFirstActor(m_family, &actorDesc, scratch.data(), this->messageLog) != nullptr);
+
+        const uint32_t chunkCount = NvBlastAssetGetChunkCount(m_asset, this->messageLog);
+        m_shapes.resize(chunkCount);
+        m_chunkShapes.resize(chunkCount);
+        for (uint32_t i = 0; i < chunkCount; ++i)
+        {
+            const GeneratorAsset::BlastChunkCube& chunk = m_cube.chunks[i];
+            m_shapes[i] = m_physics->createShape(PxBoxGeometry(chunk.extents.x * 0.5f, chunk.extents.y * 0.5f, chunk.extents.z * 0.5f), *m_material, false);
+            m_shapes[i]->setLocalPose(PxTransform(PxVec3(chunk.position.x, chunk.position.y, chunk.position.z)));
+            m_chunkShapes[i].shapes = &m_shapes[i];
+            m_chunkShapes[i].shapeCount = 1;
+        }
+    }
+
+    void releaseChunkShapes()
+    {
+        for (PxShape* shape : m_shapes)
+        {
+            shape->release();
+        }
+        m_shapes.clear();
+    }
+
+    ExtPxDestructionDesc destructionDesc() const
+    {
+        ExtPxDestructionDesc desc;
+        desc.physics = m_physics;
+        desc.scene = m_scene;
+        desc.family = m_family;
+        desc.chunkShapes = m_chunkShapes.data();
+        return desc;
+    }
+
+    void createDestruction(const ExtPxDestructionDesc& desc)
+    {
+        m_destruction = ExtPxDestruction::create(desc);
+        ASSERT_TRUE(m_destruction != nullptr);
+    }
+
+    // Stress solver of the family, bonds break above fatalLimit
+    void createStressSolver(float elasticLimit, float fatalLimit)
+    {
+        ExtStressSolverSettings settings;
+        settings.compressionElasticLimit = elasticLimit;
+        settings.compressionFatalLimit = fatalLimit;
+        m_stressSolver = ExtStressSolver::create(*m_family, settings);
+        ASSERT_TRUE(m_stressSolver != nullptr);
+        m_stressSolver->setAllNodesInfoFromLL();
+    }
+
+    // Contact report of a PhysX actor of the bridge against a removed actor
+    static PxContactReportRecord contactReport(const PxRigidActor& actor, const PxVec3& point, const PxVec3& impulse)
+    {
+        PxContactReportRecord record;
+        record.userIndex0 = (uint32_t)(size_t)actor.userData;
+        record.userIndex1 = PX_INVALID_U32;
+        record.events = PxPairFlag::eNOTIFY_TOUCH_PERSISTS;
+        record.nbContacts = 1;
+        record.impulse = impulse;
+        record.point = point;
+        return record;
+    }
+
+    // Reports the contacts and steps the solver every frame until it fractures the family, returns the new actor count
+    uint32_t pushUntilBroken(const std::vector<PxContactReportRecord>& records, uint32_t maxFrameCount, float dt = 1.0f / 60.0f)
+    {
+        for (uint32_t i = 0; i < maxFrameCount; ++i)
+        {
+            m_destruction->addContactReports(records.data(), (uint32_t)records.size());
+            const uint32_t newActorCount = m_destruction->updateStress(dt);
+            if (newActorCount > 0)
+            {
+                return newActorCount;
+            }
+        }
+        return 0;
+    }
+
+    std::vector<NvBlastActor*> getActors() const
+    {
+        std::vector<NvBlastActor*> actors(NvBlastFamilyGetActorCount(m_family, this->messageLog));
+        NvBlastFamilyGetActors(actors.data(), (uint32_t)actors.size(), m_family, this->messageLog);
+        return actors;
+    }
+
+    std::vector<uint32_t> getVisibleChunks(const NvBlastActor& actor) const
+    {
+        std::vector<uint32_t> chunks(NvBlastActorGetVisibleChunkCount(&actor, this->messageLog));
+        NvBlastActorGetVisibleChunkIndices(chunks.data(), (uint32_t)chunks.size(), &actor, this->messageLog);
+        return chunks;
+    }
+
+    std::vector<ExtPxDebris> getDebris() const
+    {
+        std::vector<ExtPxDebris> debris(m_destruction->getDebrisCount());
+        EXPECT_EQ(debris.size(), m_destruction->getDebris(debris.data(), (uint32_t)debris.size()));
+        return debris;
+    }
+
+    // World position of the center of a debris particle
+    PxVec3 getDebrisCenter(const ExtPxDebris& debris) const
+    {
+        const PxTransform pose(PxVec3(debris.pose.p.x, debris.pose.p.y, debris.pose.p.z), PxQuat(debris.pose.q.x, debris.pose.q.y, debris.pose.q.z, debris.pose.q.w));
+        const NvBlastActor* actor = NvBlastFamilyGetActorByIndex(m_family, debris.actorIndex, this->messageLog);
+        PxVec3 localCenter(0.0f);
+        float volume = 0.0f;
+        for (uint32_t chunk : getVisibleChunks(*actor))
+        {
+            const GeneratorAsset::BlastChunkCube& cube = m_cube.chunks[chunk];
+            const float chunkVolume = cube.extents.x * cube.extents.y * cube.extents.z;
+            localCenter += PxVec3(cube.position.x, cube.position.y, cube.position.z) * chunkVolume;
+            volume += chunkVolume;
+        }
+        return pose.transform(localCenter / volume);
+    }
+
+    uint32_t getSceneActorCount() const
+    {
+        return m_scene->getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC);
+    }
+
+    uint32_t slice(NvBlastActor& actor, uint32_t axis, float coord)
+    {
+        const BondSlicerParams params = { axis, coord };
+        const NvBlastDamageProgram program = { BondSlicer, nullptr };
+        return m_destruction->applyDamage(actor, program, &params);
+    }
+
+    // Breaks every bond of the actor
+    uint32_t shatter(NvBlastActor& actor)
+    {
+        const NvBlastExtRadialDamageDesc damage = { 10.0f, { 0.0f, 0.0f, 0.0f }, 10.0f, 20.0f };
+        const NvBlastExtProgramParams params(&damage);
+        const NvBlastDamageProgram program = { NvBlastExtFalloffGraphShader, NvBlastExtFalloffSubgraphShader };
+        return m_destruction->applyDamage(actor, program, &params);
+    }
+
+    // Checks that every Blast actor has a PhysX actor in the scene with the shapes of its visible chunks
+    void expectActorsMatchScene() const
+    {
+        const std::vector<NvBlastActor*> actors = getActors();
+        EXPECT_EQ(actors.size(), getSceneActorCount());
+
+        std::set<PxRigidDynamic*> pxActors;
+        for (NvBlastActor* actor : actors)
+        {
+            PxRigidDynamic* pxActor = m_destruction->getPxActor(*actor);
+            ASSERT_TRUE(pxActor != nullptr);
+            EXPECT_TRUE(pxActor->getScene() == m_scene);
+            EXPECT_EQ(actor, m_destruction->getBlastActor(*pxActor));
+            EXPECT_TRUE(pxActors.insert(pxActor).second);
+            EXPECT_EQ(NvBlastActorHasExternalBonds(actor, this->messageLog), pxActor->getRigidBodyFlags().isSet(PxRigidBodyFlag::eKINEMATIC));
+
+            std::vector<PxShape*> shapes(pxActor->getNbShapes());
+            pxActor->getShapes(shapes.data(), (PxU32)shapes.size());
+            std::vector<PxShape*> expectedShapes;
+            for (uint32_t chunk : getVisibleChunks(*actor))
+            {
+                expectedShapes.push_back(m_shapes[chunk]);
+            }
+            std::sort(shapes.begin(), shapes.end());
+            std::sort(expectedShapes.begin(), expectedShapes.end());
+            EXPECT_TRUE(shapes == expectedShapes);
+        }
+    }
+
+    void simulate(uint32_t stepCount, float dt = 1.0f / 60.0f)
+    {
+        for (uint32_t i = 0; i < stepCount; ++i)
+        {
+            m_scene->simulate(dt);
+            m_scene->fetchResults(true);
+        }
+    }
+
+protected:
+    PxDefaultAllocator                  m_allocator;
+    PhysXTestErrorCallback              m_errorCallback;
+    PxFoundation*                       m_foundation;
+    PxPhysics*                          m_physics;
+    PxDefaultCpuDispatcher*             m_dispatcher;
+    PxScene*                            m_scene;
+    PxMaterial*                         m_material;
+
+    GeneratorAsset                      m_cube;
+    NvBlastAsset*                       m_asset;
+    NvBlastFamily*                      m_family;
+    std::vector<PxShape*>               m_shapes;
+    std::vector<ExtPxChunkShapes>       m_chunkShapes;
+    ExtPxDestruction*                   m_destruction;
+    ExtStressSolver*                    m_stressSolver;
+};
+
+typedef PxDestructionTest<-1, 0> PxDestructionTestAllowErrorsSilently;
+typedef PxDestructionTest<NvBlastMessage::Error, 0> PxDestructionTestAllowWarningsSilently;
+typedef PxDestructionTest<NvBlastMessage::Warning, 1> PxDestructionTestStrict;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                      Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(PxDestructionTestStrict, CreateAddsTheFamilyToTheScene)
+{
+    createCube(4);
+
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.pose.p = { 1.0f, 2.0f, 3.0f };
+    desc.pose.q = { 0.0f, 0.0f, 0.70710678f, 0.70710678f };
+    desc.pooledActorCount = 4;
+    createDestruction(desc);
+
+    // the shapes are referenced by the bridge
+    for (PxShape* shape : m_shapes)
+    {
+        EXPECT_LT(1u, shape->getReferenceCount());
+    }
+
+    const std::vector<NvBlastActor*> actors = getActors();
+    ASSERT_EQ(1u, actors.size());
+    expectActorsMatchScene();
+
+    PxRigidDynamic* pxActor = m_destruction->getPxActor(*actors[0]);
+    const PxTransform pose = pxActor->getGlobalPose();
+    EXPECT_TRUE(pose.p == PxVec3(1.0f, 2.0f, 3.0f));
+    EXPECT_NEAR(1.0f, PxAbs(pose.q.dot(PxQuat(0.0f, 0.0f, 0.70710678f, 0.70710678f))), 1e-6f);
+    EXPECT_NEAR(1.0f, pxActor->getMass(), 1e-4f);   // density 1, unit cube
+    EXPECT_EQ(0u, m_destruction->getPoolOverflowCount());
+
+    // PhysX actors of other bridges or of the application are not ours
+    PxRigidDynamic* other = m_physics->createRigidDynamic(PxTransform(PxIdentity));
+    EXPECT_TRUE(m_destruction->getBlastActor(*other) == nullptr);
+    other->release();
+
+    m_destruction->release();
+    m_destruction = nullptr;
+    EXPECT_EQ(0u, getSceneActorCount());
+    for (PxShape* shape : m_shapes)
+    {
+        EXPECT_EQ(1u, shape->getReferenceCount());
+    }
+}
+
+TEST_F(PxDestructionTestAllowErrorsSilently, CreateRejectsInvalidDescs)
+{
+    createCube(2);
+
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.physics = nullptr;
+    EXPECT_TRUE(ExtPxDestruction::create(desc) == nullptr);
+
+    desc = destructionDesc();
+    desc.chunkShapes = nullptr;
+    EXPECT_TRUE(ExtPxDestruction::create(desc) == nullptr);
+
+    // chunk shapes are shared between actors
+    PxShape* exclusive = m_physics->createShape(PxSphereGeometry(0.1f), *m_material, true);
+    const ExtPxChunkShapes exclusiveShapes = { &exclusive, 1 };
+    std::vector<ExtPxChunkShapes> chunkShapes = m_chunkShapes;
+    chunkShapes.back() = exclusiveShapes;
+    desc = destructionDesc();
+    desc.chunkShapes = chunkShapes.data();
+    EXPECT_TRUE(ExtPxDestruction::create(desc) == nullptr);
+    exclusive->release();
+
+    EXPECT_EQ(0u, getSceneActorCount());
+    for (PxShape* shape : m_shapes)
+    {
+        EXPECT_EQ(1u, shape->getReferenceCount());
+    }
+}
+
+TEST_F(PxDestructionTestStrict, SingleChunkFragmentsUsePreShapedActors)
+{
+    createCube(4);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.pooledActorCount = 0;
+    createDestruction(desc);
+
+    NvBlastActor* actor = getActors()[0];
+    PxRigidDynamic* parent = m_destruction->getPxActor(*actor);
+
+    EXPECT_EQ(64u, shatter(*actor));
+    EXPECT_EQ(64u, NvBlastFamilyGetActorCount(m_family, messageLog));
+    expectActorsMatchScene();
+    EXPECT_TRUE(parent->getScene() == nullptr);
+    EXPECT_TRUE(m_destruction->getBlastActor(*parent) == nullptr);
+    EXPECT_EQ(0u, m_destruction->getPoolOverflowCount());
+
+    for (NvBlastActor* fragment : getActors())
+    {
+        EXPECT_NEAR(1.0f / 64.0f, m_destruction->getPxActor(*fragment)->getMass(), 1e-6f);
+    }
+
+    // fragments fall
+    simulate(10);
+    for (NvBlastActor* fragment : getActors())
+    {
+        EXPECT_LT(m_destruction->getPxActor(*fragment)->getGlobalPose().p.y, -0.1f);
+    }
+}
+
+TEST_F(PxDestructionTestStrict, MultiChunkFragmentsUsePooledActors)
+{
+    createCube(4);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.pooledActorCount = 3;
+    createDestruction(desc);
+
+    // halves
+    EXPECT_EQ(2u, slice(*getActors()[0], 0, 0.0f));
+    expectActorsMatchScene();
+    EXPECT_EQ(0u, m_destruction->getPoolOverflowCount());
+
+    NvBlastActor* half = getActors()[0];
+    PxRigidDynamic* halfPxActor = m_destruction->getPxActor(*half);
+    EXPECT_EQ(32u, halfPxActor->getNbShapes());
+    EXPECT_NEAR(0.5f, halfPxActor->getMass(), 1e-4f);
+
+    // quarters, the half's PhysX actor goes back to the pool and is reused
+    EXPECT_EQ(2u, slice(*half, 1, 0.0f));
+    expectActorsMatchScene();
+    EXPECT_EQ(3u, NvBlastFamilyGetActorCount(m_family, messageLog));
+    EXPECT_EQ(0u, m_destruction->getPoolOverflowCount());
+
+    NvBlastActor* reuser = m_destruction->getBlastActor(*halfPxActor);
+    ASSERT_TRUE(reuser != nullptr);
+    EXPECT_EQ(16u, getVisibleChunks(*reuser).size());
+    EXPECT_EQ(16u, halfPxActor->getNbShapes());
+    EXPECT_NEAR(0.25f, halfPxActor->getMass(), 1e-4f);
+
+    // undamaged actors are left alone
+    EXPECT_EQ(0u, slice(*reuser, 1, 0.0f));
+    expectActorsMatchScene();
+}
+
+TEST_F(PxDestructionTestAllowWarningsSilently, EmptyPoolCreatesActors)
+{
+    createCube(4);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.pooledActorCount = 1;
+    createDestruction(desc);
+
+    EXPECT_EQ(2u, slice(*getActors()[0], 0, 0.0f));
+    EXPECT_EQ(1u, m_destruction->getPoolOverflowCount());
+    expectActorsMatchScene();
+}
+
+TEST_F(PxDestructionTestStrict, ActorsBoundToTheWorldAreKinematic)
+{
+    createCube(4, CubeAssetGenerator::BondFlags(CubeAssetGenerator::ALL_INTERNAL_BONDS | CubeAssetGenerator::Y_MINUS_WORLD_BONDS));
+    createDestruction(destructionDesc());
+    expectActorsMatchScene();
+
+    // the bottom layer stays bound to the world
+    EXPECT_EQ(2u, slice(*getActors()[0], 1, -0.25f));
+    expectActorsMatchScene();
+
+    // throw the rest up, the kinematic actor is not pushed back
+    for (NvBlastActor* actor : getActors())
+    {
+        if (!NvBlastActorHasExternalBonds(actor, messageLog))
+        {
+            m_destruction->getPxActor(*actor)->setLinearVelocity(PxVec3(0.0f, 5.0f, 0.0f));
+        }
+    }
+    simulate(10);
+    for (NvBlastActor* actor : getActors())
+    {
+        const float y = m_destruction->getPxActor(*actor)->getGlobalPose().p.y;
+        if (NvBlastActorHasExternalBonds(actor, messageLog))
+        {
+            EXPECT_EQ(16u, getVisibleChunks(*actor).size());
+            EXPECT_EQ(0.0f, y);
+        }
+        else
+        {
+            EXPECT_EQ(48u, getVisibleChunks(*actor).size());
+            EXPECT_GT(y, 0.5f);
+        }
+    }
+}
+
+TEST_F(PxDestructionTestStrict, FragmentsInheritTheParentMotion)
+{
+    createCube(4);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.pose.p = { 0.0f, 10.0f, 0.0f };
+    createDestruction(desc);
+
+    NvBlastActor* actor = getActors()[0];
+    PxRigidDynamic* parent = m_destruction->getPxActor(*actor);
+    const PxVec3 linearVelocity(1.0f, 2.0f, 3.0f);
+    const PxVec3 angularVelocity(0.0f, 4.0f, 0.0f);
+    parent->setLinearVelocity(linearVelocity);
+    parent->setAngularVelocity(angularVelocity);
+    const PxVec3 parentCenter = parent->getGlobalPose().transform(parent->getCMassLocalPose().p);
+
+    EXPECT_EQ(64u, shatter(*actor));
+    for (NvBlastActor* fragment : getActors())
+    {
+        PxRigidDynamic* pxActor = m_destruction->getPxActor(*fragment);
+        const PxVec3 center = pxActor->getGlobalPose().transform(pxActor->getCMassLocalPose().p);
+        const PxVec3 expected = linearVelocity + angularVelocity.cross(center - parentCenter);
+        EXPECT_NEAR(expected.x, pxActor->getLinearVelocity().x, 1e-5f);
+        EXPECT_NEAR(expected.y, pxActor->getLinearVelocity().y, 1e-5f);
+        EXPECT_NEAR(expected.z, pxActor->getLinearVelocity().z, 1e-5f);
+        EXPECT_TRUE(pxActor->getAngularVelocity() == angularVelocity);
+        EXPECT_FALSE(pxActor->isSleeping());
+    }
+}
+
+TEST_F(PxDestructionTestStrict, StressNeedsASolver)
+{
+    createCube(4);
+    createDestruction(destructionDesc());
+
+    PxRigidDynamic* pxActor = m_destruction->getPxActor(*getActors()[0]);
+    const std::vector<PxContactReportRecord> records = { contactReport(*pxActor, PxVec3(0.375f), PxVec3(1000.0f, 0.0f, 0.0f)) };
+    EXPECT_EQ(0u, pushUntilBroken(records, 10));
+    EXPECT_EQ(1u, getActors().size());
+}
+
+TEST_F(PxDestructionTestStrict, ContactImpulsesBreakOverstressedBonds)
+{
+    createCube(4, CubeAssetGenerator::BondFlags(CubeAssetGenerator::ALL_INTERNAL_BONDS | CubeAssetGenerator::Y_MINUS_WORLD_BONDS));
+    createStressSolver(1000.0f, 2000.0f);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.userIndexBase = 100;
+    desc.stressSolver = m_stressSolver;
+    createDestruction(desc);
+
+    PxRigidDynamic* pxActor = m_destruction->getPxActor(*getActors()[0]);
+    EXPECT_LE(100u, (uint32_t)(size_t)pxActor->userData);
+
+    // the structure carries its own weight
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(0u, m_destruction->updateStress(1.0f / 60.0f));
+    }
+    EXPECT_EQ(0u, m_stressSolver->getOverstressedBondCount());
+
+    // a hard push on the top corner breaks it
+    const std::vector<PxContactReportRecord> records = { contactReport(*pxActor, PxVec3(0.375f), PxVec3(1000.0f, 0.0f, 0.0f)) };
+    EXPECT_LT(0u, pushUntilBroken(records, 10));
+    EXPECT_LT(1u, getActors().size());
+    expectActorsMatchScene();
+}
+
+TEST_F(PxDestructionTestStrict, ForeignContactReportsAreIgnored)
+{
+    createCube(4, CubeAssetGenerator::BondFlags(CubeAssetGenerator::ALL_INTERNAL_BONDS | CubeAssetGenerator::Y_MINUS_WORLD_BONDS));
+    createStressSolver(1000.0f, 2000.0f);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.userIndexBase = 100;
+    desc.pooledActorCount = 4;
+    desc.stressSolver = m_stressSolver;
+    createDestruction(desc);
+
+    // records of actors outside of the bridge's user index range, or without contacts or impulses
+    PxRigidDynamic* pxActor = m_destruction->getPxActor(*getActors()[0]);
+    const PxVec3 point(0.375f);
+    const PxVec3 impulse(1000.0f, 0.0f, 0.0f);
+    const uint32_t chunkCount = NvBlastAssetGetChunkCount(m_asset, messageLog);
+    std::vector<PxContactReportRecord> records(5, contactReport(*pxActor, point, impulse));
+    records[0].userIndex0 = 99;
+    records[1].userIndex0 = 100 + chunkCount + desc.pooledActorCount;
+    records[2].userIndex0 = PX_INVALID_U32;
+    records[3].nbContacts = 0;
+    records[4].impulse = PxVec3(0.0f);
+    EXPECT_EQ(0u, pushUntilBroken(records, 10));
+    EXPECT_EQ(1u, getActors().size());
+}
+
+TEST_F(PxDestructionTestStrict, TimeBudgetLimitsSolverIterations)
+{
+    createCube(4, CubeAssetGenerator::BondFlags(CubeAssetGenerator::ALL_INTERNAL_BONDS | CubeAssetGenerator::Y_MINUS_WORLD_BONDS));
+    createStressSolver(1000.0f, 2000.0f);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.stressSolver = m_stressSolver;
+    createDestruction(desc);
+    const uint32_t maxIterationCount = m_stressSolver->getSettings().maxSolverIterationsPerFrame;
+
+    // the first update measures the iteration cost
+    m_destruction->updateStress(1.0f / 60.0f, 1e-9f);
+    m_destruction->updateStress(1.0f / 60.0f, 1e-9f);
+    EXPECT_EQ(1u, m_stressSolver->getSettings().maxSolverIterationsPerFrame);
+
+    // capped by the iteration count the solver had when the bridge was created
+    m_destruction->updateStress(1.0f / 60.0f, 10.0f);
+    EXPECT_EQ(maxIterationCount, m_stressSolver->getSettings().maxSolverIterationsPerFrame);
+
+    m_destruction->updateStress(1.0f / 60.0f, 1e-9f);
+    EXPECT_EQ(1u, m_stressSolver->getSettings().maxSolverIterationsPerFrame);
+    m_destruction->updateStress(1.0f / 60.0f);
+    EXPECT_EQ(maxIterationCount, m_stressSolver->getSettings().maxSolverIterationsPerFrame);
+}
+
+TEST_F(PxDestructionTestStrict, SmallFragmentsBecomeDebris)
+{
+    createCube(4);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.debris.volumeThreshold = 0.02f;   // between the volumes of one and two chunks
+    createDestruction(desc);
+
+    EXPECT_EQ(2u, slice(*getActors()[0], 0, 0.0f));
+    EXPECT_EQ(0u, m_destruction->getDebrisCount());
+    EXPECT_EQ(2u, getSceneActorCount());
+
+    NvBlastActor* half = getActors()[0];
+    EXPECT_EQ(32u, shatter(*half));
+    EXPECT_EQ(32u, m_destruction->getDebrisCount());
+    EXPECT_EQ(1u, getSceneActorCount());
+
+    const float radius = PxPow(3.0f / (4.0f * PxPi * 64.0f), 1.0f / 3.0f);
+    std::set<uint32_t> actorIndices;
+    for (const ExtPxDebris& debris : getDebris())
+    {
+        EXPECT_TRUE(actorIndices.insert(debris.actorIndex).second);
+        const NvBlastActor* actor = NvBlastFamilyGetActorByIndex(m_family, debris.actorIndex, messageLog);
+        ASSERT_TRUE(actor != nullptr);
+        EXPECT_EQ(1u, getVisibleChunks(*actor).size());
+        EXPECT_TRUE(m_destruction->getPxActor(*actor) == nullptr);
+        EXPECT_NEAR(radius, debris.radius, 1e-6f);
+
+        // the pose is the one of the asset frame, like a PhysX actor's
+        EXPECT_TRUE(PxVec3(debris.pose.p.x, debris.pose.p.y, debris.pose.p.z).isZero());
+        EXPECT_EQ(1.0f, debris.pose.q.w);
+    }
+
+    // partial reads
+    ExtPxDebris debris[4];
+    EXPECT_EQ(4u, m_destruction->getDebris(debris, 4));
+}
+
+TEST_F(PxDestructionTestStrict, DebrisIsNotFractured)
+{
+    createCube(4);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.debris.volumeThreshold = 0.3f;     // quarters
+    createDestruction(desc);
+
+    EXPECT_EQ(2u, slice(*getActors()[0], 0, 0.0f));
+    EXPECT_EQ(0u, m_destruction->getDebrisCount());
+    EXPECT_EQ(2u, slice(*getActors()[0], 1, 0.0f));
+    ASSERT_EQ(2u, m_destruction->getDebrisCount());
+
+    NvBlastActor* quarter = NvBlastFamilyGetActorByIndex(m_family, getDebris()[0].actorIndex, messageLog);
+    ASSERT_TRUE(quarter != nullptr);
+    EXPECT_EQ(0u, shatter(*quarter));
+    EXPECT_EQ(16u, getVisibleChunks(*quarter).size());
+    EXPECT_EQ(3u, getActors().size());
+}
+
+TEST_F(PxDestructionTestStrict, DistantFragmentsBecomeDebris)
+{
+    createCube(4);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.debris.distanceThreshold = 0.2f;
+    createDestruction(desc);
+
+    // without viewers the test is disabled
+    EXPECT_EQ(2u, slice(*getActors()[0], 1, 0.0f));
+    EXPECT_EQ(0u, m_destruction->getDebrisCount());
+    NvBlastActor* top = getActors()[0];
+    NvBlastActor* bottom = getActors()[1];
+    if (m_cube.chunks[getVisibleChunks(*top)[0]].position.y < 0.0f)
+    {
+        std::swap(top, bottom);
+    }
+
+    // the first viewer is at the center of the -x quarter of the top half
+    const NvcVec3 viewers[] = { { -0.25f, 0.25f, 0.0f }, { 0.375f, -0.125f, 0.375f } };
+    m_destruction->setViewers(viewers, 1);
+    EXPECT_EQ(2u, slice(*top, 0, 0.0f));
+    ASSERT_EQ(1u, m_destruction->getDebrisCount());
+    EXPECT_EQ(2u, getSceneActorCount());
+    EXPECT_NEAR(0.25f, getDebrisCenter(getDebris()[0]).x, 1e-6f);
+
+    // the second viewer is at the center of a chunk of the bottom half, the other chunks are farther from both viewers
+    m_destruction->setViewers(viewers, 2);
+    EXPECT_EQ(32u, shatter(*bottom));
+    EXPECT_EQ(1u + 31u, m_destruction->getDebrisCount());
+    EXPECT_EQ(2u, getSceneActorCount());
+    for (NvBlastActor* actor : getActors())
+    {
+        if (PxRigidDynamic* pxActor = m_destruction->getPxActor(*actor))
+        {
+            const std::vector<uint32_t> chunks = getVisibleChunks(*actor);
+            if (chunks.size() == 1)
+            {
+                const PxVec3 center = pxActor->getGlobalPose().transform(pxActor->getCMassLocalPose().p);
+                EXPECT_TRUE((center - PxVec3(0.375f, -0.125f, 0.375f)).magnitude() < 1e-6f);
+            }
+        }
+    }
+}
+
+TEST_F(PxDestructionTestStrict, WorldBoundFragmentsAreNeverDebris)
+{
+    createCube(4, CubeAssetGenerator::BondFlags(CubeAssetGenerator::ALL_INTERNAL_BONDS | CubeAssetGenerator::Y_MINUS_WORLD_BONDS));
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.debris.volumeThreshold = 10.0f;    // any fragment
+    createDestruction(desc);
+
+    EXPECT_EQ(2u, slice(*getActors()[0], 1, -0.25f));
+    EXPECT_EQ(1u, m_destruction->getDebrisCount());
+    EXPECT_EQ(1u, getSceneActorCount());
+
+    for (NvBlastActor* actor : getActors())
+    {
+        const bool debris = m_destruction->getPxActor(*actor) == nullptr;
+        EXPECT_NE(debris, NvBlastActorHasExternalBonds(actor, messageLog));
+        EXPECT_EQ(debris ? 48u : 16u, getVisibleChunks(*actor).size());
+    }
+}
+
+TEST_F(PxDestructionTestStrict, DebrisCountIsCapped)
+{
+    createCube(4);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.debris.volumeThreshold = 0.02f;
+    desc.debris.maxDebrisCount = 8;
+    createDestruction(desc);
+
+    EXPECT_EQ(2u, slice(*getActors()[0], 0, 0.0f));
+    NvBlastActor* first = getActors()[0];
+    NvBlastActor* second = getActors()[1];
+    EXPECT_EQ(32u, shatter(*first));
+    EXPECT_EQ(8u, m_destruction->getDebrisCount());
+    EXPECT_EQ(1u, getSceneActorCount());
+
+    // the older particles make room for the new ones
+    m_destruction->updateDebris(1.0f / 60.0f);
+    const bool secondIsPositive = m_cube.chunks[getVisibleChunks(*second)[0]].position.x > 0.0f;
+    EXPECT_EQ(32u, shatter(*second));
+    EXPECT_EQ(8u, m_destruction->getDebrisCount());
+    for (const ExtPxDebris& debris : getDebris())
+    {
+        EXPECT_EQ(secondIsPositive, getDebrisCenter(debris).x > 0.0f);
+    }
+}
+
+TEST_F(PxDestructionTestStrict, DebrisExpires)
+{
+    createCube(4);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.debris.volumeThreshold = 0.02f;
+    desc.debris.lifetime = 0.5f;
+    createDestruction(desc);
+
+    EXPECT_EQ(64u, shatter(*getActors()[0]));
+    EXPECT_EQ(64u, m_destruction->getDebrisCount());
+    EXPECT_EQ(0u, getSceneActorCount());
+
+    m_destruction->updateDebris(0.2f);
+    m_destruction->updateDebris(0.2f);
+    EXPECT_EQ(64u, m_destruction->getDebrisCount());
+    m_destruction->updateDebris(0.2f);
+    EXPECT_EQ(0u, m_destruction->getDebrisCount());
+}
+
+TEST_F(PxDestructionTestStrict, DebrisComesToRestOnStaticGeometry)
+{
+    createCube(4);
+    ExtPxDestructionDesc desc = destructionDesc();
+    desc.debris.volumeThreshold = 0.02f;
+    desc.debris.lifetime = 0.0f;
+    createDestruction(desc);
+
+    // ground at y = -2
+    PxRigidStatic* ground = PxCreatePlane(*m_physics, PxPlane(0.0f, 1.0f, 0.0f, 2.0f), *m_material);
+    m_scene->addActor(*ground);
+
+    EXPECT_EQ(64u, shatter(*getActors()[0]));
+    for (uint32_t i = 0; i < 600; ++i)
+    {
+        m_destruction->updateDebris(1.0f / 60.0f);
+    }
+
+    const std::vector<ExtPxDebris> debris = getDebris();
+    ASSERT_EQ(64u, debris.size());
+    for (const ExtPxDebris& d : debris)
+    {
+        const PxVec3 center = getDebrisCenter(d);
+        EXPECT_NEAR(-2.0f + d.radius, center.y, 1e-4f);
+    }
+
+    // at rest
+    m_destruction->updateDebris(1.0f / 60.0f);
+    const std::vector<ExtPxDebris> restingDebris = getDebris();
+    for (uint32_t i = 0; i < debris.size(); ++i)
+    {
+        EXPECT_EQ(0, memcmp(&debris[i], &restingDebris[i], sizeof(ExtPxDebris)));
+    }
+
+    ground->release();
+}
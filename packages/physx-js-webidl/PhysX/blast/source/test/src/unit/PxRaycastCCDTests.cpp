@@ -0,0 +1,173 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2024 NVIDIA Corporation. All rights reserved.
+
+
+
+#include "BlastBaseTest.h"
+
+#include "PxPhysicsAPI.h"
+#include "extensions/PxRaycastCCD.h"
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                  Utils / Tests Common
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace physx;
+
+template<int FailLevel, int Verbosity>
+class PxRaycastCCDTest : public BlastBaseTest<FailLevel, Verbosity>
+{
+public:
+    PxRaycastCCDTest() : m_foundation(nullptr), m_physics(nullptr), m_dispatcher(nullptr), m_scene(nullptr), m_material(nullptr), m_ccd(nullptr)
+    {
+    }
+
+    virtual void SetUp() override
+    {
+        m_foundation = PxCreateFoundation(PX_PHYSICS_VERSION, m_allocator, m_errorCallback);
+        ASSERT_TRUE(m_foundation != nullptr);
+        m_physics = PxCreatePhysics(PX_PHYSICS_VERSION, *m_foundation, PxTolerancesScale());
+        ASSERT_TRUE(m_physics != nullptr);
+
+        m_dispatcher = PxDefaultCpuDispatcherCreate(0);
+        PxSceneDesc sceneDesc(m_physics->getTolerancesScale());
+        sceneDesc.gravity = PxVec3(0.0f, -10.0f, 0.0f);
+        sceneDesc.cpuDispatcher = m_dispatcher;
+        sceneDesc.filterShader = PxDefaultSimulationFilterShader;
+        m_scene = m_physics->createScene(sceneDesc);
+        ASSERT_TRUE(m_scene != nullptr);
+
+        // frictionless, so that sliding objects keep their speed
+        m_material = m_physics->createMaterial(0.0f, 0.0f, 0.0f);
+        m_material->setFrictionCombineMode(PxCombineMode::eMIN);
+
+        m_ccd = new RaycastCCDManager(m_scene);
+    }
+
+    virtual void TearDown() override
+    {
+        delete m_ccd;
+
+        if (m_material)
+        {
+            m_material->release();
+        }
+        if (m_scene)
+        {
+            m_scene->release();
+        }
+        if (m_dispatcher)
+        {
+            m_dispatcher->release();
+        }
+        if (m_physics)
+        {
+            m_physics->release();
+        }
+        if (m_foundation)
+        {
+            m_foundation->release();
+        }
+    }
+
+    // Arrow-like box, long along x, registered for sphere-cast CCD with a radius larger than its thickness
+    PxRigidDynamic* createThinBox(const PxVec3& position, const PxVec3& velocity)
+    {
+        PxRigidDynamic* box = PxCreateDynamic(*m_physics, PxTransform(position), PxBoxGeometry(0.5f, 0.02f, 0.02f), *m_material, 1.0f);
+        box->setLinearVelocity(velocity);
+        m_scene->addActor(*box);
+
+        PxShape* shape;
+        box->getShapes(&shape, 1);
+        EXPECT_TRUE(m_ccd->registerRaycastCCDObject(box, shape, 0.2f));
+        return box;
+    }
+
+    void step()
+    {
+        m_scene->simulate(1.0f / 60.0f);
+        m_scene->fetchResults(true);
+        m_ccd->doRaycastCCD(false);
+    }
+
+    PxDefaultAllocator                  m_allocator;
+    PxDefaultErrorCallback              m_errorCallback;
+    PxFoundation*                       m_foundation;
+    PxPhysics*                          m_physics;
+    PxDefaultCpuDispatcher*             m_dispatcher;
+    PxScene*                            m_scene;
+    PxMaterial*                         m_material;
+    RaycastCCDManager*                  m_ccd;
+};
+
+typedef PxRaycastCCDTest<NvBlastMessage::Warning, 1> PxRaycastCCDTestStrict;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                      Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(PxRaycastCCDTestStrict, SlidingThinBoxKeepsMoving)
+{
+    PxRigidStatic* ground = PxCreatePlane(*m_physics, PxPlane(0.0f, 1.0f, 0.0f, 0.0f), *m_material);
+    m_scene->addActor(*ground);
+
+    // resting on the ground, the swept sphere starts overlapping it every frame
+    PxRigidDynamic* box = createThinBox(PxVec3(0.0f, 0.02f, 0.0f), PxVec3(5.0f, 0.0f, 0.0f));
+
+    float previousX = box->getGlobalPose().p.x;
+    for (uint32_t i = 0; i < 60; ++i)
+    {
+        step();
+        const float x = box->getGlobalPose().p.x;
+        EXPECT_GT(x, previousX);
+        previousX = x;
+    }
+    EXPECT_NEAR(5.0f, previousX, 0.5f);
+    EXPECT_GT(box->getGlobalPose().p.y, -0.02f);
+
+    box->release();
+    ground->release();
+}
+
+TEST_F(PxRaycastCCDTestStrict, FastThinBoxStopsAtThinWall)
+{
+    PxRigidStatic* wall = PxCreateStatic(*m_physics, PxTransform(PxVec3(20.0f, 0.0f, 0.0f)), PxBoxGeometry(0.05f, 10.0f, 10.0f), *m_material);
+    m_scene->addActor(*wall);
+
+    // 20 units per frame, the box would go through the wall without CCD
+    PxRigidDynamic* box = createThinBox(PxVec3(0.0f, 0.0f, 0.0f), PxVec3(1200.0f, 0.0f, 0.0f));
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        step();
+        EXPECT_LT(box->getGlobalPose().p.x, 20.0f);
+    }
+
+    box->release();
+    wall->release();
+}
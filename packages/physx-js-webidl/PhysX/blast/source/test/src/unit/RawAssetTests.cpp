@@ -0,0 +1,338 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2016-2024 NVIDIA Corporation. All rights reserved.
+
+
+
+#include "BlastBaseTest.h"
+#include "TestAssets.h"
+#include "NvBlastExtRawAsset.h"
+#include "NvBlastExtDamageShaders.h"
+
+#include <cstring>
+#include <vector>
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                  Utils / Tests Common
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace Nv::Blast;
+
+template<int FailLevel, int Verbosity>
+class RawAssetTest : public BlastBaseTest<FailLevel, Verbosity>
+{
+public:
+    RawAssetTest() : m_asset(nullptr)
+    {
+    }
+
+    ~RawAssetTest()
+    {
+        this->alignedFree(m_asset);
+        for (void* buffer : m_buffers)
+        {
+            this->alignedFree(buffer);
+        }
+    }
+
+    void createCubeAsset(size_t width)
+    {
+        GeneratorAsset cube;
+        NvBlastAssetDesc assetDesc;
+        generateCube(cube, assetDesc, 2, width);
+
+        std::vector<char> scratch((size_t)NvBlastGetRequiredScratchForCreateAsset(&assetDesc, this->messageLog));
+        void* amem = this->alignedZeroedAlloc(NvBlastGetAssetMemorySize(&assetDesc, this->messageLog));
+        m_asset = NvBlastCreateAsset(amem, &assetDesc, scratch.data(), this->messageLog);
+        ASSERT_TRUE(m_asset != nullptr);
+    }
+
+    uint32_t chunkCount() const
+    {
+        return NvBlastAssetGetChunkCount(m_asset, this->messageLog);
+    }
+
+    // Chunk i gets i % 3 payloads of distinct sizes, most of them not multiples of 16
+    void createPayloads()
+    {
+        m_payloadBytes.resize(chunkCount());
+        m_payloads.resize(chunkCount());
+        m_chunkPayloads.resize(chunkCount());
+        for (uint32_t i = 0; i < chunkCount(); ++i)
+        {
+            const uint32_t payloadCount = i % 3;
+            m_payloadBytes[i].resize(payloadCount);
+            m_payloads[i].resize(payloadCount);
+            for (uint32_t j = 0; j < payloadCount; ++j)
+            {
+                std::vector<char>& bytes = m_payloadBytes[i][j];
+                bytes.resize(1 + 7 * i + 13 * j);
+                for (size_t k = 0; k < bytes.size(); ++k)
+                {
+                    bytes[k] = (char)(i * 31 + j * 17 + k);
+                }
+                m_payloads[i][j].data = bytes.data();
+                m_payloads[i][j].size = (uint32_t)bytes.size();
+            }
+            m_chunkPayloads[i].payloads = m_payloads[i].data();
+            m_chunkPayloads[i].payloadCount = payloadCount;
+        }
+    }
+
+    const NvBlastExtRawAssetChunkPayloads* chunkPayloads() const
+    {
+        return m_chunkPayloads.empty() ? nullptr : m_chunkPayloads.data();
+    }
+
+    // Writes the raw asset into a new 16-byte aligned buffer, filled with garbage first
+    void* writeRawAsset(uint64_t& size)
+    {
+        size = NvBlastExtRawAssetGetSize(m_asset, chunkPayloads());
+        EXPECT_LT(0u, size);
+        EXPECT_EQ(0u, size % 16);
+
+        void* buffer = this->alignedZeroedAlloc((size_t)size);
+        memset(buffer, 0xcd, (size_t)size);
+        m_buffers.push_back(buffer);
+        EXPECT_EQ(size, NvBlastExtRawAssetWrite(buffer, size, m_asset, chunkPayloads()));
+        return buffer;
+    }
+
+    static bool isInBuffer(const void* ptr, const void* buffer, uint64_t size)
+    {
+        return static_cast<const char*>(ptr) >= static_cast<const char*>(buffer) && static_cast<const char*>(ptr) < static_cast<const char*>(buffer) + size;
+    }
+
+protected:
+    NvBlastAsset*                                   m_asset;
+    std::vector<void*>                              m_buffers;
+    std::vector<std::vector<std::vector<char>>>     m_payloadBytes;
+    std::vector<std::vector<NvBlastExtRawAssetPayload>> m_payloads;
+    std::vector<NvBlastExtRawAssetChunkPayloads>    m_chunkPayloads;
+};
+
+typedef RawAssetTest<-1, 0> RawAssetTestAllowErrorsSilently;
+typedef RawAssetTest<NvBlastMessage::Warning, 1> RawAssetTestStrict;
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                      Tests
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(RawAssetTestStrict, AssetIsUsedInPlace)
+{
+    createCubeAsset(3);
+
+    uint64_t size;
+    void* buffer = writeRawAsset(size);
+
+    const NvBlastAsset* asset = NvBlastExtRawAssetGetAsset(buffer, size);
+    ASSERT_TRUE(asset != nullptr);
+    EXPECT_TRUE(isInBuffer(asset, buffer, size));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(asset) % 16);
+
+    const uint32_t assetSize = NvBlastAssetGetSize(m_asset, messageLog);
+    ASSERT_EQ(assetSize, NvBlastAssetGetSize(asset, messageLog));
+    EXPECT_EQ(0, memcmp(m_asset, asset, assetSize));
+    EXPECT_EQ(chunkCount(), NvBlastAssetGetChunkCount(asset, messageLog));
+    EXPECT_EQ(NvBlastAssetGetBondCount(m_asset, messageLog), NvBlastAssetGetBondCount(asset, messageLog));
+
+    for (uint32_t i = 0; i < chunkCount(); ++i)
+    {
+        EXPECT_EQ(0u, NvBlastExtRawAssetGetChunkPayloadCount(buffer, i));
+        EXPECT_TRUE(NvBlastExtRawAssetGetChunkPayload(buffer, i, 0).data == nullptr);
+    }
+}
+
+TEST_F(RawAssetTestStrict, PayloadsAreCoLocated)
+{
+    createCubeAsset(3);
+    createPayloads();
+
+    uint64_t size;
+    void* buffer = writeRawAsset(size);
+    ASSERT_TRUE(NvBlastExtRawAssetGetAsset(buffer, size) != nullptr);
+
+    for (uint32_t i = 0; i < chunkCount(); ++i)
+    {
+        ASSERT_EQ(m_chunkPayloads[i].payloadCount, NvBlastExtRawAssetGetChunkPayloadCount(buffer, i));
+        for (uint32_t j = 0; j < m_chunkPayloads[i].payloadCount; ++j)
+        {
+            const NvBlastExtRawAssetPayload payload = NvBlastExtRawAssetGetChunkPayload(buffer, i, j);
+            ASSERT_TRUE(payload.data != nullptr);
+            EXPECT_TRUE(isInBuffer(payload.data, buffer, size));
+            EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(payload.data) % 16);
+            ASSERT_EQ(m_payloads[i][j].size, payload.size);
+            EXPECT_EQ(0, memcmp(m_payloads[i][j].data, payload.data, payload.size));
+        }
+
+        // out of range payloads
+        const NvBlastExtRawAssetPayload past = NvBlastExtRawAssetGetChunkPayload(buffer, i, m_chunkPayloads[i].payloadCount);
+        EXPECT_TRUE(past.data == nullptr);
+        EXPECT_EQ(0u, past.size);
+    }
+
+    EXPECT_EQ(0u, NvBlastExtRawAssetGetChunkPayloadCount(buffer, chunkCount()));
+    EXPECT_TRUE(NvBlastExtRawAssetGetChunkPayload(buffer, chunkCount(), 0).data == nullptr);
+}
+
+TEST_F(RawAssetTestStrict, WriteIsDeterministic)
+{
+    createCubeAsset(2);
+    createPayloads();
+
+    uint64_t size0, size1;
+    const void* buffer0 = writeRawAsset(size0);
+    const void* buffer1 = writeRawAsset(size1);
+    ASSERT_EQ(size0, size1);
+    // the padding is zeroed, the garbage the buffers were filled with is gone
+    EXPECT_EQ(0, memcmp(buffer0, buffer1, (size_t)size0));
+}
+
+TEST_F(RawAssetTestStrict, FamiliesShareTheBuffer)
+{
+    createCubeAsset(3);
+    createPayloads();
+
+    uint64_t size;
+    void* buffer = writeRawAsset(size);
+    const std::vector<char> original(static_cast<const char*>(buffer), static_cast<const char*>(buffer) + size);
+
+    const NvBlastAsset* asset = NvBlastExtRawAssetGetAsset(buffer, size);
+    ASSERT_TRUE(asset != nullptr);
+
+    NvBlastActorDesc actorDesc;
+    actorDesc.initialBondHealths = actorDesc.initialSupportChunkHealths = nullptr;
+    actorDesc.uniformInitialBondHealth = actorDesc.uniformInitialLowerSupportChunkHealth = 1.0f;
+
+    NvBlastFamily* families[2];
+    NvBlastActor* actors[2];
+    std::vector<char> scratch;
+    for (int i = 0; i < 2; ++i)
+    {
+        families[i] = NvBlastAssetCreateFamily(alignedZeroedAlloc(NvBlastAssetGetFamilyMemorySize(asset, messageLog)), asset, messageLog);
+        ASSERT_TRUE(families[i] != nullptr);
+        EXPECT_EQ(asset, NvBlastFamilyGetAsset(families[i], messageLog));
+        scratch.resize((size_t)NvBlastFamilyGetRequiredScratchForCreateFirstActor(families[i], messageLog));
+        actors[i] = NvBlastFamilyCreateFirstActor(families[i], &actorDesc, scratch.data(), messageLog);
+        ASSERT_TRUE(actors[i] != nullptr);
+    }
+
+    // break the whole first family
+    NvBlastExtRadialDamageDesc damage = { 10.0f, { 0.0f, 0.0f, 0.0f }, 10.0f, 20.0f };
+    const NvBlastExtProgramParams programParams(&damage);
+    const NvBlastDamageProgram program = { NvBlastExtFalloffGraphShader, nullptr };
+
+    std::vector<NvBlastBondFractureData> bondFractures(NvBlastAssetGetBondCount(asset, messageLog));
+    NvBlastFractureBuffers commands = { (uint32_t)bondFractures.size(), 0, bondFractures.data(), nullptr };
+    NvBlastActorGenerateFracture(&commands, actors[0], program, &programParams, messageLog, nullptr);
+    EXPECT_EQ(bondFractures.size(), commands.bondFractureCount);
+    NvBlastActorApplyFracture(nullptr, actors[0], &commands, messageLog, nullptr);
+
+    std::vector<NvBlastActor*> newActors(NvBlastAssetGetLeafChunkCount(asset, messageLog));
+    NvBlastActorSplitEvent splitEvent = { nullptr, newActors.data() };
+    scratch.resize((size_t)NvBlastActorGetRequiredScratchForSplit(actors[0], messageLog));
+    EXPECT_EQ(27u, NvBlastActorSplit(&splitEvent, actors[0], (uint32_t)newActors.size(), scratch.data(), messageLog, nullptr));
+
+    EXPECT_EQ(27u, NvBlastFamilyGetActorCount(families[0], messageLog));
+    EXPECT_EQ(1u, NvBlastFamilyGetActorCount(families[1], messageLog));
+
+    // families only read the asset
+    EXPECT_EQ(0, memcmp(original.data(), buffer, (size_t)size));
+
+    alignedFree(families[0]);
+    alignedFree(families[1]);
+}
+
+TEST_F(RawAssetTestAllowErrorsSilently, RejectsInvalidInput)
+{
+    createCubeAsset(2);
+    createPayloads();
+
+    EXPECT_EQ(0u, NvBlastExtRawAssetGetSize(nullptr, nullptr));
+
+    uint64_t size;
+    char* buffer = static_cast<char*>(writeRawAsset(size));
+    ASSERT_TRUE(NvBlastExtRawAssetGetAsset(buffer, size) != nullptr);
+
+    // writing
+    std::vector<char> copy(buffer, buffer + size);
+    EXPECT_EQ(0u, NvBlastExtRawAssetWrite(nullptr, size, m_asset, chunkPayloads()));
+    EXPECT_EQ(0u, NvBlastExtRawAssetWrite(buffer, size, nullptr, chunkPayloads()));
+    EXPECT_EQ(0u, NvBlastExtRawAssetWrite(buffer, size - 1, m_asset, chunkPayloads()));
+    EXPECT_EQ(0, memcmp(copy.data(), buffer, (size_t)size));
+
+    void* unaligned = alignedZeroedAlloc((size_t)size + 16);
+    EXPECT_EQ(0u, NvBlastExtRawAssetWrite(static_cast<char*>(unaligned) + 4, size, m_asset, chunkPayloads()));
+    memcpy(static_cast<char*>(unaligned) + 4, buffer, (size_t)size);
+    EXPECT_TRUE(NvBlastExtRawAssetGetAsset(static_cast<char*>(unaligned) + 4, size) == nullptr);
+    alignedFree(unaligned);
+
+    // reading
+    EXPECT_TRUE(NvBlastExtRawAssetGetAsset(nullptr, size) == nullptr);
+    EXPECT_TRUE(NvBlastExtRawAssetGetAsset(buffer, size - 1) == nullptr);  // truncated
+    EXPECT_TRUE(NvBlastExtRawAssetGetAsset(buffer, 8) == nullptr);
+
+    // header fields, in the order they are written: fourCC, version, size, assetOffset, chunkCount, partitionOffset, payloadTableOffset
+    uint32_t* header = reinterpret_cast<uint32_t*>(buffer);
+    const uint32_t partitionOffset = header[6];
+    const uint32_t payloadTableOffset = header[7];
+
+    struct Corruption
+    {
+        uint32_t    offset;
+        uint32_t    value;
+    };
+    const Corruption corruptions[] =
+    {
+        { 0, 0x12345678 },                          // fourCC
+        { 4, 2 },                                   // version
+        { 16, 8 },                                  // misaligned asset offset
+        { 20, chunkCount() + 1 },                   // chunk count
+        { 24, payloadTableOffset },                 // partition overlapping the payload table
+        { partitionOffset, 1 },                     // partition does not start at 0
+        { partitionOffset + 4, 0xffff },            // partition not sorted
+        { payloadTableOffset, 0 },                  // payload inside the header
+        { payloadTableOffset, (uint32_t)size },     // payload past the end
+    };
+
+    for (const Corruption& corruption : corruptions)
+    {
+        uint32_t& word = *reinterpret_cast<uint32_t*>(buffer + corruption.offset);
+        const uint32_t original = word;
+        word = corruption.value;
+        EXPECT_TRUE(NvBlastExtRawAssetGetAsset(buffer, size) == nullptr) << "corrupt word at " << corruption.offset;
+        word = original;
+    }
+
+    // asset data block type
+    const uint32_t assetOffset = header[4];
+    reinterpret_cast<NvBlastDataBlock*>(buffer + assetOffset)->dataType = NvBlastDataBlock::FamilyDataBlock;
+    EXPECT_TRUE(NvBlastExtRawAssetGetAsset(buffer, size) == nullptr);
+    reinterpret_cast<NvBlastDataBlock*>(buffer + assetOffset)->dataType = NvBlastDataBlock::AssetDataBlock;
+
+    EXPECT_TRUE(NvBlastExtRawAssetGetAsset(buffer, size) != nullptr);
+}
@@ -3673,6 +3673,185 @@ typedef NvFlowThreadPoolInterface* (NV_FLOW_ABI* PFN_NvFlowThreadPoolInterface)(
 
 NV_FLOW_API NvFlowThreadPoolInterface* NvFlowGetThreadPoolInterface();
 
+/// ********************************* Gas CPU ***************************************
+
+// Coarse sparse grid simulated on the CPU, for gameplay volumes (smoke, poison clouds) on servers without a GPU.
+// Uses the block layout of NvFlowSparse: blocks of 2^blockDimBits cells, addressed by NvFlowInt4 locations (w is the layer, always 0).
+// Simulation is first order semi-Lagrangian advection of velocity and density, without pressure solve,
+// diffusion stands in for the spreading the pressure solve would provide.
+
+struct NvFlowGasCPU;
+typedef struct NvFlowGasCPU NvFlowGasCPU;
+
+typedef struct NvFlowGasCPUDesc
+{
+    float cellSize;                                     //!< World size of one cell
+    NvFlowUint3 blockDimBits;                           //!< Cells per block, log2
+    NvFlowUint maxLocations;                            //!< Block limit, the lowest priority blocks are dropped beyond it
+    NvFlowThreadPoolInterface* threadPoolInterface;     //!< Optional, runs the simulation on the calling thread when null
+    NvFlowThreadPool* threadPool;
+}NvFlowGasCPUDesc;
+
+#define NvFlowGasCPUDesc_default_init { \
+    1.f,            /*cellSize*/ \
+    {3u, 3u, 3u},    /*blockDimBits*/ \
+    4096u,            /*maxLocations*/ \
+    0,                /*threadPoolInterface*/ \
+    0                /*threadPool*/ \
+}
+static const NvFlowGasCPUDesc NvFlowGasCPUDesc_default = NvFlowGasCPUDesc_default_init;
+
+typedef struct NvFlowGasCPUParams
+{
+    NvFlowAdvectionChannelParams velocity;    //!< Only damping and fade are used
+    NvFlowAdvectionChannelParams density;    //!< Only damping and fade are used
+
+    float buoyancyPerDensity;        //!< Buoyant force per unit density
+    float buoyancyMaxDensity;        //!< Density clamp value applied before computing buoyancy
+    NvFlowFloat3 gravity;
+
+    NvFlowFloat3 wind;                //!< Velocity the gas relaxes to
+    float windCoupleRate;
+
+    float diffusionRate;            //!< Rate at which cells relax to the average of their neighbors
+
+    float allocationThreshold;        //!< Blocks whose density stays below this value are freed
+}NvFlowGasCPUParams;
+
+#define NvFlowGasCPUParams_default_init { \
+    {0.001f, 0.5f, 0.01f, 1.00f},    /*velocity : {secondOrderBlendThreshold, secondOrderBlendFactor, damping, fade}*/ \
+    {0.001f, 0.9f, 0.05f, 0.02f},    /*density : {secondOrderBlendThreshold, secondOrderBlendFactor, damping, fade}*/ \
+    0.f,                /*buoyancyPerDensity*/ \
+    1.f,                /*buoyancyMaxDensity*/ \
+    {0.f, -9.8f, 0.f},    /*gravity*/ \
+    {0.f, 0.f, 0.f},    /*wind*/ \
+    0.f,                /*windCoupleRate*/ \
+    2.f,                /*diffusionRate*/ \
+    0.01f                /*allocationThreshold*/ \
+}
+static const NvFlowGasCPUParams NvFlowGasCPUParams_default = NvFlowGasCPUParams_default_init;
+
+#define NV_FLOW_REFLECT_TYPE NvFlowGasCPUParams
+NV_FLOW_REFLECT_BEGIN()
+NV_FLOW_REFLECT_VALUE(NvFlowAdvectionChannelParams, velocity, 0, 0)
+NV_FLOW_REFLECT_VALUE(NvFlowAdvectionChannelParams, density, 0, 0)
+NV_FLOW_REFLECT_VALUE(float, buoyancyPerDensity, 0, 0)
+NV_FLOW_REFLECT_VALUE(float, buoyancyMaxDensity, 0, 0)
+NV_FLOW_REFLECT_VALUE(NvFlowFloat3, gravity, 0, 0)
+NV_FLOW_REFLECT_VALUE(NvFlowFloat3, wind, 0, 0)
+NV_FLOW_REFLECT_VALUE(float, windCoupleRate, 0, 0)
+NV_FLOW_REFLECT_VALUE(float, diffusionRate, 0, 0)
+NV_FLOW_REFLECT_VALUE(float, allocationThreshold, 0, 0)
+NV_FLOW_REFLECT_END(&NvFlowGasCPUParams_default)
+#undef NV_FLOW_REFLECT_TYPE
+
+typedef struct NvFlowGasCPUEmitterSphere
+{
+    NvFlowFloat3 position;
+    float radius;
+    NvFlowFloat3 velocity;
+    float density;
+    float coupleRateVelocity;
+    float coupleRateDensity;
+}NvFlowGasCPUEmitterSphere;
+
+typedef struct NvFlowGasCPUInterface
+{
+    NV_FLOW_REFLECT_INTERFACE();
+
+    NvFlowGasCPU*(NV_FLOW_ABI* create)(const NvFlowGasCPUDesc* desc);
+
+    void(NV_FLOW_ABI* destroy)(NvFlowGasCPU* gas);
+
+    void(NV_FLOW_ABI* reset)(NvFlowGasCPU* gas);
+
+    void(NV_FLOW_ABI* update)(NvFlowGasCPU* gas, const NvFlowGasCPUParams* params, const NvFlowGasCPUEmitterSphere* emitters, NvFlowUint64 emitterCount, float deltaTime);
+
+    // Trilinear density at world positions, 0 outside of the allocated blocks
+    void(NV_FLOW_ABI* sampleDensity)(NvFlowGasCPU* gas, const NvFlowFloat3* positions, float* densities, NvFlowUint64 count);
+
+    // Density integrated along rays (optical depth), rayDirections must be normalized
+    // Each ray stops once maxDensity is reached, stopDistances (optional) receives where, the ray length if it ran to the end
+    void(NV_FLOW_ABI* integrateDensity)(NvFlowGasCPU* gas, const NvFlowFloat3* rayOrigins, const NvFlowFloat3* rayDirections, const float* rayLengths, float maxDensity, float* densities, float* stopDistances, NvFlowUint64 count);
+
+    void(NV_FLOW_ABI* getLocations)(NvFlowGasCPU* gas, const NvFlowInt4** pLocations, NvFlowUint64* pLocationCount);
+}NvFlowGasCPUInterface;
+
+#define NV_FLOW_REFLECT_TYPE NvFlowGasCPUInterface
+NV_FLOW_REFLECT_BEGIN()
+NV_FLOW_REFLECT_FUNCTION_POINTER(create, 0, 0)
+NV_FLOW_REFLECT_FUNCTION_POINTER(destroy, 0, 0)
+NV_FLOW_REFLECT_FUNCTION_POINTER(reset, 0, 0)
+NV_FLOW_REFLECT_FUNCTION_POINTER(update, 0, 0)
+NV_FLOW_REFLECT_FUNCTION_POINTER(sampleDensity, 0, 0)
+NV_FLOW_REFLECT_FUNCTION_POINTER(integrateDensity, 0, 0)
+NV_FLOW_REFLECT_FUNCTION_POINTER(getLocations, 0, 0)
+NV_FLOW_REFLECT_END(0)
+NV_FLOW_REFLECT_INTERFACE_IMPL()
+#undef NV_FLOW_REFLECT_TYPE
+
+typedef NvFlowGasCPUInterface* (NV_FLOW_ABI* PFN_NvFlowGetGasCPUInterface)();
+
+NV_FLOW_API NvFlowGasCPUInterface* NvFlowGetGasCPUInterface();
+
+/// ********************************* NanoVdb Import ***************************************
+
+// Resamples a NanoVDB float grid (density or level set) into a dense grid on the CPU, a few z slices at a time.
+// Sample (x, y, z) is at lower + (x, y, z) * spacing, stored at index (z * dims.y + y) * dims.x + x.
+// This is the layout of a precomputed PxSDFDesc (sdf, dims, meshLower, spacing with subgridSize 0),
+// and of NvFlowEmitterTextureParams textures with halfSize = 0.5 * dims * spacing, centered on lower + 0.5 * (dims - 1) * spacing.
+
+struct NvFlowNanoVdbImport;
+typedef struct NvFlowNanoVdbImport NvFlowNanoVdbImport;
+
+typedef struct NvFlowNanoVdbImportDesc
+{
+    NvFlowUint* nanoVdb;            //!< NanoVDB grid of type float, must stay valid while importing
+    NvFlowUint64 nanoVdbCount;        //!< Size of the grid, in 32-bit words
+    NvFlowFloat3 boundsMin;            //!< World region to import, the bounds of the grid when boundsMin > boundsMax
+    NvFlowFloat3 boundsMax;
+    float spacing;                    //!< World distance between samples, the voxel size of the grid when <= 0
+}NvFlowNanoVdbImportDesc;
+
+#define NvFlowNanoVdbImportDesc_default_init { \
+    0,                    /*nanoVdb*/ \
+    0llu,                /*nanoVdbCount*/ \
+    {1.f, 1.f, 1.f},    /*boundsMin*/ \
+    {0.f, 0.f, 0.f},    /*boundsMax*/ \
+    0.f                    /*spacing*/ \
+}
+static const NvFlowNanoVdbImportDesc NvFlowNanoVdbImportDesc_default = NvFlowNanoVdbImportDesc_default_init;
+
+typedef struct NvFlowNanoVdbImportInterface
+{
+    NV_FLOW_REFLECT_INTERFACE();
+
+    // Returns null if the buffer is not a float NanoVDB grid
+    NvFlowNanoVdbImport*(NV_FLOW_ABI* create)(const NvFlowNanoVdbImportDesc* desc);
+
+    void(NV_FLOW_ABI* destroy)(NvFlowNanoVdbImport* importer);
+
+    void(NV_FLOW_ABI* getGrid)(NvFlowNanoVdbImport* importer, NvFlowUint3* pDims, NvFlowFloat3* pLower, float* pSpacing);
+
+    // Writes slices [zBegin, zBegin + zCount) of the dense grid, values points to the whole grid (dims.x * dims.y * dims.z floats)
+    // Returns the number of slices left after zBegin + zCount, so that large grids can be imported over several frames
+    NvFlowUint(NV_FLOW_ABI* importSlices)(NvFlowNanoVdbImport* importer, NvFlowUint zBegin, NvFlowUint zCount, float* values);
+}NvFlowNanoVdbImportInterface;
+
+#define NV_FLOW_REFLECT_TYPE NvFlowNanoVdbImportInterface
+NV_FLOW_REFLECT_BEGIN()
+NV_FLOW_REFLECT_FUNCTION_POINTER(create, 0, 0)
+NV_FLOW_REFLECT_FUNCTION_POINTER(destroy, 0, 0)
+NV_FLOW_REFLECT_FUNCTION_POINTER(getGrid, 0, 0)
+NV_FLOW_REFLECT_FUNCTION_POINTER(importSlices, 0, 0)
+NV_FLOW_REFLECT_END(0)
+NV_FLOW_REFLECT_INTERFACE_IMPL()
+#undef NV_FLOW_REFLECT_TYPE
+
+typedef NvFlowNanoVdbImportInterface* (NV_FLOW_ABI* PFN_NvFlowGetNanoVdbImportInterface)();
+
+NV_FLOW_API NvFlowNanoVdbImportInterface* NvFlowGetNanoVdbImportInterface();
+
 /// ********************************* Optimization Layer ***************************************
 
 struct NvFlowContextOpt;
@@ -0,0 +1,622 @@
+// SPDX-FileCopyrightText: Copyright (c) 2014-2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "NvFlowExt.h"
+
+#include "NvFlowArray.h"
+#include "NvFlowMath.h"
+#include "NvFlowLocationHashTable.h"
+
+namespace NvFlowGasCPUDefault
+{
+    // queries per task when sampling through the thread pool
+    static const NvFlowUint queriesPerTask = 64u;
+
+    struct GasCPU
+    {
+        NvFlowGasCPUDesc desc = {};
+        NvFlowThreadPoolInterface threadPoolInterface = {};
+
+        NvFlowUint3 blockDim = {};
+        NvFlowUint cellsPerBlock = 0u;
+        float cellSizeInv = 1.f;
+
+        // double buffered, the front table and cells are the current state
+        NvFlowLocationHashTable tables[2u];
+        NvFlowUint tableFrontIdx = 0u;
+        NvFlowArray<NvFlowFloat4> cells[2u];    // velocity xyz, density w
+        NvFlowUint cellFrontIdx = 0u;
+        NvFlowArray<float> maxDensities;        // per front block, drives allocation
+
+        // per update/query state read by the tasks
+        const NvFlowGasCPUParams* params = nullptr;
+        const NvFlowGasCPUEmitterSphere* emitters = nullptr;
+        NvFlowUint64 emitterCount = 0u;
+        float deltaTime = 0.f;
+        const NvFlowFloat3* queryPositions = nullptr;
+        const NvFlowFloat3* queryDirections = nullptr;
+        const float* queryLengths = nullptr;
+        float queryMaxDensity = 0.f;
+        float* queryResults = nullptr;
+        float* queryStopDistances = nullptr;
+        NvFlowUint64 queryCount = 0u;
+    };
+
+    NV_FLOW_CAST_PAIR(NvFlowGasCPU, GasCPU)
+
+    // single entry cache, consecutive fetches mostly land in the same block
+    struct BlockCache
+    {
+        NvFlowInt4 location;
+        NvFlowUint64 blockIdx;
+    };
+
+    NV_FLOW_INLINE void execute(GasCPU* ptr, NvFlowUint taskCount, NvFlowThreadPoolTask_t task)
+    {
+        if (ptr->desc.threadPool)
+        {
+            ptr->threadPoolInterface.execute(ptr->desc.threadPool, taskCount, 1u, task, ptr);
+        }
+        else
+        {
+            for (NvFlowUint taskIdx = 0u; taskIdx < taskCount; taskIdx++)
+            {
+                task(taskIdx, 0u, nullptr, ptr);
+            }
+        }
+    }
+
+    NV_FLOW_INLINE NvFlowInt4 cellToLocation(const GasCPU* ptr, int x, int y, int z)
+    {
+        return NvFlowInt4{ x >> ptr->desc.blockDimBits.x, y >> ptr->desc.blockDimBits.y, z >> ptr->desc.blockDimBits.z, 0 };
+    }
+
+    NV_FLOW_INLINE NvFlowUint cellToBlockOffset(const GasCPU* ptr, int x, int y, int z)
+    {
+        return ((NvFlowUint)(z & (ptr->blockDim.z - 1u)) << (ptr->desc.blockDimBits.x + ptr->desc.blockDimBits.y)) |
+            ((NvFlowUint)(y & (ptr->blockDim.y - 1u)) << ptr->desc.blockDimBits.x) |
+            (NvFlowUint)(x & (ptr->blockDim.x - 1u));
+    }
+
+    NvFlowFloat4 fetchCell(const GasCPU* ptr, NvFlowLocationHashTable* table, const NvFlowFloat4* cells, BlockCache* cache, int x, int y, int z)
+    {
+        NvFlowInt4 location = cellToLocation(ptr, x, y, z);
+        if (location.x != cache->location.x || location.y != cache->location.y || location.z != cache->location.z)
+        {
+            cache->location = location;
+            cache->blockIdx = table->find(location);
+        }
+        if (cache->blockIdx == ~0llu)
+        {
+            return NvFlowFloat4{ 0.f, 0.f, 0.f, 0.f };
+        }
+        return cells[cache->blockIdx * ptr->cellsPerBlock + cellToBlockOffset(ptr, x, y, z)];
+    }
+
+    NvFlowFloat4 sampleCells(GasCPU* ptr, BlockCache* cache, NvFlowFloat3 position)
+    {
+        // cell centers are at (i + 0.5) * cellSize
+        float fx = position.x * ptr->cellSizeInv - 0.5f;
+        float fy = position.y * ptr->cellSizeInv - 0.5f;
+        float fz = position.z * ptr->cellSizeInv - 0.5f;
+        int x = (int)floorf(fx);
+        int y = (int)floorf(fy);
+        int z = (int)floorf(fz);
+        float tx = fx - (float)x;
+        float ty = fy - (float)y;
+        float tz = fz - (float)z;
+
+        NvFlowFloat4 sum = { 0.f, 0.f, 0.f, 0.f };
+        for (int k = 0; k < 8; k++)
+        {
+            int dx = k & 1;
+            int dy = (k >> 1) & 1;
+            int dz = (k >> 2) & 1;
+            float w = (dx ? tx : 1.f - tx) * (dy ? ty : 1.f - ty) * (dz ? tz : 1.f - tz);
+            NvFlowFloat4 value = fetchCell(ptr, &ptr->tables[ptr->tableFrontIdx], ptr->cells[ptr->cellFrontIdx].data, cache, x + dx, y + dy, z + dz);
+            sum.x += w * value.x;
+            sum.y += w * value.y;
+            sum.z += w * value.z;
+            sum.w += w * value.w;
+        }
+        return sum;
+    }
+
+    // damping/fade as applied by the GPU advection
+    NV_FLOW_INLINE float applyFade(float value, float dampingRate, float fadeAmount)
+    {
+        float magnitude = fabsf(value * dampingRate);
+        if (fadeAmount > magnitude)
+        {
+            magnitude = fadeAmount;
+        }
+        if (magnitude > fabsf(value))
+        {
+            return 0.f;
+        }
+        return value > 0.f ? value - magnitude : value + magnitude;
+    }
+
+    NV_FLOW_INLINE float computeDampingRate(float damping, float deltaTime)
+    {
+        return 1.f - powf(1.f - damping, deltaTime);
+    }
+
+    // copies the front cells into the back cells laid out for the reallocated front table, before the cells are flipped
+    void remapTask(NvFlowUint taskIdx, NvFlowUint threadIdx, void* sharedMem, void* userdata)
+    {
+        auto ptr = (GasCPU*)userdata;
+        NvFlowUint64 oldBlockIdx = ptr->tables[ptr->tableFrontIdx ^ 1u].find(ptr->tables[ptr->tableFrontIdx].locations[taskIdx]);
+        NvFlowFloat4* dst = ptr->cells[ptr->cellFrontIdx ^ 1u].data + (NvFlowUint64)taskIdx * ptr->cellsPerBlock;
+        if (oldBlockIdx == ~0llu)
+        {
+            for (NvFlowUint cellIdx = 0u; cellIdx < ptr->cellsPerBlock; cellIdx++)
+            {
+                dst[cellIdx] = NvFlowFloat4{ 0.f, 0.f, 0.f, 0.f };
+            }
+            return;
+        }
+        const NvFlowFloat4* src = ptr->cells[ptr->cellFrontIdx].data + oldBlockIdx * ptr->cellsPerBlock;
+        for (NvFlowUint cellIdx = 0u; cellIdx < ptr->cellsPerBlock; cellIdx++)
+        {
+            dst[cellIdx] = src[cellIdx];
+        }
+    }
+
+    void emitTask(NvFlowUint taskIdx, NvFlowUint threadIdx, void* sharedMem, void* userdata)
+    {
+        auto ptr = (GasCPU*)userdata;
+        NvFlowInt4 location = ptr->tables[ptr->tableFrontIdx].locations[taskIdx];
+        NvFlowFloat4* dst = ptr->cells[ptr->cellFrontIdx].data + (NvFlowUint64)taskIdx * ptr->cellsPerBlock;
+        float cellSize = ptr->desc.cellSize;
+        float blockMin[3] = {
+            (float)(location.x * (int)ptr->blockDim.x) * cellSize,
+            (float)(location.y * (int)ptr->blockDim.y) * cellSize,
+            (float)(location.z * (int)ptr->blockDim.z) * cellSize
+        };
+        float blockMax[3] = {
+            blockMin[0] + (float)ptr->blockDim.x * cellSize,
+            blockMin[1] + (float)ptr->blockDim.y * cellSize,
+            blockMin[2] + (float)ptr->blockDim.z * cellSize
+        };
+        for (NvFlowUint64 emitterIdx = 0u; emitterIdx < ptr->emitterCount; emitterIdx++)
+        {
+            const NvFlowGasCPUEmitterSphere& emitter = ptr->emitters[emitterIdx];
+            if (emitter.position.x + emitter.radius < blockMin[0] || emitter.position.x - emitter.radius > blockMax[0] ||
+                emitter.position.y + emitter.radius < blockMin[1] || emitter.position.y - emitter.radius > blockMax[1] ||
+                emitter.position.z + emitter.radius < blockMin[2] || emitter.position.z - emitter.radius > blockMax[2])
+            {
+                continue;
+            }
+            float rateVelocity = ptr->deltaTime * emitter.coupleRateVelocity;
+            float rateDensity = ptr->deltaTime * emitter.coupleRateDensity;
+            rateVelocity = rateVelocity < 0.f ? 0.f : (rateVelocity > 1.f ? 1.f : rateVelocity);
+            rateDensity = rateDensity < 0.f ? 0.f : (rateDensity > 1.f ? 1.f : rateDensity);
+            float radius2 = emitter.radius * emitter.radius;
+            for (NvFlowUint cellIdx = 0u; cellIdx < ptr->cellsPerBlock; cellIdx++)
+            {
+                NvFlowUint i = cellIdx & (ptr->blockDim.x - 1u);
+                NvFlowUint j = (cellIdx >> ptr->desc.blockDimBits.x) & (ptr->blockDim.y - 1u);
+                NvFlowUint k = cellIdx >> (ptr->desc.blockDimBits.x + ptr->desc.blockDimBits.y);
+                float dx = blockMin[0] + ((float)i + 0.5f) * cellSize - emitter.position.x;
+                float dy = blockMin[1] + ((float)j + 0.5f) * cellSize - emitter.position.y;
+                float dz = blockMin[2] + ((float)k + 0.5f) * cellSize - emitter.position.z;
+                if (dx * dx + dy * dy + dz * dz > radius2)
+                {
+                    continue;
+                }
+                NvFlowFloat4 value = dst[cellIdx];
+                value.x += rateVelocity * (emitter.velocity.x - value.x);
+                value.y += rateVelocity * (emitter.velocity.y - value.y);
+                value.z += rateVelocity * (emitter.velocity.z - value.z);
+                value.w += rateDensity * (emitter.density - value.w);
+                dst[cellIdx] = value;
+            }
+        }
+    }
+
+    // semi-Lagrangian advection from the front cells into the back cells, then forces and fade
+    void advectTask(NvFlowUint taskIdx, NvFlowUint threadIdx, void* sharedMem, void* userdata)
+    {
+        auto ptr = (GasCPU*)userdata;
+        const NvFlowGasCPUParams* params = ptr->params;
+        float deltaTime = ptr->deltaTime;
+        NvFlowInt4 location = ptr->tables[ptr->tableFrontIdx].locations[taskIdx];
+        const NvFlowFloat4* src = ptr->cells[ptr->cellFrontIdx].data + (NvFlowUint64)taskIdx * ptr->cellsPerBlock;
+        NvFlowFloat4* dst = ptr->cells[ptr->cellFrontIdx ^ 1u].data + (NvFlowUint64)taskIdx * ptr->cellsPerBlock;
+
+        float velocityDampingRate = computeDampingRate(params->velocity.damping, deltaTime);
+        float velocityFade = deltaTime * params->velocity.fade;
+        float densityDampingRate = computeDampingRate(params->density.damping, deltaTime);
+        float densityFade = deltaTime * params->density.fade;
+        float windRate = deltaTime * params->windCoupleRate;
+        windRate = windRate < 0.f ? 0.f : (windRate > 1.f ? 1.f : windRate);
+        float diffusionRate = deltaTime * params->diffusionRate;
+        diffusionRate = diffusionRate < 0.f ? 0.f : (diffusionRate > 1.f ? 1.f : diffusionRate);
+        NvFlowLocationHashTable* table = &ptr->tables[ptr->tableFrontIdx];
+        const NvFlowFloat4* frontCells = ptr->cells[ptr->cellFrontIdx].data;
+
+        BlockCache cache = { location, taskIdx };
+        float maxDensity = 0.f;
+        for (NvFlowUint cellIdx = 0u; cellIdx < ptr->cellsPerBlock; cellIdx++)
+        {
+            int i = (int)(cellIdx & (ptr->blockDim.x - 1u));
+            int j = (int)((cellIdx >> ptr->desc.blockDimBits.x) & (ptr->blockDim.y - 1u));
+            int k = (int)(cellIdx >> (ptr->desc.blockDimBits.x + ptr->desc.blockDimBits.y));
+            NvFlowFloat4 velocity = src[cellIdx];
+            NvFlowFloat3 position = {
+                ((float)(location.x * (int)ptr->blockDim.x + i) + 0.5f) * ptr->desc.cellSize - deltaTime * velocity.x,
+                ((float)(location.y * (int)ptr->blockDim.y + j) + 0.5f) * ptr->desc.cellSize - deltaTime * velocity.y,
+                ((float)(location.z * (int)ptr->blockDim.z + k) + 0.5f) * ptr->desc.cellSize - deltaTime * velocity.z
+            };
+            NvFlowFloat4 value = sampleCells(ptr, &cache, position);
+
+            if (diffusionRate > 0.f)
+            {
+                int x = location.x * (int)ptr->blockDim.x + i;
+                int y = location.y * (int)ptr->blockDim.y + j;
+                int z = location.z * (int)ptr->blockDim.z + k;
+                NvFlowFloat4 neighbors[6] = {
+                    fetchCell(ptr, table, frontCells, &cache, x - 1, y, z),
+                    fetchCell(ptr, table, frontCells, &cache, x + 1, y, z),
+                    fetchCell(ptr, table, frontCells, &cache, x, y - 1, z),
+                    fetchCell(ptr, table, frontCells, &cache, x, y + 1, z),
+                    fetchCell(ptr, table, frontCells, &cache, x, y, z - 1),
+                    fetchCell(ptr, table, frontCells, &cache, x, y, z + 1)
+                };
+                float rate = diffusionRate * (1.f / 6.f);
+                for (int neighborIdx = 0; neighborIdx < 6; neighborIdx++)
+                {
+                    value.x += rate * (neighbors[neighborIdx].x - velocity.x);
+                    value.y += rate * (neighbors[neighborIdx].y - velocity.y);
+                    value.z += rate * (neighbors[neighborIdx].z - velocity.z);
+                    value.w += rate * (neighbors[neighborIdx].w - velocity.w);
+                }
+            }
+
+            float buoyancyDensity = value.w < params->buoyancyMaxDensity ? value.w : params->buoyancyMaxDensity;
+            float buoyancy = -deltaTime * params->buoyancyPerDensity * buoyancyDensity;
+            value.x += buoyancy * params->gravity.x + windRate * (params->wind.x - value.x);
+            value.y += buoyancy * params->gravity.y + windRate * (params->wind.y - value.y);
+            value.z += buoyancy * params->gravity.z + windRate * (params->wind.z - value.z);
+
+            value.x = applyFade(value.x, velocityDampingRate, velocityFade);
+            value.y = applyFade(value.y, velocityDampingRate, velocityFade);
+            value.z = applyFade(value.z, velocityDampingRate, velocityFade);
+            value.w = applyFade(value.w, densityDampingRate, densityFade);
+
+            if (value.w > maxDensity)
+            {
+                maxDensity = value.w;
+            }
+            dst[cellIdx] = value;
+        }
+        ptr->maxDensities[taskIdx] = maxDensity;
+    }
+
+    void pushEmitterLocations(GasCPU* ptr, NvFlowLocationHashTable& table)
+    {
+        for (NvFlowUint64 emitterIdx = 0u; emitterIdx < ptr->emitterCount; emitterIdx++)
+        {
+            const NvFlowGasCPUEmitterSphere& emitter = ptr->emitters[emitterIdx];
+            NvFlowInt4 locationMin = cellToLocation(ptr,
+                (int)floorf((emitter.position.x - emitter.radius) * ptr->cellSizeInv),
+                (int)floorf((emitter.position.y - emitter.radius) * ptr->cellSizeInv),
+                (int)floorf((emitter.position.z - emitter.radius) * ptr->cellSizeInv));
+            NvFlowInt4 locationMax = cellToLocation(ptr,
+                (int)floorf((emitter.position.x + emitter.radius) * ptr->cellSizeInv),
+                (int)floorf((emitter.position.y + emitter.radius) * ptr->cellSizeInv),
+                (int)floorf((emitter.position.z + emitter.radius) * ptr->cellSizeInv));
+            for (int k = locationMin.z; k <= locationMax.z; k++)
+            {
+                for (int j = locationMin.y; j <= locationMax.y; j++)
+                {
+                    for (int i = locationMin.x; i <= locationMax.x; i++)
+                    {
+                        table.push(NvFlowInt4{ i, j, k, 0 }, 1u);
+                    }
+                }
+            }
+        }
+    }
+
+    // keeps the blocks holding gas, their neighbors so the gas can flow into them, and the emitter blocks
+    void reallocate(GasCPU* ptr)
+    {
+        const NvFlowLocationHashTable& oldTable = ptr->tables[ptr->tableFrontIdx];
+        NvFlowLocationHashTable& table = ptr->tables[ptr->tableFrontIdx ^ 1u];
+        table.reset();
+
+        // pushed by priority, compactNonZeroWithLimit() keeps the first maxLocations
+        for (NvFlowUint64 blockIdx = 0u; blockIdx < oldTable.locations.size; blockIdx++)
+        {
+            if (ptr->maxDensities[blockIdx] >= ptr->params->allocationThreshold)
+            {
+                table.push(oldTable.locations[blockIdx], 1u);
+            }
+        }
+        pushEmitterLocations(ptr, table);
+        NvFlowUint64 activeCount = table.locations.size;
+        for (NvFlowUint64 blockIdx = 0u; blockIdx < activeCount; blockIdx++)
+        {
+            NvFlowInt4 location = table.locations[blockIdx];
+            for (int neighborIdx = 0; neighborIdx < 27; neighborIdx++)
+            {
+                if (neighborIdx == 13)
+                {
+                    continue;
+                }
+                table.push(NvFlowInt4{ location.x + neighborIdx % 3 - 1, location.y + (neighborIdx / 3) % 3 - 1, location.z + neighborIdx / 9 - 1, 0 }, 1u);
+            }
+        }
+        table.compactNonZeroWithLimit(ptr->desc.maxLocations);
+        table.sort();
+        table.computeStats();
+
+        ptr->tableFrontIdx ^= 1u;
+        NvFlowArray<NvFlowFloat4>& cells = ptr->cells[ptr->cellFrontIdx ^ 1u];
+        cells.reserve(table.locations.size * ptr->cellsPerBlock);
+        cells.size = table.locations.size * ptr->cellsPerBlock;
+        execute(ptr, (NvFlowUint)table.locations.size, remapTask);
+        ptr->cellFrontIdx ^= 1u;
+    }
+
+    void reset(NvFlowGasCPU* gas)
+    {
+        auto ptr = cast(gas);
+        for (NvFlowUint idx = 0u; idx < 2u; idx++)
+        {
+            ptr->tables[idx].reset();
+            ptr->cells[idx].size = 0u;
+        }
+        ptr->maxDensities.size = 0u;
+    }
+
+    NvFlowGasCPU* create(const NvFlowGasCPUDesc* desc)
+    {
+        auto ptr = new GasCPU();
+
+        ptr->desc = *desc;
+        if (desc->threadPoolInterface)
+        {
+            NvFlowThreadPoolInterface_duplicate(&ptr->threadPoolInterface, desc->threadPoolInterface);
+        }
+        else
+        {
+            ptr->desc.threadPool = nullptr;
+        }
+        ptr->blockDim = NvFlowUint3{ 1u << desc->blockDimBits.x, 1u << desc->blockDimBits.y, 1u << desc->blockDimBits.z };
+        ptr->cellsPerBlock = ptr->blockDim.x * ptr->blockDim.y * ptr->blockDim.z;
+        ptr->cellSizeInv = 1.f / desc->cellSize;
+
+        return cast(ptr);
+    }
+
+    void destroy(NvFlowGasCPU* gas)
+    {
+        auto ptr = cast(gas);
+        delete ptr;
+    }
+
+    void update(NvFlowGasCPU* gas, const NvFlowGasCPUParams* params, const NvFlowGasCPUEmitterSphere* emitters, NvFlowUint64 emitterCount, float deltaTime)
+    {
+        auto ptr = cast(gas);
+
+        ptr->params = params;
+        ptr->emitters = emitters;
+        ptr->emitterCount = emitterCount;
+        ptr->deltaTime = deltaTime;
+
+        reallocate(ptr);
+
+        NvFlowUint blockCount = (NvFlowUint)ptr->tables[ptr->tableFrontIdx].locations.size;
+        ptr->maxDensities.reserve(blockCount);
+        ptr->maxDensities.size = blockCount;
+        NvFlowArray<NvFlowFloat4>& cells = ptr->cells[ptr->cellFrontIdx ^ 1u];
+        cells.reserve(ptr->cells[ptr->cellFrontIdx].size);
+        cells.size = ptr->cells[ptr->cellFrontIdx].size;
+
+        execute(ptr, blockCount, emitTask);
+        execute(ptr, blockCount, advectTask);
+        ptr->cellFrontIdx ^= 1u;
+
+        ptr->params = nullptr;
+        ptr->emitters = nullptr;
+        ptr->emitterCount = 0u;
+    }
+
+    void sampleTask(NvFlowUint taskIdx, NvFlowUint threadIdx, void* sharedMem, void* userdata)
+    {
+        auto ptr = (GasCPU*)userdata;
+        NvFlowUint64 beginIdx = (NvFlowUint64)taskIdx * queriesPerTask;
+        NvFlowUint64 endIdx = beginIdx + queriesPerTask < ptr->queryCount ? beginIdx + queriesPerTask : ptr->queryCount;
+        BlockCache cache = { NvFlowInt4{ 0x40000000, 0x40000000, 0x40000000, 0 }, ~0llu };
+        for (NvFlowUint64 queryIdx = beginIdx; queryIdx < endIdx; queryIdx++)
+        {
+            ptr->queryResults[queryIdx] = sampleCells(ptr, &cache, ptr->queryPositions[queryIdx]).w;
+        }
+    }
+
+    float integrateRay(GasCPU* ptr, BlockCache* cache, NvFlowFloat3 origin, NvFlowFloat3 direction, float rayLength, float maxDensity, float* stopDistance)
+    {
+        *stopDistance = rayLength;
+
+        // clip to the allocated bounds
+        const NvFlowLocationHashTable& table = ptr->tables[ptr->tableFrontIdx];
+        const float originArr[3] = { origin.x, origin.y, origin.z };
+        const float directionArr[3] = { direction.x, direction.y, direction.z };
+        const int locationMin[3] = { table.locationMin.x, table.locationMin.y, table.locationMin.z };
+        const int locationMax[3] = { table.locationMax.x, table.locationMax.y, table.locationMax.z };
+        const NvFlowUint blockDim[3] = { ptr->blockDim.x, ptr->blockDim.y, ptr->blockDim.z };
+        float blockSize[3];
+        float tmin = 0.f;
+        float tmax = rayLength;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            blockSize[axis] = (float)blockDim[axis] * ptr->desc.cellSize;
+            float boundsMin = (float)locationMin[axis] * blockSize[axis];
+            float boundsMax = (float)locationMax[axis] * blockSize[axis];
+            if (directionArr[axis] == 0.f)
+            {
+                if (originArr[axis] < boundsMin || originArr[axis] > boundsMax)
+                {
+                    return 0.f;
+                }
+                continue;
+            }
+            float t0 = (boundsMin - originArr[axis]) / directionArr[axis];
+            float t1 = (boundsMax - originArr[axis]) / directionArr[axis];
+            if (t0 > t1)
+            {
+                float tmp = t0;
+                t0 = t1;
+                t1 = tmp;
+            }
+            tmin = t0 > tmin ? t0 : tmin;
+            tmax = t1 < tmax ? t1 : tmax;
+        }
+
+        // midpoint rule at half cell steps, skipping over unallocated blocks
+        float stepSize = 0.5f * ptr->desc.cellSize;
+        float sum = 0.f;
+        float t = tmin;
+        while (t < tmax)
+        {
+            float dt = tmax - t < stepSize ? tmax - t : stepSize;
+            NvFlowFloat3 position = {
+                origin.x + (t + 0.5f * dt) * direction.x,
+                origin.y + (t + 0.5f * dt) * direction.y,
+                origin.z + (t + 0.5f * dt) * direction.z
+            };
+            NvFlowInt4 location = cellToLocation(ptr,
+                (int)floorf(position.x * ptr->cellSizeInv),
+                (int)floorf(position.y * ptr->cellSizeInv),
+                (int)floorf(position.z * ptr->cellSizeInv));
+            if (ptr->tables[ptr->tableFrontIdx].find(location) == ~0llu)
+            {
+                // advance to the exit of the empty block
+                const int locationArr[3] = { location.x, location.y, location.z };
+                float tExit = tmax;
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    if (directionArr[axis] != 0.f)
+                    {
+                        float plane = (float)(locationArr[axis] + (directionArr[axis] > 0.f ? 1 : 0)) * blockSize[axis];
+                        float tPlane = (plane - originArr[axis]) / directionArr[axis];
+                        tExit = tPlane < tExit ? tPlane : tExit;
+                    }
+                }
+                t = tExit > t + dt ? tExit : t + dt;
+                continue;
+            }
+            sum += dt * sampleCells(ptr, cache, position).w;
+            t += dt;
+            if (sum >= maxDensity)
+            {
+                *stopDistance = t;
+                break;
+            }
+        }
+        return sum;
+    }
+
+    void integrateTask(NvFlowUint taskIdx, NvFlowUint threadIdx, void* sharedMem, void* userdata)
+    {
+        auto ptr = (GasCPU*)userdata;
+        NvFlowUint64 beginIdx = (NvFlowUint64)taskIdx * queriesPerTask;
+        NvFlowUint64 endIdx = beginIdx + queriesPerTask < ptr->queryCount ? beginIdx + queriesPerTask : ptr->queryCount;
+        BlockCache cache = { NvFlowInt4{ 0x40000000, 0x40000000, 0x40000000, 0 }, ~0llu };
+        for (NvFlowUint64 queryIdx = beginIdx; queryIdx < endIdx; queryIdx++)
+        {
+            float stopDistance = 0.f;
+            ptr->queryResults[queryIdx] = integrateRay(ptr, &cache, ptr->queryPositions[queryIdx], ptr->queryDirections[queryIdx], ptr->queryLengths[queryIdx], ptr->queryMaxDensity, &stopDistance);
+            if (ptr->queryStopDistances)
+            {
+                ptr->queryStopDistances[queryIdx] = stopDistance;
+            }
+        }
+    }
+
+    void sampleDensity(NvFlowGasCPU* gas, const NvFlowFloat3* positions, float* densities, NvFlowUint64 count)
+    {
+        auto ptr = cast(gas);
+
+        ptr->queryPositions = positions;
+        ptr->queryResults = densities;
+        ptr->queryCount = count;
+
+        execute(ptr, (NvFlowUint)((count + queriesPerTask - 1u) / queriesPerTask), sampleTask);
+
+        ptr->queryPositions = nullptr;
+        ptr->queryResults = nullptr;
+        ptr->queryCount = 0u;
+    }
+
+    void integrateDensity(NvFlowGasCPU* gas, const NvFlowFloat3* rayOrigins, const NvFlowFloat3* rayDirections, const float* rayLengths, float maxDensity, float* densities, float* stopDistances, NvFlowUint64 count)
+    {
+        auto ptr = cast(gas);
+
+        ptr->queryPositions = rayOrigins;
+        ptr->queryDirections = rayDirections;
+        ptr->queryLengths = rayLengths;
+        ptr->queryMaxDensity = maxDensity;
+        ptr->queryResults = densities;
+        ptr->queryStopDistances = stopDistances;
+        ptr->queryCount = count;
+
+        execute(ptr, (NvFlowUint)((count + queriesPerTask - 1u) / queriesPerTask), integrateTask);
+
+        ptr->queryPositions = nullptr;
+        ptr->queryDirections = nullptr;
+        ptr->queryLengths = nullptr;
+        ptr->queryResults = nullptr;
+        ptr->queryStopDistances = nullptr;
+        ptr->queryCount = 0u;
+    }
+
+    void getLocations(NvFlowGasCPU* gas, const NvFlowInt4** pLocations, NvFlowUint64* pLocationCount)
+    {
+        auto ptr = cast(gas);
+        const NvFlowLocationHashTable& table = ptr->tables[ptr->tableFrontIdx];
+        *pLocations = table.locations.data;
+        *pLocationCount = table.locations.size;
+    }
+}
+
+NvFlowGasCPUInterface* NvFlowGetGasCPUInterface()
+{
+    using namespace NvFlowGasCPUDefault;
+    static NvFlowGasCPUInterface iface = { NV_FLOW_REFLECT_INTERFACE_INIT(NvFlowGasCPUInterface) };
+    iface.create = create;
+    iface.destroy = destroy;
+    iface.reset = reset;
+    iface.update = update;
+    iface.sampleDensity = sampleDensity;
+    iface.integrateDensity = integrateDensity;
+    iface.getLocations = getLocations;
+    return &iface;
+}
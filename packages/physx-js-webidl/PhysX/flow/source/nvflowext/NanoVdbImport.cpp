@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: Copyright (c) 2014-2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "NvFlowExt.h"
+
+#include "NvFlowMath.h"
+
+#define PNANOVDB_C
+#include "nanovdb/PNanoVDB.h"
+
+namespace NvFlowNanoVdbImportDefault
+{
+    struct NanoVdbImport
+    {
+        pnanovdb_buf_t buf = {};
+        pnanovdb_grid_handle_t grid = {};
+        pnanovdb_root_handle_t root = {};
+
+        NvFlowUint3 dims = {};
+        NvFlowFloat3 lower = {};
+        float spacing = 0.f;
+    };
+
+    NV_FLOW_CAST_PAIR(NvFlowNanoVdbImport, NanoVdbImport)
+
+    NvFlowNanoVdbImport* create(const NvFlowNanoVdbImportDesc* desc)
+    {
+        if (!desc->nanoVdb || desc->nanoVdbCount == 0u)
+        {
+            return nullptr;
+        }
+        pnanovdb_buf_t buf = pnanovdb_make_buf(desc->nanoVdb, desc->nanoVdbCount);
+        pnanovdb_grid_handle_t grid = { 0u };
+        pnanovdb_uint64_t magic = pnanovdb_grid_get_magic(buf, grid);
+        if ((magic != PNANOVDB_MAGIC_NUMBER && magic != PNANOVDB_MAGIC_GRID) ||
+            pnanovdb_grid_get_grid_type(buf, grid) != PNANOVDB_GRID_TYPE_FLOAT)
+        {
+            return nullptr;
+        }
+        pnanovdb_tree_handle_t tree = pnanovdb_grid_get_tree(buf, grid);
+        pnanovdb_root_handle_t root = pnanovdb_tree_get_root(buf, tree);
+
+        NvFlowFloat3 boundsMin = desc->boundsMin;
+        NvFlowFloat3 boundsMax = desc->boundsMax;
+        if (boundsMin.x > boundsMax.x || boundsMin.y > boundsMax.y || boundsMin.z > boundsMax.z)
+        {
+            // world bounds of the active voxels
+            pnanovdb_coord_t bbox_min = pnanovdb_root_get_bbox_min(buf, root);
+            pnanovdb_coord_t bbox_max = pnanovdb_root_get_bbox_max(buf, root);
+            if (bbox_max.x < bbox_min.x || bbox_max.y < bbox_min.y || bbox_max.z < bbox_min.z)
+            {
+                return nullptr;
+            }
+            NvFlowFloat4 worldMin = { 0.f, 0.f, 0.f, 0.f };
+            NvFlowFloat4 worldMax = { 0.f, 0.f, 0.f, 0.f };
+            for (NvFlowUint idx = 0u; idx < 8u; idx++)
+            {
+                pnanovdb_vec3_t corner = {
+                    (float)((idx & 1u) ? bbox_max.x : bbox_min.x),
+                    (float)((idx & 2u) ? bbox_max.y : bbox_min.y),
+                    (float)((idx & 4u) ? bbox_max.z : bbox_min.z)
+                };
+                pnanovdb_vec3_t world = pnanovdb_grid_index_to_worldf(buf, grid, PNANOVDB_REF(corner));
+                NvFlowFloat4 world4 = { world.x, world.y, world.z, 1.f };
+                if (idx == 0u)
+                {
+                    worldMin = world4;
+                    worldMax = world4;
+                }
+                worldMin = NvFlowMath::vectorMin(worldMin, world4);
+                worldMax = NvFlowMath::vectorMax(worldMax, world4);
+            }
+            boundsMin = NvFlowFloat3{ worldMin.x, worldMin.y, worldMin.z };
+            boundsMax = NvFlowFloat3{ worldMax.x, worldMax.y, worldMax.z };
+        }
+
+        float spacing = desc->spacing;
+        if (spacing <= 0.f)
+        {
+            spacing = (float)pnanovdb_grid_get_voxel_size(buf, grid, 0u);
+        }
+        if (spacing <= 0.f)
+        {
+            return nullptr;
+        }
+
+        auto ptr = new NanoVdbImport();
+
+        ptr->buf = buf;
+        ptr->grid = grid;
+        ptr->root = root;
+        ptr->spacing = spacing;
+        ptr->lower = boundsMin;
+        // samples on both bounds
+        ptr->dims.x = (NvFlowUint)ceilf((boundsMax.x - boundsMin.x) / spacing) + 1u;
+        ptr->dims.y = (NvFlowUint)ceilf((boundsMax.y - boundsMin.y) / spacing) + 1u;
+        ptr->dims.z = (NvFlowUint)ceilf((boundsMax.z - boundsMin.z) / spacing) + 1u;
+
+        return cast(ptr);
+    }
+
+    void destroy(NvFlowNanoVdbImport* importer)
+    {
+        auto ptr = cast(importer);
+        delete ptr;
+    }
+
+    void getGrid(NvFlowNanoVdbImport* importer, NvFlowUint3* pDims, NvFlowFloat3* pLower, float* pSpacing)
+    {
+        auto ptr = cast(importer);
+        if (pDims)
+        {
+            *pDims = ptr->dims;
+        }
+        if (pLower)
+        {
+            *pLower = ptr->lower;
+        }
+        if (pSpacing)
+        {
+            *pSpacing = ptr->spacing;
+        }
+    }
+
+    NV_FLOW_INLINE float readValue(NanoVdbImport* ptr, pnanovdb_readaccessor_t* acc, pnanovdb_int32_t i, pnanovdb_int32_t j, pnanovdb_int32_t k)
+    {
+        pnanovdb_coord_t ijk = { i, j, k };
+        pnanovdb_address_t address = pnanovdb_readaccessor_get_value_address(PNANOVDB_GRID_TYPE_FLOAT, ptr->buf, acc, PNANOVDB_REF(ijk));
+        return pnanovdb_read_float(ptr->buf, address);
+    }
+
+    NvFlowUint importSlices(NvFlowNanoVdbImport* importer, NvFlowUint zBegin, NvFlowUint zCount, float* values)
+    {
+        auto ptr = cast(importer);
+
+        NvFlowUint zEnd = zBegin + zCount < ptr->dims.z ? zBegin + zCount : ptr->dims.z;
+
+        // inactive voxels read as the background value, or the value of the tile containing them
+        pnanovdb_readaccessor_t acc;
+        pnanovdb_readaccessor_init(PNANOVDB_REF(acc), ptr->root);
+
+        for (NvFlowUint z = zBegin; z < zEnd; z++)
+        {
+            for (NvFlowUint y = 0u; y < ptr->dims.y; y++)
+            {
+                float* row = values + ((NvFlowUint64)z * ptr->dims.y + y) * ptr->dims.x;
+                for (NvFlowUint x = 0u; x < ptr->dims.x; x++)
+                {
+                    pnanovdb_vec3_t world = {
+                        ptr->lower.x + (float)x * ptr->spacing,
+                        ptr->lower.y + (float)y * ptr->spacing,
+                        ptr->lower.z + (float)z * ptr->spacing
+                    };
+                    // voxel values are at integer index coordinates
+                    pnanovdb_vec3_t index = pnanovdb_grid_world_to_indexf(ptr->buf, ptr->grid, PNANOVDB_REF(world));
+                    float fi = floorf(index.x);
+                    float fj = floorf(index.y);
+                    float fk = floorf(index.z);
+                    float tx = index.x - fi;
+                    float ty = index.y - fj;
+                    float tz = index.z - fk;
+                    pnanovdb_int32_t i = (pnanovdb_int32_t)fi;
+                    pnanovdb_int32_t j = (pnanovdb_int32_t)fj;
+                    pnanovdb_int32_t k = (pnanovdb_int32_t)fk;
+
+                    float v000 = readValue(ptr, &acc, i, j, k);
+                    float v100 = readValue(ptr, &acc, i + 1, j, k);
+                    float v010 = readValue(ptr, &acc, i, j + 1, k);
+                    float v110 = readValue(ptr, &acc, i + 1, j + 1, k);
+                    float v001 = readValue(ptr, &acc, i, j, k + 1);
+                    float v101 = readValue(ptr, &acc, i + 1, j, k + 1);
+                    float v011 = readValue(ptr, &acc, i, j + 1, k + 1);
+                    float v111 = readValue(ptr, &acc, i + 1, j + 1, k + 1);
+
+                    float v00 = v000 + tx * (v100 - v000);
+                    float v10 = v010 + tx * (v110 - v010);
+                    float v01 = v001 + tx * (v101 - v001);
+                    float v11 = v011 + tx * (v111 - v011);
+                    float v0 = v00 + ty * (v10 - v00);
+                    float v1 = v01 + ty * (v11 - v01);
+                    row[x] = v0 + tz * (v1 - v0);
+                }
+            }
+        }
+        return ptr->dims.z - zEnd;
+    }
+}
+
+NvFlowNanoVdbImportInterface* NvFlowGetNanoVdbImportInterface()
+{
+    using namespace NvFlowNanoVdbImportDefault;
+    static NvFlowNanoVdbImportInterface iface = { NV_FLOW_REFLECT_INTERFACE_INIT(NvFlowNanoVdbImportInterface) };
+    iface.create = create;
+    iface.destroy = destroy;
+    iface.getGrid = getGrid;
+    iface.importSlices = importSlices;
+    return &iface;
+}
@@ -327,6 +327,9 @@ def getCommonParams():
         os.environ['PHYSX_ROOT_DIR'] + '\"'
     if os.environ.get('GENERATE_SOURCE_DISTRO') == '1':
         outString = outString + ' -DPX_GENERATE_SOURCE_DISTRO=1'
+    # Extra switches on top of the preset, e.g. PHYSX_CMAKE_SWITCHES="-DPX_BUILD_VEHICLE=FALSE"
+    if os.environ.get('PHYSX_CMAKE_SWITCHES'):
+        outString = outString + ' ' + os.environ['PHYSX_CMAKE_SWITCHES']
     return outString
 
 def cleanupCompilerDir(compilerDirName):
@@ -40,6 +40,8 @@ namespace physx
 	class PxBaseTask;
 	class PxCudaContextManager;
 	class PxAllocatorCallback;
+	class PxShape;
+	class PxActor;
 
 	/**
 	\brief Broad phase algorithm used in the simulation
@@ -383,6 +385,21 @@ namespace physx
 		const PxBroadPhasePair*	mDeletedPairs;		//!< Array of lost/deleted pairs.
 	};
 
+	/**
+	\brief Broadphase shape pair.
+
+	A pair of shapes whose broadphase bounds started or stopped overlapping during a simulation step.
+
+	\see	PxScene::setBroadPhasePairRecording PxScene::getBroadPhaseCreatedPairs PxScene::getBroadPhaseDeletedPairs
+	*/
+	struct PxBroadPhaseShapePair
+	{
+		PxShape*	mShape0;	//!< First shape
+		PxActor*	mActor0;	//!< Owner of first shape
+		PxShape*	mShape1;	//!< Second shape
+		PxActor*	mActor1;	//!< Owner of second shape
+	};
+
 	/**
 	\brief Broadphase regions.
 
@@ -65,7 +65,8 @@ struct PxContactPatch
 		eHAS_TARGET_VELOCITY = 16,			//!< Indicates this contact stream has target velocities set
 		eHAS_MAX_IMPULSE = 32,				//!< Indicates this contact stream has max impulses set
 		eREGENERATE_PATCHES = 64,			//!< Indicates this contact stream needs patches re-generated. This is required if the application modified either the contact normal or the material properties
-		eCOMPRESSED_MODIFIED_CONTACT = 128
+		eCOMPRESSED_MODIFIED_CONTACT = 128,
+		eQUANTIZED_CONTACTS = 256			//!< Indicates this contact stream stores PxQuantizedContact points after each patch's first contact. \see PxSceneFlag::eENABLE_QUANTIZED_CONTACTS
 	};
 
 	/**
@@ -167,6 +168,65 @@ struct PxExtendedContact : public PxContact
 }
 PX_ALIGN_SUFFIX(16);
 
+/**
+\brief Quantized contact point data
+
+Used by streams with the PxContactPatch::eQUANTIZED_CONTACTS flag. The first contact of each patch is a full precision PxContact,
+the patch anchor. The other contacts of the patch store their position as a half precision offset from that anchor, and their
+separation as a half precision value. Values too small for half precision are flushed to zero and values too large are clamped.
+
+The struct has no alignment requirement, so the anchor of the next patch may only be 8-byte aligned. Use PxContactStreamIterator
+to read such streams.
+
+\see PxSceneFlag::eENABLE_QUANTIZED_CONTACTS
+*/
+struct PxQuantizedContact
+{
+	/**
+	\brief Offset from the patch anchor, as half floats
+	*/
+	PxU16	offset[3];
+	/**
+	\brief Separation value, as a half float
+	*/
+	PxU16	separation;
+
+	/**
+	\brief Encodes a float as a half float, with round-to-nearest.
+	*/
+	static PX_CUDA_CALLABLE PX_FORCE_INLINE PxU16 encode(PxReal value)
+	{
+		union { PxReal f; PxU32 u; } bits;
+		bits.f = value;
+		const PxU32 sign = (bits.u >> 16) & 0x8000;
+		PxI32 exponent = PxI32((bits.u >> 23) & 0xff) - 112;
+		PxU32 mantissa = (bits.u & 0x7fffff) + 0x1000;
+		if(mantissa & 0x800000)
+		{
+			mantissa = 0;
+			exponent++;
+		}
+		if(exponent <= 0)
+			return PxU16(sign);
+		if(exponent >= 31)
+			return PxU16(sign | 0x7bff);
+		return PxU16(sign | (PxU32(exponent) << 10) | (mantissa >> 13));
+	}
+
+	/**
+	\brief Decodes a half float written by encode().
+	*/
+	static PX_CUDA_CALLABLE PX_FORCE_INLINE PxReal decode(PxU16 value)
+	{
+		const PxU32 exponent = (value >> 10) & 0x1f;
+		union { PxReal f; PxU32 u; } bits;
+		bits.u = PxU32(value & 0x8000) << 16;
+		if(exponent)
+			bits.u |= ((exponent + 112) << 23) | (PxU32(value & 0x3ff) << 13);
+		return bits.f;
+	}
+};
+
 /**
 \brief A modifiable contact point. This has additional fields per-contact to permit modification by user.
 \note Not all fields are currently exposed to the user.
@@ -216,7 +276,8 @@ struct PxContactStreamIterator
 	{
 		eSIMPLE_STREAM,
 		eMODIFIABLE_STREAM,
-		eCOMPRESSED_MODIFIABLE_STREAM
+		eCOMPRESSED_MODIFIABLE_STREAM,
+		eQUANTIZED_STREAM
 	};
 	/**
 	\brief Utility zero vector to optimize functions returning zero vectors when a certain flag isn't set.
@@ -240,6 +301,12 @@ struct PxContactStreamIterator
 	*/
 	const PxU32* faceIndice;
 
+	/**
+	\brief The current contact, decoded from a quantized stream
+	\note In quantized streams, #contact points to the current patch's anchor instead of the current contact.
+	*/
+	PxContact decodedContact;
+
 	/**
 	\brief The total number of patches in this contact stream
 	*/
@@ -301,6 +368,7 @@ struct PxContactStreamIterator
 	{		
 		bool modify = false;
 		bool compressedModify = false;
+		bool quantized = false;
 		bool response = false;
 		bool indices = false; 
 		
@@ -314,6 +382,7 @@ struct PxContactStreamIterator
 			modify = (patches->internalFlags & PxContactPatch::eMODIFIABLE) != 0;
 			compressedModify = (patches->internalFlags & PxContactPatch::eCOMPRESSED_MODIFIED_CONTACT) != 0;
 			indices = (patches->internalFlags & PxContactPatch::eHAS_FACE_INDICES) != 0;
+			quantized = (patches->internalFlags & PxContactPatch::eQUANTIZED_CONTACTS) != 0;
 
 			patch = patches;
 
@@ -321,13 +390,13 @@ struct PxContactStreamIterator
 
 			faceIndice = contactFaceIndices;
 
-			pointSize = compressedModify ?  sizeof(PxExtendedContact) : modify ? sizeof(PxModifiableContact) : sizeof(PxContact);
+			pointSize = compressedModify ?  sizeof(PxExtendedContact) : modify ? sizeof(PxModifiableContact) : quantized ? sizeof(PxQuantizedContact) : sizeof(PxContact);
 
 			response = (patch->internalFlags & PxContactPatch::eFORCE_NO_RESPONSE) == 0;
 		}
 
 
-		mStreamFormat = compressedModify ? eCOMPRESSED_MODIFIABLE_STREAM : modify ? eMODIFIABLE_STREAM : eSIMPLE_STREAM;
+		mStreamFormat = compressedModify ? eCOMPRESSED_MODIFIABLE_STREAM : modify ? eMODIFIABLE_STREAM : quantized ? eQUANTIZED_STREAM : eSIMPLE_STREAM;
 		hasFaceIndices = PxU32(indices);
 		forceNoResponse = PxU32(!response);
 
@@ -374,7 +443,13 @@ struct PxContactStreamIterator
 	PX_CUDA_CALLABLE PX_INLINE void nextPatch()
 	{
 		PX_ASSERT(nextPatchIndex < totalPatches);
-		if(nextPatchIndex)
+		if(nextPatchIndex && mStreamFormat == eQUANTIZED_STREAM)
+		{
+			// PT: skip the anchor and the quantized contacts of the current patch
+			contact = reinterpret_cast<const PxContact*>(reinterpret_cast<const PxU8*>(contact) + sizeof(PxContact) + sizeof(PxQuantizedContact) * (patch->nbContacts - 1));
+			patch = reinterpret_cast<const PxContactPatch*>(reinterpret_cast<const PxU8*>(patch) + contactPatchHeaderSize);
+		}
+		else if(nextPatchIndex)
 		{
 			if(nextContactIndex < patch->nbContacts)
 			{
@@ -404,9 +479,12 @@ struct PxContactStreamIterator
 		PX_ASSERT(nextContactIndex < patch->nbContacts);
 		if(pointStepped)
 		{
-			contact = reinterpret_cast<const PxContact*>(reinterpret_cast<const PxU8*>(contact) + contactPointSize);
+			if(mStreamFormat != eQUANTIZED_STREAM)
+				contact = reinterpret_cast<const PxContact*>(reinterpret_cast<const PxU8*>(contact) + contactPointSize);
 			faceIndice++;
 		}
+		if(mStreamFormat == eQUANTIZED_STREAM)
+			decodeQuantizedContact();
 		nextContactIndex++;
 		pointStepped = true;
 	}
@@ -480,7 +558,7 @@ struct PxContactStreamIterator
 	*/
 	PX_CUDA_CALLABLE PX_FORCE_INLINE const PxVec3& getContactPoint() const
 	{
-		return contact->contact;
+		return mStreamFormat == eQUANTIZED_STREAM ? decodedContact.contact : contact->contact;
 	}
 
 	/**
@@ -489,7 +567,7 @@ struct PxContactStreamIterator
 	*/
 	PX_CUDA_CALLABLE PX_FORCE_INLINE PxReal getSeparation() const
 	{
-		return contact->separation;
+		return mStreamFormat == eQUANTIZED_STREAM ? decodedContact.separation : contact->separation;
 	}
 
 	/**
@@ -598,7 +676,8 @@ struct PxContactStreamIterator
 				PxU32 patchSize = patch->nbContacts;
 				if(numToAdvance <= patchSize)
 				{
-					contact = reinterpret_cast<const PxContact*>(reinterpret_cast<const PxU8*>(contact) + contactPointSize * numToAdvance);
+					if(mStreamFormat != eQUANTIZED_STREAM)
+						contact = reinterpret_cast<const PxContact*>(reinterpret_cast<const PxU8*>(contact) + contactPointSize * numToAdvance);
 					nextContactIndex += numToAdvance;
 					return true;
 				}
@@ -627,6 +706,27 @@ private:
 		return *static_cast<const PxExtendedContact*>(contact);
 	}
 
+	/**
+	\brief Internal helper, decodes the contact at nextContactIndex in the current patch of a quantized stream
+	*/
+	PX_CUDA_CALLABLE PX_FORCE_INLINE void decodeQuantizedContact()
+	{
+		// PT: the anchor can be only 8-byte aligned, so we read it as floats and not as a PxContact
+		const PxReal* anchor = reinterpret_cast<const PxReal*>(contact);
+		const PxVec3 anchorPoint(anchor[0], anchor[1], anchor[2]);
+		if(nextContactIndex == 0)
+		{
+			decodedContact.contact = anchorPoint;
+			decodedContact.separation = anchor[3];
+		}
+		else
+		{
+			const PxQuantizedContact& q = reinterpret_cast<const PxQuantizedContact*>(anchor + 4)[nextContactIndex - 1];
+			decodedContact.contact = anchorPoint + PxVec3(PxQuantizedContact::decode(q.offset[0]), PxQuantizedContact::decode(q.offset[1]), PxQuantizedContact::decode(q.offset[2]));
+			decodedContact.separation = PxQuantizedContact::decode(q.separation);
+		}
+	}
+
 };
 
 /**
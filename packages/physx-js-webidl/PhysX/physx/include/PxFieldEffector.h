@@ -0,0 +1,179 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_FIELD_EFFECTOR_H
+#define PX_FIELD_EFFECTOR_H
+
+#include "foundation/PxBounds3.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Identifies the kind of a PxFieldEffector.
+
+\see PxFieldEffector
+*/
+struct PxFieldEffectorType
+{
+	enum Enum
+	{
+		/**
+		\brief One-shot radial impulse.
+
+		Bodies within #PxFieldEffector::radius of #PxFieldEffector::position receive an impulse of magnitude #PxFieldEffector::strength,
+		pointing away from the center and falling off linearly to zero at the radius. The effector is removed automatically after
+		the simulation step that applied it.
+		*/
+		eRADIAL_EXPLOSION,
+
+		/**
+		\brief Directional wind volume.
+
+		The flow velocity is #PxFieldEffector::direction * #PxFieldEffector::strength. Bodies are accelerated towards the flow velocity
+		with the rate #PxFieldEffector::drag.
+		*/
+		eWIND,
+
+		/**
+		\brief Vortex around an axis.
+
+		The axis goes through #PxFieldEffector::position along #PxFieldEffector::direction. The flow velocity is tangential, of magnitude
+		#PxFieldEffector::strength on the axis and falling off linearly to zero at #PxFieldEffector::radius. Bodies are accelerated
+		towards the flow velocity with the rate #PxFieldEffector::drag.
+		*/
+		eVORTEX,
+
+		/**
+		\brief Buoyancy below a plane.
+
+		The plane goes through #PxFieldEffector::position with the upward normal #PxFieldEffector::direction. Bodies below the plane are
+		accelerated along the normal by #PxFieldEffector::strength, scaled by their depth divided by #PxFieldEffector::radius (clamped
+		to 1), and their linear velocity is damped by #PxFieldEffector::drag scaled the same way.
+		*/
+		eBUOYANCY_PLANE
+	};
+};
+
+/**
+\brief A force field applied by the scene to its awake rigid bodies during integration.
+
+Effectors are evaluated once per simulation step, for the center of mass of each awake dynamic rigid body contained in #bounds.
+They only modify the linear velocity of the bodies and do not wake up sleeping bodies. Articulation links are not affected.
+
+\see PxScene::addFieldEffector() PxFieldEffectorType
+*/
+struct PxFieldEffector
+{
+	PxFieldEffectorType::Enum	type;		//!< Kind of the effector
+	PxVec3						position;	//!< Explosion center, point on the vortex axis or point on the buoyancy plane
+	PxVec3						direction;	//!< Normalized wind direction, vortex axis or buoyancy plane normal
+	PxReal						strength;	//!< Impulse (explosion), flow speed (wind, vortex) or acceleration (buoyancy)
+	PxReal						radius;		//!< Falloff radius (explosion, vortex) or full submersion depth (buoyancy)
+	PxReal						drag;		//!< Rate, in 1/time, at which bodies are driven towards the flow velocity (wind, vortex) or damped (buoyancy)
+	PxBounds3					bounds;		//!< World-space volume outside of which the effector is ignored
+
+	/**
+	\brief Creates a radial explosion, bounded by the box enclosing its radius.
+	*/
+	static PX_INLINE PxFieldEffector createRadialExplosion(const PxVec3& center, PxReal impulse, PxReal radius)
+	{
+		PxFieldEffector effector;
+		effector.type		= PxFieldEffectorType::eRADIAL_EXPLOSION;
+		effector.position	= center;
+		effector.direction	= PxVec3(0.0f, 1.0f, 0.0f);
+		effector.strength	= impulse;
+		effector.radius		= radius;
+		effector.drag		= 0.0f;
+		effector.bounds		= PxBounds3::centerExtents(center, PxVec3(radius));
+		return effector;
+	}
+
+	/**
+	\brief Creates a wind volume.
+	*/
+	static PX_INLINE PxFieldEffector createWind(const PxBounds3& bounds, const PxVec3& direction, PxReal speed, PxReal drag)
+	{
+		PxFieldEffector effector;
+		effector.type		= PxFieldEffectorType::eWIND;
+		effector.position	= bounds.getCenter();
+		effector.direction	= direction;
+		effector.strength	= speed;
+		effector.radius		= 0.0f;
+		effector.drag		= drag;
+		effector.bounds		= bounds;
+		return effector;
+	}
+
+	/**
+	\brief Creates a vortex, bounded by the cylinder of the given radius and height centered on position.
+	*/
+	static PX_INLINE PxFieldEffector createVortex(const PxVec3& position, const PxVec3& axis, PxReal speed, PxReal radius, PxReal height, PxReal drag)
+	{
+		PxFieldEffector effector;
+		effector.type		= PxFieldEffectorType::eVORTEX;
+		effector.position	= position;
+		effector.direction	= axis;
+		effector.strength	= speed;
+		effector.radius		= radius;
+		effector.drag		= drag;
+		effector.bounds		= PxBounds3::centerExtents(position, PxVec3(radius) + axis.abs() * (height * 0.5f));
+		return effector;
+	}
+
+	/**
+	\brief Creates an unbounded buoyancy plane.
+	*/
+	static PX_INLINE PxFieldEffector createBuoyancyPlane(const PxVec3& point, const PxVec3& normal, PxReal acceleration, PxReal depth, PxReal drag)
+	{
+		PxFieldEffector effector;
+		effector.type		= PxFieldEffectorType::eBUOYANCY_PLANE;
+		effector.position	= point;
+		effector.direction	= normal;
+		effector.strength	= acceleration;
+		effector.radius		= depth;
+		effector.drag		= drag;
+		effector.bounds.setMaximal();
+		return effector;
+	}
+
+	/**
+	\brief Returns true if the effector is valid.
+	*/
+	PX_INLINE bool isValid() const
+	{
+		return position.isFinite() && direction.isNormalized() && PxIsFinite(strength) && PxIsFinite(drag) && drag >= 0.0f
+			&& (type == PxFieldEffectorType::eWIND || radius > 0.0f) && bounds.isValid();
+	}
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -443,6 +443,21 @@ public:
 	*/
 	virtual	PxU32 getScenes(PxScene** userBuffer, PxU32 bufferSize, PxU32 startIndex = 0) const = 0;
 
+	/**
+	\brief Returns memory that the SDK-level object pools kept after a usage peak.
+
+	Actors, shapes, materials, constraints, aggregates and articulations are allocated from pools shared by all scenes.
+	These pools only grow to the peak number of objects. This call releases their empty slabs, for example after a
+	large number of objects has been released in a long-running application.
+
+	Per-scene memory is not affected, see PxScene::compactMemory().
+
+	\return The number of bytes released.
+
+	\see PxScene::compactMemory()
+	*/
+	virtual	PxU32 compactMemory() = 0;
+
 	//\}
 	/** \name Actors
 	*/
@@ -483,6 +498,29 @@ public:
 	*/
 	virtual PxPruningStructure* createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors) = 0;
 
+	/**
+	\brief Creates a pruning structure from actors and precomputed tree data.
+
+	The tree data must have been written by #PxPruningStructure::exportTreeData(). It is used in place: the trees are neither
+	rebuilt nor copied, so the buffer must remain valid and unmodified until the pruning structure is released. The buffer
+	can be read-only, e.g. a memory-mapped file.
+
+	When the pruning structure is added to a scene whose static pruner is empty and uses PxPruningStructureType::eSTATIC_AABB_TREE,
+	the static tree of the pruning structure becomes the scene query tree directly, without any rebuild.
+
+	\note The same requirements as for #createPruningStructure(PxRigidActor*const*, PxU32) apply to the actors.
+	\note The actors must be passed in the same order, with the same scene query shapes and poses, as the actors of the exported
+	pruning structure. Only the number of scene query shapes can be verified.
+
+	\param	[in] actors			Array of actors to add to the pruning structure. Must be non NULL.
+	\param	[in] nbActors		Number of actors in the array. Must be >0.
+	\param	[in] treeData		Tree data written by PxPruningStructure::exportTreeData(). Must be 16-byte aligned.
+	\param	[in] treeDataSize	Size of the tree data in bytes.
+	\return Pruning structure using the given tree data, or NULL if the tree data is invalid or does not match the actors.
+	\see PxPruningStructure::exportTreeData
+	*/
+	virtual PxPruningStructure* createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, const void* treeData, PxU32 treeDataSize) = 0;
+
 	//\}
 	/** \name Shapes
 	*/
@@ -163,6 +163,7 @@ Alternatively, one can instead directly #include a subset of the below files.
 #include "PxDeformableVolumeMaterial.h"
 #include "PxDeletionListener.h"
 #include "PxFEMSoftBodyMaterial.h" // deprecated, include PxDeformableVolumeMaterial.h
+#include "PxFieldEffector.h"
 #include "PxFiltering.h"
 #include "PxForceMode.h"
 #include "PxLockedData.h"
@@ -174,6 +175,7 @@ Alternatively, one can instead directly #include a subset of the below files.
 #include "PxPhysics.h"
 #include "PxPhysXConfig.h"
 #include "PxQueryFiltering.h"
+#include "PxQueryRecorder.h"
 #include "PxQueryReport.h"
 #include "PxRigidActor.h"
 #include "PxRigidBody.h"
@@ -196,12 +198,14 @@ Alternatively, one can instead directly #include a subset of the below files.
 #include "characterkinematic/PxControllerBehavior.h"
 #include "characterkinematic/PxControllerManager.h"
 #include "characterkinematic/PxControllerObstacles.h"
+#include "characterkinematic/PxControllerLayerFilter.h"
 #include "characterkinematic/PxExtended.h"
 
 //Cooking (data preprocessing)
 #include "cooking/Pxc.h"
 #include "cooking/PxConvexMeshDesc.h"
 #include "cooking/PxCooking.h"
+#include "cooking/PxCookingCache.h"
 #include "cooking/PxTriangleMeshDesc.h"
 #include "cooking/PxBVH33MidphaseDesc.h"
 #include "cooking/PxBVH34MidphaseDesc.h"
@@ -112,6 +112,33 @@ public:
 	*/
 	virtual	const void*			getDynamicMergeData()	const	= 0;
 
+	/**
+	\brief Returns the size of the buffer needed by #exportTreeData().
+
+	\return Size of the tree data in bytes, or 0 if the pruning structure is invalid.
+
+	\see exportTreeData
+	*/
+	virtual	PxU32				getTreeDataSize()		const	= 0;
+
+	/**
+	\brief Writes the AABB trees of the pruning structure to a buffer.
+
+	The tree data is position-independent: it contains offsets rather than pointers, so it can be stored in a file and later
+	be used in place from a memory-mapped file or any other buffer, with #PxPhysics::createPruningStructure(PxRigidActor*const*, PxU32, const void*, PxU32).
+	The actors are not part of the tree data. They must be recreated separately, in the same order and with the same scene
+	query shapes and poses as when the tree data was exported.
+
+	\note The tree data uses the native endianness of the platform.
+
+	\param[out] buffer		Buffer receiving the tree data. Must be 16-byte aligned.
+	\param[in] bufferSize	Size of the buffer in bytes. Must be at least #getTreeDataSize().
+	\return True on success, false if the pruning structure is invalid or the buffer is too small.
+
+	\see getTreeDataSize PxPhysics::createPruningStructure
+	*/
+	virtual	bool				exportTreeData(void* buffer, PxU32 bufferSize)	const	= 0;
+
 	virtual	const char*			getConcreteTypeName() const	PX_OVERRIDE	PX_FINAL	{ return "PxPruningStructure";	}
 protected:
 	PX_INLINE					PxPruningStructure(PxType concreteType, PxBaseFlags baseFlags) : PxBase(concreteType, baseFlags) {}
@@ -0,0 +1,101 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_QUERY_RECORDER_H
+#define PX_QUERY_RECORDER_H
+
+#include "PxPhysXConfig.h"
+#include "PxQueryFiltering.h"
+#include "foundation/PxTransform.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxGeometry;
+
+	/**
+	\brief Receives the scene queries issued on a scene, e.g. to capture query traces from a live application.
+
+	The recorder is called at the start of PxScene::raycast(), PxScene::sweep() and PxScene::overlap(), before the query
+	runs, with the query parameters as passed by the user. Query callbacks, filter callbacks and caches are not recorded.
+
+	\note Queries can be issued from several threads at the same time, so implementations must be thread-safe.
+	\note The recorder is only called for PxScene queries, not for queries running directly on a PxSceneQuerySystem.
+
+	\see PxScene::setQueryRecorder()
+	*/
+	class PxQueryRecorder
+	{
+		public:
+		/**
+		\brief Called for each raycast.
+
+		\param[in] origin		Origin of the ray
+		\param[in] unitDir		Normalized direction of the ray
+		\param[in] distance		Length of the ray
+		\param[in] hitFlags		Hit flags of the query
+		\param[in] filterData	Filter data of the query
+		\param[in] maxNbTouches	Size of the touch buffer of the hit callback, zero for blocking-only queries
+		*/
+		virtual	void	recordRaycast(const PxVec3& origin, const PxVec3& unitDir, PxReal distance, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxU32 maxNbTouches) = 0;
+
+		/**
+		\brief Called for each sweep.
+
+		\param[in] geometry		Swept geometry
+		\param[in] pose			Initial pose of the geometry
+		\param[in] unitDir		Normalized sweep direction
+		\param[in] distance		Sweep distance
+		\param[in] hitFlags		Hit flags of the query
+		\param[in] filterData	Filter data of the query
+		\param[in] maxNbTouches	Size of the touch buffer of the hit callback, zero for blocking-only queries
+		\param[in] inflation	Inflation of the swept geometry
+		*/
+		virtual	void	recordSweep(const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, PxReal distance, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxU32 maxNbTouches, PxReal inflation) = 0;
+
+		/**
+		\brief Called for each overlap.
+
+		\param[in] geometry		Overlap geometry
+		\param[in] pose			Pose of the geometry
+		\param[in] filterData	Filter data of the query
+		\param[in] maxNbTouches	Size of the touch buffer of the hit callback, zero for blocking-only queries
+		*/
+		virtual	void	recordOverlap(const PxGeometry& geometry, const PxTransform& pose, const PxQueryFilterData& filterData, PxU32 maxNbTouches) = 0;
+
+		protected:
+		virtual			~PxQueryRecorder()	{}
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
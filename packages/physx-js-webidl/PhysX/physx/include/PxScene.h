@@ -30,6 +30,8 @@
 #define PX_SCENE_H
 
 #include "PxActor.h"
+#include "foundation/PxVec4.h"
+#include "foundation/PxQuat.h"
 #include "PxDirectGPUAPI.h"
 #include "PxSceneQuerySystem.h"
 #include "PxSceneDesc.h"
@@ -42,6 +44,8 @@
 #include "PxParticleSystemFlag.h"
 #include "PxParticleSolverType.h"
 #include "PxResidual.h"
+#include "PxForceMode.h"
+#include "PxFieldEffector.h"
 
 #include "cudamanager/PxCudaTypes.h"
 
@@ -63,6 +67,7 @@ class PxArticulationReducedCoordinate;
 struct PxContactPairHeader;
 
 class PxPvdSceneClient;
+class PxQueryRecorder;
 
 class PxDeformableSurface;
 class PxDeformableVolume;
@@ -176,6 +181,38 @@ public:
 	virtual ~PxPostSolveCallback() {}
 };
 
+/**
+\brief Poses and velocities of the active rigid bodies, in structure-of-arrays form.
+
+Each array has nbBodies entries and is 16-byte aligned, so it can be streamed with SIMD loads. Entry i of each
+array belongs to actors[i]. The w components of the PxVec4 entries are undefined.
+
+\see PxScene::getRigidBodyStreams() PxSceneFlag::eENABLE_BODY_STREAMS
+*/
+struct PxRigidBodyStreams
+{
+	PxRigidActor*const*	actors;				//!< Actors the bodies belong to (PxRigidDynamic or PxArticulationLink)
+	const PxVec4*		positions;			//!< Global positions of the actors
+	const PxQuat*		orientations;		//!< Global orientations of the actors
+	const PxVec4*		linearVelocities;	//!< Linear velocities of the bodies' centers of mass, in world space
+	const PxVec4*		angularVelocities;	//!< Angular velocities of the bodies, in world space
+	PxU32				nbBodies;			//!< Number of entries in each array
+};
+
+/**
+\brief World transform of a shape, as stored in the scene's shape transform cache.
+
+Entries are 32 bytes and 16-byte aligned: the orientation (x, y, z, w), the position (x, y, z), then a flags word.
+
+\see PxScene::getShapeTransforms() PxScene::getShapeTransformIndex()
+*/
+struct PX_ALIGN_PREFIX(16) PxShapeTransform
+{
+	PxTransform	transform;	//!< World transform of the shape
+	PxU32		flags;		//!< Bit 0 is set if the shape's actor was frozen during the last simulation step. Other bits are reserved.
+}
+PX_ALIGN_SUFFIX(16);
+
 /** 
  \brief A scene is a collection of bodies and constraints which can interact.
 
@@ -528,6 +565,64 @@ class PxScene : public PxSceneSQSystem
 	*/
 	virtual PxActor**		getActiveActors(PxU32& nbActorsOut) = 0;
 
+	/**
+	\brief Retrieves the poses and velocities of the rigid bodies updated during the previous simulation step.
+
+	The bodies are the same as the ones returned by getActiveActors(), and the poses are the same as the ones returned by
+	PxRigidActor::getGlobalPose(). Reading the streams avoids one API call and one indirection per body.
+
+	\note PxSceneFlag::eENABLE_BODY_STREAMS must be set. Otherwise, or while the simulation is running, the streams are empty.
+
+	\note The streams are rebuilt by fetchResults(), and only valid until the next call to simulate() or advance(). They are not
+	updated by API calls such as PxRigidActor::setGlobalPose().
+
+	\param[out] streams The arrays of body data
+
+	\see PxRigidBodyStreams PxSceneFlag::eENABLE_BODY_STREAMS getActiveActors()
+	*/
+	virtual void			getRigidBodyStreams(PxRigidBodyStreams& streams) const = 0;
+
+	/**
+	\brief Retrieves the world transforms of all the simulated shapes in the scene.
+
+	This is the transform cache used internally by the broadphase and the narrowphase, exposed read-only. Each shape of
+	a simulated actor owns one entry, whose index is given by getShapeTransformIndex(). The array can be uploaded as is,
+	e.g. to a GPU instance buffer, instead of querying and converting the pose of each shape.
+
+	\note The transforms are the ones used by the last simulation step. Poses set through the API afterwards, e.g. with
+	PxRigidActor::setGlobalPose(), are only reflected after the next call to simulate().
+
+	\note Entries of removed shapes are undefined, and their indices are reused by shapes added later.
+
+	\note The array can move in memory when shapes are added to the scene, the returned pointer must not be kept across
+	simulation steps. It is not updated on the CPU when the direct GPU API is enabled.
+
+	\note Do not use this method while the simulation is running. Calls to this method while the simulation is running will be ignored and NULL will be returned.
+
+	\param[out] nbTransforms The number of entries in the array, i.e. the highest shape transform index plus one
+
+	\return The array of shape transforms
+
+	\see getShapeTransformIndex() PxShapeTransform
+	*/
+	virtual const PxShapeTransform*	getShapeTransforms(PxU32& nbTransforms) const = 0;
+
+	/**
+	\brief Returns the index of a shape's entry in the array returned by getShapeTransforms().
+
+	The index stays the same as long as the shape remains attached to the actor, and the actor remains in the scene.
+	Shared shapes have one entry per actor they are attached to.
+
+	\param[in] actor The actor the shape is attached to
+	\param[in] shape The shape
+
+	\return The index of the shape's transform, or 0xffffffff if the actor is not in this scene, the shape is not attached to
+	the actor, or the actor is not simulated (PxActorFlag::eDISABLE_SIMULATION).
+
+	\see getShapeTransforms()
+	*/
+	virtual PxU32			getShapeTransformIndex(const PxRigidActor& actor, const PxShape& shape) const = 0;
+
 	/**
 	\brief Retrieve the number of deformable surfaces in the scene.
 
@@ -882,6 +977,27 @@ class PxScene : public PxSceneSQSystem
 	*/
 	virtual PxBroadPhaseCallback* getBroadPhaseCallback()	const = 0;
 
+	/**
+	\brief Sets a recorder receiving the parameters of the raycasts, sweeps and overlaps issued on this scene.
+
+	This is meant to capture query traces from a running application, to replay them later e.g. in a benchmark.
+	Pass NULL to stop recording.
+
+	\param[in] recorder	Query recorder. See #PxQueryRecorder.
+
+	\see PxQueryRecorder getQueryRecorder()
+	*/
+	virtual void				setQueryRecorder(PxQueryRecorder* recorder) = 0;
+
+	/**
+	\brief Retrieves the PxQueryRecorder pointer set with setQueryRecorder().
+
+	\return The current query recorder pointer. See #PxQueryRecorder.
+
+	\see PxQueryRecorder setQueryRecorder()
+	*/
+	virtual PxQueryRecorder*	getQueryRecorder()	const = 0;
+
 	//\}
 	/************************************************************************************************/
 
@@ -1101,6 +1217,24 @@ class PxScene : public PxSceneSQSystem
 	*/
 	virtual	bool				checkResults(bool block = false) = 0;
 
+	/**
+	\brief Returns the address of a counter incremented each time a simulation step completes.
+
+	The counter is incremented when the results of simulate() or advance() become available, i.e. when checkResults()
+	starts returning true. It can be read from any thread without calling into the SDK, which lets applications run
+	their own work while the step runs on worker threads and poll for completion at no cost.
+
+	When building for WebAssembly with threads, waiters on the counter's address (Atomics.wait() or Atomics.waitAsync())
+	are notified when it is incremented. This allows a script to await the completion of a step, then call fetchResults().
+
+	\note The counter is only modified by the SDK. It wraps around after 2^31 steps.
+
+	\return Address of the completion counter
+
+	\see simulate() advance() checkResults() fetchResults()
+	*/
+	virtual	const volatile PxI32*	getSimulationCompletionCounter() const = 0;
+
 	/**
 	This method must be called after collide() and before advance(). It will wait for the collision phase to finish. If the user makes an illegal simulation call, the SDK will issue an error
 	message.
@@ -1187,6 +1321,187 @@ class PxScene : public PxSceneSQSystem
 	\param[in] sendPendingReports When set to true pending reports will be sent out before the buffers get cleaned up (for instance lost touch contact/trigger reports due to deleted objects).
 	*/
 	virtual	void				flushSimulation(bool sendPendingReports = false) = 0;
+
+	/**
+	\brief Returns memory that internal pools kept after a usage peak.
+
+	Internal pools (simulation objects, interactions, contact managers, manifolds, contact stream blocks, scene query
+	pruning pools) only grow to the peak number of objects they had to hold. This call releases their empty slabs and
+	unused capacity, for example after a large number of objects has been removed from a long-running scene.
+
+	Unlike flushSimulation(), the simulation state and pending reports are preserved. Live objects are never moved, so
+	partially used slabs cannot be released.
+
+	\note It is not allowed to call this method while the simulation is running. The call will fail.
+
+	\note On platforms where the heap cannot shrink (e.g. WebAssembly), released memory is reused by later allocations instead.
+
+	\return The number of bytes released by the simulation pools. Scene query memory is released but not counted.
+
+	\see flushSimulation() PxPhysics::compactMemory()
+	*/
+	virtual	PxU32				compactMemory() = 0;
+
+	/**
+	\brief Sets the kinematic targets of a batch of kinematic actors.
+
+	This is equivalent to calling PxRigidDynamic::setKinematicTarget() for each actor, but the API checks are done once for the
+	whole batch and the targets are read from separate position and orientation arrays. This is useful to move large numbers of
+	kinematic actors (e.g. crowds of characters) each frame.
+
+	\note All actors must be kinematic actors that belong to this scene and do not have PxActorFlag::eDISABLE_SIMULATION set.
+	The whole call is ignored otherwise (checked builds only).
+
+	\note Orientations are normalized, as in PxRigidDynamic::setKinematicTarget().
+
+	\note It is not allowed to call this method while the simulation is running, except during split simulation (see PxScene::collide()).
+
+	<b>Sleeping:</b> This call wakes the actors up.
+
+	\param[in] actors			The kinematic actors to move
+	\param[in] positions		The target positions of the actors, in world space
+	\param[in] orientations		The target orientations of the actors, in world space
+	\param[in] nbActors			The number of entries in the three arrays
+
+	\see PxRigidDynamic::setKinematicTarget() PxRigidBodyFlag::eKINEMATIC
+	*/
+	virtual	void				setKinematicTargets(PxRigidDynamic*const* actors, const PxVec3* positions, const PxQuat* orientations, PxU32 nbActors) = 0;
+
+	/**
+	\brief Sets the kinematic targets of a batch of kinematic actors, from a single contiguous buffer.
+
+	Same as the previous function, except the targets are read from one buffer of transforms, i.e. 7 consecutive floats
+	per actor (orientation x, y, z, w, then position x, y, z). This is the cheapest way to submit targets from a tightly
+	packed buffer, for example one written by a scripting layer or another language, with a single call.
+
+	\param[in] actors			The kinematic actors to move
+	\param[in] targets			The target poses of the actors, in world space
+	\param[in] nbActors			The number of entries in the two arrays
+
+	\see PxRigidDynamic::setKinematicTarget() PxRigidBodyFlag::eKINEMATIC
+	*/
+	virtual	void				setKinematicTargets(PxRigidDynamic*const* actors, const PxTransform* targets, PxU32 nbActors) = 0;
+
+	/**
+	\brief Applies forces and/or torques to a batch of dynamic actors.
+
+	This is equivalent to calling PxRigidBody::addForce() and PxRigidBody::addTorque() for each actor, but the API checks
+	are done once for the whole batch. This is useful to apply explosions, knockbacks or wind to many actors at once, in
+	particular from a scripting layer or another language where each call has a significant overhead.
+
+	\note All actors must be non-kinematic dynamic actors that belong to this scene and do not have PxActorFlag::eDISABLE_SIMULATION set.
+	The whole call is ignored otherwise (checked builds only).
+
+	\note It is not allowed to call this method while the simulation is running, except during split simulation (see PxScene::collide()).
+
+	\note This method should not be used after the direct GPU API has been enabled and initialized. See #PxDirectGPUAPI for the details.
+
+	<b>Sleeping:</b> This call wakes the actors up if autowake is true (default) or if the force or torque is non-zero.
+
+	\param[in] actors			The actors to apply the forces to
+	\param[in] forces			The forces, in world space, one per actor. Can be NULL to only apply torques.
+	\param[in] torques			The torques, in world space, one per actor. Can be NULL to only apply forces.
+	\param[in] nbActors			The number of entries in the arrays
+	\param[in] mode				The mode to use when applying the forces and torques, as in PxRigidBody::addForce()
+	\param[in] autowake			Whether to wake the actors up if they are asleep, as in PxRigidBody::addForce()
+
+	\see PxRigidBody::addForce() PxRigidBody::addTorque() PxForceMode
+	*/
+	virtual	void				addForces(PxRigidDynamic*const* actors, const PxVec3* forces, const PxVec3* torques, PxU32 nbActors, PxForceMode::Enum mode = PxForceMode::eFORCE, bool autowake = true) = 0;
+
+	/**
+	\brief Sets the linear and/or angular velocities of a batch of dynamic actors.
+
+	This is equivalent to calling PxRigidDynamic::setLinearVelocity() and PxRigidDynamic::setAngularVelocity() for each
+	actor, but the API checks are done once for the whole batch.
+
+	\note All actors must be non-kinematic dynamic actors that belong to this scene and do not have PxActorFlag::eDISABLE_SIMULATION set.
+	The whole call is ignored otherwise (checked builds only).
+
+	\note It is not allowed to call this method while the simulation is running, except during split simulation (see PxScene::collide()).
+
+	\note This method should not be used after the direct GPU API has been enabled and initialized. See #PxDirectGPUAPI for the details.
+
+	<b>Sleeping:</b> This call wakes the actors up if autowake is true (default) or if the new velocity is non-zero.
+
+	\param[in] actors				The actors to modify
+	\param[in] linearVelocities		The new linear velocities, one per actor. Can be NULL to leave linear velocities unchanged.
+	\param[in] angularVelocities	The new angular velocities, one per actor. Can be NULL to leave angular velocities unchanged.
+	\param[in] nbActors				The number of entries in the arrays
+	\param[in] autowake				Whether to wake the actors up if they are asleep, as in PxRigidDynamic::setLinearVelocity()
+
+	\see PxRigidDynamic::setLinearVelocity() PxRigidDynamic::setAngularVelocity()
+	*/
+	virtual	void				setVelocities(PxRigidDynamic*const* actors, const PxVec3* linearVelocities, const PxVec3* angularVelocities, PxU32 nbActors, bool autowake = true) = 0;
+
+	/**
+	\brief Retrieves the global poses of all links of a batch of articulations.
+
+	This is equivalent to calling PxArticulationLink::getGlobalPose() for each link of each articulation, but the API checks
+	are done once for the whole batch. The poses of each articulation are written contiguously, in the order of the articulations
+	and, for each articulation, in the order of PxArticulationReducedCoordinate::getLinks(). For a batch of articulations with
+	the same topology (e.g. ragdolls), the pose of link j of articulation i is at index i*nbLinks + j.
+
+	\note It is not allowed to call this method while the simulation is running, except during PxScene::collide().
+
+	\param[in] articulations	The articulations. They must belong to this scene.
+	\param[in] nbArticulations	The number of articulations
+	\param[out] poses			The link poses, in world space
+	\param[in] maxNbPoses		The capacity of the poses buffer. Articulations whose links do not all fit are not written.
+	\return The number of poses written
+
+	\see PxArticulationLink::getGlobalPose() PxArticulationReducedCoordinate::getLinks()
+	*/
+	virtual	PxU32				getArticulationLinkPoses(const PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations, PxTransform* poses, PxU32 maxNbPoses) const = 0;
+
+	/**
+	\brief Copies the state of a batch of articulations to a single flat buffer.
+
+	For each articulation, the following data is written contiguously, as floats:
+	- the root link global pose (7 floats, PxTransform layout: quaternion xyzw then position xyz)
+	- the global pose of each link, in the order of PxArticulationReducedCoordinate::getLinks() (7 floats per link)
+	- the joint positions, in the same order as PxArticulationCache::jointPosition (PxArticulationReducedCoordinate::getDofs() floats)
+
+	The state of an articulation thus uses 7*(1 + getNbLinks()) + getDofs() floats, and the state of the next articulation
+	immediately follows it. This replaces a createCache() / copyInternalStateToCache() pair per articulation, and per-element
+	reads of the cache data, with a single call.
+
+	\note It is not allowed to call this method while the simulation is running.
+
+	\note This method should not be used after the direct GPU API has been enabled and initialized. See #PxDirectGPUAPI for the details.
+
+	\param[in] articulations	The articulations. They must belong to this scene.
+	\param[in] nbArticulations	The number of articulations
+	\param[out] buffer			The destination buffer
+	\param[in] bufferSize		The capacity of the buffer, in floats. Articulations whose state does not fit entirely are not written.
+	\return The number of floats written to the buffer
+
+	\see applyArticulationStates() PxArticulationReducedCoordinate::copyInternalStateToCache()
+	*/
+	virtual	PxU32				copyArticulationStates(const PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations, PxReal* buffer, PxU32 bufferSize) const = 0;
+
+	/**
+	\brief Applies the state of a batch of articulations from a single flat buffer.
+
+	The buffer uses the same layout as copyArticulationStates(). The root link pose and the joint positions are applied to each
+	articulation, as PxArticulationReducedCoordinate::applyCache() would do with PxArticulationCacheFlag::eROOT_TRANSFORM and
+	PxArticulationCacheFlag::ePOSITION. The link poses stored in the buffer are ignored: they are recomputed from the root pose and
+	the joint positions.
+
+	\note It is not allowed to call this method while the simulation is running.
+
+	\note This method should not be used after the direct GPU API has been enabled and initialized. See #PxDirectGPUAPI for the details.
+
+	\param[in] articulations	The articulations. They must belong to this scene.
+	\param[in] nbArticulations	The number of articulations
+	\param[in] buffer			The source buffer
+	\param[in] bufferSize		The size of the buffer, in floats. Articulations whose state is not entirely contained in the buffer are not modified.
+	\param[in] autowake		If true, the articulations are woken up as in PxArticulationReducedCoordinate::applyCache().
+	\return The number of floats read from the buffer
+
+	\see copyArticulationStates() PxArticulationReducedCoordinate::applyCache()
+	*/
+	virtual	PxU32				applyArticulationStates(PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations, const PxReal* buffer, PxU32 bufferSize, bool autowake = true) = 0;
 	
 	/**
 	\brief Sets a constant gravity for the entire scene.
@@ -1210,6 +1525,56 @@ class PxScene : public PxSceneSQSystem
 	*/
 	virtual PxVec3				getGravity() const = 0;
 
+	/**
+	\brief Adds a field effector to the scene.
+
+	Field effectors (explosions, wind, vortices, buoyancy) are applied to the awake dynamic rigid bodies inside their bounds
+	when the bodies are integrated, without any per-body API call. Radial explosions are removed automatically after the next
+	simulation step.
+
+	\note Do not use this method while the simulation is running.
+
+	\note Field effectors are not supported with GPU dynamics and are ignored in that case.
+
+	<b>Sleeping:</b> Does <b>NOT</b> wake actors up automatically.
+
+	\param[in] effector The effector to add. See #PxFieldEffector::isValid()
+	\return The id of the new effector, or 0xffffffff if the effector is invalid. Ids of removed effectors are recycled.
+
+	\see PxFieldEffector setFieldEffector() removeFieldEffector()
+	*/
+	virtual PxU32				addFieldEffector(const PxFieldEffector& effector) = 0;
+
+	/**
+	\brief Replaces the parameters of a field effector, e.g. to move a wind volume.
+
+	\note Do not use this method while the simulation is running.
+
+	\param[in] id			The id returned by addFieldEffector()
+	\param[in] effector	The new parameters. See #PxFieldEffector::isValid()
+
+	\see addFieldEffector()
+	*/
+	virtual void				setFieldEffector(PxU32 id, const PxFieldEffector& effector) = 0;
+
+	/**
+	\brief Removes a field effector from the scene.
+
+	\note Do not use this method while the simulation is running.
+
+	\param[in] id The id returned by addFieldEffector()
+
+	\see addFieldEffector()
+	*/
+	virtual void				removeFieldEffector(PxU32 id) = 0;
+
+	/**
+	\brief Returns the number of field effectors in the scene.
+
+	\see addFieldEffector()
+	*/
+	virtual PxU32				getNbFieldEffectors() const = 0;
+
 	/**
 	\brief Set the bounce threshold velocity.  Collision speeds below this threshold will not cause a bounce.
 
@@ -1419,6 +1784,76 @@ class PxScene : public PxSceneSQSystem
 	\see PxSimulationStatistics
 	*/
 	virtual	void				getSimulationStatistics(PxSimulationStatistics& stats) const = 0;
+
+	/**
+	\brief Call this method to retrieve per-stage timings for the last simulation step.
+
+	The timings are always recorded and do not require PVD or a profiler, so they can be exported every step.
+
+	\note Do not use this method while the simulation is running. Calls to this method while the simulation is running will be ignored.
+
+	\param[out] timings Used to retrieve the timings of the last simulation step.
+
+	\see PxSimulationStageTimings PxSimulationStage
+	*/
+	virtual	void				getSimulationStageTimings(PxSimulationStageTimings& timings) const = 0;
+
+	/**
+	\brief Enables or disables the narrow-phase attribution mode.
+
+	When enabled, the CPU narrow phase times the contact generation of each shape pair, so that the most expensive
+	pairs and actors of the last simulation step can be retrieved with getNarrowPhasePairCosts() and
+	getNarrowPhaseActorCosts(). This is meant for finding the objects responsible for narrow-phase spikes, e.g. a
+	complex mesh touching many bodies. It adds a couple of timer reads per pair, so it is disabled by default.
+
+	Pairs processed in batches by the narrow phase share the cost of the batch evenly. Pairs processed on the GPU are
+	not reported.
+
+	\note Do not use this method while the simulation is running. Calls to this method while the simulation is running will be ignored.
+
+	\param[in] enabled True to enable the attribution mode.
+
+	\see getNarrowPhaseAttribution() getNarrowPhasePairCosts() getNarrowPhaseActorCosts()
+	*/
+	virtual	void				setNarrowPhaseAttribution(bool enabled) = 0;
+
+	/**
+	\brief Returns whether the narrow-phase attribution mode is enabled.
+
+	\see setNarrowPhaseAttribution()
+	*/
+	virtual	bool				getNarrowPhaseAttribution() const = 0;
+
+	/**
+	\brief Retrieves the most expensive shape pairs of the last simulation step, sorted by decreasing cost.
+
+	Only available when the attribution mode is enabled, see setNarrowPhaseAttribution().
+
+	\note Do not use this method while the simulation is running. Calls to this method while the simulation is running will be ignored.
+
+	\param[out] userBuffer		Buffer receiving the most expensive pairs.
+	\param[in] bufferSize		Size of the buffer, i.e. maximum number of pairs to report.
+	\return Number of pairs written to the buffer.
+
+	\see PxNarrowPhasePairCost getNarrowPhaseActorCosts()
+	*/
+	virtual	PxU32				getNarrowPhasePairCosts(PxNarrowPhasePairCost* userBuffer, PxU32 bufferSize) const = 0;
+
+	/**
+	\brief Retrieves the actors with the most expensive narrow phase in the last simulation step, sorted by decreasing cost.
+
+	The cost of a pair is added to both of its actors. Only available when the attribution mode is enabled, see
+	setNarrowPhaseAttribution().
+
+	\note Do not use this method while the simulation is running. Calls to this method while the simulation is running will be ignored.
+
+	\param[out] userBuffer		Buffer receiving the most expensive actors.
+	\param[in] bufferSize		Size of the buffer, i.e. maximum number of actors to report.
+	\return Number of actors written to the buffer.
+
+	\see PxNarrowPhaseActorCost getNarrowPhasePairCosts()
+	*/
+	virtual	PxU32				getNarrowPhaseActorCosts(PxNarrowPhaseActorCost* userBuffer, PxU32 bufferSize) const = 0;
 	
 	//\}
 	
@@ -1505,6 +1940,61 @@ class PxScene : public PxSceneSQSystem
 	*/
 	virtual	bool					removeBroadPhaseRegion(PxU32 handle)				= 0;
 
+	/**
+	\brief Enables or disables the recording of broad-phase pair deltas.
+
+	When enabled, the pairs of shapes whose broad-phase bounds started or stopped overlapping during a simulation step are
+	recorded, and can be retrieved after fetchResults() with getBroadPhaseCreatedPairs() and getBroadPhaseDeletedPairs().
+	This makes it possible to drive proximity-based game logic from the simulation's own broad-phase, without creating
+	trigger shapes or running a second broad-phase.
+
+	A pair is recorded if the simulation filter data of at least one of its shapes shares a bit with the group mask,
+	i.e. if (filterData.word0 & groupMask.word0) | (filterData.word1 & groupMask.word1) | ... is not zero. Use a mask
+	with all bits set to record all pairs.
+
+	\note Pairs are reported before filtering, i.e. independently of the filter shader and of PxPairFlags.
+	\note Pairs are not reported when a shape is removed from the scene, or when pairs are refiltered.
+	\note The pairs use the broad-phase bounds, which include the shapes' contact offsets.
+
+	\param[in]	enable		True to enable the recording
+	\param[in]	groupMask	Mask tested against the simulation filter data of each shape
+
+	\see getBroadPhaseCreatedPairs() getBroadPhaseDeletedPairs() PxShape::setSimulationFilterData()
+	*/
+	virtual	void					setBroadPhasePairRecording(bool enable, const PxFilterData& groupMask = PxFilterData(0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff))	= 0;
+
+	/**
+	\brief Returns true if broad-phase pair deltas are being recorded.
+
+	\see setBroadPhasePairRecording()
+	*/
+	virtual	bool					getBroadPhasePairRecording()						const	= 0;
+
+	/**
+	\brief Returns the pairs of shapes whose broad-phase bounds started overlapping during the last simulation step.
+
+	The returned buffer is owned by the scene. It is only valid until the next simulation step, and it must not be
+	accessed while the simulation is running.
+
+	\param[out]	nbPairs	Number of returned pairs
+	\return Buffer of created pairs, or NULL if there are none
+
+	\see setBroadPhasePairRecording() getBroadPhaseDeletedPairs()
+	*/
+	virtual	const PxBroadPhaseShapePair*	getBroadPhaseCreatedPairs(PxU32& nbPairs)	const	= 0;
+
+	/**
+	\brief Returns the pairs of shapes whose broad-phase bounds stopped overlapping during the last simulation step.
+
+	Same as getBroadPhaseCreatedPairs() for lost pairs.
+
+	\param[out]	nbPairs	Number of returned pairs
+	\return Buffer of deleted pairs, or NULL if there are none
+
+	\see setBroadPhasePairRecording() getBroadPhaseCreatedPairs()
+	*/
+	virtual	const PxBroadPhaseShapePair*	getBroadPhaseDeletedPairs(PxU32& nbPairs)	const	= 0;
+
 	//\}
 
 	/************************************************************************************************/
@@ -1692,6 +2182,8 @@ class PxScene : public PxSceneSQSystem
 
 	\note This is an expensive operation and we recommend to use it only in the case where distance related precision issues may arise in areas far from the origin.
 
+	\note For large scenes the work is spread over the worker threads of the scene's CPU dispatcher. The call still returns only once the whole scene has been shifted.
+
 	\param[in] shift Translation vector to shift the origin by.
 	*/
 	virtual	void					shiftOrigin(const PxVec3& shift) = 0;
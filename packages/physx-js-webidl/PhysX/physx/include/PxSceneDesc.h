@@ -251,6 +251,10 @@ struct PxSceneFlag
 		with the existing actors in the scene. Determinism is only guaranteed if the actors are inserted in a consistent order each run in a newly-created scene and simulated using a consistent time-stepping
 		scheme.
 
+		With this flag, CPU simulation results also do not depend on the number of worker threads used by the CPU dispatcher. Solver islands are
+		batched independently of the worker count, force threshold reports are accumulated in a fixed order and adaptive solver iteration counts
+		(see PxSceneDesc::solverResidualTolerance) are only used for islands that are always solved on a single thread.
+
 		Note that this flag is not mutable and must be set at scene creation.
 
 		Note that enabling this flag can have a negative impact on performance.
@@ -343,7 +347,65 @@ struct PxSceneFlag
 		*/
 		eENABLE_SOLVER_RESIDUAL_REPORTING = (1 << 19),
 
-		eMUTABLE_FLAGS = eENABLE_ACTIVE_ACTORS|eEXCLUDE_KINEMATICS_FROM_ACTIVE_ACTORS
+		/**
+		\brief Enables caching of the simulation filter shader results.
+
+		When many new broadphase pairs are found at once, most of them usually share the same filter data. With this flag,
+		the results of the filter shader are cached and reused for pairs with identical inputs (filter object attributes,
+		filter data and incoming pair flags), instead of calling the shader again.
+
+		The cache only lives for the duration of a filtering pass, so changing the filter data of shapes or calling
+		PxScene::resetFiltering() does not require any explicit invalidation.
+
+		\note The filter shader must be a pure function of its inputs, as recommended in #PxSimulationFilterShader.
+
+		\note This flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		\see PxSimulationFilterShader
+
+		<b>Default</b> false
+		*/
+		eENABLE_FILTER_SHADER_CACHE = (1 << 20),
+
+		/**
+		\brief Enables the rigid body streams.
+
+		With this flag, fetchResults() copies the poses and velocities of the active rigid bodies to separate,
+		16-byte aligned arrays, which can then be read with PxScene::getRigidBodyStreams(). The set of bodies is the
+		same as for the active actors, i.e. eEXCLUDE_KINEMATICS_FROM_ACTIVE_ACTORS applies, but eENABLE_ACTIVE_ACTORS
+		does not need to be set.
+
+		\note This flag is mutable.
+
+		\see PxScene::getRigidBodyStreams() PxRigidBodyStreams
+
+		<b>Default</b> false
+		*/
+		eENABLE_BODY_STREAMS = (1 << 21),
+
+		/**
+		\brief Enables quantized contact streams.
+
+		With this flag, the contact streams written by the CPU narrow phase store the first contact of each patch at full
+		precision and the other contacts as half precision offsets from it (see #PxQuantizedContact). This roughly halves the
+		memory written and read per contact, which matters in dense piles. The solver and the contact reports decode the
+		points on the fly through PxContactStreamIterator, so code reading the streams with the iterator (e.g.
+		PxContactPair::extractContacts()) is unaffected, but code casting PxContactPair::contactPoints to PxContact is not.
+
+		Point offsets keep about 3 significant digits, i.e. up to ~1mm of error for contacts 1 unit apart in the same patch.
+
+		\note Modifiable contacts (see #PxPairFlag::eMODIFY_CONTACTS), CCD contacts and contacts processed by GPU dynamics
+		are never quantized.
+
+		\note This flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		\see PxQuantizedContact PxContactStreamIterator
+
+		<b>Default</b> false
+		*/
+		eENABLE_QUANTIZED_CONTACTS = (1 << 22),
+
+		eMUTABLE_FLAGS = eENABLE_ACTIVE_ACTORS|eEXCLUDE_KINEMATICS_FROM_ACTIVE_ACTORS|eENABLE_BODY_STREAMS
 	};
 };
 
@@ -627,6 +689,40 @@ public:
 	*/
 	PxGpuBroadPhaseDesc*	gpuBroadPhaseDesc;
 
+	/**
+	\brief Margin for the broad-phase temporal coherence mode.
+
+	When this is strictly positive, the bounds of non-aggregated shapes are inflated by this margin (and extended in the
+	direction of motion, see #broadPhaseCoherencePrediction) before being passed to the broad-phase. As long as the actual
+	bounds of a shape remain within these fat bounds, the shape is not re-submitted to the broad-phase. This can greatly
+	reduce the broad-phase cost for scenes where many objects move slowly.
+
+	The drawback is that overlaps are computed using the fat bounds, so more pairs can reach the narrow-phase.
+
+	\note Only used by CPU broad-phases (i.e. not with PxBroadPhaseType::eGPU). Aggregates are not affected.
+
+	<b>Range:</b> [0, PX_MAX_F32)<br>
+	<b>Default:</b> 0.0 (disabled)
+
+	\see broadPhaseCoherencePrediction
+	*/
+	PxReal	broadPhaseCoherenceMargin;
+
+	/**
+	\brief Number of simulation steps of motion covered by the fat bounds in the broad-phase temporal coherence mode.
+
+	Each time the fat bounds of a shape are recomputed, they are extended by the displacement the shape would cover in that many
+	steps, at the velocity observed since the previous time its fat bounds were recomputed. Use 0.0 to only use the constant margin.
+
+	\note Only used when #broadPhaseCoherenceMargin is strictly positive.
+
+	<b>Range:</b> [0, PX_MAX_F32)<br>
+	<b>Default:</b> 2.0
+
+	\see broadPhaseCoherenceMargin
+	*/
+	PxReal	broadPhaseCoherencePrediction;
+
 	/**
 	\brief Expected scene limits.
 
@@ -762,6 +858,44 @@ public:
 	*/
 	PxU32	solverArticulationBatchSize;
 
+	/**
+	\brief Residual tolerance below which the CPU solver stops iterating on an island.
+
+	When this is strictly positive, the solver monitors the maximum contact residual of each island after every iteration. Once it
+	drops below this tolerance (and at least #solverMinIterations iterations have been performed), the remaining iterations of the
+	current phase are skipped. Resting islands then typically converge in one or two iterations, while active islands still use
+	the iteration counts requested by their bodies, which act as the upper bound.
+
+	The residual is a velocity error, expressed in units of distance per unit of time.
+
+	\note This requires PxSceneFlag::eENABLE_SOLVER_RESIDUAL_REPORTING, and is ignored otherwise.
+
+	\note Residuals are only computed for contacts. Islands containing joints or articulations always use their full iteration counts.
+
+	\note Only islands solved by a single thread are affected, since the multi-threaded solver synchronizes iterations across threads.
+	With the TGS solver, position iterations are substeps and are never skipped: only velocity iterations stop early.
+
+	\note Friction is solved in every position iteration for the affected islands, regardless of PxSceneFlag::eENABLE_FRICTION_EVERY_ITERATION.
+
+	<b>Range:</b> [0, PX_MAX_F32)<br>
+	<b>Default:</b> 0.0 (disabled)
+
+	\see solverMinIterations PxRigidDynamic.setSolverIterationCounts()
+	*/
+	PxReal	solverResidualTolerance;
+
+	/**
+	\brief Minimum number of solver iterations performed in each phase before an island is allowed to stop early.
+
+	\note Only used when #solverResidualTolerance is strictly positive.
+
+	<b>Range:</b> [1, 255]<br>
+	<b>Default:</b> 1
+
+	\see solverResidualTolerance
+	*/
+	PxU32	solverMinIterations;
+
 	/**
 	\brief Setting to define the number of 16K blocks that will be initially reserved to store contact, friction, and contact cache data.
 	This is the number of 16K memory blocks that will be automatically allocated from the user allocator when the scene is instantiated. Further 16k
@@ -797,6 +931,29 @@ public:
 	*/
 	PxU32	maxNbContactDataBlocks;
 
+	/**
+	\brief Memory budget (in bytes) for the contact, friction, contact cache and constraint data of the scene.
+
+	These all live in the 16K blocks controlled by #nbContactDataBlocks and #maxNbContactDataBlocks. When a budget is set,
+	the number of blocks the SDK can allocate is clamped to the budget. Additionally, when the peak usage of the previous
+	simulation step reached 75% of the budget, the scene degrades in the following way for the next step, instead of running
+	into allocation failures and dropped contacts:
+
+	\li eNOTIFY_TOUCH_PERSISTS contact reports are not sent. Touch found and touch lost reports are unaffected.
+	\li The number of CCD passes is limited to 1, regardless of #ccdMaxPasses.
+
+	The degradations taken in a step are reported in PxSimulationStatistics.
+
+	\note A value of 0 disables the budget.
+
+	<b>Default:</b> 0
+
+	<b>Range:</b> [0, PX_MAX_U32]<br>
+
+	\see maxNbContactDataBlocks PxSimulationStatistics.budgetedMemoryPeak
+	*/
+	PxU32	simulationMemoryBudget;
+
 	/**
 	\brief The maximum bias coefficient used in the constraint solver
 
@@ -1012,6 +1169,8 @@ PX_INLINE PxSceneDesc::PxSceneDesc(const PxTolerancesScale& scale):
 	broadPhaseType					(PxBroadPhaseType::ePABP),
 	broadPhaseCallback				(NULL),
 	gpuBroadPhaseDesc				(NULL),
+	broadPhaseCoherenceMargin		(0.0f),
+	broadPhaseCoherencePrediction	(2.0f),
 
 	frictionType					(PxFrictionType::ePATCH),
 	solverType						(PxSolverType::ePGS),
@@ -1028,9 +1187,12 @@ PX_INLINE PxSceneDesc::PxSceneDesc(const PxTolerancesScale& scale):
 
 	solverBatchSize					(128),
 	solverArticulationBatchSize		(16),
+	solverResidualTolerance			(0.0f),
+	solverMinIterations				(1),
 
 	nbContactDataBlocks				(0),
 	maxNbContactDataBlocks			(1<<16),
+	simulationMemoryBudget			(0),
 	maxBiasCoefficient				(PX_MAX_F32),
 	contactReportStreamBufferSize	(8192),
 	ccdMaxPasses					(1),
@@ -1074,6 +1236,9 @@ PX_INLINE bool PxSceneDesc::isValid() const
 	if(frictionCorrelationDistance <= 0)
 		return false;
 
+	if(solverResidualTolerance < 0.0f || solverMinIterations < 1 || solverMinIterations > 255)
+		return false;
+
 	if(maxBiasCoefficient < 0.0f)
 		return false;
 
@@ -1093,12 +1258,18 @@ PX_INLINE bool PxSceneDesc::isValid() const
 	if(maxNbContactDataBlocks < nbContactDataBlocks)
 		return false;
 
+	if(simulationMemoryBudget && simulationMemoryBudget/16384 < nbContactDataBlocks)
+		return false;
+
 	if(wakeCounterResetValue <= 0.0f)
 		return false;
 
 	if(!sanityBounds.isValid())
 		return false;
 
+	if(broadPhaseCoherenceMargin < 0.0f || broadPhaseCoherencePrediction < 0.0f)
+		return false;
+
 	if(solverType == PxSolverType::ePGS && (flags & PxSceneFlag::eENABLE_EXTERNAL_FORCES_EVERY_ITERATION_TGS))
 		return false;
 
@@ -91,6 +91,10 @@ eINCREMENTAL uses an incremental AABB-tree, with no direct PxPruningStructureTyp
 Query time is fast but insertion cost can be high.
 
 eBVH uses a PxBVH structure. This usually offers the best overall performance.
+
+eGRID uses a loose grid (spatial hash). Insertion, update and removal are O(1), and query cost depends
+on how many objects are around the query. It is meant for scenes that constantly add and remove many
+small objects, e.g. projectiles, where the cost of the other structures is dominated by insertions.
 */
 struct PxDynamicTreeSecondaryPruner
 {
@@ -100,6 +104,7 @@ struct PxDynamicTreeSecondaryPruner
 		eBUCKET	,		//!< bucket-based secondary pruner, faster updates, slower query time
 		eINCREMENTAL,	//!< incremental-BVH secondary pruner, faster query time, slower updates
 		eBVH,			//!< PxBVH-based secondary pruner, good overall performance
+		eGRID,			//!< loose-grid secondary pruner, fastest updates, for many small short-lived objects
 
 		eLAST
 	};
@@ -190,6 +195,31 @@ public:
 	*/
 	PxU32	dynamicTreeRebuildRateHint;
 
+	/**
+	\brief Tree quality degradation that triggers a rebuild of the dynamic AABB tree pruning structures.
+
+	By default a new tree is rebuilt in the background as soon as objects are added, removed or updated, and the
+	rebuild restarts as soon as the previous one has finished. When this parameter is larger than zero, the current tree
+	is only refit until its quality has degraded past the given threshold, and only then a rebuild starts (spread over
+	#PxSceneQueryDesc::dynamicTreeRebuildRateHint frames as usual).
+
+	The degradation is measured as the relative increase of the tree's surface area heuristic cost since it was built,
+	plus the number of objects added since then relative to the number of objects in the tree. For example a value of
+	0.25 starts a rebuild once refitting made the tree 25% more expensive to traverse, or once a quarter more objects
+	have been added.
+
+	This is useful for scenes where objects move slowly, where refitting alone keeps the tree efficient for a long time
+	and constant rebuilds are wasted work.
+
+	\note Only used by the dynamic pruning structure (#dynamicStructure), when it is #PxPruningStructureType::eDYNAMIC_AABB_TREE.
+
+	<b>Range:</b> [0, PX_MAX_F32)<br>
+	<b>Default:</b> 0.0 (rebuild whenever the tree changed)
+
+	\see dynamicTreeRebuildRateHint
+	*/
+	PxReal	dynamicTreeRebuildCostThreshold;
+
 	/**
 	\brief Secondary pruner for dynamic tree.
 
@@ -261,6 +291,24 @@ public:
 	*/
 	PxU32	dynamicNbObjectsPerNode;
 
+	/**
+	\brief Quantized tree for PxSceneQueryDesc::staticStructure.
+
+	When enabled, the tree of a PxPruningStructureType::eSTATIC_AABB_TREE static structure stores its node bounds with
+	16 bits per coordinate instead of 32, using 16-byte nodes instead of 28-byte ones. This reduces the memory used by
+	large static trees by about 40% and the memory bandwidth of queries traversing them. The quantized bounds are
+	slightly larger than the exact ones, so queries can visit a few more nodes, but the results are the same.
+
+	Merging a PxPruningStructure into a quantized static tree triggers a full rebuild of the tree.
+
+	\note Only used with PxPruningStructureType::eSTATIC_AABB_TREE.
+
+	<b>Default:</b> false
+
+	\see PxSceneQueryDesc::staticStructure
+	*/
+	bool	staticQuantizedTree;
+
 	/**
 	\brief Defines the scene query update mode.
 
@@ -292,11 +340,13 @@ PX_INLINE PxSceneQueryDesc::PxSceneQueryDesc():
 	staticStructure				(PxPruningStructureType::eDYNAMIC_AABB_TREE),
 	dynamicStructure			(PxPruningStructureType::eDYNAMIC_AABB_TREE),
 	dynamicTreeRebuildRateHint	(100),
+	dynamicTreeRebuildCostThreshold	(0.0f),
 	dynamicTreeSecondaryPruner	(PxDynamicTreeSecondaryPruner::eINCREMENTAL),
 	staticBVHBuildStrategy		(PxBVHBuildStrategy::eFAST),
 	dynamicBVHBuildStrategy		(PxBVHBuildStrategy::eFAST),
 	staticNbObjectsPerNode		(4),
 	dynamicNbObjectsPerNode		(4),
+	staticQuantizedTree			(false),
 	sceneQueryUpdateMode		(PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_ENABLED)
 {
 }
@@ -314,6 +364,9 @@ PX_INLINE bool PxSceneQueryDesc::isValid() const
 	if(dynamicTreeRebuildRateHint < 4)
 		return false;
 
+	if(!(dynamicTreeRebuildCostThreshold >= 0.0f))
+		return false;
+
 	return true;
 }
 
@@ -50,6 +50,7 @@ namespace physx
 	class PxBVH;
 	class PxPruningStructure;
 	class PxBounds3;
+	class PxPlane;
 
 	/**
 	\brief Built-in enum for default PxScene pruners
@@ -241,6 +242,73 @@ namespace physx
 		virtual bool	overlap(const PxGeometry& geometry, const PxTransform& pose, PxOverlapCallback& hitCall,
 								const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
 								const PxQueryCache* cache = NULL, PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const = 0;
+
+		/**
+		\brief Culls the scene against a convex volume, returns the results in a PxOverlapBuffer object
+		or via a custom user callback implementation inheriting from PxOverlapCallback.
+
+		This reports all shapes whose scene-query bounds are not fully outside the volume, typically a view frustum
+		or any other set of planes used for visibility or interest-management purposes. Parts of the pruning structures
+		fully inside the volume are reported without any further test, which makes this query much cheaper than an
+		overlap against a convex mesh for large volumes.
+
+		Like #PxBVH::cull this is a conservative test against bounds only, i.e. some of the returned shapes may actually
+		be outside the volume, close to it but not touching it. Returned hits have their faceIndex set to 0xffffffff.
+
+		Filtering works as for overlap(): the static and dynamic flags, the filter equation and the pre-filter are supported.
+		Post-filters are called with the reported hits. There is no cache parameter.
+
+		\param[in] nbPlanes		Number of planes. Only 32 planes max are supported.
+		\param[in] planes		Planes defining the volume, in world space. Normals point outward, i.e. a point is inside the volume when it is behind all planes.
+		\param[out] hitCall		Overlap hit buffer or callback object used to report culling results.
+		\param[in] filterData	Filtering data and simple logic. See #PxQueryFilterData #PxQueryFilterCallback
+		\param[in] filterCall	Custom filtering logic (optional). Only used if the corresponding #PxQueryFlag flags are set. If NULL, all shapes are reported.
+		\param[in] queryFlags	Optional flags controlling the query.
+
+		\return True if any touching or blocking hits were found or any hit was found in case PxQueryFlag::eANY_HIT was specified.
+
+		\note As for overlap(), users should set PxQueryFlag::eNO_BLOCK or only return eTOUCH from the pre-filter.
+
+		\see PxOverlapCallback PxOverlapBuffer PxQueryFilterData PxQueryFilterCallback PxBVH::cull
+		*/
+		virtual bool	cull(PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hitCall,
+							const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
+							PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const = 0;
+
+		/**
+		\brief Batched sphere overlap queries, typically used for interest management (e.g. all objects within a given
+		radius of each connected client).
+
+		This is equivalent to one sphere overlap() call per query, but the spheres are first organized in a small BVH and the
+		scene-query trees are traversed once for the whole batch, opening the pairs of tree nodes and query nodes that overlap.
+		This is much cheaper than independent queries when there are many spheres.
+
+		Results are written to the hits buffer grouped by query: the hits of the first sphere come first, followed by the hits
+		of the second sphere, etc. The number of hits for each sphere is written to nbHitsPerQuery. Returned hits have their
+		faceIndex set to 0xffffffff. Within a sphere's results, hits are in no particular order.
+
+		Filtering works as for overlap(), except that the post-filter is never called and that all hits are reported as touches,
+		whatever the pre-filter returns (other than PxQueryHitType::eNONE). By default only dynamic shapes are tested.
+
+		\param[in] nbSpheres		Number of query spheres
+		\param[in] centers			World-space centers of the query spheres
+		\param[in] radii			Radii of the query spheres
+		\param[out] hits			Buffer receiving the hits, grouped by query
+		\param[in] maxNbHits		Capacity of the hits buffer
+		\param[out] nbHitsPerQuery	Buffer of nbSpheres entries receiving the number of hits for each sphere. This is also filled
+									when the hits buffer overflows, so that users can allocate a large enough buffer and retry.
+		\param[in] filterData		Filtering data and simple logic, shared by all queries. See #PxQueryFilterData #PxQueryFilterCallback
+		\param[in] filterCall		Custom filtering logic (optional). Only used if PxQueryFlag::ePREFILTER is set.
+		\param[in] queryFlags		Optional flags controlling the query.
+
+		\return Total number of hits written to the buffer, or -1 if the buffer overflowed or the input was invalid.
+
+		\see overlap PxQueryFilterData PxQueryFilterCallback
+		*/
+		virtual	PxI32	overlapSpheres(PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,
+										PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+										const PxQueryFilterData& filterData = PxQueryFilterData(PxQueryFlag::eDYNAMIC), PxQueryFilterCallback* filterCall = NULL,
+										PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const = 0;
 		//\}
 	};
 
@@ -571,6 +639,18 @@ namespace physx
 		*/
 		virtual	PxSQPrunerHandle	getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const	= 0;
 
+		/**
+		\brief Starts the scene's fetchResults() synchronization.
+
+		This is called by PxScene in fetchResults(), before the updateSQCompound() and sync() calls that move the scene-query
+		objects to their new poses. The synchronization always ends with a finalizeUpdates() call. The default implementation
+		does nothing. Wrappers running queries concurrently with fetchResults() can use it to treat all these updates as a
+		single operation.
+
+		\see sync() updateSQCompound() finalizeUpdates()
+		*/
+		virtual	void	beginSync()	{}
+
 		/**
 		\brief Synchronizes the scene-query system with another system that references the same objects.
 
@@ -111,7 +111,23 @@ struct PxShapeFlag
 
 		\see PxScene.getRenderBuffer() PxRenderBuffer PxVisualizationParameter
 		*/
-		eVISUALIZATION					= (1<<3)
+		eVISUALIZATION					= (1<<3),
+
+		/**
+		\brief Contacts against triangle meshes and heightfields are reduced to a single patch of at most 4 points.
+
+		The narrow phase keeps the deepest contact and the 3 contacts spanning the largest area around it, and gives them
+		a shared normal and the deepest contact's triangle (and therefore material). This bounds the solver cost of a
+		shape resting on a dense mesh, at the expense of accuracy when the shape touches several distinct surfaces.
+
+		The flag applies to a pair when either shape raises it. It has no effect on pairs that do not involve a triangle
+		mesh or a heightfield, or when the narrow phase runs on the GPU.
+
+		<b>Default:</b> false
+
+		\see PxShape.setFlag()
+		*/
+		eREDUCE_MESH_CONTACTS			= (1<<4)
 	};
 };
 
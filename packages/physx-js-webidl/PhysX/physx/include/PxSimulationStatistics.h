@@ -39,6 +39,9 @@ namespace physx
 {
 #endif
 
+class PxActor;
+class PxShape;
+
 /**
 \brief Structure used to retrieve actual sizes/counts for the configuration parameters provided in PxGpuDynamicsMemoryConfig.
 
@@ -199,6 +202,51 @@ public:
 	*/
 	PxU32   peakConstraintMemory;
 
+//memory budget:
+	/**
+	\brief The peak amount of memory (in bytes) used by the contact, friction, contact cache and constraint blocks during the previous
+	simulation step. This is the value compared against PxSceneDesc::simulationMemoryBudget to decide whether the current step runs degraded.
+	*/
+	PxU32	budgetedMemoryPeak;
+
+	/**
+	\brief The number of eNOTIFY_TOUCH_PERSISTS contact reports dropped in the current simulation step because of the memory budget.
+
+	\see PxSceneDesc::simulationMemoryBudget
+	*/
+	PxU32	nbDroppedContactReports;
+
+	/**
+	\brief The number of CCD passes removed from PxSceneDesc::ccdMaxPasses in the current simulation step because of the memory budget.
+
+	\see PxSceneDesc::simulationMemoryBudget
+	*/
+	PxU32	nbCappedCCDPasses;
+
+//internal memory:
+	/**
+	\brief The amount of memory (in bytes) used by the CPU contact stream in the current simulation step, i.e. the size of the 16K blocks
+	holding the compressed contacts.
+	*/
+	PxU32	peakContactStreamMemory;
+
+	/**
+	\brief The peak amount of memory (in bytes) used by temporary allocations from the scratch block in the current simulation step.
+
+	This does not include the space given to the constraint blocks, see peakConstraintMemory.
+
+	\see PxScene::simulate()
+	*/
+	PxU32	peakScratchMemory;
+
+	/**
+	\brief The amount of memory (in bytes) of the temporary allocations that did not fit in the scratch block in the current simulation
+	step, and were allocated from the heap instead. A non-zero value means a larger scratch block would avoid some heap allocations.
+
+	\see PxScene::simulate()
+	*/
+	PxU32	scratchHeapFallbackMemory;
+
 //broadphase:
 	/**
 	\brief Get number of broadphase volumes added for the current simulation step.
@@ -281,6 +329,16 @@ public:
 	*/
 	PxU32	nbDiscreteContactPairsWithContacts;
 
+	/**
+	\brief Returns the ratio of (non CCD) pairs whose contacts were reused from the cache, e.g. unchanged PCM manifolds.
+
+	\return Ratio between 0 and 1, or 0 if no pair reached the narrow phase.
+	*/
+	PX_FORCE_INLINE	PxReal getNarrowPhaseCacheHitRate() const
+	{
+		return nbDiscreteContactPairsTotal ? PxReal(nbDiscreteContactPairsWithCacheHits) / PxReal(nbDiscreteContactPairsTotal) : 0.0f;
+	}
+
 	/**
 	\brief Number of new pairs found by BP this frame
 	*/
@@ -306,6 +364,36 @@ public:
 	*/
 	PxU32	nbPartitions;
 
+	enum
+	{
+		eISLAND_SIZE_BUCKET_COUNT	= 8,	//!< Number of buckets in islandSizeHistogram.
+		eSOLVER_BATCH_WIDTH_COUNT	= 4		//!< Number of entries in nbSolverBatches.
+	};
+
+	/**
+	\brief Number of bounds updated in the broad phase this frame, not counting the CCD passes.
+	*/
+	PxU32	nbBroadPhaseUpdatedBounds;
+
+	/**
+	\brief Number of active islands this frame.
+	*/
+	PxU32	nbActiveIslands;
+
+	/**
+	\brief Histogram of the active islands' sizes this frame, in number of nodes (rigid bodies and articulations).
+
+	Bucket i counts the islands with 2^i to 2^(i+1)-1 nodes. The last bucket also counts all the larger islands.
+	*/
+	PxU32	islandSizeHistogram[eISLAND_SIZE_BUCKET_COUNT];
+
+	/**
+	\brief Number of constraint batches solved this frame by the CPU solver, per batch width.
+
+	Entry i counts the batches of i+1 constraints. Full batches (the last entry) are solved most efficiently by the SIMD solver.
+	*/
+	PxU32	nbSolverBatches[eSOLVER_BATCH_WIDTH_COUNT];
+
 	/**
 	\brief GPU device memory in bytes allocated for particle state accessible through API
 	*/
@@ -428,6 +516,12 @@ public:
 		compressedContactSize					(0),
 		requiredContactConstraintMemory			(0),
 		peakConstraintMemory					(0),
+		budgetedMemoryPeak						(0),
+		nbDroppedContactReports					(0),
+		nbCappedCCDPasses						(0),
+		peakContactStreamMemory					(0),
+		peakScratchMemory						(0),
+		scratchHeapFallbackMemory				(0),
 		nbDiscreteContactPairsTotal				(0),
 		nbDiscreteContactPairsWithCacheHits		(0),
 		nbDiscreteContactPairsWithContacts		(0),
@@ -436,6 +530,8 @@ public:
 		nbNewTouches							(0),
 		nbLostTouches							(0),
 		nbPartitions							(0),
+		nbBroadPhaseUpdatedBounds				(0),
+		nbActiveIslands							(0),
 		gpuMemParticles							(0),
 		gpuMemDeformableSurfaces				(0),
 		gpuMemDeformableVolumes					(0),
@@ -475,6 +571,12 @@ public:
 		{
 			nbShapes[i] = 0;
 		}
+
+		for(PxU32 i=0; i < eISLAND_SIZE_BUCKET_COUNT; i++)
+			islandSizeHistogram[i] = 0;
+
+		for(PxU32 i=0; i < eSOLVER_BATCH_WIDTH_COUNT; i++)
+			nbSolverBatches[i] = 0;
 	}
 
 
@@ -492,6 +594,123 @@ public:
 	PxU32   nbTriggerPairs[PxGeometryType::eGEOMETRY_COUNT][PxGeometryType::eGEOMETRY_COUNT];
 };
 
+/**
+\brief Identifies a stage of the simulation pipeline, see PxSimulationStageTimings.
+
+Some stages are spans covering a whole phase of the pipeline, including the tasks it spawns (eCOLLISION, eBROAD_PHASE,
+ePOST_BROAD_PHASE, eNARROW_PHASE, eSOLVER, eUPDATE_DYNAMICS). The others measure a single pipeline task, and are nested
+within the spans.
+
+\see PxSimulationStageTimings PxScene::getSimulationStageTimings()
+*/
+struct PxSimulationStage
+{
+	enum Enum
+	{
+		eCOLLISION,					//!< Whole collision phase, from the start of the step to the end of the narrow phase.
+		eBROAD_PHASE,				//!< Broad phase, including the processing of new and lost pairs.
+		eBROAD_PHASE_FIRST_PASS,	//!< First broad-phase pass, updating the bounds and aggregates.
+		eBROAD_PHASE_SECOND_PASS,	//!< Second broad-phase pass, running the broad-phase algorithm itself. Runs again for each CCD pass.
+		ePOST_BROAD_PHASE,			//!< Processing of the broad-phase results (filtering, creation and destruction of pairs).
+		ePOST_BROAD_PHASE_STAGE2,	//!< Registration of the new pairs. The item count is the number of new shape pairs.
+		eNARROW_PHASE,				//!< Narrow phase (contact generation). The item count is the number of active shape pairs.
+		eISLAND_GEN,				//!< Island generation. The item count is the number of active rigid bodies.
+		eSOLVER,					//!< Whole rigid-body solver phase, from the end of the narrow phase to the end of the step. The item count is the number of active rigid bodies.
+		eUPDATE_DYNAMICS,			//!< Constraint solving and integration. The item count is the number of active rigid bodies.
+		eAFTER_INTEGRATION,			//!< Post-integration update of bounds, sleeping and contact force events.
+
+		eCOUNT
+	};
+};
+
+/**
+\brief Timings of a single simulation stage, see PxSimulationStageTimings.
+*/
+struct PxSimulationStageTiming
+{
+	PxReal	startTime;	//!< Time (in milliseconds) at which the stage first started, relative to the start of the simulation step.
+	PxReal	endTime;	//!< Time (in milliseconds) at which the stage last ended, relative to the start of the simulation step.
+	PxU32	nbCalls;	//!< Number of times the stage ran during the step. Zero if the stage did not run.
+	PxU32	nbItems;	//!< Number of items processed by the stage, see PxSimulationStage. Zero for stages without item count.
+
+	/**
+	\brief Wall-clock time (in milliseconds) spent in the stage. For stages running several times per step this includes the time between runs.
+	*/
+	PX_FORCE_INLINE	PxReal	getDuration()	const	{ return nbCalls ? endTime - startTime : 0.0f;	}
+};
+
+/**
+\brief Class used to retrieve per-stage timings for a simulation step.
+
+The timings are always recorded, independently of PxSimulationStatistics, of the PX_ENABLE_SIM_STATS define and of a
+connected profiler or PVD. Recording only costs a couple of timer reads per stage.
+
+\see PxScene::getSimulationStageTimings() PxSimulationStage
+*/
+class PxSimulationStageTimings
+{
+public:
+	PxSimulationStageTimings() : totalTime(0.0f)
+	{
+		for(PxU32 i=0; i<PxSimulationStage::eCOUNT; i++)
+		{
+			stages[i].startTime = 0.0f;
+			stages[i].endTime = 0.0f;
+			stages[i].nbCalls = 0;
+			stages[i].nbItems = 0;
+		}
+	}
+
+	/**
+	\brief Returns a readable name for a simulation stage, e.g. for exporting the timings to a metrics system.
+	*/
+	static const char*	getStageName(PxSimulationStage::Enum stage)
+	{
+		static const char* names[PxSimulationStage::eCOUNT] =
+		{
+			"collision",
+			"broadPhase",
+			"broadPhaseFirstPass",
+			"broadPhaseSecondPass",
+			"postBroadPhase",
+			"postBroadPhaseStage2",
+			"narrowPhase",
+			"islandGen",
+			"solver",
+			"updateDynamics",
+			"afterIntegration"
+		};
+		return stage < PxSimulationStage::eCOUNT ? names[stage] : "";
+	}
+
+	PxSimulationStageTiming	stages[PxSimulationStage::eCOUNT];	//!< Timings of each stage, indexed by PxSimulationStage::Enum.
+	PxReal					totalTime;							//!< Wall-clock time (in milliseconds) of the whole simulation step, excluding fetchResults().
+};
+
+/**
+\brief Narrow-phase cost of a shape pair, see PxScene::getNarrowPhasePairCosts().
+
+\note The pointers are only valid until the next simulation step, or until the objects are released.
+*/
+struct PxNarrowPhasePairCost
+{
+	const PxShape*	shapes[2];	//!< The two shapes of the pair.
+	const PxActor*	actors[2];	//!< The actors owning the shapes.
+	PxReal			time;		//!< Time (in microseconds) spent computing contacts for the pair.
+};
+
+/**
+\brief Narrow-phase cost of an actor, accumulated over all its shape pairs. See PxScene::getNarrowPhaseActorCosts().
+
+\note The pointer is only valid until the next simulation step, or until the actor is released.
+*/
+struct PxNarrowPhaseActorCost
+{
+	const PxActor*	actor;		//!< The actor.
+	PxReal			time;		//!< Time (in microseconds) spent computing contacts for the pairs involving the actor.
+	PxU32			nbPairs;	//!< Number of shape pairs involving the actor.
+};
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
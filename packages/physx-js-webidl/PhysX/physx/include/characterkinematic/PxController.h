@@ -89,6 +89,20 @@ struct PxControllerNonWalkableMode
 	};
 };
 
+/**
+\brief specifies the collision quality of a CCT.
+
+Lower qualities trade accuracy for speed. They are meant for large numbers of background characters.
+*/
+struct PxControllerQuality
+{
+	enum Enum
+	{
+		eDEFAULT,	//!< Full CCT algorithm
+		eCROWD		//!< Single iteration per pass, no overlap recovery, static shapes only, no user obstacles, no tessellation, no invisible walls and no precise sweeps
+	};
+};
+
 /**
 \brief specifies which sides a character is colliding with.
 */
@@ -497,6 +511,18 @@ public:
 	*/
 	PxControllerNonWalkableMode::Enum	nonWalkableMode;
 
+	/**
+	\brief The collision quality of the controller.
+
+	PxControllerQuality::eCROWD is a cheaper version of the CCT algorithm for background characters. It only collides
+	against static shapes and other characters, and the obstacle context passed to PxController::move() is ignored.
+
+	<b>Default:</b> PxControllerQuality::eDEFAULT
+
+	\see PxControllerQuality
+	*/
+	PxControllerQuality::Enum			quality;
+
 	/**
 	\brief The material for the actor associated with the controller.
 	
@@ -573,6 +599,7 @@ PX_INLINE PxControllerDesc::PxControllerDesc(PxControllerShapeType::Enum t) :
 	reportCallback				(NULL),
 	behaviorCallback			(NULL),
 	nonWalkableMode				(PxControllerNonWalkableMode::ePREVENT_CLIMBING),
+	quality						(PxControllerQuality::eDEFAULT),
 	material					(NULL),
 	registerDeletionListener	(true),
 	clientID					(PX_DEFAULT_CLIENT),
@@ -605,6 +632,7 @@ PX_INLINE void PxControllerDesc::copy(const PxControllerDesc& other)
 	behaviorCallback			= other.behaviorCallback;
 	userData					= other.userData;
 	nonWalkableMode				= other.nonWalkableMode;
+	quality						= other.quality;
 	position.x					= other.position.x;
 	position.y					= other.position.y;
 	position.z					= other.position.z;
@@ -784,6 +812,24 @@ public:
 	*/
 	virtual		PxControllerNonWalkableMode::Enum	getNonWalkableMode()				const		= 0;
 
+	/**
+	\brief Sets the collision quality for the CCT.
+
+	\param[in] quality The new collision quality.
+
+	\see PxControllerQuality
+	*/
+	virtual		void						setQuality(PxControllerQuality::Enum quality)	= 0;
+
+	/**
+	\brief Retrieves the collision quality for the CCT.
+
+	\return The current collision quality.
+
+	\see PxControllerQuality
+	*/
+	virtual		PxControllerQuality::Enum	getQuality()						const		= 0;
+
 	/**
 	\brief Retrieve the contact offset.
 
@@ -0,0 +1,80 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_CONTROLLER_LAYER_FILTER_H
+#define PX_CONTROLLER_LAYER_FILTER_H
+
+#include "characterkinematic/PxController.h"
+#include "extensions/PxLayerCollisionMatrix.h"
+#include "PxRigidDynamic.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	/**
+	\brief CCT-vs-CCT filter callback testing controllers against a PxLayerCollisionMatrix.
+
+	The layers of a controller are read from word0 of the query filter data of its actor's first shape. The matrix is
+	referenced, not copied, so that changes to it apply to the next moves.
+
+	Use it as PxControllerFilters::mCCTFilterCallback, together with a PxLayerMatrixQueryFilterCallback as
+	PxControllerFilters::mFilterCallback for CCT-vs-world filtering.
+
+	\see PxLayerCollisionMatrix PxLayerMatrixQueryFilterCallback PxControllerFilters
+	*/
+	class PxLayerMatrixControllerFilterCallback : public PxControllerFilterCallback
+	{
+		public:
+		/**
+		\param[in] matrix	Collision matrix, must outlive the callback
+		*/
+		PX_INLINE PxLayerMatrixControllerFilterCallback(const PxLayerCollisionMatrix& matrix) : mMatrix(matrix)	{}
+
+		virtual bool filter(const PxController& a, const PxController& b)	PX_OVERRIDE
+		{
+			return mMatrix.collides(getLayers(a), getLayers(b));
+		}
+
+		private:
+		const PxLayerCollisionMatrix&	mMatrix;
+
+		static PX_FORCE_INLINE PxU32 getLayers(const PxController& controller)
+		{
+			PxShape* shape = NULL;
+			controller.getActor()->getShapes(&shape, 1);
+			return shape ? shape->getQueryFilterData().word0 : 0;
+		}
+
+		PxLayerMatrixControllerFilterCallback& operator=(const PxLayerMatrixControllerFilterCallback&);
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
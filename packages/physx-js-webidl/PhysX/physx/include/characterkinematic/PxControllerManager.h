@@ -33,6 +33,7 @@
 #include "foundation/PxFlags.h"
 #include "foundation/PxErrorCallback.h"
 #include "common/PxRenderBuffer.h"
+#include "characterkinematic/PxController.h"
 
 #if !PX_DOXYGEN
 namespace physx
@@ -45,6 +46,7 @@ class PxController;
 class PxControllerDesc;
 class PxObstacleContext;
 class PxControllerFilterCallback;
+class PxCpuDispatcher;
 
 /**
 \brief specifies debug-rendering flags
@@ -70,6 +72,42 @@ struct PxControllerDebugRenderFlag
 typedef PxFlags<PxControllerDebugRenderFlag::Enum, PxU32> PxControllerDebugRenderFlags;
 PX_FLAGS_OPERATORS(PxControllerDebugRenderFlag::Enum, PxU32)
 
+/**
+\brief Per-controller input and output of PxControllerManager::moveAll().
+
+The input members are the parameters of PxController::move(). The collision flags are written back by moveAll().
+
+\see PxControllerManager.moveAll() PxController.move()
+*/
+struct PxControllerMoveDesc
+{
+	PX_INLINE	PxControllerMoveDesc() : controller(NULL), disp(0.0f), minDist(0.0f), elapsedTime(0.0f), collisionFlags(0)	{}
+
+	PxController*				controller;		//!< Controller to move. Each controller can only appear once per moveAll() call.
+	PxVec3						disp;			//!< Displacement vector, same as in PxController::move()
+	PxF32						minDist;		//!< Minimum travelled distance to consider, same as in PxController::move()
+	PxF32						elapsedTime;	//!< Time elapsed since last call, same as in PxController::move()
+	PxControllerCollisionFlags	collisionFlags;	//!< [out] Collision flags returned by the move
+};
+
+/**
+\brief Output buffers for PxControllerManager::getControllerStates().
+
+Each buffer is a flat array indexed like the manager's controllers (see PxControllerManager::getController()).
+Buffers left to NULL are not written.
+
+\see PxControllerManager.getControllerStates()
+*/
+struct PxControllerStateBuffers
+{
+	PX_INLINE	PxControllerStateBuffers() : positions(NULL), footPositions(NULL), collisionFlags(NULL), groundNormals(NULL)	{}
+
+	PxExtendedVec3*	positions;		//!< Center positions, same as PxController::getPosition()
+	PxExtendedVec3*	footPositions;	//!< Foot positions, same as PxController::getFootPosition()
+	PxU32*			collisionFlags;	//!< Collision flags of the last move (PxControllerCollisionFlag), same as PxControllerState::collisionFlags
+	PxVec3*			groundNormals;	//!< Contact normal of the last ground touched during the last move, or zero if the controller did not touch the ground
+};
+
 
 /**
 \brief Manages an array of character controllers.
@@ -187,6 +225,51 @@ public:
 	*/
 	virtual	void				computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb=NULL) = 0;
 
+	/**
+	\brief Moves a batch of controllers, optionally in parallel.
+
+	This is the batched equivalent of calling PxController::move() for each descriptor. When a dispatcher is provided, the
+	controllers are moved concurrently using its worker threads, and the function returns once all of them have been moved.
+
+	Within a batch, each controller collides against the other controllers at the positions they had when moveAll() was
+	called, not at their updated positions. The results therefore do not depend on how the work is scheduled. Use
+	computeInteractions() before the next batch to resolve the overlaps this can leave between characters.
+
+	Kinematic actors of the controllers are updated after all the moves have completed, in the order of the descriptors.
+
+	\note The user callbacks (PxUserControllerHitReport, PxControllerBehaviorCallback, PxControllerFilterCallback, PxQueryFilterCallback)
+	can be called concurrently from several threads when a dispatcher is used, and must be thread-safe.
+
+	\note Debug rendering (see setDebugRenderingFlags()) is not performed for controllers moved by this function.
+
+	\note The scene must not be written to while this function runs.
+
+	\param[in,out] descs			Array of move descriptors. The collision flags are written back to each descriptor.
+	\param[in] nbDescs			Number of descriptors
+	\param[in] filters			User-defined filters, shared by all controllers
+	\param[in] obstacles			Potential additional obstacles the controllers should collide with, shared by all controllers
+	\param[in] dispatcher			CPU dispatcher used to move the controllers in parallel. If NULL, they are moved serially on the calling thread.
+
+	\see PxControllerMoveDesc PxController.move() computeInteractions()
+	*/
+	virtual	void				moveAll(PxControllerMoveDesc* descs, PxU32 nbDescs, const PxControllerFilters& filters, const PxObstacleContext* obstacles=NULL, PxCpuDispatcher* dispatcher=NULL) = 0;
+
+	/**
+	\brief Retrieves the state of several controllers at once.
+
+	This is the bulk equivalent of calling PxController::getPosition(), PxController::getFootPosition() and
+	PxController::getState() for each controller, typically after moveAll(). Controller i of the manager is written
+	to index i-startIndex of each non-NULL buffer.
+
+	\param[out] buffers		Output buffers. Each non-NULL buffer must have room for at least bufferSize elements.
+	\param[in] bufferSize	Capacity of the buffers, in number of controllers
+	\param[in] startIndex	Index of the first controller to retrieve
+	\return Number of controllers written to the buffers
+
+	\see PxControllerStateBuffers getNbControllers() moveAll()
+	*/
+	virtual	PxU32				getControllerStates(const PxControllerStateBuffers& buffers, PxU32 bufferSize, PxU32 startIndex=0) const = 0;
+
 	/**
 	\brief Enables or disables runtime tessellation.
 
@@ -249,6 +332,28 @@ public:
 	*/
 	virtual	void				setPreventVerticalSlidingAgainstCeiling(bool flag) = 0;
 
+	/**
+	\brief Enables or disables the shared geometry cache.
+
+	By default each character gathers the static geometry around it with its own scene query. With the shared cache,
+	static geometry is gathered once per world-space tile and reused by all characters located in that tile. This
+	helps when many characters stand close to each other.
+
+	Tiles are cubes of size 'tileSize', extended by half a tile on each side. A character only uses the cache when its
+	cached volume fits in a tile, so the tile size should be large compared to the characters. Other characters fall back to
+	their own queries.
+
+	The cache is rebuilt when static objects are added, removed or moved. Characters only share tiles when they use the
+	same filter data, filter callback, up direction, slope limit and invisible wall height. A PxQueryFilterCallback
+	used with the cache must give the same answer for the same shape and filter data, whichever character is moving.
+
+	By default, the shared cache is disabled.
+
+	\param[in] flag				True/false to enable/disable the shared cache.
+	\param[in] tileSize			Size of a tile.
+	*/
+	virtual	void				setSharedGeometryCache(bool flag, float tileSize) = 0;
+
 	/**
 	\brief Shift the origin of the character controllers and obstacle objects by the specified vector.
 
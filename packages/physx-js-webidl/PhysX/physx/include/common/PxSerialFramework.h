@@ -364,6 +364,34 @@ public:
 	//\}
 	/************************************************************************************************/
 
+	/**
+	\brief Enables sharing of identical triangle meshes between collections deserialized with this registry.
+
+	When enabled, PxSerialization::createCollectionFromBinary() looks up each deserialized triangle mesh by content
+	hash among the meshes previously deserialized with this registry and not yet released. If an identical mesh is
+	found, the new collection and the objects referencing the mesh use that instance instead, and the collection owns
+	an additional reference to it. This way a mesh used by many separately serialized collections only exists once at
+	runtime.
+
+	The duplicate mesh is left unused in the deserialization memory block, which still has to stay allocated as long
+	as the collection is in use. To avoid storing the mesh in each block in the first place, serialize shared meshes
+	in their own collection and pass it as externalRefs instead.
+
+	\param[in]	enabled	True to enable sharing. Disabling it forgets all registered meshes. Default: false
+
+	\see PxSerialization::createCollectionFromBinary
+	*/
+	virtual void						setTriangleMeshSharing(bool enabled) = 0;
+
+	/**
+	\brief Returns whether triangle mesh sharing is enabled.
+
+	\see setTriangleMeshSharing
+	*/
+	virtual bool						getTriangleMeshSharing() const = 0;
+
+	/************************************************************************************************/
+
 	/**
 	\brief Releases PxSerializationRegistry instance.
 
@@ -50,6 +50,8 @@ class PxInsertionCallback;
 class PxFoundation;
 class PxAllocatorCallback;
 class PxHeightFieldDesc;
+class PxHeightFieldRasterDesc;
+class PxCpuDispatcher;
 
 /**
 \brief Result from convex cooking.
@@ -107,6 +109,34 @@ struct PxConvexMeshCookingType
 	};
 };
 
+/**
+\brief Quality tier for triangle mesh cooking.
+
+\see PxCookingParams::meshCookingQuality
+*/
+struct PxMeshCookingQuality
+{
+	enum Enum
+	{
+		/**
+		\brief Regular cooking. All requested preprocessing steps are performed.
+		*/
+		eFULL,
+
+		/**
+		\brief Fast cooking for meshes generated at runtime, at the expense of query and contact generation performance.
+
+		Vertex welding is skipped even if PxMeshPreprocessingFlag::eWELD_VERTICES is set, the BVH34 midphase is built from
+		Morton-sorted triangle centers instead of using PxBVH34MidphaseDesc::buildStrategy, and neither active edges nor
+		triangle adjacencies are computed (as if PxMeshPreprocessingFlag::eDISABLE_ACTIVE_EDGES_PRECOMPUTE was set and
+		PxCookingParams::buildTriangleAdjacencies was false).
+
+		Meshes cooked this way can later be replaced with the same mesh cooked with eFULL.
+		*/
+		ePREVIEW
+	};
+};
+
 /**
 \brief Result from triangle mesh cooking
 */
@@ -177,7 +207,28 @@ struct PxMeshPreprocessingFlag
 		/**
 		\brief When set, inertia data is calculated for the mesh, assuming unit density.
 		*/
-		eENABLE_INERTIA	= 1 << 5
+		eENABLE_INERTIA	= 1 << 5,
+
+		/**
+		\brief When set, vertices are snapped to a 16-bit grid spanning the mesh bounds and stored as 16-bit integers in the cooked data.
+
+		This halves the size of the vertex data in the cooked stream. The snapping happens before the midphase structure is built,
+		so the loaded mesh matches the cooked one exactly. The precision is the extent of the mesh bounds divided by 65535 on each axis.
+
+		\note Snapping can turn very thin triangles into degenerate ones. Only use this for meshes whose bounds are small enough for the required precision.
+		\note This only affects the cooked stream. The runtime mesh still stores its vertices as floats.
+		*/
+		eQUANTIZE_VERTICES	= 1 << 6,
+
+		/**
+		\brief When set, triangle indices are delta-encoded as variable-length integers in the cooked data.
+
+		The triangles are ordered spatially by the midphase structure, so consecutive indices are close to each other and
+		most of them take a single byte.
+
+		\note This only affects the cooked stream. The runtime mesh still stores 16-bit or 32-bit indices.
+		*/
+		eCOMPRESS_INDICES	= 1 << 7
 	};
 };
 
@@ -357,6 +408,28 @@ struct PxCookingParams
 	*/
 	PxReal maxWeightRatioInTet;
 
+	/**
+	\brief Optional CPU dispatcher used to parallelize triangle mesh cooking and batched convex mesh cooking.
+
+	When set, mesh cleaning, the BVH34 midphase build and the triangle remapping run on the dispatcher's worker threads
+	as well as on the calling thread. The cooked data is identical to the data produced without a dispatcher.
+	PxCreateConvexMeshes() also uses it to cook several hulls at the same time.
+
+	<b>Default value:</b> NULL
+
+	\see PxCookTriangleMesh PxCreateTriangleMesh PxCreateConvexMeshes PxDefaultCpuDispatcher
+	*/
+	PxCpuDispatcher* cpuDispatcher;
+
+	/**
+	\brief Quality tier for triangle mesh cooking.
+
+	<b>Default value:</b> PxMeshCookingQuality::eFULL
+
+	\see PxMeshCookingQuality
+	*/
+	PxMeshCookingQuality::Enum meshCookingQuality;
+
 	PxCookingParams(const PxTolerancesScale& sc):
 		areaTestEpsilon					(0.06f*sc.length*sc.length),
 		planeTolerance					(0.0007f),
@@ -370,11 +443,82 @@ struct PxCookingParams
 		meshAreaMinLimit				(0.0f),
 		meshEdgeLengthMaxLimit			(500.0f),
 		gaussMapLimit					(32),
-		maxWeightRatioInTet             (FLT_MAX)
+		maxWeightRatioInTet             (FLT_MAX),
+		cpuDispatcher					(NULL),
+		meshCookingQuality				(PxMeshCookingQuality::eFULL)
 	{
 	}
 };
 
+/**
+\brief Parameters for approximate convex decomposition.
+
+\see PxCreateConvexDecomposition()
+*/
+struct PxConvexDecompositionParams
+{
+	/**
+	\brief Maximum number of convex hulls produced for the mesh.
+
+	<b>Range:</b> [1, 1024]<br>
+	<b>Default value:</b> 16
+	*/
+	PxU32	maxNbHulls;
+
+	/**
+	\brief Maximum number of vertices per hull. See PxConvexMeshDesc::vertexLimit.
+
+	<b>Range:</b> [8, 255]<br>
+	<b>Default value:</b> 32
+	*/
+	PxU16	maxNbVerticesPerHull;
+
+	/**
+	\brief Number of voxels along the largest dimension of the mesh bounds.
+
+	Higher resolutions capture smaller concave features but make the decomposition slower.
+
+	<b>Range:</b> [8, 256]<br>
+	<b>Default value:</b> 32
+	*/
+	PxU32	voxelResolution;
+
+	/**
+	\brief Parts whose concavity is below this value are not split further.
+
+	The concavity of a part is the volume difference between its convex hull and its voxels, expressed as a fraction of the
+	volume of the convex hull of the whole mesh.
+
+	<b>Range:</b> [0, 1]<br>
+	<b>Default value:</b> 0.0025
+	*/
+	PxReal	maxConcavity;
+
+	PxConvexDecompositionParams() :
+		maxNbHulls				(16),
+		maxNbVerticesPerHull	(32),
+		voxelResolution			(32),
+		maxConcavity			(0.0025f)
+	{
+	}
+
+	/**
+	\brief Returns true if the parameters are valid.
+	*/
+	PX_INLINE bool isValid() const
+	{
+		if(maxNbHulls<1 || maxNbHulls>1024)
+			return false;
+		if(maxNbVerticesPerHull<8 || maxNbVerticesPerHull>255)
+			return false;
+		if(voxelResolution<8 || voxelResolution>256)
+			return false;
+		if(!(maxConcavity>=0.0f && maxConcavity<=1.0f))
+			return false;
+		return true;
+	}
+};
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
@@ -483,6 +627,43 @@ PX_FORCE_INLINE	physx::PxHeightField* PxCreateHeightField(const physx::PxHeightF
 	return PxCreateHeightField(desc, *PxGetStandaloneInsertionCallback());
 }
 
+/**
+\brief Cooks a heightfield from a height raster and an optional material map. The results are written to the stream.
+
+This converts the raster to heightfield samples as described in PxHeightFieldRasterDesc, then does the same as PxCookHeightField().
+
+\param[in] desc		The raster descriptor to read the HF from.
+\param[in] stream	User stream to output the cooked data.
+\return true on success
+
+\see PxHeightFieldRasterDesc PxCookHeightField() PxPhysics.createHeightField()
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCookHeightFieldFromRaster(const physx::PxHeightFieldRasterDesc& desc, physx::PxOutputStream& stream);
+
+/**
+\brief Creates a heightfield from a height raster and an optional material map, and inserts it into PxPhysics.
+
+\param[in] desc					The raster descriptor to read the HF from.
+\param[in] insertionCallback	The insertion interface from PxPhysics.
+\return PxHeightField pointer on success
+
+\see PxHeightFieldRasterDesc PxCreateHeightField() PxInsertionCallback
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	physx::PxHeightField* PxCreateHeightFieldFromRaster(const physx::PxHeightFieldRasterDesc& desc, physx::PxInsertionCallback& insertionCallback);
+
+/**
+\brief Creates a heightfield from a height raster and an optional material map. Convenience function for standalone objects.
+
+\param[in] desc	The raster descriptor to read the HF from.
+\return PxHeightField pointer on success
+
+\see PxHeightFieldRasterDesc PxCreateHeightField() PxInsertionCallback
+*/
+PX_FORCE_INLINE	physx::PxHeightField* PxCreateHeightFieldFromRaster(const physx::PxHeightFieldRasterDesc& desc)
+{
+	return PxCreateHeightFieldFromRaster(desc, *PxGetStandaloneInsertionCallback());
+}
+
 // ==== Convex meshes ====
 
 /**
@@ -545,6 +726,72 @@ PX_FORCE_INLINE	physx::PxConvexMesh* PxCreateConvexMesh(const physx::PxCookingPa
 	return PxCreateConvexMesh(params, desc, *PxGetStandaloneInsertionCallback());
 }
 
+/**
+\brief Cooks and creates a batch of convex meshes without going through a stream.
+
+This is the same as calling PxCreateConvexMesh for each descriptor, but the meshes are cooked in parallel on
+PxCookingParams::cpuDispatcher when it is set, and identical descriptors are only cooked once. Duplicates get
+the same PxConvexMesh pointer, with one reference per occurrence.
+
+\note The meshes are inserted from the calling thread, so the insertion callback doesn't need to be thread safe.
+\note Descriptors with an SDF descriptor are never deduplicated.
+
+\param[in] params				The cooking parameters
+\param[in] descs				The convex mesh descriptors to read the meshes from.
+\param[in] nbDescs				Number of descriptors.
+\param[out] meshes				Created meshes, one per descriptor. NULL for descriptors that failed to cook.
+\param[in] insertionCallback	The insertion interface from PxPhysics.
+\param[out] conditions			Optional results from convex mesh cooking, one per descriptor.
+\return Number of successfully created meshes
+
+\see PxCreateConvexMesh() PxCookingParams::cpuDispatcher PxInsertionCallback
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	physx::PxU32 PxCreateConvexMeshes(const physx::PxCookingParams& params, const physx::PxConvexMeshDesc* descs, physx::PxU32 nbDescs, physx::PxConvexMesh** meshes, physx::PxInsertionCallback& insertionCallback, physx::PxConvexMeshCookingResult::Enum* conditions=NULL);
+
+/**
+\brief Cooks and creates a batch of convex meshes without going through a stream. Convenience function for standalone objects.
+
+\see PxCreateConvexMeshes()
+*/
+PX_FORCE_INLINE	physx::PxU32 PxCreateConvexMeshes(const physx::PxCookingParams& params, const physx::PxConvexMeshDesc* descs, physx::PxU32 nbDescs, physx::PxConvexMesh** meshes)
+{
+	return PxCreateConvexMeshes(params, descs, nbDescs, meshes, *PxGetStandaloneInsertionCallback());
+}
+
+/**
+\brief Approximates a concave triangle mesh with a set of convex meshes.
+
+The mesh is voxelized and recursively split along axis-aligned planes, most concave parts first, until each part is
+convex enough (see PxConvexDecompositionParams::maxConcavity) or maxNbHulls parts have been created. A convex mesh is
+then cooked for each part. The split evaluation and the final hull cooking run on PxCookingParams::cpuDispatcher
+when it is set.
+
+The result can be used instead of a triangle mesh for dynamic actors, with one PxConvexMeshGeometry shape per hull.
+
+\note The hulls enclose the voxelized parts, so they can be up to one voxel larger than the input mesh.
+\note Closed meshes are decomposed as solids. For open meshes only the voxelized surface is decomposed.
+
+\param[in] params					The cooking parameters
+\param[in] mesh					The triangle mesh to decompose.
+\param[in] decompositionParams		The decomposition parameters.
+\param[out] hulls					Created convex meshes. Must have room for PxConvexDecompositionParams::maxNbHulls pointers.
+\param[in] insertionCallback		The insertion interface from PxPhysics.
+\return Number of convex meshes written to hulls, 0 on failure
+
+\see PxConvexDecompositionParams PxCreateConvexMeshes() PxInsertionCallback
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	physx::PxU32 PxCreateConvexDecomposition(const physx::PxCookingParams& params, const physx::PxSimpleTriangleMesh& mesh, const physx::PxConvexDecompositionParams& decompositionParams, physx::PxConvexMesh** hulls, physx::PxInsertionCallback& insertionCallback);
+
+/**
+\brief Approximates a concave triangle mesh with a set of convex meshes. Convenience function for standalone objects.
+
+\see PxCreateConvexDecomposition()
+*/
+PX_FORCE_INLINE	physx::PxU32 PxCreateConvexDecomposition(const physx::PxCookingParams& params, const physx::PxSimpleTriangleMesh& mesh, const physx::PxConvexDecompositionParams& decompositionParams, physx::PxConvexMesh** hulls)
+{
+	return PxCreateConvexDecomposition(params, mesh, decompositionParams, hulls, *PxGetStandaloneInsertionCallback());
+}
+
 /**
 \brief Verifies if the convex mesh is valid. Prints an error message for each inconsistency found.
 
@@ -660,6 +907,44 @@ PX_FORCE_INLINE	physx::PxTriangleMesh*	PxCreateTriangleMesh(const physx::PxCooki
 	return PxCreateTriangleMesh(params, desc, *PxGetStandaloneInsertionCallback());
 }
 
+/**
+\brief Saves a triangle mesh in the in-place format.
+
+The in-place format is a versioned, 16-byte aligned binary layout of the runtime mesh data, including the
+BVH34 tree. Contrary to the regular cooked format it needs no decompression or copy at load time: see
+PxCreateTriangleMeshInPlace().
+
+\note Only PxMeshMidPhase::eBVH34 meshes are supported. SDF and GPU data are not saved.
+\note The format is not endian-neutral. Save it on a platform with the same endianness as the target.
+
+\param[in] mesh	The triangle mesh to save
+\param[in] stream	User stream to output the data
+\return true on success
+
+\see PxCreateTriangleMeshInPlace()
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxSaveTriangleMeshInPlace(const physx::PxTriangleMesh& mesh, physx::PxOutputStream& stream);
+
+/**
+\brief Creates a triangle mesh that directly references data saved with PxSaveTriangleMeshInPlace().
+
+The mesh arrays are used in place, nothing is copied. This is intended for data that is already in memory,
+e.g. a memory-mapped file or an asset buffer.
+
+\note The buffer must be 16-byte aligned and remain valid and unmodified until the mesh is released.
+Releasing the mesh does not free the buffer.
+\note The buffer is written to only if the mesh vertices are modified through PxTriangleMesh::getVerticesForModification(),
+or if the BVH is refit. Read-only memory is fine otherwise.
+\note The mesh is a standalone object: it is not registered in PxPhysics.
+
+\param[in] data	The in-place data, 16-byte aligned
+\param[in] size	The size of the buffer in bytes
+\return PxTriangleMesh pointer on success, NULL if the data is invalid.
+
+\see PxSaveTriangleMeshInPlace()
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	physx::PxTriangleMesh* PxCreateTriangleMeshInPlace(void* data, physx::PxU32 size);
+
 // ==== Tetrahedron & deformable volume meshes ====
 
 /**
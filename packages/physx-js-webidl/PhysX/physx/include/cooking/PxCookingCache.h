@@ -0,0 +1,163 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_COOKING_CACHE_H
+#define PX_COOKING_CACHE_H
+
+#include "cooking/PxCooking.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxPhysics;
+class PxConvexMesh;
+
+/**
+\brief Persistent storage for the cooked streams of a PxCookingCache, e.g. files on disk.
+
+\see PxCookingCache PxCreateCookingCache
+*/
+class PxCookingCacheStorage
+{
+public:
+
+	/**
+	\brief Loads a cooked stream.
+
+	Data that cannot be deserialized (e.g. corrupt or truncated) is treated as a cache miss: the object is cooked
+	again and the fresh data is passed to store().
+
+	\param[in] key		Content hash of the cooked object
+	\param[out] stream	Stream to write the stored data to
+	\return True if data was found for this key
+	*/
+	virtual	bool	load(PxU64 key, PxOutputStream& stream) = 0;
+
+	/**
+	\brief Stores a cooked stream.
+
+	\param[in] key		Content hash of the cooked object
+	\param[in] data		Cooked data
+	\param[in] size		Size of the cooked data in bytes
+	*/
+	virtual	void	store(PxU64 key, const void* data, PxU32 size) = 0;
+
+protected:
+	virtual			~PxCookingCacheStorage()	{}
+};
+
+/**
+\brief Content-addressed cache of cooked meshes.
+
+Meshes are keyed by a 64-bit hash of the mesh descriptor's data and of the cooking parameters. When the same content
+is requested again, the existing mesh object is returned with an additional reference instead of being cooked again.
+
+Cooked streams are also kept in memory, so that objects released with releaseUnusedObjects() can be recreated
+without cooking, and optionally written to a PxCookingCacheStorage to survive process restarts.
+
+\note Descriptors with an SDF descriptor bypass the cache.
+\note The cache is thread safe.
+
+\see PxCreateCookingCache PxCookingCacheStorage
+*/
+class PxCookingCache
+{
+public:
+
+	/**
+	\brief Creates a triangle mesh, or returns the cached one for the same content.
+
+	The caller owns one reference to the returned mesh and must release it as usual.
+
+	\param[in] params		The cooking parameters
+	\param[in] desc			The triangle mesh descriptor
+	\param[out] condition	Result from the cooking, eSUCCESS for cache hits
+	\return The triangle mesh, or NULL on failure
+
+	\see PxCookTriangleMesh PxCreateTriangleMesh
+	*/
+	virtual	PxTriangleMesh*	createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxTriangleMeshCookingResult::Enum* condition = NULL) = 0;
+
+	/**
+	\brief Creates a convex mesh, or returns the cached one for the same content.
+
+	The caller owns one reference to the returned mesh and must release it as usual.
+
+	\param[in] params		The cooking parameters
+	\param[in] desc			The convex mesh descriptor
+	\param[out] condition	Result from the cooking, eSUCCESS for cache hits
+	\return The convex mesh, or NULL on failure
+
+	\see PxCookConvexMesh PxCreateConvexMesh
+	*/
+	virtual	PxConvexMesh*	createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxConvexMeshCookingResult::Enum* condition = NULL) = 0;
+
+	/**
+	\brief Returns the number of cached entries.
+	*/
+	virtual	PxU32			getNbEntries()	const = 0;
+
+	/**
+	\brief Releases the cache's reference to objects which are not referenced anywhere else.
+
+	The cooked streams are kept, so these objects are recreated without cooking when requested again.
+
+	\return Number of released objects
+	*/
+	virtual	PxU32			releaseUnusedObjects() = 0;
+
+	/**
+	\brief Releases all cached objects and streams.
+	*/
+	virtual	void			clear() = 0;
+
+	/**
+	\brief Releases the cache, and its references to the cached objects.
+	*/
+	virtual	void			release() = 0;
+
+protected:
+	virtual					~PxCookingCache()	{}
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/**
+\brief Creates a cooking cache.
+
+\param[in] physics	The physics SDK used to create the cached objects
+\param[in] storage	Optional persistent storage for the cooked streams. Must outlive the cache.
+\return The new cooking cache
+
+\see PxCookingCache PxCookingCacheStorage
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	physx::PxCookingCache* PxCreateCookingCache(physx::PxPhysics& physics, physx::PxCookingCacheStorage* storage = NULL);
+
+#endif
@@ -60,6 +60,7 @@ public:
 	/**
 	\brief	Midphase descriptors union
 
+	\note	PxMeshMidPhase::eBVH38 uses mBVH34Desc
 	\see PxBV33MidphaseDesc, PxBV34MidphaseDesc
 	*/
 	union {		
@@ -78,7 +79,7 @@ public:
 		mType = type;
 		if(type==PxMeshMidPhase::eBVH33)
 			mBVH33Desc.setToDefault();
-		else if(type==PxMeshMidPhase::eBVH34)
+		else if(type==PxMeshMidPhase::eBVH34 || type==PxMeshMidPhase::eBVH38)
 			mBVH34Desc.setToDefault();
 	}
 
@@ -90,7 +91,7 @@ public:
 	{		
 		if(mType==PxMeshMidPhase::eBVH33)
 			return mBVH33Desc.isValid();
-		else if(mType==PxMeshMidPhase::eBVH34)
+		else if(mType==PxMeshMidPhase::eBVH34 || mType==PxMeshMidPhase::eBVH38)
 			return mBVH34Desc.isValid();
 		return false;
 	}
@@ -0,0 +1,98 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_ACTIVE_ACTOR_TRACKER_H
+#define PX_ACTIVE_ACTOR_TRACKER_H
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class ActiveActorTrackerInternal;
+
+	/**
+	\brief Reasons reported for an actor in PxActiveActorRecord::flags.
+	*/
+	struct PxActiveActorFlag
+	{
+		enum Enum
+		{
+			eMOVED			= (1<<0),	//!< The actor is in PxScene::getActiveActors(), i.e. its pose has been updated
+			eWOKE			= (1<<1),	//!< The actor was not awake at the previous update() call
+			eFELL_ASLEEP	= (1<<2)	//!< The actor was awake at the previous update() call and is now asleep (or no longer active)
+		};
+	};
+
+	/**
+	\brief Active actor entry, as returned by PxActiveActorTracker.
+
+	The layout is 2 x 32-bit words (8 bytes) without padding.
+	*/
+	struct PxActiveActorRecord
+	{
+		PxU32	userIndex;	//!< Index stored in the actor's userData
+		PxU32	flags;		//!< Combination of PxActiveActorFlag values
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(PxActiveActorRecord) == 8);
+
+	/**
+	\brief Compact active actor list.
+
+	PxScene::getActiveActors() returns actor pointers, which callers then have to dereference one by one. This class
+	turns that list into an array of user indices, each tagged with the reason the actor is reported: it moved, it
+	woke up since the previous call, or it fell asleep. Actors that fell asleep are reported exactly once.
+
+	The scene must have PxSceneFlag::eENABLE_ACTIVE_ACTORS set. The user index of each actor is read from
+	PxActor::userData, which must then contain a small integer index rather than a pointer:
+	userData = reinterpret_cast<void*>(size_t(index)). Per-index state is kept in an array, so indices should be dense.
+	*/
+	class PxActiveActorTracker
+	{
+		public:
+							PxActiveActorTracker(PxScene& scene);
+							~PxActiveActorTracker();
+
+			/**
+			\brief Computes the records for the last simulation step. Call this after fetchResults().
+
+			\param[out] nbRecords	number of returned records
+			\return Records, valid until the next update() call
+			*/
+			const PxActiveActorRecord*	update(PxU32& nbRecords);
+
+		private:
+			ActiveActorTrackerInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
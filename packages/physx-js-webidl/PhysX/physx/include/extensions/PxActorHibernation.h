@@ -0,0 +1,179 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_ACTOR_HIBERNATION_H
+#define PX_ACTOR_HIBERNATION_H
+
+#include "foundation/PxBounds3.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class PxRigidDynamic;
+	class ActorHibernationInternal;
+
+	/**
+	\brief Parameters of PxActorHibernation.
+	*/
+	struct PxActorHibernationParams
+	{
+		PxActorHibernationParams() :
+			hibernationDelay		(60.0f),
+			wakeMargin				(1.0f),
+			cellSize				(4.0f),
+			maxChecksPerUpdate		(4096)
+		{
+		}
+
+		/**
+		\brief Time an actor must have been asleep before it is hibernated, in the time unit passed to update().
+		*/
+		PxReal	hibernationDelay;
+
+		/**
+		\brief Distance at which an awake body or a query bounds rehydrates hibernated actors.
+
+		The margin must cover the distance an awake body can travel between two calls to update().
+		*/
+		PxReal	wakeMargin;
+
+		/**
+		\brief Size of the cells of the hash grid indexing hibernated actors. Roughly the size of a typical actor's neighborhood.
+		*/
+		PxReal	cellSize;
+
+		/**
+		\brief Number of registered actors checked for hibernation per update(), in a round-robin fashion. Bounds the cost of update() in large worlds.
+		*/
+		PxU32	maxChecksPerUpdate;
+
+		/**
+		\brief Returns true if the parameters are valid.
+		*/
+		bool	isValid()	const
+		{
+			return hibernationDelay >= 0.0f && wakeMargin >= 0.0f && cellSize > 0.0f && maxChecksPerUpdate > 0;
+		}
+	};
+
+	/**
+	\brief Evicts long-sleeping rigid bodies from a scene, and puts them back when something approaches.
+
+	Worlds with many props that sleep most of the time still pay for them in the scene: each one keeps a body sim,
+	shape sims, broadphase entries, island nodes and scene query pruner entries. Actors registered with this class are
+	removed from the scene once they have been asleep for PxActorHibernationParams::hibernationDelay. Only their bounds
+	are kept, in a hash grid. They are added back to the scene (still asleep) when:
+
+	- the bounds of an awake dynamic body, inflated by PxActorHibernationParams::wakeMargin, touch them during update()
+	- rehydrate() is called with bounds touching them, e.g. the bounds of a scene query about to be run
+
+	The actor objects themselves are kept, so user pointers stay valid, and pose, mass, shapes and user data are preserved.
+
+	Actors that are kinematic, in an aggregate or attached to joints are never hibernated. Awake bodies are found with
+	PxScene::getActiveActors() when PxSceneFlag::eENABLE_ACTIVE_ACTORS is set, and by scanning the scene's rigid dynamics
+	otherwise, which is much slower in large scenes.
+
+	All functions must be called while the scene is not simulating. Registered actors must be removed from the
+	hibernation before they are released.
+	*/
+	class PxActorHibernation
+	{
+		public:
+										PxActorHibernation(PxScene& scene, const PxActorHibernationParams& params = PxActorHibernationParams());
+
+		/**
+		\brief Destructor. Hibernated actors are added back to the scene.
+		*/
+										~PxActorHibernation();
+
+		/**
+		\brief Registers an actor for hibernation. The actor must be in the scene.
+
+		\param[in] actor	Actor to register
+		\return False if the actor is already registered or is not in the scene
+		*/
+				bool					addActor(PxRigidDynamic& actor);
+
+		/**
+		\brief Unregisters an actor. If it is hibernated, it is added back to the scene first.
+
+		\param[in] actor	Actor to unregister
+		\return False if the actor was not registered
+		*/
+				bool					removeActor(PxRigidDynamic& actor);
+
+		/**
+		\brief Returns true if the actor is currently hibernated, i.e. registered and removed from the scene.
+		*/
+				bool					isHibernated(const PxRigidDynamic& actor)	const;
+
+		/**
+		\brief Updates the hibernation. Call once per frame after PxScene::fetchResults().
+
+		Hibernated actors touched by awake bodies are added back to the scene first, then up to maxChecksPerUpdate
+		registered actors are checked and hibernated if they have been asleep long enough.
+
+		\param[in] dt	Time elapsed since the last update
+		*/
+				void					update(PxReal dt);
+
+		/**
+		\brief Adds hibernated actors touching some bounds back to the scene.
+
+		\param[in] bounds	World bounds, e.g. of a scene query or of a body teleported into the area
+		\return Number of rehydrated actors
+		*/
+				PxU32					rehydrate(const PxBounds3& bounds);
+
+		/**
+		\brief Adds all hibernated actors back to the scene. They are hibernated again by later updates.
+
+		\return Number of rehydrated actors
+		*/
+				PxU32					rehydrateAll();
+
+		/**
+		\brief Returns the number of registered actors.
+		*/
+				PxU32					getNbActors()		const;
+
+		/**
+		\brief Returns the number of hibernated actors.
+		*/
+				PxU32					getNbHibernated()	const;
+
+		private:
+				ActorHibernationInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,118 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_ALLOCATION_TRACKER_H
+#define PX_ALLOCATION_TRACKER_H
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class AllocationTrackerInternal;
+
+	/**
+	\brief Subsystems used to bucket allocations in PxAllocationTracker.
+	*/
+	struct PxAllocationSubsystem
+	{
+		enum Enum
+		{
+			eFOUNDATION,		//!< Foundation library
+			eAPI,				//!< PxPhysics / PxScene objects and buffers
+			eSIMULATION,		//!< Simulation controller (islands, interactions, shapes and bodies)
+			eBROADPHASE,		//!< Broadphase and AABB manager
+			eSCENE_QUERY,		//!< Scene query pruners
+			eNARROWPHASE,		//!< Narrowphase contexts, caches and contact streams
+			eSOLVER,			//!< Constraint solver and articulations
+			eGEOMETRY,			//!< Meshes, heightfields and geometry utilities
+			eCOOKING,			//!< Cooking library
+			eCHARACTER,			//!< Character controllers
+			eVEHICLE,			//!< Vehicles
+			eEXTENSIONS,		//!< Extensions library
+			eGPU,				//!< GPU simulation host-side allocations
+			eOTHER,				//!< Allocations without a known source file, e.g. made by the user
+
+			eCOUNT
+		};
+	};
+
+	/**
+	\brief Per-subsystem allocation statistics.
+	*/
+	struct PxAllocationStats
+	{
+		PxU64	liveBytes;			//!< Bytes currently allocated
+		PxU64	peakBytes;			//!< Highest liveBytes value since the tracker was created, or since the last resetPeaks() call
+		PxU64	nbLiveAllocations;	//!< Number of allocations currently alive
+		PxU64	nbAllocations;		//!< Total number of allocations since the tracker was created. Sample it to compute an allocation rate.
+	};
+
+	/**
+	\brief Tracks the SDK's memory usage per subsystem.
+
+	The tracker registers itself as a PxAllocationListener on the foundation, and buckets each allocation by the
+	source directory of the file that made it. Only allocations made while the tracker exists are accounted for.
+
+	Tracking costs a hash map insertion and a mutex lock per allocation, so it is meant for diagnostics builds or
+	sessions rather than always-on use.
+
+	\see PxAllocationListener PxFoundation::registerAllocationListener
+	*/
+	class PxAllocationTracker
+	{
+		public:
+							PxAllocationTracker();
+							~PxAllocationTracker();
+
+			/**
+			\brief Retrieves the current statistics.
+
+			\param[out] stats	array of PxAllocationSubsystem::eCOUNT entries, indexed by PxAllocationSubsystem
+			*/
+			void			getStats(PxAllocationStats* stats)	const;
+
+			/**
+			\brief Resets the peak values to the current live values.
+			*/
+			void			resetPeaks();
+
+			/**
+			\brief Returns the name of a subsystem, for reporting.
+			*/
+			static	const char*	getSubsystemName(PxAllocationSubsystem::Enum subsystem);
+
+		private:
+			AllocationTrackerInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,146 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_ALLOCATION_TRIPWIRE_H
+#define PX_ALLOCATION_TRIPWIRE_H
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class AllocationTripwireInternal;
+
+	/**
+	\brief A call site that made heap allocations while a PxAllocationTripwire was armed.
+	*/
+	struct PxAllocationTripwireSite
+	{
+		const char*	tag;			//!< Tag of the armed scope, as passed to PxAllocationTripwire::arm()
+		const char*	typeName;		//!< Type name passed to the allocator
+		const char*	file;			//!< Source file of the allocation
+		int			line;			//!< Source line of the allocation
+		PxU32		nbAllocations;	//!< Number of allocations made from this site
+		PxU64		nbBytes;		//!< Total number of bytes allocated from this site
+	};
+
+	/**
+	\brief Debug tool reporting heap allocations made inside frames that should not allocate.
+
+	Steady-state simulation steps and scene queries are expected to run without heap allocations once internal buffers
+	have grown to their working size. The tripwire registers itself as a PxAllocationListener on the foundation and
+	records every allocation made while it is armed, bucketed by call site (tag of the armed scope, file, line and type
+	name). The first few armed scopes are ignored to let buffers warm up.
+
+	Arm it around the code to audit, e.g. simulate() to fetchResults(), or a batch of scene queries. Allocations made by
+	any thread while the tripwire is armed are recorded, including SDK worker threads.
+
+	When a new call site is found, a PxErrorCode::ePERF_WARNING is sent to the error callback from disarm().
+
+	\note Call sites are identified by the pointers passed to the allocator, which are expected to be string literals.
+	At most 256 sites are recorded.
+	\note Reporting costs a mutex lock per allocation while armed, and nothing otherwise.
+
+	\see PxAllocationTripwireScope PxAllocationTracker PxFoundation::registerAllocationListener
+	*/
+	class PxAllocationTripwire
+	{
+		public:
+			/**
+			\param[in] nbWarmupScopes	Number of armed scopes to ignore before allocations get reported
+			*/
+							PxAllocationTripwire(PxU32 nbWarmupScopes = 8);
+							~PxAllocationTripwire();
+
+			/**
+			\brief Starts recording allocations.
+
+			\param[in] tag	Name of the audited scope, e.g. "simulate". Must remain valid while the tripwire exists.
+			*/
+			void			arm(const char* tag);
+
+			/**
+			\brief Stops recording allocations, and reports new call sites to the error callback.
+			*/
+			void			disarm();
+
+			/**
+			\brief Returns the number of recorded call sites.
+			*/
+			PxU32			getNbSites()	const;
+
+			/**
+			\brief Retrieves the recorded call sites.
+
+			\param[out] userBuffer	buffer receiving the sites
+			\param[in] bufferSize	number of entries in userBuffer
+			\param[in] startIndex	index of the first site to retrieve
+			\return number of sites written to userBuffer
+			*/
+			PxU32			getSites(PxAllocationTripwireSite* userBuffer, PxU32 bufferSize, PxU32 startIndex = 0)	const;
+
+			/**
+			\brief Forgets recorded sites and restarts the warm-up period.
+			*/
+			void			reset();
+
+			/**
+			\brief Enables or disables error callback reports. Enabled by default.
+			*/
+			void			setReportErrors(bool reportErrors);
+
+		private:
+			AllocationTripwireInternal*	mImpl;
+	};
+
+	/**
+	\brief Arms a PxAllocationTripwire for the lifetime of the object.
+	*/
+	class PxAllocationTripwireScope
+	{
+		public:
+			PX_INLINE	PxAllocationTripwireScope(PxAllocationTripwire* tripwire, const char* tag) : mTripwire(tripwire)
+						{
+							if(mTripwire)
+								mTripwire->arm(tag);
+						}
+
+			PX_INLINE	~PxAllocationTripwireScope()
+						{
+							if(mTripwire)
+								mTripwire->disarm();
+						}
+		private:
+			PxAllocationTripwire*	mTripwire;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
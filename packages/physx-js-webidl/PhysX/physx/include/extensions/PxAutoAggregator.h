@@ -0,0 +1,161 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_AUTO_AGGREGATOR_H
+#define PX_AUTO_AGGREGATOR_H
+
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class PxRigidActor;
+	class PxShape;
+	class AutoAggregatorInternal;
+
+	/**
+	\brief Parameters of PxAutoAggregator.
+	*/
+	struct PxAutoAggregatorParams
+	{
+		PxAutoAggregatorParams() :
+			shapeThreshold		(16),
+			staticCellSize		(0.0f),
+			maxStaticsPerCell	(64),
+			shapeSlack			(0.5f),
+			buildBVH			(true)
+		{
+		}
+
+		/**
+		\brief Actors with at least this many shapes are put in their own aggregate.
+		*/
+		PxU32	shapeThreshold;
+
+		/**
+		\brief Size of the grid cells used to cluster static actors. Static actors whose bounds centers fall in the same
+		cell share an aggregate, whatever their shape count. Zero disables clustering, statics are then handled like
+		dynamic actors.
+		*/
+		PxReal	staticCellSize;
+
+		/**
+		\brief Maximum number of static actors in a cell aggregate. Additional statics of a full cell are added to the scene directly.
+		*/
+		PxU32	maxStaticsPerCell;
+
+		/**
+		\brief Aggregates are created with room for this fraction of additional shapes, so that attaching a few shapes
+		doesn't rebuild them.
+		*/
+		PxReal	shapeSlack;
+
+		/**
+		\brief Builds a PxBVH of the shapes of actors having at least shapeThreshold shapes when they are added to an
+		aggregate, so that scene queries only store one bound per actor.
+		*/
+		bool	buildBVH;
+
+		/**
+		\brief Returns true if the parameters are valid.
+		*/
+		bool	isValid()	const
+		{
+			return shapeThreshold > 0 && staticCellSize >= 0.0f && maxStaticsPerCell > 0 && shapeSlack >= 0.0f;
+		}
+	};
+
+	/**
+	\brief Puts actors with many shapes and clusters of static actors into aggregates automatically.
+
+	Without aggregates, each shape of an actor is a separate broadphase entry. Actors added through this class are put
+	in an aggregate when they have at least PxAutoAggregatorParams::shapeThreshold shapes, so that the broadphase only
+	sees one bound for them. With PxAutoAggregatorParams::staticCellSize, static actors are also grouped per grid cell
+	into static aggregates, which the broadphase never tests against each other.
+
+	Shapes must be attached through attachShape() to actors managed by this class. When an aggregate is out of room,
+	it is rebuilt with a larger capacity: it is removed from the scene and added back with all its actors.
+
+	All functions must be called while the scene is not simulating. Managed actors must be removed with removeActor()
+	before they are released. The destructor releases the aggregates, which puts their actors back in the scene
+	without aggregates.
+	*/
+	class PxAutoAggregator
+	{
+		public:
+										PxAutoAggregator(PxScene& scene, const PxAutoAggregatorParams& params = PxAutoAggregatorParams());
+										~PxAutoAggregator();
+
+		/**
+		\brief Adds an actor to the scene, in an aggregate if the policy asks for it.
+
+		The actor can already be in the scene, in which case it is moved into an aggregate if needed. Actors that
+		already belong to an aggregate are left untouched.
+
+		\param[in] actor	Rigid static or rigid dynamic actor
+		\return False if the actor couldn't be added to the scene
+		*/
+				bool					addActor(PxRigidActor& actor);
+
+		/**
+		\brief Removes an actor from its managed aggregate, if any, and from the scene.
+
+		\param[in] actor		Actor to remove
+		\param[in] wakeOnLostTouch	Passed to PxScene::removeActor()
+		*/
+				void					removeActor(PxRigidActor& actor, bool wakeOnLostTouch = true);
+
+		/**
+		\brief Attaches a shape to an actor, growing or creating its aggregate if needed.
+
+		\param[in] actor	Actor previously passed to addActor()
+		\param[in] shape	Shape to attach
+		\return Result of PxRigidActor::attachShape()
+		*/
+				bool					attachShape(PxRigidActor& actor, PxShape& shape);
+
+		/**
+		\brief Returns the number of aggregates created by this class.
+		*/
+				PxU32					getNbAggregates()	const;
+
+		/**
+		\brief Returns the number of actors in the aggregates created by this class.
+		*/
+				PxU32					getNbAggregatedActors()	const;
+
+		private:
+				AutoAggregatorInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -36,6 +36,7 @@
 namespace physx
 {
 class PxBounds3;
+class PxScene;
 #endif
 
 class PxBroadPhaseExt
@@ -61,6 +62,56 @@ public:
 	\see PxSceneDesc PxBroadPhaseType
 	*/
 	static	PxU32	createRegionsFromWorldBounds(PxBounds3* regions, const PxBounds3& globalBounds, PxU32 nbSubdiv, PxU32 upAxis=1);
+
+	/**
+	\brief Creates regions for PxBroadPhaseType::eMBP, from the distribution of a set of objects.
+
+	Contrary to createRegionsFromWorldBounds(), the global box is not subdivided into a uniform grid. Instead the region
+	containing the largest number of objects is recursively split at the median object center, along the non-up axis with
+	the largest spread, until each region contains at most maxObjectsPerRegion objects or maxNbRegions regions have been
+	created. Dense areas (e.g. player clusters in a large open world) thus end up covered by small regions while empty areas
+	are covered by a few large ones.
+
+	The returned regions do not overlap and together cover the global box. Like createRegionsFromWorldBounds(), the function
+	does not subdivide along the given up axis.
+
+	\param[out]	regions				Regions computed from the input objects. Must be large enough to hold maxNbRegions boxes.
+	\param[in]	maxNbRegions		Maximum number of regions to create. The MBP broadphase supports at most 256 regions.
+	\param[in]	globalBounds		World-space box covering the game world
+	\param[in]	objectBounds		World-space bounds of the objects
+	\param[in]	nbObjects			Number of objects in the objectBounds array
+	\param[in]	maxObjectsPerRegion	Target number of objects per region. Regions containing fewer objects are not split further.
+	\param[in]	upAxis				Up axis (0 for X, 1 for Y, 2 for Z).
+	\return		number of regions written out to the 'regions' array
+
+	\see createRegionsFromWorldBounds rebalanceRegions
+	*/
+	static	PxU32	createRegionsFromObjectBounds(PxBounds3* regions, PxU32 maxNbRegions, const PxBounds3& globalBounds, const PxBounds3* objectBounds, PxU32 nbObjects, PxU32 maxObjectsPerRegion, PxU32 upAxis=1);
+
+	/**
+	\brief Rebuilds the broadphase regions of a scene from the current distribution of its rigid actors.
+
+	New regions are computed with createRegionsFromObjectBounds(), from the world bounds of the scene's rigid static and
+	rigid dynamic actors. They cover the union of these bounds, enlarged by the given margin, and are unbounded along the up
+	axis. The new regions are added to
+	the scene (with populateRegion enabled) before the previous ones are removed, so that objects migrate from one region
+	to another through the broadphase's own region bookkeeping, without being removed from and re-inserted into the scene,
+	and without temporarily going out-of-bounds. If the old and new regions do not fit together within the broadphase's
+	region limit, the old regions are removed first.
+
+	This is meant to be called once in a while (e.g. every few seconds, or when players teleport) for large open worlds
+	using PxBroadPhaseType::eMBP, instead of manually setting up the regions. It cannot be called while the simulation is running.
+
+	\param[in]	scene				Scene using PxBroadPhaseType::eMBP
+	\param[in]	maxNbRegions		Maximum number of regions to create (at most 256)
+	\param[in]	maxObjectsPerRegion	Target number of objects per region
+	\param[in]	upAxis				Up axis (0 for X, 1 for Y, 2 for Z).
+	\param[in]	margin				Distance by which the regions extend beyond the current actors' bounds
+	\return		number of regions now used by the scene, or 0 if the scene does not use MBP or has no actors
+
+	\see createRegionsFromObjectBounds PxScene::addBroadPhaseRegion PxScene::removeBroadPhaseRegion
+	*/
+	static	PxU32	rebalanceRegions(PxScene& scene, PxU32 maxNbRegions, PxU32 maxObjectsPerRegion, PxU32 upAxis=1, PxReal margin=0.0f);
 };
 
 #if !PX_DOXYGEN
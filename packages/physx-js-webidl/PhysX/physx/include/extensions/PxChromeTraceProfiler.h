@@ -0,0 +1,111 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_CHROME_TRACE_PROFILER_H
+#define PX_CHROME_TRACE_PROFILER_H
+
+#include "foundation/PxProfiler.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxOutputStream;
+
+/**
+\brief Profiler callback recording events in memory and exporting them in the Chrome trace event JSON format.
+
+The exported files can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing. Events are exported as follows:
+- thread-local zones become duration events on the thread that recorded them
+- cross-thread zones (detached) become async events, paired by name and context
+- PxProfilerCallback::recordData() values become counters
+- PxProfilerCallback::recordFrame() markers become global instant events
+
+The SDK does not call recordFrame() itself: call it once per frame from the application, e.g. after fetchResults().
+Frame markers are also used by the ring-buffer mode: when a maximum number of frames is given, only the events of the
+last frames are kept, in fixed memory once the buffers have grown to fit a frame. This allows keeping the profiler
+enabled on a production server and dumping the trace of a frame right after it spiked.
+
+Each thread records into its own buffers, so recording does not take locks except when a buffer is full.
+
+\see PxChromeTraceProfilerCreate()
+*/
+class PxChromeTraceProfiler : public PxProfilerCallback
+{
+public:
+
+	/**
+	\brief Deletes the profiler.
+
+	Do not keep a reference to the deleted instance.
+	*/
+	virtual void release() = 0;
+
+	/**
+	\brief Writes the recorded events to a stream, as a complete Chrome trace JSON document.
+
+	In ring-buffer mode only the events of the last frames are written. Recorded events are not removed.
+
+	This call is not thread safe, so it should only be called during a sync point or when all threads have yielded.
+
+	\param[in] stream	Output stream
+	\return True if all data could be written
+	*/
+	virtual bool writeTrace(PxOutputStream& stream) = 0;
+
+	/**
+	\brief Removes all recorded events. One buffer per thread is kept for reuse.
+
+	Combined with writeTrace() this allows streaming traces in pieces, e.g. one file per second.
+	This call is not thread safe, see writeTrace().
+	*/
+	virtual void clear() = 0;
+
+	/**
+	\brief Returns the number of recordFrame() calls since the profiler was created.
+	*/
+	virtual PxU32 getFrameIndex() const = 0;
+
+protected:
+	virtual ~PxChromeTraceProfiler() {}
+};
+
+/**
+\brief Creates a Chrome trace profiler.
+
+\param[in] maxNbFrames			Number of complete frames to keep (ring-buffer mode), in addition to the frame being recorded.
+								Zero keeps all events until clear() is called.
+\param[in] nbEventsPerBuffer	Number of events per buffer. Buffers are allocated per thread as needed.
+\return The new profiler, to register with PxFoundation or PxCreatePhysics as profiler callback
+*/
+PxChromeTraceProfiler* PxChromeTraceProfilerCreate(PxU32 maxNbFrames = 0, PxU32 nbEventsPerBuffer = 4096);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
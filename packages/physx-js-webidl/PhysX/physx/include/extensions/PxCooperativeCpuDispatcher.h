@@ -0,0 +1,103 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_COOPERATIVE_CPU_DISPATCHER_H
+#define PX_COOPERATIVE_CPU_DISPATCHER_H
+
+#include "common/PxPhysXCommonConfig.h"
+#include "task/PxCpuDispatcher.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief A CPU dispatcher that queues tasks and runs them in time-sliced chunks, on the thread of the user's choice.
+
+This is meant for single-threaded hosts (e.g. WebAssembly builds without threads) where a blocking simulate() call
+would stall an event loop. With a 0-thread PxDefaultCpuDispatcher, tasks run inline and simulate() only returns once
+the whole step is done. With this dispatcher, simulate() returns after queuing the first tasks, and the step is then
+advanced by calling runSlice() until it returns false:
+
+\code
+	scene->simulate(dt);
+	// ... on each event loop iteration:
+	if(!dispatcher->runSlice(2000))
+		scene->fetchResults(true);
+\endcode
+
+The dispatcher reports zero worker threads, so that the SDK uses its single-threaded code paths, in which no task
+waits for another one.
+
+\note Tasks are not interrupted: a slice ends after the first task that exceeds the budget, so long tasks can overrun it.
+\note A blocking fetchResults() call made before the queue is drained never returns, since nothing else runs the tasks.
+\note The dispatcher is not thread-safe. Tasks must be submitted from the thread that calls runSlice().
+
+\see PxCooperativeCpuDispatcherCreate() PxCpuDispatcher
+*/
+class PxCooperativeCpuDispatcher : public PxCpuDispatcher
+{
+public:
+
+	/**
+	\brief Deletes the dispatcher.
+
+	Do not keep a reference to the deleted instance.
+
+	\see PxCooperativeCpuDispatcherCreate()
+	*/
+	virtual void release() = 0;
+
+	/**
+	\brief Runs queued tasks until the time budget is spent or the queue is empty.
+
+	Tasks submitted by the tasks that run are queued and processed within the same slice if time permits.
+	At least one task is run per call, when the queue is not empty.
+
+	\param[in] budgetMicroseconds time budget of the slice, in microseconds
+	\return True if tasks remain in the queue.
+	*/
+	virtual bool runSlice(PxU32 budgetMicroseconds) = 0;
+
+	/**
+	\brief Returns the number of queued tasks.
+	*/
+	virtual PxU32 getNbPendingTasks() const = 0;
+};
+
+/**
+\brief Create a cooperative dispatcher, extensions SDK needs to be initialized first.
+
+\see PxCooperativeCpuDispatcher
+*/
+PxCooperativeCpuDispatcher* PxCooperativeCpuDispatcherCreate();
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
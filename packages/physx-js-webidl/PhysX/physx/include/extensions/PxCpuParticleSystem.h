@@ -0,0 +1,217 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_CPU_PARTICLE_SYSTEM_H
+#define PX_CPU_PARTICLE_SYSTEM_H
+
+#include "foundation/PxBounds3.h"
+#include "PxQueryFiltering.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class PxCpuDispatcher;
+	class CpuParticleSystemInternal;
+
+	/**
+	\brief Parameters of PxCpuParticleSystem.
+	*/
+	struct PxCpuParticleSystemParams
+	{
+		PxCpuParticleSystemParams() :
+			maxParticles	(4096),
+			radius			(0.05f),
+			restitution		(0.3f),
+			friction		(0.5f),
+			damping			(0.0f),
+			lifetime		(0.0f),
+			sleepSpeed		(0.1f),
+			filterData		(PxQueryFlag::eSTATIC)
+		{
+		}
+
+		/**
+		\brief Maximum number of particles. Adding particles beyond this count fails.
+		*/
+		PxU32				maxParticles;
+
+		/**
+		\brief Radius of the particle spheres.
+		*/
+		PxReal				radius;
+
+		/**
+		\brief Fraction of the normal speed kept when a particle bounces, in [0, 1].
+		*/
+		PxReal				restitution;
+
+		/**
+		\brief Fraction of the tangential speed removed when a particle bounces, in [0, 1].
+		*/
+		PxReal				friction;
+
+		/**
+		\brief Linear damping, i.e. fraction of the velocity removed per second.
+		*/
+		PxReal				damping;
+
+		/**
+		\brief Time after which particles are removed, in the time unit passed to simulate(). Zero for no limit.
+		*/
+		PxReal				lifetime;
+
+		/**
+		\brief Particles slower than this after a collision are put to sleep and not moved anymore.
+		*/
+		PxReal				sleepSpeed;
+
+		/**
+		\brief Filter data of the sweeps against the scene. Only static geometry by default.
+
+		Including dynamic actors works, but particles don't push them and sleeping particles are not woken up when
+		these actors move.
+		*/
+		PxQueryFilterData	filterData;
+
+		/**
+		\brief Returns true if the parameters are valid.
+		*/
+		bool	isValid()	const
+		{
+			return maxParticles > 0 && radius > 0.0f && restitution >= 0.0f && restitution <= 1.0f
+				&& friction >= 0.0f && friction <= 1.0f && damping >= 0.0f && lifetime >= 0.0f && sleepSpeed >= 0.0f;
+		}
+	};
+
+	/**
+	\brief Position-based sphere particles simulated on the CPU, for debris, sparks or item drops.
+
+	PxPBDParticleSystem needs CUDA. This class is a lightweight alternative: each particle is a sphere of
+	PxCpuParticleSystemParams::radius, moved under the scene's gravity and swept against the scene's static geometry
+	(including heightfields and triangle meshes) through the scene query system. On impact, the particle is moved to the
+	contact and its velocity is reflected with restitution and friction. Particles don't collide with each other and
+	don't affect the scene.
+
+	Particle data is stored as separate arrays (structure of arrays), and particles are stepped in parallel on the
+	threads of the dispatcher passed to simulate(). Positions are exported as a flat array of x,y,z floats, e.g. for
+	an instanced draw call.
+
+	Particles are identified by their index in the arrays. Removing a particle, either explicitly or when its lifetime
+	expires, moves the last particle into its slot.
+
+	simulate() runs scene queries, so it must be called while the scene is not simulating, or at least not while the
+	scene query system is being updated.
+	*/
+	class PxCpuParticleSystem
+	{
+		public:
+										PxCpuParticleSystem(PxScene& scene, const PxCpuParticleSystemParams& params = PxCpuParticleSystemParams());
+										~PxCpuParticleSystem();
+
+		/**
+		\brief Adds particles.
+
+		\param[in] positions	Initial positions
+		\param[in] velocities	Initial velocities, or NULL for particles at rest
+		\param[in] nb			Number of particles to add
+		\return Number of particles actually added, which is smaller than nb when PxCpuParticleSystemParams::maxParticles is reached
+		*/
+				PxU32					addParticles(const PxVec3* positions, const PxVec3* velocities, PxU32 nb);
+
+		/**
+		\brief Removes a particle. The last particle is moved into its slot.
+
+		\param[in] index	Index of the particle to remove
+		*/
+				void					removeParticle(PxU32 index);
+
+		/**
+		\brief Removes all particles.
+		*/
+				void					clear();
+
+		/**
+		\brief Wakes up the sleeping particles touching some bounds, e.g. after the static geometry below them has been removed.
+
+		\param[in] bounds	World bounds
+		\return Number of particles woken up
+		*/
+				PxU32					wakeParticles(const PxBounds3& bounds);
+
+		/**
+		\brief Advances the particles by one step. Expired particles are removed afterwards.
+
+		\param[in] dt			Time step
+		\param[in] dispatcher	Dispatcher used to step the particles in parallel, or NULL to step them on the calling thread
+		*/
+				void					simulate(PxReal dt, PxCpuDispatcher* dispatcher = NULL);
+
+		/**
+		\brief Returns the number of particles.
+		*/
+				PxU32					getNbParticles()	const;
+
+		/**
+		\brief Returns the number of sleeping particles.
+		*/
+				PxU32					getNbSleeping()		const;
+
+		/**
+		\brief Returns the particle positions, getNbParticles() tightly packed x,y,z floats.
+
+		The pointer is invalidated by addParticles().
+		*/
+				const PxVec3*			getPositions()		const;
+
+		/**
+		\brief Returns the particle velocities, getNbParticles() tightly packed x,y,z floats.
+
+		The pointer is invalidated by addParticles().
+		*/
+				const PxVec3*			getVelocities()		const;
+
+		/**
+		\brief Returns the particle ages, i.e. the time since each particle was added.
+		*/
+				const PxReal*			getAges()			const;
+
+		/**
+		\brief Returns the parameters.
+		*/
+				const PxCpuParticleSystemParams&	getParams()	const;
+
+		private:
+				CpuParticleSystemInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
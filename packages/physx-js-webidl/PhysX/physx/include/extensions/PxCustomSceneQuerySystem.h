@@ -36,6 +36,35 @@ namespace physx
 {
 #endif
 
+	/**
+	\brief Traversal counters for one type of scene query against one pruner.
+
+	\see PxPrunerQueryStats PxCustomSceneQuerySystem::getQueryStats
+	*/
+	struct PxPrunerQueryCounters
+	{
+		PxU32	nbQueries;			//!< Number of queries that reached the pruner (i.e. that passed the per-pruner filtering)
+		PxU32	nbNodes;			//!< Number of tree nodes whose bounds were tested against the query volume
+		PxU32	nbLeaves;			//!< Number of leaf nodes reached by the traversals
+		PxU32	nbPrimitives;		//!< Number of primitives contained in the reached leaf nodes
+		PxU32	nbNarrowPhaseTests;	//!< Number of exact shape-level tests performed on the primitives reported by the pruner
+		PxU32	nbEarlyOuts;		//!< Number of queries that were stopped in this pruner, e.g. by an any-hit query or a user callback
+	};
+
+	/**
+	\brief Per-pruner query statistics.
+
+	Culling queries are reported in the overlaps counters. Queries against the compound pruner are not included.
+
+	\see PxPrunerQueryCounters PxCustomSceneQuerySystem::getQueryStats
+	*/
+	struct PxPrunerQueryStats
+	{
+		PxPrunerQueryCounters	raycasts;
+		PxPrunerQueryCounters	overlaps;
+		PxPrunerQueryCounters	sweeps;
+	};
+
 	/**
 	\brief A custom scene query system.
 
@@ -116,6 +145,49 @@ namespace physx
 		\see startCustomBuildstep customBuildstep
 		*/
 		virtual	void	finishCustomBuildstep()	= 0;
+
+		/**
+		\brief Enables or disables per-pruner query statistics.
+
+		When enabled, each query accumulates its traversal counters into the stats of the pruners it visits. This has a
+		small cost per visited node, so it is disabled by default. Node, leaf and primitive counts are only gathered by
+		AABB-tree based pruners.
+
+		The counters are never reset automatically: call resetQueryStats() once per frame to get per-frame numbers.
+
+		\param[in] enabled		True to gather query statistics
+
+		\see getQueryStats resetQueryStats
+		*/
+		virtual	void	setQueryStatsEnabled(bool enabled)	= 0;
+
+		/**
+		\brief Returns whether per-pruner query statistics are enabled.
+
+		\see setQueryStatsEnabled
+		*/
+		virtual	bool	getQueryStatsEnabled()	const	= 0;
+
+		/**
+		\brief Retrieves the query statistics accumulated by a given pruner since the last resetQueryStats() call.
+
+		\param[in] prunerIndex	Pruner index, as returned by addPruner()
+		\param[out] stats		The pruner's query statistics
+
+		\return	False if the pruner index is invalid
+
+		\see setQueryStatsEnabled resetQueryStats
+		*/
+		virtual	bool	getQueryStats(PxU32 prunerIndex, PxPrunerQueryStats& stats)	const	= 0;
+
+		/**
+		\brief Resets the query statistics of all pruners.
+
+		This should not be called while queries are running.
+
+		\see setQueryStatsEnabled getQueryStats
+		*/
+		virtual	void	resetQueryStats()	= 0;
 	};
 
 	/**
@@ -154,7 +226,7 @@ namespace physx
 		This will be called for each query to validate whether it should process a given pruner.
 
 		\param[in] prunerIndex	The index of currently processed pruner
-		\param[in] context		The query context
+		\param[in] context		The query context, i.e. the hit callback of the query. This is NULL for PxSceneQuerySystemBase::overlapSpheres().
 		\param[in] filterData	The query's filter data
 		\param[in] filterCall	The query's filter callback
 
@@ -0,0 +1,110 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_DEFAULT_CONTACT_MODIFY_CALLBACK_H
+#define PX_DEFAULT_CONTACT_MODIFY_CALLBACK_H
+
+#include "PxContactModifyCallback.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxMaterial;
+	class PxShape;
+	class DefaultContactModifyCallbackInternal;
+
+	/**
+	\brief Data-driven contact modification callback.
+
+	Implements common contact modifications from lookup tables, without user code:
+	- material pair overrides: friction and restitution used when two given materials touch
+	- one-way shapes: contacts are only kept if their normal, pointing away from the one-way shape, is within a cone
+	  around a direction given in the shape's local space. Typically used for one-way platforms.
+
+	The narrowphase already calls contact modification callbacks from its worker tasks, one batch of pairs per task,
+	so this class runs in parallel with no serial step. Pairs must request modification with PxPairFlag::eMODIFY_CONTACTS
+	in the filter shader.
+
+	An optional user callback is invoked after the built-in modifications, with the same batch of pairs.
+
+	\note The tables must not be modified while the scene is simulating.
+	*/
+	class PxDefaultContactModifyCallback : public PxContactModifyCallback
+	{
+		public:
+							PxDefaultContactModifyCallback(PxContactModifyCallback* userCallback = NULL);
+			virtual			~PxDefaultContactModifyCallback();
+
+			/**
+			\brief Sets the friction and restitution used for contacts between two materials. The order of materials does not matter.
+
+			\param[in] material0		first material
+			\param[in] material1		second material
+			\param[in] staticFriction	static friction coefficient, range [0, inf]
+			\param[in] dynamicFriction	dynamic friction coefficient, range [0, inf]
+			\param[in] restitution		restitution coefficient, range [0, 1]
+			*/
+			void			setMaterialPairOverride(const PxMaterial& material0, const PxMaterial& material1, PxReal staticFriction, PxReal dynamicFriction, PxReal restitution);
+
+			/**
+			\brief Removes a material pair override.
+			*/
+			void			clearMaterialPairOverride(const PxMaterial& material0, const PxMaterial& material1);
+
+			/**
+			\brief Makes a shape one-way.
+
+			\param[in] shape		shape to make one-way
+			\param[in] localDir		unit direction in the shape's local space, along which other shapes are pushed out (e.g. the platform's up axis)
+			\param[in] cosAngle		cosine of the cone half-angle around localDir in which contact normals are kept
+			*/
+			void			setOneWayShape(const PxShape& shape, const PxVec3& localDir, PxReal cosAngle);
+
+			/**
+			\brief Makes a shape two-way again.
+			*/
+			void			clearOneWayShape(const PxShape& shape);
+
+			/**
+			\brief Sets the user callback invoked after the built-in modifications. Can be NULL.
+			*/
+			void			setUserCallback(PxContactModifyCallback* userCallback);
+
+			// PxContactModifyCallback
+			virtual void	onContactModify(PxContactModifyPair* const pairs, PxU32 count)	PX_OVERRIDE;
+			//~PxContactModifyCallback
+
+		private:
+			DefaultContactModifyCallbackInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,63 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_DEFAULT_COOKING_CACHE_STORAGE_H
+#define PX_DEFAULT_COOKING_CACHE_STORAGE_H
+
+#include "cooking/PxCookingCache.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Default PxCookingCacheStorage implementation, storing each cooked stream in its own file.
+
+Files are named after the hexadecimal content hash, e.g. "<directory>/0123456789abcdef.pxcook". The directory must exist.
+
+\see PxCookingCache PxCreateCookingCache
+*/
+class PxDefaultFileCookingCacheStorage : public PxCookingCacheStorage
+{
+public:
+					PxDefaultFileCookingCacheStorage(const char* directory);
+	virtual			~PxDefaultFileCookingCacheStorage()	{}
+
+	virtual	bool	load(PxU64 key, PxOutputStream& stream)				PX_OVERRIDE;
+	virtual	void	store(PxU64 key, const void* data, PxU32 size)		PX_OVERRIDE;
+
+private:
+			void	getFileName(PxU64 key, char* fileName, PxU32 size)	const;
+
+			char	mDirectory[256];
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
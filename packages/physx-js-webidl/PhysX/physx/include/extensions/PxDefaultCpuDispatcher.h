@@ -57,6 +57,14 @@ public:
 	/**
 	\brief Enables profiling at task level.
 
+	Each task runs in a profiler zone named after the task. In addition, each worker thread reports:
+	- "PxDefaultCpuDispatcher.idle" zones covering the time spent without work, whatever the wait mode is.
+	- "PxDefaultCpuDispatcher.stolenTask" zones around tasks taken from another worker's queue.
+	- a "PxWorkerNN.queueDepth" value with the number of tasks left in its local queues, each time it starts a task.
+
+	These go through the regular PxProfilerCallback interface, so they end up in the PxDefaultProfiler buffers and
+	can be converted to Chrome trace format with SnippetProfilerConverter.
+
 	\note By default enabled only in profiling builds.
 	
 	\param[in] runProfiled True if tasks should be profiled.
@@ -74,11 +82,14 @@ public:
 
 /**
 \brief If a thread ends up waiting for work it will find itself in a spin-wait loop until work becomes available.
-Three strategies are available to limit wasted cycles.
+Four strategies are available to limit wasted cycles.
 The strategies are as follows: 
 a) wait until a work task signals the end of the spin-wait period.
 b) yield the thread by providing a hint to reschedule thread execution, thereby allowing other threads to run.
 c) yield the processor by informing it that it is waiting for work and requesting it to more efficiently use compute resources.
+d) spin for an adaptive number of cycles, then wait as in a). The spin budget grows when spinning finds work and shrinks
+when it does not, so that it converges to the typical gap between simulation stages. Outside of a simulation step (see
+PxCpuDispatcher::simulationStarting() and PxCpuDispatcher::simulationFinished()) threads wait immediately.
 */
 struct PxDefaultCpuDispatcherWaitForWorkMode
 {
@@ -86,7 +97,8 @@ struct PxDefaultCpuDispatcherWaitForWorkMode
 	{
 		eWAIT_FOR_WORK,
 		eYIELD_THREAD,
-		eYIELD_PROCESSOR
+		eYIELD_PROCESSOR,
+		eADAPTIVE
 	};
 };
 
@@ -98,12 +110,13 @@ struct PxDefaultCpuDispatcherWaitForWorkMode
 \param[in] affinityMasks Array with affinity mask for each thread. If not defined, default masks will be used.
 \param[in] mode is the strategy employed when a busy-wait is encountered. 
 \param[in] yieldProcessorCount specifies the number of times a OS-specific yield processor command will be executed
-during each cycle of a busy-wait in the event that the specified mode is eYIELD_PROCESSOR
+during each cycle of a busy-wait in the event that the specified mode is eYIELD_PROCESSOR, or the maximum spin budget
+in the event that the specified mode is eADAPTIVE
 
 \note numThreads may be zero in which case no worker thread are initialized and
 simulation tasks will be executed on the thread that calls PxScene::simulate()
 
-\note yieldProcessorCount must be greater than zero if eYIELD_PROCESSOR is the chosen mode and equal to zero for all other modes.
+\note yieldProcessorCount must be greater than zero if eYIELD_PROCESSOR or eADAPTIVE is the chosen mode and equal to zero for all other modes.
 
 \note eYIELD_THREAD and eYIELD_PROCESSOR modes will use compute resources even if the simulation is not running.
 It is left to users to keep threads inactive, if so desired, when no simulation is running.
@@ -112,6 +125,36 @@ It is left to users to keep threads inactive, if so desired, when no simulation
 */
 PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks = NULL, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode = PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK, PxU32 yieldProcessorCount = 0);
 
+/**
+\brief Placement strategies for PxDefaultCpuDispatcherComputeAffinityMasks().
+*/
+struct PxDefaultCpuDispatcherAffinityPolicy
+{
+	enum Enum
+	{
+		eCOMPACT,	//!< Threads are pinned to consecutive logical processors, filling each core (including SMT siblings) before the next one
+		eSCATTER	//!< Threads are pinned to one logical processor per core first, SMT siblings are only used once all cores are taken
+	};
+};
+
+/**
+\brief Computes per-thread affinity masks for PxDefaultCpuDispatcherCreate() from a placement policy.
+
+The set of candidate logical processors is given as a mask. Restricting the dispatcher to a subset of the machine,
+for example the performance cores of a hybrid CPU or the processors of one NUMA node, is done by passing the
+corresponding mask, as reported by the operating system.
+
+\param[in] policy				Placement strategy.
+\param[in] numThreads			Number of worker threads, i.e. number of masks to compute.
+\param[in] processorMask		Mask of candidate logical processors. Bit i is logical processor i.
+\param[in] nbLogicalPerCore		Number of logical processors per physical core (2 with SMT, 1 otherwise). Logical processors of a core are assumed to be consecutive.
+\param[out] affinityMasks		Array of numThreads masks, each with a single bit set. If there are more threads than candidate processors, processors are reused in the same order.
+\return Number of distinct logical processors used.
+
+\see PxDefaultCpuDispatcherCreate
+*/
+PxU32 PxDefaultCpuDispatcherComputeAffinityMasks(PxDefaultCpuDispatcherAffinityPolicy::Enum policy, PxU32 numThreads, PxU32 processorMask, PxU32 nbLogicalPerCore, PxU32* affinityMasks);
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
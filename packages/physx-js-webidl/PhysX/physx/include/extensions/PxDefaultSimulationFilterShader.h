@@ -123,6 +123,29 @@ PxFilterFlags PxDefaultSimulationFilterShader(
 	PxPairFlags& pairFlags,
 	const void* constantBlock, PxU32 constantBlockSize);
 
+/**
+\brief Filter shader using a PxLayerCollisionMatrix passed as filter shader data.
+
+This shader provides the following logic:
+\li If one of the two filter objects is a trigger, the pair is accepted and #PxPairFlag::eTRIGGER_DEFAULT will be used for trigger reports
+\li Else, if the layers in word0 of the two filter data do not collide according to the matrix, the pair is suppressed (#PxFilterFlag::eSUPPRESS)
+\li Else, the pair gets accepted and collision response gets enabled (#PxPairFlag::eCONTACT_DEFAULT)
+
+The matrix is the constant block: set PxSceneDesc::filterShaderData to the matrix and PxSceneDesc::filterShaderDataSize to
+sizeof(PxLayerCollisionMatrix). The SDK copies the block, so after modifying the matrix call PxScene::setFilterShaderData()
+again, and PxScene::resetFiltering() on the actors whose existing pairs should be filtered again. If no matrix is given,
+all pairs collide.
+
+Unlike PxDefaultSimulationFilterShader, the shader has no global state, so scenes can use different matrices.
+
+\see PxLayerCollisionMatrix PxSimulationFilterShader
+*/
+PxFilterFlags PxLayerMatrixFilterShader(
+	PxFilterObjectAttributes attributes0, PxFilterData filterData0, 
+	PxFilterObjectAttributes attributes1, PxFilterData filterData1,
+	PxPairFlags& pairFlags,
+	const void* constantBlock, PxU32 constantBlockSize);
+
 /**
 \brief Determines if collision detection is performed between a pair of groups
 
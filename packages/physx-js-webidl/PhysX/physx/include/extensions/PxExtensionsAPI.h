@@ -43,17 +43,46 @@
 #include "extensions/PxDefaultSimulationFilterShader.h"
 #include "extensions/PxDefaultErrorCallback.h"
 #include "extensions/PxDefaultStreams.h"
+#include "extensions/PxDefaultCookingCacheStorage.h"
 #include "extensions/PxRigidActorExt.h"
 #include "extensions/PxRigidBodyExt.h"
 #include "extensions/PxShapeExt.h"
 #include "extensions/PxTriangleMeshExt.h"
+#include "extensions/PxHeightFieldExt.h"
 #include "extensions/PxSerialization.h"
 #include "extensions/PxDefaultCpuDispatcher.h"
+#include "extensions/PxCooperativeCpuDispatcher.h"
 #include "extensions/PxSmoothNormals.h"
 #include "extensions/PxSimpleFactory.h"
 #include "extensions/PxStringTableExt.h"
 #include "extensions/PxBroadPhaseExt.h"
 #include "extensions/PxMassProperties.h"
+#include "extensions/PxSceneExt.h"
+#include "extensions/PxActiveActorTracker.h"
+#include "extensions/PxSceneSnapshot.h"
+#include "extensions/PxAllocationTracker.h"
+#include "extensions/PxAllocationTripwire.h"
+#include "extensions/PxDefaultContactModifyCallback.h"
+#include "extensions/PxLazyStatics.h"
+#include "extensions/PxMultiSceneScheduler.h"
+#include "extensions/PxParallelFor.h"
+#include "extensions/PxSceneStepper.h"
+#include "extensions/PxShardedScene.h"
+#include "extensions/PxTriggerTracker.h"
+#include "extensions/PxImmediatePairCache.h"
+#include "extensions/PxImmediateWorld.h"
+#include "extensions/PxRope.h"
+#include "extensions/PxQueryTrace.h"
+#include "extensions/PxSceneQueryHistory.h"
+#include "extensions/PxFrameSpikeRecorder.h"
+#include "extensions/PxOmniPvdAsyncWriteStream.h"
+#include "extensions/PxObjectIdTable.h"
+#include "extensions/PxActorHibernation.h"
+#include "extensions/PxCpuParticleSystem.h"
+#include "extensions/PxStaticVoxelizer.h"
+#include "extensions/PxAutoAggregator.h"
+#include "extensions/PxSimulationEventStream.h"
+#include "extensions/PxLayerCollisionMatrix.h"
 #include "extensions/PxSceneQueryExt.h"
 #include "extensions/PxSceneQuerySystemExt.h"
 #include "extensions/PxCustomSceneQuerySystem.h"
@@ -0,0 +1,182 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_FRAME_SPIKE_RECORDER_H
+#define PX_FRAME_SPIKE_RECORDER_H
+
+#include "common/PxPhysXCommonConfig.h"
+#include "PxSimulationStatistics.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class PxCollection;
+	class PxInputStream;
+	class PxSerializationRegistry;
+	class PxChromeTraceProfiler;
+	class FrameSpikeRecorderInternal;
+
+	/**
+	\brief Description of a recorded frame spike.
+	*/
+	struct PxFrameSpikeInfo
+	{
+		PxU32						frameIndex;		//!< Index of the frame, counting PxFrameSpikeRecorder::beginFrame() calls from zero
+		PxReal						frameTime;		//!< Time (in milliseconds) between beginFrame() and endFrame()
+		PxReal						threshold;		//!< Threshold (in milliseconds) that the frame time exceeded
+		PxSimulationStageTimings	timings;		//!< Per-stage timings of the simulation step, see PxScene::getSimulationStageTimings()
+	};
+
+	/**
+	\brief Callback receiving the recorded frame spikes.
+
+	\see PxFrameSpikeRecorderDesc
+	*/
+	class PxFrameSpikeCallback
+	{
+	public:
+		/**
+		\brief Called from PxFrameSpikeRecorder::endFrame() when a spike has been recorded.
+
+		\param[in] info			Description of the spike
+		\param[in] report		Spike report, to be stored and passed to PxFrameSpikeRecorder::load() later
+		\param[in] reportSize	Size of the report in bytes
+		\param[in] trace		Chrome trace JSON of the profiler ring buffer, or NULL if no profiler was given
+		\param[in] traceSize	Size of the trace in bytes
+		*/
+		virtual	void	onFrameSpike(const PxFrameSpikeInfo& info, const void* report, PxU32 reportSize, const void* trace, PxU32 traceSize) = 0;
+
+	protected:
+		virtual			~PxFrameSpikeCallback()	{}
+	};
+
+	/**
+	\brief Descriptor for PxFrameSpikeRecorder.
+	*/
+	struct PxFrameSpikeRecorderDesc
+	{
+		PxReal					threshold;		//!< Frame time (in milliseconds) above which a spike is recorded
+		PxU32					maxNbSpikes;	//!< Maximum number of spikes to record, zero for no limit. Recording a spike is slow, so repeated spikes can make things worse.
+		const char*				filePrefix;		//!< If not NULL, spikes are written to "<filePrefix><frameIndex>.pxspike", plus "<filePrefix><frameIndex>.json" for the trace
+		PxFrameSpikeCallback*	callback;		//!< If not NULL, spikes are passed to this callback
+		PxChromeTraceProfiler*	profiler;		//!< Optional profiler, typically created in ring-buffer mode, whose events are exported with each spike
+
+		PX_INLINE	PxFrameSpikeRecorderDesc() :
+			threshold	(1000.0f/30.0f),
+			maxNbSpikes	(1),
+			filePrefix	(NULL),
+			callback	(NULL),
+			profiler	(NULL)
+		{
+		}
+
+		/**
+		\brief Returns true if the descriptor is valid.
+		*/
+		PX_INLINE	bool	isValid()	const
+		{
+			return threshold>0.0f && (filePrefix || callback);
+		}
+	};
+
+	/**
+	\brief Flight recorder snapshotting the scene when a frame takes longer than a threshold.
+
+	Call beginFrame() before PxScene::simulate() and endFrame() after PxScene::fetchResults(). beginFrame() keeps the
+	pose and velocities of all rigid dynamic actors in memory, which costs a copy of their state each frame. When the frame
+	time exceeds the threshold, endFrame() serializes the scene to a binary collection and stores it together with the
+	pre-step actor states, the stage timings of the step and the events of the optional profiler.
+
+	load() recreates the collection from a report and restores the pre-step actor states, so that the slow frame can
+	be simulated again offline, e.g. under a profiler.
+
+	Articulations, deformables and particles are serialized in their post-step state, when supported by the binary
+	serialization. Objects created or released by the application between beginFrame() and endFrame() are not restored
+	to their pre-step state.
+
+	\see PxFrameSpikeRecorderDesc PxSerialization PxChromeTraceProfiler
+	*/
+	class PxFrameSpikeRecorder
+	{
+	public:
+		/**
+		\brief Creates a recorder for a scene.
+
+		\param[in] scene	The scene to record. Must outlive the recorder.
+		\param[in] registry	Serialization registry used to serialize the scene. Must outlive the recorder.
+		\param[in] desc		Recorder descriptor
+		*/
+						PxFrameSpikeRecorder(PxScene& scene, PxSerializationRegistry& registry, const PxFrameSpikeRecorderDesc& desc);
+						~PxFrameSpikeRecorder();
+
+		/**
+		\brief Starts a frame. Call before PxScene::simulate().
+		*/
+		void			beginFrame();
+
+		/**
+		\brief Ends a frame and records it if it exceeded the threshold. Call after PxScene::fetchResults().
+
+		\return True if a spike has been recorded
+		*/
+		bool			endFrame();
+
+		/**
+		\brief Returns the number of spikes recorded so far.
+		*/
+		PxU32			getNbSpikes()	const;
+
+		/**
+		\brief Recreates the scene of a spike report.
+
+		The returned collection contains the objects of the scene, with the rigid dynamic actors in their pre-step state.
+		Add it to a scene with PxScene::addCollection() and simulate it to replay the frame.
+
+		\param[in] stream	Stream containing a report written by the recorder
+		\param[in] registry	Serialization registry
+		\param[out] memory	Memory block holding the deserialized objects. Release it with releaseMemory() after releasing the objects.
+		\param[out] info	Optional description of the spike
+		\return The deserialized collection, or NULL if the report is invalid
+		*/
+		static	PxCollection*	load(PxInputStream& stream, PxSerializationRegistry& registry, void*& memory, PxFrameSpikeInfo* info = NULL);
+
+		/**
+		\brief Releases a memory block returned by load().
+		*/
+		static	void			releaseMemory(void* memory);
+
+	private:
+		FrameSpikeRecorderInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,137 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_HEIGHT_FIELD_EXT_H
+#define PX_HEIGHT_FIELD_EXT_H
+
+#include "PxPhysXConfig.h"
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxPhysics;
+class PxHeightField;
+class PxShape;
+struct PxHeightFieldSample;
+
+/**
+\brief Utility functions to build and stream height fields from regular grids of heights.
+
+Heights are given as float grids, with nbColumns heights per row. Row r and column c map to the local position
+(r * PxHeightFieldGeometry::rowScale, height, c * PxHeightFieldGeometry::columnScale) of the height field shape.
+
+Heights are quantized to 16-bit samples using a height scale, which must then be used as
+PxHeightFieldGeometry::heightScale for the shapes referencing the height field.
+
+\see PxHeightField PxHeightFieldGeometry PxHeightFieldSample
+*/
+class PxHeightFieldExt
+{
+public:
+
+	/**
+	\brief Computes the height scale giving the best precision for a set of heights.
+
+	\param[in] heights Heights to quantize
+	\param[in] nbHeights Number of heights
+	\param[in] minHeightRange The returned scale covers at least heights in [-minHeightRange, minHeightRange]. Use it to
+	leave room for later updates through updateHeights().
+
+	\return Height scale to use for the conversion and for PxHeightFieldGeometry::heightScale
+	*/
+	static PxReal			computeHeightScale(const PxReal* heights, PxU32 nbHeights, PxReal minHeightRange = 0.0f);
+
+	/**
+	\brief Converts a grid of heights to height field samples.
+
+	Material indices are set to materialIndex0 / materialIndex1 and the tessellation flag is cleared.
+
+	\param[in] heights Source heights, nbRows * nbColumns values in row-major order
+	\param[in] nbRows Number of rows
+	\param[in] nbColumns Number of columns
+	\param[in] heightScale Height scale, see computeHeightScale(). Heights out of range are clamped.
+	\param[out] samples Destination samples, nbRows * nbColumns entries
+	\param[in] materialIndex0 Material index of the lower triangle of each quad
+	\param[in] materialIndex1 Material index of the upper triangle of each quad
+
+	\see PxHeightFieldSample
+	*/
+	static void				convertHeights(const PxReal* heights, PxU32 nbRows, PxU32 nbColumns, PxReal heightScale, PxHeightFieldSample* samples,
+											PxU8 materialIndex0 = 0, PxU8 materialIndex1 = 0);
+
+	/**
+	\brief Creates a height field directly from a grid of heights.
+
+	Height fields do not need any cooking: the samples are copied to the new height field as is.
+
+	\param[in] physics The physics SDK, whose insertion callback is used to create the height field
+	\param[in] heights Source heights, nbRows * nbColumns values in row-major order
+	\param[in] nbRows Number of rows, at least 2
+	\param[in] nbColumns Number of columns, at least 2
+	\param[in] heightScale Height scale, see computeHeightScale()
+	\param[in] materialIndex0 Material index of the lower triangle of each quad
+	\param[in] materialIndex1 Material index of the upper triangle of each quad
+
+	\return The new height field, or NULL on failure
+
+	\see PxCreateHeightField
+	*/
+	static PxHeightField*	createHeightField(PxPhysics& physics, const PxReal* heights, PxU32 nbRows, PxU32 nbColumns, PxReal heightScale,
+											PxU8 materialIndex0 = 0, PxU8 materialIndex1 = 0);
+
+	/**
+	\brief Replaces the heights of a rectangular part of a height field, in place.
+
+	Material indices and tessellation flags of the modified samples are kept. The height bounds of the height field
+	are refitted, and only fully recomputed when a sample at the previous minimum or maximum height was modified.
+	The geometry of the given shapes is then refreshed so that the scene picks up the new bounds.
+
+	\param[in] heightField The height field to modify
+	\param[in] startRow First row to modify
+	\param[in] startColumn First column to modify
+	\param[in] nbRows Number of rows to modify
+	\param[in] nbColumns Number of columns to modify
+	\param[in] heights Source heights, nbRows * nbColumns values in row-major order
+	\param[in] heightScale Height scale the height field was created with
+	\param[in] shapes Shapes referencing the height field. Can be NULL.
+	\param[in] nbShapes Number of shapes
+
+	\return True on success
+
+	\see PxHeightField::modifySamples PxShape::setGeometry
+	*/
+	static bool				updateHeights(PxHeightField& heightField, PxU32 startRow, PxU32 startColumn, PxU32 nbRows, PxU32 nbColumns,
+											const PxReal* heights, PxReal heightScale, PxShape* const* shapes = NULL, PxU32 nbShapes = 0);
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,199 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_IMMEDIATE_PAIR_CACHE_H
+#define PX_IMMEDIATE_PAIR_CACHE_H
+
+#include "common/PxPhysXCommonConfig.h"
+#include "foundation/PxTransform.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxGeometry;
+	class PxCacheAllocator;
+	class PxConstraintAllocator;
+	struct PxCache;
+	class ImmediatePairCacheInternal;
+
+#if !PX_DOXYGEN
+namespace immediate
+{
+#endif
+	class PxContactRecorder;
+#if !PX_DOXYGEN
+}
+#endif
+
+	/**
+	\brief Pair of object indices tracked by PxImmediatePairCache.
+	*/
+	struct PxImmediatePair
+	{
+		PxU32	id0;	//!< First object index, as passed to PxImmediatePairCache::addPair()
+		PxU32	id1;	//!< Second object index, as passed to PxImmediatePairCache::addPair()
+	};
+
+	/**
+	\brief Persistent pair cache for immediate mode.
+
+	immediate::PxGenerateContacts() and immediate::PxCreateContactConstraints() / immediate::PxCreateContactConstraintsTGS() return
+	contact caches and friction patches that should be kept from one frame to the next, in memory provided by the user. This class
+	tracks these per-pair data for a set of object pairs, and owns the memory:
+
+	- pairs are identified by two user object indices. The pair (a, b) is the same as the pair (b, a).
+	- contact caches and friction patches are allocated from page-based arenas. The pages are reused from one frame to the next,
+	so the cache does not allocate memory once it has reached its working size.
+	- pairs that have not been added again for more than a given number of frames are removed in beginFrame().
+
+	Typical frame:
+	- beginFrame()
+	- addPair() for each overlapping pair, e.g. from a broadphase. Pairs reported by an incremental broadphase can use a maximum
+	age of 0xffffffff, and removePair() for lost pairs.
+	- generateContacts() for all tracked pairs, in one call
+	- create the contact constraints with getConstraintAllocator(), passing getFriction() data and storing the new data with setFriction()
+
+	Pair indices are only valid until the next call to beginFrame(), removePair() or removeObject().
+	*/
+	class PxImmediatePairCache
+	{
+		public:
+			/**
+			\param[in] maxAge	Number of frames a pair can remain in the cache without being added again
+			*/
+							PxImmediatePairCache(PxU32 maxAge = 1);
+							~PxImmediatePairCache();
+
+			/**
+			\brief Starts a new frame.
+
+			This recycles the memory used for the data of the frame before the previous one, and removes the pairs that have not been
+			added for more than the maximum age.
+			*/
+			void			beginFrame();
+
+			/**
+			\brief Adds a pair, or marks an existing pair as used in the current frame.
+
+			\param[in] id0	First object index
+			\param[in] id1	Second object index
+			\return Pair index
+			*/
+			PxU32			addPair(PxU32 id0, PxU32 id1);
+
+			/**
+			\brief Removes a pair.
+
+			\param[in] id0	First object index
+			\param[in] id1	Second object index
+			\return True if the pair was found
+			*/
+			bool			removePair(PxU32 id0, PxU32 id1);
+
+			/**
+			\brief Removes all the pairs involving an object.
+
+			\param[in] id	Object index
+			\return Number of removed pairs
+			*/
+			PxU32			removeObject(PxU32 id);
+
+			/**
+			\brief Removes all pairs.
+			*/
+			void			clear();
+
+			/**
+			\brief Returns the tracked pairs.
+
+			\param[out] nbPairs	Number of tracked pairs
+			\return Pairs. The object indices are in the order used when the pair was created.
+			*/
+			const PxImmediatePair*	getPairs(PxU32& nbPairs)	const;
+
+			/**
+			\brief Returns the contact caches of the tracked pairs, in the same order as getPairs().
+			*/
+			PxCache*		getCaches();
+
+			/**
+			\brief Generates contacts for all tracked pairs with a single call to immediate::PxGenerateContacts().
+
+			Contact caches that were not updated in the previous frame are reset first, since their memory has been recycled. Pairs
+			that do not generate contacts lose their friction patches.
+
+			\param[in] geometries		Geometries of the objects, indexed by object index
+			\param[in] poses			Poses of the objects, indexed by object index
+			\param[in] recorder			Contact recorder. The index passed to the recorder is the pair index.
+			\param[in] contactDistance	See immediate::PxGenerateContacts()
+			\param[in] meshContactMargin	See immediate::PxGenerateContacts()
+			\param[in] toleranceLength	See immediate::PxGenerateContacts()
+			\return Number of pairs with contacts
+			*/
+			PxU32			generateContacts(const PxGeometry*const* geometries, const PxTransform* poses, immediate::PxContactRecorder& recorder,
+											PxReal contactDistance, PxReal meshContactMargin, PxReal toleranceLength);
+
+			/**
+			\brief Returns the friction patches of a pair, to pass to the contact constraint creation.
+
+			\param[in] pairIndex		Pair index
+			\param[out] frictionPatches	Friction patches, or NULL
+			\param[out] nbPatches		Number of friction patches
+			*/
+			void			getFriction(PxU32 pairIndex, PxU8*& frictionPatches, PxU8& nbPatches)	const;
+
+			/**
+			\brief Stores the friction patches of a pair, as returned by the contact constraint creation.
+
+			\param[in] pairIndex		Pair index
+			\param[in] frictionPatches	Friction patches, allocated with getConstraintAllocator()
+			\param[in] nbPatches		Number of friction patches
+			*/
+			void			setFriction(PxU32 pairIndex, PxU8* frictionPatches, PxU8 nbPatches);
+
+			/**
+			\brief Returns the allocator used for the contact caches.
+			*/
+			PxCacheAllocator&		getCacheAllocator();
+
+			/**
+			\brief Returns the allocator to use for contact constraints and friction patches.
+
+			Constraint data is valid until the next beginFrame() call, friction data until the one after.
+			*/
+			PxConstraintAllocator&	getConstraintAllocator();
+
+		private:
+			ImmediatePairCacheInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
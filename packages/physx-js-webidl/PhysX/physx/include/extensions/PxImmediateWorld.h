@@ -0,0 +1,247 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_IMMEDIATE_WORLD_H
+#define PX_IMMEDIATE_WORLD_H
+
+#include "common/PxPhysXCommonConfig.h"
+#include "common/PxTolerancesScale.h"
+#include "foundation/PxTransform.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxGeometry;
+	class ImmediateWorldInternal;
+
+	/**
+	\brief Invalid body handle, returned by PxImmediateWorld::addBody() on failure.
+	*/
+	static const PxU32 PX_INVALID_IMMEDIATE_BODY = 0xffffffff;
+
+	/**
+	\brief Body types for PxImmediateWorld.
+	*/
+	struct PxImmediateBodyType
+	{
+		enum Enum
+		{
+			eSTATIC,	//!< Never moves
+			eKINEMATIC,	//!< Moved by the user with PxImmediateWorld::setKinematicTarget(), pushes dynamic bodies
+			eDYNAMIC	//!< Simulated
+		};
+	};
+
+	/**
+	\brief Descriptor for PxImmediateWorld.
+
+	The default values match the values used in the immediate mode snippet, for the given tolerances scale.
+	*/
+	struct PxImmediateWorldDesc
+	{
+		PxVec3	gravity;					//!< Gravity vector
+		PxReal	contactDistance;			//!< Distance at which contacts begin to be generated. Also used to inflate the bounds in the broadphase.
+		PxReal	meshContactMargin;			//!< Mesh contact margin, see immediate::PxGenerateContacts()
+		PxReal	toleranceLength;			//!< PxTolerancesScale::length, used to scale internal thresholds
+		PxReal	bounceThreshold;			//!< Relative velocity above which restitution is applied. Must be positive.
+		PxReal	frictionOffsetThreshold;	//!< Contacts whose separation is below this threshold can generate friction
+		PxReal	correlationDistance;		//!< Distance used by friction correlation to decide whether a friction patch is broken
+		PxU32	nbPositionIterations;		//!< Number of position iterations (TGS sub-steps)
+		PxU32	nbVelocityIterations;		//!< Number of velocity iterations
+
+		PX_INLINE	PxImmediateWorldDesc(const PxTolerancesScale& scale) :
+			gravity					(0.0f, -9.81f*scale.length, 0.0f),
+			contactDistance			(0.04f*scale.length),
+			meshContactMargin		(0.01f*scale.length),
+			toleranceLength			(scale.length),
+			bounceThreshold			(2.0f*scale.length),
+			frictionOffsetThreshold	(0.04f*scale.length),
+			correlationDistance		(0.025f*scale.length),
+			nbPositionIterations	(4),
+			nbVelocityIterations	(1)
+		{
+		}
+
+		PX_INLINE	bool	isValid()	const
+		{
+			return gravity.isFinite() && contactDistance>=0.0f && meshContactMargin>=0.0f && toleranceLength>0.0f
+				&& bounceThreshold>0.0f && frictionOffsetThreshold>0.0f && correlationDistance>0.0f && nbPositionIterations>0;
+		}
+	};
+
+	/**
+	\brief Descriptor for a body of PxImmediateWorld.
+	*/
+	struct PxImmediateBodyDesc
+	{
+		PxTransform					pose;				//!< Initial actor pose
+		PxVec3						linearVelocity;		//!< Initial linear velocity (dynamic bodies only)
+		PxVec3						angularVelocity;	//!< Initial angular velocity (dynamic bodies only)
+		PxImmediateBodyType::Enum	type;				//!< Body type
+		PxReal						density;			//!< Density used to compute the mass properties from the geometry (dynamic bodies only)
+		PxReal						linearDamping;		//!< Linear damping (dynamic bodies only)
+		PxReal						angularDamping;		//!< Angular damping (dynamic bodies only)
+		PxReal						staticFriction;		//!< Static friction coefficient. Coefficients of touching bodies are averaged.
+		PxReal						dynamicFriction;	//!< Dynamic friction coefficient. Coefficients of touching bodies are averaged.
+		PxReal						restitution;		//!< Restitution coefficient. Coefficients of touching bodies are averaged.
+
+		PX_INLINE	PxImmediateBodyDesc() :
+			pose			(PxIdentity),
+			linearVelocity	(0.0f),
+			angularVelocity	(0.0f),
+			type			(PxImmediateBodyType::eDYNAMIC),
+			density			(1.0f),
+			linearDamping	(0.0f),
+			angularDamping	(0.05f),
+			staticFriction	(0.5f),
+			dynamicFriction	(0.5f),
+			restitution		(0.0f)
+		{
+		}
+
+		PX_INLINE	bool	isValid()	const
+		{
+			return pose.isValid() && linearVelocity.isFinite() && angularVelocity.isFinite() && (type!=PxImmediateBodyType::eDYNAMIC || density>0.0f)
+				&& linearDamping>=0.0f && angularDamping>=0.0f && staticFriction>=0.0f && dynamicFriction>=0.0f && restitution>=0.0f && restitution<=1.0f;
+		}
+	};
+
+	/**
+	\brief Small self-contained rigid body world built on the immediate mode API.
+
+	This is meant for small, off-scene simulations that must run every frame, such as client-side prediction of the objects
+	pushed by a local player. It implements the pipeline shown in the immediate mode snippet:
+	- an incremental broadphase (PxAABBManager) with persistent pairs
+	- batched contact generation for all pairs (a single immediate::PxGenerateContacts() call per step)
+	- persistent contact caches and friction patches, kept from one step to the next in a PxImmediatePairCache
+	- constraint batching, TGS solver and integration
+
+	All internal buffers are kept and reused from one step to the next, so that a world with a stable number of bodies and
+	pairs does not allocate memory after a few steps.
+
+	Each body has a single geometry. Referenced meshes (triangle meshes, convex meshes, height fields) must outlive the bodies
+	using them. Joints are not supported.
+	*/
+	class PxImmediateWorld
+	{
+		public:
+							PxImmediateWorld(const PxImmediateWorldDesc& desc);
+							~PxImmediateWorld();
+
+			/**
+			\brief Adds a body to the world.
+
+			\param[in] geometry	Body geometry, in actor space. The geometry is copied.
+			\param[in] desc		Body descriptor
+			\return Body handle, or PX_INVALID_IMMEDIATE_BODY if the descriptor is invalid. Handles of removed bodies are recycled.
+			*/
+			PxU32			addBody(const PxGeometry& geometry, const PxImmediateBodyDesc& desc);
+
+			/**
+			\brief Removes a body from the world.
+
+			\param[in] handle	Body handle
+			*/
+			void			removeBody(PxU32 handle);
+
+			/**
+			\brief Teleports a body.
+
+			\param[in] handle	Body handle
+			\param[in] pose		New actor pose
+			*/
+			void			setPose(PxU32 handle, const PxTransform& pose);
+
+			/**
+			\brief Returns the pose of a body.
+
+			\param[in] handle	Body handle
+			\return Actor pose
+			*/
+			PxTransform		getPose(PxU32 handle)	const;
+
+			/**
+			\brief Sets the velocity of a dynamic body.
+
+			\param[in] handle			Body handle
+			\param[in] linearVelocity	Linear velocity
+			\param[in] angularVelocity	Angular velocity
+			*/
+			void			setVelocity(PxU32 handle, const PxVec3& linearVelocity, const PxVec3& angularVelocity);
+
+			/**
+			\brief Returns the linear velocity of a body.
+
+			\param[in] handle	Body handle
+			\return Linear velocity. For kinematic bodies this is the velocity computed in the last step.
+			*/
+			PxVec3			getLinearVelocity(PxU32 handle)	const;
+
+			/**
+			\brief Returns the angular velocity of a body.
+
+			\param[in] handle	Body handle
+			\return Angular velocity. For kinematic bodies this is the velocity computed in the last step.
+			*/
+			PxVec3			getAngularVelocity(PxU32 handle)	const;
+
+			/**
+			\brief Sets the target pose of a kinematic body for the next step.
+
+			The body velocity is derived from the target pose and the time step, and the body reaches the target at the end of
+			the step.
+
+			\param[in] handle	Body handle
+			\param[in] target	Target actor pose
+			*/
+			void			setKinematicTarget(PxU32 handle, const PxTransform& target);
+
+			/**
+			\brief Simulates the world.
+
+			\param[in] dt	Time step
+			*/
+			void			step(PxReal dt);
+
+			/**
+			\brief Returns the number of broadphase pairs, and the number of pairs that generated contacts in the last step.
+
+			\param[out] nbTouchingPairs	Number of pairs with contacts
+			\return Number of broadphase pairs
+			*/
+			PxU32			getNbPairs(PxU32& nbTouchingPairs)	const;
+
+		private:
+			ImmediateWorldInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,206 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_LAYER_COLLISION_MATRIX_H
+#define PX_LAYER_COLLISION_MATRIX_H
+
+#include "PxPhysXConfig.h"
+#include "PxQueryFiltering.h"
+#include "PxShape.h"
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxFoundation.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	/**
+	\brief Collision matrix between 32 layers, evaluated natively by the simulation shader, scene queries and character controllers.
+
+	Shapes carry their layers as a bitmask in word0 of their filter data: the simulation filter data for
+	PxLayerMatrixFilterShader, the query filter data for PxLayerMatrixQueryFilterCallback and
+	PxLayerMatrixControllerFilterCallback. Each layer has a mask of the layers it collides with, and two sets of layers
+	collide when each one is in the mask of the other:
+
+	<pre> (mask(layers0) & layers1) && (mask(layers1) & layers0) </pre>
+
+	where mask(layers) is the union of the masks of all the layers in the set. This is the usual group/mask test of
+	word0/word1 filter data, with the masks stored once in the matrix instead of in every shape, so that per-candidate
+	filter callbacks into script bindings can be replaced with a matrix set once.
+
+	The class is a plain array of 32 masks and is entirely inline, so that any SDK module can use it without linking
+	PhysXExtensions.
+
+	\see PxLayerMatrixFilterShader PxLayerMatrixQueryFilterCallback
+	*/
+	class PxLayerCollisionMatrix
+	{
+		public:
+		enum
+		{
+			eMAX_NB_LAYERS = 32
+		};
+
+		/**
+		\brief Constructor.
+
+		\param[in] collideAll	True to make all layers collide with each other, false to disable all collisions
+		*/
+		PX_INLINE PxLayerCollisionMatrix(bool collideAll = true)
+		{
+			for(PxU32 i=0; i<eMAX_NB_LAYERS; i++)
+				mMasks[i] = collideAll ? 0xffffffff : 0;
+		}
+
+		/**
+		\brief Sets the mask of layers a layer collides with.
+
+		This does not modify the masks of other layers, which also need to contain the layer for collisions to happen.
+
+		\param[in] layer	Layer index, less than 32. The layer's bit in filter data is (1<<layer).
+		\param[in] mask		Layers the layer collides with, as a bitmask
+		*/
+		PX_INLINE void setLayerMask(PxU32 layer, PxU32 mask)
+		{
+			PX_CHECK_AND_RETURN(layer < eMAX_NB_LAYERS, "PxLayerCollisionMatrix::setLayerMask: layer must be less than 32");
+			mMasks[layer] = mask;
+		}
+
+		/**
+		\brief Returns the mask of layers a layer collides with.
+		*/
+		PX_INLINE PxU32 getLayerMask(PxU32 layer) const
+		{
+			PX_CHECK_AND_RETURN_NULL(layer < eMAX_NB_LAYERS, "PxLayerCollisionMatrix::getLayerMask: layer must be less than 32");
+			return mMasks[layer];
+		}
+
+		/**
+		\brief Enables or disables collisions between two layers, in both masks.
+
+		\param[in] layer0	First layer index, less than 32
+		\param[in] layer1	Second layer index, less than 32
+		\param[in] enable	True to make the layers collide
+		*/
+		PX_INLINE void setCollision(PxU32 layer0, PxU32 layer1, bool enable)
+		{
+			PX_CHECK_AND_RETURN(layer0 < eMAX_NB_LAYERS && layer1 < eMAX_NB_LAYERS, "PxLayerCollisionMatrix::setCollision: layers must be less than 32");
+			if(enable)
+			{
+				mMasks[layer0] |= 1u<<layer1;
+				mMasks[layer1] |= 1u<<layer0;
+			}
+			else
+			{
+				mMasks[layer0] &= ~(1u<<layer1);
+				mMasks[layer1] &= ~(1u<<layer0);
+			}
+		}
+
+		/**
+		\brief Returns the union of the masks of a set of layers.
+
+		\param[in] layers	Set of layers, as a bitmask
+		*/
+		PX_FORCE_INLINE PxU32 getMask(PxU32 layers) const
+		{
+			PxU32 mask = 0;
+			while(layers)
+			{
+				mask |= mMasks[PxLowestSetBit(layers)];
+				layers &= layers - 1;
+			}
+			return mask;
+		}
+
+		/**
+		\brief Returns true if two sets of layers collide.
+
+		\param[in] layers0	First set of layers, as a bitmask (e.g. word0 of a shape's filter data)
+		\param[in] layers1	Second set of layers, as a bitmask
+		*/
+		PX_FORCE_INLINE bool collides(PxU32 layers0, PxU32 layers1) const
+		{
+			return (getMask(layers0) & layers1) && (getMask(layers1) & layers0);
+		}
+
+		PxU32	mMasks[eMAX_NB_LAYERS];	//!< Mask of the layers each layer collides with
+	};
+
+	/**
+	\brief Scene query filter callback testing shapes against a PxLayerCollisionMatrix.
+
+	A shape passes when the layers of the query collide with the layers in word0 of the shape's query filter data. The
+	matrix is referenced, not copied, so that changes to it apply to the next queries.
+
+	Use with PxQueryFlag::ePREFILTER and an all-zero PxQueryFilterData::data: non-zero filter data enables the built-in
+	word-by-word filter test, which runs before the callback. Character controllers use it through
+	PxControllerFilters::mFilterCallback, with mFilterData set to NULL.
+
+	\see PxLayerCollisionMatrix
+	*/
+	class PxLayerMatrixQueryFilterCallback : public PxQueryFilterCallback
+	{
+		public:
+		/**
+		\param[in] matrix		Collision matrix, must outlive the callback
+		\param[in] queryLayers	Layers of the query, as a bitmask
+		\param[in] hitType		Hit type reported for shapes passing the test
+		*/
+		PX_INLINE PxLayerMatrixQueryFilterCallback(const PxLayerCollisionMatrix& matrix, PxU32 queryLayers, PxQueryHitType::Enum hitType = PxQueryHitType::eBLOCK) :
+			mMatrix		(matrix),
+			mQueryLayers(queryLayers),
+			mHitType	(hitType)
+		{
+		}
+
+		virtual PxQueryHitType::Enum preFilter(const PxFilterData&, const PxShape* shape, const PxRigidActor*, PxHitFlags&)	PX_OVERRIDE
+		{
+			return mMatrix.collides(mQueryLayers, shape->getQueryFilterData().word0) ? mHitType : PxQueryHitType::eNONE;
+		}
+
+		virtual PxQueryHitType::Enum postFilter(const PxFilterData&, const PxQueryHit&, const PxShape*, const PxRigidActor*)	PX_OVERRIDE
+		{
+			return mHitType;
+		}
+
+		PX_INLINE void	setQueryLayers(PxU32 queryLayers)	{ mQueryLayers = queryLayers;	}
+		PX_INLINE PxU32	getQueryLayers()			const	{ return mQueryLayers;			}
+
+		private:
+		const PxLayerCollisionMatrix&	mMatrix;
+		PxU32							mQueryLayers;
+		PxQueryHitType::Enum			mHitType;
+
+		PxLayerMatrixQueryFilterCallback& operator=(const PxLayerMatrixQueryFilterCallback&);
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
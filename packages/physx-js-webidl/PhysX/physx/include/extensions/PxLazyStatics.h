@@ -0,0 +1,105 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_LAZY_STATICS_H
+#define PX_LAZY_STATICS_H
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class PxRigidStatic;
+	class LazyStaticsInternal;
+
+	/**
+	\brief Lazy simulation of static actors.
+
+	Each simulated PxRigidStatic shape costs a shape sim and a broadphase entry, even if no dynamic actor ever
+	comes close to it. This class adds static actors to the scene with PxActorFlag::eDISABLE_SIMULATION, i.e. as
+	scene-query-only objects, and keeps their bounds in a compact BVH. update() tests the bounds of the awake
+	dynamic actors against that BVH and enables simulation for the statics they touch. From then on these statics
+	are regular simulated actors.
+
+	Usage:
+	- add the statics with addStatics() instead of PxScene::addActor()
+	- call update() before each PxScene::simulate() call
+
+	\note Statics are only materialized before a simulation step, so a body woken up by a contact during a step,
+	or moving further than the margin passed to the constructor within a step, can touch a static one step late.
+	\note Articulation links are not considered by update().
+	*/
+	class PxLazyStatics
+	{
+		public:
+							PxLazyStatics(PxScene& scene, PxReal margin);
+							~PxLazyStatics();
+
+			/**
+			\brief Adds static actors to the scene, with simulation disabled until a dynamic actor gets close.
+
+			\param[in] actors	static actors, not yet in a scene
+			\param[in] nbActors	number of actors
+			\return True on success
+			*/
+			bool			addStatics(PxRigidStatic*const* actors, PxU32 nbActors);
+
+			/**
+			\brief Stops tracking a static actor. The actor is not removed from the scene.
+
+			\param[in] actor	static actor previously passed to addStatics()
+			*/
+			void			removeStatic(PxRigidStatic& actor);
+
+			/**
+			\brief Enables simulation for statics touched by awake dynamic actors. Call this before PxScene::simulate().
+
+			\return Number of statics materialized by this call
+			*/
+			PxU32			update();
+
+			/**
+			\brief Returns the number of tracked statics.
+			*/
+			PxU32			getNbStatics()		const;
+
+			/**
+			\brief Returns the number of tracked statics whose simulation has been enabled.
+			*/
+			PxU32			getNbMaterialized()	const;
+
+		private:
+			LazyStaticsInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
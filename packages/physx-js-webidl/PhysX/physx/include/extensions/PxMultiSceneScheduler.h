@@ -0,0 +1,123 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_MULTI_SCENE_SCHEDULER_H
+#define PX_MULTI_SCENE_SCHEDULER_H
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class MultiSceneSchedulerInternal;
+
+	/**
+	\brief Steps many scenes concurrently on a shared CPU dispatcher.
+
+	All scenes selected for a step are started before waiting for any of them, so the stages of different scenes
+	interleave on the worker threads: while one scene runs a serial stage, the workers pick up tasks from the others.
+	Scenes are started in priority order, so that the tasks of high priority scenes are queued first.
+
+	Each scene has a priority and a time budget:
+	- the budget is compared to the time the scene's last step took, from simulate() to completion. Scenes that exceed
+	their budget are simulated less often, with the accumulated elapsed time, until their cost fits again.
+	- the priority is used when a frame budget is passed to step(). Scenes are selected by decreasing priority until the
+	predicted cost of the selection reaches the frame budget. Deferred scenes accumulate their elapsed time and gain one
+	priority level per deferred step, so that they are not starved.
+
+	The elapsed time passed to a scene is capped by maxElapsedTime. Time in excess is dropped.
+
+	\note The scenes should share the same CPU dispatcher. Step times are wall-clock times, which include the time
+	spent sharing the workers with the other scenes.
+	\note The scheduler calls simulate() and fetchResults(true). It must not be used with scenes that are stepped
+	elsewhere.
+	*/
+	class PxMultiSceneScheduler
+	{
+		public:
+			/**
+			\param[in] maxElapsedTime	maximum elapsed time passed to a scene's simulate() call
+			*/
+							PxMultiSceneScheduler(PxReal maxElapsedTime);
+							~PxMultiSceneScheduler();
+
+			/**
+			\brief Adds a scene to the scheduler.
+
+			\param[in] scene	scene to schedule
+			\param[in] priority	scene priority. Higher values are scheduled first.
+			\param[in] budget	time budget per step, in seconds. Zero disables throttling for this scene.
+			\return False if the scene has already been added.
+			*/
+			bool			addScene(PxScene& scene, PxU32 priority, PxReal budget);
+
+			/**
+			\brief Removes a scene from the scheduler.
+
+			\return False if the scene was not found.
+			*/
+			bool			removeScene(PxScene& scene);
+
+			/**
+			\brief Changes the priority of a scene, e.g. when players enter or leave it.
+
+			\return False if the scene was not found.
+			*/
+			bool			setPriority(PxScene& scene, PxU32 priority);
+
+			/**
+			\brief Changes the time budget of a scene.
+
+			\return False if the scene was not found.
+			*/
+			bool			setBudget(PxScene& scene, PxReal budget);
+
+			/**
+			\brief Steps the scenes.
+
+			\param[in] elapsedTime	elapsed time since the last call
+			\param[in] frameBudget	predicted time allowed for this call, in seconds. Zero selects all scenes not throttled by their own budget.
+			\return Number of scenes simulated by this call
+			*/
+			PxU32			step(PxReal elapsedTime, PxReal frameBudget = 0.0f);
+
+			/**
+			\brief Returns the time taken by the last step of a scene, in seconds, or -1 if the scene was not found.
+			*/
+			PxReal			getLastStepTime(const PxScene& scene)	const;
+
+		private:
+			MultiSceneSchedulerInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,148 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_OBJECT_ID_TABLE_H
+#define PX_OBJECT_ID_TABLE_H
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxBase;
+	struct PxRaycastHit;
+	struct PxSweepHit;
+	struct PxOverlapHit;
+	struct PxContactPairHeader;
+	struct PxContactPair;
+	struct PxTriggerPair;
+	class ObjectIdTableInternal;
+
+	/**
+	\brief Stable small integer ids for SDK objects.
+
+	Language bindings usually expose SDK objects as wrappers keyed by pointer, which means creating or looking up a
+	wrapper each time a query result or a simulation event returns an actor or a shape. This class assigns each
+	registered object (actors, shapes, articulations, ... - e.g. the actor of a character controller) a dense id, and
+	converts query hits and event pairs into arrays of ids that can be read directly from memory.
+
+	Ids are recycled in the same way as the SDK's internal id pools: an id released by remove() is only reused after
+	the next call to processDeferredIds(), so that results and events produced in the same frame never refer to a
+	recycled id. Unregistered objects, and NULL pointers, are reported as PX_INVALID_U32.
+
+	With storeIdsInUserData, the id of each registered actor and shape is also written to its userData as
+	reinterpret_cast<void*>(size_t(id)), the convention used by PxActiveActorTracker.
+	*/
+	class PxObjectIdTable
+	{
+		public:
+							PxObjectIdTable(bool storeIdsInUserData = false);
+							~PxObjectIdTable();
+
+			/**
+			\brief Registers an object.
+
+			\param[in] object	Object to register
+			\return The id of the object. If it was already registered, its existing id.
+			*/
+			PxU32			add(PxBase& object);
+
+			/**
+			\brief Unregisters an object. Its id is reused after the next processDeferredIds() call.
+
+			\param[in] object	Object to unregister, typically just before it is released
+			\return False if the object was not registered
+			*/
+			bool			remove(PxBase& object);
+
+			/**
+			\brief Makes the ids of the objects removed since the last call available again. Call this once per frame, after results and events have been consumed.
+			*/
+			void			processDeferredIds();
+
+			/**
+			\brief Returns the id of an object, or PX_INVALID_U32 if it is NULL or not registered.
+			*/
+			PxU32			getId(const PxBase* object)	const;
+
+			/**
+			\brief Returns the object registered with an id, or NULL.
+			*/
+			PxBase*			getObject(PxU32 id)			const;
+
+			/**
+			\brief Returns the number of registered objects.
+			*/
+			PxU32			getNbObjects()				const;
+
+			/**
+			\brief Returns an upper bound of the ids in use, i.e. the size of an array indexed by id.
+			*/
+			PxU32			getMaxId()					const;
+
+			/**
+			\brief Writes the actor and shape ids of query hits, 2 ids per hit: ids[i*2] = actor, ids[i*2+1] = shape.
+
+			\param[in] hits		Hits, e.g. PxRaycastBuffer::touches or &PxRaycastBuffer::block
+			\param[in] nbHits	Number of hits
+			\param[out] ids		Output ids, 2*nbHits entries
+			*/
+			void			getHitIds(const PxRaycastHit* hits, PxU32 nbHits, PxU32* ids)	const;
+			void			getHitIds(const PxSweepHit* hits, PxU32 nbHits, PxU32* ids)		const;
+			void			getHitIds(const PxOverlapHit* hits, PxU32 nbHits, PxU32* ids)	const;
+
+			/**
+			\brief Writes the ids of contact pairs, as reported by PxSimulationEventCallback::onContact(), 4 ids per pair: actor0, actor1, shape0, shape1.
+
+			Removed actors and shapes are reported as PX_INVALID_U32 once they have been unregistered.
+
+			\param[in] pairHeader	Pair header
+			\param[in] pairs		Contact pairs
+			\param[in] nbPairs		Number of contact pairs
+			\param[out] ids			Output ids, 4*nbPairs entries
+			*/
+			void			getContactPairIds(const PxContactPairHeader& pairHeader, const PxContactPair* pairs, PxU32 nbPairs, PxU32* ids)	const;
+
+			/**
+			\brief Writes the ids of trigger pairs, as reported by PxSimulationEventCallback::onTrigger(), 4 ids per pair: triggerActor, triggerShape, otherActor, otherShape.
+
+			\param[in] pairs	Trigger pairs
+			\param[in] nbPairs	Number of trigger pairs
+			\param[out] ids		Output ids, 4*nbPairs entries
+			*/
+			void			getTriggerPairIds(const PxTriggerPair* pairs, PxU32 nbPairs, PxU32* ids)	const;
+
+		private:
+			ObjectIdTableInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,95 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_OMNI_PVD_ASYNC_WRITE_STREAM_H
+#define PX_OMNI_PVD_ASYNC_WRITE_STREAM_H
+
+#include "foundation/PxSimpleTypes.h"
+
+class OmniPvdWriteStream;
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief OmniPvd write stream moving the writes to a background thread.
+
+Data written by the OmniPvd writer is copied into a buffer. Full buffers are written to the target stream, e.g. the
+file stream returned by PxOmniPvd::getFileWriteStream(), by a background thread while the next buffer is being filled.
+The simulation thread only blocks when both buffers are full, i.e. when the target stream cannot keep up.
+
+Combined with PxOmniPvdSamplingParams this allows keeping OmniPvd recording enabled in production builds with
+PX_SUPPORT_OMNI_PVD.
+
+Typical usage:
+
+	PxOmniPvdAsyncWriteStream* asyncStream = PxOmniPvdAsyncWriteStreamCreate(*omniPvd->getFileWriteStream());
+	omniPvd->getWriter()->setWriteStream(asyncStream->getStream());
+
+\see PxOmniPvdAsyncWriteStreamCreate() PxOmniPvdSamplingParams
+*/
+class PxOmniPvdAsyncWriteStream
+{
+public:
+	/**
+	\brief Returns the stream to pass to OmniPvdWriter::setWriteStream().
+	*/
+	virtual OmniPvdWriteStream&	getStream() = 0;
+
+	/**
+	\brief Returns the number of times the writer had to wait for the background thread.
+
+	A high count means that the buffers are too small, or that the target stream is too slow for the recorded data.
+	*/
+	virtual PxU32				getNbStalls() const = 0;
+
+	/**
+	\brief Writes the pending data, stops the background thread and deletes the stream.
+
+	The target stream is not closed. Release the stream after OmniPvd stopped writing to it.
+	*/
+	virtual void				release() = 0;
+
+protected:
+	virtual						~PxOmniPvdAsyncWriteStream() {}
+};
+
+/**
+\brief Creates an asynchronous OmniPvd write stream.
+
+\param[in] targetStream	Stream receiving the data, from the background thread. Must outlive the created stream.
+\param[in] bufferSize	Size of each of the two buffers, in bytes. Larger writes are passed to the target stream directly.
+\return The new stream
+*/
+PxOmniPvdAsyncWriteStream* PxOmniPvdAsyncWriteStreamCreate(OmniPvdWriteStream& targetStream, PxU32 bufferSize = 4*1024*1024);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
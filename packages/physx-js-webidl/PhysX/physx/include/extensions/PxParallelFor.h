@@ -0,0 +1,77 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_PARALLEL_FOR_H
+#define PX_PARALLEL_FOR_H
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxCpuDispatcher;
+
+	/**
+	\brief Work callback for PxParallelFor().
+
+	process() is called concurrently from several threads, each time with a different [startIndex, endIndex) range.
+	It must be thread-safe and must not block.
+	*/
+	class PxParallelForCallback
+	{
+		public:
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	= 0;
+
+		protected:
+			virtual			~PxParallelForCallback()	{}
+	};
+
+	/**
+	\brief Runs a callback over [0, count) in parallel, using the threads of a CPU dispatcher.
+
+	The range is split into chunks of 'grain' elements. Up to getWorkerCount() tasks are submitted to the dispatcher,
+	and the calling thread processes chunks as well. Chunks are distributed dynamically: each thread grabs the next
+	unprocessed chunk until none are left, so threads that finish early take work from slower ones.
+
+	The function returns once the whole range has been processed. It can be called from a worker thread of the same
+	dispatcher, in which case the calling thread simply ends up processing the chunks that nobody else picked.
+
+	\param[in] dispatcher	CPU dispatcher used to run the tasks. If NULL or without worker threads, the range is processed serially.
+	\param[in] count		number of elements to process
+	\param[in] grain		number of elements per chunk. Zero is treated as one.
+	\param[in] callback		work callback
+
+	\see PxParallelForCallback
+	*/
+	void	PxParallelFor(PxCpuDispatcher* dispatcher, PxU32 count, PxU32 grain, PxParallelForCallback& callback);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,148 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_QUERY_TRACE_H
+#define PX_QUERY_TRACE_H
+
+#include "PxQueryRecorder.h"
+#include "geometry/PxGeometryHelpers.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class PxInputStream;
+	class PxOutputStream;
+	class QueryTraceInternal;
+
+	/**
+	\brief Query types stored in a PxQueryTrace.
+	*/
+	struct PxQueryTraceType
+	{
+		enum Enum
+		{
+			eRAYCAST,
+			eSWEEP,
+			eOVERLAP
+		};
+	};
+
+	/**
+	\brief A recorded scene query.
+	*/
+	struct PxQueryTraceEntry
+	{
+		PxGeometryHolder		geometry;		//!< Query geometry (sweeps and overlaps only)
+		PxTransform				pose;			//!< Query pose. For raycasts only the position is used, as the ray origin.
+		PxVec3					unitDir;		//!< Normalized direction (raycasts and sweeps only)
+		PxReal					distance;		//!< Query distance (raycasts and sweeps only)
+		PxReal					inflation;		//!< Inflation (sweeps only)
+		PxQueryFilterData		filterData;		//!< Filter data
+		PxHitFlags				hitFlags;		//!< Hit flags (raycasts and sweeps only)
+		PxU32					maxNbTouches;	//!< Size of the touch buffer used by the recorded query
+		PxQueryTraceType::Enum	type;			//!< Query type
+	};
+
+	/**
+	\brief Query recorder storing queries in memory, to save them to a file and replay them later.
+
+	Register it on a scene with PxScene::setQueryRecorder() to capture the queries of a live application. Only sphere,
+	capsule and box geometries are recorded for sweeps and overlaps, queries using other geometries are counted as dropped.
+	Recording is thread-safe.
+
+	\see PxQueryRecorder PxScene::setQueryRecorder()
+	*/
+	class PxQueryTrace : public PxQueryRecorder
+	{
+		public:
+								PxQueryTrace();
+		virtual					~PxQueryTrace();
+
+		// PxQueryRecorder
+		virtual	void			recordRaycast(const PxVec3& origin, const PxVec3& unitDir, PxReal distance, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxU32 maxNbTouches)	PX_OVERRIDE;
+		virtual	void			recordSweep(const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, PxReal distance, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxU32 maxNbTouches, PxReal inflation)	PX_OVERRIDE;
+		virtual	void			recordOverlap(const PxGeometry& geometry, const PxTransform& pose, const PxQueryFilterData& filterData, PxU32 maxNbTouches)	PX_OVERRIDE;
+		//~PxQueryRecorder
+
+		/**
+		\brief Returns the number of recorded queries.
+		*/
+				PxU32			getNbEntries()	const;
+
+		/**
+		\brief Returns the recorded queries, in recording order.
+		*/
+		const	PxQueryTraceEntry*	getEntries()	const;
+
+		/**
+		\brief Returns the number of queries that could not be recorded because of their geometry type.
+		*/
+				PxU32			getNbDroppedQueries()	const;
+
+		/**
+		\brief Removes all recorded queries.
+		*/
+				void			clear();
+
+		/**
+		\brief Saves the trace to a stream, in a little-endian binary format.
+
+		\param[in] stream	Output stream
+		\return True on success
+		*/
+				bool			save(PxOutputStream& stream)	const;
+
+		/**
+		\brief Replaces the trace with the content of a stream written by save().
+
+		\param[in] stream	Input stream
+		\return True on success. On failure the trace is left empty.
+		*/
+				bool			load(PxInputStream& stream);
+
+		/**
+		\brief Runs a recorded query on a scene.
+
+		Queries with touches use a touch buffer of up to 64 hits.
+
+		\param[in] scene	Scene to query
+		\param[in] entry	Recorded query
+		\return Number of hits, including the blocking hit
+		*/
+		static	PxU32			replay(const PxScene& scene, const PxQueryTraceEntry& entry);
+
+		private:
+				QueryTraceInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
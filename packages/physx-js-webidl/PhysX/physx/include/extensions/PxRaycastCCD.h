@@ -60,6 +60,12 @@ namespace physx
 	Finally, since it is using the SDK's scene queries under the hood, it only works provided the simulation shapes also have
 	scene-query shapes associated with them. That is, if the objects in the scene only use PxShapeFlag::eSIMULATION_SHAPE
 	(and no PxShapeFlag::eSCENE_QUERY_SHAPE), then the raycast-CCD system will not work.
+
+	For small fast projectiles (arrows, bullets, thrown items...) this can replace the SDK's CCD passes entirely: do not set
+	PxRigidBodyFlag::eENABLE_CCD on these objects, and register them here instead. Objects can be registered with a sweep
+	radius, in which case a sphere of that radius is swept against the scene instead of a ray, which avoids going through
+	cracks narrower than the sphere. When the sphere already overlaps the scene at its start position, e.g. for objects
+	sliding along the ground, the ray is used instead.
 	*/
 	class RaycastCCDManager
 	{
@@ -77,6 +83,17 @@ namespace physx
 			*/
 			bool	registerRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape);
 
+			/**
+			\brief Register dynamic object for sphere-cast CCD.
+
+			\param[in] actor		object's actor
+			\param[in] shape		object's shape
+			\param[in] sweepRadius	radius of the sphere swept against the scene. Zero means a raycast is used, as in the above function. Clamped to half the shape's smallest half-extent and internal radius.
+
+			\return True if success
+			*/
+			bool	registerRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape, PxReal sweepRadius);
+
 			/**
 			\brief Unregister dynamic object for raycast CCD.
 
@@ -90,6 +107,10 @@ namespace physx
 			/**
 			\brief Perform raycast CCD. Call this after your simulate/fetchResults calls.
 
+			All registered objects are processed in a batch: queries are first performed for all moving objects, then the
+			corrected poses are written back. As a consequence dynamic-vs-dynamic CCD sees the poses from the simulation,
+			not the poses already corrected for other objects during the same call.
+
 			\param[in] doDynamicDynamicCCD	True to enable dynamic-vs-dynamic CCD (more expensive, not always needed)
 			*/
 			void	doRaycastCCD(bool doDynamicDynamicCCD);
@@ -153,6 +153,21 @@ public:
 	\see PxBVH PxScene::addActor PxAggregate::addActor
 	*/
 	static PxBVH* createBVHFromActor(PxPhysics& physics, const PxRigidActor& actor);
+
+	/**
+	\brief Convenience function to cook a PxBVH for a PxRigidActor into a stream.
+
+	Use it to prebuild the BVH of actors with many shapes offline, e.g. streamed world regions. The stream can later
+	be loaded with PxPhysics::createBVH() and passed to PxScene::addActor().
+
+	\param[in] actor	The actor to cook a PxBVH for.
+	\param[out] stream	User stream to output the cooked data.
+
+	\return	True on success.
+
+	\see PxBVH PxCookBVH PxPhysics::createBVH PxScene::addActor
+	*/
+	static bool cookBVHFromActor(const PxRigidActor& actor, PxOutputStream& stream);
 };
 
 #if !PX_DOXYGEN
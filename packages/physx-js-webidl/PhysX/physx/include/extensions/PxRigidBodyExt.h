@@ -102,6 +102,24 @@ public:
 	\see PxRigidBody::setMassLocalPose PxRigidBody::setMassSpaceInertiaTensor PxRigidBody::setMass
 	*/
 	static		bool			updateMassAndInertia(PxRigidBody& body, PxReal density, const PxVec3* massLocalPose = NULL, bool includeNonSimShapes = false);
+
+	/**
+	\brief Batched computation of mass properties for many rigid body actors sharing the same density
+
+	Same as calling updateMassAndInertia(PxRigidBody&, PxReal, const PxVec3*, bool) for each body. Bodies whose shapes
+	have the same geometries (same meshes and mesh scales for convex and triangle meshes) and the same local poses share
+	their mass properties, which are then only computed once. This is meant for spawning many copies of the same object.
+
+	\param[in,out] bodies The rigid bodies.
+	\param[in] nbBodies The number of bodies.
+	\param[in] density The density of the bodies. The density must be greater than 0.
+	\param[in] massLocalPose The center of mass relative to the actor frame, for all bodies. If set to null then it is computed for each body.
+	\param[in] includeNonSimShapes True if all kind of shapes (PxShapeFlag::eSCENE_QUERY_SHAPE, PxShapeFlag::eTRIGGER_SHAPE) should be taken into account.
+	\return Boolean. True if all bodies succeeded else false.
+
+	\see updateMassAndInertia
+	*/
+	static		bool			updateMassAndInertia(PxRigidBody* const* bodies, PxU32 nbBodies, PxReal density, const PxVec3* massLocalPose = NULL, bool includeNonSimShapes = false);
 	
 	/**
 	\brief Computation of mass properties for a rigid body actor
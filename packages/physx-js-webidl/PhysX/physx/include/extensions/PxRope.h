@@ -0,0 +1,174 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_ROPE_H
+#define PX_ROPE_H
+
+#include "common/PxPhysXCommonConfig.h"
+#include "foundation/PxVec3.h"
+#include "PxQueryFiltering.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class PxRigidActor;
+	class RopeInternal;
+
+	/**
+	\brief Descriptor for PxRope.
+	*/
+	struct PxRopeDesc
+	{
+		PxVec3				start;				//!< World position of the first node
+		PxVec3				end;				//!< World position of the last node. Nodes are evenly spaced between start and end, which also defines the rest length.
+		PxVec3				gravity;			//!< Gravity vector
+		PxU32				nbNodes;			//!< Number of nodes, including both ends. Must be at least 2.
+		PxReal				radius;				//!< Radius of the sphere-swept segments used for collisions
+		PxReal				nodeMass;			//!< Mass of each node, used to compute the forces applied to attached dynamic actors
+		PxReal				damping;			//!< Velocity damping, between 0 (none) and 1 (full)
+		PxReal				maxTension;			//!< Maximum force applied to each attached dynamic actor
+		PxU32				nbIterations;		//!< Number of solver iterations for the chain
+		PxQueryFilterData	filterData;			//!< Filter data used by the collision queries. Set the flags to zero to disable collisions.
+
+		PX_INLINE	PxRopeDesc() :
+			start			(0.0f),
+			end				(0.0f),
+			gravity			(0.0f, -9.81f, 0.0f),
+			nbNodes			(0),
+			radius			(0.05f),
+			nodeMass		(0.1f),
+			damping			(0.01f),
+			maxTension		(PX_MAX_F32),
+			nbIterations	(8),
+			filterData		(PxQueryFlag::eSTATIC|PxQueryFlag::eDYNAMIC)
+		{
+		}
+
+		PX_INLINE	bool	isValid()	const
+		{
+			return start.isFinite() && end.isFinite() && gravity.isFinite() && nbNodes>=2 && radius>=0.0f && nodeMass>0.0f
+				&& damping>=0.0f && damping<=1.0f && maxTension>=0.0f && nbIterations>0;
+		}
+	};
+
+	/**
+	\brief Inextensible rope or chain, simulated as a single block of distance constraints.
+
+	This replaces ropes and chains built from many small rigid bodies connected with joints. The rope is a list of point
+	nodes connected by segments that can become slack but cannot stretch beyond their rest length. All segments are solved
+	together in a single pass over the chain, and collisions use sphere-swept segments (capsules) queried against the scene.
+
+	Nodes can be attached to actors. Attached nodes follow their actor, and dynamic actors receive the rope tension as a force.
+	Shapes of attached actors are ignored by the collision queries.
+
+	The rope is not part of the scene: call simulate() once per frame, when the scene is not simulating, typically right after
+	PxScene::fetchResults(). Tension forces are then applied to attached actors during the next scene simulation.
+	*/
+	class PxRope
+	{
+		public:
+			/**
+			\param[in] scene	Scene used for the collision queries and containing the attached actors. Must outlive the rope.
+			\param[in] desc		Rope descriptor. Must be valid.
+			*/
+							PxRope(PxScene& scene, const PxRopeDesc& desc);
+							~PxRope();
+
+			/**
+			\brief Attaches a node to an actor, or pins it in the world.
+
+			\param[in] node		Node index
+			\param[in] actor	Actor to attach to, or NULL to pin the node in the world. The actor must stay alive while it is attached.
+			\param[in] localPos	Attachment point, in actor space, or in world space if actor is NULL
+			*/
+			void			attach(PxU32 node, PxRigidActor* actor, const PxVec3& localPos);
+
+			/**
+			\brief Detaches a node from its actor, or unpins it.
+
+			\param[in] node		Node index
+			*/
+			void			detach(PxU32 node);
+
+			/**
+			\brief Detaches all nodes attached to an actor. Call this before releasing an attached actor.
+
+			\param[in] actor	Attached actor
+			*/
+			void			detachActor(const PxRigidActor& actor);
+
+			/**
+			\brief Advances the rope simulation.
+
+			\param[in] dt	Time step
+			*/
+			void			simulate(PxReal dt);
+
+			/**
+			\brief Teleports a node. Its velocity is reset.
+
+			\param[in] node		Node index
+			\param[in] pos		New world position
+			*/
+			void			setNodePosition(PxU32 node, const PxVec3& pos);
+
+			/**
+			\brief Returns the number of nodes.
+			*/
+			PxU32			getNbNodes()	const;
+
+			/**
+			\brief Copies node positions to a user buffer.
+
+			\param[out] buffer		Destination buffer
+			\param[in] bufferSize	Number of PxVec3 the buffer can hold
+			\param[in] startIndex	Index of the first node to copy
+			\return Number of positions written
+			*/
+			PxU32			getNodePositions(PxVec3* buffer, PxU32 bufferSize, PxU32 startIndex=0)	const;
+
+			/**
+			\brief Returns the rest length of the rope.
+			*/
+			PxReal			getRestLength()	const;
+
+			/**
+			\brief Returns the current length of the rope, i.e. the sum of the segment lengths.
+			*/
+			PxReal			getLength()	const;
+
+		private:
+			RopeInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
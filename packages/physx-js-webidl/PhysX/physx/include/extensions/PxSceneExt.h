@@ -0,0 +1,214 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_SCENE_EXT_H
+#define PX_SCENE_EXT_H
+
+#include "PxPhysXConfig.h"
+#include "foundation/PxTransform.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxScene;
+class PxRigidActor;
+class PxBVH;
+struct PxContactPairHeader;
+struct PxConstraintInfo;
+
+/**
+\brief Transform of an active actor, as written by PxSceneExt::getActiveActorTransforms().
+
+The layout is 8 x 32-bit words (32 bytes) without padding. It can be read from a flat float buffer, with the
+first word of each entry reinterpreted as an unsigned integer.
+*/
+struct PxActiveActorTransform
+{
+	PxU32	userIndex;	//!< Index stored in the actor's userData, see PxSceneExt::getActiveActorTransforms()
+	PxVec3	p;			//!< Global position of the actor
+	PxQuat	q;			//!< Global orientation of the actor
+};
+PX_COMPILE_TIME_ASSERT(sizeof(PxActiveActorTransform) == 32);
+
+/**
+\brief Contact report of a shape pair, as written by PxSceneExt::getContactReports().
+
+The layout is 10 x 32-bit words (40 bytes) without padding. It can be read from a flat float buffer, with the
+first four words of each entry reinterpreted as unsigned integers.
+*/
+struct PxContactReportRecord
+{
+	PxU32	userIndex0;	//!< Index stored in the first actor's userData, or 0xffffffff if the actor has been removed
+	PxU32	userIndex1;	//!< Index stored in the second actor's userData, or 0xffffffff if the actor has been removed
+	PxU32	events;		//!< Raised events, see PxContactPair::events and PxPairFlag
+	PxU32	nbContacts;	//!< Number of contact points of the pair
+	PxVec3	impulse;	//!< Sum of the contact impulses. Zero if impulses are not available, see PxContactPairFlag::eINTERNAL_HAS_IMPULSES.
+	PxVec3	point;		//!< Position of the first contact point. Zero if the pair has no contact points.
+};
+PX_COMPILE_TIME_ASSERT(sizeof(PxContactReportRecord) == 40);
+
+/**
+\brief Broken constraint, as written by PxSceneExt::getConstraintBreakReports().
+
+The layout is 10 x 32-bit words (40 bytes) without padding. It can be read from a flat float buffer, with the
+first four words of each entry reinterpreted as unsigned integers.
+*/
+struct PxConstraintBreakRecord
+{
+	PxU32	userIndex;	//!< Index stored in the joint's userData, or 0xffffffff if the constraint is not a PxJoint
+	PxU32	type;		//!< Type ID of the constraint's external object, see PxConstraintInfo::type and PxConstraintExtIDs
+	PxU32	userIndex0;	//!< Index stored in the first actor's userData, or 0xffffffff if the constraint is attached to the world
+	PxU32	userIndex1;	//!< Index stored in the second actor's userData, or 0xffffffff if the constraint is attached to the world
+	PxVec3	force;		//!< Linear force applied by the constraint in the step it broke, see PxConstraint::getForce(). Multiply by the time step to get the impulse.
+	PxVec3	torque;		//!< Angular force applied by the constraint in the step it broke, see PxConstraint::getForce()
+};
+PX_COMPILE_TIME_ASSERT(sizeof(PxConstraintBreakRecord) == 40);
+
+/**
+\brief Utility functions for bulk access to scene data.
+
+These functions replace per-actor API calls with a single call that reads or writes contiguous user buffers.
+They are meant for callers for which each API call is expensive, e.g. script bindings.
+*/
+class PxSceneExt
+{
+public:
+
+	/**
+	\brief Writes the global poses of the scene's active actors to a contiguous buffer.
+
+	This is equivalent to calling PxRigidActor::getGlobalPose() for each actor returned by PxScene::getActiveActors().
+	Actors that are not rigid actors are skipped, and the output is compacted: entry i is the i-th active rigid actor,
+	which is not necessarily the i-th active actor.
+
+	The user index of each actor is read from PxActor::userData, which must then contain an integer index rather
+	than a pointer: userData = reinterpret_cast<void*>(size_t(index)).
+
+	\note PxSceneFlag::eENABLE_ACTIVE_ACTORS must be set, and the function must be called after PxScene::fetchResults().
+
+	\param[in] scene The scene to read the active actors from
+	\param[out] buffer Destination buffer
+	\param[in] bufferSize Number of entries in the buffer
+	\param[in] startIndex Index of the first active rigid actor to write. Use it to read the data in chunks when the buffer
+	is smaller than the number of active rigid actors, increasing it by the returned count after each call.
+
+	\return Number of entries written to the buffer.
+
+	\see PxScene::getActiveActors PxActiveActorTransform
+	*/
+	static PxU32	getActiveActorTransforms(PxScene& scene, PxActiveActorTransform* buffer, PxU32 bufferSize, PxU32 startIndex = 0);
+
+	/**
+	\brief Returns the number of active rigid actors of the scene.
+
+	Use it to size the buffer passed to getActiveActorTransforms().
+
+	\param[in] scene The scene to read the active actors from
+	\return Number of active rigid actors, i.e. the number of entries written by getActiveActorTransforms()
+	*/
+	static PxU32	getNbActiveActors(PxScene& scene);
+
+	/**
+	\brief Writes the contact reports of the last simulation step to a contiguous buffer.
+
+	This is a pull-based alternative to PxSimulationEventCallback::onContact(). Call PxScene::fetchResultsStart() to
+	retrieve the contact pair headers, call this function, then call PxScene::fetchResultsFinish(). One entry is written
+	per reported shape pair, in the order of the headers.
+
+	The user index of each actor is read from PxActor::userData, as in getActiveActorTransforms().
+
+	\param[in] pairHeaders Contact pair headers returned by PxScene::fetchResultsStart()
+	\param[in] nbPairHeaders Number of contact pair headers
+	\param[out] buffer Destination buffer
+	\param[in] bufferSize Number of entries in the buffer
+	\param[in] startIndex Index of the first shape pair to write. Use it to read the data in chunks when the buffer is
+	smaller than the number of shape pairs.
+
+	\return Number of entries written to the buffer.
+
+	\see PxScene::fetchResultsStart PxContactReportRecord getNbContactReports
+	*/
+	static PxU32	getContactReports(const PxContactPairHeader* pairHeaders, PxU32 nbPairHeaders, PxContactReportRecord* buffer, PxU32 bufferSize, PxU32 startIndex = 0);
+
+	/**
+	\brief Returns the number of shape pairs in a set of contact pair headers.
+
+	Use it to size the buffer passed to getContactReports().
+
+	\param[in] pairHeaders Contact pair headers returned by PxScene::fetchResultsStart()
+	\param[in] nbPairHeaders Number of contact pair headers
+	\return Number of shape pairs
+	*/
+	static PxU32	getNbContactReports(const PxContactPairHeader* pairHeaders, PxU32 nbPairHeaders);
+
+	/**
+	\brief Writes broken constraints to a contiguous buffer.
+
+	Call this from PxSimulationEventCallback::onConstraintBreak(), or use PxSimulationEventStream which does it for you.
+	One entry is written per broken constraint. The user index of joints and actors is read from their userData, as
+	in getActiveActorTransforms().
+
+	\param[in] constraints Broken constraints passed to PxSimulationEventCallback::onConstraintBreak()
+	\param[in] nbConstraints Number of broken constraints
+	\param[out] buffer Destination buffer
+	\param[in] bufferSize Number of entries in the buffer
+	\param[in] startIndex Index of the first constraint to write
+
+	\return Number of entries written to the buffer.
+
+	\see PxConstraintBreakRecord PxSimulationEventStream
+	*/
+	static PxU32	getConstraintBreakReports(const PxConstraintInfo* constraints, PxU32 nbConstraints, PxConstraintBreakRecord* buffer, PxU32 bufferSize, PxU32 startIndex = 0);
+
+	/**
+	\brief Adds an actor representing a streamed world region (terrain or building chunk) to the scene.
+
+	The region's shapes are grouped under a single BVH and stored as one compound in the scene query system,
+	instead of being inserted one by one in the static pruner. Adding or removing the region therefore does not
+	trigger a rebuild of the static pruner's tree, and queries first test the region's bounds before their shapes.
+
+	Remove the region with PxScene::removeActor(), which releases the whole compound at once.
+
+	\param[in] scene The scene to add the region to
+	\param[in] actor The region actor. All its scene query shapes must be attached before the call.
+	\param[in] bvh Prebuilt BVH for the actor's shapes, e.g. loaded from a stream cooked with
+	PxRigidActorExt::cookBVHFromActor(). If NULL, the BVH is built from the actor's shapes. The BVH is copied
+	and can be released after the call.
+
+	\return True on success
+
+	\see PxScene::addActor PxRigidActorExt::cookBVHFromActor PxBVH
+	*/
+	static bool		addRegion(PxScene& scene, PxRigidActor& actor, const PxBVH* bvh = NULL);
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
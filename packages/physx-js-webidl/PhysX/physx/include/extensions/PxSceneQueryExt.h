@@ -32,6 +32,7 @@
 #include "PxPhysXConfig.h"
 
 #include "PxScene.h"
+#include "geometry/PxGeometryHelpers.h"
 
 #if !PX_DOXYGEN
 namespace physx
@@ -47,6 +48,64 @@ typedef PxQueryCache			PxSceneQueryCache;
 typedef PxHitFlag				PxSceneQueryFlag;
 typedef PxHitFlags				PxSceneQueryFlags;
 
+class PxObjectIdTable;
+
+/**
+\brief Layout of the result slot written by PxSceneQueryExt::raycastClosest(), in floats.
+*/
+struct PxRaycastClosestSlot
+{
+	enum Enum
+	{
+		eACTOR_ID	= 0,	//!< Id of the hit actor, -1.0f if there is no hit
+		ePOSITION	= 1,	//!< Hit position (x,y,z)
+		eNORMAL		= 4,	//!< Hit normal (x,y,z)
+		eDISTANCE	= 7,	//!< Hit distance, -1.0f if there is no hit
+		eCOUNT		= 8		//!< Number of floats per slot
+	};
+};
+
+/**
+\brief Volume attenuating rays without blocking them, e.g. a smoke density grid.
+
+Used by PxSceneQueryExt::raycastOccluded(). The occluder returns the optical depth along the ray, i.e. the integral of its
+extinction, from which the opacity is 1 - exp(-depth).
+
+\see PxSceneQueryExt::raycastOccluded
+*/
+class PxVolumetricOccluder
+{
+public:
+	/**
+	\brief Integrates the optical depth along a ray segment.
+
+	The integration can stop as soon as maxOpticalDepth is reached, the remainder of the ray does not change the result.
+
+	\param[in] origin			Origin of the ray
+	\param[in] unitDir			Normalized direction of the ray
+	\param[in] distance			Length of the segment to integrate
+	\param[in] maxOpticalDepth	Depth at which the integration can stop
+	\param[out] stopDistance	Distance at which the integration stopped, distance if it ran to the end of the segment
+	\return Optical depth accumulated over [0, stopDistance]
+	*/
+	virtual PxReal	integrate(const PxVec3& origin, const PxVec3& unitDir, PxReal distance, PxReal maxOpticalDepth, PxReal& stopDistance) const = 0;
+
+protected:
+	virtual			~PxVolumetricOccluder()	{}
+};
+
+/**
+\brief Result of PxSceneQueryExt::raycastOccluded().
+*/
+struct PxVolumetricRaycastHit
+{
+	PxRaycastHit	block;		//!< Closest blocking hit, valid when hasBlock is true
+	PxReal			opacity;	//!< Opacity accumulated through the occluder, up to the blocking hit or the end of the ray
+	PxReal			distance;	//!< Distance at which the ray stopped: opacity threshold, blocking hit, or ray length
+	bool			hasBlock;	//!< True if a shape was hit before the opacity threshold was reached
+	bool			occluded;	//!< True if the opacity threshold was reached before any shape
+};
+
 /**
 \brief Utility functions for use with PxScene, related to scene queries.
 
@@ -145,6 +204,98 @@ public:
 									const PxSceneQueryFilterData& filterData = PxSceneQueryFilterData(),
 									PxSceneQueryFilterCallback* filterCall = NULL, const PxSceneQueryCache* cache = NULL);
 
+	/**
+	\brief Batched raycasts returning the closest blocking hit of each ray, with structure-of-arrays input and output buffers.
+
+	This is equivalent to calling raycastSingle() for each ray, but all inputs and outputs are read from and written to flat
+	arrays in a single call. Rays are internally processed in an order that groups rays with nearby origins, so that
+	consecutive queries traverse the same parts of the scene-query trees. Results are written at the index of the
+	corresponding input ray.
+
+	Output arrays are optional, pass NULL for data that is not needed. When a ray has no blocking hit, its distance is set
+	to -1.0f and its shape index to 0xffffffff. Position and normal are not written in that case.
+
+	The shape index of a hit is read from PxShape::userData, which must then contain an integer index rather than a
+	pointer: userData = reinterpret_cast<void*>(size_t(index)).
+
+	\param[in] scene			The scene
+	\param[in] nbRays			Number of rays
+	\param[in] origins			Ray origins, 3 floats (x,y,z) per ray
+	\param[in] unitDirs			Normalized ray directions, 3 floats (x,y,z) per ray
+	\param[in] distances		Ray lengths, 1 float per ray. Need to be larger than 0.
+	\param[out] hitPositions	Hit positions, 3 floats (x,y,z) per ray. Can be NULL.
+	\param[out] hitNormals		Hit normals, 3 floats (x,y,z) per ray. Can be NULL.
+	\param[out] hitDistances	Hit distances, 1 float per ray. Can be NULL.
+	\param[out] hitShapeIndices	Indices of hit shapes, 1 PxU32 per ray. Can be NULL.
+	\param[in] filterData		Filtering data and simple logic, shared by all rays.
+	\param[in] filterCall		Custom filtering logic (optional). Only used if the corresponding #PxHitFlag flags are set. If NULL, all hits are assumed to be blocking.
+	\return Number of rays with a blocking hit.
+
+	\see raycastSingle PxBatchQueryExt
+	*/
+	static PxU32 raycastBatch(	const PxScene& scene, PxU32 nbRays,
+								const PxReal* origins, const PxReal* unitDirs, const PxReal* distances,
+								PxReal* hitPositions, PxReal* hitNormals, PxReal* hitDistances, PxU32* hitShapeIndices,
+								const PxSceneQueryFilterData& filterData = PxSceneQueryFilterData(),
+								PxSceneQueryFilterCallback* filterCall = NULL);
+
+	/**
+	\brief Raycast returning the closest hit on a set of layers, written into a flat result slot.
+
+	This is meant for language bindings: the ray is passed by value, the layer test runs natively in a pre-filter callback,
+	and the result is written into PxRaycastClosestSlot::eCOUNT floats (e.g. a slot of a Float32Array over the wasm heap)
+	instead of being returned as a hit structure that needs to be wrapped and searched on the other side.
+
+	A shape passes the layer test when (shape query filter data word0 & layerMask) != 0, i.e. word0 holds the layers of
+	the shape. With layerMask = 0xffffffff the test is skipped and every shape is considered.
+
+	The actor id is read from the idTable when one is given, otherwise from PxActor::userData, which must then contain an
+	integer rather than a pointer: userData = reinterpret_cast<void*>(size_t(id)). Ids are stored as floats and are exact
+	up to 2^24. When there is no hit, the id and the distance are set to -1.0f and position and normal are not written.
+
+	\param[in] scene		The scene
+	\param[in] origin		Origin of the ray
+	\param[in] unitDir		Normalized direction of the ray
+	\param[in] distance		Length of the ray. Needs to be larger than 0.
+	\param[in] layerMask	Layers to test against, compared with word0 of the shapes' query filter data
+	\param[out] result		Result slot, PxRaycastClosestSlot::eCOUNT floats
+	\param[in] idTable		Table used to convert the hit actor to an id (optional)
+	\return True if a shape was hit
+
+	\see raycastSingle PxRaycastClosestSlot PxObjectIdTable
+	*/
+	static bool raycastClosest(	const PxScene& scene,
+								const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
+								PxU32 layerMask, PxReal* result, const PxObjectIdTable* idTable = NULL);
+
+	/**
+	\brief Raycast through a volumetric occluder, e.g. a line of sight test through smoke.
+
+	The closest blocking hit is found first, then the occluder is integrated up to that hit, stopping early once the
+	accumulated opacity reaches opacityThreshold. The ray is blocked either by the shape or by the occluder, whichever
+	comes first.
+
+	\param[in] scene				The scene
+	\param[in] occluder			Volumetric occluder (optional). If NULL, this is a plain raycastSingle().
+	\param[in] origin				Origin of the ray.
+	\param[in] unitDir				Normalized direction of the ray.
+	\param[in] distance				Length of the ray. Needs to be larger than 0.
+	\param[in] opacityThreshold		Opacity in (0, 1] at which the occluder blocks the ray. With 1, the occluder never blocks and only reports its opacity.
+	\param[out] hit					Raycast hit information.
+	\param[in] outputFlags			Specifies which properties should be written to the blocking hit
+	\param[in] filterData			Filtering data and simple logic.
+	\param[in] filterCall			Custom filtering logic (optional). Only used if the corresponding #PxHitFlag flags are set. If NULL, all hits are assumed to be blocking.
+	\return True if the ray is blocked, by a shape or by the occluder.
+
+	\see PxVolumetricOccluder PxVolumetricRaycastHit raycastSingle
+	*/
+	static bool raycastOccluded(const PxScene& scene, const PxVolumetricOccluder* occluder,
+								const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
+								PxReal opacityThreshold, PxVolumetricRaycastHit& hit,
+								PxSceneQueryFlags outputFlags = PxHitFlag::eDEFAULT,
+								const PxSceneQueryFilterData& filterData = PxSceneQueryFilterData(),
+								PxSceneQueryFilterCallback* filterCall = NULL);
+
 	/**
 	\brief Sweep returning any blocking hit, not necessarily the closest.
 	
@@ -271,6 +422,42 @@ public:
 									const PxSceneQueryFilterData& filterData = PxSceneQueryFilterData(),
 									PxSceneQueryFilterCallback* filterCall = NULL);
 
+	/**
+	\brief Batched overlap tests writing (query index, shape index) pairs into a flat buffer.
+
+	This is equivalent to calling overlapMultiple() for each query volume, but no PxOverlapHit is built and no hit
+	callback is invoked. Query volumes are grouped by spatial proximity, and each group traverses the scene-query
+	trees once with the bounds of the whole group. The returned candidates are then culled against the bounds of the
+	individual volumes of the group, 4 at a time, and only the remaining pairs run the exact overlap test.
+
+	Each output pair takes 2 PxU32: the index of the query volume in the input arrays, followed by the index of the
+	overlapping shape. The shape index is read from PxShape::userData, which must then contain an integer index
+	rather than a pointer. Pairs are written in no particular order.
+
+	By default only dynamic shapes are tested, which is the common case for gameplay area queries. Pass
+	PxQueryFlag::eSTATIC in the filter data to include static shapes.
+
+	\note The pre-filter of filterCall is called once per candidate shape and query group, i.e. before the shape is
+	tested against the individual query volumes. The post-filter is never called.
+
+	\param[in] scene			The scene
+	\param[in] nbQueries		Number of query volumes
+	\param[in] geometries		Geometries of the query volumes (supported types are: box, sphere, capsule, convex).
+	\param[in] poses			Poses of the query volumes.
+	\param[out] pairs			Buffer receiving the overlapping pairs, 2 PxU32 per pair.
+	\param[in] maxNbPairs		Capacity of the pairs buffer, in pairs.
+	\param[in] filterData		Filtering data and simple logic, shared by all queries.
+	\param[in] filterCall		Custom filtering logic (optional). Only used if PxQueryFlag::ePREFILTER is set.
+	\return Number of pairs in the buffer, or -1 if the buffer overflowed.
+
+	\see overlapMultiple
+	*/
+	static PxI32 overlapBatch(	const PxScene& scene, PxU32 nbQueries,
+								const PxGeometryHolder* geometries, const PxTransform* poses,
+								PxU32* pairs, PxU32 maxNbPairs,
+								const PxSceneQueryFilterData& filterData = PxSceneQueryFilterData(PxQueryFlag::eDYNAMIC),
+								PxSceneQueryFilterCallback* filterCall = NULL);
+
 	/**
 	\brief Test returning, for a given geometry, any overlapping object in the scene.
 	
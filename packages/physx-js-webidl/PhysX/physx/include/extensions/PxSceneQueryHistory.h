@@ -0,0 +1,172 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_SCENE_QUERY_HISTORY_H
+#define PX_SCENE_QUERY_HISTORY_H
+
+#include "foundation/PxTransform.h"
+#include "PxQueryReport.h"
+#include "PxQueryFiltering.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxGeometry;
+	class PxRigidActor;
+	class SceneQueryHistoryInternal;
+
+	/**
+	\brief Scene query history, for lag-compensated queries against past poses of a set of actors.
+
+	The history keeps the shape poses and bounds of tracked actors for the last N recorded frames, in a ring buffer.
+	Raycasts and sweeps can then target any timestamp covered by the history: poses are interpolated between the two
+	recorded frames surrounding it, and the query runs against the interpolated shapes only. The scene itself is never
+	modified, so there is no need to move actors back and forth, and the scene's pruners are not touched.
+
+	Typical use is server-side hit validation, tracking the hitbox actors of players:
+
+	- call recordFrame() once per simulation step, after PxScene::fetchResults()
+	- validate a hit with raycast() or sweep(), at the timestamp the client saw when firing
+
+	Queries only see tracked actors. Combine them with regular scene queries for the static world.
+
+	Queries are read-only and can run concurrently with each other, but not with recordFrame(), addActor(),
+	removeActor() or clear(). Tracked actors must be removed from the history before they are released.
+
+	\see PxSceneQueryExt
+	*/
+	class PxSceneQueryHistory
+	{
+		public:
+		/**
+		\param[in] nbFrames	Number of frames kept in the history. The oldest frame is overwritten when the history is full.
+		*/
+										PxSceneQueryHistory(PxU32 nbFrames);
+										~PxSceneQueryHistory();
+
+		/**
+		\brief Starts tracking an actor.
+
+		The actor's scene query shapes (PxShapeFlag::eSCENE_QUERY_SHAPE) are recorded from the next call to recordFrame().
+		Shapes attached to or detached from the actor later are not picked up: remove and add the actor again.
+
+		\param[in] actor	Actor to track
+		\return False if the actor is already tracked
+		*/
+				bool					addActor(const PxRigidActor& actor);
+
+		/**
+		\brief Stops tracking an actor. Its past poses are removed from the history.
+
+		\param[in] actor	Actor to remove
+		\return False if the actor was not tracked
+		*/
+				bool					removeActor(const PxRigidActor& actor);
+
+		/**
+		\brief Returns the number of tracked actors.
+		*/
+				PxU32					getNbActors()	const;
+
+		/**
+		\brief Records the current poses of all tracked shapes.
+
+		\param[in] timestamp	Time of the frame, in the caller's time unit. Must be greater than the timestamp of the previous frame.
+		\return False if the timestamp is not increasing. The frame is not recorded in this case.
+		*/
+				bool					recordFrame(PxF64 timestamp);
+
+		/**
+		\brief Removes all recorded frames. Tracked actors are kept.
+		*/
+				void					clear();
+
+		/**
+		\brief Returns the number of recorded frames, at most the capacity passed to the constructor.
+		*/
+				PxU32					getNbFrames()	const;
+
+		/**
+		\brief Returns the range of timestamps covered by the history.
+
+		\return False if no frame has been recorded
+		*/
+				bool					getTimeRange(PxF64& oldest, PxF64& newest)	const;
+
+		/**
+		\brief Raycast against the tracked shapes, as they were at a given time.
+
+		Timestamps outside of the recorded range are clamped to it. Shapes are filtered with PxQueryFilterData::data as
+		in scene queries (a shape passes if any of the words are shared, or if the query words are all zero) and
+		then with the pre-filter callback, if any. Only blocking hits are reported.
+
+		\param[in] origin		Origin of the ray
+		\param[in] unitDir		Normalized direction of the ray
+		\param[in] distance		Length of the ray
+		\param[in] timestamp	Time to query
+		\param[out] hit			Closest hit. Only valid if the function returns true.
+		\param[in] hitFlags		Hit flags, see PxHitFlag
+		\param[in] filterData	Filter data, only the data member is used
+		\param[in] filterCall	Optional pre-filter callback. eNONE skips a shape, other values are treated as eBLOCK.
+		\return True if a tracked shape was hit
+		*/
+				bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal distance, PxF64 timestamp,
+												PxRaycastHit& hit, PxHitFlags hitFlags = PxHitFlag::eDEFAULT,
+												const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL)	const;
+
+		/**
+		\brief Sweep against the tracked shapes, as they were at a given time.
+
+		See raycast() for timestamps and filtering. The swept geometry must be supported by PxGeometryQuery::sweep().
+
+		\param[in] geometry		Geometry to sweep
+		\param[in] pose			Initial pose of the swept geometry
+		\param[in] unitDir		Normalized direction of the sweep
+		\param[in] distance		Length of the sweep
+		\param[in] timestamp	Time to query
+		\param[out] hit			Closest hit. Only valid if the function returns true.
+		\param[in] hitFlags		Hit flags, see PxHitFlag
+		\param[in] filterData	Filter data, only the data member is used
+		\param[in] filterCall	Optional pre-filter callback. eNONE skips a shape, other values are treated as eBLOCK.
+		\param[in] inflation	Inflation of the swept geometry
+		\return True if a tracked shape was hit
+		*/
+				bool					sweep(const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, PxReal distance, PxF64 timestamp,
+											  PxSweepHit& hit, PxHitFlags hitFlags = PxHitFlag::eDEFAULT,
+											  const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
+											  PxReal inflation = 0.0f)	const;
+
+		private:
+				SceneQueryHistoryInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -56,6 +56,94 @@ namespace physx
 	*/
 	PxSceneQuerySystem* PxCreateExternalSceneQuerySystem(const PxSceneQueryDesc& desc, PxU64 contextID);
 
+	/**
+	\brief Creates a scene query system wrapper allowing queries to run on other threads while the scene simulates.
+
+	The pruners of a scene query system are not modified during PxScene::simulate(): user updates are buffered by the scene
+	until fetchResults(), and asynchronous tree rebuilds work on a separate tree. Queries issued directly on the scene query
+	system during the simulation thus see the state of the previous frame. However fetchResults() then updates the pruners
+	in place, and queries cannot safely run at that time.
+
+	The returned wrapper forwards all calls to the given system and protects them with a read-write lock. Queries (raycast,
+	sweep, overlap) are readers and can run concurrently with each other. The bounds synchronization done in fetchResults()
+	is a single writer operation, so that a query returns either the previous frame's results or the new frame's results,
+	but never a mix of both. Individual scene modifications (adding or removing actors, etc) are separate writes.
+
+	Pass the wrapper to PxSceneDesc::sceneQuerySystem, and call its query functions directly (not through PxScene, which does
+	not allow concurrent reads and writes) from the threads that need to overlap with the simulation step.
+
+	\note The external scene query system reads shape data through the PxShape API. In builds with API thread checks enabled,
+	these reads can be reported as overlapping with simulate() or fetchResults(). The wrapper's lock makes them safe.
+
+	\param[in] sqSystem	Scene query system to wrap, e.g. created with PxCreateExternalSceneQuerySystem(). The wrapper takes
+							ownership of the creation reference: releasing the wrapper releases the wrapped system.
+
+	\return	A scene query system wrapper
+
+	\see PxSceneQuerySystem PxCreateExternalSceneQuerySystem PxSceneDesc::sceneQuerySystem
+	*/
+	PxSceneQuerySystem* PxCreateConcurrentSceneQuerySystem(PxSceneQuerySystem& sqSystem);
+
+	/**
+	\brief A scene query system wrapper caching the results of repeated raycasts.
+
+	\see PxCreateCachedSceneQuerySystem
+	*/
+	class PxCachedSceneQuerySystem : public PxSceneQuerySystem
+	{
+		protected:
+						PxCachedSceneQuerySystem()	{}
+		virtual			~PxCachedSceneQuerySystem()	{}
+
+		public:
+
+		/**
+		\brief Discards all cached results.
+
+		The cache is automatically invalidated when shapes are added, removed or moved. It is not aware of changes that do
+		not go through the scene query system though, such as changes to a shape's query filter data or PxShapeFlags. Call
+		this function after such changes.
+		*/
+		virtual	void	invalidateCache()	= 0;
+
+		/**
+		\brief Retrieves the number of raycasts answered from the cache, and the number of cacheable raycasts that were not.
+
+		Raycasts that cannot be cached at all (see PxCreateCachedSceneQuerySystem()) are not counted.
+
+		\param[out]	nbHits		Number of raycasts answered from the cache
+		\param[out]	nbMisses	Number of cacheable raycasts that traversed the pruners
+		\param[in]	reset		Reset the counters after reading them
+		*/
+		virtual	void	getCacheStatistics(PxU32& nbHits, PxU32& nbMisses, bool reset = false)	= 0;
+	};
+
+	/**
+	\brief Creates a scene query system wrapper caching the results of repeated raycasts.
+
+	Raycasts that are identical from one call to the next (same origin, direction, distance, hit flags, filter data and
+	query flags, compared bit for bit) return the previously computed blocking hit without traversing the pruners.
+
+	Only raycasts without touch buffer (PxRaycastBuffer with no touches, i.e. closest or any blocking hit), without
+	filter callback and without PxQueryCache are cached. Other queries, sweeps and overlaps are forwarded unchanged.
+
+	Cached results are invalidated when the static timestamp of the wrapped system changes, when the hit shape is
+	updated or removed, and when any shape is added, updated or synchronized with new bounds that cross the ray's segment
+	up to the cached hit. Any change to a compound flushes the whole cache.
+
+	Pass the wrapper to PxSceneDesc::sceneQuerySystem. The wrapper can be combined with PxCreateConcurrentSceneQuerySystem().
+
+	\param[in] sqSystem		Scene query system to wrap, e.g. created with PxCreateExternalSceneQuerySystem(). The wrapper takes
+								ownership of the creation reference: releasing the wrapper releases the wrapped system.
+	\param[in] maxNbEntries	Number of cache entries, rounded up to a power of two. Entries are direct-mapped: a new result
+								replaces the previous entry with the same hash slot.
+
+	\return	A scene query system wrapper
+
+	\see PxCachedSceneQuerySystem PxCreateExternalSceneQuerySystem PxSceneDesc::sceneQuerySystem
+	*/
+	PxCachedSceneQuerySystem* PxCreateCachedSceneQuerySystem(PxSceneQuerySystem& sqSystem, PxU32 maxNbEntries = 1024);
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
@@ -0,0 +1,187 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_SCENE_SNAPSHOT_H
+#define PX_SCENE_SNAPSHOT_H
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class SceneSnapshotInternal;
+
+	/**
+	\brief Quantization parameters for PxSceneSnapshot::computeDiff().
+
+	Positions and velocities are stored as signed fixed-point integers, i.e. a component is transmitted as
+	round(value / precision) clamped to the range of nbBits signed bits. Rotations use the smallest-three encoding: the
+	largest quaternion component is dropped and the other three are stored with rotationBits each.
+	*/
+	struct PxSceneDiffParams
+	{
+		PxReal	positionPrecision;	//!< Position quantization step. Default: 1/1024 (about 1mm)
+		PxU32	positionBits;		//!< Bits per position component, [2, 24]. Default: 24, i.e. +/- 8192 at default precision
+		PxU32	rotationBits;		//!< Bits per smallest-three quaternion component, [2, 16]. Default: 11
+		PxReal	velocityPrecision;	//!< Linear & angular velocity quantization step. Default: 1/256
+		PxU32	velocityBits;		//!< Bits per velocity component, [2, 24]. Default: 16, i.e. +/- 128 at default precision
+
+		PxSceneDiffParams() :
+			positionPrecision	(1.0f/1024.0f),
+			positionBits		(24),
+			rotationBits		(11),
+			velocityPrecision	(1.0f/256.0f),
+			velocityBits		(16)
+		{
+		}
+
+		bool	isValid()	const
+		{
+			return positionPrecision>0.0f && velocityPrecision>0.0f
+				&& positionBits>=2 && positionBits<=24
+				&& rotationBits>=2 && rotationBits<=16
+				&& velocityBits>=2 && velocityBits<=24;
+		}
+	};
+
+	/**
+	\brief Captures and restores the dynamic state of a scene.
+
+	A snapshot contains, for each object currently in the scene:
+	- rigid dynamics: global pose, linear and angular velocities, wake counter and sleep state. Only the pose is
+	  stored for kinematic actors and actors with PxActorFlag::eDISABLE_SIMULATION.
+	- articulations: root pose and velocities, joint positions and velocities, wake counter and sleep state.
+	- constraints: the PxConstraintFlag::eBROKEN flag.
+
+	The data is written to a single contiguous buffer with no pointers in it, so it can be kept in a ring buffer for
+	rollback, or sent to another process for server migration. Objects are identified by their order in
+	PxScene::getActors(), PxScene::getArticulations() and PxScene::getConstraints(): the snapshot can only be restored
+	to a scene with the same objects added in the same order, for example the original scene or a scene created from
+	the same serialized collection. A mismatch in object counts is detected and the restore is rejected.
+
+	Limitations:
+	- contact caches (warm-starting impulses, persistent contact manifolds) are not part of the public API and are not
+	  captured. They are rebuilt by the next simulation step, so a restored scene does not replay bit-exactly.
+	- broken constraints cannot be repaired. Restoring a snapshot in which a now broken constraint was intact emits a
+	  warning and leaves the constraint broken.
+	- forces accumulated with addForce() / addTorque() and pending kinematic targets are not captured.
+
+	For network replication, computeDiff() encodes the rigid dynamics that changed between two snapshots into a
+	bit-packed buffer, and applyDiff() writes that state to a scene on the receiving side. A body is considered changed
+	when its quantized state differs, so bodies that did not move by more than the transmitted precision cost nothing.
+
+	capture(), restore() and applyDiff() must not be called while the scene is simulating.
+	*/
+	class PxSceneSnapshot
+	{
+		public:
+							PxSceneSnapshot(PxScene& scene);
+							~PxSceneSnapshot();
+
+			/**
+			\brief Captures the current state of the scene to the internal buffer.
+
+			\return Size of the captured data in bytes
+			*/
+			PxU32			capture();
+
+			/**
+			\brief Returns the data captured by the last capture() call, or set with setData().
+
+			\param[out] size	size of the data in bytes
+			\return Captured data, valid until the next capture() or setData() call
+			*/
+			const void*		getData(PxU32& size)	const;
+
+			/**
+			\brief Replaces the internal buffer with data captured by another PxSceneSnapshot, e.g. in another process.
+
+			\param[in] data	captured data, as returned by getData()
+			\param[in] size	size of the data in bytes
+			\return False if the data is not a valid snapshot
+			*/
+			bool			setData(const void* data, PxU32 size);
+
+			/**
+			\brief Restores the scene state from the internal buffer.
+
+			\return False if there is no data, or if the data does not match the objects in the scene
+			*/
+			bool			restore();
+
+			/**
+			\brief Encodes the rigid dynamics whose quantized state differs between base and this snapshot.
+
+			Each changed body is written with its index, sleep state, quantized position, smallest-three rotation and, unless
+			sleeping or kinematic, quantized linear and angular velocities. If base is empty or captured from a different set
+			of bodies, all bodies are written.
+
+			\param[in] base	snapshot the receiver already has. Can be this snapshot's previous capture, see captureDiff()
+			\param[in] params	quantization parameters
+			\return Size of the diff in bytes, 0 if the parameters are invalid or this snapshot is empty
+			*/
+			PxU32			computeDiff(const PxSceneSnapshot& base, const PxSceneDiffParams& params = PxSceneDiffParams());
+
+			/**
+			\brief Captures the scene and encodes the changes since the previous capture() or captureDiff() call.
+
+			\param[in] params	quantization parameters
+			\return Size of the diff in bytes
+			*/
+			PxU32			captureDiff(const PxSceneDiffParams& params = PxSceneDiffParams());
+
+			/**
+			\brief Returns the diff computed by the last computeDiff() or captureDiff() call.
+
+			\param[out] size	size of the diff in bytes
+			\return Diff data, valid until the next computeDiff() or captureDiff() call
+			*/
+			const void*		getDiff(PxU32& size)	const;
+
+			/**
+			\brief Applies a diff to the scene.
+
+			The scene must contain the same rigid dynamics, in the same order, as the scene the diff was computed from. Awake
+			bodies are woken up with the default wake counter, since wake counters are not transmitted.
+
+			\param[in] diff	diff data, as returned by getDiff()
+			\param[in] size	size of the diff in bytes
+			\return False if the diff is invalid or does not match the scene
+			*/
+			bool			applyDiff(const void* diff, PxU32 size);
+
+		private:
+			SceneSnapshotInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,111 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_SCENE_STEPPER_H
+#define PX_SCENE_STEPPER_H
+
+#include "extensions/PxSceneExt.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class SceneStepperInternal;
+
+	/**
+	\brief Fixed time-step scheduler with interpolated poses output.
+
+	The stepper accumulates the elapsed frame time and runs as many fixed sub-steps as needed, with simulate() and
+	fetchResults() calls. The remaining time is used to interpolate the poses of the moved actors between the last
+	two sub-steps, for rendering.
+
+	Usage:
+	- call advance() once per frame with the elapsed frame time
+	- call getTransforms() to retrieve the simulated and interpolated poses of the actors that moved during that call
+
+	The user index of each actor is read from PxActor::userData, as in PxSceneExt::getActiveActorTransforms(). The
+	stepper keeps per-actor data in arrays indexed by user index, so indices should be small and dense.
+
+	\note PxSceneFlag::eENABLE_ACTIVE_ACTORS must be set.
+
+	\see PxSceneExt::getActiveActorTransforms PxActiveActorTransform
+	*/
+	class PxSceneStepper
+	{
+		public:
+			/**
+			\param[in] scene			scene to simulate
+			\param[in] stepSize			fixed sub-step duration
+			\param[in] maxNbSubsteps	maximum number of sub-steps per advance() call. Time in excess is dropped, to avoid a spiral of death when the simulation can't keep up.
+			*/
+							PxSceneStepper(PxScene& scene, PxReal stepSize, PxU32 maxNbSubsteps);
+							~PxSceneStepper();
+
+			/**
+			\brief Runs the sub-steps for the elapsed time.
+
+			\param[in] elapsedTime	elapsed time since the last call
+			\return Number of sub-steps that have been run
+			*/
+			PxU32			advance(PxReal elapsedTime);
+
+			/**
+			\brief Returns the interpolation factor between the last two sub-steps, in [0, 1).
+
+			This is the fraction of a sub-step that has been accumulated but not simulated yet.
+			*/
+			PxReal			getInterpolationFactor()	const;
+
+			/**
+			\brief Returns the number of actors that moved during the last advance() call.
+
+			Use it to size the buffers passed to getTransforms().
+			*/
+			PxU32			getNbMovedActors()	const;
+
+			/**
+			\brief Writes the poses of the actors that moved during the last advance() call.
+
+			\param[out] simulated		poses at the end of the last sub-step. Can be NULL.
+			\param[out] interpolated	poses interpolated between the last two sub-steps with getInterpolationFactor(). Can be NULL.
+			\param[in] bufferSize		number of entries in each buffer
+			\param[in] startIndex		index of the first moved actor to write, to read the data in chunks
+
+			\return Number of entries written to each buffer.
+			*/
+			PxU32			getTransforms(PxActiveActorTransform* simulated, PxActiveActorTransform* interpolated, PxU32 bufferSize, PxU32 startIndex = 0)	const;
+
+		private:
+			SceneStepperInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
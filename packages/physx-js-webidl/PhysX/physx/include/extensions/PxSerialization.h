@@ -49,6 +49,62 @@ namespace physx
 {
 #endif
 
+class PxCpuDispatcher;
+
+/**
+\brief Incremental deserializer for the chunked binary format written by PxSerialization::serializeCollectionToBinaryChunks.
+
+Bytes can be passed in pieces of any size as they arrive, for example while downloading. Each chunk is deserialized as soon
+as it is complete, into its own collection, so its objects can be used (e.g. added to a scene) before the rest of the stream
+is received. References to objects of earlier chunks are resolved through their ids.
+
+The deserializer owns the memory of the deserialized objects. All objects must be released before the deserializer.
+
+\see PxSerialization::createBinaryChunkDeserializer, PxSerialization::serializeCollectionToBinaryChunks
+*/
+class PxBinaryChunkDeserializer
+{
+public:
+	/**
+	\brief Passes the next bytes of the stream.
+
+	Deserializes all the chunks completed by these bytes.
+
+	\param[in] data Next bytes of the stream
+	\param[in] size Number of bytes
+	\return false if the stream is invalid or a chunk failed to deserialize. The deserializer ignores further data after an error.
+	*/
+	virtual	bool			addData(const void* data, PxU32 size) = 0;
+
+	/**
+	\brief Returns true once all the chunks of the stream have been deserialized.
+	*/
+	virtual	bool			isComplete() const = 0;
+
+	/**
+	\brief Returns the number of chunks deserialized so far.
+	*/
+	virtual	PxU32			getNbCollections() const = 0;
+
+	/**
+	\brief Returns the collection holding the objects of a deserialized chunk. Chunks are in stream order.
+
+	The collection is owned by the deserializer. It contains the ids of the objects referenced by later chunks, and of the
+	objects which had an id in the serialized collection.
+
+	\param[in] index Chunk index, smaller than getNbCollections()
+	*/
+	virtual	PxCollection*	getCollection(PxU32 index) const = 0;
+
+	/**
+	\brief Releases the deserializer, its collections, and the memory of the deserialized objects.
+	*/
+	virtual	void			release() = 0;
+
+protected:
+	virtual					~PxBinaryChunkDeserializer() {}
+};
+
 /**
 \brief Utility functions for serialization
 
@@ -178,13 +234,18 @@ public:
 	which is defined by "PX_PHYSICS_VERSION_MAJOR.PX_PHYSICS_VERSION_MINOR.PX_PHYSICS_VERSION_BUGFIX-PX_BINARY_SERIAL_VERSION".
 	For a list of compatible sdk releases refer to the documentation of PX_BINARY_SERIAL_VERSION.
 
+	Objects are created in the order in which they were serialized, since the extra data of each object follows
+	the extra data of the previous one. When triangle mesh sharing is enabled (see PxSerializationRegistry::setTriangleMeshSharing),
+	the mesh content hashes are computed on the threads of the optional dispatcher.
+
 	\param[in] memBlock Pointer to memory block containing the serialized collection
 	\param[in] sr PxSerializationRegistry instance with information about registered classes.
 	\param[in] externalRefs Collection to resolve external dependencies
+	\param[in] dispatcher Optional CPU dispatcher used for per-object work that doesn't depend on the object order. NULL processes everything on the calling thread.
 
 	\see PxCollection, PxSerialization::complete, PxSerialization::serializeCollectionToBinary, PxSerializationRegistry, PX_BINARY_SERIAL_VERSION
 	*/
-	static	PxCollection*	createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL);
+	static	PxCollection*	createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL, PxCpuDispatcher* dispatcher = NULL);
 
 	/**
 	\brief Serializes a physics collection to an XML output stream.
@@ -232,6 +293,39 @@ public:
 	*/
 	static	bool			serializeCollectionToBinary(PxOutputStream& outputStream, PxCollection& collection, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL, bool exportNames = false );
 
+	/**
+	\brief Serializes a collection to a chunked binary stream, which can be deserialized incrementally.
+
+	The objects are split into chunks of about maxObjectsPerChunk objects. Objects come after the objects they require, and
+	subordinate objects and exclusive shapes stay in the same chunk as their owner. Each chunk is stored as a binary collection
+	(see serializeCollectionToBinary) whose external references are the objects of earlier chunks and of externalRefs.
+
+	Objects referenced from a later chunk need an id. Objects without one in the collection are assigned one, which is
+	not used by the collection or by externalRefs. These ids are only stored in the stream, the collection is not modified.
+
+	\param[out] outputStream into which the collection is serialized
+	\param[in] collection Collection to be serialized. The collection needs to be complete with respect to the externalRefs collection.
+	\param[in] sr PxSerializationRegistry instance with information about registered classes.
+	\param[in] maxObjectsPerChunk Target number of objects per chunk. Groups of objects that must stay together can exceed it.
+	\param[in] externalRefs Collection used to resolve external dependencies
+	\param[in] exportNames Specifies whether object names are serialized
+	\return Whether serialization was successful
+
+	\see PxBinaryChunkDeserializer, PxSerialization::createBinaryChunkDeserializer, PxSerialization::serializeCollectionToBinary
+	*/
+	static	bool			serializeCollectionToBinaryChunks(PxOutputStream& outputStream, PxCollection& collection, PxSerializationRegistry& sr, PxU32 maxObjectsPerChunk, const PxCollection* externalRefs = NULL, bool exportNames = false);
+
+	/**
+	\brief Creates a deserializer for the chunked binary format written by serializeCollectionToBinaryChunks.
+
+	\param[in] sr PxSerializationRegistry instance with information about registered classes. Must stay valid while the deserializer is used.
+	\param[in] externalRefs Collection to resolve external dependencies. Must stay valid while the deserializer is used.
+	\return The deserializer
+
+	\see PxBinaryChunkDeserializer, PxSerialization::serializeCollectionToBinaryChunks
+	*/
+	static	PxBinaryChunkDeserializer*	createBinaryChunkDeserializer(PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL);
+
 	/**
 	\brief Creates an application managed registry for serialization.
 	
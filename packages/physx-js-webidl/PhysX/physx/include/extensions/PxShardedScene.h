@@ -0,0 +1,132 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_SHARDED_SCENE_H
+#define PX_SHARDED_SCENE_H
+
+#include "common/PxPhysXCommonConfig.h"
+#include "foundation/PxBounds3.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxPhysics;
+	class PxScene;
+	class PxSceneDesc;
+	class PxRigidDynamic;
+	class ShardedSceneInternal;
+
+	/**
+	\brief Sharded scene manager.
+
+	The serial stages of a single scene limit how well it scales with the number of cores. This class partitions the
+	world into several scenes (shards), each covering a user-defined region. The shards are simulated concurrently,
+	on the CPU dispatcher they share.
+
+	Dynamic actors added to the manager are owned by the shard containing their position. After each step:
+	- actors that moved into another shard's region are handed off to that shard
+	- actors whose bounds are within the ghost margin of another shard's region are mirrored there as kinematic ghosts,
+	so that objects on both sides of a boundary can interact. Ghosts are driven by kinematic targets, so the
+	interaction is one-way: ghosts push the objects of their shard but are not pushed back.
+
+	Ghosts share the owner's userData, so that reports from any shard can be mapped back to the same user object.
+
+	This implementation has some limitations:
+	- static actors are not managed. Add them directly to each shard whose region they overlap, see getShard().
+	- constrained actors (joints, articulations) must not cross shard boundaries.
+
+	\note The shards are created from the same scene descriptor, which must include a CPU dispatcher.
+	*/
+	class PxShardedScene
+	{
+		public:
+			/**
+			\param[in] physics		physics SDK
+			\param[in] desc			descriptor used to create each shard
+			\param[in] shardBounds	region covered by each shard. Regions should not overlap. Actors outside all regions stay in their current shard.
+			\param[in] nbShards		number of shards
+			\param[in] ghostMargin	distance to a shard's region within which ghosts are created
+			*/
+							PxShardedScene(PxPhysics& physics, const PxSceneDesc& desc, const PxBounds3* shardBounds, PxU32 nbShards, PxReal ghostMargin);
+							~PxShardedScene();
+
+			/**
+			\brief Returns the number of shards.
+			*/
+			PxU32			getNbShards()	const;
+
+			/**
+			\brief Returns a shard's scene.
+
+			\param[in] index	shard index
+			\return Shard's scene
+			*/
+			PxScene*		getShard(PxU32 index)	const;
+
+			/**
+			\brief Adds a dynamic actor to the shard containing its position.
+
+			\param[in] actor	actor to add. It must not be in a scene already.
+			\return True if success
+			*/
+			bool			addActor(PxRigidDynamic& actor);
+
+			/**
+			\brief Removes a dynamic actor and its ghosts.
+
+			\param[in] actor	actor to remove
+			\return True if success
+			*/
+			bool			removeActor(PxRigidDynamic& actor);
+
+			/**
+			\brief Returns the shard owning an actor.
+
+			\param[in] actor	actor added with addActor()
+			\return Shard index, or 0xffffffff if the actor is not managed by this object
+			*/
+			PxU32			getOwnerShard(const PxRigidDynamic& actor)	const;
+
+			/**
+			\brief Simulates all the shards concurrently, then hands actors off and updates ghosts.
+
+			This is equivalent to calling simulate() on all shards, then fetchResults(true) on all shards.
+
+			\param[in] elapsedTime	time step
+			*/
+			void			simulate(PxReal elapsedTime);
+
+		private:
+			ShardedSceneInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_SIMULATION_EVENT_STREAM_H
+#define PX_SIMULATION_EVENT_STREAM_H
+
+#include "PxSimulationEventCallback.h"
+#include "extensions/PxSceneExt.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class SimulationEventStreamInternal;
+
+	/**
+	\brief Simulation event callback that records contact reports and broken constraints into flat buffers.
+
+	Set it as the scene's simulation event callback. During PxScene::fetchResults(), every reported shape pair is
+	written as a PxContactReportRecord and every broken constraint as a PxConstraintBreakRecord. Once fetchResults()
+	returns, the records of the step can be read as contiguous arrays, for example as typed arrays in bindings,
+	instead of being delivered through one callback per event.
+
+	Records accumulate until clear() is called, so that several substeps can be read at once. Events that are not
+	recorded (triggers, wake, sleep, advance), as well as the recorded ones, are forwarded to an optional user callback.
+
+	\see PxSceneExt::getContactReports PxSceneExt::getConstraintBreakReports
+	*/
+	class PxSimulationEventStream : public PxSimulationEventCallback
+	{
+		public:
+		/**
+		\param[in] forward	Optional callback receiving all events after they have been recorded
+		*/
+												PxSimulationEventStream(PxSimulationEventCallback* forward = NULL);
+		virtual									~PxSimulationEventStream();
+
+		/**
+		\brief Returns the contact reports recorded since the last call to clear().
+		*/
+				const PxContactReportRecord*	getContactReports()			const;
+				PxU32							getNbContactReports()		const;
+
+		/**
+		\brief Returns the broken constraints recorded since the last call to clear().
+		*/
+				const PxConstraintBreakRecord*	getConstraintBreaks()		const;
+				PxU32							getNbConstraintBreaks()		const;
+
+		/**
+		\brief Discards all recorded events. Memory is kept for the next steps.
+		*/
+				void							clear();
+
+		// PxSimulationEventCallback
+		virtual	void							onConstraintBreak(PxConstraintInfo* constraints, PxU32 count)	PX_OVERRIDE;
+		virtual	void							onWake(PxActor** actors, PxU32 count)	PX_OVERRIDE;
+		virtual	void							onSleep(PxActor** actors, PxU32 count)	PX_OVERRIDE;
+		virtual	void							onContact(const PxContactPairHeader& pairHeader, const PxContactPair* pairs, PxU32 nbPairs)	PX_OVERRIDE;
+		virtual	void							onTrigger(PxTriggerPair* pairs, PxU32 count)	PX_OVERRIDE;
+		virtual	void							onAdvance(const PxRigidBody*const* bodyBuffer, const PxTransform* poseBuffer, const PxU32 count)	PX_OVERRIDE;
+		//~PxSimulationEventCallback
+
+		private:
+				SimulationEventStreamInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,174 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_STATIC_VOXELIZER_H
+#define PX_STATIC_VOXELIZER_H
+
+#include "foundation/PxBounds3.h"
+#include "PxShape.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class PxCpuDispatcher;
+	class StaticVoxelizerInternal;
+
+	/**
+	\brief Parameters of PxStaticVoxelizer::voxelize().
+	*/
+	struct PxStaticVoxelizerParams
+	{
+		PxStaticVoxelizerParams() :
+			region		(PxBounds3::empty()),
+			voxelSize	(0.25f),
+			solid		(false),
+			shapeFlags	(PxShapeFlag::eSIMULATION_SHAPE)
+		{
+		}
+
+		/**
+		\brief World-space region to voxelize. Its minimum is the corner of voxel (0, 0, 0).
+		*/
+		PxBounds3		region;
+
+		/**
+		\brief Size of the cubic voxels.
+		*/
+		PxReal			voxelSize;
+
+		/**
+		\brief Solid or surface voxelization.
+
+		In surface mode, triangle meshes only mark the voxels touching their triangles. In solid mode, the voxels inside
+		closed triangle meshes are marked as well (using ray parity along each column) and heightfields fill their
+		columns down to the bottom of the region. Primitives and convex meshes are always solid.
+		*/
+		bool			solid;
+
+		/**
+		\brief Only shapes with at least one of these flags are voxelized.
+		*/
+		PxShapeFlags	shapeFlags;
+
+		/**
+		\brief Returns true if the parameters are valid.
+		*/
+		bool	isValid()	const
+		{
+			return !region.isEmpty() && voxelSize > 0.0f;
+		}
+	};
+
+	/**
+	\brief Run of solid voxels in a column, from voxel start (included) to voxel end (excluded) along the Y axis.
+	*/
+	struct PxVoxelSpan
+	{
+		PxU16	start;
+		PxU16	end;
+	};
+
+	/**
+	\brief Voxelizes the static collision geometry of a scene, e.g. as the input of a navmesh baker.
+
+	The static shapes overlapping the region are gathered once. Each voxel of each column is then tested against the
+	shapes overlapping the column with PxGeometryQuery box overlaps, which use the midphase structures of triangle
+	meshes (box vs BV4 tree) and the cells of heightfields. Columns are processed in parallel on the dispatcher passed
+	to voxelize().
+
+	The result is run-length encoded per column: the solid voxels of column (x, z) are the spans
+	getSpans()[getColumnOffsets()[i]] to getSpans()[getColumnOffsets()[i+1] - 1], with i = z * getNbX() + x, sorted
+	along Y. Voxel (x, y, z) covers region.minimum + (x, y, z) * voxelSize to region.minimum + (x+1, y+1, z+1) * voxelSize.
+
+	The object keeps its buffers between calls, so re-baking a region after an edit doesn't reallocate. To re-bake part
+	of a world, pass the bounds of the edit as region and merge the columns into the previous result.
+	*/
+	class PxStaticVoxelizer
+	{
+		public:
+										PxStaticVoxelizer();
+										~PxStaticVoxelizer();
+
+		/**
+		\brief Voxelizes the static shapes of a scene over a region.
+
+		The scene is read-locked while the shapes are gathered. The voxelization itself only uses copies of the shape
+		geometries and poses, but the meshes and heightfields must not be modified until the function returns.
+
+		\param[in] scene		Scene whose static actors are voxelized
+		\param[in] params		Region, voxel size and mode
+		\param[in] dispatcher	Dispatcher used to process the columns in parallel, or NULL to process them on the calling thread
+		\return False if the parameters are invalid or the grid has more than 65535 voxels along Y
+		*/
+				bool					voxelize(PxScene& scene, const PxStaticVoxelizerParams& params, PxCpuDispatcher* dispatcher = NULL);
+
+		/**
+		\brief Returns the number of voxels along X.
+		*/
+				PxU32					getNbX()				const;
+
+		/**
+		\brief Returns the number of voxels along Y.
+		*/
+				PxU32					getNbY()				const;
+
+		/**
+		\brief Returns the number of voxels along Z.
+		*/
+				PxU32					getNbZ()				const;
+
+		/**
+		\brief Returns the getNbX() * getNbZ() + 1 offsets of the columns in the span array.
+		*/
+				const PxU32*			getColumnOffsets()		const;
+
+		/**
+		\brief Returns the spans of all columns.
+		*/
+				const PxVoxelSpan*		getSpans()				const;
+
+		/**
+		\brief Returns the total number of spans.
+		*/
+				PxU32					getNbSpans()			const;
+
+		/**
+		\brief Returns true if a voxel is solid. Voxels outside the grid are empty.
+		*/
+				bool					isSolid(PxU32 x, PxU32 y, PxU32 z)	const;
+
+		private:
+				StaticVoxelizerInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
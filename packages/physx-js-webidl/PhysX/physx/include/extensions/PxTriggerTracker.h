@@ -0,0 +1,122 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_TRIGGER_TRACKER_H
+#define PX_TRIGGER_TRACKER_H
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxActor;
+	struct PxTriggerPair;
+	class TriggerTrackerInternal;
+
+	/**
+	\brief Trigger state change, as returned by PxTriggerTracker.
+
+	The layout is 2 x 32-bit words (8 bytes) without padding.
+	*/
+	struct PxTriggerDelta
+	{
+		PxU32	triggerIndex;	//!< Index stored in the trigger actor's userData
+		PxU32	otherIndex;		//!< Index stored in the other actor's userData
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(PxTriggerDelta) == 8);
+
+	/**
+	\brief Trigger state tracker.
+
+	PxSimulationEventCallback::onTrigger() reports one event per shape pair. An actor with several shapes entering a
+	trigger therefore generates several events, and an actor that enters and leaves a trigger within the same frame
+	generates events that cancel each other. This class keeps the set of actors inside each trigger actor, and turns
+	the trigger events of a frame into compact arrays of actor-level enter and leave deltas.
+
+	Usage:
+	- forward the pairs received in onTrigger() to processTriggers()
+	- call update() after fetchResults()
+	- read the deltas with getEntered() and getLeft(). They remain valid until the next update() call.
+
+	The user index of each actor is read from PxActor::userData, which must then contain an integer index rather
+	than a pointer: userData = reinterpret_cast<void*>(size_t(index)). It is captured when the actor enters a trigger,
+	so the leave delta of a removed actor still reports its index.
+	*/
+	class PxTriggerTracker
+	{
+		public:
+							PxTriggerTracker();
+							~PxTriggerTracker();
+
+			/**
+			\brief Records trigger events. Call this from PxSimulationEventCallback::onTrigger().
+
+			\param[in] pairs	trigger pairs passed to onTrigger()
+			\param[in] count	number of trigger pairs
+			*/
+			void			processTriggers(const PxTriggerPair* pairs, PxU32 count);
+
+			/**
+			\brief Computes the deltas for the events recorded since the last call. Call this after fetchResults().
+			*/
+			void			update();
+
+			/**
+			\brief Returns the actors that entered a trigger during the last frame.
+
+			\param[out] nbDeltas	number of returned deltas
+			\return Enter deltas
+			*/
+			const PxTriggerDelta*	getEntered(PxU32& nbDeltas)	const;
+
+			/**
+			\brief Returns the actors that left a trigger during the last frame.
+
+			\param[out] nbDeltas	number of returned deltas
+			\return Leave deltas
+			*/
+			const PxTriggerDelta*	getLeft(PxU32& nbDeltas)	const;
+
+			/**
+			\brief Checks whether an actor is inside a trigger actor, as of the last update() call.
+
+			\param[in] triggerActor	trigger actor
+			\param[in] otherActor	other actor
+			\return True if at least one shape of the other actor touches a trigger shape of the trigger actor
+			*/
+			bool			isInside(const PxActor* triggerActor, const PxActor* otherActor)	const;
+
+		private:
+			TriggerTrackerInternal*	mImpl;
+	};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
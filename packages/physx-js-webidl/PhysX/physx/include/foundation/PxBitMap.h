@@ -38,11 +38,91 @@
 #include "foundation/PxBitUtils.h"
 #include "foundation/PxConstructor.h"
 
+#if PX_WASM_SIMD
+	#include <wasm_simd128.h>
+#elif PX_SSE2
+	#include <emmintrin.h>
+#endif
 
 #if !PX_DOXYGEN
 namespace physx
 {
 #endif
+	/*!
+	Returns the index of the first non-zero word in [start, end), or end if all these words are zero.
+
+	Zero words are skipped 128 bits at a time, so that sparse bitmaps (e.g. a few hundred set bits out of 100k handles)
+	can be scanned without touching every word individually.
+	*/
+	PX_FORCE_INLINE PxU32 PxBitMapFindNonZeroWord(const PxU32* PX_RESTRICT words, PxU32 start, PxU32 end)
+	{
+		PxU32 i = start;
+		// PT: first reach a 4-words boundary so that the 128-bit blocks are aligned relative to the map, not to memory
+		while(i < end && (i & 3))
+		{
+			if(words[i])
+				return i;
+			i++;
+		}
+
+		while(i + 4 <= end)
+		{
+#if PX_WASM_SIMD
+			const bool nonZero = wasm_v128_any_true(wasm_v128_load(words + i));
+#elif PX_SSE2
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+			const bool nonZero = _mm_movemask_epi8(_mm_cmpeq_epi32(block, _mm_setzero_si128())) != 0xffff;
+#else
+			const bool nonZero = (words[i] | words[i + 1] | words[i + 2] | words[i + 3]) != 0;
+#endif
+			if(nonZero)
+				break;
+			i += 4;
+		}
+
+		while(i < end)
+		{
+			if(words[i])
+				return i;
+			i++;
+		}
+		return end;
+	}
+
+	/*!
+	Returns the number of bits set in the given words.
+	*/
+	PX_FORCE_INLINE PxU32 PxBitMapCountBits(const PxU32* PX_RESTRICT words, PxU32 nbWords)
+	{
+		PxU32 count = 0;
+		PxU32 i = 0;
+#if PX_WASM_SIMD
+		v128_t acc = wasm_i32x4_splat(0);
+		for(; i + 4 <= nbWords; i += 4)
+			acc = wasm_i32x4_add(acc, wasm_u32x4_extadd_pairwise_u16x8(wasm_u16x8_extadd_pairwise_u8x16(wasm_i8x16_popcnt(wasm_v128_load(words + i)))));
+		count = PxU32(wasm_i32x4_extract_lane(acc, 0) + wasm_i32x4_extract_lane(acc, 1) + wasm_i32x4_extract_lane(acc, 2) + wasm_i32x4_extract_lane(acc, 3));
+#elif PX_SSE2
+		// PT: same parallel bit count as PxBitCount, 4 words at a time. The final per-byte sums are accumulated with
+		// _mm_sad_epu8, which cannot overflow since each byte holds at most 8.
+		const __m128i m1 = _mm_set1_epi8(0x55);
+		const __m128i m2 = _mm_set1_epi8(0x33);
+		const __m128i m4 = _mm_set1_epi8(0x0f);
+		__m128i acc = _mm_setzero_si128();
+		for(; i + 4 <= nbWords; i += 4)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+			v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi16(v, 1), m1));
+			v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi16(v, 2), m2));
+			v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi16(v, 4)), m4);
+			acc = _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128()));
+		}
+		count = PxU32(_mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+#endif
+		for(; i < nbWords; i++)
+			count += PxBitCount(words[i]);
+		return count;
+	}
+
 	/*!
 	Hold a bitmap with operations to set,reset or test given bit.
 
@@ -199,23 +279,68 @@ namespace physx
 
 		PX_INLINE PxU32 count()		const
 		{
-			// NOTE: we can probably do this faster, since the last steps in PxBitCount can be defered to
-			// the end of the seq. + 64/128bits at a time + native bit counting instructions(360 is fast non micro code).
-			PxU32 count = 0;
-			const PxU32 wordCount = getWordCount();
-			for(PxU32 i = 0; i<wordCount; i++)
-				count += PxBitCount(mMap[i]);
-
-			return count;
+			return PxBitMapCountBits(mMap, getWordCount());
 		}
 
+		// Counts the bits set in [start, start + length), clamped to the size of the map
 		PX_INLINE PxU32 count(PxU32 start, PxU32 length) const
 		{
-			const PxU32 end = PxMin(getWordCount() << 5, start + length);
-			PxU32 count = 0;
-			for(PxU32 i = start; i<end; i++)
-				count += (test(i) != 0);
-			return count;
+			const PxU32 end = PxMin(getWordCount() << 5, start + PxMin(length, 0xffffffff - start));
+			if(start >= end)
+				return 0;
+
+			const PxU32 firstWord = start >> 5;
+			const PxU32 lastWord = (end - 1) >> 5;
+			const PxU32 firstMask = 0xffffffff << (start & 31);
+			const PxU32 lastMask = 0xffffffff >> (31 - ((end - 1) & 31));
+
+			if(firstWord == lastWord)
+				return PxBitCount(mMap[firstWord] & firstMask & lastMask);
+
+			return PxBitCount(mMap[firstWord] & firstMask)
+				+ PxBitMapCountBits(mMap + firstWord + 1, lastWord - firstWord - 1)
+				+ PxBitCount(mMap[lastWord] & lastMask);
+		}
+
+		/*!
+		Writes the indices of the set bits, in increasing order, starting from bit 'cursor'.
+
+		At most maxIndices indices are written. On return 'cursor' is the bit index to resume from, or
+		Iterator::DONE once the whole map has been scanned. Zero words are skipped 128 bits at a time.
+
+		\return the number of indices written
+		*/
+		PxU32 extractSetBits(PxU32* PX_RESTRICT indices, PxU32 maxIndices, PxU32& cursor) const
+		{
+			const PxU32 wordCount = getWordCount();
+			if(cursor == Iterator::DONE || (cursor >> 5) >= wordCount)
+			{
+				cursor = Iterator::DONE;
+				return 0;
+			}
+
+			PxU32 nb = 0;
+			PxU32 w = cursor >> 5;
+			PxU32 block = mMap[w] & (0xffffffff << (cursor & 31));
+			while(nb < maxIndices)
+			{
+				if(!block)
+				{
+					w = PxBitMapFindNonZeroWord(mMap, w + 1, wordCount);
+					if(w == wordCount)
+					{
+						cursor = Iterator::DONE;
+						return nb;
+					}
+					block = mMap[w];
+				}
+
+				const PxU32 bitIndex = w << 5 | PxLowestSetBit(block);
+				block &= block - 1;
+				indices[nb++] = bitIndex;
+				cursor = bitIndex + 1;
+			}
+			return nb;
 		}
 
 		//! returns 0 if no bits set (!!!)
@@ -233,12 +358,7 @@ namespace physx
 		bool hasAnyBitSet() const
 		{
 			const PxU32 wordCount = getWordCount();
-			for(PxU32 i = 0; i<wordCount; i++)
-			{
-				if (mMap[i])
-					return true;
-			}
-			return false;
+			return PxBitMapFindNonZeroWord(mMap, 0, wordCount) != wordCount;
 		}
 
 		// the obvious combiners and some used in the SDK
@@ -305,9 +425,13 @@ namespace physx
 
 					const PxU32 bitIndex = index << 5 | PxLowestSetBit(block);
 					block &= block - 1;
-					PxU32 wordCount = mBitMap.getWordCount();
-					while(!block && ++index < wordCount)
-						block = mBitMap.mMap[index];
+					if(!block)
+					{
+						const PxU32 wordCount = mBitMap.getWordCount();
+						index = PxBitMapFindNonZeroWord(mBitMap.mMap, index + 1, wordCount);
+						if(index < wordCount)
+							block = mBitMap.mMap[index];
+					}
 
 					mBlock = block;
 					mIndex = index;
@@ -319,12 +443,9 @@ namespace physx
 
 			PX_INLINE void reset()
 			{
-				PxU32 index = 0;
-				PxU32 block = 0;
-
-				PxU32 wordCount = mBitMap.getWordCount();
-				while(index < wordCount && ((block = mBitMap.mMap[index]) == 0))
-					++index;
+				const PxU32 wordCount = mBitMap.getWordCount();
+				const PxU32 index = PxBitMapFindNonZeroWord(mBitMap.mMap, 0, wordCount);
+				const PxU32 block = index < wordCount ? mBitMap.mMap[index] : 0;
 
 				mBlock = block;
 				mIndex = index;
@@ -345,9 +466,10 @@ namespace physx
 			PX_FORCE_INLINE bool hasBits()
 			{
 				PX_ASSERT(mIndex<mWordCount);
-				while (mBlock == 0)
+				if(mBlock == 0)
 				{
-					if (++mIndex == mWordCount)
+					mIndex = PxI32(PxBitMapFindNonZeroWord(mMap, PxU32(mIndex + 1), PxU32(mWordCount)));
+					if(mIndex == mWordCount)
 						return false;
 					mBlock = mMap[mIndex];
 				}
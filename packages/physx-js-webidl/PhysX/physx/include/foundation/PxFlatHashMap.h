@@ -0,0 +1,555 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_FLAT_HASH_MAP_H
+#define PX_FLAT_HASH_MAP_H
+
+#include "foundation/PxAllocator.h"
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxBasicTemplates.h"
+#include "foundation/PxHash.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxMemory.h"
+
+#if PX_WASM_SIMD
+	#include <wasm_simd128.h>
+#elif PX_SSE2
+	#include <emmintrin.h>
+#endif
+
+// This header defines open-addressing alternatives to PxHashMap / PxHashSet ("flat" tables).
+//
+// Instead of chaining entries through a separate next array, entries live directly in the table slots
+// and a parallel array of one-byte control values records the state of each slot (empty, deleted, or the
+// top 7 bits of the key's hash). Slots are probed in aligned groups of 16: a single SIMD compare of the
+// group's control bytes yields the candidate slots for a key, so most lookups touch one control cache
+// line and one entry. Deleted slots become tombstones unless their group still has an empty slot.
+//
+// The tables grow at a 7/8 load factor and carry no per-entry link, which makes them smaller than the
+// chained maps for small key/value types.
+//
+// PxFlatHashMap<T>:
+//		bool			insert(const Key& k, const Value& v)	O(1) amortized
+//		Value &			operator[](const Key& k)				O(1) for existing objects, else O(1) amortized
+//		const Entry *	find(const Key& k);						O(1)
+//		bool			erase(const Key& k);					O(1)
+//		uint32_t		size();									constant
+//		void			reserve(uint32_t size);					O(MAX(capacity,size))
+//		void			clear();								O(capacity)
+//		Iterator		getIterator();
+//
+// PxFlatHashSet<T>:
+//		bool			insert(const Key& k)					O(1) amortized
+//		bool			contains(const Key& k)					O(1)
+//		bool			erase(const Key& k)						O(1)
+//
+// Unlike PxHashMap, pointers to entries are invalidated by any insertion that grows the table.
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+// PT: control byte values. Full slots store the top 7 bits of the hash, so their high bit is always clear.
+static const uint8_t PX_FLAT_HASH_EMPTY		= 0x80;
+static const uint8_t PX_FLAT_HASH_DELETED	= 0xfe;
+static const uint32_t PX_FLAT_HASH_GROUP	= 16;
+
+// PT: 16 control bytes and the bitmask queries used to probe them
+class PxFlatHashGroup
+{
+  public:
+	PX_FORCE_INLINE PxFlatHashGroup(const uint8_t* ctrl)
+	{
+#if PX_WASM_SIMD
+		mCtrl = wasm_v128_load(ctrl);
+#elif PX_SSE2
+		mCtrl = _mm_load_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+		mCtrl = ctrl;
+#endif
+	}
+
+	// Returns a bitmask of the slots whose control byte equals the given tag
+	PX_FORCE_INLINE uint32_t match(uint8_t tag) const
+	{
+#if PX_WASM_SIMD
+		return uint32_t(wasm_i8x16_bitmask(wasm_i8x16_eq(mCtrl, wasm_i8x16_splat(int8_t(tag)))));
+#elif PX_SSE2
+		return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(mCtrl, _mm_set1_epi8(char(tag)))));
+#else
+		uint32_t mask = 0;
+		for(uint32_t i = 0; i < PX_FLAT_HASH_GROUP; i++)
+			mask |= uint32_t(mCtrl[i] == tag) << i;
+		return mask;
+#endif
+	}
+
+	PX_FORCE_INLINE uint32_t matchEmpty() const
+	{
+		return match(PX_FLAT_HASH_EMPTY);
+	}
+
+	// PT: empty and deleted are the only control values with the high bit set
+	PX_FORCE_INLINE uint32_t matchEmptyOrDeleted() const
+	{
+#if PX_WASM_SIMD
+		return uint32_t(wasm_i8x16_bitmask(mCtrl));
+#elif PX_SSE2
+		return uint32_t(_mm_movemask_epi8(mCtrl));
+#else
+		uint32_t mask = 0;
+		for(uint32_t i = 0; i < PX_FLAT_HASH_GROUP; i++)
+			mask |= uint32_t(mCtrl[i] >> 7) << i;
+		return mask;
+#endif
+	}
+
+  private:
+#if PX_WASM_SIMD
+	v128_t			mCtrl;
+#elif PX_SSE2
+	__m128i			mCtrl;
+#else
+	const uint8_t*	mCtrl;
+#endif
+};
+
+template <class Entry, class Key, class HashFn, class GetKey, class Allocator>
+class PxFlatHashBase : private Allocator
+{
+	PX_NOCOPY(PxFlatHashBase)
+  public:
+	PxFlatHashBase(uint32_t initialTableSize, const Allocator& alloc = Allocator()) :
+		Allocator	(alloc),
+		mBuffer		(NULL),
+		mEntries	(NULL),
+		mCtrl		(NULL),
+		mCapacity	(0),
+		mSize		(0),
+		mGrowthLeft	(0)
+	{
+		if(initialTableSize)
+			reserve(initialTableSize);
+	}
+
+	~PxFlatHashBase()
+	{
+		destroy();
+		if(mBuffer)
+			Allocator::deallocate(mBuffer);
+	}
+
+	PX_FORCE_INLINE uint32_t size() const
+	{
+		return mSize;
+	}
+
+	PX_FORCE_INLINE uint32_t capacity() const
+	{
+		return mCapacity;
+	}
+
+	PX_INLINE Entry* find(const Key& k) const
+	{
+		if(!mSize)
+			return NULL;
+
+		const uint32_t h = HashFn()(k);
+		const uint8_t tag = getTag(h);
+		const uint32_t groupMask = mCapacity / PX_FLAT_HASH_GROUP - 1;
+		uint32_t group = h & groupMask;
+		// PT: triangular probing over a power-of-two number of groups visits every group
+		for(uint32_t i = 1;; i++)
+		{
+			const uint32_t base = group * PX_FLAT_HASH_GROUP;
+			const PxFlatHashGroup g(mCtrl + base);
+			uint32_t candidates = g.match(tag);
+			while(candidates)
+			{
+				const uint32_t slot = base + PxLowestSetBitUnsafe(candidates);
+				if(HashFn().equal(GetKey()(mEntries[slot]), k))
+					return mEntries + slot;
+				candidates &= candidates - 1;
+			}
+			// PT: the table always keeps empty slots, so this terminates
+			if(g.matchEmpty())
+				return NULL;
+			group = (group + i) & groupMask;
+		}
+	}
+
+	// Returns the slot for k. If the key was not present, the slot is claimed but left unconstructed.
+	PX_INLINE Entry* create(const Key& k, bool& exists)
+	{
+		Entry* entry = find(k);
+		exists = entry != NULL;
+		if(exists)
+			return entry;
+
+		if(!mGrowthLeft)
+			grow();
+
+		const uint32_t h = HashFn()(k);
+		const uint32_t slot = findFreeSlot(h);
+		if(mCtrl[slot] == PX_FLAT_HASH_EMPTY)
+			mGrowthLeft--;
+		mCtrl[slot] = getTag(h);
+		mSize++;
+		return mEntries + slot;
+	}
+
+	PX_INLINE bool erase(const Key& k)
+	{
+		Entry* entry = find(k);
+		if(!entry)
+			return false;
+
+		const uint32_t slot = uint32_t(entry - mEntries);
+		entry->~Entry();
+
+		// PT: lookups stop at the first group with an empty slot. If this group still has one, no probe
+		// sequence continues past it and the slot can go back to empty instead of becoming a tombstone.
+		const PxFlatHashGroup g(mCtrl + (slot & ~(PX_FLAT_HASH_GROUP - 1)));
+		if(g.matchEmpty())
+		{
+			mCtrl[slot] = PX_FLAT_HASH_EMPTY;
+			mGrowthLeft++;
+		}
+		else
+			mCtrl[slot] = PX_FLAT_HASH_DELETED;
+		mSize--;
+		return true;
+	}
+
+	void clear()
+	{
+		if(!mCapacity)
+			return;
+		destroy();
+		PxMemSet(mCtrl, PX_FLAT_HASH_EMPTY, mCapacity);
+		mSize = 0;
+		mGrowthLeft = getMaxLoad(mCapacity);
+	}
+
+	void reserve(uint32_t size)
+	{
+		// PT: smallest power-of-two capacity (at least one group) holding 'size' entries under the 7/8 load factor
+		uint32_t newCapacity = PxNextPowerOfTwo(PxMax(size + size / 7, PX_FLAT_HASH_GROUP) - 1);
+		if(newCapacity > mCapacity)
+			rehash(newCapacity);
+	}
+
+	PX_FORCE_INLINE bool isFull(uint32_t slot) const
+	{
+		return !(mCtrl[slot] & 0x80);
+	}
+
+	PX_FORCE_INLINE Entry* getEntries() const
+	{
+		return mEntries;
+	}
+
+  private:
+	PX_FORCE_INLINE static uint8_t getTag(uint32_t h)
+	{
+		return uint8_t(h >> 25);
+	}
+
+	PX_FORCE_INLINE static uint32_t getMaxLoad(uint32_t capacity)
+	{
+		return capacity - capacity / 8;
+	}
+
+	PX_INLINE uint32_t findFreeSlot(uint32_t h) const
+	{
+		const uint32_t groupMask = mCapacity / PX_FLAT_HASH_GROUP - 1;
+		uint32_t group = h & groupMask;
+		for(uint32_t i = 1;; i++)
+		{
+			const uint32_t base = group * PX_FLAT_HASH_GROUP;
+			const uint32_t freeSlots = PxFlatHashGroup(mCtrl + base).matchEmptyOrDeleted();
+			if(freeSlots)
+				return base + PxLowestSetBitUnsafe(freeSlots);
+			group = (group + i) & groupMask;
+		}
+	}
+
+	void destroy()
+	{
+		for(uint32_t i = 0; i < mCapacity; i++)
+		{
+			if(isFull(i))
+				mEntries[i].~Entry();
+		}
+	}
+
+	void grow()
+	{
+		// PT: when most of the used slots are tombstones, rehashing in place is enough to free them
+		if(mCapacity && mSize < getMaxLoad(mCapacity) / 2)
+			rehash(mCapacity);
+		else
+			rehash(mCapacity ? mCapacity * 2 : PX_FLAT_HASH_GROUP);
+	}
+
+	void rehash(uint32_t newCapacity)
+	{
+		PX_ASSERT(PxIsPowerOfTwo(newCapacity) && newCapacity >= PX_FLAT_HASH_GROUP);
+		PX_ASSERT(getMaxLoad(newCapacity) >= mSize);
+
+		// PT: entries first, then the 16-byte aligned control bytes, in a single allocation
+		const uint32_t ctrlOffset = (newCapacity * uint32_t(sizeof(Entry)) + 15) & ~15;
+		uint8_t* newBuffer = reinterpret_cast<uint8_t*>(Allocator::allocate(ctrlOffset + newCapacity, PX_FL));
+		PX_ASSERT(!(size_t(newBuffer) & 15));
+
+		uint8_t* oldBuffer = mBuffer;
+		Entry* oldEntries = mEntries;
+		const uint8_t* oldCtrl = mCtrl;
+		const uint32_t oldCapacity = mCapacity;
+
+		mBuffer = newBuffer;
+		mEntries = reinterpret_cast<Entry*>(newBuffer);
+		mCtrl = newBuffer + ctrlOffset;
+		mCapacity = newCapacity;
+		mGrowthLeft = getMaxLoad(newCapacity) - mSize;
+		PxMemSet(mCtrl, PX_FLAT_HASH_EMPTY, newCapacity);
+
+		for(uint32_t i = 0; i < oldCapacity; i++)
+		{
+			if(oldCtrl[i] & 0x80)
+				continue;
+			Entry& entry = oldEntries[i];
+			const uint32_t h = HashFn()(GetKey()(entry));
+			const uint32_t slot = findFreeSlot(h);
+			mCtrl[slot] = getTag(h);
+			PX_PLACEMENT_NEW(mEntries + slot, Entry)(entry);
+			entry.~Entry();
+		}
+
+		if(oldBuffer)
+			Allocator::deallocate(oldBuffer);
+	}
+
+	uint8_t*	mBuffer;
+	Entry*		mEntries;
+	uint8_t*	mCtrl;
+	uint32_t	mCapacity;
+	uint32_t	mSize;
+	uint32_t	mGrowthLeft;	// PT: empty slots that can still be claimed before the table must grow
+};
+
+template <class Key, class Value, class HashFn = PxHash<Key>, class Allocator = PxAllocator>
+class PxFlatHashMap
+{
+	PX_NOCOPY(PxFlatHashMap)
+  public:
+	typedef PxPair<const Key, Value> Entry;
+
+	struct GetKey
+	{
+		PX_FORCE_INLINE const Key& operator()(const Entry& e)
+		{
+			return e.first;
+		}
+	};
+
+	typedef PxFlatHashBase<Entry, Key, HashFn, GetKey, Allocator> BaseMap;
+
+	class Iterator
+	{
+	  public:
+		PX_INLINE Iterator(BaseMap& base) : mBase(base), mSlot(0)
+		{
+			skip();
+		}
+		PX_INLINE bool done() const
+		{
+			return mSlot >= mBase.capacity();
+		}
+		PX_INLINE Iterator& operator++()
+		{
+			mSlot++;
+			skip();
+			return *this;
+		}
+		PX_INLINE Entry& operator*() const
+		{
+			return mBase.getEntries()[mSlot];
+		}
+		PX_INLINE Entry* operator->() const
+		{
+			return mBase.getEntries() + mSlot;
+		}
+	  private:
+		PX_INLINE void skip()
+		{
+			while(mSlot < mBase.capacity() && !mBase.isFull(mSlot))
+				mSlot++;
+		}
+		Iterator& operator=(const Iterator&);
+
+		BaseMap&	mBase;
+		uint32_t	mSlot;
+	};
+
+	PxFlatHashMap(uint32_t initialTableSize = 64) : mBase(initialTableSize)
+	{
+	}
+
+	PxFlatHashMap(uint32_t initialTableSize, const Allocator& alloc) : mBase(initialTableSize, alloc)
+	{
+	}
+
+	PX_INLINE bool insert(const Key& k, const Value& v)
+	{
+		bool exists;
+		Entry* e = mBase.create(k, exists);
+		if(!exists)
+			PX_PLACEMENT_NEW(e, Entry)(k, v);
+		return !exists;
+	}
+
+	PX_INLINE Value& operator[](const Key& k)
+	{
+		bool exists;
+		Entry* e = mBase.create(k, exists);
+		if(!exists)
+			PX_PLACEMENT_NEW(e, Entry)(k, Value());
+		return e->second;
+	}
+
+	PX_INLINE const Entry* find(const Key& k) const
+	{
+		return mBase.find(k);
+	}
+
+	PX_INLINE bool erase(const Key& k)
+	{
+		return mBase.erase(k);
+	}
+
+	PX_INLINE uint32_t size() const
+	{
+		return mBase.size();
+	}
+
+	PX_INLINE uint32_t capacity() const
+	{
+		return mBase.capacity();
+	}
+
+	PX_INLINE void reserve(uint32_t size)
+	{
+		mBase.reserve(size);
+	}
+
+	PX_INLINE void clear()
+	{
+		mBase.clear();
+	}
+
+	Iterator getIterator()
+	{
+		return Iterator(mBase);
+	}
+
+  private:
+	BaseMap	mBase;
+};
+
+template <class Key, class HashFn = PxHash<Key>, class Allocator = PxAllocator>
+class PxFlatHashSet
+{
+	PX_NOCOPY(PxFlatHashSet)
+  public:
+	struct GetKey
+	{
+		PX_FORCE_INLINE const Key& operator()(const Key& e)
+		{
+			return e;
+		}
+	};
+
+	typedef PxFlatHashBase<Key, Key, HashFn, GetKey, Allocator> BaseSet;
+
+	PxFlatHashSet(uint32_t initialTableSize = 64) : mBase(initialTableSize)
+	{
+	}
+
+	PxFlatHashSet(uint32_t initialTableSize, const Allocator& alloc) : mBase(initialTableSize, alloc)
+	{
+	}
+
+	PX_INLINE bool insert(const Key& k)
+	{
+		bool exists;
+		Key* e = mBase.create(k, exists);
+		if(!exists)
+			PX_PLACEMENT_NEW(e, Key)(k);
+		return !exists;
+	}
+
+	PX_INLINE bool contains(const Key& k) const
+	{
+		return mBase.find(k) != NULL;
+	}
+
+	PX_INLINE bool erase(const Key& k)
+	{
+		return mBase.erase(k);
+	}
+
+	PX_INLINE uint32_t size() const
+	{
+		return mBase.size();
+	}
+
+	PX_INLINE uint32_t capacity() const
+	{
+		return mBase.capacity();
+	}
+
+	PX_INLINE void reserve(uint32_t size)
+	{
+		mBase.reserve(size);
+	}
+
+	PX_INLINE void clear()
+	{
+		mBase.clear();
+	}
+
+  private:
+	BaseSet	mBase;
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
+
@@ -172,6 +172,58 @@ class PxPoolBase : public PxUserAllocated, public Alloc
 		}
 	}
 
+	// Give back to the allocator all slabs without live elements. Returns the number of released bytes.
+	uint32_t releaseEmptySlabs()
+	{
+		if(!mFreeElement)
+			return 0;
+
+		PxArray<void*, Alloc> freeNodes(*this);
+		while(mFreeElement)
+		{
+			freeNodes.pushBack(mFreeElement);
+			mFreeElement = mFreeElement->mNext;
+		}
+		Alloc& alloc(*this);
+		PxSort(freeNodes.begin(), freeNodes.size(), PxLess<void*>(), alloc);
+		PxSort(mSlabs.begin(), mSlabs.size(), PxLess<void*>(), alloc);
+
+		// PT: both arrays are sorted, so the free nodes of each slab form a contiguous range
+		uint32_t nbReleased = 0;
+		uint32_t nbKept = 0;
+		uint32_t nbKeptFree = 0;
+		uint32_t freeIndex = 0;
+		const uint32_t nbFree = freeNodes.size();
+		const uint32_t nbSlabs = mSlabs.size();
+		for(uint32_t i = 0; i < nbSlabs; i++)
+		{
+			T* slabStart = reinterpret_cast<T*>(mSlabs[i]);
+			T* slabEnd = slabStart + mElementsPerSlab;
+
+			const uint32_t first = freeIndex;
+			while(freeIndex < nbFree && freeNodes[freeIndex] < slabEnd)
+				freeIndex++;
+
+			if(freeIndex - first == mElementsPerSlab)
+			{
+				Alloc::deallocate(slabStart);
+				nbReleased++;
+				continue;
+			}
+
+			mSlabs[nbKept++] = slabStart;
+			for(uint32_t j = first; j < freeIndex; j++)
+				freeNodes[nbKeptFree++] = freeNodes[j];
+		}
+		mSlabs.forceSize_Unsafe(nbKept);
+
+		// PT: push in reverse so that lower addresses are reused first
+		while(nbKeptFree--)
+			push(reinterpret_cast<FreeList*>(freeNodes[nbKeptFree]));
+
+		return nbReleased * mSlabSize;
+	}
+
   protected:
 	struct FreeList
 	{
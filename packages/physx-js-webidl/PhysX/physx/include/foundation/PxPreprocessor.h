@@ -106,7 +106,8 @@ Operating system defines, see http://sourceforge.net/p/predef/wiki/OperatingSyst
 /**
 Architecture defines, see http://sourceforge.net/p/predef/wiki/Architectures/
 */
-#if defined(__x86_64__) || defined(_M_X64)
+#if defined(__x86_64__) || defined(_M_X64) || (defined (__EMSCRIPTEN__) && defined(__wasm64__))
+	// PT: wasm64 (emscripten MEMORY64) is treated as a 64-bit Intel-like target, like wasm32 is treated as PX_X86
 	#define PX_X64 1
 #elif defined(__i386__) || defined(_M_IX86) || defined (__EMSCRIPTEN__)
 	#define PX_X86 1
@@ -133,6 +134,11 @@ SIMD defines
 	#if defined(_M_PPC) || defined(__CELLOS_LV2__)
 		#define PX_VMX 1
 	#endif
+	// WebAssembly SIMD128 (-msimd128). The SSE2 code path is compiled through emscripten's SSE
+	// translation headers (-msse2) and uses native wasm_simd128.h intrinsics where SSE2 has no direct equivalent.
+	#if defined(__EMSCRIPTEN__) && defined(__wasm_simd128__)
+		#define PX_WASM_SIMD 1
+	#endif
 #endif
 
 /**
@@ -186,6 +192,9 @@ define anything not defined on this platform to 0
 #ifndef PX_VMX
 	#define PX_VMX 0
 #endif
+#ifndef PX_WASM_SIMD
+	#define PX_WASM_SIMD 0
+#endif
 
 /*
 define anything not defined through the command line to 0
@@ -39,6 +39,10 @@
 	#include "smmintrin.h"
 #endif
 
+#if PX_WASM_SIMD
+	#include "PxVecMathWasmSimd.h"
+#endif
+
 #if !PX_DOXYGEN
 namespace physx
 {
@@ -118,8 +122,12 @@ PX_FORCE_INLINE __m128i m128_F2I(__m128 n)
 
 PX_FORCE_INLINE PxU32 BAllTrue4_R(const BoolV a)
 {
+#if PX_WASM_SIMD
+	return PxU32(internalWasmSimd::allTrue4(a));
+#else
 	const PxI32 moveMask = _mm_movemask_ps(a);
 	return PxU32(moveMask == 0xf);
+#endif
 }
 
 PX_FORCE_INLINE PxU32 BAllTrue3_R(const BoolV a)
@@ -130,8 +138,12 @@ PX_FORCE_INLINE PxU32 BAllTrue3_R(const BoolV a)
 
 PX_FORCE_INLINE PxU32 BAnyTrue4_R(const BoolV a)
 {
+#if PX_WASM_SIMD
+	return PxU32(internalWasmSimd::anyTrue4(a));
+#else
 	const PxI32 moveMask = _mm_movemask_ps(a);
 	return PxU32(moveMask != 0x0);
+#endif
 }
 
 PX_FORCE_INLINE PxU32 BAnyTrue3_R(const BoolV a)
@@ -563,6 +575,8 @@ PX_FORCE_INLINE FloatV FRound(const FloatV a)
 	ASSERT_ISVALIDFLOATV(a);
 #ifdef __SSE4_2__
 	return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#elif PX_WASM_SIMD
+	return internalWasmSimd::round(a);
 #else
 	// return _mm_round_ps(a, 0x0);
 	const FloatV half = FLoad(0.5f);
@@ -968,6 +982,8 @@ PX_FORCE_INLINE FloatV V3Dot(const Vec3V a, const Vec3V b)
 	ASSERT_ISVALIDVEC3V(b);
 #ifdef __SSE4_2__
 	return _mm_dp_ps(a, b, 0x7f);
+#elif PX_WASM_SIMD
+	return internalWasmSimd::dot3Splat(a, b);
 #else
 	const __m128 t0 = _mm_mul_ps(a, b);								//	aw*bw | az*bz | ay*by | ax*bx
 	const __m128 t1 = _mm_shuffle_ps(t0, t0, _MM_SHUFFLE(1,0,3,2));	//	ay*by | ax*bx | aw*bw | az*bz
@@ -1184,6 +1200,8 @@ PX_FORCE_INLINE Vec3V V3Round(const Vec3V a)
 	ASSERT_ISVALIDVEC3V(a);
 #ifdef __SSE4_2__
 	return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#elif PX_WASM_SIMD
+	return internalWasmSimd::round(a);
 #else
 	// return _mm_round_ps(a, 0x0);
 	const Vec3V half = V3Load(0.5f);
@@ -1380,6 +1398,8 @@ PX_FORCE_INLINE FloatV V3SumElems(const Vec3V a)
 	Vec3V r = _mm_hadd_ps(a, a);
 	r = _mm_hadd_ps(r, r);
 	return r;
+#elif PX_WASM_SIMD
+	return internalWasmSimd::sum3Splat(a);
 #else
 	const __m128 shuf1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)); // z,y,x,w
 	const __m128 shuf2 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)); // y,x,w,z
@@ -1701,6 +1721,8 @@ PX_FORCE_INLINE FloatV V4SumElements(const Vec4V a)
 	Vec4V r = _mm_hadd_ps(a, a);
 	r = _mm_hadd_ps(r, r);
 	return r;
+#elif PX_WASM_SIMD
+	return internalWasmSimd::sum4Splat(a);
 #else
 	const Vec4V xy = V4UnpackXY(a, a);	// x,x,y,y
 	const Vec4V zw = V4UnpackZW(a, a);	// z,z,w,w
@@ -1715,6 +1737,8 @@ PX_FORCE_INLINE FloatV V4Dot(const Vec4V a, const Vec4V b)
 {
 #ifdef __SSE4_2__
 	return _mm_dp_ps(a, b, 0xff);
+#elif PX_WASM_SIMD
+	return internalWasmSimd::dot4Splat(a, b);
 #else
 	//const __m128 dot1 = _mm_mul_ps(a, b);                                     // x,y,z,w
 	//const __m128 shuf1 = _mm_shuffle_ps(dot1, dot1, _MM_SHUFFLE(2, 1, 0, 3)); // w,x,y,z
@@ -1743,6 +1767,8 @@ PX_FORCE_INLINE FloatV V4Dot3(const Vec4V a, const Vec4V b)
 {
 #ifdef __SSE4_2__
 	return _mm_dp_ps(a, b, 0x7f);
+#elif PX_WASM_SIMD
+	return internalWasmSimd::dot3Splat(a, b);
 #else
 	const __m128 dot1 = _mm_mul_ps(a, b);                                     // aw*bw | az*bz | ay*by | ax*bx
 	const __m128 shuf1 = _mm_shuffle_ps(dot1, dot1, _MM_SHUFFLE(0, 0, 0, 0)); // ax*bx | ax*bx | ax*bx | ax*bx
@@ -1884,6 +1910,8 @@ PX_FORCE_INLINE Vec4V V4Round(const Vec4V a)
 {
 #ifdef __SSE4_2__
 	return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#elif PX_WASM_SIMD
+	return internalWasmSimd::round(a);
 #else
 	// return _mm_round_ps(a, 0x0);
 	const Vec4V half = V4Load(0.5f);
@@ -0,0 +1,109 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_VEC_MATH_WASM_SIMD_H
+#define PX_VEC_MATH_WASM_SIMD_H
+
+// This file contains the WebAssembly SIMD128 helpers used by the SSE code path (PxVecMathSSE.h) when
+// building with emscripten and -msimd128 -msse2. Emscripten translates SSE2 intrinsics to SIMD128, but
+// the SSE4 instructions we use on desktop (round, dot product, horizontal add) and some boolean reductions
+// have native SIMD128 equivalents that are much cheaper than the SSE2 fallback sequences.
+
+#if !COMPILE_VECTOR_INTRINSICS || !PX_WASM_SIMD
+	#error This file should only be included for WebAssembly SIMD128 builds.
+#endif
+
+#include <wasm_simd128.h>
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+namespace aos
+{
+namespace internalWasmSimd
+{
+PX_FORCE_INLINE v128_t toV128(const __m128 a)
+{
+	return (v128_t)a;
+}
+
+PX_FORCE_INLINE __m128 toM128(const v128_t a)
+{
+	return (__m128)a;
+}
+
+// Returns x+y+z in all 4 components.
+PX_FORCE_INLINE __m128 sum3Splat(const __m128 a)
+{
+	const v128_t v = toV128(a);
+	const v128_t x = wasm_i32x4_shuffle(v, v, 0, 0, 0, 0);
+	const v128_t y = wasm_i32x4_shuffle(v, v, 1, 1, 1, 1);
+	const v128_t z = wasm_i32x4_shuffle(v, v, 2, 2, 2, 2);
+	return toM128(wasm_f32x4_add(wasm_f32x4_add(x, y), z));
+}
+
+// Returns x+y+z+w in all 4 components.
+PX_FORCE_INLINE __m128 sum4Splat(const __m128 a)
+{
+	const v128_t v = toV128(a);
+	const v128_t t0 = wasm_f32x4_add(v, wasm_i32x4_shuffle(v, v, 2, 3, 0, 1));	// x+z | y+w | z+x | w+y
+	return toM128(wasm_f32x4_add(t0, wasm_i32x4_shuffle(t0, t0, 1, 0, 3, 2)));	// x+y+z+w in each component
+}
+
+PX_FORCE_INLINE __m128 dot3Splat(const __m128 a, const __m128 b)
+{
+	return sum3Splat(toM128(wasm_f32x4_mul(toV128(a), toV128(b))));
+}
+
+PX_FORCE_INLINE __m128 dot4Splat(const __m128 a, const __m128 b)
+{
+	return sum4Splat(toM128(wasm_f32x4_mul(toV128(a), toV128(b))));
+}
+
+// Round to nearest, ties to even (same as _mm_round_ps with _MM_FROUND_TO_NEAREST_INT).
+PX_FORCE_INLINE __m128 round(const __m128 a)
+{
+	return toM128(wasm_f32x4_nearest(toV128(a)));
+}
+
+PX_FORCE_INLINE bool allTrue4(const __m128 a)
+{
+	return wasm_i32x4_all_true(toV128(a));
+}
+
+PX_FORCE_INLINE bool anyTrue4(const __m128 a)
+{
+	return wasm_v128_any_true(toV128(a));
+}
+
+} // namespace internalWasmSimd
+} // namespace aos
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
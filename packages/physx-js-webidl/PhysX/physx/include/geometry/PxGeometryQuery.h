@@ -145,6 +145,123 @@ public:
 											const PxReal inflation = 0.0f, PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT,
 											PxSweepThreadContext* threadContext = NULL);
 
+	/**
+	\brief Raycast test of several rays against the same geometry object.
+
+	Equivalent to calling #raycast() once per ray with maxHits = 1, but the geometry-specific raycast function is only
+	looked up once, and rays that miss the bounds of mesh, heightfield and convex mesh geometries are rejected before
+	the exact test.
+
+	\param[in] nbRays			Number of rays
+	\param[in] origins			Ray origins, nbRays entries
+	\param[in] unitDirs			Normalized ray directions, nbRays entries
+	\param[in] maxDists			Maximum ray lengths, nbRays entries, each in the [0, inf) range
+	\param[in] geom				The geometry object to test the rays against
+	\param[in] pose				Pose of the geometry object
+	\param[in] hitFlags			Specification of the kind of information to retrieve on hit. Combination of #PxHitFlag flags
+	\param[out] rayHits			Raycast hit per ray, nbRays entries. rayHits[i] is only valid if hitResults[i] is true.
+	\param[out] hitResults		Optional, nbRays entries. Set to true for rays hitting the geometry, false otherwise.
+	\param[in] queryFlags		Optional flags controlling the query.
+	\param[in] threadContext	Optional user-defined per-thread context.
+
+	\return Number of rays hitting the geometry object
+
+	\see raycast PxGeomRaycastHit
+	*/
+	PX_PHYSX_COMMON_API static PxU32 raycastBatch(	PxU32 nbRays, const PxVec3* PX_RESTRICT origins, const PxVec3* PX_RESTRICT unitDirs, const PxReal* PX_RESTRICT maxDists,
+													const PxGeometry& geom, const PxTransform& pose, PxHitFlags hitFlags,
+													PxGeomRaycastHit* PX_RESTRICT rayHits, bool* PX_RESTRICT hitResults = NULL,
+													PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT, PxRaycastThreadContext* threadContext = NULL);
+
+	/**
+	\brief Overlap test of one geometry object against several geometry objects.
+
+	Equivalent to calling #overlap() once per target, with the same supported combinations. Sphere targets are
+	tested four at a time against sphere and capsule query geometries, capsule targets use a direct segment-segment
+	distance test, and other targets go through the regular overlap function table.
+
+	\param[in] geom0			The query geometry object
+	\param[in] pose0			Pose of the query geometry object
+	\param[in] nbGeoms			Number of target geometry objects
+	\param[in] geoms			Target geometry objects, nbGeoms entries
+	\param[in] poses			Poses of the target geometry objects, nbGeoms entries
+	\param[out] overlapResults	Optional, nbGeoms entries. Set to true for targets overlapping the query geometry, false otherwise.
+	\param[in] queryFlags		Optional flags controlling the query.
+	\param[in] threadContext	Optional user-defined per-thread context.
+
+	\return Number of target geometry objects overlapping the query geometry
+
+	\see overlap PxGeometry PxTransform
+	*/
+	PX_PHYSX_COMMON_API static PxU32 overlapBatch(	const PxGeometry& geom0, const PxTransform& pose0,
+													PxU32 nbGeoms, const PxGeometry* const* PX_RESTRICT geoms, const PxTransform* PX_RESTRICT poses,
+													bool* PX_RESTRICT overlapResults = NULL,
+													PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT, PxOverlapThreadContext* threadContext = NULL);
+
+	/**
+	\brief Sweep a geometry object against several geometry objects.
+
+	Equivalent to calling #sweep() once per target, with the same supported combinations. The swept shape is only
+	built once, and targets outside of the swept bounds are rejected before the exact test.
+
+	\param[in] unitDir			Normalized direction along which object geom0 should be swept
+	\param[in] maxDist			Maximum sweep distance, has to be in the [0, inf) range
+	\param[in] geom0			The geometry object to sweep. Supported geometries are #PxSphereGeometry, #PxCapsuleGeometry, #PxBoxGeometry and #PxConvexMeshGeometry
+	\param[in] pose0			Pose of the geometry object to sweep
+	\param[in] nbGeoms			Number of target geometry objects
+	\param[in] geoms			Target geometry objects, nbGeoms entries
+	\param[in] poses			Poses of the target geometry objects, nbGeoms entries
+	\param[out] sweepHits		Sweep hit per target, nbGeoms entries. sweepHits[i] is only valid if hitResults[i] is true.
+	\param[out] hitResults		Optional, nbGeoms entries. Set to true for targets hit by the sweep, false otherwise.
+	\param[in] hitFlags			Specify which properties per hit should be computed and written to result hit array. Combination of #PxHitFlag flags
+	\param[in] inflation		Surface of the swept shape is additively extruded in the normal direction, rounding corners and edges.
+	\param[in] queryFlags		Optional flags controlling the query.
+	\param[in] threadContext	Optional user-defined per-thread context.
+
+	\return Number of target geometry objects hit by the sweep
+
+	\see sweep PxGeomSweepHit PxGeometry PxTransform
+	*/
+	PX_PHYSX_COMMON_API static PxU32 sweepBatch(const PxVec3& unitDir, const PxReal maxDist,
+												const PxGeometry& geom0, const PxTransform& pose0,
+												PxU32 nbGeoms, const PxGeometry* const* PX_RESTRICT geoms, const PxTransform* PX_RESTRICT poses,
+												PxGeomSweepHit* PX_RESTRICT sweepHits, bool* PX_RESTRICT hitResults = NULL,
+												PxHitFlags hitFlags = PxHitFlag::eDEFAULT, const PxReal inflation = 0.0f,
+												PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT, PxSweepThreadContext* threadContext = NULL);
+
+	/**
+	\brief Sweep a geometry object, first pushing it out of the target object if it starts in overlap.
+
+	Equivalent to a #sweep() with PxHitFlag::eMTD, followed by a second sweep from the depenetrated pose when the first
+	one reports an initial overlap. The depenetration vector comes from the MTD computed by the first sweep, so there is
+	no separate #computePenetration() call. This is the typical recovery path for characters pushed into geometry, e.g. by
+	moving platforms. Same supported combinations as #sweep().
+
+	\param[in] unitDir			Normalized direction along which object geom0 should be swept
+	\param[in] maxDist			Maximum sweep distance, has to be in the [0, inf) range
+	\param[in] geom0			The geometry object to sweep. Supported geometries are #PxSphereGeometry, #PxCapsuleGeometry, #PxBoxGeometry, #PxConvexCoreGeometry, and #PxConvexMeshGeometry
+	\param[in] pose0			Pose of the geometry object to sweep
+	\param[in] geom1			The geometry object to test the sweep against
+	\param[in] pose1			Pose of the geometry object to sweep against
+	\param[out] sweepHit		The sweep hit information, relative to the depenetrated pose (pose0.p + depenetration). Only valid if this method returns true.
+	\param[out] depenetration	Translation applied to pose0 before the sweep. Zero if geom0 did not start in overlap.
+	\param[in] hitFlags			Specify which properties per hit should be computed and written to result hit array. Combination of #PxHitFlag flags. PxHitFlag::eMTD is implied and PxHitFlag::eASSUME_NO_INITIAL_OVERLAP is ignored.
+	\param[in] inflation		Surface of the swept shape is additively extruded in the normal direction, rounding corners and edges.
+	\param[in] separation		Extra distance added to the penetration depth when depenetrating, so that the follow-up sweep starts clear of the surface.
+	\param[in] queryFlags		Optional flags controlling the query.
+	\param[in] threadContext	Optional user-defined per-thread context.
+
+	\return True if the sweep from the depenetrated pose hits geom1. If geom0 still overlaps geom1 after depenetration, the returned hit is that initial overlap.
+
+	\see sweep computePenetration PxGeomSweepHit PxGeometry PxTransform
+	*/
+	PX_PHYSX_COMMON_API static bool sweepAndDepenetrate(const PxVec3& unitDir, const PxReal maxDist,
+														const PxGeometry& geom0, const PxTransform& pose0,
+														const PxGeometry& geom1, const PxTransform& pose1,
+														PxGeomSweepHit& sweepHit, PxVec3& depenetration,
+														PxHitFlags hitFlags = PxHitFlag::eDEFAULT, const PxReal inflation = 0.0f, const PxReal separation = 1e-3f,
+														PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT, PxSweepThreadContext* threadContext = NULL);
+
 	/**
 	\brief Compute minimum translational distance (MTD) between two geometry objects.
 
@@ -203,6 +320,38 @@ public:
 													PxVec3* closestPoint=NULL, PxU32* closestIndex=NULL,
 													PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
 
+	/**
+	\brief Computes the closest points on a triangle mesh or heightfield for several points.
+
+	The points are processed in a spatially sorted order. The closest point found for one query bounds the search radius
+	of the next one, and the radius then shrinks during the traversal of the mesh's BV4 tree, or of the heightfield cells.
+	This makes large batches of nearby points (e.g. AI agents, navmesh samples) much cheaper than separate #pointDistance() calls.
+
+	Unlike pointDistance(), the returned distances are not squared, and points inside closed meshes get the distance to
+	the surface rather than 0. Holes of heightfields are skipped.
+
+	The function doesn't use any shared state, so large batches can be split across threads.
+
+	\note For meshes, only the BVH34 midphase data-structure is supported. With a non-identity mesh scale, the closest point
+	is computed in vertex space, as in pointDistance().
+
+	\param[in] nbPoints			Number of points
+	\param[in] points			Query points, nbPoints entries
+	\param[in] geom				The geometry object, #PxTriangleMeshGeometry or #PxHeightFieldGeometry
+	\param[in] pose				Pose of the geometry object
+	\param[in] maxDistance		Points farther than this from the geometry are reported as misses. Use PX_MAX_F32 for no limit.
+	\param[out] distances		Distance to the closest point per query, nbPoints entries. -1.0 for misses.
+	\param[out] closestPoints	Optional, nbPoints entries. Closest point on the geometry, only valid when distances[i] is not negative.
+	\param[out] closestIndices	Optional, nbPoints entries. Closest triangle index, PX_INVALID_U32 for misses.
+	\param[in] queryFlags		Optional flags controlling the query.
+	\return Number of points within maxDistance of the geometry
+
+	\see pointDistance PxGeometry PxTransform
+	*/
+	PX_PHYSX_COMMON_API static PxU32 pointDistanceBatch(PxU32 nbPoints, const PxVec3* PX_RESTRICT points, const PxGeometry& geom, const PxTransform& pose, PxReal maxDistance,
+														PxReal* PX_RESTRICT distances, PxVec3* PX_RESTRICT closestPoints = NULL, PxU32* PX_RESTRICT closestIndices = NULL,
+														PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
+
 	/**
 	\brief computes the bounds for a geometry object
 
@@ -111,7 +111,7 @@ class PxHeightField : public PxRefCounted
 	\param[in] startCol First cell in the destination heightfield to be modified. Can be negative.
 	\param[in] startRow First row in the destination heightfield to be modified. Can be negative.
 	\param[in] subfieldDesc Description of the source subfield to read the samples from.
-	\param[in] shrinkBounds If left as false, the bounds will never shrink but only grow. If set to true the bounds will be recomputed from all HF samples at O(nbColums*nbRows) perf cost.
+	\param[in] shrinkBounds If left as false, the bounds will never shrink but only grow. If set to true the bounds will be recomputed from all HF samples at O(nbColums*nbRows) perf cost, but only if a sample at the previous minimum or maximum height was modified.
 	\return True on success, false on failure. Failure can occur due to format mismatch.
 
 	\note Modified samples are constrained to the same height quantization range as the original heightfield.
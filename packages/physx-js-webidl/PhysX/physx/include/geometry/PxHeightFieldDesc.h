@@ -174,6 +174,167 @@ PX_INLINE bool PxHeightFieldDesc::isValid() const
 	return true;
 }
 
+/**
+\brief Format of the height values in a PxHeightFieldRasterDesc.
+*/
+struct PxHeightFieldRasterFormat
+{
+	enum Enum
+	{
+		eU16,	//!< One PxU16 per sample
+		eF32	//!< One PxReal per sample
+	};
+};
+
+/**
+\brief Descriptor to create a #PxHeightField directly from a height raster and an optional material map.
+
+Raster values are converted to the 16-bit heightfield samples as follows:
+
+sample = clamp(round((value * rasterScale - heightOffset) / heightScale), -32768, 32767)
+
+The shape using the heightfield must then use heightScale as PxHeightFieldGeometry::heightScale, and be offset by heightOffset along
+its local Y axis. For example a full-range PxU16 raster with a vertical resolution of s meters per unit is converted losslessly with
+rasterScale = heightScale = s and heightOffset = 32768 * s.
+
+\see PxHeightFieldDesc PxCookHeightFieldFromRaster() PxCreateHeightFieldFromRaster()
+*/
+class PxHeightFieldRasterDesc
+{
+public:
+
+	/**
+	\brief Number of sample rows in the raster. Local space X-axis corresponds to rows.
+
+	<b>Range:</b> &gt;1<br>
+	<b>Default:</b> 0
+	*/
+	PxU32							nbRows;
+
+	/**
+	\brief Number of sample columns in the raster. Local space Z-axis corresponds to columns.
+
+	<b>Range:</b> &gt;1<br>
+	<b>Default:</b> 0
+	*/
+	PxU32							nbColumns;
+
+	/**
+	\brief Format of the height values.
+
+	<b>Default:</b> PxHeightFieldRasterFormat::eF32
+	*/
+	PxHeightFieldRasterFormat::Enum	format;
+
+	/**
+	\brief The height values, nbRows * nbColumns of them. The index of sample(row, column) is row * nbColumns + column.
+
+	<b>Default:</b> NULL
+	*/
+	PxStridedData					heights;
+
+	/**
+	\brief Optional material map, one PxU8 per sample with the same layout as the heights.
+
+	The value is used for both triangles of the cell whose first vertex is the sample. Use PxHeightFieldMaterial::eHOLE for holes.
+	Values must be below 128. When NULL, all triangles use material 0.
+
+	<b>Default:</b> NULL
+	*/
+	PxStridedData					materials;
+
+	/**
+	\brief Scale from raster values to heights, before heightOffset and heightScale are applied.
+
+	<b>Range:</b> (0, PX_MAX_F32)<br>
+	<b>Default:</b> 1.0
+	*/
+	PxReal							rasterScale;
+
+	/**
+	\brief Height of a zero sample, to be applied to the shape along its local Y axis.
+
+	<b>Default:</b> 0.0
+	*/
+	PxReal							heightOffset;
+
+	/**
+	\brief Height of one sample step, to be used as PxHeightFieldGeometry::heightScale.
+
+	<b>Range:</b> (0, PX_MAX_F32)<br>
+	<b>Default:</b> 1.0
+	*/
+	PxReal							heightScale;
+
+	/**
+	\brief See PxHeightFieldDesc::convexEdgeThreshold.
+
+	<b>Default:</b> 0
+	*/
+	PxReal							convexEdgeThreshold;
+
+	/**
+	\brief See PxHeightFieldDesc::flags.
+
+	<b>Default:</b> 0
+	*/
+	PxHeightFieldFlags				flags;
+
+	/**
+	\brief Constructor sets to default.
+	*/
+	PX_INLINE						PxHeightFieldRasterDesc();
+
+	/**
+	\brief (re)sets the structure to the default.
+	*/
+	PX_INLINE		void			setToDefault();
+
+	/**
+	\brief Returns true if the descriptor is valid.
+	\return True if the current settings are valid.
+	*/
+	PX_INLINE		bool			isValid() const;
+};
+
+PX_INLINE PxHeightFieldRasterDesc::PxHeightFieldRasterDesc()	//constructor sets to default
+{
+	nbColumns					= 0;
+	nbRows						= 0;
+	format						= PxHeightFieldRasterFormat::eF32;
+	rasterScale					= 1.0f;
+	heightOffset				= 0.0f;
+	heightScale					= 1.0f;
+	convexEdgeThreshold			= 0.0f;
+	flags						= PxHeightFieldFlags();
+}
+
+PX_INLINE void PxHeightFieldRasterDesc::setToDefault()
+{
+	*this = PxHeightFieldRasterDesc();
+}
+
+PX_INLINE bool PxHeightFieldRasterDesc::isValid() const
+{
+	if (nbColumns < 2)
+		return false;
+	if (nbRows < 2)
+		return false;
+	if (!heights.data)
+		return false;
+	if (heights.stride < (format == PxHeightFieldRasterFormat::eU16 ? sizeof(PxU16) : sizeof(PxReal)))
+		return false;
+	if (materials.data && materials.stride < sizeof(PxU8))
+		return false;
+	if (!(rasterScale > 0.0f) || !(heightScale > 0.0f))
+		return false;
+	if (convexEdgeThreshold < 0)
+		return false;
+	if ((flags & PxHeightFieldFlag::eNO_BOUNDARY_EDGES) != flags)
+		return false;
+	return true;
+}
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
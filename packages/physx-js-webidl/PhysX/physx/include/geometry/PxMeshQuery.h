@@ -229,6 +229,35 @@ public:
 															PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
 
 
+	/**
+	\brief Raycasts a set of rays against a triangle mesh, tracing them in packets.
+
+	Rays are grouped in packets of consecutive rays. For BVH34 meshes, each packet traverses the mesh's tree once:
+	a node is fetched once for all the rays of the packet and rays drop out of the traversal as they miss. Packets
+	whose ray directions diverge are traced one ray at a time. For best results, consecutive rays should be
+	coherent, i.e. have close origins and directions.
+
+	\param[in] meshGeom		The triangle mesh geometry to raycast against.
+	\param[in] pose			Pose of the triangle mesh.
+	\param[in] nbRays		Number of rays.
+	\param[in] origins		Origins of the rays, one per ray.
+	\param[in] unitDirs		Normalized directions of the rays, one per ray.
+	\param[in] maxDists		Lengths of the rays, one per ray. Each must be larger than 0.
+	\param[out] hits		Raycast hits, one per ray. For rays that missed, distance is -1.0f and faceIndex is 0xffffffff.
+	\param[in] hitFlags		Specification of the kind of information to retrieve on hit. Combination of #PxHitFlag flags.
+	\param[in] queryFlags	Optional flags controlling the query.
+	\return Number of rays that hit the mesh.
+
+	\note PxHitFlag::eMESH_MULTIPLE is not supported, a single closest (or any, with PxHitFlag::eANY_HIT) hit is returned per ray.
+	\note Scaled meshes and BVH33 meshes are supported but trace rays one by one.
+
+	\see PxTriangleMeshGeometry PxGeomRaycastHit PxGeometryQuery::raycast
+	*/
+	PX_PHYSX_COMMON_API static PxU32 raycastPacket(	const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
+													PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* maxDists,
+													PxGeomRaycastHit* hits, PxHitFlags hitFlags = PxHitFlag::eDEFAULT,
+													PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
+
 	/**
 	\brief Sweep a specified geometry object in space and test for collision with a set of given triangles.
 
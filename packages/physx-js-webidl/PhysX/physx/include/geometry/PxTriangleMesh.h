@@ -49,6 +49,10 @@ namespace physx
 
  The PxMeshMidPhase::eBVH34 structure is a revisited implementation introduced in PhysX 3.4. It can be significantly faster both
  in terms of cooking performance and runtime performance.
+
+ The PxMeshMidPhase::eBVH38 structure is a PxMeshMidPhase::eBVH34 mesh with an additional 8-wide tree, built when the mesh is
+ loaded. Raycasts and overlaps traverse the wide tree, which needs fewer traversal steps on deep meshes and maps to AVX or paired
+ WASM SIMD lanes. Sweeps use the BVH34 tree. It is cooked with the PxBVH34MidphaseDesc settings and uses more memory than eBVH34.
 */
 struct PxMeshMidPhase
 {
@@ -56,6 +60,7 @@ struct PxMeshMidPhase
 	{
 		eBVH33 = 0,		//!< \deprecated Use eBVH34 instead. Used to be default midphase mesh structure up to PhysX 3.3
 		eBVH34 = 1,		//!< New midphase mesh structure, introduced in PhysX 3.4
+		eBVH38 = 2,		//!< eBVH34 structure plus an 8-wide tree for raycasts & overlaps
 
 		eLAST
 	};
@@ -170,6 +175,38 @@ class PxTriangleMesh : public PxRefCounted
 	*/
 	virtual PxBounds3	refitBVH() = 0;
 
+	/**
+	\brief Refits the BVH for a subset of the mesh triangles.
+
+	Same as refitBVH(), but only the BVH nodes containing the given triangles (and their parents) are updated. Use this
+	when getVerticesForModification was only used to move the vertices of a few triangles, e.g. for destructible or
+	editable terrain. The caller must list all triangles referencing a modified vertex.
+
+	\param[in] triangleIndices	Indices of the triangles whose vertices have been modified. These are cooked triangle indices, see getTrianglesRemap().
+	\param[in] nbTriangles		Number of indices in triangleIndices.
+	\return New bounds for the entire mesh.
+
+	\note For PxMeshMidPhase::eBVH33 trees this is the same as refitBVH().
+	\note The same limitations as refitBVH() apply.
+	\see refitBVH() getVerticesForModification() getBVHRefitCostRatio()
+	*/
+	virtual PxBounds3	refitBVHForTriangles(const PxU32* triangleIndices, PxU32 nbTriangles) = 0;
+
+	/**
+	\brief Returns how much refits have degraded the BVH.
+
+	This is the ratio between the current surface area cost of the BVH and its cost before the first refit. Refits never
+	reorganize the tree, so the ratio grows as vertices move away from their cooked positions. Once it exceeds a
+	user-defined threshold (e.g. 1.5), the mesh should be cooked again from its current vertices and triangles, for example
+	on a background thread, and swapped in with PxShape::setGeometry.
+
+	\return Cost ratio, 1.0 for an unmodified mesh.
+
+	\note Only tracked for non-quantized PxMeshMidPhase::eBVH34 trees. Other meshes always return 1.0.
+	\see refitBVH() refitBVHForTriangles()
+	*/
+	virtual PxReal		getBVHRefitCostRatio() const = 0;
+
 	/**
 	\brief Returns the number of triangles.
 	\return	number of triangles
@@ -52,6 +52,32 @@ namespace physx
 #endif
 
 class PxFoundation;
+class PxActor;
+
+/**
+\brief Parameters reducing the amount of data recorded by OmniPvd, e.g. to keep it enabled in production.
+
+The default parameters record everything, for every simulation step. The parameters only affect the data streamed
+at the end of each simulation step: the creation, release and modification of objects through the API are always
+recorded, so that the recording stays consistent.
+
+\see PxOmniPvd::setSamplingParams()
+*/
+struct PxOmniPvdSamplingParams
+{
+	PxU32	frameInterval;		//!< The simulation results are recorded for one simulation step out of frameInterval. Must be at least 1.
+	bool	transformsOnly;		//!< Only record the poses of the simulated actors, not their velocities, bounds, flags, joints or articulation states.
+	bool	sampledActorsOnly;	//!< Only record the simulation results of the actors selected with PxOmniPvd::setActorSampled(). Contacts are not filtered.
+	bool	contactSummaries;	//!< Record a single averaged contact per pair instead of all contact points and friction anchors.
+
+	PX_INLINE PxOmniPvdSamplingParams() :
+		frameInterval		(1),
+		transformsOnly		(false),
+		sampledActorsOnly	(false),
+		contactSummaries	(false)
+	{
+	}
+};
 
 class PxOmniPvd
 {
@@ -136,6 +162,37 @@ public:
 	*/
 	virtual bool startSampling() = 0;
 
+	/**
+	\brief Sets the sampling parameters
+
+	Takes effect at the next simulation step. The parameters are shared by all scenes.
+
+	\param params The new sampling parameters
+	*/
+	virtual void setSamplingParams(const PxOmniPvdSamplingParams& params) = 0;
+
+	/**
+	\brief Gets the sampling parameters
+
+	\return The current sampling parameters
+	*/
+	virtual PxOmniPvdSamplingParams getSamplingParams() = 0;
+
+	/**
+	\brief Selects an actor for the sampling, see PxOmniPvdSamplingParams::sampledActorsOnly
+
+	Actors are automatically deselected when released. Should not be called while the actor's scene is simulating.
+
+	\param actor The actor to select or deselect
+	\param sampled True to select the actor, false to deselect it
+	*/
+	virtual void setActorSampled(const PxActor& actor, bool sampled) = 0;
+
+	/**
+	\brief Returns true if the actor has been selected with setActorSampled()
+	*/
+	virtual bool isActorSampled(const PxActor& actor) = 0;
+
 	/**
 	\brief Releases the PxOmniPvd object
 
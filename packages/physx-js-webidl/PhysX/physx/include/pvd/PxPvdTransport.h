@@ -117,6 +117,23 @@ PxDefaultPvdSocketTransportCreate(const char* host, int port, unsigned int timeo
 */
 PX_C_EXPORT PxPvdTransport* PX_CALL_CONV PxDefaultPvdFileTransportCreate(const char* name);
 
+/**
+	\brief Create a transport that sends data to another transport from a background thread.
+
+	Data written by PVD is copied into one of two buffers. The other buffer is written to the target transport by a
+	background thread, so that a slow connection doesn't stall the simulation thread. flush() hands the pending data
+	to the background thread without waiting for it to be sent. Writes only block when both buffers are full, i.e.
+	when the connection cannot keep up with the captured data.
+
+	The stream is sent as is: it is neither compressed nor thinned out, since the PVD application needs every event.
+	Reduce the amount of captured data with PxPvdInstrumentationFlags and PxPvdSceneFlags instead.
+
+	\param target transport receiving the data, e.g. created with PxDefaultPvdSocketTransportCreate(). It is not
+	owned by the created transport and must outlive it.
+	\param bufferSize size of each of the two buffers, in bytes. Larger writes are passed to the target directly.
+*/
+PX_C_EXPORT PxPvdTransport* PX_CALL_CONV PxPvdAsyncTransportCreate(PxPvdTransport& target, unsigned int bufferSize);
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
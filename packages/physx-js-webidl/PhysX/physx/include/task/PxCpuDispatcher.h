@@ -71,6 +71,26 @@ public:
 	*/
 	virtual uint32_t getWorkerCount() const = 0;
 
+	/**
+	\brief Hint sent by the SDK when a simulation step is about to dispatch work.
+
+	Dispatchers whose threads are parked between steps can use this to wake them up
+	before the first tasks are submitted. The default implementation does nothing.
+
+	\see simulationFinished
+	*/
+	virtual void simulationStarting()	{}
+
+	/**
+	\brief Hint sent by the SDK when a simulation step has completed.
+
+	Dispatchers can use this to stop spinning and let their threads sleep until the
+	next step. The default implementation does nothing.
+
+	\see simulationStarting
+	*/
+	virtual void simulationFinished()	{}
+
 	virtual ~PxCpuDispatcher() {}
 };
 
@@ -49,6 +49,11 @@
 #include "vehicle2/drivetrain/PxVehicleDrivetrainFunctions.h"
 #include "vehicle2/drivetrain/PxVehicleDrivetrainComponents.h"
 
+#include "vehicle2/lod/PxVehicleLodParams.h"
+#include "vehicle2/lod/PxVehicleLodStates.h"
+#include "vehicle2/lod/PxVehicleLodFunctions.h"
+#include "vehicle2/lod/PxVehicleLodComponents.h"
+
 #include "vehicle2/physxActor/PxVehiclePhysXActorStates.h"
 #include "vehicle2/physxActor/PxVehiclePhysXActorHelpers.h"
 #include "vehicle2/physxActor/PxVehiclePhysXActorFunctions.h"
@@ -76,6 +81,8 @@
 #include "vehicle2/rigidBody/PxVehicleRigidBodyComponents.h"
 
 #include "vehicle2/roadGeometry/PxVehicleRoadGeometryState.h"
+#include "vehicle2/roadGeometry/PxVehicleRoadGeometryHelpers.h"
+#include "vehicle2/roadGeometry/PxVehicleRoadGeometryComponents.h"
 
 #include "vehicle2/steering/PxVehicleSteeringParams.h"
 #include "vehicle2/steering/PxVehicleSteeringFunctions.h"
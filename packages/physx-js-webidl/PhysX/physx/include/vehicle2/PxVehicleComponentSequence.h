@@ -30,6 +30,7 @@
 #include "foundation/PxAssert.h"
 #include "foundation/PxErrors.h"
 #include "foundation/PxFoundation.h"
+#include "task/PxCpuDispatcher.h"
 #include "PxVehicleComponent.h"
 
 #if !PX_DOXYGEN
@@ -315,6 +316,169 @@ PxU8 PxVehicleComponentSequence::beginSubstepGroup(const PxU8 nbSubSteps)
 	return mActiveSubgroup;
 }
 
+struct PxVehicleComponentBatchLimits
+{
+	enum Enum
+	{
+		eMAX_NB_STAGES = 64,
+		eMAX_NB_SUBGROUPS = 16
+	};
+};
+
+/**
+\brief A batch of vehicles with the same structure, updated stage by stage rather than vehicle by vehicle.
+
+A stage is an array of components with one component per vehicle, for example the suspension components of all
+vehicles. The batch updates a chunk of vehicles at a time and runs each stage over the whole chunk before moving
+to the next stage, so that the same component code runs for many vehicles in a row. If the data returned by the
+components of a stage is laid out in arrays across vehicles, consecutive updates also read consecutive memory.
+Chunks of vehicles are updated in parallel on the threads of the provided dispatcher.
+
+If the update method of a component returns false, the remaining stages are skipped for that vehicle only.
+
+\see PxVehicleComponentSequence
+*/
+class PxVehicleComponentBatch
+{
+public:
+	enum
+	{
+		eINVALID_SUBSTEP_GROUP = 0xff
+	};
+
+	PxVehicleComponentBatch()
+		: mNbVehicles(0), mAborted(NULL), mNbStages(0), mNbSubgroups(0), mActiveSubgroup(eINVALID_SUBSTEP_GROUP)
+	{
+	}
+
+	/**
+	\brief Set the vehicles of the batch.
+
+	\param[in] nbVehicles is the number of vehicles. Each stage must have nbVehicles components.
+	\param[in] abortedBuffer is a buffer of nbVehicles elements used to record the vehicles whose update was aborted.
+	The buffer is owned by the caller and must remain valid for the lifetime of the batch.
+	*/
+	void setVehicles(const PxU32 nbVehicles, bool* abortedBuffer)
+	{
+		mNbVehicles = nbVehicles;
+		mAborted = abortedBuffer;
+	}
+
+	/**
+	\brief Add a stage to the batch.
+
+	\param[in] components is an array with one component per vehicle. NULL entries are skipped. The array is owned
+	by the caller and must remain valid for the lifetime of the batch.
+	\return True on success, else false (for example due to stage count limit being reached).
+	*/
+	PX_FORCE_INLINE bool addStage(PxVehicleComponent* const* components)
+	{
+		if (PxVehicleComponentBatchLimits::eMAX_NB_STAGES == mNbStages)
+			return false;
+
+		mStages[mNbStages].components = components;
+		mStages[mNbStages].subgroup = mActiveSubgroup;
+		mNbStages++;
+		return true;
+	}
+
+	/**
+	\brief Start a substepping group.
+	\note All stages added using #addStage() will be added to the new substepping group until the group is marked as
+	complete with a call to #endSubstepGroup(). Unlike PxVehicleComponentSequence, groups cannot be nested.
+	\param[in] nbSubSteps is the number of substeps for the group's stages. This can be changed with a call to #setSubsteps().
+	\return Handle for the substepping group on success, else eINVALID_SUBSTEP_GROUP
+	*/
+	PX_FORCE_INLINE PxU8 beginSubstepGroup(const PxU8 nbSubSteps = 1)
+	{
+		if (PxVehicleComponentBatchLimits::eMAX_NB_SUBGROUPS == mNbSubgroups || eINVALID_SUBSTEP_GROUP != mActiveSubgroup)
+			return eINVALID_SUBSTEP_GROUP;
+
+		mSubgroupNbSteps[mNbSubgroups] = nbSubSteps;
+		mActiveSubgroup = mNbSubgroups++;
+		return mActiveSubgroup;
+	}
+
+	/**
+	\brief End the substepping group opened by #beginSubstepGroup().
+	*/
+	PX_FORCE_INLINE void endSubstepGroup()
+	{
+		mActiveSubgroup = eINVALID_SUBSTEP_GROUP;
+	}
+
+	/**
+	\brief Set the number of substeps to perform for a specific substepping group.
+	\param[in] subGroupHandle specifies the substepping group
+	\param[in] nbSteps is the number of times to invoke the stages of the specified substepping group.
+	*/
+	void setSubsteps(const PxU8 subGroupHandle, const PxU8 nbSteps)
+	{
+		PX_ASSERT(subGroupHandle < mNbSubgroups);
+		mSubgroupNbSteps[subGroupHandle] = nbSteps;
+	}
+
+	/**
+	\brief Update all stages of all vehicles.
+
+	\param[in] dt is the timestep of the update. The provided value has to be positive.
+	\param[in] context specifies global quantities of the simulation such as gravitational acceleration.
+	\param[in] dispatcher is the dispatcher used to run the update in parallel. May be NULL.
+	\param[in] grain is the number of vehicles updated per task.
+
+	\note Vehicles are updated concurrently, so their components must not write to state shared with other vehicles.
+	*/
+	void update(const PxReal dt, const PxVehicleSimulationContext& context,
+		PxCpuDispatcher* dispatcher = NULL, const PxU32 grain = 32);
+
+	/**
+	\brief Update all stages of a range of vehicles, on the calling thread.
+	\note This is the work done by each task of #update(). It is exposed for users with their own task system.
+	*/
+	void updateVehicles(const PxU32 startVehicle, const PxU32 endVehicle, const PxReal dt, const PxVehicleSimulationContext& context);
+
+private:
+	struct Stage
+	{
+		PxVehicleComponent* const* components;
+		PxU8 subgroup;
+	};
+
+	PxU32 mNbVehicles;
+	bool* mAborted;
+
+	Stage mStages[PxVehicleComponentBatchLimits::eMAX_NB_STAGES];
+	PxU8 mNbStages;
+
+	PxU8 mSubgroupNbSteps[PxVehicleComponentBatchLimits::eMAX_NB_SUBGROUPS];
+	PxU8 mNbSubgroups;
+
+	PxU8 mActiveSubgroup;
+};
+
+/**
+\brief Update a batch of component sequences, typically one per vehicle.
+
+The sequences are split into groups of 'grain' sequences and the groups are updated in parallel on the threads of
+the provided dispatcher (see PxParallelFor). Without a dispatcher, or with a dispatcher that has no worker threads,
+the sequences are updated serially on the calling thread.
+
+\param[in] sequences is the array of sequences to update.
+\param[in] nbSequences is the number of sequences in the array.
+\param[in] dt is the timestep of the update. The provided value has to be positive.
+\param[in] context specifies global quantities of the simulation such as gravitational acceleration.
+\param[in] dispatcher is the dispatcher used to run the update in parallel. May be NULL.
+\param[in] grain is the number of sequences updated per task.
+
+\note Sequences are updated concurrently, so their components must not write to state shared with other sequences.
+Components that read from or write to PhysX actors, such as PxVehiclePhysXActorBeginComponent and
+PxVehiclePhysXActorEndComponent, should be kept out of these sequences and updated serially before and after this call.
+*/
+void PxVehicleComponentSequencesUpdate
+(PxVehicleComponentSequence* const* sequences, const PxU32 nbSequences,
+ const PxReal dt, const PxVehicleSimulationContext& context,
+ PxCpuDispatcher* dispatcher = NULL, const PxU32 grain = 1);
+
 #if !PX_DOXYGEN
 } // namespace vehicle2
 } // namespace physx
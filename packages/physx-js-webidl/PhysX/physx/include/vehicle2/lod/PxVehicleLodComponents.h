@@ -0,0 +1,139 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+
+#include "vehicle2/PxVehicleParams.h"
+#include "vehicle2/PxVehicleComponent.h"
+
+#include "vehicle2/rigidBody/PxVehicleRigidBodyStates.h"
+#include "vehicle2/wheel/PxVehicleWheelParams.h"
+#include "vehicle2/wheel/PxVehicleWheelStates.h"
+
+#include "PxVehicleLodFunctions.h"
+#include "PxVehicleLodParams.h"
+#include "PxVehicleLodStates.h"
+
+#include "common/PxProfileZone.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+/**
+\brief Select the level of detail of a vehicle and run the reduced fidelity model when the vehicle is far from all observers.
+
+The component is meant to be added to a vehicle's component sequence right after the component that reads the
+rigid body state from PhysX (for example PxVehiclePhysXActorBeginComponent). At PxVehicleLodLevel::eFULL, it does nothing
+and the rest of the sequence runs as usual. At reduced levels, it updates the wheels itself and returns false, which
+skips the rest of the sequence: no wheel query is performed and no tire or drivetrain state is updated, and the PhysX
+actor moves as a plain rigid body. All states of the skipped components are left untouched, so the full model resumes
+from them when the vehicle is promoted.
+
+\see PxVehicleLodUpdate PxVehicleLodSimpleWheelUpdate
+*/
+class PxVehicleLodComponent : public PxVehicleComponent
+{
+public:
+
+	PxVehicleLodComponent() : PxVehicleComponent() {}
+	virtual ~PxVehicleLodComponent() {}
+
+	/**
+	\brief Provide vehicle data items for this component.
+
+	\param[out] axleDescription identifies the wheels on each axle.
+	\param[out] lodParams The distances and thresholds of the level of detail.
+	\param[out] observerPositions The world space positions of the observers, typically shared by all vehicles.
+	\param[out] nbObservers The number of observers.
+	\param[out] rigidBodyState The pose, velocity etc. of the vehicle rigid body.
+	\param[out] wheelParams The wheel parameters for the wheels.
+	\param[out] wheelRigidBody1dStates The wheel rotation speeds and angles, updated at reduced levels of detail.
+	\param[out] lodState The level of detail of the vehicle.
+	*/
+	virtual void getDataForLodComponent(
+		const PxVehicleAxleDescription*& axleDescription,
+		const PxVehicleLodParams*& lodParams,
+		const PxVec3*& observerPositions,
+		PxU32& nbObservers,
+		const PxVehicleRigidBodyState*& rigidBodyState,
+		PxVehicleArrayData<const PxVehicleWheelParams>& wheelParams,
+		PxVehicleArrayData<PxVehicleWheelRigidBody1dState>& wheelRigidBody1dStates,
+		PxVehicleLodState*& lodState) = 0;
+
+	virtual bool update(const PxReal dt, const PxVehicleSimulationContext& context)
+	{
+		PX_PROFILE_ZONE("PxVehicleLodComponent::update", 0);
+
+		const PxVehicleAxleDescription* axleDescription;
+		const PxVehicleLodParams* lodParams;
+		const PxVec3* observerPositions;
+		PxU32 nbObservers;
+		const PxVehicleRigidBodyState* rigidBodyState;
+		PxVehicleArrayData<const PxVehicleWheelParams> wheelParams;
+		PxVehicleArrayData<PxVehicleWheelRigidBody1dState> wheelRigidBody1dStates;
+		PxVehicleLodState* lodState;
+
+		getDataForLodComponent(axleDescription, lodParams, observerPositions, nbObservers,
+			rigidBodyState, wheelParams, wheelRigidBody1dStates, lodState);
+
+		const PxReal wheelRadius = axleDescription->nbWheels ? wheelParams[axleDescription->wheelIdsInAxleOrder[0]].radius : 0.0f;
+		PxVehicleLodUpdate(*lodParams, observerPositions, nbObservers, *rigidBodyState, wheelRadius, *lodState);
+
+		if (PxVehicleLodLevel::eFULL == lodState->level)
+			return true;
+
+		for (PxU32 i = 0; i < axleDescription->nbWheels; i++)
+		{
+			const PxU32 wheelId = axleDescription->wheelIdsInAxleOrder[i];
+
+			if (PxVehicleLodLevel::eSIMPLE == lodState->level)
+			{
+				PxVehicleLodSimpleWheelUpdate(wheelParams[wheelId], *rigidBodyState, context.frame, dt,
+					wheelRigidBody1dStates[wheelId]);
+			}
+			else
+			{
+				wheelRigidBody1dStates[wheelId].rotationSpeed = 0.0f;
+				wheelRigidBody1dStates[wheelId].correctedRotationSpeed = 0.0f;
+			}
+		}
+
+		return false;
+	}
+};
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
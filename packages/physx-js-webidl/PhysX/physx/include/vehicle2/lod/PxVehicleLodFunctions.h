@@ -0,0 +1,88 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+
+#include "foundation/PxPreprocessor.h"
+#include "foundation/PxSimpleTypes.h"
+#include "foundation/PxVec3.h"
+
+#include "vehicle2/PxVehicleParams.h"
+#include "PxVehicleLodParams.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+struct PxVehicleRigidBodyState;
+struct PxVehicleWheelParams;
+struct PxVehicleWheelRigidBody1dState;
+struct PxVehicleLodState;
+
+/**
+\brief Update the level of detail of a vehicle from the positions of the observers.
+\param[in] lodParams describes the distances and thresholds of the level of detail.
+\param[in] observerPositions are the world space positions of the observers, typically the players' cameras.
+\param[in] nbObservers is the number of observers. With no observer, the vehicle is considered infinitely far.
+\param[in] rigidBodyState describes the pose and velocities of the vehicle rigid body.
+\param[in] wheelRadius is the radius used to turn sleepSpeed into an angular speed threshold.
+\param[in,out] lodState is the level of detail of the vehicle.
+\return True if the vehicle was promoted from a reduced fidelity level to PxVehicleLodLevel::eFULL by this update.
+*/
+bool PxVehicleLodUpdate
+(const PxVehicleLodParams& lodParams,
+ const PxVec3* observerPositions, const PxU32 nbObservers,
+ const PxVehicleRigidBodyState& rigidBodyState, const PxReal wheelRadius,
+ PxVehicleLodState& lodState);
+
+/**
+\brief Update a wheel of a vehicle simulated at PxVehicleLodLevel::eSIMPLE.
+
+The wheel rolls without slip at the longitudinal speed of the rigid body. Because the wheel speed matches the ground
+speed, the tire model starts with no slip when the vehicle is promoted back to PxVehicleLodLevel::eFULL.
+
+\param[in] wheelParams describes the radius of the wheel.
+\param[in] rigidBodyState describes the velocity of the vehicle rigid body.
+\param[in] frame describes the longitudinal, lateral and vertical axes of the vehicle.
+\param[in] dt is the simulation time that has lapsed since the last update.
+\param[in,out] wheelRigidBody1dState describes the current angular speed and angle of the wheel.
+*/
+void PxVehicleLodSimpleWheelUpdate
+(const PxVehicleWheelParams& wheelParams, const PxVehicleRigidBodyState& rigidBodyState,
+ const PxVehicleFrame& frame, const PxReal dt,
+ PxVehicleWheelRigidBody1dState& wheelRigidBody1dState);
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
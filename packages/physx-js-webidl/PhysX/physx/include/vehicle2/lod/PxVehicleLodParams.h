@@ -0,0 +1,123 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+
+#include "foundation/PxFoundation.h"
+#include "foundation/PxSimpleTypes.h"
+
+#include "vehicle2/PxVehicleParams.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+/**
+\brief The level of detail at which a vehicle is simulated.
+\see PxVehicleLodParams
+*/
+struct PxVehicleLodLevel
+{
+	enum Enum
+	{
+		eFULL = 0,	//!< The vehicle runs its full component sequence.
+		eSIMPLE,	//!< The vehicle is moved by the PhysX rigid body alone. Wheels follow the chassis kinematically and no wheel query is performed.
+		eSLEEPING	//!< The vehicle is far away and at rest. Nothing is updated.
+	};
+};
+
+/**
+\brief Distances and thresholds that drive the level of detail of a vehicle.
+
+A vehicle switches to PxVehicleLodLevel::eSIMPLE once all observers are further away than
+simpleDistance + hysteresis, and back to PxVehicleLodLevel::eFULL once any observer is closer than
+simpleDistance - hysteresis. A vehicle in PxVehicleLodLevel::eSIMPLE switches to PxVehicleLodLevel::eSLEEPING
+while the speeds of its rigid body are below sleepSpeed.
+*/
+struct PxVehicleLodParams
+{
+	/**
+	\brief The distance from the closest observer beyond which the vehicle is simulated at reduced fidelity.
+
+	<b>Range:</b> [0, inf)<br>
+	<b>Unit:</b> length
+	*/
+	PxReal simpleDistance;
+
+	/**
+	\brief The distance band around simpleDistance within which the level of detail does not change.
+
+	This prevents vehicles from switching back and forth when an observer stays near simpleDistance.
+
+	<b>Range:</b> [0, simpleDistance]<br>
+	<b>Unit:</b> length
+	*/
+	PxReal hysteresis;
+
+	/**
+	\brief The linear speed below which a reduced fidelity vehicle is considered at rest.
+
+	The angular speed is compared against sleepSpeed divided by the wheel radius of the first wheel.
+	A value of zero disables PxVehicleLodLevel::eSLEEPING.
+
+	<b>Range:</b> [0, inf)<br>
+	<b>Unit:</b> length / time
+	*/
+	PxReal sleepSpeed;
+
+	PX_FORCE_INLINE PxVehicleLodParams transformAndScale(
+		const PxVehicleFrame& srcFrame, const PxVehicleFrame& trgFrame, const PxVehicleScale& srcScale, const PxVehicleScale& trgScale) const
+	{
+		PX_UNUSED(srcFrame);
+		PX_UNUSED(trgFrame);
+		PxVehicleLodParams r = *this;
+		const PxReal scale = trgScale.scale / srcScale.scale;
+		r.simpleDistance *= scale;
+		r.hysteresis *= scale;
+		r.sleepSpeed *= scale;
+		return r;
+	}
+
+	PX_FORCE_INLINE bool isValid() const
+	{
+		PX_CHECK_AND_RETURN_VAL(simpleDistance >= 0.0f, "PxVehicleLodParams.simpleDistance must be greater than or equal to zero", false);
+		PX_CHECK_AND_RETURN_VAL(hysteresis >= 0.0f && hysteresis <= simpleDistance, "PxVehicleLodParams.hysteresis must be in range [0, simpleDistance]", false);
+		PX_CHECK_AND_RETURN_VAL(sleepSpeed >= 0.0f, "PxVehicleLodParams.sleepSpeed must be greater than or equal to zero", false);
+		return true;
+	}
+};
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
@@ -137,6 +137,75 @@ public:
 	}
 };
 
+/**
+\brief Compute the road geometry under the wheels of many vehicles with a single batched query.
+
+Unlike the other components, this component is not specific to a vehicle. It is meant to be updated once per
+simulation step, before the component sequences of the vehicles are updated, in place of a
+PxVehiclePhysXRoadGeometrySceneQueryComponent in each vehicle.
+
+\see PxVehiclePhysXRoadGeometryQueryBatchUpdate
+*/
+class PxVehiclePhysXRoadGeometrySceneQueryBatchComponent : public PxVehicleComponent
+{
+public:
+	PxVehiclePhysXRoadGeometrySceneQueryBatchComponent() : PxVehicleComponent() {}
+	virtual ~PxVehiclePhysXRoadGeometrySceneQueryBatchComponent() {}
+
+	/**
+	\brief Provide the wheels of all vehicles for this component.
+
+	\param[out] entries The query descriptions of all wheels.
+	\param[out] nbEntries The number of wheels.
+	\param[out] sortBuffer A scratch buffer of 2*nbEntries elements, or NULL to issue the queries in input order.
+	\param[out] queryType The type of scene query shared by all wheels.
+	\param[out] filterCallback The filter callback shared by all wheels. NULL is a valid value.
+	\param[out] cacheTolerance The distance a wheel's query can move before its cached result is discarded. Zero disables the cache.
+	*/
+	virtual void getDataForPhysXRoadGeometrySceneQueryBatchComponent(
+		const PxVehiclePhysXRoadGeometryQueryBatchEntry*& entries,
+		PxU32& nbEntries,
+		PxU32*& sortBuffer,
+		PxVehiclePhysXRoadGeometryQueryType::Enum& queryType,
+		PxQueryFilterCallback*& filterCallback,
+		PxReal& cacheTolerance) = 0;
+
+	virtual bool update(const PxReal dt, const PxVehicleSimulationContext& context)
+	{
+		PX_UNUSED(dt);
+
+		PX_PROFILE_ZONE("PxVehiclePhysXRoadGeometrySceneQueryBatchComponent::update", 0);
+
+		const PxVehiclePhysXRoadGeometryQueryBatchEntry* entries;
+		PxU32 nbEntries;
+		PxU32* sortBuffer;
+		PxVehiclePhysXRoadGeometryQueryType::Enum queryType;
+		PxQueryFilterCallback* filterCallback;
+		PxReal cacheTolerance;
+
+		getDataForPhysXRoadGeometrySceneQueryBatchComponent(entries, nbEntries, sortBuffer,
+			queryType, filterCallback, cacheTolerance);
+
+		if (context.getType() == PxVehicleSimulationContextType::ePHYSX)
+		{
+			const PxVehiclePhysXSimulationContext& physxContext = static_cast<const PxVehiclePhysXSimulationContext&>(context);
+
+			PxVehiclePhysXRoadGeometryQueryBatchUpdate(entries, nbEntries, sortBuffer,
+				queryType, filterCallback, cacheTolerance,
+				*physxContext.physxScene, physxContext.physxUnitCylinderSweepMesh, context.frame);
+		}
+		else
+		{
+			PX_ALWAYS_ASSERT();
+
+			for(PxU32 i = 0; i < nbEntries; i++)
+				entries[i].roadGeomState->setToDefault();
+		}
+
+		return true;
+	}
+};
+
 #if !PX_DOXYGEN
 } // namespace vehicle2
 } // namespace physx
@@ -46,6 +46,7 @@ namespace vehicle2
 struct PxVehicleWheelParams;
 struct PxVehicleSuspensionParams;
 struct PxVehiclePhysXRoadGeometryQueryState;
+struct PxVehiclePhysXRoadGeometryQueryCacheState;
 struct PxVehicleRigidBodyState;
 struct PxVehicleFrame;
 struct PxVehicleRoadGeometryState;
@@ -84,6 +85,54 @@ void PxVehiclePhysXRoadGeometryQueryUpdate
  PxVehicleRoadGeometryState& roadGeomState,
  PxVehiclePhysXRoadGeometryQueryState* physxRoadGeometryState);
 
+/**
+\brief Describes the road geometry query of a single wheel in a batch.
+\see PxVehiclePhysXRoadGeometryQueryBatchUpdate
+*/
+struct PxVehiclePhysXRoadGeometryQueryBatchEntry
+{
+	const PxVehicleWheelParams* wheelParams;								//!< The radius and halfwidth of the wheel.
+	const PxVehicleSuspensionParams* suspensionParams;						//!< The frame of the suspension and wheel and the maximum suspension travel.
+	const PxQueryFilterData* filterData;									//!< The filter data to use for the query. NULL uses default filter data.
+	const PxVehiclePhysXMaterialFrictionParams* materialFrictionParams;	//!< The mapping between PxMaterial and tire friction.
+	PxReal steerAngle;														//!< The yaw angle (in radians) of the wheel.
+	const PxVehicleRigidBodyState* rigidBodyState;							//!< The pose of the vehicle rigid body.
+	PxVehicleRoadGeometryState* roadGeomState;								//!< [out] The plane and friction of the road geometry under the wheel.
+	PxVehiclePhysXRoadGeometryQueryState* physxRoadGeomState;				//!< [out] Optional additional information about the query. May be NULL.
+	PxVehiclePhysXRoadGeometryQueryCacheState* cacheState;					//!< [in,out] Optional cached result of the previous query. May be NULL.
+};
+
+/**
+\brief Compute the road geometry under many wheels, typically all the wheels of all the vehicles of a scene, in a single call.
+
+This is equivalent to calling PxVehiclePhysXRoadGeometryQueryUpdate() for each entry, with two differences:
+\li Wheels with a cache state reuse the cached result instead of querying the scene if their query barely moved
+since the cached result was computed. Only hits against static actors are cached.
+\li If a sort buffer is provided, the remaining queries are issued in an order that groups wheels with nearby
+positions, so that consecutive queries traverse the same parts of the scene-query trees.
+
+\param[in] entries describes the query of each wheel.
+\param[in] nbEntries is the number of wheels in the batch.
+\param[in] sortBuffer is a scratch buffer of 2*nbEntries elements used to sort the queries. NULL is a valid input,
+           in which case the queries are issued in input order.
+\param[in] queryType describes what type of PhysX scene query to use (see #PxVehiclePhysXRoadGeometryQueryType).
+           If PxVehiclePhysXRoadGeometryQueryType::eNONE is used, no work will be done.
+\param[in] filterCallback describes the filter callback to use for the PhysX scene queries. NULL is a valid input.
+\param[in] cacheTolerance is the maximum distance the start of a wheel's query can move before its cached result is discarded.
+           A value of zero disables the cache.
+\param[in] scene is the PhysX scene that will be queried by the scene queries.
+\param[in] unitCylinderSweepMesh is a convex cylindrical mesh of unit radius and half-width to be used in
+the event that a sweep query is to be used.
+\param[in] frame describes the lateral, longitudinal and vertical axes.
+\see PxVehiclePhysXRoadGeometryQueryUpdate PxVehiclePhysXRoadGeometrySceneQueryBatchComponent
+*/
+void PxVehiclePhysXRoadGeometryQueryBatchUpdate
+(const PxVehiclePhysXRoadGeometryQueryBatchEntry* entries, const PxU32 nbEntries, PxU32* sortBuffer,
+ const PxVehiclePhysXRoadGeometryQueryType::Enum queryType, PxQueryFilterCallback* filterCallback,
+ const PxReal cacheTolerance,
+ const PxScene& scene, const PxConvexMesh* unitCylinderSweepMesh,
+ const PxVehicleFrame& frame);
+
 #if !PX_DOXYGEN
 } // namespace vehicle2
 } // namespace physx
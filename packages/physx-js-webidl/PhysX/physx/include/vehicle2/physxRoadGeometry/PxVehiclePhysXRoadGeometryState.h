@@ -31,6 +31,9 @@
 
 #include "foundation/PxMemory.h"
 #include "foundation/PxVec3.h"
+#include "foundation/PxTransform.h"
+
+#include "vehicle2/roadGeometry/PxVehicleRoadGeometryState.h"
 
 #if !PX_DOXYGEN
 namespace physx
@@ -57,6 +60,27 @@ struct PxVehiclePhysXRoadGeometryQueryState
 	}
 };
 
+/**
+\brief The result of the last road geometry query of a wheel, kept so that it can be reused while the wheel barely moves.
+\note Only hits against static actors are cached. The cache must be reset with setToDefault() if the static geometry
+under the wheel is modified or released.
+\see PxVehiclePhysXRoadGeometryQueryBatchUpdate
+*/
+struct PxVehiclePhysXRoadGeometryQueryCacheState
+{
+	PxTransform queryStart;										//!< The start pose of the cached query.
+	PxVec3 queryDir;											//!< The direction of the cached query.
+	PxReal queryDist;											//!< The length of the cached query.
+	PxVehicleRoadGeometryState roadGeomState;					//!< The road geometry found by the cached query.
+	PxVehiclePhysXRoadGeometryQueryState physxRoadGeomState;	//!< Additional information about the cached query.
+	bool valid;													//!< True if the cached result can be reused.
+
+	PX_FORCE_INLINE void setToDefault()
+	{
+		PxMemZero(this, sizeof(PxVehiclePhysXRoadGeometryQueryCacheState));
+	}
+};
+
 #if !PX_DOXYGEN
 } // namespace vehicle2
 } // namespace physx
@@ -0,0 +1,100 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+
+#include "vehicle2/PxVehicleParams.h"
+#include "vehicle2/PxVehicleComponent.h"
+
+#include "PxVehicleRoadGeometryHelpers.h"
+#include "PxVehicleRoadGeometryState.h"
+
+#include "common/PxProfileZone.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+/**
+\brief Keep the road planes found by the last road geometry query in step with moving road geometry during substeps.
+
+The intended setup is to update the road geometry query component (for example
+PxVehiclePhysXRoadGeometrySceneQueryComponent) once per step, outside of the substepping group, and to add this
+component as the last component of the substepping group. All substeps then run without scene queries, using the
+cached plane and friction of the hit material, and the plane follows the road geometry from one substep to the next.
+
+\see PxVehicleRoadGeometryPlaneAdvance
+*/
+class PxVehicleRoadGeometryCachedPlaneComponent : public PxVehicleComponent
+{
+public:
+
+	PxVehicleRoadGeometryCachedPlaneComponent() : PxVehicleComponent() {}
+	virtual ~PxVehicleRoadGeometryCachedPlaneComponent() {}
+
+	/**
+	\brief Provide vehicle data items for this component.
+
+	\param[out] axleDescription identifies the wheels on each axle.
+	\param[out] roadGeometryStates The cached road geometry states of the wheels.
+	*/
+	virtual void getDataForRoadGeometryCachedPlaneComponent(
+		const PxVehicleAxleDescription*& axleDescription,
+		PxVehicleArrayData<PxVehicleRoadGeometryState>& roadGeometryStates) = 0;
+
+	virtual bool update(const PxReal dt, const PxVehicleSimulationContext& context)
+	{
+		PX_UNUSED(context);
+
+		PX_PROFILE_ZONE("PxVehicleRoadGeometryCachedPlaneComponent::update", 0);
+
+		const PxVehicleAxleDescription* axleDescription;
+		PxVehicleArrayData<PxVehicleRoadGeometryState> roadGeometryStates;
+
+		getDataForRoadGeometryCachedPlaneComponent(axleDescription, roadGeometryStates);
+
+		for (PxU32 i = 0; i < axleDescription->nbWheels; i++)
+		{
+			const PxU32 wheelId = axleDescription->wheelIdsInAxleOrder[i];
+
+			PxVehicleRoadGeometryPlaneAdvance(dt, roadGeometryStates[wheelId]);
+		}
+
+		return true;
+	}
+};
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
@@ -0,0 +1,88 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+
+#include "foundation/PxAssert.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxSimpleTypes.h"
+
+#include "vehicle2/roadGeometry/PxVehicleRoadGeometryState.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+/**
+\brief Move the cached road plane under a wheel along with the road geometry.
+
+Road geometry queries are typically issued once per simulation step, outside of any substepping group, and the
+resulting plane is used by all substeps. If the road geometry moves, for example a moving platform, the cached plane
+lags behind by up to one step. This function translates the plane by the velocity of the road geometry so that each
+substep sees the plane where the road geometry is expected to be, without a new query.
+
+\param[in] dt is the simulation time that has lapsed since the plane was last updated.
+\param[in,out] roadGeomState is the road geometry under the wheel. It is left untouched if no plane was found.
+\note Only the translation of the road geometry is accounted for. Rotating road geometry is not.
+*/
+PX_FORCE_INLINE void PxVehicleRoadGeometryPlaneAdvance(const PxReal dt, PxVehicleRoadGeometryState& roadGeomState)
+{
+	if (roadGeomState.hitState)
+		roadGeomState.plane.d -= roadGeomState.plane.n.dot(roadGeomState.velocity) * dt;
+}
+
+/**
+\brief Compute the number of substeps required to keep each substep at or below a fixed timestep.
+
+This allows the vehicle to be integrated at a fixed rate (for example 120Hz) independently of the rate at which the
+scene is stepped. The result is meant to be passed to PxVehicleComponentSequence::setSubsteps() before each update.
+
+\param[in] dt is the timestep of the update.
+\param[in] maxSubstepDt is the largest allowed substep timestep.
+\param[in] maxNbSubsteps is the largest allowed number of substeps. Substeps get longer than maxSubstepDt if it is reached.
+\return The number of substeps, in range [1, maxNbSubsteps].
+*/
+PX_FORCE_INLINE PxU8 PxVehicleComputeNbSubsteps(const PxReal dt, const PxReal maxSubstepDt, const PxU8 maxNbSubsteps)
+{
+	PX_ASSERT(maxSubstepDt > 0.0f);
+	PX_ASSERT(maxNbSubsteps > 0);
+
+	//Allow a small tolerance so that dt = n*maxSubstepDt does not round up to n+1 substeps.
+	const PxReal nbSubsteps = PxCeil(dt / maxSubstepDt - 1e-4f);
+	return PxU8(PxClamp(nbSubsteps, 1.0f, PxReal(maxNbSubsteps)));
+}
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
@@ -0,0 +1,823 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet is a headless benchmark for the simulation and scene queries.
+//
+// It runs a fixed set of game-like scenes, generated with a fixed seed:
+// - kinematicCapsules: 5000 kinematic capsules walking on a heightfield,
+//   among rolling dynamic spheres
+// - staticProps: 10000 static props with dynamic objects falling on them
+// - itemPiles: piles of boxes, spheres and capsules settling on the ground
+// - ragdollBursts: bursts of jointed ragdolls, the oldest ones being
+//   released to keep a fixed budget
+// - raycastStorm: thousands of scene raycasts per frame against static props
+// - cctCrowd: a crowd of capsule character controllers walking among props
+// - spike: a frame recorded by PxFrameSpikeRecorder, only run when a report
+//   is given with --spike. Use "--warmup 0 --frames 1" to replay the slow
+//   frame alone. The report does not contain the scene settings, the scene
+//   is created with the benchmark settings.
+//
+// For each scene it reports, as JSON on stdout:
+// - the average, min and max frame times, split between the scene update
+//   (kinematic targets, queries, character moves) and the simulation step
+// - the average time of each stage of the simulation pipeline, from
+//   PxScene::getSimulationStageTimings()
+// - the number of allocations per frame and the peak memory per subsystem,
+//   from PxAllocationTracker
+// - the PxSimulationStatistics counters of the last frame
+//
+// Progress messages go to stderr so that the output can be piped to a file
+// and compared between builds, e.g. between native and WebAssembly builds.
+//
+// Command line: [--frames N] [--warmup N] [--threads N] [--scene name] [--spike file]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "PxPhysicsAPI.h"
+#include "extensions/PxCollectionExt.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics = NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+static PxMaterial*				gMaterial = NULL;
+static PxScene*					gScene = NULL;
+static PxControllerManager*		gControllerManager = NULL;
+static PxHeightField*			gHeightField = NULL;
+
+// PT: WebAssembly builds are usually single-threaded, so the default runs the simulation on the main thread everywhere
+// to keep native and WebAssembly numbers comparable. Use --threads to measure multithreaded native builds.
+static PxU32		gNbThreads = 0;
+static PxU32		gNbFrames = 300;
+static PxU32		gNbWarmupFrames = 30;
+static const char*	gSceneFilter = NULL;
+static const char*	gSpikeFile = NULL;
+static const PxReal	gTimeStep = 1.0f/60.0f;
+
+namespace
+{
+	// Simple deterministic random generator, so that the scenes are the same for each run
+	class BenchmarkRandom
+	{
+		public:
+			BenchmarkRandom(PxU32 seed) : mSeed(seed)	{}
+
+			float	randomFloat01()
+			{
+				mSeed = mSeed * 1664525 + 1013904223;
+				return float(mSeed>>8) / float(1<<24);
+			}
+
+			float	randomFloat(float minValue, float maxValue)
+			{
+				return minValue + randomFloat01() * (maxValue - minValue);
+			}
+
+		private:
+			PxU32	mSeed;
+	};
+
+	struct Walker
+	{
+		PxRigidDynamic*	mActor;
+		PxController*	mController;
+		PxVec3			mPos;
+		PxReal			mHeading;
+		PxReal			mTurnRate;
+	};
+
+	struct Ragdoll
+	{
+		PxRigidDynamic*	mBones[11];
+		PxJoint*		mJoints[10];
+	};
+
+	struct Bone
+	{
+		PxI32	mParent;
+		PxVec3	mP0;	// Also the joint anchor, when the bone has a parent
+		PxVec3	mP1;
+		PxReal	mRadius;
+	};
+
+	// Scenes are created by setup(), modified each frame by update() before the simulation step, and destroyed by
+	// cleanup() before the scene itself is released.
+	struct BenchmarkScene
+	{
+		const char*	mName;
+		void		(*mSetup)(BenchmarkRandom& rnd);
+		void		(*mUpdate)(PxU32 frame, BenchmarkRandom& rnd);
+		void		(*mCleanup)();
+	};
+}
+
+static PxArray<Walker>	gWalkers;
+static PxArray<Ragdoll>	gRagdolls;
+static PxU32			gOldestRagdoll = 0;
+static PxU32			gNbRaycastHits = 0;
+
+static const PxReal		gTerrainRowScale = 1.0f;
+static const PxReal		gTerrainColumnScale = 1.0f;
+static const PxReal		gTerrainHeightScale = 0.01f;
+static const PxU32		gTerrainSize = 257;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static PxReal terrainHeight(PxReal x, PxReal z)
+{
+	return 4.0f * PxSin(x * 0.05f) * PxCos(z * 0.07f) + 1.5f * PxSin(x * 0.17f + z * 0.11f);
+}
+
+static void createTerrain()
+{
+	PxArray<PxHeightFieldSample> samples(gTerrainSize * gTerrainSize);
+	for(PxU32 row=0;row<gTerrainSize;row++)
+	{
+		for(PxU32 col=0;col<gTerrainSize;col++)
+		{
+			PxHeightFieldSample& sample = samples[row * gTerrainSize + col];
+			const PxReal h = terrainHeight(PxReal(row) * gTerrainRowScale, PxReal(col) * gTerrainColumnScale);
+			sample.height			= PxI16(PxFloor(h / gTerrainHeightScale + 0.5f));
+			sample.materialIndex0	= 0;
+			sample.materialIndex1	= 0;
+		}
+	}
+
+	PxHeightFieldDesc hfDesc;
+	hfDesc.nbRows			= gTerrainSize;
+	hfDesc.nbColumns		= gTerrainSize;
+	hfDesc.samples.data		= samples.begin();
+	hfDesc.samples.stride	= sizeof(PxHeightFieldSample);
+	gHeightField = PxCreateHeightField(hfDesc, gPhysics->getPhysicsInsertionCallback());
+
+	const PxHeightFieldGeometry geom(gHeightField, PxMeshGeometryFlags(), gTerrainHeightScale, gTerrainRowScale, gTerrainColumnScale);
+	gScene->addActor(*PxCreateStatic(*gPhysics, PxTransform(PxIdentity), geom, *gMaterial));
+}
+
+static PxReal sampleTerrain(PxReal x, PxReal z)
+{
+	return gHeightField->getHeight(x / gTerrainRowScale, z / gTerrainColumnScale) * gTerrainHeightScale;
+}
+
+static void createGround()
+{
+	gScene->addActor(*PxCreatePlane(*gPhysics, PxPlane(0.0f, 1.0f, 0.0f, 0.0f), *gMaterial));
+}
+
+// Static props: boxes and capsules of various sizes scattered on a square, like buildings, rocks and trees
+static void createStaticProps(BenchmarkRandom& rnd, PxU32 nbProps, PxReal extent)
+{
+	for(PxU32 i=0;i<nbProps;i++)
+	{
+		const PxVec3 pos(rnd.randomFloat(-extent, extent), 0.0f, rnd.randomFloat(-extent, extent));
+		const PxQuat rot(rnd.randomFloat(0.0f, PxTwoPi), PxVec3(0.0f, 1.0f, 0.0f));
+		PxRigidStatic* actor;
+		if(i&1)
+		{
+			const PxVec3 halfExtents(rnd.randomFloat(0.2f, 2.0f), rnd.randomFloat(0.2f, 3.0f), rnd.randomFloat(0.2f, 2.0f));
+			actor = PxCreateStatic(*gPhysics, PxTransform(pos + PxVec3(0.0f, halfExtents.y, 0.0f), rot), PxBoxGeometry(halfExtents), *gMaterial);
+		}
+		else
+		{
+			const PxReal radius = rnd.randomFloat(0.1f, 0.5f);
+			const PxReal halfHeight = rnd.randomFloat(0.5f, 3.0f);
+			actor = PxCreateStatic(*gPhysics, PxTransform(pos + PxVec3(0.0f, halfHeight + radius, 0.0f), PxQuat(PxHalfPi, PxVec3(0.0f, 0.0f, 1.0f))),
+				PxCapsuleGeometry(radius, halfHeight), *gMaterial);
+		}
+		gScene->addActor(*actor);
+	}
+}
+
+static PxRigidDynamic* createItem(BenchmarkRandom& rnd, const PxVec3& pos)
+{
+	const PxTransform pose(pos, PxQuat(rnd.randomFloat(0.0f, PxTwoPi), PxVec3(0.0f, 1.0f, 0.0f)));
+	const PxReal size = rnd.randomFloat(0.15f, 0.4f);
+	const float type = rnd.randomFloat01();
+	PxRigidDynamic* actor;
+	if(type<0.4f)
+		actor = PxCreateDynamic(*gPhysics, pose, PxBoxGeometry(size, size * 0.7f, size * 1.2f), *gMaterial, 10.0f);
+	else if(type<0.7f)
+		actor = PxCreateDynamic(*gPhysics, pose, PxSphereGeometry(size), *gMaterial, 10.0f);
+	else
+		actor = PxCreateDynamic(*gPhysics, pose, PxCapsuleGeometry(size * 0.5f, size), *gMaterial, 10.0f);
+	gScene->addActor(*actor);
+	return actor;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void setupKinematicCapsules(BenchmarkRandom& rnd)
+{
+	createTerrain();
+
+	const PxReal extent = PxReal(gTerrainSize - 1) * gTerrainRowScale;
+	const PxReal radius = 0.3f;
+	const PxReal halfHeight = 0.6f;
+	const PxQuat upright(PxHalfPi, PxVec3(0.0f, 0.0f, 1.0f));
+
+	gWalkers.reserve(5000);
+	for(PxU32 i=0;i<5000;i++)
+	{
+		Walker w;
+		w.mPos = PxVec3(rnd.randomFloat(8.0f, extent - 8.0f), 0.0f, rnd.randomFloat(8.0f, extent - 8.0f));
+		w.mPos.y = sampleTerrain(w.mPos.x, w.mPos.z) + halfHeight + radius;
+		w.mHeading = rnd.randomFloat(0.0f, PxTwoPi);
+		w.mTurnRate = rnd.randomFloat(-1.0f, 1.0f);
+		w.mController = NULL;
+		w.mActor = PxCreateKinematic(*gPhysics, PxTransform(w.mPos, upright), PxCapsuleGeometry(radius, halfHeight), *gMaterial, 1.0f);
+		gScene->addActor(*w.mActor);
+		gWalkers.pushBack(w);
+	}
+
+	for(PxU32 i=0;i<500;i++)
+	{
+		const PxReal x = rnd.randomFloat(8.0f, extent - 8.0f);
+		const PxReal z = rnd.randomFloat(8.0f, extent - 8.0f);
+		const PxReal r = rnd.randomFloat(0.2f, 0.6f);
+		gScene->addActor(*PxCreateDynamic(*gPhysics, PxTransform(PxVec3(x, sampleTerrain(x, z) + r + 0.5f, z)), PxSphereGeometry(r), *gMaterial, 10.0f));
+	}
+}
+
+static void updateKinematicCapsules(PxU32, BenchmarkRandom&)
+{
+	const PxReal extent = PxReal(gTerrainSize - 1) * gTerrainRowScale;
+	const PxReal speed = 1.5f;
+	const PxReal offset = 0.9f;	// halfHeight + radius
+	const PxQuat upright(PxHalfPi, PxVec3(0.0f, 0.0f, 1.0f));
+
+	const PxU32 nbWalkers = gWalkers.size();
+	for(PxU32 i=0;i<nbWalkers;i++)
+	{
+		Walker& w = gWalkers[i];
+		w.mHeading += w.mTurnRate * gTimeStep;
+		w.mPos.x += PxCos(w.mHeading) * speed * gTimeStep;
+		w.mPos.z += PxSin(w.mHeading) * speed * gTimeStep;
+		// Turn back at the terrain borders
+		if(w.mPos.x<4.0f || w.mPos.x>extent - 4.0f || w.mPos.z<4.0f || w.mPos.z>extent - 4.0f)
+		{
+			w.mHeading += PxPi;
+			w.mPos.x = PxClamp(w.mPos.x, 4.0f, extent - 4.0f);
+			w.mPos.z = PxClamp(w.mPos.z, 4.0f, extent - 4.0f);
+		}
+		w.mPos.y = sampleTerrain(w.mPos.x, w.mPos.z) + offset;
+		w.mActor->setKinematicTarget(PxTransform(w.mPos, upright));
+	}
+}
+
+static void cleanupWalkers()
+{
+	gWalkers.reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void setupStaticProps(BenchmarkRandom& rnd)
+{
+	createGround();
+	createStaticProps(rnd, 10000, 200.0f);
+
+	for(PxU32 i=0;i<1000;i++)
+		createItem(rnd, PxVec3(rnd.randomFloat(-200.0f, 200.0f), rnd.randomFloat(8.0f, 20.0f), rnd.randomFloat(-200.0f, 200.0f)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void setupItemPiles(BenchmarkRandom& rnd)
+{
+	createGround();
+
+	// 16 piles of 10x10x12 items, dropped as loose grids so that they collapse into piles
+	for(PxU32 p=0;p<16;p++)
+	{
+		const PxVec3 center(PxReal(p & 3) * 20.0f - 30.0f, 0.0f, PxReal(p >> 2) * 20.0f - 30.0f);
+		for(PxU32 y=0;y<12;y++)
+			for(PxU32 x=0;x<10;x++)
+				for(PxU32 z=0;z<10;z++)
+					createItem(rnd, center + PxVec3(PxReal(x) * 0.9f - 4.5f, 0.5f + PxReal(y) * 0.9f, PxReal(z) * 0.9f - 4.5f));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static const PxU32	gNbRagdollsPerBurst = 16;
+static const PxU32	gMaxNbRagdolls = 256;
+static const PxU32	gRagdollBurstPeriod = 30;
+
+static const Bone gRagdollBones[11] =
+{
+	{ -1,	PxVec3(-0.15f, 1.0f, 0.0f),		PxVec3(0.15f, 1.0f, 0.0f),		0.12f },	// pelvis
+	{ 0,	PxVec3(0.0f, 1.12f, 0.0f),		PxVec3(0.0f, 1.45f, 0.0f),		0.15f },	// torso
+	{ 1,	PxVec3(0.0f, 1.62f, 0.0f),		PxVec3(0.0f, 1.75f, 0.0f),		0.1f },		// head
+	{ 1,	PxVec3(0.22f, 1.45f, 0.0f),		PxVec3(0.5f, 1.45f, 0.0f),		0.05f },	// left upper arm
+	{ 3,	PxVec3(0.52f, 1.45f, 0.0f),		PxVec3(0.8f, 1.45f, 0.0f),		0.045f },	// left lower arm
+	{ 1,	PxVec3(-0.22f, 1.45f, 0.0f),	PxVec3(-0.5f, 1.45f, 0.0f),		0.05f },	// right upper arm
+	{ 5,	PxVec3(-0.52f, 1.45f, 0.0f),	PxVec3(-0.8f, 1.45f, 0.0f),		0.045f },	// right lower arm
+	{ 0,	PxVec3(0.12f, 0.9f, 0.0f),		PxVec3(0.12f, 0.52f, 0.0f),		0.07f },	// left thigh
+	{ 7,	PxVec3(0.12f, 0.48f, 0.0f),		PxVec3(0.12f, 0.08f, 0.0f),		0.06f },	// left shin
+	{ 0,	PxVec3(-0.12f, 0.9f, 0.0f),		PxVec3(-0.12f, 0.52f, 0.0f),	0.07f },	// right thigh
+	{ 9,	PxVec3(-0.12f, 0.48f, 0.0f),	PxVec3(-0.12f, 0.08f, 0.0f),	0.06f },	// right shin
+};
+
+static void createRagdoll(Ragdoll& ragdoll, const PxTransform& pose, const PxVec3& linVel)
+{
+	for(PxU32 i=0;i<11;i++)
+	{
+		const Bone& bone = gRagdollBones[i];
+		const PxVec3 axis = bone.mP1 - bone.mP0;
+		const PxReal length = axis.magnitude();
+		const PxTransform bonePose = pose * PxTransform((bone.mP0 + bone.mP1) * 0.5f, PxShortestRotation(PxVec3(1.0f, 0.0f, 0.0f), axis / length));
+
+		PxRigidDynamic* actor = PxCreateDynamic(*gPhysics, bonePose, PxCapsuleGeometry(bone.mRadius, length * 0.5f), *gMaterial, 10.0f);
+		actor->setLinearVelocity(linVel);
+		actor->setSolverIterationCounts(8, 1);
+		ragdoll.mBones[i] = actor;
+
+		if(bone.mParent>=0)
+		{
+			PxRigidDynamic* parent = ragdoll.mBones[bone.mParent];
+			const PxTransform anchor = pose * PxTransform(bone.mP0);
+			PxSphericalJoint* j = PxSphericalJointCreate(*gPhysics,	parent, parent->getGlobalPose().getInverse() * anchor,
+																	actor, bonePose.getInverse() * anchor);
+			j->setLimitCone(PxJointLimitCone(PxPi/4.0f, PxPi/4.0f));
+			j->setSphericalJointFlag(PxSphericalJointFlag::eLIMIT_ENABLED, true);
+			ragdoll.mJoints[i-1] = j;
+		}
+	}
+
+	// Add all bones at once, once the joints exist
+	gScene->addActors(reinterpret_cast<PxActor*const*>(ragdoll.mBones), 11);
+}
+
+static void releaseRagdoll(Ragdoll& ragdoll)
+{
+	for(PxU32 i=0;i<10;i++)
+		ragdoll.mJoints[i]->release();
+	for(PxU32 i=0;i<11;i++)
+		ragdoll.mBones[i]->release();
+}
+
+static void spawnRagdollBurst(BenchmarkRandom& rnd)
+{
+	for(PxU32 i=0;i<gNbRagdollsPerBurst;i++)
+	{
+		const PxTransform pose(	PxVec3(rnd.randomFloat(-20.0f, 20.0f), rnd.randomFloat(2.0f, 8.0f), rnd.randomFloat(-20.0f, 20.0f)),
+								PxQuat(rnd.randomFloat(0.0f, PxTwoPi), PxVec3(0.0f, 1.0f, 0.0f)));
+		const PxVec3 linVel(rnd.randomFloat(-5.0f, 5.0f), rnd.randomFloat(0.0f, 5.0f), rnd.randomFloat(-5.0f, 5.0f));
+
+		// Once the budget is reached, the oldest ragdoll is replaced
+		if(gRagdolls.size()<gMaxNbRagdolls)
+		{
+			Ragdoll ragdoll;
+			createRagdoll(ragdoll, pose, linVel);
+			gRagdolls.pushBack(ragdoll);
+		}
+		else
+		{
+			releaseRagdoll(gRagdolls[gOldestRagdoll]);
+			createRagdoll(gRagdolls[gOldestRagdoll], pose, linVel);
+			gOldestRagdoll = (gOldestRagdoll + 1) % gMaxNbRagdolls;
+		}
+	}
+}
+
+static void setupRagdollBursts(BenchmarkRandom& rnd)
+{
+	createGround();
+	createStaticProps(rnd, 200, 25.0f);
+	gOldestRagdoll = 0;
+	spawnRagdollBurst(rnd);
+}
+
+static void updateRagdollBursts(PxU32 frame, BenchmarkRandom& rnd)
+{
+	if(frame && (frame % gRagdollBurstPeriod)==0)
+		spawnRagdollBurst(rnd);
+}
+
+static void cleanupRagdollBursts()
+{
+	const PxU32 nbRagdolls = gRagdolls.size();
+	for(PxU32 i=0;i<nbRagdolls;i++)
+		releaseRagdoll(gRagdolls[i]);
+	gRagdolls.reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static const PxU32	gNbRaycastsPerFrame = 8192;
+
+static void setupRaycastStorm(BenchmarkRandom& rnd)
+{
+	createGround();
+	createStaticProps(rnd, 10000, 200.0f);
+
+	for(PxU32 i=0;i<500;i++)
+		createItem(rnd, PxVec3(rnd.randomFloat(-200.0f, 200.0f), rnd.randomFloat(8.0f, 20.0f), rnd.randomFloat(-200.0f, 200.0f)));
+	gNbRaycastHits = 0;
+}
+
+// A mix of long horizontal rays (visibility, bullets) and short vertical rays (ground probes)
+static void updateRaycastStorm(PxU32, BenchmarkRandom& rnd)
+{
+	PxRaycastBuffer hit;
+	for(PxU32 i=0;i<gNbRaycastsPerFrame;i++)
+	{
+		const PxVec3 origin(rnd.randomFloat(-200.0f, 200.0f), rnd.randomFloat(0.5f, 4.0f), rnd.randomFloat(-200.0f, 200.0f));
+		if(i&3)
+		{
+			const PxReal angle = rnd.randomFloat(0.0f, PxTwoPi);
+			const PxVec3 dir(PxCos(angle), rnd.randomFloat(-0.05f, 0.05f), PxSin(angle));
+			if(gScene->raycast(origin, dir.getNormalized(), 100.0f, hit))
+				gNbRaycastHits++;
+		}
+		else
+		{
+			if(gScene->raycast(origin + PxVec3(0.0f, 10.0f, 0.0f), PxVec3(0.0f, -1.0f, 0.0f), 20.0f, hit))
+				gNbRaycastHits++;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void setupCCTCrowd(BenchmarkRandom& rnd)
+{
+	createGround();
+	createStaticProps(rnd, 1000, 60.0f);
+
+	gControllerManager = PxCreateControllerManager(*gScene);
+
+	gWalkers.reserve(1000);
+	for(PxU32 i=0;i<1000;i++)
+	{
+		PxCapsuleControllerDesc desc;
+		desc.height		= 1.2f;
+		desc.radius		= 0.3f;
+		desc.stepOffset	= 0.3f;
+		desc.material	= gMaterial;
+		desc.position	= PxExtendedVec3(rnd.randomFloat(-60.0f, 60.0f), 1.0f, rnd.randomFloat(-60.0f, 60.0f));
+
+		Walker w;
+		w.mActor		= NULL;
+		w.mController	= gControllerManager->createController(desc);
+		w.mPos			= PxVec3(0.0f);
+		w.mHeading		= rnd.randomFloat(0.0f, PxTwoPi);
+		w.mTurnRate		= rnd.randomFloat(-1.0f, 1.0f);
+		// Controllers spawned inside props are skipped, like a game would
+		if(w.mController)
+			gWalkers.pushBack(w);
+	}
+}
+
+static void updateCCTCrowd(PxU32, BenchmarkRandom&)
+{
+	const PxReal speed = 2.0f;
+	const PxControllerFilters filters;
+	const PxU32 nbWalkers = gWalkers.size();
+	for(PxU32 i=0;i<nbWalkers;i++)
+	{
+		Walker& w = gWalkers[i];
+		w.mHeading += w.mTurnRate * gTimeStep;
+		const PxVec3 disp(PxCos(w.mHeading) * speed * gTimeStep, -9.81f * gTimeStep * gTimeStep, PxSin(w.mHeading) * speed * gTimeStep);
+		const PxControllerCollisionFlags flags = w.mController->move(disp, 0.001f, gTimeStep, filters);
+		// Walk away from whatever was hit
+		if(flags & PxControllerCollisionFlag::eCOLLISION_SIDES)
+			w.mHeading += PxHalfPi;
+	}
+}
+
+static void cleanupCCTCrowd()
+{
+	gWalkers.reset();
+	PX_RELEASE(gControllerManager);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static PxSerializationRegistry*	gSpikeRegistry = NULL;
+static PxCollection*			gSpikeCollection = NULL;
+static void*					gSpikeMemory = NULL;
+
+static void setupSpike(BenchmarkRandom&)
+{
+	PxDefaultFileInputData data(gSpikeFile);
+	if(!data.isValid())
+	{
+		fprintf(stderr, "Cannot open %s\n", gSpikeFile);
+		return;
+	}
+
+	PxFrameSpikeInfo info;
+	gSpikeRegistry = PxSerialization::createSerializationRegistry(*gPhysics);
+	gSpikeCollection = PxFrameSpikeRecorder::load(data, *gSpikeRegistry, gSpikeMemory, &info);
+	if(gSpikeCollection)
+	{
+		gScene->addCollection(*gSpikeCollection);
+		fprintf(stderr, "Replaying frame %u, recorded in %.3f ms\n", info.frameIndex, double(info.frameTime));
+	}
+}
+
+static void cleanupSpike()
+{
+	if(gSpikeCollection)
+	{
+		PxCollectionExt::releaseObjects(*gSpikeCollection);
+		PX_RELEASE(gSpikeCollection);
+	}
+	PxFrameSpikeRecorder::releaseMemory(gSpikeMemory);
+	gSpikeMemory = NULL;
+	PX_RELEASE(gSpikeRegistry);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static const BenchmarkScene gScenes[] =
+{
+	{ "kinematicCapsules",	setupKinematicCapsules,	updateKinematicCapsules,	cleanupWalkers			},
+	{ "staticProps",		setupStaticProps,		NULL,						NULL					},
+	{ "itemPiles",			setupItemPiles,			NULL,						NULL					},
+	{ "ragdollBursts",		setupRagdollBursts,		updateRagdollBursts,		cleanupRagdollBursts	},
+	{ "raycastStorm",		setupRaycastStorm,		updateRaycastStorm,			NULL					},
+	{ "cctCrowd",			setupCCTCrowd,			updateCCTCrowd,				cleanupCCTCrowd			},
+	{ "spike",				setupSpike,				NULL,						cleanupSpike			},
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct FrameTimes
+	{
+		FrameTimes() : mTotal(0.0f), mMin(PX_MAX_F32), mMax(0.0f)	{}
+
+		void	add(PxReal time)
+		{
+			mTotal += time;
+			mMin = PxMin(mMin, time);
+			mMax = PxMax(mMax, time);
+		}
+
+		PxReal	mTotal;
+		PxReal	mMin;
+		PxReal	mMax;
+	};
+}
+
+static void printFrameTimes(const char* name, const FrameTimes& times, PxU32 nbFrames, bool last)
+{
+	printf("      \"%s\": { \"avgMs\": %.4f, \"minMs\": %.4f, \"maxMs\": %.4f }%s\n", name,
+		double(times.mTotal / PxReal(nbFrames)), double(times.mMin), double(times.mMax), last ? "" : ",");
+}
+
+static void printStatistics(const PxSimulationStatistics& stats)
+{
+	printf("      \"stats\": {\n");
+	printf("        \"nbActiveConstraints\": %u,\n", stats.nbActiveConstraints);
+	printf("        \"nbActiveDynamicBodies\": %u,\n", stats.nbActiveDynamicBodies);
+	printf("        \"nbActiveKinematicBodies\": %u,\n", stats.nbActiveKinematicBodies);
+	printf("        \"nbStaticBodies\": %u,\n", stats.nbStaticBodies);
+	printf("        \"nbDynamicBodies\": %u,\n", stats.nbDynamicBodies);
+	printf("        \"nbKinematicBodies\": %u,\n", stats.nbKinematicBodies);
+	printf("        \"nbAggregates\": %u,\n", stats.nbAggregates);
+	printf("        \"nbArticulations\": %u,\n", stats.nbArticulations);
+	printf("        \"nbAxisSolverConstraints\": %u,\n", stats.nbAxisSolverConstraints);
+	printf("        \"compressedContactSize\": %u,\n", stats.compressedContactSize);
+	printf("        \"requiredContactConstraintMemory\": %u,\n", stats.requiredContactConstraintMemory);
+	printf("        \"peakConstraintMemory\": %u,\n", stats.peakConstraintMemory);
+	printf("        \"nbDiscreteContactPairsTotal\": %u,\n", stats.nbDiscreteContactPairsTotal);
+	printf("        \"nbDiscreteContactPairsWithCacheHits\": %u,\n", stats.nbDiscreteContactPairsWithCacheHits);
+	printf("        \"nbDiscreteContactPairsWithContacts\": %u,\n", stats.nbDiscreteContactPairsWithContacts);
+	printf("        \"nbNewPairs\": %u,\n", stats.nbNewPairs);
+	printf("        \"nbLostPairs\": %u,\n", stats.nbLostPairs);
+	printf("        \"nbNewTouches\": %u,\n", stats.nbNewTouches);
+	printf("        \"nbLostTouches\": %u,\n", stats.nbLostTouches);
+	printf("        \"nbPartitions\": %u,\n", stats.nbPartitions);
+	printf("        \"nbBroadPhaseAdds\": %u,\n", stats.getNbBroadPhaseAdds());
+	printf("        \"nbBroadPhaseRemoves\": %u\n", stats.getNbBroadPhaseRemoves());
+	printf("      }\n");
+}
+
+static void runScene(const BenchmarkScene& desc, bool first)
+{
+	fprintf(stderr, "Running %s...\n", desc.mName);
+
+	BenchmarkRandom rnd(42);
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity		= PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher	= gDispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+
+	const PxU64 setupStart = SnippetUtils::getCurrentTimeCounterValue();
+	gScene = gPhysics->createScene(sceneDesc);
+	desc.mSetup(rnd);
+	const PxReal setupTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - setupStart);
+
+	FrameTimes updateTimes;
+	FrameTimes stepTimes;
+	PxReal stageTotals[PxSimulationStage::eCOUNT];
+	for(PxU32 i=0;i<PxSimulationStage::eCOUNT;i++)
+		stageTotals[i] = 0.0f;
+
+	PxAllocationStats allocStart[PxAllocationSubsystem::eCOUNT];
+	PxAllocationStats allocEnd[PxAllocationSubsystem::eCOUNT];
+	PxAllocationTracker* tracker = NULL;	// PT: gNbFrames is at least 1 so this is always created in the loop
+
+	const PxU32 nbFrames = gNbWarmupFrames + gNbFrames;
+	for(PxU32 frame=0;frame<nbFrames;frame++)
+	{
+		// Allocations are only tracked after the warmup frames, once the scene has reached its steady state
+		if(frame==gNbWarmupFrames)
+		{
+			tracker = new PxAllocationTracker;
+			tracker->getStats(allocStart);
+		}
+		const bool measured = frame>=gNbWarmupFrames;
+
+		const PxU64 updateStart = SnippetUtils::getCurrentTimeCounterValue();
+		if(desc.mUpdate)
+			desc.mUpdate(frame, rnd);
+		const PxU64 stepStart = SnippetUtils::getCurrentTimeCounterValue();
+		gScene->simulate(gTimeStep);
+		gScene->fetchResults(true);
+		const PxU64 stepEnd = SnippetUtils::getCurrentTimeCounterValue();
+
+		if(measured)
+		{
+			updateTimes.add(SnippetUtils::getElapsedTimeInMilliseconds(stepStart - updateStart));
+			stepTimes.add(SnippetUtils::getElapsedTimeInMilliseconds(stepEnd - stepStart));
+
+			PxSimulationStageTimings timings;
+			gScene->getSimulationStageTimings(timings);
+			for(PxU32 i=0;i<PxSimulationStage::eCOUNT;i++)
+				stageTotals[i] += timings.stages[i].getDuration();
+		}
+	}
+
+	tracker->getStats(allocEnd);
+
+	PxSimulationStatistics stats;
+	gScene->getSimulationStatistics(stats);
+
+	printf("%s    {\n", first ? "" : ",\n");
+	printf("      \"name\": \"%s\",\n", desc.mName);
+	printf("      \"setupMs\": %.3f,\n", double(setupTime));
+	printFrameTimes("update", updateTimes, gNbFrames, false);
+	printFrameTimes("step", stepTimes, gNbFrames, false);
+
+	printf("      \"stages\": {");
+	for(PxU32 i=0;i<PxSimulationStage::eCOUNT;i++)
+	{
+		const char* name = PxSimulationStageTimings::getStageName(PxSimulationStage::Enum(i));
+		printf("%s \"%s\": %.4f", i ? "," : "", name, double(stageTotals[i] / PxReal(gNbFrames)));
+	}
+	printf(" },\n");
+
+	PxU64 nbAllocations = 0;
+	PxU64 peakBytes = 0;
+	printf("      \"allocations\": {\n");
+	printf("        \"subsystems\": {");
+	for(PxU32 i=0;i<PxAllocationSubsystem::eCOUNT;i++)
+	{
+		const PxU64 nb = allocEnd[i].nbAllocations - allocStart[i].nbAllocations;
+		nbAllocations += nb;
+		peakBytes += allocEnd[i].peakBytes;
+		printf("%s \"%s\": { \"perFrame\": %.2f, \"peakBytes\": %llu }", i ? "," : "", PxAllocationTracker::getSubsystemName(PxAllocationSubsystem::Enum(i)),
+			double(nb) / double(gNbFrames), static_cast<unsigned long long>(allocEnd[i].peakBytes));
+	}
+	printf(" },\n");
+	printf("        \"perFrame\": %.2f,\n", double(nbAllocations) / double(gNbFrames));
+	printf("        \"peakBytes\": %llu\n", static_cast<unsigned long long>(peakBytes));
+	printf("      },\n");
+
+	if(gNbRaycastHits)
+		printf("      \"raycastHits\": %u,\n", gNbRaycastHits);
+
+	printStatistics(stats);
+	printf("    }");
+	fflush(stdout);
+
+	delete tracker;
+
+	if(desc.mCleanup)
+		desc.mCleanup();
+	PX_RELEASE(gScene);
+	PX_RELEASE(gHeightField);
+	gNbRaycastHits = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool parseArgs(int argc, const char*const* argv)
+{
+	for(int i=1;i<argc;i++)
+	{
+		const bool hasValue = i+1<argc;
+		if(hasValue && !strcmp(argv[i], "--frames"))
+			gNbFrames = PxMax(1u, PxU32(atoi(argv[++i])));
+		else if(hasValue && !strcmp(argv[i], "--warmup"))
+			gNbWarmupFrames = PxU32(atoi(argv[++i]));
+		else if(hasValue && !strcmp(argv[i], "--threads"))
+			gNbThreads = PxU32(atoi(argv[++i]));
+		else if(hasValue && !strcmp(argv[i], "--scene"))
+			gSceneFilter = argv[++i];
+		else if(hasValue && !strcmp(argv[i], "--spike"))
+			gSpikeFile = argv[++i];
+		else
+		{
+			fprintf(stderr, "Usage: %s [--frames N] [--warmup N] [--threads N] [--scene name] [--spike file]\n", argv[0]);
+			return false;
+		}
+	}
+	// The recorded frame is replayed alone unless other scenes are explicitly selected
+	if(gSpikeFile && !gSceneFilter)
+		gSceneFilter = "spike";
+	return true;
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+	gDispatcher = PxDefaultCpuDispatcherCreate(gNbThreads);
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.1f);
+	PxInitExtensions(*gPhysics, NULL);
+}
+
+void cleanupPhysics()
+{
+	PxCloseExtensions();
+	PX_RELEASE(gMaterial);
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	fprintf(stderr, "SnippetBenchmark done.\n");
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	if(!parseArgs(argc, argv))
+		return 1;
+
+	initPhysics();
+
+	printf("{\n");
+	printf("  \"version\": \"%d.%d.%d\",\n", PX_PHYSICS_VERSION_MAJOR, PX_PHYSICS_VERSION_MINOR, PX_PHYSICS_VERSION_BUGFIX);
+	printf("  \"platform\": \"%s\",\n", PX_EMSCRIPTEN ? "wasm" : "native");
+	printf("  \"threads\": %u,\n", gNbThreads);
+	printf("  \"frames\": %u,\n", gNbFrames);
+	printf("  \"warmupFrames\": %u,\n", gNbWarmupFrames);
+	printf("  \"timeStep\": %.6f,\n", double(gTimeStep));
+	printf("  \"scenes\": [\n");
+
+	bool first = true;
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(gScenes);i++)
+	{
+		if(gSceneFilter && strcmp(gSceneFilter, gScenes[i].mName))
+			continue;
+		if(!gSpikeFile && gScenes[i].mSetup==setupSpike)
+			continue;
+		runScene(gScenes[i], first);
+		first = false;
+	}
+
+	printf("\n  ]\n}\n");
+
+	cleanupPhysics();
+
+	return 0;
+}
@@ -0,0 +1,823 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet is a benchmark for the cooking library.
+//
+// It cooks a fixed corpus of procedurally generated items (a terrain tile, a
+// building made of rooms, and a noisy closed "scanned" prop) into triangle
+// meshes, convex meshes, heightfields, BVHs and SDFs, using several
+// PxCookingParams presets for each. For each item and preset it reports:
+// - the best cooking time over a few runs
+// - the peak memory allocated through the foundation allocator while cooking
+//   (including the output stream)
+// - the size of the cooked data
+// - the average time of a fixed set of raycasts against the cooked object
+//
+// The corpus is generated with a fixed seed so that numbers can be compared
+// between builds, to measure regressions and improvements in the cooking code.
+// ****************************************************************************
+
+#include <ctype.h>
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxAtomic.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static const PxU32	gNbRuns = 3;
+static const PxU32	gNbRays = 4096;
+
+namespace
+{
+	// Allocator tracking the current and peak allocated memory. The requested size is stored in front of each block.
+	class TrackingAllocator : public PxAllocatorCallback
+	{
+		public:
+			TrackingAllocator() : mCurrent(0), mPeak(0)	{}
+
+			virtual void* allocate(size_t size, const char* typeName, const char* filename, int line)
+			{
+				// PT: the header is 16 bytes to preserve the alignment of the returned block
+				PxU8* mem = reinterpret_cast<PxU8*>(mAllocator.allocate(size + 16, typeName, filename, line));
+				if(!mem)
+					return NULL;
+				*reinterpret_cast<size_t*>(mem) = size;
+				const PxI64 current = PxAtomicAdd(&mCurrent, PxI64(size));
+				PxAtomicMax(&mPeak, current);
+				return mem + 16;
+			}
+
+			virtual void deallocate(void* ptr)
+			{
+				if(!ptr)
+					return;
+				PxU8* mem = reinterpret_cast<PxU8*>(ptr) - 16;
+				PxAtomicAdd(&mCurrent, -PxI64(*reinterpret_cast<size_t*>(mem)));
+				mAllocator.deallocate(mem);
+			}
+
+			// Restarts peak tracking from the current allocation level, which is returned
+			PxI64	resetPeak()				{ PxAtomicExchange(&mPeak, mCurrent); return mCurrent;	}
+			PxI64	getPeak()		const	{ return mPeak;											}
+
+		private:
+			PxDefaultAllocator	mAllocator;
+			volatile PxI64		mCurrent;
+			volatile PxI64		mPeak;
+	};
+
+	// Simple deterministic random generator, so that the corpus and the queries are the same for each run
+	class BenchmarkRandom
+	{
+		public:
+			BenchmarkRandom(PxU32 seed) : mSeed(seed)	{}
+
+			float	randomFloat01()
+			{
+				mSeed = mSeed * 1664525 + 1013904223;
+				return float(mSeed>>8) / float(1<<24);
+			}
+
+			float	randomFloat(float minValue, float maxValue)
+			{
+				return minValue + randomFloat01() * (maxValue - minValue);
+			}
+
+			PxVec3	randomPoint(const PxBounds3& bounds)
+			{
+				return PxVec3(	randomFloat(bounds.minimum.x, bounds.maximum.x),
+								randomFloat(bounds.minimum.y, bounds.maximum.y),
+								randomFloat(bounds.minimum.z, bounds.maximum.z));
+			}
+
+		private:
+			PxU32	mSeed;
+	};
+
+	struct CorpusItem
+	{
+		const char*		mName;
+		PxArray<PxVec3>	mVertices;
+		PxArray<PxU32>	mIndices;
+		// Terrain items also keep their grid of heights, for heightfield cooking
+		PxArray<float>	mHeights;
+		PxU32			mNbRows;
+		PxU32			mNbColumns;
+		float			mCellSize;
+		bool			mClosed;
+
+		CorpusItem() : mName(NULL), mNbRows(0), mNbColumns(0), mCellSize(0.0f), mClosed(false)	{}
+
+		PxU32		getNbTriangles()	const	{ return mIndices.size()/3;	}
+
+		PxBounds3	computeBounds()		const
+		{
+			PxBounds3 bounds = PxBounds3::empty();
+			for(PxU32 i=0;i<mVertices.size();i++)
+				bounds.include(mVertices[i]);
+			return bounds;
+		}
+
+		void		addQuad(PxU32 i0, PxU32 i1, PxU32 i2, PxU32 i3)
+		{
+			mIndices.pushBack(i0);	mIndices.pushBack(i1);	mIndices.pushBack(i2);
+			mIndices.pushBack(i0);	mIndices.pushBack(i2);	mIndices.pushBack(i3);
+		}
+	};
+
+	struct BenchmarkResult
+	{
+		float	mCookTime;		// ms, best of gNbRuns
+		PxI64	mPeakMemory;	// bytes
+		PxU32	mCookedSize;	// bytes
+	};
+}
+
+static TrackingAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static CorpusItem				gCorpus[3];
+static PxArray<PxVec3>			gRayOrigins;
+static PxArray<PxVec3>			gRayDirs;
+static PxArray<float>			gRayLengths;
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Terrain tile: a smooth landscape with some small scale noise
+static void createTerrain(CorpusItem& item, PxU32 nbRows, PxU32 nbColumns, float cellSize)
+{
+	BenchmarkRandom rnd(1);
+	item.mName		= "terrain";
+	item.mNbRows	= nbRows;
+	item.mNbColumns	= nbColumns;
+	item.mCellSize	= cellSize;
+	item.mHeights.resize(nbRows * nbColumns);
+	for(PxU32 r=0;r<nbRows;r++)
+	{
+		for(PxU32 c=0;c<nbColumns;c++)
+		{
+			const float x = float(r) * cellSize;
+			const float z = float(c) * cellSize;
+			const float h = 8.0f * PxSin(x * 0.02f) * PxCos(z * 0.03f) + 2.0f * PxSin(x * 0.11f + z * 0.07f) + rnd.randomFloat(-0.2f, 0.2f);
+			item.mHeights[r * nbColumns + c] = h;
+			item.mVertices.pushBack(PxVec3(x, h, z));
+		}
+	}
+
+	for(PxU32 r=0;r<nbRows-1;r++)
+	{
+		for(PxU32 c=0;c<nbColumns-1;c++)
+		{
+			const PxU32 i = r * nbColumns + c;
+			item.addQuad(i, i + 1, i + nbColumns + 1, i + nbColumns);
+		}
+	}
+}
+
+// Architecture: floors of box-shaped rooms. Neighbor rooms duplicate their shared walls, as exported content often does.
+static void createBuilding(CorpusItem& item, PxU32 nbRoomsX, PxU32 nbRoomsZ, PxU32 nbFloors)
+{
+	item.mName = "building";
+	const PxVec3 roomSize(6.0f, 3.0f, 5.0f);
+	const float wall = 0.2f;
+	for(PxU32 f=0;f<nbFloors;f++)
+	{
+		for(PxU32 x=0;x<nbRoomsX;x++)
+		{
+			for(PxU32 z=0;z<nbRoomsZ;z++)
+			{
+				const PxVec3 minimum(float(x) * roomSize.x, float(f) * roomSize.y, float(z) * roomSize.z);
+				const PxVec3 maximum = minimum + roomSize - PxVec3(0.0f, wall, 0.0f);
+
+				// 8 corners of the room, then its 6 faces
+				const PxU32 base = item.mVertices.size();
+				for(PxU32 i=0;i<8;i++)
+					item.mVertices.pushBack(PxVec3(i&1 ? maximum.x : minimum.x, i&2 ? maximum.y : minimum.y, i&4 ? maximum.z : minimum.z));
+
+				item.addQuad(base + 0, base + 1, base + 5, base + 4);	// floor
+				item.addQuad(base + 2, base + 6, base + 7, base + 3);	// ceiling
+				item.addQuad(base + 0, base + 2, base + 3, base + 1);	// -z wall
+				item.addQuad(base + 4, base + 5, base + 7, base + 6);	// +z wall
+				item.addQuad(base + 0, base + 4, base + 6, base + 2);	// -x wall
+				item.addQuad(base + 1, base + 3, base + 7, base + 5);	// +x wall
+			}
+		}
+	}
+}
+
+// Scanned prop: a closed, noisy blob made of the 6 subdivided faces of a cube projected on a sphere.
+// Vertices along the cube edges are duplicated between faces and welded by the mesh cleaning.
+static void createProp(CorpusItem& item, PxU32 resolution, float radius)
+{
+	item.mName		= "prop";
+	item.mClosed	= true;
+
+	const PxU32 nbVertsPerSide = resolution + 1;
+	for(PxU32 face=0;face<6;face++)
+	{
+		const PxU32 axis = face>>1;
+		const float sign = face&1 ? 1.0f : -1.0f;
+		const PxU32 base = item.mVertices.size();
+		for(PxU32 i=0;i<nbVertsPerSide;i++)
+		{
+			for(PxU32 j=0;j<nbVertsPerSide;j++)
+			{
+				const float u = float(i) / float(resolution) * 2.0f - 1.0f;
+				const float v = float(j) / float(resolution) * 2.0f - 1.0f;
+				PxVec3 p;
+				p[axis] = sign;
+				p[(axis + 1) % 3] = u;
+				p[(axis + 2) % 3] = v;
+				p.normalize();
+				// PT: the noise only depends on the position, so that duplicated vertices stay identical
+				const float noise = 0.1f * PxSin(p.x * 7.0f) * PxSin(p.y * 9.0f) * PxSin(p.z * 5.0f);
+				item.mVertices.pushBack(p * radius * (1.0f + noise));
+			}
+		}
+
+		for(PxU32 i=0;i<resolution;i++)
+		{
+			for(PxU32 j=0;j<resolution;j++)
+			{
+				const PxU32 i0 = base + i * nbVertsPerSide + j;
+				if(face&1)
+					item.addQuad(i0, i0 + nbVertsPerSide, i0 + nbVertsPerSide + 1, i0 + 1);
+				else
+					item.addQuad(i0, i0 + 1, i0 + nbVertsPerSide + 1, i0 + nbVertsPerSide);
+			}
+		}
+	}
+}
+
+// Rays start anywhere around the item and go through a random point of its bounds
+static void createRays(const CorpusItem& item)
+{
+	BenchmarkRandom rnd(3);
+	const PxBounds3 bounds = item.computeBounds();
+	PxBounds3 startBounds = bounds;
+	startBounds.fattenFast(bounds.getExtents().magnitude());
+
+	gRayOrigins.clear();
+	gRayDirs.clear();
+	gRayLengths.clear();
+	for(PxU32 i=0;i<gNbRays;i++)
+	{
+		const PxVec3 origin = rnd.randomPoint(startBounds);
+		PxVec3 dir = rnd.randomPoint(bounds) - origin;
+		const float length = dir.normalize();
+		gRayOrigins.pushBack(origin);
+		gRayDirs.pushBack(dir);
+		gRayLengths.pushBack(length * 2.0f);
+	}
+}
+
+// Returns the average raycast time in microseconds
+static float raycastGeometry(const PxGeometry& geom, PxU32& nbHits)
+{
+	const PxTransform pose(PxIdentity);
+	nbHits = 0;
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0;i<gNbRays;i++)
+	{
+		PxGeomRaycastHit hit;
+		nbHits += PxGeometryQuery::raycast(gRayOrigins[i], gRayDirs[i], geom, pose, gRayLengths[i], PxHitFlag::eDEFAULT, 1, &hit);
+	}
+	const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+	return SnippetUtils::getElapsedTimeInMicroSeconds(stopTime - startTime) / float(gNbRays);
+}
+
+static float raycastBVH(const PxBVH& bvh, PxU32& nbHits)
+{
+	struct CountHits : PxBVH::RaycastCallback
+	{
+		CountHits() : mNbHits(0)	{}
+		virtual bool	reportHit(PxU32, PxReal&)	{ mNbHits++; return true;	}
+		PxU32	mNbHits;
+	};
+
+	CountHits cb;
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0;i<gNbRays;i++)
+		bvh.raycast(gRayOrigins[i], gRayDirs[i], gRayLengths[i], cb);
+	const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+	nbHits = cb.mNbHits;
+	return SnippetUtils::getElapsedTimeInMicroSeconds(stopTime - startTime) / float(gNbRays);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Cooks gNbRuns times with the given functor and keeps the best time. Memory is tracked from the first run.
+// The cooked data of the last run is left in the stream.
+template<class CookFunc>
+static bool runCooking(CookFunc& cook, PxDefaultMemoryOutputStream*& stream, BenchmarkResult& result)
+{
+	result.mCookTime = PX_MAX_F32;
+	result.mPeakMemory = 0;
+	result.mCookedSize = 0;
+	stream = NULL;
+	for(PxU32 run=0;run<gNbRuns;run++)
+	{
+		PX_DELETE(stream);
+
+		const PxI64 baseline = gAllocator.resetPeak();
+		const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+		stream = new PxDefaultMemoryOutputStream;
+		const bool status = cook(*stream);
+		const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+		if(!status)
+		{
+			PX_DELETE(stream);
+			return false;
+		}
+
+		if(!run)
+			result.mPeakMemory = gAllocator.getPeak() - baseline;
+		result.mCookTime = PxMin(result.mCookTime, SnippetUtils::getElapsedTimeInMilliseconds(stopTime - startTime));
+	}
+	result.mCookedSize = stream->getSize();
+	return true;
+}
+
+static void printHeader(const char* title)
+{
+	printf("\n%s\n", title);
+	printf("%-10s %-22s %10s %10s %10s %12s %8s\n", "item", "preset", "cook ms", "peak KB", "size KB", "us/raycast", "hits");
+}
+
+static void printResult(const char* itemName, const char* presetName, const BenchmarkResult& result, float rayTime, PxU32 nbHits)
+{
+	printf("%-10s %-22s %10.2f %10.1f %10.1f %12.3f %8d\n", itemName, presetName, double(result.mCookTime),
+		double(result.mPeakMemory) / 1024.0, double(result.mCookedSize) / 1024.0, double(rayTime), nbHits);
+}
+
+static void printFailure(const char* itemName, const char* presetName)
+{
+	printf("%-10s %-22s cooking failed\n", itemName, presetName);
+}
+
+static void setupTriangleMeshDesc(const CorpusItem& item, PxTriangleMeshDesc& meshDesc)
+{
+	meshDesc.points.count		= item.mVertices.size();
+	meshDesc.points.data		= item.mVertices.begin();
+	meshDesc.points.stride		= sizeof(PxVec3);
+	meshDesc.triangles.count	= item.getNbTriangles();
+	meshDesc.triangles.data		= item.mIndices.begin();
+	meshDesc.triangles.stride	= 3 * sizeof(PxU32);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct CookTriangleMesh
+{
+	const PxCookingParams&		mParams;
+	const PxTriangleMeshDesc&	mDesc;
+	CookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc) : mParams(params), mDesc(desc)	{}
+	bool operator()(PxOutputStream& stream)	{ return PxCookTriangleMesh(mParams, mDesc, stream);	}
+	PX_NOCOPY(CookTriangleMesh)
+};
+
+static void benchmarkTriangleMeshes()
+{
+	struct Preset
+	{
+		const char*					mName;
+		PxMeshMidPhase::Enum		mMidphase;
+		PxU32						mNbPrimsPerLeaf;
+		PxMeshPreprocessingFlags	mFlags;
+	};
+
+	const Preset presets[] =
+	{
+		// Default settings, suitable for offline cooking
+		{ "BVH34 default",		PxMeshMidPhase::eBVH34,	4,	PxMeshPreprocessingFlags() },
+		// Settings for runtime cooking: no active edges, larger leaves
+		{ "BVH34 runtime",		PxMeshMidPhase::eBVH34,	15,	PxMeshPreprocessingFlags(PxMeshPreprocessingFlag::eDISABLE_ACTIVE_EDGES_PRECOMPUTE) },
+		// Smallest cooked data
+		{ "BVH34 compressed",	PxMeshMidPhase::eBVH34,	4,	PxMeshPreprocessingFlags(PxMeshPreprocessingFlag::eQUANTIZE_VERTICES) | PxMeshPreprocessingFlag::eCOMPRESS_INDICES },
+		{ "BVH33 default",		PxMeshMidPhase::eBVH33,	0,	PxMeshPreprocessingFlags() },
+	};
+
+	printHeader("Triangle meshes");
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(gCorpus);i++)
+	{
+		const CorpusItem& item = gCorpus[i];
+		createRays(item);
+
+		PxTriangleMeshDesc meshDesc;
+		setupTriangleMeshDesc(item, meshDesc);
+
+		for(PxU32 j=0;j<PX_ARRAY_SIZE(presets);j++)
+		{
+			const Preset& preset = presets[j];
+
+			PxCookingParams params(gPhysics->getTolerancesScale());
+			params.midphaseDesc = preset.mMidphase;
+			if(preset.mMidphase == PxMeshMidPhase::eBVH34)
+				params.midphaseDesc.mBVH34Desc.numPrimsPerLeaf = preset.mNbPrimsPerLeaf;
+			params.meshPreprocessParams = preset.mFlags;
+
+			CookTriangleMesh cook(params, meshDesc);
+			PxDefaultMemoryOutputStream* stream;
+			BenchmarkResult result;
+			if(!runCooking(cook, stream, result))
+			{
+				printFailure(item.mName, preset.mName);
+				continue;
+			}
+
+			PxDefaultMemoryInputData input(stream->getData(), stream->getSize());
+			PxTriangleMesh* mesh = gPhysics->createTriangleMesh(input);
+			PX_DELETE(stream);
+
+			PxU32 nbHits;
+			const float rayTime = raycastGeometry(PxTriangleMeshGeometry(mesh), nbHits);
+			printResult(item.mName, preset.mName, result, rayTime, nbHits);
+			mesh->release();
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct CookConvexMesh
+{
+	const PxCookingParams&		mParams;
+	const PxConvexMeshDesc&		mDesc;
+	CookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc) : mParams(params), mDesc(desc)	{}
+	bool operator()(PxOutputStream& stream)	{ return PxCookConvexMesh(mParams, mDesc, stream);	}
+	PX_NOCOPY(CookConvexMesh)
+};
+
+static void benchmarkConvexMeshes()
+{
+	struct Preset
+	{
+		const char*		mName;
+		PxConvexFlags	mFlags;
+		PxU16			mVertexLimit;
+		bool			mBuildGPUData;
+	};
+
+	const Preset presets[] =
+	{
+		{ "default",		PxConvexFlags(),										255,	false	},
+		{ "fast inertia",	PxConvexFlags(PxConvexFlag::eFAST_INERTIA_COMPUTATION),	255,	false	},
+		// GPU compatible hulls are limited to 64 vertices and polygons
+		{ "GPU data",		PxConvexFlags(),										64,		true	},
+	};
+
+	printHeader("Convex meshes (hull of all item vertices)");
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(gCorpus);i++)
+	{
+		const CorpusItem& item = gCorpus[i];
+		createRays(item);
+
+		for(PxU32 j=0;j<PX_ARRAY_SIZE(presets);j++)
+		{
+			const Preset& preset = presets[j];
+
+			PxConvexMeshDesc convexDesc;
+			convexDesc.points.count		= item.mVertices.size();
+			convexDesc.points.data		= item.mVertices.begin();
+			convexDesc.points.stride	= sizeof(PxVec3);
+			convexDesc.flags			= PxConvexFlags(PxConvexFlag::eCOMPUTE_CONVEX) | preset.mFlags;
+			convexDesc.vertexLimit		= preset.mVertexLimit;
+
+			PxCookingParams params(gPhysics->getTolerancesScale());
+			params.buildGPUData = preset.mBuildGPUData;
+			CookConvexMesh cook(params, convexDesc);
+			PxDefaultMemoryOutputStream* stream;
+			BenchmarkResult result;
+			if(!runCooking(cook, stream, result))
+			{
+				printFailure(item.mName, preset.mName);
+				continue;
+			}
+
+			PxDefaultMemoryInputData input(stream->getData(), stream->getSize());
+			PxConvexMesh* mesh = gPhysics->createConvexMesh(input);
+			PX_DELETE(stream);
+
+			PxU32 nbHits;
+			const float rayTime = raycastGeometry(PxConvexMeshGeometry(mesh), nbHits);
+			printResult(item.mName, preset.mName, result, rayTime, nbHits);
+			mesh->release();
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct CookHeightField
+{
+	const PxHeightFieldDesc&	mDesc;
+	CookHeightField(const PxHeightFieldDesc& desc) : mDesc(desc)	{}
+	bool operator()(PxOutputStream& stream)	{ return PxCookHeightField(mDesc, stream);	}
+	PX_NOCOPY(CookHeightField)
+};
+
+struct CookHeightFieldFromRaster
+{
+	const PxHeightFieldRasterDesc&	mDesc;
+	CookHeightFieldFromRaster(const PxHeightFieldRasterDesc& desc) : mDesc(desc)	{}
+	bool operator()(PxOutputStream& stream)	{ return PxCookHeightFieldFromRaster(mDesc, stream);	}
+	PX_NOCOPY(CookHeightFieldFromRaster)
+};
+
+static void benchmarkHeightFields()
+{
+	const float heightScale = 0.001f;
+
+	printHeader("Heightfields");
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(gCorpus);i++)
+	{
+		const CorpusItem& item = gCorpus[i];
+		if(!item.mHeights.size())
+			continue;
+		createRays(item);
+
+		const PxHeightFieldGeometry geomTemplate(NULL, PxMeshGeometryFlags(), heightScale, item.mCellSize, item.mCellSize);
+
+		// From samples, converted beforehand
+		{
+			PxArray<PxHeightFieldSample> samples(item.mHeights.size());
+			for(PxU32 j=0;j<samples.size();j++)
+			{
+				samples[j].height			= PxI16(PxClamp(PxFloor(item.mHeights[j] / heightScale + 0.5f), -32768.0f, 32767.0f));
+				samples[j].materialIndex0	= 0;
+				samples[j].materialIndex1	= 0;
+			}
+
+			PxHeightFieldDesc hfDesc;
+			hfDesc.nbRows			= item.mNbRows;
+			hfDesc.nbColumns		= item.mNbColumns;
+			hfDesc.samples.data		= samples.begin();
+			hfDesc.samples.stride	= sizeof(PxHeightFieldSample);
+
+			CookHeightField cook(hfDesc);
+			PxDefaultMemoryOutputStream* stream;
+			BenchmarkResult result;
+			if(runCooking(cook, stream, result))
+			{
+				PxDefaultMemoryInputData input(stream->getData(), stream->getSize());
+				PxHeightField* hf = gPhysics->createHeightField(input);
+				PX_DELETE(stream);
+
+				PxHeightFieldGeometry geom = geomTemplate;
+				geom.heightField = hf;
+				PxU32 nbHits;
+				const float rayTime = raycastGeometry(geom, nbHits);
+				printResult(item.mName, "samples", result, rayTime, nbHits);
+				hf->release();
+			}
+			else
+				printFailure(item.mName, "samples");
+		}
+
+		// From a float raster, converted by the cooking
+		{
+			PxHeightFieldRasterDesc rasterDesc;
+			rasterDesc.nbRows			= item.mNbRows;
+			rasterDesc.nbColumns		= item.mNbColumns;
+			rasterDesc.format			= PxHeightFieldRasterFormat::eF32;
+			rasterDesc.heights.data		= item.mHeights.begin();
+			rasterDesc.heights.stride	= sizeof(float);
+			rasterDesc.heightScale		= heightScale;
+
+			CookHeightFieldFromRaster cook(rasterDesc);
+			PxDefaultMemoryOutputStream* stream;
+			BenchmarkResult result;
+			if(runCooking(cook, stream, result))
+			{
+				PxDefaultMemoryInputData input(stream->getData(), stream->getSize());
+				PxHeightField* hf = gPhysics->createHeightField(input);
+				PX_DELETE(stream);
+
+				PxHeightFieldGeometry geom = geomTemplate;
+				geom.heightField = hf;
+				PxU32 nbHits;
+				const float rayTime = raycastGeometry(geom, nbHits);
+				printResult(item.mName, "float raster", result, rayTime, nbHits);
+				hf->release();
+			}
+			else
+				printFailure(item.mName, "float raster");
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct CookBVH
+{
+	const PxBVHDesc&	mDesc;
+	CookBVH(const PxBVHDesc& desc) : mDesc(desc)	{}
+	bool operator()(PxOutputStream& stream)	{ return PxCookBVH(mDesc, stream);	}
+	PX_NOCOPY(CookBVH)
+};
+
+static void benchmarkBVHs()
+{
+	struct Preset
+	{
+		const char*					mName;
+		PxBVHBuildStrategy::Enum	mStrategy;
+	};
+
+	const Preset presets[] =
+	{
+		{ "fast",		PxBVHBuildStrategy::eFAST		},
+		{ "default",	PxBVHBuildStrategy::eDEFAULT	},
+		{ "SAH",		PxBVHBuildStrategy::eSAH		},
+	};
+
+	printHeader("BVHs (one box per triangle, hits are leaf boxes)");
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(gCorpus);i++)
+	{
+		const CorpusItem& item = gCorpus[i];
+		createRays(item);
+
+		const PxU32 nbTris = item.getNbTriangles();
+		PxArray<PxBounds3> bounds(nbTris);
+		for(PxU32 j=0;j<nbTris;j++)
+		{
+			const PxU32* tri = &item.mIndices[j*3];
+			bounds[j] = PxBounds3::empty();
+			bounds[j].include(item.mVertices[tri[0]]);
+			bounds[j].include(item.mVertices[tri[1]]);
+			bounds[j].include(item.mVertices[tri[2]]);
+		}
+
+		for(PxU32 j=0;j<PX_ARRAY_SIZE(presets);j++)
+		{
+			const Preset& preset = presets[j];
+
+			PxBVHDesc bvhDesc;
+			bvhDesc.bounds.count	= nbTris;
+			bvhDesc.bounds.data		= bounds.begin();
+			bvhDesc.bounds.stride	= sizeof(PxBounds3);
+			bvhDesc.buildStrategy	= preset.mStrategy;
+
+			CookBVH cook(bvhDesc);
+			PxDefaultMemoryOutputStream* stream;
+			BenchmarkResult result;
+			if(!runCooking(cook, stream, result))
+			{
+				printFailure(item.mName, preset.mName);
+				continue;
+			}
+
+			PxDefaultMemoryInputData input(stream->getData(), stream->getSize());
+			PxBVH* bvh = gPhysics->createBVH(input);
+			PX_DELETE(stream);
+
+			PxU32 nbHits;
+			const float rayTime = raycastBVH(*bvh, nbHits);
+			printResult(item.mName, preset.mName, result, rayTime, nbHits);
+			bvh->release();
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void benchmarkSDFs()
+{
+	struct Preset
+	{
+		const char*						mName;
+		PxU32							mSubgridSize;
+		PxSdfBitsPerSubgridPixel::Enum	mBitsPerSubgridPixel;
+	};
+
+	const Preset presets[] =
+	{
+		{ "dense",			0,	PxSdfBitsPerSubgridPixel::e32_BIT_PER_PIXEL	},
+		{ "sparse 16 bits",	6,	PxSdfBitsPerSubgridPixel::e16_BIT_PER_PIXEL	},
+		{ "sparse 8 bits",	6,	PxSdfBitsPerSubgridPixel::e8_BIT_PER_PIXEL	},
+	};
+
+	printHeader("SDFs (triangle mesh + SDF, raycasts use the mesh)");
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(gCorpus);i++)
+	{
+		const CorpusItem& item = gCorpus[i];
+		// SDFs need closed meshes
+		if(!item.mClosed)
+			continue;
+		createRays(item);
+
+		const PxBounds3 bounds = item.computeBounds();
+		const float spacing = bounds.getDimensions().maxElement() / 64.0f;
+
+		for(PxU32 j=0;j<PX_ARRAY_SIZE(presets);j++)
+		{
+			const Preset& preset = presets[j];
+
+			PxSDFDesc sdfDesc;
+			sdfDesc.spacing							= spacing;
+			sdfDesc.subgridSize						= preset.mSubgridSize;
+			sdfDesc.bitsPerSubgridPixel				= preset.mBitsPerSubgridPixel;
+			sdfDesc.numThreadsForSdfConstruction	= 4;
+
+			PxTriangleMeshDesc meshDesc;
+			setupTriangleMeshDesc(item, meshDesc);
+			meshDesc.sdfDesc = &sdfDesc;
+
+			const PxCookingParams params(gPhysics->getTolerancesScale());
+			CookTriangleMesh cook(params, meshDesc);
+			PxDefaultMemoryOutputStream* stream;
+			BenchmarkResult result;
+			if(!runCooking(cook, stream, result))
+			{
+				printFailure(item.mName, preset.mName);
+				continue;
+			}
+
+			PxDefaultMemoryInputData input(stream->getData(), stream->getSize());
+			PxTriangleMesh* mesh = gPhysics->createTriangleMesh(input);
+			PX_DELETE(stream);
+
+			PxU32 nbHits;
+			const float rayTime = raycastGeometry(PxTriangleMeshGeometry(mesh), nbHits);
+			printResult(item.mName, preset.mName, result, rayTime, nbHits);
+			mesh->release();
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+
+	createTerrain(gCorpus[0], 257, 257, 1.0f);
+	createBuilding(gCorpus[1], 12, 12, 6);
+	createProp(gCorpus[2], 96, 1.0f);
+
+	printf("Corpus:\n");
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(gCorpus);i++)
+		printf("  %-10s %8d vertices %8d triangles\n", gCorpus[i].mName, gCorpus[i].mVertices.size(), gCorpus[i].getNbTriangles());
+}
+
+void cleanupPhysics()
+{
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(gCorpus);i++)
+	{
+		gCorpus[i].mVertices.reset();
+		gCorpus[i].mIndices.reset();
+		gCorpus[i].mHeights.reset();
+	}
+	gRayOrigins.reset();
+	gRayDirs.reset();
+	gRayLengths.reset();
+
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetCookingBenchmark done.\n");
+}
+
+int snippetMain(int, const char*const*)
+{
+	initPhysics();
+
+	benchmarkTriangleMeshes();
+	benchmarkConvexMeshes();
+	benchmarkHeightFields();
+	benchmarkBVHs();
+	benchmarkSDFs();
+
+	cleanupPhysics();
+
+	return 0;
+}
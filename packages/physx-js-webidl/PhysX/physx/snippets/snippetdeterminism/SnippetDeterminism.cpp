@@ -0,0 +1,571 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+// ****************************************************************************
+// This snippet checks the determinism of the simulation across thread counts
+// and builds.
+//
+// The same scene is simulated once per worker thread count of the CPU
+// dispatcher. Each frame, the state of every rigid body and articulation link
+// (pose, linear and angular velocities) is hashed bitwise. All runs are
+// compared with the first one, and the snippet reports, as JSON on stdout,
+// the first frame and the first body whose state diverges.
+//
+// To compare builds (e.g. native SSE2, WebAssembly scalar and WebAssembly
+// SIMD128), run the snippet with --save in one build and with --compare in
+// the others: the saved hashes are then used as the reference for all runs.
+//
+// By default the snippet simulates a generated scene (stacks, joint chains and
+// a rain of random shapes, with a fixed seed). --collection loads the scene
+// from a binary serialized collection instead. The scene is simulated with
+// PxSceneFlag::eENABLE_ENHANCED_DETERMINISM unless --no-enhanced-determinism
+// is passed, and with the PGS or TGS solver.
+//
+// Command line: [--collection file] [--frames N] [--threads N,N,...]
+//               [--solver pgs|tgs] [--no-enhanced-determinism]
+//               [--save file] [--compare file]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "extensions/PxCollectionExt.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics = NULL;
+static PxMaterial*				gMaterial = NULL;
+static PxSerializationRegistry*	gRegistry = NULL;
+
+static const char*	gCollectionFile = NULL;
+static const char*	gSaveFile = NULL;
+static const char*	gCompareFile = NULL;
+static PxU32		gNbFrames = 300;
+static bool			gEnhancedDeterminism = true;
+static PxSolverType::Enum	gSolverType = PxSolverType::ePGS;
+static PxArray<PxU32>		gThreadCounts;
+static const PxReal	gTimeStep = 1.0f/60.0f;
+
+// Magic and version of the hash files written by --save
+static const PxU32	gFileMagic = PX_MAKE_FOURCC('P', 'X', 'D', 'T');
+static const PxU32	gFileVersion = 1;
+
+namespace
+{
+	// Simple deterministic random generator, so that the generated scene is the same for each run
+	class BenchmarkRandom
+	{
+		public:
+			BenchmarkRandom(PxU32 seed) : mSeed(seed)	{}
+
+			float	randomFloat01()
+			{
+				mSeed = mSeed * 1664525 + 1013904223;
+				return float(mSeed>>8) / float(1<<24);
+			}
+
+			float	randomFloat(float minValue, float maxValue)
+			{
+				return minValue + randomFloat01() * (maxValue - minValue);
+			}
+
+		private:
+			PxU32	mSeed;
+	};
+
+	// Per-frame, per-body state hashes of a run
+	struct StateHashes
+	{
+		StateHashes() : mNbBodies(0)	{}
+
+		PxU32	getHash(PxU32 frame, PxU32 body)	const	{ return mHashes[frame * mNbBodies + body];	}
+		PxU32	getNbFrames()						const	{ return mNbBodies ? mHashes.size() / mNbBodies : 0;	}
+
+		char				mBackend[16];
+		PxU32				mNbBodies;
+		PxArray<PxU32>		mHashes;
+		PxArray<PxVec3>		mInitialPositions;	// Used to identify diverging bodies in the report
+	};
+
+	struct Divergence
+	{
+		PxU32	mFrame;
+		PxU32	mBody;
+		bool	mBodyCountMismatch;
+	};
+}
+
+static const char* getBackendName()
+{
+#if PX_WASM_SIMD
+	return "wasmSimd128";
+#elif PX_SSE2
+	return "sse2";
+#elif PX_NEON
+	return "neon";
+#else
+	return "scalar";
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static PxU32 hashBits(PxU32 hash, const void* data, PxU32 size)
+{
+	// FNV-1a, on the raw bits so that any difference is detected
+	const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+	for(PxU32 i=0;i<size;i++)
+		hash = (hash ^ bytes[i]) * 16777619u;
+	return hash;
+}
+
+static PxU32 hashBodyState(const PxTransform& pose, const PxVec3& linVel, const PxVec3& angVel)
+{
+	PxU32 hash = 2166136261u;
+	hash = hashBits(hash, &pose.p, sizeof(PxVec3));
+	hash = hashBits(hash, &pose.q, sizeof(PxQuat));
+	hash = hashBits(hash, &linVel, sizeof(PxVec3));
+	hash = hashBits(hash, &angVel, sizeof(PxVec3));
+	return hash;
+}
+
+// Bodies of the scene in a fixed order: rigid dynamics in insertion order, then the links of each articulation
+static void getBodies(PxScene& scene, PxArray<PxRigidBody*>& bodies)
+{
+	bodies.clear();
+
+	const PxU32 nbActors = scene.getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC);
+	PxArray<PxActor*> actors(nbActors);
+	scene.getActors(PxActorTypeFlag::eRIGID_DYNAMIC, actors.begin(), nbActors);
+	for(PxU32 i=0;i<nbActors;i++)
+		bodies.pushBack(actors[i]->is<PxRigidDynamic>());
+
+	const PxU32 nbArticulations = scene.getNbArticulations();
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		PxArticulationReducedCoordinate* articulation;
+		scene.getArticulations(&articulation, 1, i);
+		const PxU32 nbLinks = articulation->getNbLinks();
+		PxArray<PxArticulationLink*> links(nbLinks);
+		articulation->getLinks(links.begin(), nbLinks);
+		for(PxU32 j=0;j<nbLinks;j++)
+			bodies.pushBack(links[j]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static PxRigidDynamic* createDynamic(PxScene& scene, const PxTransform& pose, const PxGeometry& geometry)
+{
+	PxRigidDynamic* actor = PxCreateDynamic(*gPhysics, pose, geometry, *gMaterial, 10.0f);
+	scene.addActor(*actor);
+	return actor;
+}
+
+static void createGeneratedScene(PxScene& scene, PxArray<PxJoint*>& joints)
+{
+	BenchmarkRandom rnd(42);
+
+	scene.addActor(*PxCreatePlane(*gPhysics, PxPlane(0.0f, 1.0f, 0.0f, 0.0f), *gMaterial));
+
+	// Pyramid stacks, the classic test for solver ordering issues
+	for(PxU32 s=0;s<4;s++)
+	{
+		const PxReal halfExtent = 0.5f;
+		const PxU32 size = 10;
+		const PxVec3 base(PxReal(s) * 15.0f - 22.5f, 0.0f, -10.0f);
+		for(PxU32 i=0;i<size;i++)
+			for(PxU32 j=0;j<size-i;j++)
+			{
+				const PxVec3 pos(PxReal(j*2) - PxReal(size-i), PxReal(i*2+1), 0.0f);
+				createDynamic(scene, PxTransform(base + pos * halfExtent), PxBoxGeometry(halfExtent, halfExtent, halfExtent));
+			}
+	}
+
+	// Chains of spherical joints hanging from static anchors, which swing into the stacks
+	for(PxU32 c=0;c<4;c++)
+	{
+		PxRigidActor* previous = NULL;
+		const PxVec3 anchor(PxReal(c) * 15.0f - 22.5f, 12.0f, -7.0f);
+		for(PxU32 i=0;i<10;i++)
+		{
+			const PxVec3 pos = anchor + PxVec3(PxReal(i) + 0.5f, 0.0f, 0.0f);
+			PxRigidDynamic* link = createDynamic(scene, PxTransform(pos), PxCapsuleGeometry(0.15f, 0.35f));
+			joints.pushBack(PxSphericalJointCreate(*gPhysics, previous, previous ? PxTransform(PxVec3(0.5f, 0.0f, 0.0f)) : PxTransform(anchor),
+				link, PxTransform(PxVec3(-0.5f, 0.0f, 0.0f))));
+			previous = link;
+		}
+	}
+
+	// A rain of random shapes, to get many islands that merge and split
+	for(PxU32 i=0;i<400;i++)
+	{
+		const PxTransform pose(PxVec3(rnd.randomFloat(-25.0f, 25.0f), rnd.randomFloat(2.0f, 30.0f), rnd.randomFloat(-5.0f, 15.0f)),
+			PxQuat(rnd.randomFloat(0.0f, PxTwoPi), PxVec3(0.0f, 1.0f, 0.0f)));
+		const float kind = rnd.randomFloat01();
+		if(kind<0.33f)
+			createDynamic(scene, pose, PxSphereGeometry(rnd.randomFloat(0.2f, 0.6f)));
+		else if(kind<0.66f)
+			createDynamic(scene, pose, PxCapsuleGeometry(rnd.randomFloat(0.15f, 0.4f), rnd.randomFloat(0.2f, 0.6f)));
+		else
+			createDynamic(scene, pose, PxBoxGeometry(rnd.randomFloat(0.2f, 0.6f), rnd.randomFloat(0.2f, 0.6f), rnd.randomFloat(0.2f, 0.6f)));
+	}
+}
+
+// Binary collections are deserialized in place, so each run deserializes its own copy of the file
+static PxCollection* loadCollection(const char* filename, void*& memory)
+{
+	PxDefaultFileInputData input(filename);
+	if(!input.isValid())
+		return NULL;
+
+	// Binary collections must be deserialized from 128-byte aligned memory, which must outlive the collection
+	const PxU32 size = input.getLength();
+	memory = malloc(size + PX_SERIAL_FILE_ALIGN - 1);
+	void* alignedMemory = reinterpret_cast<void*>((size_t(memory) + PX_SERIAL_FILE_ALIGN - 1) & ~size_t(PX_SERIAL_FILE_ALIGN - 1));
+	if(input.read(alignedMemory, size)!=size)
+		return NULL;
+
+	return PxSerialization::createCollectionFromBinary(alignedMemory, *gRegistry);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Simulates the scene with the given number of worker threads and records the state hashes of each frame
+static bool runSimulation(PxU32 nbThreads, StateHashes& hashes)
+{
+	PxDefaultCpuDispatcher* dispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity		= PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher	= dispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	sceneDesc.solverType	= gSolverType;
+	if(gEnhancedDeterminism)
+		sceneDesc.flags |= PxSceneFlag::eENABLE_ENHANCED_DETERMINISM;
+	PxScene* scene = gPhysics->createScene(sceneDesc);
+
+	PxCollection* collection = NULL;
+	void* collectionMemory = NULL;
+	PxArray<PxJoint*> joints;
+	if(gCollectionFile)
+	{
+		collection = loadCollection(gCollectionFile, collectionMemory);
+		if(!collection)
+		{
+			fprintf(stderr, "Failed to load collection %s\n", gCollectionFile);
+			scene->release();
+			dispatcher->release();
+			free(collectionMemory);
+			return false;
+		}
+		scene->addCollection(*collection);
+	}
+	else
+		createGeneratedScene(*scene, joints);
+
+	PxArray<PxRigidBody*> bodies;
+	getBodies(*scene, bodies);
+
+	strcpy(hashes.mBackend, getBackendName());
+	hashes.mNbBodies = bodies.size();
+	hashes.mHashes.reserve(gNbFrames * bodies.size());
+	hashes.mInitialPositions.resize(bodies.size());
+	for(PxU32 i=0;i<bodies.size();i++)
+		hashes.mInitialPositions[i] = bodies[i]->getGlobalPose().p;
+
+	for(PxU32 frame=0;frame<gNbFrames;frame++)
+	{
+		scene->simulate(gTimeStep);
+		scene->fetchResults(true);
+
+		for(PxU32 i=0;i<bodies.size();i++)
+		{
+			const PxRigidBody* body = bodies[i];
+			hashes.mHashes.pushBack(hashBodyState(body->getGlobalPose(), body->getLinearVelocity(), body->getAngularVelocity()));
+		}
+	}
+
+	// Releasing the scene does not release its objects
+	if(collection)
+	{
+		PxCollectionExt::releaseObjects(*collection);
+		collection->release();
+	}
+	else
+	{
+		for(PxU32 i=0;i<joints.size();i++)
+			joints[i]->release();
+		const PxU32 nbActors = scene->getNbActors(PxActorTypeFlag::eRIGID_STATIC | PxActorTypeFlag::eRIGID_DYNAMIC);
+		PxArray<PxActor*> actors(nbActors);
+		scene->getActors(PxActorTypeFlag::eRIGID_STATIC | PxActorTypeFlag::eRIGID_DYNAMIC, actors.begin(), nbActors);
+		for(PxU32 i=0;i<nbActors;i++)
+			actors[i]->release();
+	}
+	scene->release();
+	free(collectionMemory);
+	dispatcher->release();
+	return true;
+}
+
+static Divergence findDivergence(const StateHashes& reference, const StateHashes& hashes)
+{
+	Divergence divergence = { 0xffffffff, 0xffffffff, reference.mNbBodies!=hashes.mNbBodies };
+	if(divergence.mBodyCountMismatch)
+	{
+		divergence.mFrame = 0;
+		return divergence;
+	}
+
+	const PxU32 nbFrames = PxMin(reference.getNbFrames(), hashes.getNbFrames());
+	for(PxU32 frame=0;frame<nbFrames;frame++)
+		for(PxU32 body=0;body<hashes.mNbBodies;body++)
+		{
+			if(reference.getHash(frame, body)!=hashes.getHash(frame, body))
+			{
+				divergence.mFrame = frame;
+				divergence.mBody = body;
+				return divergence;
+			}
+		}
+	return divergence;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool saveHashes(const char* filename, const StateHashes& hashes)
+{
+	PxDefaultFileOutputStream output(filename);
+	if(!output.isValid())
+		return false;
+
+	const PxU32 nbFrames = hashes.getNbFrames();
+	output.write(&gFileMagic, sizeof(PxU32));
+	output.write(&gFileVersion, sizeof(PxU32));
+	output.write(hashes.mBackend, sizeof(hashes.mBackend));
+	output.write(&hashes.mNbBodies, sizeof(PxU32));
+	output.write(&nbFrames, sizeof(PxU32));
+	output.write(hashes.mInitialPositions.begin(), hashes.mNbBodies * sizeof(PxVec3));
+	return output.write(hashes.mHashes.begin(), hashes.mHashes.size() * sizeof(PxU32))==hashes.mHashes.size() * sizeof(PxU32);
+}
+
+static bool loadHashes(const char* filename, StateHashes& hashes)
+{
+	PxDefaultFileInputData input(filename);
+	if(!input.isValid())
+		return false;
+
+	PxU32 magic, version, nbFrames;
+	if(input.read(&magic, sizeof(PxU32))!=sizeof(PxU32) || magic!=gFileMagic)
+		return false;
+	if(input.read(&version, sizeof(PxU32))!=sizeof(PxU32) || version!=gFileVersion)
+		return false;
+	if(input.read(hashes.mBackend, sizeof(hashes.mBackend))!=sizeof(hashes.mBackend))
+		return false;
+	hashes.mBackend[sizeof(hashes.mBackend)-1] = 0;
+	if(input.read(&hashes.mNbBodies, sizeof(PxU32))!=sizeof(PxU32) || input.read(&nbFrames, sizeof(PxU32))!=sizeof(PxU32))
+		return false;
+
+	hashes.mInitialPositions.resize(hashes.mNbBodies);
+	hashes.mHashes.resize(hashes.mNbBodies * nbFrames);
+	const PxU32 positionsSize = hashes.mNbBodies * sizeof(PxVec3);
+	const PxU32 hashesSize = hashes.mHashes.size() * sizeof(PxU32);
+	return input.read(hashes.mInitialPositions.begin(), positionsSize)==positionsSize && input.read(hashes.mHashes.begin(), hashesSize)==hashesSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool parseThreadCounts(const char* list)
+{
+	gThreadCounts.clear();
+	while(*list)
+	{
+		char* end;
+		const long count = strtol(list, &end, 10);
+		if(end==list || count<0)
+			return false;
+		gThreadCounts.pushBack(PxU32(count));
+		list = *end==',' ? end + 1 : end;
+	}
+	return !gThreadCounts.empty();
+}
+
+static bool parseArgs(int argc, const char*const* argv)
+{
+	bool valid = true;
+	for(int i=1;i<argc && valid;i++)
+	{
+		const bool hasValue = i+1<argc;
+		if(hasValue && !strcmp(argv[i], "--collection"))
+			gCollectionFile = argv[++i];
+		else if(hasValue && !strcmp(argv[i], "--frames"))
+			gNbFrames = PxMax(1u, PxU32(atoi(argv[++i])));
+		else if(hasValue && !strcmp(argv[i], "--threads"))
+			valid = parseThreadCounts(argv[++i]);
+		else if(hasValue && !strcmp(argv[i], "--solver"))
+		{
+			++i;
+			if(!strcmp(argv[i], "pgs"))
+				gSolverType = PxSolverType::ePGS;
+			else if(!strcmp(argv[i], "tgs"))
+				gSolverType = PxSolverType::eTGS;
+			else
+				valid = false;
+		}
+		else if(!strcmp(argv[i], "--no-enhanced-determinism"))
+			gEnhancedDeterminism = false;
+		else if(hasValue && !strcmp(argv[i], "--save"))
+			gSaveFile = argv[++i];
+		else if(hasValue && !strcmp(argv[i], "--compare"))
+			gCompareFile = argv[++i];
+		else
+			valid = false;
+	}
+
+	if(!valid)
+	{
+		fprintf(stderr, "Usage: %s [--collection file] [--frames N] [--threads N,N,...] [--solver pgs|tgs] [--no-enhanced-determinism] [--save file] [--compare file]\n", argv[0]);
+		return false;
+	}
+
+	if(gThreadCounts.empty())
+	{
+		gThreadCounts.pushBack(0);
+		gThreadCounts.pushBack(1);
+		gThreadCounts.pushBack(2);
+		gThreadCounts.pushBack(4);
+	}
+	return true;
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+	PxInitExtensions(*gPhysics, NULL);
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.1f);
+	gRegistry = PxSerialization::createSerializationRegistry(*gPhysics);
+}
+
+void cleanupPhysics()
+{
+	PX_RELEASE(gRegistry);
+	PX_RELEASE(gMaterial);
+	PxCloseExtensions();
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	fprintf(stderr, "SnippetDeterminism done.\n");
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	if(!parseArgs(argc, argv))
+		return 1;
+
+	initPhysics();
+
+	StateHashes reference;
+	const bool hasReferenceFile = gCompareFile!=NULL;
+	if(hasReferenceFile && !loadHashes(gCompareFile, reference))
+	{
+		fprintf(stderr, "Failed to load reference hashes from %s\n", gCompareFile);
+		cleanupPhysics();
+		return 1;
+	}
+
+	printf("{\n");
+	printf("  \"version\": \"%d.%d.%d\",\n", PX_PHYSICS_VERSION_MAJOR, PX_PHYSICS_VERSION_MINOR, PX_PHYSICS_VERSION_BUGFIX);
+	printf("  \"platform\": \"%s\",\n", PX_EMSCRIPTEN ? "wasm" : "native");
+	printf("  \"backend\": \"%s\",\n", getBackendName());
+	printf("  \"scene\": \"%s\",\n", gCollectionFile ? gCollectionFile : "generated");
+	printf("  \"solver\": \"%s\",\n", gSolverType==PxSolverType::eTGS ? "tgs" : "pgs");
+	printf("  \"enhancedDeterminism\": %s,\n", gEnhancedDeterminism ? "true" : "false");
+	printf("  \"frames\": %u,\n", gNbFrames);
+	if(hasReferenceFile)
+		printf("  \"reference\": { \"file\": \"%s\", \"backend\": \"%s\" },\n", gCompareFile, reference.mBackend);
+	printf("  \"runs\": [\n");
+
+	int status = 0;
+	for(PxU32 r=0;r<gThreadCounts.size();r++)
+	{
+		fprintf(stderr, "Running with %u worker threads...\n", gThreadCounts[r]);
+
+		StateHashes hashes;
+		if(!runSimulation(gThreadCounts[r], hashes))
+		{
+			status = 1;
+			break;
+		}
+
+		if(r==0 && gSaveFile && !saveHashes(gSaveFile, hashes))
+		{
+			fprintf(stderr, "Failed to save hashes to %s\n", gSaveFile);
+			status = 1;
+		}
+
+		printf("%s    { \"threads\": %u, \"bodies\": %u", r ? ",\n" : "", gThreadCounts[r], hashes.mNbBodies);
+
+		// Without a reference file, the first run is the reference for the following ones
+		if(r==0 && !hasReferenceFile)
+		{
+			printf(", \"reference\": true }");
+			reference.mNbBodies = hashes.mNbBodies;
+			reference.mHashes.swap(hashes.mHashes);
+			reference.mInitialPositions.swap(hashes.mInitialPositions);
+			continue;
+		}
+
+		const Divergence divergence = findDivergence(reference, hashes);
+		if(divergence.mBodyCountMismatch)
+		{
+			printf(", \"deterministic\": false, \"referenceBodies\": %u }", reference.mNbBodies);
+			status = 1;
+		}
+		else if(divergence.mFrame!=0xffffffff)
+		{
+			const PxVec3& p = hashes.mInitialPositions[divergence.mBody];
+			printf(", \"deterministic\": false, \"firstDivergingFrame\": %u, \"firstDivergingBody\": %u, \"bodyInitialPosition\": [%g, %g, %g] }",
+				divergence.mFrame, divergence.mBody, double(p.x), double(p.y), double(p.z));
+			status = 1;
+		}
+		else
+			printf(", \"deterministic\": true }");
+		fflush(stdout);
+	}
+	printf("\n  ]\n}\n");
+
+	cleanupPhysics();
+	return status;
+}
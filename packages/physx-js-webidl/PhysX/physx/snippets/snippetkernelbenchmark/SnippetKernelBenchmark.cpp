@@ -0,0 +1,603 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+// ****************************************************************************
+// This snippet is a microbenchmark for the low-level geometry kernels.
+//
+// Each kernel is run over a fixed set of random inputs generated from a fixed
+// seed, through the public entry points that dispatch to it:
+// - GJK overlap and GJK raycast: PxGeometryQuery::overlap() and sweep() for
+//   convex/convex, box/convex and capsule/convex pairs
+// - EPA: PxGeometryQuery::computePenetration() for penetrating convex pairs
+// - PCM: immediate::PxGenerateContacts() for box/box, convex/convex and
+//   convex/mesh pairs, with an empty cache so that a full manifold is built
+// - BV4 traversal: raycasts, sweeps and PxMeshQuery::findOverlapTriangleMesh()
+//   against a triangle mesh cooked with the BVH34 midphase
+//
+// It reports, as JSON on stdout, the cost in nanoseconds per operation of each
+// kernel for the SIMD backend the snippet was compiled with (scalar, SSE2,
+// NEON or WebAssembly SIMD128), so that builds can be compared with each other.
+//
+// The result of each operation (hit, distance, depth, contact count and
+// separations) is also recorded. --save writes these results to a file, and
+// --compare checks a build against a file saved by another build: the report
+// then contains, for each kernel, the number of operations whose result
+// differs by more than the tolerance, and the largest difference.
+//
+// Command line: [--iterations N] [--save file] [--compare file]
+//               [--tolerance T]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "PxPhysicsAPI.h"
+#include "PxImmediateMode.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics = NULL;
+static PxConvexMesh*			gConvexMesh = NULL;
+static PxTriangleMesh*			gTriangleMesh = NULL;
+
+static const char*	gSaveFile = NULL;
+static const char*	gCompareFile = NULL;
+static PxU32		gNbIterations = 20;
+static PxReal		gTolerance = 1e-4f;
+
+// Number of random inputs per kernel
+static const PxU32	gNbInputs = 4096;
+
+namespace
+{
+	// Simple deterministic random generator, so that all builds run the same inputs
+	class BenchmarkRandom
+	{
+		public:
+			BenchmarkRandom(PxU32 seed) : mSeed(seed)	{}
+
+			float	randomFloat01()
+			{
+				mSeed = mSeed * 1664525 + 1013904223;
+				return float(mSeed>>8) / float(1<<24);
+			}
+
+			float	randomFloat(float minValue, float maxValue)
+			{
+				return minValue + randomFloat01() * (maxValue - minValue);
+			}
+
+			PxVec3	randomUnitVector()
+			{
+				const PxVec3 v(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f));
+				const PxReal m = v.magnitude();
+				return m>1e-3f ? v / m : PxVec3(1.0f, 0.0f, 0.0f);
+			}
+
+			PxQuat	randomRotation()
+			{
+				const PxQuat q(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f));
+				const PxReal m = q.magnitude();
+				return m>1e-3f ? q * (1.0f / m) : PxQuat(PxIdentity);
+			}
+
+		private:
+			PxU32	mSeed;
+	};
+
+	// A random pair of poses, and a direction for sweeps and raycasts
+	struct KernelInput
+	{
+		PxTransform	mPose0;
+		PxTransform	mPose1;
+		PxVec3		mDir;
+	};
+
+	// Cache memory for PxGenerateContacts, reset before each operation
+	class LinearCacheAllocator : public PxCacheAllocator
+	{
+		public:
+			LinearCacheAllocator() : mUsed(0)	{}
+
+			virtual PxU8* allocateCacheData(const PxU32 byteSize)
+			{
+				const PxU32 size = (byteSize + 15) & ~15;
+				if(mUsed + size > sizeof(mBuffer))
+					return NULL;
+				PxU8* data = mBuffer + mUsed;
+				mUsed += size;
+				return data;
+			}
+
+			void	reset()	{ mUsed = 0;	}
+
+		private:
+			PX_ALIGN(16, PxU8	mBuffer[16384]);
+			PxU32	mUsed;
+	};
+
+	// Sums the contacts of the last PxGenerateContacts call into a single comparable value
+	class ContactRecorder : public immediate::PxContactRecorder
+	{
+		public:
+			ContactRecorder() : mNbContacts(0), mSeparations(0.0f)	{}
+
+			virtual bool recordContacts(const PxContactPoint* contactPoints, PxU32 nbContacts, PxU32)
+			{
+				mNbContacts += nbContacts;
+				for(PxU32 i=0;i<nbContacts;i++)
+					mSeparations += contactPoints[i].separation;
+				return true;
+			}
+
+			PxU32	mNbContacts;
+			PxReal	mSeparations;
+	};
+
+	typedef PxReal (*KernelFunction)(const KernelInput& input);
+
+	struct Kernel
+	{
+		const char*		mName;
+		KernelFunction	mFunction;
+		PxReal			mMinDistance;	// Range of distances between the two poses of the inputs
+		PxReal			mMaxDistance;
+	};
+
+	struct KernelResult
+	{
+		PxArray<PxReal>	mValues;
+		PxReal			mNsPerOp;
+		PxU32			mNbMismatches;
+		PxReal			mMaxDifference;
+		bool			mCompared;
+	};
+}
+
+static const char* getBackendName()
+{
+#if PX_WASM_SIMD
+	return "wasmSimd128";
+#elif PX_SSE2
+	return "sse2";
+#elif PX_NEON
+	return "neon";
+#else
+	return "scalar";
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A random hull with up to 64 vertices
+static PxConvexMesh* createConvexMesh()
+{
+	BenchmarkRandom rnd(7);
+	PxVec3 points[64];
+	for(PxU32 i=0;i<64;i++)
+		points[i] = rnd.randomUnitVector().multiply(PxVec3(1.0f, 0.7f, 0.5f));
+
+	PxConvexMeshDesc convexDesc;
+	convexDesc.points.count		= 64;
+	convexDesc.points.stride	= sizeof(PxVec3);
+	convexDesc.points.data		= points;
+	convexDesc.flags			= PxConvexFlag::eCOMPUTE_CONVEX;
+
+	PxCookingParams params(gPhysics->getTolerancesScale());
+	return PxCreateConvexMesh(params, convexDesc, gPhysics->getPhysicsInsertionCallback());
+}
+
+// A bumpy terrain patch centered on the origin, cooked with the BVH34 midphase
+static PxTriangleMesh* createTriangleMesh(PxU32 size, PxReal cellSize)
+{
+	BenchmarkRandom rnd(11);
+	const PxReal offset = PxReal(size - 1) * cellSize * 0.5f;
+	PxArray<PxVec3> vertices(size * size);
+	PxArray<PxU32> indices;
+	indices.reserve((size - 1) * (size - 1) * 6);
+	for(PxU32 z=0;z<size;z++)
+		for(PxU32 x=0;x<size;x++)
+		{
+			const PxReal fx = PxReal(x) * cellSize - offset;
+			const PxReal fz = PxReal(z) * cellSize - offset;
+			vertices[z * size + x] = PxVec3(fx, PxSin(fx * 0.3f) * PxCos(fz * 0.4f) + rnd.randomFloat(-0.1f, 0.1f), fz);
+		}
+	for(PxU32 z=0;z<size-1;z++)
+		for(PxU32 x=0;x<size-1;x++)
+		{
+			const PxU32 i0 = z * size + x;
+			const PxU32 i1 = i0 + 1;
+			const PxU32 i2 = i0 + size;
+			const PxU32 i3 = i2 + 1;
+			indices.pushBack(i0);	indices.pushBack(i2);	indices.pushBack(i1);
+			indices.pushBack(i1);	indices.pushBack(i2);	indices.pushBack(i3);
+		}
+
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count		= vertices.size();
+	meshDesc.points.data		= vertices.begin();
+	meshDesc.points.stride		= sizeof(PxVec3);
+	meshDesc.triangles.count	= indices.size() / 3;
+	meshDesc.triangles.data		= indices.begin();
+	meshDesc.triangles.stride	= 3 * sizeof(PxU32);
+
+	PxCookingParams params(gPhysics->getTolerancesScale());
+	params.midphaseDesc = PxMeshMidPhase::eBVH34;
+	return PxCreateTriangleMesh(params, meshDesc, gPhysics->getPhysicsInsertionCallback());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static PxReal gjkOverlapConvexConvex(const KernelInput& input)
+{
+	const PxConvexMeshGeometry convex(gConvexMesh);
+	return PxGeometryQuery::overlap(convex, input.mPose0, convex, input.mPose1) ? 1.0f : 0.0f;
+}
+
+static PxReal gjkOverlapBoxConvex(const KernelInput& input)
+{
+	return PxGeometryQuery::overlap(PxBoxGeometry(0.8f, 0.5f, 0.3f), input.mPose0, PxConvexMeshGeometry(gConvexMesh), input.mPose1) ? 1.0f : 0.0f;
+}
+
+static PxReal gjkOverlapCapsuleConvex(const KernelInput& input)
+{
+	return PxGeometryQuery::overlap(PxCapsuleGeometry(0.3f, 0.6f), input.mPose0, PxConvexMeshGeometry(gConvexMesh), input.mPose1) ? 1.0f : 0.0f;
+}
+
+static PxReal sweepResult(bool hit, const PxGeomSweepHit& sweepHit)
+{
+	return hit ? sweepHit.distance : -1.0f;
+}
+
+static PxReal gjkRaycastConvexConvex(const KernelInput& input)
+{
+	const PxConvexMeshGeometry convex(gConvexMesh);
+	PxGeomSweepHit hit;
+	return sweepResult(PxGeometryQuery::sweep(input.mDir, 10.0f, convex, input.mPose0, convex, input.mPose1, hit), hit);
+}
+
+static PxReal gjkRaycastBoxConvex(const KernelInput& input)
+{
+	PxGeomSweepHit hit;
+	return sweepResult(PxGeometryQuery::sweep(input.mDir, 10.0f, PxBoxGeometry(0.8f, 0.5f, 0.3f), input.mPose0, PxConvexMeshGeometry(gConvexMesh), input.mPose1, hit), hit);
+}
+
+static PxReal gjkRaycastCapsuleConvex(const KernelInput& input)
+{
+	PxGeomSweepHit hit;
+	return sweepResult(PxGeometryQuery::sweep(input.mDir, 10.0f, PxCapsuleGeometry(0.3f, 0.6f), input.mPose0, PxConvexMeshGeometry(gConvexMesh), input.mPose1, hit), hit);
+}
+
+static PxReal epaConvexConvex(const KernelInput& input)
+{
+	const PxConvexMeshGeometry convex(gConvexMesh);
+	PxVec3 direction;
+	PxReal depth;
+	return PxGeometryQuery::computePenetration(direction, depth, convex, input.mPose0, convex, input.mPose1) ? depth : -1.0f;
+}
+
+static PxReal epaBoxConvex(const KernelInput& input)
+{
+	PxVec3 direction;
+	PxReal depth;
+	return PxGeometryQuery::computePenetration(direction, depth, PxBoxGeometry(0.8f, 0.5f, 0.3f), input.mPose0, PxConvexMeshGeometry(gConvexMesh), input.mPose1) ? depth : -1.0f;
+}
+
+static PxReal generateContacts(const PxGeometry& geom0, const PxGeometry& geom1, const KernelInput& input)
+{
+	static LinearCacheAllocator cacheAllocator;
+	cacheAllocator.reset();
+
+	const PxGeometry* geom0Ptr = &geom0;
+	const PxGeometry* geom1Ptr = &geom1;
+	PxCache cache;
+	ContactRecorder recorder;
+	immediate::PxGenerateContacts(&geom0Ptr, &geom1Ptr, &input.mPose0, &input.mPose1, &cache, 1, recorder, 0.04f, 0.01f, 1.0f, cacheAllocator);
+	return PxReal(recorder.mNbContacts) + recorder.mSeparations;
+}
+
+static PxReal pcmBoxBox(const KernelInput& input)
+{
+	const PxBoxGeometry box(0.8f, 0.5f, 0.3f);
+	return generateContacts(box, box, input);
+}
+
+static PxReal pcmConvexConvex(const KernelInput& input)
+{
+	const PxConvexMeshGeometry convex(gConvexMesh);
+	return generateContacts(convex, convex, input);
+}
+
+static PxReal pcmConvexMesh(const KernelInput& input)
+{
+	return generateContacts(PxConvexMeshGeometry(gConvexMesh), PxTriangleMeshGeometry(gTriangleMesh), input);
+}
+
+static PxReal bv4Raycast(const KernelInput& input)
+{
+	PxGeomRaycastHit hit;
+	return PxGeometryQuery::raycast(input.mPose0.p, input.mDir, PxTriangleMeshGeometry(gTriangleMesh), input.mPose1, 50.0f, PxHitFlag::eDEFAULT, 1, &hit) ? hit.distance : -1.0f;
+}
+
+static PxReal bv4SweepCapsule(const KernelInput& input)
+{
+	PxGeomSweepHit hit;
+	return sweepResult(PxGeometryQuery::sweep(input.mDir, 10.0f, PxCapsuleGeometry(0.3f, 0.6f), input.mPose0, PxTriangleMeshGeometry(gTriangleMesh), input.mPose1, hit), hit);
+}
+
+static PxReal bv4OverlapBox(const KernelInput& input)
+{
+	PxU32 results[256];
+	bool overflow;
+	return PxReal(PxMeshQuery::findOverlapTriangleMesh(PxBoxGeometry(2.0f, 1.0f, 2.0f), input.mPose0, PxTriangleMeshGeometry(gTriangleMesh), input.mPose1, results, 256, 0, overflow));
+}
+
+// Pair kernels use poses close enough for the shapes to touch about half of the time. The mesh kernels place the
+// query shape above the terrain, which is centered on the origin and 64 units wide.
+static const Kernel gKernels[] =
+{
+	{ "gjkOverlapConvexConvex",		gjkOverlapConvexConvex,		0.0f,	3.0f	},
+	{ "gjkOverlapBoxConvex",		gjkOverlapBoxConvex,		0.0f,	3.0f	},
+	{ "gjkOverlapCapsuleConvex",	gjkOverlapCapsuleConvex,	0.0f,	3.0f	},
+	{ "gjkRaycastConvexConvex",		gjkRaycastConvexConvex,		2.0f,	6.0f	},
+	{ "gjkRaycastBoxConvex",		gjkRaycastBoxConvex,		2.0f,	6.0f	},
+	{ "gjkRaycastCapsuleConvex",	gjkRaycastCapsuleConvex,	2.0f,	6.0f	},
+	{ "epaConvexConvex",			epaConvexConvex,			0.0f,	1.0f	},
+	{ "epaBoxConvex",				epaBoxConvex,				0.0f,	1.0f	},
+	{ "pcmBoxBox",					pcmBoxBox,					0.0f,	1.5f	},
+	{ "pcmConvexConvex",			pcmConvexConvex,			0.0f,	2.0f	},
+	{ "pcmConvexMesh",				pcmConvexMesh,				0.0f,	0.0f	},
+	{ "bv4Raycast",					bv4Raycast,					0.0f,	0.0f	},
+	{ "bv4SweepCapsule",			bv4SweepCapsule,			0.0f,	0.0f	},
+	{ "bv4OverlapBox",				bv4OverlapBox,				0.0f,	0.0f	},
+};
+
+static const PxU32 gNbKernels = PX_ARRAY_SIZE(gKernels);
+
+static bool isMeshKernel(const Kernel& kernel)
+{
+	return kernel.mMaxDistance==0.0f;
+}
+
+static void generateInputs(const Kernel& kernel, PxU32 seed, PxArray<KernelInput>& inputs)
+{
+	BenchmarkRandom rnd(seed);
+	inputs.resize(gNbInputs);
+	for(PxU32 i=0;i<gNbInputs;i++)
+	{
+		KernelInput& input = inputs[i];
+		if(isMeshKernel(kernel))
+		{
+			input.mPose0 = PxTransform(PxVec3(rnd.randomFloat(-28.0f, 28.0f), rnd.randomFloat(0.0f, 2.0f), rnd.randomFloat(-28.0f, 28.0f)), rnd.randomRotation());
+			input.mPose1 = PxTransform(PxIdentity);
+			// Mostly downward directions, so that raycasts and sweeps usually hit the terrain
+			input.mDir = (rnd.randomUnitVector() - PxVec3(0.0f, 1.5f, 0.0f)).getNormalized();
+		}
+		else
+		{
+			input.mPose0 = PxTransform(PxVec3(0.0f), rnd.randomRotation());
+			input.mPose1 = PxTransform(rnd.randomUnitVector() * rnd.randomFloat(kernel.mMinDistance, kernel.mMaxDistance), rnd.randomRotation());
+			// Sweep towards the second shape, with some spread
+			input.mDir = (input.mPose1.p.getNormalized() + rnd.randomUnitVector() * 0.3f).getNormalized();
+		}
+	}
+}
+
+static void runKernel(const Kernel& kernel, PxU32 seed, KernelResult& result)
+{
+	PxArray<KernelInput> inputs;
+	generateInputs(kernel, seed, inputs);
+
+	// The first pass records the results and warms up the caches, the following ones are timed
+	result.mValues.resize(gNbInputs);
+	for(PxU32 i=0;i<gNbInputs;i++)
+		result.mValues[i] = kernel.mFunction(inputs[i]);
+
+	PxReal sink = 0.0f;
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 j=0;j<gNbIterations;j++)
+		for(PxU32 i=0;i<gNbInputs;i++)
+			sink += kernel.mFunction(inputs[i]);
+	const PxReal time = SnippetUtils::getElapsedTimeInMicroSeconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+
+	// Prevents the compiler from discarding the timed loop
+	if(sink==PX_MAX_F32)
+		fprintf(stderr, "\n");
+
+	result.mNsPerOp = time * 1000.0f / PxReal(gNbIterations * gNbInputs);
+	result.mNbMismatches = 0;
+	result.mMaxDifference = 0.0f;
+	result.mCompared = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Results file: one "<kernel> <count>" line per kernel, followed by its values
+static bool saveResults(const char* filename, const KernelResult* results)
+{
+	FILE* fp = fopen(filename, "w");
+	if(!fp)
+		return false;
+	fprintf(fp, "%s\n", getBackendName());
+	for(PxU32 k=0;k<gNbKernels;k++)
+	{
+		fprintf(fp, "%s %u\n", gKernels[k].mName, results[k].mValues.size());
+		for(PxU32 i=0;i<results[k].mValues.size();i++)
+			fprintf(fp, "%.9g\n", double(results[k].mValues[i]));
+	}
+	fclose(fp);
+	return true;
+}
+
+static bool compareResults(const char* filename, KernelResult* results, char* referenceBackend, PxU32 referenceBackendSize)
+{
+	FILE* fp = fopen(filename, "r");
+	if(!fp)
+		return false;
+
+	char format[16];
+	sprintf(format, "%%%us", referenceBackendSize - 1);
+	bool valid = fscanf(fp, format, referenceBackend)==1;
+
+	char name[64];
+	PxU32 count;
+	while(valid && fscanf(fp, "%63s %u", name, &count)==2)
+	{
+		KernelResult* result = NULL;
+		for(PxU32 k=0;k<gNbKernels;k++)
+			if(!strcmp(gKernels[k].mName, name))
+				result = results + k;
+
+		for(PxU32 i=0;i<count && valid;i++)
+		{
+			double value;
+			valid = fscanf(fp, "%lf", &value)==1;
+			if(result && i<result->mValues.size())
+			{
+				const PxReal difference = PxAbs(result->mValues[i] - PxReal(value));
+				if(difference>gTolerance)
+					result->mNbMismatches++;
+				result->mMaxDifference = PxMax(result->mMaxDifference, difference);
+			}
+		}
+		if(result)
+		{
+			// Missing values count as mismatches
+			if(count<result->mValues.size())
+				result->mNbMismatches += result->mValues.size() - count;
+			result->mCompared = true;
+		}
+	}
+	fclose(fp);
+	return valid;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool parseArgs(int argc, const char*const* argv)
+{
+	for(int i=1;i<argc;i++)
+	{
+		const bool hasValue = i+1<argc;
+		if(hasValue && !strcmp(argv[i], "--iterations"))
+			gNbIterations = PxMax(1u, PxU32(atoi(argv[++i])));
+		else if(hasValue && !strcmp(argv[i], "--save"))
+			gSaveFile = argv[++i];
+		else if(hasValue && !strcmp(argv[i], "--compare"))
+			gCompareFile = argv[++i];
+		else if(hasValue && !strcmp(argv[i], "--tolerance"))
+			gTolerance = PxReal(atof(argv[++i]));
+		else
+		{
+			fprintf(stderr, "Usage: %s [--iterations N] [--save file] [--compare file] [--tolerance T]\n", argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+	gConvexMesh = createConvexMesh();
+	gTriangleMesh = createTriangleMesh(65, 1.0f);
+}
+
+void cleanupPhysics()
+{
+	PX_RELEASE(gTriangleMesh);
+	PX_RELEASE(gConvexMesh);
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	fprintf(stderr, "SnippetKernelBenchmark done.\n");
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	if(!parseArgs(argc, argv))
+		return 1;
+
+	initPhysics();
+
+	KernelResult results[gNbKernels];
+	for(PxU32 k=0;k<gNbKernels;k++)
+	{
+		fprintf(stderr, "Running %s...\n", gKernels[k].mName);
+		runKernel(gKernels[k], 1000 + k, results[k]);
+	}
+
+	int status = 0;
+	if(gSaveFile && !saveResults(gSaveFile, results))
+	{
+		fprintf(stderr, "Failed to save results to %s\n", gSaveFile);
+		status = 1;
+	}
+
+	char referenceBackend[32] = "";
+	if(gCompareFile && !compareResults(gCompareFile, results, referenceBackend, sizeof(referenceBackend)))
+	{
+		fprintf(stderr, "Failed to load reference results from %s\n", gCompareFile);
+		status = 1;
+	}
+
+	printf("{\n");
+	printf("  \"platform\": \"%s\",\n", PX_EMSCRIPTEN ? "wasm" : "native");
+	printf("  \"backend\": \"%s\",\n", getBackendName());
+	printf("  \"inputsPerKernel\": %u,\n", gNbInputs);
+	printf("  \"iterations\": %u,\n", gNbIterations);
+	if(gCompareFile)
+	{
+		printf("  \"reference\": \"%s\",\n", referenceBackend);
+		printf("  \"tolerance\": %g,\n", double(gTolerance));
+	}
+	printf("  \"kernels\": [\n");
+	for(PxU32 k=0;k<gNbKernels;k++)
+	{
+		const KernelResult& result = results[k];
+		printf("    { \"name\": \"%s\", \"nsPerOp\": %.1f", gKernels[k].mName, double(result.mNsPerOp));
+		if(result.mCompared)
+		{
+			printf(", \"mismatches\": %u, \"maxDifference\": %g", result.mNbMismatches, double(result.mMaxDifference));
+			if(result.mNbMismatches)
+				status = 1;
+		}
+		printf(" }%s\n", k+1<gNbKernels ? "," : "");
+	}
+	printf("  ]\n");
+	printf("}\n");
+
+	cleanupPhysics();
+	return status;
+}
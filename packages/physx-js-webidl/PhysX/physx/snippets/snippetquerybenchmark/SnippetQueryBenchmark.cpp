@@ -0,0 +1,570 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet is a benchmark for scene queries, replaying query traces.
+//
+// A query trace is a list of raycasts, sweeps and overlaps captured from a
+// running application with a PxQueryTrace registered as the scene's query
+// recorder (see PxScene::setQueryRecorder()). The snippet replays the trace
+// against a scene built with each combination of:
+// - PxPruningStructureType for the static and dynamic pruners
+// - PxDynamicTreeSecondaryPruner, when a dynamic AABB tree is used
+// - PxMeshMidPhase, for the triangle meshes of the generated scene
+//
+// The scene is stepped between batches of queries, like in a game, so that
+// the dynamic pruners see moving objects. For each configuration it reports,
+// as JSON on stdout, the throughput and the latency percentiles of each
+// query type.
+//
+// By default the snippet generates a scene and records a trace from a
+// scripted game loop, with a fixed seed. Real data can be used instead:
+// --collection loads the scene from a binary serialized collection (its
+// meshes are then used as serialized, for all midphase configurations) and
+// --trace loads a trace saved with PxQueryTrace::save(). --save-trace saves
+// the generated trace, e.g. to replay it in another build.
+//
+// Command line: [--collection file] [--trace file] [--save-trace file]
+//               [--queries-per-frame N]
+// ****************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxSort.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics = NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+static PxMaterial*				gMaterial = NULL;
+static PxQueryTrace*			gTrace = NULL;
+
+static PxSerializationRegistry*	gRegistry = NULL;
+static PxCollection*			gCollection = NULL;
+static void*					gCollectionMemory = NULL;
+
+static const char*	gCollectionFile = NULL;
+static const char*	gTraceFile = NULL;
+static const char*	gSaveTraceFile = NULL;
+static PxU32		gNbQueriesPerFrame = 1024;
+static const PxReal	gTimeStep = 1.0f/60.0f;
+
+static const PxU32	gNbStaticProps = 5000;
+static const PxU32	gNbKinematics = 500;
+static const PxU32	gNbDynamics = 500;
+static const PxReal	gWorldExtent = 150.0f;
+
+namespace
+{
+	// Simple deterministic random generator, so that the scene and the trace are the same for each run
+	class BenchmarkRandom
+	{
+		public:
+			BenchmarkRandom(PxU32 seed) : mSeed(seed)	{}
+
+			float	randomFloat01()
+			{
+				mSeed = mSeed * 1664525 + 1013904223;
+				return float(mSeed>>8) / float(1<<24);
+			}
+
+			float	randomFloat(float minValue, float maxValue)
+			{
+				return minValue + randomFloat01() * (maxValue - minValue);
+			}
+
+			PxVec3	randomUnitVector()
+			{
+				const PxVec3 v(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f));
+				const PxReal m = v.magnitude();
+				return m>1e-3f ? v / m : PxVec3(1.0f, 0.0f, 0.0f);
+			}
+
+		private:
+			PxU32	mSeed;
+	};
+
+	struct Config
+	{
+		PxPruningStructureType::Enum		mStaticStructure;
+		PxPruningStructureType::Enum		mDynamicStructure;
+		PxDynamicTreeSecondaryPruner::Enum	mSecondaryPruner;
+		PxMeshMidPhase::Enum				mMidphase;
+	};
+
+	// Moving kinematic objects of the generated scene, so that the dynamic pruner is updated each frame
+	struct Mover
+	{
+		PxRigidDynamic*	mActor;
+		PxVec3			mCenter;
+		PxReal			mRadius;
+		PxReal			mPhase;
+	};
+}
+
+static PxArray<Mover>			gMovers;
+static PxArray<PxTriangleMesh*>	gMeshes;
+
+static const char* getStructureName(PxPruningStructureType::Enum type)
+{
+	switch(type)
+	{
+		case PxPruningStructureType::eNONE:					return "none";
+		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	return "dynamicAABBTree";
+		case PxPruningStructureType::eSTATIC_AABB_TREE:		return "staticAABBTree";
+		case PxPruningStructureType::eLAST:					break;
+	}
+	return "";
+}
+
+static const char* getSecondaryPrunerName(PxDynamicTreeSecondaryPruner::Enum type)
+{
+	switch(type)
+	{
+		case PxDynamicTreeSecondaryPruner::eNONE:			return "none";
+		case PxDynamicTreeSecondaryPruner::eBUCKET:			return "bucket";
+		case PxDynamicTreeSecondaryPruner::eINCREMENTAL:	return "incremental";
+		case PxDynamicTreeSecondaryPruner::eBVH:			return "bvh";
+		case PxDynamicTreeSecondaryPruner::eLAST:			break;
+	}
+	return "";
+}
+
+static const char* getQueryTypeName(PxQueryTraceType::Enum type)
+{
+	switch(type)
+	{
+		case PxQueryTraceType::eRAYCAST:	return "raycast";
+		case PxQueryTraceType::eSWEEP:		return "sweep";
+		case PxQueryTraceType::eOVERLAP:	return "overlap";
+	}
+	return "";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A wavy terrain patch, cooked for the given midphase
+static PxTriangleMesh* createTerrainMesh(PxMeshMidPhase::Enum midphase, PxU32 size, PxReal cellSize)
+{
+	PxArray<PxVec3> vertices(size * size);
+	PxArray<PxU32> indices;
+	indices.reserve((size - 1) * (size - 1) * 6);
+	for(PxU32 z=0;z<size;z++)
+		for(PxU32 x=0;x<size;x++)
+		{
+			const PxReal fx = PxReal(x) * cellSize;
+			const PxReal fz = PxReal(z) * cellSize;
+			vertices[z * size + x] = PxVec3(fx, 2.0f * PxSin(fx * 0.1f) * PxCos(fz * 0.13f), fz);
+		}
+	for(PxU32 z=0;z<size-1;z++)
+		for(PxU32 x=0;x<size-1;x++)
+		{
+			const PxU32 i0 = z * size + x;
+			const PxU32 i1 = i0 + 1;
+			const PxU32 i2 = i0 + size;
+			const PxU32 i3 = i2 + 1;
+			indices.pushBack(i0);	indices.pushBack(i2);	indices.pushBack(i1);
+			indices.pushBack(i1);	indices.pushBack(i2);	indices.pushBack(i3);
+		}
+
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count		= vertices.size();
+	meshDesc.points.data		= vertices.begin();
+	meshDesc.points.stride		= sizeof(PxVec3);
+	meshDesc.triangles.count	= indices.size() / 3;
+	meshDesc.triangles.data		= indices.begin();
+	meshDesc.triangles.stride	= 3 * sizeof(PxU32);
+
+	PxCookingParams params(gPhysics->getTolerancesScale());
+	params.midphaseDesc = midphase;
+	return PxCreateTriangleMesh(params, meshDesc, gPhysics->getPhysicsInsertionCallback());
+}
+
+static void createGeneratedScene(PxScene& scene, PxMeshMidPhase::Enum midphase)
+{
+	BenchmarkRandom rnd(42);
+
+	scene.addActor(*PxCreatePlane(*gPhysics, PxPlane(0.0f, 1.0f, 0.0f, 0.0f), *gMaterial));
+
+	// 4 terrain patches, one per quadrant
+	PxTriangleMesh* mesh = createTerrainMesh(midphase, 64, 1.0f);
+	gMeshes.pushBack(mesh);
+	for(PxU32 i=0;i<4;i++)
+	{
+		const PxVec3 pos(i&1 ? 20.0f : -84.0f, 0.5f, i&2 ? 20.0f : -84.0f);
+		scene.addActor(*PxCreateStatic(*gPhysics, PxTransform(pos), PxTriangleMeshGeometry(mesh), *gMaterial));
+	}
+
+	for(PxU32 i=0;i<gNbStaticProps;i++)
+	{
+		const PxVec3 pos(rnd.randomFloat(-gWorldExtent, gWorldExtent), 0.0f, rnd.randomFloat(-gWorldExtent, gWorldExtent));
+		const PxQuat rot(rnd.randomFloat(0.0f, PxTwoPi), PxVec3(0.0f, 1.0f, 0.0f));
+		const PxVec3 halfExtents(rnd.randomFloat(0.2f, 2.0f), rnd.randomFloat(0.2f, 3.0f), rnd.randomFloat(0.2f, 2.0f));
+		scene.addActor(*PxCreateStatic(*gPhysics, PxTransform(pos + PxVec3(0.0f, halfExtents.y, 0.0f), rot), PxBoxGeometry(halfExtents), *gMaterial));
+	}
+
+	for(PxU32 i=0;i<gNbKinematics;i++)
+	{
+		Mover m;
+		m.mCenter = PxVec3(rnd.randomFloat(-gWorldExtent, gWorldExtent), rnd.randomFloat(1.0f, 4.0f), rnd.randomFloat(-gWorldExtent, gWorldExtent));
+		m.mRadius = rnd.randomFloat(2.0f, 10.0f);
+		m.mPhase = rnd.randomFloat(0.0f, PxTwoPi);
+		m.mActor = PxCreateKinematic(*gPhysics, PxTransform(m.mCenter), PxCapsuleGeometry(0.3f, 0.6f), *gMaterial, 1.0f);
+		scene.addActor(*m.mActor);
+		gMovers.pushBack(m);
+	}
+
+	for(PxU32 i=0;i<gNbDynamics;i++)
+	{
+		const PxVec3 pos(rnd.randomFloat(-gWorldExtent, gWorldExtent), rnd.randomFloat(5.0f, 15.0f), rnd.randomFloat(-gWorldExtent, gWorldExtent));
+		scene.addActor(*PxCreateDynamic(*gPhysics, PxTransform(pos), PxSphereGeometry(rnd.randomFloat(0.2f, 0.6f)), *gMaterial, 10.0f));
+	}
+}
+
+static void releaseGeneratedScene()
+{
+	gMovers.reset();
+	for(PxU32 i=0;i<gMeshes.size();i++)
+		gMeshes[i]->release();
+	gMeshes.reset();
+}
+
+static void stepScene(PxScene& scene, PxU32 frame)
+{
+	const PxReal time = PxReal(frame) * gTimeStep;
+	for(PxU32 i=0;i<gMovers.size();i++)
+	{
+		const Mover& m = gMovers[i];
+		const PxReal angle = m.mPhase + time;
+		m.mActor->setKinematicTarget(PxTransform(m.mCenter + PxVec3(PxCos(angle), 0.0f, PxSin(angle)) * m.mRadius));
+	}
+	scene.simulate(gTimeStep);
+	scene.fetchResults(true);
+}
+
+static PxScene* createScene(const Config& config)
+{
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity						= PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher					= gDispatcher;
+	sceneDesc.filterShader					= PxDefaultSimulationFilterShader;
+	sceneDesc.staticStructure				= config.mStaticStructure;
+	sceneDesc.dynamicStructure				= config.mDynamicStructure;
+	sceneDesc.dynamicTreeSecondaryPruner	= config.mSecondaryPruner;
+	PxScene* scene = gPhysics->createScene(sceneDesc);
+
+	if(gCollection)
+		scene->addCollection(*gCollection);
+	else
+		createGeneratedScene(*scene, config.mMidphase);
+	return scene;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Records a trace from a scripted game loop: visibility and weapon raycasts, ground probes, character sweeps and
+// trigger-like overlaps, issued through the regular PxScene API while the trace is registered as query recorder.
+static void recordTrace(PxU32 nbFrames)
+{
+	const Config config = { PxPruningStructureType::eDYNAMIC_AABB_TREE, PxPruningStructureType::eDYNAMIC_AABB_TREE,
+							PxDynamicTreeSecondaryPruner::eINCREMENTAL, PxMeshMidPhase::eBVH34 };
+	PxScene* scene = createScene(config);
+	scene->setQueryRecorder(gTrace);
+
+	BenchmarkRandom rnd(1234);
+	PxRaycastBuffer rayHit;
+	PxRaycastHit rayTouches[16];
+	PxSweepBuffer sweepHit;
+	PxOverlapHit overlapTouches[32];
+	const PxQueryFilterData touchFilter(PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::eNO_BLOCK);
+
+	for(PxU32 frame=0;frame<nbFrames;frame++)
+	{
+		for(PxU32 i=0;i<256;i++)
+		{
+			const PxVec3 origin(rnd.randomFloat(-gWorldExtent, gWorldExtent), rnd.randomFloat(0.5f, 4.0f), rnd.randomFloat(-gWorldExtent, gWorldExtent));
+			const float kind = rnd.randomFloat01();
+			if(kind<0.5f)
+			{
+				const PxReal angle = rnd.randomFloat(0.0f, PxTwoPi);
+				scene->raycast(origin, PxVec3(PxCos(angle), 0.0f, PxSin(angle)), 100.0f, rayHit);
+			}
+			else if(kind<0.8f)
+				scene->raycast(origin + PxVec3(0.0f, 5.0f, 0.0f), PxVec3(0.0f, -1.0f, 0.0f), 10.0f, rayHit);
+			else
+			{
+				PxRaycastBuffer multiHit(rayTouches, 16);
+				scene->raycast(origin, rnd.randomUnitVector(), 50.0f, multiHit, PxHitFlag::eDEFAULT, touchFilter);
+			}
+		}
+
+		for(PxU32 i=0;i<64;i++)
+		{
+			const PxVec3 pos(rnd.randomFloat(-gWorldExtent, gWorldExtent), rnd.randomFloat(1.0f, 3.0f), rnd.randomFloat(-gWorldExtent, gWorldExtent));
+			const PxVec3 dir = PxVec3(rnd.randomFloat(-1.0f, 1.0f), 0.0f, rnd.randomFloat(-1.0f, 1.0f)).getNormalized();
+			if(i&1)
+				scene->sweep(PxCapsuleGeometry(0.3f, 0.6f), PxTransform(pos, PxQuat(PxHalfPi, PxVec3(0.0f, 0.0f, 1.0f))), dir, 0.5f, sweepHit);
+			else
+				scene->sweep(PxSphereGeometry(0.25f), PxTransform(pos), dir, 20.0f, sweepHit);
+		}
+
+		for(PxU32 i=0;i<64;i++)
+		{
+			const PxVec3 pos(rnd.randomFloat(-gWorldExtent, gWorldExtent), rnd.randomFloat(0.5f, 3.0f), rnd.randomFloat(-gWorldExtent, gWorldExtent));
+			PxOverlapBuffer overlapHit(overlapTouches, 32);
+			if(i&1)
+				scene->overlap(PxSphereGeometry(rnd.randomFloat(1.0f, 6.0f)), PxTransform(pos), overlapHit, touchFilter);
+			else
+				scene->overlap(PxBoxGeometry(2.0f, 1.0f, 2.0f), PxTransform(pos), overlapHit, touchFilter);
+		}
+
+		stepScene(*scene, frame);
+	}
+
+	scene->setQueryRecorder(NULL);
+	scene->release();
+	releaseGeneratedScene();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void printLatencies(PxQueryTraceType::Enum type, PxArray<PxReal>& latencies, bool last)
+{
+	const PxU32 nb = latencies.size();
+	printf("        \"%s\": {", getQueryTypeName(type));
+	if(nb)
+	{
+		PxSort(latencies.begin(), nb);
+		PxReal total = 0.0f;
+		for(PxU32 i=0;i<nb;i++)
+			total += latencies[i];
+
+		printf(" \"count\": %u, \"queriesPerSecond\": %.0f, \"avgUs\": %.3f, \"p50Us\": %.3f, \"p90Us\": %.3f, \"p99Us\": %.3f, \"maxUs\": %.3f", nb,
+			total>0.0f ? double(nb) * 1e6 / double(total) : 0.0, double(total / PxReal(nb)),
+			double(latencies[nb/2]), double(latencies[(nb*9)/10]), double(latencies[(nb*99)/100]), double(latencies[nb-1]));
+	}
+	else
+		printf(" \"count\": 0");
+	printf(" }%s\n", last ? "" : ",");
+}
+
+static void runConfig(const Config& config, bool first)
+{
+	fprintf(stderr, "Running %s/%s/%s/%s...\n", getStructureName(config.mStaticStructure), getStructureName(config.mDynamicStructure),
+		getSecondaryPrunerName(config.mSecondaryPruner), gCollection ? "serialized" : (config.mMidphase==PxMeshMidPhase::eBVH34 ? "bvh34" : "bvh33"));
+
+	PxScene* scene = createScene(config);
+
+	// Let the dynamic objects settle and the pruners build once before measuring
+	PxU32 frame = 0;
+	for(;frame<10;frame++)
+		stepScene(*scene, frame);
+
+	PxArray<PxReal> latencies[3];
+	PxU32 nbHits = 0;
+	PxReal totalTime = 0.0f;
+
+	const PxU32 nbEntries = gTrace->getNbEntries();
+	const PxQueryTraceEntry* entries = gTrace->getEntries();
+	for(PxU32 i=0;i<nbEntries;i++)
+	{
+		const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+		nbHits += PxQueryTrace::replay(*scene, entries[i]);
+		const PxReal time = SnippetUtils::getElapsedTimeInMicroSeconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+		latencies[entries[i].type].pushBack(time);
+		totalTime += time;
+
+		if(((i+1) % gNbQueriesPerFrame)==0)
+			stepScene(*scene, frame++);
+	}
+
+	printf("%s    {\n", first ? "" : ",\n");
+	printf("      \"staticStructure\": \"%s\",\n", getStructureName(config.mStaticStructure));
+	printf("      \"dynamicStructure\": \"%s\",\n", getStructureName(config.mDynamicStructure));
+	printf("      \"secondaryPruner\": \"%s\",\n", getSecondaryPrunerName(config.mSecondaryPruner));
+	printf("      \"midphase\": \"%s\",\n", gCollection ? "serialized" : (config.mMidphase==PxMeshMidPhase::eBVH34 ? "bvh34" : "bvh33"));
+	printf("      \"totalMs\": %.3f,\n", double(totalTime) * 0.001);
+	printf("      \"hits\": %u,\n", nbHits);
+	printf("      \"queries\": {\n");
+	printLatencies(PxQueryTraceType::eRAYCAST, latencies[0], false);
+	printLatencies(PxQueryTraceType::eSWEEP, latencies[1], false);
+	printLatencies(PxQueryTraceType::eOVERLAP, latencies[2], true);
+	printf("      }\n");
+	printf("    }");
+	fflush(stdout);
+
+	scene->release();
+	if(!gCollection)
+		releaseGeneratedScene();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool loadCollection(const char* filename)
+{
+	PxDefaultFileInputData input(filename);
+	if(!input.isValid())
+		return false;
+
+	// Binary collections must be deserialized from 128-byte aligned memory, which must outlive the collection
+	const PxU32 size = input.getLength();
+	gCollectionMemory = malloc(size + PX_SERIAL_FILE_ALIGN - 1);
+	void* alignedMemory = reinterpret_cast<void*>((size_t(gCollectionMemory) + PX_SERIAL_FILE_ALIGN - 1) & ~size_t(PX_SERIAL_FILE_ALIGN - 1));
+	if(input.read(alignedMemory, size)!=size)
+		return false;
+
+	gRegistry = PxSerialization::createSerializationRegistry(*gPhysics);
+	gCollection = PxSerialization::createCollectionFromBinary(alignedMemory, *gRegistry);
+	return gCollection!=NULL;
+}
+
+static bool parseArgs(int argc, const char*const* argv)
+{
+	for(int i=1;i<argc;i++)
+	{
+		const bool hasValue = i+1<argc;
+		if(hasValue && !strcmp(argv[i], "--collection"))
+			gCollectionFile = argv[++i];
+		else if(hasValue && !strcmp(argv[i], "--trace"))
+			gTraceFile = argv[++i];
+		else if(hasValue && !strcmp(argv[i], "--save-trace"))
+			gSaveTraceFile = argv[++i];
+		else if(hasValue && !strcmp(argv[i], "--queries-per-frame"))
+			gNbQueriesPerFrame = PxMax(1u, PxU32(atoi(argv[++i])));
+		else
+		{
+			fprintf(stderr, "Usage: %s [--collection file] [--trace file] [--save-trace file] [--queries-per-frame N]\n", argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+	gDispatcher = PxDefaultCpuDispatcherCreate(0);
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.1f);
+	gTrace = new PxQueryTrace;
+}
+
+void cleanupPhysics()
+{
+	delete gTrace;
+	PX_RELEASE(gCollection);
+	PX_RELEASE(gRegistry);
+	PX_RELEASE(gMaterial);
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+	free(gCollectionMemory);
+
+	fprintf(stderr, "SnippetQueryBenchmark done.\n");
+}
+
+int snippetMain(int argc, const char*const* argv)
+{
+	if(!parseArgs(argc, argv))
+		return 1;
+
+	initPhysics();
+
+	if(gCollectionFile && !loadCollection(gCollectionFile))
+	{
+		fprintf(stderr, "Failed to load collection %s\n", gCollectionFile);
+		cleanupPhysics();
+		return 1;
+	}
+
+	if(gTraceFile)
+	{
+		PxDefaultFileInputData input(gTraceFile);
+		if(!input.isValid() || !gTrace->load(input))
+		{
+			fprintf(stderr, "Failed to load trace %s\n", gTraceFile);
+			cleanupPhysics();
+			return 1;
+		}
+	}
+	else
+		recordTrace(120);
+
+	if(gSaveTraceFile)
+	{
+		PxDefaultFileOutputStream output(gSaveTraceFile);
+		if(!output.isValid() || !gTrace->save(output))
+			fprintf(stderr, "Failed to save trace %s\n", gSaveTraceFile);
+	}
+
+	printf("{\n");
+	printf("  \"version\": \"%d.%d.%d\",\n", PX_PHYSICS_VERSION_MAJOR, PX_PHYSICS_VERSION_MINOR, PX_PHYSICS_VERSION_BUGFIX);
+	printf("  \"platform\": \"%s\",\n", PX_EMSCRIPTEN ? "wasm" : "native");
+	printf("  \"scene\": \"%s\",\n", gCollectionFile ? gCollectionFile : "generated");
+	printf("  \"nbQueries\": %u,\n", gTrace->getNbEntries());
+	printf("  \"nbDroppedQueries\": %u,\n", gTrace->getNbDroppedQueries());
+	printf("  \"queriesPerFrame\": %u,\n", gNbQueriesPerFrame);
+	printf("  \"configs\": [\n");
+
+	static const PxPruningStructureType::Enum staticStructures[] = { PxPruningStructureType::eNONE, PxPruningStructureType::eDYNAMIC_AABB_TREE, PxPruningStructureType::eSTATIC_AABB_TREE };
+	static const PxPruningStructureType::Enum dynamicStructures[] = { PxPruningStructureType::eNONE, PxPruningStructureType::eDYNAMIC_AABB_TREE };
+	static const PxDynamicTreeSecondaryPruner::Enum secondaryPruners[] = { PxDynamicTreeSecondaryPruner::eNONE, PxDynamicTreeSecondaryPruner::eBUCKET, PxDynamicTreeSecondaryPruner::eINCREMENTAL, PxDynamicTreeSecondaryPruner::eBVH };
+	static const PxMeshMidPhase::Enum midphases[] = { PxMeshMidPhase::eBVH33, PxMeshMidPhase::eBVH34 };
+
+	// The midphase only matters for the generated scene, serialized meshes are used as they are
+	const PxU32 nbMidphases = gCollection ? 1 : PX_ARRAY_SIZE(midphases);
+
+	bool first = true;
+	for(PxU32 s=0;s<PX_ARRAY_SIZE(staticStructures);s++)
+		for(PxU32 d=0;d<PX_ARRAY_SIZE(dynamicStructures);d++)
+		{
+			// The secondary pruner is only used by dynamic AABB trees
+			const bool usesDynamicTree = staticStructures[s]==PxPruningStructureType::eDYNAMIC_AABB_TREE || dynamicStructures[d]==PxPruningStructureType::eDYNAMIC_AABB_TREE;
+			const PxU32 nbSecondaryPruners = usesDynamicTree ? PX_ARRAY_SIZE(secondaryPruners) : 1;
+			for(PxU32 p=0;p<nbSecondaryPruners;p++)
+				for(PxU32 m=0;m<nbMidphases;m++)
+				{
+					const Config config = { staticStructures[s], dynamicStructures[d], secondaryPruners[p], midphases[nbMidphases==1 ? 1 : m] };
+					runConfig(config, first);
+					first = false;
+				}
+		}
+
+	printf("\n  ]\n}\n");
+
+	cleanupPhysics();
+
+	return 0;
+}
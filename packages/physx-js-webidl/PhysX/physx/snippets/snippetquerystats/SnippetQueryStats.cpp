@@ -0,0 +1,361 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet illustrates how to gather query statistics from the pruners.
+//
+// It builds the same set of objects in several standalone query systems, one
+// per pruner type, then replays the same stream of raycasts, overlaps and
+// sweeps against each of them. Each query's callback carries a stats block
+// that the pruners fill with the number of visited nodes, leaves and
+// primitives, and that the default callbacks fill with the number of exact
+// shape-level tests. The counters are then printed per query type and per
+// pruner, next to the time it took to run the stream.
+//
+// The same counters are available per pruner in PxCustomSceneQuerySystem,
+// see PxCustomSceneQuerySystem::setQueryStatsEnabled().
+//
+// ****************************************************************************
+
+#include <ctype.h>
+#include "PxPhysicsAPI.h"
+#include "GuQuerySystem.h"
+#include "GuFactory.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxTime.h"
+#include "../snippetcommon/SnippetPrint.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+using namespace Gu;
+
+static const float	gBoundsInflation = 0.001f;
+static const PxU32	gNbObjects = 4096;
+static const PxU32	gNbQueries = 2048;
+static const float	gWorldSize = 200.0f;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+
+namespace
+{
+	// Simple deterministic random generator, so that each pruner gets exactly the same data
+	class QueryStreamRandom
+	{
+		public:
+			QueryStreamRandom() : mSeed(42)	{}
+
+			float	randomFloat01()
+			{
+				mSeed = mSeed * 1664525 + 1013904223;
+				return float(mSeed>>8) / float(1<<24);
+			}
+
+			float	randomFloat(float minValue, float maxValue)
+			{
+				return minValue + randomFloat01() * (maxValue - minValue);
+			}
+
+			PxVec3	randomPoint()
+			{
+				const float x = randomFloat(-gWorldSize, gWorldSize);
+				const float y = randomFloat(-gWorldSize*0.1f, gWorldSize*0.1f);
+				const float z = randomFloat(-gWorldSize, gWorldSize);
+				return PxVec3(x, y, z);
+			}
+
+			PxVec3	randomDir()
+			{
+				PxVec3 dir(randomFloat(-1.0f, 1.0f), randomFloat(-0.2f, 0.2f), randomFloat(-1.0f, 1.0f));
+				if(dir.normalize() == 0.0f)
+					dir = PxVec3(1.0f, 0.0f, 0.0f);
+				return dir;
+			}
+
+			PxU32	mSeed;
+	};
+
+	struct Query
+	{
+		PxVec3	mOrigin;
+		PxVec3	mDir;
+		float	mDist;
+		float	mRadius;
+	};
+
+	class BenchScene : public Adapter
+	{
+		public:
+			BenchScene(const PxGeometryHolder* geoms, Pruner* pruner, bool dynamic);
+			~BenchScene()	{ PX_DELETE(mQuerySystem);	}
+
+			// Adapter
+			virtual	const PxGeometry&	getGeometry(const PrunerPayload& payload)	const
+			{
+				return mGeoms[PxU32(payload.data[0])].any();
+			}
+			//~Adapter
+
+			void	addObjects(const PxTransform* poses);
+
+			const PxGeometryHolder*	mGeoms;
+			QuerySystem*			mQuerySystem;
+			PxU32					mPrunerIndex;
+			const bool				mDynamic;
+	};
+
+BenchScene::BenchScene(const PxGeometryHolder* geoms, Pruner* pruner, bool dynamic) : mGeoms(geoms), mDynamic(dynamic)
+{
+	mQuerySystem = PX_NEW(QuerySystem)(PxU64(this), gBoundsInflation, *this);
+	mPrunerIndex = mQuerySystem->addPruner(pruner, gNbObjects);
+}
+
+void BenchScene::addObjects(const PxTransform* poses)
+{
+	for(PxU32 i=0;i<gNbObjects;i++)
+	{
+		PrunerPayload payload;
+		payload.data[0] = i;
+		payload.data[1] = size_t(this);
+		mQuerySystem->addPrunerShape(payload, mPrunerIndex, mDynamic, poses[i], NULL);
+	}
+
+	// Commit and build the internal structures before the queries
+	mQuerySystem->update(true, true);
+}
+
+	struct BenchFilterCallback : public PrunerFilterCallback
+	{
+		virtual	const PxGeometry*	validatePayload(const PrunerPayload& payload, PxHitFlags& /*hitFlags*/)
+		{
+			const BenchScene* scene = reinterpret_cast<const BenchScene*>(payload.data[1]);
+			return &scene->getGeometry(payload);
+		}
+	};
+
+	struct BenchOverlapCallback : public DefaultPrunerOverlapCallback
+	{
+		BenchOverlapCallback(PrunerFilterCallback& filterCB, const GeomOverlapTable* funcs, const PxGeometry& geometry, const PxTransform& pose) :
+			DefaultPrunerOverlapCallback(filterCB, funcs, geometry, pose), mNbHits(0)	{}
+
+		virtual	bool	reportHit(const PrunerPayload& /*payload*/)
+		{
+			mNbHits++;
+			return true;
+		}
+
+		PxU32	mNbHits;
+	};
+
+	enum QueryType
+	{
+		QUERY_RAYCAST,
+		QUERY_OVERLAP,
+		QUERY_SWEEP,
+
+		QUERY_COUNT
+	};
+
+	struct QueryTypeResults
+	{
+		QueryTypeResults() : mNbHits(0), mTime(0.0)	{}
+
+		PrunerQueryStats	mStats;
+		PxU32				mNbHits;
+		PxF64				mTime;
+	};
+}
+
+static BenchFilterCallback	gFilterCallback;
+static CachedFuncs			gCachedFuncs;
+
+static void runQueries(const BenchScene& scene, const Query* queries, QueryTypeResults* results)
+{
+	const QuerySystem& qs = *scene.mQuerySystem;
+	PxTime timer;
+
+	// Closest-hit raycasts
+	{
+		QueryTypeResults& res = results[QUERY_RAYCAST];
+		timer.getElapsedSeconds();
+		for(PxU32 i=0;i<gNbQueries;i++)
+		{
+			const Query& q = queries[i];
+			float dist = q.mDist;
+			DefaultPrunerRaycastClosestCallback CB(gFilterCallback, gCachedFuncs.mCachedRaycastFuncs, q.mOrigin, q.mDir, dist, PxHitFlag::eDEFAULT);
+			CB.mStats = &res.mStats;
+			qs.raycast(q.mOrigin, q.mDir, dist, CB, NULL);
+			if(CB.mFoundHit)
+				res.mNbHits++;
+		}
+		res.mTime += timer.getElapsedSeconds();
+	}
+
+	// Sphere overlaps reporting all touched objects
+	{
+		QueryTypeResults& res = results[QUERY_OVERLAP];
+		timer.getElapsedSeconds();
+		for(PxU32 i=0;i<gNbQueries;i++)
+		{
+			const Query& q = queries[i];
+			const PxSphereGeometry sphere(q.mRadius);
+			const PxTransform pose(q.mOrigin);
+			const ShapeData queryVolume(sphere, pose, 0.0f);
+			BenchOverlapCallback CB(gFilterCallback, gCachedFuncs.mCachedOverlapFuncs, sphere, pose);
+			CB.mStats = &res.mStats;
+			qs.overlap(queryVolume, CB, NULL);
+			res.mNbHits += CB.mNbHits;
+		}
+		res.mTime += timer.getElapsedSeconds();
+	}
+
+	// Closest-hit sphere sweeps
+	{
+		QueryTypeResults& res = results[QUERY_SWEEP];
+		timer.getElapsedSeconds();
+		for(PxU32 i=0;i<gNbQueries;i++)
+		{
+			const Query& q = queries[i];
+			const PxSphereGeometry sphere(q.mRadius*0.25f);
+			const PxTransform pose(q.mOrigin);
+			const ShapeData queryVolume(sphere, pose, 0.0f);
+			float dist = q.mDist;
+			DefaultPrunerSphereSweepCallback CB(gFilterCallback, gCachedFuncs.mCachedSweepFuncs, sphere, pose, queryVolume, q.mDir, dist, PxHitFlag::eDEFAULT, false);
+			CB.mStats = &res.mStats;
+			qs.sweep(queryVolume, q.mDir, dist, CB, NULL);
+			if(CB.mFoundHit)
+				res.mNbHits++;
+		}
+		res.mTime += timer.getElapsedSeconds();
+	}
+}
+
+static void printResults(const char* prunerName, const QueryTypeResults* results)
+{
+	static const char* queryNames[QUERY_COUNT] = { "raycasts", "overlaps", "sweeps" };
+
+	printf("%s:\n", prunerName);
+	for(PxU32 i=0;i<QUERY_COUNT;i++)
+	{
+		const QueryTypeResults& res = results[i];
+		const float coeff = 1.0f / float(gNbQueries);
+		printf("  %-8s %8.3f ms | hits %6d | per query: nodes %8.2f, leaves %7.2f, prims %7.2f, tests %6.2f\n",
+			queryNames[i], res.mTime*1000.0, res.mNbHits,
+			double(float(res.mStats.mNbNodes)*coeff), double(float(res.mStats.mNbLeaves)*coeff),
+			double(float(res.mStats.mNbPrims)*coeff), double(float(res.mStats.mNbTests)*coeff));
+	}
+}
+
+void initPhysics(bool /*interactive*/)
+{
+	// Like SnippetStandaloneQuerySystem, we only need Foundation here
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+}
+
+void stepPhysics(bool /*interactive*/)
+{
+	QueryStreamRandom rnd;
+
+	// Generate the objects: a mix of boxes, spheres and capsules scattered over a flat-ish world
+	PxArray<PxGeometryHolder> geoms(gNbObjects);
+	PxArray<PxTransform> poses(gNbObjects);
+	for(PxU32 i=0;i<gNbObjects;i++)
+	{
+		const float size = rnd.randomFloat(0.5f, 3.0f);
+		if((i%3)==0)
+			geoms[i].storeAny(PxBoxGeometry(size, size*0.5f, size*2.0f));
+		else if((i%3)==1)
+			geoms[i].storeAny(PxSphereGeometry(size));
+		else
+			geoms[i].storeAny(PxCapsuleGeometry(size*0.5f, size));
+
+		poses[i] = PxTransform(rnd.randomPoint(), PxQuat(rnd.randomFloat(0.0f, PxTwoPi), rnd.randomDir()));
+	}
+
+	// Generate the query stream, replayed as-is against each pruner
+	PxArray<Query> queries(gNbQueries);
+	for(PxU32 i=0;i<gNbQueries;i++)
+	{
+		queries[i].mOrigin	= rnd.randomPoint();
+		queries[i].mDir		= rnd.randomDir();
+		queries[i].mDist	= rnd.randomFloat(10.0f, gWorldSize);
+		queries[i].mRadius	= rnd.randomFloat(1.0f, 10.0f);
+	}
+
+	const PxU32 nbPruners = 5;
+	const char* prunerNames[nbPruners] = { "Static AABB tree", "Static quantized AABB tree", "Dynamic AABB tree", "Bucket pruner", "Incremental pruner" };
+
+	for(PxU32 i=0;i<nbPruners;i++)
+	{
+		const PxU64 contextID = PxU64(i);
+		Pruner* pruner;
+		bool dynamic = true;
+		if(i==0)
+		{
+			pruner = createAABBPruner(contextID, false, COMPANION_PRUNER_NONE, BVH_SPLATTER_POINTS, 4);
+			dynamic = false;
+		}
+		else if(i==1)
+		{
+			pruner = createAABBPruner(contextID, false, COMPANION_PRUNER_NONE, BVH_SPLATTER_POINTS, 4, 0.0f, true);
+			dynamic = false;
+		}
+		else if(i==2)
+			pruner = createAABBPruner(contextID, true, COMPANION_PRUNER_INCREMENTAL, BVH_SPLATTER_POINTS, 4);
+		else if(i==3)
+			pruner = createBucketPruner(contextID);
+		else
+			pruner = createIncrementalPruner(contextID);
+
+		BenchScene scene(geoms.begin(), pruner, dynamic);
+		scene.addObjects(poses.begin());
+
+		QueryTypeResults results[QUERY_COUNT];
+		runQueries(scene, queries.begin(), results);
+		printResults(prunerNames[i], results);
+	}
+}
+
+void cleanupPhysics(bool /*interactive*/)
+{
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetQueryStats done.\n");
+}
+
+int snippetMain(int, const char*const*)
+{
+	printf("Query Stats snippet. Node, leaf and primitive counts are only gathered by AABB-tree based pruners.\n");
+
+	initPhysics(false);
+	stepPhysics(false);
+	cleanupPhysics(false);
+
+	return 0;
+}
@@ -36,6 +36,10 @@
 
 /*
 Pool used to allocate variable sized tasks. It's intended to be cleared after a short period (time step).
+
+The first chunk acts as a frame arena: when a time step spills over into additional chunks, clear() replaces all of
+them with a single first chunk large enough for the whole step. After a few steps the pool settles on one contiguous
+region and stops calling the allocator.
 */
 
 namespace physx
@@ -48,7 +52,7 @@ namespace Cm
 	{
 		PX_NOCOPY(FlushPool)
 	public:
-		FlushPool(PxU32 chunkSize) : mChunks("FlushPoolChunk"), mChunkIndex(0), mOffset(0), mChunkSize(chunkSize)
+		FlushPool(PxU32 chunkSize) : mChunks("FlushPoolChunk"), mChunkIndex(0), mOffset(0), mChunkSize(chunkSize), mFirstChunkSize(chunkSize)
 		{
 			mChunks.pushBack(static_cast<PxU8*>(PX_ALLOC(mChunkSize, "PxU8")));
 		}
@@ -76,7 +80,7 @@ namespace Cm
 			size_t unalignedStart = size_t(mChunks[mChunkIndex]+mOffset);
 			PxU32 pad = PxU32(((unalignedStart+alignment-1)&~(size_t(alignment)-1)) - unalignedStart);
 
-			if (mOffset + size + pad > mChunkSize)
+			if (mOffset + size + pad > getCurrentChunkSize())
 			{
 				mChunkIndex++;
 				mOffset = 0;
@@ -103,6 +107,24 @@ namespace Cm
 
 		void clearNotThreadSafe(PxU32 spareChunkCount = sSpareChunkCount)
 		{
+			// PT: if this step needed more than the first chunk, grow the first chunk to the whole step's usage so
+			// that the next steps fit in it. Overflow chunks are released, their memory is now part of the first one.
+			if (mChunkIndex)
+			{
+				const PxU32 usedSize = mFirstChunkSize + (mChunkIndex - 1) * mChunkSize + mOffset;
+
+				for (PxU32 i = 0; i < mChunks.size(); ++i)
+					PX_FREE(mChunks[i]);
+				mChunks.clear();
+
+				mFirstChunkSize = PxNextPowerOfTwo(usedSize);
+				mChunks.pushBack(static_cast<PxU8*>(PX_ALLOC(mFirstChunkSize, "PxU8")));
+
+				mChunkIndex = 0;
+				mOffset = 0;
+				return;
+			}
+
 			//release memory not used previously
 			PxU32 targetSize = mChunkIndex+spareChunkCount;
 			while (mChunks.size() > targetSize)
@@ -139,11 +161,17 @@ namespace Cm
 		}
 
 	private:
+		PX_FORCE_INLINE PxU32 getCurrentChunkSize() const
+		{
+			return mChunkIndex ? mChunkSize : mFirstChunkSize;
+		}
+
 		PxMutex mMutex;
 		PxArray<PxU8*> mChunks;
 		PxU32 mChunkIndex;
 		PxU32 mOffset;
-		PxU32 mChunkSize;
+		PxU32 mChunkSize;		// size of overflow chunks
+		PxU32 mFirstChunkSize;	// size of the first chunk, grows to fit a whole time step
 	};
 
 	
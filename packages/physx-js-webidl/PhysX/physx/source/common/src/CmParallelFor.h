@@ -0,0 +1,59 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef CM_PARALLEL_FOR_H
+#define CM_PARALLEL_FOR_H
+
+#include "common/PxPhysXCommonConfig.h"
+
+namespace physx
+{
+	class PxCpuDispatcher;
+
+namespace Cm
+{
+	// PT: internal version of PxParallelFor, for code that cannot depend on the extensions library (e.g. cooking).
+	// process() is called concurrently with disjoint [startIndex, endIndex) ranges.
+	class ParallelForCallback
+	{
+		public:
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	= 0;
+
+		protected:
+			virtual			~ParallelForCallback()	{}
+	};
+
+	// PT: runs the callback over [0, count) using the dispatcher's worker threads and the calling thread. Returns once
+	// the whole range has been processed. Runs serially when the dispatcher is NULL or has no worker threads.
+	PX_PHYSX_COMMON_API void	parallelFor(PxCpuDispatcher* dispatcher, PxU32 count, PxU32 grain, ParallelForCallback& callback);
+
+	// PT: number of threads parallelFor() can use, including the calling thread
+	PX_PHYSX_COMMON_API PxU32	getParallelForThreadCount(const PxCpuDispatcher* dispatcher);
+}
+
+}
+
+#endif
@@ -274,6 +274,38 @@ public:
 		return mUseBitmap.findLast();
 	}
 
+	// Frees the trailing slabs that contain no used element. Elements are addressed by index so
+	// slabs in the middle of the range cannot go away. Returns the number of released bytes.
+	PxU32 releaseEmptySlabs()
+	{
+		const PxU32 nbUsedSlabs = mUseBitmap.hasAnyBitSet() ? (getMaxUsedIndex() >> mLog2EltsPerSlab) + 1 : 0;
+		if(nbUsedSlabs >= mSlabCount)
+			return 0;
+
+		// PT: drop the released elements from the free list, preserving its order
+		const PxU32 maxIndex = nbUsedSlabs * mEltsPerSlab;
+		PxU32 freeCount = 0;
+		for(PxU32 i=0;i<mFreeCount;i++)
+		{
+			if(mFreeList[i]->getIndex() < maxIndex)
+				mFreeList[freeCount++] = mFreeList[i];
+		}
+		mFreeCount = freeCount;
+
+		const PxU32 nbReleased = mSlabCount - nbUsedSlabs;
+		for(PxU32 i=nbUsedSlabs;i<mSlabCount;i++)
+		{
+			T* slab = mSlabs[i];
+			for(PxU32 j=0;j<mEltsPerSlab;j++)
+				slab[j].~T();
+			Alloc::deallocate(slab);
+			mSlabs[i] = NULL;
+		}
+		mSlabCount = nbUsedSlabs;
+
+		return nbReleased * mEltsPerSlab * PxU32(sizeof(T));
+	}
+
 	PX_INLINE PxBitMap::Iterator getIterator() const
 	{
 		return PxBitMap::Iterator(mUseBitmap);
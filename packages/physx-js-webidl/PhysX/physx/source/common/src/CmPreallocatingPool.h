@@ -92,6 +92,15 @@ public:
 		mFirstFree = element;
 	}
 
+	// PT: a region is empty when every element handed out so far is back in the free list
+	bool		isEmpty()	const
+	{
+		PxU32 nbFree = 0;
+		for(void* it = mFirstFree; it; it = *reinterpret_cast<void**>(it))
+			nbFree++;
+		return nbFree == mNbElements;
+	}
+
 	PX_FORCE_INLINE bool operator < (const PreallocatingRegion& p) const
 	{
 		return mMemory < p.mMemory;
@@ -150,6 +159,39 @@ class PreallocatingRegionManager
 		}
 	}
 
+	// Frees all empty regions but one. Returns the number of released bytes.
+	PxU32				releaseEmptyRegions()
+	{
+		PxU32 nbReleased = 0;
+		PxU32 nbPools = mPools.size();
+		for(PxU32 i=0;i<nbPools;)
+		{
+			PreallocatingRegion& region = mPools[i];
+			if(region.isEmpty())
+			{
+				if(nbPools>1)
+				{
+					region.reset();
+					mPools.replaceWithLast(i);
+					nbPools--;
+					nbReleased++;
+					continue;
+				}
+				// PT: keep the last region, but restart it from scratch to get rid of its fragmented free list
+				region.mFirstFree = NULL;
+				region.mNbElements = 0;
+			}
+			i++;
+		}
+
+		if(nbReleased)
+		{
+			mActivePoolIndex = 0;
+			mNeedsSorting = true;
+		}
+		return nbReleased * mMaxElements * mElementSize;
+	}
+
 	PX_FORCE_INLINE PxU8* allocateMemory()
 	{
 		PX_ASSERT(mActivePoolIndex<mPools.size());
@@ -266,6 +308,11 @@ public:
 		mPool.preAllocate(n);
 	}
 
+	PX_FORCE_INLINE	PxU32	releaseEmptyRegions()
+	{
+		return mPool.releaseEmptyRegions();
+	}
+
 	PX_INLINE T* allocate()
 	{
 		return reinterpret_cast<T*>(mPool.allocateMemory());
@@ -557,3 +557,381 @@ RadixSortBuffered& RadixSortBuffered::Sort(const float* input2, PxU32 nb)
 	return *this;
 }
 
+
+#include "task/PxCpuDispatcher.h"
+#include "task/PxTask.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxBasicTemplates.h"
+#include "foundation/PxMath.h"
+
+namespace
+{
+	// PT: keys are remapped so that comparing them as unsigned integers gives the desired order
+	struct RadixKeyUnsigned	{ static PX_FORCE_INLINE PxU32 get(PxU32 v)	{ return v;												} };
+	struct RadixKeySigned	{ static PX_FORCE_INLINE PxU32 get(PxU32 v)	{ return v ^ 0x80000000;								} };
+	struct RadixKeyFloat	{ static PX_FORCE_INLINE PxU32 get(PxU32 v)	{ return (v & 0x80000000) ? ~v : (v | 0x80000000);		} };
+
+	static const PxU32 RADIX_MAX_NB_BLOCKS = 32;
+
+	// PT: a parallel sort is a sequence of phases, each split into the same number of blocks. processBlock() runs
+	// concurrently for the blocks of a phase, then finishPhase() runs on the calling thread before the next phase starts.
+	class RadixSortWork
+	{
+		public:
+		virtual	void	processBlock(PxU32 phase, PxU32 block)	= 0;
+		virtual	void	finishPhase(PxU32 phase)				= 0;
+		protected:
+		virtual			~RadixSortWork()						{}
+	};
+
+	class RadixSortJob;
+
+	// PT: same as PxParallelFor, we don't use PxLightCpuTask here because it needs a PxTaskManager for its reference
+	// counting. These tasks are submitted directly to the dispatcher, which calls run() and then release().
+	class RadixSortTask : public PxBaseTask
+	{
+		public:
+									RadixSortTask() : mJob(NULL)	{}
+
+		virtual	void				run()							PX_OVERRIDE;
+		virtual	const char*			getName()				const	PX_OVERRIDE	{ return "Cm::RadixSortParallel";	}
+		virtual	void				addReference()					PX_OVERRIDE	{}
+		virtual	void				removeReference()				PX_OVERRIDE	{}
+		virtual	int32_t				getReference()			const	PX_OVERRIDE	{ return 1;							}
+		virtual	void				release()						PX_OVERRIDE;
+
+				RadixSortJob*		mJob;
+	};
+
+	// PT: chunks are numbered across phases, i.e. chunk c is block c%nbBlocks of phase c/nbBlocks, and they are grabbed
+	// with a single atomic counter. A thread that grabs a chunk from a phase that hasn't been published yet waits for it.
+	// This cannot deadlock: a phase is published by the calling thread once all the chunks of the previous phase are done,
+	// and all these chunks have been grabbed by threads that are already allowed to run them.
+	// The job is heap-allocated and reference counted because tasks can still be sitting in a dispatcher queue when the
+	// sort returns. Such late tasks only find chunks past the last phase and drop their reference.
+	class RadixSortJob : public PxUserAllocated
+	{
+		public:
+							RadixSortJob(RadixSortWork& work, PxU32 nbBlocks, PxU32 nbPhases, PxU32 nbTasks) :
+								mWork			(work),
+								mNbBlocks		(nbBlocks),
+								mNbPhases		(nbPhases),
+								mNextChunk		(0),
+								mNbDoneChunks	(0),
+								mPublishedPhase	(0),
+								mRefCount		(PxI32(nbTasks + 1))	// PT: +1 for the calling thread
+							{
+								PX_ASSERT(nbTasks <= RADIX_MAX_NB_BLOCKS);
+								for(PxU32 i=0;i<nbTasks;i++)
+									mTasks[i].mJob = this;
+							}
+
+				PX_FORCE_INLINE	PxU32	grabChunk()	{ return PxU32(PxAtomicIncrement(&mNextChunk) - 1);	}
+
+				void		processChunks()
+							{
+								for(;;)
+								{
+									const PxU32 chunk = grabChunk();
+									const PxU32 phase = chunk / mNbBlocks;
+									if(phase >= mNbPhases)
+										break;
+
+									while(PxU32(mPublishedPhase) < phase)
+										PxThread::yield();
+
+									mWork.processBlock(phase, chunk % mNbBlocks);
+									PxAtomicIncrement(&mNbDoneChunks);
+								}
+							}
+
+				// PT: called by the thread that started the sort
+				void		run()
+							{
+								PxU32 chunk = grabChunk();
+								for(PxU32 phase=0;phase<mNbPhases;phase++)
+								{
+									// PT: a chunk from a later phase is kept for when that phase gets published
+									while(chunk / mNbBlocks == phase)
+									{
+										mWork.processBlock(phase, chunk % mNbBlocks);
+										PxAtomicIncrement(&mNbDoneChunks);
+										chunk = grabChunk();
+									}
+
+									while(PxU32(mNbDoneChunks) != (phase + 1) * mNbBlocks)
+										PxThread::yield();
+
+									mWork.finishPhase(phase);
+									PxAtomicExchange(&mPublishedPhase, PxI32(phase + 1));
+								}
+							}
+
+				void		releaseReference()
+							{
+								if(!PxAtomicDecrement(&mRefCount))
+									PX_DELETE_THIS;
+							}
+
+		RadixSortWork&		mWork;
+		const PxU32			mNbBlocks;
+		const PxU32			mNbPhases;
+		volatile PxI32		mNextChunk;
+		volatile PxI32		mNbDoneChunks;
+		volatile PxI32		mPublishedPhase;
+		volatile PxI32		mRefCount;
+		RadixSortTask		mTasks[RADIX_MAX_NB_BLOCKS];
+
+		PX_NOCOPY(RadixSortJob)
+	};
+
+	void RadixSortTask::run()
+	{
+		mJob->processChunks();
+	}
+
+	void RadixSortTask::release()
+	{
+		mJob->releaseReference();
+	}
+
+	// PT: even phases compute the per-block histograms of a pass, odd phases scatter the blocks
+	template<class KeyT>
+	class RadixSortPasses : public RadixSortWork
+	{
+		public:
+							RadixSortPasses(const PxU32* input, PxU32 nb, PxU32 nbBlocks, PxU32 digitBits, PxU32* histograms, PxU32* ranks, PxU32* ranks2) :
+								mInput		(input),
+								mNb			(nb),
+								mBlockSize	((nb + nbBlocks - 1)/nbBlocks),
+								mDigitBits	(digitBits),
+								mNbBuckets	(1u<<digitBits),
+								mHistograms	(histograms),
+								mRanks		(ranks),
+								mRanks2		(ranks2),
+								mIdentity	(true),
+								mSkipPass	(false)
+							{
+							}
+
+		virtual	void		processBlock(PxU32 phase, PxU32 block)	PX_OVERRIDE
+							{
+								const PxU32 shift = (phase>>1) * mDigitBits;
+								const PxU32 mask = mNbBuckets - 1;
+								const PxU32 start = block * mBlockSize;
+								const PxU32 end = PxMin(start + mBlockSize, mNb);
+								const PxU32* PX_RESTRICT input = mInput;
+								const PxU32* PX_RESTRICT ranks = mRanks;
+								PxU32* PX_RESTRICT h = mHistograms + block * mNbBuckets;
+
+								if(!(phase & 1))
+								{
+									PxMemZero(h, mNbBuckets*sizeof(PxU32));
+									if(mIdentity)
+									{
+										for(PxU32 i=start;i<end;i++)
+											h[(KeyT::get(input[i])>>shift) & mask]++;
+									}
+									else
+									{
+										for(PxU32 i=start;i<end;i++)
+											h[(KeyT::get(input[ranks[i]])>>shift) & mask]++;
+									}
+								}
+								else if(!mSkipPass)
+								{
+									// PT: h now contains the output offsets of this block
+									PxU32* PX_RESTRICT dst = mRanks2;
+									if(mIdentity)
+									{
+										for(PxU32 i=start;i<end;i++)
+											dst[h[(KeyT::get(input[i])>>shift) & mask]++] = i;
+									}
+									else
+									{
+										for(PxU32 i=start;i<end;i++)
+										{
+											const PxU32 id = ranks[i];
+											dst[h[(KeyT::get(input[id])>>shift) & mask]++] = id;
+										}
+									}
+								}
+							}
+
+		virtual	void		finishPhase(PxU32 phase)	PX_OVERRIDE
+							{
+								if(!(phase & 1))
+								{
+									// PT: exclusive prefix sum, digit-major then block-minor, so that each block writes its elements
+									// after the same digits from previous blocks. If all values share the same digit the pass is useless.
+									const PxU32 nbBlocks = (mNb + mBlockSize - 1)/mBlockSize;
+									PxU32 sum = 0;
+									mSkipPass = false;
+									for(PxU32 d=0;d<mNbBuckets;d++)
+									{
+										const PxU32 digitStart = sum;
+										for(PxU32 b=0;b<nbBlocks;b++)
+										{
+											PxU32& h = mHistograms[b * mNbBuckets + d];
+											const PxU32 count = h;
+											h = sum;
+											sum += count;
+										}
+										if(sum - digitStart == mNb)
+										{
+											mSkipPass = true;
+											break;
+										}
+										if(sum == mNb)
+											break;
+									}
+								}
+								else if(!mSkipPass)
+								{
+									PxSwap(mRanks, mRanks2);
+									mIdentity = false;
+								}
+							}
+
+		const PxU32*		mInput;
+		const PxU32			mNb;
+		const PxU32			mBlockSize;
+		const PxU32			mDigitBits;
+		const PxU32			mNbBuckets;
+		PxU32*				mHistograms;
+		PxU32*				mRanks;
+		PxU32*				mRanks2;
+		bool				mIdentity;
+		bool				mSkipPass;
+
+		PX_NOCOPY(RadixSortPasses)
+	};
+}
+
+RadixSortParallel::RadixSortParallel() : mRanks(NULL), mRanks2(NULL), mCapacity(0), mHistograms(NULL), mHistogramsSize(0)
+{
+}
+
+RadixSortParallel::~RadixSortParallel()
+{
+	reset();
+}
+
+void RadixSortParallel::reset()
+{
+	PX_FREE(mHistograms);
+	PX_FREE(mRanks2);
+	PX_FREE(mRanks);
+	mCapacity = 0;
+	mHistogramsSize = 0;
+}
+
+template<class KeyT>
+void RadixSortParallel::sort(const PxU32* input, PxU32 nb, PxCpuDispatcher* dispatcher, RadixDigits digits)
+{
+	if(nb > mCapacity)
+	{
+		PX_FREE(mRanks2);
+		PX_FREE(mRanks);
+		mRanks	= PX_ALLOCATE(PxU32, nb, "RadixSortParallel:mRanks");
+		mRanks2	= PX_ALLOCATE(PxU32, nb, "RadixSortParallel:mRanks2");
+		mCapacity = nb;
+	}
+
+	const PxU32 digitBits = digits == RADIX_16_BITS ? 16 : 8;
+	const PxU32 nbPasses = 32 / digitBits;
+
+	// PT: blocks must be large enough to amortize clearing and scanning their histogram
+	const PxU32 minBlockSize = digits == RADIX_16_BITS ? 65536 : 8192;
+	const PxU32 nbWorkers = dispatcher ? dispatcher->getWorkerCount() : 0;
+	PxU32 nbBlocks = PxMin(PxMin(nbWorkers + 1, nb / minBlockSize), RADIX_MAX_NB_BLOCKS);
+	if(!nbBlocks)
+		nbBlocks = 1;
+
+	const PxU32 histogramsSize = nbBlocks << digitBits;
+	if(histogramsSize > mHistogramsSize)
+	{
+		PX_FREE(mHistograms);
+		mHistograms = PX_ALLOCATE(PxU32, histogramsSize, "RadixSortParallel:mHistograms");
+		mHistogramsSize = histogramsSize;
+	}
+
+	RadixSortPasses<KeyT> passes(input, nb, nbBlocks, digitBits, mHistograms, mRanks, mRanks2);
+
+	const PxU32 nbPhases = nbPasses * 2;
+	const PxU32 nbTasks = PxMin(nbWorkers, nbBlocks - 1);
+	if(!nbTasks)
+	{
+		for(PxU32 phase=0;phase<nbPhases;phase++)
+		{
+			for(PxU32 block=0;block<nbBlocks;block++)
+				passes.processBlock(phase, block);
+			passes.finishPhase(phase);
+		}
+	}
+	else
+	{
+		RadixSortJob* job = PX_NEW(RadixSortJob)(passes, nbBlocks, nbPhases, nbTasks);
+
+		for(PxU32 i=0;i<nbTasks;i++)
+			dispatcher->submitTask(job->mTasks[i]);
+
+		job->run();
+		job->releaseReference();
+	}
+
+	// PT: all keys were equal, every pass got skipped
+	if(passes.mIdentity)
+	{
+		for(PxU32 i=0;i<nb;i++)
+			passes.mRanks[i] = i;
+	}
+
+	mRanks = passes.mRanks;
+	mRanks2 = passes.mRanks2;
+}
+
+/**
+ *	Main sort routine.
+ *	This one is for integer values. After the call, mRanks contains a list of indices in sorted order, i.e. in the order you may process your data.
+ *	\param		input		[in] a list of integer values to sort
+ *	\param		nb			[in] number of values to sort, must be < 2^31
+ *	\param		hint		[in] RADIX_SIGNED to handle negative values, RADIX_UNSIGNED if you know your input buffer only contains positive values
+ *	\param		dispatcher	[in] CPU dispatcher used to run the passes in parallel, or NULL to sort on the calling thread
+ *	\param		digits		[in] size of the radix digits
+ *	\return		Self-Reference
+ */
+RadixSortParallel& RadixSortParallel::Sort(const PxU32* input, PxU32 nb, RadixHint hint, PxCpuDispatcher* dispatcher, RadixDigits digits)
+{
+	// Checkings
+	if(!input || !nb || nb&0x80000000)
+		return *this;
+
+	if(hint==RADIX_UNSIGNED)
+		sort<RadixKeyUnsigned>(input, nb, dispatcher, digits);
+	else
+		sort<RadixKeySigned>(input, nb, dispatcher, digits);
+	return *this;
+}
+
+/**
+ *	Main sort routine.
+ *	This one is for floating-point values. After the call, mRanks contains a list of indices in sorted order, i.e. in the order you may process your data.
+ *	\param		input2		[in] a list of floating-point values to sort
+ *	\param		nb			[in] number of values to sort, must be < 2^31
+ *	\param		dispatcher	[in] CPU dispatcher used to run the passes in parallel, or NULL to sort on the calling thread
+ *	\param		digits		[in] size of the radix digits
+ *	\return		Self-Reference
+ *	\warning	only sorts IEEE floating-point values
+ */
+RadixSortParallel& RadixSortParallel::Sort(const float* input2, PxU32 nb, PxCpuDispatcher* dispatcher, RadixDigits digits)
+{
+	// Checkings
+	if(!input2 || !nb || nb&0x80000000)
+		return *this;
+
+	sort<RadixKeyFloat>(reinterpret_cast<const PxU32*>(input2), nb, dispatcher, digits);
+	return *this;
+}
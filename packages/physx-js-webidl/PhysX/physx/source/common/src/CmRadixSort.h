@@ -33,6 +33,8 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Cm
 {
 	enum RadixHint
@@ -111,6 +113,45 @@ namespace Cm
 		void				CheckResize(PxU32 nb);
 		bool				Resize(PxU32 nb);
 	};
+
+	enum RadixDigits
+	{
+		RADIX_8_BITS,		//!< 4 passes over 8-bit digits
+		RADIX_16_BITS		//!< 2 passes over 16-bit digits. Needs 256Kb of histogram per block, only worth it for large arrays.
+	};
+
+	// PT: LSD radix sort whose passes are split across the threads of a CPU dispatcher. Each pass computes one histogram
+	// per block of the current ranks, turns them into per-block offsets with a prefix sum, then scatters each block in parallel.
+	// Blocks are contiguous ranges of the current ranks so the sort is stable. There is no temporal coherence, i.e. the ranks
+	// are always recomputed from scratch. Small arrays, or a NULL dispatcher, run the same passes on the calling thread.
+	class PX_PHYSX_COMMON_API RadixSortParallel
+	{
+										PX_NOCOPY(RadixSortParallel)
+		public:
+										RadixSortParallel();
+										~RadixSortParallel();
+
+						void			reset();
+
+						RadixSortParallel&	Sort(const PxU32* input, PxU32 nb, RadixHint hint, PxCpuDispatcher* dispatcher, RadixDigits digits=RADIX_8_BITS);
+						RadixSortParallel&	Sort(const float* input, PxU32 nb, PxCpuDispatcher* dispatcher, RadixDigits digits=RADIX_8_BITS);
+
+		//! Access to results. mRanks is a list of indices in sorted order, i.e. in the order you may further process your data
+		PX_FORCE_INLINE	const PxU32*	GetRanks()			const	{ return mRanks;		}
+
+		//! mRanks2 gets trashed on calling the sort routine, but otherwise you can recycle it the way you want.
+		PX_FORCE_INLINE	PxU32*			GetRecyclable()		const	{ return mRanks2;		}
+
+		private:
+						PxU32*			mRanks;
+						PxU32*			mRanks2;
+						PxU32			mCapacity;			//!< Capacity of the ranks buffers
+						PxU32*			mHistograms;		//!< One histogram per block
+						PxU32			mHistogramsSize;	//!< Number of PxU32 allocated for mHistograms
+
+						template<class KeyT>
+						void			sort(const PxU32* input, PxU32 nb, PxCpuDispatcher* dispatcher, RadixDigits digits);
+	};
 }
 }
 
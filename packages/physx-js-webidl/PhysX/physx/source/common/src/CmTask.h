@@ -66,6 +66,58 @@ namespace Cm
 		}
 
 		virtual void runInternal()=0;
+
+		// PT: same as setContinuation() but the single reference is owned by a predecessor task that
+		// has not been released yet, so no addReference()/removeReference() pair is needed. See TaskChain.
+		PX_FORCE_INLINE	void	setChainedContinuation(PxTaskManager& tm, PxBaseTask* c)
+		{
+			PX_ASSERT(mRefCount == 0);
+			mRefCount = 1;
+			mCont = c;
+			mTm = &tm;
+		}
+	};
+
+	/**
+	\brief A linear chain of tasks, recorded once and replayed each frame.
+
+	Setting up a chain with setContinuation() costs one addReference() and one removeReference() per task. Since none
+	of the tasks can run before the head is released, replaying a recorded chain only needs plain stores for all
+	tasks, one addReference() on the external continuation and one removeReference() on the head.
+
+	Tasks can still add dependencies to their successors while they run, as usual.
+	*/
+	class TaskChain
+	{
+		PX_NOCOPY(TaskChain)
+	public:
+		enum { MAX_NB_TASKS = 16 };
+
+						TaskChain() : mNbTasks(0)	{}
+
+		PX_FORCE_INLINE	void	reset()						{ mNbTasks = 0;										}
+		PX_FORCE_INLINE	PxU32	size()				const	{ return mNbTasks;									}
+		PX_FORCE_INLINE	void	record(Cm::Task& task)		{ PX_ASSERT(mNbTasks<MAX_NB_TASKS); mTasks[mNbTasks++] = &task;	}
+
+		// PT: tasks run in recording order, then the continuation
+		void	launch(PxBaseTask* continuation)
+		{
+			PX_ASSERT(continuation && mNbTasks);
+			PxTaskManager& tm = *continuation->getTaskManager();
+
+			const PxU32 last = mNbTasks - 1;
+			for(PxU32 i=0; i<last; i++)
+				mTasks[i]->setChainedContinuation(tm, mTasks[i+1]);
+			mTasks[last]->setChainedContinuation(tm, continuation);
+			continuation->addReference();
+
+			// PT: the head's reference is the setup reference, releasing it starts the chain
+			mTasks[0]->removeReference();
+		}
+
+	private:
+		Cm::Task*	mTasks[MAX_NB_TASKS];
+		PxU32		mNbTasks;
 	};
 
 	// same as Cm::Task but inheriting from physx::PxBaseTask
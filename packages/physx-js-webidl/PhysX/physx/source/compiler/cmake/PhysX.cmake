@@ -68,6 +68,7 @@ SET(PHYSX_HEADERS
 	${PHYSX_ROOT_DIR}/include/PxDeformableVolumeFlag.h
 	${PHYSX_ROOT_DIR}/include/PxDeletionListener.h
 	${PHYSX_ROOT_DIR}/include/PxFEMParameter.h #deprecated
+	${PHYSX_ROOT_DIR}/include/PxFieldEffector.h
 	${PHYSX_ROOT_DIR}/include/PxFiltering.h
 	${PHYSX_ROOT_DIR}/include/PxForceMode.h
 	${PHYSX_ROOT_DIR}/include/PxImmediateMode.h
@@ -85,6 +86,7 @@ SET(PHYSX_HEADERS
 	${PHYSX_ROOT_DIR}/include/PxPhysXConfig.h
 	${PHYSX_ROOT_DIR}/include/PxPruningStructure.h
 	${PHYSX_ROOT_DIR}/include/PxQueryFiltering.h
+	${PHYSX_ROOT_DIR}/include/PxQueryRecorder.h
 	${PHYSX_ROOT_DIR}/include/PxQueryReport.h
 	${PHYSX_ROOT_DIR}/include/PxRigidActor.h
 	${PHYSX_ROOT_DIR}/include/PxRigidBody.h
@@ -42,6 +42,7 @@ SET(PHYSXCCT_HEADERS
 	${PHYSX_ROOT_DIR}/include/characterkinematic/PxControllerBehavior.h
 	${PHYSX_ROOT_DIR}/include/characterkinematic/PxControllerManager.h
 	${PHYSX_ROOT_DIR}/include/characterkinematic/PxControllerObstacles.h
+	${PHYSX_ROOT_DIR}/include/characterkinematic/PxControllerLayerFilter.h
 	${PHYSX_ROOT_DIR}/include/characterkinematic/PxExtended.h
 )
 SOURCE_GROUP(include FILES ${PHYSXCCT_HEADERS})
@@ -57,6 +58,7 @@ SET(PHYSXCCT_SOURCE
 	${LL_SOURCE_DIR}/CctSweptBox.cpp
 	${LL_SOURCE_DIR}/CctSweptCapsule.cpp
 	${LL_SOURCE_DIR}/CctSweptVolume.cpp
+	${LL_SOURCE_DIR}/CctTileCache.cpp
 	${LL_SOURCE_DIR}/CctBoxController.h
 	${LL_SOURCE_DIR}/CctCapsuleController.h
 	${LL_SOURCE_DIR}/CctCharacterController.h
@@ -67,6 +69,7 @@ SET(PHYSXCCT_SOURCE
 	${LL_SOURCE_DIR}/CctSweptBox.h
 	${LL_SOURCE_DIR}/CctSweptCapsule.h
 	${LL_SOURCE_DIR}/CctSweptVolume.h
+	${LL_SOURCE_DIR}/CctTileCache.h
 	${LL_SOURCE_DIR}/CctUtils.h
 )
 SOURCE_GROUP(src FILES ${PHYSXCCT_SOURCE})
@@ -87,6 +90,7 @@ TARGET_INCLUDE_DIRECTORIES(PhysXCharacterKinematic
 	PRIVATE ${PHYSX_SOURCE_DIR}/common/src
 	
 	PRIVATE ${PHYSX_SOURCE_DIR}/geomutils/include
+	PRIVATE ${PHYSX_SOURCE_DIR}/geomutils/src
 )
 
 TARGET_COMPILE_DEFINITIONS(PhysXCharacterKinematic 
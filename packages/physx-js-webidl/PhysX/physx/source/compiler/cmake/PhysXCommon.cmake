@@ -52,6 +52,8 @@ SET(PHYSX_COMMON_SOURCE
 	${COMMON_SRC_DIR}/CmFlushPool.h
 	${COMMON_SRC_DIR}/CmIDPool.h
 	${COMMON_SRC_DIR}/CmMatrix34.h
+	${COMMON_SRC_DIR}/CmParallelFor.h
+	${COMMON_SRC_DIR}/CmParallelFor.cpp
 	${COMMON_SRC_DIR}/CmPool.h
 	${COMMON_SRC_DIR}/CmPreallocatingPool.h
 	${COMMON_SRC_DIR}/CmPriorityQueue.h
@@ -264,6 +266,7 @@ SET(PHYSXCOMMON_GU_CONTACT_SOURCE
 	${GU_SOURCE_DIR}/src/contact/GuContactPlaneConvex.cpp
 	${GU_SOURCE_DIR}/src/contact/GuContactPlaneMesh.cpp
 	${GU_SOURCE_DIR}/src/contact/GuContactPolygonPolygon.cpp
+	${GU_SOURCE_DIR}/src/contact/GuContactPrimitives4.cpp
 	${GU_SOURCE_DIR}/src/contact/GuContactMeshMesh.cpp
 	${GU_SOURCE_DIR}/src/contact/GuContactMeshMesh.h
 	${GU_SOURCE_DIR}/src/contact/GuContactReduction.h
@@ -394,6 +397,8 @@ SET(PXCOMMON_BVH4_FILES
 SET(PHYSXCOMMON_GU_MESH_SOURCE
 	${GU_SOURCE_DIR}/src/mesh/GuBV4.cpp
 	${GU_SOURCE_DIR}/src/mesh/GuBV4Build.cpp
+	${GU_SOURCE_DIR}/src/mesh/GuBV8.cpp
+	${GU_SOURCE_DIR}/src/mesh/GuBV8_Queries.cpp
 
 	${PXCOMMON_BVH4_FILES}
 
@@ -415,6 +420,7 @@ SET(PHYSXCOMMON_GU_MESH_SOURCE
 	${GU_SOURCE_DIR}/src/mesh/GuBV4.h
 	${GU_SOURCE_DIR}/src/mesh/GuBV4Build.h
 	${GU_SOURCE_DIR}/src/mesh/GuBV4Settings.h
+	${GU_SOURCE_DIR}/src/mesh/GuBV8.h
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_AABBAABBSweepTest.h
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_BoxBoxOverlapTest.h
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_BoxOverlap_Internal.h
@@ -567,6 +573,7 @@ SET(PHYSXCOMMON_GU_COOKING_SOURCE
 	${GU_SOURCE_DIR}/src/cooking/GuCookingHF.cpp
 	${GU_SOURCE_DIR}/src/cooking/GuCookingGrbTriangleMesh.h
 	${GU_SOURCE_DIR}/src/cooking/GuCookingConvexMesh.cpp
+	${GU_SOURCE_DIR}/src/cooking/GuCookingConvexDecomposition.cpp
 	${GU_SOURCE_DIR}/src/cooking/GuCookingTriangleMesh.h
 	${GU_SOURCE_DIR}/src/cooking/GuCookingTriangleMesh.cpp
 	${GU_SOURCE_DIR}/src/cooking/GuCookingTetrahedronMesh.h
@@ -45,6 +45,7 @@ SET(PHYSX_COOKING_HEADERS
 	${PHYSX_ROOT_DIR}/include/cooking/Pxc.h
 	${PHYSX_ROOT_DIR}/include/cooking/PxConvexMeshDesc.h
 	${PHYSX_ROOT_DIR}/include/cooking/PxCooking.h
+	${PHYSX_ROOT_DIR}/include/cooking/PxCookingCache.h
 	${PHYSX_ROOT_DIR}/include/cooking/PxCookingInternal.h
 	${PHYSX_ROOT_DIR}/include/cooking/PxMidphaseDesc.h
 	${PHYSX_ROOT_DIR}/include/cooking/PxTriangleMeshDesc.h
@@ -58,6 +59,7 @@ SOURCE_GROUP(include FILES ${PHYSX_COOKING_HEADERS})
 SET(PHYSX_COOKING_SOURCE
 	${LL_SOURCE_DIR}/Cooking.cpp
 	${LL_SOURCE_DIR}/Cooking.h
+	${LL_SOURCE_DIR}/CookingCache.cpp
 )
 SOURCE_GROUP(src FILES ${PHYSX_COOKING_SOURCE})
 
@@ -39,9 +39,11 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtCollection.cpp
 	${LL_SOURCE_DIR}/ExtConvexMeshExt.cpp
 	${LL_SOURCE_DIR}/ExtCpuWorkerThread.cpp
+	${LL_SOURCE_DIR}/ExtDefaultContactModifyCallback.cpp
 	${LL_SOURCE_DIR}/ExtDefaultCpuDispatcher.cpp
 	${LL_SOURCE_DIR}/ExtDefaultErrorCallback.cpp
 	${LL_SOURCE_DIR}/ExtDefaultProfiler.cpp
+	${LL_SOURCE_DIR}/ExtChromeTraceProfiler.cpp
 	${LL_SOURCE_DIR}/ExtDefaultSimulationFilterShader.cpp
 	${LL_SOURCE_DIR}/ExtDefaultStreams.cpp
 	${LL_SOURCE_DIR}/ExtExtensions.cpp
@@ -50,9 +52,35 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtRaycastCCD.cpp
 	${LL_SOURCE_DIR}/ExtRigidBodyExt.cpp
 	${LL_SOURCE_DIR}/ExtRigidActorExt.cpp
+	${LL_SOURCE_DIR}/ExtSceneExt.cpp
 	${LL_SOURCE_DIR}/ExtSceneQueryExt.cpp
 	${LL_SOURCE_DIR}/ExtSceneQuerySystem.cpp
+	${LL_SOURCE_DIR}/ExtActiveActorTracker.cpp
+	${LL_SOURCE_DIR}/ExtSceneSnapshot.cpp
+	${LL_SOURCE_DIR}/ExtAllocationTracker.cpp
+	${LL_SOURCE_DIR}/ExtAllocationTripwire.cpp
+	${LL_SOURCE_DIR}/ExtLazyStatics.cpp
+	${LL_SOURCE_DIR}/ExtMultiSceneScheduler.cpp
+	${LL_SOURCE_DIR}/ExtParallelFor.cpp
+	${LL_SOURCE_DIR}/ExtSceneStepper.cpp
+	${LL_SOURCE_DIR}/ExtShardedScene.cpp
+	${LL_SOURCE_DIR}/ExtTriggerTracker.cpp
+	${LL_SOURCE_DIR}/ExtImmediatePairCache.cpp
+	${LL_SOURCE_DIR}/ExtImmediateWorld.cpp
+	${LL_SOURCE_DIR}/ExtRope.cpp
+	${LL_SOURCE_DIR}/ExtQueryTrace.cpp
+	${LL_SOURCE_DIR}/ExtSceneQueryHistory.cpp
+	${LL_SOURCE_DIR}/ExtFrameSpikeRecorder.cpp
+	${LL_SOURCE_DIR}/ExtOmniPvdAsyncWriteStream.cpp
+	${LL_SOURCE_DIR}/ExtObjectIdTable.cpp
+	${LL_SOURCE_DIR}/ExtActorHibernation.cpp
+	${LL_SOURCE_DIR}/ExtCpuParticleSystem.cpp
+	${LL_SOURCE_DIR}/ExtStaticVoxelizer.cpp
+	${LL_SOURCE_DIR}/ExtAutoAggregator.cpp
+	${LL_SOURCE_DIR}/ExtSimulationEventStream.cpp
 	${LL_SOURCE_DIR}/ExtCustomSceneQuerySystem.cpp
+	${LL_SOURCE_DIR}/ExtConcurrentSceneQuerySystem.cpp
+	${LL_SOURCE_DIR}/ExtCachedSceneQuerySystem.cpp
 	${LL_SOURCE_DIR}/ExtSqQuery.cpp
 	${LL_SOURCE_DIR}/ExtSqQuery.h
 	${LL_SOURCE_DIR}/ExtSqManager.cpp
@@ -62,10 +90,12 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtDeformableSurfaceExt.cpp
 	${LL_SOURCE_DIR}/ExtDeformableVolumeExt.cpp
 	${LL_SOURCE_DIR}/ExtTriangleMeshExt.cpp
+	${LL_SOURCE_DIR}/ExtHeightFieldExt.cpp
 	${LL_SOURCE_DIR}/ExtTetrahedronMeshExt.cpp
 	${LL_SOURCE_DIR}/ExtRemeshingExt.cpp
 	${LL_SOURCE_DIR}/ExtCpuWorkerThread.h
 	${LL_SOURCE_DIR}/ExtDefaultCpuDispatcher.h
+	${LL_SOURCE_DIR}/ExtCooperativeCpuDispatcher.cpp
 	${LL_SOURCE_DIR}/ExtDefaultProfiler.h
 	${LL_SOURCE_DIR}/ExtInertiaTensor.h
 	${LL_SOURCE_DIR}/ExtPlatform.h
@@ -73,6 +103,7 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtSerialization.h
 	${LL_SOURCE_DIR}/ExtSharedQueueEntryPool.h
 	${LL_SOURCE_DIR}/ExtTaskQueueHelper.h
+	${LL_SOURCE_DIR}/ExtWorkStealingDeque.h
 	${LL_SOURCE_DIR}/ExtSampling.cpp
 	${LL_SOURCE_DIR}/ExtTetMakerExt.cpp
 	${LL_SOURCE_DIR}/ExtGjkQueryExt.cpp
@@ -174,22 +205,52 @@ SET(PHYSX_EXTENSIONS_HEADERS
 	${PHYSX_ROOT_DIR}/include/extensions/PxConvexMeshExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxCudaHelpersExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultAllocator.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultCookingCacheStorage.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultContactModifyCallback.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultCpuDispatcher.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxCooperativeCpuDispatcher.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultErrorCallback.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxChromeTraceProfiler.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultProfiler.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultSimulationFilterShader.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultStreams.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDeformableSurfaceExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDeformableVolumeExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxExtensionsAPI.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxHeightFieldExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxMassProperties.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxRaycastCCD.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxRepXSerializer.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxRepXSimpleType.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxRigidActorExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxRigidBodyExt.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxSceneExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSceneQueryExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSceneQuerySystemExt.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxActiveActorTracker.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxSceneSnapshot.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxAllocationTracker.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxAllocationTripwire.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxLazyStatics.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxMultiSceneScheduler.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxParallelFor.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxSceneStepper.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxShardedScene.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxTriggerTracker.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxImmediatePairCache.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxImmediateWorld.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxRope.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxQueryTrace.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxSceneQueryHistory.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxFrameSpikeRecorder.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxOmniPvdAsyncWriteStream.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxObjectIdTable.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxActorHibernation.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxCpuParticleSystem.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxStaticVoxelizer.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxAutoAggregator.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxSimulationEventStream.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxLayerCollisionMatrix.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxCustomSceneQuerySystem.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSerialization.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxShapeExt.h
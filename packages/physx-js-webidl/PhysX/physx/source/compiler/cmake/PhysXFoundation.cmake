@@ -57,6 +57,7 @@ SET(PHYSXFOUNDATION_HEADERS
 	${PHYSX_ROOT_DIR}/include/foundation/PxErrorCallback.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxErrors.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxFlags.h
+	${PHYSX_ROOT_DIR}/include/foundation/PxFlatHashMap.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxFPU.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxInlineAoS.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxIntrinsics.h
@@ -78,6 +78,8 @@ SET(PHYSXPVDSDK_SOURCE
 	${LL_SOURCE_DIR}/src/PxPvdDefaultFileTransport.h
 	${LL_SOURCE_DIR}/src/PxPvdDefaultSocketTransport.cpp
 	${LL_SOURCE_DIR}/src/PxPvdDefaultSocketTransport.h
+	${LL_SOURCE_DIR}/src/PxPvdAsyncTransport.cpp
+	${LL_SOURCE_DIR}/src/PxPvdAsyncTransport.h
 	${LL_SOURCE_DIR}/src/PxPvdFoundation.h
 	${LL_SOURCE_DIR}/src/PxPvdImpl.cpp
 	${LL_SOURCE_DIR}/src/PxPvdImpl.h
@@ -59,6 +59,12 @@ SET(PHYSX_VEHICLE_DRIVETRAIN_HEADERS
 	${PHYSX_ROOT_DIR}/include/vehicle2/drivetrain/PxVehicleDrivetrainParams.h
 	${PHYSX_ROOT_DIR}/include/vehicle2/drivetrain/PxVehicleDrivetrainStates.h
 )
+SET(PHYSX_VEHICLE_LOD_HEADERS
+	${PHYSX_ROOT_DIR}/include/vehicle2/lod/PxVehicleLodComponents.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/lod/PxVehicleLodFunctions.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/lod/PxVehicleLodParams.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/lod/PxVehicleLodStates.h
+)
 SET(PHYSX_VEHICLE_PHYSXACTOR_HEADERS
 	${PHYSX_ROOT_DIR}/include/vehicle2/physxActor/PxVehiclePhysXActorComponents.h
 	${PHYSX_ROOT_DIR}/include/vehicle2/physxActor/PxVehiclePhysXActorFunctions.h
@@ -86,6 +92,8 @@ SET(PHYSX_VEHICLE_RIGIDBODY_HEADERS
 	${PHYSX_ROOT_DIR}/include/vehicle2/rigidBody/PxVehicleRigidBodyStates.h
 )
 SET(PHYSX_VEHICLE_ROADGEOMETRY_HEADERS
+	${PHYSX_ROOT_DIR}/include/vehicle2/roadGeometry/PxVehicleRoadGeometryComponents.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/roadGeometry/PxVehicleRoadGeometryHelpers.h
 	${PHYSX_ROOT_DIR}/include/vehicle2/roadGeometry/PxVehicleRoadGeometryState.h
 )
 SET(PHYSX_VEHICLE_STEERING_HEADERS
@@ -123,6 +131,7 @@ SOURCE_GROUP(include FILES ${PHYSX_VEHICLE_HEADERS})
 SOURCE_GROUP(include\\braking FILES ${PHYSX_VEHICLE_BRAKING_HEADERS})
 SOURCE_GROUP(include\\commands FILES ${PHYSX_VEHICLE_COMMAND_HEADERS})
 SOURCE_GROUP(include\\drivetrain FILES ${PHYSX_VEHICLE_DRIVETRAIN_HEADERS})
+SOURCE_GROUP(include\\lod FILES ${PHYSX_VEHICLE_LOD_HEADERS})
 SOURCE_GROUP(include\\physxActor FILES ${PHYSX_VEHICLE_PHYSXACTOR_HEADERS})
 SOURCE_GROUP(include\\physxConstraints FILES ${PHYSX_VEHICLE_PHYSXCONSTRAINT_HEADERS})
 SOURCE_GROUP(include\\rigidBody FILES ${PHYSX_VEHICLE_RIGIDBODY_HEADERS})
@@ -135,6 +144,9 @@ SOURCE_GROUP(include\\wheel FILES ${PHYSX_VEHICLE_WHEEL_HEADERS})
 SOURCE_GROUP(include\\pvd FILES ${PHYSX_VEHICLE_PVD_HEADERS})
 
 
+SET(PHYSX_VEHICLE_SOURCE
+	${LL_SOURCE_DIR}/VhComponentSequence.cpp
+)
 SET(PHYSX_VEHICLE_BRAKING_SOURCE
 )
 SET(PHYSX_VEHICLE_COMMANDS_SOURCE
@@ -144,6 +156,9 @@ SET(PHYSX_VEHICLE_DRIVETRAIN_SOURCE
 	${LL_SOURCE_DIR}/drivetrain/VhDrivetrainFunctions.cpp
 	${LL_SOURCE_DIR}/drivetrain/VhDrivetrainHelpers.cpp
 )
+SET(PHYSX_VEHICLE_LOD_SOURCE
+	${LL_SOURCE_DIR}/lod/VhLodFunctions.cpp
+)
 SET(PHYSX_VEHICLE_PHYSXACTOR_SOURCE
 	${LL_SOURCE_DIR}/physxActor/VhPhysXActorFunctions.cpp
 	${LL_SOURCE_DIR}/physxActor/VhPhysXActorHelpers.cpp
@@ -182,9 +197,11 @@ SET(PHYSX_VEHICLE_PVD_SOURCE
 	${LL_SOURCE_DIR}/pvd/VhPvdWriter.h
 )
 
+SOURCE_GROUP(src FILES ${PHYSX_VEHICLE_SOURCE})
 SOURCE_GROUP(src\\braking FILES ${PHYSX_VEHICLE_BRAKING_SOURCE})
 SOURCE_GROUP(src\\commands FILES ${PHYSX_VEHICLE_COMMANDS_SOURCE})
 SOURCE_GROUP(src\\drivetrain FILES ${PHYSX_VEHICLE_DRIVETRAIN_SOURCE})
+SOURCE_GROUP(src\\lod FILES ${PHYSX_VEHICLE_LOD_SOURCE})
 SOURCE_GROUP(src\\physxActor FILES ${PHYSX_VEHICLE_PHYSXACTOR_SOURCE})
 SOURCE_GROUP(src\\physxConstraints FILES ${PHYSX_VEHICLE_PHYSXCONSTRAINT_SOURCE})
 SOURCE_GROUP(src\\physxRoadGeometry FILES ${PHYSX_VEHICLE_PHYSXROADGEOMETRY_SOURCE})
@@ -196,9 +213,11 @@ SOURCE_GROUP(src\\wheel FILES ${PHYSX_VEHICLE_WHEEL_SOURCE})
 SOURCE_GROUP(src\\pvd FILES ${PHYSX_VEHICLE_PVD_SOURCE})
 
 ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE_LIBTYPE}
+	${PHYSX_VEHICLE_SOURCE}
 	${PHYSX_VEHICLE_BRAKING_SOURCE}
 	${PHYSX_VEHICLE_COMMANDS_SOURCE}
 	${PHYSX_VEHICLE_DRIVETRAIN_SOURCE}
+	${PHYSX_VEHICLE_LOD_SOURCE}
 	${PHYSX_VEHICLE_PHYSXACTOR_SOURCE}
 	${PHYSX_VEHICLE_PHYSXCONSTRAINT_SOURCE}
 	${PHYSX_VEHICLE_PHYSXROADGEOMETRY_SOURCE}
@@ -212,6 +231,7 @@ ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE_LIBTYPE}
 	${PHYSX_VEHICLE_BRAKING_HEADERS}
 	${PHYSX_VEHICLE_COMMAND_HEADERS}
 	${PHYSX_VEHICLE_DRIVETRAIN_HEADERS}
+	${PHYSX_VEHICLE_LOD_HEADERS}
 	${PHYSX_VEHICLE_PHYSXACTOR_HEADERS}
 	${PHYSX_VEHICLE_PHYSXCONSTRAINT_HEADERS}
 	${PHYSX_VEHICLE_PHYSXROADGEOMETRY_HEADERS}
@@ -228,6 +248,7 @@ INSTALL(FILES ${PHYSX_VEHICLE_HEADERS} DESTINATION include/vehicle2)
 INSTALL(FILES ${PHYSX_VEHICLE_BRAKING_HEADERS} DESTINATION include/vehicle2/braking)
 INSTALL(FILES ${PHYSX_VEHICLE_COMMAND_HEADERS} DESTINATION include/vehicle2/commands)
 INSTALL(FILES ${PHYSX_VEHICLE_DRIVETRAIN_HEADERS} DESTINATION include/vehicle2/drivetrain)
+INSTALL(FILES ${PHYSX_VEHICLE_LOD_HEADERS} DESTINATION include/vehicle2/lod)
 INSTALL(FILES ${PHYSX_VEHICLE_PHYSXACTOR_HEADERS} DESTINATION include/vehicle2/physxActor)
 INSTALL(FILES ${PHYSX_VEHICLE_PHYSXCONSTRAINT_HEADERS} DESTINATION include/vehicle2/physxConstraints)
 INSTALL(FILES ${PHYSX_VEHICLE_PHYSXROADGEOMETRY_HEADERS} DESTINATION include/vehicle2/physxRoadGeometry)
@@ -284,6 +305,7 @@ IF(PX_GENERATE_SOURCE_DISTRO)
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_BRAKING_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_COMMAND_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_DRIVETRAIN_HEADERS})
+	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_LOD_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_PHYSXACTOR_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_PHYSXCONSTRAINT_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_PHYSXROADGEOMETRY_HEADERS})
@@ -294,9 +316,11 @@ IF(PX_GENERATE_SOURCE_DISTRO)
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_TIRE_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_WHEEL_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_PVD_HEADERS})
+	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_BRAKING_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_COMMANDS_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_DRIVETRAIN_SOURCE})
+	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_LOD_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_PHYSXACTOR_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_PHYSXCONSTRAINT_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE_PHYSXROADGEOMETRY_SOURCE})
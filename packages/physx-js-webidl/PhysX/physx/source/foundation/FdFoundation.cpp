@@ -31,6 +31,7 @@
 #include "foundation/PxPhysicsVersion.h"
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxBroadcast.h"
+#include "foundation/PxThread.h"
 
 namespace physx
 {
@@ -77,6 +78,8 @@ class PX_FOUNDATION_API Foundation : public PxFoundation, public PxUserAllocated
 
 	AllocFreeTable mTempAllocFreeTable;
 	Mutex mTempAllocMutex;
+	PxU32 mTempAllocTlsIndex;								// per-thread PxTempAllocatorThreadCache
+	PxTempAllocatorThreadCache* mTempAllocThreadCaches;	// all thread caches, linked, for release. Protected by mTempAllocMutex.
 
 	Mutex mListenerMutex;
 
@@ -108,6 +111,20 @@ Mutex& getTempAllocMutex()
 	return gInstance->mTempAllocMutex;
 }
 
+// PT: not in header so that people don't use it, only for temp allocator, will be removed
+PxU32 getTempAllocTlsIndex()
+{
+	PX_ASSERT(gInstance);
+	return gInstance->mTempAllocTlsIndex;
+}
+
+// PT: not in header so that people don't use it, only for temp allocator, will be removed
+PxTempAllocatorThreadCache*& getTempAllocThreadCaches()
+{
+	PX_ASSERT(gInstance);
+	return gInstance->mTempAllocThreadCaches;
+}
+
 Foundation::Foundation(PxErrorCallback& errc, PxAllocatorCallback& alloc) :
 	mAllocatorCallback		(alloc),
 	mErrorCallback			(errc),
@@ -121,15 +138,18 @@ Foundation::Foundation(PxErrorCallback& errc, PxAllocatorCallback& alloc) :
     mErrorMask				(PxErrorCode::Enum(~0)),
 	mErrorMutex				("Foundation::mErrorMutex"),
 	mTempAllocMutex			("Foundation::mTempAllocMutex"),
+	mTempAllocTlsIndex		(PxTlsAlloc()),
+	mTempAllocThreadCaches	(NULL),
 	mRefCount				(0)
 {
 }
 
-void deallocateTempBufferAllocations(AllocFreeTable& mTempAllocFreeTable);
+void deallocateTempBufferAllocations(AllocFreeTable& mTempAllocFreeTable, PxTempAllocatorThreadCache*& threadCaches);
 
 Foundation::~Foundation()
 {
-	deallocateTempBufferAllocations(mTempAllocFreeTable);
+	deallocateTempBufferAllocations(mTempAllocFreeTable, mTempAllocThreadCaches);
+	PxTlsFree(mTempAllocTlsIndex);
 }
 
 bool Foundation::error(PxErrorCode::Enum c, const char* file, int line, const char* messageFmt, ...)
@@ -36,6 +36,7 @@
 namespace physx
 {
 	union PxTempAllocatorChunk;
+	struct PxTempAllocatorThreadCache;
 
 	typedef PxMutexT<PxAllocator> Mutex;
 	typedef PxArray<PxTempAllocatorChunk*, PxAllocator> AllocFreeTable;
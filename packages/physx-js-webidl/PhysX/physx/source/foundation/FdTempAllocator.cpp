@@ -33,6 +33,7 @@
 #include "foundation/PxMutex.h"
 #include "foundation/PxAtomic.h"
 #include "foundation/PxTempAllocator.h"
+#include "foundation/PxThread.h"
 
 #include "FdFoundation.h"
 
@@ -42,6 +43,8 @@
 
 physx::AllocFreeTable& getTempAllocFreeTable();
 physx::Mutex& getTempAllocMutex();
+physx::PxU32 getTempAllocTlsIndex();
+physx::PxTempAllocatorThreadCache*& getTempAllocThreadCaches();
 
 namespace physx
 {
@@ -57,6 +60,36 @@ typedef PxTempAllocatorChunk Chunk;
 
 const PxU32 sMinIndex = 8;  // 256B min
 const PxU32 sMaxIndex = 17; // 128kB max
+const PxU32 sMaxThreadCachedChunks = 4;	// per size class
+}
+
+// PT: per-thread free lists in front of the shared one, so that threads recycling their own temp buffers don't take
+// the mutex. Chunks are interchangeable, so a chunk freed by another thread than the one that allocated it simply
+// goes to the freeing thread's cache.
+struct PxTempAllocatorThreadCache
+{
+	Chunk*						mFreeLists[sMaxIndex - sMinIndex];
+	PxU32						mNbFree[sMaxIndex - sMinIndex];
+	PxTempAllocatorThreadCache*	mNext;	// linked list of all thread caches, for release
+};
+
+static PxTempAllocatorThreadCache* getThreadCache()
+{
+	const PxU32 tlsIndex = getTempAllocTlsIndex();
+	PxTempAllocatorThreadCache* cache = reinterpret_cast<PxTempAllocatorThreadCache*>(PxTlsGet(tlsIndex));
+	if(!cache)
+	{
+		cache = reinterpret_cast<PxTempAllocatorThreadCache*>(PxAllocator().allocate(sizeof(PxTempAllocatorThreadCache), PX_FL));
+		PxMemZero(cache, sizeof(PxTempAllocatorThreadCache));
+		{
+			Mutex::ScopedLock lock(getTempAllocMutex());
+			PxTempAllocatorThreadCache*& caches = getTempAllocThreadCaches();
+			cache->mNext = caches;
+			caches = cache;
+		}
+		PxTlsSet(tlsIndex, cache);
+	}
+	return cache;
 }
 
 void* PxTempAllocator::allocate(size_t size, const char* filename, PxI32 line)
@@ -69,6 +102,27 @@ void* PxTempAllocator::allocate(size_t size, const char* filename, PxI32 line)
 	Chunk* chunk = 0;
 	if(index < sMaxIndex)
 	{
+		// PT: try the thread cache first, with the same "up to 4x bigger" rule as the shared free lists below
+		PxTempAllocatorThreadCache* cache = getThreadCache();
+		{
+			Chunk** it = cache->mFreeLists + index - sMinIndex;
+			Chunk** end = PxMin(it + 3, cache->mFreeLists + sMaxIndex - sMinIndex);
+			while(it < end && !(*it))
+				++it;
+
+			if(it < end)
+			{
+				chunk = *it;
+				*it = chunk->mNext;
+				const PxU32 cacheIndex = PxU32(it - cache->mFreeLists);
+				cache->mNbFree[cacheIndex]--;
+				chunk->mIndex = cacheIndex + sMinIndex;
+				void* ret = chunk + 1;
+				PX_ASSERT((size_t(ret) & 0xf) == 0);
+				return ret;
+			}
+		}
+
 		Mutex::ScopedLock lock(getTempAllocMutex());
 
 		// find chunk up to 16x bigger than necessary
@@ -112,10 +166,19 @@ void PxTempAllocator::deallocate(void* ptr)
 	if(index >= sMaxIndex)
 		return PxAllocator().deallocate(chunk);
 
-	Mutex::ScopedLock lock(getTempAllocMutex());
-
 	index -= sMinIndex;
 
+	PxTempAllocatorThreadCache* cache = getThreadCache();
+	if(cache->mNbFree[index] < sMaxThreadCachedChunks)
+	{
+		chunk->mNext = cache->mFreeLists[index];
+		cache->mFreeLists[index] = chunk;
+		cache->mNbFree[index]++;
+		return;
+	}
+
+	Mutex::ScopedLock lock(getTempAllocMutex());
+
 	AllocFreeTable& freeTable = getTempAllocFreeTable();
 
 	if(freeTable.size() <= index)
@@ -129,7 +192,7 @@ void PxTempAllocator::deallocate(void* ptr)
 
 using namespace physx;
 
-void deallocateTempBufferAllocations(AllocFreeTable& mTempAllocFreeTable)
+void deallocateTempBufferAllocations(AllocFreeTable& mTempAllocFreeTable, PxTempAllocatorThreadCache*& threadCaches)
 {
 	PxAllocator alloc;
 	for(PxU32 i = 0; i < mTempAllocFreeTable.size(); ++i)
@@ -142,4 +205,22 @@ void deallocateTempBufferAllocations(AllocFreeTable& mTempAllocFreeTable)
 		}
 	}
 	mTempAllocFreeTable.reset();
+
+	// PT: the TLS slot is released by the caller, so the threads' pointers to their caches go away with it
+	for(PxTempAllocatorThreadCache* cache = threadCaches; cache;)
+	{
+		for(PxU32 i = 0; i < sMaxIndex - sMinIndex; ++i)
+		{
+			for(PxTempAllocatorChunk* ptr = cache->mFreeLists[i]; ptr;)
+			{
+				PxTempAllocatorChunk* next = ptr->mNext;
+				alloc.deallocate(ptr);
+				ptr = next;
+			}
+		}
+		PxTempAllocatorThreadCache* next = cache->mNext;
+		alloc.deallocate(cache);
+		cache = next;
+	}
+	threadCaches = NULL;
 }
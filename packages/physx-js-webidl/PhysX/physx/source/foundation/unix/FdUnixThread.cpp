@@ -44,6 +44,10 @@
 #include <sys/resource.h>
 #endif
 
+#if PX_EMSCRIPTEN && defined(__EMSCRIPTEN_PTHREADS__)
+#include <emscripten/threading.h>
+#endif
+
 #if PX_APPLE_FAMILY
 #include <sys/types.h>
 #include <sys/sysctl.h>
@@ -267,7 +271,9 @@ void PxThreadImpl::yield()
 
 void PxThreadImpl::yieldProcessor()
 {
-#if (PX_ARM || PX_A64)
+#if PX_EMSCRIPTEN
+	// there is no pause instruction in WebAssembly
+#elif (PX_ARM || PX_A64)
 	__asm__ __volatile__("yield");
 #else
 	__asm__ __volatile__("pause");
@@ -385,7 +391,14 @@ PxThreadPriority::Enum PxThreadImpl::getPriority(Id pthread)
 
 uint32_t PxThreadImpl::getNbPhysicalCores()
 {
-#if PX_APPLE_FAMILY
+#if PX_EMSCRIPTEN
+#if defined(__EMSCRIPTEN_PTHREADS__)
+	// navigator.hardwareConcurrency in browsers, os.cpus().length in Node.js
+	return uint32_t(emscripten_num_logical_cores());
+#else
+	return 1;
+#endif
+#elif PX_APPLE_FAMILY
 	int count;
 	size_t size = sizeof(count);
 	return sysctlbyname("hw.physicalcpu", &count, &size, NULL, 0) ? 0 : count;
@@ -71,6 +71,31 @@ namespace Gu
 		return bounds;
 	}
 
+	// PT: batched version of computeBounds(), for shapes whose world bounds are a transformed local box (boxes, non-tight
+	// convex & triangle meshes, heightfields). The bounds are computed 4 at a time in flush(), and written directly to
+	// the target array. Unsupported geometries are rejected by add(), the caller should then use computeBounds().
+	// Results are the same as computeBounds() with contactOffset=0 and inflation=1.
+	class BoundsBatch
+	{
+		public:
+		static const PxU32	MaxEntries = 32;
+
+		PX_FORCE_INLINE		BoundsBatch(PxBounds3* bounds) : mBounds(bounds), mNb(0)	{}
+		PX_FORCE_INLINE		~BoundsBatch()												{ PX_ASSERT(!mNb);	}
+
+		PX_PHYSX_COMMON_API	bool	add(PxU32 index, const PxGeometry& geometry, const PxTransform& pose);
+		PX_PHYSX_COMMON_API	void	flush();
+
+		private:
+		PxBounds3*			mBounds;
+		PxU32				mNb;
+		PxU32				mIndices[MaxEntries];
+		PX_ALIGN(16, PxVec4	mRotations[MaxEntries]);
+		PX_ALIGN(16, PxVec4	mPositions[MaxEntries]);
+		PX_ALIGN(16, PxVec4	mCenters[MaxEntries]);	// PT: local-space center, scaled
+		PX_ALIGN(16, PxVec4	mExtents[MaxEntries]);	// PT: local-space extents, scaled
+	};
+
 	void computeGlobalBox(PxBounds3& bounds, PxU32 nbPrims, const PxBounds3* PX_RESTRICT boxes, const PxU32* PX_RESTRICT primitives);
 
 	PX_PHYSX_COMMON_API void computeBoundsAroundVertices(PxBounds3& bounds, PxU32 nbVerts, const PxVec3* PX_RESTRICT verts);
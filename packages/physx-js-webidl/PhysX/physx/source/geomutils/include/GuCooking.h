@@ -97,6 +97,9 @@ namespace physx
 			return createHeightField(desc, *getInsertionCallback());
 		}
 
+		PX_C_EXPORT PX_PHYSX_COMMON_API	bool cookHeightFieldFromRaster(const PxHeightFieldRasterDesc& desc, PxOutputStream& stream);
+		PX_C_EXPORT PX_PHYSX_COMMON_API	PxHeightField* createHeightFieldFromRaster(const PxHeightFieldRasterDesc& desc, PxInsertionCallback& insertionCallback);
+
 		// Convex meshes
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition=NULL);
 		PX_C_EXPORT PX_PHYSX_COMMON_API	PxConvexMesh* createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition=NULL);
@@ -106,6 +109,10 @@ namespace physx
 			return createConvexMesh(params, desc, *getInsertionCallback());
 		}
 
+		PX_C_EXPORT PX_PHYSX_COMMON_API	PxU32 createConvexMeshes(const PxCookingParams& params, const PxConvexMeshDesc* descs, PxU32 nbDescs, PxConvexMesh** meshes, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* conditions=NULL);
+
+		PX_C_EXPORT PX_PHYSX_COMMON_API	PxU32 createConvexDecomposition(const PxCookingParams& params, const PxSimpleTriangleMesh& mesh, const PxConvexDecompositionParams& decompositionParams, PxConvexMesh** hulls, PxInsertionCallback& insertionCallback);
+
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool validateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc);
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool computeHullPolygons(const PxCookingParams& params, const PxSimpleTriangleMesh& mesh, PxAllocatorCallback& inCallback, PxU32& nbVerts, PxVec3*& vertices,
 																PxU32& nbIndices, PxU32*& indices, PxU32& nbPolygons, PxHullPolygon*& hullPolygons);
@@ -40,7 +40,7 @@ namespace Gu
 	class Pruner;
 
 	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createBucketPruner(PxU64 contextID);
-	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createAABBPruner(PxU64 contextID, bool dynamic, Gu::CompanionPrunerType type, Gu::BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode);
+	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createAABBPruner(PxU64 contextID, bool dynamic, Gu::CompanionPrunerType type, Gu::BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode, float rebuildCostThreshold=0.0f, bool quantizedStaticTree=false);
 	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createIncrementalPruner(PxU64 contextID);
 }
 }
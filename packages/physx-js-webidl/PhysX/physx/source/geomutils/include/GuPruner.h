@@ -31,6 +31,7 @@
 
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxTransform.h"
+#include "foundation/PxVec4.h"
 #include "GuPrunerPayload.h"
 #include "GuPrunerTypedef.h"
 
@@ -38,25 +39,61 @@ namespace physx
 {
 	class PxRenderOutput;
 	class PxBounds3;
+	class PxPlane;
 
 namespace Gu
 {
 	class ShapeData;
 
+	// PT: optional per-query traversal counters. Pruners fill them when the query callback's mStats pointer is not NULL.
+	struct PrunerQueryStats
+	{
+		PX_FORCE_INLINE	PrunerQueryStats() : mNbNodes(0), mNbLeaves(0), mNbPrims(0), mNbTests(0)	{}
+
+		PxU32	mNbNodes;	// Tree nodes tested against the query volume
+		PxU32	mNbLeaves;	// Leaf nodes reached
+		PxU32	mNbPrims;	// Primitives contained in the reached leaves
+		PxU32	mNbTests;	// Narrow-phase tests. Not touched by pruners, this one is for the callbacks themselves.
+	};
+
 	struct PrunerRaycastCallback
 	{
-						PrunerRaycastCallback()		{}
-		virtual			~PrunerRaycastCallback()	{}
+						PrunerRaycastCallback() : mStats(NULL)	{}
+		virtual			~PrunerRaycastCallback()				{}
 
 		virtual bool	invoke(PxReal& distance, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms) = 0;
+
+		PrunerQueryStats*	mStats;
 	};
 
 	struct PrunerOverlapCallback
 	{
-						PrunerOverlapCallback()		{}
-		virtual			~PrunerOverlapCallback()	{}
+						PrunerOverlapCallback() : mStats(NULL)	{}
+		virtual			~PrunerOverlapCallback()				{}
 
 		virtual bool	invoke(PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms) = 0;
+
+		PrunerQueryStats*	mStats;
+	};
+
+	struct BVHNode;
+
+	// PT: set of query spheres for Pruner::overlapSpheres(). The spheres are organized in a small BVH built over their bounds,
+	// so that pruners can run a single dual-tree traversal for the whole set instead of one traversal per sphere.
+	struct PrunerSphereBatch
+	{
+		const PxVec4*	mSpheres;	// Center in xyz, radius in w
+		const BVHNode*	mNodes;		// BVH built over the spheres' bounds
+		const PxU32*	mIndices;	// BVH remap table, or NULL for a BVH with one sphere per leaf
+		PxU32			mNbSpheres;
+	};
+
+	struct PrunerBatchOverlapCallback
+	{
+						PrunerBatchOverlapCallback()	{}
+		virtual			~PrunerBatchOverlapCallback()	{}
+
+		virtual bool	invoke(PxU32 queryIndex, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms) = 0;
 	};
 
 	class BasePruner : public PxUserAllocated
@@ -156,6 +193,29 @@ namespace Gu
 		virtual	bool					overlap(const Gu::ShapeData& queryVolume, PrunerOverlapCallback&) const = 0;
 		virtual	bool					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&) const = 0;
 
+		/**
+		\brief	Culling query against a convex volume.
+
+		Reports all objects whose bounds are not fully outside the volume. This is a conservative test done against
+		the pruner bounds only, and parts of the accel structure fully inside the volume are reported without further
+		per-object tests.
+
+		\param[in]	nbPlanes	Number of planes, between 1 and 32
+		\param[in]	planes		Planes defining the volume. Normals point outward.
+		*/
+		virtual	bool					cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback&) const = 0;
+
+		/**
+		\brief	Batched overlap query against a set of spheres.
+
+		Reports all (sphere, object) pairs whose bounds overlap. This is equivalent to one sphere overlap() per query,
+		but implementations can traverse their accel structure once for the whole batch. Pairs are reported in no
+		particular order.
+
+		\param[in]	spheres		The query spheres and their BVH
+		*/
+		virtual	bool					overlapSpheres(const PrunerSphereBatch& spheres, PrunerBatchOverlapCallback&) const = 0;
+
 		/**
 		\brief	Retrieves the object's payload and data associated with the handle.
 
@@ -177,6 +237,11 @@ namespace Gu
 		*/
 		virtual void					preallocate(PxU32 nbEntries) = 0;
 
+		/**
+		\brief	Releases memory not needed by the current set of objects, e.g. after many objects have been removed.
+		*/
+		virtual void					shrinkMemory() = 0;
+
 		/**
 		\brief	Sets object's transform
 
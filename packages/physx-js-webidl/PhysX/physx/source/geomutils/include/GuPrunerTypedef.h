@@ -49,7 +49,8 @@ namespace physx
 			COMPANION_PRUNER_NONE,
 			COMPANION_PRUNER_BUCKET,
 			COMPANION_PRUNER_INCREMENTAL,
-			COMPANION_PRUNER_AABB_TREE
+			COMPANION_PRUNER_AABB_TREE,
+			COMPANION_PRUNER_GRID
 		};
 
 		enum BVHBuildStrategy
@@ -131,6 +131,7 @@ namespace Gu
 
 		PX_PHYSX_COMMON_API	void					flushMemory();
 
+		// PT: set the callback's mStats pointer to gather traversal counters over all the pruners visited by a query
 		PX_PHYSX_COMMON_API	void					raycast(const PxVec3& origin, const PxVec3& unitDir, float& inOutDistance, PrunerRaycastCallback& cb, const PrunerFilter* prunerFilter)			const;
 		PX_PHYSX_COMMON_API	void					overlap(const ShapeData& queryVolume, PrunerOverlapCallback& cb, const PrunerFilter* prunerFilter)												const;
 		PX_PHYSX_COMMON_API	void					sweep(const ShapeData& queryVolume, const PxVec3& unitDir, float& inOutDistance, PrunerRaycastCallback& cb, const PrunerFilter* prunerFilter)	const;
@@ -242,6 +243,9 @@ namespace Gu
 			if(!shapeGeom)
 				return true;
 
+			if(mStats)
+				mStats->mNbTests++;
+
 			const RaycastFunc func = mCachedRaycastFuncs[shapeGeom->getType()];
 			const PxU32 nbHits = func(*shapeGeom, transforms[primIndex], mOrigin, mDir, aDist, filteredHitFlags, mMaxLocalHits, mLocalHits, sizeof(PxGeomRaycastHit), mContext);
 			if(!nbHits || !reportHits(payload, nbHits, mLocalHits))
@@ -310,7 +314,13 @@ namespace Gu
 			const PrunerPayload& payload = payloads[primIndex];
 
 			const PxGeometry* shapeGeom = mFilterCB.validatePayload(payload, mUnused);
-			if(!shapeGeom || !Gu::overlap(mGeometry, mPose, *shapeGeom, transforms[primIndex], mCachedFuncs, mContext))
+			if(!shapeGeom)
+				return true;
+
+			if(mStats)
+				mStats->mNbTests++;
+
+			if(!Gu::overlap(mGeometry, mPose, *shapeGeom, transforms[primIndex], mCachedFuncs, mContext))
 				return true;
 
 			return reportHit(payload);
@@ -428,6 +438,9 @@ namespace Gu
 			if(!shapeGeom)
 				return true;
 
+			if(mStats)
+				mStats->mNbTests++;
+
 			// PT: ### TODO: missing bit from PhysX version here
 
 			const float inflation = 0.0f;	// ####
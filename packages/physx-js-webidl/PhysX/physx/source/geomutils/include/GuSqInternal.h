@@ -47,6 +47,7 @@ namespace physx
 	{
 		class BVH;
 		class AABBTree;
+		class QuantizedAABBTree;
 		class IncrementalAABBTree;
 		class IncrementalAABBTreeNode;
 	}
@@ -62,6 +63,7 @@ namespace physx
 
 	PX_PHYSX_COMMON_API	void visualizeTree(physx::PxRenderOutput& out, physx::PxU32 color, const physx::Gu::BVH* tree);
 	PX_PHYSX_COMMON_API	void visualizeTree(physx::PxRenderOutput& out, physx::PxU32 color, const physx::Gu::AABBTree* tree);
+	PX_PHYSX_COMMON_API	void visualizeTree(physx::PxRenderOutput& out, physx::PxU32 color, const physx::Gu::QuantizedAABBTree* tree);
 	PX_PHYSX_COMMON_API	void visualizeTree(physx::PxRenderOutput& out, physx::PxU32 color, const physx::Gu::IncrementalAABBTree* tree, physx::DebugVizCallback* cb=NULL);
 
 	// PT: macros to try limiting the code duplication in headers. Mostly it just redefines the
@@ -82,8 +84,11 @@ namespace physx
 	virtual	bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, Gu::PrunerRaycastCallback&)				const;														\
 	virtual	bool					overlap(const Gu::ShapeData& queryVolume, Gu::PrunerOverlapCallback&)												const;														\
 	virtual	bool					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, Gu::PrunerRaycastCallback&)	const;														\
+	virtual	bool					cull(PxU32 nbPlanes, const PxPlane* planes, Gu::PrunerOverlapCallback&)												const;														\
+	virtual	bool					overlapSpheres(const Gu::PrunerSphereBatch& spheres, Gu::PrunerBatchOverlapCallback&)								const;														\
 	virtual	const PrunerPayload&	getPayloadData(PrunerHandle handle, PrunerPayloadData* data)														const	{ return mPool.getPayloadData(handle, data);	}	\
 	virtual	void					preallocate(PxU32 entries)																									{ mPool.preallocate(entries);					}	\
+	virtual	void					shrinkMemory()																												{ mPool.shrinkMemory();							}	\
 	virtual	bool					setTransform(PrunerHandle handle, const PxTransform& transform)																{ return mPool.setTransform(handle, transform);	}	\
 	virtual	void					getGlobalBounds(PxBounds3&)																							const;
 
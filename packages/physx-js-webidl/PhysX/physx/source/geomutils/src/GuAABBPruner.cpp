@@ -49,7 +49,7 @@ using namespace Cm;
 	#define SQ_PRUNER_EPSILON	0.005f
 	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
 
-AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode) :
+AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode, float rebuildCostThreshold, bool quantizedStaticTree) :
 	mAABBTree			(NULL),
 	mNewTree			(NULL),
 	mNbCachedBoxes		(0),
@@ -59,10 +59,14 @@ AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPruner
 	mProgress			(BUILD_NOT_STARTED),
 	mRebuildRateHint	(100),
 	mAdaptiveRebuildTerm(0),
+	mRebuildCostThreshold(rebuildCostThreshold),
+	mBaseCost			(0.0f),
+	mNodeAreaSum		(0.0f),
 	mNbObjectsPerNode	(nbObjectsPerNode),
 	mBuildStrategy		(buildStrategy),
 	mPool				(contextID, TRANSFORM_CACHE_GLOBAL),
 	mIncrementalRebuild	(incrementalRebuild),
+	mQuantizedStaticTree(quantizedStaticTree),
 	mUncommittedChanges	(false),
 	mNeedsNewTree		(false),
 	mNewTreeFixups		("AABBPruner::mNewTreeFixups")
@@ -98,7 +102,8 @@ bool AABBPruner::addObjects(PrunerHandle* results, const PxBounds3* bounds, cons
 	{
 		PX_PROFILE_ZONE("SceneQuery.bucketPrunerAddObjects", mPool.mContextID);
 
-		mNeedsNewTree = true; // each add forces a tree rebuild
+		if(mRebuildCostThreshold==0.0f)
+			mNeedsNewTree = true; // each add forces a tree rebuild
 
 		// if a pruner structure is provided, we dont move the new objects into bucket pruner
 		// the pruning structure will be merged into the bucket pruner
@@ -131,7 +136,8 @@ void AABBPruner::updateObjects(const PrunerHandle* handles, PxU32 count, float i
 
 	if(mIncrementalRebuild && mAABBTree)
 	{
-		mNeedsNewTree = true; // each update forces a tree rebuild
+		if(mRebuildCostThreshold==0.0f)
+			mNeedsNewTree = true; // each update forces a tree rebuild
 		const PxBounds3* currentBounds = mPool.getCurrentWorldBoxes();
 		const PxTransform* currentTransforms = mPool.getTransforms();
 		const PrunerPayload* data = mPool.getObjects();
@@ -174,7 +180,8 @@ void AABBPruner::removeObjects(const PrunerHandle* handles, PxU32 count, PrunerP
 		const PoolIndex poolRelocatedLastIndex = mPool.removeObject(h, removalCallback); // save the lastIndex returned by removeObject
 		if(mIncrementalRebuild && mAABBTree)
 		{
-			mNeedsNewTree = true;
+			if(mRebuildCostThreshold==0.0f)
+				mNeedsNewTree = true;
 
 			const TreeNodeIndex treeNodeIndex = mTreeMap[poolIndex]; // already removed from pool but still in tree map
 			const PrunerPayload swappedData = mPool.getObjects()[poolIndex];
@@ -209,64 +216,71 @@ void AABBPruner::removeObjects(const PrunerHandle* handles, PxU32 count, PrunerP
 	}
 }
 
-bool AABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pcbArgName) const
+// PT: shared by the regular and the quantized trees
+template<typename Tree, typename Node>
+static bool overlapTree(const AABBTreeBounds& bounds, const Tree& tree, const ShapeData& queryVolume, OverlapCallbackAdapter& pcb)
 {
-	PX_ASSERT(!mUncommittedChanges);
-
-	bool again = true;
-
-	if(mAABBTree)
+	switch(queryVolume.getType())
 	{
-		OverlapCallbackAdapter pcb(pcbArgName, mPool);
-
-		switch(queryVolume.getType())
+		case PxGeometryType::eBOX:
 		{
-			case PxGeometryType::eBOX:
-			{
-				if(queryVolume.isOBB())
-				{	
-					const DefaultOBBAABBTest test(queryVolume);
-					again = AABBTreeOverlap<true, OBBAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
-				}
-				else
-				{
-					const DefaultAABBAABBTest test(queryVolume);
-					again = AABBTreeOverlap<true, AABBAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
-				}
+			if(queryVolume.isOBB())
+			{	
+				const DefaultOBBAABBTest test(queryVolume);
+				return AABBTreeOverlap<true, OBBAABBTest, Tree, Node, OverlapCallbackAdapter>()(bounds, tree, test, pcb);
 			}
-			break;
-
-			case PxGeometryType::eCAPSULE:
+			else
 			{
-				const DefaultCapsuleAABBTest test(queryVolume, SQ_PRUNER_INFLATION);
-				again = AABBTreeOverlap<true, CapsuleAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+				const DefaultAABBAABBTest test(queryVolume);
+				return AABBTreeOverlap<true, AABBAABBTest, Tree, Node, OverlapCallbackAdapter>()(bounds, tree, test, pcb);
 			}
-			break;
+		}
 
-			case PxGeometryType::eSPHERE:
-			{
-				const DefaultSphereAABBTest test(queryVolume);
-				again = AABBTreeOverlap<true, SphereAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
-			}
-			break;
+		case PxGeometryType::eCAPSULE:
+		{
+			const DefaultCapsuleAABBTest test(queryVolume, SQ_PRUNER_INFLATION);
+			return AABBTreeOverlap<true, CapsuleAABBTest, Tree, Node, OverlapCallbackAdapter>()(bounds, tree, test, pcb);
+		}
 
-			case PxGeometryType::eCONVEXCORE:
-			{
-				const DefaultOBBAABBTest test(queryVolume);
-				again = AABBTreeOverlap<true, OBBAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
-			}
-			break;
+		case PxGeometryType::eSPHERE:
+		{
+			const DefaultSphereAABBTest test(queryVolume);
+			return AABBTreeOverlap<true, SphereAABBTest, Tree, Node, OverlapCallbackAdapter>()(bounds, tree, test, pcb);
+		}
 
-			case PxGeometryType::eCONVEXMESH:
-			{
-				const DefaultOBBAABBTest test(queryVolume);
-				again = AABBTreeOverlap<true, OBBAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
-			}
-			break;
+		case PxGeometryType::eCONVEXCORE:
+		{
+			const DefaultOBBAABBTest test(queryVolume);
+			return AABBTreeOverlap<true, OBBAABBTest, Tree, Node, OverlapCallbackAdapter>()(bounds, tree, test, pcb);
+		}
+
+		case PxGeometryType::eCONVEXMESH:
+		{
+			const DefaultOBBAABBTest test(queryVolume);
+			return AABBTreeOverlap<true, OBBAABBTest, Tree, Node, OverlapCallbackAdapter>()(bounds, tree, test, pcb);
+		}
 
 		default:
 			PX_ALWAYS_ASSERT_MESSAGE("unsupported overlap query volume geometry type");
-		}
+	}
+	return true;
+}
+
+bool AABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pcbArgName) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+
+	bool again = true;
+
+	if(mAABBTree)
+	{
+		OverlapCallbackAdapter pcb(pcbArgName, mPool);
+		again = overlapTree<AABBTree, BVHNode>(mPool.getCurrentAABBTreeBounds(), *mAABBTree, queryVolume, pcb);
+	}
+	else if(mQuantizedTree.getNbNodes())
+	{
+		OverlapCallbackAdapter pcb(pcbArgName, mPool);
+		again = overlapTree<QuantizedAABBTree, BVHNodeQ>(mPool.getCurrentAABBTreeBounds(), mQuantizedTree, queryVolume, pcb);
 	}
 
 	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
@@ -287,6 +301,12 @@ bool AABBPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxRe
 		const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
 		again = AABBTreeRaycast<true, true, AABBTree, BVHNode, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, aabb.getCenter(), unitDir, inOutDistance, aabb.getExtents(), pcb);
 	}
+	else if(mQuantizedTree.getNbNodes())
+	{
+		RaycastCallbackAdapter pcb(pcbArgName, mPool);
+		const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
+		again = AABBTreeRaycast<true, true, QuantizedAABBTree, BVHNodeQ, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), mQuantizedTree, aabb.getCenter(), unitDir, inOutDistance, aabb.getExtents(), pcb);
+	}
 
 	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
 		again = mBucketPruner.sweep(queryVolume, unitDir, inOutDistance, pcbArgName);
@@ -305,6 +325,11 @@ bool AABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& in
 		RaycastCallbackAdapter pcb(pcbArgName, mPool);
 		again = AABBTreeRaycast<false, true, AABBTree, BVHNode, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
 	}
+	else if(mQuantizedTree.getNbNodes())
+	{
+		RaycastCallbackAdapter pcb(pcbArgName, mPool);
+		again = AABBTreeRaycast<false, true, QuantizedAABBTree, BVHNodeQ, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), mQuantizedTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
+	}
 		
 	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
 		again = mBucketPruner.raycast(origin, unitDir, inOutDistance, pcbArgName);
@@ -312,6 +337,53 @@ bool AABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& in
 	return again;
 }
 
+bool AABBPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcbArgName) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+
+	bool again = true;
+
+	if(mAABBTree)
+	{
+		OverlapCallbackAdapter pcb(pcbArgName, mPool);
+		again = AABBTreeCull<true, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, nbPlanes, planes, pcb);
+	}
+	else if(mQuantizedTree.getNbNodes())
+	{
+		OverlapCallbackAdapter pcb(pcbArgName, mPool);
+		again = AABBTreeCull<true, QuantizedAABBTree, BVHNodeQ, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), mQuantizedTree, nbPlanes, planes, pcb);
+	}
+
+	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
+		again = mBucketPruner.cull(nbPlanes, planes, pcbArgName);
+
+	return again;
+}
+
+bool AABBPruner::overlapSpheres(const PrunerSphereBatch& spheres, PrunerBatchOverlapCallback& pcbArgName) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+
+	bool again = true;
+
+	if(mAABBTree)
+	{
+		BatchOverlapCallbackAdapter pcb(pcbArgName, mPool);
+		again = AABBTreeSpheresOverlap<true, AABBTree, BVHNode, BatchOverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, spheres, pcb);
+	}
+	else if(mQuantizedTree.getNbNodes())
+	{
+		BatchOverlapCallbackAdapter pcb(pcbArgName, mPool);
+		again = AABBTreeSpheresOverlap<true, QuantizedAABBTree, BVHNodeQ, BatchOverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), mQuantizedTree, spheres, pcb);
+	}
+
+	// PT: the bucket pruner only contains the objects added since the last rebuild, so we just query it one sphere at a time
+	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
+		again = overlapSpheresOneByOne(mBucketPruner, spheres, pcbArgName);
+
+	return again;
+}
+
 // This isn't part of the pruner virtual interface, but it is part of the public interface
 // of AABBPruner - it gets called by SqManager to force a rebuild, and requires a commit() before 
 // queries can take place
@@ -347,7 +419,7 @@ void AABBPruner::commit()
 
 	if(!mAABBTree || !mIncrementalRebuild)
 	{
-		if(!mIncrementalRebuild && mAABBTree)
+		if(!mIncrementalRebuild && (mAABBTree || mQuantizedTree.getNbNodes()))
 			PxGetFoundation().error(PxErrorCode::ePERF_WARNING, PX_FL, "SceneQuery static AABB Tree rebuilt, because a shape attached to a static actor was added, removed or moved, and PxSceneQueryDesc::staticStructure is set to eSTATIC_AABB_TREE.");
 
 		fullRebuildAABBTree();
@@ -371,6 +443,9 @@ void AABBPruner::commit()
 		// Calling refit because the second tree is not ready to be swapped in (mProgress != BUILD_FINISHED)
 		// Generally speaking as long as things keep moving the second build will never catch up with true state
 		refitUpdatedAndRemoved();
+
+		if(mRebuildCostThreshold!=0.0f && mProgress==BUILD_NOT_STARTED)
+			updateRebuildTrigger();
 	}
 	else
 	{
@@ -448,7 +523,10 @@ void AABBPruner::commit()
 			PxU32 nbRemovedPairs = mBucketPruner.removeMarkedObjects(mTimeStamp-1);
 			PX_UNUSED(nbRemovedPairs);
 
-			mNeedsNewTree = mBucketPruner.getNbObjects()>0;
+			if(mRebuildCostThreshold==0.0f)
+				mNeedsNewTree = mBucketPruner.getNbObjects()>0;
+			else
+				resetRebuildCost();
 		}
 	}
 
@@ -462,6 +540,9 @@ void AABBPruner::shiftOrigin(const PxVec3& shift)
 	if(mAABBTree)
 		mAABBTree->shiftOrigin(shift);
 
+	if(mQuantizedTree.getNbNodes())
+		mQuantizedTree.shiftOrigin(shift);
+
 	if(mIncrementalRebuild)
 		mBucketPruner.shiftOrigin(shift);
 
@@ -473,6 +554,7 @@ void AABBPruner::visualize(PxRenderOutput& out, PxU32 primaryColor, PxU32 second
 {
 	// getAABBTree() asserts when pruner is dirty. NpScene::visualization() does not enforce flushUpdate. see DE7834
 	visualizeTree(out, primaryColor, mAABBTree);
+	visualizeTree(out, primaryColor, &mQuantizedTree);
 
 	// Render added objects not yet in the tree
 	out << PxTransform(PxIdentity);
@@ -659,6 +741,7 @@ bool AABBPruner::fullRebuildAABBTree()
 
 	// Release possibly already existing tree
 	PX_DELETE(mAABBTree);
+	mQuantizedTree.release();
 
 	// Don't bother building an AABB-tree if there isn't a single static object
 	const PxU32 nbObjects = mPool.getNbActiveObjects();
@@ -673,9 +756,21 @@ bool AABBPruner::fullRebuildAABBTree()
 		Status = mAABBTree->build(AABBTreeBuildParams(mNbObjectsPerNode, nbObjects, &mPool.getCurrentAABBTreeBounds(), mBuildStrategy), mNodeAllocator);
 	}
 
+	// PT: the static tree is never refit, since any change triggers a full rebuild. So when requested we can keep a
+	// quantized copy only. Later merges of pruning structures also go through a full rebuild then, since they need
+	// the float tree.
+	if(Status && mQuantizedStaticTree && !mIncrementalRebuild)
+	{
+		Status = mQuantizedTree.init(*mAABBTree);
+		PX_DELETE(mAABBTree);
+	}
+
 	// No need for the tree map for static pruner
 	if(mIncrementalRebuild)
+	{
 		mTreeMap.initMap(PxMax(nbObjects, mNbCachedBoxes), *mAABBTree);
+		resetRebuildCost();
+	}
 
 	return Status;
 }
@@ -703,6 +798,7 @@ void AABBPruner::release() // this can be called from purge()
 	mNodeAllocator.release();
 	PX_DELETE(mNewTree);
 	PX_DELETE(mAABBTree);
+	mQuantizedTree.release();
 
 	mNbCachedBoxes = 0;
 	mProgress = BUILD_NOT_STARTED;
@@ -732,7 +828,53 @@ void AABBPruner::refitUpdatedAndRemoved()
 		return;
 
 	mBucketPruner.refitMarkedNodes(mPool.getCurrentWorldBoxes());
-	tree->refitMarkedNodes(mPool.getCurrentWorldBoxes());
+	tree->refitMarkedNodes(mPool.getCurrentWorldBoxes(), mRebuildCostThreshold!=0.0f ? &mNodeAreaSum : NULL);
+}
+
+static PX_FORCE_INLINE float getRootArea(const AABBTree& tree)
+{
+	const PxBounds3& rootBounds = tree.getNodes()->mBV;
+	const PxVec3 e = rootBounds.maximum - rootBounds.minimum;
+	return e.x*e.y + e.y*e.z + e.z*e.x;
+}
+
+// Records the cost of the tree we just switched to, as a reference to measure its degradation
+void AABBPruner::resetRebuildCost()
+{
+	mNeedsNewTree = false;
+	mNodeAreaSum = 0.0f;
+	mBaseCost = 0.0f;
+	if(!mAABBTree || !mAABBTree->getNbNodes())
+		return;
+
+	mNodeAreaSum = mAABBTree->computeNodeAreaSum();
+
+	const float rootArea = getRootArea(*mAABBTree);
+	mBaseCost = rootArea > 0.0f ? mNodeAreaSum / rootArea : 0.0f;
+}
+
+// Requests a new tree if the current one degraded past the threshold. Called after each refit while no rebuild is running.
+void AABBPruner::updateRebuildTrigger()
+{
+	PX_ASSERT(mRebuildCostThreshold!=0.0f);
+
+	const PxU32 nbAdded = mBucketPruner.getNbObjects();
+	if(!mAABBTree || !mAABBTree->getNbNodes())
+	{
+		mNeedsNewTree = nbAdded!=0;
+		return;
+	}
+
+	// PT: objects added since the tree was built are in the bucket pruner, which is queried in addition to the tree
+	const PxU32 nbTreeObjects = PxMax(mAABBTree->getNbIndices(), 1u);
+	float drift = float(nbAdded) / float(nbTreeObjects);
+
+	const float rootArea = getRootArea(*mAABBTree);
+	if(rootArea > 0.0f && mBaseCost > 0.0f)
+		drift += (mNodeAreaSum / rootArea) / mBaseCost - 1.0f;
+
+	if(drift > mRebuildCostThreshold)
+		mNeedsNewTree = true;
 }
 
 void AABBPruner::merge(const void* mergeParams)
@@ -761,12 +903,38 @@ void AABBPruner::merge(const void* mergeParams)
 			mBucketPruner.addTree(aabbTreeMergeParams, mTimeStamp);
 		}
 	}
+	else if(!mIncrementalRebuild && mPool.getNbActiveObjects() == pruningStructure.mNbObjects)
+	{
+		// PT: the static pruner only contains the objects of the pruning structure, so its tree can be used as-is
+		// instead of doing the full rebuild that addObjects() scheduled. This is the typical case when a precomputed
+		// static world is loaded into an empty scene.
+		const AABBTreeMergeData aabbTreeMergeParams(pruningStructure.mNbNodes, pruningStructure.mAABBTreeNodes,
+			pruningStructure.mNbObjects, pruningStructure.mAABBTreeIndices, 0);
+
+		PX_DELETE(mAABBTree);
+		mQuantizedTree.release();
+
+		mAABBTree = PX_NEW(AABBTree);
+		mAABBTree->initTree(aabbTreeMergeParams);
+
+		if(mQuantizedStaticTree)
+		{
+			const bool status = mQuantizedTree.init(*mAABBTree);
+			PX_DELETE(mAABBTree);
+			if(!status)
+				return;	// PT: keep mUncommittedChanges so that the next commit rebuilds the tree
+		}
+
+		mUncommittedChanges = false;
+	}
 }
 
 void AABBPruner::getGlobalBounds(PxBounds3& bounds) const
 {
 	if(mAABBTree && mAABBTree->getNodes())
 		bounds = mAABBTree->getNodes()->mBV;
+	else if(mQuantizedTree.getNbNodes())
+		mQuantizedTree.getNodeBounds(mQuantizedTree.getNodes(), bounds);
 	else
 		bounds.setEmpty();
 
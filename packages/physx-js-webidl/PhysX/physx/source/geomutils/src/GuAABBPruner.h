@@ -126,7 +126,7 @@ namespace Gu
 	{
 												PX_NOCOPY(AABBPruner)
 		public:
-		PX_PHYSX_COMMON_API						AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy=BVH_SPLATTER_POINTS, PxU32 nbObjectsPerNode=4); // true is equivalent to former dynamic pruner
+		PX_PHYSX_COMMON_API						AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy=BVH_SPLATTER_POINTS, PxU32 nbObjectsPerNode=4, float rebuildCostThreshold=0.0f, bool quantizedStaticTree=false); // true is equivalent to former dynamic pruner
 		virtual									~AABBPruner();
 
 		// BasePruner
@@ -158,6 +158,7 @@ namespace Gu
 						NodeAllocator			mNodeAllocator;
 
 						AABBTree*				mAABBTree; // current active tree
+						QuantizedAABBTree		mQuantizedTree; // replaces mAABBTree for static pruners created with quantizedStaticTree
 						AABBTreeBuildParams		mBuilder; // this class deals with the details of the actual tree building
 						BuildStats				mBuildStats;
 
@@ -198,6 +199,13 @@ namespace Gu
 		// Term to correct the work unit estimate if the rebuild rate is not matched
 						PxI32					mAdaptiveRebuildTerm;
 
+		// Cost-based rebuild trigger. When mRebuildCostThreshold is zero, each change to the pruner requests a new tree.
+		// Otherwise the current tree is only refit until its SAH cost (sum of node areas / root area) has grown by more
+		// than the threshold since it was built, accounting for objects added to the bucket pruner in the meantime.
+			const		float					mRebuildCostThreshold;
+						float					mBaseCost;		// SAH cost of the current tree when it was built
+						float					mNodeAreaSum;	// Current sum of node areas, updated incrementally during refits
+
 			const		PxU32					mNbObjectsPerNode;
 			const		BVHBuildStrategy		mBuildStrategy;
 
@@ -218,6 +226,9 @@ namespace Gu
 		// bucket pruner is only used with incremental rebuild
 				const	bool					mIncrementalRebuild;
 
+		// Static pruner only: the tree is replaced with a QuantizedAABBTree after each rebuild, see mQuantizedTree
+				const	bool					mQuantizedStaticTree;
+
 		// A rebuild can be triggered even when the Pruner is not dirty
 		// mUncommittedChanges is set to true in add, remove, update and buildStep
 		// mUncommittedChanges is set to false in commit
@@ -254,6 +265,8 @@ namespace Gu
 						bool					fullRebuildAABBTree(); // full rebuild function, used with static pruner mode
 						void					release();
 						void					refitUpdatedAndRemoved();
+						void					resetRebuildCost();
+						void					updateRebuildTrigger();
 						void					updateBucketPruner();
 	};
 
@@ -35,6 +35,7 @@
 #include "foundation/PxMathUtils.h"
 #include "foundation/PxFPU.h"
 #include "foundation/PxInlineArray.h"
+#include "foundation/PxAlignedMalloc.h"
 
 using namespace physx;
 using namespace Gu;
@@ -814,10 +815,27 @@ Exit:
 	mRefitHighestSetWord = refitHighestSetWord;
 }
 
+// PT: half surface area, zero for empty nodes (invalidated leaves use inverted bounds)
+static PX_FORCE_INLINE float getNodeArea(const BVHNode& node)
+{
+	const PxVec3 e = node.mBV.maximum - node.mBV.minimum;
+	if(e.x<0.0f || e.y<0.0f || e.z<0.0f)
+		return 0.0f;
+	return e.x*e.y + e.y*e.z + e.z*e.x;
+}
+
+float BVHCoreData::computeNodeAreaSum() const
+{
+	float sum = 0.0f;
+	for(PxU32 i=0; i<mNbNodes; i++)
+		sum += getNodeArea(mNodes[i]);
+	return sum;
+}
+
 #define FIRST_VERSION
 #ifdef FIRST_VERSION
-template<const bool hasIndices>
-static void refitMarkedLoop(const PxBounds3* PX_RESTRICT boxes, BVHNode* const PX_RESTRICT nodeBase, const PxU32* PX_RESTRICT indices, PxU32* PX_RESTRICT bits, PxU32 nbToGo)
+template<const bool hasIndices, const bool trackArea>
+static void refitMarkedLoop(const PxBounds3* PX_RESTRICT boxes, BVHNode* const PX_RESTRICT nodeBase, const PxU32* PX_RESTRICT indices, PxU32* PX_RESTRICT bits, PxU32 nbToGo, float& areaDelta)
 {
 #if PX_DEBUG
 	PxU32 nbRefit=0;
@@ -845,10 +863,14 @@ static void refitMarkedLoop(const PxBounds3* PX_RESTRICT boxes, BVHNode* const P
 			PX_ASSERT(mask==PxU32(1<<(index&31)));
 			if(currentBits & mask)
 			{
+				if(trackArea)
+					areaDelta -= getNodeArea(nodeBase[index]);
 				if(hasIndices)
 					refitNode<1>(nodeBase + index, boxes, indices, nodeBase);
 				else
 					refitNode<0>(nodeBase + index, boxes, indices, nodeBase);
+				if(trackArea)
+					areaDelta += getNodeArea(nodeBase[index]);
 #if PX_DEBUG
 				nbRefit++;
 #endif
@@ -859,7 +881,7 @@ static void refitMarkedLoop(const PxBounds3* PX_RESTRICT boxes, BVHNode* const P
 	}
 }
 
-void BVHPartialRefitData::refitMarkedNodes(const PxBounds3* boxes)
+void BVHPartialRefitData::refitMarkedNodes(const PxBounds3* boxes, float* areaDelta)
 {
 	if(!mRefitBitmask.getBits())
 		return;	// No refit needed
@@ -877,10 +899,22 @@ void BVHPartialRefitData::refitMarkedNodes(const PxBounds3* boxes)
 			}
 		}
 #endif
-		if(mIndices)
-			refitMarkedLoop<1>(boxes, mNodes, mIndices, bits, size);
+		float delta = 0.0f;
+		if(areaDelta)
+		{
+			if(mIndices)
+				refitMarkedLoop<1, 1>(boxes, mNodes, mIndices, bits, size, delta);
+			else
+				refitMarkedLoop<0, 1>(boxes, mNodes, mIndices, bits, size, delta);
+			*areaDelta += delta;
+		}
 		else
-			refitMarkedLoop<0>(boxes, mNodes, mIndices, bits, size);
+		{
+			if(mIndices)
+				refitMarkedLoop<1, 0>(boxes, mNodes, mIndices, bits, size, delta);
+			else
+				refitMarkedLoop<0, 0>(boxes, mNodes, mIndices, bits, size, delta);
+		}
 
 		mRefitHighestSetWord = 0;
 //		mRefitBitmask.clearAll();
@@ -1435,6 +1469,137 @@ void AABBTree::mergeTree(const AABBTreeMergeData& treeParams)
 	mNbIndices += treeParams.mNbIndices;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+QuantizedAABBTree::QuantizedAABBTree() :
+	mOrigin		(0.0f),
+	mQuantum	(0.0f),
+	mNbIndices	(0),
+	mNbNodes	(0),
+	mNodes		(NULL),
+	mIndices	(NULL)
+{
+}
+
+QuantizedAABBTree::~QuantizedAABBTree()
+{
+	release();
+}
+
+void QuantizedAABBTree::release()
+{
+	if(mNodes)
+		PxAlignedAllocator<64>().deallocate(mNodes - 1);
+	mNodes = NULL;
+	PX_FREE(mIndices);
+	mNbNodes = 0;
+	mNbIndices = 0;
+}
+
+// PT: coordinates beyond this are considered unbounded and use the reserved codes
+#define QUANTIZED_UNBOUNDED_LIMIT	(PX_MAX_BOUNDS_EXTENTS * 0.5f)
+
+// PT: valid codes are [1;0xfffe] for minimums and [0;0xfffe] for maximums, and the range is mapped to [2;0xfffd] so that
+// the extra step taken when rounding outward remains available.
+#define QUANTIZED_NB_STEPS	65531.0f
+
+static PX_FORCE_INLINE PxU16 quantizeMin(float v, float origin, float invQuantum)
+{
+	if(v <= -QUANTIZED_UNBOUNDED_LIMIT)
+		return 0;
+	// PT: one extra step absorbs the float error of the decoding
+	const float q = PxFloor((v - origin)*invQuantum) - 1.0f;
+	return PxU16(PxClamp(q, 1.0f, 65534.0f));
+}
+
+static PX_FORCE_INLINE PxU16 quantizeMax(float v, float origin, float invQuantum)
+{
+	if(v >= QUANTIZED_UNBOUNDED_LIMIT)
+		return 0xffff;
+	const float q = PxCeil((v - origin)*invQuantum) + 1.0f;
+	return PxU16(PxClamp(q, 0.0f, 65534.0f));
+}
+
+bool QuantizedAABBTree::init(AABBTree& tree)
+{
+	release();
+
+	const PxU32 nbNodes = tree.getNbNodes();
+	const BVHNode* srcNodes = tree.getNodes();
+	if(!nbNodes || !srcNodes)
+		return false;
+
+	// PT: compute the quantization range from the bounded coordinates only. Both minimums and maximums are included,
+	// since e.g. the bounded maximum of a box with an unbounded minimum can be below all bounded minimums.
+	PxVec3 rangeMin(PX_MAX_F32);
+	PxVec3 rangeMax(-PX_MAX_F32);
+	for(PxU32 i=0;i<nbNodes;i++)
+	{
+		const PxBounds3& bv = srcNodes[i].mBV;
+		for(PxU32 j=0;j<3;j++)
+		{
+			const float values[2] = { bv.minimum[j], bv.maximum[j] };
+			for(PxU32 k=0;k<2;k++)
+			{
+				if(PxAbs(values[k]) < QUANTIZED_UNBOUNDED_LIMIT)
+				{
+					rangeMin[j] = PxMin(rangeMin[j], values[k]);
+					rangeMax[j] = PxMax(rangeMax[j], values[k]);
+				}
+			}
+		}
+	}
+
+	PxVec3 invQuantum;
+	for(PxU32 j=0;j<3;j++)
+	{
+		if(rangeMin[j] > rangeMax[j])
+			rangeMin[j] = rangeMax[j] = 0.0f;
+
+		// PT: the step is kept above the float precision at that distance from the origin, otherwise the extra step
+		// would not be enough to cover the decoding error
+		const float maxAbs = PxMax(PxAbs(rangeMin[j]), PxAbs(rangeMax[j]));
+		const float quantum = PxMax((rangeMax[j] - rangeMin[j]) / QUANTIZED_NB_STEPS, maxAbs * 1e-6f);
+		mQuantum[j] = quantum;
+		mOrigin[j] = rangeMin[j] - 2.0f * quantum;
+		invQuantum[j] = quantum!=0.0f ? 1.0f / quantum : 0.0f;
+	}
+
+	// PT: the extra node in front of the root puts each sibling pair at a 32-byte boundary
+	BVHNodeQ* nodes = reinterpret_cast<BVHNodeQ*>(PxAlignedAllocator<64>().allocate(sizeof(BVHNodeQ)*(nbNodes+1), PX_FL));
+	if(!nodes)
+		return false;
+	PxMemZero(nodes, sizeof(BVHNodeQ));
+	nodes++;
+
+	for(PxU32 i=0;i<nbNodes;i++)
+	{
+		const BVHNode& src = srcNodes[i];
+		BVHNodeQ& dst = nodes[i];
+		PX_ASSERT(src.isLeaf() || (src.getPosIndex() & 1));
+		for(PxU32 j=0;j<3;j++)
+		{
+			dst.mMin[j] = quantizeMin(src.mBV.minimum[j], mOrigin[j], invQuantum[j]);
+			dst.mMax[j] = quantizeMax(src.mBV.maximum[j], mOrigin[j], invQuantum[j]);
+		}
+		dst.mData = src.mData;
+	}
+
+	mNodes = nodes;
+	mNbNodes = nbNodes;
+
+	mIndices = tree.mIndices;
+	mNbIndices = tree.mNbIndices;
+	tree.mIndices = NULL;
+	tree.mNbIndices = 0;
+	return true;
+}
+
+void QuantizedAABBTree::shiftOrigin(const PxVec3& shift)
+{
+	mOrigin -= shift;
+}
+
 void TinyBVH::constructFromTriangles(const PxU32* triangles, const PxU32 numTriangles, const PxVec3* points,
 	TinyBVH& result, PxF32 enlargement)
 {
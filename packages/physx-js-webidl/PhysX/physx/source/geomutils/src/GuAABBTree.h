@@ -252,6 +252,8 @@ namespace Gu
 		PX_FORCE_INLINE			BVHNode*		getNodes()					{ return mNodes;		}
 
 		PX_PHYSX_COMMON_API		void			fullRefit(const PxBounds3* boxes);
+		// returns the sum of the surface areas of all nodes, i.e. the unnormalized SAH cost of the tree
+		PX_PHYSX_COMMON_API		float			computeNodeAreaSum()	const;
 
 		// PT: I'm leaving the above accessors here to avoid refactoring the SQ code using them, but members became public.
 								PxU32			mNbIndices;	//!< Nb indices
@@ -270,7 +272,8 @@ namespace Gu
 		// adds node[index] to a list of nodes to refit when refitMarkedNodes is called
 		// Note that this includes updating the hierarchy up the chain
 		PX_PHYSX_COMMON_API		void			markNodeForRefit(TreeNodeIndex nodeIndex);
-		PX_PHYSX_COMMON_API		void			refitMarkedNodes(const PxBounds3* boxes);
+		// if areaDelta is not NULL, the change in the sum of node surface areas caused by the refit is added to it
+		PX_PHYSX_COMMON_API		void			refitMarkedNodes(const PxBounds3* boxes, float* areaDelta=NULL);
 
 		PX_FORCE_INLINE			PxU32*			getUpdateMap()	{ return mUpdateMap;	}
 
@@ -329,6 +332,93 @@ namespace Gu
 								void			traverseRuntimeNode(BVHNode& targetNode, const AABBTreeMergeData& tree, PxU32 nodeIndex);
 	};
 
+	//! Read-only AABB-tree with quantized node bounds, used for large static trees. It is initialized from a regular AABBTree
+	//! and uses 16-byte nodes (BVHNodeQ) instead of 28-byte ones. The node array is aligned so that each sibling pair sits in
+	//! one half of a 64-byte cache line. Bounds are quantized against the root bounds and rounded outward, i.e. the decoded
+	//! node bounds always contain the original ones.
+	class QuantizedAABBTree : public PxUserAllocated
+	{
+		public:
+												QuantizedAABBTree();
+												~QuantizedAABBTree();
+
+		// Initializes the tree from a regular one. The indices are taken over, i.e. the source tree doesn't own them anymore.
+								bool			init(AABBTree& tree);
+								void			release();
+
+		PX_FORCE_INLINE			PxU32			getNbIndices()		const	{ return mNbIndices;	}
+		PX_FORCE_INLINE			const PxU32*	getIndices()		const	{ return mIndices;		}
+		PX_FORCE_INLINE			PxU32			getNbNodes()		const	{ return mNbNodes;		}
+		PX_FORCE_INLINE			const BVHNodeQ*	getNodes()			const	{ return mNodes;		}
+
+		PX_FORCE_INLINE			void			getNodeBounds(const BVHNodeQ* node, PxBounds3& bounds)	const
+												{
+													Vec3V minV, maxV;
+													decode(node, minV, maxV);
+													V3StoreU(minV, bounds.minimum);
+													V3StoreU(maxV, bounds.maximum);
+												}
+
+		// Same as BVHNode::getAABBCenterExtentsV / getAABBCenterExtentsV2
+		PX_FORCE_INLINE			void			getAABBCenterExtentsV(const BVHNodeQ* node, Vec3V* center, Vec3V* extents)	const
+												{
+													Vec3V minV, maxV;
+													decode(node, minV, maxV);
+
+													const float half = 0.5f;
+													const FloatV halfV = FLoad(half);
+
+													*extents = V3Scale(V3Sub(maxV, minV), halfV);
+													*center = V3Scale(V3Add(maxV, minV), halfV);
+												}
+
+		PX_FORCE_INLINE			void			getAABBCenterExtentsV2(const BVHNodeQ* node, Vec3V* center, Vec3V* extents)	const
+												{
+													Vec3V minV, maxV;
+													decode(node, minV, maxV);
+
+													*extents = V3Sub(maxV, minV);
+													*center = V3Add(maxV, minV);
+												}
+
+		// Returns the memory used by the nodes and indices, in bytes
+		PX_FORCE_INLINE			PxU32			getMemoryUsed()		const	{ return mNbNodes ? (mNbNodes+1)*sizeof(BVHNodeQ) + mNbIndices*sizeof(PxU32) : 0;	}
+
+								void			shiftOrigin(const PxVec3& shift);
+		private:
+		// PT: min code 0 and max code 0xffff are reserved for unbounded coordinates (e.g. planes), so that such objects
+		// don't ruin the precision for the whole tree
+		PX_FORCE_INLINE			void			decode(const BVHNodeQ* node, Vec3V& minV, Vec3V& maxV)	const
+												{
+													const Vec3V qMinV = V3LoadU(PxVec3(float(node->mMin[0]), float(node->mMin[1]), float(node->mMin[2])));
+													const Vec3V qMaxV = V3LoadU(PxVec3(float(node->mMax[0]), float(node->mMax[1]), float(node->mMax[2])));
+													const Vec3V originV = V3LoadU(mOrigin);
+													const Vec3V quantumV = V3LoadU(mQuantum);
+													const Vec3V unboundedV = V3Load(PX_MAX_BOUNDS_EXTENTS);
+
+													minV = V3Sel(V3IsEq(qMinV, V3Zero()), V3Neg(unboundedV), V3MulAdd(qMinV, quantumV, originV));
+													maxV = V3Sel(V3IsEq(qMaxV, V3Load(65535.0f)), unboundedV, V3MulAdd(qMaxV, quantumV, originV));
+												}
+
+								PxVec3			mOrigin;		//!< Position of quantized coordinate 0
+								PxVec3			mQuantum;		//!< Size of one quantization step
+								PxU32			mNbIndices;
+								PxU32			mNbNodes;
+								BVHNodeQ*		mNodes;			//!< Root node. There is a padding node before it to align the sibling pairs.
+								PxU32*			mIndices;
+	};
+
+	// PT: overloads picked by the traversal templates in GuAABBTreeQuery.h
+	static PX_FORCE_INLINE void getNodeCenterExtentsV(const QuantizedAABBTree& tree, const BVHNodeQ* node, Vec3V* center, Vec3V* extents)
+	{
+		tree.getAABBCenterExtentsV(node, center, extents);
+	}
+
+	static PX_FORCE_INLINE void getNodeCenterExtentsV2(const QuantizedAABBTree& tree, const BVHNodeQ* node, Vec3V* center, Vec3V* extents)
+	{
+		tree.getAABBCenterExtentsV2(node, center, extents);
+	}
+
 
 
 	struct TinyBVH
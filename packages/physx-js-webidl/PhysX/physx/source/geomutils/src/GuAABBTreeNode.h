@@ -40,6 +40,14 @@ using namespace aos;
 
 namespace Gu
 {
+	// PT: the leaf code of the traversal templates skips the primitive bounds test for single-primitive leaves, since their
+	// bounds are the same. Node types with approximate bounds specialize this to disable that shortcut.
+	template<typename Node>
+	struct NodeHasExactBounds
+	{
+		enum { value = 1 };
+	};
+
 	struct BVHNode : public PxUserAllocated
 	{
 		public:
@@ -92,6 +100,32 @@ namespace Gu
 						PxU32			mData;	// 27 bits node or prim index|4 bits #prims|1 bit leaf
 	};
 
+	// PT: 16-byte version of BVHNode with the bounds quantized to 16 bits per coordinate. The quantization parameters are
+	// stored in the tree (see QuantizedAABBTree), so the bounds must be decoded through the tree. mData has the same layout
+	// as in BVHNode.
+	struct BVHNodeQ
+	{
+		PX_FORCE_INLINE	PxU32			isLeaf()								const	{ return mData&1;			}
+		PX_FORCE_INLINE	const PxU32*	getPrimitives(const PxU32* base)		const	{ return base + (mData>>5);	}
+		PX_FORCE_INLINE	PxU32			getPrimitiveIndex()						const	{ return mData>>5;			}
+		PX_FORCE_INLINE	PxU32			getNbPrimitives()						const	{ return (mData>>1)&15;		}
+		PX_FORCE_INLINE	PxU32			getPosIndex()							const	{ return mData>>1;			}
+		PX_FORCE_INLINE	PxU32			getNegIndex()							const	{ return (mData>>1) + 1;	}
+		PX_FORCE_INLINE	const BVHNodeQ*	getPos(const BVHNodeQ* base)			const	{ return base + (mData>>1);	}
+		PX_FORCE_INLINE	const BVHNodeQ*	getNeg(const BVHNodeQ* base)			const	{ return base + (mData>>1) + 1;	}
+
+						PxU16			mMin[3];	// Quantized bounds, rounded outward
+						PxU16			mMax[3];
+						PxU32			mData;		// 27 bits node or prim index|4 bits #prims|1 bit leaf
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(BVHNodeQ)==16);
+
+	template<>
+	struct NodeHasExactBounds<BVHNodeQ>
+	{
+		enum { value = 0 };
+	};
+
 } // namespace Gu
 }
 
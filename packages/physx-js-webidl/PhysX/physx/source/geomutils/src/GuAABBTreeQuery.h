@@ -32,7 +32,9 @@
 #include "GuBVHTestsSIMD.h"
 #include "GuAABBTreeBounds.h"
 #include "foundation/PxInlineArray.h"
+#include "foundation/PxPlane.h"
 #include "GuAABBTreeNode.h"
+#include "GuPruner.h"
 
 namespace physx
 {
@@ -56,11 +58,53 @@ namespace physx
 
 		//////////////////////////////////////////////////////////////////////////
 
+		// PT: node bounds are fetched through these so that trees whose nodes don't store plain float bounds can decode
+		// them (see QuantizedAABBTree, which provides its own overloads).
+		template<typename Tree, typename Node>
+		static PX_FORCE_INLINE void getNodeCenterExtentsV(const Tree&, const Node* node, Vec3V* center, Vec3V* extents)
+		{
+			node->getAABBCenterExtentsV(center, extents);
+		}
+
+		template<typename Tree, typename Node>
+		static PX_FORCE_INLINE void getNodeCenterExtentsV2(const Tree&, const Node* node, Vec3V* center, Vec3V* extents)
+		{
+			node->getAABBCenterExtentsV2(center, extents);
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+
+		// PT: optional traversal counters. Callbacks that can carry a PrunerQueryStats pointer provide their own overloads
+		// (see GuCallbackAdapter.h). For everything else this returns NULL and the counting code compiles away.
+		template<typename QueryCallback>
+		static PX_FORCE_INLINE PrunerQueryStats* getQueryStats(const QueryCallback&)
+		{
+			return NULL;
+		}
+
+		static PX_FORCE_INLINE void recordNodes(PrunerQueryStats* stats, PxU32 nbNodes)
+		{
+			if(stats)
+				stats->mNbNodes += nbNodes;
+		}
+
+		template<typename Node>
+		static PX_FORCE_INLINE void recordLeaf(PrunerQueryStats* stats, const Node* node)
+		{
+			if(stats)
+			{
+				stats->mNbLeaves++;
+				stats->mNbPrims += node->getNbPrimitives();
+			}
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+
 		template<const bool tHasIndices, typename Test, typename Node, typename QueryCallback>
 		static PX_FORCE_INLINE bool doOverlapLeafTest(const Test& test, const Node* node, const PxBounds3* bounds, const PxU32* indices, QueryCallback& visitor)
 		{
 			PxU32 nbPrims = node->getNbPrimitives();
-			const bool doBoxTest = nbPrims > 1;
+			const bool doBoxTest = nbPrims > 1 || !NodeHasExactBounds<Node>::value;
 			const PxU32* prims = tHasIndices ? node->getPrimitives(indices) : NULL;
 			while(nbPrims--)
 			{
@@ -93,6 +137,7 @@ namespace physx
 			bool operator()(const AABBTreeBounds& treeBounds, const Tree& tree, const Test& test, QueryCallback& visitor)
 			{
 				const PxBounds3* bounds = treeBounds.getBounds();
+				PrunerQueryStats* stats = getQueryStats(visitor);
 
 				PxInlineArray<const Node*, RAW_TRAVERSAL_STACK_SIZE> stack;
 				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
@@ -104,11 +149,13 @@ namespace physx
 				{
 					const Node* node = stack[--stackIndex];
 					Vec3V center, extents;
-					node->getAABBCenterExtentsV(&center, &extents);
+					getNodeCenterExtentsV(tree, node, &center, &extents);
+					recordNodes(stats, 1);
 					while(test(center, extents))
 					{
 						if(node->isLeaf())
 						{
+							recordLeaf(stats, node);
 							if(!doOverlapLeafTest<tHasIndices, Test, Node>(test, node, bounds, tree.getIndices(), visitor))
 								return false;
 							break;
@@ -120,7 +167,8 @@ namespace physx
 						stack[stackIndex++] = children + 1;
 						if(stackIndex == stack.capacity())
 							stack.resizeUninitialized(stack.capacity() * 2);
-						node->getAABBCenterExtentsV(&center, &extents);
+						getNodeCenterExtentsV(tree, node, &center, &extents);
+						recordNodes(stats, 1);
 					}
 				}
 				return true;
@@ -129,11 +177,317 @@ namespace physx
 
 		//////////////////////////////////////////////////////////////////////////
 
+		// PT: box-vs-planes test used for culling queries. Planes point outward, i.e. a point is inside the volume when it is
+		// behind all planes. Only the planes whose bits are set in 'inClipMask' are tested. Returns false if the box is fully
+		// outside one of them. Otherwise 'outClipMask' receives the subset of planes still straddled by the box, so a zero mask
+		// means the box (and anything it contains) is fully inside the volume and the remaining planes can be skipped.
+		static PX_FORCE_INLINE bool planesAABBOverlap(const PxVec3& m, const PxVec3& d, const PxPlane* p, PxU32& outClipMask, PxU32 inClipMask)
+		{
+			PxU32 mask = 1;
+			PxU32 tmpOutClipMask = 0;
+
+			while(inClipMask)
+			{
+				if(inClipMask & 1)
+				{
+					const float NP = d.x*fabsf(p->n.x) + d.y*fabsf(p->n.y) + d.z*fabsf(p->n.z);
+					const float MP = m.x*p->n.x + m.y*p->n.y + m.z*p->n.z + p->d;
+
+					if(NP < MP)
+						return false;
+					if((-NP) < MP)
+						tmpOutClipMask |= mask;
+				}
+				inClipMask >>= 1;
+				mask += mask;
+				p++;
+			}
+
+			outClipMask = tmpOutClipMask;
+			return true;
+		}
+
+		static PX_FORCE_INLINE PxU32 getPlanesClipMask(PxU32 nbPlanes)
+		{
+			PX_ASSERT(nbPlanes && nbPlanes<=32);
+			return nbPlanes>=32 ? 0xffffffff : (1<<nbPlanes)-1;
+		}
+
+		// PT: AABBTreeOverlap-compatible test for culling queries. This one does not support the early-accept of fully
+		// visible subtrees, use AABBTreeCull for that. It is still useful for flat structures.
+		struct PlanesAABBTest
+		{
+			PlanesAABBTest(PxU32 nbPlanes, const PxPlane* planes) : mPlanes(planes), mMask(getPlanesClipMask(nbPlanes)), mOutClipMask(0)
+			{
+			}
+
+			PX_FORCE_INLINE PxIntBool operator()(const Vec3V boxCenter, const Vec3V boxExtents) const
+			{
+				PxVec3 center, extents;
+				V3StoreU(boxCenter, center);
+				V3StoreU(boxExtents, extents);
+				return planesAABBOverlap(center, extents, mPlanes, mOutClipMask, mMask) ? PxIntTrue : PxIntFalse;
+			}
+
+			const PxPlane*	mPlanes;
+			const PxU32		mMask;
+			mutable PxU32	mOutClipMask;
+
+			PX_NOCOPY(PlanesAABBTest)
+		};
+
+		// PT: reports all primitives below 'node0' without testing them. Used for subtrees fully inside a culling volume.
+		template<const bool tHasIndices, typename Node, typename QueryCallback>
+		static bool dumpSubtree(const Node* const nodeBase, const Node* node0, const PxU32* indices, QueryCallback& visitor)
+		{
+			PxInlineArray<const Node*, RAW_TRAVERSAL_STACK_SIZE> stack;
+			stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+			stack[0] = node0;
+			PxU32 stackIndex = 1;
+
+			while(stackIndex > 0)
+			{
+				const Node* node = stack[--stackIndex];
+				while(!node->isLeaf())
+				{
+					const Node* children = node->getPos(nodeBase);
+					node = children;
+					stack[stackIndex++] = children + 1;
+					if(stackIndex == stack.capacity())
+						stack.resizeUninitialized(stack.capacity() * 2);
+				}
+
+				PxU32 nbPrims = node->getNbPrimitives();
+				const PxU32* prims = tHasIndices ? node->getPrimitives(indices) : NULL;
+				while(nbPrims--)
+				{
+					const PxU32 primIndex = tHasIndices ? *prims++ : node->getPrimitiveIndex();
+					if(!visitor.invoke(primIndex))
+						return false;
+				}
+			}
+			return true;
+		}
+
+		// PT: culling query against a convex volume defined by up to 32 planes. This is the hierarchical version of
+		// AABBTreeOverlap + PlanesAABBTest: each traversed node only tests the planes its parent was still straddling,
+		// and subtrees fully inside the volume are reported as-is with no further box tests.
+		template<const bool tHasIndices, typename Tree, typename Node, typename QueryCallback>
+		class AABBTreeCull
+		{
+			struct Entry
+			{
+				const Node*	mNode;
+				PxU32		mClipMask;
+			};
+
+		public:
+			bool operator()(const AABBTreeBounds& treeBounds, const Tree& tree, PxU32 nbPlanes, const PxPlane* planes, QueryCallback& visitor)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const PxU32* indices = tree.getIndices();
+				PrunerQueryStats* stats = getQueryStats(visitor);
+
+				PxInlineArray<Entry, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				const Node* const nodeBase = tree.getNodes();
+				stack[0].mNode = nodeBase;
+				stack[0].mClipMask = getPlanesClipMask(nbPlanes);
+				PxU32 stackIndex = 1;
+
+				while(stackIndex > 0)
+				{
+					--stackIndex;
+					const Node* node = stack[stackIndex].mNode;
+					PxU32 inClipMask = stack[stackIndex].mClipMask;
+
+					while(1)
+					{
+						Vec3V centerV, extentsV;
+						getNodeCenterExtentsV(tree, node, &centerV, &extentsV);
+						recordNodes(stats, 1);
+						PxVec3 center, extents;
+						V3StoreU(centerV, center);
+						V3StoreU(extentsV, extents);
+
+						PxU32 outClipMask;
+						if(!planesAABBOverlap(center, extents, planes, outClipMask, inClipMask))
+							break;
+
+						if(!outClipMask)
+						{
+							if(!dumpSubtree<tHasIndices, Node>(nodeBase, node, indices, visitor))
+								return false;
+							break;
+						}
+
+						if(node->isLeaf())
+						{
+							recordLeaf(stats, node);
+							PxU32 nbPrims = node->getNbPrimitives();
+							const bool doBoxTest = nbPrims > 1 || !NodeHasExactBounds<Node>::value;
+							const PxU32* prims = tHasIndices ? node->getPrimitives(indices) : NULL;
+							while(nbPrims--)
+							{
+								const PxU32 primIndex = tHasIndices ? *prims++ : node->getPrimitiveIndex();
+								if(doBoxTest)
+								{
+									const PxBounds3& primBounds = bounds[primIndex];
+									PxU32 unused;
+									if(!planesAABBOverlap(primBounds.getCenter(), primBounds.getExtents(), planes, unused, outClipMask))
+										continue;
+								}
+
+								if(!visitor.invoke(primIndex))
+									return false;
+							}
+							break;
+						}
+
+						const Node* children = node->getPos(nodeBase);
+						node = children;
+						stack[stackIndex].mNode = children + 1;
+						stack[stackIndex].mClipMask = outClipMask;
+						stackIndex++;
+						if(stackIndex == stack.capacity())
+							stack.resizeUninitialized(stack.capacity() * 2);
+						inClipMask = outClipMask;
+					}
+				}
+				return true;
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
+		static PX_FORCE_INLINE bool sphereAABBOverlap(const PxVec4& sphere, const PxVec3& center, const PxVec3& extents)
+		{
+			const float dx = PxMax(PxAbs(sphere.x - center.x) - extents.x, 0.0f);
+			const float dy = PxMax(PxAbs(sphere.y - center.y) - extents.y, 0.0f);
+			const float dz = PxMax(PxAbs(sphere.z - center.z) - extents.z, 0.0f);
+			return dx*dx + dy*dy + dz*dz <= sphere.w*sphere.w;
+		}
+
+		static PX_FORCE_INLINE bool centerExtentsOverlap(const PxVec3& c0, const PxVec3& e0, const PxVec3& c1, const PxVec3& e1)
+		{
+			return	PxAbs(c0.x - c1.x) <= e0.x + e1.x
+				&&	PxAbs(c0.y - c1.y) <= e0.y + e1.y
+				&&	PxAbs(c0.z - c1.z) <= e0.z + e1.z;
+		}
+
+		// PT: batched overlap query between a tree and a set of spheres organized in their own BVH (see PrunerSphereBatch).
+		// This is a dual-tree traversal: pairs of (tree node, query node) are visited from a single stack, and the larger node
+		// of each overlapping pair is opened first. Subtrees that no sphere touches are discarded once for the whole batch,
+		// instead of once per sphere. The callback receives (sphere index, primitive index) pairs, in no particular order.
+		template<const bool tHasIndices, typename Tree, typename Node, typename QueryCallback>
+		class AABBTreeSpheresOverlap
+		{
+			struct Entry
+			{
+				const Node*		mNode;
+				const BVHNode*	mQueryNode;
+			};
+
+		public:
+			bool operator()(const AABBTreeBounds& treeBounds, const Tree& tree, const PrunerSphereBatch& batch, QueryCallback& visitor)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const PxU32* indices = tree.getIndices();
+
+				PxInlineArray<Entry, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				const Node* const nodeBase = tree.getNodes();
+				const BVHNode* const queryNodeBase = batch.mNodes;
+				stack[0].mNode = nodeBase;
+				stack[0].mQueryNode = queryNodeBase;
+				PxU32 stackIndex = 1;
+
+				while(stackIndex > 0)
+				{
+					--stackIndex;
+					const Node* node = stack[stackIndex].mNode;
+					const BVHNode* queryNode = stack[stackIndex].mQueryNode;
+
+					Vec3V centerV, extentsV;
+					getNodeCenterExtentsV(tree, node, &centerV, &extentsV);
+					PxVec3 center, extents;
+					V3StoreU(centerV, center);
+					V3StoreU(extentsV, extents);
+
+					const PxVec3 queryCenter = queryNode->mBV.getCenter();
+					const PxVec3 queryExtents = queryNode->mBV.getExtents();
+					if(!centerExtentsOverlap(center, extents, queryCenter, queryExtents))
+						continue;
+
+					const bool queryIsLeaf = queryNode->isLeaf()!=0;
+					if(node->isLeaf())
+					{
+						if(!queryIsLeaf)
+						{
+							pushChildren(stack, stackIndex, node, queryNode->getPos(queryNodeBase));
+							continue;
+						}
+
+						const PxU32 nbSpheres = batch.mIndices ? queryNode->getNbPrimitives() : 1;
+						const PxU32 sphereIndex = queryNode->getPrimitiveIndex();
+						const PxU32* spheres = batch.mIndices ? queryNode->getPrimitives(batch.mIndices) : &sphereIndex;
+
+						PxU32 nbPrims = node->getNbPrimitives();
+						const PxU32* prims = tHasIndices ? node->getPrimitives(indices) : NULL;
+						while(nbPrims--)
+						{
+							const PxU32 primIndex = tHasIndices ? *prims++ : node->getPrimitiveIndex();
+							const PxBounds3& primBounds = bounds[primIndex];
+							const PxVec3 primCenter = primBounds.getCenter();
+							const PxVec3 primExtents = primBounds.getExtents();
+							for(PxU32 i=0;i<nbSpheres;i++)
+							{
+								if(sphereAABBOverlap(batch.mSpheres[spheres[i]], primCenter, primExtents) && !visitor.invoke(spheres[i], primIndex))
+									return false;
+							}
+						}
+						continue;
+					}
+
+					// PT: a single sphere is tested directly against the tree nodes, which culls more than its box
+					if(queryIsLeaf && !batch.mIndices && !sphereAABBOverlap(batch.mSpheres[queryNode->getPrimitiveIndex()], center, extents))
+						continue;
+
+					if(queryIsLeaf || extents.x + extents.y + extents.z >= queryExtents.x + queryExtents.y + queryExtents.z)
+					{
+						const Node* children = node->getPos(nodeBase);
+						pushPair(stack, stackIndex, children, queryNode);
+						pushPair(stack, stackIndex, children + 1, queryNode);
+					}
+					else
+						pushChildren(stack, stackIndex, node, queryNode->getPos(queryNodeBase));
+				}
+				return true;
+			}
+
+		private:
+			static PX_FORCE_INLINE void pushPair(PxInlineArray<Entry, RAW_TRAVERSAL_STACK_SIZE>& stack, PxU32& stackIndex, const Node* node, const BVHNode* queryNode)
+			{
+				stack[stackIndex].mNode = node;
+				stack[stackIndex].mQueryNode = queryNode;
+				stackIndex++;
+				if(stackIndex == stack.capacity())
+					stack.resizeUninitialized(stack.capacity() * 2);
+			}
+
+			static PX_FORCE_INLINE void pushChildren(PxInlineArray<Entry, RAW_TRAVERSAL_STACK_SIZE>& stack, PxU32& stackIndex, const Node* node, const BVHNode* queryChildren)
+			{
+				pushPair(stack, stackIndex, node, queryChildren);
+				pushPair(stack, stackIndex, node, queryChildren + 1);
+			}
+		};
+		//////////////////////////////////////////////////////////////////////////
+
 		template <const bool tInflate, const bool tHasIndices, typename Node, typename QueryCallback> // use inflate=true for sweeps, inflate=false for raycasts
 		static PX_FORCE_INLINE bool doLeafTest(	const Node* node, Gu::RayAABBTest& test, const PxBounds3* bounds, const PxU32* indices, PxReal& maxDist, QueryCallback& pcb)
 		{
 			PxU32 nbPrims = node->getNbPrimitives();
-			const bool doBoxTest = nbPrims > 1;
+			const bool doBoxTest = nbPrims > 1 || !NodeHasExactBounds<Node>::value;
 			const PxU32* prims = tHasIndices ? node->getPrimitives(indices) : NULL;
 			while(nbPrims--)
 			{
@@ -202,6 +556,7 @@ namespace physx
 				// PT: we will pass center*2 and extents*2 to the ray-box code, to save some work per-box
 				// So we initialize the test with values multiplied by 2 as well, to get correct results
 				Gu::RayAABBTest test(origin*2.0f, unitDir*2.0f, maxDist, inflation*2.0f);
+				PrunerQueryStats* stats = getQueryStats(pcb);
 
 				PxInlineArray<const Node*, RAW_TRAVERSAL_STACK_SIZE> stack;
 				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
@@ -213,7 +568,8 @@ namespace physx
 				{
 					const Node* node = stack[stackIndex];
 					Vec3V center, extents;
-					node->getAABBCenterExtentsV2(&center, &extents);
+					getNodeCenterExtentsV2(tree, node, &center, &extents);
+					recordNodes(stats, 1);
 					if(test.check<tInflate>(center, extents))	// TODO: try timestamp ray shortening to skip this
 					{
 						while(!node->isLeaf())
@@ -221,12 +577,13 @@ namespace physx
 							const Node* children = node->getPos(nodeBase);
 
 							Vec3V c0, e0;
-							children[0].getAABBCenterExtentsV2(&c0, &e0);
+							getNodeCenterExtentsV2(tree, children, &c0, &e0);
 							const PxU32 b0 = test.check<tInflate>(c0, e0);
 
 							Vec3V c1, e1;
-							children[1].getAABBCenterExtentsV2(&c1, &e1);
+							getNodeCenterExtentsV2(tree, children + 1, &c1, &e1);
 							const PxU32 b1 = test.check<tInflate>(c1, e1);
+							recordNodes(stats, 2);
 
 							if(b0 && b1)	// if both intersect, push the one with the further center on the stack for later
 							{
@@ -245,6 +602,7 @@ namespace physx
 								goto skip_leaf_code;
 						}
 
+						recordLeaf(stats, node);
 						if(!doLeafTest<tInflate, tHasIndices, Node>(node, test, bounds, tree.getIndices(), maxDist, pcb))
 							return false;
 					skip_leaf_code:;
@@ -423,192 +423,16 @@ bool BVH::sweep(const PxGeometry& geom, const PxTransform& pose, const PxVec3& u
 	return sweep(queryVolume, unitDir, distance, cb, flags);
 }
 
-namespace
-{
-	PX_FORCE_INLINE bool planesAABBOverlap(const PxVec3& m, const PxVec3& d, const PxPlane* p, PxU32& outClipMask, PxU32 inClipMask)
-	{
-		PxU32 mask = 1;
-		PxU32 tmpOutClipMask = 0;
-
-		while(mask<=inClipMask)
-		{
-			if(inClipMask & mask)
-			{               
-				const float NP = d.x*fabsf(p->n.x) + d.y*fabsf(p->n.y) + d.z*fabsf(p->n.z);
-				const float MP = m.x*p->n.x + m.y*p->n.y + m.z*p->n.z + p->d;
-
-				if(NP < MP)
-					return false;
-				if((-NP) < MP)
-					tmpOutClipMask |= mask;
-			}
-			mask+=mask;
-			p++;
-		}
-
-		outClipMask = tmpOutClipMask;
-		return true;
-	}
-
-	struct FrustumTest
-	{
-		FrustumTest(PxU32 nbPlanes, const PxPlane* planes) : mPlanes(planes), mMask((1<<nbPlanes)-1), mNbPlanes(nbPlanes), mOutClipMask(0)
-		{
-		}
-
-		PX_FORCE_INLINE PxIntBool operator()(const Vec3V boxCenter, const Vec3V boxExtents) const		
-		{
-			// PT: TODO: rewrite all this in SIMD
-			PxVec3 center, extents;
-			V3StoreU(boxCenter, center);
-			V3StoreU(boxExtents, extents);
-
-			if(!planesAABBOverlap(center, extents, mPlanes, mOutClipMask, mMask))
-				return PxIntFalse;
-
-			// PT: unfortunately the AABBTreeOverlap template doesn't support this case where we know we can
-			// immediately dump the rest of the tree (i.e. the old "containment tests" in Opcode). We might
-			// want to revisit this at some point.
-			//
-			// In fact it's worse than this: we lost the necessary data to make this quick, in "flattenTree"
-			// when going from AABBTreeBuildNodes to BVHNodes. The BVHNodes lost the primitive-related info
-			// for internal (non-leaf) nodes so we cannot just dump a list of primitives when an internal
-			// node is fully visible (like we did in Opcode 1.x). Best we can do is keep traversing the tree
-			// and skip VFC tests.
-			//if(!outClipMask)
-			
-			return PxIntTrue;
-		}
-
-		const PxPlane*	mPlanes;
-		const PxU32		mMask;
-		const PxU32		mNbPlanes;
-		mutable PxU32	mOutClipMask;
-
-		PX_NOCOPY(FrustumTest)
-	};
-}
-
-static bool dumpNode(OverlapAdapter& oa, const BVHNode* const nodeBase, const BVHNode* node0, const PxU32* indices)
-{
-	PxInlineArray<const BVHNode*, RAW_TRAVERSAL_STACK_SIZE> stack;
-	stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
-	stack[0] = node0;
-	PxU32 stackIndex = 1;
-
-	while(stackIndex > 0)
-	{
-		const BVHNode* node = stack[--stackIndex];
-
-		while(1)
-		{
-			if(node->isLeaf())
-			{
-				PxU32 nbPrims = node->getNbPrimitives();
-				const PxU32* prims = indices ? node->getPrimitives(indices) : NULL;
-				while(nbPrims--)
-				{
-					const PxU32 primIndex = indices ? *prims++ : node->getPrimitiveIndex();
-					if(!oa.invoke(primIndex))
-						return false;
-				}
-				break;
-			}
-			else
-			{
-				const BVHNode* children = node->getPos(nodeBase);
-				node = children;
-				stack[stackIndex++] = children + 1;
-				if(stackIndex == stack.capacity())
-					stack.resizeUninitialized(stack.capacity() * 2);
-			}
-		}
-	}
-	return true;
-}
-
 bool BVH::cull(PxU32 nbPlanes, const PxPlane* planes, OverlapCallback& cb, PxGeometryQueryFlags flags) const
 {
 	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
 
 	OverlapAdapter oa(cb);
-	const FrustumTest test(nbPlanes, planes);
 
-	if(0)
-	{
-		// PT: this vanilla codepath is slower
-		if(mData.mIndices)
-			return AABBTreeOverlap<true, FrustumTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
-		else
-			return AABBTreeOverlap<false, FrustumTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
-	}
+	if(mData.mIndices)
+		return AABBTreeCull<true, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), nbPlanes, planes, oa);
 	else
-	{
-		const PxBounds3* bounds = mData.mBounds.getBounds();
-		const bool hasIndices = mData.mIndices!=NULL;
-
-		PxInlineArray<const BVHNode*, RAW_TRAVERSAL_STACK_SIZE> stack;
-		stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
-		const BVHNode* const nodeBase = mData.mNodes;
-		stack[0] = nodeBase;
-		PxU32 stackIndex = 1;
-
-		while(stackIndex > 0)
-		{
-			const BVHNode* node = stack[--stackIndex];
-			Vec3V center, extents;
-			node->getAABBCenterExtentsV(&center, &extents);
-			while(test(center, extents))
-			{
-				if(!test.mOutClipMask)
-				{
-					if(!dumpNode(oa, nodeBase, node, mData.mIndices))
-						return false;
-					break;
-				}
-				else
-				{
-					if(node->isLeaf())
-					{
-						PxU32 nbPrims = node->getNbPrimitives();
-						const bool doBoxTest = nbPrims > 1;
-						const PxU32* prims = hasIndices ? node->getPrimitives(mData.mIndices) : NULL;
-						while(nbPrims--)
-						{
-							const PxU32 primIndex = hasIndices ? *prims++ : node->getPrimitiveIndex();
-							if(doBoxTest)
-							{
-								Vec4V center2, extents2;
-								getBoundsTimesTwo(center2, extents2, bounds, primIndex);
-
-								const float half = 0.5f;
-								const FloatV halfV = FLoad(half);
-
-								const Vec4V extents_ = V4Scale(extents2, halfV);
-								const Vec4V center_ = V4Scale(center2, halfV);
-
-								if(!test(Vec3V_From_Vec4V(center_), Vec3V_From_Vec4V(extents_)))
-									continue;
-							}
-
-							if(!oa.invoke(primIndex))
-								return false;
-						}
-						break;
-					}
-
-					const BVHNode* children = node->getPos(nodeBase);
-
-					node = children;
-					stack[stackIndex++] = children + 1;
-					if(stackIndex == stack.capacity())
-						stack.resizeUninitialized(stack.capacity() * 2);
-					node->getAABBCenterExtentsV(&center, &extents);
-				}
-			}
-		}
-		return true;
-	}
+		return AABBTreeCull<false, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), nbPlanes, planes, oa);
 }
 
 void BVH::refit()
@@ -351,6 +351,180 @@ void Gu::computeTightBounds(PxBounds3& bounds, PxU32 nb, const PxVec3* PX_RESTRI
 	StoreBounds(bounds, minV, maxV);
 }
 
+// PT: the mesh scale can be applied to the local box directly when it is a plain (diagonal) scale
+static PX_FORCE_INLINE bool isDiagonalScale(const PxMeshScale& scale)
+{
+	return scale.rotation.isIdentity() || (scale.scale.x==scale.scale.y && scale.scale.x==scale.scale.z);
+}
+
+bool BoundsBatch::add(PxU32 index, const PxGeometry& geometry, const PxTransform& pose)
+{
+	PxVec3 center, extents;
+	switch(geometry.getType())
+	{
+		case PxGeometryType::eBOX:
+		{
+			center = PxVec3(0.0f);
+			extents = static_cast<const PxBoxGeometry&>(geometry).halfExtents;
+		}
+		break;
+
+		case PxGeometryType::eCONVEXMESH:
+		{
+			const PxConvexMeshGeometry& shape = static_cast<const PxConvexMeshGeometry&>(geometry);
+			if((shape.meshFlags & PxConvexMeshGeometryFlag::eTIGHT_BOUNDS) || !isDiagonalScale(shape.scale))
+				return false;
+
+			const CenterExtentsPadded& local = static_cast<const Gu::ConvexMesh*>(shape.convexMesh)->getHull().getPaddedBounds();
+			center = local.mCenter.multiply(shape.scale.scale);
+			extents = local.mExtents.multiply(shape.scale.scale.abs());
+		}
+		break;
+
+		case PxGeometryType::eTRIANGLEMESH:
+		{
+			const PxTriangleMeshGeometry& shape = static_cast<const PxTriangleMeshGeometry&>(geometry);
+			if((shape.meshFlags & PxMeshGeometryFlag::eTIGHT_BOUNDS) || !isDiagonalScale(shape.scale))
+				return false;
+
+			const CenterExtentsPadded& local = static_cast<const TriangleMesh*>(shape.triangleMesh)->getPaddedBounds();
+			center = local.mCenter.multiply(shape.scale.scale);
+			extents = local.mExtents.multiply(shape.scale.scale.abs());
+		}
+		break;
+
+		case PxGeometryType::eHEIGHTFIELD:
+		{
+			const PxHeightFieldGeometry& shape = static_cast<const PxHeightFieldGeometry&>(geometry);
+			const PxVec3 scale(shape.rowScale, shape.heightScale, shape.columnScale);
+
+			const CenterExtentsPadded& local = static_cast<const Gu::HeightField*>(shape.heightField)->getData().getPaddedBounds();
+			center = local.mCenter.multiply(scale);
+			extents = local.mExtents.multiply(scale.abs());
+		}
+		break;
+
+		default:
+			return false;
+	}
+
+	const PxU32 nb = mNb++;
+	mIndices[nb] = index;
+	mRotations[nb] = PxVec4(pose.q.x, pose.q.y, pose.q.z, pose.q.w);
+	mPositions[nb] = PxVec4(pose.p, 0.0f);
+	mCenters[nb] = PxVec4(center, 0.0f);
+	mExtents[nb] = PxVec4(extents, 0.0f);
+
+	if(mNb==MaxEntries)
+		flush();
+	return true;
+}
+
+void BoundsBatch::flush()
+{
+	PxU32 nb = mNb;
+	if(!nb)
+		return;
+
+	// PT: pad the batch to a multiple of 4 by duplicating the last entry. It will just be written twice.
+	while(nb&3)
+	{
+		mIndices[nb] = mIndices[nb-1];
+		mRotations[nb] = mRotations[nb-1];
+		mPositions[nb] = mPositions[nb-1];
+		mCenters[nb] = mCenters[nb-1];
+		mExtents[nb] = mExtents[nb-1];
+		nb++;
+	}
+
+	const Vec4V oneV = V4One();
+
+	PxBounds3* PX_RESTRICT dst = mBounds;
+	for(PxU32 i=0;i<nb;i+=4)
+	{
+		// PT: transpose the data to SoA form, i.e. qx = x components of the 4 quaternions, etc
+		Vec4V qx = V4LoadA(&mRotations[i+0].x);
+		Vec4V qy = V4LoadA(&mRotations[i+1].x);
+		Vec4V qz = V4LoadA(&mRotations[i+2].x);
+		Vec4V qw = V4LoadA(&mRotations[i+3].x);
+		V4Transpose(qx, qy, qz, qw);
+
+		Vec4V px = V4LoadA(&mPositions[i+0].x);
+		Vec4V py = V4LoadA(&mPositions[i+1].x);
+		Vec4V pz = V4LoadA(&mPositions[i+2].x);
+		Vec4V pw = V4LoadA(&mPositions[i+3].x);
+		V4Transpose(px, py, pz, pw);
+
+		Vec4V cx = V4LoadA(&mCenters[i+0].x);
+		Vec4V cy = V4LoadA(&mCenters[i+1].x);
+		Vec4V cz = V4LoadA(&mCenters[i+2].x);
+		Vec4V cw = V4LoadA(&mCenters[i+3].x);
+		V4Transpose(cx, cy, cz, cw);
+
+		Vec4V ex = V4LoadA(&mExtents[i+0].x);
+		Vec4V ey = V4LoadA(&mExtents[i+1].x);
+		Vec4V ez = V4LoadA(&mExtents[i+2].x);
+		Vec4V ew = V4LoadA(&mExtents[i+3].x);
+		V4Transpose(ex, ey, ez, ew);
+
+		// PT: rotation matrices, same formulas as PxMat33(const PxQuat&)
+		const Vec4V x2 = V4Add(qx, qx);
+		const Vec4V y2 = V4Add(qy, qy);
+		const Vec4V z2 = V4Add(qz, qz);
+
+		const Vec4V xx = V4Mul(qx, x2);
+		const Vec4V yy = V4Mul(qy, y2);
+		const Vec4V zz = V4Mul(qz, z2);
+		const Vec4V xy = V4Mul(qx, y2);
+		const Vec4V xz = V4Mul(qx, z2);
+		const Vec4V yz = V4Mul(qy, z2);
+		const Vec4V xw = V4Mul(x2, qw);
+		const Vec4V yw = V4Mul(y2, qw);
+		const Vec4V zw = V4Mul(z2, qw);
+
+		const Vec4V m00 = V4Sub(oneV, V4Add(yy, zz));
+		const Vec4V m10 = V4Add(xy, zw);
+		const Vec4V m20 = V4Sub(xz, yw);
+
+		const Vec4V m01 = V4Sub(xy, zw);
+		const Vec4V m11 = V4Sub(oneV, V4Add(xx, zz));
+		const Vec4V m21 = V4Add(yz, xw);
+
+		const Vec4V m02 = V4Add(xz, yw);
+		const Vec4V m12 = V4Sub(yz, xw);
+		const Vec4V m22 = V4Sub(oneV, V4Add(xx, yy));
+
+		// PT: world center = pos + rot * center
+		const Vec4V wcx = V4Add(px, V4MulAdd(m02, cz, V4MulAdd(m01, cy, V4Mul(m00, cx))));
+		const Vec4V wcy = V4Add(py, V4MulAdd(m12, cz, V4MulAdd(m11, cy, V4Mul(m10, cx))));
+		const Vec4V wcz = V4Add(pz, V4MulAdd(m22, cz, V4MulAdd(m21, cy, V4Mul(m20, cx))));
+
+		// PT: world extents = abs(rot) * extents, as in basisExtent()
+		const Vec4V wex = V4MulAdd(V4Abs(m02), ez, V4MulAdd(V4Abs(m01), ey, V4Mul(V4Abs(m00), ex)));
+		const Vec4V wey = V4MulAdd(V4Abs(m12), ez, V4MulAdd(V4Abs(m11), ey, V4Mul(V4Abs(m10), ex)));
+		const Vec4V wez = V4MulAdd(V4Abs(m22), ez, V4MulAdd(V4Abs(m21), ey, V4Mul(V4Abs(m20), ex)));
+
+		// PT: back to AoS
+		Vec4V min0 = V4Sub(wcx, wex);
+		Vec4V min1 = V4Sub(wcy, wey);
+		Vec4V min2 = V4Sub(wcz, wez);
+		Vec4V min3 = V4Zero();
+		V4Transpose(min0, min1, min2, min3);
+
+		Vec4V max0 = V4Add(wcx, wex);
+		Vec4V max1 = V4Add(wcy, wey);
+		Vec4V max2 = V4Add(wcz, wez);
+		Vec4V max3 = V4Zero();
+		V4Transpose(max0, max1, max2, max3);
+
+		{ PxBounds3& b = dst[mIndices[i+0]]; StoreBounds(b, min0, max0);	}
+		{ PxBounds3& b = dst[mIndices[i+1]]; StoreBounds(b, min1, max1);	}
+		{ PxBounds3& b = dst[mIndices[i+2]]; StoreBounds(b, min2, max2);	}
+		{ PxBounds3& b = dst[mIndices[i+3]]; StoreBounds(b, min3, max3);	}
+	}
+	mNb = 0;
+}
+
 void Gu::computeBounds(PxBounds3& bounds, const PxGeometry& geometry, const PxTransform& pose, float contactOffset, float inflation)
 {
 	// Box, Convex, Mesh and HeightField will compute local bounds and pose to world space.
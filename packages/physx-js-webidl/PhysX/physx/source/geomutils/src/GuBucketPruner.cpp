@@ -30,6 +30,8 @@
 #include "foundation/PxBitUtils.h"
 #include "GuBucketPruner.h"
 #include "GuInternal.h"
+#include "GuAABBTreeQuery.h"
+#include "GuCallbackAdapter.h"
 #include "CmVisualization.h"
 #include "CmRadixSort.h"
 
@@ -2184,6 +2186,74 @@ bool BucketPrunerCore::overlap(const ShapeData& queryVolume, PrunerOverlapCallba
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static PX_FORCE_INLINE bool cullBucketBox(const BucketBox& box, const PxPlane* planes, PxU32& outClipMask, PxU32 inClipMask)
+{
+	return planesAABBOverlap(box.mCenter, box.mExtents, planes, outClipMask, inClipMask);
+}
+
+// PT: the bucket hierarchy is only 3 levels deep so we just pass the clip masks down. A zero mask means the
+// box is fully inside the volume, in which case planesAABBOverlap returns immediately for all children.
+bool BucketPrunerCore::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcbArgName) const
+{
+	PX_ASSERT(!mDirty);
+
+	const PxU32 clipMask = getPlanesClipMask(nbPlanes);
+
+#ifdef FREE_PRUNER_SIZE
+	{
+		BucketPrunerOverlapAdapter pcb(pcbArgName, mFreeObjects, mFreeTransforms);
+		for(PxU32 i=0;i<mNbFree;i++)
+		{
+			PxU32 outClipMask;
+			if(planesAABBOverlap(mFreeBounds[i].getCenter(), mFreeBounds[i].getExtents(), planes, outClipMask, clipMask) && !pcb.invoke(i))
+				return false;
+		}
+	}
+#endif
+	if(!mSortedNb)
+		return true;
+
+	PxU32 mask0;
+	if(!cullBucketBox(mGlobalBox, planes, mask0, clipMask))
+		return true;
+
+	BucketPrunerOverlapAdapter pcb(pcbArgName, mSortedObjects, mSortedTransforms);
+
+	for(PxU32 i=0;i<5;i++)
+	{
+		PxU32 mask1;
+		if(!mLevel1.mCounters[i] || !cullBucketBox(mLevel1.mBucketBox[i], planes, mask1, mask0))
+			continue;
+
+		for(PxU32 j=0;j<5;j++)
+		{
+			PxU32 mask2;
+			if(!mLevel2[i].mCounters[j] || !cullBucketBox(mLevel2[i].mBucketBox[j], planes, mask2, mask1))
+				continue;
+
+			for(PxU32 k=0;k<5;k++)
+			{
+				const PxU32 nbInBucket = mLevel3[i][j].mCounters[k];
+				PxU32 mask3;
+				if(!nbInBucket || !cullBucketBox(mLevel3[i][j].mBucketBox[k], planes, mask3, mask2))
+					continue;
+
+				const PxU32 offset = mLevel1.mOffsets[i] + mLevel2[i].mOffsets[j] + mLevel3[i][j].mOffsets[k];
+				for(PxU32 n=0;n<nbInBucket;n++)
+				{
+					const PxU32 index = offset + n;
+					PxU32 outClipMask;
+					if(cullBucketBox(mSortedWorldBoxes[index], planes, outClipMask, mask3) && !pcb.invoke(index))
+						return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void BucketPrunerCore::getGlobalBounds(PxBounds3& bounds) const
 {
 	// PT: TODO: refactor with similar code above in the file
@@ -2392,6 +2462,23 @@ bool BucketPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback&
 	return mCore.overlap(queryVolume, pcb);
 }
 
+bool BucketPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcb) const
+{
+	PX_ASSERT(!mCore.mDirty);
+	if(mCore.mDirty)
+		return true; // it may crash otherwise
+	return mCore.cull(nbPlanes, planes, pcb);
+}
+
+bool BucketPruner::overlapSpheres(const PrunerSphereBatch& spheres, PrunerBatchOverlapCallback& pcb) const
+{
+	PX_ASSERT(!mCore.mDirty);
+	if(mCore.mDirty)
+		return true; // it may crash otherwise
+	// PT: the bucket structure has no dedicated batched traversal
+	return overlapSpheresOneByOne(mCore, spheres, pcb);
+}
+
 bool BucketPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcb) const
 {
 	PX_ASSERT(!mCore.mDirty);
@@ -199,6 +199,7 @@ namespace Gu
 
 		PX_PHYSX_COMMON_API	bool				raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&) const;
 		PX_PHYSX_COMMON_API	bool				overlap(const ShapeData& queryVolume, PrunerOverlapCallback&) const;
+		PX_PHYSX_COMMON_API	bool				cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback&) const;
 		PX_PHYSX_COMMON_API	bool				sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&) const;
 
 							void				getGlobalBounds(PxBounds3& bounds)	const;
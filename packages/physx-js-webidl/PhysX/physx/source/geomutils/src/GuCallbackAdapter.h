@@ -31,6 +31,8 @@
 
 #include "GuPruner.h"
 #include "GuPruningPool.h"
+#include "GuBounds.h"
+#include "geometry/PxSphereGeometry.h"
 
 namespace physx
 {
@@ -64,6 +66,54 @@ namespace Gu
 		PX_NOCOPY(OverlapCallbackAdapter)
 	};
 
+	// PT: these let the tree traversal code in GuAABBTreeQuery.h find the optional query counters
+	static PX_FORCE_INLINE PrunerQueryStats* getQueryStats(const RaycastCallbackAdapter& adapter)	{ return adapter.mCallback.mStats;	}
+	static PX_FORCE_INLINE PrunerQueryStats* getQueryStats(const OverlapCallbackAdapter& adapter)	{ return adapter.mCallback.mStats;	}
+
+	struct BatchOverlapCallbackAdapter
+	{
+		PX_FORCE_INLINE	BatchOverlapCallbackAdapter(PrunerBatchOverlapCallback& pcb, const PruningPool& pool) : mCallback(pcb), mPool(pool)	{}
+
+		PX_FORCE_INLINE bool	invoke(PxU32 queryIndex, PxU32 primIndex)
+		{
+			return mCallback.invoke(queryIndex, primIndex, mPool.getObjects(), mPool.getTransforms());
+		}
+
+		PrunerBatchOverlapCallback&	mCallback;
+		const PruningPool&			mPool;
+		PX_NOCOPY(BatchOverlapCallbackAdapter)
+	};
+
+	// PT: fallback for structures without a dedicated batched traversal: runs a regular sphere overlap per query
+	struct SingleSphereOverlapAdapter : public PrunerOverlapCallback
+	{
+		SingleSphereOverlapAdapter(PrunerBatchOverlapCallback& pcb) : mCallback(pcb), mQueryIndex(0)	{}
+
+		virtual bool	invoke(PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms)
+		{
+			return mCallback.invoke(mQueryIndex, primIndex, payloads, transforms);
+		}
+
+		PrunerBatchOverlapCallback&	mCallback;
+		PxU32						mQueryIndex;
+		PX_NOCOPY(SingleSphereOverlapAdapter)
+	};
+
+	template<class PrunerT>
+	static bool overlapSpheresOneByOne(const PrunerT& pruner, const PrunerSphereBatch& batch, PrunerBatchOverlapCallback& pcb)
+	{
+		SingleSphereOverlapAdapter adapter(pcb);
+		for(PxU32 i=0;i<batch.mNbSpheres;i++)
+		{
+			const PxVec4& sphere = batch.mSpheres[i];
+			const ShapeData queryVolume(PxSphereGeometry(sphere.w), PxTransform(sphere.getXYZ()), 0.0f);
+			adapter.mQueryIndex = i;
+			if(!pruner.overlap(queryVolume, adapter))
+				return false;
+		}
+		return true;
+	}
+
 }
 
 }
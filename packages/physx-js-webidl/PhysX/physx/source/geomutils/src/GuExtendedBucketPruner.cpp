@@ -734,6 +734,48 @@ bool ExtendedBucketPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCa
 	return again;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// cull main tree callback
+struct MainTreeCullPrunerCallback
+{
+	MainTreeCullPrunerCallback(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback, const PruningPool* pool, const MergedTree* mergedTrees)
+		: mNbPlanes(nbPlanes), mPlanes(planes), mPrunerCallback(prunerCallback), mPruningPool(pool), mMergedTrees(mergedTrees)
+	{
+	}
+
+	bool invoke(PxU32 primIndex)
+	{
+		const AABBTree* aabbTree = mMergedTrees[primIndex].mTree;
+		// cull the merged tree
+		OverlapCallbackAdapter pcb(mPrunerCallback, *mPruningPool);
+		return AABBTreeCull<true, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPruningPool->getCurrentAABBTreeBounds(), *aabbTree, mNbPlanes, mPlanes, pcb);
+	}
+
+	PX_NOCOPY(MainTreeCullPrunerCallback)
+
+private:
+	const PxU32				mNbPlanes;
+	const PxPlane*			mPlanes;
+	PrunerOverlapCallback&	mPrunerCallback;
+	const PruningPool*		mPruningPool;
+	const MergedTree*		mMergedTrees;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// cull implementation
+bool ExtendedBucketPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback) const
+{
+	bool again = mCompanion ? mCompanion->cull(nbPlanes, planes, prunerCallback) : true;
+
+	if(again && mExtendedBucketPrunerMap.size())
+	{
+		MainTreeCullPrunerCallback pcb(nbPlanes, planes, prunerCallback, mPruningPool, mMergedTrees);
+		again = AABBTreeCull<true, AABBTree, BVHNode, MainTreeCullPrunerCallback>()(mBounds, *mMainTree, nbPlanes, planes, pcb);
+	}
+
+	return again;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // sweep implementation 
 bool ExtendedBucketPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback) const
@@ -39,9 +39,9 @@ Pruner* physx::Gu::createBucketPruner(PxU64 contextID)
 	return PX_NEW(BucketPruner)(contextID);
 }
 
-Pruner* physx::Gu::createAABBPruner(PxU64 contextID, bool dynamic, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode)
+Pruner* physx::Gu::createAABBPruner(PxU64 contextID, bool dynamic, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode, float rebuildCostThreshold, bool quantizedStaticTree)
 {
-	return PX_NEW(AABBPruner)(dynamic, contextID, cpType, buildStrategy, nbObjectsPerNode);
+	return PX_NEW(AABBPruner)(dynamic, contextID, cpType, buildStrategy, nbObjectsPerNode, rebuildCostThreshold, quantizedStaticTree);
 }
 
 Pruner* physx::Gu::createIncrementalPruner(PxU64 contextID)
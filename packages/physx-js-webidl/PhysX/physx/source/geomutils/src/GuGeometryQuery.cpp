@@ -48,9 +48,15 @@
 #include "GuMTD.h"
 #include "GuBounds.h"
 #include "GuDistancePointSegment.h"
+#include "GuDistanceSegmentSegment.h"
+#include "GuIntersectionRayBox.h"
 #include "GuConvexMesh.h"
 #include "GuDistancePointBox.h"
 #include "GuMidphaseInterface.h"
+#include "GuHeightField.h"
+#include "GuDistancePointTriangle.h"
+#include "CmRadixSort.h"
+#include "foundation/PxArray.h"
 #include "foundation/PxFPU.h"
 
 #include "GuConvexEdgeFlags.h"
@@ -202,6 +208,340 @@ PxU32 PxGeometryQuery::raycast(	const PxVec3& rayOrigin, const PxVec3& rayDir,
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// PT: batched queries. The single-pair functions above validate their inputs and look up the pair function for each
+// call. The batched versions do this once per batch, and use cheaper rejection tests when the target type allows it.
+
+// PT: bounds are only worth computing for targets whose exact test is significantly more expensive
+static PX_FORCE_INLINE bool cullWithBounds(PxGeometryType::Enum type)
+{
+	return type==PxGeometryType::eCONVEXMESH || type==PxGeometryType::eTRIANGLEMESH || type==PxGeometryType::eHEIGHTFIELD;
+}
+
+static PX_FORCE_INLINE bool rayTouchesBounds(const PxBounds3& bounds, const PxVec3& origin, const PxVec3& unitDir, PxReal maxDist)
+{
+	float tnear, tfar;
+	if(intersectRayAABB(bounds.minimum, bounds.maximum, origin, unitDir, tnear, tfar)==-1)
+		return false;
+	return tnear<=maxDist;
+}
+
+PxU32 PxGeometryQuery::raycastBatch(PxU32 nbRays, const PxVec3* PX_RESTRICT origins, const PxVec3* PX_RESTRICT unitDirs, const PxReal* PX_RESTRICT maxDists,
+									const PxGeometry& geom, const PxTransform& pose, PxHitFlags hitFlags,
+									PxGeomRaycastHit* PX_RESTRICT rayHits, bool* PX_RESTRICT hitResults,
+									PxGeometryQueryFlags queryFlags, PxRaycastThreadContext* threadContext)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(pose.isValid(), "PxGeometryQuery::raycastBatch(): pose is not valid.", 0);
+
+	const RaycastFunc func = gRaycastMap[geom.getType()];
+
+	const bool cull = cullWithBounds(geom.getType());
+	PxBounds3 bounds;
+	if(cull)
+	{
+		// PT: slightly fattened so that rays grazing the surface are still sent to the exact test
+		Gu::computeBounds(bounds, geom, pose, 0.0f, 1.0f);
+		bounds.fattenFast(1e-4f);
+	}
+
+	PxU32 nbHits = 0;
+	for(PxU32 i=0;i<nbRays;i++)
+	{
+		const PxVec3& origin = origins[i];
+		const PxVec3& unitDir = unitDirs[i];
+		const PxReal maxDist = maxDists[i];
+
+		bool hit = false;
+#if PX_CHECKED
+		if(!origin.isFinite() || !unitDir.isFinite() || !(maxDist>=0.0f) || !PxIsFinite(maxDist) || PxAbs(unitDir.magnitudeSquared()-1)>=1e-4f)
+			PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxGeometryQuery::raycastBatch(): ray %d is not valid.", i);
+		else
+#endif
+		if(!cull || rayTouchesBounds(bounds, origin, unitDir, maxDist))
+			hit = func(geom, pose, origin, unitDir, maxDist, hitFlags, 1, rayHits + i, sizeof(PxGeomRaycastHit), threadContext)!=0;
+
+		if(hitResults)
+			hitResults[i] = hit;
+		nbHits += PxU32(hit);
+	}
+	return nbHits;
+}
+
+namespace
+{
+	// PT: sphere targets of a sphere or capsule query, gathered in SoA form and tested four at a time
+	struct SphereBatch4
+	{
+		PX_ALIGN(16, PxReal	mX[4]);
+		PX_ALIGN(16, PxReal	mY[4]);
+		PX_ALIGN(16, PxReal	mZ[4]);
+		PX_ALIGN(16, PxReal	mRadius[4]);
+		PxU32				mIndices[4];
+		PxU32				mCount;
+
+		PX_FORCE_INLINE	SphereBatch4() : mCount(0)	{}
+
+		PX_FORCE_INLINE	void	add(PxU32 index, const PxVec3& center, PxReal radius)
+		{
+			PX_ASSERT(mCount<4);
+			mX[mCount] = center.x;
+			mY[mCount] = center.y;
+			mZ[mCount] = center.z;
+			mRadius[mCount] = radius;
+			mIndices[mCount] = index;
+			mCount++;
+		}
+
+		// PT: query segment is (p0, p0 + dir), invDD is 1/|dir|^2 or 0 for sphere queries
+		PxU32	flush(const PxVec3& p0, const PxVec3& dir, PxReal invDD, PxReal radius, bool* PX_RESTRICT results)
+		{
+			using namespace aos;
+
+			for(PxU32 j=mCount;j<4;j++)
+				mX[j] = mY[j] = mZ[j] = mRadius[j] = 0.0f;
+
+			const Vec4V rX = V4Sub(V4LoadA(mX), V4Load(p0.x));
+			const Vec4V rY = V4Sub(V4LoadA(mY), V4Load(p0.y));
+			const Vec4V rZ = V4Sub(V4LoadA(mZ), V4Load(p0.z));
+			const Vec4V dX = V4Load(dir.x);
+			const Vec4V dY = V4Load(dir.y);
+			const Vec4V dZ = V4Load(dir.z);
+
+			// PT: closest point on the query segment, then squared distance to the sphere centers
+			const Vec4V proj = V4MulAdd(rZ, dZ, V4MulAdd(rY, dY, V4Mul(rX, dX)));
+			const Vec4V t = V4Clamp(V4Mul(proj, V4Load(invDD)), V4Zero(), V4One());
+			const Vec4V eX = V4NegMulSub(t, dX, rX);
+			const Vec4V eY = V4NegMulSub(t, dY, rY);
+			const Vec4V eZ = V4NegMulSub(t, dZ, rZ);
+			const Vec4V sqDist = V4MulAdd(eZ, eZ, V4MulAdd(eY, eY, V4Mul(eX, eX)));
+
+			const Vec4V sumRadius = V4Add(V4LoadA(mRadius), V4Load(radius));
+			const PxU32 mask = BGetBitMask(V4IsGrtrOrEq(V4Mul(sumRadius, sumRadius), sqDist)) & ((1<<mCount)-1);
+
+			if(results)
+			{
+				for(PxU32 j=0;j<mCount;j++)
+					results[mIndices[j]] = (mask & (1<<j))!=0;
+			}
+			mCount = 0;
+			return PxU32(PxBitCount(mask));
+		}
+	};
+}
+
+PxU32 PxGeometryQuery::overlapBatch(const PxGeometry& geom0, const PxTransform& pose0,
+									PxU32 nbGeoms, const PxGeometry* const* PX_RESTRICT geoms, const PxTransform* PX_RESTRICT poses,
+									bool* PX_RESTRICT overlapResults,
+									PxGeometryQueryFlags queryFlags, PxOverlapThreadContext* threadContext)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(pose0.isValid(), "PxGeometryQuery::overlapBatch(): pose0 is not valid.", 0);
+
+	// PT: sphere and capsule queries are segments with a radius, tested directly against sphere and capsule targets
+	const PxGeometryType::Enum type0 = geom0.getType();
+	const bool segmentQuery = type0==PxGeometryType::eSPHERE || type0==PxGeometryType::eCAPSULE;
+
+	Capsule queryCapsule(pose0.p, pose0.p, 0.0f);
+	if(type0==PxGeometryType::eSPHERE)
+		queryCapsule.radius = static_cast<const PxSphereGeometry&>(geom0).radius;
+	else if(type0==PxGeometryType::eCAPSULE)
+		getCapsule(queryCapsule, static_cast<const PxCapsuleGeometry&>(geom0), pose0);
+
+	const PxVec3 queryDir = queryCapsule.p1 - queryCapsule.p0;
+	const PxReal dd = queryDir.magnitudeSquared();
+	const PxReal invDD = dd>PX_EPS_F32 ? 1.0f/dd : 0.0f;
+
+	SphereBatch4 spheres;
+	PxU32 nbOverlaps = 0;
+	for(PxU32 i=0;i<nbGeoms;i++)
+	{
+		const PxGeometry& geom1 = *geoms[i];
+		const PxTransform& pose1 = poses[i];
+		const PxGeometryType::Enum type1 = geom1.getType();
+
+		bool hit = false;
+#if PX_CHECKED
+		if(!pose1.isValid())
+			PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxGeometryQuery::overlapBatch(): pose %d is not valid.", i);
+		else
+#endif
+		if(segmentQuery && type1==PxGeometryType::eSPHERE)
+		{
+			spheres.add(i, pose1.p, static_cast<const PxSphereGeometry&>(geom1).radius);
+			if(spheres.mCount==4)
+				nbOverlaps += spheres.flush(queryCapsule.p0, queryDir, invDD, queryCapsule.radius, overlapResults);
+			continue;
+		}
+		else if(segmentQuery && type1==PxGeometryType::eCAPSULE)
+		{
+			Capsule targetCapsule;
+			getCapsule(targetCapsule, static_cast<const PxCapsuleGeometry&>(geom1), pose1);
+
+			const PxReal sumRadius = queryCapsule.radius + targetCapsule.radius;
+			hit = distanceSegmentSegmentSquared(queryCapsule.p0, queryDir, targetCapsule.p0, targetCapsule.computeDirection()) <= sumRadius*sumRadius;
+		}
+		else
+			hit = Gu::overlap(geom0, pose0, geom1, pose1, gGeomOverlapMethodTable, threadContext);
+
+		if(overlapResults)
+			overlapResults[i] = hit;
+		nbOverlaps += PxU32(hit);
+	}
+
+	if(spheres.mCount)
+		nbOverlaps += spheres.flush(queryCapsule.p0, queryDir, invDD, queryCapsule.radius, overlapResults);
+
+	return nbOverlaps;
+}
+
+PxU32 PxGeometryQuery::sweepBatch(	const PxVec3& unitDir, const PxReal distance,
+									const PxGeometry& geom0, const PxTransform& pose0,
+									PxU32 nbGeoms, const PxGeometry* const* PX_RESTRICT geoms, const PxTransform* PX_RESTRICT poses,
+									PxGeomSweepHit* PX_RESTRICT sweepHits, bool* PX_RESTRICT hitResults,
+									PxHitFlags hitFlags, const PxReal inflation,
+									PxGeometryQueryFlags queryFlags, PxSweepThreadContext* threadContext)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(pose0.isValid(), "PxGeometryQuery::sweepBatch(): pose0 is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(unitDir.isFinite(), "PxGeometryQuery::sweepBatch(): unitDir is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(PxIsFinite(distance), "PxGeometryQuery::sweepBatch(): distance is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL((distance >= 0.0f && !(hitFlags & PxHitFlag::eASSUME_NO_INITIAL_OVERLAP)) || distance > 0.0f,
+		"PxGeometryQuery::sweepBatch(): sweep distance must be >=0 or >0 with eASSUME_NO_INITIAL_OVERLAP.", 0);
+#if PX_CHECKED
+	if(!PxGeometryQuery::isValid(geom0))
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "Provided geometry 0 is not valid");
+		return 0;
+	}
+#endif
+
+	const GeomSweepFuncs& sf = gGeomSweepFuncs;
+	const bool precise = hitFlags & PxHitFlag::ePRECISE_SWEEP;
+
+	// PT: the swept shape is built once for the whole batch, same as in sweep()
+	const PxGeometryType::Enum type0 = geom0.getType();
+	PxCapsuleGeometry capsuleGeom;
+	Capsule worldCapsule;
+	Box box;
+	switch(type0)
+	{
+		case PxGeometryType::eSPHERE:
+		{
+			const PxReal radius = static_cast<const PxSphereGeometry&>(geom0).radius;
+			capsuleGeom = PxCapsuleGeometry(radius, 0.0f);
+			worldCapsule = Capsule(pose0.p, pose0.p, radius);
+		}
+		break;
+
+		case PxGeometryType::eCAPSULE:
+		{
+			capsuleGeom = static_cast<const PxCapsuleGeometry&>(geom0);
+			getCapsule(worldCapsule, capsuleGeom, pose0);
+		}
+		break;
+
+		case PxGeometryType::eBOX:
+			buildFrom(box, pose0.p, static_cast<const PxBoxGeometry&>(geom0).halfExtents, pose0.q);
+		break;
+
+		case PxGeometryType::eCONVEXMESH:
+		break;
+
+		default:
+			PX_CHECK_MSG(false, "PxGeometryQuery::sweepBatch(): first geometry object parameter must be sphere, capsule, box or convex geometry.");
+			return 0;
+	}
+
+	// PT: bounds of the whole sweep, to reject targets it cannot reach
+	PxBounds3 sweptBounds;
+	Gu::computeBounds(sweptBounds, geom0, pose0, 0.0f, 1.0f);
+	const PxVec3 motion = unitDir * distance;
+	sweptBounds.include(PxBounds3(sweptBounds.minimum + motion, sweptBounds.maximum + motion));
+	sweptBounds.fattenFast(inflation + 1e-4f);
+
+	PxU32 nbHits = 0;
+	for(PxU32 i=0;i<nbGeoms;i++)
+	{
+		const PxGeometry& geom1 = *geoms[i];
+		const PxTransform& pose1 = poses[i];
+		const PxGeometryType::Enum type1 = geom1.getType();
+
+		bool hit = false;
+#if PX_CHECKED
+		if(!pose1.isValid() || !PxGeometryQuery::isValid(geom1))
+			PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxGeometryQuery::sweepBatch(): target %d is not valid.", i);
+		else
+#endif
+		if(type1==PxGeometryType::ePLANE || sweptBounds.intersects(Gu::computeBounds(geom1, pose1)))
+		{
+			PxGeomSweepHit& sweepHit = sweepHits[i];
+			if(type0==PxGeometryType::eBOX)
+			{
+				const SweepBoxFunc func = precise ? sf.preciseBoxMap[type1] : sf.boxMap[type1];
+				hit = func(geom1, pose1, static_cast<const PxBoxGeometry&>(geom0), pose0, box, unitDir, distance, sweepHit, hitFlags, inflation, threadContext);
+			}
+			else if(type0==PxGeometryType::eCONVEXMESH)
+			{
+				const SweepConvexFunc func = sf.convexMap[type1];
+				hit = func(geom1, pose1, static_cast<const PxConvexMeshGeometry&>(geom0), pose0, unitDir, distance, sweepHit, hitFlags, inflation, threadContext);
+			}
+			else
+			{
+				const SweepCapsuleFunc func = precise ? sf.preciseCapsuleMap[type1] : sf.capsuleMap[type1];
+				hit = func(geom1, pose1, capsuleGeom, pose0, worldCapsule, unitDir, distance, sweepHit, hitFlags, inflation, threadContext);
+			}
+		}
+
+		if(hitResults)
+			hitResults[i] = hit;
+		nbHits += PxU32(hit);
+	}
+	return nbHits;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool PxGeometryQuery::sweepAndDepenetrate(	const PxVec3& unitDir, const PxReal distance,
+											const PxGeometry& geom0, const PxTransform& pose0,
+											const PxGeometry& geom1, const PxTransform& pose1,
+											PxGeomSweepHit& sweepHit, PxVec3& depenetration,
+											PxHitFlags hitFlags, const PxReal inflation, const PxReal separation,
+											PxGeometryQueryFlags queryFlags, PxSweepThreadContext* threadContext)
+{
+	PX_CHECK_AND_RETURN_VAL(PxIsFinite(separation) && separation >= 0.0f, "PxGeometryQuery::sweepAndDepenetrate(): separation must be >= 0.", false);
+
+	depenetration = PxVec3(0.0f);
+
+	// PT: the initial overlap must be detected, and its MTD is what we use to depenetrate
+	hitFlags |= PxHitFlag::eMTD;
+	hitFlags &= ~PxHitFlag::eASSUME_NO_INITIAL_OVERLAP;
+
+	if(!sweep(unitDir, distance, geom0, pose0, geom1, pose1, sweepHit, hitFlags, inflation, queryFlags, threadContext))
+		return false;
+
+	if(!sweepHit.hadInitialOverlap())
+		return true;
+
+	// PT: with eMTD the initial overlap hit has distance = -depth and the normal is the depenetration direction. The normal
+	// can be zero when the MTD could not be computed, in which case there is nothing better to report than the overlap.
+	if(sweepHit.normal.isZero())
+		return true;
+
+	const PxVec3 delta = sweepHit.normal * (separation - sweepHit.distance);
+	const PxTransform depenetratedPose(pose0.p + delta, pose0.q);
+
+	PxGeomSweepHit hit;
+	const bool status = sweep(unitDir, distance, geom0, depenetratedPose, geom1, pose1, hit, hitFlags, inflation, queryFlags, threadContext);
+
+	depenetration = delta;
+	if(status)
+		sweepHit = hit;
+	// PT: no hit after depenetration: the sweep is free
+	return status;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool pointConvexDistance(PxVec3& normal_, PxVec3& closestPoint_, PxReal& sqDistance, const PxVec3& pt, const ConvexMesh* convexMesh, const PxMeshScale& meshScale, const PxTransform32& convexPose);
 
 PxReal PxGeometryQuery::pointDistance(const PxVec3& point, const PxGeometry& geom, const PxTransform& pose, PxVec3* closestPoint, PxU32* closestIndex, PxGeometryQueryFlags queryFlags)
@@ -330,6 +670,232 @@ PxReal PxGeometryQuery::pointDistance(const PxVec3& point, const PxGeometry& geo
 	return -1.0f;
 }
 
+namespace
+{
+	PX_FORCE_INLINE PxU32 spreadBits10(PxReal coord)
+	{
+		PxU32 x = PxMin(PxU32(coord), 1023u);
+		x = (x | (x << 16)) & 0x030000ff;
+		x = (x | (x << 8)) & 0x0300f00f;
+		x = (x | (x << 4)) & 0x030c30c3;
+		x = (x | (x << 2)) & 0x09249249;
+		return x;
+	}
+
+	// PT: sorts the points along a Morton curve so that consecutive queries are close to each other. The closest point
+	// found for a query then gives a tight initial radius for the next one.
+	const PxU32* sortPointsSpatially(PxU32 nbPoints, const PxVec3* PX_RESTRICT points, PxArray<PxU32>& keys, Cm::RadixSortBuffered& sorter)
+	{
+		PxBounds3 bounds = PxBounds3::empty();
+		for(PxU32 i=0;i<nbPoints;i++)
+			bounds.include(points[i]);
+
+		const PxVec3 extents = bounds.getDimensions();
+		const PxVec3 scale(	extents.x > 0.0f ? 1023.0f / extents.x : 0.0f,
+							extents.y > 0.0f ? 1023.0f / extents.y : 0.0f,
+							extents.z > 0.0f ? 1023.0f / extents.z : 0.0f);
+
+		keys.resizeUninitialized(nbPoints);
+		for(PxU32 i=0;i<nbPoints;i++)
+		{
+			const PxVec3 p = (points[i] - bounds.minimum).multiply(scale);
+			keys[i] = spreadBits10(p.x) | (spreadBits10(p.y)<<1) | (spreadBits10(p.z)<<2);
+		}
+		return sorter.Sort(keys.begin(), nbPoints, Cm::RADIX_UNSIGNED).GetRanks();
+	}
+
+	// PT: upper bound for the distance from 'point' to the surface, given a point known to be on the surface. Slightly
+	// enlarged so that the query still finds the closest triangle despite FP errors.
+	PX_FORCE_INLINE PxReal getDistanceBound(const PxVec3& point, const PxVec3& surfacePoint)
+	{
+		return (point - surfacePoint).magnitude() * 1.0001f + 1e-4f;
+	}
+
+	// PT: closest triangle of a heightfield within 'radius' of a point in shape space, looking at the cells in the given range
+	bool pointHeightFieldDistance(const HeightField& hf, const PxVec3& hfScale, const PxVec3& point, PxReal radius,
+								PxU32 minRow, PxU32 maxRow, PxU32 minColumn, PxU32 maxColumn,
+								PxU32& index, PxVec3& closestPt)
+	{
+		const PxU32 nbColumns = hf.getNbColumnsFast();
+		PxReal bestDist2 = radius * radius;
+		bool found = false;
+		for(PxU32 row=minRow;row<=maxRow;row++)
+		{
+			for(PxU32 column=minColumn;column<=maxColumn;column++)
+			{
+				const PxU32 cell = row * nbColumns + column;
+
+				const PxReal h0 = hf.getHeight(cell);
+				const PxReal h1 = hf.getHeight(cell + 1);
+				const PxReal h2 = hf.getHeight(cell + nbColumns);
+				const PxReal h3 = hf.getHeight(cell + nbColumns + 1);
+				const PxBounds3 cellBounds(	PxVec3(PxReal(row) * hfScale.x, PxMin(PxMin(h0, h1), PxMin(h2, h3)) * hfScale.y, PxReal(column) * hfScale.z),
+											PxVec3(PxReal(row + 1) * hfScale.x, PxMax(PxMax(h0, h1), PxMax(h2, h3)) * hfScale.y, PxReal(column + 1) * hfScale.z));
+				if((cellBounds.closestPoint(point) - point).magnitudeSquared() > bestDist2)
+					continue;
+
+				for(PxU32 k=0;k<2;k++)
+				{
+					const PxU32 triangleIndex = cell * 2 + k;
+					if(hf.getTriangleMaterial(triangleIndex) == PxHeightFieldMaterial::eHOLE)
+						continue;
+
+					PxVec3 v0, v1, v2;
+					hf.getTriangleVertices(triangleIndex, row, column, v0, v1, v2);
+					v0 = v0.multiply(hfScale);
+					v1 = v1.multiply(hfScale);
+					v2 = v2.multiply(hfScale);
+
+					const PxVec3 cp = closestPtPointTriangle2(point, v0, v1, v2, v1 - v0, v2 - v0);
+					const PxReal dist2 = (cp - point).magnitudeSquared();
+					if(dist2 <= bestDist2)
+					{
+						bestDist2 = dist2;
+						closestPt = cp;
+						index = triangleIndex;
+						found = true;
+					}
+				}
+			}
+		}
+		return found;
+	}
+
+	PX_FORCE_INLINE PxU32 getCellCoord(PxReal x, PxU32 maxCoord)
+	{
+		return x <= 0.0f ? 0 : PxMin(PxU32(x), maxCoord);
+	}
+
+	// PT: the search radius starts from the given bound, or from the cell size, and doubles until a triangle is found.
+	// Once the radius covers the whole heightfield, or reaches maxDistance, the last pass is exhaustive.
+	bool pointHeightFieldDistance(const HeightField& hf, const PxVec3& hfScale, const PxVec3& point, PxReal bound, PxReal maxDistance,
+								PxU32& index, PxVec3& closestPt)
+	{
+		const PxU32 maxRow = hf.getNbRowsFast() - 2;
+		const PxU32 maxColumn = hf.getNbColumnsFast() - 2;
+
+		PxReal radius = PxMin(bound, maxDistance);
+		for(;;)
+		{
+			const PxU32 minR = getCellCoord((point.x - radius) / hfScale.x, maxRow);
+			const PxU32 maxR = getCellCoord((point.x + radius) / hfScale.x, maxRow);
+			const PxU32 minC = getCellCoord((point.z - radius) / hfScale.z, maxColumn);
+			const PxU32 maxC = getCellCoord((point.z + radius) / hfScale.z, maxColumn);
+
+			const bool lastPass = radius >= maxDistance || (!minR && maxR==maxRow && !minC && maxC==maxColumn);
+			if(pointHeightFieldDistance(hf, hfScale, point, lastPass ? maxDistance : radius, minR, maxR, minC, maxC, index, closestPt))
+				return true;
+			if(lastPass)
+				return false;
+			radius = PxMin(radius * 2.0f, maxDistance);
+		}
+	}
+}
+
+PxU32 PxGeometryQuery::pointDistanceBatch(	PxU32 nbPoints, const PxVec3* PX_RESTRICT points, const PxGeometry& geom, const PxTransform& pose, PxReal maxDistance,
+											PxReal* PX_RESTRICT distances, PxVec3* PX_RESTRICT closestPoints, PxU32* PX_RESTRICT closestIndices,
+											PxGeometryQueryFlags queryFlags)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(pose.isValid(), "PxGeometryQuery::pointDistanceBatch(): pose is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(maxDistance >= 0.0f, "PxGeometryQuery::pointDistanceBatch(): maxDistance must be positive.", 0);
+	PX_CHECK_AND_RETURN_VAL(geom.getType() == PxGeometryType::eTRIANGLEMESH || geom.getType() == PxGeometryType::eHEIGHTFIELD,
+		"PxGeometryQuery::pointDistanceBatch(): geometry object parameter must be triangle mesh or heightfield geometry.", 0);
+
+	if(!nbPoints)
+		return 0;
+
+	PxArray<PxU32> keys;
+	Cm::RadixSortBuffered sorter;
+	const PxU32* sorted = sortPointsSpatially(nbPoints, points, keys, sorter);
+
+	PxU32 nbFound = 0;
+	bool hasPrevious = false;
+	PxVec3 previousLocalPt(0.0f);	// PT: closest point of the previous query, in the space of the query
+
+	if(geom.getType() == PxGeometryType::eTRIANGLEMESH)
+	{
+		const PxTriangleMeshGeometry& meshGeom = static_cast<const PxTriangleMeshGeometry&>(geom);
+		const TriangleMesh* mesh = static_cast<const TriangleMesh*>(meshGeom.triangleMesh);
+		PX_CHECK_AND_RETURN_VAL(mesh->getConcreteType() == PxConcreteType::eTRIANGLE_MESH_BVH34,
+			"PxGeometryQuery::pointDistanceBatch(): only the BVH34 midphase data-structure is supported for meshes.", 0);
+
+		// PT: BV4 works in vertex space, so the bounds and the maximum distance are computed there. With a non-identity
+		// scale, the maximum distance is converted conservatively and results are filtered again in world space.
+		const PxMat34 world2vertex = meshGeom.scale.getInverse() * pose.getInverse();
+		const PxVec3 s = meshGeom.scale.scale.abs();
+		const PxReal minScale = PxMin(s.x, PxMin(s.y, s.z));
+		const PxReal vertexMaxDistance = meshGeom.scale.isIdentity() ? maxDistance : (minScale > 0.0f ? maxDistance / minScale : PX_MAX_F32);
+
+		for(PxU32 j=0;j<nbPoints;j++)
+		{
+			const PxU32 i = sorted[j];
+			const PxVec3 localPt = world2vertex.transform(points[i]);
+
+			PxReal bound = hasPrevious ? PxMin(getDistanceBound(localPt, previousLocalPt), vertexMaxDistance) : vertexMaxDistance;
+			PxU32 index;
+			PxReal dist;
+			PxVec3 cp;
+			Midphase::pointMeshDistance(mesh, meshGeom, pose, points[i], bound, index, dist, cp);
+			if(index == PX_INVALID_U32 && bound < vertexMaxDistance)
+				Midphase::pointMeshDistance(mesh, meshGeom, pose, points[i], vertexMaxDistance, index, dist, cp);
+
+			dist = (cp - points[i]).magnitude();
+			if(index == PX_INVALID_U32 || dist > maxDistance)
+			{
+				distances[i] = -1.0f;
+				if(closestIndices)
+					closestIndices[i] = PX_INVALID_U32;
+				continue;
+			}
+
+			hasPrevious = true;
+			previousLocalPt = world2vertex.transform(cp);
+
+			distances[i] = dist;
+			if(closestPoints)
+				closestPoints[i] = cp;
+			if(closestIndices)
+				closestIndices[i] = index;
+			nbFound++;
+		}
+	}
+	else
+	{
+		const PxHeightFieldGeometry& hfGeom = static_cast<const PxHeightFieldGeometry&>(geom);
+		const HeightField& hf = *static_cast<const HeightField*>(hfGeom.heightField);
+		const PxVec3 hfScale(hfGeom.rowScale, hfGeom.heightScale, hfGeom.columnScale);
+		const PxReal cellSize = PxMax(hfGeom.rowScale, hfGeom.columnScale);
+
+		for(PxU32 j=0;j<nbPoints;j++)
+		{
+			const PxU32 i = sorted[j];
+			const PxVec3 localPt = pose.transformInv(points[i]);
+
+			PxU32 index;
+			PxVec3 cp;
+			if(!pointHeightFieldDistance(hf, hfScale, localPt, hasPrevious ? getDistanceBound(localPt, previousLocalPt) : cellSize, maxDistance, index, cp))
+			{
+				distances[i] = -1.0f;
+				if(closestIndices)
+					closestIndices[i] = PX_INVALID_U32;
+				continue;
+			}
+
+			hasPrevious = true;
+			previousLocalPt = cp;
+
+			distances[i] = (cp - localPt).magnitude();
+			if(closestPoints)
+				closestPoints[i] = pose.transform(cp);
+			if(closestIndices)
+				closestIndices[i] = index;
+			nbFound++;
+		}
+	}
+	return nbFound;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void PxGeometryQuery::computeGeomBounds(PxBounds3& bounds, const PxGeometry& geom, const PxTransform& pose, float offset, float inflation, PxGeometryQueryFlags queryFlags)
@@ -280,6 +280,32 @@ bool IncrementalAABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir,
 	return again;
 }
 
+bool IncrementalAABBPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcbArgName) const
+{
+	bool again = true;
+
+	if(mAABBTree && mAABBTree->getNodes())
+	{
+		OverlapCallbackAdapter pcb(pcbArgName, mPool);
+		again = AABBTreeCull<true, IncrementalAABBTree, IncrementalAABBTreeNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, nbPlanes, planes, pcb);
+	}
+
+	return again;
+}
+
+bool IncrementalAABBPruner::overlapSpheres(const PrunerSphereBatch& spheres, PrunerBatchOverlapCallback& pcbArgName) const
+{
+	bool again = true;
+
+	if(mAABBTree && mAABBTree->getNodes())
+	{
+		BatchOverlapCallbackAdapter pcb(pcbArgName, mPool);
+		again = AABBTreeSpheresOverlap<true, IncrementalAABBTree, IncrementalAABBTreeNode, BatchOverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, spheres, pcb);
+	}
+
+	return again;
+}
+
 // This isn't part of the pruner virtual interface, but it is part of the public interface
 // of AABBPruner - it gets called by SqManager to force a rebuild, and requires a commit() before 
 // queries can take place
@@ -318,6 +318,21 @@ bool IncrementalAABBPrunerCore::overlap(const ShapeData& queryVolume, PrunerOver
 	return again;
 }
 
+bool IncrementalAABBPrunerCore::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcbArgName) const
+{
+	bool again = true;
+	OverlapCallbackAdapter pcb(pcbArgName, *mPool);
+
+	for(PxU32 i = 0; i < NUM_TREES; i++)
+	{
+		const CoreTree& tree = mAABBTree[i];
+		if(tree.tree && tree.tree->getNodes() && again)
+			again = AABBTreeCull<true, IncrementalAABBTree, IncrementalAABBTreeNode, OverlapCallbackAdapter>()(mPool->getCurrentAABBTreeBounds(), *tree.tree, nbPlanes, planes, pcb);
+	}
+
+	return again;
+}
+
 bool IncrementalAABBPrunerCore::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcbArgName) const
 {
 	bool again = true;
@@ -200,6 +200,45 @@ static void read32BitIndices(PxInputStream& stream, void* tris, PxU32 nbIndices,
 	}
 }
 
+// PT: see compressIndices() in GuCookingTriangleMesh.cpp
+static bool readCompressedIndices(PxInputStream& stream, void* tris, PxU32 nbIndices, const bool has16BitIndices, const bool mismatch)
+{
+	const PxU32 nbBytes = readDword(mismatch, stream);
+	PxU8* bytes = PX_ALLOCATE(PxU8, nbBytes, "compressed indices");
+	stream.read(bytes, nbBytes);
+
+	PxU16* tris16 = reinterpret_cast<PxU16*>(tris);
+	PxU32* tris32 = reinterpret_cast<PxU32*>(tris);
+	const PxU8* current = bytes;
+	const PxU8* last = bytes + nbBytes;
+	PxU32 previous = 0;
+	for(PxU32 i=0;i<nbIndices;i++)
+	{
+		PxU32 value = 0;
+		PxU32 shift = 0;
+		PxU8 b;
+		do
+		{
+			if(current==last || shift>28)
+			{
+				PX_FREE(bytes);
+				return false;
+			}
+			b = *current++;
+			value |= PxU32(b & 0x7f)<<shift;
+			shift += 7;
+		}while(b & 0x80);
+
+		previous += PxU32(PxI32(value>>1) ^ -PxI32(value & 1));
+		if(has16BitIndices)
+			tris16[i] = PxTo16(previous);
+		else
+			tris32[i] = previous;
+	}
+	PX_FREE(bytes);
+	return true;
+}
+
 static TriangleMeshData* loadMeshData(PxInputStream& stream)
 {
 	// Import header
@@ -234,8 +273,11 @@ static TriangleMeshData* loadMeshData(PxInputStream& stream)
 	TriangleMeshData* data;
 	if(midphaseID==PxMeshMidPhase::eBVH33)
 		data = PX_NEW(RTreeTriangleData);
-	else if(midphaseID==PxMeshMidPhase::eBVH34)
+	else if(midphaseID==PxMeshMidPhase::eBVH34 || midphaseID==PxMeshMidPhase::eBVH38)
+	{
 		data = PX_NEW(BV4TriangleData);
+		data->mType = PxMeshMidPhase::Enum(midphaseID);
+	}
 	else return NULL;
 
 	// Import mesh
@@ -246,19 +288,43 @@ static TriangleMeshData* loadMeshData(PxInputStream& stream)
 	//ML: this will allocate CPU triangle indices and GPU triangle indices if we have GRB data built
 	void* tris = data->allocateTriangles(nbTris, force32, serialFlags & IMSF_GRB_DATA);
 
-	stream.read(verts, sizeof(PxVec3)*data->mNbVertices);
-	if(mismatch)
+	if(serialFlags & IMSF_QUANTIZED_VERTICES)
 	{
+		PxVec3 minimum, scale;
+		readFloatBuffer(&minimum.x, 3, mismatch, stream);
+		readFloatBuffer(&scale.x, 3, mismatch, stream);
 		for(PxU32 i=0;i<data->mNbVertices;i++)
 		{
-			flip(verts[i].x);
-			flip(verts[i].y);
-			flip(verts[i].z);
+			PxU16 q[3];
+			readWordBuffer(q, 3, mismatch, stream);
+			verts[i] = dequantizeMeshVertex(q, minimum, scale);
+		}
+	}
+	else
+	{
+		stream.read(verts, sizeof(PxVec3)*data->mNbVertices);
+		if(mismatch)
+		{
+			for(PxU32 i=0;i<data->mNbVertices;i++)
+			{
+				flip(verts[i].x);
+				flip(verts[i].y);
+				flip(verts[i].z);
+			}
 		}
 	}
 	//TODO: stop support for format conversion on load!!
 	const PxU32 nbIndices = 3*data->mNbTriangles;
-	if(serialFlags & IMSF_8BIT_INDICES)
+	if(serialFlags & IMSF_COMPRESSED_INDICES)
+	{
+		if(!readCompressedIndices(stream, tris, nbIndices, data->has16BitIndices(), mismatch))
+		{
+			outputError<PxErrorCode::eINTERNAL_ERROR>(__LINE__, "Loading triangle mesh failed: corrupted compressed indices.");
+			PX_DELETE(data);
+			return NULL;
+		}
+	}
+	else if(serialFlags & IMSF_8BIT_INDICES)
 		read8BitIndices(stream, tris, nbIndices, data->has16BitIndices());
 	else if(serialFlags & IMSF_16BIT_INDICES)
 		read16BitIndices(stream, tris, nbIndices, data->has16BitIndices(), mismatch);
@@ -302,7 +368,7 @@ static TriangleMeshData* loadMeshData(PxInputStream& stream)
 			return NULL;
 		}
 	}
-	else if(midphaseID==PxMeshMidPhase::eBVH34)
+	else if(midphaseID==PxMeshMidPhase::eBVH34 || midphaseID==PxMeshMidPhase::eBVH38)
 	{
 		BV4TriangleData* bv4data = static_cast<BV4TriangleData*>(data);
 		if(!bv4data->mBV4Tree.load(stream, mismatch))
@@ -473,7 +539,7 @@ PxTriangleMesh* MeshFactory::createTriangleMesh(TriangleMeshData& data)
 	{
 		PX_NEW_SERIALIZED(np, RTreeTriangleMesh)(this, data);
 	}
-	else if(data.mType==PxMeshMidPhase::eBVH34)
+	else if(data.mType==PxMeshMidPhase::eBVH34 || data.mType==PxMeshMidPhase::eBVH38)
 	{
 		PX_NEW_SERIALIZED(np, BV4TriangleMesh)(this, data);
 	}
@@ -28,6 +28,7 @@
 
 #include "GuPruningPool.h"
 #include "foundation/PxMemory.h"
+#include "foundation/PxBitMap.h"
 #include "common/PxProfileZone.h"
 
 using namespace physx;
@@ -81,7 +82,7 @@ bool PruningPool::resize(PxU32 newCapacity)
 	if(mObjects)		PxMemCopy(newData, mObjects, mNbObjects*sizeof(PrunerPayload));
 	if(mTransforms)		PxMemCopy(newTransforms, mTransforms, mNbObjects*sizeof(PxTransform));
 	if(mIndexToHandle)	PxMemCopy(newIndexToHandle, mIndexToHandle, mNbObjects*sizeof(PrunerHandle));
-	if(mHandleToIndex)	PxMemCopy(newHandleToIndex, mHandleToIndex, mMaxNbObjects*sizeof(PoolIndex));	// PT: why mMaxNbObjects here? on purpose?
+	if(mHandleToIndex)	PxMemCopy(newHandleToIndex, mHandleToIndex, PxMin(mMaxNbObjects, newCapacity)*sizeof(PoolIndex));	// PT: why mMaxNbObjects here? on purpose?
 	mMaxNbObjects = newCapacity;
 
 	PX_FREE(mIndexToHandle);
@@ -102,6 +103,40 @@ void PruningPool::preallocate(PxU32 newCapacity)
 		resize(newCapacity);
 }
 
+void PruningPool::shrinkMemory()
+{
+	PX_PROFILE_ZONE("PruningPool::shrinkMemory", mContextID);
+
+	// PT: handles are stable, so the pool cannot shrink below the highest live handle. Handles issued
+	// so far are always [0, nbHandles), either live or in the recycled list.
+	PxU32 nbHandles = 0;
+	for(PxU32 i=0;i<mNbObjects;i++)
+		nbHandles = PxMax(nbHandles, mIndexToHandle[i] + 1);
+
+	const PxU32 newCapacity = PxMax<PxU32>(nbHandles, 64);
+	if(newCapacity>=mMaxNbObjects)
+		return;
+
+	if(!resize(newCapacity))
+		return;
+
+	// PT: rebuild the recycled list with the handles that survived, lowest first so that they get reused before higher ones
+	PxBitMap liveHandles;
+	liveHandles.resize(nbHandles);
+	for(PxU32 i=0;i<mNbObjects;i++)
+		liveHandles.set(mIndexToHandle[i]);
+
+	mFirstRecycledHandle = INVALID_PRUNERHANDLE;
+	for(PxU32 h=nbHandles;h--;)
+	{
+		if(!liveHandles.test(h))
+		{
+			mHandleToIndex[h] = mFirstRecycledHandle;
+			mFirstRecycledHandle = h;
+		}
+	}
+}
+
 PxU32 PruningPool::addObjects(PrunerHandle* results, const PxBounds3* bounds, const PrunerPayload* data, const PxTransform* transforms, PxU32 count)
 {
 	PX_PROFILE_ZONE("PruningPool::addObjects", mContextID);
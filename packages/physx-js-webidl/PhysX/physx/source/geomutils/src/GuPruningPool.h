@@ -100,6 +100,8 @@ namespace Gu
 
 						void					updateAndInflateBounds(const PrunerHandle* handles, const PxU32* boundsIndices, const PxBounds3* newBounds, const PxTransform32* newTransforms, PxU32 count, float epsilon);
 						void					preallocate(PxU32 entries);
+						// Releases unused capacity, down to the highest live handle
+						void					shrinkMemory();
 //	protected:
 
 						PxU32					mNbObjects;			//!< Current number of objects
@@ -68,7 +68,8 @@ void QuerySystem::PrunerExt::flushMemory()
 
 	// PT: TODO: flush bitmap here
 
-	// PT: TODO: flush pruner here?
+	if(mPruner)
+		mPruner->shrinkMemory();
 }
 
 // PT: ok things became more complicated than before here. We'd like to delay the update of *both* the transform and the bounds,
@@ -74,6 +74,10 @@ bool SAH_Buffers::split(PxU32& leftCount, PxU32 nb, const PxU32* PX_RESTRICT pri
 				keys[i] = center;
 			}
 
+			// PT: the sorters would otherwise reuse the ranks of the previous call as a starting point when the number of keys
+			// doesn't change, which makes the order of equal keys (and thus the tree) depend on which nodes were split before.
+			// We want the split of a node to only depend on its primitives, so that subtrees can be built in any order.
+			mSorters[axis].invalidateRanks();
 			sorted = mSorters[axis].Sort(keys, nb).GetRanks();
 		}
 
@@ -431,6 +431,43 @@ namespace Gu
 		yi = id / sizeX;
 	}
 
+	//Returns the unsigned distance from the query point to the mesh. lastTriangle is used to warm-start the query and receives the closest triangle.
+	static PxReal closestDistanceToTrimesh(const PxVec3& queryPoint, Gu::BVHNode* tree, const PxU32* indices, const PxVec3* vertices, PxI32& lastTriangle)
+	{
+		ClosestDistanceToTrimeshTraversalController cd(indices, vertices, tree);
+		cd.setQueryPoint(queryPoint);
+
+		if (lastTriangle != -1)
+		{
+			//Warm-start the query with a lower-bound distance based on the triangle found by the previous query.
+			//This helps to cull the tree traversal more effectively in the closest point query.
+			PxU32 i0 = indices[3 * lastTriangle];
+			PxU32 i1 = indices[3 * lastTriangle + 1];
+			PxU32 i2 = indices[3 * lastTriangle + 2];
+
+			//const PxVec3 closest = Gu::closestPtPointTriangle2UnitBox(queryPoint, vertices[i0], vertices[i1], vertices[i2]);
+			//PxReal d2 = (closest - queryPoint).magnitudeSquared();
+
+			aos::FloatV t1, t2;
+			aos::Vec3V q = aos::V3LoadU(queryPoint);
+			aos::Vec3V a = aos::V3LoadU(vertices[i0]);
+			aos::Vec3V b = aos::V3LoadU(vertices[i1]);
+			aos::Vec3V c = aos::V3LoadU(vertices[i2]);
+			aos::Vec3V cp;
+			aos::FloatV dist2 = Gu::distancePointTriangleSquared2UnitBox(q, a, b, c, t1, t2, cp);
+			PxReal d2;
+			aos::FStore(dist2, &d2);
+			PxVec3 closest;
+			aos::V3StoreU(cp, closest);
+
+			cd.setClosestStart(d2, lastTriangle, closest);
+		}
+
+		Gu::traverseBVH(tree, cd);
+		lastTriangle = cd.getClosestTriId();
+		return (cd.getClosestPoint() - queryPoint).magnitude();
+	}
+
 	void* computeSDFThreadJob(void* data)
 	{
 		SDFCalculationData& d = *reinterpret_cast<SDFCalculationData*>(data);
@@ -542,40 +579,7 @@ namespace Gu
 
 						PxVec3 queryPoint = d.pointSampler->getPoint(x, y, z);
 
-						ClosestDistanceToTrimeshTraversalController cd(d.indices, d.vertices, d.tree->begin());
-						cd.setQueryPoint(queryPoint);
-
-						if (lastTriangle != -1)
-						{
-							//Warm-start the query with a lower-bound distance based on the triangle found by the previous query.
-							//This helps to cull the tree traversal more effectively in the closest point query.
-							PxU32 i0 = d.indices[3 * lastTriangle];
-							PxU32 i1 = d.indices[3 * lastTriangle + 1];
-							PxU32 i2 = d.indices[3 * lastTriangle + 2];
-
-							//const PxVec3 closest = Gu::closestPtPointTriangle2UnitBox(queryPoint, d.vertices[i0], d.vertices[i1], d.vertices[i2]);
-							//PxReal d2 = (closest - queryPoint).magnitudeSquared();
-
-							aos::FloatV t1, t2;
-							aos::Vec3V q = aos::V3LoadU(queryPoint);
-							aos::Vec3V a = aos::V3LoadU(d.vertices[i0]);
-							aos::Vec3V b = aos::V3LoadU(d.vertices[i1]);
-							aos::Vec3V c = aos::V3LoadU(d.vertices[i2]);
-							aos::Vec3V cp;
-							aos::FloatV dist2 = Gu::distancePointTriangleSquared2UnitBox(q, a, b, c, t1, t2, cp);
-							PxReal d2;
-							aos::FStore(dist2, &d2);
-							PxVec3 closest;
-							aos::V3StoreU(cp, closest);							
-
-							cd.setClosestStart(d2, lastTriangle, closest);
-						}
-
-						Gu::traverseBVH(d.tree->begin(), cd);
-						PxVec3 closestPoint = cd.getClosestPoint();
-						PxReal closestDistance = (closestPoint - queryPoint).magnitude();
-
-						lastTriangle = cd.getClosestTriId();
+						PxReal closestDistance = closestDistanceToTrimesh(queryPoint, d.tree->begin(), d.indices, d.vertices, lastTriangle);
 
 						PxReal sign = 1.f;
 						if (!d.optimizeInsideOutsideCalculation)
@@ -1200,7 +1204,83 @@ namespace Gu
 		}
 	}
 
-	void SDFUsingWindingNumbersSparse(const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
+	struct NarrowBandCalculationData
+	{
+		const PxVec3* vertices;
+		const PxU32* indices;
+		Gu::BVHNode* tree;
+		PxHashMap<PxU32, Gu::ClusterApproximation>* clusters;
+		const GridQueryPointSampler* pointSampler;
+		const PxReal* sdfCoarse;
+		PxU32 coarseWidth;
+		PxU32 coarseHeight;
+		const PxU32* blocks;		//Coordinates of the candidate subgrid blocks, 3 per block
+		PxReal* samples;			//(cellsPerSubgrid+1)^3 samples per candidate block
+		PxU32 cellsPerSubgrid;
+		PxI32 end;
+		PxI32* progress;
+	};
+
+	//Evaluates the fine samples of the candidate blocks only, one block at a time
+	void* computeNarrowBandThreadJob(void* data)
+	{
+		NarrowBandCalculationData& d = *reinterpret_cast<NarrowBandCalculationData*>(data);
+
+		const PxU32 s = d.cellsPerSubgrid + 1;
+		const PxVec3 cellSize = d.pointSampler->getActiveCellSize();
+		PxI32 lastTriangle = -1;
+
+		PxI32 block = physx::PxAtomicIncrement(d.progress) - 1;
+		while (block < d.end)
+		{
+			const PxU32* b = d.blocks + 3 * block;
+			PxReal* samples = d.samples + block * s * s * s;
+			for (PxU32 zLocal = 0; zLocal < s; ++zLocal)
+				for (PxU32 yLocal = 0; yLocal < s; ++yLocal)
+					for (PxU32 xLocal = 0; xLocal < s; ++xLocal)
+					{
+						const PxVec3 queryPoint = d.pointSampler->getPoint(b[0] * d.cellsPerSubgrid + xLocal, b[1] * d.cellsPerSubgrid + yLocal, b[2] * d.cellsPerSubgrid + zLocal);
+						const PxReal closestDistance = closestDistanceToTrimesh(queryPoint, d.tree, d.indices, d.vertices, lastTriangle);
+
+						//If the empty ball around either this sample or an already evaluated neighbor contains the other one,
+						//both are on the same side of the surface and the expensive winding number can be skipped
+						PxReal neighbor, spacing;
+						if (xLocal > 0)
+						{
+							neighbor = samples[idx3D(xLocal - 1, yLocal, zLocal, s, s)];
+							spacing = cellSize.x;
+						}
+						else if (yLocal > 0)
+						{
+							neighbor = samples[idx3D(xLocal, yLocal - 1, zLocal, s, s)];
+							spacing = cellSize.y;
+						}
+						else if (zLocal > 0)
+						{
+							neighbor = samples[idx3D(xLocal, yLocal, zLocal - 1, s, s)];
+							spacing = cellSize.z;
+						}
+						else
+						{
+							//The block origin is a coarse sample
+							neighbor = d.sdfCoarse[idx3D(b[0], b[1], b[2], d.coarseWidth, d.coarseHeight)];
+							spacing = 0.0f;
+						}
+
+						bool inside;
+						if (PxMax(closestDistance, PxAbs(neighbor)) > spacing)
+							inside = neighbor < 0.0f;
+						else
+							inside = Gu::computeWindingNumber(d.tree, queryPoint, *d.clusters, d.indices, d.vertices) > 0.5f;
+
+						samples[idx3D(xLocal, yLocal, zLocal, s, s)] = inside ? -closestDistance : closestDistance;
+					}
+			block = physx::PxAtomicIncrement(d.progress) - 1;
+		}
+		return NULL;
+	}
+
+	void SDFUsingWindingNumbersSparse(const PxVec3* vertices, const PxU32* indicesOrig, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
 		const PxVec3& minExtents, const PxVec3& maxExtents, PxReal narrowBandThickness, PxU32 cellsPerSubgrid,
 		PxArray<PxReal>& sdfCoarse, PxArray<PxU32>& sdfFineStartSlots, PxArray<PxReal>& subgridData, PxArray<PxReal>& denseSdf,
 		PxReal& subgridsMinSdfValue, PxReal& subgridsMaxSdfValue, PxU32 numThreads, PxSDFBuilder* sdfBuilder)
@@ -1216,122 +1296,197 @@ namespace Gu
 		const PxU32 h = height / cellsPerSubgrid;
 		const PxU32 d = depth / cellsPerSubgrid;
 
-		denseSdf.resize((width + 1) * (height + 1) * (depth + 1));
-		SDFUsingWindingNumbers(vertices, indices, numTriangleIndices, width + 1, height + 1, depth + 1, denseSdf.begin(), minExtents, maxExtents + delta, NULL, false, numThreads, sdfBuilder);
-
 		sdfCoarse.clear();
 		sdfFineStartSlots.clear();
 		subgridData.clear();
+		denseSdf.clear();
 
-		sdfCoarse.reserve((w + 1) * (h + 1) * (d + 1));
-		sdfFineStartSlots.reserve(w * h * d);
+		PxArray<PxU32> repairedIndices;
+		analyzeAndFixMesh(vertices, indicesOrig, numTriangleIndices, repairedIndices);
+		const PxU32* indices = repairedIndices.size() > 0 ? repairedIndices.begin() : indicesOrig;
+		if (repairedIndices.size() > 0)
+			numTriangleIndices = repairedIndices.size();
 
-		for (PxU32 zBlock = 0; zBlock < d; ++zBlock)		
-			for (PxU32 yBlock = 0; yBlock < h; ++yBlock)			
-				for (PxU32 xBlock = 0; xBlock < w; ++xBlock)
+		const PxU32 s = cellsPerSubgrid + 1;
+		const PxU32 samplesPerBlock = s * s * s;
+
+		//Fine samples of the blocks that may need a subgrid, in block order
+		PxArray<PxU32> candidateBlocks;
+		PxArray<PxReal> candidateSamples;
+
+		//The narrow band path relies on the distance field being 1-Lipschitz, which requires a watertight mesh. Open meshes
+		//need the fix-up pass over the full dense grid, and an external sdf builder is expected to compute the dense grid itself.
+		const bool isWatertight = MeshAnalyzer::checkMeshWatertightness(reinterpret_cast<const Triangle*>(indices), numTriangleIndices / 3);
+		if (sdfBuilder || !isWatertight)
+		{
+			denseSdf.resize((width + 1) * (height + 1) * (depth + 1));
+			SDFUsingWindingNumbers(vertices, indices, numTriangleIndices, width + 1, height + 1, depth + 1, denseSdf.begin(), minExtents, maxExtents + delta, NULL, false, numThreads, sdfBuilder);
+
+			sdfCoarse.reserve((w + 1) * (h + 1) * (d + 1));
+			for (PxU32 zBlock = 0; zBlock <= d; ++zBlock)
+				for (PxU32 yBlock = 0; yBlock <= h; ++yBlock)
+					for (PxU32 xBlock = 0; xBlock <= w; ++xBlock)
+					{
+						const PxU32 index = idx3D(xBlock * cellsPerSubgrid, yBlock * cellsPerSubgrid, zBlock * cellsPerSubgrid, width + 1, height + 1);
+						PX_ASSERT(index < denseSdf.size());
+						sdfCoarse.pushBack(denseSdf[index]);
+					}
+
+			//All blocks are candidates, their samples are gathered from the dense grid below
+			for (PxU32 zBlock = 0; zBlock < d; ++zBlock)
+				for (PxU32 yBlock = 0; yBlock < h; ++yBlock)
+					for (PxU32 xBlock = 0; xBlock < w; ++xBlock)
+					{
+						candidateBlocks.pushBack(xBlock);
+						candidateBlocks.pushBack(yBlock);
+						candidateBlocks.pushBack(zBlock);
+					}
+			candidateSamples.resize(samplesPerBlock);
+		}
+		else
+		{
+			PxArray<Gu::BVHNode> tree;
+			buildTree(indices, numTriangleIndices / 3, vertices, tree);
+
+			PxHashMap<PxU32, Gu::ClusterApproximation> clusters;
+			Gu::precomputeClusterInformation(tree.begin(), indices, numTriangleIndices / 3, vertices, clusters);
+
+			bool allSamplesInsideBox = true;
+			const PxBounds3 box(minExtents, maxExtents);
+			for (PxU32 i = 0; i < numTriangleIndices; ++i)
+			{
+				if (!box.contains(vertices[indices[i]]))
 				{
-					sdfFineStartSlots.pushBack(0xFFFFFFFF);
+					allSamplesInsideBox = false;
+					break;
 				}
+			}
 
-		for (PxU32 zBlock = 0; zBlock <= d; ++zBlock)		
-			for (PxU32 yBlock = 0; yBlock <= h; ++yBlock)			
-				for (PxU32 xBlock = 0; xBlock <= w; ++xBlock)
+			//The coarse grid samples are exactly the dense grid samples at the block corners
+			sdfCoarse.resize((w + 1) * (h + 1) * (d + 1));
+			GridQueryPointSampler coarseSampler(minExtents, delta, false, 0, 0, 0, cellsPerSubgrid, cellsPerSubgrid, cellsPerSubgrid);
+			SDFUsingWindingNumbers(tree, clusters, vertices, indices, numTriangleIndices, w + 1, h + 1, d + 1, sdfCoarse.begin(), coarseSampler, NULL, numThreads, true, allSamplesInsideBox);
+
+			//Every sample of a block is at most half a block diagonal away from one of its corners, so the distance field over
+			//the block stays within that margin of the corner values. Blocks that cannot reach the narrow band are skipped.
+			const PxReal margin = 0.5f * (delta * PxReal(cellsPerSubgrid)).magnitude() + 1e-6f * extents.magnitude();
+			Interval narrowBandInterval(-narrowBandThickness - margin, narrowBandThickness + margin);
+			for (PxU32 zBlock = 0; zBlock < d; ++zBlock)
+				for (PxU32 yBlock = 0; yBlock < h; ++yBlock)
+					for (PxU32 xBlock = 0; xBlock < w; ++xBlock)
+					{
+						Interval cornerInterval;
+						for (PxU32 i = 0; i < 8; ++i)
+						{
+							const PxReal v = sdfCoarse[idx3D(xBlock + (i & 1), yBlock + ((i >> 1) & 1), zBlock + (i >> 2), w + 1, h + 1)];
+							cornerInterval.min = PxMin(cornerInterval.min, v);
+							cornerInterval.max = PxMax(cornerInterval.max, v);
+						}
+						if (narrowBandInterval.overlaps(cornerInterval))
+						{
+							candidateBlocks.pushBack(xBlock);
+							candidateBlocks.pushBack(yBlock);
+							candidateBlocks.pushBack(zBlock);
+						}
+					}
+
+			const PxU32 numCandidates = candidateBlocks.size() / 3;
+			candidateSamples.resize(numCandidates * samplesPerBlock);
+
+			GridQueryPointSampler fineSampler(minExtents, delta, false);
+			PxI32 progress = 0;
+
+			NarrowBandCalculationData data;
+			data.vertices = vertices;
+			data.indices = indices;
+			data.tree = tree.begin();
+			data.clusters = &clusters;
+			data.pointSampler = &fineSampler;
+			data.sdfCoarse = sdfCoarse.begin();
+			data.coarseWidth = w + 1;
+			data.coarseHeight = h + 1;
+			data.blocks = candidateBlocks.begin();
+			data.samples = candidateSamples.begin();
+			data.cellsPerSubgrid = cellsPerSubgrid;
+			data.end = PxI32(numCandidates);
+			data.progress = &progress;
+
+			numThreads = PxMin(PxMax(numThreads, 1u), PxMax(numCandidates, 1u));
+			if (numThreads == 1)
+				computeNarrowBandThreadJob(&data);
+			else
+			{
+				//The job only reads from the shared data, so all threads can use the same instance
+				PxArray<PxThread*> threads;
+				for (PxU32 i = 0; i < numThreads; ++i)
 				{
-					PxU32 x = xBlock * cellsPerSubgrid;
-					PxU32 y = yBlock * cellsPerSubgrid;
-					PxU32 z = zBlock * cellsPerSubgrid;
-					const PxU32 index = idx3D(x, y, z, width+1, height+1);
-					PX_ASSERT(index < denseSdf.size());
-					PxReal sdfValue = denseSdf[index];
-					sdfCoarse.pushBack(sdfValue);					
+					threads.pushBack(PX_NEW(PxThread)(computeNarrowBandThreadJob, &data, "thread"));
+					threads[i]->start();
 				}
-
-#if PX_DEBUG
-		for (PxU32 zBlock = 0; zBlock <= d; ++zBlock)
-			for (PxU32 yBlock = 0; yBlock <= h; ++yBlock)
-				for (PxU32 xBlock = 0; xBlock <= w; ++xBlock)
+				for (PxU32 i = 0; i < threads.size(); ++i)
+					threads[i]->waitForQuit();
+				for (PxU32 i = 0; i < threads.size(); ++i)
 				{
-					PxU32 x = xBlock * cellsPerSubgrid;
-					PxU32 y = yBlock * cellsPerSubgrid;
-					PxU32 z = zBlock * cellsPerSubgrid;
-
-					const PxU32 index = idx3D(x, y, z, width+1, height+1);
-					const PxU32 indexCoarse = idx3D(xBlock, yBlock, zBlock, w+1, h+1);
-					PX_ASSERT(sdfCoarse[indexCoarse] == denseSdf[index]);
-					PX_UNUSED(indexCoarse);
-					PX_UNUSED(index);
+					threads[i]->~PxThreadT();
+					PX_FREE(threads[i]);
 				}
-#endif
-
+			}
+		}
 
-		Interval narrowBandInterval(-narrowBandThickness, narrowBandThickness);
+		sdfFineStartSlots.resize(w * h * d, 0xFFFFFFFF);
 
 		DenseSDF coarseEval(w + 1, h + 1, d + 1, sdfCoarse.begin());
-		PxReal s = 1.0f / cellsPerSubgrid;
+		PxReal invCellsPerSubgrid = 1.0f / cellsPerSubgrid;
 
+		Interval narrowBandInterval(-narrowBandThickness, narrowBandThickness);
 		const PxReal errorThreshold = 1e-6f * extents.magnitude();
 		PxU32 subgridIndexer = 0;
 		subgridsMaxSdfValue = -FLT_MAX;
 		subgridsMinSdfValue = FLT_MAX;
-		for (PxU32 zBlock = 0; zBlock < d; ++zBlock)
+		for (PxU32 c = 0; c < candidateBlocks.size(); c += 3)
 		{
-			for (PxU32 yBlock = 0; yBlock < h; ++yBlock)
+			const PxU32 xBlock = candidateBlocks[c];
+			const PxU32 yBlock = candidateBlocks[c + 1];
+			const PxU32 zBlock = candidateBlocks[c + 2];
+			const PxReal* samples;
+			if (denseSdf.size())
 			{
-				for (PxU32 xBlock = 0; xBlock < w; ++xBlock)
-				{
-					bool subgridRequired = false;
-					Interval inverval;
-					PxReal maxAbsError = 0.0f;
-					for (PxU32 zLocal = 0; zLocal <= cellsPerSubgrid; ++zLocal)
-					{
-						for (PxU32 yLocal = 0; yLocal <= cellsPerSubgrid; ++yLocal)
-						{
-							for (PxU32 xLocal = 0; xLocal <= cellsPerSubgrid; ++xLocal)
-							{
-								PxU32 x = xBlock * cellsPerSubgrid + xLocal;
-								PxU32 y = yBlock * cellsPerSubgrid + yLocal;
-								PxU32 z = zBlock * cellsPerSubgrid + zLocal;
-
-								const PxU32 index = idx3D(x, y, z, width+1, height+1);
-								PxReal sdfValue = denseSdf[index];								
-								inverval.max = PxMax(inverval.max, sdfValue);
-								inverval.min = PxMin(inverval.min, sdfValue);
-
-								maxAbsError = PxMax(maxAbsError, PxAbs(sdfValue - coarseEval.sampleSDFDirect(PxVec3(xBlock + xLocal * s, yBlock + yLocal * s, zBlock + zLocal * s))));							
-							}
-						}
-					}			
-
-					subgridRequired = narrowBandInterval.overlaps(inverval);
-					if (maxAbsError < errorThreshold)
-						subgridRequired = false; //No need for a subgrid if the coarse SDF is already almost exact
+				PxReal* gathered = candidateSamples.begin();
+				for (PxU32 zLocal = 0; zLocal < s; ++zLocal)
+					for (PxU32 yLocal = 0; yLocal < s; ++yLocal)
+						for (PxU32 xLocal = 0; xLocal < s; ++xLocal)
+							*gathered++ = denseSdf[idx3D(xBlock * cellsPerSubgrid + xLocal, yBlock * cellsPerSubgrid + yLocal, zBlock * cellsPerSubgrid + zLocal, width + 1, height + 1)];
+				samples = candidateSamples.begin();
+			}
+			else
+				samples = candidateSamples.begin() + (c / 3) * samplesPerBlock;
 
-					if (subgridRequired)
+			Interval inverval;
+			PxReal maxAbsError = 0.0f;
+			for (PxU32 zLocal = 0; zLocal < s; ++zLocal)
+				for (PxU32 yLocal = 0; yLocal < s; ++yLocal)
+					for (PxU32 xLocal = 0; xLocal < s; ++xLocal)
 					{
-						subgridsMaxSdfValue = PxMax(subgridsMaxSdfValue, inverval.max);
-						subgridsMinSdfValue = PxMin(subgridsMinSdfValue, inverval.min);	
+						PxReal sdfValue = samples[idx3D(xLocal, yLocal, zLocal, s, s)];
+						inverval.max = PxMax(inverval.max, sdfValue);
+						inverval.min = PxMin(inverval.min, sdfValue);
 
-						for (PxU32 zLocal = 0; zLocal <= cellsPerSubgrid; ++zLocal)
-						{
-							for (PxU32 yLocal = 0; yLocal <= cellsPerSubgrid; ++yLocal)
-							{
-								for (PxU32 xLocal = 0; xLocal <= cellsPerSubgrid; ++xLocal)
-								{
-									PxU32 x = xBlock * cellsPerSubgrid + xLocal;
-									PxU32 y = yBlock * cellsPerSubgrid + yLocal;
-									PxU32 z = zBlock * cellsPerSubgrid + zLocal;
+						maxAbsError = PxMax(maxAbsError, PxAbs(sdfValue - coarseEval.sampleSDFDirect(PxVec3(xBlock + xLocal * invCellsPerSubgrid, yBlock + yLocal * invCellsPerSubgrid, zBlock + zLocal * invCellsPerSubgrid))));
+					}
 
-									const PxU32 index = z * (width + 1) * (height + 1) + y * (width + 1) + x;
-									PxReal sdfValue = denseSdf[index];
+			bool subgridRequired = narrowBandInterval.overlaps(inverval);
+			if (maxAbsError < errorThreshold)
+				subgridRequired = false; //No need for a subgrid if the coarse SDF is already almost exact
 
-									subgridData.pushBack(sdfValue);
-								}
-							}
-						}
-						sdfFineStartSlots[idx3D(xBlock, yBlock, zBlock, w, h)] = subgridIndexer;
-						++subgridIndexer;						
-					}
-				}
+			if (subgridRequired)
+			{
+				subgridsMaxSdfValue = PxMax(subgridsMaxSdfValue, inverval.max);
+				subgridsMinSdfValue = PxMin(subgridsMinSdfValue, inverval.min);
+
+				for (PxU32 i = 0; i < samplesPerBlock; ++i)
+					subgridData.pushBack(samples[i]);
+				sdfFineStartSlots[idx3D(xBlock, yBlock, zBlock, w, h)] = subgridIndexer;
+				++subgridIndexer;
 			}
 		}
 	}
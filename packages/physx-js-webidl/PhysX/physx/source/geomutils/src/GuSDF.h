@@ -320,7 +320,8 @@ namespace physx
 		\param[out] sdfCoarse The coarse sdf as a dense 3d array of lower resolution (resulution is (with/cellsPerSubgrid+1, height/cellsPerSubgrid+1, depth/cellsPerSubgrid+1))
 		\param[out] sdfFineStartSlots The start slot indices of the subgrid blocks. If a subgrid block is empty, the start slot will be 0xFFFFFFFF
 		\param[out] subgridData The array containing subgrid data blocks
-		\param[out] denseSdf Provides acces to the denxe sdf that is used for compuation internally
+		\param[out] denseSdf Provides acces to the dense sdf that is used for computation internally. Only filled if the dense sdf is needed, i.e. for non-watertight meshes
+		or when sdfBuilder is provided. Watertight meshes only evaluate the coarse sdf and the subgrid blocks close to the narrow band, and leave this array empty.
 		\param[out] subgridsMinSdfValue The minimum value over all subgrid blocks. Used if normalized textures are used which is the case for 8 and 16bit formats
 		\param[out] subgridsMaxSdfValue	The maximum value over all subgrid blocks. Used if normalized textures are used which is the case for 8 and 16bit formats
 		\param[in] numThreads The number of cpu threads to use during the computation
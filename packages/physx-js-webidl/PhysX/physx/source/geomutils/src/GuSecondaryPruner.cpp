@@ -29,6 +29,8 @@
 #include "GuSecondaryPruner.h"
 #include "GuBucketPruner.h"
 #include "GuIncrementalAABBPrunerCore.h"
+#include "CmVisualization.h"
+#include "foundation/PxBitUtils.h"
 
 //#define USE_DEBUG_PRINTF
 
@@ -89,6 +91,12 @@ class CompanionPrunerBucket : public CompanionPruner
 							return mPrunerCore.overlap(queryVolume, prunerCallback);
 						return true;
 					}
+	virtual	bool	cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)	const
+					{
+						if(mPrunerCore.getNbObjects())
+							return mPrunerCore.cull(nbPlanes, planes, prunerCallback);
+						return true;
+					}
 	virtual	bool	sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const
 					{
 						if(mPrunerCore.getNbObjects())
@@ -155,6 +163,12 @@ class CompanionPrunerIncremental : public CompanionPruner
 							return mPrunerCore.overlap(queryVolume, prunerCallback);
 						return true;
 					}
+	virtual	bool	cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)	const
+					{
+						if(mPrunerCore.getNbObjects())
+							return mPrunerCore.cull(nbPlanes, planes, prunerCallback);
+						return true;
+					}
 	virtual	bool	sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const
 					{
 						if(mPrunerCore.getNbObjects())
@@ -211,6 +225,7 @@ class CompanionPrunerAABBTree : public CompanionPruner
 	virtual			void					visualize(PxRenderOutput& out, PxU32 color)	const;
 	virtual			bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const;
 	virtual			bool					overlap(const ShapeData& queryVolume, PrunerOverlapCallback& prunerCallback)	const;
+	virtual			bool					cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)	const;
 	virtual			bool					sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const;
 	virtual			void					getGlobalBounds(PxBounds3& bounds)	const;
 
@@ -978,6 +993,34 @@ bool CompanionPrunerAABBTree::overlap(const ShapeData& queryVolume, PrunerOverla
 	return true;
 }
 
+bool CompanionPrunerAABBTree::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback) const
+{
+	PX_ASSERT(!mDirtyFlags);
+
+#ifdef USE_MAVERICK_NODE
+	{
+		// PT: doOverlapLeafTest skips the box test for single-object leaves, which is fine for overlaps since they
+		// run an exact test afterwards, but culling queries only rely on bounds. So we test all free objects here.
+		MaverickOverlapAdapter ra(mMaverick, prunerCallback);
+		const PxU32 clipMask = getPlanesClipMask(nbPlanes);
+		for(PxU32 i=0;i<mMaverick.mNbFree;i++)
+		{
+			const PxBounds3& bounds = mMaverick.mFreeBounds[i];
+			PxU32 outClipMask;
+			if(planesAABBOverlap(bounds.getCenter(), bounds.getExtents(), planes, outClipMask, clipMask) && !ra.invoke(i))
+				return false;
+		}
+	}
+#endif
+
+	if(mBVH)
+	{
+		OverlapAdapter ra(*this, prunerCallback, mLastValidTimestamp);
+		return AABBTreeCull<true, BVHTree, BVHNode, OverlapAdapter>()(mBVH->getData().mBounds, BVHTree(mBVH->getData()), nbPlanes, planes, ra);
+	}
+	return true;
+}
+
 bool CompanionPrunerAABBTree::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback) const
 {
 	PX_UNUSED(queryVolume);
@@ -1048,6 +1091,646 @@ void CompanionPrunerAABBTree::getGlobalBounds(PxBounds3& bounds) const
 	StoreBounds(bounds, minV, maxV);
 }
 
+// PT: loose-grid companion pruner, for scenes where lots of small objects are constantly added and removed (projectiles,
+// debris, etc). Objects are stored in a spatial hash, in the cell containing the center of their bounds. Add, update and
+// remove are O(1) and there is nothing to build. Queries visit the cells touched by the query bounds, inflated by the
+// largest object extents (that's the "loose" part), or test all objects when that would visit too many cells. As with
+// the other companion pruners, objects are moved to the main tree by the regular rebuild process (removeMarkedObjects),
+// so the time they spend here is driven by the dynamic tree's rebuild rate.
+
+#define GRID_NB_BUCKETS_MIN		256
+#define GRID_CELL_SIZE_SCALE	4.0f	// PT: cell size relative to the average object size
+
+static const PxU32 GRID_INVALID_ID = 0xffffffff;
+
+static PX_FORCE_INLINE PxU32 hashCell(PxI32 x, PxI32 y, PxI32 z)
+{
+	return (PxU32(x)*73856093u) ^ (PxU32(y)*19349663u) ^ (PxU32(z)*83492791u);
+}
+
+// PT: clamped so that the float-to-int conversion cannot overflow far away from the origin. Objects & queries use the
+// same conversion so clamped cells are merged, which is slower but still correct.
+static PX_FORCE_INLINE PxI32 toCell(PxReal x)
+{
+	return PxI32(PxClamp(PxFloor(x), -1073741824.0f, 1073741824.0f));
+}
+
+class CompanionPrunerGrid : public CompanionPruner
+{
+	public:
+											CompanionPrunerGrid(const PruningPool* pool);
+	virtual									~CompanionPrunerGrid();
+
+	virtual			bool					addObject(const PrunerPayload& object, PrunerHandle handle, const PxBounds3& worldAABB, const PxTransform& transform, PxU32 timeStamp, PoolIndex poolIndex);
+	virtual			bool					updateObject(const PrunerPayload& object, PrunerHandle handle, const PxBounds3& worldAABB, const PxTransform& transform, PoolIndex poolIndex);
+	virtual			bool					removeObject(const PrunerPayload& object, PrunerHandle handle, PxU32 objectIndex, PxU32 swapObjectIndex);
+	virtual			void					swapIndex(PxU32 objectIndex, PxU32 swapObjectIndex);
+	virtual			PxU32					removeMarkedObjects(PxU32 timeStamp);
+	virtual			void					shiftOrigin(const PxVec3& shift);
+	virtual			void					timeStampChange();
+	virtual			void					build();
+	virtual			PxU32					getNbObjects()								const;
+	virtual			void					release();
+	virtual			void					visualize(PxRenderOutput& out, PxU32 color)	const;
+	virtual			bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const;
+	virtual			bool					overlap(const ShapeData& queryVolume, PrunerOverlapCallback& prunerCallback)	const;
+	virtual			bool					cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)	const;
+	virtual			bool					sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const;
+	virtual			void					getGlobalBounds(PxBounds3& bounds)	const;
+
+					typedef PxInlineArray<PxU32, 256>	Candidates;
+
+					struct GridObject
+					{
+						PrunerHandle	mHandle;	// INVALID_PRUNERHANDLE for free slots
+						PxU32			mTimestamp;
+						PxU32			mNext;		// Next object in the same bucket, or next free slot
+						PxU32			mPrev;		// Previous object in the same bucket
+						PxI32			mCell[3];
+					};
+
+					const PruningPool*		mPool;
+					PxArray<GridObject>		mObjects;
+					PxArray<PxBounds3>		mBounds;	// Parallel to mObjects, plus one padding entry for V4LoadU
+					PxU32*					mBuckets;	// First object of each bucket
+					PxU32*					mRemap;		// Pruner handle to object index
+					PxU32					mNbBuckets;
+					PxU32					mMapSize;
+					PxU32					mNbObjects;
+					PxU32					mFirstFree;
+					PxU32					mNbRemovedSinceRehash;
+					PxReal					mCellSize;
+					PxReal					mInvCellSize;
+					PxVec3					mMaxExtents;
+					PxBounds3				mGlobalBounds;
+					bool					mGlobalBoundsDirty;
+
+	PX_FORCE_INLINE	void					computeCell(PxI32* cell, const PxVec3& p)	const
+											{
+												cell[0] = toCell(p.x * mInvCellSize);
+												cell[1] = toCell(p.y * mInvCellSize);
+												cell[2] = toCell(p.z * mInvCellSize);
+											}
+	PX_FORCE_INLINE	PxU32					getBucket(const PxI32* cell)	const	{ return hashCell(cell[0], cell[1], cell[2]) & (mNbBuckets-1);	}
+
+					void					linkObject(PxU32 index);
+					void					unlinkObject(PxU32 index);
+					void					removeObjectInternal(PxU32 index);
+					void					rehash(PxU32 nbBuckets);
+					void					resizeMap(PxU32 index);
+					void					releaseInternal();
+					void					gatherObjects(const PxBounds3& queryBounds, Candidates& candidates)	const;
+};
+
+CompanionPrunerGrid::CompanionPrunerGrid(const PruningPool* pool) :
+	mPool					(pool),
+	mBuckets				(NULL),
+	mRemap					(NULL),
+	mNbBuckets				(0),
+	mMapSize				(0),
+	mNbObjects				(0),
+	mFirstFree				(GRID_INVALID_ID),
+	mNbRemovedSinceRehash	(0),
+	mCellSize				(0.0f),
+	mInvCellSize			(0.0f),
+	mMaxExtents				(0.0f),
+	mGlobalBoundsDirty		(false)
+{
+	mGlobalBounds.setEmpty();
+}
+
+CompanionPrunerGrid::~CompanionPrunerGrid()
+{
+	releaseInternal();
+}
+
+void CompanionPrunerGrid::releaseInternal()
+{
+	PX_FREE(mBuckets);
+	PX_FREE(mRemap);
+	mObjects.reset();
+	mBounds.reset();
+	mNbBuckets = 0;
+	mMapSize = 0;
+	mNbObjects = 0;
+	mFirstFree = GRID_INVALID_ID;
+	mNbRemovedSinceRehash = 0;
+	mCellSize = 0.0f;
+	mInvCellSize = 0.0f;
+	mMaxExtents = PxVec3(0.0f);
+	mGlobalBounds.setEmpty();
+	mGlobalBoundsDirty = false;
+}
+
+void CompanionPrunerGrid::resizeMap(PxU32 index)
+{
+	PxU32 size = mMapSize ? mMapSize*2 : 64;
+	const PxU32 minSize = index+1;
+	if(minSize>size)
+		size = minSize*2;
+
+	PxU32* items = PX_ALLOCATE(PxU32, size, "Map");
+	if(mRemap)
+		PxMemCopy(items, mRemap, mMapSize*sizeof(PxU32));
+	PxMemSet(items+mMapSize, 0xff, (size-mMapSize)*sizeof(PxU32));
+	PX_FREE(mRemap);
+	mRemap = items;
+	mMapSize = size;
+}
+
+void CompanionPrunerGrid::linkObject(PxU32 index)
+{
+	GridObject& object = mObjects[index];
+	const PxU32 bucket = getBucket(object.mCell);
+	const PxU32 next = mBuckets[bucket];
+	object.mPrev = GRID_INVALID_ID;
+	object.mNext = next;
+	if(next!=GRID_INVALID_ID)
+		mObjects[next].mPrev = index;
+	mBuckets[bucket] = index;
+}
+
+void CompanionPrunerGrid::unlinkObject(PxU32 index)
+{
+	const GridObject& object = mObjects[index];
+	if(object.mPrev!=GRID_INVALID_ID)
+		mObjects[object.mPrev].mNext = object.mNext;
+	else
+		mBuckets[getBucket(object.mCell)] = object.mNext;
+	if(object.mNext!=GRID_INVALID_ID)
+		mObjects[object.mNext].mPrev = object.mPrev;
+}
+
+// PT: rebuilds the hash from scratch. This is where the cell size adapts to the current objects, and where the max extents
+// shrink back after large objects have been removed. Only called when the number of objects changes significantly, so the
+// cost is amortized over the adds & removes.
+void CompanionPrunerGrid::rehash(PxU32 nbBuckets)
+{
+	nbBuckets = PxMax(nbBuckets, PxU32(GRID_NB_BUCKETS_MIN));
+	if(!PxIsPowerOfTwo(nbBuckets))
+		nbBuckets = PxNextPowerOfTwo(nbBuckets);
+	if(nbBuckets!=mNbBuckets)
+	{
+		PX_FREE(mBuckets);
+		mBuckets = PX_ALLOCATE(PxU32, nbBuckets, "GridBuckets");
+		mNbBuckets = nbBuckets;
+	}
+	PxMemSet(mBuckets, 0xff, nbBuckets*sizeof(PxU32));
+
+	const PxU32 nbSlots = mObjects.size();
+
+	PxVec3 maxExtents(0.0f);
+	PxReal sumSizes = 0.0f;
+	for(PxU32 i=0;i<nbSlots;i++)
+	{
+		if(mObjects[i].mHandle==INVALID_PRUNERHANDLE)
+			continue;
+		const PxVec3 extents = mBounds[i].getExtents();
+		maxExtents = maxExtents.maximum(extents);
+		sumSizes += extents.maxElement()*2.0f;
+	}
+	mMaxExtents = maxExtents;
+	mNbRemovedSinceRehash = 0;
+
+	if(!mNbObjects)
+	{
+		mCellSize = mInvCellSize = 0.0f;
+		return;
+	}
+
+	mCellSize = PxMax(GRID_CELL_SIZE_SCALE * sumSizes / PxReal(mNbObjects), 1e-3f);
+	mInvCellSize = 1.0f / mCellSize;
+
+	for(PxU32 i=0;i<nbSlots;i++)
+	{
+		if(mObjects[i].mHandle==INVALID_PRUNERHANDLE)
+			continue;
+		computeCell(mObjects[i].mCell, mBounds[i].getCenter());
+		linkObject(i);
+	}
+}
+
+bool CompanionPrunerGrid::addObject(const PrunerPayload& object, PrunerHandle handle, const PxBounds3& worldAABB, const PxTransform& transform, PxU32 timeStamp, PoolIndex poolIndex)
+{
+	PX_UNUSED(object);
+	PX_UNUSED(transform);
+	PX_UNUSED(poolIndex);
+
+	PX_ASSERT(handle!=INVALID_PRUNERHANDLE);
+	if(handle>=mMapSize)
+		resizeMap(handle);
+	PX_ASSERT(mRemap[handle]==GRID_INVALID_ID);
+
+	PxU32 index = mFirstFree;
+	if(index!=GRID_INVALID_ID)
+	{
+		mFirstFree = mObjects[index].mNext;
+	}
+	else
+	{
+		index = mObjects.size();
+		mObjects.pushBack(GridObject());
+		// PT: one extra entry so that V4LoadU on the last bounds stays within the array
+		mBounds.resize(index+2);
+	}
+
+	mRemap[handle] = index;
+	mBounds[index] = worldAABB;
+	GridObject& gridObject = mObjects[index];
+	gridObject.mHandle = handle;
+	gridObject.mTimestamp = timeStamp;
+
+	mNbObjects++;
+	mGlobalBounds.include(worldAABB);
+
+	if(mNbObjects>mNbBuckets || mCellSize==0.0f)
+	{
+		// PT: this also links the new object
+		rehash(mNbObjects*2);
+	}
+	else
+	{
+		mMaxExtents = mMaxExtents.maximum(worldAABB.getExtents());
+		computeCell(gridObject.mCell, worldAABB.getCenter());
+		linkObject(index);
+	}
+	return true;
+}
+
+bool CompanionPrunerGrid::updateObject(const PrunerPayload& object, PrunerHandle handle, const PxBounds3& worldAABB, const PxTransform& transform, PoolIndex poolIndex)
+{
+	PX_UNUSED(object);
+	PX_UNUSED(transform);
+	PX_UNUSED(poolIndex);
+
+	if(handle>=mMapSize || mRemap[handle]==GRID_INVALID_ID)
+		return false;
+
+	const PxU32 index = mRemap[handle];
+	mBounds[index] = worldAABB;
+	mMaxExtents = mMaxExtents.maximum(worldAABB.getExtents());
+	mGlobalBoundsDirty = true;
+
+	// PT: fast-moving objects often stay in the same cell for a few frames, in which case there is nothing else to do
+	PxI32 cell[3];
+	computeCell(cell, worldAABB.getCenter());
+	GridObject& gridObject = mObjects[index];
+	if(cell[0]!=gridObject.mCell[0] || cell[1]!=gridObject.mCell[1] || cell[2]!=gridObject.mCell[2])
+	{
+		unlinkObject(index);
+		gridObject.mCell[0] = cell[0];
+		gridObject.mCell[1] = cell[1];
+		gridObject.mCell[2] = cell[2];
+		linkObject(index);
+	}
+	return true;
+}
+
+void CompanionPrunerGrid::removeObjectInternal(PxU32 index)
+{
+	unlinkObject(index);
+
+	GridObject& gridObject = mObjects[index];
+	mRemap[gridObject.mHandle] = GRID_INVALID_ID;
+	gridObject.mHandle = INVALID_PRUNERHANDLE;
+	gridObject.mNext = mFirstFree;
+	mFirstFree = index;
+	mBounds[index].setEmpty();
+
+	mNbObjects--;
+	mNbRemovedSinceRehash++;
+	mGlobalBoundsDirty = true;
+}
+
+bool CompanionPrunerGrid::removeObject(const PrunerPayload& object, PrunerHandle handle, PxU32 objectIndex, PxU32 swapObjectIndex)
+{
+	PX_UNUSED(object);
+	PX_UNUSED(objectIndex);
+	PX_UNUSED(swapObjectIndex);
+
+	if(handle>=mMapSize || mRemap[handle]==GRID_INVALID_ID)
+		return false;
+
+	removeObjectInternal(mRemap[handle]);
+	return true;
+}
+
+void CompanionPrunerGrid::swapIndex(PxU32 objectIndex, PxU32 swapObjectIndex)
+{
+	// PT: we only use pruner handles, which don't change when objects move in the pruning pool
+	PX_UNUSED(objectIndex);
+	PX_UNUSED(swapObjectIndex);
+}
+
+PxU32 CompanionPrunerGrid::removeMarkedObjects(PxU32 timeStamp)
+{
+	PxU32 nbRemoved = 0;
+	const PxU32 nbSlots = mObjects.size();
+	for(PxU32 i=0;i<nbSlots && mNbObjects;i++)
+	{
+		const GridObject& gridObject = mObjects[i];
+		if(gridObject.mHandle!=INVALID_PRUNERHANDLE && gridObject.mTimestamp==timeStamp)
+		{
+			removeObjectInternal(i);
+			nbRemoved++;
+		}
+	}
+	return nbRemoved;
+}
+
+void CompanionPrunerGrid::shiftOrigin(const PxVec3& shift)
+{
+	const PxU32 nbSlots = mObjects.size();
+	for(PxU32 i=0;i<nbSlots;i++)
+	{
+		if(mObjects[i].mHandle==INVALID_PRUNERHANDLE)
+			continue;
+		mBounds[i].minimum -= shift;
+		mBounds[i].maximum -= shift;
+	}
+	if(!mGlobalBounds.isEmpty())
+	{
+		mGlobalBounds.minimum -= shift;
+		mGlobalBounds.maximum -= shift;
+	}
+
+	// PT: all cells change
+	if(mNbBuckets)
+		rehash(mNbBuckets);
+}
+
+void CompanionPrunerGrid::timeStampChange()
+{
+}
+
+void CompanionPrunerGrid::build()
+{
+	// PT: nothing to build per se. We just use this opportunity to compact things after heavy churn, so that stale max
+	// extents or an oversized table don't keep slowing down queries.
+	if(mNbBuckets && mNbRemovedSinceRehash>PxMax(mNbObjects, PxU32(GRID_NB_BUCKETS_MIN)))
+	{
+		if(!mNbObjects)
+		{
+			// PT: keep the table but forget the free slots, the next objects will start from a clean state
+			mObjects.clear();
+			mBounds.clear();
+			mFirstFree = GRID_INVALID_ID;
+		}
+		rehash(mNbObjects*2);
+	}
+
+	if(mGlobalBoundsDirty)
+	{
+		mGlobalBoundsDirty = false;
+		mGlobalBounds.setEmpty();
+		const PxU32 nbSlots = mObjects.size();
+		for(PxU32 i=0;i<nbSlots;i++)
+		{
+			if(mObjects[i].mHandle!=INVALID_PRUNERHANDLE)
+				mGlobalBounds.include(mBounds[i]);
+		}
+	}
+}
+
+PxU32 CompanionPrunerGrid::getNbObjects() const
+{
+	return mNbObjects;
+}
+
+void CompanionPrunerGrid::release()
+{
+	releaseInternal();
+}
+
+void CompanionPrunerGrid::visualize(PxRenderOutput& out, PxU32 color) const
+{
+	const PxTransform idt = PxTransform(PxIdentity);
+	out << idt;
+	out << color;
+
+	const PxU32 nbSlots = mObjects.size();
+	for(PxU32 i=0;i<nbSlots;i++)
+	{
+		if(mObjects[i].mHandle!=INVALID_PRUNERHANDLE)
+			Cm::renderOutputDebugBox(out, mBounds[i]);
+	}
+}
+
+void CompanionPrunerGrid::gatherObjects(const PxBounds3& queryBounds, Candidates& candidates) const
+{
+	// PT: objects are stored in the cell of their center, so we extend the query by the largest object extents
+	const PxVec3 qmin = (queryBounds.minimum - mMaxExtents) * mInvCellSize;
+	const PxVec3 qmax = (queryBounds.maximum + mMaxExtents) * mInvCellSize;
+
+	// PT: computed with floats since large queries would overflow the cell coordinates. Visiting a cell costs about as
+	// much as testing an object, so we switch to testing all objects when there are more cells to visit than that.
+	const PxVec3 nbCellsPerAxis(PxFloor(qmax.x) - PxFloor(qmin.x) + 1.0f, PxFloor(qmax.y) - PxFloor(qmin.y) + 1.0f, PxFloor(qmax.z) - PxFloor(qmin.z) + 1.0f);
+	const PxReal nbCells = nbCellsPerAxis.x * nbCellsPerAxis.y * nbCellsPerAxis.z;
+
+	if(!(nbCells < PxReal(mNbObjects)))	// PT: written this way to also catch NaNs & infinities
+	{
+		const PxU32 nbSlots = mObjects.size();
+		for(PxU32 i=0;i<nbSlots;i++)
+		{
+			if(mObjects[i].mHandle!=INVALID_PRUNERHANDLE)
+				candidates.pushBack(i);
+		}
+		return;
+	}
+
+	const PxI32 x0 = toCell(qmin.x), x1 = toCell(qmax.x);
+	const PxI32 y0 = toCell(qmin.y), y1 = toCell(qmax.y);
+	const PxI32 z0 = toCell(qmin.z), z1 = toCell(qmax.z);
+	for(PxI32 z=z0;z<=z1;z++)
+	{
+		for(PxI32 y=y0;y<=y1;y++)
+		{
+			for(PxI32 x=x0;x<=x1;x++)
+			{
+				PxU32 index = mBuckets[hashCell(x, y, z) & (mNbBuckets-1)];
+				while(index!=GRID_INVALID_ID)
+				{
+					const GridObject& gridObject = mObjects[index];
+					// PT: different cells can share the same bucket, so we filter by cell to avoid duplicates
+					if(gridObject.mCell[0]==x && gridObject.mCell[1]==y && gridObject.mCell[2]==z)
+						candidates.pushBack(index);
+					index = gridObject.mNext;
+				}
+			}
+		}
+	}
+}
+
+// PT: adapter to run the regular leaf-level code from the tree traversals on the objects gathered from the grid
+struct GridLeaf
+{
+	PX_FORCE_INLINE					GridLeaf(const CompanionPrunerGrid::Candidates& candidates) : mCandidates(candidates)	{}
+
+	PX_FORCE_INLINE	const PxU32*	getPrimitives(const PxU32*)		const	{ return mCandidates.begin();	}
+	PX_FORCE_INLINE	PxU32			getPrimitiveIndex()				const	{ return 0;						}
+	PX_FORCE_INLINE	PxU32			getNbPrimitives()				const	{ return mCandidates.size();	}
+
+	const CompanionPrunerGrid::Candidates&	mCandidates;
+	PX_NOCOPY(GridLeaf)
+};
+
+namespace physx
+{
+namespace Gu
+{
+	// PT: a single gathered object still needs its bounds test
+	template<>
+	struct NodeHasExactBounds<GridLeaf>
+	{
+		enum { value = 0 };
+	};
+}
+}
+
+namespace
+{
+	struct GridRaycastAdapter
+	{
+		GridRaycastAdapter(const CompanionPrunerGrid& owner, PrunerRaycastCallback& cb) : mOwner(owner), mCallback(cb)	{}
+
+		PX_FORCE_INLINE bool invoke(PxReal& distance, PxU32 index)
+		{
+			const PoolIndex poolIndex = mOwner.mPool->getIndex(mOwner.mObjects[index].mHandle);
+			return mCallback.invoke(distance, poolIndex, mOwner.mPool->getObjects(), mOwner.mPool->getTransforms());
+		}
+
+		const CompanionPrunerGrid&	mOwner;
+		PrunerRaycastCallback&		mCallback;
+		PX_NOCOPY(GridRaycastAdapter)
+	};
+
+	struct GridOverlapAdapter
+	{
+		GridOverlapAdapter(const CompanionPrunerGrid& owner, PrunerOverlapCallback& cb) : mOwner(owner), mCallback(cb)	{}
+
+		PX_FORCE_INLINE bool invoke(PxU32 index)
+		{
+			const PoolIndex poolIndex = mOwner.mPool->getIndex(mOwner.mObjects[index].mHandle);
+			return mCallback.invoke(poolIndex, mOwner.mPool->getObjects(), mOwner.mPool->getTransforms());
+		}
+
+		const CompanionPrunerGrid&	mOwner;
+		PrunerOverlapCallback&		mCallback;
+		PX_NOCOPY(GridOverlapAdapter)
+	};
+}
+
+bool CompanionPrunerGrid::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback) const
+{
+	if(!mNbObjects)
+		return true;
+
+	PxBounds3 rayBounds(origin, origin);
+	rayBounds.include(origin + unitDir * inOutDistance);
+
+	Candidates candidates;
+	gatherObjects(rayBounds, candidates);
+
+	const GridLeaf leaf(candidates);
+	GridRaycastAdapter ra(*this, prunerCallback);
+	Gu::RayAABBTest test(origin*2.0f, unitDir*2.0f, inOutDistance, PxVec3(0.0f));
+	return doLeafTest<false, true, GridLeaf, GridRaycastAdapter>(&leaf, test, mBounds.begin(), NULL, inOutDistance, ra);
+}
+
+bool CompanionPrunerGrid::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& prunerCallback) const
+{
+	if(!mNbObjects)
+		return true;
+
+	Candidates candidates;
+	gatherObjects(queryVolume.getPrunerInflatedWorldAABB(), candidates);
+
+	const GridLeaf leaf(candidates);
+	GridOverlapAdapter ra(*this, prunerCallback);
+	const PxBounds3* bounds = mBounds.begin();
+
+	switch(queryVolume.getType())
+	{
+		case PxGeometryType::eBOX:
+		{
+			if(queryVolume.isOBB())
+			{	
+				const DefaultOBBAABBTest test(queryVolume);
+				return doOverlapLeafTest<true, OBBAABBTest, GridLeaf, GridOverlapAdapter>(test, &leaf, bounds, NULL, ra);
+			}
+			else
+			{
+				const DefaultAABBAABBTest test(queryVolume);
+				return doOverlapLeafTest<true, AABBAABBTest, GridLeaf, GridOverlapAdapter>(test, &leaf, bounds, NULL, ra);
+			}
+		}
+
+		case PxGeometryType::eCAPSULE:
+		{
+			const DefaultCapsuleAABBTest test(queryVolume, SQ_PRUNER_INFLATION);
+			return doOverlapLeafTest<true, CapsuleAABBTest, GridLeaf, GridOverlapAdapter>(test, &leaf, bounds, NULL, ra);
+		}
+
+		case PxGeometryType::eSPHERE:
+		{
+			const DefaultSphereAABBTest test(queryVolume);
+			return doOverlapLeafTest<true, SphereAABBTest, GridLeaf, GridOverlapAdapter>(test, &leaf, bounds, NULL, ra);
+		}
+
+		case PxGeometryType::eCONVEXMESH:
+		{
+			const DefaultOBBAABBTest test(queryVolume);
+			return doOverlapLeafTest<true, OBBAABBTest, GridLeaf, GridOverlapAdapter>(test, &leaf, bounds, NULL, ra);
+		}
+
+		default:
+			PX_ALWAYS_ASSERT_MESSAGE("unsupported overlap query volume geometry type");
+	}
+	return true;
+}
+
+bool CompanionPrunerGrid::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback) const
+{
+	// PT: culling volumes are usually large compared to our cells, so we just test all objects
+	GridOverlapAdapter ra(*this, prunerCallback);
+	const PxU32 clipMask = getPlanesClipMask(nbPlanes);
+	const PxU32 nbSlots = mObjects.size();
+	for(PxU32 i=0;i<nbSlots;i++)
+	{
+		if(mObjects[i].mHandle==INVALID_PRUNERHANDLE)
+			continue;
+		const PxBounds3& bounds = mBounds[i];
+		PxU32 outClipMask;
+		if(planesAABBOverlap(bounds.getCenter(), bounds.getExtents(), planes, outClipMask, clipMask) && !ra.invoke(i))
+			return false;
+	}
+	return true;
+}
+
+bool CompanionPrunerGrid::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback) const
+{
+	if(!mNbObjects)
+		return true;
+
+	const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
+	PxBounds3 sweptBounds = aabb;
+	const PxVec3 motion = unitDir * inOutDistance;
+	sweptBounds.include(PxBounds3(aabb.minimum + motion, aabb.maximum + motion));
+
+	Candidates candidates;
+	gatherObjects(sweptBounds, candidates);
+
+	const GridLeaf leaf(candidates);
+	GridRaycastAdapter ra(*this, prunerCallback);
+	Gu::RayAABBTest test(aabb.getCenter()*2.0f, unitDir*2.0f, inOutDistance, aabb.getExtents()*2.0f);
+	return doLeafTest<true, true, GridLeaf, GridRaycastAdapter>(&leaf, test, mBounds.begin(), NULL, inOutDistance, ra);
+}
+
+void CompanionPrunerGrid::getGlobalBounds(PxBounds3& bounds) const
+{
+	bounds = mGlobalBounds;
+}
+
 
 
 CompanionPruner* physx::Gu::createCompanionPruner(PxU64 contextID, CompanionPrunerType type, const PruningPool* pool)
@@ -1065,6 +1748,7 @@ CompanionPruner* physx::Gu::createCompanionPruner(PxU64 contextID, CompanionPrun
 		case COMPANION_PRUNER_BUCKET:		return PX_NEW(CompanionPrunerBucket);
 		case COMPANION_PRUNER_INCREMENTAL:	return PX_NEW(CompanionPrunerIncremental)(pool);
 		case COMPANION_PRUNER_AABB_TREE:	return PX_NEW(CompanionPrunerAABBTree)(contextID, pool);
+		case COMPANION_PRUNER_GRID:			return PX_NEW(CompanionPrunerGrid)(pool);
 	}
 	return NULL;
 }
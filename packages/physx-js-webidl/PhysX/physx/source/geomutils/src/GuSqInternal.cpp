@@ -66,6 +66,27 @@ void visualizeTree(PxRenderOutput& out, PxU32 color, const AABBTree* tree)
 	}
 }
 
+static void drawBVH(const QuantizedAABBTree& tree, const BVHNodeQ* node, PxRenderOutput& out_)
+{
+	PxBounds3 bounds;
+	tree.getNodeBounds(node, bounds);
+	renderOutputDebugBox(out_, bounds);
+	if(node->isLeaf())
+		return;
+	drawBVH(tree, node->getPos(tree.getNodes()), out_);
+	drawBVH(tree, node->getNeg(tree.getNodes()), out_);
+}
+
+void visualizeTree(PxRenderOutput& out, PxU32 color, const QuantizedAABBTree* tree)
+{
+	if(tree && tree->getNbNodes())
+	{
+		out << PxTransform(PxIdentity);
+		out << color;
+		drawBVH(*tree, tree->getNodes(), out);
+	}
+}
+
 void visualizeTree(PxRenderOutput& out, PxU32 color, const IncrementalAABBTree* tree, DebugVizCallback* cb)
 {
 	if(tree && tree->getNodes())
@@ -31,10 +31,111 @@
 #include "foundation/PxAllocator.h"
 #include "foundation/PxBitUtils.h"
 #include "GuMeshCleaner.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 using namespace Gu;
 
+#define MESH_CLEANER_GRAIN	8192
+
+namespace
+{
+	class SnapVertices : public Cm::ParallelForCallback
+	{
+		public:
+			SnapVertices(const PxVec3* srcVerts, PxVec3* cleanVerts, PxU32* vertexIndices, PxF32 weldTolerance) :
+				mSrcVerts(srcVerts), mCleanVerts(cleanVerts), mVertexIndices(vertexIndices), mWeldTolerance(weldTolerance)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				const PxF32 weldTolerance = mWeldTolerance;
+				for(PxU32 i=startIndex; i<endIndex; i++)
+				{
+					mVertexIndices[i] = i;
+					mCleanVerts[i] = PxVec3(	PxFloor(mSrcVerts[i].x*weldTolerance + 0.5f),
+												PxFloor(mSrcVerts[i].y*weldTolerance + 0.5f),
+												PxFloor(mSrcVerts[i].z*weldTolerance + 0.5f));
+				}
+			}
+
+			const PxVec3*	mSrcVerts;
+			PxVec3*			mCleanVerts;
+			PxU32*			mVertexIndices;
+			const PxF32		mWeldTolerance;
+			PX_NOCOPY(SnapVertices)
+	};
+
+	// PT: writes the remapped indices of each triangle in place, or 0xffffffff as first index for rejected triangles.
+	// The compaction itself is done serially afterwards.
+	class FilterTriangles : public Cm::ParallelForCallback
+	{
+		public:
+			FilterTriangles(PxU32 nbVerts, const PxVec3* srcVerts, const PxU32* srcIndices, const PxU32* remapVerts, PxU32* indices, PxF32 limit) :
+				mNbVerts(nbVerts), mSrcVerts(srcVerts), mSrcIndices(srcIndices), mRemapVerts(remapVerts), mIndices(indices), mLimit(limit)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				const PxU32 nbVerts = mNbVerts;
+				for(PxU32 i=startIndex; i<endIndex; i++)
+				{
+					PxU32* dst = mIndices + i*3;
+					dst[0] = 0xffffffff;
+
+					PxU32 vref0 = mSrcIndices[i*3+0];
+					PxU32 vref1 = mSrcIndices[i*3+1];
+					PxU32 vref2 = mSrcIndices[i*3+2];
+					if(vref0>=nbVerts || vref1>=nbVerts || vref2>=nbVerts)
+						continue;
+
+					// PT: you can still get zero-area faces when the 3 vertices are perfectly aligned
+					const PxVec3& p0 = mSrcVerts[vref0];
+					const PxVec3& p1 = mSrcVerts[vref1];
+					const PxVec3& p2 = mSrcVerts[vref2];
+
+					const float area2 = ((p0 - p1).cross(p0 - p2)).magnitudeSquared();
+					if(area2<=mLimit)
+						continue;
+
+					vref0 = mRemapVerts[vref0];
+					vref1 = mRemapVerts[vref1];
+					vref2 = mRemapVerts[vref2];
+					if(vref0==vref1 || vref1==vref2 || vref2==vref0)
+						continue;
+
+					dst[0] = vref0;
+					dst[1] = vref1;
+					dst[2] = vref2;
+				}
+			}
+
+			const PxU32		mNbVerts;
+			const PxVec3*	mSrcVerts;
+			const PxU32*	mSrcIndices;
+			const PxU32*	mRemapVerts;
+			PxU32*			mIndices;
+			const PxF32		mLimit;
+			PX_NOCOPY(FilterTriangles)
+	};
+
+	class GatherVertices : public Cm::ParallelForCallback
+	{
+		public:
+			GatherVertices(const PxVec3* srcVerts, PxVec3* cleanVerts, const PxU32* vertexIndices) :
+				mSrcVerts(srcVerts), mCleanVerts(cleanVerts), mVertexIndices(vertexIndices)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				for(PxU32 i=startIndex; i<endIndex; i++)
+					mCleanVerts[i] = mSrcVerts[mVertexIndices[i]];
+			}
+
+			const PxVec3*	mSrcVerts;
+			PxVec3*			mCleanVerts;
+			const PxU32*	mVertexIndices;
+			PX_NOCOPY(GatherVertices)
+	};
+}
+
 struct Indices
 {
 	PxU32 mRef[3];
@@ -70,7 +171,7 @@ static PX_FORCE_INLINE PxU32 getHashValue(const Indices& v)
 	return c;
 }
 
-MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, const PxU32* srcIndices, PxF32 meshWeldTolerance, PxF32 areaLimit)
+MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, const PxU32* srcIndices, PxF32 meshWeldTolerance, PxF32 areaLimit, PxCpuDispatcher* dispatcher)
 {
 	PxVec3* cleanVerts = PX_ALLOCATE(PxVec3, nbVerts, "MeshCleaner");
 	PX_ASSERT(cleanVerts);
@@ -83,15 +184,9 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 	if(meshWeldTolerance!=0.0f)
 	{
 		vertexIndices = PX_ALLOCATE(PxU32, nbVerts, "MeshCleaner");
-		const PxF32 weldTolerance = 1.0f / meshWeldTolerance;
 		// snap to grid
-		for(PxU32 i=0; i<nbVerts; i++)
-		{
-			vertexIndices[i] = i;
-			cleanVerts[i] = PxVec3(	PxFloor(srcVerts[i].x*weldTolerance + 0.5f),
-									PxFloor(srcVerts[i].y*weldTolerance + 0.5f),
-									PxFloor(srcVerts[i].z*weldTolerance + 0.5f));
-		}
+		SnapVertices snap(srcVerts, cleanVerts, vertexIndices, 1.0f / meshWeldTolerance);
+		Cm::parallelFor(dispatcher, nbVerts, MESH_CLEANER_GRAIN, snap);
 	}
 	else
 	{
@@ -147,33 +242,22 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 	// <=> ((p0 - p1).cross(p0 - p2)).magnitudeSquared() < (areaLimit * 2.0)^2
 	const PxF32 limit = areaLimit * areaLimit * 4.0f;
 
+	{
+		FilterTriangles filter(nbVerts, srcVerts, srcIndices, remapVerts, indices, limit);
+		Cm::parallelFor(dispatcher, nbTris, MESH_CLEANER_GRAIN, filter);
+	}
+
+	// PT: compaction, in place since nbCleanedTris<=i
 	PxU32 nbCleanedTris = 0;
 	for(PxU32 i=0;i<nbTris;i++)
 	{
-		PxU32 vref0 = *srcIndices++;
-		PxU32 vref1 = *srcIndices++;
-		PxU32 vref2 = *srcIndices++;
-		if(vref0>=nbVerts || vref1>=nbVerts || vref2>=nbVerts)
-			continue;
-
-		// PT: you can still get zero-area faces when the 3 vertices are perfectly aligned
-		const PxVec3& p0 = srcVerts[vref0];
-		const PxVec3& p1 = srcVerts[vref1];
-		const PxVec3& p2 = srcVerts[vref2];
-
-		const float area2 = ((p0 - p1).cross(p0 - p2)).magnitudeSquared();
-		if(area2<=limit)
-			continue;
-
-		vref0 = remapVerts[vref0];
-		vref1 = remapVerts[vref1];
-		vref2 = remapVerts[vref2];
-		if(vref0==vref1 || vref1==vref2 || vref2==vref0)
+		const PxU32 vref0 = indices[i*3+0];
+		if(vref0==0xffffffff)
 			continue;
 
 		indices[nbCleanedTris*3+0] = vref0;
-		indices[nbCleanedTris*3+1] = vref1;
-		indices[nbCleanedTris*3+2] = vref2;
+		indices[nbCleanedTris*3+1] = indices[i*3+1];
+		indices[nbCleanedTris*3+2] = indices[i*3+2];
 		remapTriangles[nbCleanedTris] = i;
 		nbCleanedTris++;
 	}
@@ -210,8 +294,8 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 
 	if(vertexIndices)
 	{
-		for(PxU32 i=0;i<nbCleanedVerts;i++)
-			cleanVerts[i] = srcVerts[vertexIndices[i]];
+		GatherVertices gather(srcVerts, cleanVerts, vertexIndices);
+		Cm::parallelFor(dispatcher, nbCleanedVerts, MESH_CLEANER_GRAIN, gather);
 		PX_FREE(vertexIndices);
 	}
 	mNbVerts	= nbCleanedVerts;
@@ -33,12 +33,15 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Gu
 {
 	class MeshCleaner
 	{
 		public:
-			MeshCleaner(PxU32 nbVerts, const PxVec3* verts, PxU32 nbTris, const PxU32* indices, PxF32 meshWeldTolerance, PxF32 areaLimit);
+			// PT: the optional dispatcher is used for the per-vertex and per-triangle passes. It doesn't change the results.
+			MeshCleaner(PxU32 nbVerts, const PxVec3* verts, PxU32 nbTris, const PxU32* indices, PxF32 meshWeldTolerance, PxF32 areaLimit, PxCpuDispatcher* dispatcher=NULL);
 			~MeshCleaner();
 
 			PxU32	mNbVerts;
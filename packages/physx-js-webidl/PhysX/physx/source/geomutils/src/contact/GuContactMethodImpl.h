@@ -39,6 +39,7 @@ namespace physx
 	class PxGeometry;
 	class PxRenderOutput;
 	class PxContactBuffer;
+	struct PxContactPoint;
 
 namespace Gu
 {
@@ -174,6 +175,15 @@ namespace Gu
 	PX_PHYSX_COMMON_API bool contactCustomGeometryGeometry(GU_CONTACT_METHOD_ARGS);
 	PX_PHYSX_COMMON_API bool contactGeometryCustomGeometry(GU_CONTACT_METHOD_ARGS);
 
+	// PT: 4-wide versions of the sphere-sphere & sphere-capsule functions, used by the batched narrowphase. Spheres and capsules
+	// are passed as (center, radius), capsule axes are the x axes of the capsule rotations. Each touching pair outputs a single
+	// contact in contacts[i], and the returned value is the mask of touching pairs (bit i for pair i). Results are the same as for
+	// the regular functions. The pcm parameter selects the contact point used by the PCM sphere-sphere function.
+	PX_PHYSX_COMMON_API PxU32 contactSphereSphere4(const PxVec4* PX_RESTRICT spheres0, const PxVec4* PX_RESTRICT spheres1, const PxReal* PX_RESTRICT contactDistances,
+													PxContactPoint* PX_RESTRICT contacts, bool pcm);
+	PX_PHYSX_COMMON_API PxU32 contactSphereCapsule4(const PxVec4* PX_RESTRICT spheres, const PxVec4* PX_RESTRICT capsules, const PxQuat* PX_RESTRICT capsuleRotations,
+													const PxReal* PX_RESTRICT halfHeights, const PxReal* PX_RESTRICT contactDistances, PxContactPoint* PX_RESTRICT contacts);
+
 	PX_PHYSX_COMMON_API bool pcmContactSphereMesh(GU_CONTACT_METHOD_ARGS);
 	PX_PHYSX_COMMON_API bool pcmContactCapsuleMesh(GU_CONTACT_METHOD_ARGS);
 	PX_PHYSX_COMMON_API bool pcmContactBoxMesh(GU_CONTACT_METHOD_ARGS);
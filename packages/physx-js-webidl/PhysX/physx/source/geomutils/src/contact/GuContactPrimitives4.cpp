@@ -0,0 +1,204 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxVecMath.h"
+#include "geomutils/PxContactBuffer.h"
+#include "GuContactMethodImpl.h"
+
+using namespace physx;
+using namespace aos;
+
+// PT: 4-wide versions of the sphere-sphere & sphere-capsule contact functions. Inputs are transposed to SoA form so that the
+// four pairs are processed in parallel, then outputs are transposed back and only written out for touching pairs.
+
+static PX_FORCE_INLINE void loadTransposed4(const PxVec4* PX_RESTRICT src, Vec4V& x, Vec4V& y, Vec4V& z, Vec4V& w)
+{
+	x = V4LoadU(&src[0].x);
+	y = V4LoadU(&src[1].x);
+	z = V4LoadU(&src[2].x);
+	w = V4LoadU(&src[3].x);
+	V4Transpose(x, y, z, w);
+}
+
+static PX_FORCE_INLINE void storeContacts4(PxContactPoint* PX_RESTRICT contacts, PxU32 mask,
+											Vec4V nx, Vec4V ny, Vec4V nz, Vec4V sep,
+											Vec4V px, Vec4V py, Vec4V pz, Vec4V pw)
+{
+	// PT: after the transposes, normals[i] = (n, separation) and points[i] = (p, unused) for pair i
+	V4Transpose(nx, ny, nz, sep);
+	V4Transpose(px, py, pz, pw);
+
+	PX_ALIGN(16, PxVec4 normals[4]);
+	PX_ALIGN(16, PxVec4 points[4]);
+	V4StoreA(nx, &normals[0].x);
+	V4StoreA(ny, &normals[1].x);
+	V4StoreA(nz, &normals[2].x);
+	V4StoreA(sep, &normals[3].x);
+	V4StoreA(px, &points[0].x);
+	V4StoreA(py, &points[1].x);
+	V4StoreA(pz, &points[2].x);
+	V4StoreA(pw, &points[3].x);
+
+	for(PxU32 i=0;i<4;i++)
+	{
+		if(mask & (1<<i))
+		{
+			PxContactPoint& c = contacts[i];
+			c.normal			= normals[i].getXYZ();
+			c.separation		= normals[i].w;
+			c.point				= points[i].getXYZ();
+			c.internalFaceIndex1= PXC_CONTACT_NO_FACE_INDEX;
+		}
+	}
+}
+
+PxU32 Gu::contactSphereSphere4(const PxVec4* PX_RESTRICT spheres0, const PxVec4* PX_RESTRICT spheres1, const PxReal* PX_RESTRICT contactDistances,
+								PxContactPoint* PX_RESTRICT contacts, bool pcm)
+{
+	Vec4V p0x, p0y, p0z, r0;
+	Vec4V p1x, p1y, p1z, r1;
+	loadTransposed4(spheres0, p0x, p0y, p0z, r0);
+	loadTransposed4(spheres1, p1x, p1y, p1z, r1);
+
+	const Vec4V cDist = V4LoadU(contactDistances);
+
+	const Vec4V dx = V4Sub(p0x, p1x);
+	const Vec4V dy = V4Sub(p0y, p1y);
+	const Vec4V dz = V4Sub(p0z, p1z);
+	const Vec4V distanceSq = V4MulAdd(dx, dx, V4MulAdd(dy, dy, V4Mul(dz, dz)));
+	const Vec4V radiusSum = V4Add(r0, r1);
+	const Vec4V inflatedSum = V4Add(radiusSum, cDist);
+
+	const PxU32 mask = BGetBitMask(V4IsGrtr(V4Mul(inflatedSum, inflatedSum), distanceSq));
+	if(!mask)
+		return 0;
+
+	const Vec4V zero = V4Zero();
+	const Vec4V one = V4One();
+	const Vec4V dist = V4Sqrt(distanceSq);
+
+	// PT: spheres are exactly overlapping => can't create normal => pick up random one
+	const BoolV degenerate = V4IsGrtrOrEq(V4Load(0.00001f), dist);
+	const Vec4V invDist = V4Recip(V4Sel(degenerate, one, dist));
+	const Vec4V nx = V4Sel(degenerate, one, V4Mul(dx, invDist));
+	const Vec4V ny = V4Sel(degenerate, zero, V4Mul(dy, invDist));
+	const Vec4V nz = V4Sel(degenerate, zero, V4Mul(dz, invDist));
+
+	Vec4V px, py, pz;
+	if(pcm)
+	{
+		px = V4MulAdd(nx, r1, p1x);
+		py = V4MulAdd(ny, r1, p1y);
+		pz = V4MulAdd(nz, r1, p1z);
+	}
+	else
+	{
+		const Vec4V coeff = V4Mul(V4Sub(V4Add(r0, dist), r1), V4Load(-0.5f));
+		px = V4MulAdd(nx, coeff, p0x);
+		py = V4MulAdd(ny, coeff, p0y);
+		pz = V4MulAdd(nz, coeff, p0z);
+	}
+
+	storeContacts4(contacts, mask, nx, ny, nz, V4Sub(dist, radiusSum), px, py, pz, zero);
+	return mask;
+}
+
+PxU32 Gu::contactSphereCapsule4(const PxVec4* PX_RESTRICT spheres, const PxVec4* PX_RESTRICT capsules, const PxQuat* PX_RESTRICT capsuleRotations,
+								const PxReal* PX_RESTRICT halfHeights, const PxReal* PX_RESTRICT contactDistances, PxContactPoint* PX_RESTRICT contacts)
+{
+	Vec4V cx, cy, cz, sphereRadius;
+	Vec4V p1x, p1y, p1z, capsuleRadius;
+	loadTransposed4(spheres, cx, cy, cz, sphereRadius);
+	loadTransposed4(capsules, p1x, p1y, p1z, capsuleRadius);
+
+	Vec4V qx = V4LoadU(&capsuleRotations[0].x);
+	Vec4V qy = V4LoadU(&capsuleRotations[1].x);
+	Vec4V qz = V4LoadU(&capsuleRotations[2].x);
+	Vec4V qw = V4LoadU(&capsuleRotations[3].x);
+	V4Transpose(qx, qy, qz, qw);
+
+	const Vec4V halfHeight = V4LoadU(halfHeights);
+	const Vec4V cDist = V4LoadU(contactDistances);
+
+	const Vec4V zero = V4Zero();
+	const Vec4V one = V4One();
+	const Vec4V two = V4Add(one, one);
+
+	// PT: capsule axis = basis vector 0 of the capsule rotation, scaled by the half-height
+	const Vec4V bx = V4MulAdd(V4Mul(qx, qx), two, V4Sub(V4Mul(V4Mul(qw, qw), two), one));
+	const Vec4V by = V4Mul(V4MulAdd(qx, qy, V4Mul(qz, qw)), two);
+	const Vec4V bz = V4Mul(V4Sub(V4Mul(qx, qz), V4Mul(qy, qw)), two);
+	const Vec4V ax = V4Mul(bx, halfHeight);
+	const Vec4V ay = V4Mul(by, halfHeight);
+	const Vec4V az = V4Mul(bz, halfHeight);
+
+	// PT: sphere center in capsule space. The segment goes from a = axis to b = -axis, i.e. ab = -2*axis
+	const Vec4V lx = V4Sub(cx, p1x);
+	const Vec4V ly = V4Sub(cy, p1y);
+	const Vec4V lz = V4Sub(cz, p1z);
+	const Vec4V apx = V4Sub(lx, ax);
+	const Vec4V apy = V4Sub(ly, ay);
+	const Vec4V apz = V4Sub(lz, az);
+	const Vec4V abx = V4Mul(ax, V4Load(-2.0f));
+	const Vec4V aby = V4Mul(ay, V4Load(-2.0f));
+	const Vec4V abz = V4Mul(az, V4Load(-2.0f));
+
+	const Vec4V nom = V4MulAdd(apx, abx, V4MulAdd(apy, aby, V4Mul(apz, abz)));
+	const Vec4V denom = V4MulAdd(abx, abx, V4MulAdd(aby, aby, V4Mul(abz, abz)));
+	const BoolV zeroDenom = V4IsEq(denom, zero);
+	const Vec4V t = V4Sel(zeroDenom, zero, V4Clamp(V4Div(nom, V4Sel(zeroDenom, one, denom)), zero, one));
+
+	// PT: dir = sphere center - closest point on segment. Computed from the local center like in the regular function,
+	// so that a sphere centered on the segment gets an exactly zero vector.
+	const Vec4V dx = V4Sub(lx, V4MulAdd(abx, t, ax));
+	const Vec4V dy = V4Sub(ly, V4MulAdd(aby, t, ay));
+	const Vec4V dz = V4Sub(lz, V4MulAdd(abz, t, az));
+	const Vec4V squareDist = V4MulAdd(dx, dx, V4MulAdd(dy, dy, V4Mul(dz, dz)));
+
+	const Vec4V radiusSum = V4Add(sphereRadius, capsuleRadius);
+	const Vec4V inflatedSum = V4Add(radiusSum, cDist);
+
+	const PxU32 mask = BGetBitMask(V4IsGrtr(V4Mul(inflatedSum, inflatedSum), squareDist));
+	if(!mask)
+		return 0;
+
+	// PT: zero normal => pick up random one
+	const Vec4V dist = V4Sqrt(squareDist);
+	const BoolV degenerate = V4IsEq(squareDist, zero);
+	const Vec4V invDist = V4Recip(V4Sel(degenerate, one, dist));
+	const Vec4V nx = V4Sel(degenerate, one, V4Mul(dx, invDist));
+	const Vec4V ny = V4Sel(degenerate, zero, V4Mul(dy, invDist));
+	const Vec4V nz = V4Sel(degenerate, zero, V4Mul(dz, invDist));
+
+	const Vec4V px = V4NegMulSub(nx, sphereRadius, cx);
+	const Vec4V py = V4NegMulSub(ny, sphereRadius, cy);
+	const Vec4V pz = V4NegMulSub(nz, sphereRadius, cz);
+
+	storeContacts4(contacts, mask, nx, ny, nz, V4Sub(dist, radiusSum), px, py, pz, zero);
+	return mask;
+}
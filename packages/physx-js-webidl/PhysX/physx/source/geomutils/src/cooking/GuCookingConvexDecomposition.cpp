@@ -0,0 +1,519 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "GuCooking.h"
+#include "GuCookingQuickHullConvexHullLib.h"
+#include "GuIntersectionTriangleBox.h"
+#include "CmParallelFor.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxBounds3.h"
+#include "foundation/PxFPU.h"
+#include "foundation/PxMemory.h"
+#include "common/PxInsertionCallback.h"
+
+using namespace physx;
+using namespace Gu;
+
+///////////////////////////////////////////////////////////////////////////////
+
+PX_IMPLEMENT_OUTPUT_ERROR
+
+///////////////////////////////////////////////////////////////////////////////
+
+// PT: approximate convex decomposition, in the spirit of V-HACD:
+// - the mesh is voxelized and its interior filled
+// - parts are recursively split by axis-aligned planes, always splitting the most concave part first. Concavity is
+// the volume difference between a part's convex hull and its voxels, and each split picks the candidate plane that
+// minimizes the total concavity of both sides
+// - the final hulls are cooked from the parts' voxels with PxConvexMeshDesc::vertexLimit set to the user's limit
+// The hulls enclose the voxelized parts, so they can be up to one voxel larger than the input mesh.
+
+#define DECOMPOSITION_MAX_CANDIDATES_PER_AXIS	8
+
+namespace
+{
+	enum VoxelState
+	{
+		VOXEL_INSIDE,	// PT: unknown during voxelization, i.e. inside once the exterior has been flood-filled
+		VOXEL_SURFACE,
+		VOXEL_OUTSIDE
+	};
+
+	// PT: voxel coordinates are packed in 10 bits per axis
+	PX_FORCE_INLINE PxU32 packVoxel(PxU32 x, PxU32 y, PxU32 z)	{ return x | (y<<10) | (z<<20);	}
+	PX_FORCE_INLINE PxU32 getVoxelCoord(PxU32 voxel, PxU32 axis)	{ return (voxel>>(axis*10)) & 1023;	}
+
+	struct VoxelGrid
+	{
+		PxVec3	mOrigin;
+		float	mVoxelSize;
+		PxU32	mDims[3];
+
+		PX_FORCE_INLINE	PxU32	getIndex(PxU32 x, PxU32 y, PxU32 z)	const	{ return x + mDims[0]*(y + mDims[1]*z);	}
+		PX_FORCE_INLINE	PxVec3	getCorner(PxU32 x, PxU32 y, PxU32 z)	const	{ return mOrigin + PxVec3(float(x), float(y), float(z))*mVoxelSize;	}
+	};
+
+	struct Part
+	{
+		PxArray<PxU32>	mVoxels;
+		PxU32			mMin[3];
+		PxU32			mMax[3];
+		float			mConcavity;
+		bool			mDone;
+
+		void	computeRange()
+		{
+			for(PxU32 axis=0;axis<3;axis++)
+			{
+				mMin[axis] = 0xffffffff;
+				mMax[axis] = 0;
+			}
+			const PxU32 nb = mVoxels.size();
+			for(PxU32 i=0;i<nb;i++)
+			{
+				for(PxU32 axis=0;axis<3;axis++)
+				{
+					const PxU32 c = getVoxelCoord(mVoxels[i], axis);
+					mMin[axis] = PxMin(mMin[axis], c);
+					mMax[axis] = PxMax(mMax[axis], c);
+				}
+			}
+		}
+	};
+
+	// PT: the convex hull of a set of voxels is the convex hull of the first & last voxels of each row along X, so we
+	// only output the corners of these voxels. Voxels are selected with the (axis, splitCoord, left) filter, where
+	// splitCoord==0xffffffff selects all of them.
+	class HullPointsGatherer
+	{
+		public:
+			HullPointsGatherer(const VoxelGrid& grid) : mGrid(grid)
+			{
+				const PxU32 nbRows = grid.mDims[1]*grid.mDims[2];
+				mRowMin.resize(nbRows, 0xffffffff);
+				mRowMax.resize(nbRows, 0);
+			}
+
+			PxU32	gather(const Part& part, PxU32 axis, PxU32 splitCoord, bool left, PxArray<PxVec3>& points)
+			{
+				PxU32 nbVoxels = 0;
+				const PxU32 nb = part.mVoxels.size();
+				for(PxU32 i=0;i<nb;i++)
+				{
+					const PxU32 voxel = part.mVoxels[i];
+					if(splitCoord!=0xffffffff && (getVoxelCoord(voxel, axis)<splitCoord)!=left)
+						continue;
+
+					nbVoxels++;
+					const PxU32 x = getVoxelCoord(voxel, 0);
+					const PxU32 row = getVoxelCoord(voxel, 1) + mGrid.mDims[1]*getVoxelCoord(voxel, 2);
+					if(mRowMin[row]==0xffffffff)
+						mTouchedRows.pushBack(row);
+					mRowMin[row] = PxMin(mRowMin[row], x);
+					mRowMax[row] = PxMax(mRowMax[row], x);
+				}
+
+				const PxU32 nbRows = mTouchedRows.size();
+				for(PxU32 i=0;i<nbRows;i++)
+				{
+					const PxU32 row = mTouchedRows[i];
+					const PxU32 y = row % mGrid.mDims[1];
+					const PxU32 z = row / mGrid.mDims[1];
+					const PxU32 xs[2] = { mRowMin[row], mRowMax[row] + 1 };
+					for(PxU32 j=0;j<2;j++)
+					{
+						points.pushBack(mGrid.getCorner(xs[j], y,	z));
+						points.pushBack(mGrid.getCorner(xs[j], y+1,	z));
+						points.pushBack(mGrid.getCorner(xs[j], y,	z+1));
+						points.pushBack(mGrid.getCorner(xs[j], y+1,	z+1));
+					}
+					mRowMin[row] = 0xffffffff;
+					mRowMax[row] = 0;
+				}
+				mTouchedRows.clear();
+				return nbVoxels;
+			}
+
+		private:
+			const VoxelGrid&	mGrid;
+			PxArray<PxU32>		mRowMin;
+			PxArray<PxU32>		mRowMax;
+			PxArray<PxU32>		mTouchedRows;
+			PX_NOCOPY(HullPointsGatherer)
+	};
+
+	// PT: returns a negative value if the hull couldn't be computed
+	float computeHullVolume(const PxCookingParams& params, const PxArray<PxVec3>& points)
+	{
+		if(points.size()<4)
+			return -1.0f;
+
+		PxConvexMeshDesc desc;
+		desc.points.count	= points.size();
+		desc.points.stride	= sizeof(PxVec3);
+		desc.points.data	= points.begin();
+		desc.flags			= PxConvexFlag::eCOMPUTE_CONVEX;
+
+		QuickHullConvexHullLib hullLib(desc, params);
+		const PxConvexMeshCookingResult::Enum res = hullLib.createConvexHull();
+		if(res!=PxConvexMeshCookingResult::eSUCCESS && res!=PxConvexMeshCookingResult::ePOLYGONS_LIMIT_REACHED)
+			return -1.0f;
+
+		PxConvexMeshDesc hullDesc;
+		hullLib.fillConvexMeshDesc(hullDesc);
+
+		const PxVec3* verts = reinterpret_cast<const PxVec3*>(hullDesc.points.data);
+		const PxU32* indices = reinterpret_cast<const PxU32*>(hullDesc.indices.data);
+		const PxHullPolygon* polygons = reinterpret_cast<const PxHullPolygon*>(hullDesc.polygons.data);
+
+		// PT: sum of the pyramids from an inner point to each polygon
+		PxVec3 center(0.0f);
+		for(PxU32 i=0;i<hullDesc.points.count;i++)
+			center += verts[i];
+		center /= float(hullDesc.points.count);
+
+		float volume = 0.0f;
+		for(PxU32 i=0;i<hullDesc.polygons.count;i++)
+		{
+			const PxHullPolygon& polygon = polygons[i];
+			const PxU32* polygonIndices = indices + polygon.mIndexBase;
+			const PxVec3& p0 = verts[polygonIndices[0]];
+			PxVec3 areaVector(0.0f);
+			for(PxU32 j=2;j<polygon.mNbVerts;j++)
+				areaVector += (verts[polygonIndices[j-1]] - p0).cross(verts[polygonIndices[j]] - p0);
+			const float area = areaVector.magnitude()*0.5f;
+			const float height = -(polygon.mPlane[0]*center.x + polygon.mPlane[1]*center.y + polygon.mPlane[2]*center.z + polygon.mPlane[3]);
+			volume += area*height/3.0f;
+		}
+		return volume;
+	}
+
+	struct SplitCandidate
+	{
+		PxU32	mAxis;
+		PxU32	mCoord;		// PT: voxels with a smaller coordinate go to the left side
+		float	mCost;		// PT: total concavity of both sides, negative if the split is invalid
+		float	mConcavity[2];
+	};
+
+	class EvaluateSplits : public Cm::ParallelForCallback
+	{
+		public:
+			EvaluateSplits(const PxCookingParams& params, const VoxelGrid& grid, const Part& part, SplitCandidate* candidates) :
+				mParams(params), mGrid(grid), mPart(part), mCandidates(candidates)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				PX_FPU_GUARD;
+
+				HullPointsGatherer gatherer(mGrid);
+				PxArray<PxVec3> points;
+				const float voxelVolume = mGrid.mVoxelSize*mGrid.mVoxelSize*mGrid.mVoxelSize;
+
+				for(PxU32 i=startIndex; i<endIndex; i++)
+				{
+					SplitCandidate& candidate = mCandidates[i];
+					candidate.mCost = -1.0f;
+
+					float cost = 0.0f;
+					bool valid = true;
+					for(PxU32 side=0; side<2 && valid; side++)
+					{
+						points.clear();
+						const PxU32 nbVoxels = gatherer.gather(mPart, candidate.mAxis, candidate.mCoord, side==0, points);
+						const float hullVolume = computeHullVolume(mParams, points);
+						valid = nbVoxels && hullVolume>=0.0f;
+						candidate.mConcavity[side] = PxMax(hullVolume - float(nbVoxels)*voxelVolume, 0.0f);
+						cost += candidate.mConcavity[side];
+					}
+					if(valid)
+						candidate.mCost = cost;
+				}
+			}
+
+			const PxCookingParams&	mParams;
+			const VoxelGrid&		mGrid;
+			const Part&				mPart;
+			SplitCandidate*			mCandidates;
+			PX_NOCOPY(EvaluateSplits)
+	};
+
+	bool voxelize(const PxSimpleTriangleMesh& mesh, PxU32 resolution, VoxelGrid& grid, PxArray<PxU8>& states)
+	{
+		const PxVec3* points = reinterpret_cast<const PxVec3*>(mesh.points.data);
+
+		PxBounds3 bounds = PxBounds3::empty();
+		for(PxU32 i=0;i<mesh.points.count;i++)
+			bounds.include(*reinterpret_cast<const PxVec3*>(reinterpret_cast<const PxU8*>(points) + i*mesh.points.stride));
+
+		const PxVec3 extents = bounds.getDimensions();
+		const float maxExtent = PxMax(extents.x, PxMax(extents.y, extents.z));
+		if(!(maxExtent>0.0f))
+			return false;
+
+		// PT: one voxel of padding on each side, so that the exterior is connected
+		grid.mVoxelSize = maxExtent/float(resolution);
+		grid.mOrigin = bounds.minimum - PxVec3(grid.mVoxelSize);
+		for(PxU32 axis=0;axis<3;axis++)
+			grid.mDims[axis] = PxMin(PxU32(extents[axis]/grid.mVoxelSize) + 3, resolution + 3);
+
+		const PxU32 nbVoxels = grid.mDims[0]*grid.mDims[1]*grid.mDims[2];
+		states.resize(nbVoxels, PxU8(VOXEL_INSIDE));
+
+		const PxVec3 halfVoxel(grid.mVoxelSize*0.5f);
+		const bool has16BitIndices = mesh.flags & PxMeshFlag::e16_BIT_INDICES;
+		const PxU8* triangles = reinterpret_cast<const PxU8*>(mesh.triangles.data);
+		for(PxU32 i=0;i<mesh.triangles.count;i++)
+		{
+			PxU32 vref[3];
+			if(has16BitIndices)
+			{
+				const PxU16* tri = reinterpret_cast<const PxU16*>(triangles + i*mesh.triangles.stride);
+				vref[0] = tri[0];	vref[1] = tri[1];	vref[2] = tri[2];
+			}
+			else
+			{
+				const PxU32* tri = reinterpret_cast<const PxU32*>(triangles + i*mesh.triangles.stride);
+				vref[0] = tri[0];	vref[1] = tri[1];	vref[2] = tri[2];
+			}
+
+			const PxVec3& p0 = *reinterpret_cast<const PxVec3*>(reinterpret_cast<const PxU8*>(points) + vref[0]*mesh.points.stride);
+			const PxVec3& p1 = *reinterpret_cast<const PxVec3*>(reinterpret_cast<const PxU8*>(points) + vref[1]*mesh.points.stride);
+			const PxVec3& p2 = *reinterpret_cast<const PxVec3*>(reinterpret_cast<const PxU8*>(points) + vref[2]*mesh.points.stride);
+
+			PxBounds3 triBounds = PxBounds3::empty();
+			triBounds.include(p0);
+			triBounds.include(p1);
+			triBounds.include(p2);
+
+			PxU32 minCoords[3], maxCoords[3];
+			for(PxU32 axis=0;axis<3;axis++)
+			{
+				const float minC = (triBounds.minimum[axis] - grid.mOrigin[axis])/grid.mVoxelSize;
+				const float maxC = (triBounds.maximum[axis] - grid.mOrigin[axis])/grid.mVoxelSize;
+				minCoords[axis] = PxClamp(PxU32(PxMax(minC, 0.0f)), PxU32(1), grid.mDims[axis]-2);
+				maxCoords[axis] = PxClamp(PxU32(PxMax(maxC, 0.0f)), PxU32(1), grid.mDims[axis]-2);
+			}
+
+			for(PxU32 z=minCoords[2];z<=maxCoords[2];z++)
+			for(PxU32 y=minCoords[1];y<=maxCoords[1];y++)
+			for(PxU32 x=minCoords[0];x<=maxCoords[0];x++)
+			{
+				PxU8& state = states[grid.getIndex(x, y, z)];
+				if(state==VOXEL_SURFACE)
+					continue;
+				if(intersectTriangleBox_ReferenceCode(grid.getCorner(x, y, z) + halfVoxel, halfVoxel, p0, p1, p2))
+					state = VOXEL_SURFACE;
+			}
+		}
+
+		// PT: flood-fill the exterior from a padding voxel. Whatever isn't reached is inside. For open meshes the fill
+		// leaks inside and only the surface voxels remain, which still gives a usable decomposition of the shell.
+		PxArray<PxU32> stack;
+		states[0] = VOXEL_OUTSIDE;
+		stack.pushBack(0);
+		while(stack.size())
+		{
+			const PxU32 index = stack.popBack();
+			const PxU32 x = index % grid.mDims[0];
+			const PxU32 y = (index / grid.mDims[0]) % grid.mDims[1];
+			const PxU32 z = index / (grid.mDims[0]*grid.mDims[1]);
+
+			const PxU32 nbNeighbors = 6;
+			const PxI32 offsets[nbNeighbors][3] = { {-1,0,0}, {1,0,0}, {0,-1,0}, {0,1,0}, {0,0,-1}, {0,0,1} };
+			for(PxU32 j=0;j<nbNeighbors;j++)
+			{
+				const PxI32 nx = PxI32(x) + offsets[j][0];
+				const PxI32 ny = PxI32(y) + offsets[j][1];
+				const PxI32 nz = PxI32(z) + offsets[j][2];
+				if(nx<0 || ny<0 || nz<0 || nx>=PxI32(grid.mDims[0]) || ny>=PxI32(grid.mDims[1]) || nz>=PxI32(grid.mDims[2]))
+					continue;
+				const PxU32 neighbor = grid.getIndex(PxU32(nx), PxU32(ny), PxU32(nz));
+				if(states[neighbor]==VOXEL_INSIDE)
+				{
+					states[neighbor] = VOXEL_OUTSIDE;
+					stack.pushBack(neighbor);
+				}
+			}
+		}
+		return true;
+	}
+
+	bool splitPart(const PxCookingParams& params, const VoxelGrid& grid, Part& part, Part& newPart)
+	{
+		SplitCandidate candidates[3*DECOMPOSITION_MAX_CANDIDATES_PER_AXIS];
+		PxU32 nbCandidates = 0;
+		for(PxU32 axis=0;axis<3;axis++)
+		{
+			const PxU32 extent = part.mMax[axis] - part.mMin[axis];
+			const PxU32 nb = PxMin(extent, PxU32(DECOMPOSITION_MAX_CANDIDATES_PER_AXIS));
+			for(PxU32 i=0;i<nb;i++)
+			{
+				SplitCandidate& candidate = candidates[nbCandidates++];
+				candidate.mAxis = axis;
+				candidate.mCoord = part.mMin[axis] + 1 + (i*extent)/nb;
+			}
+		}
+		if(!nbCandidates)
+			return false;
+
+		EvaluateSplits evaluate(params, grid, part, candidates);
+		Cm::parallelFor(params.cpuDispatcher, nbCandidates, 1, evaluate);
+
+		const SplitCandidate* best = NULL;
+		for(PxU32 i=0;i<nbCandidates;i++)
+		{
+			if(candidates[i].mCost>=0.0f && (!best || candidates[i].mCost<best->mCost))
+				best = candidates + i;
+		}
+		if(!best)
+			return false;
+
+		PxArray<PxU32> leftVoxels;
+		const PxU32 nb = part.mVoxels.size();
+		for(PxU32 i=0;i<nb;i++)
+		{
+			const PxU32 voxel = part.mVoxels[i];
+			if(getVoxelCoord(voxel, best->mAxis)<best->mCoord)
+				leftVoxels.pushBack(voxel);
+			else
+				newPart.mVoxels.pushBack(voxel);
+		}
+		part.mVoxels.swap(leftVoxels);
+
+		part.computeRange();
+		part.mConcavity = best->mConcavity[0];
+		part.mDone = false;
+		newPart.computeRange();
+		newPart.mConcavity = best->mConcavity[1];
+		newPart.mDone = false;
+		return true;
+	}
+}
+
+PxU32 immediateCooking::createConvexDecomposition(const PxCookingParams& params, const PxSimpleTriangleMesh& mesh, const PxConvexDecompositionParams& decompositionParams,
+													PxConvexMesh** hulls, PxInsertionCallback& insertionCallback)
+{
+	if(!mesh.isValid())
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxCreateConvexDecomposition: user-provided triangle mesh descriptor is invalid!");
+
+	if(!decompositionParams.isValid())
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxCreateConvexDecomposition: user-provided decomposition parameters are invalid!");
+
+	PX_FPU_GUARD;
+
+	VoxelGrid grid;
+	PxArray<PxU8> states;
+	if(!voxelize(mesh, decompositionParams.voxelResolution, grid, states))
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxCreateConvexDecomposition: mesh has no volume!");
+
+	PxArray<Part> parts;
+	parts.reserve(decompositionParams.maxNbHulls);
+	{
+		Part& root = parts.insert();
+		for(PxU32 z=0;z<grid.mDims[2];z++)
+		for(PxU32 y=0;y<grid.mDims[1];y++)
+		for(PxU32 x=0;x<grid.mDims[0];x++)
+		{
+			if(states[grid.getIndex(x, y, z)]!=VOXEL_OUTSIDE)
+				root.mVoxels.pushBack(packVoxel(x, y, z));
+		}
+		root.computeRange();
+		root.mDone = false;
+	}
+
+	PxArray<PxVec3> points;
+	float rootHullVolume;
+	{
+		HullPointsGatherer gatherer(grid);
+		const PxU32 nbVoxels = gatherer.gather(parts[0], 0, 0xffffffff, true, points);
+		rootHullVolume = computeHullVolume(params, points);
+		if(rootHullVolume<0.0f)
+			return outputError<PxErrorCode::eINTERNAL_ERROR>(__LINE__, "PxCreateConvexDecomposition: failed to compute the mesh's convex hull!");
+		parts[0].mConcavity = PxMax(rootHullVolume - float(nbVoxels)*grid.mVoxelSize*grid.mVoxelSize*grid.mVoxelSize, 0.0f);
+	}
+
+	// PT: split the most concave part until it's convex enough or we run out of hulls
+	const float concavityLimit = decompositionParams.maxConcavity*rootHullVolume;
+	while(parts.size()<decompositionParams.maxNbHulls)
+	{
+		Part* mostConcave = NULL;
+		for(PxU32 i=0;i<parts.size();i++)
+		{
+			if(!parts[i].mDone && (!mostConcave || parts[i].mConcavity>mostConcave->mConcavity))
+				mostConcave = &parts[i];
+		}
+		if(!mostConcave || mostConcave->mConcavity<=concavityLimit)
+			break;
+
+		Part newPart;
+		if(splitPart(params, grid, *mostConcave, newPart))
+			parts.pushBack(newPart);	// PT: no reallocation thanks to the reserve() above, mostConcave stays valid
+		else
+			mostConcave->mDone = true;
+	}
+
+	// PT: cook the final hulls in one batch
+	const PxU32 nbParts = parts.size();
+	PxArray<PxU32> offsets(nbParts+1);
+	points.clear();
+	{
+		HullPointsGatherer gatherer(grid);
+		for(PxU32 i=0;i<nbParts;i++)
+		{
+			offsets[i] = points.size();
+			gatherer.gather(parts[i], 0, 0xffffffff, true, points);
+		}
+		offsets[nbParts] = points.size();
+	}
+
+	PxArray<PxConvexMeshDesc> descs(nbParts);
+	for(PxU32 i=0;i<nbParts;i++)
+	{
+		PxConvexMeshDesc& desc = descs[i];
+		desc.points.count	= offsets[i+1] - offsets[i];
+		desc.points.stride	= sizeof(PxVec3);
+		desc.points.data	= points.begin() + offsets[i];
+		desc.flags			= PxConvexFlag::eCOMPUTE_CONVEX;
+		desc.vertexLimit	= decompositionParams.maxNbVerticesPerHull;
+	}
+
+	PxConvexMesh** meshes = PX_ALLOCATE(PxConvexMesh*, nbParts, "ConvexDecompositionHulls");
+	createConvexMeshes(params, descs.begin(), nbParts, meshes, insertionCallback);
+
+	PxU32 nbHulls = 0;
+	for(PxU32 i=0;i<nbParts;i++)
+	{
+		if(meshes[i])
+			hulls[nbHulls++] = meshes[i];
+	}
+	PX_FREE(meshes);
+
+	if(nbHulls!=nbParts)
+		outputError<PxErrorCode::eDEBUG_WARNING>(__LINE__, "PxCreateConvexDecomposition: some hulls failed to cook and have been skipped.");
+
+	return nbHulls;
+}
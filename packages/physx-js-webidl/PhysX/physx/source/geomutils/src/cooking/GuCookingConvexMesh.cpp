@@ -33,6 +33,8 @@
 #include "foundation/PxAlloca.h"
 #include "foundation/PxFPU.h"
 #include "common/PxInsertionCallback.h"
+#include "foundation/PxHashMap.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 using namespace Gu;
@@ -213,6 +215,212 @@ PxConvexMesh* immediateCooking::createConvexMesh(const PxCookingParams& params,
 	return convexMesh;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	// PT: FNV-1a over the descriptor data. Strided data is hashed element by element so that the stride doesn't change the key.
+	class DescHash
+	{
+		public:
+		PX_FORCE_INLINE	DescHash() : mHash(14695981039346656037ull)	{}
+
+		PX_FORCE_INLINE	void	addBytes(const void* data, PxU32 size)
+		{
+			const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+			PxU64 h = mHash;
+			for(PxU32 i=0;i<size;i++)
+				h = (h ^ bytes[i]) * 1099511628211ull;
+			mHash = h;
+		}
+
+		template<class T>
+		PX_FORCE_INLINE	void	add(const T& value)	{ addBytes(&value, sizeof(T));	}
+
+		void	addStrided(const PxBoundedData& data, PxU32 elemSize)
+		{
+			const PxU8* src = reinterpret_cast<const PxU8*>(data.data);
+			if(!src)
+				return;
+			for(PxU32 i=0;i<data.count;i++)
+				addBytes(src + i*data.stride, elemSize);
+		}
+
+		PxU64	mHash;
+	};
+
+	PX_FORCE_INLINE PxU32 getIndexSize(const PxConvexMeshDesc& desc)
+	{
+		return (desc.flags & PxConvexFlag::e16_BIT_INDICES) ? sizeof(PxU16) : sizeof(PxU32);
+	}
+
+	PX_FORCE_INLINE PxU32 getNbIndices(const PxConvexMeshDesc& desc)
+	{
+		// PT: the indices aren't counted explicitly, they're referenced by the polygons
+		return desc.indices.data ? desc.indices.count : 0;
+	}
+
+	PxU64 computeDescKey(const PxConvexMeshDesc& desc)
+	{
+		DescHash hash;
+		hash.add(PxU32(desc.flags));
+		hash.add(desc.vertexLimit);
+		hash.add(desc.polygonLimit);
+		hash.add(desc.quantizedCount);
+		hash.add(desc.points.count);
+		hash.addStrided(desc.points, sizeof(PxVec3));
+		hash.add(desc.polygons.count);
+		hash.addStrided(desc.polygons, sizeof(PxHullPolygon));
+		hash.add(getNbIndices(desc));
+		hash.addStrided(desc.indices, getIndexSize(desc));
+		return hash.mHash;
+	}
+
+	bool sameStridedData(const PxBoundedData& a, const PxBoundedData& b, PxU32 elemSize)
+	{
+		if(a.count!=b.count || !a.data!=!b.data)
+			return false;
+		if(!a.data)
+			return true;
+		const PxU8* srcA = reinterpret_cast<const PxU8*>(a.data);
+		const PxU8* srcB = reinterpret_cast<const PxU8*>(b.data);
+		for(PxU32 i=0;i<a.count;i++)
+		{
+			const PxU8* elemA = srcA + i*a.stride;
+			const PxU8* elemB = srcB + i*b.stride;
+			for(PxU32 j=0;j<elemSize;j++)
+			{
+				if(elemA[j]!=elemB[j])
+					return false;
+			}
+		}
+		return true;
+	}
+
+	// PT: hash collisions are possible so duplicates are confirmed with a full comparison
+	bool sameDesc(const PxConvexMeshDesc& a, const PxConvexMeshDesc& b)
+	{
+		return		a.flags==b.flags && a.vertexLimit==b.vertexLimit && a.polygonLimit==b.polygonLimit && a.quantizedCount==b.quantizedCount
+				&&	getNbIndices(a)==getNbIndices(b)
+				&&	sameStridedData(a.points, b.points, sizeof(PxVec3))
+				&&	sameStridedData(a.polygons, b.polygons, sizeof(PxHullPolygon))
+				&&	(!getNbIndices(a) || sameStridedData(a.indices, b.indices, getIndexSize(a)));
+	}
+
+	class CookConvexMeshes : public Cm::ParallelForCallback
+	{
+		public:
+			CookConvexMeshes(const PxCookingParams& params, const PxConvexMeshDesc* descs, const PxU32* uniqueDescs, ConvexHullInitData* hullData, bool* cooked, PxConvexMeshCookingResult::Enum* conditions) :
+				mParams(params), mDescs(descs), mUniqueDescs(uniqueDescs), mHullData(hullData), mCooked(cooked), mConditions(conditions)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				PX_FPU_GUARD;
+
+				for(PxU32 i=startIndex; i<endIndex; i++)
+				{
+					const PxU32 descIndex = mUniqueDescs[i];
+
+					PxConvexMeshDesc desc = mDescs[descIndex];
+					ConvexHullLib* hullLib = createHullLib(desc, mParams);
+
+					ConvexMeshBuilder meshBuilder(mParams.buildGPUData);
+					mCooked[descIndex] = cookConvexMeshInternal(mParams, desc, meshBuilder, hullLib, mConditions + descIndex);
+					if(mCooked[descIndex])
+						meshBuilder.copy(mHullData[descIndex]);
+
+					PX_DELETE(hullLib);
+				}
+			}
+
+			const PxCookingParams&				mParams;
+			const PxConvexMeshDesc*				mDescs;
+			const PxU32*						mUniqueDescs;
+			ConvexHullInitData*					mHullData;
+			bool*								mCooked;
+			PxConvexMeshCookingResult::Enum*	mConditions;
+			PX_NOCOPY(CookConvexMeshes)
+	};
+}
+
+PxU32 immediateCooking::createConvexMeshes(const PxCookingParams& params, const PxConvexMeshDesc* descs, PxU32 nbDescs, PxConvexMesh** meshes, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* conditions)
+{
+	if(!nbDescs)
+		return 0;
+
+	PX_FPU_GUARD;
+
+	PxConvexMeshCookingResult::Enum* results = PX_ALLOCATE(PxConvexMeshCookingResult::Enum, nbDescs, "ConvexMeshCookingResults");
+	PxU32* duplicateOf = PX_ALLOCATE(PxU32, nbDescs, "ConvexMeshDuplicates");
+	PxU32* uniqueDescs = PX_ALLOCATE(PxU32, nbDescs, "ConvexMeshUniqueDescs");
+	PxU32 nbUniqueDescs = 0;
+
+	// PT: identical descriptors are only cooked once. Descriptors with an SDF are always cooked.
+	{
+		PxHashMap<PxU64, PxU32> firstDescs;
+		for(PxU32 i=0;i<nbDescs;i++)
+		{
+			duplicateOf[i] = i;
+			if(!descs[i].sdfDesc)
+			{
+				const PxU64 key = computeDescKey(descs[i]);
+				const PxHashMap<PxU64, PxU32>::Entry* e = firstDescs.find(key);
+				if(e && sameDesc(descs[e->second], descs[i]))
+				{
+					duplicateOf[i] = e->second;
+					continue;
+				}
+				if(!e)
+					firstDescs.insert(key, i);
+			}
+			uniqueDescs[nbUniqueDescs++] = i;
+		}
+	}
+
+	// PT: cooking runs on the dispatcher's threads, then the meshes are inserted serially from this thread
+	ConvexHullInitData* hullData = PX_ALLOCATE(ConvexHullInitData, nbDescs, "ConvexHullInitData");
+	bool* cooked = PX_ALLOCATE(bool, nbDescs, "ConvexMeshCooked");
+	{
+		CookConvexMeshes cook(params, descs, uniqueDescs, hullData, cooked, results);
+		Cm::parallelFor(params.cpuDispatcher, nbUniqueDescs, 1, cook);
+	}
+
+	PxU32 nbCreated = 0;
+	for(PxU32 i=0;i<nbDescs;i++)
+	{
+		const PxU32 first = duplicateOf[i];
+		if(first!=i)
+		{
+			meshes[i] = meshes[first];
+			results[i] = results[first];
+			if(meshes[i])
+				meshes[i]->acquireReference();
+		}
+		else
+		{
+			meshes[i] = NULL;
+			if(cooked[i])
+			{
+				meshes[i] = static_cast<PxConvexMesh*>(insertionCallback.buildObjectFromData(PxConcreteType::eCONVEX_MESH, &hullData[i]));
+				if(!meshes[i])
+					results[i] = PxConvexMeshCookingResult::eFAILURE;
+			}
+		}
+
+		if(meshes[i])
+			nbCreated++;
+		if(conditions)
+			conditions[i] = results[i];
+	}
+
+	PX_FREE(cooked);
+	PX_FREE(hullData);
+	PX_FREE(uniqueDescs);
+	PX_FREE(duplicateOf);
+	PX_FREE(results);
+	return nbCreated;
+}
+
 bool immediateCooking::validateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc)
 {
 	ConvexMeshBuilder mesh(params.buildGPUData);
@@ -31,6 +31,7 @@
 #include "foundation/PxFPU.h"
 #include "common/PxInsertionCallback.h"
 #include "CmUtils.h"
+#include "foundation/PxArray.h"
 
 using namespace physx;
 using namespace Gu;
@@ -93,8 +94,67 @@ PxHeightField* immediateCooking::createHeightField(const PxHeightFieldDesc& desc
 	heightField->mNbSamples = hf->mNbSamples;
 	heightField->mMinHeight = hf->mMinHeight;
 	heightField->mMaxHeight = hf->mMaxHeight;
+	heightField->mExactHeightBounds = hf->mExactHeightBounds;
 	heightField->mModifyCount = hf->mModifyCount;
 
 	PX_DELETE(hf);
 	return heightField;
 }
+
+// PT: converts the raster to regular samples, see PxHeightFieldRasterDesc for the conversion rule
+static void convertRaster(const PxHeightFieldRasterDesc& raster, PxArray<PxHeightFieldSample>& samples, PxHeightFieldDesc& desc)
+{
+	const PxU32 nbSamples = raster.nbRows * raster.nbColumns;
+	samples.resize(nbSamples);
+
+	const PxReal invHeightScale = 1.0f / raster.heightScale;
+	const PxU8* heights = reinterpret_cast<const PxU8*>(raster.heights.data);
+	const PxU8* materials = reinterpret_cast<const PxU8*>(raster.materials.data);
+	for(PxU32 i=0;i<nbSamples;i++)
+	{
+		const PxReal value = raster.format == PxHeightFieldRasterFormat::eU16 ? PxReal(*reinterpret_cast<const PxU16*>(heights)) : *reinterpret_cast<const PxReal*>(heights);
+		const PxReal h = PxFloor((value * raster.rasterScale - raster.heightOffset) * invHeightScale + 0.5f);
+		heights += raster.heights.stride;
+
+		PxHeightFieldSample& sample = samples[i];
+		sample.height = PxI16(PxClamp(h, -32768.0f, 32767.0f));
+		const PxU8 material = materials ? PxU8(*materials & 0x7f) : PxU8(0);
+		sample.materialIndex0 = material;
+		sample.materialIndex1 = material;
+		if(materials)
+			materials += raster.materials.stride;
+	}
+
+	desc.nbRows					= raster.nbRows;
+	desc.nbColumns				= raster.nbColumns;
+	desc.format					= PxHeightFieldFormat::eS16_TM;
+	desc.samples.data			= samples.begin();
+	desc.samples.stride			= sizeof(PxHeightFieldSample);
+	desc.convexEdgeThreshold	= raster.convexEdgeThreshold;
+	desc.flags					= raster.flags;
+}
+
+bool immediateCooking::cookHeightFieldFromRaster(const PxHeightFieldRasterDesc& raster, PxOutputStream& stream)
+{
+	if(!raster.isValid())
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "Cooking::cookHeightFieldFromRaster: user-provided raster descriptor is invalid!");
+
+	PxArray<PxHeightFieldSample> samples;
+	PxHeightFieldDesc desc;
+	convertRaster(raster, samples, desc);
+	return cookHeightField(desc, stream);
+}
+
+PxHeightField* immediateCooking::createHeightFieldFromRaster(const PxHeightFieldRasterDesc& raster, PxInsertionCallback& insertionCallback)
+{
+	if(!raster.isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "Cooking::createHeightFieldFromRaster: user-provided raster descriptor is invalid!");
+		return NULL;
+	}
+
+	PxArray<PxHeightFieldSample> samples;
+	PxHeightFieldDesc desc;
+	convertRaster(raster, samples, desc);
+	return createHeightField(desc, insertionCallback);
+}
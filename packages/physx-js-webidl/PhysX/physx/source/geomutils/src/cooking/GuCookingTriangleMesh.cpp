@@ -43,6 +43,7 @@
 #include "GuBV32Build.h"
 #include "GuBounds.h"
 #include "CmSerialize.h"
+#include "CmParallelFor.h"
 #include "GuCookingGrbTriangleMesh.h"
 #include "GuCookingVolumeIntegration.h"
 #include "GuCookingSDF.h"
@@ -58,10 +59,43 @@ PX_IMPLEMENT_OUTPUT_ERROR
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	// PT: dst[i] = src[order[i]]
+	template<class T>
+	class RemapArray : public ParallelForCallback
+	{
+		public:
+			RemapArray(T* dst, const T* src, const PxU32* order) : mDst(dst), mSrc(src), mOrder(order)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				for(PxU32 i=startIndex; i<endIndex; i++)
+					mDst[i] = mSrc[mOrder[i]];
+			}
+
+			T*				mDst;
+			const T*		mSrc;
+			const PxU32*	mOrder;
+			PX_NOCOPY(RemapArray)
+	};
+
+	template<class T>
+	static void remapArray(PxCpuDispatcher* dispatcher, PxU32 nb, T* dst, const T* src, const PxU32* order)
+	{
+		RemapArray<T> remap(dst, src, order);
+		parallelFor(dispatcher, nb, 16384, remap);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 TriangleMeshBuilder::TriangleMeshBuilder(TriangleMeshData& m, const PxCookingParams& params) :
-	mEdgeList	(NULL),
-	mParams		(params),
-	mMeshData	(m)
+	mEdgeList			(NULL),
+	mParams				(params),
+	mMeshData			(m),
+	mQuantizationMin	(0.0f),
+	mQuantizationScale	(0.0f)
 {
 }
 
@@ -80,16 +114,14 @@ void TriangleMeshBuilder::remapTopology(const PxU32* order)
 	// Remap one array at a time to limit memory usage
 
 	IndexedTriangle32* newTopo = PX_ALLOCATE(IndexedTriangle32, mMeshData.mNbTriangles, "IndexedTriangle32");
-	for(PxU32 i=0;i<mMeshData.mNbTriangles;i++)
-		newTopo[i]	= reinterpret_cast<IndexedTriangle32*>(mMeshData.mTriangles)[order[i]];
+	remapArray(mParams.cpuDispatcher, mMeshData.mNbTriangles, newTopo, reinterpret_cast<const IndexedTriangle32*>(mMeshData.mTriangles), order);
 	PX_FREE(mMeshData.mTriangles);
 	mMeshData.mTriangles = newTopo;
 
 	if(mMeshData.mMaterialIndices)
 	{
 		PxMaterialTableIndex* newMat = PX_ALLOCATE(PxMaterialTableIndex, mMeshData.mNbTriangles, "mMaterialIndices");
-		for(PxU32 i=0;i<mMeshData.mNbTriangles;i++)
-			newMat[i] = mMeshData.mMaterialIndices[order[i]];
+		remapArray(mParams.cpuDispatcher, mMeshData.mNbTriangles, newMat, mMeshData.mMaterialIndices, order);
 		PX_FREE(mMeshData.mMaterialIndices);
 		mMeshData.mMaterialIndices = newMat;
 	}
@@ -97,8 +129,10 @@ void TriangleMeshBuilder::remapTopology(const PxU32* order)
 	if(!mParams.suppressTriangleMeshRemapTable || mParams.buildGPUData)
 	{
 		PxU32* newMap = PX_ALLOCATE(PxU32, mMeshData.mNbTriangles, "mFaceRemap");
-		for(PxU32 i=0;i<mMeshData.mNbTriangles;i++)
-			newMap[i] = mMeshData.mFaceRemap ? mMeshData.mFaceRemap[order[i]] : order[i];
+		if(mMeshData.mFaceRemap)
+			remapArray(mParams.cpuDispatcher, mMeshData.mNbTriangles, newMap, mMeshData.mFaceRemap, order);
+		else
+			PxMemCopy(newMap, order, mMeshData.mNbTriangles*sizeof(PxU32));
 		PX_FREE(mMeshData.mFaceRemap);
 		mMeshData.mFaceRemap = newMap;
 	}
@@ -111,7 +145,8 @@ bool TriangleMeshBuilder::cleanMesh(bool validate, PxTriangleMeshCookingResult::
 	PX_ASSERT(mMeshData.mFaceRemap == NULL);
 
 	PxF32 meshWeldTolerance = 0.0f;
-	if(mParams.meshPreprocessParams & PxMeshPreprocessingFlag::eWELD_VERTICES)
+	// PT: no welding in preview mode, it's the most expensive part of the cleaning
+	if((mParams.meshPreprocessParams & PxMeshPreprocessingFlag::eWELD_VERTICES) && mParams.meshCookingQuality!=PxMeshCookingQuality::ePREVIEW)
 	{
 		if(mParams.meshWeldTolerance == 0.0f)
 			outputError<PxErrorCode::eDEBUG_WARNING>(__LINE__, "TriangleMeshBuilder::cleanMesh: mesh welding enabled with 0 weld tolerance!");
@@ -119,7 +154,7 @@ bool TriangleMeshBuilder::cleanMesh(bool validate, PxTriangleMeshCookingResult::
 			meshWeldTolerance = mParams.meshWeldTolerance;
 	}
 
-	MeshCleaner cleaner(mMeshData.mNbVertices, mMeshData.mVertices, mMeshData.mNbTriangles, reinterpret_cast<const PxU32*>(mMeshData.mTriangles), meshWeldTolerance, mParams.meshAreaMinLimit);
+	MeshCleaner cleaner(mMeshData.mNbVertices, mMeshData.mVertices, mMeshData.mNbTriangles, reinterpret_cast<const PxU32*>(mMeshData.mTriangles), meshWeldTolerance, mParams.meshAreaMinLimit, mParams.cpuDispatcher);
 	if(!cleaner.mNbTris)
 	{
 		if(condition)
@@ -541,7 +576,8 @@ bool TriangleMeshBuilder::loadFromDescInternal(PxTriangleMeshDesc& desc, PxTrian
 	// Compute local bounds
 	computeLocalBoundsAndGeomEpsilon(mMeshData.mVertices, mMeshData.mNbVertices, mMeshData.mAABB, mMeshData.mGeomEpsilon);	
 
-	createSharedEdgeData(mParams.buildTriangleAdjacencies, !(mParams.meshPreprocessParams & PxMeshPreprocessingFlag::eDISABLE_ACTIVE_EDGES_PRECOMPUTE));
+	if(mParams.meshCookingQuality!=PxMeshCookingQuality::ePREVIEW)
+		createSharedEdgeData(mParams.buildTriangleAdjacencies, !(mParams.meshPreprocessParams & PxMeshPreprocessingFlag::eDISABLE_ACTIVE_EDGES_PRECOMPUTE));
 
 	return createGRBMidPhaseAndData(originalTriangleCount);
 }
@@ -600,6 +636,61 @@ void TriangleMeshBuilder::buildInertiaTensorFromSDF()
 	mMeshData.mLocalCenterOfMass = integrals.COM;
 }
 
+static PX_FORCE_INLINE PxU16 quantizeCoordinate(PxReal v, PxReal minimum, PxReal scale)
+{
+	if(scale==0.0f)
+		return 0;
+	return PxU16(PxClamp((v - minimum)/scale + 0.5f, 0.0f, 65535.0f));
+}
+
+static PX_FORCE_INLINE void quantizeVertex(PxU16* q, const PxVec3& v, const PxVec3& minimum, const PxVec3& scale)
+{
+	q[0] = quantizeCoordinate(v.x, minimum.x, scale.x);
+	q[1] = quantizeCoordinate(v.y, minimum.y, scale.y);
+	q[2] = quantizeCoordinate(v.z, minimum.z, scale.z);
+}
+
+void TriangleMeshBuilder::quantizeVertices()
+{
+	PxVec3* verts = mMeshData.mVertices;
+	const PxU32 nbVerts = mMeshData.mNbVertices;
+	if(!nbVerts)
+		return;
+
+	PxBounds3 bounds = PxBounds3::empty();
+	for(PxU32 i=0;i<nbVerts;i++)
+		bounds.include(verts[i]);
+
+	mQuantizationMin = bounds.minimum;
+	mQuantizationScale = bounds.getDimensions() / 65535.0f;
+
+	for(PxU32 i=0;i<nbVerts;i++)
+	{
+		PxU16 q[3];
+		quantizeVertex(q, verts[i], mQuantizationMin, mQuantizationScale);
+		verts[i] = dequantizeMeshVertex(q, mQuantizationMin, mQuantizationScale);
+	}
+}
+
+// PT: zigzag-encoded deltas between consecutive indices, stored as LEB128 variable-length integers
+static void compressIndices(const PxU32* indices, PxU32 nbIndices, PxArray<PxU8>& bytes)
+{
+	bytes.reserve(nbIndices + 16);
+	PxU32 previous = 0;
+	for(PxU32 i=0;i<nbIndices;i++)
+	{
+		const PxI32 delta = PxI32(indices[i] - previous);
+		PxU32 value = (PxU32(delta)<<1) ^ PxU32(delta>>31);
+		previous = indices[i];
+		while(value>=0x80)
+		{
+			bytes.pushBack(PxU8(value|0x80));
+			value >>= 7;
+		}
+		bytes.pushBack(PxU8(value));
+	}
+}
+
 //
 // When suppressTriangleMeshRemapTable is true, the face remap table is not created.  This saves a significant amount of memory,
 // but the SDK will not be able to provide information about which mesh triangle is hit in collisions, sweeps or raycasts hits.
@@ -656,13 +747,40 @@ bool TriangleMeshBuilder::save(PxOutputStream& stream, bool platformMismatch, co
 	if (enableVertexMapping)
 		serialFlags |= IMSF_VERT_MAPPING;
 
+	if(params.meshPreprocessParams & PxMeshPreprocessingFlag::eQUANTIZE_VERTICES)
+		serialFlags |= IMSF_QUANTIZED_VERTICES;
+
+	// PT: the 8/16-bit flags are kept, they still define the runtime index format
+	if(params.meshPreprocessParams & PxMeshPreprocessingFlag::eCOMPRESS_INDICES)
+		serialFlags |= IMSF_COMPRESSED_INDICES;
+
 	writeDword(serialFlags, platformMismatch, stream);
 
 	// Export mesh
 	writeDword(mMeshData.mNbVertices, platformMismatch, stream);
 	writeDword(mMeshData.mNbTriangles, platformMismatch, stream);
-	writeFloatBuffer(&mMeshData.mVertices->x, mMeshData.mNbVertices*3, platformMismatch, stream);
-	if(serialFlags & IMSF_8BIT_INDICES)
+	if(serialFlags & IMSF_QUANTIZED_VERTICES)
+	{
+		writeFloatBuffer(&mQuantizationMin.x, 3, platformMismatch, stream);
+		writeFloatBuffer(&mQuantizationScale.x, 3, platformMismatch, stream);
+		for(PxU32 i=0;i<mMeshData.mNbVertices;i++)
+		{
+			PxU16 q[3];
+			quantizeVertex(q, mMeshData.mVertices[i], mQuantizationMin, mQuantizationScale);
+			writeWordBuffer(q, 3, platformMismatch, stream);
+		}
+	}
+	else
+		writeFloatBuffer(&mMeshData.mVertices->x, mMeshData.mNbVertices*3, platformMismatch, stream);
+
+	if(serialFlags & IMSF_COMPRESSED_INDICES)
+	{
+		PxArray<PxU8> bytes;
+		compressIndices(tris->mRef, mMeshData.mNbTriangles*3, bytes);
+		writeDword(bytes.size(), platformMismatch, stream);
+		stream.write(bytes.begin(), bytes.size());
+	}
+	else if(serialFlags & IMSF_8BIT_INDICES)
 	{
 		const PxU32* indices = tris->mRef;
 		for(PxU32 i=0;i<mMeshData.mNbTriangles*3;i++)
@@ -902,6 +1020,10 @@ bool TriangleMeshBuilder::importMesh(const PxTriangleMeshDesc& desc, PxTriangleM
 		}
 	}
 
+	// PT: snap the vertices before anything else is computed from them
+	if(mParams.meshPreprocessParams & PxMeshPreprocessingFlag::eQUANTIZE_VERTICES)
+		quantizeVertices();
+
 	const bool computeInertia = mParams.meshPreprocessParams & PxMeshPreprocessingFlag::eENABLE_INERTIA;
 	if (computeInertia)
 	{
@@ -1010,6 +1132,9 @@ void TriangleMeshBuilder::checkMeshIndicesSize()
 
 BV4TriangleMeshBuilder::BV4TriangleMeshBuilder(const PxCookingParams& params) : TriangleMeshBuilder(mData, params)
 {
+	// PT: eBVH38 meshes cook the same data as eBVH34 ones, only the midphase ID differs. The wide tree is built at load time.
+	if(params.midphaseDesc.getType() == PxMeshMidPhase::eBVH38)
+		mData.mType = PxMeshMidPhase::eBVH38;
 }
 
 BV4TriangleMeshBuilder::~BV4TriangleMeshBuilder()
@@ -1047,7 +1172,7 @@ bool BV4TriangleMeshBuilder::createMidPhaseStructure()
 
 	mData.mMeshInterface.setPointers(triangles32, triangles16, mMeshData.mVertices);
 
-	PX_ASSERT(mParams.midphaseDesc.getType() == PxMeshMidPhase::eBVH34);
+	PX_ASSERT(mParams.midphaseDesc.getType() == PxMeshMidPhase::eBVH34 || mParams.midphaseDesc.getType() == PxMeshMidPhase::eBVH38);
 	const PxU32 nbTrisPerLeaf = mParams.midphaseDesc.mBVH34Desc.numPrimsPerLeaf;
 	const bool quantized = mParams.midphaseDesc.mBVH34Desc.quantized;
 
@@ -1057,7 +1182,9 @@ bool BV4TriangleMeshBuilder::createMidPhaseStructure()
 		gubs = BV4_SAH;
 	else if(strategy==PxBVH34BuildStrategy::eFAST)
 		gubs = BV4_SPLATTER_POINTS;
-	if(!BuildBV4Ex(mData.mBV4Tree, mData.mMeshInterface, gBoxEpsilon, nbTrisPerLeaf, quantized, gubs))
+	if(mParams.meshCookingQuality==PxMeshCookingQuality::ePREVIEW)
+		gubs = BV4_MORTON;
+	if(!BuildBV4Ex(mData.mBV4Tree, mData.mMeshInterface, gBoxEpsilon, nbTrisPerLeaf, quantized, gubs, mParams.cpuDispatcher))
 		return outputError<PxErrorCode::eINTERNAL_ERROR>(__LINE__, "BV4 tree failed to build.");
 
 	{
@@ -1069,8 +1196,7 @@ bool BV4TriangleMeshBuilder::createMidPhaseStructure()
 		if(mMeshData.mMaterialIndices)
 		{
 			PxMaterialTableIndex* newMat = PX_ALLOCATE(PxMaterialTableIndex, mMeshData.mNbTriangles, "mMaterialIndices");
-			for(PxU32 i=0;i<mMeshData.mNbTriangles;i++)
-				newMat[i] = mMeshData.mMaterialIndices[order[i]];
+			remapArray(mParams.cpuDispatcher, mMeshData.mNbTriangles, newMat, mMeshData.mMaterialIndices, order);
 			PX_FREE(mMeshData.mMaterialIndices);
 			mMeshData.mMaterialIndices = newMat;
 		}
@@ -1078,8 +1204,10 @@ bool BV4TriangleMeshBuilder::createMidPhaseStructure()
 		if (!mParams.suppressTriangleMeshRemapTable || mParams.buildGPUData)
 		{
 			PxU32* newMap = PX_ALLOCATE(PxU32, mMeshData.mNbTriangles, "mFaceRemap");
-			for(PxU32 i=0;i<mMeshData.mNbTriangles;i++)
-				newMap[i] = mMeshData.mFaceRemap ? mMeshData.mFaceRemap[order[i]] : order[i];
+			if(mMeshData.mFaceRemap)
+				remapArray(mParams.cpuDispatcher, mMeshData.mNbTriangles, newMap, mMeshData.mFaceRemap, order);
+			else
+				PxMemCopy(newMap, order, mMeshData.mNbTriangles*sizeof(PxU32));
 			PX_FREE(mMeshData.mFaceRemap);
 			mMeshData.mFaceRemap = newMap;
 		}
@@ -1337,7 +1465,7 @@ bool immediateCooking::validateTriangleMesh(const PxCookingParams& params, const
 		RTreeTriangleMeshBuilder builder(params);
 		return builder.loadFromDesc(desc, NULL, true /*doValidate*/);
 	}
-	else if(params.midphaseDesc.getType() == PxMeshMidPhase::eBVH34)
+	else if(params.midphaseDesc.getType() == PxMeshMidPhase::eBVH34 || params.midphaseDesc.getType() == PxMeshMidPhase::eBVH38)
 	{
 		BV4TriangleMeshBuilder builder(params);
 		return builder.loadFromDesc(desc, NULL, true /*doValidate*/);
@@ -76,11 +76,14 @@ namespace physx
 
 				void						buildInertiaTensor(bool flipNormals = false);
 				void						buildInertiaTensorFromSDF();
+				void						quantizeVertices();
 
 				TriangleMeshBuilder& operator=(const TriangleMeshBuilder&);
 				Gu::EdgeList*				mEdgeList;
 				const PxCookingParams&		mParams;
 				Gu::TriangleMeshData&		mMeshData;
+				PxVec3						mQuantizationMin;	// PT: only valid with PxMeshPreprocessingFlag::eQUANTIZE_VERTICES
+				PxVec3						mQuantizationScale;
 	};
 
 	class RTreeTriangleMeshBuilder : public TriangleMeshBuilder
@@ -102,7 +105,7 @@ namespace physx
 											BV4TriangleMeshBuilder(const PxCookingParams& params);
 		virtual								~BV4TriangleMeshBuilder();
 
-		virtual	PxMeshMidPhase::Enum		getMidphaseID()	const		PX_OVERRIDE	{ return PxMeshMidPhase::eBVH34;	}
+		virtual	PxMeshMidPhase::Enum		getMidphaseID()	const		PX_OVERRIDE	{ return mData.mType;	}	// PT: eBVH34 or eBVH38
 		virtual	bool						createMidPhaseStructure()	PX_OVERRIDE;
 		virtual	void						saveMidPhaseStructure(PxOutputStream& stream, bool mismatch)	const	PX_OVERRIDE;
 		virtual	void						onMeshIndexFormatChange();
@@ -214,6 +214,10 @@ namespace Gu
 			if(FAllGrtr(vw, sumExpandedMargin))
 			{
 				assignWarmStartValue(aIndices, bIndices, warmStartSize, aInd, bInd, size);
+				//PT: v is a separating axis and (vw - sumMargin) a lower bound of the distance between the shapes. This is
+				//used by the PCM functions to skip GJK for pairs that stay separated, see PersistentContactManifold::isStillSeparated.
+				output.searchDir = v;
+				output.penDep = FSub(vw, sumMargin);
 				return GJK_NON_INTERSECT;
 			}
 			
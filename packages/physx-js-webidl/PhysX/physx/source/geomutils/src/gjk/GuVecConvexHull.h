@@ -73,6 +73,16 @@ namespace Gu
 		return FMul(min, FLoad(0.25f));
 	}
 
+	//This is an upper bound of the distance between the shape space origin and the hull vertices. The scale matrix is a rotated
+	//diagonal scale, so it doesn't stretch vectors by more than its largest coefficient.
+	PX_SUPPORT_FORCE_INLINE aos::FloatV CalculatePCMConvexRadius(const Gu::ConvexHullData* hullData, const aos::Vec3VArg scale)
+	{
+		using namespace aos;
+		const FloatV center = V3Length(V3LoadU(hullData->mAABB.mCenter));
+		const FloatV extents = V3Length(V3LoadU(hullData->mAABB.mExtents));
+		return FMul(FAdd(center, extents), V3ExtractMax(V3Abs(scale)));
+	}
+
 	//This minMargin is used in PCM contact gen
 	PX_SUPPORT_FORCE_INLINE void CalculateConvexMargin(const InternalObjectsData& internalObject, PxReal& margin, PxReal& minMargin, PxReal& sweepMargin,
 		const aos::Vec3VArg scale)
@@ -195,7 +205,7 @@ namespace Gu
 		/**
 		\brief Constructor
 		*/
-		PX_SUPPORT_INLINE ConvexHullV() : ConvexV(ConvexType::eCONVEXHULL)
+		PX_SUPPORT_INLINE ConvexHullV() : ConvexV(ConvexType::eCONVEXHULL), supportHint(PX_INVALID_U32)
 		{
 		}
 
@@ -212,6 +222,7 @@ namespace Gu
 			CalculateConvexMargin(_hullData->mInternal, margin, minMargin, sweepMargin, scale);
 			ConstructSkewMatrix(scale, scaleRot, vertex2Shape, shape2Vertex, center, idtScale);
 			data = _hullData->mBigConvexRawData;
+			supportHint = PX_INVALID_U32;
 		}
 
 		PX_SUPPORT_INLINE ConvexHullV(const Gu::ConvexHullData* _hullData, const aos::Vec3VArg _center) :
@@ -223,6 +234,7 @@ namespace Gu
 			verts = _hullData->getHullVertices();
 			numVerts = _hullData->mNbHullVertices;
 			data = _hullData->mBigConvexRawData;
+			supportHint = PX_INVALID_U32;
 		}
 
 		//this is used by CCD system
@@ -244,6 +256,7 @@ namespace Gu
 			ConstructSkewMatrix(vScale, vRot, vertex2Shape, shape2Vertex, center, idtScale);
 
 			data = hData->mBigConvexRawData;
+			supportHint = PX_INVALID_U32;
 		}
 
 		//this is used by convex vs tetrahedron collision
@@ -270,6 +283,7 @@ namespace Gu
 			shape2Vertex.col2 = V3LoadU(s2v.column2);
 
 			data = polyData.mBigData;
+			supportHint = PX_INVALID_U32;
 
 		}
 
@@ -290,6 +304,7 @@ namespace Gu
 
 			//	searchIndex = 0;
 			data = _hullData->mBigConvexRawData;
+			supportHint = PX_INVALID_U32;
 
 			hullData = _hullData;
 			if (_hullData->mBigConvexRawData)
@@ -318,7 +333,14 @@ namespace Gu
 			return M33MulV3(vertex2Shape, V3LoadU_SafeReadW(verts[index]));	// PT: safe because of the way vertex memory is allocated in ConvexHullData (and 'verts' is initialized with ConvexHullData::getHullVertices())
 		}
 
-		PX_NOINLINE PxU32 hillClimbing(const aos::Vec3VArg _dir)const
+		// PT: warm-starts the hill climbing with a vertex index, typically the support vertex found by the previous frame's
+		// GJK query for the same pair. Ignored for small hulls, which use a brute-force search.
+		PX_FORCE_INLINE void setSupportHint(PxU32 index)	const
+		{
+			supportHint = index < numVerts ? index : PX_INVALID_U32;
+		}
+
+		PX_NOINLINE PxU32 hillClimbing(const aos::Vec3VArg _dir, PxU32 hint = PX_INVALID_U32)const
 		{
 			using namespace aos;
 
@@ -341,6 +363,18 @@ namespace Gu
 
 			Vec3V maxPoint = V3LoadU_SafeReadW(verts[index]);	// PT: safe because of the way vertex memory is allocated in ConvexHullData (and 'verts' is initialized with ConvexHullData::getHullVertices())
 			FloatV max = V3Dot(maxPoint, _dir);
+
+			// PT: start from the hint instead of the cubemap sample when it is closer to the support vertex. Successive GJK
+			// support directions change little, within a query and across frames, so this saves climbing steps.
+			if(hint != PX_INVALID_U32)
+			{
+				const FloatV hintDist = V3Dot(V3LoadU_SafeReadW(verts[hint]), _dir);	// PT: safe, see above
+				if(FAllGrtr(hintDist, max))
+				{
+					max = hintDist;
+					index = hint;
+				}
+			}
 	
 			PxU32 initialIndex = index;
 			
@@ -401,7 +435,11 @@ namespace Gu
 		{
 			using namespace aos;
 			if(data)
-				return hillClimbing(_dir);
+			{
+				const PxU32 index = hillClimbing(_dir, supportHint);
+				supportHint = index;
+				return index;
+			}
 			else
 				return bruteForceSearch(_dir);
 		}
@@ -528,6 +566,7 @@ namespace Gu
 		const Gu::ConvexHullData* hullData;
 		const BigConvexRawData* data;  
 		const PxVec3* verts;
+		mutable PxU32 supportHint;	// Start vertex for hillClimbing(), see setSupportHint()
 		PxU8 numVerts;
 	};
 
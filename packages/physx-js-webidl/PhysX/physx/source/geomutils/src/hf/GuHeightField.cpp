@@ -43,7 +43,10 @@ HeightField::HeightField(MeshFactory* factory)
 , mNbSamples	(0)
 , mMinHeight	(0.0f)
 , mMaxHeight	(0.0f)
+, mExactHeightBounds	(true)
 , mModifyCount	(0)
+, mTileBounds	(NULL)
+, mNbTileColumns(0)
 , mMeshFactory	(factory)
 {
 	mData.format				= PxHeightFieldFormat::eS16_TM;
@@ -62,11 +65,16 @@ HeightField::HeightField(MeshFactory* factory, HeightFieldData& data)
 , mNbSamples	(0)
 , mMinHeight	(0.0f)
 , mMaxHeight	(0.0f)
+, mExactHeightBounds	(true)
 , mModifyCount	(0)
+, mTileBounds	(NULL)
+, mNbTileColumns(0)
 , mMeshFactory	(factory)
 {
 	mData = data;
 	data.samples = NULL; // set to null so that we don't release the memory
+
+	buildTileBounds();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -94,6 +102,10 @@ void HeightField::exportExtraData(PxSerializationContext& stream)
 void HeightField::importExtraData(PxDeserializationContext& context)
 {
 	mData.samples = context.readExtraData<PxHeightFieldSample, PX_SERIAL_ALIGN>(mData.rows * mData.columns);
+
+	// PT: the pointer comes from the exported object and is meaningless here
+	mTileBounds = NULL;
+	buildTileBounds();
 }
 
 HeightField* HeightField::createObject(PxU8*& address, PxDeserializationContext& context)
@@ -137,6 +149,9 @@ bool HeightField::modifySamples(PxI32 startCol, PxI32 startRow, const PxHeightFi
 	// unless shrinkBounds is specified. then the bounds will be fully recomputed later
 	PxReal minHeight = mMinHeight;
 	PxReal maxHeight = mMaxHeight;
+	// the bounds can only shrink if a sample at the old min or max height gets overwritten. Without shrinkBounds
+	// they are then left loose, and a later call with shrinkBounds must rescan even if it overwrites no extreme
+	bool extremeOverwritten = false;
 	PxU32 hiRow = PxMin(PxU32(PxMax(0, startRow + PxI32(desc.nbRows))), nbRows);
 	PxU32 hiCol = PxMin(PxU32(PxMax(0, startCol + PxI32(desc.nbColumns))), nbCols);
 	for (PxU32 row = PxU32(PxMax(startRow, 0)); row < hiRow; row++)
@@ -146,6 +161,12 @@ bool HeightField::modifySamples(PxI32 startCol, PxI32 startRow, const PxHeightFi
 			const PxU32 vertexIndex = col + row*nbCols;
 			PxHeightFieldSample* targetSample = &mData.samples[vertexIndex];
 
+			if(!extremeOverwritten)
+			{
+				const PxReal oldH = getHeight(vertexIndex);
+				extremeOverwritten = oldH <= mMinHeight || oldH >= mMaxHeight;
+			}
+
 			// update target sample from source sample
 			const PxHeightFieldSample& sourceSample =
 				(reinterpret_cast<const PxHeightFieldSample*>(desc.samples.data))[col - startCol + (row - startRow) * desc.nbColumns];
@@ -158,7 +179,7 @@ bool HeightField::modifySamples(PxI32 startCol, PxI32 startRow, const PxHeightFi
 		}
 	}
 
-	if (shrinkBounds)
+	if (shrinkBounds && (extremeOverwritten || !mExactHeightBounds))
 	{
 		// do a full recompute on vertical bounds to allow shrinking
 		minHeight = PX_MAX_REAL;
@@ -171,10 +192,26 @@ bool HeightField::modifySamples(PxI32 startCol, PxI32 startRow, const PxHeightFi
 			minHeight = physx::intrinsics::selectMin(h, minHeight);
 			maxHeight = physx::intrinsics::selectMax(h, maxHeight);
 		}
+		mExactHeightBounds = true;
+	}
+	else if (extremeOverwritten)
+	{
+		mExactHeightBounds = false;
 	}
 	mMinHeight = minHeight;
 	mMaxHeight = maxHeight;
 
+	// update the tiles touching the modified samples. A sample belongs to the cells on both sides of it.
+	if(mTileBounds && hiRow > PxU32(PxMax(startRow, 0)) && hiCol > PxU32(PxMax(startCol, 0)))
+	{
+		const PxU32 maxTileRow = (nbRows - 2)>>HF_TILE_SHIFT;
+		const PxU32 maxTileCol = (nbCols - 2)>>HF_TILE_SHIFT;
+		const PxU32 loRow = PxU32(PxMax(startRow - 1, 0));
+		const PxU32 loCol = PxU32(PxMax(startCol - 1, 0));
+		computeTileBounds(	loRow>>HF_TILE_SHIFT, PxMin((hiRow - 1)>>HF_TILE_SHIFT, maxTileRow),
+							loCol>>HF_TILE_SHIFT, PxMin((hiCol - 1)>>HF_TILE_SHIFT, maxTileCol));
+	}
+
 	// update local space aabb
 	CenterExtents& bounds = mData.mAABB;
 	bounds.mCenter.y = (maxHeight + minHeight)*0.5f;
@@ -234,6 +271,7 @@ bool HeightField::load(PxInputStream& stream)
 	mNbSamples = readDword(endian, stream);
 	mMinHeight = readFloat(endian, stream);
 	mMaxHeight = readFloat(endian, stream);
+	mExactHeightBounds = false;	// PT: saved after modifySamples() calls we know nothing about
 
 	// allocate height samples
 	mData.samples = NULL;
@@ -254,7 +292,7 @@ bool HeightField::load(PxInputStream& stream)
 			}
 	}
 
-	return true;
+	return buildTileBounds();
 }
 
 bool HeightField::loadFromDesc(const PxHeightFieldDesc& desc)
@@ -283,6 +321,7 @@ bool HeightField::loadFromDesc(const PxHeightFieldDesc& desc)
 	const PxU32 nbVerts = desc.nbRows * desc.nbColumns;
 	mMinHeight = PX_MAX_REAL;
 	mMaxHeight = -PX_MAX_REAL;
+	mExactHeightBounds = true;
 
 	if(nbVerts > 0) 
 	{
@@ -323,7 +362,7 @@ bool HeightField::loadFromDesc(const PxHeightFieldDesc& desc)
 	bounds.maximum.z = PxReal(getNbColumnsFast() - 1);
 	mData.mAABB = bounds;
 
-	return true;
+	return buildTileBounds();
 }
 
 bool HeightField::save(PxOutputStream& stream, bool endian)
@@ -389,6 +428,68 @@ void HeightField::releaseMemory()
 	{
 		PX_FREE(mData.samples);
 	}
+	PX_FREE(mTileBounds);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool HeightField::buildTileBounds()
+{
+	PX_FREE(mTileBounds);
+	mNbTileColumns = 0;
+
+	const PxU32 nbRows = mData.rows;
+	const PxU32 nbCols = mData.columns;
+	if(!mData.samples || nbRows < 2 || nbCols < 2)
+		return true;
+
+	const PxU32 nbTileRows = ((nbRows - 2)>>HF_TILE_SHIFT) + 1;
+	mNbTileColumns = ((nbCols - 2)>>HF_TILE_SHIFT) + 1;
+	mTileBounds = PX_ALLOCATE(HeightFieldTileBounds, nbTileRows * mNbTileColumns, "HeightFieldTileBounds");
+	if(!mTileBounds)
+	{
+		mNbTileColumns = 0;
+		return PxGetFoundation().error(PxErrorCode::eOUT_OF_MEMORY, PX_FL, "Gu::HeightField::buildTileBounds: PX_ALLOC failed!");
+	}
+
+	computeTileBounds(0, nbTileRows - 1, 0, mNbTileColumns - 1);
+	return true;
+}
+
+void HeightField::computeTileBounds(PxU32 minTileRow, PxU32 maxTileRow, PxU32 minTileColumn, PxU32 maxTileColumn)
+{
+	const PxU32 nbRows = mData.rows;
+	const PxU32 nbCols = mData.columns;
+	const PxU32 tileSize = 1<<HF_TILE_SHIFT;
+
+	for(PxU32 tileRow=minTileRow; tileRow<=maxTileRow; tileRow++)
+	{
+		// PT: a tile covers cells [first, first+tileSize) i.e. vertices [first, first+tileSize]
+		const PxU32 row0 = tileRow<<HF_TILE_SHIFT;
+		const PxU32 row1 = PxMin(row0 + tileSize, nbRows - 1);
+		for(PxU32 tileCol=minTileColumn; tileCol<=maxTileColumn; tileCol++)
+		{
+			const PxU32 col0 = tileCol<<HF_TILE_SHIFT;
+			const PxU32 col1 = PxMin(col0 + tileSize, nbCols - 1);
+
+			PxI16 minHeight = PX_MAX_I16;
+			PxI16 maxHeight = PX_MIN_I16;
+			for(PxU32 row=row0; row<=row1; row++)
+			{
+				const PxHeightFieldSample* samples = mData.samples + row * nbCols;
+				for(PxU32 col=col0; col<=col1; col++)
+				{
+					const PxI16 height = samples[col].height;
+					minHeight = height < minHeight ? height : minHeight;
+					maxHeight = height > maxHeight ? height : maxHeight;
+				}
+			}
+
+			HeightFieldTileBounds& tile = mTileBounds[tileRow * mNbTileColumns + tileCol];
+			tile.mMinHeight = minHeight;
+			tile.mMaxHeight = maxHeight;
+		}
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -51,11 +51,22 @@ class PxInputStream;
 namespace Gu
 {
 class MeshFactory;
+
+// PT: cells are grouped in square tiles of (1<<HF_TILE_SHIFT)^2 cells, for which we store the min/max sample heights.
+// Raycasts use these to skip whole tiles the segment passes above (or below). They are computed at load time, not saved.
+#define HF_TILE_SHIFT	4
+
+struct HeightFieldTileBounds
+{
+	PxI16	mMinHeight;
+	PxI16	mMaxHeight;
+};
+
 class HeightField : public PxHeightField, public PxUserAllocated
 {
 public:
 // PX_SERIALIZATION
-																	HeightField(PxBaseFlags baseFlags) : PxHeightField(baseFlags), mData(PxEmpty), mModifyCount(0) {}
+																	HeightField(PxBaseFlags baseFlags) : PxHeightField(baseFlags), mData(PxEmpty), mModifyCount(0), mTileBounds(NULL), mNbTileColumns(0) {}
 
 										void						preExportDataReset() { Cm::RefCountable_preExportDataReset(*this); }
 							virtual		void						exportExtraData(PxSerializationContext& context);
@@ -224,6 +235,13 @@ public:
 						PX_FORCE_INLINE	PxReal						getMaxHeight()					const	{ return mMaxHeight; }
 
 						PX_FORCE_INLINE	const Gu::HeightFieldData&	getData()						const	{ return mData; }
+
+						PX_FORCE_INLINE	const HeightFieldTileBounds*	getTileBounds()				const	{ return mTileBounds;		}
+						// PT: tile containing the cell whose first vertex is (row, column)
+						PX_FORCE_INLINE	PxU32						getTileIndex(PxU32 row, PxU32 column)	const
+																	{
+																		return (row>>HF_TILE_SHIFT) * mNbTileColumns + (column>>HF_TILE_SHIFT);
+																	}
 	
 	PX_CUDA_CALLABLE	PX_FORCE_INLINE	void						getTriangleVertices(PxU32 triangleIndex, PxU32 row, PxU32 column, PxVec3& v0, PxVec3& v1, PxVec3& v2) const;
 
@@ -238,9 +256,14 @@ public:
 										PxU32						mNbSamples;	// PT: added for platform conversion. Try to remove later.
 										PxReal						mMinHeight;
 										PxReal						mMaxHeight;
+										bool						mExactHeightBounds;	// false once modifySamples() without shrinkBounds overwrote an extreme
 										PxU32						mModifyCount;
+										HeightFieldTileBounds*		mTileBounds;	// PT: always owned, rebuilt after deserialization
+										PxU32						mNbTileColumns;
 
 										void						releaseMemory();
+										bool						buildTileBounds();
+										void						computeTileBounds(PxU32 minTileRow, PxU32 maxTileRow, PxU32 minTileColumn, PxU32 maxTileColumn);
 						virtual										~HeightField();
 
 private:
@@ -464,6 +464,71 @@ namespace Gu
 			PxU32					mNbIndices;
 		};
 
+		// helper class for skipping whole tiles of cells using the per-tile height bounds, see Gu::HeightField::getTileBounds().
+		// Tiles are convex so the segment visits all the cells of a tile in one go. We test the part of the segment inside
+		// the tile once when entering it, and reuse the result for its remaining cells.
+		template<bool useUnderFaceCallback>
+		class TileSkipper
+		{
+		public:
+			PX_FORCE_INLINE TileSkipper(const Gu::HeightField& hf, PxF32 u0, PxF32 v0, PxF32 du, PxF32 dv, PxReal h0, PxReal dh, PxReal heightScale, PxF32 tMax, PxF32 hEpsilon) :
+				mHf(hf), mTiles(hf.getTileBounds()), mU0(u0), mV0(v0), mDu(du), mDv(dv), mH0(h0), mDh(dh), mHeightScale(heightScale), mTMax(tMax),
+				mEpsilon(hEpsilon + PxAbs(dh)*1e-4f), mCurrentTile(0xffffffff), mSkip(false)
+			{
+			}
+
+			// ui, vi, step_ui, step_vi define the current cell as in traceSegment, tPrev is where the segment enters it
+			PX_FORCE_INLINE bool skip(PxI32 ui, PxI32 vi, PxI32 step_ui, PxI32 step_vi, PxF32 tPrev)
+			{
+				if(!mTiles)
+					return false;
+
+				const PxU32 minui = PxU32(PxMin(ui, ui + step_ui));
+				const PxU32 minvi = PxU32(PxMin(vi, vi + step_vi));
+				const PxU32 tile = mHf.getTileIndex(minui, minvi);
+				if(tile != mCurrentTile)
+				{
+					mCurrentTile = tile;
+
+					// find where the segment leaves the tile
+					const PxU32 tileSize = 1<<HF_TILE_SHIFT;
+					const PxF32 u0 = PxF32((minui>>HF_TILE_SHIFT)<<HF_TILE_SHIFT);
+					const PxF32 v0 = PxF32((minvi>>HF_TILE_SHIFT)<<HF_TILE_SHIFT);
+					const PxF32 uExit = mDu > 0.0f ? u0 + PxF32(tileSize) : u0;
+					const PxF32 vExit = mDv > 0.0f ? v0 + PxF32(tileSize) : v0;
+					const PxF32 tExit = PxMin(PxMin((uExit - mU0) / mDu, (vExit - mV0) / mDv), mTMax);
+
+					const PxReal hPrev = mH0 + tPrev * mDh;
+					const PxReal hExit = mH0 + tExit * mDh;
+					const HeightFieldTileBounds& bounds = mTiles[tile];
+					const PxReal tileMin = PxReal(bounds.mMinHeight) * mHeightScale;
+					const PxReal tileMax = PxReal(bounds.mMaxHeight) * mHeightScale;
+
+					const bool above = PxMin(hPrev, hExit) - mEpsilon > tileMax;
+					const bool below = PxMax(hPrev, hExit) + mEpsilon < tileMin;
+					mSkip = above || (!useUnderFaceCallback && below);
+				}
+				return mSkip;
+			}
+
+		private:
+			const Gu::HeightField&			mHf;
+			const HeightFieldTileBounds*	mTiles;
+			const PxF32						mU0;
+			const PxF32						mV0;
+			const PxF32						mDu;
+			const PxF32						mDv;
+			const PxReal					mH0;
+			const PxReal					mDh;
+			const PxReal					mHeightScale;
+			const PxF32						mTMax;
+			const PxF32						mEpsilon;
+			PxU32							mCurrentTile;
+			bool							mSkip;
+
+			PX_NOCOPY(TileSkipper)
+		};
+
 		// If useUnderFaceCalblack is false, traceSegment will report segment/triangle hits via
 		//   faceHit(const Gu::HeightFieldUtil& hf, const PxVec3& point, PxU32 triangleIndex)
 		// Otherwise traceSegment will report all triangles the segment passes under via
@@ -477,9 +542,12 @@ namespace Gu
 		// Note that hfLocalBounds are passed as a parameter instead of being computed inside the traceSegment. 
 		//	The localBounds can be obtained: PxBounds3 hfLocalBounds; hfUtil.computeLocalBounds(hfLocalBounds); and passed as 
 		//  a parameter.		
+		// overlapClosestHit (optional, overlap only) points to the closest hit distance found so far by the callback. Cells are
+		//  visited in order along the segment and each overlap rectangle covers the object extent around its cell, so the walk
+		//  stops as soon as it enters a cell beyond that distance: the remaining cells cannot produce a closer hit.
 		template<class T, bool useUnderFaceCallback, bool overlap>
 		PX_INLINE void traceSegment(const PxVec3& aP0, const PxVec3& rayDir, const float rayLength , T* aCallback, const PxBounds3& hfLocalBounds, bool backfaceCull,
-			const PxVec3* overlapObjectExtent = NULL) const
+			const PxVec3* overlapObjectExtent = NULL, const PxReal* overlapClosestHit = NULL) const
 		{			
 			PxF32 tnear, tfar;
 			if(!Gu::intersectRayAABB2(hfLocalBounds.minimum, hfLocalBounds.maximum, aP0, rayDir, rayLength, tnear, tfar)) 
@@ -602,6 +670,9 @@ namespace Gu
 			// seed hLinePrev as h(0)
 			PxReal hLinePrev = COMPUTE_H_FROM_T(0);
 
+			// PT: a cell's exit t is less than one step past its entry t, and we don't enter cells beyond tEnd
+			TileSkipper<useUnderFaceCallback> tileSkipper(hf, uu0, uv0, du, dv, h0, dh, heightScale, tEnd + PxMax(step_tu, step_tv), hEpsilon);
+
 			do
 			{
 				tMinUV = PxMin(tu, tv); // determine where next closest u or v-intercept point is
@@ -622,12 +693,16 @@ namespace Gu
 					}
 					else
 					{
+						// early exit: the segment enters the current cell beyond the closest hit
+						if(overlapClosestHit && tnear + PxMax(last_tu, last_tv)*(tfar - tnear) > *overlapClosestHit)
+							return;
+
 						// overlap step
 						if(!overlapTraceSegment.step(ui,vi))
 							return;
 					}
 				}
-				else
+				else if(!tileSkipper.skip(ui, vi, step_ui, step_vi, PxMax(last_tu, last_tv)))
 				{
 				const PxU32 colIndex0 = PxU32(nbVi * ui + vi);
 				const PxU32 colIndex1 = PxU32(nbVi * (ui + step_ui) + vi);
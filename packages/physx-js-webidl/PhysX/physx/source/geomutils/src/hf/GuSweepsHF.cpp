@@ -68,10 +68,11 @@ public:
 		mLocalBounds.maximum = mLocalBounds.maximum + aabbExtentHfLocalSpace;
 	}
 
+	// closestHit (optional) is the closest hit distance maintained by the callback, see HeightFieldTraceUtil::traceSegment
 	template<class T>
-	PX_INLINE void traceSegment(const PxVec3& aP0, const PxVec3& rayDirNorm, const float rayLength, T* aCallback) const
+	PX_INLINE void traceSegment(const PxVec3& aP0, const PxVec3& rayDirNorm, const float rayLength, T* aCallback, const PxReal* closestHit = NULL) const
 	{
-		mHfUtil.traceSegment<T, false, true>(aP0, rayDirNorm, rayLength, aCallback, mLocalBounds, false, &mOverlapObjectExtent);
+		mHfUtil.traceSegment<T, false, true>(aP0, rayDirNorm, rayLength, aCallback, mLocalBounds, false, &mOverlapObjectExtent, closestHit);
 	}
 
 private:
@@ -148,9 +149,9 @@ public:
 
 		PxGeomSweepHit h;	// PT: TODO: ctor!
 		// PT: this one is safe because cullbox is NULL (no need to allocate one more triangle)
-		// PT: TODO: is it ok to pass the initial distance here?
+		// PT: triangles are only useful if they are hit before the closest hit so far, so we sweep up to that distance
 		PxVec3 bestNormal;
-		const bool status = sweepCapsuleTriangles_Precise(nb, tmpT, mInflatedCapsule, mUnitDir, mDistance, NULL, h, bestNormal, mHitFlags, mIsDoubleSided);
+		const bool status = sweepCapsuleTriangles_Precise(nb, tmpT, mInflatedCapsule, mUnitDir, PxMin(mDistance, mSweepHit.distance), NULL, h, bestNormal, mHitFlags, mIsDoubleSided);
 		if(status && (h.distance <= mSweepHit.distance))
 		{
 			mSweepHit.faceIndex	= indices[h.faceIndex];
@@ -252,8 +253,9 @@ bool sweepCapsule_HeightFieldGeom(GU_CAPSULE_SWEEP_FUNC_PARAMS)
 	const PxVec3 sweepDirLocalSpace = inversePose.rotate(unitDir);
 	const PxVec3 capsuleAABBBExtentHfLocalSpace = PxBounds3::basisExtent(centerLocalSpace, PxMat33Padded(inversePose.q), capsuleAABBExtents).getExtents();
 
+	// PT: the cells are walked in sweep order, so the traversal can stop once it gets past the closest hit
 	HeightFieldTraceSegmentSweepHelper traceSegmentHelper(hfUtil, capsuleAABBBExtentHfLocalSpace);
-	traceSegmentHelper.traceSegment<CapsuleTraceSegmentReport>(centerLocalSpace, sweepDirLocalSpace, distance, &myReport);
+	traceSegmentHelper.traceSegment<CapsuleTraceSegmentReport>(centerLocalSpace, sweepDirLocalSpace, distance, &myReport, &sweepHit.distance);
 
 	return myReport.finalizeHit(sweepHit, hfGeom, pose, lss, inflatedCapsule, unitDir);
 }
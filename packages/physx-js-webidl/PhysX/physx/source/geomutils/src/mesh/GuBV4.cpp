@@ -32,6 +32,7 @@
 #include "CmSerialize.h"
 #include "foundation/PxVecMath.h"
 #include "common/PxSerialFramework.h"
+#include "foundation/PxBitMap.h"
 
 using namespace physx;
 using namespace Gu;
@@ -581,7 +582,7 @@ bool BV4Tree::refit(PxBounds3& globalBounds, float epsilon)
 #endif
 
 #ifdef VERSION2
-bool BV4Tree::refit(PxBounds3& globalBounds, float epsilon)
+bool BV4Tree::refit(PxBounds3& globalBounds, float epsilon, const PxU32* dirtyPrimitives, PxU32 nbDirtyPrimitives)
 {
 	if(mQuantized)
 		return false;
@@ -611,7 +612,23 @@ bool BV4Tree::refit(PxBounds3& globalBounds, float epsilon)
 	PX_ASSERT(!(mNbNodes&3));
 	PxU32 nb = mNbNodes/4;
 	BVDataSwizzledNQ* data = reinterpret_cast<BVDataSwizzledNQ*>(mNodes);
-	
+
+	// PT: for partial refits we tag the dirty primitives, then the nodes whose boxes changed. Children are always stored
+	// after their parent, so a single reverse pass propagates the changes up to the root like the regular refit.
+	const bool partialRefit = dirtyPrimitives!=NULL;
+	PxBitMap dirtyPrims;
+	PxBitMap dirtyNodes;
+	if(partialRefit)
+	{
+		dirtyPrims.resizeAndClear(mMeshInterface->getNbPrimitives());
+		for(PxU32 i=0;i<nbDirtyPrimitives;i++)
+		{
+			PX_ASSERT(dirtyPrimitives[i]<mMeshInterface->getNbPrimitives());
+			dirtyPrims.set(dirtyPrimitives[i]);
+		}
+		dirtyNodes.resizeAndClear(nb);
+	}
+
 	while(nb--)
 	{
 		BVDataSwizzledNQ* PX_RESTRICT current = data + nb;
@@ -629,6 +646,16 @@ bool BV4Tree::refit(PxBounds3& globalBounds, float epsilon)
 				Vec4V maxV = V4Load(-FLT_MAX);
 
 				PxU32 nbToGo = getNbPrimitives(primIndex);
+
+				if(partialRefit)
+				{
+					bool dirty = false;
+					for(PxU32 k=0;k<=nbToGo && !dirty;k++)
+						dirty = dirtyPrims.test(primIndex+k)!=0;
+					if(!dirty)
+						continue;
+					dirtyNodes.set(nb);
+				}
 				//VertexPointers VP;
 				do
 				{
@@ -677,6 +704,13 @@ bool BV4Tree::refit(PxBounds3& globalBounds, float epsilon)
 				PX_ASSERT(childOffset>nb);
 				const PxU32 childType = current->getChildType(j);
 
+				if(partialRefit)
+				{
+					if(!dirtyNodes.test(childOffset))
+						continue;
+					dirtyNodes.set(nb);
+				}
+
 				const BVDataSwizzledNQ* PX_RESTRICT next = data + childOffset;
 				{
 					current->mMinX[j] = PxMin(next->mMinX[0], next->mMinX[1]);
@@ -735,3 +769,28 @@ bool BV4Tree::refit(PxBounds3& globalBounds, float epsilon)
 }
 #endif
 
+float BV4Tree::computeSurfaceAreaCost() const
+{
+	if(mQuantized || !mNodes)
+		return 0.0f;
+
+	float cost = 0.0f;
+	const PxU32 nb = mNbNodes/4;
+	const BVDataSwizzledNQ* data = reinterpret_cast<const BVDataSwizzledNQ*>(mNodes);
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const BVDataSwizzledNQ& current = data[i];
+		for(PxU32 j=0;j<4;j++)
+		{
+			if(current.getChildData(j)==PX_INVALID_U32)
+				continue;
+
+			const float dx = current.mMaxX[j] - current.mMinX[j];
+			const float dy = current.mMaxY[j] - current.mMinY[j];
+			const float dz = current.mMaxZ[j] - current.mMinZ[j];
+			cost += dx*dy + dy*dz + dz*dx;
+		}
+	}
+	return cost;
+}
+
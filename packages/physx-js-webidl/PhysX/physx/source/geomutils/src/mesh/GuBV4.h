@@ -348,7 +348,10 @@ namespace Gu
 								BV4Tree(SourceMesh* meshInterface, const PxBounds3& localBounds);
 								~BV4Tree();
 
-				bool			refit(PxBounds3& globalBounds, float epsilon);
+				// PT: if 'dirtyPrimitives' is not NULL, only the nodes containing these primitives and their parents are refit
+				bool			refit(PxBounds3& globalBounds, float epsilon, const PxU32* dirtyPrimitives=NULL, PxU32 nbDirtyPrimitives=0);
+				// PT: sum of the surface areas of all node boxes, i.e. the unscaled SAH cost of the tree. Non-quantized trees only.
+				float			computeSurfaceAreaCost()	const;
 
 				bool			load(PxInputStream& stream, bool mismatch);
 
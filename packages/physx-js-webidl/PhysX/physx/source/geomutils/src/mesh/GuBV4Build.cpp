@@ -34,6 +34,10 @@
 #include "GuBounds.h"
 #include "GuBV4Build.h"
 #include "GuBV4.h"
+#include "CmParallelFor.h"
+#include "CmRadixSort.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxBitUtils.h"
 #include <stdio.h>
 
 using namespace physx;
@@ -325,26 +329,263 @@ static void local_BuildHierarchy_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats&
 	}
 }
 
-bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy)
+// PT: spreads the 10 lower bits of x so that there are two zero bits between each of them
+static PX_FORCE_INLINE PxU32 expandBits10(PxU32 x)
+{
+	x = (x | (x << 16)) & 0x030000FF;
+	x = (x | (x <<  8)) & 0x0300F00F;
+	x = (x | (x <<  4)) & 0x030C30C3;
+	x = (x | (x <<  2)) & 0x09249249;
+	return x;
+}
+
+static PX_FORCE_INLINE PxU32 computeMortonCode(const PxVec3& p, const PxVec3& minimum, const PxVec3& scale)
+{
+	const PxVec3 n = (p - minimum).multiply(scale);
+	const PxU32 x = PxU32(PxClamp(n.x, 0.0f, 1023.0f));
+	const PxU32 y = PxU32(PxClamp(n.y, 0.0f, 1023.0f));
+	const PxU32 z = PxU32(PxClamp(n.z, 0.0f, 1023.0f));
+	return (expandBits10(x)<<2) | (expandBits10(y)<<1) | expandBits10(z);
+}
+
+// PT: LBVH-style split for primitives sorted by Morton code. The node's primitives are a contiguous range of the sorted
+// codes, and we split them where the highest bit that differs between the first and last code changes. This is much
+// cheaper than the other strategies (no reshuffle, no SAH sweeps) at the expense of slightly worse trees.
+static PxU32 local_SplitMorton(const PxU32* PX_RESTRICT codes, PxU32 nb)
+{
+	const PxU32 first = codes[0];
+	const PxU32 last = codes[nb-1];
+	if(first==last)
+		return nb>>1;	// PT: identical codes, make an arbitrary 50-50 split
+
+	const PxU32 highestBit = 1u<<PxHighestSetBit(first ^ last);
+
+	// PT: the codes are sorted so they share the same prefix above 'highestBit', and the ones with this bit set come last
+	PxU32 lo = 0;
+	PxU32 hi = nb-1;
+	while(lo<hi)
+	{
+		const PxU32 mid = (lo + hi)>>1;
+		if(codes[mid] & highestBit)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	return lo;
+}
+
+static bool local_Subdivide_Morton(AABBTreeNode* PX_RESTRICT node, BuildStats& stats, const BuildParams& params, const PxU32* PX_RESTRICT sortedCodes, const PxU32* PX_RESTRICT indexBase)
+{
+	const PxU32* prims = node->mNodePrimitives;
+	const PxU32 nb = node->mNbPrimitives;
+
+	// Compute bv
+	computeGlobalBox(node->mBV, nb, params.mBoxes, prims);
+
+#ifndef GU_BV4_FILL_GAPS
+	if(nb<=params.mLimit)
+		return false;
+#endif
+
+	const PxU32 leftCount = nb>1 ? local_SplitMorton(sortedCodes + (prims - indexBase), nb) : 0;
+
+#ifdef GU_BV4_FILL_GAPS
+	// We split the node a last time before returning when we're below the limit, for the "fill the gaps" strategy
+	if(nb<=params.mLimit)
+	{
+		node->mNextSplit = leftCount;
+		return false;
+	}
+#endif
+
+	// Now create children and assign their pointers.
+	// We use a pre-allocated linear pool for complete trees [Opcode 1.3]
+	const PxU32 count = stats.getCount();
+	node->mPos = size_t(params.mNodeBase + count);
+
+	// Update stats
+	stats.increaseCount(2);
+
+	// Assign children
+	AABBTreeNode* pos = const_cast<AABBTreeNode*>(node->getPos());
+	AABBTreeNode* neg = const_cast<AABBTreeNode*>(node->getNeg());
+	pos->mNodePrimitives	= node->mNodePrimitives;
+	pos->mNbPrimitives		= leftCount;
+	neg->mNodePrimitives	= node->mNodePrimitives + leftCount;
+	neg->mNbPrimitives		= node->mNbPrimitives - leftCount;
+	return true;
+}
+
+static void local_BuildHierarchy_Morton(AABBTreeNode* PX_RESTRICT node, BuildStats& stats, const BuildParams& params, const PxU32* PX_RESTRICT sortedCodes, const PxU32* PX_RESTRICT indexBase)
+{
+	if(local_Subdivide_Morton(node, stats, params, sortedCodes, indexBase))
+	{
+		AABBTreeNode* pos = const_cast<AABBTreeNode*>(node->getPos());
+		AABBTreeNode* neg = const_cast<AABBTreeNode*>(node->getNeg());
+		local_BuildHierarchy_Morton(pos, stats, params, sortedCodes, indexBase);
+		local_BuildHierarchy_Morton(neg, stats, params, sortedCodes, indexBase);
+	}
+}
+
+// PT: sorts the primitives by the Morton code of their center, and writes the sorted indices & codes
+static void sortByMortonCodes(PxU32 nbBoxes, const PxVec3* PX_RESTRICT centers, PxU32* PX_RESTRICT indices, PxU32* PX_RESTRICT sortedCodes, PxCpuDispatcher* dispatcher)
+{
+	PxBounds3 centersBounds = PxBounds3::empty();
+	for(PxU32 i=0;i<nbBoxes;i++)
+		centersBounds.include(centers[i]);
+
+	const PxVec3 extents = centersBounds.maximum - centersBounds.minimum;
+	const PxVec3 scale(	extents.x>0.0f ? 1023.0f/extents.x : 0.0f,
+						extents.y>0.0f ? 1023.0f/extents.y : 0.0f,
+						extents.z>0.0f ? 1023.0f/extents.z : 0.0f);
+
+	PxU32* codes = PX_ALLOCATE(PxU32, nbBoxes, "BV4 Morton codes");
+	for(PxU32 i=0;i<nbBoxes;i++)
+		codes[i] = computeMortonCode(centers[i], centersBounds.minimum, scale);
+
+	Cm::RadixSortParallel rs;
+	const PxU32* ranks = rs.Sort(codes, nbBoxes, Cm::RADIX_UNSIGNED, dispatcher).GetRanks();
+	for(PxU32 i=0;i<nbBoxes;i++)
+	{
+		const PxU32 index = ranks[i];
+		indices[i] = index;
+		sortedCodes[i] = codes[index];
+	}
+	PX_FREE(codes);
+}
+
+namespace
+{
+	// PT: a subtree whose construction is deferred to the parallel phase of buildFromMesh()
+	struct PendingSubtree
+	{
+		AABBTreeNode*	mRoot;
+		AABBTreeNode*	mNodes;		// Node range reserved for the descendants of mRoot
+		PxU32			mNbNodes;	// Number of nodes actually used in mNodes
+	};
+
+	class ComputePrimitiveBoxes : public Cm::ParallelForCallback
+	{
+		public:
+			ComputePrimitiveBoxes(SourceMeshBase& mesh, PxBounds3* boxes, PxVec3* centers) : mMesh(mesh), mBoxes(boxes), mCenters(centers)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				const FloatV halfV = FLoad(0.5f);
+				const PxU32 last = endIndex - 1;
+				for(PxU32 i=startIndex; i<=last; i++)
+				{
+					Vec4V minV, maxV;
+					mMesh.getPrimitiveBox(i, minV, maxV);
+
+					V4StoreU_Safe(minV, &mBoxes[i].minimum.x);	// PT: safe because 'maximum' follows 'minimum'
+
+					const Vec4V centerV = V4Scale(V4Add(maxV, minV), halfV);
+
+					// PT: the 16-byte stores write into the next element, which can belong to a range processed by another thread
+					if(i!=last)
+					{
+						V4StoreU_Safe(maxV, &mBoxes[i].maximum.x);
+						V4StoreU_Safe(centerV, &mCenters[i].x);
+					}
+					else
+					{
+						V3StoreU(Vec3V_From_Vec4V(maxV), mBoxes[i].maximum);
+						V3StoreU(Vec3V_From_Vec4V(centerV), mCenters[i]);
+					}
+				}
+			}
+
+			SourceMeshBase&	mMesh;
+			PxBounds3*		mBoxes;
+			PxVec3*			mCenters;
+			PX_NOCOPY(ComputePrimitiveBoxes)
+	};
+
+	class BuildSubtrees : public Cm::ParallelForCallback
+	{
+		public:
+			BuildSubtrees(PendingSubtree* subtrees, const PxBounds3* boxes, const PxVec3* centers, PxU32 limit, const SourceMesh* mesh, bool sah) :
+				mSubtrees(subtrees), mBoxes(boxes), mCenters(centers), mLimit(limit), mMesh(mesh), mSAH(sah)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				for(PxU32 i=startIndex; i<endIndex; i++)
+				{
+					PendingSubtree& subtree = mSubtrees[i];
+
+					BuildStats stats;
+					stats.setCount(0);
+					const BuildParams params(mBoxes, mCenters, subtree.mNodes, mLimit, mMesh);
+					if(mSAH)
+					{
+						SAH_Buffers sah(subtree.mRoot->mNbPrimitives);
+						local_BuildHierarchy_SAH(subtree.mRoot, stats, params, sah);
+					}
+					else
+						local_BuildHierarchy(subtree.mRoot, stats, params);
+					subtree.mNbNodes = stats.getCount();
+				}
+			}
+
+			PendingSubtree*		mSubtrees;
+			const PxBounds3*	mBoxes;
+			const PxVec3*		mCenters;
+			const PxU32			mLimit;
+			const SourceMesh*	mMesh;
+			const bool			mSAH;
+			PX_NOCOPY(BuildSubtrees)
+	};
+}
+
+// PT: builds the top of the tree serially, and defers the subtrees with less than 'grain' primitives. Each deferred subtree
+// gets its own node range, taken from the end of the pool. The descendants of a node with N primitives use at most 2*N-2 nodes
+// and the whole tree at most 2*nbPrims-1, so these ranges never overlap the nodes allocated here from the start of the pool.
+// Node splits only depend on the node's primitives, so the resulting tree is the same as the one built serially.
+static void local_BuildTopHierarchy(AABBTreeNode* PX_RESTRICT node, BuildStats& stats, const BuildParams& params, SAH_Buffers* buffers, PxU32 grain, PxArray<PendingSubtree>& subtrees, AABBTreeNode*& reservedNodes)
+{
+	if(node->mNbPrimitives<=grain)
+	{
+		reservedNodes -= node->mNbPrimitives*2 - 2;
+
+		PendingSubtree subtree;
+		subtree.mRoot		= node;
+		subtree.mNodes		= reservedNodes;
+		subtree.mNbNodes	= 0;
+		subtrees.pushBack(subtree);
+		return;
+	}
+
+	const bool split = buffers ? local_Subdivide_SAH(node, stats, params, *buffers) : local_Subdivide(node, stats, params);
+	if(split)
+	{
+		AABBTreeNode* pos = const_cast<AABBTreeNode*>(node->getPos());
+		AABBTreeNode* neg = const_cast<AABBTreeNode*>(node->getNeg());
+		local_BuildTopHierarchy(pos, stats, params, buffers, grain, subtrees, reservedNodes);
+		local_BuildTopHierarchy(neg, stats, params, buffers, grain, subtrees, reservedNodes);
+	}
+}
+
+// PT: below this number of primitives per subtree the task overhead isn't worth it
+#define BV4_PARALLEL_BUILD_MIN_GRAIN	4096
+
+bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
 {
 	const PxU32 nbBoxes = mesh.getNbPrimitives();
 	if(!nbBoxes)
 		return false;
 	PxBounds3* boxes = PX_ALLOCATE(PxBounds3, (nbBoxes + 1), "BV4");	// PT: +1 to safely V4Load/V4Store the last element
 	PxVec3* centers = PX_ALLOCATE(PxVec3, (nbBoxes + 1), "BV4");		// PT: +1 to safely V4Load/V4Store the last element
-	const FloatV halfV = FLoad(0.5f);
-	for (PxU32 i = 0; i<nbBoxes; i++)
 	{
-		Vec4V minV, maxV;
-		mesh.getPrimitiveBox(i, minV, maxV);
-
-		V4StoreU_Safe(minV, &boxes[i].minimum.x);	// PT: safe because 'maximum' follows 'minimum'
-		V4StoreU_Safe(maxV, &boxes[i].maximum.x);	// PT: safe because we allocated one more box
-
-		const Vec4V centerV = V4Scale(V4Add(maxV, minV), halfV);
-		V4StoreU_Safe(centerV, &centers[i].x);	// PT: safe because we allocated one more PxVec3
+		ComputePrimitiveBoxes computeBoxes(mesh, boxes, centers);
+		Cm::parallelFor(dispatcher, nbBoxes, BV4_PARALLEL_BUILD_MIN_GRAIN, computeBoxes);
 	}
 
+	const PxU32 nbThreads = Cm::getParallelForThreadCount(dispatcher);
+	// PT: a few subtrees per thread for load balancing, since SAH subtrees can be very uneven
+	const PxU32 grain = PxMax(PxMax(nbBoxes / (nbThreads * 8), PxU32(BV4_PARALLEL_BUILD_MIN_GRAIN)), limit);
+	const bool parallelBuild = nbThreads>1 && nbBoxes>grain;
+
 	{
 		// Release previous tree
 		release();
@@ -368,17 +609,44 @@ bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStr
 		mPool->mNodePrimitives = mIndices;
 		mPool->mNbPrimitives = nbBoxes;
 
+		if(strategy!=BV4_SPLATTER_POINTS && strategy!=BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER && strategy!=BV4_SAH && strategy!=BV4_MORTON)
+			return false;
+
+		// PT: not sure what the equivalent would be for tet-meshes here
+		SourceMesh* triMesh = NULL;
+		if(strategy==BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER)
+		{
+			if(mesh.getMeshType()==SourceMeshBase::TRI_MESH)
+				triMesh = static_cast<SourceMesh*>(&mesh);
+		}
+
 		// Build the hierarchy
-		if(strategy==BV4_SPLATTER_POINTS||strategy==BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER)
+		if(strategy==BV4_MORTON)
 		{
-			// PT: not sure what the equivalent would be for tet-meshes here
-			SourceMesh* triMesh = NULL;
-			if(strategy==BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER)
+			// PT: the Morton build is cheap enough that we only parallelize the sort
+			PxU32* sortedCodes = PX_ALLOCATE(PxU32, nbBoxes, "BV4 sorted Morton codes");
+			sortByMortonCodes(nbBoxes, centers, mIndices, sortedCodes, dispatcher);
+			local_BuildHierarchy_Morton(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sortedCodes, mIndices);
+			PX_FREE(sortedCodes);
+		}
+		else if(parallelBuild)
+		{
+			PxArray<PendingSubtree> subtrees;
+			AABBTreeNode* reservedNodes = mPool + nbBoxes * 2 - 1;
+			if(strategy==BV4_SAH)
 			{
-				if(mesh.getMeshType()==SourceMeshBase::TRI_MESH)
-					triMesh = static_cast<SourceMesh*>(&mesh);
+				SAH_Buffers sah(nbBoxes);
+				local_BuildTopHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), &sah, grain, subtrees, reservedNodes);
 			}
-			local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
+			else
+				local_BuildTopHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh), NULL, grain, subtrees, reservedNodes);
+			PX_ASSERT(mPool + Stats.getCount() <= reservedNodes);
+
+			BuildSubtrees buildSubtrees(subtrees.begin(), boxes, centers, limit, triMesh, strategy==BV4_SAH);
+			Cm::parallelFor(dispatcher, subtrees.size(), 1, buildSubtrees);
+
+			for(PxU32 i=0; i<subtrees.size(); i++)
+				Stats.increaseCount(subtrees[i].mNbNodes);
 		}
 		else if(strategy==BV4_SAH)
 		{
@@ -386,7 +654,7 @@ bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStr
 			local_BuildHierarchy_SAH(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sah);
 		}
 		else
-			return false;
+			local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
 
 		// Get back total number of nodes
 		mTotalNbNodes = Stats.getCount();
@@ -1820,7 +2088,7 @@ static bool gReorderCallback(const AABBTreeNode* current, PxU32 /*depth*/, void*
 	return true;
 }
 
-bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy)
+bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
 {
 	//either number of triangle or number of tetrahedron
 	const PxU32 nbPrimitives = mesh.getNbPrimitives();
@@ -1828,7 +2096,7 @@ bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, P
 	BV4_AABBTree Source;
 	{
 		GU_PROFILE_ZONE("..BuildBV4Ex_buildFromMesh")
-		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy))
+		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy, dispatcher))
 			return false;
 	}
 
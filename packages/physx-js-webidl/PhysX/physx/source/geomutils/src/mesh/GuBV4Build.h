@@ -36,6 +36,8 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Gu
 {
 	class BV4Tree;
@@ -86,7 +88,8 @@ namespace Gu
 	{
 		BV4_SPLATTER_POINTS,
 		BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER,
-		BV4_SAH
+		BV4_SAH,
+		BV4_MORTON	// LBVH-style build from Morton-sorted centers. Fast but lower quality trees.
 	};
 
 	// PT: TODO: refactor with SQ version (TA34704)
@@ -96,7 +99,7 @@ namespace Gu
 											BV4_AABBTree();
 											~BV4_AABBTree();
 
-						bool				buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy=BV4_SPLATTER_POINTS);
+						bool				buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy=BV4_SPLATTER_POINTS, PxCpuDispatcher* dispatcher=NULL);
 						void				release();
 
 		PX_FORCE_INLINE	const PxU32*		getIndices()		const	{ return mIndices;		}	//!< Catch the indices
@@ -115,7 +118,7 @@ namespace Gu
 						PxU32				mTotalNbNodes;		//!< Number of nodes in the tree.
 	};
 
-	bool BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy=BV4_SPLATTER_POINTS);
+	bool BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy=BV4_SPLATTER_POINTS, PxCpuDispatcher* dispatcher=NULL);
 
 } // namespace Gu
 }
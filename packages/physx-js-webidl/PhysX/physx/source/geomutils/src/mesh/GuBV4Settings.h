@@ -36,6 +36,7 @@
 	#define GU_BV4_USE_SLABS					// Use swizzled data format or not. Swizzled = faster raycasts, but slower overlaps & larger trees.
 //	#define GU_BV4_COMPILE_NON_QUANTIZED_TREE	// 
 	#define GU_BV4_FILL_GAPS
+	#define GU_BV4_RAY_PACKET_SIZE	8			// Max number of rays traversed together by the packet raycast.
 
 //#define PROFILE_MESH_COOKING
 #ifdef PROFILE_MESH_COOKING
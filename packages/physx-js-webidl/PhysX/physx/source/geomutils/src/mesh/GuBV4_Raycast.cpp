@@ -42,6 +42,7 @@ using namespace Gu;
 #include "GuIntersectionRayTriangle.h"
 
 #include "foundation/PxVecMath.h"
+#include "foundation/PxBitUtils.h"
 using namespace aos;
 
 #include "GuBV4_Common.h"
@@ -904,3 +905,227 @@ PxU32 BV4_RaycastAll(const PxVec3& origin, const PxVec3& dir, const BV4Tree& tre
 	return Params.mNbHits;
 }
 
+
+// Packet version
+
+#ifdef GU_BV4_USE_SLABS
+namespace
+{
+// PT: per-ray slab data, i.e. what SLABS_INIT computes for the single-ray traversal
+struct PacketRay
+{
+	Vec4V	mInvDX, mInvDY, mInvDZ;
+	Vec4V	mPInvDX, mPInvDY, mPInvDZ;
+};
+}
+
+static PX_FORCE_INLINE void setupPacketRay(PacketRay& ray, const RayParams_Raycast& params)
+{
+	const Vec4V rayP = V4LoadU_Safe(&params.mOrigin_Padded.x);
+	Vec4V rayD = V4LoadU_Safe(&params.mLocalDir_Padded.x);
+	const VecU32V raySign = V4U32and(VecU32V_ReinterpretFrom_Vec4V(rayD), signMask);
+	const Vec4V rayDAbs = V4Abs(rayD);
+	Vec4V rayInvD = Vec4V_ReinterpretFrom_VecU32V(V4U32or(raySign, VecU32V_ReinterpretFrom_Vec4V(V4Max(rayDAbs, epsFloat4))));
+	rayD = rayInvD;
+	rayInvD = V4RecipFast(rayInvD);
+	rayInvD = V4Mul(rayInvD, V4NegMulSub(rayD, rayInvD, twos));
+	const Vec4V rayPinvD = V4NegMulSub(rayInvD, rayP, zeroes);
+	ray.mInvDX = V4SplatElement<0>(rayInvD);
+	ray.mInvDY = V4SplatElement<1>(rayInvD);
+	ray.mInvDZ = V4SplatElement<2>(rayInvD);
+	ray.mPInvDX = V4SplatElement<0>(rayPinvD);
+	ray.mPInvDY = V4SplatElement<1>(rayPinvD);
+	ray.mPInvDZ = V4SplatElement<2>(rayPinvD);
+}
+
+// PT: returns a 4-bit mask of the node's children touched by the ray
+static PX_FORCE_INLINE PxU32 testPacketRay(const PacketRay& ray, float maxT,	const Vec4V minx4a, const Vec4V miny4a, const Vec4V minz4a,
+																			const Vec4V maxx4a, const Vec4V maxy4a, const Vec4V maxz4a)
+{
+	const Vec4V maxT4 = V4Load(maxT);
+	const Vec4V tminxa0 = V4MulAdd(minx4a, ray.mInvDX, ray.mPInvDX);
+	const Vec4V tminya0 = V4MulAdd(miny4a, ray.mInvDY, ray.mPInvDY);
+	const Vec4V tminza0 = V4MulAdd(minz4a, ray.mInvDZ, ray.mPInvDZ);
+	const Vec4V tmaxxa0 = V4MulAdd(maxx4a, ray.mInvDX, ray.mPInvDX);
+	const Vec4V tmaxya0 = V4MulAdd(maxy4a, ray.mInvDY, ray.mPInvDY);
+	const Vec4V tmaxza0 = V4MulAdd(maxz4a, ray.mInvDZ, ray.mPInvDZ);
+	const Vec4V maxOfNeasa = V4Max(V4Max(V4Min(tminxa0, tmaxxa0), V4Min(tminya0, tmaxya0)), V4Min(tminza0, tmaxza0));
+	const Vec4V minOfFarsa = V4Min(V4Min(V4Max(tminxa0, tmaxxa0), V4Max(tminya0, tmaxya0)), V4Max(tminza0, tmaxza0));
+
+	BoolV ignore4a = V4IsGrtr(epsFloat4, minOfFarsa);
+	ignore4a = BOr(ignore4a, V4IsGrtr(maxOfNeasa, maxT4));
+	const BoolV resa4 = BOr(V4IsGrtr(maxOfNeasa, minOfFarsa), ignore4a);
+	return ~BGetBitMask(resa4) & 15;
+}
+
+static PX_FORCE_INLINE void getSwizzledBounds(const BVDataSwizzledQ* PX_RESTRICT tn, const Vec4V* PX_RESTRICT coeffs,
+												Vec4V& minx4a, Vec4V& miny4a, Vec4V& minz4a, Vec4V& maxx4a, Vec4V& maxy4a, Vec4V& maxz4a)
+{
+	OPC_DEQ4(maxx4a, minx4a, mX, coeffs[0], coeffs[3])
+	OPC_DEQ4(maxy4a, miny4a, mY, coeffs[1], coeffs[4])
+	OPC_DEQ4(maxz4a, minz4a, mZ, coeffs[2], coeffs[5])
+}
+
+static PX_FORCE_INLINE void getSwizzledBounds(const BVDataSwizzledNQ* PX_RESTRICT tn, const Vec4V* PX_RESTRICT,
+												Vec4V& minx4a, Vec4V& miny4a, Vec4V& minz4a, Vec4V& maxx4a, Vec4V& maxy4a, Vec4V& maxz4a)
+{
+	minx4a = V4LoadA(tn->mMinX);
+	miny4a = V4LoadA(tn->mMinY);
+	minz4a = V4LoadA(tn->mMinZ);
+	maxx4a = V4LoadA(tn->mMaxX);
+	maxy4a = V4LoadA(tn->mMaxY);
+	maxz4a = V4LoadA(tn->mMaxZ);
+}
+
+// PT: Kajiya, no sort, N rays at a time. Each stack entry carries the subset of rays still touching the node,
+// so the node is fetched (and dequantized) once for the whole packet and rays drop out as they miss.
+template<class LeafTestT, class PackedT, class SwizzledT>
+static void BV4_ProcessStreamKajiyaPacket(const PackedT* PX_RESTRICT node, PxU32 initData, RayParams_Raycast* PX_RESTRICT params, const PacketRay* PX_RESTRICT rays, PxU32 nbRays, const Vec4V* PX_RESTRICT coeffs)
+{
+	const PackedT* root = node;
+
+	PxU32 nb=1;
+	PxU32 stack[GU_BV4_STACK_SIZE];
+	PxU32 rayMasks[GU_BV4_STACK_SIZE];
+	stack[0] = initData;
+	rayMasks[0] = (1u<<nbRays)-1;
+
+	PxU32 activeRays = rayMasks[0];
+
+	do
+	{
+		nb--;
+		const PxU32 rayMask = rayMasks[nb] & activeRays;
+		if(!rayMask)
+			continue;
+
+		const PxU32 childData = stack[nb];
+		node = root + getChildOffset(childData);
+
+		const SwizzledT* tn = reinterpret_cast<const SwizzledT*>(node);
+
+		Vec4V minx4a, miny4a, minz4a, maxx4a, maxy4a, maxz4a;
+		getSwizzledBounds(tn, coeffs, minx4a, miny4a, minz4a, maxx4a, maxy4a, maxz4a);
+
+		PxU32 childRays[4] = { 0, 0, 0, 0 };
+		PxU32 m = rayMask;
+		while(m)
+		{
+			const PxU32 i = PxLowestSetBitUnsafe(m);
+			m &= m - 1;
+
+			const PxU32 code = testPacketRay(rays[i], params[i].mStabbedFace.mDistance, minx4a, miny4a, minz4a, maxx4a, maxy4a, maxz4a);
+			const PxU32 bit = 1u<<i;
+			childRays[0] |= (code & 1) ? bit : 0;
+			childRays[1] |= (code & 2) ? bit : 0;
+			childRays[2] |= (code & 4) ? bit : 0;
+			childRays[3] |= (code & 8) ? bit : 0;
+		}
+
+#define PACKET_LEAF_TEST(x)																\
+			if(childRays[x])															\
+			{																			\
+				if(tn->isLeaf(x))														\
+				{																		\
+					PxU32 leafRays = childRays[x];										\
+					while(leafRays)														\
+					{																	\
+						const PxU32 i = PxLowestSetBitUnsafe(leafRays);					\
+						leafRays &= leafRays - 1;										\
+						if(LeafTestT::doLeafTest(params + i, tn->getPrimitive(x)))		\
+							activeRays &= ~(1u<<i);										\
+					}																	\
+					if(!activeRays)														\
+						return;															\
+				}																		\
+				else																	\
+				{																		\
+					stack[nb] = tn->getChildData(x);									\
+					rayMasks[nb++] = childRays[x];										\
+				}																		\
+			}
+
+		const PxU32 nodeType = getChildType(childData);
+		if(nodeType>1)
+			PACKET_LEAF_TEST(3)
+
+		if(nodeType>0)
+			PACKET_LEAF_TEST(2)
+
+		PACKET_LEAF_TEST(1)
+
+		PACKET_LEAF_TEST(0)
+
+#undef PACKET_LEAF_TEST
+
+	}while(nb);
+}
+
+// PT: rays whose directions spread over more than ~25 degrees rarely share nodes, trace them one by one
+static PX_FORCE_INLINE bool isPacketCoherent(PxU32 nbRays, const PxVec3* PX_RESTRICT dirs)
+{
+	for(PxU32 i=1; i<nbRays; i++)
+	{
+		if(dirs[i].dot(dirs[0]) < 0.9f)
+			return false;
+	}
+	return true;
+}
+#endif
+
+PxU32 BV4_RaycastPacket(PxU32 nbRays, const PxVec3* PX_RESTRICT origins, const PxVec3* PX_RESTRICT dirs, const float* PX_RESTRICT maxDists, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxGeomRaycastHit* PX_RESTRICT hits, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags)
+{
+	PX_ASSERT(nbRays && nbRays<=GU_BV4_RAY_PACKET_SIZE);
+
+#ifdef GU_BV4_USE_SLABS
+	if(nbRays>1 && tree.mNodes && isPacketCoherent(nbRays, dirs))
+	{
+		const SourceMesh* PX_RESTRICT mesh = static_cast<SourceMesh*>(tree.mMeshInterface);
+
+		RayParams_Raycast Params[GU_BV4_RAY_PACKET_SIZE];
+		PacketRay Rays[GU_BV4_RAY_PACKET_SIZE];
+		for(PxU32 i=0; i<nbRays; i++)
+		{
+			setupRayParams(&Params[i], origins[i], dirs[i], &tree, worldm_Aligned, mesh, maxDists[i], geomEpsilon, flags);
+			setupPacketRay(Rays[i], Params[i]);
+		}
+
+		// PT: the dequantization coeffs only depend on the tree
+		const Vec4V minCoeffV = V4LoadA_Safe(&Params[0].mCenterOrMinCoeff_PaddedAligned.x);
+		const Vec4V maxCoeffV = V4LoadA_Safe(&Params[0].mExtentsOrMaxCoeff_PaddedAligned.x);
+		const Vec4V coeffs[6] = {	V4SplatElement<0>(minCoeffV), V4SplatElement<1>(minCoeffV), V4SplatElement<2>(minCoeffV),
+									V4SplatElement<0>(maxCoeffV), V4SplatElement<1>(maxCoeffV), V4SplatElement<2>(maxCoeffV) };
+
+		if(Params[0].mEarlyExit)
+		{
+			if(tree.mQuantized)
+				BV4_ProcessStreamKajiyaPacket<LeafFunction_RaycastAny, BVDataPackedQ, BVDataSwizzledQ>(reinterpret_cast<const BVDataPackedQ*>(tree.mNodes), tree.mInitData, Params, Rays, nbRays, coeffs);
+			else
+				BV4_ProcessStreamKajiyaPacket<LeafFunction_RaycastAny, BVDataPackedNQ, BVDataSwizzledNQ>(reinterpret_cast<const BVDataPackedNQ*>(tree.mNodes), tree.mInitData, Params, Rays, nbRays, coeffs);
+		}
+		else
+		{
+			if(tree.mQuantized)
+				BV4_ProcessStreamKajiyaPacket<LeafFunction_RaycastClosest, BVDataPackedQ, BVDataSwizzledQ>(reinterpret_cast<const BVDataPackedQ*>(tree.mNodes), tree.mInitData, Params, Rays, nbRays, coeffs);
+			else
+				BV4_ProcessStreamKajiyaPacket<LeafFunction_RaycastClosest, BVDataPackedNQ, BVDataSwizzledNQ>(reinterpret_cast<const BVDataPackedNQ*>(tree.mNodes), tree.mInitData, Params, Rays, nbRays, coeffs);
+		}
+
+		PxU32 hitMask = 0;
+		for(PxU32 i=0; i<nbRays; i++)
+		{
+			if(computeImpactData(hits + i, Params + i, worldm_Aligned, hitFlags))
+				hitMask |= 1u<<i;
+		}
+		return hitMask;
+	}
+#endif
+
+	PxU32 hitMask = 0;
+	for(PxU32 i=0; i<nbRays; i++)
+	{
+		if(BV4_RaycastSingle(origins[i], dirs[i], tree, worldm_Aligned, hits + i, maxDists[i], geomEpsilon, flags, hitFlags))
+			hitMask |= 1u<<i;
+	}
+	return hitMask;
+}
@@ -520,6 +520,9 @@ void BV4_PointDistance(const PxVec3& point, const BV4Tree& tree, float maxDist,
 
 	PointDistanceParams Params;
 	setupSphereParams(&Params, Sphere(point, maxDist), &tree, NULL/*worldm_Aligned*/, mesh);
+	// PT: stays invalid when no triangle is closer than maxDist
+	Params.mIndex = 0xffffffff;
+	Params.mClosestPt = point;
 
 	if(tree.mNodes)
 	{
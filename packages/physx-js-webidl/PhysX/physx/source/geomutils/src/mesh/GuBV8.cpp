@@ -0,0 +1,281 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "GuBV8.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMemory.h"
+
+using namespace physx;
+using namespace Gu;
+
+BV8Tree::BV8Tree() : mMeshInterface(NULL), mNodes(NULL), mNbNodes(0), mPrimitives(NULL), mNbPrimitives(0)
+{
+}
+
+BV8Tree::~BV8Tree()
+{
+	release();
+}
+
+void BV8Tree::release()
+{
+	PX_FREE(mNodes);
+	PX_FREE(mPrimitives);
+	mNbNodes = 0;
+	mNbPrimitives = 0;
+}
+
+namespace
+{
+struct BV8BuildParams
+{
+	const PxBounds3*	mPrimBounds;
+	const PxVec3*		mPrimCenters;
+	PxU32*				mPrimitives;
+	PxU32				mNbPrimsPerLeaf;
+	PxArray<BV8Node>	mNodes;
+};
+}
+
+static PxBounds3 computeBounds(const BV8BuildParams& params, PxU32 start, PxU32 nb)
+{
+	PxBounds3 bounds = PxBounds3::empty();
+	for(PxU32 i=0;i<nb;i++)
+		bounds.include(params.mPrimBounds[params.mPrimitives[start+i]]);
+	return bounds;
+}
+
+// PT: partial quicksort putting the k-th smallest center (along 'axis') at index k, smaller ones before and larger ones after it
+static void selectMedian(const PxVec3* PX_RESTRICT centers, PxU32* PX_RESTRICT prims, PxI32 nb, PxI32 k, PxU32 axis)
+{
+	PxI32 lo = 0;
+	PxI32 hi = nb - 1;
+	while(lo<hi)
+	{
+		const float pivot = centers[prims[(lo + hi)/2]][axis];
+		PxI32 i = lo;
+		PxI32 j = hi;
+		while(i<=j)
+		{
+			while(centers[prims[i]][axis]<pivot)
+				i++;
+			while(centers[prims[j]][axis]>pivot)
+				j--;
+			if(i<=j)
+				PxSwap(prims[i++], prims[j--]);
+		}
+		if(k<=j)
+			hi = j;
+		else if(k>=i)
+			lo = i;
+		else
+			break;
+	}
+}
+
+// PT: splits a range of primitives in two, at the center of the largest axis of their centers' bounds. Returns the number of
+// primitives in the first half. Falls back to a median split when the center split is too unbalanced, which bounds the tree
+// depth (and thus the traversal stack size) regardless of the triangle distribution.
+static PxU32 splitPrimitives(BV8BuildParams& params, PxU32 start, PxU32 nb)
+{
+	PxU32* PX_RESTRICT prims = params.mPrimitives + start;
+
+	PxBounds3 centerBounds = PxBounds3::empty();
+	for(PxU32 i=0;i<nb;i++)
+		centerBounds.include(params.mPrimCenters[prims[i]]);
+
+	const PxVec3 extents = centerBounds.getExtents();
+	const PxU32 axis = extents.x>=extents.y ? (extents.x>=extents.z ? 0u : 2u) : (extents.y>=extents.z ? 1u : 2u);
+	const float splitValue = centerBounds.getCenter(axis);
+
+	PxU32 nbLeft = 0;
+	for(PxU32 i=0;i<nb;i++)
+	{
+		if(params.mPrimCenters[prims[i]][axis]<splitValue)
+			PxSwap(prims[i], prims[nbLeft++]);
+	}
+
+	if(nbLeft<nb/4 || nbLeft>nb-nb/4)
+	{
+		nbLeft = nb/2;
+		selectMedian(params.mPrimCenters, prims, PxI32(nb), PxI32(nbLeft), axis);
+	}
+	return nbLeft;
+}
+
+// PT: builds one node by splitting the largest cluster of primitives until there are 8 of them (or all fit in leaves), then
+// recurses into the clusters that are still too large. Collapsing the binary splits this way keeps the tree shallow.
+static PxU32 buildNode(BV8BuildParams& params, PxU32 start, PxU32 nb)
+{
+	const PxU32 nodeIndex = params.mNodes.size();
+	params.mNodes.insert();
+
+	PxU32 clusterStart[GU_BV8_WIDTH];
+	PxU32 clusterSize[GU_BV8_WIDTH];
+	clusterStart[0] = start;
+	clusterSize[0] = nb;
+	PxU32 nbClusters = 1;
+	while(nbClusters<GU_BV8_WIDTH)
+	{
+		PxU32 largest = PX_INVALID_U32;
+		PxU32 largestSize = params.mNbPrimsPerLeaf;
+		for(PxU32 i=0;i<nbClusters;i++)
+		{
+			if(clusterSize[i]>largestSize)
+			{
+				largestSize = clusterSize[i];
+				largest = i;
+			}
+		}
+		if(largest==PX_INVALID_U32)
+			break;
+
+		const PxU32 nbLeft = splitPrimitives(params, clusterStart[largest], largestSize);
+		clusterStart[nbClusters] = clusterStart[largest] + nbLeft;
+		clusterSize[nbClusters] = largestSize - nbLeft;
+		clusterSize[largest] = nbLeft;
+		nbClusters++;
+	}
+
+	for(PxU32 i=0;i<nbClusters;i++)
+	{
+		const PxBounds3 bounds = computeBounds(params, clusterStart[i], clusterSize[i]);
+
+		PxU32 data;
+		if(clusterSize[i]<=params.mNbPrimsPerLeaf)
+			data = BV8Node::getLeafData(clusterStart[i], clusterSize[i]);
+		else
+			data = buildNode(params, clusterStart[i], clusterSize[i]);
+
+		// PT: fetch the node after the recursion, the array may have been resized
+		BV8Node& node = params.mNodes[nodeIndex];
+		node.setBounds(i, bounds);
+		node.mData[i] = data;
+	}
+
+	BV8Node& node = params.mNodes[nodeIndex];
+	node.mNbChildren = nbClusters;
+	for(PxU32 i=nbClusters;i<GU_BV8_WIDTH;i++)
+	{
+		node.setBounds(i, PxBounds3::empty());
+		node.mData[i] = PX_INVALID_U32;
+	}
+	return nodeIndex;
+}
+
+static PX_FORCE_INLINE PxBounds3 computeTriangleBounds(const SourceMesh* mesh, PxU32 index)
+{
+	VertexPointers vp;
+	mesh->getTriangle(vp, index);
+	PxBounds3 bounds = PxBounds3::boundsOfPoints(*vp.Vertex[0], *vp.Vertex[1]);
+	bounds.include(*vp.Vertex[2]);
+	return bounds;
+}
+
+bool BV8Tree::build(const SourceMesh* meshInterface, PxU32 nbPrimsPerLeaf, float epsilon)
+{
+	release();
+	mMeshInterface = meshInterface;
+
+	const PxU32 nbTris = meshInterface->getNbTriangles();
+	// PT: leaves encode their first primitive on 27 bits
+	if(!nbTris || nbTris>=(1u<<27))
+		return false;
+
+	PxBounds3* primBounds = PX_ALLOCATE(PxBounds3, nbTris, "BV8 primBounds");
+	PxVec3* primCenters = PX_ALLOCATE(PxVec3, nbTris, "BV8 primCenters");
+	mPrimitives = PX_ALLOCATE(PxU32, nbTris, "BV8 primitives");
+	mNbPrimitives = nbTris;
+	// PT: inflated boxes keep flat triangles & rays running along box faces robust, as for BV4 trees
+	const PxVec3 eps(epsilon);
+	for(PxU32 i=0;i<nbTris;i++)
+	{
+		primBounds[i] = computeTriangleBounds(meshInterface, i);
+		primBounds[i].minimum -= eps;
+		primBounds[i].maximum += eps;
+		primCenters[i] = primBounds[i].getCenter();
+		mPrimitives[i] = i;
+	}
+
+	BV8BuildParams params;
+	params.mPrimBounds		= primBounds;
+	params.mPrimCenters		= primCenters;
+	params.mPrimitives		= mPrimitives;
+	params.mNbPrimsPerLeaf	= PxClamp(nbPrimsPerLeaf, 1u, PxU32(GU_BV8_MAX_PRIMS_PER_LEAF));
+	params.mNodes.reserve(PxMax(1u, (nbTris/params.mNbPrimsPerLeaf)/(GU_BV8_WIDTH-1)));
+	buildNode(params, 0, nbTris);
+
+	PX_FREE(primCenters);
+	PX_FREE(primBounds);
+
+	mNbNodes = params.mNodes.size();
+	mNodes = PX_ALLOCATE(BV8Node, mNbNodes, "BV8 nodes");
+	PxMemCopy(mNodes, params.mNodes.begin(), sizeof(BV8Node)*mNbNodes);
+	return true;
+}
+
+bool BV8Tree::refit(PxBounds3& globalBounds, float epsilon)
+{
+	if(!mNodes)
+		return false;
+
+	const PxVec3 eps(epsilon);
+
+	// PT: children are always stored after their parent, so a reverse pass updates them before they're read
+	PxU32 i = mNbNodes;
+	while(i--)
+	{
+		BV8Node& node = mNodes[i];
+		for(PxU32 j=0;j<node.mNbChildren;j++)
+		{
+			const PxU32 data = node.mData[j];
+			PxBounds3 bounds = PxBounds3::empty();
+			if(BV8Node::isLeaf(data))
+			{
+				const PxU32 primStart = BV8Node::getPrimitiveStart(data);
+				const PxU32 nbPrims = BV8Node::getNbPrimitives(data);
+				for(PxU32 k=0;k<nbPrims;k++)
+					bounds.include(computeTriangleBounds(mMeshInterface, mPrimitives[primStart+k]));
+				bounds.minimum -= eps;
+				bounds.maximum += eps;
+			}
+			else
+			{
+				const BV8Node& child = mNodes[data];
+				for(PxU32 k=0;k<child.mNbChildren;k++)
+					bounds.include(child.getBounds(k));
+			}
+			node.setBounds(j, bounds);
+		}
+	}
+
+	globalBounds = PxBounds3::empty();
+	for(PxU32 j=0;j<mNodes[0].mNbChildren;j++)
+		globalBounds.include(mNodes[0].getBounds(j));
+	return true;
+}
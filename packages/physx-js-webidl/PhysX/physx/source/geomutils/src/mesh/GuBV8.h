@@ -0,0 +1,104 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_BV8_H
+#define GU_BV8_H
+
+#include "foundation/PxBounds3.h"
+#include "foundation/PxUserAllocated.h"
+#include "geometry/PxGeometryHit.h"
+#include "GuBV4_Common.h"
+
+namespace physx
+{
+namespace Gu
+{
+	#define GU_BV8_WIDTH				8
+	#define GU_BV8_MAX_PRIMS_PER_LEAF	15	// PT: the leaf primitive count is encoded on 4 bits, see BV8Node::getLeafData
+
+	// PT: 8-wide node for PxMeshMidPhase::eBVH38 trees. Bounds are stored as SoA so that all children of a node are tested against a
+	// query with two SSE (or paired WASM SIMD) batches, or a single AVX batch. Children are packed, i.e. only the first mNbChildren
+	// entries are valid.
+	struct BV8Node
+	{
+		float	mMinX[GU_BV8_WIDTH];
+		float	mMinY[GU_BV8_WIDTH];
+		float	mMinZ[GU_BV8_WIDTH];
+		float	mMaxX[GU_BV8_WIDTH];
+		float	mMaxY[GU_BV8_WIDTH];
+		float	mMaxZ[GU_BV8_WIDTH];
+		PxU32	mData[GU_BV8_WIDTH];	// PT: child node index, or leaf data when the top bit is set
+		PxU32	mNbChildren;
+		PxU32	mPad[3];
+
+		static	PX_FORCE_INLINE	PxU32	getLeafData(PxU32 start, PxU32 nb)	{ return 0x80000000 | (start<<4) | nb;	}
+		static	PX_FORCE_INLINE	bool	isLeaf(PxU32 data)					{ return (data & 0x80000000)!=0;		}
+		static	PX_FORCE_INLINE	PxU32	getPrimitiveStart(PxU32 data)		{ return (data & 0x7fffffff)>>4;		}
+		static	PX_FORCE_INLINE	PxU32	getNbPrimitives(PxU32 data)			{ return data & 15;						}
+
+		PX_FORCE_INLINE	void	setBounds(PxU32 i, const PxBounds3& bounds)
+		{
+			mMinX[i] = bounds.minimum.x;	mMinY[i] = bounds.minimum.y;	mMinZ[i] = bounds.minimum.z;
+			mMaxX[i] = bounds.maximum.x;	mMaxY[i] = bounds.maximum.y;	mMaxZ[i] = bounds.maximum.z;
+		}
+
+		PX_FORCE_INLINE	PxBounds3	getBounds(PxU32 i)	const
+		{
+			return PxBounds3(PxVec3(mMinX[i], mMinY[i], mMinZ[i]), PxVec3(mMaxX[i], mMaxY[i], mMaxZ[i]));
+		}
+	};
+	PX_COMPILE_TIME_ASSERT((sizeof(BV8Node)&15)==0);
+
+	// PT: 8-ary tree built on top of a BV4 mesh (see PxMeshMidPhase::eBVH38). It references the mesh's triangles through an
+	// indirection array, so the triangle order (and thus the BV4 tree) is left untouched.
+	class BV8Tree : public PxUserAllocated
+	{
+		public:
+								BV8Tree();
+								~BV8Tree();
+
+				bool			build(const SourceMesh* meshInterface, PxU32 nbPrimsPerLeaf, float epsilon);
+				bool			refit(PxBounds3& globalBounds, float epsilon);
+				void			release();
+
+		const	SourceMesh*		mMeshInterface;
+				BV8Node*		mNodes;
+				PxU32			mNbNodes;
+				PxU32*			mPrimitives;	// PT: triangle indices referenced by leaves
+				PxU32			mNbPrimitives;
+	};
+
+	// PT: queries, all in mesh-local space. The flags are the QUERY_MODIFIER_XXX flags from GuBV4_Common.h.
+	PxIntBool	BV8_RaycastSingle	(const PxVec3& origin, const PxVec3& dir, const BV8Tree& tree, PxGeomRaycastHit* PX_RESTRICT hit, float maxDist, float geomEpsilon, PxU32 flags);
+	void		BV8_RaycastCB		(const PxVec3& origin, const PxVec3& dir, const BV8Tree& tree, float maxDist, float geomEpsilon, PxU32 flags, MeshRayCallback callback, void* userData);
+	void		BV8_OverlapBoxCB	(const Box& box, const BV8Tree& tree, MeshOverlapCallback callback, void* userData);
+
+} // namespace Gu
+}
+
+#endif // GU_BV8_H
@@ -0,0 +1,339 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "GuBV8.h"
+#include "GuIntersectionRayTriangle.h"
+#include "GuIntersectionTriangleBox.h"
+#include "foundation/PxVecMath.h"
+#include "foundation/PxBitUtils.h"
+
+using namespace physx;
+using namespace Gu;
+using namespace aos;
+
+// This file contains the traversal code for the 8-wide (PxMeshMidPhase::eBVH38) trees.
+
+// PT: each visited node pushes at most 7 more entries than it pops. The builder keeps splits balanced enough for the tree depth to
+// stay well below 512/7 for any mesh a BV8Tree accepts.
+#define GU_BV8_STACK_SIZE	512
+
+namespace
+{
+struct BV8StackEntry
+{
+	PxU32	mData;	// PT: node index or leaf data
+	float	mDist;	// PT: entry distance along the ray, 0 for overlap queries
+};
+
+struct BV8RayParams
+{
+	Vec4V				mOrigX, mOrigY, mOrigZ;
+	Vec4V				mInvDirX, mInvDirY, mInvDirZ;
+	PxVec3				mOrigin;
+	PxVec3				mDir;
+	const PxVec3*		mVerts;
+	const IndTri32*		mTris32;
+	const IndTri16*		mTris16;
+	const PxU32*		mPrimitives;
+	float				mGeomEpsilon;
+	float				mMaxDist;		// PT: shrinks as closer hits are found, for closest-hit queries
+	bool				mBackfaceCulling;
+	bool				mEarlyExit;
+	// PT: closest hit so far
+	PxU32				mTriangleID;
+	float				mU, mV;
+	// PT: callback-based queries
+	MeshRayCallback		mCallback;
+	void*				mUserData;
+};
+}
+
+static PX_FORCE_INLINE float safeInverse(float x)
+{
+	// PT: large but finite values avoid 0*inf NaNs in the slab test for axis-aligned rays
+	if(PxAbs(x)<1e-20f)
+		return x<0.0f ? -1e20f : 1e20f;
+	return 1.0f/x;
+}
+
+static void setupRayParams(BV8RayParams& params, const PxVec3& origin, const PxVec3& dir, const BV8Tree& tree, float maxDist, float geomEpsilon, PxU32 flags)
+{
+	params.mOrigX			= V4Load(origin.x);
+	params.mOrigY			= V4Load(origin.y);
+	params.mOrigZ			= V4Load(origin.z);
+	params.mInvDirX			= V4Load(safeInverse(dir.x));
+	params.mInvDirY			= V4Load(safeInverse(dir.y));
+	params.mInvDirZ			= V4Load(safeInverse(dir.z));
+	params.mOrigin			= origin;
+	params.mDir				= dir;
+	params.mVerts			= tree.mMeshInterface->getVerts();
+	params.mTris32			= tree.mMeshInterface->getTris32();
+	params.mTris16			= tree.mMeshInterface->getTris16();
+	params.mPrimitives		= tree.mPrimitives;
+	params.mGeomEpsilon		= geomEpsilon;
+	params.mMaxDist			= maxDist;
+	params.mBackfaceCulling	= (flags & (QUERY_MODIFIER_DOUBLE_SIDED|QUERY_MODIFIER_MESH_BOTH_SIDES))==0;
+	params.mEarlyExit		= (flags & QUERY_MODIFIER_ANY_HIT)!=0;
+	params.mTriangleID		= PX_INVALID_U32;
+	params.mU				= 0.0f;
+	params.mV				= 0.0f;
+	params.mCallback		= NULL;
+	params.mUserData		= NULL;
+}
+
+// PT: slab test of a ray against the children of a node, 4 at a time. Returns the mask of touched children and writes their entry distances.
+static PX_FORCE_INLINE PxU32 rayVsNode(const BV8Node& node, const BV8RayParams& params, float* PX_RESTRICT entryDist)
+{
+	const Vec4V zero = V4Zero();
+	const Vec4V maxDist = V4Load(params.mMaxDist);
+
+	PxU32 mask = 0;
+	for(PxU32 i=0;i<GU_BV8_WIDTH;i+=4)
+	{
+		const Vec4V tx0 = V4Mul(V4Sub(V4LoadA(node.mMinX + i), params.mOrigX), params.mInvDirX);
+		const Vec4V tx1 = V4Mul(V4Sub(V4LoadA(node.mMaxX + i), params.mOrigX), params.mInvDirX);
+		const Vec4V ty0 = V4Mul(V4Sub(V4LoadA(node.mMinY + i), params.mOrigY), params.mInvDirY);
+		const Vec4V ty1 = V4Mul(V4Sub(V4LoadA(node.mMaxY + i), params.mOrigY), params.mInvDirY);
+		const Vec4V tz0 = V4Mul(V4Sub(V4LoadA(node.mMinZ + i), params.mOrigZ), params.mInvDirZ);
+		const Vec4V tz1 = V4Mul(V4Sub(V4LoadA(node.mMaxZ + i), params.mOrigZ), params.mInvDirZ);
+
+		const Vec4V tNear = V4Max(V4Max(V4Min(tx0, tx1), V4Min(ty0, ty1)), V4Max(V4Min(tz0, tz1), zero));
+		const Vec4V tFar = V4Min(V4Min(V4Max(tx0, tx1), V4Max(ty0, ty1)), V4Min(V4Max(tz0, tz1), maxDist));
+
+		mask |= BGetBitMask(V4IsGrtrOrEq(tFar, tNear))<<i;
+		V4StoreA(tNear, entryDist + i);
+	}
+	return mask & ((1u<<node.mNbChildren)-1);
+}
+
+// PT: returns true to stop the traversal
+static PX_FORCE_INLINE bool rayVsLeaf(BV8RayParams& params, PxU32 leafData)
+{
+	const PxU32* PX_RESTRICT prims = params.mPrimitives + BV8Node::getPrimitiveStart(leafData);
+	const PxU32 nbPrims = BV8Node::getNbPrimitives(leafData);
+	for(PxU32 i=0;i<nbPrims;i++)
+	{
+		const PxU32 triangleIndex = prims[i];
+
+		PxU32 VRef0, VRef1, VRef2;
+		getVertexReferences(VRef0, VRef1, VRef2, triangleIndex, params.mTris32, params.mTris16);
+		const PxVec3& p0 = params.mVerts[VRef0];
+		const PxVec3& p1 = params.mVerts[VRef1];
+		const PxVec3& p2 = params.mVerts[VRef2];
+
+		float t, u, v;
+		if(!intersectRayTriangle(params.mOrigin, params.mDir, p0, p1, p2, t, u, v, params.mBackfaceCulling, params.mGeomEpsilon))
+			continue;
+
+		// PT: intersection point is valid if distance is positive (else it can just be a face behind the orig point)
+		if(t<0.0f || t>params.mMaxDist)
+			continue;
+
+		if(params.mCallback)
+		{
+			// PT: like BV4_RaycastCB, no shrinking here
+			if((params.mCallback)(params.mUserData, p0, p1, p2, triangleIndex, t, u, v)==HIT_EXIT)
+				return true;
+		}
+		else
+		{
+			params.mMaxDist		= t;
+			params.mTriangleID	= triangleIndex;
+			params.mU			= u;
+			params.mV			= v;
+			if(params.mEarlyExit)
+				return true;
+		}
+	}
+	return false;
+}
+
+// PT: children are visited front-to-back when 'ordered' is true, which lets closest-hit queries skip subtrees beyond the current hit.
+static void traverseRay(const BV8Tree& tree, BV8RayParams& params, bool ordered)
+{
+	BV8StackEntry stack[GU_BV8_STACK_SIZE];
+	stack[0].mData = 0;
+	stack[0].mDist = 0.0f;
+	PxU32 nb = 1;
+
+	while(nb)
+	{
+		const BV8StackEntry entry = stack[--nb];
+		if(entry.mDist>params.mMaxDist)
+			continue;
+
+		if(BV8Node::isLeaf(entry.mData))
+		{
+			if(rayVsLeaf(params, entry.mData))
+				return;
+			continue;
+		}
+
+		const BV8Node& node = tree.mNodes[entry.mData];
+		PX_ALIGN_PREFIX(16)	float entryDist[GU_BV8_WIDTH] PX_ALIGN_SUFFIX(16);
+		PxU32 mask = rayVsNode(node, params, entryDist);
+
+		PxU32 children[GU_BV8_WIDTH];
+		PxU32 nbChildren = 0;
+		while(mask)
+		{
+			const PxU32 i = PxLowestSetBitUnsafe(mask);
+			mask &= mask - 1;
+
+			// PT: insertion sort by entry distance, closest first
+			PxU32 j = nbChildren++;
+			if(ordered)
+			{
+				while(j && entryDist[children[j-1]]>entryDist[i])
+				{
+					children[j] = children[j-1];
+					j--;
+				}
+			}
+			children[j] = i;
+		}
+
+		// PT: push in reverse order so that the closest child is popped first
+		PX_ASSERT(nb + nbChildren<=GU_BV8_STACK_SIZE);
+		while(nbChildren--)
+		{
+			const PxU32 i = children[nbChildren];
+			stack[nb].mData = node.mData[i];
+			stack[nb].mDist = entryDist[i];
+			nb++;
+		}
+	}
+}
+
+PxIntBool Gu::BV8_RaycastSingle(const PxVec3& origin, const PxVec3& dir, const BV8Tree& tree, PxGeomRaycastHit* PX_RESTRICT hit, float maxDist, float geomEpsilon, PxU32 flags)
+{
+	BV8RayParams params;
+	setupRayParams(params, origin, dir, tree, maxDist, geomEpsilon, flags);
+
+	traverseRay(tree, params, !params.mEarlyExit);
+
+	if(params.mTriangleID==PX_INVALID_U32)
+		return 0;
+
+	PxU32 VRef0, VRef1, VRef2;
+	getVertexReferences(VRef0, VRef1, VRef2, params.mTriangleID, params.mTris32, params.mTris16);
+	const PxVec3& p0 = params.mVerts[VRef0];
+	const PxVec3& p1 = params.mVerts[VRef1];
+	const PxVec3& p2 = params.mVerts[VRef2];
+
+	// PT: same outputs as BV4_RaycastSingle without a world matrix, i.e. local impact point & normalized local normal
+	hit->distance	= params.mMaxDist;
+	hit->u			= params.mU;
+	hit->v			= params.mV;
+	hit->faceIndex	= params.mTriangleID;
+	hit->position	= (1.0f - params.mU - params.mV)*p0 + params.mU*p1 + params.mV*p2;
+	hit->normal		= (p0 - p1).cross(p0 - p2).getNormalized();
+	return 1;
+}
+
+void Gu::BV8_RaycastCB(const PxVec3& origin, const PxVec3& dir, const BV8Tree& tree, float maxDist, float geomEpsilon, PxU32 flags, MeshRayCallback callback, void* userData)
+{
+	BV8RayParams params;
+	setupRayParams(params, origin, dir, tree, maxDist, geomEpsilon, flags);
+	params.mCallback = callback;
+	params.mUserData = userData;
+
+	traverseRay(tree, params, false);
+}
+
+void Gu::BV8_OverlapBoxCB(const Box& localBox, const BV8Tree& tree, MeshOverlapCallback callback, void* userData)
+{
+	const SourceMesh* PX_RESTRICT mesh = tree.mMeshInterface;
+	const PxVec3* PX_RESTRICT verts = mesh->getVerts();
+	const IndTri32* PX_RESTRICT tris32 = mesh->getTris32();
+	const IndTri16* PX_RESTRICT tris16 = mesh->getTris16();
+
+	BoxPadded box;
+	static_cast<Box&>(box) = localBox;
+
+	// PT: nodes are culled against the box's AABB, triangles against the box itself
+	const PxVec3 boxExtents = localBox.computeAABBExtent();
+	const PxVec3 boxMin = localBox.center - boxExtents;
+	const PxVec3 boxMax = localBox.center + boxExtents;
+	const Vec4V boxMinX = V4Load(boxMin.x);
+	const Vec4V boxMinY = V4Load(boxMin.y);
+	const Vec4V boxMinZ = V4Load(boxMin.z);
+	const Vec4V boxMaxX = V4Load(boxMax.x);
+	const Vec4V boxMaxY = V4Load(boxMax.y);
+	const Vec4V boxMaxZ = V4Load(boxMax.z);
+
+	PxU32 stack[GU_BV8_STACK_SIZE];
+	stack[0] = 0;
+	PxU32 nb = 1;
+
+	while(nb)
+	{
+		const BV8Node& node = tree.mNodes[stack[--nb]];
+
+		PxU32 mask = 0;
+		for(PxU32 i=0;i<GU_BV8_WIDTH;i+=4)
+		{
+			const BoolV overlapX = BAnd(V4IsGrtrOrEq(boxMaxX, V4LoadA(node.mMinX + i)), V4IsGrtrOrEq(V4LoadA(node.mMaxX + i), boxMinX));
+			const BoolV overlapY = BAnd(V4IsGrtrOrEq(boxMaxY, V4LoadA(node.mMinY + i)), V4IsGrtrOrEq(V4LoadA(node.mMaxY + i), boxMinY));
+			const BoolV overlapZ = BAnd(V4IsGrtrOrEq(boxMaxZ, V4LoadA(node.mMinZ + i)), V4IsGrtrOrEq(V4LoadA(node.mMaxZ + i), boxMinZ));
+			mask |= BGetBitMask(BAnd(BAnd(overlapX, overlapY), overlapZ))<<i;
+		}
+		mask &= (1u<<node.mNbChildren)-1;
+
+		while(mask)
+		{
+			const PxU32 i = PxLowestSetBitUnsafe(mask);
+			mask &= mask - 1;
+
+			const PxU32 data = node.mData[i];
+			if(!BV8Node::isLeaf(data))
+			{
+				PX_ASSERT(nb<GU_BV8_STACK_SIZE);
+				stack[nb++] = data;
+				continue;
+			}
+
+			const PxU32* PX_RESTRICT prims = tree.mPrimitives + BV8Node::getPrimitiveStart(data);
+			const PxU32 nbPrims = BV8Node::getNbPrimitives(data);
+			for(PxU32 j=0;j<nbPrims;j++)
+			{
+				const PxU32 triangleIndex = prims[j];
+
+				PxU32 VRef0, VRef1, VRef2;
+				getVertexReferences(VRef0, VRef1, VRef2, triangleIndex, tris32, tris16);
+
+				if(intersectTriangleBox(box, verts[VRef0], verts[VRef1], verts[VRef2]))
+				{
+					const PxU32 vrefs[3] = { VRef0, VRef1, VRef2 };
+					if((callback)(userData, verts[VRef0], verts[VRef1], verts[VRef2], triangleIndex, vrefs))
+						return;
+				}
+			}
+		}
+	}
+}
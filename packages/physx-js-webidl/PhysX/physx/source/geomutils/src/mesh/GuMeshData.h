@@ -62,8 +62,9 @@ namespace Gu {
 // 14: added midphase ID
 // 15: GPU data simplification
 // 16: vertex2Face mapping enabled by default if using GPU
+// 17: optional quantized vertices and compressed indices
 
-#define PX_MESH_VERSION 16
+#define PX_MESH_VERSION 17
 #define PX_TET_MESH_VERSION 1
 #define PX_DEFORMABLE_VOLUME_MESH_VERSION 3 // 3: parallel GS + new linear corotated model.
 
@@ -79,9 +80,17 @@ enum InternalMeshSerialFlag
 	IMSF_SDF			=	(1<<6),	//!< if set, the cooked mesh file contains SDF data structures
 	IMSF_VERT_MAPPING	=   (1<<7), //!< if set, the cooked mesh file contains vertex mapping information
 	IMSF_GRB_INV_REMAP	=	(1<<8),	//!< if set, the cooked mesh file contains vertex inv mapping information. Required for deformable surfaces
-	IMSF_INERTIA		=	(1<<9)	//!< if set, the cooked mesh file contains inertia tensor for the mesh
+	IMSF_INERTIA		=	(1<<9),	//!< if set, the cooked mesh file contains inertia tensor for the mesh
+	IMSF_QUANTIZED_VERTICES	=	(1<<10),	//!< if set, the cooked mesh file contains 16-bit quantized vertices
+	IMSF_COMPRESSED_INDICES	=	(1<<11)		//!< if set, the cooked mesh file contains delta-encoded variable-length indices
 };
 
+	// PT: used by both cooking and loading, so that quantized vertices decode to exactly the positions used to build the midphase
+	PX_FORCE_INLINE PxVec3 dequantizeMeshVertex(const PxU16* q, const PxVec3& minimum, const PxVec3& scale)
+	{
+		return PxVec3(minimum.x + PxReal(q[0])*scale.x, minimum.y + PxReal(q[1])*scale.y, minimum.z + PxReal(q[2])*scale.z);
+	}
+
 #if PX_VC
 #pragma warning(push)
 #pragma warning(disable: 4324)	// Padding was added at the end of a structure because of a __declspec(align) value.
@@ -39,6 +39,7 @@
 #include "CmScaling.h"
 #include "GuSweepTests.h"
 #include "GuMidphaseInterface.h"
+#include "GuBV4Settings.h"
 #include "foundation/PxFPU.h"
 
 using namespace physx;
@@ -270,6 +271,44 @@ PxU32 physx::PxMeshQuery::findOverlapHeightField(	const PxGeometry& geom, const
 
 ///////////////////////////////////////////////////////////////////////////////
 
+PxU32 physx::PxMeshQuery::raycastPacket(	const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
+											PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxReal* maxDists,
+											PxGeomRaycastHit* hits, PxHitFlags hitFlags, PxGeometryQueryFlags queryFlags)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	PX_CHECK_AND_RETURN_VAL(pose.isValid(), "PxMeshQuery::raycastPacket(): pose is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(!nbRays || (origins && unitDirs && maxDists && hits), "PxMeshQuery::raycastPacket(): buffers cannot be NULL.", 0);
+
+	const TriangleMesh* tm = static_cast<const TriangleMesh*>(meshGeom.triangleMesh);
+
+	PxU32 nbHits = 0;
+	for(PxU32 offset=0; offset<nbRays; offset+=GU_BV4_RAY_PACKET_SIZE)
+	{
+		const PxU32 nbInPacket = PxMin(nbRays - offset, PxU32(GU_BV4_RAY_PACKET_SIZE));
+
+		const PxU32 hitMask = Midphase::raycastTriangleMeshPacket(tm, meshGeom, pose, nbInPacket, origins + offset, unitDirs + offset, maxDists + offset, hitFlags, hits + offset);
+
+		for(PxU32 i=0; i<nbInPacket; i++)
+		{
+			if(hitMask & (1u<<i))
+			{
+				nbHits++;
+			}
+			else
+			{
+				PxGeomRaycastHit& hit = hits[offset + i];
+				hit.distance = -1.0f;
+				hit.faceIndex = 0xffffffff;
+				hit.flags = PxHitFlags(0);
+			}
+		}
+	}
+	return nbHits;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool physx::PxMeshQuery::sweep(	const PxVec3& unitDir, const PxReal maxDistance,
 								const PxGeometry& geom, const PxTransform& pose,
 								PxU32 triangleCount, const PxTriangle* triangles,
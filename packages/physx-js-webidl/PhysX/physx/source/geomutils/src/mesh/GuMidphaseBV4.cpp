@@ -33,6 +33,7 @@ using namespace physx;
 using namespace Gu;
 
 #include "foundation/PxVecMath.h"
+#include "foundation/PxBitUtils.h"
 using namespace aos;
 
 #include "GuSweepMesh.h"
@@ -47,6 +48,7 @@ using namespace aos;
 #include "GuIntersectionCapsuleTriangle.h"
 #include "GuIntersectionRayBox.h"
 #include "GuTriangleMeshBV4.h"
+#include "GuBV8.h"
 #include "CmScaling.h"
 #include "CmMatrix34.h"
 
@@ -58,6 +60,7 @@ using namespace Cm;
 
 PxIntBool	BV4_RaycastSingle		(const PxVec3& origin, const PxVec3& dir, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxGeomRaycastHit* PX_RESTRICT hit, float maxDist, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags);
 PxU32		BV4_RaycastAll			(const PxVec3& origin, const PxVec3& dir, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxGeomRaycastHit* PX_RESTRICT hits, PxU32 maxNbHits, float maxDist, PxU32 stride, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags);
+PxU32		BV4_RaycastPacket		(PxU32 nbRays, const PxVec3* PX_RESTRICT origins, const PxVec3* PX_RESTRICT dirs, const float* PX_RESTRICT maxDists, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, PxGeomRaycastHit* PX_RESTRICT hits, float geomEpsilon, PxU32 flags, PxHitFlags hitFlags);
 void		BV4_RaycastCB			(const PxVec3& origin, const PxVec3& dir, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned, float maxDist, float geomEpsilon, PxU32 flags, MeshRayCallback callback, void* userData);
 
 PxIntBool	BV4_OverlapSphereAny	(const Sphere& sphere, const BV4Tree& tree, const PxMat44* PX_RESTRICT worldm_Aligned);
@@ -375,7 +378,9 @@ PxU32 physx::Gu::raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTri
 	const bool bothSides = isDoubleSided || (hitFlags & PxHitFlag::eMESH_BOTH_SIDES);
 
 	const BV4Tree& tree = static_cast<const BV4TriangleMesh*>(meshData)->getBV4Tree();
-	if(idtScale && !multipleHits)
+	// PT: eBVH38 meshes raycast against their wide tree, in local space
+	const BV8Tree* wideTree = meshData->getWideTree();
+	if(idtScale && !multipleHits && !wideTree)
 	{
 		bool b = raycastVsMesh(*hits, tree, &pose.p.x, &pose.q.x, rayOrigin, rayDir, maxDist, meshData->getGeomEpsilon(), bothSides, hitFlags);
 		if(b)
@@ -441,7 +446,11 @@ PxU32 physx::Gu::raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTri
 
 	if(!multipleHits)
 	{
-		bool b = raycastVsMesh(*hits, tree, NULL, NULL, orig, dir, maxDist, meshData->getGeomEpsilon(), bothSides, hitFlags);
+		bool b;
+		if(wideTree)
+			b = BV8_RaycastSingle(orig, dir, *wideTree, hits, maxDist, meshData->getGeomEpsilon(), setupFlags(hitFlags & PxHitFlag::eANY_HIT, bothSides, false))!=0;
+		else
+			b = raycastVsMesh(*hits, tree, NULL, NULL, orig, dir, maxDist, meshData->getGeomEpsilon(), bothSides, hitFlags);
 		if(b)
 		{
 			hits->distance	*= distCoeff;
@@ -469,13 +478,74 @@ PxU32 physx::Gu::raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTri
 
 	BV4RaycastCBParams callback(hits, maxHits, stride, &meshGeom.scale, &pose, world2vertexSkewP, hitFlags, rayDir, isDoubleSided, distCoeff);
 
-	raycastVsMeshCB(	tree,
-						orig, dir,
-						maxDist, meshData->getGeomEpsilon(), bothSides,
-						gRayCallback, &callback);
+	if(wideTree)
+		BV8_RaycastCB(orig, dir, *wideTree, maxDist, meshData->getGeomEpsilon(), setupFlags(false, bothSides, false), gRayCallback, &callback);
+	else
+		raycastVsMeshCB(	tree,
+							orig, dir,
+							maxDist, meshData->getGeomEpsilon(), bothSides,
+							gRayCallback, &callback);
 	return callback.mHitNum;
 }
 
+PxU32 physx::Gu::raycastPacket_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
+												PxU32 nbRays, const PxVec3* PX_RESTRICT rayOrigins, const PxVec3* PX_RESTRICT rayDirs, const PxReal* PX_RESTRICT maxDists,
+												PxHitFlags hitFlags, PxGeomRaycastHit* PX_RESTRICT hits)
+{
+	PX_ASSERT(mesh->getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34);
+	PX_ASSERT(nbRays && nbRays<=GU_BV4_RAY_PACKET_SIZE);
+	const BV4TriangleMesh* meshData = static_cast<const BV4TriangleMesh*>(mesh);
+
+	hitFlags &= ~PxHitFlag::eMESH_MULTIPLE;
+
+	// PT: scaled meshes need a per-ray transform to vertex space, use the regular code path for them
+	if(!meshGeom.scale.isIdentity())
+	{
+		PxU32 hitMask = 0;
+		for(PxU32 i=0; i<nbRays; i++)
+		{
+			if(raycast_triangleMesh_BV4(mesh, meshGeom, pose, rayOrigins[i], rayDirs[i], maxDists[i], hitFlags, 1, hits + i, sizeof(PxGeomRaycastHit)))
+				hitMask |= 1u<<i;
+		}
+		return hitMask;
+	}
+
+	const bool isDoubleSided = meshGeom.meshFlags.isSet(PxMeshGeometryFlag::eDOUBLE_SIDED);
+	const bool bothSides = isDoubleSided || (hitFlags & PxHitFlag::eMESH_BOTH_SIDES);
+
+	BV4_ALIGN16(PxMat44 World);
+	const PxMat44* TM = setupWorldMatrix(World, &pose.p.x, &pose.q.x);
+
+	const bool anyHit = hitFlags & PxHitFlag::eANY_HIT;
+	const PxU32 flags = setupFlags(anyHit, bothSides, false);
+
+	const BV4Tree& tree = meshData->getBV4Tree();
+	const PxU32 hitMask = BV4_RaycastPacket(nbRays, rayOrigins, rayDirs, maxDists, tree, TM, hits, meshData->getGeomEpsilon(), flags, hitFlags);
+
+	PxU32 m = hitMask;
+	while(m)
+	{
+		const PxU32 i = PxLowestSetBitUnsafe(m);
+		m &= m - 1;
+
+		PxGeomRaycastHit& hit = hits[i];
+		PxHitFlags dstFlags = PxHitFlag::ePOSITION|PxHitFlag::eUV|PxHitFlag::eFACE_INDEX;
+		if(hitFlags & PxHitFlag::eNORMAL)
+		{
+			dstFlags |= PxHitFlag::eNORMAL;
+			// PT: same normal orientation rule as raycast_triangleMesh_BV4 (DE7458)
+			if(isDoubleSided && hit.normal.dot(rayDirs[i]) > 0.0f)
+				hit.normal = -hit.normal;
+		}
+		else
+		{
+			hit.normal = PxVec3(0.0f);
+		}
+		hit.flags = dstFlags;
+	}
+	return hitMask;
+}
+
 namespace
 {
 struct IntersectShapeVsMeshCallback
@@ -619,8 +689,10 @@ bool physx::Gu::intersectSphereVsMesh_BV4(const Sphere& sphere, const TriangleMe
 {
 	PX_ASSERT(triMesh.getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34);
 	const BV4Tree& tree = static_cast<const BV4TriangleMesh&>(triMesh).getBV4Tree();
+	const BV8Tree* wideTree = static_cast<const BV4TriangleMesh&>(triMesh).getWideTree();
 
-	if(meshScale.isIdentity())
+	// PT: eBVH38 meshes always go through the callback-based path, against their wide tree
+	if(meshScale.isIdentity() && !wideTree)
 	{
 		BV4_ALIGN16(PxMat44 World);
 		const PxMat44* TM = setupWorldMatrix(World, &meshTransform.p.x, &meshTransform.q.x);
@@ -644,7 +716,10 @@ bool physx::Gu::intersectSphereVsMesh_BV4(const Sphere& sphere, const TriangleMe
 		Box vertexOBB;
 		computeVertexSpaceOBB(vertexOBB, worldOBB_, meshTransform, meshScale);
 
-		BV4_OverlapBoxCB(vertexOBB, tree, gSphereVsMeshCallback, &callback);
+		if(wideTree)
+			BV8_OverlapBoxCB(vertexOBB, *wideTree, gSphereVsMeshCallback, &callback);
+		else
+			BV4_OverlapBoxCB(vertexOBB, tree, gSphereVsMeshCallback, &callback);
 		return callback.mAnyHits;
 	}
 }
@@ -653,8 +728,10 @@ bool physx::Gu::intersectBoxVsMesh_BV4(const Box& box, const TriangleMesh& triMe
 {
 	PX_ASSERT(triMesh.getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34);
 	const BV4Tree& tree = static_cast<const BV4TriangleMesh&>(triMesh).getBV4Tree();
+	const BV8Tree* wideTree = static_cast<const BV4TriangleMesh&>(triMesh).getWideTree();
 
-	if(meshScale.isIdentity())
+	// PT: eBVH38 meshes always go through the callback-based path, against their wide tree
+	if(meshScale.isIdentity() && !wideTree)
 	{
 		BV4_ALIGN16(PxMat44 World);
 		const PxMat44* TM = setupWorldMatrix(World, &meshTransform.p.x, &meshTransform.q.x);
@@ -677,7 +754,10 @@ bool physx::Gu::intersectBoxVsMesh_BV4(const Box& box, const TriangleMesh& triMe
 		Box vertexOBB; // query box in vertex space
 		computeVertexSpaceOBB(vertexOBB, box, meshTransform, meshScale);
 
-		BV4_OverlapBoxCB(vertexOBB, tree, gBoxVsMeshCallback, &callback);
+		if(wideTree)
+			BV8_OverlapBoxCB(vertexOBB, *wideTree, gBoxVsMeshCallback, &callback);
+		else
+			BV4_OverlapBoxCB(vertexOBB, tree, gBoxVsMeshCallback, &callback);
 		return callback.mAnyHits;
 	}
 }
@@ -686,8 +766,10 @@ bool physx::Gu::intersectCapsuleVsMesh_BV4(const Capsule& capsule, const Triangl
 {
 	PX_ASSERT(triMesh.getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34);
 	const BV4Tree& tree = static_cast<const BV4TriangleMesh&>(triMesh).getBV4Tree();
+	const BV8Tree* wideTree = static_cast<const BV4TriangleMesh&>(triMesh).getWideTree();
 
-	if(meshScale.isIdentity())
+	// PT: eBVH38 meshes always go through the callback-based path, against their wide tree
+	if(meshScale.isIdentity() && !wideTree)
 	{
 		BV4_ALIGN16(PxMat44 World);
 		const PxMat44* TM = setupWorldMatrix(World, &meshTransform.p.x, &meshTransform.q.x);
@@ -713,7 +795,10 @@ bool physx::Gu::intersectCapsuleVsMesh_BV4(const Capsule& capsule, const Triangl
 		worldOBB_.create(capsule); // AP: potential optimization (meshTransform.inverse is already in callback.mCapsule)
 		computeVertexSpaceOBB(vertexOBB, worldOBB_, meshTransform, meshScale);
 
-		BV4_OverlapBoxCB(vertexOBB, tree, gCapsuleVsMeshCallback, &callback);
+		if(wideTree)
+			BV8_OverlapBoxCB(vertexOBB, *wideTree, gCapsuleVsMeshCallback, &callback);
+		else
+			BV4_OverlapBoxCB(vertexOBB, tree, gCapsuleVsMeshCallback, &callback);
 		return callback.mAnyHits;
 	}
 }
@@ -743,7 +828,11 @@ void physx::Gu::intersectOBB_BV4(const TriangleMesh* mesh, const Box& obb, MeshH
 {
 	PX_UNUSED(checkObbIsAligned);
 	PX_UNUSED(bothTriangleSidesCollide);
-	BV4_OverlapBoxCB(obb, static_cast<const BV4TriangleMesh*>(mesh)->getBV4Tree(), gVolumeCallback, &callback);
+	const BV4TriangleMesh* meshData = static_cast<const BV4TriangleMesh*>(mesh);
+	if(meshData->getWideTree())
+		BV8_OverlapBoxCB(obb, *meshData->getWideTree(), gVolumeCallback, &callback);
+	else
+		BV4_OverlapBoxCB(obb, meshData->getBV4Tree(), gVolumeCallback, &callback);
 }
 
 void physx::Gu::intersectOBB_BV4(const TetrahedronMesh* mesh, const Box& obb, TetMeshHitCallback<PxGeomRaycastHit>& callback)
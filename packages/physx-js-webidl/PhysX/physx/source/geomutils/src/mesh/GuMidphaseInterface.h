@@ -154,6 +154,9 @@ namespace Gu
 	PX_PHYSX_COMMON_API PxU32 raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
 									const PxVec3& rayOrigin, const PxVec3& rayDir, PxReal maxDist,
 									PxHitFlags hitFlags, PxU32 maxHits, PxGeomRaycastHit* PX_RESTRICT hits, PxU32 stride);
+	PX_PHYSX_COMMON_API PxU32 raycastPacket_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
+									PxU32 nbRays, const PxVec3* PX_RESTRICT rayOrigins, const PxVec3* PX_RESTRICT rayDirs, const PxReal* PX_RESTRICT maxDists,
+									PxHitFlags hitFlags, PxGeomRaycastHit* PX_RESTRICT hits);
 	PX_PHYSX_COMMON_API bool intersectSphereVsMesh_BV4	(const Sphere& sphere,		const TriangleMesh& triMesh, const PxTransform& meshTransform, const PxMeshScale& meshScale, LimitedResults* results);
 	PX_PHYSX_COMMON_API bool intersectBoxVsMesh_BV4		(const Box& box,			const TriangleMesh& triMesh, const PxTransform& meshTransform, const PxMeshScale& meshScale, LimitedResults* results);
 	PX_PHYSX_COMMON_API bool intersectCapsuleVsMesh_BV4	(const Capsule& capsule,	const TriangleMesh& triMesh, const PxTransform& meshTransform, const PxMeshScale& meshScale, LimitedResults* results);
@@ -194,6 +197,8 @@ namespace Gu
 	typedef void (*MidphaseConvexSweepFunction)(	const TriangleMesh* mesh, const Gu::Box& hullBox, const PxVec3& localDir, PxReal distance, SweepConvexMeshHitCallback& callback, bool anyHit);
 	typedef void (*MidphasePointMeshFunction)(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, const PxVec3& point, float maxDist, PxU32& index, float& dist, PxVec3& closestPt);
 
+	// PT: these tables are indexed by concrete type. PxMeshMidPhase::eBVH38 meshes are eTRIANGLE_MESH_BVH34 meshes with an extra
+	// wide tree (see BV4TriangleMesh::getWideTree), the BV4 entry points dispatch to it.
 	static const MidphaseRaycastFunction	gMidphaseRaycastTable[PxMeshMidPhase::eLAST] =
 	{
 		raycast_triangleMesh_RTREE,
@@ -269,6 +274,34 @@ namespace Midphase
 		return gMidphaseRaycastTable[index](mesh, meshGeom, meshTransform, rayOrigin, rayDir, maxDist, hitFlags, maxHits, hits, stride);
 	}
 
+	// \param[in]	mesh			triangle mesh to raycast against
+	// \param[in]	meshGeom		geometry object associated with the mesh
+	// \param[in]	meshTransform	pose/transform of geometry object
+	// \param[in]	nbRays			number of rays in the packet, at most GU_BV4_RAY_PACKET_SIZE
+	// \param[in]	rayOrigins		rays' origins
+	// \param[in]	rayDirs			rays' unit dirs
+	// \param[in]	maxDists		rays' lengths/max distances
+	// \param[in]	hitFlags		query behavior flags. eMESH_MULTIPLE is ignored.
+	// \param[out]	hits			result buffer with one entry per ray
+	// \return		bitmask of the rays that hit the mesh
+	// \note		BV4 meshes traverse the tree once for the whole packet, other midphases trace rays one by one.
+	PX_FORCE_INLINE PxU32 raycastTriangleMeshPacket(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshTransform,
+														PxU32 nbRays, const PxVec3* PX_RESTRICT rayOrigins, const PxVec3* PX_RESTRICT rayDirs, const PxReal* PX_RESTRICT maxDists,
+														PxHitFlags hitFlags, PxGeomRaycastHit* PX_RESTRICT hits)
+	{
+		if(mesh->getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34)
+			return raycastPacket_triangleMesh_BV4(mesh, meshGeom, meshTransform, nbRays, rayOrigins, rayDirs, maxDists, hitFlags, hits);
+
+		hitFlags &= ~PxHitFlag::eMESH_MULTIPLE;
+		PxU32 hitMask = 0;
+		for(PxU32 i=0; i<nbRays; i++)
+		{
+			if(raycast_triangleMesh_RTREE(mesh, meshGeom, meshTransform, rayOrigins[i], rayDirs[i], maxDists[i], hitFlags, 1, hits + i, sizeof(PxGeomRaycastHit)))
+				hitMask |= 1u<<i;
+		}
+		return hitMask;
+	}
+
 	// \param[in]	sphere			sphere
 	// \param[in]	mesh			triangle mesh
 	// \param[in]	meshTransform	pose/transform of triangle mesh
@@ -106,6 +106,8 @@ public:
 
 	virtual						PxVec3*					getVerticesForModification();
 	virtual						PxBounds3				refitBVH();
+	virtual						PxBounds3				refitBVHForTriangles(const PxU32*, PxU32)	{ return refitBVH();	}
+	virtual						PxReal					getBVHRefitCostRatio()		const	{ return 1.0f;							}
 	virtual						PxU32					getNbTriangles()			const	{ return mNbTriangles;					}
 	virtual						const void*				getTriangles()				const	{ return mTriangles;					}
 	virtual						PxTriangleMeshFlags		getTriangleMeshFlags()		const	{ return PxTriangleMeshFlags(mFlags);	}
@@ -28,7 +28,9 @@
 
 #include "GuTriangleMesh.h"
 #include "GuTriangleMeshBV4.h"
+#include "GuBV8.h"
 #include "geometry/PxGeometryInternal.h"
+#include "foundation/PxIO.h"
 
 using namespace physx;
 using namespace Gu;
@@ -38,7 +40,7 @@ namespace physx
 
 // PT: temporary for Kit
 
-BV4TriangleMesh::BV4TriangleMesh(const PxTriangleMeshInternalData& data) : TriangleMesh(data)
+BV4TriangleMesh::BV4TriangleMesh(const PxTriangleMeshInternalData& data) : TriangleMesh(data), mCookedBVHCost(0.0f), mWideTree(NULL)
 {
 	mMeshInterface.setNbTriangles(getNbTrianglesFast());
 	if(has16BitIndices())
@@ -95,14 +97,225 @@ bool PxGetTriangleMeshInternalData(PxTriangleMeshInternalData& data, const PxTri
 
 //~ PT: temporary for Kit
 
-BV4TriangleMesh::BV4TriangleMesh(MeshFactory* factory, TriangleMeshData& d) : TriangleMesh(factory, d)
+// PT: in-place format. A header followed by the mesh arrays, each starting on a 16-byte boundary. Offsets are relative
+// to the start of the header and 0 means the array is absent. Loading only patches pointers, the arrays are used as-is.
+#define PX_INPLACE_MESH_MAGIC	0x4d425850	// 'PXBM'
+#define PX_INPLACE_MESH_VERSION	1
+
+namespace
+{
+	struct InPlaceMeshHeader
+	{
+		PxU32	mMagic;
+		PxU32	mVersion;
+		PxU32	mTotalSize;
+		PxU32	mFlags;
+		PxU32	mNbVertices;
+		PxU32	mNbTriangles;
+		PxU32	mNbNodes;
+		PxU32	mInitData;
+		PxVec3	mAABBCenter;
+		PxReal	mGeomEpsilon;
+		PxVec3	mAABBExtents;
+		PxU32	mQuantized;
+		PxVec3	mCenterOrMinCoeff;
+		PxReal	mMass;
+		PxVec3	mExtentsOrMaxCoeff;
+		PxU32	mPad0;
+		PxMat33	mInertia;
+		PxVec3	mLocalCenterOfMass;
+		PxU32	mVerticesOffset;
+		PxU32	mTrianglesOffset;
+		PxU32	mNodesOffset;
+		PxU32	mFaceRemapOffset;
+		PxU32	mExtraTrigDataOffset;
+		PxU32	mMaterialIndicesOffset;
+		PxU32	mAdjacenciesOffset;
+		PxU32	mPad1;
+	};
+	PX_COMPILE_TIME_ASSERT(!(sizeof(InPlaceMeshHeader)&15));
+
+	PX_FORCE_INLINE PxU32 alignInPlace(PxU32 size)
+	{
+		return (size + 15) & ~15;
+	}
+
+	PX_FORCE_INLINE PxU32 reserveInPlace(PxU32& offset, PxU32 size, bool present)
+	{
+		if(!present)
+			return 0;
+		const PxU32 start = offset;
+		offset = alignInPlace(offset + size);
+		return start;
+	}
+
+	void writeInPlace(PxOutputStream& stream, PxU32& written, PxU32 offset, const void* src, PxU32 size)
+	{
+		if(!offset)
+			return;
+		static const PxU8 zeros[16] = {0};
+		PX_ASSERT(offset>=written && offset-written<16);
+		stream.write(zeros, offset - written);
+		stream.write(src, size);
+		written = offset + size;
+	}
+
+	PX_FORCE_INLINE bool validInPlaceArray(const InPlaceMeshHeader& header, PxU32 offset, PxU64 size)
+	{
+		return !offset || (!(offset&15) && offset>=sizeof(InPlaceMeshHeader) && PxU64(offset) + size <= header.mTotalSize);
+	}
+}
+
+bool BV4TriangleMesh::saveInPlace(PxOutputStream& stream) const
+{
+	if(mSdfData.mSdf || mGRB_triIndices)
+		PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "PxSaveTriangleMeshInPlace: SDF and GPU data are not supported by the in-place format and will be dropped.");
+
+	const PxU32 nbTris = mNbTriangles;
+	const PxU32 indexSize = has16BitIndices() ? sizeof(PxU16) : sizeof(PxU32);
+	const PxU32 nodeSize = mBV4Tree.mQuantized ? sizeof(BVDataPackedQ) : sizeof(BVDataPackedNQ);
+
+	// PT: the extra 4 bytes after the vertices make V4Loads on the last vertex safe, as for cooked meshes
+	PxU32 offset = sizeof(InPlaceMeshHeader);
+	const PxU32 verticesOffset		= reserveInPlace(offset, mNbVertices*sizeof(PxVec3) + sizeof(PxU32), true);
+	const PxU32 trianglesOffset		= reserveInPlace(offset, nbTris*3*indexSize, true);
+	const PxU32 nodesOffset			= reserveInPlace(offset, mBV4Tree.mNbNodes*nodeSize, mBV4Tree.mNbNodes!=0);
+	const PxU32 faceRemapOffset		= reserveInPlace(offset, nbTris*sizeof(PxU32), mFaceRemap!=NULL);
+	const PxU32 extraTrigDataOffset	= reserveInPlace(offset, nbTris*sizeof(PxU8), mExtraTrigData!=NULL);
+	const PxU32 materialsOffset		= reserveInPlace(offset, nbTris*sizeof(PxU16), mMaterialIndices!=NULL);
+	const PxU32 adjacenciesOffset	= reserveInPlace(offset, nbTris*3*sizeof(PxU32), mAdjacencies!=NULL);
+
+	InPlaceMeshHeader header;
+	PxMemZero(&header, sizeof(InPlaceMeshHeader));
+	header.mMagic					= PX_INPLACE_MESH_MAGIC;
+	header.mVersion					= PX_INPLACE_MESH_VERSION;
+	header.mTotalSize				= offset;
+	header.mFlags					= mFlags;
+	header.mNbVertices				= mNbVertices;
+	header.mNbTriangles				= nbTris;
+	header.mNbNodes					= mBV4Tree.mNbNodes;
+	header.mInitData				= mBV4Tree.mInitData;
+	header.mAABBCenter				= mAABB.mCenter;
+	header.mGeomEpsilon				= mGeomEpsilon;
+	header.mAABBExtents				= mAABB.mExtents;
+	header.mQuantized				= PxU32(mBV4Tree.mQuantized);
+	header.mCenterOrMinCoeff		= mBV4Tree.mCenterOrMinCoeff;
+	header.mMass					= mMass;
+	header.mExtentsOrMaxCoeff		= mBV4Tree.mExtentsOrMaxCoeff;
+	header.mInertia					= mInertia;
+	header.mLocalCenterOfMass		= mLocalCenterOfMass;
+	header.mVerticesOffset			= verticesOffset;
+	header.mTrianglesOffset			= trianglesOffset;
+	header.mNodesOffset				= nodesOffset;
+	header.mFaceRemapOffset			= faceRemapOffset;
+	header.mExtraTrigDataOffset		= extraTrigDataOffset;
+	header.mMaterialIndicesOffset	= materialsOffset;
+	header.mAdjacenciesOffset		= adjacenciesOffset;
+
+	stream.write(&header, sizeof(InPlaceMeshHeader));
+	PxU32 written = sizeof(InPlaceMeshHeader);
+	writeInPlace(stream, written, verticesOffset, mVertices, mNbVertices*sizeof(PxVec3));
+	writeInPlace(stream, written, trianglesOffset, mTriangles, nbTris*3*indexSize);
+	writeInPlace(stream, written, nodesOffset, mBV4Tree.mNodes, mBV4Tree.mNbNodes*nodeSize);
+	writeInPlace(stream, written, faceRemapOffset, mFaceRemap, nbTris*sizeof(PxU32));
+	writeInPlace(stream, written, extraTrigDataOffset, mExtraTrigData, nbTris*sizeof(PxU8));
+	writeInPlace(stream, written, materialsOffset, mMaterialIndices, nbTris*sizeof(PxU16));
+	writeInPlace(stream, written, adjacenciesOffset, mAdjacencies, nbTris*3*sizeof(PxU32));
+
+	// PT: pad the end so that the total size is a multiple of 16 as well
+	static const PxU8 zeros[16] = {0};
+	stream.write(zeros, offset - written);
+	return true;
+}
+
+BV4TriangleMesh* BV4TriangleMesh::createInPlace(void* data, PxU32 size)
 {
-	PX_ASSERT(d.mType==PxMeshMidPhase::eBVH34);
+	if(!data || (size_t(data)&15) || size<sizeof(InPlaceMeshHeader))
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateTriangleMeshInPlace: data must be non-null, 16-byte aligned and contain at least a header.");
+		return NULL;
+	}
+
+	PxU8* base = reinterpret_cast<PxU8*>(data);
+	const InPlaceMeshHeader& header = *reinterpret_cast<const InPlaceMeshHeader*>(base);
+	if(header.mMagic!=PX_INPLACE_MESH_MAGIC || header.mVersion!=PX_INPLACE_MESH_VERSION || header.mTotalSize>size)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateTriangleMeshInPlace: unknown format, unsupported version or truncated data.");
+		return NULL;
+	}
+
+	const PxU64 nbTris = header.mNbTriangles;
+	const PxU32 indexSize = (header.mFlags & PxTriangleMeshFlag::e16_BIT_INDICES) ? sizeof(PxU16) : sizeof(PxU32);
+	const PxU32 nodeSize = header.mQuantized ? sizeof(BVDataPackedQ) : sizeof(BVDataPackedNQ);
+	if(		!header.mVerticesOffset || !header.mTrianglesOffset || (header.mNbNodes && !header.mNodesOffset)
+		||	!validInPlaceArray(header, header.mVerticesOffset, PxU64(header.mNbVertices)*sizeof(PxVec3) + sizeof(PxU32))
+		||	!validInPlaceArray(header, header.mTrianglesOffset, nbTris*3*indexSize)
+		||	!validInPlaceArray(header, header.mNodesOffset, PxU64(header.mNbNodes)*nodeSize)
+		||	!validInPlaceArray(header, header.mFaceRemapOffset, nbTris*sizeof(PxU32))
+		||	!validInPlaceArray(header, header.mExtraTrigDataOffset, nbTris*sizeof(PxU8))
+		||	!validInPlaceArray(header, header.mMaterialIndicesOffset, nbTris*sizeof(PxU16))
+		||	!validInPlaceArray(header, header.mAdjacenciesOffset, nbTris*3*sizeof(PxU32)))
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateTriangleMeshInPlace: corrupted data.");
+		return NULL;
+	}
+
+	PxTriangleMeshInternalData internal;
+	internal.mNbVertices		= header.mNbVertices;
+	internal.mNbTriangles		= header.mNbTriangles;
+	internal.mVertices			= reinterpret_cast<PxVec3*>(base + header.mVerticesOffset);
+	internal.mTriangles			= base + header.mTrianglesOffset;
+	internal.mFaceRemap			= header.mFaceRemapOffset ? reinterpret_cast<PxU32*>(base + header.mFaceRemapOffset) : NULL;
+	internal.mAABB_Center		= header.mAABBCenter;
+	internal.mAABB_Extents		= header.mAABBExtents;
+	internal.mGeomEpsilon		= header.mGeomEpsilon;
+	internal.mFlags				= PxU8(header.mFlags);
+	internal.mNbNodes			= header.mNbNodes;
+	internal.mNodeSize			= nodeSize;
+	internal.mNodes				= header.mNodesOffset ? base + header.mNodesOffset : NULL;
+	internal.mInitData			= header.mInitData;
+	internal.mCenterOrMinCoeff	= header.mCenterOrMinCoeff;
+	internal.mExtentsOrMaxCoeff	= header.mExtentsOrMaxCoeff;
+	internal.mQuantized			= header.mQuantized!=0;
+
+	// PT: the internal-data constructor doesn't own memory, so releasing the mesh leaves the user buffer alone
+	BV4TriangleMesh* mesh = PX_NEW(BV4TriangleMesh)(internal);
+	mesh->mExtraTrigData		= header.mExtraTrigDataOffset ? base + header.mExtraTrigDataOffset : NULL;
+	mesh->mMaterialIndices		= header.mMaterialIndicesOffset ? reinterpret_cast<PxU16*>(base + header.mMaterialIndicesOffset) : NULL;
+	mesh->mAdjacencies			= header.mAdjacenciesOffset ? reinterpret_cast<PxU32*>(base + header.mAdjacenciesOffset) : NULL;
+	mesh->mMass					= header.mMass;
+	mesh->mInertia				= header.mInertia;
+	mesh->mLocalCenterOfMass	= header.mLocalCenterOfMass;
+	return mesh;
+}
+
+BV4TriangleMesh::BV4TriangleMesh(MeshFactory* factory, TriangleMeshData& d) : TriangleMesh(factory, d), mCookedBVHCost(0.0f), mWideTree(NULL)
+{
+	PX_ASSERT(d.mType==PxMeshMidPhase::eBVH34 || d.mType==PxMeshMidPhase::eBVH38);
 
 	BV4TriangleData& bv4Data = static_cast<BV4TriangleData&>(d);
 	mMeshInterface = bv4Data.mMeshInterface;
 	mBV4Tree = bv4Data.mBV4Tree;
 	mBV4Tree.mMeshInterface = &mMeshInterface;
+
+	if(d.mType==PxMeshMidPhase::eBVH38)
+		createWideTree();
+}
+
+BV4TriangleMesh::~BV4TriangleMesh()
+{
+	PX_DELETE(mWideTree);
+}
+
+void BV4TriangleMesh::createWideTree()
+{
+	// PT: same leaf size & box epsilon as the BV4 trees' defaults
+	mWideTree = PX_NEW(BV8Tree);
+	if(!mWideTree->build(&mMeshInterface, 4, 2e-4f))
+	{
+		PX_DELETE(mWideTree);
+		PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "BVH38 trees: wide tree could not be built, falling back to BVH34.\n");
+	}
 }
 
 TriangleMesh* BV4TriangleMesh::createObject(PxU8*& address, PxDeserializationContext& context)
@@ -124,11 +337,20 @@ void BV4TriangleMesh::importExtraData(PxDeserializationContext& context)
 	mBV4Tree.importExtraData(context);
 	TriangleMesh::importExtraData(context);
 
+	mCookedBVHCost = 0.0f;
+
 	if(has16BitIndices())
 		mMeshInterface.setPointers(NULL, const_cast<IndTri16*>(reinterpret_cast<const IndTri16*>(getTrianglesFast())), getVerticesFast());
 	else
 		mMeshInterface.setPointers(const_cast<IndTri32*>(reinterpret_cast<const IndTri32*>(getTrianglesFast())), NULL, getVerticesFast());
 	mBV4Tree.mMeshInterface = &mMeshInterface;
+
+	// PT: the wide tree isn't serialized, a non-NULL pointer only tells us the mesh had one
+	if(mWideTree)
+	{
+		mWideTree = NULL;
+		createWideTree();
+	}
 }
 
 PxVec3 * BV4TriangleMesh::getVerticesForModification()
@@ -137,13 +359,48 @@ PxVec3 * BV4TriangleMesh::getVerticesForModification()
 }
 
 PxBounds3 BV4TriangleMesh::refitBVH()
+{
+	return refit(NULL, 0);
+}
+
+PxBounds3 BV4TriangleMesh::refitBVHForTriangles(const PxU32* triangleIndices, PxU32 nbTriangles)
+{
+	PX_CHECK_AND_RETURN_VAL(triangleIndices || !nbTriangles, "PxTriangleMesh::refitBVHForTriangles: triangleIndices is NULL", PxBounds3(mAABB.getMin(), mAABB.getMax()));
+#if PX_CHECKED
+	for(PxU32 i=0;i<nbTriangles;i++)
+		PX_CHECK_AND_RETURN_VAL(triangleIndices[i]<mNbTriangles, "PxTriangleMesh::refitBVHForTriangles: invalid triangle index", PxBounds3(mAABB.getMin(), mAABB.getMax()));
+#endif
+	// PT: an empty list still needs a valid pointer, else the tree would do a full refit
+	static const PxU32 dummy = 0;
+	return refit(nbTriangles ? triangleIndices : &dummy, nbTriangles);
+}
+
+PxReal BV4TriangleMesh::getBVHRefitCostRatio() const
+{
+	if(mCookedBVHCost==0.0f)
+		return 1.0f;
+	return mBV4Tree.computeSurfaceAreaCost()/mCookedBVHCost;
+}
+
+PxBounds3 BV4TriangleMesh::refit(const PxU32* triangleIndices, PxU32 nbTriangles)
 {
 	PxBounds3 newBounds;
 
+	// PT: the tree hasn't been modified yet so this is the cost of the cooked tree
+	if(mCookedBVHCost==0.0f)
+		mCookedBVHCost = mBV4Tree.computeSurfaceAreaCost();
+
 	const float gBoxEpsilon = 2e-4f;
-	if(mBV4Tree.refit(newBounds, gBoxEpsilon))
+	if(mBV4Tree.refit(newBounds, gBoxEpsilon, triangleIndices, nbTriangles))
 	{
 		mAABB.setMinMax(newBounds.minimum, newBounds.maximum);
+
+		// PT: the wide tree is small compared to the mesh so it's always fully refit, even for partial refits
+		if(mWideTree)
+		{
+			PxBounds3 wideBounds;
+			mWideTree->refit(wideBounds, gBoxEpsilon);
+		}
 	}
 	else
 	{
@@ -36,6 +36,7 @@ namespace physx
 namespace Gu
 {
 class MeshFactory;
+class BV8Tree;
 
 #if PX_VC
 #pragma warning(push)
@@ -47,26 +48,39 @@ class BV4TriangleMesh : public TriangleMesh
 	public:
 						virtual const char*				getConcreteTypeName()	const	{ return "PxBVH34TriangleMesh"; }
 // PX_SERIALIZATION
-														BV4TriangleMesh(PxBaseFlags baseFlags) : TriangleMesh(baseFlags), mMeshInterface(PxEmpty), mBV4Tree(PxEmpty)	{}
+														BV4TriangleMesh(PxBaseFlags baseFlags) : TriangleMesh(baseFlags), mMeshInterface(PxEmpty), mBV4Tree(PxEmpty), mCookedBVHCost(0.0f)	{}	// PT: mWideTree is left as deserialized, see importExtraData
 	PX_PHYSX_COMMON_API	virtual void					exportExtraData(PxSerializationContext& ctx);
 								void					importExtraData(PxDeserializationContext&);
 	PX_PHYSX_COMMON_API	static	TriangleMesh*			createObject(PxU8*& address, PxDeserializationContext& context);
 //~PX_SERIALIZATION
 														BV4TriangleMesh(MeshFactory* factory, TriangleMeshData& data);
-						virtual							~BV4TriangleMesh(){}
+						virtual							~BV4TriangleMesh();
 
-						virtual	PxMeshMidPhase::Enum	getMidphaseID()			const	{ return PxMeshMidPhase::eBVH34;	}
+						virtual	PxMeshMidPhase::Enum	getMidphaseID()			const	{ return mWideTree ? PxMeshMidPhase::eBVH38 : PxMeshMidPhase::eBVH34;	}
 
 						virtual PxVec3*					getVerticesForModification();
 						virtual PxBounds3				refitBVH();
+						virtual PxBounds3				refitBVHForTriangles(const PxU32* triangleIndices, PxU32 nbTriangles);
+						virtual PxReal					getBVHRefitCostRatio()	const;
 
 	PX_PHYSX_COMMON_API									BV4TriangleMesh(const PxTriangleMeshInternalData& data);
 						virtual	bool					getInternalData(PxTriangleMeshInternalData&, bool)	const;
 
 	PX_FORCE_INLINE				const Gu::BV4Tree&		getBV4Tree()			const	{ return mBV4Tree;				}
+	// PT: 8-wide tree used by raycasts & overlaps of PxMeshMidPhase::eBVH38 meshes, NULL for regular BVH34 meshes
+	PX_FORCE_INLINE				const Gu::BV8Tree*		getWideTree()			const	{ return mWideTree;				}
+
+	// PT: in-place format, see PxSaveTriangleMeshInPlace / PxCreateTriangleMeshInPlace
+	PX_PHYSX_COMMON_API			bool					saveInPlace(PxOutputStream& stream)	const;
+	PX_PHYSX_COMMON_API	static	BV4TriangleMesh*		createInPlace(void* data, PxU32 size);
 	private:
+								PxBounds3				refit(const PxU32* triangleIndices, PxU32 nbTriangles);
+								void					createWideTree();
+
 								Gu::SourceMesh			mMeshInterface;
 								Gu::BV4Tree				mBV4Tree;
+								PxReal					mCookedBVHCost;	// PT: SAH cost of the tree before the first refit, 0 until then
+								Gu::BV8Tree*			mWideTree;		// PT: derived from the mesh at load time, not part of the cooked data
 };
 
 #if PX_VC
@@ -108,10 +108,13 @@ static bool generateOrProcessContactsBoxConvex(	const GjkConvex* relativeConvex,
 {
 	if (status == GJK_NON_INTERSECT)
 	{
+		manifold.setSeparatingAxis(output.searchDir, output.penDep);
 		return false;
 	}
 	else
 	{
+		manifold.invalidateSeparatingAxis();
+
 		PersistentContact* manifoldContacts = PX_CP_TO_PCP(contactBuffer.contacts);
 
 		const Vec3V localNor = manifold.mNumContacts ? manifold.getLocalNormal() : V3Zero();
@@ -195,10 +198,15 @@ bool Gu::pcmContactBoxConvex(GU_CONTACT_METHOD_ARGS)
 	const FloatV projectBreakingThreshold = FMul(minMargin, FLoad(0.8f));
 	const PxU32 initialContacts = manifold.mNumContacts;
 
+	const FloatV radiusA = V3Length(boxExtents);
+
+	//ML: separated pairs whose relative motion can't close the gap found by the previous GJK query don't need to run GJK again
+	if(!initialContacts && manifold.isStillSeparated(curRTrans, radiusA, contactDist))
+		return false;
+
 	manifold.refreshContactPoints(aToB, projectBreakingThreshold, contactDist);  
 
 	const Vec3V extents = V3Mul(V3LoadU_SafeReadW(hullData->mInternal.mInternalExtents), vScale);
-	const FloatV radiusA = V3Length(boxExtents);
 	const FloatV radiusB = V3Length(extents);
 	
 	//After the refresh contact points, the numcontacts in the manifold will be changed
@@ -33,11 +33,16 @@
 #include "GuPCMContactMeshCallback.h"
 #include "GuBarycentricCoordinates.h"
 #include "GuBox.h"
+#include "GuTriangleMesh.h"
 
 using namespace physx;
 using namespace Gu;
 using namespace aos;
 
+// PT: the midphase query volume is inflated by this ratio of the capsule radius, so that its candidate triangles can be reused
+// in the next frames while the capsule doesn't move by more than that. See MultiplePersistentContactManifold::canReuseCachedTriangles.
+#define PCM_CAPSULE_MESH_CACHE_INFLATION	0.5f
+
 namespace
 {
 struct PCMCapsuleVsMeshContactGenerationCallback : PCMMeshContactGenerationCallback< PCMCapsuleVsMeshContactGenerationCallback >
@@ -45,6 +50,8 @@ struct PCMCapsuleVsMeshContactGenerationCallback : PCMMeshContactGenerationCallb
 	PCMCapsuleVsMeshContactGenerationCallback& operator=(const PCMCapsuleVsMeshContactGenerationCallback&);
 
 	PCMCapsuleVsMeshContactGeneration	mGeneration;
+	PxU32*								mRecordedTriangles;
+	PxU32								mNbRecordedTriangles;
 
 	PCMCapsuleVsMeshContactGenerationCallback(
 		const CapsuleV& capsule,
@@ -62,8 +69,23 @@ struct PCMCapsuleVsMeshContactGenerationCallback : PCMMeshContactGenerationCallb
 	) :
 		PCMMeshContactGenerationCallback<PCMCapsuleVsMeshContactGenerationCallback>(meshScaling, extraTriData, idtMeshScale),
 		mGeneration(capsule, contactDist, replaceBreakingThreshold, sphereTransform, meshTransform, multiManifold, contactBuffer, 
-			deferredContacts, renderOutput)
+			deferredContacts, renderOutput),
+		mRecordedTriangles	(NULL),
+		mNbRecordedTriangles(0)
+	{
+	}
+
+	virtual PxAgain processHit(const PxGeomRaycastHit& hit, const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, PxReal& shrunkMaxT, const PxU32* vinds)
 	{
+		// PT: record the candidate triangles for the next frames. We keep counting after the buffer is full so that the caller can
+		// detect the overflow and invalidate the cache.
+		if(mRecordedTriangles)
+		{
+			if(mNbRecordedTriangles < GU_MAX_CACHED_TRIANGLES)
+				mRecordedTriangles[mNbRecordedTriangles] = hit.faceIndex;
+			mNbRecordedTriangles++;
+		}
+		return PCMMeshContactGenerationCallback<PCMCapsuleVsMeshContactGenerationCallback>::processHit(hit, v0, v1, v2, shrunkMaxT, vinds);
 	}
 
 	PX_FORCE_INLINE bool doTest(const PxVec3&, const PxVec3&, const PxVec3&) { return true; }
@@ -76,6 +98,29 @@ struct PCMCapsuleVsMeshContactGenerationCallback : PCMMeshContactGenerationCallb
 };
 }
 
+// PT: replays the cached candidate triangles through the callback, the same way the midphase would report them
+static void processCachedTriangles(const TriangleMesh* meshData, const MultiplePersistentContactManifold& multiManifold, PCMCapsuleVsMeshContactGenerationCallback& callback)
+{
+	const PxVec3* PX_RESTRICT vertices = meshData->getVerticesFast();
+	const void* PX_RESTRICT triangles = meshData->getTrianglesFast();
+	const bool has16BitIndices = meshData->has16BitIndices();
+
+	PxGeomRaycastHit hit;
+	PxReal shrunkMaxT = PX_MAX_REAL;
+	const PxU32 nbTriangles = multiManifold.mNumCachedTriangles;
+	for(PxU32 i=0;i<nbTriangles;i++)
+	{
+		const PxU32 triangleIndex = multiManifold.mCachedTriangles[i];
+		PX_ASSERT(triangleIndex < meshData->getNbTrianglesFast());
+
+		PxU32 vinds[3];
+		getVertexRefs(triangleIndex, vinds[0], vinds[1], vinds[2], triangles, has16BitIndices);
+
+		hit.faceIndex = triangleIndex;
+		callback.processHit(hit, vertices[vinds[0]], vertices[vinds[1]], vertices[vinds[2]], shrunkMaxT, vinds);
+	}
+}
+
 bool Gu::pcmContactCapsuleMesh(GU_CONTACT_METHOD_ARGS)
 {
 	MultiplePersistentContactManifold& multiManifold = cache.getMultipleManifold();
@@ -115,9 +160,6 @@ bool Gu::pcmContactCapsuleMesh(GU_CONTACT_METHOD_ARGS)
 		const PxVec3 capsuleDirInMesh = transform1.rotateInv(tmp);
 		const CapsuleV capsule(V3LoadU(capsuleCenterInMesh), V3LoadU(capsuleDirInMesh), capsuleRadius);
 
-		// We must be in local space to use the cache
-		const Capsule queryCapsule(meshCapsule, inflatedRadius);
-
 		const TriangleMesh* meshData = _getMeshData(shapeMesh);
 
 		multiManifold.mNumManifolds = 0;
@@ -139,15 +181,28 @@ bool Gu::pcmContactCapsuleMesh(GU_CONTACT_METHOD_ARGS)
 			NULL,
 			renderOutput);
 
-		//bound the capsule in shape space by an OBB:
-		Box queryBox;
-		queryBox.create(queryCapsule);
+		if(multiManifold.canReuseCachedTriangles(meshCapsule.p0, meshCapsule.p1, inflatedRadius))
+		{
+			processCachedTriangles(meshData, multiManifold, callback);
+		}
+		else
+		{
+			// We must be in local space to use the cache
+			const PxReal queryRadius = inflatedRadius + shapeCapsule.radius * PCM_CAPSULE_MESH_CACHE_INFLATION;
+			const Capsule queryCapsule(meshCapsule, queryRadius);
+
+			//bound the capsule in shape space by an OBB:
+			Box queryBox;
+			queryBox.create(queryCapsule);
 
-		//apply the skew transform to the box:
-		if(!idtMeshScale)
-			meshScaling.transformQueryBounds(queryBox.center, queryBox.extents, queryBox.rot);
+			//apply the skew transform to the box:
+			if(!idtMeshScale)
+				meshScaling.transformQueryBounds(queryBox.center, queryBox.extents, queryBox.rot);
 
-		Midphase::intersectOBB(meshData, queryBox, callback, true);
+			callback.mRecordedTriangles = multiManifold.mCachedTriangles;
+			Midphase::intersectOBB(meshData, queryBox, callback, true);
+			multiManifold.setCachedTriangles(meshCapsule.p0, meshCapsule.p1, queryRadius, callback.mNbRecordedTriangles);
+		}
 
 		callback.flushCache();
 	
@@ -100,10 +100,13 @@ static bool generateOrProcessContactsConvexConvex(	const GjkConvex* relativeConv
 {
 	if(status == GJK_NON_INTERSECT)
 	{
+		manifold.setSeparatingAxis(output.searchDir, output.penDep);
 		return false;
 	}
 	else
 	{
+		manifold.invalidateSeparatingAxis();
+
 		PersistentContact* manifoldContacts = PX_CP_TO_PCP(contactBuffer.contacts);
 
 		const Vec3V localNor = manifold.mNumContacts ? manifold.getLocalNormal() : V3Zero();
@@ -222,6 +225,10 @@ bool Gu::pcmContactConvexConvex(GU_CONTACT_METHOD_ARGS)
 	
 	const PxU32 initialContacts = manifold.mNumContacts;
 
+	//ML: separated pairs whose relative motion can't close the gap found by the previous GJK query don't need to run GJK again
+	if(!initialContacts && manifold.isStillSeparated(curRTrans, CalculatePCMConvexRadius(hullData0, vScale0), contactDist))
+		return false;
+
 	const FloatV minMargin = FMin(convexMargin0, convexMargin1);
 	const FloatV projectBreakingThreshold = FMul(minMargin, FLoad(0.8f));
 	
@@ -249,6 +256,14 @@ bool Gu::pcmContactConvexConvex(GU_CONTACT_METHOD_ARGS)
 		const ConvexHullV convexHull0(hullData0, V3LoadU_SafeReadW(hullData0->mCenterOfMass), vScale0, vQuat0, idtScale0);
 		const ConvexHullV convexHull1(hullData1, V3LoadU_SafeReadW(hullData1->mCenterOfMass), vScale1, vQuat1, idtScale1);
 
+		//ML: the previous frame's simplex warm-starts GJK, and its support vertices also warm-start the hill climbing
+		//of large hulls
+		if(manifold.mNumWarmStartPoints)
+		{
+			convexHull0.setSupportHint(manifold.mAIndice[0]);
+			convexHull1.setSupportHint(manifold.mBIndice[0]);
+		}
+
 		GjkOutput output;
 		
 		if(idtScale0)
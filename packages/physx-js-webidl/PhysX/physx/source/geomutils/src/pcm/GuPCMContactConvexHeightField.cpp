@@ -142,7 +142,12 @@ bool Gu::PCMContactConvexHeightfield(
 			renderOutput
 		);
 
-		hfUtil.overlapAABBTriangles(transform0, transform1, hullAABB, blockCallback);
+		{
+			// PT: same bounds as overlapAABBTriangles(transform0, transform1, ...), then direct cell walk
+			const PxTransform pose0to1 = transform1.transformInv(transform0);
+			const PxMat33Padded basis(pose0to1.q);
+			blockCallback.overlapCells(PxBounds3::basisExtent(pose0to1.transform(hullAABB.getCenter()), basis, hullAABB.getExtents()));
+		}
 
 		PX_ASSERT(multiManifold.mNumManifolds <= GU_MAX_MANIFOLD_SIZE);
 		blockCallback.mGeneration.generateLastContacts();
@@ -203,8 +203,176 @@ public:
 			(static_cast<Derived*>(this))->template processTriangleCache< CacheSize >(cache);
 		}
 		return true;
-	}	
+	}
+
+	// PT: direct cell-grid alternative to HeightFieldUtil::overlapAABBTriangles() + reportTouchedTris(). We compute the
+	// covered cell range once, read the samples straight from the heightfield while walking the rows, and rebuild each
+	// cell's triangles (and their neighbours, for edge flags) from the cell's row/column. No virtual calls, no index
+	// buffer, no getTriangle() and no per-vertex divisions. Results are the same as the callback-based path.
+	// "bounds" is in heightfield shape space, as for overlapAABBTriangles().
+	void overlapCells(const PxBounds3& bounds)
+	{
+		PX_ASSERT(!bounds.isEmpty());
+
+		const Gu::HeightField& hf = mHfUtil.getHeightField();
+		const PxHeightFieldGeometry& hfGeom = mHfUtil.getHeightFieldGeometry();
+
+		PxBounds3 localBounds(	PxVec3(bounds.minimum.x * mHfUtil.getOneOverRowScale(), bounds.minimum.y * mHfUtil.getOneOverHeightScale(), bounds.minimum.z * mHfUtil.getOneOverColumnScale()),
+								PxVec3(bounds.maximum.x * mHfUtil.getOneOverRowScale(), bounds.maximum.y * mHfUtil.getOneOverHeightScale(), bounds.maximum.z * mHfUtil.getOneOverColumnScale()));
+
+		if(hfGeom.rowScale < 0.0f)
+			PxSwap(localBounds.minimum.x, localBounds.maximum.x);
+
+		if(hfGeom.columnScale < 0.0f)
+			PxSwap(localBounds.minimum.z, localBounds.maximum.z);
+
+		// PT: same early exits as overlapAABBTriangles(), done after scaling since scales can be negative
+		const PxU32 nbRows = hf.getNbRowsFast();
+		const PxU32 nbColumns = hf.getNbColumnsFast();
+		if(localBounds.minimum.x > float(nbRows - 1) || localBounds.minimum.z > float(nbColumns - 1))
+			return;
+		if(localBounds.maximum.x < 0.0f || localBounds.maximum.z < 0.0f)
+			return;
+
+		const PxU32 minRow = hf.getMinRow(localBounds.minimum.x);
+		const PxU32 maxRow = hf.getMaxRow(localBounds.maximum.x);
+		const PxU32 minColumn = hf.getMinColumn(localBounds.minimum.z);
+		const PxU32 maxColumn = hf.getMaxColumn(localBounds.maximum.z);
+		if(minRow >= maxRow || minColumn >= maxColumn)
+			return;
+
+		const bool wrongHanded = (hfGeom.rowScale < 0.0f) != (hfGeom.columnScale < 0.0f);
+
+		const PxReal miny = localBounds.minimum.y;
+		const PxReal maxy = localBounds.maximum.y;
+
+		const PxU32 CacheSize = 16;
+		Gu::TriangleCache<CacheSize> cache;
+
+		for(PxU32 row=minRow; row<maxRow; row++)
+		{
+			PxU32 offset = row * nbColumns + minColumn;
+			for(PxU32 column=minColumn; column<maxColumn; column++, offset++)
+			{
+				const PxReal h0 = hf.getHeight(offset);
+				const PxReal h1 = hf.getHeight(offset + 1);
+				const PxReal h2 = hf.getHeight(offset + nbColumns);
+				const PxReal h3 = hf.getHeight(offset + nbColumns + 1);
+
+				const bool bmax = maxy < h0 && maxy < h1 && maxy < h2 && maxy < h3;
+				const bool bmin = miny > h0 && miny > h1 && miny > h2 && miny > h3;
+				if(bmax || bmin)
+					continue;
+
+				if(hf.getMaterialIndex0(offset) != PxHeightFieldMaterial::eHOLE)
+					addCellTriangle(cache, offset << 1, row, column, wrongHanded);
+
+				if(hf.getMaterialIndex1(offset) != PxHeightFieldMaterial::eHOLE)
+					addCellTriangle(cache, (offset << 1) + 1, row, column, wrongHanded);
+			}
+		}
+
+		if(!cache.isEmpty())
+			(static_cast<Derived*>(this))->template processTriangleCache< CacheSize >(cache);
+	}
+
 protected:
+	// PT: same vertices/indices as getTriangle(..., false, false), but using the known cell row/column instead of
+	// dividing each vertex index by the number of columns.
+	PX_FORCE_INLINE void getCellTriangle(PxU32 triangleIndex, PxU32 row, PxU32 column, bool wrongHanded, PxVec3* verts, PxU32* vertIndices) const
+	{
+		const Gu::HeightField& hf = mHfUtil.getHeightField();
+		const PxU32 nbColumns = hf.getNbColumnsFast();
+		const PxU32 cell = triangleIndex >> 1;
+		PX_ASSERT(cell == row * nbColumns + column);
+
+		// PT: cell corners are encoded as (rowOffset<<1)|columnOffset, see HeightField::getTriangleVertexIndices()
+		static const PxU8 corners[2][2][3] = {	{ { 0, 1, 2 }, { 3, 2, 1 } },		// 0th vertex not shared
+												{ { 2, 0, 3 }, { 1, 3, 0 } } };		// 0th vertex shared
+		const PxU8* tri = corners[hf.isZerothVertexShared(cell) ? 1 : 0][triangleIndex & 1];
+
+		const PxU32 slots[3] = { 0, 1u + wrongHanded, 2u - wrongHanded };
+		for(PxU32 i=0; i<3; i++)
+		{
+			const PxU32 dr = PxU32(tri[i] >> 1);
+			const PxU32 dc = PxU32(tri[i] & 1);
+			const PxU32 vertexIndex = cell + dr * nbColumns + dc;
+			vertIndices[slots[i]] = vertexIndex;
+			verts[slots[i]] = mHfUtil.hf2shapep(PxVec3(PxReal(row + dr), hf.getHeight(vertexIndex), PxReal(column + dc)));
+		}
+	}
+
+	template<PxU32 CacheSize>
+	PX_FORCE_INLINE void addCellTriangle(Gu::TriangleCache<CacheSize>& cache, PxU32 triangleIndex, PxU32 row, PxU32 column, bool wrongHanded)
+	{
+		const Gu::HeightField& hf = mHfUtil.getHeightField();
+		const PxU32 nbColumns = hf.getNbColumnsFast();
+		const PxU32 cell = triangleIndex >> 1;
+
+		PxTriangle currentTriangle;
+		PxU32 vertIndices[3];
+		getCellTriangle(triangleIndex, row, column, wrongHanded, currentTriangle.verts, vertIndices);
+
+		PxU32 adjInds[3];
+		hf.getTriangleAdjacencyIndices(	triangleIndex, vertIndices[0], vertIndices[1], vertIndices[2],
+										adjInds[wrongHanded ? 2 : 0], adjInds[1], adjInds[wrongHanded ? 0 : 2]);
+
+		PxVec3 normal;
+		currentTriangle.normal(normal);
+
+		const PxU8 nextInd[] = {2,0,1};
+
+		// PT: same edge classification as reportTouchedTris()
+		PxU8 triFlags = 0;
+		for(PxU32 a = 0; a < 3; ++a)
+		{
+			if(adjInds[a] != 0xFFFFFFFF)
+			{
+				// PT: neighbours are either in the same cell or in one of the 4 edge-adjacent cells
+				const PxU32 adjCell = adjInds[a] >> 1;
+				PxU32 adjRow = row;
+				PxU32 adjColumn = column;
+				if(adjCell == cell + 1)
+					adjColumn++;
+				else if(adjCell + 1 == cell)
+					adjColumn--;
+				else if(adjCell == cell + nbColumns)
+					adjRow++;
+				else if(adjCell + nbColumns == cell)
+					adjRow--;
+
+				PxTriangle adjTri;
+				PxU32 inds[3];
+				getCellTriangle(adjInds[a], adjRow, adjColumn, wrongHanded, adjTri.verts, inds);
+
+				PX_ASSERT(inds[0] == vertIndices[a] || inds[1] == vertIndices[a] || inds[2] == vertIndices[a]);
+				PX_ASSERT(inds[0] == vertIndices[(a + 1) % 3] || inds[1] == vertIndices[(a + 1) % 3] || inds[2] == vertIndices[(a + 1) % 3]);
+
+				PxVec3 adjNormal;
+				adjTri.denormalizedNormal(adjNormal);
+				const PxF32 projD = adjNormal.dot(currentTriangle.verts[nextInd[a]] - adjTri.verts[0]);
+
+				if(projD < 0.f)
+				{
+					adjNormal.normalize();
+					if(adjNormal.dot(normal) < 0.997f)
+						triFlags |= (1 << (a + 3));
+				}
+			}
+			else if(mBoundaryCollisions)
+				triFlags |= (1 << (a + 3));	//Mark boundary edge active
+			else
+				triFlags |= (1 << a);		//Mark as silhouette edge
+		}
+
+		if(cache.isFull())
+		{
+			(static_cast<Derived*>(this))->template processTriangleCache< CacheSize >(cache);
+			cache.reset();
+		}
+		cache.addTriangle(currentTriangle.verts, vertIndices, triangleIndex, triFlags);
+	}
+
 	PCMHeightfieldContactGenerationCallback& operator=(const PCMHeightfieldContactGenerationCallback&);
 };
 
@@ -126,7 +126,7 @@ bool Gu::pcmContactSphereHeightField(GU_CONTACT_METHOD_ARGS)
 			&delayedContacts,
 			hfUtil);
 
-		hfUtil.overlapAABBTriangles(localBounds, blockCallback);
+		blockCallback.overlapCells(localBounds);
 
 		blockCallback.mGeneration.generateLastContacts();
 		blockCallback.mGeneration.processContacts(GU_SPHERE_MANIFOLD_CACHE_SIZE, false);
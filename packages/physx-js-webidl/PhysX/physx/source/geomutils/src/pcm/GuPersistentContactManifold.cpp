@@ -2228,10 +2228,23 @@ void MultiplePersistentContactManifold::fromBuffer(PxU8* PX_RESTRICT buffer)
 			}
 			buff += sizeof(CachedMeshPersistentContact) * numContacts;
 		}
+
+		mNumCachedTriangles = header->mNumCachedTriangles;
+		if(hasCachedTriangles())
+		{
+			PX_ASSERT(mNumCachedTriangles <= GU_MAX_CACHED_TRIANGLES);
+			const CachedTrianglesHeader* PX_RESTRICT trianglesHeader = reinterpret_cast<const CachedTrianglesHeader*>(buff);
+			buff += sizeof(CachedTrianglesHeader);
+			mCachedSegment0 = trianglesHeader->mSegment0;
+			mCachedSegment1 = trianglesHeader->mSegment1;
+			mCachedTrianglesRadius = trianglesHeader->mRadius;
+			PxMemCopy(mCachedTriangles, buff, sizeof(PxU32) * mNumCachedTriangles);
+		}
 	}
 	else
 	{
 		mRelativeTransform.invalidate();
+		invalidateCachedTriangles();
 	}
 	mNumManifolds = PxU8(numManifolds);
 	for (PxU32 a = numManifolds; a < GU_MAX_MANIFOLD_SIZE; ++a)
@@ -2273,6 +2286,17 @@ void MultiplePersistentContactManifold::toBuffer(PxU8* PX_RESTRICT buffer) const
 		}
 		buff += sizeof(CachedMeshPersistentContact) * manifold.mNumContacts;
 	}
+
+	header->mNumCachedTriangles = mNumCachedTriangles;
+	if(hasCachedTriangles())
+	{
+		CachedTrianglesHeader* PX_RESTRICT trianglesHeader = reinterpret_cast<CachedTrianglesHeader*>(buff);
+		buff += sizeof(CachedTrianglesHeader);
+		trianglesHeader->mSegment0 = mCachedSegment0;
+		trianglesHeader->mSegment1 = mCachedSegment1;
+		trianglesHeader->mRadius = mCachedTrianglesRadius;
+		PxMemCopy(buff, mCachedTriangles, sizeof(PxU32) * mNumCachedTriangles);
+	}
 }
 
 void Gu::addManifoldPoint(PersistentContact* manifoldContacts, PersistentContactManifold& manifold, GjkOutput& output,
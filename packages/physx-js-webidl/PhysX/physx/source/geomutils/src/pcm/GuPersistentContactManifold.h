@@ -49,6 +49,7 @@ namespace physx
 #define GU_CAPSULE_MANIFOLD_CACHE_SIZE 3
 #define GU_MAX_MANIFOLD_SIZE 6	// PT: max nb of manifolds (e.g. for multi-manifolds), NOT the max size of a single manifold
 #define GU_MESH_CONTACT_REDUCTION_THRESHOLD	16
+#define GU_MAX_CACHED_TRIANGLES	64	// PT: max nb of candidate triangles cached in multi-manifolds, see MultiplePersistentContactManifold::canReuseCachedTriangles
 
 #define GU_MANIFOLD_INVALID_INDEX	0xffffffff
 
@@ -151,6 +152,7 @@ public:
 		mRelativeTransform.invalidate();
 		mQuatA = QuatIdentity();
 		mQuatB = QuatIdentity();
+		invalidateSeparatingAxis();
 	}
 
 	PX_FORCE_INLINE PxU32	getNumContacts() const { return mNumContacts;}
@@ -222,6 +224,37 @@ public:
 		return generateContacts;
 	}
 
+	//This is used for the box/convexhull vs convexhull contact gen to skip GJK for pairs that stay separated. When the last GJK query
+	//reported no intersection, we stored its separating axis (in the local space of B) and the distance between the shapes along that
+	//axis. Since then the shape A moved along the axis by the relative translation, and its vertices moved by at most 2*sin(angle/2)*radiusA
+	//because of the relative rotation. If the remaining distance is still larger than the contact distance, the shapes can't touch.
+	PX_FORCE_INLINE PxU32 isStillSeparated(const aos::PxTransformV& curRTrans, const aos::FloatVArg radiusA, const aos::FloatVArg contactDist)	const
+	{
+		using namespace aos;
+		const FloatV one = FOne();
+		const Vec3V axis = Vec3V_From_Vec4V(mSeparatingAxis);
+		const FloatV separation = V4GetW(mSeparatingAxis);
+
+		const FloatV deltaP = V3Dot(axis, V3Sub(curRTrans.p, mRelativeTransform.p));
+
+		const FloatV cosHalfAngle = FMin(FAbs(QuatDot(curRTrans.q, mRelativeTransform.q)), one);
+		const FloatV sinHalfAngle = FSqrt(FSub(one, FMul(cosHalfAngle, cosHalfAngle)));
+		const FloatV deltaQ = FMul(FAdd(sinHalfAngle, sinHalfAngle), radiusA);
+
+		return FAllGrtr(FSub(FAdd(separation, deltaP), deltaQ), contactDist);
+	}
+
+	PX_FORCE_INLINE void setSeparatingAxis(const aos::Vec3VArg axis, const aos::FloatVArg separation)
+	{
+		mSeparatingAxis = aos::V4SetW(aos::Vec4V_From_Vec3V(axis), separation);
+	}
+
+	PX_FORCE_INLINE void invalidateSeparatingAxis()
+	{
+		using namespace aos;
+		mSeparatingAxis = V4SetW(V4Zero(), FNegMax());
+	}
+
 	//This is used for the sphere/capsule vs other primitives contact gen to decide whether the relative movement of a pair of objects are 
 	//small enough. In this case, we can skip the collision detection all together
 	PX_FORCE_INLINE PxU32 invalidate_SphereCapsule(const aos::PxTransformV& curRTrans, const aos::FloatVArg minMargin)	const
@@ -273,6 +306,7 @@ public:
 		mNumWarmStartPoints = 0;
 		mNumContacts = 0;
 		mRelativeTransform.invalidate();
+		invalidateSeparatingAxis();
 	}
 
 	PX_FORCE_INLINE void initialize()
@@ -337,6 +371,7 @@ public:
 	aos::PxTransformV mRelativeTransform;//aToB
 	aos::QuatV mQuatA;
 	aos::QuatV mQuatB;
+	aos::Vec4V mSeparatingAxis;//separating axis in B space (xyz) and separation along that axis (w), see isStillSeparated
 	PxU8 mNumContacts;
 	PxU8 mCapacity;
 	PxU8 mNumWarmStartPoints;
@@ -458,7 +493,16 @@ struct MultiPersistentManifoldHeader
 {
 	aos::PxTransformV mRelativeTransform;//aToB
 	PxU32 mNumManifolds;
-	PxU32 pad[3];
+	PxU32 mNumCachedTriangles;
+	PxU32 pad[2];
+};
+
+struct CachedTrianglesHeader
+{
+	PxVec3 mSegment0;
+	PxReal mRadius;
+	PxVec3 mSegment1;
+	PxU32 pad;
 };
 
 struct SingleManifoldHeader
@@ -479,6 +523,7 @@ public:
 	MultiplePersistentContactManifold():mNumManifolds(0), mNumTotalContacts(0)
 	{
 		mRelativeTransform.invalidate();
+		invalidateCachedTriangles();
 	}
 
 	PX_FORCE_INLINE void setRelativeTransform(const aos::PxTransformV& transform)
@@ -515,6 +560,50 @@ public:
 		return invalidate(curRTrans, minMargin, FLoad(0.2f));
 	}
 
+	//The candidate triangles returned by the last midphase query are cached with the query segment and radius (in mesh space). They
+	//can be reused instead of running a new query as long as the current query volume stays inside the cached one, i.e. when the
+	//displacement of the segment end points plus the current radius doesn't exceed the cached radius.
+	PX_FORCE_INLINE bool canReuseCachedTriangles(const PxVec3& p0, const PxVec3& p1, PxReal radius)	const
+	{
+		if(mNumCachedTriangles == GU_MANIFOLD_INVALID_INDEX)
+			return false;
+
+		const PxReal displacement = PxSqrt(PxMax((p0 - mCachedSegment0).magnitudeSquared(), (p1 - mCachedSegment1).magnitudeSquared()));
+		return displacement + radius <= mCachedTrianglesRadius;
+	}
+
+	PX_FORCE_INLINE void setCachedTriangles(const PxVec3& p0, const PxVec3& p1, PxReal radius, PxU32 nbTriangles)
+	{
+		if(nbTriangles > GU_MAX_CACHED_TRIANGLES)
+		{
+			invalidateCachedTriangles();
+			return;
+		}
+		mCachedSegment0 = p0;
+		mCachedSegment1 = p1;
+		mCachedTrianglesRadius = radius;
+		mNumCachedTriangles = nbTriangles;
+	}
+
+	PX_FORCE_INLINE void invalidateCachedTriangles()
+	{
+		mNumCachedTriangles = GU_MANIFOLD_INVALID_INDEX;
+	}
+
+	PX_FORCE_INLINE bool hasCachedTriangles()	const
+	{
+		return mNumCachedTriangles != GU_MANIFOLD_INVALID_INDEX;
+	}
+
+	//Size of the buffer needed by toBuffer
+	PX_FORCE_INLINE PxU32 getBufferSize()	const
+	{
+		PxU32 size = sizeof(MultiPersistentManifoldHeader) + mNumManifolds * sizeof(SingleManifoldHeader) + mNumTotalContacts * sizeof(CachedMeshPersistentContact);
+		if(hasCachedTriangles())
+			size += sizeof(CachedTrianglesHeader) + mNumCachedTriangles * sizeof(PxU32);
+		return size;
+	}
+
 	// This function work out the contact patch connectivity. If two patches's normal are within 5 degree, we would link these two patches together and reset the total size.
 	PX_FORCE_INLINE void refineContactPatchConnective(PCMContactPatch** contactPatch, PxU32 numContactPatch, MeshPersistentContact* manifoldContacts, const aos::FloatVArg acceptanceEpsilon)	const
 	{
@@ -623,6 +712,7 @@ public:
 		mNumManifolds = 0;
 		mNumTotalContacts = 0;
 		mRelativeTransform.invalidate();
+		invalidateCachedTriangles();
 		for(PxU8 i=0; i<GU_MAX_MANIFOLD_SIZE; ++i)
 		{
 			mManifolds[i].initialize();
@@ -639,6 +729,7 @@ public:
 		mNumManifolds = 0;
 		mNumTotalContacts = 0;
 		mRelativeTransform.invalidate();
+		invalidateCachedTriangles();
 	}
 
 	PX_FORCE_INLINE const SinglePersistentContactManifold* getManifold(PxU32 index)	const
@@ -684,6 +775,11 @@ public:
 	PxU8 mNumManifolds;
 	PxU8 mNumTotalContacts;
 	SinglePersistentContactManifold mManifolds[GU_MAX_MANIFOLD_SIZE];
+	PxVec3 mCachedSegment0;
+	PxReal mCachedTrianglesRadius;
+	PxVec3 mCachedSegment1;
+	PxU32 mNumCachedTriangles;	//GU_MANIFOLD_INVALID_INDEX when there is no cached query
+	PxU32 mCachedTriangles[GU_MAX_CACHED_TRIANGLES];
 	
 } PX_ALIGN_SUFFIX(16);
 
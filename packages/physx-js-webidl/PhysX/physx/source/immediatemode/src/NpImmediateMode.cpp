@@ -789,9 +789,7 @@ bool immediate::PxGenerateContacts(	const PxGeometry* const * geom0, const PxGeo
 			//Do collision detection, then write manifold out...
 			g_PCMContactMethodTable[type0][type1](*tempGeom0, *tempGeom1, transform0, transform1, params, cache, contactBuffer, NULL);
 
-			const PxU32 size = (sizeof(Gu::MultiPersistentManifoldHeader) +
-				multiManifold.mNumManifolds * sizeof(Gu::SingleManifoldHeader) +
-				multiManifold.mNumTotalContacts * sizeof(Gu::CachedMeshPersistentContact));
+			const PxU32 size = multiManifold.getBufferSize();
 
 			PxU8* buffer = allocator.allocateCacheData(size);
 
@@ -43,6 +43,19 @@ namespace physx
 		PxU16 mMaterialIndex1;
 	};
 
+	// PT: combined properties of a pair of materials, see PxsCombineMaterials()
+	struct PxsCombinedMaterial
+	{
+		PxReal	mStaticFriction;
+		PxReal	mDynamicFriction;
+		PxReal	mRestitution;
+		PxReal	mDamping;
+		PxU32	mFlags;
+	};
+
+	// PT: materials with an index below this have their pairs combined ahead of time, see PxsMaterialManager
+	#define PXS_MATERIAL_PAIR_TABLE_SIZE	64
+
 	template<class MaterialCore>
 	class PxsMaterialManagerT 
 	{
@@ -120,8 +133,49 @@ namespace physx
 	};
 
 	//This class is used for forward declaration
+	// PT: it also maintains a table of combined material pairs, updated when materials are added or changed at the
+	// start of a simulation step, so that the narrow phase doesn't combine the same pairs again for each contact patch.
+	// The table only covers the first PXS_MATERIAL_PAIR_TABLE_SIZE materials to bound its size, other pairs are combined
+	// on the fly.
 	class PxsMaterialManager : public PxsMaterialManagerT<PxsMaterialCore>
 	{
+	public:
+		PxsMaterialManager()
+		{
+			combinedMaterials = reinterpret_cast<PxsCombinedMaterial*>(physx::PxAlignedAllocator<16>().allocate(sizeof(PxsCombinedMaterial)*PXS_MATERIAL_PAIR_TABLE_SIZE*PXS_MATERIAL_PAIR_TABLE_SIZE, PX_FL));
+		}
+
+		~PxsMaterialManager()
+		{
+			physx::PxAlignedAllocator<16>().deallocate(combinedMaterials);
+		}
+
+		void setMaterial(PxsMaterialCore* mat)
+		{
+			PxsMaterialManagerT<PxsMaterialCore>::setMaterial(mat);
+			updateCombinedMaterials(mat->mMaterialIndex);
+		}
+
+		void updateMaterial(PxsMaterialCore* mat)
+		{
+			PxsMaterialManagerT<PxsMaterialCore>::updateMaterial(mat);
+			updateCombinedMaterials(mat->mMaterialIndex);
+		}
+
+		// PT: returns NULL if the pair is not in the table
+		PX_FORCE_INLINE const PxsCombinedMaterial* getCombinedMaterial(PxU32 index0, PxU32 index1) const
+		{
+			if(index0 >= PXS_MATERIAL_PAIR_TABLE_SIZE || index1 >= PXS_MATERIAL_PAIR_TABLE_SIZE)
+				return NULL;
+			return &combinedMaterials[index0*PXS_MATERIAL_PAIR_TABLE_SIZE + index1];
+		}
+
+	private:
+		// PT: recomputes the pairs between a material and all valid materials. Pairs involving removed materials are
+		// left as they are, no shape can reference them anymore.
+		void updateCombinedMaterials(PxU32 index);
+
+		PxsCombinedMaterial* combinedMaterials;
 	};
 
 	class PxsDeformableSurfaceMaterialManager : public PxsMaterialManagerT<PxsDeformableSurfaceMaterialCore>
@@ -97,6 +97,10 @@ struct PxvSimStats
 	PxU32	mTotalCompressedContactSize;
 	PxU32	mTotalConstraintSize;
 	PxU32	mPeakConstraintBlockAllocations;
+	PxU32	mPeakContactBlockAllocations;
+
+	PxU32	mNbBroadPhaseUpdatedBounds;
+	PxU32	mNbSolverBatches[4];	// PT: per batch width, index = width-1
 
 	PxU32	mNbNewPairs;
 	PxU32	mNbLostPairs;
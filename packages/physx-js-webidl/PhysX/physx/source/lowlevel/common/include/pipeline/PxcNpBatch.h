@@ -30,6 +30,7 @@
 #define PXC_NP_BATCH_H
 
 #include "PxvConfig.h"
+#include "geometry/PxGeometry.h"
 
 namespace physx
 {
@@ -44,6 +45,18 @@ namespace physx
 
 	void PxcDiscreteNarrowPhase(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, Gu::Cache& cache, PxsContactManagerOutput& output, PxU64 contextID);
 	void PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, const PxcNpWorkUnit& cmInput, Gu::Cache& cache, PxsContactManagerOutput& output, PxU64 contextID);
+
+	// PT: batched versions of the above for up to 4 pairs of the same geometry types, using the 4-wide contact functions.
+	// Only the pairs for which PxcCanBatchNarrowPhase returns true are supported.
+	void PxcDiscreteNarrowPhase4(PxcNpThreadContext& context, const PxcNpWorkUnit* const* cmInputs, Gu::Cache* const* caches, PxsContactManagerOutput* const* outputs, PxU32 nb, PxU64 contextID);
+	void PxcDiscreteNarrowPhasePCM4(PxcNpThreadContext& context, const PxcNpWorkUnit* const* cmInputs, Gu::Cache* const* caches, PxsContactManagerOutput* const* outputs, PxU32 nb, PxU64 contextID);
+
+	PX_FORCE_INLINE bool PxcCanBatchNarrowPhase(PxGeometryType::Enum type0, PxGeometryType::Enum type1)
+	{
+		const PxGeometryType::Enum minType = type0<type1 ? type0 : type1;
+		const PxGeometryType::Enum maxType = type0<type1 ? type1 : type0;
+		return minType==PxGeometryType::eSPHERE && (maxType==PxGeometryType::eSPHERE || maxType==PxGeometryType::eCAPSULE);
+	}
 }
 
 #endif
@@ -61,7 +61,10 @@ public:
 	PxU32			getUsedBlockCount() const;
 	PxU32			getMaxUsedBlockCount() const;
 	PxU32			getPeakConstraintBlockCount() const;
-	void			releaseUnusedBlocks();
+	PxU32			getContactBlockCount() const	{ return mContacts[mContactIndex].size();	}
+	PxU32			getMaxUsedBlockCountSinceReset() const	{ return mMaxUsedBlocksSinceReset;	}
+	void			resetMaxUsedBlockCountSinceReset()		{ mMaxUsedBlocksSinceReset = mUsedBlocks;	}
+	PxU32			releaseUnusedBlocks();	// returns the number of released blocks
 
 	PxcNpMemBlock*	acquireConstraintBlock();
 	PxcNpMemBlock*	acquireConstraintBlock(PxcNpMemBlockArray& memBlocks);
@@ -101,6 +104,7 @@ private:
 	PxU32					mInitialBlocks;
 	PxU32					mUsedBlocks;
 	PxU32					mMaxUsedBlocks;
+	PxU32					mMaxUsedBlocksSinceReset;
 	PxcNpMemBlock*			mScratchBlockAddr;
 	PxU32					mNbScratchBlocks;
 	PxcScratchAllocator&	mScratchAllocator;
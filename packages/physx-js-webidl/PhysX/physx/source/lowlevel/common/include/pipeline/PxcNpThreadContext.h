@@ -42,6 +42,7 @@
 #include "PxcThreadCoherentCache.h"
 #include "PxcScratchAllocator.h"
 #include "foundation/PxBitMap.h"
+#include "foundation/PxArray.h"
 #include "../pcm/GuPersistentContactManifold.h"
 #include "../contact/GuContactMethodImpl.h"
 
@@ -50,6 +51,8 @@ namespace physx
 
 class PxsTransformCache;
 class PxsMaterialManager;
+class PxActor;
+class PxShape;
 
 namespace Sc
 {
@@ -60,6 +63,17 @@ namespace Sc
 Per-thread context used by contact generation routines.
 */
 
+// PT: narrowphase cost of a pair, recorded when the attribution mode is enabled. The user-level
+// objects are fetched immediately since the contact manager might be gone by the time we report.
+struct PxcNpPairCost
+{
+	const PxShape*	mShape0;
+	const PxShape*	mShape1;
+	const PxActor*	mActor0;
+	const PxActor*	mActor1;
+	PxU64			mTicks;
+};
+
 struct PxcDataStreamPool
 {
 	PxU8* mDataStream;
@@ -169,6 +183,7 @@ public:
 					bool						mPCM;
 					bool						mContactCache;
 					bool						mCreateAveragePoint;	// flag to enforce whether we create average points
+					bool						mQuantizeContacts;		// flag to enforce whether we write quantized contact streams
 #if PX_ENABLE_SIM_STATS
 					PxU32						mCompressedCacheSize;
 					PxU32						mNbDiscreteContactPairsWithCacheHits;
@@ -188,6 +203,9 @@ public:
 					PxcDataStreamPool*			mFrictionPatchStreamPool;
 					PxsMaterialManager*			mMaterialManager;
 
+					// PT: per-pair costs, only filled when PxsContext::getNarrowPhaseAttribution() is enabled
+					PxArray<PxcNpPairCost>		mPairCosts;
+
 private:
 		// change touch handling.
 					PxBitMap					mLocalChangeTouch;
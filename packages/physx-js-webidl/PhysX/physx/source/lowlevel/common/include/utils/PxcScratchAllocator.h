@@ -35,6 +35,7 @@
 #include "foundation/PxArray.h"
 #include "foundation/PxAllocator.h"
 #include "foundation/PxUserAllocated.h"
+#include "foundation/PxMath.h"
 
 namespace physx
 {
@@ -42,7 +43,7 @@ class PxcScratchAllocator : public PxUserAllocated
 {
 	PX_NOCOPY(PxcScratchAllocator)
 public:
-	PxcScratchAllocator() : mStack("PxcScratchAllocator"), mStart(NULL), mSize(0)
+	PxcScratchAllocator() : mStack("PxcScratchAllocator"), mStart(NULL), mSize(0), mPeakUsage(0), mHeapFallbackSize(0)
 	{
 		mStack.reserve(64);
 		mStack.pushBack(0);
@@ -62,6 +63,10 @@ public:
 		mStart = reinterpret_cast<PxU8*>(addr);
 		mSize = size;
 		mStack.pushBack(mStart + size);
+
+		// PT: the block is set once per simulation step, so that's where we reset the stats
+		mPeakUsage = 0;
+		mHeapFallbackSize = 0;
 	}
 
 	void* allocAll(PxU32& size)
@@ -90,12 +95,14 @@ public:
 		{
 			PxU8* addr = top - requestedSize;
 			mStack.pushBack(addr);
+			mPeakUsage = PxMax(mPeakUsage, PxU32(mStart + mSize - addr));
 			return addr;
 		}
 
 		if(!fallBackToHeap)
 			return NULL;
 
+		mHeapFallbackSize += requestedSize;
 		return PX_ALLOC(requestedSize, "Scratch Block Fallback");
 	}
 
@@ -119,6 +126,10 @@ public:
 		mStack.remove(i);
 	}
 
+	// PT: stats for the current simulation step. The peak usage doesn't include allocAll(), which grabs the remaining space.
+	PxU32 getPeakUsage()		const	{ return mPeakUsage;		}
+	PxU32 getHeapFallbackSize()	const	{ return mHeapFallbackSize;	}
+
 	bool isScratchAddr(void* addr) const
 	{
 		PxU8* a = reinterpret_cast<PxU8*>(addr);
@@ -130,6 +141,8 @@ private:
 	PxArray<PxU8*>		mStack;
 	PxU8*				mStart;
 	PxU32				mSize;
+	PxU32				mPeakUsage;
+	PxU32				mHeapFallbackSize;
 };
 
 }
@@ -39,6 +39,8 @@
 #include "PxsContactManagerState.h"
 #include "PxcNpThreadContext.h"
 #include "PxcMaterialMethodImpl.h"
+#include "GuContactMethodImpl.h"
+#include "PxShape.h"
 
 // PT: use this define to enable detailed analysis of the NP functions.
 //#define LOCAL_PROFILE_ZONE(x, y)	PX_PROFILE_ZONE(x, y)
@@ -73,6 +75,105 @@ static void flipContacts(PxcNpThreadContext& threadContext, PxsMaterialInfo* PX_
 	}
 }
 
+// PT: reduces mesh contacts to a single patch for PxShapeFlag::eREDUCE_MESH_CONTACTS. We keep the deepest contact, the contact
+// furthest from it, and the contacts spanning the largest area on each side of that edge. The kept contacts share the averaged
+// normal and the deepest contact's triangle index, so that the solver builds a single patch with a single material.
+static void reduceMeshContactsToPatch(PxContactBuffer& buffer)
+{
+	const PxU32 nb = buffer.count;
+	if(nb<2)
+		return;
+
+	const PxContactPoint* PX_RESTRICT contacts = buffer.contacts;
+
+	PxU32 deepest = 0;
+	for(PxU32 i=1; i<nb; i++)
+	{
+		if(contacts[i].separation<contacts[deepest].separation)
+			deepest = i;
+	}
+
+	// PT: the deepest normal is part of the sum so the result cannot be zero
+	const PxVec3 deepestNormal = contacts[deepest].normal;
+	PxVec3 normal(0.0f);
+	for(PxU32 i=0; i<nb; i++)
+	{
+		if(contacts[i].normal.dot(deepestNormal)>0.0f)
+			normal += contacts[i].normal;
+	}
+	normal.normalize();
+
+	PxU32 selected[4];
+	PxU32 nbSelected = 0;
+	if(nb<=4)
+	{
+		for(PxU32 i=0; i<nb; i++)
+			selected[nbSelected++] = i;
+	}
+	else
+	{
+		selected[nbSelected++] = deepest;
+		const PxVec3 p0 = contacts[deepest].point;
+
+		PxU32 furthest = deepest;
+		PxReal maxDist = 0.0f;
+		for(PxU32 i=0; i<nb; i++)
+		{
+			const PxReal d = (contacts[i].point - p0).magnitudeSquared();
+			if(d>maxDist)
+			{
+				maxDist = d;
+				furthest = i;
+			}
+		}
+
+		if(furthest!=deepest)
+		{
+			selected[nbSelected++] = furthest;
+
+			// PT: signed areas around the normal, one contact on each side of the edge
+			const PxVec3 edge = contacts[furthest].point - p0;
+			PxReal maxArea = 0.0f;
+			PxReal minArea = 0.0f;
+			PxU32 left = 0xffffffff;
+			PxU32 right = 0xffffffff;
+			for(PxU32 i=0; i<nb; i++)
+			{
+				const PxReal area = edge.cross(contacts[i].point - p0).dot(normal);
+				if(area>maxArea)
+				{
+					maxArea = area;
+					left = i;
+				}
+				else if(area<minArea)
+				{
+					minArea = area;
+					right = i;
+				}
+			}
+			if(left!=0xffffffff)
+				selected[nbSelected++] = left;
+			if(right!=0xffffffff)
+				selected[nbSelected++] = right;
+		}
+	}
+
+	PxContactPoint reduced[4];
+	const PxU32 faceIndex = contacts[deepest].internalFaceIndex1;
+	for(PxU32 i=0; i<nbSelected; i++)
+	{
+		reduced[i] = contacts[selected[i]];
+		// PT: project the penetration onto the shared normal
+		reduced[i].separation *= reduced[i].normal.dot(normal);
+		reduced[i].normal = normal;
+		reduced[i].internalFaceIndex1 = faceIndex;
+	}
+
+	for(PxU32 i=0; i<nbSelected; i++)
+		buffer.contacts[i] = reduced[i];
+	buffer.count = nbSelected;
+}
+
 static PX_FORCE_INLINE void updateDiscreteContactStats(PxcNpThreadContext& context, PxGeometryType::Enum type0, PxGeometryType::Enum type1)
 {
 #if PX_ENABLE_SIM_STATS
@@ -90,7 +191,7 @@ static bool copyBuffers(PxsContactManagerOutput& cmOutput, Gu::Cache& cache, Pxc
 {
 	bool ret = false;
 	//Copy the contact stream from previous buffer to current buffer...
-	PxU32 oldSize = sizeof(PxContact) * cmOutput.nbContacts + sizeof(PxContactPatch)*cmOutput.nbPatches;
+	PxU32 oldSize = cmOutput.getContactPointsSize() + sizeof(PxContactPatch)*cmOutput.nbPatches;
 	if(oldSize)
 	{
 		ret = true;
@@ -118,7 +219,7 @@ static bool copyBuffers(PxsContactManagerOutput& cmOutput, Gu::Cache& cache, Pxc
 		if(context.mContactStreamPool)
 		{
 			const PxU32 patchSize = cmOutput.nbPatches * sizeof(PxContactPatch);
-			const PxU32 contactSize = cmOutput.nbContacts * sizeof(PxContact);
+			const PxU32 contactSize = cmOutput.getContactPointsSize();
 
 			PxU32 index = PxU32(PxAtomicAdd(&context.mContactStreamPool->mSharedDataIndex, PxI32(contactSize)));
 			
@@ -296,7 +397,7 @@ static bool finishContacts(const PxcNpWorkUnit& input, PxsContactManagerOutput&
 		npOutput.frictionPatches, threadContext.mFrictionPatchStreamPool,
 		threadContext.mMaterialManager, ((input.mFlags & PxcNpWorkUnitFlag::eMODIFIABLE_CONTACT) != 0), 
 		false, pMaterials, npOutput.nbPatches, 0, NULL, NULL, threadContext.mCreateAveragePoint, threadContext.mContactStreamPool, 
-		threadContext.mPatchStreamPool, threadContext.mForceAndIndiceStreamPool, isMeshType) != 0;
+		threadContext.mPatchStreamPool, threadContext.mForceAndIndiceStreamPool, isMeshType, threadContext.mQuantizeContacts && !threadContext.mContactStreamPool) != 0;
 
 	//handle buffer overflow
 	if(!npOutput.nbContacts)
@@ -460,6 +561,12 @@ static PX_FORCE_INLINE void discreteNarrowPhase(PxcNpThreadContext& context, con
 
 	if(context.mContactBuffer.count)
 	{
+		if((type1==PxGeometryType::eTRIANGLEMESH || type1==PxGeometryType::eHEIGHTFIELD) && ((shape0->mShapeFlags | shape1->mShapeFlags) & PxShapeFlag::eREDUCE_MESH_CONTACTS))
+		{
+			LOCAL_PROFILE_ZONE("reduceMeshContacts", contextID);
+			reduceMeshContactsToPatch(context.mContactBuffer);
+		}
+
 		const PxcGetMaterialMethod materialMethod = g_GetMaterialMethodTable[type0][type1];
 		if(materialMethod)
 		{
@@ -479,9 +586,7 @@ static PX_FORCE_INLINE void discreteNarrowPhase(PxcNpThreadContext& context, con
 		if(isMultiManifold)
 		{
 			//Store the manifold back...
-			const PxU32 size = (sizeof(MultiPersistentManifoldHeader) +
-				manifold.mNumManifolds * sizeof(SingleManifoldHeader) +
-				manifold.mNumTotalContacts * sizeof(Gu::CachedMeshPersistentContact));
+			const PxU32 size = manifold.getBufferSize();
 
 			PxcNpCacheReserve(context.mNpCacheStreamPair, cache, size);
 
@@ -510,3 +615,141 @@ void physx::PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, const PxcNpWo
 	LOCAL_PROFILE_ZONE("PxcDiscreteNarrowPhasePCM", contextID);
 	discreteNarrowPhase<false>(context, input, cache, output, contextID);
 }
+
+template<bool useLegacyCodepath>
+static void discreteNarrowPhase4(PxcNpThreadContext& context, const PxcNpWorkUnit* const* inputs, Gu::Cache* const* caches, PxsContactManagerOutput* const* outputs, PxU32 nb, PxU64 contextID)
+{
+	PX_ASSERT(nb && nb<=4);
+
+	PxGeometryType::Enum type0 = inputs[0]->getGeomType0();
+	PxGeometryType::Enum type1 = inputs[0]->getGeomType1();
+	if(type1<type0)
+		PxSwap(type0, type1);
+	PX_ASSERT(PxcCanBatchNarrowPhase(type0, type1));
+
+	// PT: the 4-wide functions don't support the legacy contact cache, so we revert to the regular codepath when it's used
+	if(useLegacyCodepath && context.mContactCache && g_CanUseContactCache[type0][type1])
+	{
+		for(PxU32 i=0;i<nb;i++)
+			discreteNarrowPhase<true>(context, *inputs[i], *caches[i], *outputs[i], contextID);
+		return;
+	}
+
+	const bool sphereCapsule = type1==PxGeometryType::eCAPSULE;
+
+	PxVec4				spheres[4];
+	PxVec4				shapes1[4];
+	PxQuat				rotations1[4];
+	PxReal				halfHeights[4];
+	PxReal				contactDistances[4];
+	const PxsShapeCore*	shapeCores0[4];
+	const PxsShapeCore*	shapeCores1[4];
+	PxU32				indices[4];
+	bool				flips[4];
+
+	PxU32 nbActive = 0;
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxcNpWorkUnit& input = *inputs[i];
+		const PxGeometryType::Enum inputType0 = input.getGeomType0();
+		const PxGeometryType::Enum inputType1 = input.getGeomType1();
+		const bool flip = (inputType1<inputType0);
+
+		const PxsCachedTransform* cachedTransform0 = &context.mTransformCache->getTransformCache(input.mTransformCache0);
+		const PxsCachedTransform* cachedTransform1 = &context.mTransformCache->getTransformCache(input.mTransformCache1);
+
+		if(!checkContactsMustBeGenerated<useLegacyCodepath>(context, input, *caches[i], *outputs[i], cachedTransform0, cachedTransform1, flip, inputType0, inputType1))
+			continue;
+
+		const PxsShapeCore* shape0 = input.getShapeCore0();
+		const PxsShapeCore* shape1 = input.getShapeCore1();
+		if(flip)
+		{
+			PxSwap(shape0, shape1);
+			PxSwap(cachedTransform0, cachedTransform1);
+		}
+		PX_ASSERT(cachedTransform0->transform.isSane() && cachedTransform1->transform.isSane());
+
+		const PxU32 slot = nbActive++;
+		spheres[slot] = PxVec4(cachedTransform0->transform.p, shape0->mGeometry.get<const PxSphereGeometry>().radius);
+		if(sphereCapsule)
+		{
+			const PxCapsuleGeometry& capsuleGeom = shape1->mGeometry.get<const PxCapsuleGeometry>();
+			shapes1[slot] = PxVec4(cachedTransform1->transform.p, capsuleGeom.radius);
+			rotations1[slot] = cachedTransform1->transform.q;
+			halfHeights[slot] = capsuleGeom.halfHeight;
+		}
+		else
+		{
+			shapes1[slot] = PxVec4(cachedTransform1->transform.p, shape1->mGeometry.get<const PxSphereGeometry>().radius);
+		}
+		// PT: set by checkContactsMustBeGenerated for each pair
+		contactDistances[slot] = context.mNarrowPhaseParams.mContactDistance;
+		shapeCores0[slot] = shape0;
+		shapeCores1[slot] = shape1;
+		indices[slot] = i;
+		flips[slot] = flip;
+	}
+
+	if(!nbActive)
+		return;
+
+	// PT: pad the batch with dummy pairs that never touch
+	for(PxU32 i=nbActive;i<4;i++)
+	{
+		spheres[i] = PxVec4(0.0f);
+		shapes1[i] = PxVec4(0.0f);
+		rotations1[i] = PxQuat(PxIdentity);
+		halfHeights[i] = 0.0f;
+		contactDistances[i] = 0.0f;
+	}
+
+	PxContactPoint contacts[4];
+	PxU32 touchMask;
+	{
+		LOCAL_PROFILE_ZONE("conMethod4", contextID);
+		if(sphereCapsule)
+			touchMask = Gu::contactSphereCapsule4(spheres, shapes1, rotations1, halfHeights, contactDistances, contacts);
+		else
+			touchMask = Gu::contactSphereSphere4(spheres, shapes1, contactDistances, contacts, !useLegacyCodepath);
+	}
+
+	const PxcGetMaterialMethod materialMethod = g_GetMaterialMethodTable[type0][type1];
+
+	for(PxU32 slot=0;slot<nbActive;slot++)
+	{
+		const PxU32 i = indices[slot];
+		PxsContactManagerOutput& output = *outputs[i];
+
+		updateDiscreteContactStats(context, type0, type1);
+
+		startContacts(output, context);
+
+		PxsMaterialInfo materialInfo[1];
+		if(touchMask & (1<<slot))
+		{
+			const PxContactPoint& contact = contacts[slot];
+			context.mContactBuffer.contact(contact.point, contact.normal, contact.separation);
+
+			if(materialMethod)
+				materialMethod(shapeCores0[slot], shapeCores1[slot], context.mContactBuffer, materialInfo);
+
+			if(flips[slot])
+				flipContacts(context, materialInfo);
+		}
+
+		finishContacts(*inputs[i], output, context, materialInfo, false, contextID);
+	}
+}
+
+void physx::PxcDiscreteNarrowPhase4(PxcNpThreadContext& context, const PxcNpWorkUnit* const* inputs, Gu::Cache* const* caches, PxsContactManagerOutput* const* outputs, PxU32 nb, PxU64 contextID)
+{
+	LOCAL_PROFILE_ZONE("PxcDiscreteNarrowPhase4", contextID);
+	discreteNarrowPhase4<true>(context, inputs, caches, outputs, nb, contextID);
+}
+
+void physx::PxcDiscreteNarrowPhasePCM4(PxcNpThreadContext& context, const PxcNpWorkUnit* const* inputs, Gu::Cache* const* caches, PxsContactManagerOutput* const* outputs, PxU32 nb, PxU64 contextID)
+{
+	LOCAL_PROFILE_ZONE("PxcDiscreteNarrowPhasePCM4", contextID);
+	discreteNarrowPhase4<false>(context, inputs, caches, outputs, nb, contextID);
+}
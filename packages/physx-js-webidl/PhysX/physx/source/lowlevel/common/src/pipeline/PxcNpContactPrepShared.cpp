@@ -54,8 +54,64 @@ static PX_FORCE_INLINE void copyContactPoint(PxContact* PX_RESTRICT point, const
 	point->separation = cp->separation;
 }
 
+// PT: quantized streams store the first contact of each patch (the anchor) at full precision and the others as fp16 offsets from it.
+// The anchor may only be 8-byte aligned so we don't write it as a PxContact.
+static PX_FORCE_INLINE PxU8* writeQuantizedContactPoint(PxU8* PX_RESTRICT dst, const PxVec3& point, PxReal separation, PxVec3& anchor, bool isAnchor)
+{
+	if(isAnchor)
+	{
+		anchor = point;
+		PxReal* PX_RESTRICT data = reinterpret_cast<PxReal*>(dst);
+		data[0] = point.x;
+		data[1] = point.y;
+		data[2] = point.z;
+		data[3] = separation;
+		return dst + sizeof(PxContact);
+	}
+
+	PxQuantizedContact* PX_RESTRICT q = reinterpret_cast<PxQuantizedContact*>(dst);
+	const PxVec3 offset = point - anchor;
+	q->offset[0] = PxQuantizedContact::encode(offset.x);
+	q->offset[1] = PxQuantizedContact::encode(offset.y);
+	q->offset[2] = PxQuantizedContact::encode(offset.z);
+	q->separation = PxQuantizedContact::encode(separation);
+	return dst + sizeof(PxQuantizedContact);
+}
+
+void PxsMaterialManager::updateCombinedMaterials(PxU32 index)
+{
+	if(index >= PXS_MATERIAL_PAIR_TABLE_SIZE)
+		return;
+
+	const PxsMaterialData& data = materials[index];
+	const PxU32 nb = PxMin(maxMaterials, PxU32(PXS_MATERIAL_PAIR_TABLE_SIZE));
+	for(PxU32 i=0; i<nb; i++)
+	{
+		if(materials[i].mMaterialIndex == MATERIAL_INVALID_HANDLE)
+			continue;
+
+		// PT: the combine rules are order-dependent in the compliant cases, so both orders are stored
+		PxsCombinedMaterial& c0 = combinedMaterials[index*PXS_MATERIAL_PAIR_TABLE_SIZE + i];
+		PxsCombineMaterials(data, materials[i], c0.mStaticFriction, c0.mDynamicFriction, c0.mRestitution, c0.mFlags, c0.mDamping);
+
+		PxsCombinedMaterial& c1 = combinedMaterials[i*PXS_MATERIAL_PAIR_TABLE_SIZE + index];
+		PxsCombineMaterials(materials[i], data, c1.mStaticFriction, c1.mDynamicFriction, c1.mRestitution, c1.mFlags, c1.mDamping);
+	}
+}
+
 void combineMaterials(const PxsMaterialManager* materialManager, PxU16 origMatIndex0, PxU16 origMatIndex1, PxReal& staticFriction, PxReal& dynamicFriction, PxReal& combinedRestitution, PxU32& materialFlags, PxReal& combinedDamping)
 {
+	const PxsCombinedMaterial* combined = materialManager->getCombinedMaterial(origMatIndex0, origMatIndex1);
+	if(combined)
+	{
+		staticFriction = combined->mStaticFriction;
+		dynamicFriction = combined->mDynamicFriction;
+		combinedRestitution = combined->mRestitution;
+		materialFlags = combined->mFlags;
+		combinedDamping = combined->mDamping;
+		return;
+	}
+
 	const PxsMaterialData& data0 = *materialManager->getMaterial(origMatIndex0);
 	const PxsMaterialData& data1 = *materialManager->getMaterial(origMatIndex1);
 
@@ -76,7 +132,7 @@ PxU32 physx::writeCompressedContact(const PxContactPoint* const PX_RESTRICT cont
 									PxU8*& outFrictionPatches, PxcDataStreamPool* frictionPatchesStreamPool,
 									const PxsMaterialManager* materialManager, bool hasModifiableContacts, bool forceNoResponse, const PxsMaterialInfo* PX_RESTRICT pMaterial, PxU8& numPatches,
 									PxU32 additionalHeaderSize, PxsConstraintBlockManager* manager, PxcConstraintBlockStream* blockStream, bool insertAveragePoint,
-									PxcDataStreamPool* contactStreamPool, PxcDataStreamPool* patchStreamPool, PxcDataStreamPool* forceStreamPool, const bool isMeshType)
+									PxcDataStreamPool* contactStreamPool, PxcDataStreamPool* patchStreamPool, PxcDataStreamPool* forceStreamPool, const bool isMeshType, const bool quantizeContacts)
 {
 	if(numContactPoints == 0)
 	{
@@ -177,8 +233,10 @@ PxU32 physx::writeCompressedContact(const PxContactPoint* const PX_RESTRICT cont
 	//Calculate the number of patches/points required
 
 	const bool isModifiable = !forceNoResponse && hasModifiableContacts;
+	const bool isQuantized = quantizeContacts && !isModifiable;
 	const PxU32 patchHeaderSize = sizeof(PxContactPatch) * (isModifiable ? totalContactPoints : totalUniquePatches) + additionalHeaderSize;
-	const PxU32 pointSize = totalContactPoints * (isModifiable ? sizeof(PxModifiableContact) : sizeof(PxContact));
+	const PxU32 pointSize = isQuantized ?	totalUniquePatches * sizeof(PxContact) + (totalContactPoints - totalUniquePatches) * sizeof(PxQuantizedContact) :
+											totalContactPoints * (isModifiable ? sizeof(PxModifiableContact) : sizeof(PxContact));
 
 	const PxU32 requiredContactSize = pointSize;
 	const PxU32 requiredPatchSize = patchHeaderSize;
@@ -350,7 +408,7 @@ PxU32 physx::writeCompressedContact(const PxContactPoint* const PX_RESTRICT cont
 			//KS - we could probably compress this further into the header but the complexity might not be worth it
 			patch->nbContacts = rootPatch.totalCount;
 			patch->materialFlags = PxU8(materialFlags_);
-			patch->internalFlags = PxU8(flags);
+			patch->internalFlags = PxU16(flags);
 			patch->materialIndex0 = matIndex0;
 			patch->materialIndex1 = matIndex1;
 		}
@@ -463,9 +521,12 @@ PxU32 physx::writeCompressedContact(const PxContactPoint* const PX_RESTRICT cont
 	}
 	else 
 	{
-		PxU32 flags = PxU32(isMeshType ? PxContactPatch::eHAS_FACE_INDICES : 0);
+		PxU32 flags = PxU32(isMeshType ? PxContactPatch::eHAS_FACE_INDICES : 0) |
+			(isQuantized ? PxContactPatch::eQUANTIZED_CONTACTS : 0);
 
 		PxContact* PX_RESTRICT point = reinterpret_cast<PxContact*>(contactData);
+		PxU8* PX_RESTRICT quantizedPoint = contactData;
+		PxVec3 anchor(0.0f);
 		
 		PxU32 currentIndex = 0;
 		{
@@ -515,8 +576,15 @@ PxU32 physx::writeCompressedContact(const PxContactPoint* const PX_RESTRICT cont
 							*faceIndice = contactPoints[p.startIndex].internalFaceIndex1;
 							faceIndice++;
 						}
-						point->contact = avgPt * recipCount;
-						point->separation = avgPen * recipCount;
+						if(isQuantized)
+						{
+							quantizedPoint = writeQuantizedContactPoint(quantizedPoint, avgPt * recipCount, avgPen * recipCount, anchor, true);
+						}
+						else
+						{
+							point->contact = avgPt * recipCount;
+							point->separation = avgPen * recipCount;
+						}
 						
 						point++;
 						currentIndex++;
@@ -529,7 +597,10 @@ PxU32 physx::writeCompressedContact(const PxContactPoint* const PX_RESTRICT cont
 						StridePatch& p = stridePatches[index];
 						for(PxU32 b = p.startIndex; b < p.endIndex; ++b)
 						{
-							copyContactPoint(point, &contactPoints[b]);
+							if(isQuantized)
+								quantizedPoint = writeQuantizedContactPoint(quantizedPoint, contactPoints[b].point, contactPoints[b].separation, anchor, currentIndex == patch->startContactIndex);
+							else
+								copyContactPoint(point, &contactPoints[b]);
 							if (faceIndice)
 							{
 								*faceIndice = contactPoints[b].internalFaceIndex1;
@@ -46,6 +46,7 @@ PxcNpMemBlockPool::PxcNpMemBlockPool(PxcScratchAllocator& allocator) :
 	mMaxBlocks(0),
 	mUsedBlocks(0),
 	mMaxUsedBlocks(0),
+	mMaxUsedBlocksSinceReset(0),
 	mScratchBlockAddr(0),
 	mNbScratchBlocks(0),
 	mScratchAllocator(allocator),
@@ -99,15 +100,17 @@ void PxcNpMemBlockPool::setBlockCount(PxU32 blockCount)
 	}
 }
 
-void PxcNpMemBlockPool::releaseUnusedBlocks()
+PxU32 PxcNpMemBlockPool::releaseUnusedBlocks()
 {
 	PxMutex::ScopedLock lock(mLock);
+	const PxU32 nbReleased = mUnused.size();
 	while(mUnused.size())
 	{
 		PxcNpMemBlock* ptr = mUnused.popBack();
 		PX_FREE(ptr);
 		mAllocatedBlocks--;
 	}
+	return nbReleased;
 }
 
 PxcNpMemBlockPool::~PxcNpMemBlockPool()
@@ -202,6 +205,7 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 		PxcNpMemBlock* block = mUnused.popBack();
 		trackingArray.pushBack(block);
 		mMaxUsedBlocks = PxMax<PxU32>(mUsedBlocks+1, mMaxUsedBlocks);
+		mMaxUsedBlocksSinceReset = PxMax<PxU32>(mUsedBlocks+1, mMaxUsedBlocksSinceReset);
 		mUsedBlocks++;
 		return block;
 	}	
@@ -232,6 +236,7 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 	{
 		trackingArray.pushBack(block);
 		mMaxUsedBlocks = PxMax<PxU32>(mUsedBlocks+1, mMaxUsedBlocks);
+		mMaxUsedBlocksSinceReset = PxMax<PxU32>(mUsedBlocks+1, mMaxUsedBlocksSinceReset);
 		mUsedBlocks++;
 	}
 	else
@@ -39,6 +39,7 @@ PxcNpThreadContext::PxcNpThreadContext(PxcNpContext* params) :
 	mPCM								(false),
 	mContactCache						(false),
 	mCreateAveragePoint					(false),
+	mQuantizeContacts					(false),
 #if PX_ENABLE_SIM_STATS
 	mCompressedCacheSize				(0),
 	mNbDiscreteContactPairsWithCacheHits(0),
@@ -30,6 +30,7 @@
 #define PXS_CONTACT_MANAGER_STATE_H
 
 #include "foundation/PxSimpleTypes.h"
+#include "PxContact.h"
 
 namespace physx
 {
@@ -83,6 +84,14 @@ namespace physx
 		{
 			return contactForces ? reinterpret_cast<PxU32*>(contactForces + nbContacts) : NULL;
 		}
+
+		// PT: size of the contact points of a non-modifiable stream. Quantized streams store one full PxContact per patch.
+		PX_FORCE_INLINE PxU32 getContactPointsSize()	const
+		{
+			if(nbContacts && (reinterpret_cast<const PxContactPatch*>(contactPatches)->internalFlags & PxContactPatch::eQUANTIZED_CONTACTS))
+				return sizeof(PxContact) * nbPatches + sizeof(PxQuantizedContact) * (nbContacts - nbPatches);
+			return sizeof(PxContact) * nbContacts;
+		}
 	} 
 	PX_ALIGN_SUFFIX(16);
 	PX_COMPILE_TIME_ASSERT((sizeof(PxsContactManagerOutput) & 0xf) == 0);
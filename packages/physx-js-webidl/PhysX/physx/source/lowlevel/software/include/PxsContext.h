@@ -108,6 +108,8 @@ public:
 
     // resource-related
 					void						setScratchBlock(void* addr, PxU32 size);
+					// Releases empty contact manager & manifold slabs and unused contact stream blocks. Returns the number of released bytes.
+					PxU32						compactMemory();
 
 	PX_FORCE_INLINE	void						setContactDistance(const PxFloatArrayPinned* contactDistances)	{ mContactDistances = contactDistances;	}
 
@@ -158,6 +160,12 @@ public:
 	PX_FORCE_INLINE	bool						getPCM()					const	{ return mPCM;														}
 	PX_FORCE_INLINE	bool						getContactCacheFlag()		const	{ return mContactCache;												}
 	PX_FORCE_INLINE	bool						getCreateAveragePoint()		const	{ return mCreateAveragePoint;										}
+	PX_FORCE_INLINE	bool						getQuantizeContacts()		const	{ return mQuantizeContacts;											}
+
+	PX_FORCE_INLINE	void						setNarrowPhaseAttribution(bool enabled)	{ mNarrowPhaseAttribution = enabled;						}
+	PX_FORCE_INLINE	bool						getNarrowPhaseAttribution()	const	{ return mNarrowPhaseAttribution;									}
+	// PT: per-pair narrowphase costs of the last step, gathered from the thread contexts in mergeCMDiscreteUpdateResults()
+	PX_FORCE_INLINE	const PxArray<PxcNpPairCost>&	getNarrowPhasePairCosts()	const	{ return mNpPairCosts;										}
 
 	// general stuff
 					void						shiftOrigin(const PxVec3& shift);
@@ -167,6 +175,7 @@ public:
 
 	PX_FORCE_INLINE	PxcScratchAllocator&		getScratchAllocator()					{ return mScratchAllocator;		}
 	PX_FORCE_INLINE PxsTransformCache&			getTransformCache()						{ return *mTransformCache;		}
+	PX_FORCE_INLINE const PxsTransformCache&	getTransformCache()				const	{ return *mTransformCache;		}
 	PX_FORCE_INLINE const PxReal*				getContactDistances()		const		{ return mContactDistances->begin(); }
 
 	PX_FORCE_INLINE	PxvNphaseImplementationContext*	getNphaseImplementationContext()			const							{ return mNpImplementationContext;			}
@@ -275,6 +284,10 @@ private:
 					bool						mPCM;
 					bool						mContactCache;
 					bool						mCreateAveragePoint;
+					bool						mQuantizeContacts;
+					bool						mNarrowPhaseAttribution;
+
+					PxArray<PxcNpPairCost>		mNpPairCosts;
 
 					PxsTransformCache*			mTransformCache;
 					const PxFloatArrayPinned*	mContactDistances;
@@ -416,10 +416,11 @@ class IslandSim
 	//Input list of changes observed this frame. If there no changes, no work to be done.
 	PxArray<EdgeIndex>								mDirtyEdges[Edge::eEDGE_TYPE_COUNT];
 	//Dirty nodes. These nodes lost at least one connection so we need to recompute islands from these nodes
-	//PxArray<NodeIndex>							mDirtyNodes;
-	PxBitMap										mDirtyMap;
 #if IG_LIMIT_DIRTY_NODES
+	PxBitMap										mDirtyMap;
 	PxU32											mLastMapIndex;
+#else
+	PxArray<PxU32>									mDirtyNodes;
 #endif
 	//An array of nodes to activate
 	PxArray<PxNodeIndex>							mActivatingNodes;
@@ -430,6 +431,7 @@ class IslandSim
 	Cm::PriorityQueue<QueueElement, NodeComparator>	mPriorityQueue;								//! Priority queue used for graph traversal
 	PxArray<TraversalState>							mVisitedNodes;								//! The list of nodes visited in the current traversal
 	PxBitMap										mVisitedState;								//! Indicates whether a node has been visited
+	PxArray<PxU32>									mVisitedStateNodes;							//! Nodes flagged in mVisitedState, to reset them after the traversals
 	PxArray<EdgeIndex>								mIslandSplitEdges[Edge::eEDGE_TYPE_COUNT];
 
 	PxArray<EdgeIndex>								mDeactivatingEdges[Edge::eEDGE_TYPE_COUNT];
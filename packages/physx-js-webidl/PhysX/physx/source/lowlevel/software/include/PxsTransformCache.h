@@ -80,6 +80,17 @@ namespace physx
 			mUsedSize = PxMax(mUsedSize, index + 1u);
 		}
 
+		// PT: grows the capacity without touching the used size, for batch insertions
+		void reserve(PxU32 nbEntries)
+		{
+			if (nbEntries > mTransformCache.capacity())
+			{
+				const PxU32 newCapacity = PxNextPowerOfTwo(nbEntries);
+				mTransformCache.reserve(newCapacity);
+				mTransformCache.forceSize_Unsafe(newCapacity);
+			}
+		}
+
 		PX_FORCE_INLINE void setTransformCache(const PxTransform& transform, PxU32 flags, PxU32 index, PxU32 /*indexFrom*/)
 		{
 			mTransformCache[index].transform = transform;
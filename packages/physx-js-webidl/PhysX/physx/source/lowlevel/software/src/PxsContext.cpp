@@ -67,6 +67,8 @@ PxsContext::PxsContext(const PxSceneDesc& desc, PxTaskManager* taskManager, Cm::
 	mPCM							(desc.flags & PxSceneFlag::eENABLE_PCM),
 	mContactCache					(false),
 	mCreateAveragePoint				(desc.flags & PxSceneFlag::eENABLE_AVERAGE_POINT),
+	mQuantizeContacts				(desc.flags & PxSceneFlag::eENABLE_QUANTIZED_CONTACTS),
+	mNarrowPhaseAttribution			(false),
 	mContextID						(contextID)
 {
 	clearManagerTouchEvents();
@@ -74,7 +76,11 @@ PxsContext::PxsContext(const PxSceneDesc& desc, PxTaskManager* taskManager, Cm::
 
 	PxMemZero(mVisualizationParams, sizeof(PxReal) * PxVisualizationParameter::eNUM_VALUES);
 
-	mNpMemBlockPool.init(desc.nbContactDataBlocks, desc.maxNbContactDataBlocks);
+	// PT: the memory budget caps the number of blocks the pool can ever allocate
+	PxU32 maxNbBlocks = desc.maxNbContactDataBlocks;
+	if(desc.simulationMemoryBudget)
+		maxNbBlocks = PxMin(maxNbBlocks, desc.simulationMemoryBudget / PxU32(PxcNpMemBlock::SIZE));
+	mNpMemBlockPool.init(desc.nbContactDataBlocks, maxNbBlocks);
 }
 
 PxsContext::~PxsContext()
@@ -350,6 +356,16 @@ void PxsContext::setScratchBlock(void* addr, PxU32 size)
 	mScratchAllocator.setBlock(addr, size);
 }
 
+PxU32 PxsContext::compactMemory()
+{
+	PxU32 nbReleased = mContactManagerPool.releaseEmptySlabs();
+	nbReleased += mManifoldPool.releaseEmptySlabs();
+	nbReleased += mSphereManifoldPool.releaseEmptySlabs();
+
+	nbReleased += mNpMemBlockPool.releaseUnusedBlocks() * PxcNpMemBlock::SIZE;
+	return nbReleased;
+}
+
 void PxsContext::shiftOrigin(const PxVec3& shift)
 {
 	// transform cache
@@ -474,6 +490,15 @@ void PxsContext::mergeCMDiscreteUpdateResults(PxBaseTask* /*continuation*/)
 		mMaxPatches = PxMax(mMaxPatches, threadContext->mMaxPatches);
 
 		threadContext->mMaxPatches = 0;
+
+		const PxU32 nbPairCosts = threadContext->mPairCosts.size();
+		if(nbPairCosts)
+		{
+			const PxU32 offset = mNpPairCosts.size();
+			mNpPairCosts.resizeUninitialized(offset + nbPairCosts);
+			PxMemCopy(mNpPairCosts.begin() + offset, threadContext->mPairCosts.begin(), sizeof(PxcNpPairCost)*nbPairCosts);
+			threadContext->mPairCosts.forceSize_Unsafe(0);
+		}
 	}
 }
 
@@ -504,6 +529,9 @@ void PxsContext::resetThreadContexts()
 	PxcThreadCoherentCacheIterator<PxcNpThreadContext, PxcNpContext> threadContextIt(mNpThreadContextPool);
 	PxcNpThreadContext* threadContext = threadContextIt.getNext();
 
+	// PT: the pair costs are reported for the last step only
+	mNpPairCosts.forceSize_Unsafe(0);
+
 	while(threadContext != NULL)
 	{
 		threadContext->reset(mContactManagerTouchEvent.size());
@@ -313,8 +313,11 @@ void IslandSim::removeConnectionFromGraph(EdgeIndex edgeIndex)
 			mFastRoute[index1].setIndices(PX_INVALID_NODE);
 		if(!node.isDirty())
 		{
-			//mDirtyNodes.pushBack(nodeIndex1);
+#if IG_LIMIT_DIRTY_NODES
 			mDirtyMap.growAndSet(index1);
+#else
+			mDirtyNodes.pushBack(index1);
+#endif
 			node.markDirty();
 		}
 	}
@@ -326,7 +329,11 @@ void IslandSim::removeConnectionFromGraph(EdgeIndex edgeIndex)
 			mFastRoute[index2].setIndices(PX_INVALID_NODE);
 		if(!node.isDirty())
 		{
+#if IG_LIMIT_DIRTY_NODES
 			mDirtyMap.growAndSet(index2);
+#else
+			mDirtyNodes.pushBack(index2);
+#endif
 			node.markDirty();
 		}
 	}
@@ -1184,8 +1191,9 @@ void IslandSim::processLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, boo
 	PX_PROFILE_ZONE("Basic.processLostEdges", mContextId);
 	//At this point, all nodes and edges are activated. 
 
-	//Bit map for visited
-	mVisitedState.resizeAndClear(mNodes.size());
+	//Bit map for visited. PT: this is not cleared here, the bits set by the traversals are reset at the end of the traversals instead.
+	//That way the cost only depends on the number of nodes that lost an edge, not on the total number of nodes.
+	mVisitedState.resize(mNodes.size());
 
 	//Reserve space on priority queue for at least 1024 nodes. It will resize if more memory is required during traversal.
 	mPriorityQueue.reserve(1024);
@@ -1271,22 +1279,34 @@ void IslandSim::processLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, boo
 		const PxU32 MaxCount = dirtyNodeLimit;// +10000000;
 		PxU32 lastMapIndex = mLastMapIndex;
 		PxU32 count = 0;
-#else
-		PxBitMap::Iterator iter(mDirtyMap);
-#endif
 
 		PxU32 dirtyIdx;
 
-#if IG_LIMIT_DIRTY_NODES
 		while ((dirtyIdx = iter.getNext()) != PxBitMap::PxCircularIterator::DONE
 			&& (count++ < MaxCount)
-#else
-		while ((dirtyIdx = iter.getNext()) != PxBitMap::Iterator::DONE
-#endif
 			)
 		{
-#if IG_LIMIT_DIRTY_NODES
 			lastMapIndex = dirtyIdx + 1;
+#else
+		//PT: dirty nodes are sorted (and duplicates removed) so that they're processed in increasing index order, as they
+		//would be when iterating over a bitmap. Islands that did not lose an edge are never touched here.
+		PxU32 nbDirtyNodes = mDirtyNodes.size();
+		if(nbDirtyNodes > 1)
+		{
+			PxSort(mDirtyNodes.begin(), nbDirtyNodes);
+
+			PxU32 nbUnique = 1;
+			for(PxU32 a = 1; a < nbDirtyNodes; ++a)
+			{
+				if(mDirtyNodes[a] != mDirtyNodes[nbUnique - 1])
+					mDirtyNodes[nbUnique++] = mDirtyNodes[a];
+			}
+			nbDirtyNodes = nbUnique;
+		}
+
+		for (PxU32 d = 0; d < nbDirtyNodes; ++d)
+		{
+			const PxU32 dirtyIdx = mDirtyNodes[d];
 #endif
 			//Process dirty nodes. Figure out if we can make our way from the dirty node to the root.
 
@@ -1520,6 +1540,8 @@ void IslandSim::processLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, boo
 #if IG_LIMIT_DIRTY_NODES
 			mDirtyMap.reset(dirtyIdx);
 #endif
+			for (PxU32 b = 0; b < mVisitedNodes.size(); ++b)
+				mVisitedStateNodes.pushBack(mVisitedNodes[b].mNodeIndex.index());
 		}
 
 #if IG_LIMIT_DIRTY_NODES
@@ -1527,9 +1549,14 @@ void IslandSim::processLostEdges(const PxArray<PxNodeIndex>& destroyedNodes, boo
 		if (count < MaxCount)
 			mLastMapIndex = 0;
 #else
-		mDirtyMap.clear();
+		mDirtyNodes.forceSize_Unsafe(0);
 #endif
 
+		const PxU32 nbVisitedStateNodes = mVisitedStateNodes.size();
+		for (PxU32 a = 0; a < nbVisitedStateNodes; ++a)
+			mVisitedState.reset(mVisitedStateNodes[a]);
+		mVisitedStateNodes.forceSize_Unsafe(0);
+
 		//mDirtyNodes.forceSize_Unsafe(0);
 	}
 
@@ -30,6 +30,7 @@
 #include "CmFlushPool.h"
 #include "PxsPartitionEdge.h"
 #include "common/PxProfileZone.h"
+#include "foundation/PxTime.h"
 
 #if PX_SUPPORT_GPU_PHYSX
 #include "PxPhysXGpu.h"
@@ -142,7 +143,9 @@ public:
 			PX_ALLOCA(mModifiablePairArray, PxContactModifyPair, nbModifiableManagers);
 
 			PxsTransformCache& transformCache = mContext->getTransformCache();
-		
+
+			// PT: pairs without contacts are not passed to the callback, so that it never sees uninitialized entries
+			PxU32 nbModifiablePairs = 0;
 			for(PxU32 i = 0; i < nbModifiableManagers; ++i)
 			{
 				const PxU32 index = modifiableIndices[i];
@@ -154,7 +157,7 @@ public:
 	
 				if(count)
 				{
-					PxContactModifyPair& p = mModifiablePairArray[i];
+					PxContactModifyPair& p = mModifiablePairArray[nbModifiablePairs++];
 					const PxcNpWorkUnit& unit = cm.getWorkUnit();
 
 					p.shape[0] = gPxvOffsetTable.convertPxsShape2Px(unit.getShapeCore0());
@@ -191,7 +194,8 @@ public:
 	
 			{
 				PX_PROFILE_ZONE("USERCODE - PxContactModifyCallback::onContactModify", mContext->getContextId());
-				mCallback->onContactModify(mModifiablePairArray, nbModifiableManagers);
+				if(nbModifiablePairs)
+					mCallback->onContactModify(mModifiablePairArray, nbModifiablePairs);
 			}
 		}
 	
@@ -399,7 +403,61 @@ public:
 		maxPatches_ = maxPatches;
 	}
 
-	template < void (*NarrowPhase)(PxcNpThreadContext&, const PxcNpWorkUnit&, Gu::Cache&, PxsContactManagerOutput&, PxU64)>
+	static PX_FORCE_INLINE PxU32 getGeomTypesKey(const PxcNpWorkUnit& unit)
+	{
+		const PxU32 type0 = unit.getGeomType0();
+		const PxU32 type1 = unit.getGeomType1();
+		return type0<=type1 ? (type0<<4)|type1 : (type1<<4)|type0;	// PT: same contact function for (A,B) and (B,A)
+	}
+
+	// PT: computes the processing order of the task's pairs, sorted by (sorted) geometry types. This is a stable counting sort,
+	// so pairs of the same types are still processed in their original order.
+	static void sortByGeomTypes(PxU32* PX_RESTRICT sorted, PxsContactManager* const* PX_RESTRICT cmArray, PxU32 nb)
+	{
+		PX_COMPILE_TIME_ASSERT(PxGeometryType::eGEOMETRY_COUNT<=16);
+		const PxU32 nbBuckets = 16*16;
+
+		PX_ALLOCA(keys, PxU8, nb);
+		PxU32 histogram[nbBuckets];
+		PxMemZero(histogram, sizeof(PxU32)*nbBuckets);
+
+		for(PxU32 i=0;i<nb;i++)
+		{
+			const PxU32 key = cmArray[i] ? getGeomTypesKey(cmArray[i]->getWorkUnit()) : 0;
+			keys[i] = PxU8(key);
+			histogram[key]++;
+		}
+
+		PxU32 offset = 0;
+		for(PxU32 i=0;i<nbBuckets;i++)
+		{
+			const PxU32 count = histogram[i];
+			histogram[i] = offset;
+			offset += count;
+		}
+
+		for(PxU32 i=0;i<nb;i++)
+			sorted[histogram[keys[i]]++] = i;
+	}
+
+	// PT: records the narrowphase cost of a pair for the attribution mode. We fetch the user-level objects immediately,
+	// the same way runModifiableContactManagers() does.
+	static PX_NOINLINE void recordPairCost(PxcNpThreadContext& threadContext, const PxcNpWorkUnit& unit, PxU64 ticks)
+	{
+		PxcNpPairCost& cost = threadContext.mPairCosts.insert();
+		cost.mShape0 = gPxvOffsetTable.convertPxsShape2Px(unit.getShapeCore0());
+		cost.mShape1 = gPxvOffsetTable.convertPxsShape2Px(unit.getShapeCore1());
+		cost.mActor0 = unit.mFlags & (PxcNpWorkUnitFlag::eDYNAMIC_BODY0 | PxcNpWorkUnitFlag::eARTICULATION_BODY0) ?
+							gPxvOffsetTable.convertPxsRigidCore2PxRigidBody(unit.mRigidCore0)
+						:	gPxvOffsetTable.convertPxsRigidCore2PxRigidStatic(unit.mRigidCore0);
+		cost.mActor1 = unit.mFlags & (PxcNpWorkUnitFlag::eDYNAMIC_BODY1 | PxcNpWorkUnitFlag::eARTICULATION_BODY1) ?
+							gPxvOffsetTable.convertPxsRigidCore2PxRigidBody(unit.mRigidCore1)
+						:	gPxvOffsetTable.convertPxsRigidCore2PxRigidStatic(unit.mRigidCore1);
+		cost.mTicks = ticks;
+	}
+
+	template < void (*NarrowPhase)(PxcNpThreadContext&, const PxcNpWorkUnit&, Gu::Cache&, PxsContactManagerOutput&, PxU64),
+				void (*NarrowPhase4)(PxcNpThreadContext&, const PxcNpWorkUnit* const*, Gu::Cache* const*, PxsContactManagerOutput* const*, PxU32, PxU64)>
 	void processCms(PxcNpThreadContext* threadContext)
 	{
 		const PxU64 contextID = mContext->getContextId();
@@ -417,18 +475,109 @@ public:
 		PX_ALLOCA(modifiableIndices, PxU32, nb);
 		PxU32 modifiableCount = 0;
 
-		for(PxU32 i=0;i<nb;i++)
+		// PT: attribution mode, timing each narrowphase call. Batched pairs share the cost of the batch evenly.
+		const bool attribution = mContext->getNarrowPhaseAttribution();
+
+		// PT: first pass: run the narrowphase on pairs bucketed by geometry types, so that consecutive calls go through the same contact
+		// function. The results are then processed in the original order in the second pass, so that the found/lost & modifiable pairs
+		// are reported in the same order as before.
+		PX_ALLOCA(oldStatusFlags, PxU8, nb);
 		{
-			const PxU32 prefetch1 = PxMin(i + 1, nb - 1);
-			const PxU32 prefetch2 = PxMin(i + 2, nb - 1);
+			PX_ALLOCA(sorted, PxU32, nb);
+			sortByGeomTypes(sorted, cmArray, nb);
+
+			PxU32 j = 0;
+			while(j<nb)
+			{
+				const PxU32 i = sorted[j];
+
+				const PxU32 prefetch1 = sorted[PxMin(j + 1, nb - 1)];
+				const PxU32 prefetch2 = sorted[PxMin(j + 2, nb - 1)];
+
+				PxPrefetchLine(cmArray[prefetch2]);
+				PxPrefetchLine(&mCmOutputs[prefetch2]);
+				if(cmArray[prefetch1])
+				{
+					PxPrefetchLine(cmArray[prefetch1]->getWorkUnit().getShapeCore0());
+					PxPrefetchLine(cmArray[prefetch1]->getWorkUnit().getShapeCore1());
+					PxPrefetchLine(&threadContext->mTransformCache->getTransformCache(cmArray[prefetch1]->getWorkUnit().mTransformCache0));
+					PxPrefetchLine(&threadContext->mTransformCache->getTransformCache(cmArray[prefetch1]->getWorkUnit().mTransformCache1));
+				}
+
+				PxsContactManager* const cm = cmArray[i];
+				if(!cm)
+				{
+					j++;
+					continue;
+				}
+
+				const PxcNpWorkUnit& unit = cm->getWorkUnit();
+				if(PxcCanBatchNarrowPhase(unit.getGeomType0(), unit.getGeomType1()))
+				{
+					// PT: gather up to 4 consecutive pairs of the same types and process them with the 4-wide contact functions.
+					// Null managers are skipped here since they end up in the same bucket as sphere-sphere pairs.
+					const PxU32 key = getGeomTypesKey(unit);
+
+					const PxcNpWorkUnit* units[4];
+					Gu::Cache* caches[4];
+					PxsContactManagerOutput* outputs[4];
+					PxU32 nbBatched = 0;
+					while(j<nb && nbBatched<4)
+					{
+						const PxU32 index = sorted[j];
+						PxsContactManager* const batchedCM = cmArray[index];
+						if(batchedCM)
+						{
+							const PxcNpWorkUnit& batchedUnit = batchedCM->getWorkUnit();
+							if(getGeomTypesKey(batchedUnit)!=key)
+								break;
+
+							PxsContactManagerOutput& output = mCmOutputs[index];
+
+							output.prevPatches = output.nbPatches;
+							oldStatusFlags[index] = output.statusFlag;
+
+							units[nbBatched] = &batchedUnit;
+							caches[nbBatched] = &mCaches[index];
+							outputs[nbBatched] = &output;
+							nbBatched++;
+						}
+						j++;
+					}
+
+					if(attribution)
+					{
+						const PxU64 startTime = PxTime::getCurrentCounterValue();
+						NarrowPhase4(*threadContext, units, caches, outputs, nbBatched, contextID);
+						const PxU64 ticks = (PxTime::getCurrentCounterValue() - startTime) / nbBatched;
+						for(PxU32 k=0;k<nbBatched;k++)
+							recordPairCost(*threadContext, *units[k], ticks);
+					}
+					else
+						NarrowPhase4(*threadContext, units, caches, outputs, nbBatched, contextID);
+				}
+				else
+				{
+					PxsContactManagerOutput& output = mCmOutputs[i];
 
-			PxPrefetchLine(cmArray[prefetch2]);
-			PxPrefetchLine(&mCmOutputs[prefetch2]);
-			PxPrefetchLine(cmArray[prefetch1]->getWorkUnit().getShapeCore0());
-			PxPrefetchLine(cmArray[prefetch1]->getWorkUnit().getShapeCore1());
-			PxPrefetchLine(&threadContext->mTransformCache->getTransformCache(cmArray[prefetch1]->getWorkUnit().mTransformCache0));
-			PxPrefetchLine(&threadContext->mTransformCache->getTransformCache(cmArray[prefetch1]->getWorkUnit().mTransformCache1));
+					output.prevPatches = output.nbPatches;
+					oldStatusFlags[i] = output.statusFlag;
 
+					if(attribution)
+					{
+						const PxU64 startTime = PxTime::getCurrentCounterValue();
+						NarrowPhase(*threadContext, unit, mCaches[i], output, contextID);
+						recordPairCost(*threadContext, unit, PxTime::getCurrentCounterValue() - startTime);
+					}
+					else
+						NarrowPhase(*threadContext, unit, mCaches[i], output, contextID);
+					j++;
+				}
+			}
+		}
+
+		for(PxU32 i=0;i<nb;i++)
+		{
 			PxsContactManager* const cm = cmArray[i];			
 
 			if(cm)
@@ -436,16 +585,10 @@ public:
 				PxsContactManagerOutput& output = mCmOutputs[i];
 				PxcNpWorkUnit& unit = cm->getWorkUnit();
 
-				output.prevPatches = output.nbPatches;
-
-				const PxU8 oldStatusFlag = output.statusFlag;
+				const PxU8 oldStatusFlag = oldStatusFlags[i];
 
 				const PxU8 oldTouch = PxTo8(oldStatusFlag & PxsContactManagerStatusFlag::eHAS_TOUCH);
 
-				Gu::Cache& cache = mCaches[i];
-
-				NarrowPhase(*threadContext, unit, cache, output, contextID);
-				
 				const PxU16 newTouch = PxTo8(output.statusFlag & PxsContactManagerStatusFlag::eHAS_TOUCH);
 				
 				const bool modifiable = output.nbPatches != 0 && unit.mFlags & PxcNpWorkUnitFlag::eMODIFIABLE_CONTACT;
@@ -505,14 +648,15 @@ public:
 		const bool pcm = mContext->getPCM();
 		threadContext->mPCM = pcm;
 		threadContext->mCreateAveragePoint = mContext->getCreateAveragePoint();
+		threadContext->mQuantizeContacts = mContext->getQuantizeContacts();
 		threadContext->mContactCache = mContext->getContactCacheFlag();
 		threadContext->mTransformCache = &mContext->getTransformCache();
 		threadContext->mContactDistances = mContext->getContactDistances();
 
 		if(pcm)
-			processCms<PxcDiscreteNarrowPhasePCM>(threadContext);
+			processCms<PxcDiscreteNarrowPhasePCM, PxcDiscreteNarrowPhasePCM4>(threadContext);
 		else
-			processCms<PxcDiscreteNarrowPhase>(threadContext);
+			processCms<PxcDiscreteNarrowPhase, PxcDiscreteNarrowPhase4>(threadContext);
 
 		mContext->putNpThreadContext(threadContext);
 	}
@@ -31,6 +31,7 @@
 
 #include "foundation/PxHashSet.h"
 #include "foundation/PxHashMap.h"
+#include "foundation/PxFlatHashMap.h"
 #include "BpAABBManagerTasks.h"
 #include "BpAABBManagerBase.h"
 
@@ -155,6 +156,12 @@ namespace Bp
 
 						void							preBpUpdate_CPU(PxU32 numCpuTasks);
 
+						// PT: temporal coherence mode. When margin>0, non-aggregated shapes are passed to the BP with fat bounds, and
+						// only re-submitted when their actual bounds leave them. The prediction is a number of steps of motion
+						// (estimated from the bounds themselves) added to the fat bounds.
+						void							setBoundsCoherence(PxReal margin, PxReal prediction);
+		PX_FORCE_INLINE	bool							isBoundsCoherenceEnabled()	const	{ return mCoherenceMargin>0.0f;	}
+
 						// PT: TODO: what is that BpCacheData for?
 						BpCacheData*					getBpCacheData();
 						void							putBpCacheData(BpCacheData*);
@@ -182,13 +189,25 @@ namespace Bp
 
 						PxArray<ProcessAggPairsBase*>	mAggPairTasks;
 
-						PxHashSet<Pair>					mCreatedPairsTmp;	// PT: temp hashset for dubious post filtering, persistent to minimize allocs
+						PxFlatHashSet<Pair>				mCreatedPairsTmp;	// PT: temp hashset for dubious post filtering, persistent to minimize allocs
 
 						PxSList							mBpThreadContextPool;
 
 						PxArray<void*>					mOutOfBoundsObjects;
 						PxArray<void*>					mOutOfBoundsAggregates;
 
+						// PT: temporal coherence data, indexed by BoundsIndex
+						struct FatBoundsData
+						{
+							PxVec3	mCenter;	// PT: center of the actual bounds when the fat bounds were last computed
+							PxU32	mTimestamp;	// PT: mTimestamp at that time, PX_INVALID_U32 if unknown
+						};
+						PxArray<PxBounds3>				mFatBounds;			// PT: the bounds passed to the BP in coherence mode
+						PxArray<FatBoundsData>			mFatBoundsData;
+						PxReal							mCoherenceMargin;
+						PxReal							mCoherencePrediction;
+						bool							mForceFatBoundsUpdate;
+
 		PX_FORCE_INLINE	Aggregate*						getAggregateFromHandle(AggregateHandle handle)
 														{
 															PX_ASSERT(handle<mAggregates.size());
@@ -200,6 +219,8 @@ namespace Bp
 					PersistentAggregateAggregatePair*	createPersistentAggregateAggregatePair(ShapeHandle volA, ShapeHandle volB);
 						void							updatePairs(PersistentPairs& p, BpCacheData* data = NULL);
 						void							handleOriginShift();
+						void							computeFatBounds(BoundsIndex index);
+						void							updateFatBounds();
 
 	public:
 						void							processBPCreatedPair(const BroadPhasePair& pair);
@@ -125,6 +125,13 @@ namespace Bp
 													}
 												}
 
+		// PT: same as initEntry but for a whole batch of entries
+		PX_FORCE_INLINE	void					reserve(PxU32 nbEntries)
+												{
+													if(nbEntries)
+														initEntry(nbEntries - 1);
+												}
+
 		virtual void							updateBounds(const PxTransform& transform, const PxGeometry& geom, PxU32 index, PxU32 /*indexFrom*/)
 												{
 													Gu::computeBounds(mBounds[index], geom, transform, 0.0f, 1.0f);
@@ -191,12 +198,14 @@ namespace Bp
 		virtual			bool					removeBounds(BoundsIndex index) = 0;
 
 						void					reserveSpaceForBounds(BoundsIndex index);
+						void					reserveSpaceForBatch(PxU32 nbTotalBounds);
 
 		PX_FORCE_INLINE	PxIntBool				isMarkedForRemove(BoundsIndex index)	const	{ return mRemovedHandleMap.boundedTest(index);	}
 //		PX_FORCE_INLINE	PxIntBool				isMarkedForAdd(BoundsIndex index)		const	{ return mAddedHandleMap.boundedTest(index);	}
 		PX_FORCE_INLINE	BroadPhase*				getBroadPhase()							const	{ return &mBroadPhase;							}
 		PX_FORCE_INLINE	BoundsArray&			getBoundsArray()								{ return mBoundsArray;							}
 		PX_FORCE_INLINE	PxU32					getNbActiveAggregates()					const	{ return mNbAggregates;							}
+		PX_FORCE_INLINE	PxU32					getNbUpdatedHandles()					const	{ return mUpdatedHandles.size();				}
 		PX_FORCE_INLINE	const float*			getContactDistances()					const	{ return mContactDistance.begin();				}
 		PX_FORCE_INLINE	PxBitMapPinned&			getChangedAABBMgActorHandleMap()				{ return mChangedHandleMap;						}
 		PX_FORCE_INLINE void*					getUserData(const BoundsIndex index)	const	{ return (index<mVolumeData.size()) ? mVolumeData[index].getUserData() : NULL;	}
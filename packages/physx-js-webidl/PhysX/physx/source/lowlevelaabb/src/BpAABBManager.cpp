@@ -1039,10 +1039,29 @@ AABBManager::AABBManager(	BroadPhase& bp, BoundsArray& boundsArray, PxFloatArray
 	mTimestamp				(0),
 	mFirstFreeAggregate		(PX_INVALID_U32),
 	mOutOfBoundsObjects		("AABBManager::mOutOfBoundsObjects"),
-	mOutOfBoundsAggregates	("AABBManager::mOutOfBoundsAggregates")
+	mOutOfBoundsAggregates	("AABBManager::mOutOfBoundsAggregates"),
+	mFatBounds				("AABBManager::mFatBounds"),
+	mFatBoundsData			("AABBManager::mFatBoundsData"),
+	mCoherenceMargin		(0.0f),
+	mCoherencePrediction	(0.0f),
+	mForceFatBoundsUpdate	(true)
 {
 }
 
+void AABBManager::setBoundsCoherence(PxReal margin, PxReal prediction)
+{
+	PX_ASSERT(margin>=0.0f && prediction>=0.0f);
+	mCoherenceMargin = margin;
+	mCoherencePrediction = prediction;
+	// PT: the BP might have been given the actual bounds so far, so all of them must be sent again
+	mForceFatBoundsUpdate = true;
+	if(!isBoundsCoherenceEnabled())
+	{
+		mFatBounds.reset();
+		mFatBoundsData.reset();
+	}
+}
+
 static void releasePairs(AggPairMap& map)
 {
 	for(AggPairMap::Iterator iter = map.getIterator(); !iter.done(); ++iter)
@@ -1375,10 +1394,14 @@ void AABBManager::startAggregateBoundsComputationTasks(PxU32 nbToGo, PxU32 numCp
 	}
 }
 
-void AABBManager::updateBPFirstPass(PxU32 numCpuTasks, Cm::FlushPool& flushPool, bool /*hasContactDistanceUpdated*/, PxBaseTask* continuation)
+void AABBManager::updateBPFirstPass(PxU32 numCpuTasks, Cm::FlushPool& flushPool, bool hasContactDistanceUpdated, PxBaseTask* continuation)
 {
 	PX_PROFILE_ZONE("AABBManager::updateBPFirstPass", mContextID);
 
+	// PT: the BP only reads the contact distances of updated objects, so we cannot skip any of them when these changed
+	if(hasContactDistanceUpdated)
+		mForceFatBoundsUpdate = true;
+
 	const bool singleThreaded = gSingleThreaded || numCpuTasks<2;
 	if(!singleThreaded)
 	{
@@ -1438,8 +1461,9 @@ void AABBManager::updateBPFirstPass(PxU32 numCpuTasks, Cm::FlushPool& flushPool,
 				if(bits)
 				{
 					// PT: ### bitmap iterator pattern
-					const PxU32 lastSetBit = mChangedHandleMap.findLast();
-					for(PxU32 w = 0; w <= lastSetBit >> 5; ++w)
+					// PT: the map is sized for all handles but usually very sparse, so we skip zero words in 128-bit blocks
+					const PxU32 nbWords = mChangedHandleMap.getWordCount();
+					for(PxU32 w = PxBitMapFindNonZeroWord(bits, 0, nbWords); w < nbWords; w = PxBitMapFindNonZeroWord(bits, w + 1, nbWords))
 					{
 						for(PxU32 b = bits[w]; b; b &= b-1)
 						{
@@ -1509,6 +1533,15 @@ void AABBManager::updateBPFirstPass(PxU32 numCpuTasks, Cm::FlushPool& flushPool,
 		}
 		else
 		{
+			if(isBoundsCoherenceEnabled())
+			{
+				// PT: all bounds are re-submitted and the previous centers are not valid anymore
+				mForceFatBoundsUpdate = true;
+				const PxU32 nb = mFatBoundsData.size();
+				for(PxU32 i=0;i<nb;i++)
+					mFatBoundsData[i].mTimestamp = PX_INVALID_U32;
+			}
+
 			handleOriginShift();
 		}
 	}
@@ -1554,11 +1587,19 @@ void AABBManager::updateBPSecondPass(PxcScratchAllocator* scratchAllocator, PxBa
 	//finalizeUpdate(numCpuTasks, scratchAllocator, continuation);
 	// PT: code below used to be "finalizeUpdate"
 
+	// PT: in coherence mode the BP gets the fat bounds. This must be done here, after the aggregates' bounds have been computed.
+	const PxBounds3* bpBounds = mBoundsArray.begin();
+	if(isBoundsCoherenceEnabled())
+	{
+		updateFatBounds();
+		bpBounds = mFatBounds.begin();
+	}
+
 	// PT: TODO: move to base?
 	const BroadPhaseUpdateData updateData(mAddedHandles.begin(), mAddedHandles.size(),
 		mUpdatedHandles.begin(), mUpdatedHandles.size(),
 		mRemovedHandles.begin(), mRemovedHandles.size(),
-		mBoundsArray.begin(), mGroups.begin(), mContactDistance.begin(), mBoundsArray.size(),
+		bpBounds, mGroups.begin(), mContactDistance.begin(), mBoundsArray.size(),
 		mFilters,
 		// PT: TODO: this could also be removed now. The key to understanding the refactorings is that none of the two bools below are actualy used by the CPU versions.
 		mBoundsArray.hasChanged(),
@@ -1574,6 +1615,92 @@ void AABBManager::updateBPSecondPass(PxcScratchAllocator* scratchAllocator, PxBa
 		mBroadPhase.update(scratchAllocator, updateData, continuation);
 }
 
+void AABBManager::computeFatBounds(BoundsIndex index)
+{
+	const PxBounds3& bounds = mBoundsArray.begin()[index];
+	const PxVec3 center = bounds.getCenter();
+
+	FatBoundsData& data = mFatBoundsData[index];
+
+	// PT: we don't have velocities here so we estimate them from the motion of the bounds since the last time we were here
+	PxVec3 motion(0.0f);
+	if(data.mTimestamp!=PX_INVALID_U32 && data.mTimestamp!=mTimestamp)
+		motion = (center - data.mCenter) * (mCoherencePrediction / PxReal(mTimestamp - data.mTimestamp));
+
+	data.mCenter = center;
+	data.mTimestamp = mTimestamp;
+
+	const PxVec3 margin(mCoherenceMargin);
+	const PxVec3 zero(0.0f);
+	PxBounds3& fatBounds = mFatBounds[index];
+	fatBounds.minimum = bounds.minimum - margin + motion.minimum(zero);
+	fatBounds.maximum = bounds.maximum + margin + motion.maximum(zero);
+}
+
+// PT: computes the fat bounds of added & updated objects, and removes the updated objects that are still within their fat
+// bounds from mUpdatedHandles. Aggregates always get their actual bounds.
+void AABBManager::updateFatBounds()
+{
+	PX_PROFILE_ZONE("AABBManager::updateFatBounds", mContextID);
+
+	// PT: same size as the bounds array, which includes the extra entry for SIMD-safe reads in the BP
+	const PxU32 size = mBoundsArray.size();
+	if(mFatBounds.size()<size)
+	{
+		FatBoundsData invalid;
+		invalid.mCenter = PxVec3(0.0f);
+		invalid.mTimestamp = PX_INVALID_U32;
+		mFatBounds.resize(size, PxBounds3::empty());
+		mFatBoundsData.resize(size, invalid);
+	}
+
+	const PxBounds3* PX_RESTRICT bounds = mBoundsArray.begin();
+	PxBounds3* PX_RESTRICT fatBounds = mFatBounds.begin();
+
+	{
+		const PxU32 nbAdded = mAddedHandles.size();
+		const ShapeHandle* added = mAddedHandles.begin();
+		for(PxU32 i=0;i<nbAdded;i++)
+		{
+			const BoundsIndex index = added[i];
+			if(mVolumeData[index].isSingleActor())
+			{
+				// PT: the handle might have been used by another object before
+				mFatBoundsData[index].mTimestamp = PX_INVALID_U32;
+				computeFatBounds(index);
+			}
+			else
+				fatBounds[index] = bounds[index];
+		}
+	}
+
+	{
+		const bool forceUpdate = mForceFatBoundsUpdate;
+		mForceFatBoundsUpdate = false;
+
+		// PT: filtering in-place preserves the order of mUpdatedHandles
+		const PxU32 nbUpdated = mUpdatedHandles.size();
+		ShapeHandle* updated = mUpdatedHandles.begin();
+		PxU32 nbKept = 0;
+		for(PxU32 i=0;i<nbUpdated;i++)
+		{
+			const BoundsIndex index = updated[i];
+			if(mVolumeData[index].isSingleActor())
+			{
+				if(!forceUpdate && bounds[index].isInside(fatBounds[index]))
+					continue;
+
+				computeFatBounds(index);
+			}
+			else
+				fatBounds[index] = bounds[index];
+
+			updated[nbKept++] = index;
+		}
+		mUpdatedHandles.forceSize_Unsafe(nbKept);
+	}
+}
+
 void AABBManager::preBpUpdate_CPU(PxU32 numCpuTasks)
 {
 	PX_PROFILE_ZONE("AABBManager::preBpUpdate", mContextID);
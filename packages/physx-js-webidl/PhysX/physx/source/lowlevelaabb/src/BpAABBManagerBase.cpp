@@ -87,6 +87,13 @@ void AABBManagerBase::reserveSpaceForBounds(BoundsIndex index)
 	resetEntry(index); //KS - make sure this entry is flagged as invalid
 }
 
+void AABBManagerBase::reserveSpaceForBatch(PxU32 nbTotalBounds)
+{
+	// PT: same test as in reserveSpaceForBounds, for the largest index of the batch
+	if (nbTotalBounds >= mVolumeData.size())
+		reserveShapeSpace(nbTotalBounds);
+}
+
 void AABBManagerBase::freeBuffers()
 {
 	// PT: TODO: investigate if we need more stuff here
@@ -50,7 +50,6 @@ using namespace Cm;
 
 /*
 PT: to try:
-- prepare data: sort & compute bounds in parallel? or just MT the last loop?
 - switch post update & add delayed pairs?
 - MT computeCreatedDeletedPairs
 
@@ -73,6 +72,12 @@ PT: to try:
 //#define ABP_BATCHING		128
 #define ABP_BATCHING		256
 
+#ifdef ABP_MT2
+	#define ABP_NB_SORT_TASKS			8		// PT: max number of batches for the parallel sort of updated dynamic objects
+	#define ABP_MIN_SORT_BATCH			1024	// PT: min number of keys per batch
+	#define ABP_DEFERRED_SORT_THRESHOLD	(ABP_MIN_SORT_BATCH*2)	// PT: below this we just sort in the main task
+#endif
+
 //#define USE_ABP_BUCKETS		5000	// PT: don't use buckets below that number...
 #define USE_ABP_BUCKETS		512	// PT: don't use buckets below that number...
 //#define USE_ABP_BUCKETS		64	// PT: don't use buckets below that number...
@@ -988,7 +993,17 @@ void ABP_SharedData::resize(BpHandle userID)
 						void				removeObject(ABPEntry& object, BpHandle userID);
 						void				updateObject(ABPEntry& object, BpHandle userID);
 
-						void				prepareData(RadixSortBuffered& rs, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxU64 contextID);
+						bool				prepareData(RadixSortBuffered& rs, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxU64 contextID, bool allowDeferredSort=false);
+#ifdef ABP_MT2
+						// PT: multithreaded version of the end of prepareData(). When prepareData() returns true, the updated objects have
+						// been classified and their sort keys computed, but they haven't been sorted yet. The caller then sorts the keys
+						// (returned by getDeferredKeys()), calls allocateDeferredBoxes() once, createDeferredBoxes() for each sorted
+						// batch (possibly from multiple threads), and finally endDeferredUpdate().
+		PX_FORCE_INLINE	const float*		getDeferredKeys()		const	{ return mDeferredKeys;	}
+						void				allocateDeferredBoxes();
+						void				createDeferredBoxes(const PxU32* PX_RESTRICT sorted, PxU32 start, PxU32 nb, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, PxBounds3& updatedBounds);
+						void				endDeferredUpdate(const PxBounds3& updatedBounds, ABP_MM& memoryManager);
+#endif
 
 //		PX_FORCE_INLINE	PxU32				isThereWorkToDo()		const	{ return mNbUpdated;	}
 		PX_FORCE_INLINE	bool				isThereWorkToDo()		const	{ return mNbUpdated || mNbRemovedSleeping;	}	// PT: temp & test, maybe we do that differently in the end
@@ -1026,7 +1041,17 @@ void ABP_SharedData::resize(BpHandle userID)
 						// Removed sleeping
 						PxU32				mNbRemovedSleeping;
 
+#ifdef ABP_MT2
+						// Deferred sort (see prepareData())
+						float*				mDeferredKeys;
+						PxU32*				mDeferredIDs;		// newOrUpdatedIDs from prepareData(), frame-allocated
+						PxU32				mDeferredSize;
+						BpHandle*			mDeferredInToOut;
+#endif
 						void				purgeRemovedFromSleeping(ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity);
+						BpHandle*			allocateUpdatedBoxes(PxU32 nbUpdated, float* recyclableKeys);
+						void				createUpdatedBoxes(const PxU32* PX_RESTRICT sorted, PxU32 start, PxU32 nb, const PxU32* PX_RESTRICT newOrUpdatedIDs, PxU32 size,
+																BpHandle* PX_RESTRICT inToOut, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, Vec4V& minV, Vec4V& maxV);
 	};
 
 BoxManager::BoxManager(FilterType::Enum type) :
@@ -1039,6 +1064,12 @@ BoxManager::BoxManager(FilterType::Enum type) :
 	mInToOut_Sleeping		(NULL),
 	mNbSleeping				(0),
 	mNbRemovedSleeping		(0)
+#ifdef ABP_MT2
+	,mDeferredKeys			(NULL)
+	,mDeferredIDs			(NULL)
+	,mDeferredSize			(0)
+	,mDeferredInToOut		(NULL)
+#endif
 {
 }
 
@@ -1341,9 +1372,86 @@ static PX_FORCE_INLINE PosXType2 getNextCandidateNonSorted(PxU32 offsetNonSorted
 }
 
 PX_COMPILE_TIME_ASSERT(sizeof(BpHandle)==sizeof(float));
-void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxU64 contextID)
+BpHandle* BoxManager::allocateUpdatedBoxes(PxU32 nbUpdated, float* recyclableKeys)
+{
+	// PT: TODO: the "keys" array can be much bigger than stricly necessary here
+	BpHandle* inToOut_Updated_Sorted;
+	if(mUpdatedBoxes.allocate(nbUpdated))
+	{
+		// PT: the keys buffer can only be recycled when the sorted keys are not needed anymore. Otherwise we allocate a new remap.
+		if(recyclableKeys)
+			inToOut_Updated_Sorted = reinterpret_cast<BpHandle*>(recyclableKeys);
+		else
+			inToOut_Updated_Sorted = reinterpret_cast<BpHandle*>(PX_ALLOC(nbUpdated*sizeof(BpHandle), "tmp"));
+
+		PX_FREE(mInToOut_Updated);
+		mInToOut_Updated = inToOut_Updated_Sorted;
+	}
+	else
+	{
+		PX_FREE(recyclableKeys);
+
+		inToOut_Updated_Sorted = mInToOut_Updated;
+	}
+	SIMD_AABB_X4* PX_RESTRICT dstBoxesX = mUpdatedBoxes.getBoxes_X();
+	initSentinels(dstBoxesX, nbUpdated);
+	return inToOut_Updated_Sorted;
+}
+
+void BoxManager::createUpdatedBoxes(const PxU32* PX_RESTRICT sorted, PxU32 start, PxU32 nb, const PxU32* PX_RESTRICT newOrUpdatedIDs, PxU32 size,
+									BpHandle* PX_RESTRICT inToOut_Updated_Sorted, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, Vec4V& minV, Vec4V& maxV)
+{
+	PX_UNUSED(objectsCapacity);
+	const PxBounds3* PX_RESTRICT bounds = mAABBManagerBounds;
+	const float* PX_RESTRICT distances = mAABBManagerDistances;
+
+	// PT: everything indexed by i is owned by the caller's batch, things indexed by userID might have some false sharing
+	const PxU32 end = start + nb;
+	for(PxU32 i=start;i<end;i++)
+	{
+		const PxU32 sortedIndex = *sorted++;
+
+		const BpHandle userID = newOrUpdatedIDs[size - 1 - sortedIndex];
+		PX_ASSERT(i<size);
+		inToOut_Updated_Sorted[i] = userID;
+
+		{
+			PX_ASSERT(userID<objectsCapacity);
+			objects[userID].setActiveIndex(i, mType);
+#if PX_DEBUG
+			objects[userID].mUpdated = false;
+#endif
+		}
+
+		// PT: TODO: refactor with computeMBPBounds?
+		{
+			const PxBounds3& b = bounds[userID];
+			const Vec4V contactDistanceV = V4Load(distances[userID]);
+			const Vec4V inflatedMinV = V4Sub(V4LoadU(&b.minimum.x), contactDistanceV);
+			const Vec4V inflatedMaxV = V4Add(V4LoadU(&b.maximum.x), contactDistanceV);	// PT: this one is safe because we allocated one more box in the array (in BoundsArray::initEntry)
+#ifdef USE_ABP_BUCKETS
+			minV = V4Min(minV, inflatedMinV);
+			maxV = V4Max(maxV, inflatedMaxV);
+#endif
+			// PT: TODO better
+			PX_ALIGN(16, PxVec4) boxMin;
+			PX_ALIGN(16, PxVec4) boxMax;
+			V4StoreA(inflatedMinV, &boxMin.x);
+			V4StoreA(inflatedMaxV, &boxMax.x);
+
+			mUpdatedBoxes.setBounds(i, boxMin, boxMax);
+		}
+	}
+#ifndef USE_ABP_BUCKETS
+	PX_UNUSED(minV);
+	PX_UNUSED(maxV);
+#endif
+}
+
+bool BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxU64 contextID, bool allowDeferredSort)
 {
 	PX_UNUSED(contextID);
+	PX_UNUSED(allowDeferredSort);
 
 	// PT: mNbUpdated = number of objects in the updated buffer, could have been updated this frame or previous frame
 	const PxU32 size = mNbUpdated;
@@ -1354,7 +1462,7 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 			// PT: benchmark for this codepath: MBP.RemoveHalfSleeping
 			purgeRemovedFromSleeping(objects, objectsCapacity);
 		}
-		return;
+		return false;
 	}
 
 	PX_ASSERT(mAABBManagerBounds);
@@ -1655,6 +1763,18 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 		// PT: benchmark for this codepath: MBP.Update64KObjects
 		CHECKPOINT("Create updated objects\n");
 
+#ifdef ABP_MT2
+		if(allowDeferredSort && nbUpdated>=ABP_DEFERRED_SORT_THRESHOLD)
+		{
+			// PT: the sort & the creation of updated boxes will be done later by the caller, in parallel. We keep the
+			// temp buffers alive until endDeferredUpdate().
+			mDeferredKeys = keys;
+			mDeferredIDs = newOrUpdatedIDs;
+			mDeferredSize = size;
+			mNbUpdated = mMaxNbUpdated = nbUpdated;
+			return true;
+		}
+#endif
 		// PT: we need to sort here because we reuse the "keys" buffer just afterwards
 		PxU32* ranks0 = reinterpret_cast<PxU32*>(memoryManager.frameAlloc(sizeof(PxU32)*nbUpdated));
 		PxU32* ranks1 = reinterpret_cast<PxU32*>(memoryManager.frameAlloc(sizeof(PxU32)*nbUpdated));
@@ -1669,65 +1789,11 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 		// PT:
 		// - shuffle the remap table, store it in sorted order (we can probably use the "recyclable" array here again)
 		// - compute bounds on-the-fly, store them in sorted order
+		BpHandle* inToOut_Updated_Sorted = allocateUpdatedBoxes(nbUpdated, keys);
 
-		// PT: TODO: the "keys" array can be much bigger than stricly necessary here
-		BpHandle* inToOut_Updated_Sorted;
-		if(mUpdatedBoxes.allocate(nbUpdated))
-		{
-			inToOut_Updated_Sorted = reinterpret_cast<BpHandle*>(keys);
-
-			PX_FREE(mInToOut_Updated);
-			mInToOut_Updated = inToOut_Updated_Sorted;
-		}
-		else
-		{
-			PX_FREE(keys);
-
-			inToOut_Updated_Sorted = mInToOut_Updated;
-		}
-		SIMD_AABB_X4* PX_RESTRICT dstBoxesX = mUpdatedBoxes.getBoxes_X();
-		initSentinels(dstBoxesX, nbUpdated);
-
-#ifdef USE_ABP_BUCKETS
 		Vec4V minV = V4Load(FLT_MAX);
 		Vec4V maxV = V4Load(-FLT_MAX);
-#endif
-		// PT: TODO: parallel? Everything indexed by i should be fine, things indexed by userID might have some false sharing
-		for(PxU32 i=0;i<nbUpdated;i++)
-		{
-			const PxU32 sortedIndex = *sorted++;
-
-			const BpHandle userID = newOrUpdatedIDs[size - 1 - sortedIndex];
-			PX_ASSERT(i<size);
-			inToOut_Updated_Sorted[i] = userID;
-
-			{
-				PX_ASSERT(userID<objectsCapacity);
-				objects[userID].setActiveIndex(i, mType);
-#if PX_DEBUG
-				objects[userID].mUpdated = false;
-#endif
-			}
-	
-			// PT: TODO: refactor with computeMBPBounds?
-			{
-				const PxBounds3& b = bounds[userID];
-				const Vec4V contactDistanceV = V4Load(distances[userID]);
-				const Vec4V inflatedMinV = V4Sub(V4LoadU(&b.minimum.x), contactDistanceV);
-				const Vec4V inflatedMaxV = V4Add(V4LoadU(&b.maximum.x), contactDistanceV);	// PT: this one is safe because we allocated one more box in the array (in BoundsArray::initEntry)
-#ifdef USE_ABP_BUCKETS
-				minV = V4Min(minV, inflatedMinV);
-				maxV = V4Max(maxV, inflatedMaxV);
-#endif
-				// PT: TODO better
-				PX_ALIGN(16, PxVec4) boxMin;
-				PX_ALIGN(16, PxVec4) boxMax;
-				V4StoreA(inflatedMinV, &boxMin.x);
-				V4StoreA(inflatedMaxV, &boxMax.x);
-
-				mUpdatedBoxes.setBounds(i, boxMin, boxMax);
-			}
-		}
+		createUpdatedBoxes(sorted, 0, nbUpdated, newOrUpdatedIDs, size, inToOut_Updated_Sorted, objects, objectsCapacity, minV, maxV);
 #ifdef USE_ABP_BUCKETS
 		StoreBounds(mUpdatedBounds, minV, maxV)
 #endif
@@ -1750,8 +1816,40 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 
 	if(tempBuffer)
 		memoryManager.frameFree(tempBuffer);
+	return false;
+}
+
+#ifdef ABP_MT2
+void BoxManager::allocateDeferredBoxes()
+{
+	PX_ASSERT(mDeferredKeys);
+	mDeferredInToOut = allocateUpdatedBoxes(mNbUpdated, NULL);
+}
+
+void BoxManager::createDeferredBoxes(const PxU32* PX_RESTRICT sorted, PxU32 start, PxU32 nb, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, PxBounds3& updatedBounds)
+{
+	PX_ASSERT(mDeferredInToOut);
+	Vec4V minV = V4Load(FLT_MAX);
+	Vec4V maxV = V4Load(-FLT_MAX);
+	createUpdatedBoxes(sorted, start, nb, mDeferredIDs, mDeferredSize, mDeferredInToOut, objects, objectsCapacity, minV, maxV);
+	StoreBounds(updatedBounds, minV, maxV)
 }
 
+void BoxManager::endDeferredUpdate(const PxBounds3& updatedBounds, ABP_MM& memoryManager)
+{
+#ifdef USE_ABP_BUCKETS
+	mUpdatedBounds = updatedBounds;
+#else
+	PX_UNUSED(updatedBounds);
+#endif
+	PX_FREE(mDeferredKeys);
+	memoryManager.frameFree(mDeferredIDs);
+	mDeferredIDs = NULL;
+	mDeferredSize = 0;
+	mDeferredInToOut = NULL;
+}
+#endif
+
 #ifdef ABP_MT
 namespace
 {
@@ -1779,6 +1877,8 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 	{
 		ABP_TASK_0,
 		ABP_TASK_1,
+		ABP_TASK_MERGE,		// PT: merges the sorted batches of updated objects
+		ABP_TASK_OVERLAPS,	// PT: finds overlaps once all the updated boxes have been created
 	};
 
 	class ABP_InternalTask : public PxLightCpuTask
@@ -1798,6 +1898,54 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 		ABP_TaskID				mID;
 	};
 
+	// PT: sorts one batch of updated objects. Each task has its own sorter so batches can be sorted concurrently.
+	class ABP_SortTask : public PxLightCpuTask
+	{
+		public:
+							ABP_SortTask() : mKeys(NULL), mStart(0), mNbKeys(0)	{}
+		virtual	const char* getName()	const	PX_OVERRIDE
+		{
+			return "ABP_SortTask";
+		}
+
+		virtual void run()	PX_OVERRIDE
+		{
+			mRS.Sort(mKeys + mStart, mNbKeys);
+		}
+
+		virtual bool	isHighPriority()	const	PX_OVERRIDE	{ return true; }
+
+		PX_FORCE_INLINE	const PxU32*	getRanks()	const	{ return mRS.GetRanks();	}
+
+		const float*			mKeys;
+		PxU32					mStart;
+		PxU32					mNbKeys;
+		RadixSortBuffered		mRS;
+	};
+
+	// PT: merges a range of values from all sorted batches, and creates the corresponding updated boxes. The ranges are
+	// computed so that each merge task writes a distinct, contiguous part of the output.
+	class ABP_MergeTask : public PxLightCpuTask
+	{
+		public:
+							ABP_MergeTask() : mABP(NULL), mOutStart(0), mNbOut(0)	{}
+		virtual	const char* getName()	const	PX_OVERRIDE
+		{
+			return "ABP_MergeTask";
+		}
+
+		virtual void run()	PX_OVERRIDE;
+
+		virtual bool	isHighPriority()	const	PX_OVERRIDE	{ return true; }
+
+		ABP*					mABP;
+		PxU32					mBegin[ABP_NB_SORT_TASKS];	// PT: first sorted index within each batch
+		PxU32					mEnd[ABP_NB_SORT_TASKS];	// PT: last sorted index (excluded) within each batch
+		PxU32					mOutStart;
+		PxU32					mNbOut;
+		PxBounds3				mBounds;
+	};
+
 	class ABP_CompleteBoxPruningStartTask;
 
 	class ABP_CompleteBoxPruningTask : public PxLightCpuTask
@@ -1938,6 +2086,11 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 						void					setTransientData(const PxBounds3* bounds, const PxReal* contactDistance);
 
 						void					Region_prepareOverlaps();
+#ifdef ABP_MT2
+						void					Region_prepareOverlaps_MT(PxBaseTask* continuation);
+						void					Region_mergeSortedBatches(PxBaseTask* continuation);
+						void					Region_endPrepareOverlaps_MT();
+#endif
 
 						ABP_MM					mMM;
 						BoxManager				mSBM;
@@ -1950,6 +2103,12 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 #ifdef ABP_MT2
 						ABP_InternalTask		mTask0;
 						ABP_InternalTask		mTask1;
+						ABP_InternalTask		mTaskMerge;
+						ABP_InternalTask		mTaskOverlaps;
+						ABP_SortTask			mSortTasks[ABP_NB_SORT_TASKS];
+						ABP_MergeTask			mMergeTasks[ABP_NB_SORT_TASKS];
+						PxU32					mNbSortTasks;	// PT: 0 when the updated objects have been sorted in Region_prepareOverlaps_MT()
+						PxU32*					mSortedRanks;
 				ABP_CompleteBoxPruningStartTask	mCompleteBoxPruningTask0;
 				ABP_CompleteBoxPruningStartTask	mCompleteBoxPruningTask1;
 					ABP_CompleteBoxPruningTask	mBipTasks[NB_BIP_TASKS];
@@ -2779,6 +2938,49 @@ void ABP_CompleteBoxPruningTask::run()
 									mRemap, mRemap4);
 }
 
+void ABP_MergeTask::run()
+{
+	PX_PROFILE_ZONE("ABP_MergeTask", mContextID);
+
+	const PxU32 nbBatches = mABP->mNbSortTasks;
+	const ABP_SortTask* PX_RESTRICT batches = mABP->mSortTasks;
+	const float* PX_RESTRICT keys = mABP->mDBM.getDeferredKeys();
+
+	const PxU32* ranks[ABP_NB_SORT_TASKS];
+	PxU32 current[ABP_NB_SORT_TASKS];
+	for(PxU32 j=0; j<nbBatches; j++)
+	{
+		ranks[j] = batches[j].getRanks();
+		current[j] = mBegin[j];
+	}
+
+	// PT: K-way merge with a linear scan, K is small. On equal keys we take the first batch, which is the order a
+	// single sort would have produced.
+	PxU32* PX_RESTRICT sorted = mABP->mSortedRanks + mOutStart;
+	for(PxU32 i=0; i<mNbOut; i++)
+	{
+		PxU32 best = 0xffffffff;
+		float bestKey = 0.0f;
+		for(PxU32 j=0; j<nbBatches; j++)
+		{
+			if(current[j]<mEnd[j])
+			{
+				const float key = keys[batches[j].mStart + ranks[j][current[j]]];
+				if(best==0xffffffff || key<bestKey)
+				{
+					best = j;
+					bestKey = key;
+				}
+			}
+		}
+		PX_ASSERT(best!=0xffffffff);
+		sorted[i] = batches[best].mStart + ranks[best][current[best]++];
+	}
+
+	if(mNbOut)
+		mABP->mDBM.createDeferredBoxes(sorted, mOutStart, mNbOut, mABP->mShared.mABP_Objects, mABP->mShared.mABP_Objects_Capacity, mBounds);
+}
+
 void ABP_CompleteBoxPruningEndTask::run()
 {
 //	printf("Running ABP_CompleteBoxPruningEndTask\n");
@@ -3430,6 +3632,166 @@ void ABP::Region_prepareOverlaps()
 	mRS.reset();
 }
 
+#ifdef ABP_MT2
+// PT: same as Region_prepareOverlaps() but the updated dynamic objects are sorted in parallel batches when there are enough
+// of them. The batches are then merged in Region_mergeSortedBatches(), and Region_endPrepareOverlaps_MT() must be called
+// before findOverlaps().
+void ABP::Region_prepareOverlaps_MT(PxBaseTask* continuation)
+{
+	PX_PROFILE_ZONE("ABP - Region_prepareOverlaps_MT", mContextID);
+
+	mNbSortTasks = 0;
+
+	if(		!mDBM.isThereWorkToDo()
+		&&	!mKBM.isThereWorkToDo()
+		&&	!mSBM.isThereWorkToDo()
+		)
+		return;
+
+	if(mSBM.isThereWorkToDo())
+		mSBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, mContextID);
+
+	const bool deferred = mDBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, mContextID, true);
+	mKBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, mContextID);
+
+	mRS.reset();
+
+	if(deferred)
+	{
+		const PxU32 nbUpdated = mDBM.getNbUpdatedBoxes();
+		const PxU32 nbTasks = PxMin<PxU32>(ABP_NB_SORT_TASKS, nbUpdated/ABP_MIN_SORT_BATCH);
+		PX_ASSERT(nbTasks>=2);
+		mNbSortTasks = nbTasks;
+
+		const float* keys = mDBM.getDeferredKeys();
+		for(PxU32 k=0; k<nbTasks; k++)
+		{
+			const PxU32 start = PxU32((PxU64(nbUpdated)*k)/nbTasks);
+			const PxU32 end = PxU32((PxU64(nbUpdated)*(k+1))/nbTasks);
+
+			ABP_SortTask& task = mSortTasks[k];
+			task.mKeys = keys;
+			task.mStart = start;
+			task.mNbKeys = end - start;
+			task.setContinuation(continuation);
+		}
+
+		for(PxU32 k=0; k<nbTasks; k++)
+			mSortTasks[k].removeReference();
+	}
+}
+
+// PT: returns the number of sorted keys smaller than "value" in a batch.
+static PX_FORCE_INLINE PxU32 lowerBound(const float* PX_RESTRICT keys, const PxU32* PX_RESTRICT ranks, PxU32 nb, float value)
+{
+	PxU32 first = 0;
+	while(nb)
+	{
+		const PxU32 half = nb>>1;
+		if(keys[ranks[first + half]] < value)
+		{
+			first += half + 1;
+			nb -= half + 1;
+		}
+		else
+			nb = half;
+	}
+	return first;
+}
+
+void ABP::Region_mergeSortedBatches(PxBaseTask* continuation)
+{
+	const PxU32 nbTasks = mNbSortTasks;
+	if(!nbTasks)
+		return;
+
+	PX_PROFILE_ZONE("ABP - Region_mergeSortedBatches", mContextID);
+
+	mDBM.allocateDeferredBoxes();
+
+	const PxU32 nbUpdated = mDBM.getNbUpdatedBoxes();
+	mSortedRanks = reinterpret_cast<PxU32*>(mMM.frameAlloc(sizeof(PxU32)*nbUpdated));
+
+	const float* keys = mDBM.getDeferredKeys();
+
+	// PT: we partition the output by value: the splitting values are taken from the largest batch, and each merge task
+	// gets the keys in [splitter k, splitter k+1) from all batches. Equal keys always end up in the same merge task, so
+	// the result is exactly the same as a single sort over all keys.
+	PxU32 largest = 0;
+	for(PxU32 k=1; k<nbTasks; k++)
+	{
+		if(mSortTasks[k].mNbKeys > mSortTasks[largest].mNbKeys)
+			largest = k;
+	}
+	const ABP_SortTask& ref = mSortTasks[largest];
+
+	for(PxU32 j=0; j<nbTasks; j++)
+	{
+		const ABP_SortTask& batch = mSortTasks[j];
+		mMergeTasks[0].mBegin[j] = 0;
+		mMergeTasks[nbTasks-1].mEnd[j] = batch.mNbKeys;
+	}
+
+	for(PxU32 k=1; k<nbTasks; k++)
+	{
+		const PxU32 refIndex = PxU32((PxU64(ref.mNbKeys)*k)/nbTasks);
+		const float splitter = keys[ref.mStart + ref.getRanks()[refIndex]];
+
+		for(PxU32 j=0; j<nbTasks; j++)
+		{
+			const ABP_SortTask& batch = mSortTasks[j];
+			const PxU32 index = lowerBound(keys + batch.mStart, batch.getRanks(), batch.mNbKeys, splitter);
+			mMergeTasks[k-1].mEnd[j] = index;
+			mMergeTasks[k].mBegin[j] = index;
+		}
+	}
+
+	PxU32 offset = 0;
+	for(PxU32 k=0; k<nbTasks; k++)
+	{
+		ABP_MergeTask& task = mMergeTasks[k];
+		PxU32 nb = 0;
+		for(PxU32 j=0; j<nbTasks; j++)
+		{
+			PX_ASSERT(task.mBegin[j]<=task.mEnd[j]);
+			nb += task.mEnd[j] - task.mBegin[j];
+		}
+		task.mOutStart = offset;
+		task.mNbOut = nb;
+		offset += nb;
+	}
+	PX_ASSERT(offset==nbUpdated);
+
+	for(PxU32 k=0; k<nbTasks; k++)
+		mMergeTasks[k].setContinuation(continuation);
+
+	for(PxU32 k=0; k<nbTasks; k++)
+		mMergeTasks[k].removeReference();
+}
+
+void ABP::Region_endPrepareOverlaps_MT()
+{
+	const PxU32 nbTasks = mNbSortTasks;
+	if(!nbTasks)
+		return;
+
+	PxBounds3 updatedBounds = PxBounds3::empty();
+	for(PxU32 k=0; k<nbTasks; k++)
+	{
+		if(mMergeTasks[k].mNbOut)
+			updatedBounds.include(mMergeTasks[k].mBounds);
+
+		mSortTasks[k].mRS.reset();
+	}
+
+	mMM.frameFree(mSortedRanks);
+	mSortedRanks = NULL;
+
+	mDBM.endDeferredUpdate(updatedBounds, mMM);
+	mNbSortTasks = 0;
+}
+#endif
+
 // Finds static-vs-dynamic and dynamic-vs-dynamic overlaps
 static void findAllOverlaps(
 #ifdef ABP_MT2
@@ -3580,13 +3942,25 @@ ABP::ABP(PxU64 contextID) :
 	mKBM		(FilterType::KINEMATIC),
 	mContextID	(contextID)
 #ifdef ABP_MT2
-	,mTask0		(ABP_TASK_0)
-	,mTask1		(ABP_TASK_1)
+	,mTask0			(ABP_TASK_0)
+	,mTask1			(ABP_TASK_1)
+	,mTaskMerge		(ABP_TASK_MERGE)
+	,mTaskOverlaps	(ABP_TASK_OVERLAPS)
+	,mNbSortTasks	(0)
+	,mSortedRanks	(NULL)
 #endif
 {
 #ifdef ABP_MT2
 	mTask0.setContextId(mContextID);
 	mTask1.setContextId(mContextID);
+	mTaskMerge.setContextId(mContextID);
+	mTaskOverlaps.setContextId(mContextID);
+	for(PxU32 k=0; k<ABP_NB_SORT_TASKS; k++)
+	{
+		mSortTasks[k].setContextId(mContextID);
+		mMergeTasks[k].setContextId(mContextID);
+		mMergeTasks[k].mABP = this;
+	}
 	mCompleteBoxPruningTask0.setContextId(mContextID);
 	mCompleteBoxPruningTask1.setContextId(mContextID);
 	for(PxU32 k=0; k<9; k++)
@@ -4059,10 +4433,18 @@ void BroadPhaseABP::update(PxcScratchAllocator* scratchAllocator, const BroadPha
 		mABP->mTask1.mBP = this;
 		mABP->mTask1.setContinuation(continuation);
 
+		mABP->mTaskOverlaps.mBP = this;
+		mABP->mTaskOverlaps.setContinuation(&mABP->mTask1);
+
+		mABP->mTaskMerge.mBP = this;
+		mABP->mTaskMerge.setContinuation(&mABP->mTaskOverlaps);
+
 		mABP->mTask0.mBP = this;
-		mABP->mTask0.setContinuation(&mABP->mTask1);
+		mABP->mTask0.setContinuation(&mABP->mTaskMerge);
 
 		mABP->mTask1.removeReference();
+		mABP->mTaskOverlaps.removeReference();
+		mABP->mTaskMerge.removeReference();
 		mABP->mTask0.removeReference();
 	}
 	else
@@ -4113,9 +4495,18 @@ void ABP_InternalTask::run()
 			PX_ASSERT(!mBP->mCreated.size());
 			PX_ASSERT(!mBP->mDeleted.size());
 
+			// PT: the updated dynamic objects are sorted in parallel, then merged in ABP_TASK_MERGE
 			if(gPrepareOverlapsFlag)
-				abp->Region_prepareOverlaps();
+				abp->Region_prepareOverlaps_MT(getContinuation());
 		}
+	}
+	else if(mID==ABP_TASK_MERGE)
+	{
+		abp->Region_mergeSortedBatches(getContinuation());
+	}
+	else if(mID==ABP_TASK_OVERLAPS)
+	{
+		abp->Region_endPrepareOverlaps_MT();
 
 		{
 			PX_PROFILE_ZONE("ABP_InternalTask - update", mContextID);
@@ -333,6 +333,13 @@ static PX_FORCE_INLINE void clearBit(BitArray& bitmap, MBP_ObjectIndex objectInd
 	typedef	IAABB		MBP_AABB;
 #endif
 
+	// PT: MBP_Box is the box type stored in regions and used by the box-pruning loops. MBP_AABB is used everywhere else.
+#ifdef MBP_USE_QUANTIZED_BOXES
+	typedef	QAABB		MBP_Box;
+#else
+	typedef	MBP_AABB	MBP_Box;
+#endif
+
 	struct MBPEntry;
 	struct RegionHandle;
 	struct MBP_Object;
@@ -366,15 +373,15 @@ static PX_FORCE_INLINE void clearBit(BitArray& bitmap, MBP_ObjectIndex objectInd
 		// PT: wtf, why doesn't the 128 version compile?
 //		MBP_AABB	PX_ALIGN(128, mSleepingDynamicBoxes_Stack[STACK_BUFFER_SIZE]);
 //		MBP_AABB	PX_ALIGN(128, mUpdatedDynamicBoxes_Stack[STACK_BUFFER_SIZE]);
-		MBP_AABB	PX_ALIGN(16, mSleepingDynamicBoxes_Stack[STACK_BUFFER_SIZE]);
-		MBP_AABB	PX_ALIGN(16, mUpdatedDynamicBoxes_Stack[STACK_BUFFER_SIZE]);
+		MBP_Box		PX_ALIGN(16, mSleepingDynamicBoxes_Stack[STACK_BUFFER_SIZE]);
+		MBP_Box		PX_ALIGN(16, mUpdatedDynamicBoxes_Stack[STACK_BUFFER_SIZE]);
 		MBP_Index	mInToOut_Dynamic_Sleeping_Stack[STACK_BUFFER_SIZE];
 
 		PxU32		mNbSleeping;
 		PxU32		mNbUpdated;
 		MBP_Index*	mInToOut_Dynamic_Sleeping;
-		MBP_AABB*	mSleepingDynamicBoxes;
-		MBP_AABB*	mUpdatedDynamicBoxes;
+		MBP_Box*	mSleepingDynamicBoxes;
+		MBP_Box*	mUpdatedDynamicBoxes;
 	};
 
 	struct BIP_Input
@@ -394,8 +401,8 @@ static PX_FORCE_INLINE void clearBit(BitArray& bitmap, MBP_ObjectIndex objectInd
 		const MBPEntry*		mObjects;
 		PxU32				mNbUpdatedBoxes;
 		PxU32				mNbStaticBoxes;
-		const MBP_AABB*		mDynamicBoxes;
-		const MBP_AABB*		mStaticBoxes;
+		const MBP_Box*		mDynamicBoxes;
+		const MBP_Box*		mStaticBoxes;
 		const MBP_Index*	mInToOut_Static;
 		const MBP_Index*	mInToOut_Dynamic;
 		bool				mNeeded;
@@ -416,8 +423,8 @@ static PX_FORCE_INLINE void clearBit(BitArray& bitmap, MBP_ObjectIndex objectInd
 		}
 
 		const MBPEntry*		mObjects;
-		const MBP_AABB*		mUpdatedDynamicBoxes;
-		const MBP_AABB*		mSleepingDynamicBoxes;
+		const MBP_Box*		mUpdatedDynamicBoxes;
+		const MBP_Box*		mSleepingDynamicBoxes;
 		const MBP_Index*	mInToOut_Dynamic;
 		const MBP_Index*	mInToOut_Dynamic_Sleeping;
 		PxU32				mNbUpdated;
@@ -441,6 +448,9 @@ static PX_FORCE_INLINE void clearBit(BitArray& bitmap, MBP_ObjectIndex objectInd
 		void				setBounds(MBP_Index handle, const MBP_AABB& bounds);
 		void				prepareOverlaps();
 		void				findOverlaps(MBP_PairManager& pairManager);
+#ifdef MBP_USE_QUANTIZED_BOXES
+		void				setQuantizationBounds(const PxBounds3& bounds);
+#endif
 
 //		private:
 		BoxPruning_Input	PX_ALIGN(16, mInput);
@@ -452,8 +462,8 @@ static PX_FORCE_INLINE void clearBit(BitArray& bitmap, MBP_ObjectIndex objectInd
 		PxU32				mNbStaticBoxes;
 		PxU32				mMaxNbDynamicBoxes;
 		PxU32				mNbDynamicBoxes;
-		MBP_AABB*			mStaticBoxes;
-		MBP_AABB*			mDynamicBoxes;
+		MBP_Box*			mStaticBoxes;
+		MBP_Box*			mDynamicBoxes;
 		MBP_Mapping			mInToOut_Static;	// Maps static boxes to mObjects
 		MBP_Mapping			mInToOut_Dynamic;	// Maps dynamic boxes to mObjects
 		PxU32*				mPosList;
@@ -465,6 +475,17 @@ static PX_FORCE_INLINE void clearBit(BitArray& bitmap, MBP_ObjectIndex objectInd
 		bool				mNeedsSortingSleeping;
 				
 		MBPOS_TmpBuffers	mTmpBuffers;
+#ifdef MBP_USE_QUANTIZED_BOXES
+		PxVec3				mQuantOrigin;		// Min corner of the region's bounds
+		PxVec3				mQuantScale;		// Region space to 16-bit grid
+		PxVec3				mDequantScale;		// 16-bit grid to region space
+
+		PX_FORCE_INLINE	void	quantize(MBP_Box& dst, const MBP_AABB& src)	const;
+		PX_FORCE_INLINE	void	dequantize(MBP_AABB& dst, const MBP_Box& src)	const;
+#else
+		PX_FORCE_INLINE	void	quantize(MBP_Box& dst, const MBP_AABB& src)	const	{ dst = src;	}
+		PX_FORCE_INLINE	void	dequantize(MBP_AABB& dst, const MBP_Box& src)	const	{ dst = src;	}
+#endif
 
 		void				optimizeMemory();
 		void				resizeObjects();
@@ -565,14 +586,25 @@ struct RegionData : public PxUserAllocated
 		return box.mMinX == 0xffffffff;
 	}
 	#endif
+#elif defined(MBP_USE_QUANTIZED_BOXES)
+	static PX_FORCE_INLINE void initSentinel(MBP_Box& box)
+	{
+		box.mMinX = 0xffff;
+	}
+	#if PX_DEBUG
+	static PX_FORCE_INLINE bool isSentinel(const MBP_Box& box)
+	{
+		return box.mMinX == 0xffff;
+	}
+	#endif
 #else
-	static PX_FORCE_INLINE void initSentinel(MBP_AABB& box)
+	static PX_FORCE_INLINE void initSentinel(MBP_Box& box)
 	{
 	//	box.mMinX = encodeFloat(FLT_MAX)>>1;
 		box.mMinX = 0xffffffff;
 	}
 	#if PX_DEBUG
-	static PX_FORCE_INLINE bool isSentinel(const MBP_AABB& box)
+	static PX_FORCE_INLINE bool isSentinel(const MBP_Box& box)
 	{
 		return box.mMinX == 0xffffffff;
 	}
@@ -693,6 +725,11 @@ Region::Region() :
 	mNeedsSorting			(false),
 	mNeedsSortingSleeping	(true)
 {
+#ifdef MBP_USE_QUANTIZED_BOXES
+	mQuantOrigin = PxVec3(0.0f);
+	mQuantScale = PxVec3(0.0f);
+	mDequantScale = PxVec3(0.0f);
+#endif
 }
 
 Region::~Region()
@@ -705,6 +742,66 @@ Region::~Region()
 	PX_DELETE_ARRAY(mStaticBoxes);
 }
 
+#ifdef MBP_USE_QUANTIZED_BOXES
+void Region::setQuantizationBounds(const PxBounds3& bounds)
+{
+	// PT: objects must be re-quantized after calling this, e.g. with setBounds()
+	const PxVec3 extents = bounds.maximum - bounds.minimum;
+	mQuantOrigin = bounds.minimum;
+	mQuantScale.x = extents.x>0.0f ? float(MBP_QUANTIZED_MAX)/extents.x : 0.0f;
+	mQuantScale.y = extents.y>0.0f ? float(MBP_QUANTIZED_MAX)/extents.y : 0.0f;
+	mQuantScale.z = extents.z>0.0f ? float(MBP_QUANTIZED_MAX)/extents.z : 0.0f;
+	mDequantScale = extents * (1.0f/float(MBP_QUANTIZED_MAX));
+}
+
+// PT: mins are rounded down and maxs rounded up, with an extra unit of margin to absorb float rounding. Values are clamped to the
+// region's bounds, which doesn't change the results for objects overlapping the region: for two such boxes, the overlap in region
+// space is the same before and after clamping.
+static PX_FORCE_INLINE PxU16 quantizeMin(float x)
+{
+	if(!(x>0.0f))	// PT: written this way to catch NaNs
+		return 0;
+	if(x>=float(MBP_QUANTIZED_MAX))
+		return MBP_QUANTIZED_MAX;
+	const PxU32 q = PxU32(x);
+	return PxU16(q ? q-1 : 0);
+}
+
+static PX_FORCE_INLINE PxU16 quantizeMax(float x)
+{
+	if(!(x>0.0f))
+		return 0;
+	if(x>=float(MBP_QUANTIZED_MAX-2))
+		return MBP_QUANTIZED_MAX;
+	return PxU16(PxU32(x)+2);
+}
+
+PX_FORCE_INLINE void Region::quantize(MBP_Box& dst, const MBP_AABB& src) const
+{
+	PxBounds3 bounds;
+	src.decode(bounds);
+
+	const PxVec3 localMin = (bounds.minimum - mQuantOrigin).multiply(mQuantScale);
+	const PxVec3 localMax = (bounds.maximum - mQuantOrigin).multiply(mQuantScale);
+
+	dst.mMinX = quantizeMin(localMin.x);
+	dst.mMinY = quantizeMin(localMin.y);
+	dst.mMinZ = quantizeMin(localMin.z);
+	dst.mMaxX = quantizeMax(localMax.x);
+	dst.mMaxY = quantizeMax(localMax.y);
+	dst.mMaxZ = quantizeMax(localMax.z);
+	PX_ASSERT(dst.mMinX<=dst.mMaxX && dst.mMinY<=dst.mMaxY && dst.mMinZ<=dst.mMaxZ);
+}
+
+PX_FORCE_INLINE void Region::dequantize(MBP_AABB& dst, const MBP_Box& src) const
+{
+	// PT: this returns the bounds clamped to the region
+	const PxBounds3 bounds(	mQuantOrigin + PxVec3(float(src.mMinX), float(src.mMinY), float(src.mMinZ)).multiply(mDequantScale),
+							mQuantOrigin + PxVec3(float(src.mMaxX), float(src.mMaxY), float(src.mMaxZ)).multiply(mDequantScale));
+	dst.initFrom2(bounds);
+}
+#endif
+
 // Pre-sort static boxes
 #define STACK_BUFFER_SIZE_STATIC_SORT	8192
 	#define DEFAULT_NUM_DYNAMIC_BOXES 1024
@@ -785,7 +882,7 @@ void Region::staticSort()
 	// Allocate final buffers that wil contain the 2 (merged) streams
 	MBP_Index* newMapping = reinterpret_cast<MBP_Index*>(MBP_ALLOC(sizeof(MBP_Index)*mMaxNbStaticBoxes));
 	const PxU32 nbStaticSentinels = 2;
-	MBP_AABB* sortedBoxes = PX_NEW(MBP_AABB)[mMaxNbStaticBoxes+nbStaticSentinels];
+	MBP_Box* sortedBoxes = PX_NEW(MBP_Box)[mMaxNbStaticBoxes+nbStaticSentinels];
 	initSentinel(sortedBoxes[nbStaticBoxes]);
 	initSentinel(sortedBoxes[nbStaticBoxes+1]);
 
@@ -874,11 +971,11 @@ void Region::resizeObjects()
 	mMaxNbObjects = newMaxNbOjects;
 }
 
-static MBP_AABB* resizeBoxes(PxU32 oldNbBoxes, PxU32 newNbBoxes, const MBP_AABB* boxes)
+static MBP_Box* resizeBoxes(PxU32 oldNbBoxes, PxU32 newNbBoxes, const MBP_Box* boxes)
 {
-	MBP_AABB* newBoxes = PX_NEW(MBP_AABB)[newNbBoxes];
+	MBP_Box* newBoxes = PX_NEW(MBP_Box)[newNbBoxes];
 	if(oldNbBoxes)
-		PxMemCopy(newBoxes, boxes, oldNbBoxes*sizeof(MBP_AABB));
+		PxMemCopy(newBoxes, boxes, oldNbBoxes*sizeof(MBP_Box));
 	PX_DELETE_ARRAY(boxes);
 	return newBoxes;
 }
@@ -892,12 +989,12 @@ static MBP_Index* resizeMapping(PxU32 oldNbBoxes, PxU32 newNbBoxes, MBP_Index* m
 	return newMapping;
 }
 
-static PX_FORCE_INLINE void MTF(MBP_AABB* PX_RESTRICT dynamicBoxes, MBP_Index* PX_RESTRICT inToOut_Dynamic, MBPEntry* PX_RESTRICT objects, const MBP_AABB& bounds, PxU32 frontIndex, MBPEntry& updatedObject)
+static PX_FORCE_INLINE void MTF(MBP_Box* PX_RESTRICT dynamicBoxes, MBP_Index* PX_RESTRICT inToOut_Dynamic, MBPEntry* PX_RESTRICT objects, const MBP_Box& bounds, PxU32 frontIndex, MBPEntry& updatedObject)
 {
 	const PxU32 updatedIndex = updatedObject.mIndex;
 	if(frontIndex!=updatedIndex)
 	{
-		const MBP_AABB box0 = dynamicBoxes[frontIndex];
+		const MBP_Box box0 = dynamicBoxes[frontIndex];
 		dynamicBoxes[frontIndex] = bounds;
 		dynamicBoxes[updatedIndex] = box0;
 
@@ -937,6 +1034,9 @@ MBP_Index Region::addObject(const MBP_AABB& bounds, MBP_Handle mbpHandle, bool i
 	mNbObjects++;
 	///
 
+	MBP_Box box;
+	quantize(box, bounds);
+
 	PxU32 boxIndex;
 	if(isStatic)
 	{
@@ -950,7 +1050,7 @@ MBP_Index Region::addObject(const MBP_AABB& bounds, MBP_Handle mbpHandle, bool i
 		}
 
 		boxIndex = mNbStaticBoxes++;
-		mStaticBoxes[boxIndex] = bounds;
+		mStaticBoxes[boxIndex] = box;
 		mInToOut_Static[boxIndex] = handle;
 		mNeedsSorting = true;
 		mStaticBits.setBitChecked(boxIndex);
@@ -970,7 +1070,7 @@ MBP_Index Region::addObject(const MBP_AABB& bounds, MBP_Handle mbpHandle, bool i
 		}
 
 		boxIndex = mNbDynamicBoxes++;
-		mDynamicBoxes[boxIndex] = bounds;
+		mDynamicBoxes[boxIndex] = box;
 		mInToOut_Dynamic[boxIndex] = handle;
 	}
 
@@ -982,7 +1082,7 @@ MBP_Index Region::addObject(const MBP_AABB& bounds, MBP_Handle mbpHandle, bool i
 
 	if(!isStatic)
 	{
-		MTF(mDynamicBoxes, mInToOut_Dynamic, mObjects, bounds, mNbUpdatedBoxes, mObjects[handle]);
+		MTF(mDynamicBoxes, mInToOut_Dynamic, mObjects, box, mNbUpdatedBoxes, mObjects[handle]);
 		mNbUpdatedBoxes++;
 		mPrevNbUpdatedBoxes = 0;
 		mNeedsSortingSleeping = true;
@@ -992,7 +1092,7 @@ MBP_Index Region::addObject(const MBP_AABB& bounds, MBP_Handle mbpHandle, bool i
 }
 
 // Moves box 'lastIndex' to location 'removedBoxIndex'
-static PX_FORCE_INLINE void remove(MBPEntry* PX_RESTRICT objects, MBP_Index* PX_RESTRICT mapping, MBP_AABB* PX_RESTRICT boxes, PxU32 removedBoxIndex, PxU32 lastIndex)
+static PX_FORCE_INLINE void remove(MBPEntry* PX_RESTRICT objects, MBP_Index* PX_RESTRICT mapping, MBP_Box* PX_RESTRICT boxes, PxU32 removedBoxIndex, PxU32 lastIndex)
 {
 	const PxU32 movedBoxHandle = mapping[lastIndex];
 	boxes[removedBoxIndex] = boxes[lastIndex];				// Relocate box data
@@ -1010,7 +1110,7 @@ void Region::removeObject(MBP_Index handle)
 	/*const*/ PxU32 removedBoxIndex = object.mIndex;
 
 	MBP_Index* PX_RESTRICT mapping;
-	MBP_AABB* PX_RESTRICT boxes;
+	MBP_Box* PX_RESTRICT boxes;
 	PxU32 lastIndex;
 	if(!object.isStatic())
 	{
@@ -1080,6 +1180,9 @@ void Region::updateObject(const MBP_AABB& bounds, MBP_Index handle)
 {
 	PX_ASSERT(handle<mMaxNbObjects);
 
+	MBP_Box box;
+	quantize(box, bounds);
+
 	MBPEntry& object = mObjects[handle];
 	if(!object.isStatic())
 	{
@@ -1096,18 +1199,18 @@ void Region::updateObject(const MBP_AABB& bounds, MBP_Index handle)
 #if PX_DEBUG
 			object.mUpdated = true;
 #endif
-			MTF(mDynamicBoxes, mInToOut_Dynamic, mObjects, bounds, mNbUpdatedBoxes, object);
+			MTF(mDynamicBoxes, mInToOut_Dynamic, mObjects, box, mNbUpdatedBoxes, object);
 			mNbUpdatedBoxes++;
 			PX_ASSERT(mNbUpdatedBoxes<=mNbDynamicBoxes);
 		}
 		else
 		{
-			mDynamicBoxes[object.mIndex] = bounds;
+			mDynamicBoxes[object.mIndex] = box;
 		}
 	}
 	else
 	{
-		mStaticBoxes[object.mIndex] = bounds;
+		mStaticBoxes[object.mIndex] = box;
 		mNeedsSorting = true;	// ### not always!
 		mStaticBits.setBitChecked(object.mIndex);
 	}
@@ -1119,9 +1222,9 @@ MBP_Handle Region::retrieveBounds(MBP_AABB& bounds, MBP_Index handle) const
 
 	const MBPEntry& object = mObjects[handle];
 	if(!object.isStatic())
-		bounds = mDynamicBoxes[object.mIndex];
+		dequantize(bounds, mDynamicBoxes[object.mIndex]);
 	else
-		bounds = mStaticBoxes[object.mIndex];
+		dequantize(bounds, mStaticBoxes[object.mIndex]);
 
 	return object.mMBPHandle;
 }
@@ -1134,17 +1237,17 @@ void Region::setBounds(MBP_Index handle, const MBP_AABB& bounds)
 	if(!object.isStatic())
 	{
 		PX_ASSERT(object.mIndex < mNbDynamicBoxes);
-		mDynamicBoxes[object.mIndex] = bounds;
+		quantize(mDynamicBoxes[object.mIndex], bounds);
 	}
 	else
 	{
 		PX_ASSERT(object.mIndex < mNbStaticBoxes);
-		mStaticBoxes[object.mIndex] = bounds;
+		quantize(mStaticBoxes[object.mIndex], bounds);
 	}
 }
 
 #ifndef MBP_SIMD_OVERLAP
-static PX_FORCE_INLINE PxIntBool intersect2D(const MBP_AABB& a, const MBP_AABB& b)
+static PX_FORCE_INLINE PxIntBool intersect2D(const MBP_Box& a, const MBP_Box& b)
 {
 #ifdef MBP_USE_NO_CMP_OVERLAP
 		// PT: warning, only valid with the special encoding in InitFrom2
@@ -1175,7 +1278,7 @@ static PX_FORCE_INLINE PxIntBool intersect2D(const MBP_AABB& a, const MBP_AABB&
 #endif
 
 #ifdef MBP_USE_NO_CMP_OVERLAP_3D
-static PX_FORCE_INLINE bool intersect3D(const MBP_AABB& a, const MBP_AABB& b)
+static PX_FORCE_INLINE bool intersect3D(const MBP_Box& a, const MBP_Box& b)
 {
 	// PT: warning, only valid with the special encoding in InitFrom2
 	const PxU32 bits0 = (b.mMaxY - a.mMinY)&0x80000000;
@@ -1252,7 +1355,7 @@ void MBPOS_TmpBuffers::allocateSleeping(PxU32 nbSleeping, PxU32 nbSentinels)
 		}
 		else
 		{
-			mSleepingDynamicBoxes = PX_NEW(MBP_AABB)[nbSleeping+nbSentinels];
+			mSleepingDynamicBoxes = PX_NEW(MBP_Box)[nbSleeping+nbSentinels];
 			mInToOut_Dynamic_Sleeping = reinterpret_cast<MBP_Index*>(MBP_ALLOC(sizeof(MBP_Index)*nbSleeping));
 		}
 		mNbSleeping = nbSleeping;
@@ -1269,7 +1372,7 @@ void MBPOS_TmpBuffers::allocateUpdated(PxU32 nbUpdated, PxU32 nbSentinels)
 		if(nbUpdated+nbSentinels<=STACK_BUFFER_SIZE)
 			mUpdatedDynamicBoxes = mUpdatedDynamicBoxes_Stack;
 		else
-			mUpdatedDynamicBoxes = PX_NEW(MBP_AABB)[nbUpdated+nbSentinels];
+			mUpdatedDynamicBoxes = PX_NEW(MBP_Box)[nbUpdated+nbSentinels];
 
 		mNbUpdated = nbUpdated;
 	}
@@ -1291,7 +1394,7 @@ mNbUpdatedBoxes = 0;
 		mNeedsSortingSleeping = true;
 		return;
 	}
-	const MBP_AABB* PX_RESTRICT dynamicBoxes = mDynamicBoxes;
+	const MBP_Box* PX_RESTRICT dynamicBoxes = mDynamicBoxes;
 	PxU32* PX_RESTRICT posList = mPosList;
 
 #if PX_DEBUG
@@ -1362,7 +1465,7 @@ mNbUpdatedBoxes = 0;
 
 	// ### TODO: no need to recreate those buffers each frame!
 	MBP_Index* PX_RESTRICT inToOut_Dynamic_Sleeping = NULL;
-	MBP_AABB* PX_RESTRICT sleepingDynamicBoxes = NULL;
+	MBP_Box* PX_RESTRICT sleepingDynamicBoxes = NULL;
 	if(nbNonUpdated)
 	{
 		if(mNeedsSortingSleeping)
@@ -1409,7 +1512,7 @@ mNbUpdatedBoxes = 0;
 
 	const PxU32 nbSentinels = 2;
 	buffers.allocateUpdated(nbUpdated, nbSentinels);
-	MBP_AABB* PX_RESTRICT updatedDynamicBoxes = buffers.mUpdatedDynamicBoxes;
+	MBP_Box* PX_RESTRICT updatedDynamicBoxes = buffers.mUpdatedDynamicBoxes;
 	MBP_Index* PX_RESTRICT inToOut_Dynamic = reinterpret_cast<MBP_Index*>(mRS.GetRecyclable());
 	for(PxU32 i=0;i<nbUpdated;i++)
 	{
@@ -1453,8 +1556,8 @@ void Region::prepareBIPPruning(const MBPOS_TmpBuffers& buffers)
 static void doCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const BoxPruning_Input& input)
 {
 	const MBPEntry* PX_RESTRICT objects						= input.mObjects;
-	const MBP_AABB* PX_RESTRICT updatedDynamicBoxes			= input.mUpdatedDynamicBoxes;
-	const MBP_AABB* PX_RESTRICT sleepingDynamicBoxes		= input.mSleepingDynamicBoxes;
+	const MBP_Box* PX_RESTRICT updatedDynamicBoxes			= input.mUpdatedDynamicBoxes;
+	const MBP_Box* PX_RESTRICT sleepingDynamicBoxes		= input.mSleepingDynamicBoxes;
 	const MBP_Index* PX_RESTRICT inToOut_Dynamic			= input.mInToOut_Dynamic;
 	const MBP_Index* PX_RESTRICT inToOut_Dynamic_Sleeping	= input.mInToOut_Dynamic_Sleeping;
 	const PxU32 nbUpdated 									= input.mNbUpdated;
@@ -1474,7 +1577,7 @@ static void doCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const
 
 		while(runningIndex1<nb1 && index0<nb0)
 		{
-			const MBP_AABB& box0 = updatedDynamicBoxes[index0];
+			const MBP_Box& box0 = updatedDynamicBoxes[index0];
 			const PxU32 limit = box0.mMaxX;
 			SIMD_OVERLAP_PRELOAD_BOX0
 
@@ -1501,7 +1604,7 @@ static void doCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const
 		PxU32 runningIndex0 = 0;
 		while(runningIndex0<nb0 && index0<nb1)
 		{
-			const MBP_AABB& box0 = sleepingDynamicBoxes[index0];
+			const MBP_Box& box0 = sleepingDynamicBoxes[index0];
 			const PxU32 limit = box0.mMaxX;
 			SIMD_OVERLAP_PRELOAD_BOX0
 
@@ -1531,7 +1634,7 @@ static void doCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const
 	PxU32 runningIndex = 0;
 	while(runningIndex<nbUpdated && index0<nbUpdated)
 	{
-		const MBP_AABB& box0 = updatedDynamicBoxes[index0];
+		const MBP_Box& box0 = updatedDynamicBoxes[index0];
 		const PxU32 limit = box0.mMaxX;
 
 		SIMD_OVERLAP_PRELOAD_BOX0
@@ -1565,8 +1668,8 @@ static void doBipartiteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, cons
 	const PxU32 nb1 = input.mNbStaticBoxes;
 
 	const MBPEntry* PX_RESTRICT mObjects			= input.mObjects;
-	const MBP_AABB* PX_RESTRICT dynamicBoxes		= input.mDynamicBoxes;
-	const MBP_AABB* PX_RESTRICT staticBoxes			= input.mStaticBoxes;
+	const MBP_Box* PX_RESTRICT dynamicBoxes		= input.mDynamicBoxes;
+	const MBP_Box* PX_RESTRICT staticBoxes			= input.mStaticBoxes;
 	const MBP_Index* PX_RESTRICT inToOut_Static		= input.mInToOut_Static;
 	const MBP_Index* PX_RESTRICT inToOut_Dynamic	= input.mInToOut_Dynamic;
 
@@ -1583,7 +1686,7 @@ static void doBipartiteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, cons
 
 	while(runningIndex1<nb1 && index0<nb0)
 	{
-		const MBP_AABB& box0 = dynamicBoxes[index0];
+		const MBP_Box& box0 = dynamicBoxes[index0];
 		const PxU32 limit = box0.mMaxX;
 		SIMD_OVERLAP_PRELOAD_BOX0
 
@@ -1610,7 +1713,7 @@ static void doBipartiteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, cons
 	PxU32 runningIndex0 = 0;
 	while(runningIndex0<nb0 && index0<nb1)
 	{
-		const MBP_AABB& box0 = staticBoxes[index0];
+		const MBP_Box& box0 = staticBoxes[index0];
 		const PxU32 limit = box0.mMaxX;
 		SIMD_OVERLAP_PRELOAD_BOX0
 
@@ -1967,6 +2070,14 @@ void MBP::populateNewRegion(const MBP_AABB& box, Region* addedRegion, PxU32 regi
 
 					mbpHandle = currentRegion.mBP->retrieveBounds(bounds, h.mHandle);
 				}
+#ifdef MBP_USE_QUANTIZED_BOXES
+				// PT: quantized bounds are clamped to their region, and this object is not fully inside it. So we need the
+				// real bounds, retrieved from the AABB manager like for out-of-bounds objects below.
+				const PxBounds3 rawBounds = boundsArray[currentObject.mUserID];
+				PxVec3 c(contactDistance[currentObject.mUserID]);
+				const PxBounds3 decodedBounds(rawBounds.minimum - c, rawBounds.maximum + c);
+				bounds.initFrom2(decodedBounds);
+#endif
 			}
 			else
 			{
@@ -2108,6 +2219,9 @@ PxU32 MBP::addRegion(const PxBroadPhaseRegion& region, bool populateRegion, cons
 	}
 
 	Region* newRegion = PX_NEW(Region);
+#ifdef MBP_USE_QUANTIZED_BOXES
+	newRegion->setQuantizationBounds(region.mBounds);
+#endif
 	buffer->mBox.initFrom2(region.mBounds);
 	buffer->mBP			= newRegion;
 	buffer->mUserData	= region.mUserData;
@@ -2613,6 +2727,9 @@ bool MBP::updateObjectAfterRegionRemoval(MBP_Handle handle, Region* removedRegio
 	RegionHandle newHandles[MAX_NB_MBP+1];
 
 	// Parse previously overlapping regions. Keep all of them except removed one.
+	RegionHandle removedHandle;
+	removedHandle.mHandle = 0;
+	removedHandle.mInternalBPHandle = 0;
 	RegionHandle* handles = getHandles(currentObject, nbHandles);
 	for(PxU32 i=0;i<nbHandles;i++)
 	{
@@ -2620,6 +2737,52 @@ bool MBP::updateObjectAfterRegionRemoval(MBP_Handle handle, Region* removedRegio
 		PX_ASSERT(h.mInternalBPHandle<nbRegions);
 		if(regions[h.mInternalBPHandle].mBP!=removedRegion)
 			newHandles[nbNewHandles++] = h;
+		else
+			removedHandle = h;
+	}
+	PX_ASSERT(nbNewHandles==nbHandles-1);
+
+	if(!nbNewHandles)
+	{
+		// PT: the object was only touching the removed region. Before declaring it out-of-bounds we migrate it to the
+		// other regions it overlaps, if any. This typically happens when regions are rebalanced by adding new regions
+		// before removing the old ones: objects fully inside the old region have been skipped by populateNewRegion(),
+		// and they would otherwise go out-of-bounds here. The removed region's box has already been emptied so it
+		// does not show up in the search.
+		// PT: with MBP_USE_QUANTIZED_BOXES these bounds are clamped to the removed region. This is fine since objects
+		// that are not fully inside it have been added to all overlapping regions by populateNewRegion().
+		MBP_AABB bounds;
+		removedRegion->retrieveBounds(bounds, removedHandle.mHandle);
+
+		const PxU32 isStatic = decodeHandle_IsStatic(handle);
+#ifdef USE_FULLY_INSIDE_FLAG
+		bool isFullyInsideRegions = true;
+#endif
+		for(PxU32 i=0;i<nbRegions;i++)
+		{
+			if(regions[i].mBP && regions[i].mBP!=removedRegion && regions[i].mBox.intersects(bounds))
+			{
+#ifdef USE_FULLY_INSIDE_FLAG
+				if(!bounds.isInside(regions[i].mBox))
+					isFullyInsideRegions = false;
+#endif
+				RegionHandle& h = newHandles[nbNewHandles++];
+				h.mHandle = regions[i].mBP->addObject(bounds, handle, isStatic!=0);
+				h.mInternalBPHandle = PxTo16(i);
+			}
+		}
+
+		if(nbNewHandles)
+		{
+			// PT: pairs are found again in the new regions
+			mUpdatedObjects.setBitChecked(objectIndex);
+#ifdef USE_FULLY_INSIDE_FLAG
+			if(isFullyInsideRegions)
+				setBit(mFullyInsideBitmap, objectIndex);
+			else
+				clearBit(mFullyInsideBitmap, objectIndex);
+#endif
+		}
 	}
 #ifdef USE_FULLY_INSIDE_FLAG
 	// PT: in theory we should update the inside flag here but we don't do that for perf reasons.
@@ -2629,7 +2792,6 @@ bool MBP::updateObjectAfterRegionRemoval(MBP_Handle handle, Region* removedRegio
 	//   updated again anyway, so we live with this.
 #endif
 
-	PX_ASSERT(nbNewHandles==nbHandles-1);
 	purgeHandles(&currentObject, nbHandles);
 	storeHandles(&currentObject, nbNewHandles, newHandles);
 
@@ -2892,6 +3054,10 @@ void MBP::shiftOrigin(const PxVec3& shift, const PxBounds3* boundsArray, const P
 			bounds.maximum -= shift;
 
 			box.initFrom2(bounds);
+#ifdef MBP_USE_QUANTIZED_BOXES
+			// PT: objects are re-quantized by the setBounds() calls below
+			regions[i].mBP->setQuantizationBounds(bounds);
+#endif
 		}
 	}
 
@@ -40,7 +40,12 @@ namespace Bp
 
 #define MBP_USE_WORDS
 #define MBP_USE_NO_CMP_OVERLAP
-#if PX_INTEL_FAMILY && !defined(PX_SIMD_DISABLED)
+#if PX_EMSCRIPTEN
+	// PT: store 16-bit boxes quantized relative to each region's bounds, to halve the memory used by regions. The SSE2
+	// overlap test needs 32-bit values so it is disabled in this mode. Quantization is conservative (it can only create
+	// false positives in the broadphase, within the grid resolution of each region).
+	#define MBP_USE_QUANTIZED_BOXES
+#elif PX_INTEL_FAMILY && !defined(PX_SIMD_DISABLED)
 	#define MBP_SIMD_OVERLAP
 #endif
 
@@ -118,6 +123,24 @@ namespace Bp
 		PxU32 mMaxZ;
 	};
 
+#ifdef MBP_USE_QUANTIZED_BOXES
+	// PT: max quantized value. 0xffff is reserved for sentinels.
+	#define MBP_QUANTIZED_MAX	0xfffe
+
+	struct QAABB : public PxUserAllocated
+	{
+		PX_FORCE_INLINE PxU32	getMin(PxU32 i)	const	{	return (&mMinX)[i];	}
+		PX_FORCE_INLINE PxU32	getMax(PxU32 i)	const	{	return (&mMaxX)[i];	}
+
+		PxU16 mMinX;
+		PxU16 mMinY;
+		PxU16 mMinZ;
+		PxU16 mMaxX;
+		PxU16 mMaxY;
+		PxU16 mMaxZ;
+	};
+#endif
+
 	struct SIMD_AABB : public PxUserAllocated
 	{
 		PX_FORCE_INLINE	void	initFrom(const PxBounds3& box)
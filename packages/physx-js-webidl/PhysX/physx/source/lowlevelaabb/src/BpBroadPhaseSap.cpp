@@ -34,6 +34,7 @@
 #include "BpBroadPhaseSap.h"
 #include "BpBroadPhaseSapAux.h"
 #include "foundation/PxAllocator.h"
+#include "task/PxTaskManager.h"
 //#include <stdio.h>
 
 // PT: reactivated this. Ran UTs with SAP as default BP and nothing broke.
@@ -93,6 +94,7 @@ BroadPhaseSap::BroadPhaseSap(
 	const PxU32 maxNbDynamicShapes,
 	PxU64 contextID) :
 	mScratchAllocator	(NULL),
+	mCpuDispatcher		(NULL),
 	mContextID			(contextID)
 {
 	for(PxU32 i=0;i<3;i++)
@@ -485,13 +487,14 @@ bool BroadPhaseSap::isValid(const BroadPhaseUpdateData& updateData) const
 }
 #endif
 
-void BroadPhaseSap::update(PxcScratchAllocator* scratchAllocator, const BroadPhaseUpdateData& updateData, PxBaseTask* /*continuation*/)
+void BroadPhaseSap::update(PxcScratchAllocator* scratchAllocator, const BroadPhaseUpdateData& updateData, PxBaseTask* continuation)
 {
 	PX_CHECK_AND_RETURN(scratchAllocator, "BroadPhaseSap::update - scratchAllocator must be non-NULL \n");
 
 	if(setUpdateData(updateData))
 	{
 		mScratchAllocator = scratchAllocator;
+		mCpuDispatcher = continuation && continuation->getTaskManager() ? continuation->getTaskManager()->getCpuDispatcher() : NULL;
 
 		resizeBuffers();
 
@@ -923,7 +926,8 @@ void BroadPhaseSap::batchCreate()
 		ValType* bufferValues = bv.getBase();
 
 		// PT: TODO: use the scratch allocator
-		Cm::RadixSortBuffered RS;
+		// PT: large batches of created boxes (e.g. when a level gets loaded) are sorted in parallel
+		Cm::RadixSortParallel RS;
 
 		for(PxU32 Axis=0;Axis<3;Axis++)
 		{
@@ -943,8 +947,7 @@ void BroadPhaseSap::batchCreate()
 			// Sort endpoints backwards
 			BpHandle* bufferDatas;
 			{
-				RS.invalidateRanks();	// PT: there's no coherence between axes
-				const PxU32* Sorted = RS.Sort(newEPSortedValues, numEndPoints, Cm::RADIX_UNSIGNED).GetRanks();
+				const PxU32* Sorted = RS.Sort(newEPSortedValues, numEndPoints, Cm::RADIX_UNSIGNED, mCpuDispatcher).GetRanks();
 				bufferDatas = RS.GetRecyclable();
 
 				// PT: TODO: with two passes here we could reuse the "newEPSortedValues" buffer and drop "bufferValues"
@@ -38,6 +38,7 @@
 namespace physx
 {
 class PxcScratchAllocator;
+class PxCpuDispatcher;
 
 namespace Gu
 {
@@ -127,6 +128,7 @@ private:
 			void						resizeBuffers();
 
 			PxcScratchAllocator*		mScratchAllocator;
+			PxCpuDispatcher*			mCpuDispatcher;		// PT: used to sort the endpoints of created boxes in parallel
 
 	//Data passed in from updateV.
 			const BpHandle*				mCreated;				
@@ -38,6 +38,7 @@
 #include "foundation/PxUserAllocated.h"
 #include "PxsRigidBody.h"
 #include "DyResidualAccumulator.h"
+#include "PxFieldEffector.h"
 
 namespace physx
 {
@@ -60,6 +61,7 @@ class PxsContactManager;
 struct PxsContactManagerOutputCounts;
 
 class PxvNphaseImplementationContext;
+struct PxcNpWorkUnit;
 
 namespace Dy
 {
@@ -93,6 +95,16 @@ public:
 	PX_FORCE_INLINE PxU32					getSolverArticBatchSize()			const	{ return mSolverArticBatchSize; }
 	PX_FORCE_INLINE void					setSolverArticBatchSize(PxU32 f)			{ mSolverArticBatchSize = f;	}
 
+	PX_FORCE_INLINE PxReal					getSolverResidualTolerance()		const	{ return mSolverResidualTolerance;	}
+	PX_FORCE_INLINE void					setSolverResidualTolerance(PxReal f)		{ mSolverResidualTolerance = f;		}
+
+	PX_FORCE_INLINE PxU32					getSolverMinIterations()			const	{ return mSolverMinIterations;	}
+	PX_FORCE_INLINE void					setSolverMinIterations(PxU32 f)				{ mSolverMinIterations = f;		}
+
+	PX_FORCE_INLINE const PxFieldEffector*	getFieldEffectors()					const	{ return mFieldEffectors;	}
+	PX_FORCE_INLINE PxU32					getNbFieldEffectors()				const	{ return mNbFieldEffectors;	}
+	PX_FORCE_INLINE void					setFieldEffectors(const PxFieldEffector* effectors, PxU32 nb)	{ mFieldEffectors = effectors; mNbFieldEffectors = nb;	}
+
 	PX_FORCE_INLINE PxReal					getDt()								const	{ return mDt;		}
 	PX_FORCE_INLINE void					setDt(const PxReal dt)						{ mDt = dt;			}
 	// PT: TODO: we have a setDt function but it doesn't set the inverse dt, what's the story here?
@@ -185,6 +197,14 @@ public:
 	// Only used for Direct GPU API pipeline at the moment.
 	virtual void setActiveBreakableConstraintCount(PxU32 activeBreakableConstraintCount) { PX_UNUSED(activeBreakableConstraintCount); }
 
+	/**
+	\brief Called before the contact manager of a pair that goes to sleep is destroyed.
+	CPU contexts keep a copy of the pair's friction patches and use it to warm-start the pair when it wakes up.
+	\param[in] edgeIndex The island edge index of the pair, which survives the sleep/wake cycle
+	\param[in] unit The work unit of the contact manager about to be destroyed
+	*/
+	virtual void retainSleepingFrictionPatches(PxU32 edgeIndex, const PxcNpWorkUnit& unit) { PX_UNUSED(edgeIndex); PX_UNUSED(unit); }
+
 protected:
 
 	Context(IG::SimpleIslandManager& islandManager, PxVirtualAllocatorCallback* allocatorCallback,
@@ -201,6 +221,10 @@ protected:
 		mBounceThreshold			(-2.0f),
 		mLengthScale				(lengthScale),
 		mSolverBatchSize			(32),
+		mSolverResidualTolerance	(0.0f),
+		mSolverMinIterations		(1),
+		mFieldEffectors				(NULL),
+		mNbFieldEffectors			(0),
 		mConstraintWriteBackPool	(PxVirtualAllocator(allocatorCallback)),
 		mConstraintPositionIterResidualPoolGpu(PxVirtualAllocator(allocatorCallback)),
 		mIsResidualReportingEnabled(isResidualReportingEnabled),
@@ -282,6 +306,22 @@ protected:
 	*/
 	PxU32						mSolverArticBatchSize;
 
+	/**
+	\brief Contact residual below which single-threaded islands stop iterating. Zero disables the early exit.
+	*/
+	PxReal						mSolverResidualTolerance;
+
+	/**
+	\brief The minimum number of iterations per solver phase before an island is allowed to stop early.
+	*/
+	PxU32						mSolverMinIterations;
+
+	/**
+	\brief Field effectors applied to the bodies during pre-integration. Owned by the scene, valid for the duration of the step.
+	*/
+	const PxFieldEffector*		mFieldEffectors;
+	PxU32						mNbFieldEffectors;
+
 	/**
 	\brief Structure to encapsulate contact stream allocations. Used by GPU solver to reference pre-allocated pinned host memory
 	*/
@@ -31,6 +31,7 @@
 
 #include "PxvDynamics.h"
 #include "DySolverBody.h"
+#include "PxFieldEffector.h"
 
 namespace physx
 {
@@ -80,6 +81,76 @@ PX_FORCE_INLINE void bodyCoreComputeUnconstrainedVelocity
 	inOutAngularVelocity = angularVelocity;
 }
 
+// PT: applies the scene's field effectors to the linear velocity of an awake body. This runs for each pre-integrated body so the
+// bounds are tested here against the center of mass, rather than going through the broadphase.
+PX_FORCE_INLINE void bodyCoreApplyFieldEffectors(const PxFieldEffector* effectors, PxU32 nbEffectors, PxReal dt, const PxsBodyCore& core, PxVec3& inOutLinearVelocity)
+{
+	if(core.inverseMass==0.0f)
+		return;
+
+	const PxVec3& pos = core.body2World.p;
+	PxVec3 linearVelocity = inOutLinearVelocity;
+
+	for(PxU32 i=0; i<nbEffectors; i++)
+	{
+		const PxFieldEffector& effector = effectors[i];
+		if(!effector.bounds.contains(pos))
+			continue;
+
+		switch(effector.type)
+		{
+			case PxFieldEffectorType::eRADIAL_EXPLOSION:
+			{
+				const PxVec3 offset = pos - effector.position;
+				const PxReal distSq = offset.magnitudeSquared();
+				if(distSq >= effector.radius*effector.radius)
+					break;
+
+				const PxReal dist = PxSqrt(distSq);
+				const PxVec3 dir = dist > 1e-6f ? offset / dist : effector.direction;
+				linearVelocity += dir * (effector.strength * (1.0f - dist/effector.radius) * core.inverseMass);
+			}
+			break;
+
+			case PxFieldEffectorType::eWIND:
+			{
+				const PxVec3 flowVelocity = effector.direction * effector.strength;
+				linearVelocity += (flowVelocity - linearVelocity) * PxMin(effector.drag*dt, 1.0f);
+			}
+			break;
+
+			case PxFieldEffectorType::eVORTEX:
+			{
+				const PxVec3 offset = pos - effector.position;
+				const PxVec3 radial = offset - effector.direction * offset.dot(effector.direction);
+				const PxReal distSq = radial.magnitudeSquared();
+				if(distSq >= effector.radius*effector.radius || distSq < 1e-12f)
+					break;
+
+				const PxReal dist = PxSqrt(distSq);
+				const PxVec3 tangent = effector.direction.cross(radial) / dist;
+				const PxVec3 flowVelocity = tangent * (effector.strength * (1.0f - dist/effector.radius));
+				linearVelocity += (flowVelocity - linearVelocity) * PxMin(effector.drag*dt, 1.0f);
+			}
+			break;
+
+			case PxFieldEffectorType::eBUOYANCY_PLANE:
+			{
+				const PxReal depth = effector.direction.dot(effector.position - pos);
+				if(depth <= 0.0f)
+					break;
+
+				const PxReal submerged = PxMin(depth/effector.radius, 1.0f);
+				linearVelocity += effector.direction * (effector.strength * submerged * dt);
+				linearVelocity *= PxMax(1.0f - effector.drag * submerged * dt, 0.0f);
+			}
+			break;
+		}
+	}
+
+	inOutLinearVelocity = linearVelocity;
+}
+
 PX_FORCE_INLINE void integrateCore(PxVec3& motionLinearVelocity, PxVec3& motionAngularVelocity, 
 	PxSolverBody& solverBody, PxSolverBodyData& solverBodyData, PxF32 dt, PxU32 lockFlags)
 {
@@ -27,6 +27,7 @@
 #include "DyConstraintPartition.h"
 #include "foundation/PxHashMap.h"
 #include "DyFeatherstoneArticulation.h"
+#include "DyConstraint.h"
 
 using namespace physx;
 
@@ -683,6 +684,130 @@ static void outputOverflowConstraints(
 	}
 }
 
+
+// PT: constraints within a partition touch independent bodies, so their order inside the partition doesn't matter for
+// correctness. The batch headers however only merge consecutive rigid-body constraints of the same type, so e.g. a joint
+// or an articulation constraint in the middle of a run of contacts splits it into partially filled 4-wide batches. Here
+// we stable-sort each partition by batch type (rigid contacts, rigid 1D, everything else) so that the batching code
+// fills as many SIMD lanes as possible.
+static PX_FORCE_INLINE PxU32 getBatchType(const PxSolverConstraintDesc& desc)
+{
+	if(isArticulationConstraint(desc))
+		return 2;
+	if(desc.constraintType == DY_SC_TYPE_RB_CONTACT)
+		return 0;
+	if(desc.constraintType == DY_SC_TYPE_RB_1D)
+		return 1;
+	return 2;
+}
+
+// PT: joint chains (ropes, bridges, ragdolls) often mix several joint types. The 4-wide 1D setup calls each joint's prep
+// function in turn and pads every lane to the largest row count of the batch, so batches mixing e.g. a spherical and a
+// D6 joint waste both rows and instruction cache. This regroups a run of rigid 1D constraints by prep function with a
+// stable counting sort, so that consecutive 4-wide batches mostly contain joints of the same type. Only the first few
+// distinct prep functions get their own bucket, the rest keeps its original order at the end.
+static void groupByPrepFunction(PxSolverConstraintDesc* PX_RESTRICT dst, const PxSolverConstraintDesc* PX_RESTRICT src, PxU32 count)
+{
+	const PxU32 MaxNbBuckets = 8;
+	PxConstraintSolverPrep preps[MaxNbBuckets];
+	PxU32 offsets[MaxNbBuckets+1];
+	PxU32 nbBuckets = 0;
+	PxU32 nbLeftovers = 0;
+
+	for(PxU32 i=0; i<MaxNbBuckets+1; i++)
+		offsets[i] = 0;
+
+	for(PxU32 i=0; i<count; i++)
+	{
+		const PxConstraintSolverPrep prep = reinterpret_cast<const Constraint*>(src[i].constraint)->solverPrep;
+		PxU32 b=0;
+		while(b<nbBuckets && preps[b]!=prep)
+			b++;
+		if(b==nbBuckets)
+		{
+			if(nbBuckets==MaxNbBuckets)
+			{
+				nbLeftovers++;
+				continue;
+			}
+			preps[nbBuckets++] = prep;
+		}
+		offsets[b]++;
+	}
+
+	if(nbBuckets==1)
+	{
+		for(PxU32 i=0; i<count; i++)
+			dst[i] = src[i];
+		return;
+	}
+
+	// PT: exclusive prefix sum, leftovers go last
+	offsets[nbBuckets] = nbLeftovers;
+	PxU32 sum = 0;
+	for(PxU32 b=0; b<=nbBuckets; b++)
+	{
+		const PxU32 n = offsets[b];
+		offsets[b] = sum;
+		sum += n;
+	}
+
+	for(PxU32 i=0; i<count; i++)
+	{
+		const PxConstraintSolverPrep prep = reinterpret_cast<const Constraint*>(src[i].constraint)->solverPrep;
+		PxU32 b=0;
+		while(b<nbBuckets && preps[b]!=prep)
+			b++;
+		dst[offsets[b]++] = src[i];
+	}
+}
+
+static void groupPartitionsByBatchType(
+	const PxArray<PxU32>& accumulatedConstraintsPerPartition, PxU32 firstPartition,
+	PxSolverConstraintDesc* PX_RESTRICT eaOrderedConstraintDesc, PxSolverConstraintDesc* PX_RESTRICT scratch)
+{
+	const PxU32 nbPartitions = accumulatedConstraintsPerPartition.size();
+	PxU32 startIndex = firstPartition ? accumulatedConstraintsPerPartition[firstPartition-1] : 0;
+	for(PxU32 p=firstPartition; p<nbPartitions; p++)
+	{
+		const PxU32 endIndex = accumulatedConstraintsPerPartition[p];
+		if(endIndex - startIndex > 1)
+		{
+			// PT: contacts are compacted in place (write index never passes the read index), the rest goes to the
+			// scratch buffer as [1D ...|... others] and is copied back after the contacts.
+			PxSolverConstraintDesc* PX_RESTRICT descs = eaOrderedConstraintDesc + startIndex;
+			const PxU32 count = endIndex - startIndex;
+			PxU32 nbContacts = 0;
+			PxU32 nb1D = 0;
+			PxU32 nbOthers = 0;
+			for(PxU32 i=0; i<count; i++)
+			{
+				const PxU32 type = getBatchType(descs[i]);
+				if(type == 0)
+				{
+					if(nbContacts != i)
+						descs[nbContacts] = descs[i];
+					nbContacts++;
+				}
+				else if(type == 1)
+					scratch[nb1D++] = descs[i];
+				else
+					scratch[count - 1 - nbOthers++] = descs[i];	// PT: reversed, restored below
+			}
+
+			if(nbContacts != count)
+			{
+				PxSolverConstraintDesc* PX_RESTRICT dst = descs + nbContacts;
+				groupByPrepFunction(dst, scratch, nb1D);
+				dst += nb1D;
+				for(PxU32 i=0; i<nbOthers; i++)
+					*dst++ = scratch[count - 1 - i];
+			}
+		}
+		startIndex = endIndex;
+	}
+}
+
 }
 
 #define PX_NORMALIZE_PARTITIONS 1
@@ -853,6 +978,10 @@ static void batchConstraints(
 	// Next step, let's slot the overflow partitions into the first slot and work out targets for them...
 	if(numOverflows)
 		outputOverflowConstraints(constraintsPerPartition, eaOverflowConstraintDescriptors, numOverflows, eaOrderedConstraintDescriptors);
+
+	// PT: the overflow descriptors have been copied out so we can reuse that buffer as scratch. The overflow partition
+	// itself is left untouched since its constraints are not independent.
+	groupPartitionsByBatchType(constraintsPerPartition, numOverflows ? 1u : 0u, eaOrderedConstraintDescriptors, eaOverflowConstraintDescriptors);
 }
 
 PxU32 partitionContactConstraints(ConstraintPartitionOut& out, const ConstraintPartitionIn& in)
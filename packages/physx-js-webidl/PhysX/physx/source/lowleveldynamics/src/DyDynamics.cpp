@@ -162,6 +162,8 @@ void DynamicsContext::addThreadStats(const ThreadContext::ThreadSimStats& stats)
 	mSimStats.mNbActiveDynamicBodies += stats.numActiveDynamicBodies;
 	mSimStats.mNbActiveKinematicBodies += stats.numActiveKinematicBodies;
 	mSimStats.mNbAxisSolverConstraints += stats.numAxisSolverConstraints;
+	for(PxU32 i=0; i<4; i++)
+		mSimStats.mNbSolverBatches[i] += stats.numSolverBatches[i];
 }
 #else
 	PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
@@ -507,6 +509,20 @@ public:
 };
 #endif
 
+struct ThresholdStreamSortPredicate
+{
+	bool operator()(const ThresholdStreamElement& left, const ThresholdStreamElement& right) const
+	{
+		if(!(left.nodeIndexA == right.nodeIndexA))
+			return left.nodeIndexA < right.nodeIndexA;
+		if(!(left.nodeIndexB == right.nodeIndexB))
+			return left.nodeIndexB < right.nodeIndexB;
+		if(left.normalForce != right.normalForce)
+			return left.normalForce < right.normalForce;
+		return left.threshold < right.threshold;
+	}
+};
+
 class PxsForceThresholdTask  : public Cm::Task
 {
 	DynamicsContext&		mDynamicsContext;
@@ -613,7 +629,14 @@ public:
 
 	virtual void runInternal()
 	{
-		mDynamicsContext.getThresholdStream().forceSize_Unsafe(PxU32(mDynamicsContext.mThresholdStreamOut));
+		ThresholdStream& thresholdStream = mDynamicsContext.getThresholdStream();
+		thresholdStream.forceSize_Unsafe(PxU32(mDynamicsContext.mThresholdStreamOut));
+
+		// PT: solver threads append to the threshold stream through an atomic counter, so its order depends on the worker count.
+		// The table then accumulates forces in stream order, so we sort it first to make the results reproducible.
+		if(mDynamicsContext.mUseEnhancedDeterminism && thresholdStream.size())
+			PxSort(thresholdStream.begin(), thresholdStream.size(), ThresholdStreamSortPredicate());
+
 		createForceChangeThresholdStream();
 	}
 
@@ -647,6 +670,7 @@ class SolverArticulationUpdateTask : public Cm::Task
 public:
 
 	static const PxU32 NbArticulationsPerTask = 32;
+	static const PxU32 NbLinksPerTask = 128;
 
 	SolverArticulationUpdateTask(ThreadContext& islandThreadContext, FeatherstoneArticulation** articulations, ArticulationSolverDesc* articulationDescArray, PxU32 nbToProcess, Dy::DynamicsContext& context) :
 		Cm::Task(context.getContextId()), mIslandThreadContext(islandThreadContext), mArticulations(articulations), mArticulationDescArray(articulationDescArray), mNbToProcess(nbToProcess), mContext(context)
@@ -967,13 +991,25 @@ public:
 		ThreadContext& mThreadContext = *mIslandContext.mThreadContext;
 		ArticulationSolverDesc* articulationDescArray = mThreadContext.getArticulations().begin();
 
-		for(PxU32 i=0;i<mIslandContext.mCounts.articulations; i+= SolverArticulationUpdateTask::NbArticulationsPerTask)
+		// PT: tasks are sized by number of links as well as number of articulations, so that the work per task stays roughly
+		// constant. With many ragdoll-sized articulations this creates more, better balanced tasks than a fixed batch of
+		// NbArticulationsPerTask, and a task never contains more than NbArticulationsPerTask articulations.
+		const PxU32 nbArticulations = mIslandContext.mCounts.articulations;
+		PxU32 i = 0;
+		while(i<nbArticulations)
 		{
+			PxU32 nbToProcess = 0;
+			PxU32 nbLinks = 0;
+			while(i+nbToProcess<nbArticulations && nbToProcess<SolverArticulationUpdateTask::NbArticulationsPerTask && nbLinks<SolverArticulationUpdateTask::NbLinksPerTask)
+				nbLinks += mObjects.articulations[i+nbToProcess++]->getBodyCount();
+
 			SolverArticulationUpdateTask* task = PX_PLACEMENT_NEW(mContext.getTaskPool().allocate(sizeof(SolverArticulationUpdateTask)), SolverArticulationUpdateTask)(mThreadContext, 
-				&mObjects.articulations[i], &articulationDescArray[i], PxMin(SolverArticulationUpdateTask::NbArticulationsPerTask, mIslandContext.mCounts.articulations - i), mContext);
+				&mObjects.articulations[i], &articulationDescArray[i], nbToProcess, mContext);
 
 			task->setContinuation(mCont);
 			task->removeReference();
+
+			i += nbToProcess;
 		}
 	}
 
@@ -1414,9 +1450,16 @@ static void integrate(	const IG::IslandSim& islandSim, PxSolverBodyData* PX_REST
 		core.linearVelocity = data.linearVelocity;
 		core.angularVelocity = data.angularVelocity;
 
-		const PxU32 hasStaticTouch = islandSim.getIslandStaticTouchCount(PxNodeIndex(data.nodeIndex));
-		sleepCheck(rigidBodies[i], dt, enableStabilization, motionVelocityArray[i], hasStaticTouch);
+		if(enableStabilization)
+		{
+			const PxU32 hasStaticTouch = islandSim.getIslandStaticTouchCount(PxNodeIndex(data.nodeIndex));
+			sleepCheck(rigidBodies[i], dt, enableStabilization, motionVelocityArray[i], hasStaticTouch);
+		}
 	}
+
+	// PT: without stabilization the static touch counts aren't needed and the sleep check can run as a separate batched pass
+	if(!enableStabilization)
+		sleepCheck(rigidBodies, motionVelocityArray, count, dt);
 }
 
 class PxsSolverSetupSolveTask : public Cm::Task
@@ -1501,6 +1544,11 @@ public:
 					mThreadContext.contactConstraintBatchHeaders[numBatches].constraintType = type;
 					numBatches++;
 					numBatchesInPartition++;
+#if PX_ENABLE_SIM_STATS
+					mThreadContext.getSimStats().numSolverBatches[PxMin<PxU32>(newStride, 4) - 1]++;
+#else
+					PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
+#endif
 				}
 			}
 			PxU32 numHeaders = numBatchesInPartition;
@@ -1551,6 +1599,8 @@ public:
 				params.mMaxArticulationLinks = mThreadContext.mMaxArticulationLinks;
 				params.dt = mContext.mDt;
 				params.invDt = mContext.mInvDt;
+				params.residualTolerance = 0.0f;
+				params.minIterations = mContext.getSolverMinIterations();
 
 				const PxU32 unrollSize = 8;
 				const PxU32 denom = PxMax(1u, (mThreadContext.mMaxPartitions*unrollSize));
@@ -1600,6 +1650,12 @@ public:
 					params.deltaV = mThreadContext.mDeltaV.begin();
 					params.errorAccumulator = mContext.isResidualReportingEnabled() ? &mThreadContext.getSimStats().contactErrorAccumulator : NULL;
 
+					// PT: residuals are only computed for contacts, so islands with joints or articulations keep their full iteration counts.
+					// The multi-threaded solver does not support adaptive iteration counts, so with enhanced determinism we only use them
+					// when the island would not be split over several tasks regardless of the worker count.
+					if(params.errorAccumulator && !mIslandContext.mCounts.constraints && !mIslandContext.mCounts.articulations && (!mContext.mUseEnhancedDeterminism || idealThreads <= 1))
+						params.residualTolerance = mContext.getSolverResidualTolerance();
+
 					//Only one task - a small island so do a sequential solve (avoid the atomic overheads)
 					solveV_Blocks(params, mContext.solveFrictionEveryIteration());
 
@@ -1886,19 +1942,7 @@ void DynamicsContext::update(Cm::FlushPool& /*flushPool*/, PxBaseTask* continuat
 
 	const PxU32 islandCount = islandSim.getNbActiveIslands();
 
-	const PxU32 activatedContactCount = islandSim.getNbActivatedEdges(IG::Edge::eCONTACT_MANAGER);
-	const IG::EdgeIndex* const activatingEdges = islandSim.getActivatedEdges(IG::Edge::eCONTACT_MANAGER);
-
-	{
-		PX_PROFILE_ZONE("resetFrictionPatchCount", mContextID);
-
-		for (PxU32 a = 0; a < activatedContactCount; ++a)
-		{
-			PxsContactManager* cm = mIslandManager.getContactManager(activatingEdges[a]);
-			if (cm)
-				cm->getWorkUnit().mFrictionPatchCount = 0; //KS - zero the friction patch count on any activating edges
-		}
-	}
+	restoreActivatedFrictionPatches(islandSim);
 
 #if PX_ENABLE_SIM_STATS
 	if (islandCount > 0)
@@ -2026,6 +2070,7 @@ void DynamicsContext::updatePostKinematic(IG::SimpleIslandManager& simpleIslandM
 	const PxU32 solverBatchMax = mSolverBatchSize;
 	const PxU32 articulationBatchMax = mSolverArticBatchSize;
 	const PxU32 minimumConstraintCount = 1;
+	const PxU32 constraintBudget = computeIslandConstraintBudget(islandSim, lostTouchTask);
 
 	//create force threshold tasks to produce force change events
 	PxsForceThresholdTask* forceThresholdTask = PX_PLACEMENT_NEW(getTaskPool().allocate(sizeof(PxsForceThresholdTask)), PxsForceThresholdTask)(*this);
@@ -2066,7 +2111,8 @@ void DynamicsContext::updatePostKinematic(IG::SimpleIslandManager& simpleIslandM
 
 		//KS - logic is a bit funky here. We will keep rolling the island together provided currentIsland < islandCount AND either we haven't exceeded the max number of bodies or we have
 		//zero constraints AND we haven't exceeded articulation batch counts (it's still currently beneficial to keep articulations in separate islands but this is only temporary).
-		while((currentIsland < islandCount && (nbBodies < solverBatchMax || constraintCount < minimumConstraintCount)) && 
+		// PT: we also stop once the constraint budget is reached, see computeIslandConstraintBudget()
+		while((currentIsland < islandCount && ((nbBodies < solverBatchMax && constraintCount < constraintBudget) || constraintCount < minimumConstraintCount)) && 
 			nbArticulations < articulationBatchMax)
 		{
 			const IG::Island& island = islandSim.getIsland(islandIds[currentIsland]);
@@ -2150,7 +2196,9 @@ static void preIntegrationParallel(
 	PxSolverBodyData* solverBodyDataPool,			// IN: solver body data pool (space preallocated)
 	volatile PxU32* maxSolverPositionIterations,
 	volatile PxU32* maxSolverVelocityIterations,
-	const PxVec3& gravity)
+	const PxVec3& gravity,
+	const PxFieldEffector* fieldEffectors,
+	PxU32 nbFieldEffectors)
 {
 	PxU32 localMaxPosIter = 0;
 	PxU32 localMaxVelIter = 0;
@@ -2170,6 +2218,9 @@ static void preIntegrationParallel(
 		localMaxPosIter = PxMax<PxU32>(PxU32(iterWord & 0xff), localMaxPosIter);
 		localMaxVelIter = PxMax<PxU32>(PxU32(iterWord >> 8), localMaxVelIter);
 
+		if(nbFieldEffectors)
+			bodyCoreApplyFieldEffectors(fieldEffectors, nbFieldEffectors, dt, core, core.linearVelocity);
+
 		//const Cm::SpatialVector& accel = originalBodyArray[i]->getAccelerationV();
 		bodyCoreComputeUnconstrainedVelocity(gravity, dt, core.linearDamping, core.angularDamping, rBody.mAccelScale, core.maxLinearVelocitySq, core.maxAngularVelocitySq, 
 			core.linearVelocity, core.angularVelocity, core.disableGravity!=0);
@@ -2185,6 +2236,9 @@ static void preIntegrationParallel(
 	localMaxPosIter = PxMax<PxU32>(PxU32(iterWord & 0xff), localMaxPosIter);
 	localMaxVelIter = PxMax<PxU32>(PxU32(iterWord >> 8), localMaxVelIter);
 
+	if(nbFieldEffectors)
+		bodyCoreApplyFieldEffectors(fieldEffectors, nbFieldEffectors, dt, core, core.linearVelocity);
+
 	bodyCoreComputeUnconstrainedVelocity(gravity, dt, core.linearDamping, core.angularDamping, rBody.mAccelScale, core.maxLinearVelocitySq, core.maxAngularVelocitySq,
 		core.linearVelocity, core.angularVelocity, core.disableGravity!=0);
 
@@ -2200,7 +2254,8 @@ void PxsPreIntegrateTask::runInternal()
 	PX_PROFILE_ZONE("PreIntegration", mContextID);
 
 	preIntegrationParallel(mDt, mBodyArray + mStartIndex, mOriginalBodyArray + mStartIndex, mNodeIndexArray + mStartIndex, mNumToIntegrate,
-						mSolverBodyDataPool + mStartIndex, mMaxSolverPositionIterations, mMaxSolverVelocityIterations, mGravity);
+						mSolverBodyDataPool + mStartIndex, mMaxSolverPositionIterations, mMaxSolverVelocityIterations, mGravity,
+						mContext.getFieldEffectors(), mContext.getNbFieldEffectors());
 }
 
 void DynamicsContext::preIntegrationParallel(
@@ -28,7 +28,11 @@
 
 #include "DyDynamicsBase.h"
 #include "PxsIslandSim.h"
+#include "PxsSimpleIslandManager.h"
+#include "PxsContactManager.h"
 #include "common/PxProfileZone.h"
+#include "task/PxTask.h"
+#include "task/PxCpuDispatcher.h"
 
 using namespace physx;
 using namespace Dy;
@@ -125,3 +129,119 @@ PxU32 DynamicsContextBase::reserveSharedSolverConstraintsArrays(const IG::Island
 
 	return totalConstraintCount;
 }
+
+// PT: island packing. Solver data is laid out in active island order, so only consecutive islands can be merged into the
+// same solver job. The PGS/TGS updatePostKinematic() loops used to merge islands until mSolverBatchSize bodies were reached,
+// which for a scene made of many small contact-heavy piles gives a handful of huge jobs and idle workers. We now also close
+// a job once it reaches a constraint budget, sized to give a few jobs per worker thread. Islands larger than the budget are
+// still solved alone in their job, where the existing partitioning spreads them over the workers.
+#define DY_ISLAND_JOBS_PER_WORKER		4u
+#define DY_ISLAND_MIN_CONSTRAINT_BUDGET	64u
+
+PxU32 DynamicsContextBase::computeIslandConstraintBudget(const IG::IslandSim& islandSim, const PxBaseTask* task) const
+{
+	// PT: the budget depends on the worker count, which changes the island packing and thus the SIMD batching of constraints.
+	// This is disabled with enhanced determinism, so that results are identical regardless of the number of threads.
+	if(mUseEnhancedDeterminism)
+		return PX_MAX_U32;
+
+	const PxTaskManager* taskManager = task ? task->getTaskManager() : NULL;
+	const PxCpuDispatcher* dispatcher = taskManager ? taskManager->getCpuDispatcher() : NULL;
+	const PxU32 nbWorkers = dispatcher ? PxMax(dispatcher->getWorkerCount(), 1u) : 1u;
+
+	const PxU32 nbActiveContactManagers = islandSim.getNbActiveEdges(IG::Edge::eCONTACT_MANAGER);
+	const PxU32 nbActiveConstraints = islandSim.getNbActiveEdges(IG::Edge::eCONSTRAINT);
+
+	return PxMax((nbActiveContactManagers + nbActiveConstraints) / (nbWorkers * DY_ISLAND_JOBS_PER_WORKER), DY_ISLAND_MIN_CONSTRAINT_BUDGET);
+}
+
+// PT: pairs with more patches than this are not retained, they simply restart without friction anchors as before
+#define DY_MAX_SLEEPING_FRICTION_PATCHES	4u
+
+void DynamicsContextBase::retainSleepingFrictionPatches(PxU32 edgeIndex, const PxcNpWorkUnit& unit)
+{
+	const PxHashMap<PxU32, SleepingFrictionPatches>::Entry* entry = mSleepingFrictionPatches.find(edgeIndex);
+
+	const PxU32 nbPatches = unit.mFrictionPatchCount;
+	if(!nbPatches || nbPatches > DY_MAX_SLEEPING_FRICTION_PATCHES || !unit.mFrictionDataPtr)
+	{
+		// PT: drop stale data from a previous owner of this edge index, if any
+		if(entry)
+		{
+			mFreeSleepingFrictionSlots.pushBack(entry->second.mSlot);
+			mSleepingFrictionPatches.erase(edgeIndex);
+		}
+		return;
+	}
+
+	PxU32 slot;
+	if(entry)
+		slot = entry->second.mSlot;
+	else if(mFreeSleepingFrictionSlots.size())
+		slot = mFreeSleepingFrictionSlots.popBack();
+	else
+	{
+		slot = mSleepingFrictionPatchSlots.size() / DY_MAX_SLEEPING_FRICTION_PATCHES;
+		mSleepingFrictionPatchSlots.resizeUninitialized(mSleepingFrictionPatchSlots.size() + DY_MAX_SLEEPING_FRICTION_PATCHES);
+	}
+
+	SleepingFrictionPatches data;
+	data.mRigidCore0	= unit.mRigidCore0;
+	data.mRigidCore1	= unit.mRigidCore1;
+	data.mShapeCore0	= unit.getShapeCore0();
+	data.mShapeCore1	= unit.getShapeCore1();
+	data.mSlot			= slot;
+	data.mNbPatches		= nbPatches;
+	mSleepingFrictionPatches[edgeIndex] = data;
+
+	const FrictionPatch* src = reinterpret_cast<const FrictionPatch*>(unit.mFrictionDataPtr);
+	FrictionPatch* dst = mSleepingFrictionPatchSlots.begin() + slot * DY_MAX_SLEEPING_FRICTION_PATCHES;
+	for(PxU32 i=0; i<nbPatches; i++)
+		dst[i] = src[i];
+}
+
+// PT: called at the start of the PGS/TGS update. Activated pairs normally restart with no friction patches since their
+// previous patches are gone. If we retained them when the pair went to sleep, and the new contact manager still refers to
+// the same shapes, we hand them back so that the first solve after wake-up is warm-started by the friction correlation.
+// The slot must stay valid until contact prep has read it, so it is only recycled at the next update.
+void DynamicsContextBase::restoreActivatedFrictionPatches(const IG::IslandSim& islandSim)
+{
+	PX_PROFILE_ZONE("resetFrictionPatchCount", mContextID);
+
+	for(PxU32 i=0; i<mRestoredSleepingFrictionSlots.size(); i++)
+		mFreeSleepingFrictionSlots.pushBack(mRestoredSleepingFrictionSlots[i]);
+	mRestoredSleepingFrictionSlots.forceSize_Unsafe(0);
+
+	const PxU32 activatedContactCount = islandSim.getNbActivatedEdges(IG::Edge::eCONTACT_MANAGER);
+	const IG::EdgeIndex* const activatingEdges = islandSim.getActivatedEdges(IG::Edge::eCONTACT_MANAGER);
+
+	const bool hasSleepingPatches = mSleepingFrictionPatches.size() != 0;
+
+	for(PxU32 a = 0; a < activatedContactCount; ++a)
+	{
+		PxsContactManager* cm = mIslandManager.getContactManager(activatingEdges[a]);
+		if(cm)
+			cm->getWorkUnit().mFrictionPatchCount = 0; //KS - zero the friction patch count on any activating edges
+
+		if(hasSleepingPatches)
+		{
+			const PxHashMap<PxU32, SleepingFrictionPatches>::Entry* entry = mSleepingFrictionPatches.find(activatingEdges[a]);
+			if(entry)
+			{
+				const SleepingFrictionPatches& data = entry->second;
+				if(cm)
+				{
+					PxcNpWorkUnit& unit = cm->getWorkUnit();
+					if(		data.mRigidCore0 == unit.mRigidCore0 && data.mRigidCore1 == unit.mRigidCore1
+						&&	data.mShapeCore0 == unit.getShapeCore0() && data.mShapeCore1 == unit.getShapeCore1())
+					{
+						unit.mFrictionDataPtr = reinterpret_cast<PxU8*>(mSleepingFrictionPatchSlots.begin() + data.mSlot * DY_MAX_SLEEPING_FRICTION_PATCHES);
+						unit.mFrictionPatchCount = PxTo8(data.mNbPatches);
+					}
+				}
+				mRestoredSleepingFrictionSlots.pushBack(data.mSlot);
+				mSleepingFrictionPatches.erase(activatingEdges[a]);
+			}
+		}
+	}
+}
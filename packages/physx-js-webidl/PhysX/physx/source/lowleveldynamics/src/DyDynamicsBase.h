@@ -34,6 +34,8 @@
 #include "PxvNphaseImplementationContext.h"
 #include "PxsIslandManagerTypes.h"
 #include "solver/PxSolverDefs.h"
+#include "DyFrictionPatch.h"
+#include "foundation/PxHashMap.h"
 
 namespace physx
 {
@@ -111,9 +113,33 @@ public:
 	PxI32	mThresholdStreamOut;	// Atomic counter for the number of threshold stream elements.
 	PxU32	mCurrentIndex;			// this is the index point to the current exceeded force threshold stream
 
+	// Context
+	virtual	void	retainSleepingFrictionPatches(PxU32 edgeIndex, const PxcNpWorkUnit& unit)	PX_OVERRIDE;
+	//~Context
+
 protected:
+	// PT: friction patches of sleeping contact pairs, keyed by island edge index. Contact managers are destroyed when a pair goes
+	// to sleep, and the friction patch stream they pointed to is recycled a frame later, so without this woken pairs restart
+	// with no friction anchors. Patches are stored in fixed-size slots to keep the side buffer compact.
+	struct SleepingFrictionPatches
+	{
+		const PxsRigidCore*	mRigidCore0;
+		const PxsRigidCore*	mRigidCore1;
+		const PxsShapeCore*	mShapeCore0;
+		const PxsShapeCore*	mShapeCore1;
+		PxU32				mSlot;
+		PxU32				mNbPatches;
+	};
+
+	PxHashMap<PxU32, SleepingFrictionPatches>	mSleepingFrictionPatches;
+	PxArray<FrictionPatch>						mSleepingFrictionPatchSlots;
+	PxArray<PxU32>								mFreeSleepingFrictionSlots;
+	PxArray<PxU32>								mRestoredSleepingFrictionSlots;	// Handed out to woken pairs this frame, recycled next frame
+
 	void	resetThreadContexts();
+	void	restoreActivatedFrictionPatches(const IG::IslandSim& islandSim);
 	PxU32	reserveSharedSolverConstraintsArrays(const IG::IslandSim& islandSim, PxU32 maxArticulationLinks);
+	PxU32	computeIslandConstraintBudget(const IG::IslandSim& islandSim, const PxBaseTask* task)	const;
 };
 
 }
@@ -27,8 +27,10 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "DySleep.h"
+#include "foundation/PxVecMath.h"
 
 using namespace physx;
+using namespace aos;
 
 // PT: TODO: refactor this, parts of the two codepaths are very similar
 
@@ -234,3 +236,145 @@ void Dy::sleepCheck(PxsRigidBody* originalBody, PxReal dt, bool enableStabilizat
 		originalBody->resetSleepFilter();
 	}
 }
+
+static PX_FORCE_INLINE void deactivateIfAsleep(PxsRigidBody* originalBody, PxReal wc)
+{
+	if(wc == 0.0f)
+	{
+		originalBody->mInternalFlags |= PxsRigidBody::eDEACTIVATE_THIS_FRAME;
+		originalBody->resetSleepFilter();
+	}
+}
+
+// PT: this is the non-stabilization codepath of updateWakeCounter(), restructured in three passes:
+// - a scalar pass that ticks the wake counter of bodies that are not close to sleeping yet, and gathers the others
+// (the candidates) into SoA arrays after accumulating their velocities,
+// - a SIMD pass that computes the normalized energies of the candidates and tests them against their thresholds, 4 at a time,
+// - a scalar pass that wakes up or ticks the candidates depending on the test results.
+// The energies are computed with the same operations in the same order as the scalar code, so the results are identical.
+void Dy::sleepCheck(PxsRigidBody*const* bodies, const Cm::SpatialVector* motionVelocities, PxU32 nbBodies, PxReal dt)
+{
+	const PxReal wakeCounterResetTime = 20.0f*0.02f;
+
+	const PxU32 BatchSize = 64;
+	PxU32 candidates[BatchSize];
+	PX_ALIGN(16, PxReal linX[BatchSize]);
+	PX_ALIGN(16, PxReal linY[BatchSize]);
+	PX_ALIGN(16, PxReal linZ[BatchSize]);
+	PX_ALIGN(16, PxReal angX[BatchSize]);
+	PX_ALIGN(16, PxReal angY[BatchSize]);
+	PX_ALIGN(16, PxReal angZ[BatchSize]);
+	PX_ALIGN(16, PxReal inertiaX[BatchSize]);
+	PX_ALIGN(16, PxReal inertiaY[BatchSize]);
+	PX_ALIGN(16, PxReal inertiaZ[BatchSize]);
+	PX_ALIGN(16, PxReal invMasses[BatchSize]);
+	PX_ALIGN(16, PxReal thresholds[BatchSize]);
+	PX_ALIGN(16, PxReal energies[BatchSize]);
+	PxU32 aboveThreshold[BatchSize/4];
+
+	const FloatV half = FLoad(0.5f);
+
+	for(PxU32 batchStart=0; batchStart<nbBodies; batchStart+=BatchSize)
+	{
+		const PxU32 batchEnd = PxMin(batchStart + BatchSize, nbBodies);
+
+		// Pass 1: tick or gather
+		PxU32 nbCandidates = 0;
+		for(PxU32 i=batchStart; i<batchEnd; i++)
+		{
+			PxsRigidBody* originalBody = bodies[i];
+			PxsBodyCore& bodyCore = originalBody->getCore();
+
+			const PxReal wc = bodyCore.wakeCounter;
+			if(wc < wakeCounterResetTime * 0.5f || wc < dt)
+			{
+				const Cm::SpatialVector& motionVelocity = motionVelocities[i];
+
+				originalBody->mSleepLinVelAcc += motionVelocity.linear;
+				originalBody->mSleepAngVelAcc += bodyCore.body2World.q.rotateInv(motionVelocity.angular);
+
+				const PxVec3& t = bodyCore.inverseInertia;
+				const PxReal invMass = bodyCore.inverseMass;
+
+				linX[nbCandidates] = originalBody->mSleepLinVelAcc.x;
+				linY[nbCandidates] = originalBody->mSleepLinVelAcc.y;
+				linZ[nbCandidates] = originalBody->mSleepLinVelAcc.z;
+				angX[nbCandidates] = originalBody->mSleepAngVelAcc.x;
+				angY[nbCandidates] = originalBody->mSleepAngVelAcc.y;
+				angZ[nbCandidates] = originalBody->mSleepAngVelAcc.z;
+				inertiaX[nbCandidates] = t.x > 0.0f ? 1.0f / t.x : 1.0f;
+				inertiaY[nbCandidates] = t.y > 0.0f ? 1.0f / t.y : 1.0f;
+				inertiaZ[nbCandidates] = t.z > 0.0f ? 1.0f / t.z : 1.0f;
+				invMasses[nbCandidates] = invMass == 0.0f ? 1.0f : invMass;
+				thresholds[nbCandidates] = PxReal(1 + bodyCore.numCountedInteractions) * bodyCore.sleepThreshold;
+				candidates[nbCandidates++] = i;
+			}
+			else
+			{
+				const PxReal newWc = PxMax(wc - dt, 0.0f);
+				bodyCore.solverWakeCounter = newWc;
+				deactivateIfAsleep(originalBody, newWc);
+			}
+		}
+
+		if(!nbCandidates)
+			continue;
+
+		// Pass 2: energy threshold test, 4 candidates at a time. The last group is padded with copies of the last candidate.
+		const PxU32 nbGroups = (nbCandidates + 3)/4;
+		for(PxU32 i=nbCandidates; i<nbGroups*4; i++)
+		{
+			const PxU32 last = nbCandidates - 1;
+			linX[i] = linX[last];			linY[i] = linY[last];			linZ[i] = linZ[last];
+			angX[i] = angX[last];			angY[i] = angY[last];			angZ[i] = angZ[last];
+			inertiaX[i] = inertiaX[last];	inertiaY[i] = inertiaY[last];	inertiaZ[i] = inertiaZ[last];
+			invMasses[i] = invMasses[last];
+			thresholds[i] = thresholds[last];
+		}
+
+		for(PxU32 g=0; g<nbGroups; g++)
+		{
+			const PxU32 o = g*4;
+			const Vec4V lx = V4LoadA(linX + o);
+			const Vec4V ly = V4LoadA(linY + o);
+			const Vec4V lz = V4LoadA(linZ + o);
+			const Vec4V ax = V4LoadA(angX + o);
+			const Vec4V ay = V4LoadA(angY + o);
+			const Vec4V az = V4LoadA(angZ + o);
+
+			const Vec4V angular = V4Mul(V4Add(V4Add(V4Mul(V4Mul(ax, ax), V4LoadA(inertiaX + o)), V4Mul(V4Mul(ay, ay), V4LoadA(inertiaY + o))), V4Mul(V4Mul(az, az), V4LoadA(inertiaZ + o))), V4LoadA(invMasses + o));
+			const Vec4V linear = V4Add(V4Add(V4Mul(lx, lx), V4Mul(ly, ly)), V4Mul(lz, lz));
+			const Vec4V energy = V4Scale(V4Add(angular, linear), half);
+
+			V4StoreA(energy, energies + o);
+			aboveThreshold[g] = BGetBitMask(V4IsGrtrOrEq(energy, V4LoadA(thresholds + o)));
+		}
+
+		// Pass 3: wake up or tick the candidates
+		for(PxU32 c=0; c<nbCandidates; c++)
+		{
+			PxsRigidBody* originalBody = bodies[candidates[c]];
+			PxsBodyCore& bodyCore = originalBody->getCore();
+
+			PxReal wc = bodyCore.wakeCounter;
+			if(aboveThreshold[c>>2] & (1u<<(c&3)))
+			{
+				originalBody->resetSleepFilter();
+
+				const PxReal threshold = thresholds[c];
+				const PxReal clusterFactor = PxReal(1 + bodyCore.numCountedInteractions);
+				const float factor = threshold == 0.0f ? 2.0f : PxMin(energies[c] / threshold, 2.0f);
+				const PxReal oldWc = wc;
+				wc = factor * 0.5f * wakeCounterResetTime + dt * (clusterFactor - 1.0f);
+				bodyCore.solverWakeCounter = wc;
+				originalBody->mInternalFlags = oldWc == 0.0f ? PxU16(PxsRigidBody::eACTIVATE_THIS_FRAME) : PxU16(0);
+			}
+			else
+			{
+				wc = PxMax(wc - dt, 0.0f);
+				bodyCore.solverWakeCounter = wc;
+			}
+			deactivateIfAsleep(originalBody, wc);
+		}
+	}
+}
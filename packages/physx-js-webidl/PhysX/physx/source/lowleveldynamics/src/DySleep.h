@@ -38,6 +38,9 @@ namespace physx
 namespace Dy
 {
 	void sleepCheck(PxsRigidBody* originalBody, PxReal dt, bool enableStabilization, const Cm::SpatialVector& motionVelocity, PxIntBool hasStaticTouch);
+
+	// PT: batched version of the above, for the non-stabilization case only. Equivalent to calling sleepCheck() for each body.
+	void sleepCheck(PxsRigidBody*const* bodies, const Cm::SpatialVector* motionVelocities, PxU32 nbBodies, PxReal dt);
 }
 }
 
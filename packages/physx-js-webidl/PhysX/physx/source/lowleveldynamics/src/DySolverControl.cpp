@@ -119,6 +119,13 @@ void solveV_Blocks(SolverIslandParams& params, bool solveFrictionEveryIteration)
 	const bool isTGS = false;
 	const bool residualReportingActive = params.errorAccumulator != NULL;
 
+	// PT: adaptive iteration counts. The island stops iterating once the max contact residual drops below the tolerance.
+	// Friction is then solved in all iterations, otherwise the residuals of the early iterations would not account for it.
+	const PxReal residualTolerance = residualReportingActive ? params.residualTolerance : 0.0f;
+	const bool adaptiveIterations = residualTolerance > 0.0f;
+	const PxU32 minIterations = params.minIterations;
+	solveFrictionEveryIteration = solveFrictionEveryIteration || adaptiveIterations;
+
 	const PxI32 TempThresholdStreamSize = 32;
 	ThresholdStreamElement tempThresholdStream[TempThresholdStreamSize];
 
@@ -178,6 +185,10 @@ void solveV_Blocks(SolverIslandParams& params, bool solveFrictionEveryIteration)
 			articulationListStart[i].articulation->solveInternalConstraints(params.dt, params.dt, params.invDt, false, isTGS, 0.f, biasCoefficient, residualReportingActive);
 
 		++normalIter;
+
+		// PT: converged => jump directly to the conclude iteration
+		if(adaptiveIterations && iteration > 2 && PxU32(normalIter) >= minIterations && cache.contactErrorAccumulator->mMaxError < residualTolerance)
+			iteration = 2;
 	}
 
 	saveMotionVelocities(bodyListSize, bodyListStart, motionVelocityArray);
@@ -200,6 +211,10 @@ void solveV_Blocks(SolverIslandParams& params, bool solveFrictionEveryIteration)
 		for (PxU32 i = 0; i < articulationListSize; ++i)
 			articulationListStart[i].articulation->solveInternalConstraints(params.dt, params.dt, params.invDt, true, isTGS, 0.f, biasCoefficient, residualReportingActive);
 		++normalIter;
+
+		// PT: converged => jump directly to the writeback iteration
+		if(adaptiveIterations && PxU32(iteration + 1) >= minIterations && cache.contactErrorAccumulator->mMaxError < residualTolerance)
+			break;
 	}
 
 	PxI32* outThresholdPairs = params.outThresholdPairs;
@@ -186,6 +186,8 @@ struct SolverIslandParams
 	PxU32 mMaxArticulationLinks;	// PT: not really needed by the solvers themselves
 	Cm::SpatialVectorF* deltaV;		// PT: only used by the single-threaded solver for temporarily storing velocities during propagation
 	Dy::ErrorAccumulatorEx* errorAccumulator; //only used by the single-threaded solver
+	PxReal residualTolerance;	// PT: only used by the single-threaded solver. Zero disables the early exit.
+	PxU32 minIterations;		// PT: only used by the single-threaded solver
 };
 
 void solveNoContactsCase(	PxU32 bodyListSize, const PxSolverBody* PX_RESTRICT bodyListStart, Cm::SpatialVector* PX_RESTRICT motionVelocityArray,
@@ -538,19 +538,7 @@ void DynamicsTGSContext::update(Cm::FlushPool& /*flushPool*/, PxBaseTask* contin
 
 	const PxU32 islandCount = islandSim.getNbActiveIslands();
 
-	const PxU32 activatedContactCount = islandSim.getNbActivatedEdges(IG::Edge::eCONTACT_MANAGER);
-	const IG::EdgeIndex* const activatingEdges = islandSim.getActivatedEdges(IG::Edge::eCONTACT_MANAGER);
-
-	{
-		PX_PROFILE_ZONE("resetFrictionPatchCount", mContextID);
-
-		for (PxU32 a = 0; a < activatedContactCount; ++a)
-		{
-			PxsContactManager* cm = mIslandManager.getContactManager(activatingEdges[a]);
-			if (cm)
-				cm->getWorkUnit().mFrictionPatchCount = 0; //KS - zero the friction patch count on any activating edges
-		}
-	}
+	restoreActivatedFrictionPatches(islandSim);
 
 #if PX_ENABLE_SIM_STATS
 	if (islandCount > 0)
@@ -691,6 +679,8 @@ void DynamicsTGSContext::updatePostKinematic(IG::SimpleIslandManager& simpleIsla
 
 	const PxU32 articulationBatchSize = mSolverArticBatchSize;
 
+	const PxU32 constraintBudget = computeIslandConstraintBudget(islandSim, continuation);
+
 	while (currentIsland < islandCount)
 	{
 		SolverIslandObjectsStep objectStarts;
@@ -716,7 +706,8 @@ void DynamicsTGSContext::updatePostKinematic(IG::SimpleIslandManager& simpleIsla
 		PxU32 nbConstraints = 0;
 		PxU32 nbContactManagers = 0;
 
-		while (nbBodies < minIslandSize && currentIsland < islandCount && nbArticulations < articulationBatchSize)
+		// PT: we also stop once the constraint budget is reached, see computeIslandConstraintBudget()
+		while (nbBodies < minIslandSize && constraintCount < constraintBudget && currentIsland < islandCount && nbArticulations < articulationBatchSize)
 		{
 			const IG::Island& island = islandSim.getIsland(islandIds[currentIsland]);
 
@@ -994,6 +985,8 @@ void DynamicsTGSContext::preIntegrateBodies(PxsBodyCore** bodyArray, PxsRigidBod
 	PX_PROFILE_ZONE("PreIntegrate", mContextID);
 
 	const bool skipGravity = mIsExternalForcesEveryTgsIterationEnabled;
+	const PxFieldEffector* fieldEffectors = getFieldEffectors();
+	const PxU32 nbFieldEffectors = getNbFieldEffectors();
 
 	PxU32 localMaxPosIter = 0;
 	PxU32 localMaxVelIter = 0;
@@ -1006,6 +999,9 @@ void DynamicsTGSContext::preIntegrateBodies(PxsBodyCore** bodyArray, PxsRigidBod
 		localMaxPosIter = PxMax<PxU32>(PxU32(iterWord & 0xff), localMaxPosIter);
 		localMaxVelIter = PxMax<PxU32>(PxU32(iterWord >> 8), localMaxVelIter);
 
+		if(nbFieldEffectors)
+			bodyCoreApplyFieldEffectors(fieldEffectors, nbFieldEffectors, dt, core, core.linearVelocity);
+
 		//const Cm::SpatialVector& accel = originalBodyArray[i]->getAccelerationV();
 		bodyCoreComputeUnconstrainedVelocity(gravity, dt, core.linearDamping, core.angularDamping, rBody.mAccelScale, core.maxLinearVelocitySq, core.maxAngularVelocitySq,
 			core.linearVelocity, core.angularVelocity, core.disableGravity!=0 || skipGravity);
@@ -1550,6 +1546,13 @@ void DynamicsTGSContext::copyBackBodies(const SolverIslandObjectsStep& objects,
 	PxTGSSolverBodyData* solverBodyDatas, PxReal invDt, IG::IslandSim& islandSim,
 	PxU32 startIdx, PxU32 endIdx)
 {
+	// PT: without stabilization the sleep check runs as a separate batched pass, over small chunks of bodies
+	const bool batchedSleepCheck = !mEnableStabilization;
+	const PxU32 SleepBatchSize = 64;
+	PxsRigidBody* sleepBodies[SleepBatchSize];
+	Cm::SpatialVector sleepMotionVels[SleepBatchSize];
+	PxU32 nbSleepBodies = 0;
+
 	for (PxU32 k = startIdx; k < endIdx; k++)
 	{
 		//PxStepSolverBody& solverBodyData = solverBodyData2[k + 1];
@@ -1573,9 +1576,25 @@ void DynamicsTGSContext::copyBackBodies(const SolverIslandObjectsStep& objects,
 		core.linearVelocity = linearVelocity;
 		core.angularVelocity = angularVelocity;
 
-		const PxU32 hasStaticTouch = islandSim.getIslandStaticTouchCount(PxNodeIndex(solverBodyData.nodeIndex));
-		sleepCheck(&rBody, mDt, mEnableStabilization, motionVel, hasStaticTouch);
+		if(batchedSleepCheck)
+		{
+			sleepBodies[nbSleepBodies] = &rBody;
+			sleepMotionVels[nbSleepBodies] = motionVel;
+			if(++nbSleepBodies == SleepBatchSize)
+			{
+				sleepCheck(sleepBodies, sleepMotionVels, nbSleepBodies, mDt);
+				nbSleepBodies = 0;
+			}
+		}
+		else
+		{
+			const PxU32 hasStaticTouch = islandSim.getIslandStaticTouchCount(PxNodeIndex(solverBodyData.nodeIndex));
+			sleepCheck(&rBody, mDt, mEnableStabilization, motionVel, hasStaticTouch);
+		}
 	}
+
+	if(nbSleepBodies)
+		sleepCheck(sleepBodies, sleepMotionVels, nbSleepBodies, mDt);
 }
 
 void DynamicsTGSContext::stepArticulations(Dy::ThreadContext& threadContext, const PxsIslandIndices& counts, PxReal dt, PxReal totalInvDt)
@@ -2363,6 +2382,11 @@ public:
 					headers[numBatches].constraintType = type;
 					numBatches++;
 					numBatchesInPartition++;
+#if PX_ENABLE_SIM_STATS
+					mThreadContext.getSimStats().numSolverBatches[PxMin<PxU32>(newStride, 4) - 1]++;
+#else
+					PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
+#endif
 				}
 			}
 			currIndex += mThreadContext.mConstraintsPerPartition[a];
@@ -2427,9 +2451,13 @@ public:
 
 			const PxU32 nbIdealThreads = (nbHeadersPerPartition + NbBatchesPerThread-1) / NbBatchesPerThread;
 
+			// PT: the parallel solver does not support adaptive iteration counts. With enhanced determinism we only allow them
+			// for islands that would be solved on a single thread anyway, so that results do not depend on the worker count.
+			const bool allowEarlyExit = !mContext.mUseEnhancedDeterminism || nbIdealThreads < 2;
+
 			if (threadCount < 2 || nbIdealThreads < 2) // not great if we have many articulations but no contact constraints => PX-4708
 				mContext.iterativeSolveIsland(mObjects, mCounts, mThreadContext, mIslandContext.mStepDt, mIslandContext.mInvStepDt, mTotalDt,
-					mIslandContext.mPosIters, mIslandContext.mVelIters, cache, mIslandContext.mBiasCoefficient);
+					mIslandContext.mPosIters, mIslandContext.mVelIters, cache, mIslandContext.mBiasCoefficient, allowEarlyExit);
 			else
 			{
 				mIslandContext.mSharedSolverIndex = 0;
@@ -2457,7 +2485,7 @@ public:
 		{
 			mContext.iterativeSolveIsland(mObjects, mCounts, mThreadContext, mIslandContext.mStepDt,
 				mIslandContext.mInvStepDt, mTotalDt, mIslandContext.mPosIters, mIslandContext.mVelIters, cache,
-				mIslandContext.mBiasCoefficient);
+				mIslandContext.mBiasCoefficient, true);
 		}
 	}
 };
@@ -2512,7 +2540,7 @@ public:
 };
 
 void DynamicsTGSContext::iterativeSolveIsland(const SolverIslandObjectsStep& objects, const PxsIslandIndices& counts, ThreadContext& mThreadContext,
-	PxReal stepDt, PxReal invStepDt, PxReal totalDt, PxU32 posIters, PxU32 velIters, SolverContext& cache, PxReal biasCoefficient)
+	PxReal stepDt, PxReal invStepDt, PxReal totalDt, PxU32 posIters, PxU32 velIters, SolverContext& cache, PxReal biasCoefficient, bool allowEarlyExit)
 {
 	PX_PROFILE_ZONE("Dynamics:solveIsland", mContextID);
 	PxReal elapsedTime = 0.0f;
@@ -2624,6 +2652,10 @@ void DynamicsTGSContext::iterativeSolveIsland(const SolverIslandObjectsStep& obj
 		ArticulationPImpl::saveVelocityTGS(desc.articulation, invDt);
 	}
 
+	// PT: adaptive iteration counts. Position iterations are substeps so only velocity iterations can stop early. Residuals
+	// are only computed for contacts, so islands with joints or articulations keep their full iteration counts.
+	const PxReal residualTolerance = (allowEarlyExit && mIsResidualReportingEnabled && !counts.constraints && !counts.articulations) ? mSolverResidualTolerance : 0.0f;
+
 	cache.contactErrorAccumulator = mIsResidualReportingEnabled ? &mThreadContext.getSimStats().contactErrorAccumulator.mVelocityIterationErrorAccumulator : NULL;
 	cache.isPositionIteration = false;
 	for (PxU32 a = 0; a < velIters; ++a)
@@ -2638,6 +2670,9 @@ void DynamicsTGSContext::iterativeSolveIsland(const SolverIslandObjectsStep& obj
 			d.articulation->solveInternalConstraints(totalDt, stepDt, recipStepDt, true, true, elapsedTime, biasCoefficient,
 													 mIsResidualReportingEnabled, mIsExternalForcesEveryTgsIterationEnabled);
 		}
+
+		if(residualTolerance > 0.0f && a + 1 >= mSolverMinIterations && cache.contactErrorAccumulator->mMaxError < residualTolerance)
+			break;
 	}
 
 	writebackConstraintsIteration(objects.constraintBatchHeaders, objects.orderedConstraintDescs, mThreadContext.numContactConstraintBatches, cache);
@@ -3343,6 +3378,14 @@ void DynamicsTGSContext::mergeResults()
 				threadContext->getSimStats().contactErrorAccumulator.reset();
 			}
 
+			// PT: the other thread stats are not used by the TGS solver, only the batch counts are merged
+			PxU32* nbSolverBatches = threadContext->getSimStats().numSolverBatches;
+			for (PxU32 i = 0; i < 4; i++)
+			{
+				mSimStats.mNbSolverBatches[i] += nbSolverBatches[i];
+				nbSolverBatches[i] = 0;
+			}
+
 			threadContext = threadContextIt.getNext();
 		}
 	}
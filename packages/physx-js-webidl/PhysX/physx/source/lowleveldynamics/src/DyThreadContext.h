@@ -75,12 +75,15 @@ public:
 			numActiveDynamicBodies = 0;
 			numActiveKinematicBodies = 0;
 			numAxisSolverConstraints = 0;
+			for(PxU32 i=0; i<4; i++)
+				numSolverBatches[i] = 0;
 		}
 
 		PxU32 numActiveConstraints;
 		PxU32 numActiveDynamicBodies;
 		PxU32 numActiveKinematicBodies;
 		PxU32 numAxisSolverConstraints;
+		PxU32 numSolverBatches[4];	// PT: per batch width, index = width-1
 
 		Dy::ErrorAccumulatorEx contactErrorAccumulator;
 	};
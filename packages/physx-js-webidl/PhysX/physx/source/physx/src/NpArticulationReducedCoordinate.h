@@ -186,6 +186,7 @@ namespace physx
 		}
 		PX_FORCE_INLINE	NpArticulationLink* const*	getLinks() { return mArticulationLinks.begin(); }
 		PX_FORCE_INLINE	const NpArticulationLink* const * getLinks() const { return mArticulationLinks.begin(); }
+		PX_FORCE_INLINE	PxU32						getCacheVersion() const { return mCacheVersion; }
 
 		NpArticulationLink*							getRoot();
 		void										setAggregate(PxAggregate* a);
@@ -816,6 +816,45 @@ void NpFactory::releaseConnectorArray(NpConnectorArray* array)
 
 ///////////////////////////////////////////////////////////////////////////////
 
+template<class PoolT>
+static PX_FORCE_INLINE PxU32 releaseEmptySlabs(PoolT& pool, PxMutex& lock)
+{
+	PxMutex::ScopedLock l(lock);
+	return pool.releaseEmptySlabs();
+}
+
+PxU32 NpFactory::compactMemory()
+{
+	PxU32 nbReleased = releaseEmptySlabs(mConnectorArrayPool, mConnectorArrayPoolLock);
+	nbReleased += releaseEmptySlabs(mRigidDynamicPool, mRigidDynamicPoolLock);
+	nbReleased += releaseEmptySlabs(mRigidStaticPool, mRigidStaticPoolLock);
+	nbReleased += releaseEmptySlabs(mShapePool, mShapePoolLock);
+	nbReleased += releaseEmptySlabs(mAggregatePool, mAggregatePoolLock);
+	nbReleased += releaseEmptySlabs(mConstraintPool, mConstraintPoolLock);
+	nbReleased += releaseEmptySlabs(mMaterialPool, mMaterialPoolLock);
+	nbReleased += releaseEmptySlabs(mArticulationRCPool, mArticulationRCPoolLock);
+	nbReleased += releaseEmptySlabs(mArticulationLinkPool, mArticulationLinkPoolLock);
+	nbReleased += releaseEmptySlabs(mArticulationRCJointPool, mArticulationJointRCPoolLock);
+	nbReleased += releaseEmptySlabs(mArticulationMimicJointPool, mArticulationMimicJointPoolLock);
+#if PX_SUPPORT_GPU_PHYSX
+	nbReleased += releaseEmptySlabs(mDeformableSurfacePool, mDeformableSurfacePoolLock);
+	nbReleased += releaseEmptySlabs(mDeformableVolumePool, mDeformableVolumePoolLock);
+	nbReleased += releaseEmptySlabs(mAttachmentPool, mAttachmentPoolLock);
+	nbReleased += releaseEmptySlabs(mElementFilterPool, mElementFilterPoolLock);
+	nbReleased += releaseEmptySlabs(mPBDParticleSystemPool, mPBDParticleSystemPoolLock);
+	nbReleased += releaseEmptySlabs(mParticleBufferPool, mParticleBufferPoolLock);
+	nbReleased += releaseEmptySlabs(mParticleAndDiffuseBufferPool, mParticleAndDiffuseBufferPoolLock);
+	nbReleased += releaseEmptySlabs(mParticleClothBufferPool, mParticleClothBufferPoolLock);
+	nbReleased += releaseEmptySlabs(mParticleRigidBufferPool, mParticleRigidBufferPoolLock);
+	nbReleased += releaseEmptySlabs(mDeformableSurfaceMaterialPool, mDeformableSurfaceMaterialPoolLock);
+	nbReleased += releaseEmptySlabs(mDeformableVolumeMaterialPool, mDeformableVolumeMaterialPoolLock);
+	nbReleased += releaseEmptySlabs(mPBDMaterialPool, mPBDMaterialPoolLock);
+#endif
+	return nbReleased;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 #if PX_CHECKED
 bool checkShape(const PxGeometry& g, const char* errorMsg)
 {
@@ -1004,6 +1043,22 @@ void NpFactory::addCollection(const Collection& collection)
 	// PT: we take the lock only once, here
 	PxMutex::ScopedLock lock(mTrackingMutex);
 
+	// PT: size the tracking sets once, instead of rehashing them several times for large collections
+	{
+		PxU32 nbActors = 0;
+		PxU32 nbShapes = 0;
+		for(PxU32 i=0;i<nb;i++)
+		{
+			const PxType serialType = entries[i].first->getConcreteType();
+			if(serialType==PxConcreteType::eRIGID_DYNAMIC || serialType==PxConcreteType::eRIGID_STATIC)
+				nbActors++;
+			else if(serialType==PxConcreteType::eSHAPE)
+				nbShapes++;
+		}
+		mActorTracking.reserve(mActorTracking.size() + nbActors);
+		mShapeTracking.reserve(mShapeTracking.size() + nbShapes);
+	}
+
 	for(PxU32 i=0;i<nb;i++)
 	{
 		PxBase* s = entries[i].first;
@@ -264,6 +264,9 @@ public:
 #endif
 				NpConnectorArray*						acquireConnectorArray();
 				void									releaseConnectorArray(NpConnectorArray*);
+
+				// Releases empty slabs from all object pools. Returns the number of released bytes.
+				PxU32									compactMemory();
 				
 	PX_FORCE_INLINE	NpPtrTableStorageManager&			getPtrTableStorageManager()	{ return *mPtrTableStorageManager; }
 
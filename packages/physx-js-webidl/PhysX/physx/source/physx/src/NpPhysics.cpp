@@ -448,6 +448,11 @@ PxU32 NpPhysics::getScenes(PxScene** userBuffer, PxU32 bufferSize, PxU32 startIn
 	return Cm::getArrayOfPointers(userBuffer, bufferSize, startIndex, mSceneArray.begin(), mSceneArray.size());
 }
 
+PxU32 NpPhysics::compactMemory()
+{
+	return NpFactory::getInstance().compactMemory();
+}
+
 PxRigidStatic* NpPhysics::createRigidStatic(const PxTransform& globalPose)
 {
 	PX_CHECK_AND_RETURN_NULL(globalPose.isSane(), "PxPhysics::createRigidStatic: invalid transform");
@@ -1015,6 +1020,20 @@ PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors
 	return ps;
 }
 
+PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, const void* treeData, PxU32 treeDataSize)
+{
+	PX_ASSERT(actors);
+	PX_ASSERT(nbActors > 0);
+	PX_ASSERT(treeData);
+
+	Sq::PruningStructure* ps = PX_NEW(Sq::PruningStructure)();
+	if(!ps->build(actors, nbActors, treeData, treeDataSize))
+	{
+		PX_DELETE(ps);
+	}
+	return ps;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #if PX_SUPPORT_GPU_PHYSX && !PX_PUBLIC_RELEASE
@@ -168,11 +168,13 @@ public:
 	virtual		PxScene*	createScene(const PxSceneDesc&)	PX_OVERRIDE;
 	virtual		PxU32		getNbScenes()	const	PX_OVERRIDE;
 	virtual		PxU32		getScenes(PxScene** userBuffer, PxU32 bufferSize, PxU32 startIndex=0) const	PX_OVERRIDE;
+	virtual		PxU32		compactMemory()	PX_OVERRIDE;
 
 	// Actors
 	virtual		PxRigidStatic*		createRigidStatic(const PxTransform&)	PX_OVERRIDE;
 	virtual		PxRigidDynamic*		createRigidDynamic(const PxTransform&)	PX_OVERRIDE;
 	virtual		PxPruningStructure*	createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors)	PX_OVERRIDE;
+	virtual		PxPruningStructure*	createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, const void* treeData, PxU32 treeDataSize)	PX_OVERRIDE;
 
 	// Shapes
 	virtual		PxShape*	createShape(const PxGeometry&, PxMaterial*const *, PxU16, bool, PxShapeFlags shapeFlags)	PX_OVERRIDE;
@@ -50,6 +50,39 @@ using namespace Gu;
 
 #define PS_NB_OBJECTS_PER_NODE	4
 
+#define PS_TREE_DATA_MAGIC		PX_MAKE_FOURCC('P','S','T','D')
+#define PS_TREE_DATA_VERSION	1
+#define PS_TREE_DATA_ALIGN		16
+
+namespace
+{
+	// PT: header of the buffer written by exportTreeData(). Offsets are relative to the start of the buffer, so that the
+	// buffer can be used in place from any address. Nodes and indices follow the header, each array aligned to PS_TREE_DATA_ALIGN.
+	struct TreeDataHeader
+	{
+		PxU32	mMagic;
+		PxU32	mVersion;
+		PxU32	mNbNodes[2];
+		PxU32	mNbObjects[2];
+		PxU32	mNodesOffset[2];
+		PxU32	mIndicesOffset[2];
+	};
+}
+
+static PX_FORCE_INLINE PxU32 alignTreeDataOffset(PxU32 offset)
+{
+	return (offset + PS_TREE_DATA_ALIGN - 1) & ~(PS_TREE_DATA_ALIGN - 1);
+}
+
+static void setPruningStructure(PxActor* actor, PruningStructure* ps)
+{
+	const PxType type = actor->getConcreteType();
+	if(type == PxConcreteType::eRIGID_STATIC)
+		static_cast<NpRigidStatic*>(actor)->getShapeManager().setPruningStructure(ps);
+	else if(type == PxConcreteType::eRIGID_DYNAMIC)
+		static_cast<NpRigidDynamic*>(actor)->getShapeManager().setPruningStructure(ps);
+}
+
 //////////////////////////////////////////////////////////////////////////
 PruningStructure::PruningStructure(PxBaseFlags baseFlags)
 	: PxPruningStructure(baseFlags)
@@ -59,7 +92,7 @@ PruningStructure::PruningStructure(PxBaseFlags baseFlags)
 //////////////////////////////////////////////////////////////////////////
 PruningStructure::PruningStructure()
 	: PxPruningStructure(PxConcreteType::ePRUNING_STRUCTURE, PxBaseFlag::eOWNS_MEMORY | PxBaseFlag::eIS_RELEASABLE),
-	mNbActors(0), mActors(0), mValid(true)
+	mNbActors(0), mActors(0), mValid(true), mExternalTreeData(false)
 {
 	for(PxU32 i=0; i<2; i++)
 		mData[i].init();
@@ -70,10 +103,13 @@ PruningStructure::~PruningStructure()
 {	
 	if(getBaseFlags() & PxBaseFlag::eOWNS_MEMORY)
 	{
-		for(PxU32 i=0; i<2; i++)
+		if(!mExternalTreeData)
 		{
-			PX_FREE(mData[i].mAABBTreeIndices);
-			PX_FREE(mData[i].mAABBTreeNodes);
+			for(PxU32 i=0; i<2; i++)
+			{
+				PX_FREE(mData[i].mAABBTreeIndices);
+				PX_FREE(mData[i].mAABBTreeNodes);
+			}
 		}
 
 		PX_FREE(mActors);
@@ -87,12 +123,7 @@ void PruningStructure::release()
 	for (PxU32 i = 0; i < mNbActors; i++)
 	{		
 		PX_ASSERT(mActors[i]);			
-
-		PxType type = mActors[i]->getConcreteType();
-		if (type == PxConcreteType::eRIGID_STATIC)
-			static_cast<NpRigidStatic*>(mActors[i])->getShapeManager().setPruningStructure(NULL);
-		else if (type == PxConcreteType::eRIGID_DYNAMIC)
-			static_cast<NpRigidDynamic*>(mActors[i])->getShapeManager().setPruningStructure(NULL);
+		setPruningStructure(mActors[i], NULL);
 	}
 
 	if(getBaseFlags() & PxBaseFlag::eOWNS_MEMORY)
@@ -120,12 +151,10 @@ static void getShapeBounds(PxRigidActor* actor, bool dynamic, PxBounds3* bounds,
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors)
+bool PruningStructure::registerActors(PxRigidActor*const* actors, PxU32 nbActors, PxU32* numShapes)
 {
-	PX_ASSERT(actors);
-	PX_ASSERT(nbActors > 0);
-	
-	PxU32 numShapes[2] = { 0, 0 };	
+	numShapes[PruningIndex::eSTATIC] = 0;
+	numShapes[PruningIndex::eDYNAMIC] = 0;
 	// parse the actors first to get the shapes size
 	for (PxU32 actorsDone = 0; actorsDone < nbActors; actorsDone++)
 	{
@@ -191,6 +220,18 @@ bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors)
 			return false;
 		}
 	}
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors)
+{
+	PX_ASSERT(actors);
+	PX_ASSERT(nbActors > 0);
+	
+	PxU32 numShapes[2];
+	if(!registerActors(actors, nbActors, numShapes))
+		return false;
 	
 	AABBTreeBounds bounds[2];
 
@@ -251,6 +292,67 @@ bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors)
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors, const void* treeData, PxU32 treeDataSize)
+{
+	PX_ASSERT(actors);
+	PX_ASSERT(nbActors > 0);
+
+	// validate the tree data before touching the actors
+	const PxU8* base = reinterpret_cast<const PxU8*>(treeData);
+	const TreeDataHeader* header = reinterpret_cast<const TreeDataHeader*>(base);
+	if(!base || (size_t(base) & (PS_TREE_DATA_ALIGN - 1)) || treeDataSize < sizeof(TreeDataHeader)
+		|| header->mMagic != PS_TREE_DATA_MAGIC || header->mVersion != PS_TREE_DATA_VERSION)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PrunerStructure::build: Provided tree data is invalid or not 16-byte aligned!");
+		return false;
+	}
+
+	for(PxU32 i = 0; i < 2; i++)
+	{
+		// PT: 64-bit math, so that corrupted counts cannot wrap around
+		const PxU64 nodesEnd = PxU64(header->mNodesOffset[i]) + PxU64(header->mNbNodes[i]) * sizeof(BVHNode);
+		const PxU64 indicesEnd = PxU64(header->mIndicesOffset[i]) + PxU64(header->mNbObjects[i]) * sizeof(PxU32);
+		if(nodesEnd > treeDataSize || indicesEnd > treeDataSize || (header->mNodesOffset[i] & (PS_TREE_DATA_ALIGN - 1)) || (header->mIndicesOffset[i] & (PS_TREE_DATA_ALIGN - 1))
+			|| (header->mNbObjects[i] && !header->mNbNodes[i]))
+		{
+			PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PrunerStructure::build: Provided tree data is truncated or corrupted!");
+			return false;
+		}
+	}
+
+	PxU32 numShapes[2];
+	if(!registerActors(actors, nbActors, numShapes))
+		return false;
+
+	if(numShapes[PruningIndex::eSTATIC] != header->mNbObjects[PruningIndex::eSTATIC] || numShapes[PruningIndex::eDYNAMIC] != header->mNbObjects[PruningIndex::eDYNAMIC])
+	{
+		for(PxU32 i = 0; i < nbActors; i++)
+			setPruningStructure(actors[i], NULL);
+
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PrunerStructure::build: Provided actors do not match the tree data!");
+		return false;
+	}
+
+	// relocate the offsets. The data itself is used in place and never written to.
+	for(PxU32 i = 0; i < 2; i++)
+	{
+		if(header->mNbObjects[i])
+		{
+			mData[i].init(header->mNbNodes[i], reinterpret_cast<BVHNode*>(const_cast<PxU8*>(base + header->mNodesOffset[i])),
+				header->mNbObjects[i], reinterpret_cast<PxU32*>(const_cast<PxU8*>(base + header->mIndicesOffset[i])));
+		}
+	}
+	mExternalTreeData = true;
+
+	// store the actors for verification and serialization
+	mNbActors = nbActors;
+	mActors = PX_ALLOCATE(PxActor*, mNbActors, "PxActor*");
+	PxMemCopy(mActors, actors, sizeof(PxActor*)*mNbActors);
+
+	return true;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 PruningStructure* PruningStructure::createObject(PxU8*& address, PxDeserializationContext& context)
@@ -361,6 +463,64 @@ const void* PruningStructure::getDynamicMergeData()		const
 	return &mData[PruningIndex::eDYNAMIC];
 }
 
+PxU32 PruningStructure::getTreeDataSize()	const
+{
+	if(!isValid())
+		return 0;
+
+	PxU32 size = alignTreeDataOffset(sizeof(TreeDataHeader));
+	for(PxU32 i = 0; i < 2; i++)
+	{
+		if(mData[i].mAABBTreeNodes)
+		{
+			size = alignTreeDataOffset(size + mData[i].mNbNodes * sizeof(BVHNode));
+			size = alignTreeDataOffset(size + mData[i].mNbObjects * sizeof(PxU32));
+		}
+	}
+	return size;
+}
+
+bool PruningStructure::exportTreeData(void* buffer, PxU32 bufferSize)	const
+{
+	if(!isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PrunerStructure::exportTreeData: Pruning structure is invalid!");
+		return false;
+	}
+
+	if(!buffer || (size_t(buffer) & (PS_TREE_DATA_ALIGN - 1)) || bufferSize < getTreeDataSize())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PrunerStructure::exportTreeData: Buffer is too small or not 16-byte aligned!");
+		return false;
+	}
+
+	PxU8* base = reinterpret_cast<PxU8*>(buffer);
+	PxMemZero(base, getTreeDataSize());
+
+	TreeDataHeader* header = reinterpret_cast<TreeDataHeader*>(base);
+	header->mMagic = PS_TREE_DATA_MAGIC;
+	header->mVersion = PS_TREE_DATA_VERSION;
+
+	PxU32 offset = alignTreeDataOffset(sizeof(TreeDataHeader));
+	for(PxU32 i = 0; i < 2; i++)
+	{
+		if(!mData[i].mAABBTreeNodes)
+			continue;
+
+		header->mNbNodes[i] = mData[i].mNbNodes;
+		header->mNbObjects[i] = mData[i].mNbObjects;
+
+		header->mNodesOffset[i] = offset;
+		PxMemCopy(base + offset, mData[i].mAABBTreeNodes, mData[i].mNbNodes * sizeof(BVHNode));
+		offset = alignTreeDataOffset(offset + mData[i].mNbNodes * sizeof(BVHNode));
+
+		header->mIndicesOffset[i] = offset;
+		PxMemCopy(base + offset, mData[i].mAABBTreeIndices, mData[i].mNbObjects * sizeof(PxU32));
+		offset = alignTreeDataOffset(offset + mData[i].mNbObjects * sizeof(PxU32));
+	}
+	return true;
+}
+
 PxU32 PruningStructure::getRigidActors(PxRigidActor** userBuffer, PxU32 bufferSize, PxU32 startIndex/* =0 */) const
 {	
 	if(!isValid())
@@ -385,11 +545,7 @@ void PruningStructure::invalidate(PxActor* actor)
 		if(mActors[i] == actor)
 		{
 			// set pruning structure to NULL and remove the actor from the list
-			PxType type = mActors[i]->getConcreteType();
-			if (type == PxConcreteType::eRIGID_STATIC)
-				static_cast<NpRigidStatic*>(mActors[i])->getShapeManager().setPruningStructure(NULL);
-			else if (type == PxConcreteType::eRIGID_DYNAMIC)
-				static_cast<NpRigidDynamic*>(mActors[i])->getShapeManager().setPruningStructure(NULL);
+			setPruningStructure(mActors[i], NULL);
 
 			mActors[i] = mActors[mNbActors--];
 			break;
@@ -58,11 +58,14 @@ namespace physx
 			virtual			PxU32					getNbRigidActors()			const;
 			virtual			const void*				getStaticMergeData()		const;
 			virtual			const void*				getDynamicMergeData()		const;
+			virtual			PxU32					getTreeDataSize()			const;
+			virtual			bool					exportTreeData(void* buffer, PxU32 bufferSize)	const;
 			// ~PxPruningStructure
 													PruningStructure();
 			virtual									~PruningStructure();
 
 							bool					build(PxRigidActor*const* actors, PxU32 nbActors);			
+							bool					build(PxRigidActor*const* actors, PxU32 nbActors, const void* treeData, PxU32 treeDataSize);
 
 			PX_FORCE_INLINE	PxU32					getNbActors()				const	{ return mNbActors;	}
 			PX_FORCE_INLINE	PxActor*const*			getActors()					const	{ return mActors;	}
@@ -70,10 +73,13 @@ namespace physx
 			PX_FORCE_INLINE	bool					isValid()					const	{ return mValid;	}
 							void					invalidate(PxActor* actor);
 		private:
+							bool					registerActors(PxRigidActor*const* actors, PxU32 nbActors, PxU32* numShapes);
+
 							Gu::AABBPrunerMergeData	mData[2];
 							PxU32					mNbActors;	// Nb actors from which the pruner structure was build
 							PxActor**				mActors;	// actors used for pruner structure build, used later for serialization
 							bool					mValid;		// pruning structure validity
+							bool					mExternalTreeData;	// tree nodes and indices point to user-provided tree data, not owned
 		};
 	}
 
@@ -157,6 +157,91 @@ void NpRigidDynamic::setKinematicTarget(const PxTransform& destination)
 	setKinematicTargetInternal(destination.getNormalized());
 }
 
+void NpRigidDynamic::setKinematicTargets(PxRigidDynamic*const* actors, const PxVec3* positions, const PxQuat* orientations, PxU32 nbActors)
+{
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(i+4<nbActors)
+			PxPrefetchLine(actors[i+4]);
+
+		NpRigidDynamic* npActor = static_cast<NpRigidDynamic*>(actors[i]);
+		npActor->setKinematicTargetInternal(PxTransform(positions[i], orientations[i].getNormalized()));
+	}
+}
+
+void NpRigidDynamic::setKinematicTargets(PxRigidDynamic*const* actors, const PxTransform* targets, PxU32 nbActors)
+{
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(i+4<nbActors)
+			PxPrefetchLine(actors[i+4]);
+
+		NpRigidDynamic* npActor = static_cast<NpRigidDynamic*>(actors[i]);
+		npActor->setKinematicTargetInternal(targets[i].getNormalized());
+	}
+}
+
+void NpRigidDynamic::addForces(PxRigidDynamic*const* actors, const PxVec3* forces, const PxVec3* torques, PxU32 nbActors, PxForceMode::Enum mode, bool autowake)
+{
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(i+4<nbActors)
+			PxPrefetchLine(actors[i+4]);
+
+		NpRigidDynamic* npActor = static_cast<NpRigidDynamic*>(actors[i]);
+		const PxVec3* force = forces ? forces + i : NULL;
+		const PxVec3* torque = torques ? torques + i : NULL;
+		npActor->addSpatialForce(force, torque, mode);
+
+		const bool forceWakeUp = (force && !force->isZero()) || (torque && !torque->isZero());
+		npActor->wakeUpInternalNoKinematicTest(forceWakeUp, autowake);
+	}
+}
+
+PX_FORCE_INLINE void NpRigidDynamic::setVelocitiesInternal(NpScene& scene, const PxVec3* linearVelocity, const PxVec3* angularVelocity, bool autowake)
+{
+	const bool trackAccelerations = scene.getFlagsFast() & PxSceneFlag::eENABLE_BODY_ACCELERATIONS;
+	if(trackAccelerations)
+	{
+		const PxU32 index = getRigidActorArrayIndex();
+		if(index>=scene.mRigidDynamicsAccelerations.size())
+			scene.mRigidDynamicsAccelerations.resize(index+1);
+	}
+
+	bool forceWakeUp = false;
+	if(linearVelocity)
+	{
+		scSetLinearVelocity(*linearVelocity);
+		if(trackAccelerations)
+			scene.mRigidDynamicsAccelerations[getRigidActorArrayIndex()].mPrevLinVel = *linearVelocity;
+		OMNI_PVD_SET(OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, linearVelocity, *static_cast<PxRigidBody*>(this), *linearVelocity);
+		forceWakeUp = !linearVelocity->isZero();
+	}
+
+	if(angularVelocity)
+	{
+		scSetAngularVelocity(*angularVelocity);
+		if(trackAccelerations)
+			scene.mRigidDynamicsAccelerations[getRigidActorArrayIndex()].mPrevAngVel = *angularVelocity;
+		OMNI_PVD_SET(OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, angularVelocity, *static_cast<PxRigidBody*>(this), *angularVelocity);
+		forceWakeUp = forceWakeUp || !angularVelocity->isZero();
+	}
+
+	wakeUpInternalNoKinematicTest(forceWakeUp, autowake);
+}
+
+void NpRigidDynamic::setVelocities(PxRigidDynamic*const* actors, const PxVec3* linearVelocities, const PxVec3* angularVelocities, PxU32 nbActors, bool autowake)
+{
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(i+4<nbActors)
+			PxPrefetchLine(actors[i+4]);
+
+		NpRigidDynamic* npActor = static_cast<NpRigidDynamic*>(actors[i]);
+		npActor->setVelocitiesInternal(*npActor->getNpScene(), linearVelocities ? linearVelocities + i : NULL, angularVelocities ? angularVelocities + i : NULL, autowake);
+	}
+}
+
 bool NpRigidDynamic::getKinematicTarget(PxTransform& target) const
 {
 	NP_READ_CHECK(getNpScene());
@@ -127,6 +127,14 @@ public:
 	PX_FORCE_INLINE void			wakeUpInternal();
 					void			wakeUpInternalNoKinematicTest(bool forceWakeUp, bool autowake);
 
+	// PT: batched version of setKinematicTarget(), without the API checks (done by the caller)
+	static			void			setKinematicTargets(PxRigidDynamic*const* actors, const PxVec3* positions, const PxQuat* orientations, PxU32 nbActors);
+	static			void			setKinematicTargets(PxRigidDynamic*const* actors, const PxTransform* targets, PxU32 nbActors);
+
+	// PT: batched versions of addForce()/addTorque() and setLinearVelocity()/setAngularVelocity(), without the API checks (done by the caller)
+	static			void			addForces(PxRigidDynamic*const* actors, const PxVec3* forces, const PxVec3* torques, PxU32 nbActors, PxForceMode::Enum mode, bool autowake);
+	static			void			setVelocities(PxRigidDynamic*const* actors, const PxVec3* linearVelocities, const PxVec3* angularVelocities, PxU32 nbActors, bool autowake);
+
 	static PX_FORCE_INLINE size_t	getCoreOffset()				{ return PX_OFFSET_OF_RT(NpRigidDynamic, mCore);			}
 	static PX_FORCE_INLINE size_t	getNpShapeManagerOffset()	{ return PX_OFFSET_OF_RT(NpRigidDynamic, mShapeManager);	}
 
@@ -136,6 +144,7 @@ public:
 
 private:
 	PX_FORCE_INLINE	void			setKinematicTargetInternal(const PxTransform& destination);
+	PX_FORCE_INLINE	void			setVelocitiesInternal(NpScene& scene, const PxVec3* linearVelocity, const PxVec3* angularVelocity, bool autowake);
 
 #if PX_ENABLE_DEBUG_VISUALIZATION
 public:
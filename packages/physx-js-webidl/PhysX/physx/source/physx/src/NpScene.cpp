@@ -55,6 +55,7 @@
 #include "BpBroadPhase.h"
 #include "BpAABBManagerBase.h"
 #include "omnipvd/NpOmniPvdSetData.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 
@@ -149,7 +150,8 @@ NpScene::NpScene(const PxSceneDesc& desc, NpPhysics& physics) :
 	mAggregates					("sceneAggregates"),
 	mSanityBounds				(desc.sanityBounds),
 	mNbClients					(1),			//we always have the default client.
-	mSceneCompletion			(getContextId(), mPhysicsDone),
+	mNbCompletedSteps			(0),
+	mSceneCompletion			(getContextId(), mPhysicsDone, &mNbCompletedSteps),
 	mCollisionCompletion		(getContextId(), mCollisionDone),
 	mSceneQueriesCompletion		(getContextId(), mSceneQueriesDone),
 	mSceneExecution				(getContextId(), 0, "NpScene.execution"),
@@ -187,6 +189,7 @@ NpScene::NpScene(const PxSceneDesc& desc, NpPhysics& physics) :
 
 	mPrunerType[0] = desc.staticStructure;
 	mPrunerType[1] = desc.dynamicStructure;
+	mQueryRecorder = NULL;
 
 	mSceneExecution.setObject(this);
 	mSceneCollide.setObject(this);
@@ -349,6 +352,45 @@ PxVec3 NpScene::getGravity() const
 
 ///////////////////////////////////////////////////////////////////////////////
 
+PxU32 NpScene::addFieldEffector(const PxFieldEffector& effector)
+{
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN_VAL(effector.isValid(), "PxScene::addFieldEffector(): invalid effector!", 0xffffffff);
+
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN_AND_RETURN_VAL(this, "PxScene::addFieldEffector() not allowed while simulation is running. Call will be ignored.", 0xffffffff)
+
+	return mScene.addFieldEffector(effector);
+}
+
+void NpScene::setFieldEffector(PxU32 id, const PxFieldEffector& effector)
+{
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN(mScene.isFieldEffectorValid(id), "PxScene::setFieldEffector(): invalid id!");
+	PX_CHECK_AND_RETURN(effector.isValid(), "PxScene::setFieldEffector(): invalid effector!");
+
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN(this, "PxScene::setFieldEffector() not allowed while simulation is running. Call will be ignored.")
+
+	mScene.setFieldEffector(id, effector);
+}
+
+void NpScene::removeFieldEffector(PxU32 id)
+{
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN(mScene.isFieldEffectorValid(id), "PxScene::removeFieldEffector(): invalid id!");
+
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN(this, "PxScene::removeFieldEffector() not allowed while simulation is running. Call will be ignored.")
+
+	mScene.removeFieldEffector(id);
+}
+
+PxU32 NpScene::getNbFieldEffectors() const
+{
+	NP_READ_CHECK(this);
+	return mScene.getNbFieldEffectors();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void NpScene::setBounceThresholdVelocity(const PxReal t)
 {
 	NP_WRITE_CHECK(this);
@@ -599,6 +641,40 @@ bool NpScene::addActorsInternal(PxActor*const* PX_RESTRICT actors, PxU32 nbActor
 	Sc::Scene& scScene = mScene;
 	PxU32 actorsDone;
 
+	// PT: pre-pass to size all per-actor & per-shape arrays once for the whole batch. Invalid actors are
+	// counted as well, which only over-allocates in the failure case.
+	{
+		PxU32 nbStatics = 0;
+		PxU32 nbDynamics = 0;
+		PxU32 nbShapes = 0;
+		for(PxU32 i=0; i<nbActors; i++)
+		{
+			const PxType type = actors[i]->getConcreteType();
+			if(type == PxConcreteType::eRIGID_STATIC)
+			{
+				const NpRigidStatic& a = *static_cast<const NpRigidStatic*>(actors[i]);
+				if(!(a.getCore().getActorFlags().isSet(PxActorFlag::eDISABLE_SIMULATION)))
+				{
+					nbStatics++;
+					nbShapes += a.NpRigidStatic::getNbShapes();
+				}
+			}
+			else if(type == PxConcreteType::eRIGID_DYNAMIC)
+			{
+				const NpRigidDynamic& a = *static_cast<const NpRigidDynamic*>(actors[i]);
+				if(!(a.getCore().getActorFlags().isSet(PxActorFlag::eDISABLE_SIMULATION)))
+				{
+					nbDynamics++;
+					nbShapes += a.NpRigidDynamic::getNbShapes();
+				}
+			}
+		}
+
+		mRigidStatics.reserve(mRigidStatics.size() + nbStatics);
+		mRigidDynamics.reserve(mRigidDynamics.size() + nbDynamics);
+		scScene.preAllocateBatchInsertion(mRigidStatics.size() + nbStatics, mRigidDynamics.size() + nbDynamics, nbShapes);
+	}
+
 	Sc::BatchInsertionState scState;
 	scScene.startBatchInsertion(scState);
 
@@ -716,6 +792,7 @@ void NpScene::removeFromRigidDynamicList(NpRigidDynamic& rigidDynamic)
 	{
 		getSceneOvdClientInternal().removeRigidDynamicReset(&rigidDynamic);
 	}
+	getSceneOvdClientInternal().removeSkippedActiveActor(&rigidDynamic);
 #endif
 }
 
@@ -1394,6 +1471,9 @@ void NpScene::removeArticulationInternal(PxArticulationReducedCoordinate& pxa, b
 	{
 		getSceneOvdClientInternal().removeArticulationReset(&pxa);
 	}
+	NpArticulationLink*const* ovdLinks = npArticulation.getLinks();
+	for (PxU32 i = 0; i < nbLinks; i++)
+		getSceneOvdClientInternal().removeSkippedActiveActor(ovdLinks[i]);
 #endif
 
 
@@ -2209,6 +2289,59 @@ PxActor** NpScene::getActiveActors(PxU32& nbActorsOut)
 	}
 }
 
+void NpScene::getRigidBodyStreams(PxRigidBodyStreams& streams) const
+{
+	NP_READ_CHECK(this);
+
+	if(!isAPIWriteForbidden())
+		mScene.getBodyStreams(streams);
+	else
+	{
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::getRigidBodyStreams() not allowed while simulation is running. Call will be ignored.");
+		PxMemZero(&streams, sizeof(PxRigidBodyStreams));
+	}
+}
+
+// PT: PxShapeTransform is a public mirror of the internal PxsCachedTransform
+PX_COMPILE_TIME_ASSERT(sizeof(PxShapeTransform) == sizeof(PxsCachedTransform));
+PX_COMPILE_TIME_ASSERT(PX_OFFSET_OF(PxShapeTransform, transform) == PX_OFFSET_OF(PxsCachedTransform, transform));
+PX_COMPILE_TIME_ASSERT(PX_OFFSET_OF(PxShapeTransform, flags) == PX_OFFSET_OF(PxsCachedTransform, flags));
+
+const PxShapeTransform* NpScene::getShapeTransforms(PxU32& nbTransforms) const
+{
+	NP_READ_CHECK(this);
+
+	if(isAPIWriteForbidden())
+	{
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::getShapeTransforms() not allowed while simulation is running. Call will be ignored.");
+		nbTransforms = 0;
+		return NULL;
+	}
+
+	const PxsTransformCache& cache = mScene.getLowLevelContext()->getTransformCache();
+	nbTransforms = cache.getTotalSize();
+	return nbTransforms ? reinterpret_cast<const PxShapeTransform*>(cache.getTransforms()) : NULL;
+}
+
+PxU32 NpScene::getShapeTransformIndex(const PxRigidActor& actor, const PxShape& shape) const
+{
+	NP_READ_CHECK(this);
+
+	if(NpActor::getNpSceneFromActor(actor) != this)
+		return 0xffffffff;
+
+	// PT: make sure the shape is attached, the Sc-level search reports an error otherwise
+	const NpShapeManager* shapeManager = NpActor::getShapeManager_(actor);
+	const PxU32 nbShapes = shapeManager->getNbShapes();
+	NpShape*const* shapes = shapeManager->getShapes();
+	for(PxU32 i=0;i<nbShapes;i++)
+	{
+		if(shapes[i] == &shape)
+			return NpActor::getFromPxActor(actor).getScRigidCore().getShapeTransformCacheID(shapes[i]->getCore());
+	}
+	return 0xffffffff;
+}
+
 PxActor** NpScene::getFrozenActors(PxU32& nbActorsOut)
 {
 	NP_READ_CHECK(this);
@@ -2311,6 +2444,56 @@ void NpScene::getSimulationStatistics(PxSimulationStatistics& s) const
 	}
 }
 
+void NpScene::getSimulationStageTimings(PxSimulationStageTimings& timings) const
+{
+	NP_READ_CHECK(this);
+
+	if (getSimulationStage() == Sc::SimulationStage::eCOMPLETE)
+		mScene.getStageTimings(timings);
+	else
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::getSimulationStageTimings() not allowed while simulation is running. Call will be ignored.");
+}
+
+void NpScene::setNarrowPhaseAttribution(bool enabled)
+{
+	NP_WRITE_CHECK(this);
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN(this, "PxScene::setNarrowPhaseAttribution() not allowed while simulation is running. Call will be ignored.")
+
+	mScene.setNarrowPhaseAttribution(enabled);
+}
+
+bool NpScene::getNarrowPhaseAttribution() const
+{
+	NP_READ_CHECK(this);
+	return mScene.getNarrowPhaseAttribution();
+}
+
+PxU32 NpScene::getNarrowPhasePairCosts(PxNarrowPhasePairCost* userBuffer, PxU32 bufferSize) const
+{
+	NP_READ_CHECK(this);
+	PX_CHECK_AND_RETURN_NULL(userBuffer || !bufferSize, "PxScene::getNarrowPhasePairCosts(): userBuffer is NULL.");
+
+	if(getSimulationStage() != Sc::SimulationStage::eCOMPLETE)
+	{
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::getNarrowPhasePairCosts() not allowed while simulation is running. Call will be ignored.");
+		return 0;
+	}
+	return mScene.getNarrowPhasePairCosts(userBuffer, bufferSize);
+}
+
+PxU32 NpScene::getNarrowPhaseActorCosts(PxNarrowPhaseActorCost* userBuffer, PxU32 bufferSize) const
+{
+	NP_READ_CHECK(this);
+	PX_CHECK_AND_RETURN_NULL(userBuffer || !bufferSize, "PxScene::getNarrowPhaseActorCosts(): userBuffer is NULL.");
+
+	if(getSimulationStage() != Sc::SimulationStage::eCOMPLETE)
+	{
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::getNarrowPhaseActorCosts() not allowed while simulation is running. Call will be ignored.");
+		return 0;
+	}
+	return mScene.getNarrowPhaseActorCosts(userBuffer, bufferSize);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 PxClientID NpScene::createClient()
@@ -2354,6 +2537,18 @@ void NpScene::setSimulationEventCallback(PxSimulationEventCallback* callback)
 	OMNI_PVD_SET(OMNI_PVD_CONTEXT_HANDLE, PxScene, hasSimulationEventCallback, static_cast<PxScene&>(*this), callback ? true : false)
 }
 
+void NpScene::setQueryRecorder(PxQueryRecorder* recorder)
+{
+	NP_WRITE_CHECK(this);
+	mQueryRecorder = recorder;
+}
+
+PxQueryRecorder* NpScene::getQueryRecorder() const
+{
+	NP_READ_CHECK(this);
+	return mQueryRecorder;
+}
+
 PxSimulationEventCallback* NpScene::getSimulationEventCallback() const
 {
 	NP_READ_CHECK(this);
@@ -2524,6 +2719,43 @@ bool NpScene::removeBroadPhaseRegion(PxU32 handle)
 	return bp->removeRegion(handle);
 }
 
+void NpScene::setBroadPhasePairRecording(bool enable, const PxFilterData& groupMask)
+{
+	NP_WRITE_CHECK(this);
+
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN(this, "PxScene::setBroadPhasePairRecording() not allowed while simulation is running. Call will be ignored.")
+
+	mScene.getBroadphaseManager().setPairRecording(enable, groupMask);
+}
+
+bool NpScene::getBroadPhasePairRecording() const
+{
+	NP_READ_CHECK(this);
+	return mScene.getBroadphaseManager().isRecordingPairs();
+}
+
+const PxBroadPhaseShapePair* NpScene::getBroadPhaseCreatedPairs(PxU32& nbPairs) const
+{
+	NP_READ_CHECK(this);
+	nbPairs = 0;
+	PX_CHECK_SCENE_API_READ_FORBIDDEN_AND_RETURN_VAL(this, "PxScene::getBroadPhaseCreatedPairs() not allowed while simulation is running. Call will be ignored.", NULL)
+
+	const PxArray<PxBroadPhaseShapePair>& pairs = mScene.getBroadphaseManager().getRecordedCreatedPairs();
+	nbPairs = pairs.size();
+	return nbPairs ? pairs.begin() : NULL;
+}
+
+const PxBroadPhaseShapePair* NpScene::getBroadPhaseDeletedPairs(PxU32& nbPairs) const
+{
+	NP_READ_CHECK(this);
+	nbPairs = 0;
+	PX_CHECK_SCENE_API_READ_FORBIDDEN_AND_RETURN_VAL(this, "PxScene::getBroadPhaseDeletedPairs() not allowed while simulation is running. Call will be ignored.", NULL)
+
+	const PxArray<PxBroadPhaseShapePair>& pairs = mScene.getBroadphaseManager().getRecordedDeletedPairs();
+	nbPairs = pairs.size();
+	return nbPairs ? pairs.begin() : NULL;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 // Filtering
@@ -2868,6 +3100,8 @@ bool NpScene::simulateOrCollide(PxReal elapsedTime, PxBaseTask* completionTask,
 				// when an NpScene is controlled by an APEX scene.
 				mTaskManager->resetDependencies();
 			}
+			// PT: hint the dispatcher so that parked workers can wake up before the first tasks are submitted
+			mTaskManager->getCpuDispatcher()->simulationStarting();
 			mTaskManager->startSimulation();
 		}
 
@@ -3058,6 +3292,245 @@ void NpScene::flushSimulation(bool sendPendingReports)
 	//!!! TODO: Shrink all NpObject lists?
 }
 
+PxU32 NpScene::compactMemory()
+{
+	PX_PROFILE_ZONE("API.compactMemory", getContextId());
+	NP_WRITE_CHECK_NOREENTRY(this);
+
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN_AND_RETURN_VAL(this, "PxScene::compactMemory(): This call is not allowed while the simulation is running. Call will be ignored", 0)
+
+	const PxU32 nbReleased = mScene.compactMemory();
+	getSQAPI().flushMemory();
+	return nbReleased;
+}
+
+#if PX_CHECKED
+static bool checkKinematicTarget(const NpScene* scene, const PxRigidDynamic* actor, const PxTransform& target)
+{
+	const NpRigidDynamic* npActor = static_cast<const NpRigidDynamic*>(actor);
+	PX_CHECK_AND_RETURN_VAL(npActor && npActor->getNpScene() == scene, "PxScene::setKinematicTargets: Actor must be in this scene!", false);
+	PX_CHECK_AND_RETURN_VAL(npActor->getCore().getFlags() & PxRigidBodyFlag::eKINEMATIC, "PxScene::setKinematicTargets: Actor must be kinematic!", false);
+	PX_CHECK_AND_RETURN_VAL(!(npActor->getCore().getActorFlags().isSet(PxActorFlag::eDISABLE_SIMULATION)), "PxScene::setKinematicTargets: Not allowed if PxActorFlag::eDISABLE_SIMULATION is set!", false);
+	PX_CHECK_AND_RETURN_VAL(target.isSane(), "PxScene::setKinematicTargets: target is not valid.", false);
+	scene->checkPositionSanity(*npActor, target, "PxScene::setKinematicTargets");
+	return true;
+}
+#endif
+
+void NpScene::setKinematicTargets(PxRigidDynamic*const* actors, const PxVec3* positions, const PxQuat* orientations, PxU32 nbActors)
+{
+	PX_PROFILE_ZONE("API.setKinematicTargets", getContextId());
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN(!nbActors || (actors && positions && orientations), "PxScene::setKinematicTargets: NULL buffer!");
+
+#if PX_CHECKED
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(!checkKinematicTarget(this, actors[i], PxTransform(positions[i], orientations[i])))
+			return;
+	}
+#endif
+
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN_EXCEPT_SPLIT_SIM(this, "PxScene::setKinematicTargets() not allowed while simulation is running. Call will be ignored.")
+
+	NpRigidDynamic::setKinematicTargets(actors, positions, orientations, nbActors);
+}
+
+void NpScene::setKinematicTargets(PxRigidDynamic*const* actors, const PxTransform* targets, PxU32 nbActors)
+{
+	PX_PROFILE_ZONE("API.setKinematicTargets", getContextId());
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN(!nbActors || (actors && targets), "PxScene::setKinematicTargets: NULL buffer!");
+
+#if PX_CHECKED
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(!checkKinematicTarget(this, actors[i], targets[i]))
+			return;
+	}
+#endif
+
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN_EXCEPT_SPLIT_SIM(this, "PxScene::setKinematicTargets() not allowed while simulation is running. Call will be ignored.")
+
+	NpRigidDynamic::setKinematicTargets(actors, targets, nbActors);
+}
+
+#if PX_CHECKED
+static bool checkDynamicBatchEntry(const NpScene* scene, const PxRigidDynamic* actor, const PxVec3* linear, const PxVec3* angular, const char* linearError, const char* angularError)
+{
+	const NpRigidDynamic* npActor = static_cast<const NpRigidDynamic*>(actor);
+	PX_CHECK_AND_RETURN_VAL(npActor && npActor->getNpScene() == scene, "PxScene::addForces/setVelocities: Actor must be in this scene!", false);
+	PX_CHECK_AND_RETURN_VAL(!(npActor->getCore().getFlags() & PxRigidBodyFlag::eKINEMATIC), "PxScene::addForces/setVelocities: Actor must be non-kinematic!", false);
+	PX_CHECK_AND_RETURN_VAL(!(npActor->getCore().getActorFlags().isSet(PxActorFlag::eDISABLE_SIMULATION)), "PxScene::addForces/setVelocities: Not allowed if PxActorFlag::eDISABLE_SIMULATION is set!", false);
+	PX_CHECK_AND_RETURN_VAL(!linear || linear->isFinite(), linearError, false);
+	PX_CHECK_AND_RETURN_VAL(!angular || angular->isFinite(), angularError, false);
+	return true;
+}
+#endif
+
+void NpScene::addForces(PxRigidDynamic*const* actors, const PxVec3* forces, const PxVec3* torques, PxU32 nbActors, PxForceMode::Enum mode, bool autowake)
+{
+	PX_PROFILE_ZONE("API.addForces", getContextId());
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN(!nbActors || actors, "PxScene::addForces: NULL buffer!");
+
+#if PX_CHECKED
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(!checkDynamicBatchEntry(this, actors[i], forces ? forces + i : NULL, torques ? torques + i : NULL, "PxScene::addForces: force is not valid.", "PxScene::addForces: torque is not valid."))
+			return;
+	}
+#endif
+
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN_EXCEPT_SPLIT_SIM(this, "PxScene::addForces() not allowed while simulation is running. Call will be ignored.")
+
+	if((getFlags() & PxSceneFlag::eENABLE_DIRECT_GPU_API) && isDirectGPUAPIInitialized())
+	{
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::addForces(): it is illegal to call this method if PxSceneFlag::eENABLE_DIRECT_GPU_API is enabled!");
+		return;
+	}
+
+	if(!forces && !torques)
+		return;
+
+	NpRigidDynamic::addForces(actors, forces, torques, nbActors, mode, autowake);
+}
+
+void NpScene::setVelocities(PxRigidDynamic*const* actors, const PxVec3* linearVelocities, const PxVec3* angularVelocities, PxU32 nbActors, bool autowake)
+{
+	PX_PROFILE_ZONE("API.setVelocities", getContextId());
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN(!nbActors || actors, "PxScene::setVelocities: NULL buffer!");
+
+#if PX_CHECKED
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		if(!checkDynamicBatchEntry(this, actors[i], linearVelocities ? linearVelocities + i : NULL, angularVelocities ? angularVelocities + i : NULL, "PxScene::setVelocities: linear velocity is not valid.", "PxScene::setVelocities: angular velocity is not valid."))
+			return;
+	}
+#endif
+
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN_EXCEPT_SPLIT_SIM(this, "PxScene::setVelocities() not allowed while simulation is running. Call will be ignored.")
+
+	if((getFlags() & PxSceneFlag::eENABLE_DIRECT_GPU_API) && isDirectGPUAPIInitialized())
+	{
+		outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "PxScene::setVelocities(): it is illegal to call this method if PxSceneFlag::eENABLE_DIRECT_GPU_API is enabled!");
+		return;
+	}
+
+	if(!linearVelocities && !angularVelocities)
+		return;
+
+	NpRigidDynamic::setVelocities(actors, linearVelocities, angularVelocities, nbActors, autowake);
+}
+
+PxU32 NpScene::getArticulationLinkPoses(const PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations, PxTransform* poses, PxU32 maxNbPoses) const
+{
+	PX_PROFILE_ZONE("API.getArticulationLinkPoses", getContextId());
+	NP_READ_CHECK(this);
+	PX_CHECK_AND_RETURN_VAL(!nbArticulations || (articulations && poses), "PxScene::getArticulationLinkPoses: NULL buffer!", 0);
+	PX_CHECK_SCENE_API_READ_FORBIDDEN_EXCEPT_COLLIDE_AND_RETURN_VAL(this, "PxScene::getArticulationLinkPoses() not allowed while simulation is running (except during PxScene::collide()).", 0);
+
+	PxU32 nbPoses = 0;
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		const NpArticulationReducedCoordinate* npArticulation = static_cast<const NpArticulationReducedCoordinate*>(articulations[i]);
+		PX_CHECK_AND_RETURN_VAL(npArticulation->getNpScene()==this, "PxScene::getArticulationLinkPoses: articulation does not belong to this scene!", nbPoses);
+
+		const PxU32 nbLinks = npArticulation->getNbLinks();
+		if(nbPoses + nbLinks > maxNbPoses)
+			break;
+
+		const NpArticulationLink* const* links = npArticulation->getLinks();
+		for(PxU32 j=0;j<nbLinks;j++)
+		{
+			const Sc::BodyCore& core = links[j]->getCore();
+			// PT:: tag: scalar transform*transform
+			poses[nbPoses++] = core.getBody2World() * core.getBody2Actor().getInverse();
+		}
+	}
+	return nbPoses;
+}
+
+// PT: PxTransform is 7 floats (quaternion then position), which is the layout used in the flat articulation state buffers.
+PX_COMPILE_TIME_ASSERT(sizeof(PxTransform)==sizeof(PxReal)*7);
+
+PxU32 NpScene::copyArticulationStates(const PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations, PxReal* buffer, PxU32 bufferSize) const
+{
+	PX_PROFILE_ZONE("API.copyArticulationStates", getContextId());
+	NP_READ_CHECK(this);
+	PX_CHECK_AND_RETURN_VAL(!nbArticulations || (articulations && buffer), "PxScene::copyArticulationStates: NULL buffer!", 0);
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN_AND_RETURN_VAL(this, "PxScene::copyArticulationStates() not allowed while simulation is running. Call will be ignored.", 0);
+	PX_CHECK_AND_RETURN_VAL(!(getFlagsFast() & PxSceneFlag::eENABLE_DIRECT_GPU_API), "PxScene::copyArticulationStates: it is illegal to call this method if PxSceneFlag::eENABLE_DIRECT_GPU_API is enabled!", 0);
+
+	const bool isGpuSimEnabled = getFlagsFast() & PxSceneFlag::eENABLE_GPU_DYNAMICS;
+
+	PxU32 offset = 0;
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		const NpArticulationReducedCoordinate* npArticulation = static_cast<const NpArticulationReducedCoordinate*>(articulations[i]);
+		PX_CHECK_AND_RETURN_VAL(npArticulation->getNpScene()==this, "PxScene::copyArticulationStates: articulation does not belong to this scene!", offset);
+
+		const PxU32 nbLinks = npArticulation->getNbLinks();
+		const PxU32 nbDofs = npArticulation->getCore().getDofs();
+		if(!nbLinks || nbDofs==0xFFFFFFFF || offset + 7*(1 + nbLinks) + nbDofs > bufferSize)
+			break;
+
+		PxTransform* poses = reinterpret_cast<PxTransform*>(buffer + offset);
+		const NpArticulationLink* const* links = npArticulation->getLinks();
+		for(PxU32 j=0;j<nbLinks;j++)
+		{
+			const Sc::BodyCore& core = links[j]->getCore();
+			// PT:: tag: scalar transform*transform
+			poses[j+1] = core.getBody2World() * core.getBody2Actor().getInverse();
+		}
+		poses[0] = poses[1];	// PT: root pose
+		offset += 7*(1 + nbLinks);
+
+		// PT: we don't need the full cache here, only a view of the buffer for the joint positions
+		PxArticulationCache cache;
+		cache.jointPosition = buffer + offset;
+		npArticulation->getCore().copyInternalStateToCache(cache, PxArticulationCacheFlag::ePOSITION, isGpuSimEnabled);
+		offset += nbDofs;
+	}
+	return offset;
+}
+
+PxU32 NpScene::applyArticulationStates(PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations, const PxReal* buffer, PxU32 bufferSize, bool autowake)
+{
+	PX_PROFILE_ZONE("API.applyArticulationStates", getContextId());
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN_VAL(!nbArticulations || (articulations && buffer), "PxScene::applyArticulationStates: NULL buffer!", 0);
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN_AND_RETURN_VAL(this, "PxScene::applyArticulationStates() not allowed while simulation is running. Call will be ignored.", 0);
+	PX_CHECK_AND_RETURN_VAL(!(getFlagsFast() & PxSceneFlag::eENABLE_DIRECT_GPU_API), "PxScene::applyArticulationStates: it is illegal to call this method if PxSceneFlag::eENABLE_DIRECT_GPU_API is enabled!", 0);
+
+	PxU32 offset = 0;
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		NpArticulationReducedCoordinate* npArticulation = static_cast<NpArticulationReducedCoordinate*>(articulations[i]);
+		PX_CHECK_AND_RETURN_VAL(npArticulation->getNpScene()==this, "PxScene::applyArticulationStates: articulation does not belong to this scene!", offset);
+
+		const PxU32 nbLinks = npArticulation->getNbLinks();
+		const PxU32 nbDofs = npArticulation->getCore().getDofs();
+		if(!nbLinks || nbDofs==0xFFFFFFFF || offset + 7*(1 + nbLinks) + nbDofs > bufferSize)
+			break;
+
+		// PT: the link poses are skipped, they are recomputed from the root pose and the joint positions
+		PxArticulationRootLinkData rootLinkData;
+		rootLinkData.transform = *reinterpret_cast<const PxTransform*>(buffer + offset);
+		offset += 7*(1 + nbLinks);
+
+		// PT: we don't need the full cache here, only a view of the buffer. The cache data is not modified.
+		PxArticulationCache cache;
+		cache.jointPosition = const_cast<PxReal*>(buffer + offset);
+		cache.rootLinkData = &rootLinkData;
+		cache.version = npArticulation->getCacheVersion();
+		npArticulation->applyCache(cache, PxArticulationCacheFlag::eROOT_TRANSFORM | PxArticulationCacheFlag::ePOSITION, autowake);
+		offset += nbDofs;
+	}
+	return offset;
+}
+
 /*
 Replaces finishRun() with the addition of appropriate thread sync(pulled out of PhysicsThread())
 
@@ -3628,6 +4101,87 @@ static void shiftRigidActors(PxArray<T*>& rigidActorList, const PxVec3& shift)
 	}
 }
 
+// PT: number of actors per parallelFor chunk in shiftOrigin(). Smaller scenes are shifted serially.
+#define NP_SHIFT_ORIGIN_GRAIN	1024
+
+namespace
+{
+	// PT: shifts dynamics, statics and articulation links over a single index range. Each actor only touches its
+	// own core & sim data so disjoint ranges can run concurrently.
+	class ShiftActors : public Cm::ParallelForCallback
+	{
+		public:
+			ShiftActors(NpRigidDynamic*const* dynamics, PxU32 nbDynamics, NpRigidStatic*const* statics, PxU32 nbStatics,
+						PxArticulationReducedCoordinate*const* articulations, const PxVec3& shift) :
+				mDynamics(dynamics), mStatics(statics), mArticulations(articulations),
+				mNbDynamics(nbDynamics), mNbStatics(nbStatics), mShift(shift)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				PX_SIMD_GUARD;
+				const PxU32 nbRigids = mNbDynamics + mNbStatics;
+				for(PxU32 i=startIndex; i<endIndex; i++)
+				{
+					if(i<mNbDynamics)
+						mDynamics[i]->getCore().onOriginShift(mShift);
+					else if(i<nbRigids)
+						mStatics[i - mNbDynamics]->getCore().onOriginShift(mShift);
+					else
+					{
+						NpArticulationReducedCoordinate* np = static_cast<NpArticulationReducedCoordinate*>(mArticulations[i - nbRigids]);
+						NpArticulationLink*const* links = np->getLinks();
+						const PxU32 nbLinks = np->getNbLinks();
+						for(PxU32 j=0; j<nbLinks; j++)
+							links[j]->getCore().onOriginShift(mShift);
+					}
+				}
+			}
+
+			NpRigidDynamic*const*					mDynamics;
+			NpRigidStatic*const*					mStatics;
+			PxArticulationReducedCoordinate*const*	mArticulations;
+			const PxU32								mNbDynamics;
+			const PxU32								mNbStatics;
+			const PxVec3							mShift;
+			PX_NOCOPY(ShiftActors)
+	};
+
+	// PT: the Sc scene (low-level context, bounds, broadphase, constraints), the scene query system and the render
+	// buffer don't share any data, so they are shifted as three independent jobs.
+	class ShiftSubsystems : public Cm::ParallelForCallback
+	{
+		public:
+			ShiftSubsystems(Sc::Scene& scene, PxSceneQuerySystem& sq, Cm::RenderBuffer& renderBuffer, const PxVec3& shift) :
+				mScene(scene), mSQ(sq), mRenderBuffer(renderBuffer), mShift(shift)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				PX_SIMD_GUARD;
+				for(PxU32 i=startIndex; i<endIndex; i++)
+				{
+					if(i==0)
+						mScene.shiftOrigin(mShift);
+					else if(i==1)
+						mSQ.shiftOrigin(mShift);
+					else
+					{
+#if PX_ENABLE_DEBUG_VISUALIZATION
+						mRenderBuffer.shift(-mShift);
+#else
+						PX_CATCH_UNDEFINED_ENABLE_DEBUG_VISUALIZATION
+#endif
+					}
+				}
+			}
+
+			Sc::Scene&			mScene;
+			PxSceneQuerySystem&	mSQ;
+			Cm::RenderBuffer&	mRenderBuffer;
+			const PxVec3		mShift;
+			PX_NOCOPY(ShiftSubsystems)
+	};
+}
+
 void NpScene::shiftOrigin(const PxVec3& shift)
 {
 	PX_PROFILE_ZONE("API.shiftOrigin", getContextId());
@@ -3643,6 +4197,22 @@ void NpScene::shiftOrigin(const PxVec3& shift)
 	
 	PX_SIMD_GUARD;
 
+	// PT: large worlds are shifted on the dispatcher's worker threads, first the actors in chunks, then the
+	// remaining subsystems concurrently. PVD is notified from the calling thread once everything has moved.
+	PxCpuDispatcher* dispatcher = mTaskManager ? mTaskManager->getCpuDispatcher() : NULL;
+	const PxU32 nbActors = mRigidDynamics.size() + mRigidStatics.size() + mArticulations.size();
+	if(nbActors > NP_SHIFT_ORIGIN_GRAIN && Cm::getParallelForThreadCount(dispatcher) > 1)
+	{
+		ShiftActors shiftActors(mRigidDynamics.begin(), mRigidDynamics.size(), mRigidStatics.begin(), mRigidStatics.size(), mArticulations.getEntries(), shift);
+		Cm::parallelFor(dispatcher, nbActors, NP_SHIFT_ORIGIN_GRAIN, shiftActors);
+
+		ShiftSubsystems shiftSubsystems(mScene, getSQAPI(), mRenderBuffer, shift);
+		Cm::parallelFor(dispatcher, 3, 1, shiftSubsystems);
+
+		PVD_ORIGIN_SHIFT(shift);
+		return;
+	}
+
 	shiftRigidActors(mRigidDynamics, shift);	// PT: TODO: we don't need to re-test the type all the time in shiftRigidActors...
 	shiftRigidActors(mRigidStatics, shift);
 
@@ -156,6 +156,11 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 	virtual			void							setGravity(const PxVec3&)	PX_OVERRIDE PX_FINAL;
 	virtual			PxVec3							getGravity() const			PX_OVERRIDE PX_FINAL;
 
+	virtual			PxU32							addFieldEffector(const PxFieldEffector& effector)			PX_OVERRIDE PX_FINAL;
+	virtual			void							setFieldEffector(PxU32 id, const PxFieldEffector& effector)	PX_OVERRIDE PX_FINAL;
+	virtual			void							removeFieldEffector(PxU32 id)								PX_OVERRIDE PX_FINAL;
+	virtual			PxU32							getNbFieldEffectors() const									PX_OVERRIDE PX_FINAL;
+
 	virtual			void							setBounceThresholdVelocity(const PxReal t)		PX_OVERRIDE PX_FINAL;
 	virtual			PxReal							getBounceThresholdVelocity() const				PX_OVERRIDE PX_FINAL;
 	virtual			void							setMaxBiasCoefficient(const PxReal t)			PX_OVERRIDE PX_FINAL;
@@ -208,9 +213,17 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 	virtual			PxU32							getNbActors(PxActorTypeFlags types) const	PX_OVERRIDE PX_FINAL;
 	virtual			PxU32							getActors(PxActorTypeFlags types, PxActor** buffer, PxU32 bufferSize, PxU32 startIndex=0) const	PX_OVERRIDE PX_FINAL;
 	virtual			PxActor**						getActiveActors(PxU32& nbActorsOut)	PX_OVERRIDE PX_FINAL;
+	virtual			void							getRigidBodyStreams(PxRigidBodyStreams& streams)	const	PX_OVERRIDE PX_FINAL;
+	virtual			const PxShapeTransform*			getShapeTransforms(PxU32& nbTransforms)	const	PX_OVERRIDE PX_FINAL;
+	virtual			PxU32							getShapeTransformIndex(const PxRigidActor& actor, const PxShape& shape)	const	PX_OVERRIDE PX_FINAL;
 
 	// Run
 	virtual			void							getSimulationStatistics(PxSimulationStatistics& s) const	PX_OVERRIDE PX_FINAL;
+	virtual			void							getSimulationStageTimings(PxSimulationStageTimings& timings) const	PX_OVERRIDE PX_FINAL;
+	virtual			void							setNarrowPhaseAttribution(bool enabled)								PX_OVERRIDE PX_FINAL;
+	virtual			bool							getNarrowPhaseAttribution() const									PX_OVERRIDE PX_FINAL;
+	virtual			PxU32							getNarrowPhasePairCosts(PxNarrowPhasePairCost* userBuffer, PxU32 bufferSize) const	PX_OVERRIDE PX_FINAL;
+	virtual			PxU32							getNarrowPhaseActorCosts(PxNarrowPhaseActorCost* userBuffer, PxU32 bufferSize) const	PX_OVERRIDE PX_FINAL;
 	virtual			PxSceneResidual					getSolverResidual() const PX_OVERRIDE PX_FINAL { return mScene.getSolverResidual(); }
 
 	// Multiclient 
@@ -228,6 +241,8 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 	virtual			PxCCDContactModifyCallback*		getCCDContactModifyCallback()	const								PX_OVERRIDE PX_FINAL;
 	virtual			void							setBroadPhaseCallback(PxBroadPhaseCallback* callback)				PX_OVERRIDE PX_FINAL;
 	virtual			PxBroadPhaseCallback*			getBroadPhaseCallback()		const									PX_OVERRIDE PX_FINAL;
+	virtual			void							setQueryRecorder(PxQueryRecorder* recorder)							PX_OVERRIDE PX_FINAL;
+	virtual			PxQueryRecorder*				getQueryRecorder()		const										PX_OVERRIDE PX_FINAL;
 
 	//CCD
 	virtual			void							setCCDMaxPasses(PxU32 ccdMaxPasses)	PX_OVERRIDE PX_FINAL;
@@ -256,6 +271,7 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 	virtual			bool							advance(physx::PxBaseTask* completionTask)	PX_OVERRIDE PX_FINAL;
 	virtual			bool							collide(PxReal elapsedTime, physx::PxBaseTask* completionTask, void* scratchBlock, PxU32 scratchBlockSize, bool controlSimulation = true)	PX_OVERRIDE PX_FINAL;
 	virtual			bool							checkResults(bool block)	PX_OVERRIDE PX_FINAL;
+	virtual			const volatile PxI32*			getSimulationCompletionCounter() const	PX_OVERRIDE PX_FINAL;
 	virtual			bool							fetchCollision(bool block)	PX_OVERRIDE PX_FINAL;
 	virtual			bool							fetchResults(bool block, PxU32* errorState)	PX_OVERRIDE PX_FINAL;
 	virtual			bool							fetchResultsStart(const PxContactPairHeader*& contactPairs, PxU32& nbContactPairs, bool block = false)	PX_OVERRIDE PX_FINAL;
@@ -263,6 +279,14 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 	virtual			void							fetchResultsFinish(PxU32* errorState = 0)	PX_OVERRIDE PX_FINAL;
 
 	virtual			void							flushSimulation(bool sendPendingReports)	PX_OVERRIDE PX_FINAL;
+	virtual			PxU32							compactMemory()	PX_OVERRIDE PX_FINAL;
+	virtual			void							setKinematicTargets(PxRigidDynamic*const* actors, const PxVec3* positions, const PxQuat* orientations, PxU32 nbActors)	PX_OVERRIDE PX_FINAL;
+	virtual			void							setKinematicTargets(PxRigidDynamic*const* actors, const PxTransform* targets, PxU32 nbActors)	PX_OVERRIDE PX_FINAL;
+	virtual			void							addForces(PxRigidDynamic*const* actors, const PxVec3* forces, const PxVec3* torques, PxU32 nbActors, PxForceMode::Enum mode, bool autowake)	PX_OVERRIDE PX_FINAL;
+	virtual			void							setVelocities(PxRigidDynamic*const* actors, const PxVec3* linearVelocities, const PxVec3* angularVelocities, PxU32 nbActors, bool autowake)	PX_OVERRIDE PX_FINAL;
+	virtual			PxU32							getArticulationLinkPoses(const PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations, PxTransform* poses, PxU32 maxNbPoses) const	PX_OVERRIDE PX_FINAL;
+	virtual			PxU32							copyArticulationStates(const PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations, PxReal* buffer, PxU32 bufferSize) const	PX_OVERRIDE PX_FINAL;
+	virtual			PxU32							applyArticulationStates(PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations, const PxReal* buffer, PxU32 bufferSize, bool autowake)	PX_OVERRIDE PX_FINAL;
 	virtual			const PxRenderBuffer&			getRenderBuffer()	PX_OVERRIDE PX_FINAL;
 
 	virtual			void							setSolverBatchSize(PxU32 solverBatchSize)	PX_OVERRIDE PX_FINAL;
@@ -296,6 +320,10 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 	virtual			PxU32							getBroadPhaseRegions(PxBroadPhaseRegionInfo* userBuffer, PxU32 bufferSize, PxU32 startIndex=0) const	PX_OVERRIDE PX_FINAL;
 	virtual			PxU32							addBroadPhaseRegion(const PxBroadPhaseRegion& region, bool populateRegion)	PX_OVERRIDE PX_FINAL;
 	virtual			bool							removeBroadPhaseRegion(PxU32 handle)	PX_OVERRIDE PX_FINAL;
+	virtual			void							setBroadPhasePairRecording(bool enable, const PxFilterData& groupMask)	PX_OVERRIDE PX_FINAL;
+	virtual			bool							getBroadPhasePairRecording()						const	PX_OVERRIDE PX_FINAL;
+	virtual			const PxBroadPhaseShapePair*	getBroadPhaseCreatedPairs(PxU32& nbPairs)			const	PX_OVERRIDE PX_FINAL;
+	virtual			const PxBroadPhaseShapePair*	getBroadPhaseDeletedPairs(PxU32& nbPairs)			const	PX_OVERRIDE PX_FINAL;
 
 	virtual			bool							addActors(PxActor*const* actors, PxU32 nbActors)	PX_OVERRIDE PX_FINAL;
 	virtual			bool							addActors(const PxPruningStructure& prunerStructure)	PX_OVERRIDE PX_FINAL;
@@ -360,6 +388,18 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 														PxOverlapCallback& hitCall, 
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags) const	PX_OVERRIDE PX_FINAL;
+
+	virtual			bool							cull(
+														PxU32 nbPlanes, const PxPlane* planes,	// Volume data
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const	PX_OVERRIDE PX_FINAL;
+
+	virtual			PxI32							overlapSpheres(
+														PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,	// Query spheres
+														PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const	PX_OVERRIDE PX_FINAL;
 	//~PxSceneQuerySystemBase
 
 	// PxSceneSQSystem
@@ -606,6 +646,7 @@ private:
 
 					NpSceneQueries					mNpSQ;
 					PxPruningStructureType::Enum	mPrunerType[2];
+					PxQueryRecorder*				mQueryRecorder;
 					typedef Cm::DelegateTask<NpScene, &NpScene::sceneQueriesStaticPrunerUpdate> SceneQueriesStaticPrunerUpdate;
 					typedef Cm::DelegateTask<NpScene, &NpScene::sceneQueriesDynamicPrunerUpdate> SceneQueriesDynamicPrunerUpdate;
 					SceneQueriesStaticPrunerUpdate	mSceneQueriesStaticPrunerUpdate;
@@ -654,9 +695,11 @@ private:
 
 					PxU32							mNbClients;		// Tracks reserved clients for multiclient support.
 
+					volatile PxI32					mNbCompletedSteps;	// Incremented by mSceneCompletion, see getSimulationCompletionCounter()
+
 					struct SceneCompletion : public Cm::Task
 					{
-						SceneCompletion(PxU64 contextId, PxSync& sync) : Cm::Task(contextId), mSync(sync){}
+						SceneCompletion(PxU64 contextId, PxSync& sync, volatile PxI32* counter = NULL) : Cm::Task(contextId), mSync(sync), mCounter(counter){}
 						virtual void runInternal() {}
 						//ML: As soon as mSync.set is called, and the scene is shutting down,
 						//the scene may be deleted. That means this running task may also be deleted.
@@ -667,6 +710,9 @@ private:
 							//We cache the continuation pointer because this class may be deleted 
 							//as soon as mSync.set() is called if the application releases the scene.
 							PxBaseTask* c = mCont; 
+							//the counter is bumped before mSync.set(), for the same reason.
+							if(mCounter)
+								signalCounter(mCounter);
 							//once mSync.set(), fetchResults() will be allowed to run.
 							mSync.set(); 
 							//Call the continuation task that we cached above. If we use mCont or 
@@ -679,7 +725,9 @@ private:
 
 						//	//This method just is called in the split sim approach as a way to set continuation after the task has been initialized
 						void setDependent(PxBaseTask* task){PX_ASSERT(mCont == NULL); mCont = task; if(task)task->addReference();}
+						static void signalCounter(volatile PxI32* counter);
 						PxSync& mSync;
+						volatile PxI32* mCounter;
 					private:
 						SceneCompletion& operator=(const SceneCompletion&);
 					};
@@ -46,6 +46,7 @@
 #include "CmCollection.h"
 #include "PxsSimulationController.h"
 #include "common/PxProfileZone.h"
+#include "foundation/PxAtomic.h"
 #include "BpBroadPhase.h"
 #include "BpAABBManagerBase.h"
 #include "omnipvd/NpOmniPvdSetData.h"
@@ -87,6 +88,20 @@ bool NpScene::checkResults(bool block)
 	return checkResultsInternal(block);
 }
 
+const volatile PxI32* NpScene::getSimulationCompletionCounter() const
+{
+	return &mNbCompletedSteps;
+}
+
+void NpScene::SceneCompletion::signalCounter(volatile PxI32* counter)
+{
+	PxAtomicIncrement(counter);
+#if PX_EMSCRIPTEN && defined(__EMSCRIPTEN_PTHREADS__)
+	// PT: wakes up Atomics.wait() / Atomics.waitAsync() waiters on the counter
+	__builtin_wasm_memory_atomic_notify(const_cast<int*>(reinterpret_cast<volatile int*>(counter)), PX_MAX_U32);
+#endif
+}
+
 void NpScene::fetchResultsParticleSystem()
 {
 	if (mCorruptedState) // silent if scene state is corrupted.
@@ -214,11 +229,22 @@ void NpScene::fetchResultsPostContactCallbacks()
 			mScene.buildActiveActors();
 	}
 
+	if(mScene.getFlags() & PxSceneFlag::eENABLE_BODY_STREAMS)
+	{
+		PX_PROFILE_ZONE("Sim.buildBodyStreams", getContextId());
+		mScene.buildBodyStreams();
+	}
+	else
+		mScene.clearBodyStreams();
+
 	mRenderBuffer.append(mScene.getRenderBuffer());
 
 	PX_ASSERT(getSimulationStage() != Sc::SimulationStage::eCOMPLETE);
 	if (mControllingSimulation)
+	{
 		mTaskManager->stopSimulation();
+		mTaskManager->getCpuDispatcher()->simulationFinished();
+	}
 
 	setSimulationStage(Sc::SimulationStage::eCOMPLETE);
 	setAPIWriteToAllowed();
@@ -280,191 +306,225 @@ bool NpScene::fetchResults(bool block, PxU32* errorState)
 		{
 			OMNI_PVD_WRITE_SCOPE_BEGIN(pvdWriter, pvdRegData)
 
-			//send all xforms updated by the sim:
-			PxU32 nActiveActors;
-			PxActor ** activeActors = mScene.getActiveActors(nActiveActors);
-			while (nActiveActors--)
+			NpOmniPvdSceneClient& ovdClient = getSceneOvdClientInternal();
+			const NpOmniPvd* omniPvd = NpOmniPvdGetInstance();
+			const PxOmniPvdSamplingParams& samplingParams = omniPvd->getSamplingParamsLocked();
+			if (ovdClient.isSampledStep(samplingParams.frameInterval))
 			{
-				PxActor * a = *activeActors++;
-				if ((a->getType() == PxActorType::eRIGID_STATIC) || (a->getType() == PxActorType::eRIGID_DYNAMIC))
+				const bool transformsOnly = samplingParams.transformsOnly;
+
+				//send all xforms updated by the sim:
+				PxU32 nActiveActors;
+				PxActor ** activeActors = mScene.getActiveActors(nActiveActors);
+
+				// also send the actors that moved during the skipped steps, they might be asleep now
+				PxArray<PxActor*> sampledActors;
+				if (ovdClient.hasSkippedActiveActors())
 				{
-					PxRigidActor* ra = static_cast<PxRigidActor*>(a);
-					PxTransform t = ra->getGlobalPose();
-					OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidActor, globalPose, *ra, t);
+					ovdClient.collectSampledActors(sampledActors, activeActors, nActiveActors);
+					activeActors = sampledActors.begin();
+					nActiveActors = sampledActors.size();
+				}
+				while (nActiveActors--)
+				{
+					PxActor * a = *activeActors++;
+					if (!omniPvd->isActorRecordedLocked(*a))
+						continue;
 
-					if (a->getType() == PxActorType::eRIGID_DYNAMIC)
+					if ((a->getType() == PxActorType::eRIGID_STATIC) || (a->getType() == PxActorType::eRIGID_DYNAMIC))
 					{
-						PxRigidDynamic* rdyn = static_cast<PxRigidDynamic*>(a);
-						PxRigidBody& rb = *static_cast<PxRigidBody*>(a);
+						PxRigidActor* ra = static_cast<PxRigidActor*>(a);
+						PxTransform t = ra->getGlobalPose();
+						OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidActor, globalPose, *ra, t);
+
+						if (transformsOnly)
+							continue;
+
+						if (a->getType() == PxActorType::eRIGID_DYNAMIC)
+						{
+							PxRigidDynamic* rdyn = static_cast<PxRigidDynamic*>(a);
+							PxRigidBody& rb = *static_cast<PxRigidBody*>(a);
 						
-						const PxVec3 linVel = rdyn->getLinearVelocity();
-						OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, linearVelocity, rb, linVel)
+							const PxVec3 linVel = rdyn->getLinearVelocity();
+							OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, linearVelocity, rb, linVel)
 
-						const PxVec3 angVel = rdyn->getAngularVelocity();
-						OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, angularVelocity, rb, angVel)
+							const PxVec3 angVel = rdyn->getAngularVelocity();
+							OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, angularVelocity, rb, angVel)
 
-						const PxRigidBodyFlags rFlags = rdyn->getRigidBodyFlags();
-						OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, rigidBodyFlags, rb, rFlags)
+							const PxRigidBodyFlags rFlags = rdyn->getRigidBodyFlags();
+							OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, rigidBodyFlags, rb, rFlags)
 
-						OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidDynamic, wakeCounter, *rdyn, rdyn->getWakeCounter());
-					}
+							OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidDynamic, wakeCounter, *rdyn, rdyn->getWakeCounter());
+						}
 					
-				}
-				else if (a->getType() == PxActorType::eARTICULATION_LINK)
-				{
-					PxArticulationLink* pxArticulationLink = static_cast<PxArticulationLink*>(a);
-					PxArticulationJointReducedCoordinate* pxArticulationJoint = pxArticulationLink->getInboundJoint();
-					if (pxArticulationJoint)
-					{
-						PxArticulationJointReducedCoordinate& jcord = *pxArticulationJoint;
-						PxReal vals[PxArticulationAxis::eCOUNT];
-						for (PxU32 ax = 0; ax < PxArticulationAxis::eCOUNT; ++ax)
-							vals[ax] = jcord.getJointPosition(static_cast<PxArticulationAxis::Enum>(ax));
-						OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxArticulationJointReducedCoordinate, jointPosition, jcord, vals, PxArticulationAxis::eCOUNT);
-						for (PxU32 ax = 0; ax < PxArticulationAxis::eCOUNT; ++ax)
-							vals[ax] = jcord.getJointVelocity(static_cast<PxArticulationAxis::Enum>(ax));
-						OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxArticulationJointReducedCoordinate, jointVelocity, jcord, vals, PxArticulationAxis::eCOUNT);
 					}
+					else if (a->getType() == PxActorType::eARTICULATION_LINK)
+					{
+						PxArticulationLink* pxArticulationLink = static_cast<PxArticulationLink*>(a);
+						if (transformsOnly)
+						{
+							OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidActor, globalPose, static_cast<PxRigidActor&>(*a), pxArticulationLink->getGlobalPose());
+							continue;
+						}
+
+						PxArticulationJointReducedCoordinate* pxArticulationJoint = pxArticulationLink->getInboundJoint();
+						if (pxArticulationJoint)
+						{
+							PxArticulationJointReducedCoordinate& jcord = *pxArticulationJoint;
+							PxReal vals[PxArticulationAxis::eCOUNT];
+							for (PxU32 ax = 0; ax < PxArticulationAxis::eCOUNT; ++ax)
+								vals[ax] = jcord.getJointPosition(static_cast<PxArticulationAxis::Enum>(ax));
+							OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxArticulationJointReducedCoordinate, jointPosition, jcord, vals, PxArticulationAxis::eCOUNT);
+							for (PxU32 ax = 0; ax < PxArticulationAxis::eCOUNT; ++ax)
+								vals[ax] = jcord.getJointVelocity(static_cast<PxArticulationAxis::Enum>(ax));
+							OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxArticulationJointReducedCoordinate, jointVelocity, jcord, vals, PxArticulationAxis::eCOUNT);
+						}
 
-					OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidActor, globalPose, static_cast<PxRigidActor&>(*a), pxArticulationLink->getGlobalPose());
+						OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidActor, globalPose, static_cast<PxRigidActor&>(*a), pxArticulationLink->getGlobalPose());
 
-					const PxVec3 linVel = pxArticulationLink->getLinearVelocity();
-					OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, linearVelocity, static_cast<PxRigidBody&>(*a), linVel)
+						const PxVec3 linVel = pxArticulationLink->getLinearVelocity();
+						OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, linearVelocity, static_cast<PxRigidBody&>(*a), linVel)
 
-					const PxVec3 angVel = pxArticulationLink->getAngularVelocity();
-					OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, angularVelocity, static_cast<PxRigidBody&>(*a), angVel)
+						const PxVec3 angVel = pxArticulationLink->getAngularVelocity();
+						OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, angularVelocity, static_cast<PxRigidBody&>(*a), angVel)
 
-					const PxRigidBodyFlags rFlags = pxArticulationLink->getRigidBodyFlags();
-					OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, rigidBodyFlags, static_cast<PxRigidBody&>(*a), rFlags)
-				}
+						const PxRigidBodyFlags rFlags = pxArticulationLink->getRigidBodyFlags();
+						OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxRigidBody, rigidBodyFlags, static_cast<PxRigidBody&>(*a), rFlags)
+					}
 
-				const PxBounds3 worldBounds = a->getWorldBounds();
-				OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxActor, worldBounds, *a, worldBounds)
+					const PxBounds3 worldBounds = a->getWorldBounds();
+					OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxActor, worldBounds, *a, worldBounds)
 
-				// update active actors' joints
-				const PxRigidActor* ra = a->is<PxRigidActor>();
-				if (ra)
-				{
-					static const PxU32 MAX_CONSTRAINTS = 32;
-					PxConstraint* constraints[MAX_CONSTRAINTS];
-					PxU32 index = 0;
-					while (true)
+					// update active actors' joints
+					const PxRigidActor* ra = a->is<PxRigidActor>();
+					if (ra)
 					{
-						PxU32 count = ra->getConstraints(constraints, MAX_CONSTRAINTS, index);
-						for (PxU32 i = 0; i < count; ++i)
-						{
-							const NpConstraint& c = static_cast<const NpConstraint&>(*constraints[i]);
-							PxRigidActor *ra0, *ra1; c.getActors(ra0, ra1);
-							bool ra0static = !ra0 || !!ra0->is<PxRigidStatic>(), ra1static = !ra1 || !!ra1->is<PxRigidStatic>();
-							// this check is to not update a joint twice
-							if ((ra == ra0 && (ra1static || ra0 > ra1)) || (ra == ra1 && (ra0static || ra1 > ra0)))
-								c.getCore().getPxConnector()->updateOmniPvdProperties();
-						}
-						if (count == MAX_CONSTRAINTS)
+						static const PxU32 MAX_CONSTRAINTS = 32;
+						PxConstraint* constraints[MAX_CONSTRAINTS];
+						PxU32 index = 0;
+						while (true)
 						{
-							index += MAX_CONSTRAINTS;
-							continue;
+							PxU32 count = ra->getConstraints(constraints, MAX_CONSTRAINTS, index);
+							for (PxU32 i = 0; i < count; ++i)
+							{
+								const NpConstraint& c = static_cast<const NpConstraint&>(*constraints[i]);
+								PxRigidActor *ra0, *ra1; c.getActors(ra0, ra1);
+								bool ra0static = !ra0 || !!ra0->is<PxRigidStatic>(), ra1static = !ra1 || !!ra1->is<PxRigidStatic>();
+								// this check is to not update a joint twice
+								if ((ra == ra0 && (ra1static || ra0 > ra1)) || (ra == ra1 && (ra0static || ra1 > ra0)))
+									c.getCore().getPxConnector()->updateOmniPvdProperties();
+							}
+							if (count == MAX_CONSTRAINTS)
+							{
+								index += MAX_CONSTRAINTS;
+								continue;
+							}
+							break;
 						}
-						break;
 					}
 				}
-			}
 
-			PxArticulationReducedCoordinate*const* articulations = mArticulations.getEntries();
-			const PxU32 nbArticulations = mArticulations.size();
-			for( PxU32 i = 0 ; i < nbArticulations ;i++)
-			{				
-				PxArticulationReducedCoordinate* articulation = (articulations[i]);
-				OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxArticulationReducedCoordinate, wakeCounter, *articulation, articulation->getWakeCounter());
-				const PxBounds3 worldBounds = articulation->getWorldBounds();
-				OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxArticulationReducedCoordinate, worldBounds, *articulation, worldBounds);
-				bool isSleeping = articulation->isSleeping();
-				OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxArticulationReducedCoordinate, isSleeping, *articulation, isSleeping);
-			}
-			// send contacts info
-			omniPvdSampler->streamSceneContacts(*this);
+				PxArticulationReducedCoordinate*const* articulations = mArticulations.getEntries();
+				const PxU32 nbArticulations = transformsOnly ? 0 : mArticulations.size();
+				for( PxU32 i = 0 ; i < nbArticulations ;i++)
+				{				
+					PxArticulationReducedCoordinate* articulation = (articulations[i]);
+					OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxArticulationReducedCoordinate, wakeCounter, *articulation, articulation->getWakeCounter());
+					const PxBounds3 worldBounds = articulation->getWorldBounds();
+					OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxArticulationReducedCoordinate, worldBounds, *articulation, worldBounds);
+					bool isSleeping = articulation->isSleeping();
+					OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxArticulationReducedCoordinate, isSleeping, *articulation, isSleeping);
+				}
+				// send contacts info
+				omniPvdSampler->streamSceneContacts(*this, samplingParams.contactSummaries);
 
 #if PX_SUPPORT_GPU_PHYSX
-			// process particle data
-			if (mPBDParticleSystems.size() > 0)
-			{
-				fetchResultsParticleSystem();
-				const PxPBDParticleSystem* const* particleSystems = mPBDParticleSystems.getEntries();
-				const PxU32 particleSystemCount = mPBDParticleSystems.size();
-				for (PxU32 i = 0; i < particleSystemCount; i++)
+				// process particle data
+				if (mPBDParticleSystems.size() > 0)
 				{
-					const NpPBDParticleSystem* npPs = static_cast<const NpPBDParticleSystem*>(particleSystems[i]);
+					fetchResultsParticleSystem();
+					const PxPBDParticleSystem* const* particleSystems = mPBDParticleSystems.getEntries();
+					const PxU32 particleSystemCount = mPBDParticleSystems.size();
+					for (PxU32 i = 0; i < particleSystemCount; i++)
 					{
-						const PxBounds3 worldBounds = npPs->getWorldBounds();
-						OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxActor, worldBounds, *npPs, worldBounds);
-
-						const PxArray<PxsParticleBuffer*>& pxsBuffers = npPs->getCore().getShapeCore().getLLCore().mParticleBuffers;
-						const PxArray<NpParticleBuffer*>& npBuffers = npPs->mParticleBuffers;
-						for (PxU32 b = 0; b < pxsBuffers.size(); ++b)
+						const NpPBDParticleSystem* npPs = static_cast<const NpPBDParticleSystem*>(particleSystems[i]);
 						{
-							const PxsParticleBuffer& pxsBuffer = *pxsBuffers[b];
-							if (pxsBuffer.getPositionInvMassesH())
+							const PxBounds3 worldBounds = npPs->getWorldBounds();
+							OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxActor, worldBounds, *npPs, worldBounds);
+
+							const PxArray<PxsParticleBuffer*>& pxsBuffers = npPs->getCore().getShapeCore().getLLCore().mParticleBuffers;
+							const PxArray<NpParticleBuffer*>& npBuffers = npPs->mParticleBuffers;
+							for (PxU32 b = 0; b < pxsBuffers.size(); ++b)
 							{
-								PxParticleBuffer* pxBuffer = npBuffers[b];
-								PxReal* values = reinterpret_cast<PxReal*>(pxsBuffer.getPositionInvMassesH());
-								PxU32 nbValues = pxsBuffer.getNbActiveParticles() * 4;
-								OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxParticleBuffer, positionInvMasses, *pxBuffer, values, nbValues);
-								OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxParticleBuffer, flatListStartIndex, *pxBuffer, pxsBuffer.getFlatListStartIndex());
+								const PxsParticleBuffer& pxsBuffer = *pxsBuffers[b];
+								if (pxsBuffer.getPositionInvMassesH())
+								{
+									PxParticleBuffer* pxBuffer = npBuffers[b];
+									PxReal* values = reinterpret_cast<PxReal*>(pxsBuffer.getPositionInvMassesH());
+									PxU32 nbValues = pxsBuffer.getNbActiveParticles() * 4;
+									OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxParticleBuffer, positionInvMasses, *pxBuffer, values, nbValues);
+									OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxParticleBuffer, flatListStartIndex, *pxBuffer, pxsBuffer.getFlatListStartIndex());
+								}
 							}
 						}
-					}
-					{
-						const PxArray<PxsParticleBuffer*>& pxsBuffers = npPs->getCore().getShapeCore().getLLCore().mParticleDiffuseBuffers;
-						const PxArray<NpParticleAndDiffuseBuffer*>& npBuffers = npPs->mParticleDiffuseBuffers;
-						for (PxU32 b = 0; b < pxsBuffers.size(); ++b)
 						{
-							const PxsParticleBuffer& pxsBuffer = *pxsBuffers[b];
-							if (pxsBuffer.getPositionInvMassesH())
+							const PxArray<PxsParticleBuffer*>& pxsBuffers = npPs->getCore().getShapeCore().getLLCore().mParticleDiffuseBuffers;
+							const PxArray<NpParticleAndDiffuseBuffer*>& npBuffers = npPs->mParticleDiffuseBuffers;
+							for (PxU32 b = 0; b < pxsBuffers.size(); ++b)
 							{
-								PxParticleBuffer* pxBuffer = npBuffers[b];
-								PxReal* values = reinterpret_cast<PxReal*>(pxsBuffer.getPositionInvMassesH());
-								PxU32 nbValues = pxsBuffer.getNbActiveParticles() * 4;
-								OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxParticleBuffer, positionInvMasses, *pxBuffer, values, nbValues);
+								const PxsParticleBuffer& pxsBuffer = *pxsBuffers[b];
+								if (pxsBuffer.getPositionInvMassesH())
+								{
+									PxParticleBuffer* pxBuffer = npBuffers[b];
+									PxReal* values = reinterpret_cast<PxReal*>(pxsBuffer.getPositionInvMassesH());
+									PxU32 nbValues = pxsBuffer.getNbActiveParticles() * 4;
+									OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxParticleBuffer, positionInvMasses, *pxBuffer, values, nbValues);
+								}
+								//TODO add diffuse particles
 							}
-							//TODO add diffuse particles
 						}
-					}
-					{
-						const PxArray<PxsParticleBuffer*>& pxsBuffers = npPs->getCore().getShapeCore().getLLCore().mParticleClothBuffers;
-						const PxArray<NpParticleClothBuffer*>& npBuffers = npPs->mParticleClothBuffers;
-						for (PxU32 b = 0; b < pxsBuffers.size(); ++b)
 						{
-							const PxsParticleBuffer& pxsBuffer = *pxsBuffers[b];
-							if (pxsBuffer.getPositionInvMassesH())
+							const PxArray<PxsParticleBuffer*>& pxsBuffers = npPs->getCore().getShapeCore().getLLCore().mParticleClothBuffers;
+							const PxArray<NpParticleClothBuffer*>& npBuffers = npPs->mParticleClothBuffers;
+							for (PxU32 b = 0; b < pxsBuffers.size(); ++b)
 							{
-								PxParticleBuffer* pxBuffer = npBuffers[b];
-								PxReal* values = reinterpret_cast<PxReal*>(pxsBuffer.getPositionInvMassesH());
-								PxU32 nbValues = pxsBuffer.getNbActiveParticles() * 4;
-								OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxParticleBuffer, positionInvMasses, *pxBuffer, values, nbValues);
+								const PxsParticleBuffer& pxsBuffer = *pxsBuffers[b];
+								if (pxsBuffer.getPositionInvMassesH())
+								{
+									PxParticleBuffer* pxBuffer = npBuffers[b];
+									PxReal* values = reinterpret_cast<PxReal*>(pxsBuffer.getPositionInvMassesH());
+									PxU32 nbValues = pxsBuffer.getNbActiveParticles() * 4;
+									OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxParticleBuffer, positionInvMasses, *pxBuffer, values, nbValues);
+								}
 							}
 						}
-					}
-					{
-						const PxArray<PxsParticleBuffer*>& pxsBuffers = npPs->getCore().getShapeCore().getLLCore().mParticleRigidBuffers;
-						const PxArray<NpParticleRigidBuffer*>& npBuffers = npPs->mParticleRigidBuffers;
-						for (PxU32 b = 0; b < pxsBuffers.size(); ++b)
 						{
-							const PxsParticleBuffer& pxsBuffer = *pxsBuffers[b];
-							if (pxsBuffer.getPositionInvMassesH())
+							const PxArray<PxsParticleBuffer*>& pxsBuffers = npPs->getCore().getShapeCore().getLLCore().mParticleRigidBuffers;
+							const PxArray<NpParticleRigidBuffer*>& npBuffers = npPs->mParticleRigidBuffers;
+							for (PxU32 b = 0; b < pxsBuffers.size(); ++b)
 							{
-								PxParticleBuffer* pxBuffer = npBuffers[b];
-								PxReal* values = reinterpret_cast<PxReal*>(pxsBuffer.getPositionInvMassesH());
-								PxU32 nbValues = pxsBuffer.getNbActiveParticles() * 4;
-								OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxParticleBuffer, positionInvMasses, *pxBuffer, values, nbValues);
+								const PxsParticleBuffer& pxsBuffer = *pxsBuffers[b];
+								if (pxsBuffer.getPositionInvMassesH())
+								{
+									PxParticleBuffer* pxBuffer = npBuffers[b];
+									PxReal* values = reinterpret_cast<PxReal*>(pxsBuffer.getPositionInvMassesH());
+									PxU32 nbValues = pxsBuffer.getNbActiveParticles() * 4;
+									OMNI_PVD_SET_ARRAY_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxParticleBuffer, positionInvMasses, *pxBuffer, values, nbValues);
+								}
 							}
 						}
 					}
-				}
 
-			}
+				}
 #endif
+			}
+			else if (samplingParams.frameInterval > 1)
+			{
+				PxU32 nActiveActors;
+				PxActor ** activeActors = mScene.getActiveActors(nActiveActors);
+				ovdClient.addSkippedActiveActors(activeActors, nActiveActors);
+			}
 
-			NpOmniPvdSceneClient& ovdClient = getSceneOvdClientInternal();
 			ovdClient.resetForces();
 			ovdClient.incrementFrame(*pvdWriter, true);
 			OMNI_PVD_WRITE_SCOPE_END
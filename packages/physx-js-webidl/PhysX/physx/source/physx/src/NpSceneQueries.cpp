@@ -27,6 +27,7 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "NpSceneQueries.h"
+#include "PxQueryRecorder.h"
 
 #include "common/PxProfileZone.h"
 #include "GuBounds.h"
@@ -207,7 +208,10 @@ namespace
 											mQueries(pvd, contextID, staticPruner, dynamicPruner, desc.dynamicTreeRebuildRateHint, SQ_PRUNER_EPSILON, desc.limits, mAdapter),
 											mUpdateMode	(desc.sceneQueryUpdateMode),
 											mRefCount	(1)
-										{}
+										{
+											// PT: refits of compound trees run on the scene's dispatcher
+											SQ().setCpuDispatcher(desc.cpuDispatcher);
+										}
 		virtual							~InternalPxSQ(){}
 
 		PX_FORCE_INLINE	Sq::PrunerManager&			SQ()				{ return mQueries.mSQManager;	}
@@ -402,6 +406,22 @@ namespace
 			return mQueries._overlap( geometry, transform, hitCall, filterData, filterCall, cache, flags);
 		}
 
+		virtual		bool				cull(	PxU32 nbPlanes, const PxPlane* planes,
+												PxOverlapCallback& hitCall,
+												const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+												PxGeometryQueryFlags flags) const
+		{
+			return mQueries._cull(nbPlanes, planes, hitCall, filterData, filterCall, flags);
+		}
+
+		virtual		PxI32				overlapSpheres(	PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,
+														PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const
+		{
+			return mQueries._overlapSpheres(nbSpheres, centers, radii, hits, maxNbHits, nbHitsPerQuery, filterData, filterCall, flags);
+		}
+
 		virtual	PxSQPrunerHandle		getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const
 		{
 			const NpActor& npActor = NpActor::getFromPxActor(actor);
@@ -443,6 +463,7 @@ static CompanionPrunerType getCompanionType(PxDynamicTreeSecondaryPruner::Enum t
 		case PxDynamicTreeSecondaryPruner::eBUCKET:			return COMPANION_PRUNER_BUCKET;
 		case PxDynamicTreeSecondaryPruner::eINCREMENTAL:	return COMPANION_PRUNER_INCREMENTAL;
 		case PxDynamicTreeSecondaryPruner::eBVH:			return COMPANION_PRUNER_AABB_TREE;
+		case PxDynamicTreeSecondaryPruner::eGRID:			return COMPANION_PRUNER_GRID;
 		case PxDynamicTreeSecondaryPruner::eLAST:			return COMPANION_PRUNER_NONE;
 	}
 	return COMPANION_PRUNER_NONE;
@@ -460,7 +481,7 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 	return BVH_SPLATTER_POINTS;
 }
 
-static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
+static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode, PxReal rebuildCostThreshold, bool quantizedTree)
 {
 	// PT: to force testing the bucket pruner
 //	return createBucketPruner(contextID);
@@ -473,8 +494,8 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 	switch(type)
 	{
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
-		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
-		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode, rebuildCostThreshold);		break;	}
+		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode, rebuildCostThreshold, quantizedTree);	break;	}
 		// PT: for tests
 		case PxPruningStructureType::eLAST:					{ pruner = createIncrementalPruner(contextID);									break;	}
 //		case PxPruningStructureType::eLAST:					break;
@@ -491,8 +512,8 @@ static PxSceneQuerySystem* getPxSQ(const PxSceneDesc& desc, PVDCapture* pvd, PxU
 	}
 	else
 	{
-		Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode);
-		Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode);
+		Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode, 0.0f, desc.staticQuantizedTree);
+		Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode, desc.dynamicTreeRebuildCostThreshold, false);
 		return PX_NEW(InternalPxSQ)(desc, pvd, contextID, staticPruner, dynamicPruner);
 	}
 }
@@ -541,6 +562,8 @@ bool NpScene::raycast(
 	const PxQueryCache* cache, PxGeometryQueryFlags flags) const
 {
 	NP_READ_CHECK(this);
+	if(mQueryRecorder)
+		mQueryRecorder->recordRaycast(origin, unitDir, distance, hitFlags, filterData, hits.maxNbTouches);
 	return mNpSQ.mSQ->raycast(origin, unitDir, distance, hits, hitFlags, filterData, filterCall, cache, flags);
 }
 
@@ -550,15 +573,38 @@ bool NpScene::overlap(
 	const PxQueryCache* cache, PxGeometryQueryFlags flags) const
 {
 	NP_READ_CHECK(this);
+	if(mQueryRecorder)
+		mQueryRecorder->recordOverlap(geometry, pose, filterData, hits.maxNbTouches);
 	return mNpSQ.mSQ->overlap(geometry, pose, hits, filterData, filterCall, cache, flags);
 }
 
+bool NpScene::cull(
+	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hits,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+	PxGeometryQueryFlags flags) const
+{
+	NP_READ_CHECK(this);
+	return mNpSQ.mSQ->cull(nbPlanes, planes, hits, filterData, filterCall, flags);
+}
+
+PxI32 NpScene::overlapSpheres(
+	PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,
+	PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+	PxGeometryQueryFlags flags) const
+{
+	NP_READ_CHECK(this);
+	return mNpSQ.mSQ->overlapSpheres(nbSpheres, centers, radii, hits, maxNbHits, nbHitsPerQuery, filterData, filterCall, flags);
+}
+
 bool NpScene::sweep(
 	const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, const PxReal distance,
 	PxHitCallback<PxSweepHit>& hits, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 	const PxQueryCache* cache, const PxReal inflation, PxGeometryQueryFlags flags) const
 {
 	NP_READ_CHECK(this);
+	if(mQueryRecorder)
+		mQueryRecorder->recordSweep(geometry, pose, unitDir, distance, hitFlags, filterData, hits.maxNbTouches, inflation);
 	return mNpSQ.mSQ->sweep(geometry, pose, unitDir, distance, hits, hitFlags, filterData, filterCall, cache, inflation, flags);
 }
 
@@ -645,6 +691,8 @@ void NpScene::syncSQ()
 {
 	PxSceneQuerySystem& pm = getSQAPI();
 
+	pm.beginSync();
+
 	{
 		const PxU32 numBodies = mScene.getNumActiveCompoundBodies();
 		const Sc::BodyCore*const* bodies = mScene.getActiveCompoundBodiesArray();
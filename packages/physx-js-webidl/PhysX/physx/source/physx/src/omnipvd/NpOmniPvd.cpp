@@ -34,6 +34,7 @@
 #include "OmniPvdFileWriteStream.h"
 #endif
 #include "foundation/PxUserAllocated.h"
+#include "PxActor.h"
 
 physx::PxU32 physx::NpOmniPvd::mRefCount = 0;
 physx::NpOmniPvd* physx::NpOmniPvd::mInstance = NULL;
@@ -204,6 +205,47 @@ namespace physx
 		return false;
 #endif
 	}
+
+	// The sampling parameters are read by the scenes at the end of fetchResults, while holding the writer access.
+	// Setters take the same mutex so that a step never sees partially updated parameters.
+	void NpOmniPvd::setSamplingParams(const PxOmniPvdSamplingParams& params)
+	{
+		PX_CHECK_AND_RETURN(params.frameInterval >= 1, "PxOmniPvd::setSamplingParams: frameInterval must be at least 1.");
+		PxMutex::ScopedLock lock(mMutex);
+		mSamplingParams = params;
+	}
+
+	PxOmniPvdSamplingParams NpOmniPvd::getSamplingParams()
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		return mSamplingParams;
+	}
+
+	void NpOmniPvd::setActorSampled(const PxActor& actor, bool sampled)
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		if (sampled)
+			mSampledActors.insert(&actor);
+		else
+			mSampledActors.erase(&actor);
+	}
+
+	bool NpOmniPvd::isActorSampled(const PxActor& actor)
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		return mSampledActors.contains(&actor);
+	}
+
+	void NpOmniPvd::onObjectRemove(const PxBase& object)
+	{
+		// Only the concrete type is used here, the object can be partially destroyed already
+		const PxType type = object.getConcreteType();
+		if (type == PxConcreteType::eRIGID_DYNAMIC || type == PxConcreteType::eRIGID_STATIC || type == PxConcreteType::eARTICULATION_LINK)
+		{
+			PxMutex::ScopedLock lock(mMutex);
+			mSampledActors.erase(static_cast<const PxActor*>(&object));
+		}
+	}
 }
 
 physx::PxOmniPvd* PxCreateOmniPvd(physx::PxFoundation& foundation)
@@ -31,6 +31,8 @@
 
 #include "omnipvd/PxOmniPvd.h"
 #include "foundation/PxMutex.h"
+#include "foundation/PxHashSet.h"
+#include "common/PxBase.h"
 #include "NpOmniPvdMetaData.h"
 
 class OmniPvdReader;
@@ -63,12 +65,27 @@ public:
 
 	OmniPvdFileWriteStream* getFileWriteStream();
 	bool startSampling();
+
+	void setSamplingParams(const PxOmniPvdSamplingParams& params);
+	PxOmniPvdSamplingParams getSamplingParams();
+	void setActorSampled(const PxActor& actor, bool sampled);
+	bool isActorSampled(const PxActor& actor);
+
+	// Called by the sampler with exclusive writer access, see acquireExclusiveWriterAccess()
+	PX_FORCE_INLINE const PxOmniPvdSamplingParams& getSamplingParamsLocked() const { return mSamplingParams; }
+	PX_FORCE_INLINE bool isActorRecordedLocked(const PxActor& actor) const
+	{
+		return !mSamplingParams.sampledActorsOnly || mSampledActors.contains(&actor);
+	}
+	void onObjectRemove(const PxBase& object);
 	
 	OmniPvdLoader* mLoader;
 	OmniPvdFileWriteStream* mFileWriteStream;
 	OmniPvdWriter* mWriter;
 	OmniPvdPxSampler* mPhysXSampler;
 	NpOmniPvdMetaData mMetaData;
+	PxOmniPvdSamplingParams mSamplingParams;
+	PxHashSet<const PxActor*> mSampledActors;
 	static PxU32 mRefCount;
 	static NpOmniPvd* mInstance;
 	PxMutex mMutex;
@@ -88,7 +88,7 @@ OmniPvdSamplerInternals * samplerInternals = NULL;
 
 namespace physx
 {
-NpOmniPvdSceneClient::NpOmniPvdSceneClient(physx::PxScene& scene) : mScene(scene), mFrameId(1)
+NpOmniPvdSceneClient::NpOmniPvdSceneClient(physx::PxScene& scene) : mScene(scene), mFrameId(1), mStepIndex(0)
 {
 }
 
@@ -117,6 +117,34 @@ void NpOmniPvdSceneClient::stopLastFrame(OmniPvdWriter& pvdWriter)
 	pvdWriter.stopFrame((OmniPvdContextHandle)(&mScene), mFrameId);
 }
 
+bool NpOmniPvdSceneClient::isSampledStep(physx::PxU32 frameInterval)
+{
+	if (++mStepIndex < frameInterval)
+		return false;
+	mStepIndex = 0;
+	return true;
+}
+
+void NpOmniPvdSceneClient::addSkippedActiveActors(physx::PxActor*const* actors, physx::PxU32 nbActors)
+{
+	for (PxU32 i = 0; i < nbActors; i++)
+		mSkippedActiveActors.insert(actors[i]);
+}
+
+void NpOmniPvdSceneClient::removeSkippedActiveActor(const physx::PxActor* actor)
+{
+	mSkippedActiveActors.erase(const_cast<PxActor*>(actor));
+}
+
+void NpOmniPvdSceneClient::collectSampledActors(physx::PxArray<physx::PxActor*>& sampledActors, physx::PxActor*const* activeActors, physx::PxU32 nbActiveActors)
+{
+	addSkippedActiveActors(activeActors, nbActiveActors);
+	sampledActors.reserve(mSkippedActiveActors.size());
+	for (PxHashSet<PxActor*>::Iterator it = mSkippedActiveActors.getIterator(); !it.done(); ++it)
+		sampledActors.pushBack(*it);
+	mSkippedActiveActors.clear();
+}
+
 void NpOmniPvdSceneClient::addRigidDynamicForceReset(const physx::PxRigidDynamic* rigidDynamic)
 {
 	mResetRigidDynamicForce.insert(rigidDynamic);
@@ -1359,7 +1387,7 @@ void streamTriMeshGeometry(const physx::PxTriangleMeshGeometry& g)
 	OMNI_PVD_WRITE_SCOPE_END
 }
 
-void OmniPvdPxSampler::streamSceneContacts(physx::NpScene& scene)
+void OmniPvdPxSampler::streamSceneContacts(physx::NpScene& scene, bool summaries)
 {
 	if (!isSampling()) return;
 	PxsContactManagerOutputIterator outputIter;
@@ -1395,6 +1423,17 @@ void OmniPvdPxSampler::streamSceneContacts(physx::NpScene& scene)
 				++pairCount;
 				firstContact = false;
 			}
+			else if (summaries)
+			{
+				// Accumulate into the pair's single contact: average point and normal, deepest separation, total impulse.
+				// Shapes and face indices are the ones of the first contact.
+				++pairContactCount;
+				pairsContactPoints.back() += contact->point;
+				pairsContactNormals.back() += contact->normal;
+				pairsContactSeparations.back() = PxMin(pairsContactSeparations.back(), contact->separation);
+				pairsContactImpulses.back() += contact->normalForce;
+				continue;
+			}
 			++pairContactCount;
 			pairsContactPoints.pushBack(contact->point);
 			pairsContactNormals.pushBack(contact->normal);
@@ -1405,6 +1444,13 @@ void OmniPvdPxSampler::streamSceneContacts(physx::NpScene& scene)
 			pairsContactFacesIndices.pushBack(contact->faceIndex1);
 			pairsContactImpulses.pushBack(contact->normalForce);
 		}
+		if (pairContactCount && summaries)
+		{
+			pairsContactPoints.back() /= PxReal(pairContactCount);
+			pairsContactNormals.back().normalizeSafe();
+			pairsContactCounts.pushBack(1);
+			continue;
+		}
 		if (pairContactCount) 
 		{
 			pairsContactCounts.pushBack(pairContactCount);
@@ -1793,6 +1839,11 @@ void OmniPvdPxSampler::onObjectAdd(const physx::PxBase& object)
 
 void OmniPvdPxSampler::onObjectRemove(const physx::PxBase& object)
 {
+	// Released actors are deselected even when not sampling, so that a new actor reusing the address is not sampled
+	physx::NpOmniPvd* omniPvd = physx::NpOmniPvdGetInstance();
+	if (omniPvd)
+		omniPvd->onObjectRemove(object);
+
 	if (!isSampling()) return;
 
 	const PxPhysics& physics = static_cast<PxPhysics&>(NpPhysics::getInstance());
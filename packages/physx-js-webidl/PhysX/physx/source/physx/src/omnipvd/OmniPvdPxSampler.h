@@ -138,9 +138,23 @@ public:
 	
 	void resetForces();
 
+	////////////////////////////////////////////////////////////////////////////////
+	// With PxOmniPvdSamplingParams::frameInterval, the simulation results are only streamed
+	// for some of the steps. The actors active during the skipped steps are kept, and streamed
+	// with the next sampled step even if they went to sleep in between.
+	////////////////////////////////////////////////////////////////////////////////
+
+	bool isSampledStep(physx::PxU32 frameInterval); // call once per step
+	void addSkippedActiveActors(physx::PxActor*const* actors, physx::PxU32 nbActors);
+	void removeSkippedActiveActor(const physx::PxActor* actor);
+	PX_FORCE_INLINE bool hasSkippedActiveActors() const { return mSkippedActiveActors.size() != 0; }
+	void collectSampledActors(physx::PxArray<physx::PxActor*>& sampledActors, physx::PxActor*const* activeActors, physx::PxU32 nbActiveActors);
+
 private:
 	physx::PxScene& mScene;
 	physx::PxU64 mFrameId;
+	physx::PxU32 mStepIndex;
+	physx::PxHashSet<physx::PxActor*> mSkippedActiveActors;
 
 	physx::PxHashSet<const PxRigidDynamic*> mResetRigidDynamicForce;
 	physx::PxHashSet<const PxRigidDynamic*> mResetRigidDynamicTorque;
@@ -161,8 +175,8 @@ public:
 	bool isSampling();
 	void setOmniPvdInstance(physx::NpOmniPvd* omniPvdIntance);
 
-	// writes all contacts to the stream
-	void streamSceneContacts(physx::NpScene& scene);
+	// writes all contacts to the stream, or a single averaged contact per pair for summaries
+	void streamSceneContacts(physx::NpScene& scene, bool summaries = false);
 
 	static OmniPvdPxSampler* getInstance();
 
@@ -52,6 +52,7 @@ namespace Cct
 		virtual	PxF32								getHalfHeightInternal()				const	PX_OVERRIDE	PX_FINAL		{ return mRadius+mHeight*0.5f;			}
 		virtual	bool								getWorldBox(PxExtendedBounds3& box) const	PX_OVERRIDE	PX_FINAL;
 		virtual	PxController*						getPxController()							PX_OVERRIDE	PX_FINAL		{ return this;							}
+		virtual	PxControllerCollisionFlags			moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, ControllerMoveContext* context)	PX_OVERRIDE	PX_FINAL;
 		//~Controller
 
 		// PxController
@@ -68,6 +69,8 @@ namespace Cct
 		virtual	PxF32								getStepOffset()						const	PX_OVERRIDE	PX_FINAL		{ return mUserParams.mStepOffset;		}
 		virtual	void								setNonWalkableMode(PxControllerNonWalkableMode::Enum flag)	PX_OVERRIDE	PX_FINAL	{ mUserParams.mNonWalkableMode = flag;	}
 		virtual	PxControllerNonWalkableMode::Enum	getNonWalkableMode()				const	PX_OVERRIDE	PX_FINAL		{ return mUserParams.mNonWalkableMode;	}
+		virtual	void								setQuality(PxControllerQuality::Enum quality)	PX_OVERRIDE	PX_FINAL	{ mUserParams.mQuality = quality;		}
+		virtual	PxControllerQuality::Enum			getQuality()						const	PX_OVERRIDE	PX_FINAL		{ return mUserParams.mQuality;			}
 		virtual PxF32								getContactOffset()					const	PX_OVERRIDE	PX_FINAL		{ return mUserParams.mContactOffset;	}
 		virtual	void								setContactOffset(PxF32 offset)				PX_OVERRIDE	PX_FINAL		{ if(offset>0.0f)
 																																mUserParams.mContactOffset = offset;}
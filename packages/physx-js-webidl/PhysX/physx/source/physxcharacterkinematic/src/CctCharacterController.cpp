@@ -28,6 +28,7 @@
 
 #include "common/PxProfileZone.h"
 #include "geometry/PxMeshQuery.h"
+#include "geometry/PxHeightFieldGeometry.h"
 #include "foundation/PxMathUtils.h"
 #include "PxRigidDynamic.h"
 
@@ -645,6 +646,61 @@ static bool SweepBoxCustom(const SweepTest* test, const SweptVolume* volume, con
 	return true;
 }
 
+static PX_FORCE_INLINE PxHeightFieldGeometry getHeightFieldGeometry(const TouchedHeightField& hf)
+{
+	return PxHeightFieldGeometry(hf.mHeightField, PxMeshGeometryFlags(PxU8(hf.mFlags)), hf.mScale.x, hf.mScale.y, hf.mScale.z);
+}
+
+static bool sweepVolumeVsHeightField(const SweepTest* test, const TouchedHeightField* THF, SweptContact& impact, const PxVec3& dir, const PxGeometry& geom, const PxTransform& pose)
+{
+	// PT: this goes through the heightfield's own sweep code, which walks the cells touched by the swept volume. There is
+	// no triangle extraction, and the returned triangle index is the heightfield's.
+	const PxHeightFieldGeometry hfGeom = getHeightFieldGeometry(*THF);
+	const PxTransform hfPose(THF->mPos, THF->mRot);
+
+	PxGeomSweepHit sweepHit;
+	if(!PxGeometryQuery::sweep(dir, impact.mDistance, geom, pose, hfGeom, hfPose, sweepHit, getSweepHitFlags(test->mUserParams)))
+		return false;
+
+	if(sweepHit.distance >= impact.mDistance)
+		return false;
+
+	impact.mDistance		= sweepHit.distance;
+	impact.mWorldNormal		= sweepHit.normal;
+	impact.mInternalIndex	= PX_INVALID_U32;
+	impact.mTriangleIndex	= sweepHit.faceIndex;
+	impact.setWorldPos(sweepHit.position, THF->mOffset);
+	return true;
+}
+
+static bool SweepBoxHeightField(const SweepTest* test, const SweptVolume* volume, const TouchedGeom* geom, const PxExtendedVec3& center, const PxVec3& dir, SweptContact& impact)
+{
+	PX_ASSERT(volume->getType()==SweptVolumeType::eBOX);
+	PX_ASSERT(geom->mType==TouchedGeomType::eHEIGHTFIELD);
+	const SweptBox* SB = static_cast<const SweptBox*>(volume);
+	const TouchedHeightField* THF = static_cast<const TouchedHeightField*>(geom);
+
+	PxBoxGeometry boxGeom;
+	PxTransform boxPose;
+	relocateBox(boxGeom, boxPose, center, SB->mExtents, THF->mOffset, test->mUserParams.mQuatFromUp);
+
+	return sweepVolumeVsHeightField(test, THF, impact, dir, boxGeom, boxPose);
+}
+
+static bool SweepCapsuleHeightField(const SweepTest* test, const SweptVolume* volume, const TouchedGeom* geom, const PxExtendedVec3& center, const PxVec3& dir, SweptContact& impact)
+{
+	PX_ASSERT(volume->getType()==SweptVolumeType::eCAPSULE);
+	PX_ASSERT(geom->mType==TouchedGeomType::eHEIGHTFIELD);
+	const SweptCapsule* SC = static_cast<const SweptCapsule*>(volume);
+	const TouchedHeightField* THF = static_cast<const TouchedHeightField*>(geom);
+
+	PxCapsuleGeometry capsuleGeom;
+	PxTransform capsulePose;
+	relocateCapsule(capsuleGeom, capsulePose, SC, test->mUserParams.mQuatFromUp, center, THF->mOffset);
+
+	return sweepVolumeVsHeightField(test, THF, impact, dir, capsuleGeom, capsulePose);
+}
+
 static bool SweepCapsuleCapsule(const SweepTest* test, const SweptVolume* volume, const TouchedGeom* geom, const PxExtendedVec3& center, const PxVec3& dir, SweptContact& impact)
 {
 	PX_ASSERT(volume->getType()==SweptVolumeType::eCAPSULE);
@@ -761,7 +817,8 @@ static SweepFunc gSweepMap[SweptVolumeType::eLAST][TouchedGeomType::eLAST] = {
 	SweepBoxBox,
 	SweepBoxSphere,
 	SweepBoxCapsule,
-	SweepBoxCustom
+	SweepBoxCustom,
+	SweepBoxHeightField
 	},
 
 	// Capsule funcs
@@ -772,7 +829,8 @@ static SweepFunc gSweepMap[SweptVolumeType::eLAST][TouchedGeomType::eLAST] = {
 	SweepCapsuleBox,
 	SweepCapsuleSphere,
 	SweepCapsuleCapsule,
-	SweepCapsuleCustom
+	SweepCapsuleCustom,
+	SweepCapsuleHeightField
 	}
 };
 
@@ -786,7 +844,8 @@ static const PxU32 GeomSizes[] =
 	sizeof(TouchedBox),
 	sizeof(TouchedSphere),
 	sizeof(TouchedCapsule),
-	sizeof(TouchedCustom)
+	sizeof(TouchedCustom),
+	sizeof(TouchedHeightField)
 };
 
 static const TouchedGeom* CollideGeoms(
@@ -957,6 +1016,7 @@ static bool ParseGeomStream(const void* object, const IntArray& geom_stream)
 
 CCTParams::CCTParams() :
 	mNonWalkableMode						(PxControllerNonWalkableMode::ePREVENT_CLIMBING),
+	mQuality								(PxControllerQuality::eDEFAULT),
 	mQuatFromUp								(PxQuat(PxIdentity)),
 	mUpDirection							(PxVec3(0.0f)),
 	mSlopeLimit								(0.0f),
@@ -1006,6 +1066,7 @@ SweepTest::SweepTest(bool registerDeletionListener) :
 	mVolumeGrowth	= 1.5f;	// Must be >1.0f and not too big
 //	mVolumeGrowth	= 2.0f;	// Must be >1.0f and not too big
 
+	mGroundNormal = PxVec3(0.0f);
 	mContactNormalDownPass = PxVec3(0.0f);
 	mContactNormalSidePass = PxVec3(0.0f);
 	mTouchedTriMin = 0.0f;
@@ -1283,6 +1344,9 @@ void SweepTest::updateTouchedGeoms(	const InternalCBData_FindTouchedGeom* userDa
 	filter.mPreFilter		= filters.mFilterFlags & PxQueryFlag::ePREFILTER;
 	filter.mPostFilter		= filters.mFilterFlags & PxQueryFlag::ePOSTFILTER;
 
+	// PT: crowd controllers only collide with static shapes (and other CCTs, which are handled as obstacles)
+	const bool gatherDynamic = (filters.mFilterFlags & PxQueryFlag::eDYNAMIC) && mUserParams.mQuality!=PxControllerQuality::eCROWD;
+
 	// PT: detect changes to the static pruning structure
 	bool sceneHasChanged = false;
 	{
@@ -1309,9 +1373,9 @@ void SweepTest::updateTouchedGeoms(	const InternalCBData_FindTouchedGeom* userDa
 			mTriangleIndices.forceSize_Unsafe(mNbCachedT);			
 
 			filter.mStaticShapes	= false;
-			if(filters.mFilterFlags & PxQueryFlag::eDYNAMIC)
-				filter.mDynamicShapes	= true;
-			findTouchedGeometry(userData, DYNAMIC_BOX, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, mNbTessellation);
+			filter.mDynamicShapes	= gatherDynamic;
+			if(gatherDynamic)
+				findTouchedGeometry(userData, DYNAMIC_BOX, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, mNbTessellation);
 			updateCachedShapesRegistration(mNbCachedStatic, false);
 
 			findTouchedObstacles(userObstacles, DYNAMIC_BOX);
@@ -1368,16 +1432,17 @@ void SweepTest::updateTouchedGeoms(	const InternalCBData_FindTouchedGeom* userDa
 		if(filters.mFilterFlags & PxQueryFlag::eSTATIC)
 			filter.mStaticShapes	= true;
 		filter.mDynamicShapes	= false;
-		findTouchedGeometry(userData, mCacheBounds, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, mNbTessellation);
+		if(!mCctManager->mTileCache.fetchStaticGeometry(userData, mCacheBounds, filter, mUserParams, mWorldTriangles, mTriangleIndices, mGeomStream))
+			findTouchedGeometry(userData, mCacheBounds, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, mNbTessellation);
 
 		mNbCachedStatic = mGeomStream.size();
 		mNbCachedT = mWorldTriangles.size();
 		PX_ASSERT(mTriangleIndices.size()==mNbCachedT);
 
 		filter.mStaticShapes	= false;
-		if(filters.mFilterFlags & PxQueryFlag::eDYNAMIC)
-			filter.mDynamicShapes	= true;
-		findTouchedGeometry(userData, DYNAMIC_BOX, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, mNbTessellation);
+		filter.mDynamicShapes	= gatherDynamic;
+		if(gatherDynamic)
+			findTouchedGeometry(userData, DYNAMIC_BOX, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, mNbTessellation);
 		// We can't early exit when no tris are touched since we also have to handle the boxes
 		updateCachedShapesRegistration(0, false);
 
@@ -1410,6 +1475,25 @@ void SweepTest::updateTouchedGeoms(	const InternalCBData_FindTouchedGeom* userDa
 }
 
 // This is the generic sweep test for all swept volumes, but not character-controller specific
+// PT: returns the touched triangle relative to the cache center, for the slope & step tests. Mesh triangles come from the
+// triangle cache, heightfield triangles are rebuilt from the height samples.
+bool SweepTest::getTouchedTriangle(PxTriangle& triangle, const SweptContact& contact) const
+{
+	if(contact.mInternalIndex!=PX_INVALID_U32)
+	{
+		triangle = mWorldTriangles.getTriangle(contact.mInternalIndex);
+		return true;
+	}
+
+	if(contact.mGeom && contact.mGeom->mType==TouchedGeomType::eHEIGHTFIELD && contact.mTriangleIndex!=PX_INVALID_U32)
+	{
+		const TouchedHeightField* THF = static_cast<const TouchedHeightField*>(contact.mGeom);
+		PxMeshQuery::getTriangle(getHeightFieldGeometry(*THF), PxTransform(THF->mPos, THF->mRot), contact.mTriangleIndex, triangle);
+		return true;
+	}
+	return false;
+}
+
 bool SweepTest::doSweepTest(const InternalCBData_FindTouchedGeom* userData,
 							InternalCBData_OnHit* userHitData,
 							const UserObstacles& userObstacles,
@@ -1516,6 +1600,9 @@ bool SweepTest::doSweepTest(const InternalCBData_FindTouchedGeom* userData,
 //			continue;
 		}
 
+		if(sweepPass==SWEEP_PASS_DOWN)
+			mGroundNormal = C.mWorldNormal;
+
 		bool preventVerticalMotion = false;
 		bool stopSliding = true;
 		if(C.mGeom->mType==TouchedGeomType::eUSER_BOX || C.mGeom->mType==TouchedGeomType::eUSER_CAPSULE)
@@ -1588,10 +1675,10 @@ bool SweepTest::doSweepTest(const InternalCBData_FindTouchedGeom* userData,
 				// TODO:  1. should we treat stationary kinematics the same as statics.
 				//		  2. should we treat all kinematics the same as statics.
 				//		  3. should we treat no kinematics the same as statics.
-				if((touchedActor->getConcreteType() == PxConcreteType::eRIGID_STATIC) && (C.mInternalIndex!=PX_INVALID_U32))
+				PxTriangle touchedTri;
+				if((touchedActor->getConcreteType() == PxConcreteType::eRIGID_STATIC) && getTouchedTriangle(touchedTri, C))
 				{
 					mFlags |= STF_VALIDATE_TRIANGLE_DOWN;
-					const PxTriangle& touchedTri = mWorldTriangles.getTriangle(C.mInternalIndex);
 					const PxVec3& upDirection = mUserParams.mUpDirection;
 					const float dp0 = touchedTri.verts[0].dot(upDirection);
 					const float dp1 = touchedTri.verts[1].dot(upDirection);
@@ -1623,10 +1710,10 @@ bool SweepTest::doSweepTest(const InternalCBData_FindTouchedGeom* userData,
 			}
 			else if(sweepPass==SWEEP_PASS_SIDE || sweepPass==SWEEP_PASS_SENSOR)
 			{
-				if((touchedActor->getConcreteType() == PxConcreteType::eRIGID_STATIC) && (C.mInternalIndex!=PX_INVALID_U32))
+				PxTriangle touchedTri;
+				if((touchedActor->getConcreteType() == PxConcreteType::eRIGID_STATIC) && getTouchedTriangle(touchedTri, C))
 				{
 					mFlags |= STF_VALIDATE_TRIANGLE_SIDE;
-					const PxTriangle& touchedTri = mWorldTriangles.getTriangle(C.mInternalIndex);
 					touchedTri.normal(mContactNormalSidePass);
 //					printf("%f | %f | %f\n", mContactNormalSidePass.x, mContactNormalSidePass.y, mContactNormalSidePass.z);
 					if(mUserParams.mPreventVerticalSlidingAgainstCeiling && mContactNormalSidePass.dot(mUserParams.mUpDirection)<0.0f)
@@ -1723,8 +1810,9 @@ PxControllerCollisionFlags SweepTest::moveCharacter(
 	bool standingOnMovingUp = standingOnMoving;
 
 	mFlags &= ~STF_HIT_NON_WALKABLE;
+	mGroundNormal = PxVec3(0.0f);
 	PxControllerCollisionFlags CollisionFlags = PxControllerCollisionFlags(0);
-	const PxU32 maxIter = MAX_ITER;	// 1 for "collide and stop"
+	const PxU32 maxIter = mUserParams.mQuality==PxControllerQuality::eCROWD ? 1 : MAX_ITER;	// 1 for "collide and stop"
 	const PxU32 maxIterSides = maxIter;
 	const PxU32 maxIterDown = ((mFlags & STF_WALK_EXPERIMENT) && mUserParams.mNonWalkableMode==PxControllerNonWalkableMode::ePREVENT_CLIMBING_AND_FORCE_SLIDING) ? maxIter : 1;
 //	const PxU32 maxIterDown = 1;
@@ -2283,7 +2371,7 @@ bool Controller::rideOnTouchedObject(SweptVolume& volume, const PxVec3& upDirect
 	return standingOnMoving;
 }
 
-PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& originalDisp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, bool constrainedClimbingMode)
+PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& originalDisp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, bool constrainedClimbingMode, ControllerMoveContext* context)
 {
 	const bool lockWrite = mManager->mLockingEnabled;
 	if(lockWrite)
@@ -2292,7 +2380,8 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	mGlobalTime += PxF64(elapsedTime);
 
 	// Init CCT with per-controller settings
-	PxRenderBuffer* renderBuffer									= mManager->mRenderBuffer;
+	// PT: no debug rendering in batched moves, the render buffer is not thread-safe
+	PxRenderBuffer* renderBuffer									= context ? NULL : mManager->mRenderBuffer;
 	const PxU32 debugRenderFlags									= mManager->mDebugRenderingFlags;
 	mCctModule.mRenderBuffer										= renderBuffer;
 	mCctModule.mRenderFlags											= debugRenderFlags;
@@ -2303,6 +2392,17 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	mCctModule.mUserParams.mOverlapRecovery							= mManager->mOverlapRecovery;
 	mCctModule.mUserParams.mPreciseSweeps							= mManager->mPreciseSweeps;
 	mCctModule.mUserParams.mPreventVerticalSlidingAgainstCeiling	= mManager->mPreventVerticalSlidingAgainstCeiling;
+	if(mUserParams.mQuality==PxControllerQuality::eCROWD)
+	{
+		// PT: crowd controllers use the cheapest version of everything. No tessellation and no invisible walls means
+		// heightfields are swept directly, no overlap recovery means no MTD computation, and user obstacles are ignored.
+		mCctModule.mUserParams.mTessellation						= false;
+		mCctModule.mUserParams.mOverlapRecovery						= false;
+		mCctModule.mUserParams.mPreciseSweeps						= false;
+		mCctModule.mUserParams.mInvisibleWallHeight					= 0.0f;
+		obstacleContext												= NULL;
+		mCctModule.mTouchedObstacleHandle							= PX_INVALID_OBSTACLE_HANDLE;
+	}
 	mCctModule.resetStats();
 
 	const PxVec3& upDirection = mUserParams.mUpDirection;
@@ -2381,10 +2481,10 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 //	printf("standingOnMoving: %d\n", standingOnMoving);
 
 	///////////
-	PxArray<const void*>&		boxUserData		= mManager->mBoxUserData;
-	PxArray<PxExtendedBox>&		boxes			= mManager->mBoxes;
-	PxArray<const void*>&		capsuleUserData	= mManager->mCapsuleUserData;
-	PxArray<PxExtendedCapsule>&	capsules		= mManager->mCapsules;
+	PxArray<const void*>&		boxUserData		= context ? context->mBoxUserData : mManager->mBoxUserData;
+	PxArray<PxExtendedBox>&		boxes			= context ? context->mBoxes : mManager->mBoxes;
+	PxArray<const void*>&		capsuleUserData	= context ? context->mCapsuleUserData : mManager->mCapsuleUserData;
+	PxArray<PxExtendedCapsule>&	capsules		= context ? context->mCapsules : mManager->mCapsules;
 	PX_ASSERT(!boxUserData.size());
 	PX_ASSERT(!boxes.size());
 	PX_ASSERT(!capsuleUserData.size());
@@ -2412,9 +2512,11 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 				if(currentController->mType==PxControllerShapeType::eBOX)
 				{
 					// PT: TODO: optimize this
-					BoxController* BC = static_cast<BoxController*>(currentController);
 					PxExtendedBox obb;
-					BC->getOBB(obb);
+					if(context)
+						obb = context->mControllerBoxes[i];
+					else
+						static_cast<BoxController*>(currentController)->getOBB(obb);
 
 					boxes.pushBack(obb);
 
@@ -2434,11 +2536,12 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 				}
 				else if(currentController->mType==PxControllerShapeType::eCAPSULE)
 				{
-					CapsuleController* CC = static_cast<CapsuleController*>(currentController);
-
 					// PT: TODO: optimize this
 					PxExtendedCapsule worldCapule;
-					CC->getCapsule(worldCapule);
+					if(context)
+						worldCapule = context->mControllerCapsules[i];
+					else
+						static_cast<CapsuleController*>(currentController)->getCapsule(worldCapule);
 					capsules.pushBack(worldCapule);
 
 					const size_t code = encodeUserObject(i, USER_OBJECT_CCT);
@@ -2454,10 +2557,26 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	{
 		obstacles = static_cast<const ObstacleContext*>(obstacleContext);
 
-		// PT: TODO: optimize this
-		const PxU32 nbExtraBoxes = obstacles->mBoxObstacles.size();
-		for(PxU32 i=0;i<nbExtraBoxes;i++)
+		// PT: only the obstacles the CCT can reach during this move are passed to the sweep test. Each pass of
+		// moveCharacter() moves at most by the displacement plus the step offset, so the query box covers the
+		// CCT's temporal box grown by twice that distance.
+		ObstacleIndices boxIndices;
+		ObstacleIndices capsuleIndices;
 		{
+			PxExtendedBounds3 temporalBox;
+			volume.computeTemporalBox(mCctModule, temporalBox, volume.mCenter, disp);
+
+			const PxF32 reach = 2.0f * (disp.magnitude() + mUserParams.mStepOffset);
+			PxBounds3 queryBox = getBounds3(temporalBox);
+			queryBox.fattenFast(reach);
+
+			obstacles->findObstacles(queryBox, boxIndices, capsuleIndices);
+		}
+
+		const PxU32 nbExtraBoxes = boxIndices.size();
+		for(PxU32 j=0;j<nbExtraBoxes;j++)
+		{
+			const PxU32 i = boxIndices[j];
 			const PxBoxObstacle& userBoxObstacle = obstacles->mBoxObstacles[i].mData;
 
 			PxExtendedBox extraBox;
@@ -2468,21 +2587,12 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 
 			const size_t code = encodeUserObject(i, USER_OBJECT_BOX_OBSTACLE);
 			boxUserData.pushBack(reinterpret_cast<const void*>(code));
-
-			if(renderBuffer && (debugRenderFlags & PxControllerDebugRenderFlag::eOBSTACLES))
-			{
-				PxRenderOutput out(*renderBuffer);
-				out << gObstacleDebugColor;
-
-				out << PxTransform(toVec3(userBoxObstacle.mPos), userBoxObstacle.mRot);
-
-				renderOutputDebugBox(out, PxBounds3(-userBoxObstacle.mHalfExtents, userBoxObstacle.mHalfExtents));
-			}
 		}
 
-		const PxU32 nbExtraCapsules = obstacles->mCapsuleObstacles.size();
-		for(PxU32 i=0;i<nbExtraCapsules;i++)
+		const PxU32 nbExtraCapsules = capsuleIndices.size();
+		for(PxU32 j=0;j<nbExtraCapsules;j++)
 		{
+			const PxU32 i = capsuleIndices[j];
 			const PxCapsuleObstacle& userCapsuleObstacle = obstacles->mCapsuleObstacles[i].mData;
 
 			PxExtendedCapsule extraCapsule;
@@ -2498,11 +2608,24 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 			capsules.pushBack(extraCapsule);
 			const size_t code = encodeUserObject(i, USER_OBJECT_CAPSULE_OBSTACLE);
 			capsuleUserData.pushBack(reinterpret_cast<const void*>(code));
+		}
 
-			if(renderBuffer && (debugRenderFlags & PxControllerDebugRenderFlag::eOBSTACLES))
+		// PT: debug rendering still shows all obstacles, not only the ones found above
+		if(renderBuffer && (debugRenderFlags & PxControllerDebugRenderFlag::eOBSTACLES))
+		{
+			PxRenderOutput out(*renderBuffer);
+			out << gObstacleDebugColor;
+
+			for(PxU32 i=0;i<obstacles->mBoxObstacles.size();i++)
 			{
-				PxRenderOutput out(*renderBuffer);
-				out << gObstacleDebugColor;
+				const PxBoxObstacle& userBoxObstacle = obstacles->mBoxObstacles[i].mData;
+				out << PxTransform(toVec3(userBoxObstacle.mPos), userBoxObstacle.mRot);
+				renderOutputDebugBox(out, PxBounds3(-userBoxObstacle.mHalfExtents, userBoxObstacle.mHalfExtents));
+			}
+
+			for(PxU32 i=0;i<obstacles->mCapsuleObstacles.size();i++)
+			{
+				const PxCapsuleObstacle& userCapsuleObstacle = obstacles->mCapsuleObstacles[i].mData;
 				out.outputCapsule(userCapsuleObstacle.mRadius, userCapsuleObstacle.mHalfHeight, PxTransform(toVec3(userCapsuleObstacle.mPos), userCapsuleObstacle.mRot));
 			}
 		}
@@ -2568,10 +2691,34 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	// Copy results back
 	mPosition = volume.mCenter;
 
+	// PT: in batched moves the kinematic actors are updated by the manager once all controllers have moved, since
+	// setKinematicTarget() writes to the scene.
+	if(context)
+	{
+		context->mBoxUserData.clear();
+		context->mBoxes.clear();
+		context->mCapsuleUserData.clear();
+		context->mCapsules.clear();
+	}
+	else
+	{
+		moveKinematicActor(Backup);
+
+		mManager->resetObstaclesBuffers();
+	}
+
+	if (lockWrite)
+		mWriteLock.unlock();
+
+	return collisionFlags;
+}
+
+void Controller::moveKinematicActor(const PxExtendedVec3& previousPosition)
+{
 	// Update kinematic actor
 	if(mKineActor)
 	{
-		const PxVec3 delta = diff(Backup, volume.mCenter);
+		const PxVec3 delta = diff(previousPosition, mPosition);
 		const PxF32 deltaM2 = delta.magnitudeSquared();
 		if(deltaM2!=0.0f)
 		{
@@ -2581,17 +2728,14 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 			mKineActor->setKinematicTarget(targetPose);
 		}
 	}
-
-	mManager->resetObstaclesBuffers();
-
-	if (lockWrite)
-		mWriteLock.unlock();
-
-	return collisionFlags;
 }
 
-
 PxControllerCollisionFlags BoxController::move(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles)
+{
+	return moveInternal(disp, minDist, elapsedTime, filters, obstacles, NULL);
+}
+
+PxControllerCollisionFlags BoxController::moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, ControllerMoveContext* context)
 {
 	PX_PROFILE_ZONE("CharacterController.move", getContextId());
 
@@ -2602,10 +2746,15 @@ PxControllerCollisionFlags BoxController::move(const PxVec3& disp, PxF32 minDist
 	sweptBox.mCenter		= mPosition;
 	sweptBox.mExtents		= PxVec3(mHalfHeight, mHalfSideExtent, mHalfForwardExtent);
 	sweptBox.mHalfHeight	= mHalfHeight;	// UBI
-	return Controller::move(sweptBox, disp, minDist, elapsedTime, filters, obstacles, false);
+	return Controller::move(sweptBox, disp, minDist, elapsedTime, filters, obstacles, false, context);
 }
 
 PxControllerCollisionFlags CapsuleController::move(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles)
+{
+	return moveInternal(disp, minDist, elapsedTime, filters, obstacles, NULL);
+}
+
+PxControllerCollisionFlags CapsuleController::moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, ControllerMoveContext* context)
 {
 	PX_PROFILE_ZONE("CharacterController.move", getContextId());
 
@@ -2617,6 +2766,6 @@ PxControllerCollisionFlags CapsuleController::move(const PxVec3& disp, PxF32 min
 	sweptCapsule.mRadius		= mRadius;
 	sweptCapsule.mHeight		= mHeight;
 	sweptCapsule.mHalfHeight	= mHeight*0.5f + mRadius;	// UBI
-	return Controller::move(sweptCapsule, disp, minDist, elapsedTime, filters, obstacles, mClimbingMode==PxCapsuleClimbingMode::eCONSTRAINED);
+	return Controller::move(sweptCapsule, disp, minDist, elapsedTime, filters, obstacles, mClimbingMode==PxCapsuleClimbingMode::eCONSTRAINED, context);
 }
 
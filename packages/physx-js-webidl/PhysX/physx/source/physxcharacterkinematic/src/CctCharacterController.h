@@ -46,6 +46,7 @@ struct PxFilterData;
 class PxQueryFilterCallback;
 class PxObstacle;
 class RenderBuffer;
+class PxHeightField;
 
 namespace Cct
 {	    
@@ -54,6 +55,7 @@ namespace Cct
 											CCTParams();
 
 		PxControllerNonWalkableMode::Enum	mNonWalkableMode;
+		PxControllerQuality::Enum			mQuality;
 		PxQuat								mQuatFromUp;
 		PxVec3								mUpDirection;
 		PxF32								mSlopeLimit;
@@ -162,6 +164,7 @@ namespace Cct
 			eSPHERE,
 			eCAPSULE,
 			eCUSTOM,
+			eHEIGHTFIELD,
 
 			eLAST,
 
@@ -227,6 +230,16 @@ namespace Cct
 		PxF32			mRadius;	//!< Capsule's radius
 	};
 
+	// PT: heightfields are swept directly instead of going through the triangle cache
+	struct TouchedHeightField : public TouchedGeom
+	{
+		PxHeightField*	mHeightField;	//!< Heightfield data
+		PxVec3			mScale;			//!< Height, row and column scales
+		PxU32			mFlags;			//!< PxMeshGeometryFlags
+		PxVec3			mPos;			//!< Heightfield's position, relative to the offset
+		PxQuat			mRot;			//!< Heightfield's rotation
+	};
+
 	struct SweptContact
 	{
 		PxExtendedVec3		mWorldPos;		// Contact position in world space
@@ -352,6 +365,7 @@ namespace Cct
 													const PxRigidActor*& touchedActor, const PxShape*& touchedShape, PxU64 contextID);
 
 					void				findTouchedObstacles(const UserObstacles& userObstacles, const PxExtendedBounds3& world_box);
+					bool				getTouchedTriangle(PxTriangle& triangle, const SweptContact& contact)	const;
 
 					void				voidTestCache();
 					void				onRelease(const PxBase& observed);
@@ -375,6 +389,7 @@ namespace Cct
 					PxU32				mNbCachedStatic;
 					PxU32				mNbCachedT;
 	public:
+					PxVec3				mGroundNormal;			// Contact normal of the last hit in the down pass of the last move, or zero
 #ifdef USE_CONTACT_NORMAL_FOR_SLOPE_TEST
 					PxVec3				mContactNormalDownPass;
 #else
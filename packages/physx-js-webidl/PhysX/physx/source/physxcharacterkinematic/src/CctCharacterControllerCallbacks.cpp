@@ -656,6 +656,25 @@ static void outputHeightFieldToStream(	PxShape* hfShape, const PxRigidActor* act
 
 	const PxHeightFieldGeometry& hfGeom = static_cast<const PxHeightFieldGeometry&>(geom);
 
+	// PT: without tessellation or invisible walls the heightfield triangles are used as-is, so we skip the extraction and
+	// let the CCT sweep the heightfield itself. Slope & step tests rebuild the touched triangle from the height samples.
+	if(!params.mTessellation && params.mInvisibleWallHeight==0.0f)
+	{
+		TouchedHeightField* PX_RESTRICT touchedHF = reinterpret_cast<TouchedHeightField*>(reserveContainerMemory(geomStream, sizeof(TouchedHeightField)/sizeof(PxU32)));
+		touchedHF->mType		= TouchedGeomType::eHEIGHTFIELD;
+		touchedHF->mTGUserData	= hfShape;
+		touchedHF->mActor		= actor;
+		touchedHF->mOffset		= origin;
+		touchedHF->mHeightField	= hfGeom.heightField;
+		touchedHF->mScale		= PxVec3(hfGeom.heightScale, hfGeom.rowScale, hfGeom.columnScale);
+		touchedHF->mFlags		= PxU32(PxU8(hfGeom.heightFieldFlags));
+		touchedHF->mPos.x		= float(PxExtended(heightfieldPose.p.x) - origin.x);
+		touchedHF->mPos.y		= float(PxExtended(heightfieldPose.p.y) - origin.y);
+		touchedHF->mPos.z		= float(PxExtended(heightfieldPose.p.z) - origin.z);
+		touchedHF->mRot			= heightfieldPose.q;
+		return;
+	}
+
 	const PxBoxGeometry boxGeom(tmpBounds.getExtents());
 	const PxTransform boxPose(tmpBounds.getCenter());
 
@@ -38,6 +38,8 @@
 #include "PxPhysics.h"
 #include "CmRenderBuffer.h"
 #include "CmRadixSort.h"
+#include "CmParallelFor.h"
+#include "common/PxProfileZone.h"
 
 using namespace physx;
 using namespace Cct;
@@ -55,7 +57,8 @@ CharacterControllerManager::CharacterControllerManager(PxScene& scene, bool lock
 	mOverlapRecovery						(true),
 	mPreciseSweeps							(true),
 	mPreventVerticalSlidingAgainstCeiling	(false),
-	mLockingEnabled							(lockingEnabled)
+	mLockingEnabled							(lockingEnabled),
+	mBatchMoveInProgress					(false)
 {
 	// PT: register ourself as a deletion listener, to be called by the SDK whenever an object is deleted	
 	PxPhysics& physics = scene.getPhysics();
@@ -252,6 +255,10 @@ void CharacterControllerManager::onRelease(const PxBase* observed, void* , PxDel
 	if(type!=PxConcreteType:: eRIGID_DYNAMIC && type!=PxConcreteType:: eRIGID_STATIC && type!=PxConcreteType::eSHAPE && type!=PxConcreteType::eARTICULATION_LINK)
 		return;
 
+	// PT: the tiles reference static shapes & actors directly
+	if(type==PxConcreteType::eRIGID_STATIC || type==PxConcreteType::eSHAPE)
+		mTileCache.flush();
+
 	// check if object was registered
 	if(mLockingEnabled)
 		mWriteLock.lock();
@@ -280,18 +287,20 @@ void CharacterControllerManager::onRelease(const PxBase* observed, void* , PxDel
 
 void CharacterControllerManager::registerObservedObject(const PxBase* obj)
 {	
-	if(mLockingEnabled)
+	const bool lockWrite = mLockingEnabled || mBatchMoveInProgress;
+	if(lockWrite)
 		mWriteLock.lock();
 
 	mObservedRefCountMap[obj].refCount++;	
 
-	if(mLockingEnabled)
+	if(lockWrite)
 		mWriteLock.unlock();
 }
 
 void CharacterControllerManager::unregisterObservedObject(const PxBase* obj)
 {
-	if(mLockingEnabled)
+	const bool lockWrite = mLockingEnabled || mBatchMoveInProgress;
+	if(lockWrite)
 		mWriteLock.lock();
 
 	ObservedRefCounter& refCounter = mObservedRefCountMap[obj];
@@ -300,7 +309,7 @@ void CharacterControllerManager::unregisterObservedObject(const PxBase* obj)
 	if(!refCounter.refCount)
 		mObservedRefCountMap.erase(obj);
 
-	if(mLockingEnabled)
+	if(lockWrite)
 		mWriteLock.unlock();
 }
 
@@ -402,6 +411,13 @@ void CharacterControllerManager::setPreventVerticalSlidingAgainstCeiling(bool fl
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void CharacterControllerManager::setSharedGeometryCache(bool flag, float tileSize)
+{
+	mTileCache.setTileSize(flag, tileSize);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void CharacterControllerManager::shiftOrigin(const PxVec3& shift)
 {
 	for(PxU32 i=0; i < mControllers.size(); i++)
@@ -417,6 +433,8 @@ void CharacterControllerManager::shiftOrigin(const PxVec3& shift)
 	if(mRenderBuffer)
 		mRenderBuffer->shift(-shift);
 
+	mTileCache.flush();
+
 	// assumption is that these are just used for temporary stuff
 	PX_ASSERT(!mBoxes.size());
 	PX_ASSERT(!mCapsules.size());
@@ -626,19 +644,20 @@ static void InteractionCharacterCharacter(Controller* entity0, Controller* entit
 }
 
 // PT: TODO: this is the very old version, revisit with newer one
-static void completeBoxPruning(const PxBounds3* bounds, PxU32 nb, PxArray<PxU32>& pairs)
+static void completeBoxPruning(const PxBounds3* bounds, PxU32 nb, PxArray<PxU32>& pairs, PxArray<float>& posList, Cm::RadixSortBuffered& RS)
 {
+	pairs.clear();
+
 	if(!nb)
 		return;
 
-	pairs.clear();
-
-	float* PosList = PX_ALLOCATE(float, nb, "completeBoxPruning");
+	posList.resizeUninitialized(nb);
+	float* PosList = posList.begin();
 
 	for(PxU32 i=0;i<nb;i++)
 		PosList[i] = bounds[i].minimum.x;
 
-	/*static*/ Cm::RadixSortBuffered RS;	// Static for coherence
+	// PT: the sorter is persistent, for coherence
 	const PxU32* Sorted = RS.Sort(PosList, nb).GetRanks();
 
 	const PxU32* const LastSorted = &Sorted[nb];
@@ -664,8 +683,6 @@ static void completeBoxPruning(const PxBounds3* bounds, PxU32 nb, PxArray<PxU32>
 			}
 		}
 	}
-
-	PX_FREE(PosList);
 }
 
 void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb)
@@ -673,7 +690,8 @@ void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxContro
 	PxU32 nbControllers = mControllers.size();
 	Controller** controllers = mControllers.begin();
 
-	PxBounds3* boxes = PX_ALLOCATE(PxBounds3, nbControllers, "CharacterControllerManager::computeInteractions");	// PT: TODO: get rid of alloc
+	mInteractionBounds.resizeUninitialized(nbControllers);
+	PxBounds3* boxes = mInteractionBounds.begin();
 	PxBounds3* runningBoxes = boxes;
 
 	while(nbControllers--)
@@ -690,8 +708,8 @@ void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxContro
 
 	const PxU32 nbEntities = PxU32(runningBoxes - boxes);
 
-	PxArray<PxU32> pairs;	// PT: TODO: get rid of alloc
-	completeBoxPruning(boxes, nbEntities, pairs);
+	PxArray<PxU32>& pairs = mInteractionPairs;
+	completeBoxPruning(boxes, nbEntities, pairs, mInteractionPosList, mInteractionSort);
 
 	PxU32 nbPairs = pairs.size()>>1;
 	const PxU32* indices = pairs.begin();
@@ -709,7 +727,148 @@ void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxContro
 		if(keep)
 			InteractionCharacterCharacter(ctrl0, ctrl1, elapsedTime);
 	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static PX_FORCE_INLINE Controller* getInternalController(PxController* controller)
+{
+	if(controller->getType()==PxControllerShapeType::eCAPSULE)
+		return static_cast<CapsuleController*>(controller);
+	else if(controller->getType()==PxControllerShapeType::eBOX)
+		return static_cast<BoxController*>(controller);
+	PX_ASSERT(0);
+	return NULL;
+}
+
+namespace
+{
+	class MoveAllCallback : public Cm::ParallelForCallback
+	{
+		public:
+						MoveAllCallback(PxControllerMoveDesc* descs, Controller** controllers, const PxControllerFilters& filters, const PxObstacleContext* obstacles,
+							const PxExtendedBox* controllerBoxes, const PxExtendedCapsule* controllerCapsules) :
+							mDescs				(descs),
+							mControllers		(controllers),
+							mFilters			(filters),
+							mObstacles			(obstacles),
+							mControllerBoxes	(controllerBoxes),
+							mControllerCapsules	(controllerCapsules)
+						{
+						}
+
+		virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+		{
+			ControllerMoveContext context;
+			context.mControllerBoxes	= mControllerBoxes;
+			context.mControllerCapsules	= mControllerCapsules;
+
+			for(PxU32 i=startIndex;i<endIndex;i++)
+			{
+				PxControllerMoveDesc& desc = mDescs[i];
+				desc.collisionFlags = mControllers[i]->moveInternal(desc.disp, desc.minDist, desc.elapsedTime, mFilters, mObstacles, &context);
+			}
+		}
+
+				PxControllerMoveDesc*		mDescs;
+				Controller**				mControllers;
+		const	PxControllerFilters&		mFilters;
+		const	PxObstacleContext*			mObstacles;
+		const	PxExtendedBox*				mControllerBoxes;
+		const	PxExtendedCapsule*			mControllerCapsules;
+
+		PX_NOCOPY(MoveAllCallback)
+	};
+}
+
+void CharacterControllerManager::moveAll(PxControllerMoveDesc* descs, PxU32 nbDescs, const PxControllerFilters& filters, const PxObstacleContext* obstacles, PxCpuDispatcher* dispatcher)
+{
+	PX_PROFILE_ZONE("CharacterControllerManager.moveAll", PxU64(&mScene));
+
+	if(!nbDescs)
+		return;
+
+	if(!descs)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxControllerManager::moveAll(): descs cannot be NULL.");
+		return;
+	}
+
+	mBatchControllers.resizeUninitialized(nbDescs);
+	mBatchPositions.resizeUninitialized(nbDescs);
+	for(PxU32 i=0;i<nbDescs;i++)
+	{
+		Controller* controller = descs[i].controller ? getInternalController(descs[i].controller) : NULL;
+		if(!controller || controller->getCctManager()!=this)
+		{
+			PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxControllerManager::moveAll(): controllers must be non-NULL and owned by this manager.");
+			return;
+		}
+		mBatchControllers[i] = controller;
+		mBatchPositions[i] = controller->mPosition;
+	}
+
+	// PT: snapshot of all controllers before they move. Each controller collides against these, so the results do not
+	// depend on the order in which the controllers are processed.
+	const PxU32 nbControllers = mControllers.size();
+	mBatchBoxes.resizeUninitialized(nbControllers);
+	mBatchCapsules.resizeUninitialized(nbControllers);
+	for(PxU32 i=0;i<nbControllers;i++)
+	{
+		Controller* controller = mControllers[i];
+		if(controller->mType==PxControllerShapeType::eBOX)
+			static_cast<BoxController*>(controller)->getOBB(mBatchBoxes[i]);
+		else if(controller->mType==PxControllerShapeType::eCAPSULE)
+			static_cast<CapsuleController*>(controller)->getCapsule(mBatchCapsules[i]);
+		else PX_ASSERT(0);
+	}
 
-	PX_FREE(boxes);
+	{
+		PX_PROFILE_ZONE("CharacterControllerManager.moveControllers", PxU64(&mScene));
+
+		mBatchMoveInProgress = true;
+
+		MoveAllCallback callback(descs, mBatchControllers.begin(), filters, obstacles, mBatchBoxes.begin(), mBatchCapsules.begin());
+		Cm::parallelFor(dispatcher, nbDescs, 1, callback);
+
+		mBatchMoveInProgress = false;
+	}
+
+	// PT: scene writes are done serially, once all controllers have moved
+	for(PxU32 i=0;i<nbDescs;i++)
+		mBatchControllers[i]->moveKinematicActor(mBatchPositions[i]);
 }
 
+PxU32 CharacterControllerManager::getControllerStates(const PxControllerStateBuffers& buffers, PxU32 bufferSize, PxU32 startIndex) const
+{
+	const PxU32 nbControllers = mControllers.size();
+	if(startIndex>=nbControllers)
+		return 0;
+
+	const PxU32 nbToWrite = PxMin(bufferSize, nbControllers - startIndex);
+	const Controller*const* controllers = mControllers.begin() + startIndex;
+	for(PxU32 i=0;i<nbToWrite;i++)
+	{
+		const Controller* controller = controllers[i];
+		const CCTParams& params = controller->mUserParams;
+
+		if(buffers.positions)
+			buffers.positions[i] = controller->mPosition;
+
+		if(buffers.footPositions)
+		{
+			// PT: same as getFootPosition() for both shape types, without the virtual call
+			PxExtendedVec3 groundPosition = controller->mPosition;
+			sub(groundPosition, params.mUpDirection * (controller->getHalfHeightInternal() + params.mContactOffset));
+			buffers.footPositions[i] = groundPosition;
+		}
+
+		if(buffers.collisionFlags)
+			buffers.collisionFlags[i] = PxU32(controller->mCollisionFlags);
+
+		if(buffers.groundNormals)
+			buffers.groundNormals[i] = controller->mCctModule.mGroundNormal;
+	}
+	return nbToWrite;
+}
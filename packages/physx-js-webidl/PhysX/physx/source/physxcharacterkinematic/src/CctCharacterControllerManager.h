@@ -43,6 +43,8 @@
 #include "foundation/PxMutex.h"
 #include "foundation/PxArray.h"
 #include "foundation/PxUserAllocated.h"
+#include "CmRadixSort.h"
+#include "CctTileCache.h"
 
 namespace physx
 {
@@ -86,10 +88,13 @@ namespace Cct
 		virtual			PxObstacleContext*				getObstacleContext(PxU32 index)	PX_OVERRIDE	PX_FINAL;
 		virtual			PxObstacleContext*				createObstacleContext()	PX_OVERRIDE	PX_FINAL;
 		virtual			void							computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb)	PX_OVERRIDE	PX_FINAL;
+		virtual			void							moveAll(PxControllerMoveDesc* descs, PxU32 nbDescs, const PxControllerFilters& filters, const PxObstacleContext* obstacles, PxCpuDispatcher* dispatcher)	PX_OVERRIDE	PX_FINAL;
+		virtual			PxU32							getControllerStates(const PxControllerStateBuffers& buffers, PxU32 bufferSize, PxU32 startIndex)	const	PX_OVERRIDE	PX_FINAL;
 		virtual			void							setTessellation(bool flag, float maxEdgeLength)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							setOverlapRecoveryModule(bool flag)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							setPreciseSweeps(bool flag)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							setPreventVerticalSlidingAgainstCeiling(bool flag)	PX_OVERRIDE	PX_FINAL;
+		virtual			void							setSharedGeometryCache(bool flag, float tileSize)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							shiftOrigin(const PxVec3& shift)	PX_OVERRIDE	PX_FINAL;
 		//~PxControllerManager
 
@@ -125,6 +130,20 @@ namespace Cct
 
 						PxArray<ObstacleContext*>		mObstacleContexts;
 
+						TileCache						mTileCache;			// Static geometry shared by all controllers
+
+		// Buffers for computeInteractions, kept across frames to avoid per-move allocations
+						PxArray<PxBounds3>				mInteractionBounds;
+						PxArray<float>					mInteractionPosList;
+						PxArray<PxU32>					mInteractionPairs;
+						Cm::RadixSortBuffered			mInteractionSort;
+
+		// Buffers for moveAll
+						PxArray<Controller*>			mBatchControllers;
+						PxArray<PxExtendedVec3>			mBatchPositions;
+						PxArray<PxExtendedBox>			mBatchBoxes;
+						PxArray<PxExtendedCapsule>		mBatchCapsules;
+
 						float							mMaxEdgeLength;
 						bool							mTessellation;
 
@@ -133,6 +152,7 @@ namespace Cct
 						bool							mPreventVerticalSlidingAgainstCeiling;
 
 						bool							mLockingEnabled;						
+						bool							mBatchMoveInProgress;	// Controllers are moved concurrently, observed objects must be locked
 	private:
 						ObservedRefCountMap				mObservedRefCountMap;
 						mutable	PxMutex					mWriteLock;			// Lock used for guarding pointers in observedrefcountmap
@@ -59,6 +59,7 @@ Controller::Controller(const PxControllerDesc& desc, PxScene* s) :
 	mType								= PxControllerShapeType::eFORCE_DWORD;
 
 	mUserParams.mNonWalkableMode		= desc.nonWalkableMode;
+	mUserParams.mQuality				= desc.quality;
 	mUserParams.mSlopeLimit				= desc.slopeLimit;
 	mUserParams.mContactOffset			= desc.contactOffset;
 	mUserParams.mStepOffset				= desc.stepOffset;
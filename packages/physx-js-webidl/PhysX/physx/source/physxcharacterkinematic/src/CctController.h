@@ -49,6 +49,18 @@ namespace Cct
 {
 	class CharacterControllerManager;
 
+	// PT: per-thread data for CharacterControllerManager::moveAll(). Other controllers are read from a snapshot taken before
+	// the batch starts, and obstacles are gathered in local buffers instead of the manager's shared ones.
+	struct ControllerMoveContext
+	{
+		PxArray<const void*>		mBoxUserData;
+		PxArray<PxExtendedBox>		mBoxes;
+		PxArray<const void*>		mCapsuleUserData;
+		PxArray<PxExtendedCapsule>	mCapsules;
+		const PxExtendedBox*		mControllerBoxes;		// Pre-batch box of each controller, indexed like the manager's controllers
+		const PxExtendedCapsule*	mControllerCapsules;	// Pre-batch capsule of each controller, indexed like the manager's controllers
+	};
+
 	class Controller : public PxUserAllocated
 	{
 		PX_NOCOPY(Controller)
@@ -63,11 +75,14 @@ namespace Cct
 		virtual		PxF32							getHalfHeightInternal()				const	= 0;
 		virtual		bool							getWorldBox(PxExtendedBounds3& box)	const	= 0;
 		virtual		PxController*					getPxController()							= 0;
+		virtual		PxControllerCollisionFlags		moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, ControllerMoveContext* context)	= 0;
 
 					void							onOriginShift(const PxVec3& shift);
 
 					void							onRelease(const PxBase& observed);
 
+					void							moveKinematicActor(const PxExtendedVec3& previousPosition);
+
 					void							setCctManager(CharacterControllerManager* cm)
 													{
 														mManager = cm;
@@ -108,7 +123,7 @@ namespace Cct
 					bool							setPos(const PxExtendedVec3& pos);
 					void							findTouchedObject(const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, const PxVec3& upDirection);
 					bool							rideOnTouchedObject(SweptVolume& volume, const PxVec3& upDirection, PxVec3& disp, const PxObstacleContext* obstacleContext);
-					PxControllerCollisionFlags		move(SweptVolume& volume, const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, bool constrainedClimbingMode);
+					PxControllerCollisionFlags		move(SweptVolume& volume, const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, bool constrainedClimbingMode, ControllerMoveContext* context);
 					bool							filterTouchedShape(const PxControllerFilters& filters);
 
 	PX_FORCE_INLINE	float							computeTimeCoeff()
@@ -33,6 +33,7 @@
 
 using namespace physx;
 using namespace Cct;
+using namespace aos;
 
 //! Initial list size
 #define DEFAULT_HANDLEMANAGER_SIZE	2
@@ -202,6 +203,133 @@ static PX_FORCE_INLINE PxU32 decodeIndex(ObstacleHandle handle)
 }
 #endif
 
+void ObstacleTree::updateMapping(PxU32 index, Gu::IncrementalAABBTreeNode* node)
+{
+	// PT: same as BVHCompoundPruner::updateMapping(). If leaves were split or rotated, all their objects moved.
+	if(!mChangedLeaves.empty())
+	{
+		if(node && node->isLeaf())
+		{
+			for(PxU32 j=0; j<node->getNbPrimitives(); j++)
+				mMapping[node->getPrimitives(NULL)[j]] = node;
+		}
+
+		for(PxU32 i=0; i<mChangedLeaves.size(); i++)
+		{
+			Gu::IncrementalAABBTreeNode* changedNode = mChangedLeaves[i];
+			PX_ASSERT(changedNode->isLeaf());
+			for(PxU32 j=0; j<changedNode->getNbPrimitives(); j++)
+				mMapping[changedNode->getPrimitives(NULL)[j]] = changedNode;
+		}
+	}
+	else
+	{
+		mMapping[index] = node;
+	}
+}
+
+void ObstacleTree::add(const PxBounds3& bounds)
+{
+	const PxU32 index = mBounds.size();
+	mBounds.pushBack(bounds);
+	mMapping.pushBack(NULL);
+
+	mChangedLeaves.clear();
+	Gu::IncrementalAABBTreeNode* node = mTree.insert(index, mBounds.begin(), mChangedLeaves);
+	updateMapping(index, node);
+}
+
+void ObstacleTree::update(PxU32 index, const PxBounds3& bounds)
+{
+	PX_ASSERT(index<mBounds.size());
+	mBounds[index] = bounds;
+
+	mChangedLeaves.clear();
+	Gu::IncrementalAABBTreeNode* node = mTree.update(mMapping[index], index, mBounds.begin(), mChangedLeaves);
+	updateMapping(index, node);
+}
+
+void ObstacleTree::removeWithLast(PxU32 index)
+{
+	PX_ASSERT(index<mBounds.size());
+	const PxU32 lastIndex = mBounds.size() - 1;
+
+	Gu::IncrementalAABBTreeNode* node = mTree.remove(mMapping[index], index, mBounds.begin());
+	// PT: if the leaf has been merged into its parent, the remaining objects moved with it
+	if(node && node->isLeaf())
+	{
+		for(PxU32 j=0; j<node->getNbPrimitives(); j++)
+			mMapping[node->getPrimitives(NULL)[j]] = node;
+	}
+
+	// PT: the last object takes the removed object's index, as in the obstacle arrays
+	if(index!=lastIndex)
+	{
+		mMapping[index] = mMapping[lastIndex];
+		mTree.fixupTreeIndices(mMapping[index], lastIndex, index);
+		mBounds[index] = mBounds[lastIndex];
+	}
+	mBounds.popBack();
+	mMapping.popBack();
+}
+
+void ObstacleTree::shiftOrigin(const PxVec3& shift)
+{
+	for(PxU32 i=0; i<mBounds.size(); i++)
+	{
+		mBounds[i].minimum -= shift;
+		mBounds[i].maximum -= shift;
+	}
+	mTree.shiftOrigin(shift);
+}
+
+void ObstacleTree::overlap(const PxBounds3& box, ObstacleIndices& indices) const
+{
+	const Gu::IncrementalAABBTreeNode* root = mTree.getNodes();
+	if(!root)
+		return;
+
+	const Vec3V boxMin = V3LoadU(box.minimum);
+	const Vec3V boxMax = V3LoadU(box.maximum);
+
+	PxInlineArray<const Gu::IncrementalAABBTreeNode*, 64> stack;
+	stack.pushBack(root);
+	while(stack.size())
+	{
+		const Gu::IncrementalAABBTreeNode* node = stack.popBack();
+		if(!V3AllGrtrOrEq(Vec3V_From_Vec4V(node->mBVMax), boxMin) || !V3AllGrtrOrEq(boxMax, Vec3V_From_Vec4V(node->mBVMin)))
+			continue;
+
+		if(node->isLeaf())
+		{
+			const PxU32 nbPrims = node->getNbPrimitives();
+			const PxU32* prims = node->getPrimitives(NULL);
+			for(PxU32 i=0; i<nbPrims; i++)
+			{
+				if(mBounds[prims[i]].intersects(box))
+					indices.pushBack(prims[i]);
+			}
+		}
+		else
+		{
+			stack.pushBack(node->getPos(NULL));
+			stack.pushBack(node->getNeg(NULL));
+		}
+	}
+}
+
+static PxBounds3 computeObstacleBounds(const PxBoxObstacle& obstacle)
+{
+	return PxBounds3::basisExtent(toVec3(obstacle.mPos), PxMat33(obstacle.mRot), obstacle.mHalfExtents);
+}
+
+static PxBounds3 computeObstacleBounds(const PxCapsuleObstacle& obstacle)
+{
+	const PxVec3 axis = obstacle.mRot.getBasisVector0() * obstacle.mHalfHeight;
+	const PxVec3 extents = PxVec3(PxAbs(axis.x), PxAbs(axis.y), PxAbs(axis.z)) + PxVec3(obstacle.mRadius);
+	return PxBounds3::centerExtents(toVec3(obstacle.mPos), extents);
+}
+
 ObstacleContext::ObstacleContext(CharacterControllerManager& cctMan)
 	: mCCTManager(cctMan)
 {
@@ -233,6 +361,7 @@ PxObstacleHandle ObstacleContext::addObstacle(const PxObstacle& obstacle)
 		const PxObstacleHandle handle = encodeHandle(index, type);
 #endif
 		mBoxObstacles.pushBack(InternalBoxObstacle(handle, static_cast<const PxBoxObstacle&>(obstacle)));
+		mBoxTree.add(computeObstacleBounds(static_cast<const PxBoxObstacle&>(obstacle)));
 		mCCTManager.onObstacleAdded(handle, this);
 		return handle;
 	}
@@ -245,6 +374,7 @@ PxObstacleHandle ObstacleContext::addObstacle(const PxObstacle& obstacle)
 		const PxObstacleHandle handle = encodeHandle(index, type);
 #endif
 		mCapsuleObstacles.pushBack(InternalCapsuleObstacle(handle, static_cast<const PxCapsuleObstacle&>(obstacle)));
+		mCapsuleTree.add(computeObstacleBounds(static_cast<const PxCapsuleObstacle&>(obstacle)));
 		mCCTManager.onObstacleAdded(handle, this);
 		return handle;
 	}
@@ -289,6 +419,7 @@ bool ObstacleContext::removeObstacle(PxObstacleHandle handle)
 		remove<InternalBoxObstacle>(mHandleManager, object, handle, index, size, mBoxObstacles);
 #endif
 		mBoxObstacles.replaceWithLast(index);
+		mBoxTree.removeWithLast(index);
 #ifdef NEW_ENCODING
 		mCCTManager.onObstacleRemoved(handle);
 #else
@@ -308,6 +439,7 @@ bool ObstacleContext::removeObstacle(PxObstacleHandle handle)
 #endif
 
 		mCapsuleObstacles.replaceWithLast(index);
+		mCapsuleTree.removeWithLast(index);
 #ifdef NEW_ENCODING
 		mCCTManager.onObstacleRemoved(handle);
 #else
@@ -345,6 +477,7 @@ bool ObstacleContext::updateObstacle(PxObstacleHandle handle, const PxObstacle&
 			return false;
 
 		mBoxObstacles[index].mData = static_cast<const PxBoxObstacle&>(obstacle);
+		mBoxTree.update(index, computeObstacleBounds(mBoxObstacles[index].mData));
 		mCCTManager.onObstacleUpdated(handle,this);
 		return true;
 	}
@@ -356,6 +489,7 @@ bool ObstacleContext::updateObstacle(PxObstacleHandle handle, const PxObstacle&
 			return false;
 
 		mCapsuleObstacles[index].mData = static_cast<const PxCapsuleObstacle&>(obstacle);
+		mCapsuleTree.update(index, computeObstacleBounds(mCapsuleObstacles[index].mData));
 		mCCTManager.onObstacleUpdated(handle,this);
 		return true;
 	}
@@ -425,13 +559,23 @@ const PxObstacle* ObstacleContext::raycastSingle(PxGeomRaycastHit& hit, const Px
 
 	const PxHitFlags hitFlags = PxHitFlags(0);
 
+	// PT: only the obstacles touching the ray's bounds are tested
+	PxBounds3 rayBounds = PxBounds3::empty();
+	rayBounds.include(origin);
+	rayBounds.include(origin + unitDir * distance);
+
+	ObstacleIndices boxIndices;
+	ObstacleIndices capsuleIndices;
+	findObstacles(rayBounds, boxIndices, capsuleIndices);
+
 	{
 		const RaycastFunc raycastFunc = Gu::getRaycastFuncTable()[PxGeometryType::eBOX];
 		PX_ASSERT(raycastFunc);
 
-		const PxU32 nbExtraBoxes = mBoxObstacles.size();
-		for(PxU32 i=0;i<nbExtraBoxes;i++)
+		const PxU32 nbExtraBoxes = boxIndices.size();
+		for(PxU32 j=0;j<nbExtraBoxes;j++)
 		{
+			const PxU32 i = boxIndices[j];
 			const PxBoxObstacle& userBoxObstacle = mBoxObstacles[i].mData;
 
 			PxU32 status = raycastFunc(	PxBoxGeometry(userBoxObstacle.mHalfExtents),
@@ -453,9 +597,10 @@ const PxObstacle* ObstacleContext::raycastSingle(PxGeomRaycastHit& hit, const Px
 		const RaycastFunc raycastFunc = Gu::getRaycastFuncTable()[PxGeometryType::eCAPSULE];
 		PX_ASSERT(raycastFunc);
 
-		const PxU32 nbExtraCapsules = mCapsuleObstacles.size();
-		for(PxU32 i=0;i<nbExtraCapsules;i++)
+		const PxU32 nbExtraCapsules = capsuleIndices.size();
+		for(PxU32 j=0;j<nbExtraCapsules;j++)
 		{
+			const PxU32 i = capsuleIndices[j];
 			const PxCapsuleObstacle& userCapsuleObstacle = mCapsuleObstacles[i].mData;
 
 			PxU32 status = raycastFunc(	PxCapsuleGeometry(userCapsuleObstacle.mRadius, userCapsuleObstacle.mHalfHeight),
@@ -533,4 +678,13 @@ void ObstacleContext::onOriginShift(const PxVec3& shift)
 
 	for(PxU32 i=0; i < mCapsuleObstacles.size(); i++)
 		sub(mCapsuleObstacles[i].mData.mPos, shift);
+
+	mBoxTree.shiftOrigin(shift);
+	mCapsuleTree.shiftOrigin(shift);
+}
+
+void ObstacleContext::findObstacles(const PxBounds3& box, ObstacleIndices& boxIndices, ObstacleIndices& capsuleIndices) const
+{
+	mBoxTree.overlap(box, boxIndices);
+	mCapsuleTree.overlap(box, capsuleIndices);
 }
@@ -35,6 +35,8 @@
 #include "characterkinematic/PxControllerObstacles.h"
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxArray.h"
+#include "foundation/PxInlineArray.h"
+#include "GuIncrementalAABBTree.h"
 
 namespace physx
 {
@@ -79,6 +81,33 @@ namespace Cct
 						bool		SetupLists(void** objects=NULL, PxU16* oti=NULL, PxU16* ito=NULL, PxU16* stamps=NULL);
 	};
 
+	typedef PxInlineArray<PxU32, 64>	ObstacleIndices;
+
+	// PT: incremental AABB tree over the world bounds of one obstacle type. Tree indices are the indices in the matching
+	// obstacle array, so the tree must be told about each add/remove/update in the same order as the array.
+	class ObstacleTree
+	{
+												PX_NOCOPY(ObstacleTree)
+		public:
+												ObstacleTree()	{}
+
+				void							add(const PxBounds3& bounds);
+				void							update(PxU32 index, const PxBounds3& bounds);
+				void							removeWithLast(PxU32 index);	// same semantics as PxArray::replaceWithLast()
+				void							shiftOrigin(const PxVec3& shift);
+
+				// Appends to 'indices' the objects whose bounds overlap 'box'
+				void							overlap(const PxBounds3& box, ObstacleIndices& indices)	const;
+
+		private:
+				void							updateMapping(PxU32 index, Gu::IncrementalAABBTreeNode* node);
+
+				Gu::IncrementalAABBTree				mTree;
+				PxArray<PxBounds3>					mBounds;
+				PxArray<Gu::IncrementalAABBTreeNode*>	mMapping;
+				Gu::NodeList						mChangedLeaves;
+	};
+
 	class ObstacleContext : public PxObstacleContext, public PxUserAllocated
 	{
 												PX_NOCOPY(ObstacleContext)
@@ -102,6 +131,9 @@ namespace Cct
 
 				void							onOriginShift(const PxVec3& shift);
 
+				// Returns the indices of the box/capsule obstacles whose bounds overlap 'box'
+				void							findObstacles(const PxBounds3& box, ObstacleIndices& boxIndices, ObstacleIndices& capsuleIndices)	const;
+
 				struct InternalBoxObstacle
 				{
 					InternalBoxObstacle(PxObstacleHandle handle, const PxBoxObstacle& data) : mHandle(handle), mData(data)	{}
@@ -121,6 +153,9 @@ namespace Cct
 				PxArray<InternalCapsuleObstacle>	mCapsuleObstacles;
 
 	private:
+				ObstacleTree					mBoxTree;
+				ObstacleTree					mCapsuleTree;
+
 				HandleManager					mHandleManager;
 				CharacterControllerManager&		mCCTManager;
 	};
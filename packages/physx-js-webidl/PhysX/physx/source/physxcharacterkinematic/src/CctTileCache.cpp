@@ -0,0 +1,369 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "common/PxProfileZone.h"
+#include "CctTileCache.h"
+#include "CctInternalStructs.h"
+#include "CmUtils.h"
+
+using namespace physx;
+using namespace Cct;
+using namespace Cm;
+
+static const PxU32 gMaxNbTiles		= 4096;	// PT: the whole cache is flushed when this limit is reached
+static const PxU32 gMaxNbConfigs	= 32;	// PT: controllers with more distinct settings than this do not use the cache
+
+namespace physx
+{
+namespace Cct
+{
+	struct Tile : public PxUserAllocated
+	{
+		PxExtendedVec3	mOrigin;	// TouchedGeom::mOffset of all the geoms in the tile
+		TriArray		mWorldTriangles;
+		IntArray		mTriangleIndices;
+		IntArray		mGeomStream;
+	};
+}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static PX_FORCE_INLINE PxI32 getCell(PxExtended coord, PxExtended tileSize)
+{
+	const PxExtended f = coord / tileSize;
+	PxI32 cell = PxI32(f);
+	if(PxExtended(cell) > f)
+		cell--;
+	return cell;
+}
+
+// PT: tiles overlap their neighbors by half a tile on each side, so that any bounds smaller than half a tile fit in the
+// tile of their center.
+static PX_FORCE_INLINE void getTileBounds(PxExtendedBounds3& bounds, const TileKey& key, PxExtended tileSize)
+{
+	const PxExtended margin = tileSize * 0.5;
+	bounds.set(	PxExtended(key.mX)*tileSize - margin, PxExtended(key.mY)*tileSize - margin, PxExtended(key.mZ)*tileSize - margin,
+				PxExtended(key.mX+1)*tileSize + margin, PxExtended(key.mY+1)*tileSize + margin, PxExtended(key.mZ+1)*tileSize + margin);
+}
+
+static PX_FORCE_INLINE PxU32 getTouchedGeomSize(TouchedGeomType::Enum type)
+{
+	switch(type)
+	{
+		case TouchedGeomType::eUSER_BOX:		return sizeof(TouchedUserBox);
+		case TouchedGeomType::eUSER_CAPSULE:	return sizeof(TouchedUserCapsule);
+		case TouchedGeomType::eMESH:			return sizeof(TouchedMesh);
+		case TouchedGeomType::eBOX:				return sizeof(TouchedBox);
+		case TouchedGeomType::eSPHERE:			return sizeof(TouchedSphere);
+		case TouchedGeomType::eCAPSULE:			return sizeof(TouchedCapsule);
+		case TouchedGeomType::eCUSTOM:			return sizeof(TouchedCustom);
+		case TouchedGeomType::eHEIGHTFIELD:		return sizeof(TouchedHeightField);
+		default:								PX_ASSERT(0);
+	}
+	return 0;
+}
+
+template<class T>
+static PX_FORCE_INLINE T* copyToStream(IntArray& geomStream, const T* src, const PxExtendedVec3& origin)
+{
+	T* dst = reinterpret_cast<T*>(reserveContainerMemory(geomStream, sizeof(T)/sizeof(PxU32)));
+	PxMemCopy(dst, src, sizeof(T));
+	dst->mOffset = origin;
+	return dst;
+}
+
+// PT: copies the tile's geoms touching 'localBounds' to the output arrays, moving them from the tile's origin to the new one
+static void copyTile(const Tile& tile, const PxExtendedVec3& origin, const PxBounds3& localBounds, TriArray& worldTriangles, IntArray& triIndicesArray, IntArray& geomStream)
+{
+	const PxVec3 shift = diff(tile.mOrigin, origin);
+
+	const PxU32* data = tile.mGeomStream.begin();
+	const PxU32* last = tile.mGeomStream.end();
+	while(data!=last)
+	{
+		const TouchedGeom* currentGeom = reinterpret_cast<const TouchedGeom*>(data);
+		switch(currentGeom->mType)
+		{
+			case TouchedGeomType::eMESH:
+			{
+				const TouchedMesh* src = static_cast<const TouchedMesh*>(currentGeom);
+				const PxU32 firstTri = worldTriangles.size();
+
+				const PxTriangle* tris = &tile.mWorldTriangles.getTriangle(src->mIndexWorldTriangles);
+				const PxU32* triIndices = &tile.mTriangleIndices[src->mIndexWorldTriangles];
+				for(PxU32 i=0;i<src->mNbTris;i++)
+				{
+					const PxVec3 p0 = tris[i].verts[0] + shift;
+					const PxVec3 p1 = tris[i].verts[1] + shift;
+					const PxVec3 p2 = tris[i].verts[2] + shift;
+					const PxBounds3 triBounds(p0.minimum(p1.minimum(p2)), p0.maximum(p1.maximum(p2)));
+					if(!triBounds.intersects(localBounds))
+						continue;
+
+					PxTriangle* dst = worldTriangles.reserve(1);
+					dst->verts[0] = p0;
+					dst->verts[1] = p1;
+					dst->verts[2] = p2;
+					triIndicesArray.pushBack(triIndices[i]);
+				}
+
+				const PxU32 nbTris = worldTriangles.size() - firstTri;
+				if(nbTris)
+				{
+					TouchedMesh* dst = copyToStream(geomStream, src, origin);
+					dst->mNbTris				= nbTris;
+					dst->mIndexWorldTriangles	= firstTri;
+				}
+			}
+			break;
+
+			case TouchedGeomType::eBOX:
+			{
+				const TouchedBox* src = static_cast<const TouchedBox*>(currentGeom);
+				const PxVec3 center = src->mCenter + shift;
+				const PxVec3 extents(src->mExtents.magnitude());
+				if(PxBounds3(center - extents, center + extents).intersects(localBounds))
+					copyToStream(geomStream, src, origin)->mCenter = center;
+			}
+			break;
+
+			case TouchedGeomType::eSPHERE:
+			{
+				const TouchedSphere* src = static_cast<const TouchedSphere*>(currentGeom);
+				const PxVec3 center = src->mCenter + shift;
+				const PxVec3 extents(src->mRadius);
+				if(PxBounds3(center - extents, center + extents).intersects(localBounds))
+					copyToStream(geomStream, src, origin)->mCenter = center;
+			}
+			break;
+
+			case TouchedGeomType::eCAPSULE:
+			{
+				const TouchedCapsule* src = static_cast<const TouchedCapsule*>(currentGeom);
+				const PxVec3 p0 = src->mP0 + shift;
+				const PxVec3 p1 = src->mP1 + shift;
+				const PxVec3 extents(src->mRadius);
+				if(PxBounds3(p0.minimum(p1) - extents, p0.maximum(p1) + extents).intersects(localBounds))
+				{
+					TouchedCapsule* dst = copyToStream(geomStream, src, origin);
+					dst->mP0 = p0;
+					dst->mP1 = p1;
+				}
+			}
+			break;
+
+			case TouchedGeomType::eCUSTOM:
+			{
+				// PT: no bounds available here, custom geoms are always kept
+				const TouchedCustom* src = static_cast<const TouchedCustom*>(currentGeom);
+				copyToStream(geomStream, src, origin)->mCenter = src->mCenter + shift;
+			}
+			break;
+
+			case TouchedGeomType::eHEIGHTFIELD:
+			{
+				// PT: the heightfield is swept as a whole, it is kept as long as the scene query returned it for the tile
+				const TouchedHeightField* src = static_cast<const TouchedHeightField*>(currentGeom);
+				copyToStream(geomStream, src, origin)->mPos = src->mPos + shift;
+			}
+			break;
+
+			default:
+				PX_ASSERT(0);	// PT: user obstacles are never part of the static geometry
+				break;
+		}
+
+		const PxU8* ptr = reinterpret_cast<const PxU8*>(data);
+		ptr += getTouchedGeomSize(currentGeom->mType);
+		data = reinterpret_cast<const PxU32*>(ptr);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TileCache::TileCache() :
+	mTileSize	(0.0f),
+	mTimestamp	(0),
+	mEnabled	(false)
+{
+}
+
+TileCache::~TileCache()
+{
+	flush();
+}
+
+void TileCache::setTileSize(bool enabled, PxF32 tileSize)
+{
+	PxMutex::ScopedLock lock(mMutex);
+
+	mEnabled = enabled && tileSize>0.0f;
+	if(mTileSize!=tileSize || !mEnabled)
+	{
+		mTileSize = tileSize;
+
+		releaseTiles();
+		mConfigs.clear();
+	}
+}
+
+void TileCache::flush()
+{
+	PxMutex::ScopedLock lock(mMutex);
+
+	releaseTiles();
+	mConfigs.clear();
+}
+
+void TileCache::releaseTiles()
+{
+	for(PxHashMap<TileKey, Tile*, TileKeyHash>::Iterator iter = mTiles.getIterator(); !iter.done(); ++iter)
+		PX_DELETE(iter->second);
+	mTiles.clear();
+}
+
+PxU32 TileCache::getConfigIndex(const CCTFilter& filter, const CCTParams& params)
+{
+	TileConfig config;
+	config.mFilterData			= filter.mFilterData ? *filter.mFilterData : PxFilterData();
+	config.mFilterCallback		= filter.mFilterCallback;
+	config.mUpDirection			= params.mUpDirection;
+	config.mSlopeLimit			= params.mSlopeLimit;
+	config.mInvisibleWallHeight	= params.mInvisibleWallHeight;
+	config.mMaxEdgeLength2		= params.mMaxEdgeLength2;
+	config.mTessellation		= params.mTessellation;
+	config.mPreFilter			= filter.mPreFilter;
+	config.mPostFilter			= filter.mPostFilter;
+
+	const PxU32 nbConfigs = mConfigs.size();
+	for(PxU32 i=0;i<nbConfigs;i++)
+	{
+		const TileConfig& current = mConfigs[i];
+		if(		current.mFilterData==config.mFilterData
+			&&	current.mFilterCallback==config.mFilterCallback
+			&&	current.mUpDirection==config.mUpDirection
+			&&	current.mSlopeLimit==config.mSlopeLimit
+			&&	current.mInvisibleWallHeight==config.mInvisibleWallHeight
+			&&	current.mMaxEdgeLength2==config.mMaxEdgeLength2
+			&&	current.mTessellation==config.mTessellation
+			&&	current.mPreFilter==config.mPreFilter
+			&&	current.mPostFilter==config.mPostFilter)
+			return i;
+	}
+
+	if(nbConfigs==gMaxNbConfigs)
+		return PX_INVALID_U32;
+
+	mConfigs.pushBack(config);
+	return nbConfigs;
+}
+
+Tile* TileCache::buildTile(const InternalCBData_FindTouchedGeom* userData, const TileKey& key, const CCTFilter& filter, const CCTParams& params)
+{
+	PX_ASSERT(userData);
+	const PxInternalCBData_FindTouchedGeom* internalData = static_cast<const PxInternalCBData_FindTouchedGeom*>(userData);
+
+	PX_PROFILE_ZONE("CharacterController.buildTile", PxU64(internalData->scene));
+
+	PxExtendedBounds3 tileBounds;
+	getTileBounds(tileBounds, key, PxExtended(mTileSize));
+
+	Tile* tile = PX_NEW(Tile);
+	getCenter(tileBounds, tile->mOrigin);
+
+	// PT: no debug rendering, the tile is not specific to one controller
+	PxInternalCBData_FindTouchedGeom tileData = *internalData;
+	tileData.renderBuffer = NULL;
+
+	CCTFilter staticFilter = filter;
+	staticFilter.mStaticShapes	= true;
+	staticFilter.mDynamicShapes	= false;
+
+	PxU16 nbTessellation = 0;
+	findTouchedGeometry(&tileData, tileBounds, tile->mWorldTriangles, tile->mTriangleIndices, tile->mGeomStream, staticFilter, params, nbTessellation);
+	return tile;
+}
+
+bool TileCache::fetchStaticGeometry(const InternalCBData_FindTouchedGeom* userData, const PxExtendedBounds3& worldBounds,
+									const CCTFilter& filter, const CCTParams& params,
+									TriArray& worldTriangles, IntArray& triIndicesArray, IntArray& geomStream)
+{
+	if(!mEnabled || !filter.mStaticShapes)
+		return false;
+
+	PxMutex::ScopedLock lock(mMutex);
+
+	const PxExtended tileSize = PxExtended(mTileSize);
+
+	PxExtendedVec3 origin;
+	getCenter(worldBounds, origin);
+
+	TileKey key;
+	key.mX = getCell(origin.x, tileSize);
+	key.mY = getCell(origin.y, tileSize);
+	key.mZ = getCell(origin.z, tileSize);
+
+	// PT: the bounds must be covered by the tile, including its margin
+	{
+		PxExtendedBounds3 tileBounds;
+		getTileBounds(tileBounds, key, tileSize);
+		if(!worldBounds.isInside(tileBounds))
+			return false;
+	}
+
+	// PT: tiles are only valid for a given version of the static pruning structure
+	const PxU32 timestamp = getSceneTimestamp(userData);
+	if(timestamp!=mTimestamp)
+	{
+		releaseTiles();
+		mTimestamp = timestamp;
+	}
+
+	key.mConfig = getConfigIndex(filter, params);
+	if(key.mConfig==PX_INVALID_U32)
+		return false;
+
+	Tile* tile;
+	const PxHashMap<TileKey, Tile*, TileKeyHash>::Entry* entry = mTiles.find(key);
+	if(entry)
+	{
+		tile = entry->second;
+	}
+	else
+	{
+		if(mTiles.size()>=gMaxNbTiles)
+			releaseTiles();
+
+		tile = buildTile(userData, key, filter, params);
+		mTiles.insert(key, tile);
+	}
+
+	// PT: the copy is done under the lock, since another thread could flush the cache in the meantime
+	const PxBounds3 localBounds(diff(worldBounds.minimum, origin), diff(worldBounds.maximum, origin));
+	copyTile(*tile, origin, localBounds, worldTriangles, triIndicesArray, geomStream);
+	return true;
+}
@@ -0,0 +1,122 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef CCT_TILE_CACHE
+#define CCT_TILE_CACHE
+
+/* Exclude from documentation */
+/** \cond */
+
+#include "foundation/PxHashMap.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMutex.h"
+#include "PxQueryFiltering.h"
+#include "CctUtils.h"
+
+namespace physx
+{
+namespace Cct
+{
+	class TriArray;
+	class CCTFilter;
+	struct CCTParams;
+	struct InternalCBData_FindTouchedGeom;
+
+	// PT: the settings that change the output of findTouchedGeometry() for static shapes. Controllers with different
+	// settings cannot share the same tiles.
+	struct TileConfig
+	{
+		PxFilterData			mFilterData;
+		PxQueryFilterCallback*	mFilterCallback;
+		PxVec3					mUpDirection;
+		PxF32					mSlopeLimit;
+		PxF32					mInvisibleWallHeight;
+		PxF32					mMaxEdgeLength2;
+		bool					mTessellation;
+		bool					mPreFilter;
+		bool					mPostFilter;
+	};
+
+	struct TileKey
+	{
+		PxI32	mX, mY, mZ;
+		PxU32	mConfig;
+	};
+
+	struct TileKeyHash
+	{
+		PX_FORCE_INLINE	PxU32	operator()(const TileKey& key)	const
+		{
+			// PT: large primes, as in the usual spatial hash
+			return PxU32(key.mX)*73856093u ^ PxU32(key.mY)*19349663u ^ PxU32(key.mZ)*83492791u ^ key.mConfig*2654435761u;
+		}
+
+		PX_FORCE_INLINE	bool	equal(const TileKey& key0, const TileKey& key1)	const
+		{
+			return key0.mX==key1.mX && key0.mY==key1.mY && key0.mZ==key1.mZ && key0.mConfig==key1.mConfig;
+		}
+	};
+
+	struct Tile;
+
+	// PT: static geometry gathered by world-space tiles, shared by all the controllers of a manager. A controller whose cached
+	// bounds fit in a tile copies the tile's triangles and shapes instead of running its own scene query. Tiles are built on
+	// demand and discarded when the static pruning structure changes. Thread-safe, so that it can be used from moveAll().
+	class TileCache
+	{
+											PX_NOCOPY(TileCache)
+		public:
+											TileCache();
+											~TileCache();
+
+						void				setTileSize(bool enabled, PxF32 tileSize);
+						void				flush();
+
+		// PT: appends the static geometry touching 'worldBounds' to the arrays, with TouchedGeom::mOffset set to the center of
+		// 'worldBounds' like findTouchedGeometry() does. Returns false when the cache cannot be used, in which case nothing is
+		// written and the caller should query the scene itself.
+						bool				fetchStaticGeometry(const InternalCBData_FindTouchedGeom* userData, const PxExtendedBounds3& worldBounds,
+																const CCTFilter& filter, const CCTParams& params,
+																TriArray& worldTriangles, PxArray<PxU32>& triIndicesArray, PxArray<PxU32>& geomStream);
+		private:
+						void				releaseTiles();
+						PxU32				getConfigIndex(const CCTFilter& filter, const CCTParams& params);
+						Tile*				buildTile(const InternalCBData_FindTouchedGeom* userData, const TileKey& key, const CCTFilter& filter, const CCTParams& params);
+
+						PxHashMap<TileKey, Tile*, TileKeyHash>	mTiles;
+						PxArray<TileConfig>	mConfigs;
+						PxMutex				mMutex;
+						PxF32				mTileSize;
+						PxU32				mTimestamp;
+						bool				mEnabled;
+	};
+
+} // namespace Cct
+
+}
+
+/** \endcond */
+#endif
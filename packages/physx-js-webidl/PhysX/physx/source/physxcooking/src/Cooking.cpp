@@ -44,6 +44,21 @@ physx::PxTriangleMesh* PxCreateTriangleMeshInternal(const physx::PxTriangleMeshI
 	return np;
 }
 
+bool PxSaveTriangleMeshInPlace(const PxTriangleMesh& mesh, PxOutputStream& stream)
+{
+	if(mesh.getConcreteType()!=PxConcreteType::eTRIANGLE_MESH_BVH34)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxSaveTriangleMeshInPlace: only BVH34 meshes are supported.");
+		return false;
+	}
+	return static_cast<const BV4TriangleMesh&>(mesh).saveInPlace(stream);
+}
+
+PxTriangleMesh* PxCreateTriangleMeshInPlace(void* data, PxU32 size)
+{
+	return BV4TriangleMesh::createInPlace(data, size);
+}
+
 physx::PxBVH* PxCreateBVHInternal(const physx::PxBVHInternalData& data)
 {
 	BVH* np;
@@ -78,6 +93,16 @@ PxHeightField* PxCreateHeightField(const PxHeightFieldDesc& desc, PxInsertionCal
 	return immediateCooking::createHeightField(desc, insertionCallback);
 }
 
+bool PxCookHeightFieldFromRaster(const PxHeightFieldRasterDesc& desc, PxOutputStream& stream)
+{
+	return immediateCooking::cookHeightFieldFromRaster(desc, stream);
+}
+
+PxHeightField* PxCreateHeightFieldFromRaster(const PxHeightFieldRasterDesc& desc, PxInsertionCallback& insertionCallback)
+{
+	return immediateCooking::createHeightFieldFromRaster(desc, insertionCallback);
+}
+
 bool PxCookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition)
 {
 	return immediateCooking::cookConvexMesh(params, desc, stream, condition);
@@ -88,6 +113,16 @@ PxConvexMesh* PxCreateConvexMesh(const PxCookingParams& params, const PxConvexMe
 	return immediateCooking::createConvexMesh(params, desc, insertionCallback, condition);
 }
 
+PxU32 PxCreateConvexMeshes(const PxCookingParams& params, const PxConvexMeshDesc* descs, PxU32 nbDescs, PxConvexMesh** meshes, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* conditions)
+{
+	return immediateCooking::createConvexMeshes(params, descs, nbDescs, meshes, insertionCallback, conditions);
+}
+
+PxU32 PxCreateConvexDecomposition(const PxCookingParams& params, const PxSimpleTriangleMesh& mesh, const PxConvexDecompositionParams& decompositionParams, PxConvexMesh** hulls, PxInsertionCallback& insertionCallback)
+{
+	return immediateCooking::createConvexDecomposition(params, mesh, decompositionParams, hulls, insertionCallback);
+}
+
 bool PxValidateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc)
 {
 	return immediateCooking::validateConvexMesh(params, desc);
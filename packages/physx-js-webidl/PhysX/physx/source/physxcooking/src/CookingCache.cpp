@@ -0,0 +1,444 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "cooking/PxCookingCache.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxMemory.h"
+#include "geometry/PxConvexMesh.h"
+#include "PxPhysics.h"
+
+using namespace physx;
+
+namespace
+{
+	// PT: 64-bit FNV-1a
+	class ContentHash
+	{
+	public:
+		PX_FORCE_INLINE	ContentHash() : mHash(14695981039346656037ull)	{}
+
+		PX_FORCE_INLINE	void	add(const void* data, PxU32 size)
+		{
+			const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+			PxU64 h = mHash;
+			for(PxU32 i=0; i<size; i++)
+			{
+				h ^= bytes[i];
+				h *= 1099511628211ull;
+			}
+			mHash = h;
+		}
+
+		template<class T>
+		PX_FORCE_INLINE	void	add(const T& value)	{ add(&value, sizeof(T));	}
+
+		// PT: strided data is hashed element by element, so that the stride itself doesn't change the key
+		PX_FORCE_INLINE	void	addStrided(const void* data, PxU32 count, PxU32 stride, PxU32 elementSize)
+		{
+			add(count);
+			if(!data)
+				return;
+			const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+			if(stride == elementSize)
+				add(bytes, count * elementSize);
+			else
+			{
+				for(PxU32 i=0; i<count; i++)
+					add(bytes + i * stride, elementSize);
+			}
+		}
+
+		PxU64	mHash;
+	};
+
+	void hashParams(ContentHash& hash, const PxCookingParams& params)
+	{
+		// PT: hashed field by field to skip padding bytes
+		hash.add(params.areaTestEpsilon);
+		hash.add(params.planeTolerance);
+		hash.add(PxU32(params.convexMeshCookingType));
+		hash.add(params.suppressTriangleMeshRemapTable);
+		hash.add(params.buildTriangleAdjacencies);
+		hash.add(params.buildGPUData);
+		hash.add(params.scale.length);
+		hash.add(params.scale.speed);
+		hash.add(PxU32(params.meshPreprocessParams));
+		hash.add(params.meshWeldTolerance);
+		hash.add(params.meshAreaMinLimit);
+		hash.add(params.meshEdgeLengthMaxLimit);
+		hash.add(params.gaussMapLimit);
+		hash.add(params.maxWeightRatioInTet);
+		hash.add(PxU32(params.meshCookingQuality));
+
+		const PxMeshMidPhase::Enum midphase = params.midphaseDesc.getType();
+		hash.add(PxU32(midphase));
+		if(midphase == PxMeshMidPhase::eBVH33)
+		{
+			hash.add(params.midphaseDesc.mBVH33Desc.meshSizePerformanceTradeOff);
+			hash.add(PxU32(params.midphaseDesc.mBVH33Desc.meshCookingHint));
+		}
+		else
+		{
+			hash.add(params.midphaseDesc.mBVH34Desc.numPrimsPerLeaf);
+			hash.add(PxU32(params.midphaseDesc.mBVH34Desc.buildStrategy));
+			hash.add(params.midphaseDesc.mBVH34Desc.quantized);
+		}
+	}
+
+	PxU64 computeKey(const PxCookingParams& params, const PxTriangleMeshDesc& desc)
+	{
+		ContentHash hash;
+		hash.add(PxU32(PxConcreteType::eTRIANGLE_MESH_BVH34));
+		hashParams(hash, params);
+		hash.add(PxU32(desc.flags));
+		hash.addStrided(desc.points.data, desc.points.count, desc.points.stride, sizeof(PxVec3));
+		const PxU32 indexSize = desc.flags & PxMeshFlag::e16_BIT_INDICES ? sizeof(PxU16) : sizeof(PxU32);
+		hash.addStrided(desc.triangles.data, desc.triangles.count, desc.triangles.stride, indexSize * 3);
+		hash.addStrided(desc.materialIndices.data, desc.materialIndices.data ? desc.triangles.count : 0, desc.materialIndices.stride, sizeof(PxMaterialTableIndex));
+		return hash.mHash;
+	}
+
+	PxU64 computeKey(const PxCookingParams& params, const PxConvexMeshDesc& desc)
+	{
+		ContentHash hash;
+		hash.add(PxU32(PxConcreteType::eCONVEX_MESH));
+		hashParams(hash, params);
+		hash.add(PxU32(desc.flags));
+		hash.add(desc.vertexLimit);
+		hash.add(desc.polygonLimit);
+		hash.add(desc.quantizedCount);
+		hash.addStrided(desc.points.data, desc.points.count, desc.points.stride, sizeof(PxVec3));
+		hash.addStrided(desc.polygons.data, desc.polygons.count, desc.polygons.stride, sizeof(PxHullPolygon));
+		// PT: the number of indices is implied by the polygons
+		PxU32 nbIndices = 0;
+		if(desc.polygons.data)
+		{
+			for(PxU32 i=0; i<desc.polygons.count; i++)
+				nbIndices += reinterpret_cast<const PxHullPolygon*>(reinterpret_cast<const PxU8*>(desc.polygons.data) + i * desc.polygons.stride)->mNbVerts;
+		}
+		const PxU32 indexSize = desc.flags & PxConvexFlag::e16_BIT_INDICES ? sizeof(PxU16) : sizeof(PxU32);
+		hash.addStrided(desc.indices.data, nbIndices, desc.indices.stride, indexSize);
+		return hash.mHash;
+	}
+
+	class MemoryOutputStream : public PxOutputStream
+	{
+	public:
+						MemoryOutputStream(PxArray<PxU8>& data) : mData(data)	{}
+
+		virtual	PxU32	write(const void* src, PxU32 count)	PX_OVERRIDE
+		{
+			const PxU32 size = mData.size();
+			mData.resizeUninitialized(size + count);
+			PxMemCopy(mData.begin() + size, src, count);
+			return count;
+		}
+
+		PxArray<PxU8>&	mData;
+
+		PX_NOCOPY(MemoryOutputStream)
+	};
+
+	class MemoryInputData : public PxInputData
+	{
+	public:
+						MemoryInputData(const PxArray<PxU8>& data) : mData(data.begin()), mSize(data.size()), mPos(0)	{}
+
+		virtual	PxU32	read(void* dest, PxU32 count)	PX_OVERRIDE
+		{
+			const PxU32 length = PxMin(count, mSize - mPos);
+			PxMemCopy(dest, mData + mPos, length);
+			mPos += length;
+			return length;
+		}
+
+		virtual	PxU32	getLength()	const			PX_OVERRIDE	{ return mSize;								}
+		virtual	void	seek(PxU32 pos)				PX_OVERRIDE	{ mPos = PxMin(mSize, pos);					}
+		virtual	PxU32	tell()		const			PX_OVERRIDE	{ return mPos;								}
+
+		const PxU8*		mData;
+		const PxU32		mSize;
+		PxU32			mPos;
+	};
+
+	struct CacheEntry : public PxUserAllocated
+	{
+						CacheEntry() : mObject(NULL)	{}
+
+		PxRefCounted*	mObject;	// PT: NULL after releaseUnusedObjects()
+		PxArray<PxU8>	mStream;
+	};
+
+	class CookingCache : public PxCookingCache, public PxUserAllocated
+	{
+	public:
+								CookingCache(PxPhysics& physics, PxCookingCacheStorage* storage) : mPhysics(physics), mStorage(storage)	{}
+		virtual					~CookingCache()	{ clear();	}
+
+		// PxCookingCache
+		virtual	PxTriangleMesh*	createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxTriangleMeshCookingResult::Enum* condition)	PX_OVERRIDE;
+		virtual	PxConvexMesh*	createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxConvexMeshCookingResult::Enum* condition)			PX_OVERRIDE;
+		virtual	PxU32			getNbEntries()	const	PX_OVERRIDE;
+		virtual	PxU32			releaseUnusedObjects()	PX_OVERRIDE;
+		virtual	void			clear()	PX_OVERRIDE;
+		virtual	void			release()	PX_OVERRIDE	{ PX_DELETE_THIS;	}
+		//~PxCookingCache
+
+		template<class MeshT>
+				MeshT*			findObject(PxU64 key, PxArray<PxU8>& stream);
+		template<class MeshT>
+				MeshT*			addObject(PxU64 key, MeshT* object, const PxArray<PxU8>& stream, bool cooked);
+				bool			cookAndStore(PxU64 key, const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxArray<PxU8>& stream, PxTriangleMeshCookingResult::Enum* condition);
+				bool			cookAndStore(PxU64 key, const PxCookingParams& params, const PxConvexMeshDesc& desc, PxArray<PxU8>& stream, PxConvexMeshCookingResult::Enum* condition);
+
+				PxPhysics&							mPhysics;
+				PxCookingCacheStorage*				mStorage;
+		mutable	PxMutex								mMutex;
+				PxHashMap<PxU64, CacheEntry*>		mEntries;
+
+		PX_NOCOPY(CookingCache)
+	};
+
+	PX_FORCE_INLINE PxRefCounted* createObject(PxPhysics& physics, PxTriangleMesh*, MemoryInputData& data)	{ return physics.createTriangleMesh(data);	}
+	PX_FORCE_INLINE PxRefCounted* createObject(PxPhysics& physics, PxConvexMesh*, MemoryInputData& data)	{ return physics.createConvexMesh(data);	}
+}
+
+// PT: returns the live object for the key with a new reference, or fills 'stream' with the cooked data if it is still known
+template<class MeshT>
+MeshT* CookingCache::findObject(PxU64 key, PxArray<PxU8>& stream)
+{
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		const PxHashMap<PxU64, CacheEntry*>::Entry* e = mEntries.find(key);
+		if(e)
+		{
+			CacheEntry* entry = e->second;
+			if(entry->mObject)
+			{
+				entry->mObject->acquireReference();
+				return static_cast<MeshT*>(entry->mObject);
+			}
+			stream = entry->mStream;
+		}
+	}
+
+	if(stream.empty() && mStorage)
+	{
+		MemoryOutputStream output(stream);
+		if(!mStorage->load(key, output))
+			stream.clear();
+	}
+	return NULL;
+}
+
+template<class MeshT>
+MeshT* CookingCache::addObject(PxU64 key, MeshT* object, const PxArray<PxU8>& stream, bool cooked)
+{
+	PxMutex::ScopedLock lock(mMutex);
+
+	CacheEntry*& entry = mEntries[key];
+	if(!entry)
+		entry = PX_NEW(CacheEntry);
+
+	if(entry->mObject)
+	{
+		// PT: another thread created the same object in the meantime, keep the first one
+		object->release();
+		entry->mObject->acquireReference();
+		return static_cast<MeshT*>(entry->mObject);
+	}
+
+	// PT: freshly cooked data replaces whatever we had, in case the previous stream was corrupt
+	if(cooked || entry->mStream.empty())
+		entry->mStream = stream;
+
+	// PT: the cache keeps its own reference, the caller gets the creation reference
+	object->acquireReference();
+	entry->mObject = object;
+	return object;
+}
+
+bool CookingCache::cookAndStore(PxU64 key, const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxArray<PxU8>& stream, PxTriangleMeshCookingResult::Enum* condition)
+{
+	MemoryOutputStream output(stream);
+	if(!PxCookTriangleMesh(params, desc, output, condition))
+		return false;
+	if(mStorage)
+		mStorage->store(key, stream.begin(), stream.size());
+	return true;
+}
+
+bool CookingCache::cookAndStore(PxU64 key, const PxCookingParams& params, const PxConvexMeshDesc& desc, PxArray<PxU8>& stream, PxConvexMeshCookingResult::Enum* condition)
+{
+	MemoryOutputStream output(stream);
+	if(!PxCookConvexMesh(params, desc, output, condition))
+		return false;
+	if(mStorage)
+		mStorage->store(key, stream.begin(), stream.size());
+	return true;
+}
+
+PxTriangleMesh* CookingCache::createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxTriangleMeshCookingResult::Enum* condition)
+{
+	if(desc.sdfDesc)
+		return PxCreateTriangleMesh(params, desc, mPhysics.getPhysicsInsertionCallback(), condition);
+
+	const PxU64 key = computeKey(params, desc);
+
+	PxArray<PxU8> stream;
+	PxTriangleMesh* mesh = findObject<PxTriangleMesh>(key, stream);
+	if(mesh)
+	{
+		if(condition)
+			*condition = PxTriangleMeshCookingResult::eSUCCESS;
+		return mesh;
+	}
+
+	bool cooked = stream.empty();
+	if(cooked)
+	{
+		if(!cookAndStore(key, params, desc, stream, condition))
+			return NULL;
+	}
+	else if(condition)
+		*condition = PxTriangleMeshCookingResult::eSUCCESS;
+
+	{
+		MemoryInputData input(stream);
+		mesh = static_cast<PxTriangleMesh*>(createObject(mPhysics, mesh, input));
+	}
+
+	if(!mesh && !cooked)
+	{
+		// PT: the cached data is corrupt or truncated. Treat it as a cache miss and cook again.
+		stream.clear();
+		if(!cookAndStore(key, params, desc, stream, condition))
+			return NULL;
+		cooked = true;
+
+		MemoryInputData input(stream);
+		mesh = static_cast<PxTriangleMesh*>(createObject(mPhysics, mesh, input));
+	}
+
+	if(!mesh)
+		return NULL;
+
+	return addObject(key, mesh, stream, cooked);
+}
+
+PxConvexMesh* CookingCache::createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxConvexMeshCookingResult::Enum* condition)
+{
+	if(desc.sdfDesc)
+		return PxCreateConvexMesh(params, desc, mPhysics.getPhysicsInsertionCallback(), condition);
+
+	const PxU64 key = computeKey(params, desc);
+
+	PxArray<PxU8> stream;
+	PxConvexMesh* mesh = findObject<PxConvexMesh>(key, stream);
+	if(mesh)
+	{
+		if(condition)
+			*condition = PxConvexMeshCookingResult::eSUCCESS;
+		return mesh;
+	}
+
+	bool cooked = stream.empty();
+	if(cooked)
+	{
+		if(!cookAndStore(key, params, desc, stream, condition))
+			return NULL;
+	}
+	else if(condition)
+		*condition = PxConvexMeshCookingResult::eSUCCESS;
+
+	{
+		MemoryInputData input(stream);
+		mesh = static_cast<PxConvexMesh*>(createObject(mPhysics, mesh, input));
+	}
+
+	if(!mesh && !cooked)
+	{
+		// PT: the cached data is corrupt or truncated. Treat it as a cache miss and cook again.
+		stream.clear();
+		if(!cookAndStore(key, params, desc, stream, condition))
+			return NULL;
+		cooked = true;
+
+		MemoryInputData input(stream);
+		mesh = static_cast<PxConvexMesh*>(createObject(mPhysics, mesh, input));
+	}
+
+	if(!mesh)
+		return NULL;
+
+	return addObject(key, mesh, stream, cooked);
+}
+
+PxU32 CookingCache::getNbEntries() const
+{
+	PxMutex::ScopedLock lock(mMutex);
+	return mEntries.size();
+}
+
+PxU32 CookingCache::releaseUnusedObjects()
+{
+	PxMutex::ScopedLock lock(mMutex);
+
+	PxU32 nbReleased = 0;
+	for(PxHashMap<PxU64, CacheEntry*>::Iterator it = mEntries.getIterator(); !it.done(); ++it)
+	{
+		CacheEntry* entry = it->second;
+		if(entry->mObject && entry->mObject->getReferenceCount() == 1)
+		{
+			entry->mObject->release();
+			entry->mObject = NULL;
+			nbReleased++;
+		}
+	}
+	return nbReleased;
+}
+
+void CookingCache::clear()
+{
+	PxMutex::ScopedLock lock(mMutex);
+
+	for(PxHashMap<PxU64, CacheEntry*>::Iterator it = mEntries.getIterator(); !it.done(); ++it)
+	{
+		CacheEntry* entry = it->second;
+		if(entry->mObject)
+			entry->mObject->release();
+		PX_DELETE(entry);
+	}
+	mEntries.clear();
+}
+
+PxCookingCache* PxCreateCookingCache(PxPhysics& physics, PxCookingCacheStorage* storage)
+{
+	return PX_NEW(CookingCache)(physics, storage);
+}
@@ -0,0 +1,147 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxActiveActorTracker.h"
+#include "PxScene.h"
+#include "PxRigidDynamic.h"
+#include "PxArticulationLink.h"
+#include "PxArticulationReducedCoordinate.h"
+
+#include "foundation/PxArray.h"
+
+using namespace physx;
+
+namespace physx
+{
+class ActiveActorTrackerInternal
+{
+	PX_NOCOPY(ActiveActorTrackerInternal)
+	public:
+				ActiveActorTrackerInternal(PxScene& scene) : mScene(scene), mTimestamp(0)	{}
+				~ActiveActorTrackerInternal()												{}
+
+		const PxActiveActorRecord*	update(PxU32& nbRecords);
+
+		struct ActorState
+		{
+			PxU32	mAwakeTimestamp;	// Last update() call at which the actor was awake
+			PxU32	mSeenTimestamp;		// Last update() call at which the actor was in the active actors list
+		};
+
+		PxScene&						mScene;
+		PxU32							mTimestamp;
+		PxArray<ActorState>				mStates;		// Indexed by user index
+		PxArray<PxU32>					mAwake;			// User indices of actors awake at the last update() call
+		PxArray<PxU32>					mNextAwake;
+		PxArray<PxActiveActorRecord>	mRecords;
+};
+}
+
+static bool isActorSleeping(const PxActor* actor)
+{
+	const PxType type = actor->getConcreteType();
+	if(type == PxConcreteType::eRIGID_DYNAMIC)
+		return static_cast<const PxRigidDynamic*>(actor)->isSleeping();
+	if(type == PxConcreteType::eARTICULATION_LINK)
+		return static_cast<const PxArticulationLink*>(actor)->getArticulation().isSleeping();
+	return false;
+}
+
+const PxActiveActorRecord* ActiveActorTrackerInternal::update(PxU32& nbRecords)
+{
+	mRecords.forceSize_Unsafe(0);
+	mNextAwake.forceSize_Unsafe(0);
+
+	// PT: timestamps start at 1 so that zero-initialized states are never considered awake or seen
+	const PxU32 previous = mTimestamp++;
+	const PxU32 current = mTimestamp;
+
+	PxU32 nbActiveActors;
+	PxActor** activeActors = mScene.getActiveActors(nbActiveActors);
+	for(PxU32 i=0;i<nbActiveActors;i++)
+	{
+		const PxU32 userIndex = PxU32(size_t(activeActors[i]->userData));
+		if(userIndex >= mStates.size())
+		{
+			const ActorState initState = { 0, 0 };
+			mStates.resize(userIndex+1, initState);
+		}
+
+		ActorState& state = mStates[userIndex];
+		if(state.mSeenTimestamp == current)
+			continue;	// PT: articulation links can share a user index with their root
+		state.mSeenTimestamp = current;
+
+		PxU32 flags = PxActiveActorFlag::eMOVED;
+		const bool wasAwake = previous && state.mAwakeTimestamp == previous;
+		if(isActorSleeping(activeActors[i]))
+		{
+			if(wasAwake)
+				flags |= PxActiveActorFlag::eFELL_ASLEEP;
+		}
+		else
+		{
+			if(!wasAwake)
+				flags |= PxActiveActorFlag::eWOKE;
+			state.mAwakeTimestamp = current;
+			mNextAwake.pushBack(userIndex);
+		}
+
+		const PxActiveActorRecord record = { userIndex, flags };
+		mRecords.pushBack(record);
+	}
+
+	// PT: actors awake at the previous call but missing from the list have been put to sleep or removed
+	const PxU32 nbAwake = mAwake.size();
+	for(PxU32 i=0;i<nbAwake;i++)
+	{
+		const PxU32 userIndex = mAwake[i];
+		if(mStates[userIndex].mSeenTimestamp != current)
+		{
+			const PxActiveActorRecord record = { userIndex, PxU32(PxActiveActorFlag::eFELL_ASLEEP) };
+			mRecords.pushBack(record);
+		}
+	}
+	mAwake.swap(mNextAwake);
+
+	nbRecords = mRecords.size();
+	return mRecords.begin();
+}
+
+PxActiveActorTracker::PxActiveActorTracker(PxScene& scene)
+{
+	mImpl = new ActiveActorTrackerInternal(scene);
+}
+
+PxActiveActorTracker::~PxActiveActorTracker()
+{
+	delete mImpl;
+}
+
+const PxActiveActorRecord* PxActiveActorTracker::update(PxU32& nbRecords)
+{
+	return mImpl->update(nbRecords);
+}
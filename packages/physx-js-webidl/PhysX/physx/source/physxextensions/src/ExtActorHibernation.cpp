@@ -0,0 +1,375 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxActorHibernation.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxMath.h"
+#include "PxScene.h"
+#include "PxRigidDynamic.h"
+
+using namespace physx;
+
+namespace
+{
+	struct HibernationEntry
+	{
+		PxRigidDynamic*	mActor;			// NULL for free slots
+		PxReal			mAwakeTime;		// Last time the actor was seen awake
+		PxBounds3		mBounds;		// World bounds when hibernated
+		bool			mHibernated;
+	};
+
+	struct CellCoords
+	{
+		PxI32	mMin[3];
+		PxI32	mMax[3];
+	};
+
+	// PT: 21 bits per axis, i.e. +/- 1 million cells
+	PX_FORCE_INLINE PxU64 getCellKey(PxI32 x, PxI32 y, PxI32 z)
+	{
+		return (PxU64(PxU32(x) & 0x1fffff) << 42) | (PxU64(PxU32(y) & 0x1fffff) << 21) | PxU64(PxU32(z) & 0x1fffff);
+	}
+}
+
+namespace physx
+{
+class ActorHibernationInternal
+{
+	PX_NOCOPY(ActorHibernationInternal)
+	public:
+				ActorHibernationInternal(PxScene& scene, const PxActorHibernationParams& params) :
+					mScene(scene), mParams(params), mInvCellSize(1.0f/params.cellSize), mTime(0.0f), mCursor(0), mNbActors(0), mNbHibernated(0)	{}
+				~ActorHibernationInternal()	{}
+
+		PX_FORCE_INLINE	PxU32	getEntry(const PxRigidDynamic* actor)	const
+		{
+			const PxHashMap<const PxRigidDynamic*, PxU32>::Entry* entry = mEntryIndices.find(actor);
+			return entry ? entry->second : PX_INVALID_U32;
+		}
+
+		void	computeCells(const PxBounds3& bounds, CellCoords& cells)	const
+		{
+			// PT: clamped to the range covered by the cell keys
+			const PxReal limit = PxReal(1<<20) - 1.0f;
+			for(PxU32 j=0;j<3;j++)
+			{
+				cells.mMin[j] = PxI32(PxClamp(PxFloor(bounds.minimum[j] * mInvCellSize), -limit, limit));
+				cells.mMax[j] = PxI32(PxClamp(PxFloor(bounds.maximum[j] * mInvCellSize), -limit, limit));
+			}
+		}
+
+		// PT: hibernated actors are small compared to cells, so they are inserted in all the cells they overlap
+		void	insertInGrid(PxU32 index)
+		{
+			CellCoords cells;
+			computeCells(mEntries[index].mBounds, cells);
+			for(PxI32 x=cells.mMin[0];x<=cells.mMax[0];x++)
+				for(PxI32 y=cells.mMin[1];y<=cells.mMax[1];y++)
+					for(PxI32 z=cells.mMin[2];z<=cells.mMax[2];z++)
+						mGrid[getCellKey(x, y, z)].pushBack(index);
+		}
+
+		void	removeFromGrid(PxU32 index)
+		{
+			CellCoords cells;
+			computeCells(mEntries[index].mBounds, cells);
+			for(PxI32 x=cells.mMin[0];x<=cells.mMax[0];x++)
+				for(PxI32 y=cells.mMin[1];y<=cells.mMax[1];y++)
+					for(PxI32 z=cells.mMin[2];z<=cells.mMax[2];z++)
+					{
+						// PT: the cell exists since the actor was inserted in it
+						const PxU64 key = getCellKey(x, y, z);
+						PxArray<PxU32>& cell = mGrid[key];
+						cell.findAndReplaceWithLast(index);
+						if(cell.empty())
+							mGrid.erase(key);
+					}
+		}
+
+		bool	canHibernate(const PxRigidDynamic& actor)	const
+		{
+			return actor.getScene() == &mScene && actor.isSleeping()
+				&& !(actor.getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC)
+				&& !actor.getAggregate() && !actor.getNbConstraints();
+		}
+
+		void	hibernate(PxU32 index)
+		{
+			HibernationEntry& entry = mEntries[index];
+			PX_ASSERT(!entry.mHibernated);
+			entry.mBounds = entry.mActor->getWorldBounds();
+			// PT: the actor is asleep so there is nothing to wake up around it
+			mScene.removeActor(*entry.mActor, false);
+			entry.mHibernated = true;
+			insertInGrid(index);
+			mNbHibernated++;
+		}
+
+		void	wake(PxU32 index)
+		{
+			HibernationEntry& entry = mEntries[index];
+			PX_ASSERT(entry.mHibernated);
+			removeFromGrid(index);
+			// PT: the actor was asleep when it was removed, so it is added back asleep
+			mScene.addActor(*entry.mActor);
+			entry.mHibernated = false;
+			entry.mAwakeTime = mTime;
+			mNbHibernated--;
+		}
+
+		PxU32	rehydrate(const PxBounds3& bounds)
+		{
+			if(!mNbHibernated)
+				return 0;
+
+			mCandidates.clear();
+			CellCoords cells;
+			computeCells(bounds, cells);
+			const PxU64 nbCells = PxU64(cells.mMax[0] - cells.mMin[0] + 1) * PxU64(cells.mMax[1] - cells.mMin[1] + 1) * PxU64(cells.mMax[2] - cells.mMin[2] + 1);
+			if(nbCells > mGrid.size())
+			{
+				// PT: large bounds, it is cheaper to test all hibernated actors
+				for(PxU32 i=0;i<mEntries.size();i++)
+				{
+					if(mEntries[i].mActor && mEntries[i].mHibernated)
+						mCandidates.pushBack(i);
+				}
+			}
+			else
+			{
+				for(PxI32 x=cells.mMin[0];x<=cells.mMax[0];x++)
+					for(PxI32 y=cells.mMin[1];y<=cells.mMax[1];y++)
+						for(PxI32 z=cells.mMin[2];z<=cells.mMax[2];z++)
+						{
+							const PxHashMap<PxU64, PxArray<PxU32> >::Entry* cell = mGrid.find(getCellKey(x, y, z));
+							if(cell)
+							{
+								for(PxU32 i=0;i<cell->second.size();i++)
+									mCandidates.pushBack(cell->second[i]);
+							}
+						}
+			}
+
+			// PT: actors overlapping several cells appear several times, but only the first occurrence is still hibernated
+			PxU32 nbRehydrated = 0;
+			for(PxU32 i=0;i<mCandidates.size();i++)
+			{
+				const PxU32 index = mCandidates[i];
+				if(mEntries[index].mHibernated && mEntries[index].mBounds.intersects(bounds))
+				{
+					wake(index);
+					nbRehydrated++;
+				}
+			}
+			return nbRehydrated;
+		}
+
+		void	rehydrateAroundAwakeBodies()
+		{
+			if(!mNbActors)
+				return;
+
+			PxU32 nbActors;
+			PxActor** actors;
+			if(mScene.getFlags() & PxSceneFlag::eENABLE_ACTIVE_ACTORS)
+			{
+				actors = mScene.getActiveActors(nbActors);
+			}
+			else
+			{
+				nbActors = mScene.getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC);
+				mActorBuffer.resize(nbActors);
+				nbActors = mScene.getActors(PxActorTypeFlag::eRIGID_DYNAMIC, mActorBuffer.begin(), nbActors);
+				actors = mActorBuffer.begin();
+			}
+
+			// PT: the bounds are gathered first since rehydration modifies the scene. We also refresh the awake time of
+			// registered actors here: checkForHibernation() only reaches each entry every few frames with many actors, and
+			// a stale awake time would hibernate an actor as soon as it falls asleep.
+			mAwakeBounds.clear();
+			for(PxU32 i=0;i<nbActors;i++)
+			{
+				PxRigidDynamic* body = actors[i]->is<PxRigidDynamic>();
+				if(body && !body->isSleeping())
+				{
+					const PxU32 index = getEntry(body);
+					if(index != PX_INVALID_U32)
+						mEntries[index].mAwakeTime = mTime;
+
+					if(mNbHibernated)
+						mAwakeBounds.pushBack(body->getWorldBounds());
+				}
+			}
+
+			for(PxU32 i=0;i<mAwakeBounds.size() && mNbHibernated;i++)
+			{
+				PxBounds3 bounds = mAwakeBounds[i];
+				bounds.fattenFast(mParams.wakeMargin);
+				rehydrate(bounds);
+			}
+		}
+
+		void	checkForHibernation()
+		{
+			const PxU32 nbEntries = mEntries.size();
+			if(!nbEntries)
+				return;
+
+			const PxU32 nbChecks = PxMin(mParams.maxChecksPerUpdate, nbEntries);
+			for(PxU32 i=0;i<nbChecks;i++)
+			{
+				if(mCursor >= nbEntries)
+					mCursor = 0;
+				const PxU32 index = mCursor++;
+
+				HibernationEntry& entry = mEntries[index];
+				if(!entry.mActor || entry.mHibernated)
+					continue;
+
+				if(!canHibernate(*entry.mActor))
+					entry.mAwakeTime = mTime;
+				else if(mTime - entry.mAwakeTime >= mParams.hibernationDelay)
+					hibernate(index);
+			}
+		}
+
+		PxScene&								mScene;
+		const PxActorHibernationParams			mParams;
+		const PxReal							mInvCellSize;
+		PxReal									mTime;
+		PxU32									mCursor;
+		PxU32									mNbActors;
+		PxU32									mNbHibernated;
+		PxArray<HibernationEntry>				mEntries;
+		PxArray<PxU32>							mFreeEntries;
+		PxHashMap<const PxRigidDynamic*, PxU32>	mEntryIndices;
+		PxHashMap<PxU64, PxArray<PxU32> >		mGrid;
+		PxArray<PxU32>							mCandidates;
+		PxArray<PxBounds3>						mAwakeBounds;
+		PxArray<PxActor*>						mActorBuffer;
+};
+}
+
+PxActorHibernation::PxActorHibernation(PxScene& scene, const PxActorHibernationParams& params)
+{
+	PX_ASSERT(params.isValid());
+	mImpl = new ActorHibernationInternal(scene, params);
+}
+
+PxActorHibernation::~PxActorHibernation()
+{
+	rehydrateAll();
+	delete mImpl;
+}
+
+bool PxActorHibernation::addActor(PxRigidDynamic& actor)
+{
+	if(actor.getScene() != &mImpl->mScene || mImpl->getEntry(&actor) != PX_INVALID_U32)
+		return false;
+
+	PxU32 index;
+	if(mImpl->mFreeEntries.size())
+	{
+		index = mImpl->mFreeEntries.popBack();
+	}
+	else
+	{
+		index = mImpl->mEntries.size();
+		mImpl->mEntries.insert();
+	}
+
+	HibernationEntry& entry = mImpl->mEntries[index];
+	entry.mActor = &actor;
+	entry.mAwakeTime = mImpl->mTime;
+	entry.mBounds = PxBounds3::empty();
+	entry.mHibernated = false;
+	mImpl->mEntryIndices.insert(&actor, index);
+	mImpl->mNbActors++;
+	return true;
+}
+
+bool PxActorHibernation::removeActor(PxRigidDynamic& actor)
+{
+	const PxU32 index = mImpl->getEntry(&actor);
+	if(index == PX_INVALID_U32)
+		return false;
+
+	if(mImpl->mEntries[index].mHibernated)
+		mImpl->wake(index);
+
+	mImpl->mEntries[index].mActor = NULL;
+	mImpl->mFreeEntries.pushBack(index);
+	mImpl->mEntryIndices.erase(&actor);
+	mImpl->mNbActors--;
+	return true;
+}
+
+bool PxActorHibernation::isHibernated(const PxRigidDynamic& actor)	const
+{
+	const PxU32 index = mImpl->getEntry(&actor);
+	return index != PX_INVALID_U32 && mImpl->mEntries[index].mHibernated;
+}
+
+void PxActorHibernation::update(PxReal dt)
+{
+	PX_CHECK_AND_RETURN(dt >= 0.0f && PxIsFinite(dt), "PxActorHibernation::update: invalid time step");
+
+	mImpl->mTime += dt;
+	mImpl->rehydrateAroundAwakeBodies();
+	mImpl->checkForHibernation();
+}
+
+PxU32 PxActorHibernation::rehydrate(const PxBounds3& bounds)
+{
+	PX_CHECK_AND_RETURN_VAL(bounds.isValid(), "PxActorHibernation::rehydrate: invalid bounds", 0);
+	return mImpl->rehydrate(bounds);
+}
+
+PxU32 PxActorHibernation::rehydrateAll()
+{
+	PxU32 nbRehydrated = 0;
+	for(PxU32 i=0;i<mImpl->mEntries.size() && mImpl->mNbHibernated;i++)
+	{
+		if(mImpl->mEntries[i].mActor && mImpl->mEntries[i].mHibernated)
+		{
+			mImpl->wake(i);
+			nbRehydrated++;
+		}
+	}
+	return nbRehydrated;
+}
+
+PxU32 PxActorHibernation::getNbActors()	const
+{
+	return mImpl->mNbActors;
+}
+
+PxU32 PxActorHibernation::getNbHibernated()	const
+{
+	return mImpl->mNbHibernated;
+}
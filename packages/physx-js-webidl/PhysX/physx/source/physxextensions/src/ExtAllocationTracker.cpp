@@ -0,0 +1,227 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxAllocationTracker.h"
+#include "extensions/PxDefaultAllocator.h"
+#include "foundation/PxBroadcast.h"
+#include "foundation/PxFoundation.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxString.h"
+#include "foundation/PxUtilities.h"
+
+using namespace physx;
+
+namespace
+{
+	// PT: the tracker's own allocations must not go through the foundation allocator, or they would be reported
+	// back to the tracker while it holds its lock.
+	class TrackerAllocator
+	{
+	public:
+		TrackerAllocator(const char* = NULL)	{}
+		void*	allocate(size_t size, const char*, int)	{ return platformAlignedAlloc(size);	}
+		void	deallocate(void* ptr)						{ platformAlignedFree(ptr);				}
+	};
+
+	struct SubsystemDirectory
+	{
+		const char*					mName;
+		PxAllocationSubsystem::Enum	mSubsystem;
+	};
+
+	// PT: directories under "source", see PhysX*.cmake
+	const SubsystemDirectory gDirectories[] =
+	{
+		{ "foundation",					PxAllocationSubsystem::eFOUNDATION	},
+		{ "physx",						PxAllocationSubsystem::eAPI			},
+		{ "common",						PxAllocationSubsystem::eAPI			},
+		{ "simulationcontroller",		PxAllocationSubsystem::eSIMULATION	},
+		{ "lowlevelaabb",				PxAllocationSubsystem::eBROADPHASE	},
+		{ "gpubroadphase",				PxAllocationSubsystem::eGPU			},
+		{ "scenequery",					PxAllocationSubsystem::eSCENE_QUERY	},
+		{ "lowlevel",					PxAllocationSubsystem::eNARROWPHASE	},
+		{ "lowleveldynamics",			PxAllocationSubsystem::eSOLVER		},
+		{ "geomutils",					PxAllocationSubsystem::eGEOMETRY	},
+		{ "physxcooking",				PxAllocationSubsystem::eCOOKING		},
+		{ "physxcharacterkinematic",	PxAllocationSubsystem::eCHARACTER	},
+		{ "physxvehicle",				PxAllocationSubsystem::eVEHICLE		},
+		{ "physxextensions",			PxAllocationSubsystem::eEXTENSIONS	},
+		{ "immediatemode",				PxAllocationSubsystem::eSOLVER		},
+		{ "gpucommon",					PxAllocationSubsystem::eGPU			},
+		{ "gpunarrowphase",				PxAllocationSubsystem::eGPU			},
+		{ "gpusolver",					PxAllocationSubsystem::eGPU			},
+		{ "gpuarticulation",			PxAllocationSubsystem::eGPU			},
+		{ "gpusimulationcontroller",	PxAllocationSubsystem::eGPU			},
+		{ "physxgpu",					PxAllocationSubsystem::eGPU			},
+		{ "cudamanager",				PxAllocationSubsystem::eGPU			},
+	};
+
+	PX_FORCE_INLINE bool isSeparator(char c)
+	{
+		return c == '/' || c == '\\';
+	}
+
+	PxAllocationSubsystem::Enum getSubsystem(const char* filename)
+	{
+		if(!filename)
+			return PxAllocationSubsystem::eOTHER;
+
+		// PT: find the last "source" directory and look at the next path component
+		const char* component = NULL;
+		for(const char* p = filename; *p; p++)
+		{
+			if(isSeparator(*p) && !Pxstrncmp(p + 1, "source", 6) && isSeparator(p[7]))
+				component = p + 8;
+		}
+		if(!component)
+			return PxAllocationSubsystem::eOTHER;
+
+		PxU32 length = 0;
+		while(component[length] && !isSeparator(component[length]))
+			length++;
+
+		const PxU32 nbDirectories = PX_ARRAY_SIZE(gDirectories);
+		for(PxU32 i=0; i<nbDirectories; i++)
+		{
+			const char* name = gDirectories[i].mName;
+			if(!Pxstrncmp(component, name, length) && !name[length])
+				return gDirectories[i].mSubsystem;
+		}
+		return PxAllocationSubsystem::eOTHER;
+	}
+}
+
+namespace physx
+{
+class AllocationTrackerInternal : public PxAllocationListener
+{
+	PX_NOCOPY(AllocationTrackerInternal)
+	public:
+					AllocationTrackerInternal()
+					{
+						PxMemZero(mStats, sizeof(mStats));
+					}
+
+	virtual			~AllocationTrackerInternal()	{}
+
+	// PxAllocationListener
+	virtual	void	onAllocation(size_t size, const char* /*typeName*/, const char* filename, int /*line*/, void* allocatedMemory)	PX_OVERRIDE
+					{
+						const PxAllocationSubsystem::Enum subsystem = getSubsystem(filename);
+
+						PxMutex::ScopedLock lock(mMutex);
+						Allocation& allocation = mAllocations[allocatedMemory];
+						allocation.mSize = size;
+						allocation.mSubsystem = subsystem;
+
+						PxAllocationStats& stats = mStats[subsystem];
+						stats.liveBytes += size;
+						stats.nbLiveAllocations++;
+						stats.nbAllocations++;
+						if(stats.liveBytes > stats.peakBytes)
+							stats.peakBytes = stats.liveBytes;
+					}
+
+	virtual	void	onDeallocation(void* allocatedMemory)	PX_OVERRIDE
+					{
+						if(!allocatedMemory)
+							return;
+
+						PxMutex::ScopedLock lock(mMutex);
+
+						// PT: allocations made before the tracker was created are not found
+						const AllocationMap::Entry* entry = mAllocations.find(allocatedMemory);
+						if(!entry)
+							return;
+
+						PxAllocationStats& stats = mStats[entry->second.mSubsystem];
+						stats.liveBytes -= entry->second.mSize;
+						stats.nbLiveAllocations--;
+						mAllocations.erase(allocatedMemory);
+					}
+	//~PxAllocationListener
+
+	struct Allocation
+	{
+		size_t						mSize;
+		PxAllocationSubsystem::Enum	mSubsystem;
+	};
+	typedef PxHashMap<const void*, Allocation, PxHash<const void*>, TrackerAllocator>	AllocationMap;
+
+	mutable PxMutex		mMutex;
+	AllocationMap		mAllocations;
+	PxAllocationStats	mStats[PxAllocationSubsystem::eCOUNT];
+};
+}
+
+PxAllocationTracker::PxAllocationTracker()
+{
+	mImpl = new AllocationTrackerInternal;
+	PxGetFoundation().registerAllocationListener(*mImpl);
+}
+
+PxAllocationTracker::~PxAllocationTracker()
+{
+	PxGetFoundation().deregisterAllocationListener(*mImpl);
+	delete mImpl;
+}
+
+void PxAllocationTracker::getStats(PxAllocationStats* stats) const
+{
+	PxMutex::ScopedLock lock(mImpl->mMutex);
+	PxMemCopy(stats, mImpl->mStats, sizeof(mImpl->mStats));
+}
+
+void PxAllocationTracker::resetPeaks()
+{
+	PxMutex::ScopedLock lock(mImpl->mMutex);
+	for(PxU32 i=0; i<PxAllocationSubsystem::eCOUNT; i++)
+		mImpl->mStats[i].peakBytes = mImpl->mStats[i].liveBytes;
+}
+
+const char* PxAllocationTracker::getSubsystemName(PxAllocationSubsystem::Enum subsystem)
+{
+	static const char* names[] =
+	{
+		"Foundation",
+		"API",
+		"Simulation",
+		"Broadphase",
+		"SceneQuery",
+		"Narrowphase",
+		"Solver",
+		"Geometry",
+		"Cooking",
+		"Character",
+		"Vehicle",
+		"Extensions",
+		"GPU",
+		"Other"
+	};
+	PX_COMPILE_TIME_ASSERT(PX_ARRAY_SIZE(names) == PxAllocationSubsystem::eCOUNT);
+	return PxU32(subsystem) < PxAllocationSubsystem::eCOUNT ? names[subsystem] : NULL;
+}
@@ -0,0 +1,189 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxAllocationTripwire.h"
+#include "foundation/PxBroadcast.h"
+#include "foundation/PxFoundation.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxMath.h"
+
+using namespace physx;
+
+// PT: sites are stored in a fixed-size table so that recording never allocates
+#define MAX_NB_TRIPWIRE_SITES	256
+
+namespace physx
+{
+class AllocationTripwireInternal : public PxAllocationListener
+{
+	PX_NOCOPY(AllocationTripwireInternal)
+	public:
+					AllocationTripwireInternal(PxU32 nbWarmupScopes) :
+						mTag				(NULL),
+						mArmed				(0),
+						mNbWarmupScopes		(nbWarmupScopes),
+						mNbArmedScopes		(0),
+						mNbSites			(0),
+						mNbReportedSites	(0),
+						mReportErrors		(true)
+					{
+					}
+
+	virtual			~AllocationTripwireInternal()	{}
+
+	// PxAllocationListener
+	virtual	void	onAllocation(size_t size, const char* typeName, const char* filename, int line, void* /*allocatedMemory*/)	PX_OVERRIDE
+					{
+						// PT: cheap early exit while disarmed
+						if(!mArmed)
+							return;
+
+						PxMutex::ScopedLock lock(mMutex);
+						if(!mArmed || mNbArmedScopes<=mNbWarmupScopes)
+							return;
+
+						PxAllocationTripwireSite* site = findSite(typeName, filename, line);
+						if(!site)
+						{
+							if(mNbSites==MAX_NB_TRIPWIRE_SITES)
+								return;
+							site = &mSites[mNbSites++];
+							site->tag			= mTag;
+							site->typeName		= typeName;
+							site->file			= filename;
+							site->line			= line;
+							site->nbAllocations	= 0;
+							site->nbBytes		= 0;
+						}
+						site->nbAllocations++;
+						site->nbBytes += size;
+					}
+
+	virtual	void	onDeallocation(void*)	PX_OVERRIDE
+					{
+					}
+	//~PxAllocationListener
+
+	PxAllocationTripwireSite*	findSite(const char* typeName, const char* filename, int line)
+	{
+		for(PxU32 i=0;i<mNbSites;i++)
+		{
+			PxAllocationTripwireSite& site = mSites[i];
+			if(site.line==line && site.file==filename && site.typeName==typeName && site.tag==mTag)
+				return &site;
+		}
+		return NULL;
+	}
+
+	mutable PxMutex				mMutex;
+	const char*					mTag;
+	volatile PxU32				mArmed;	// PT: armed depth, scopes can nest
+	PxU32						mNbWarmupScopes;
+	PxU32						mNbArmedScopes;
+	PxU32						mNbSites;
+	PxU32						mNbReportedSites;
+	bool						mReportErrors;
+	PxAllocationTripwireSite	mSites[MAX_NB_TRIPWIRE_SITES];
+};
+}
+
+PxAllocationTripwire::PxAllocationTripwire(PxU32 nbWarmupScopes)
+{
+	mImpl = new AllocationTripwireInternal(nbWarmupScopes);
+	PxGetFoundation().registerAllocationListener(*mImpl);
+}
+
+PxAllocationTripwire::~PxAllocationTripwire()
+{
+	PxGetFoundation().deregisterAllocationListener(*mImpl);
+	delete mImpl;
+}
+
+void PxAllocationTripwire::arm(const char* tag)
+{
+	PxMutex::ScopedLock lock(mImpl->mMutex);
+	if(!mImpl->mArmed++)
+	{
+		mImpl->mTag = tag;
+		mImpl->mNbArmedScopes++;
+	}
+}
+
+void PxAllocationTripwire::disarm()
+{
+	PxU32 first, last;
+	{
+		PxMutex::ScopedLock lock(mImpl->mMutex);
+		PX_ASSERT(mImpl->mArmed);
+		if(--mImpl->mArmed)
+			return;
+
+		first = mImpl->mNbReportedSites;
+		last = mImpl->mNbSites;
+		mImpl->mNbReportedSites = last;
+		if(!mImpl->mReportErrors)
+			return;
+	}
+
+	// PT: reported outside of the lock, the error callback is free to allocate
+	for(PxU32 i=first;i<last;i++)
+	{
+		const PxAllocationTripwireSite& site = mImpl->mSites[i];
+		PxGetFoundation().error(PxErrorCode::ePERF_WARNING, site.file, site.line,
+			"PxAllocationTripwire: heap allocation in \"%s\" after warm-up (%s, %d bytes).", site.tag ? site.tag : "", site.typeName ? site.typeName : "", int(site.nbBytes));
+	}
+}
+
+PxU32 PxAllocationTripwire::getNbSites() const
+{
+	PxMutex::ScopedLock lock(mImpl->mMutex);
+	return mImpl->mNbSites;
+}
+
+PxU32 PxAllocationTripwire::getSites(PxAllocationTripwireSite* userBuffer, PxU32 bufferSize, PxU32 startIndex) const
+{
+	PxMutex::ScopedLock lock(mImpl->mMutex);
+	if(startIndex>=mImpl->mNbSites)
+		return 0;
+	const PxU32 nb = PxMin(bufferSize, mImpl->mNbSites - startIndex);
+	PxMemCopy(userBuffer, mImpl->mSites + startIndex, sizeof(PxAllocationTripwireSite)*nb);
+	return nb;
+}
+
+void PxAllocationTripwire::reset()
+{
+	PxMutex::ScopedLock lock(mImpl->mMutex);
+	mImpl->mNbArmedScopes = mImpl->mArmed ? 1 : 0;
+	mImpl->mNbSites = 0;
+	mImpl->mNbReportedSites = 0;
+}
+
+void PxAllocationTripwire::setReportErrors(bool reportErrors)
+{
+	PxMutex::ScopedLock lock(mImpl->mMutex);
+	mImpl->mReportErrors = reportErrors;
+}
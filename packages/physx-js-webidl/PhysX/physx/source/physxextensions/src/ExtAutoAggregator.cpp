@@ -0,0 +1,365 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxAutoAggregator.h"
+#include "extensions/PxRigidActorExt.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxUserAllocated.h"
+#include "geometry/PxBVH.h"
+#include "PxAggregate.h"
+#include "PxPhysics.h"
+#include "PxScene.h"
+#include "PxRigidActor.h"
+
+using namespace physx;
+
+namespace
+{
+	struct ManagedAggregate
+	{
+		PxAggregate*			mAggregate;
+		PxArray<PxRigidActor*>	mActors;
+		PxU64					mCell;
+		PxU32					mNbShapes;
+		bool					mStatic;
+	};
+
+	struct ManagedActor
+	{
+		PxU32	mAggregateIndex;
+		bool	mHasBVH;
+	};
+
+	// PT: cell coordinates are packed on 21 bits each, which wraps around for very large worlds. That only merges
+	// distant clusters, it doesn't break anything.
+	PX_FORCE_INLINE PxU64 getCellKey(const PxVec3& p, PxReal invCellSize)
+	{
+		const PxU64 x = PxU64(PxI64(PxFloor(p.x * invCellSize))) & 0x1fffff;
+		const PxU64 y = PxU64(PxI64(PxFloor(p.y * invCellSize))) & 0x1fffff;
+		const PxU64 z = PxU64(PxI64(PxFloor(p.z * invCellSize))) & 0x1fffff;
+		return x | (y<<21) | (z<<42);
+	}
+}
+
+namespace physx
+{
+	class AutoAggregatorInternal : public PxUserAllocated
+	{
+		PX_NOCOPY(AutoAggregatorInternal)
+		public:
+			AutoAggregatorInternal(PxScene& scene, const PxAutoAggregatorParams& params) : mScene(scene), mParams(params), mNbAggregates(0)
+			{
+			}
+
+			~AutoAggregatorInternal()
+			{
+				// PT: releasing an aggregate that is in a scene puts its actors back in the scene individually
+				const PxU32 nbAggregates = mAggregates.size();
+				for(PxU32 i=0;i<nbAggregates;i++)
+				{
+					if(mAggregates[i].mAggregate)
+						mAggregates[i].mAggregate->release();
+				}
+			}
+
+			bool	addActor(PxRigidActor& actor);
+			void	removeActor(PxRigidActor& actor, bool wakeOnLostTouch);
+			bool	attachShape(PxRigidActor& actor, PxShape& shape);
+
+			PxScene&								mScene;
+			const PxAutoAggregatorParams			mParams;
+			PxArray<ManagedAggregate>				mAggregates;
+			PxArray<PxU32>							mFreeAggregates;
+			PxHashMap<PxRigidActor*, ManagedActor>	mActorMap;
+			PxHashMap<PxU64, PxU32>					mCells;
+			PxU32									mNbAggregates;
+
+		private:
+			PxU32	createManagedAggregate(bool isStatic, PxU64 cell);
+			void	buildAggregate(PxU32 index);
+			void	insertActor(PxU32 index, PxRigidActor& actor);
+			void	releaseManagedAggregate(PxU32 index);
+
+			PxU32	getShapeCapacity(PxU32 nbShapes)	const
+			{
+				return nbShapes + PxU32(PxReal(nbShapes) * mParams.shapeSlack) + 1;
+			}
+	};
+}
+
+PxU32 AutoAggregatorInternal::createManagedAggregate(bool isStatic, PxU64 cell)
+{
+	PxU32 index;
+	if(mFreeAggregates.size())
+	{
+		index = mFreeAggregates.popBack();
+	}
+	else
+	{
+		index = mAggregates.size();
+		mAggregates.insert();
+	}
+
+	ManagedAggregate& managed = mAggregates[index];
+	managed.mAggregate	= NULL;
+	managed.mActors.clear();
+	managed.mCell		= cell;
+	managed.mNbShapes	= 0;
+	managed.mStatic		= isStatic;
+
+	if(isStatic)
+		mCells.insert(cell, index);
+
+	mNbAggregates++;
+	return index;
+}
+
+void AutoAggregatorInternal::insertActor(PxU32 index, PxRigidActor& actor)
+{
+	ManagedAggregate& managed = mAggregates[index];
+
+	// PT: with a BVH the scene-query structure stores a single bound for the actor instead of one per shape
+	PxBVH* bvh = NULL;
+	if(mParams.buildBVH && actor.getNbShapes() >= mParams.shapeThreshold)
+		bvh = PxRigidActorExt::createBVHFromActor(mScene.getPhysics(), actor);
+
+	managed.mAggregate->addActor(actor, bvh);
+
+	// PT: the aggregate or the scene keeps its own reference to the BVH
+	if(bvh)
+		bvh->release();
+
+	ManagedActor& entry = mActorMap[&actor];
+	entry.mAggregateIndex	= index;
+	entry.mHasBVH			= bvh!=NULL;
+}
+
+// PT: (re)creates the aggregate of a managed aggregate from its actor list. The actors must not be in the scene.
+// Aggregates cannot be resized, so growing one means releasing it and creating a larger one.
+void AutoAggregatorInternal::buildAggregate(PxU32 index)
+{
+	ManagedAggregate& managed = mAggregates[index];
+	if(managed.mAggregate)
+	{
+		if(managed.mAggregate->getScene())
+			mScene.removeAggregate(*managed.mAggregate, false);
+		managed.mAggregate->release();
+		managed.mAggregate = NULL;
+	}
+
+	const PxU32 nbActors = managed.mActors.size();
+	PxU32 nbShapes = 0;
+	for(PxU32 i=0;i<nbActors;i++)
+		nbShapes += managed.mActors[i]->getNbShapes();
+	managed.mNbShapes = nbShapes;
+
+	// PT: static aggregates never self-collide, and shapes of a single rigid actor don't collide with each other
+	// either, so self-collisions are disabled in both cases.
+	const PxU32 maxActors = managed.mStatic ? PxMax(mParams.maxStaticsPerCell, nbActors) : 1;
+	const PxAggregateFilterHint hint = PxGetAggregateFilterHint(managed.mStatic ? PxAggregateType::eSTATIC : PxAggregateType::eGENERIC, false);
+	managed.mAggregate = mScene.getPhysics().createAggregate(maxActors, getShapeCapacity(nbShapes), hint);
+
+	for(PxU32 i=0;i<nbActors;i++)
+		insertActor(index, *managed.mActors[i]);
+
+	mScene.addAggregate(*managed.mAggregate);
+}
+
+void AutoAggregatorInternal::releaseManagedAggregate(PxU32 index)
+{
+	ManagedAggregate& managed = mAggregates[index];
+	PX_ASSERT(!managed.mActors.size());
+
+	mScene.removeAggregate(*managed.mAggregate, false);
+	managed.mAggregate->release();
+	managed.mAggregate = NULL;
+
+	if(managed.mStatic)
+		mCells.erase(managed.mCell);
+
+	mFreeAggregates.pushBack(index);
+	mNbAggregates--;
+}
+
+bool AutoAggregatorInternal::addActor(PxRigidActor& actor)
+{
+	if(mActorMap.find(&actor))
+		return true;
+
+	PxScene* scene = actor.getScene();
+	if(scene && scene!=&mScene)
+		return false;
+
+	// PT: actors put in an aggregate by the user are left as they are
+	if(actor.getAggregate())
+		return scene!=NULL;
+
+	const bool isStatic = actor.getType()==PxActorType::eRIGID_STATIC;
+	const PxU32 nbShapes = actor.getNbShapes();
+
+	PxU32 index = 0xffffffff;
+	if(isStatic && mParams.staticCellSize>0.0f)
+	{
+		const PxU64 cell = getCellKey(actor.getWorldBounds().getCenter(), 1.0f/mParams.staticCellSize);
+		const PxHashMap<PxU64, PxU32>::Entry* e = mCells.find(cell);
+		if(!e)
+			index = createManagedAggregate(true, cell);
+		else if(mAggregates[e->second].mActors.size() < mParams.maxStaticsPerCell)
+			index = e->second;
+	}
+	else if(nbShapes >= mParams.shapeThreshold)
+	{
+		index = createManagedAggregate(isStatic, 0);
+	}
+
+	if(index==0xffffffff)
+		return scene ? true : mScene.addActor(actor);
+
+	// PT: actors cannot be added to an aggregate while they are in a scene
+	if(scene)
+		mScene.removeActor(actor, false);
+
+	ManagedAggregate& managed = mAggregates[index];
+	managed.mActors.pushBack(&actor);
+
+	if(managed.mAggregate && managed.mActors.size() <= managed.mAggregate->getMaxNbActors() && managed.mNbShapes + nbShapes <= managed.mAggregate->getMaxNbShapes())
+	{
+		insertActor(index, actor);
+		managed.mNbShapes += nbShapes;
+	}
+	else
+	{
+		buildAggregate(index);
+	}
+	return true;
+}
+
+void AutoAggregatorInternal::removeActor(PxRigidActor& actor, bool wakeOnLostTouch)
+{
+	const PxHashMap<PxRigidActor*, ManagedActor>::Entry* e = mActorMap.find(&actor);
+	if(!e)
+	{
+		if(actor.getScene()==&mScene)
+			mScene.removeActor(actor, wakeOnLostTouch);
+		return;
+	}
+
+	const PxU32 index = e->second.mAggregateIndex;
+	mActorMap.erase(&actor);
+
+	// PT: removing the actor from the scene also removes it from its aggregate, without reinserting it
+	mScene.removeActor(actor, wakeOnLostTouch);
+
+	ManagedAggregate& managed = mAggregates[index];
+	managed.mActors.findAndReplaceWithLast(&actor);
+	managed.mNbShapes -= PxMin(managed.mNbShapes, actor.getNbShapes());
+
+	if(!managed.mActors.size())
+		releaseManagedAggregate(index);
+}
+
+bool AutoAggregatorInternal::attachShape(PxRigidActor& actor, PxShape& shape)
+{
+	const PxHashMap<PxRigidActor*, ManagedActor>::Entry* e = mActorMap.find(&actor);
+	if(!e)
+	{
+		if(!actor.attachShape(shape))
+			return false;
+
+		// PT: the actor may have just crossed the threshold
+		if(actor.getScene()==&mScene && !actor.getAggregate() && actor.getNbShapes() >= mParams.shapeThreshold)
+			addActor(actor);
+		return true;
+	}
+
+	const PxU32 index = e->second.mAggregateIndex;
+	ManagedAggregate& managed = mAggregates[index];
+
+	if(managed.mNbShapes + 1 > managed.mAggregate->getMaxNbShapes())
+	{
+		// PT: out of room, the aggregate is rebuilt with the new shape. Removing it first avoids inserting the shape
+		// in the broadphase only to remove it right away.
+		mScene.removeAggregate(*managed.mAggregate, false);
+		const bool status = actor.attachShape(shape);
+		buildAggregate(index);
+		return status;
+	}
+
+	const bool needsBVH = mParams.buildBVH && actor.getNbShapes() + 1 >= mParams.shapeThreshold;
+	if(!e->second.mHasBVH && !needsBVH)
+	{
+		const bool status = actor.attachShape(shape);
+		if(status)
+			managed.mNbShapes++;
+		return status;
+	}
+
+	// PT: the BVH of the actor covers its previous shapes only, so the actor is reinserted with a new one
+	mScene.removeActor(actor, false);
+	const bool status = actor.attachShape(shape);
+	insertActor(index, actor);
+	if(status)
+		managed.mNbShapes++;
+	return status;
+}
+
+PxAutoAggregator::PxAutoAggregator(PxScene& scene, const PxAutoAggregatorParams& params)
+{
+	PX_ASSERT(params.isValid());
+	mImpl = PX_NEW(AutoAggregatorInternal)(scene, params);
+}
+
+PxAutoAggregator::~PxAutoAggregator()
+{
+	PX_DELETE(mImpl);
+}
+
+bool PxAutoAggregator::addActor(PxRigidActor& actor)
+{
+	return mImpl->addActor(actor);
+}
+
+void PxAutoAggregator::removeActor(PxRigidActor& actor, bool wakeOnLostTouch)
+{
+	mImpl->removeActor(actor, wakeOnLostTouch);
+}
+
+bool PxAutoAggregator::attachShape(PxRigidActor& actor, PxShape& shape)
+{
+	return mImpl->attachShape(actor, shape);
+}
+
+PxU32 PxAutoAggregator::getNbAggregates() const
+{
+	return mImpl->mNbAggregates;
+}
+
+PxU32 PxAutoAggregator::getNbAggregatedActors() const
+{
+	return mImpl->mActorMap.size();
+}
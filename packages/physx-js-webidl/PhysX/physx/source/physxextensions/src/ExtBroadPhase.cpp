@@ -30,7 +30,12 @@
 #include "foundation/PxBounds3.h"
 #include "foundation/PxErrorCallback.h"
 #include "foundation/PxFoundation.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxSort.h"
 #include "extensions/PxBroadPhaseExt.h"
+#include "PxBroadPhase.h"
+#include "PxScene.h"
+#include "PxActor.h"
 
 using namespace physx;
 
@@ -71,3 +76,208 @@ PxU32 PxBroadPhaseExt::createRegionsFromWorldBounds(PxBounds3* regions, const Px
 	}
 	return nbRegions;
 }
+
+namespace
+{
+	struct RegionNode
+	{
+		PxBounds3	mBounds;
+		PxU32		mStart;		// First object center in the (partitioned) centers array
+		PxU32		mCount;		// Number of object centers in this region
+		bool		mFinal;		// True if the region cannot be split further
+	};
+
+	struct CenterLess
+	{
+		CenterLess(PxU32 axis) : mAxis(axis)	{}
+
+		PX_FORCE_INLINE	bool operator()(const PxVec3& a, const PxVec3& b) const
+		{
+			return a[mAxis] < b[mAxis];
+		}
+
+		PxU32	mAxis;
+	};
+}
+
+PxU32 PxBroadPhaseExt::createRegionsFromObjectBounds(PxBounds3* regions, PxU32 maxNbRegions, const PxBounds3& globalBounds, const PxBounds3* objectBounds, PxU32 nbObjects, PxU32 maxObjectsPerRegion, PxU32 upAxis)
+{
+	PX_CHECK_AND_RETURN_VAL(regions, "PxBroadPhaseExt::createRegionsFromObjectBounds(): NULL regions buffer provided!", 0);
+	PX_CHECK_AND_RETURN_VAL(globalBounds.isValid() && !globalBounds.isEmpty(), "PxBroadPhaseExt::createRegionsFromObjectBounds(): invalid bounds provided!", 0);
+	PX_CHECK_AND_RETURN_VAL(!nbObjects || objectBounds, "PxBroadPhaseExt::createRegionsFromObjectBounds(): NULL object bounds provided!", 0);
+	PX_CHECK_AND_RETURN_VAL(upAxis<3, "PxBroadPhaseExt::createRegionsFromObjectBounds(): invalid up-axis provided!", 0);
+
+	if(!maxNbRegions)
+		return 0;
+
+	// PT: we only need the object centers to measure the density. Objects outside of the global box are
+	// clamped to it, so that they are accounted for in the closest border region.
+	PxArray<PxVec3> centers;
+	centers.reserve(nbObjects);
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		if(!objectBounds[i].isEmpty())
+			centers.pushBack(objectBounds[i].getCenter().maximum(globalBounds.minimum).minimum(globalBounds.maximum));
+	}
+
+	const PxU32 axis0 = upAxis==0 ? 1u : 0u;
+	const PxU32 axis1 = upAxis==2 ? 1u : 2u;
+
+	PxArray<RegionNode> nodes;
+	nodes.reserve(maxNbRegions);
+	{
+		RegionNode root;
+		root.mBounds	= globalBounds;
+		root.mStart		= 0;
+		root.mCount		= centers.size();
+		root.mFinal		= false;
+		nodes.pushBack(root);
+	}
+
+	while(nodes.size()<maxNbRegions)
+	{
+		// PT: always split the most crowded region first
+		PxU32 best = 0xffffffff;
+		PxU32 bestCount = maxObjectsPerRegion;
+		for(PxU32 i=0;i<nodes.size();i++)
+		{
+			if(!nodes[i].mFinal && nodes[i].mCount>bestCount)
+			{
+				bestCount = nodes[i].mCount;
+				best = i;
+			}
+		}
+		if(best==0xffffffff)
+			break;
+
+		RegionNode& node = nodes[best];
+		PxVec3* PX_RESTRICT c = centers.begin() + node.mStart;
+
+		PxBounds3 centerBounds = PxBounds3::empty();
+		for(PxU32 i=0;i<node.mCount;i++)
+			centerBounds.include(c[i]);
+
+		const PxVec3 spread = centerBounds.getDimensions();
+		const PxU32 axis = spread[axis0] >= spread[axis1] ? axis0 : axis1;
+		if(spread[axis]<=0.0f)
+		{
+			// PT: all objects share the same position, splitting would not help
+			node.mFinal = true;
+			continue;
+		}
+
+		PxSort(c, node.mCount, CenterLess(axis));
+
+		// PT: split at the median, moved to the closest position that actually separates two different coordinates.
+		// We know there is one since the spread is not zero (and thus mCount>=2).
+		PxU32 nbLeft = node.mCount/2;
+		while(nbLeft && c[nbLeft-1][axis]==c[nbLeft][axis])
+			nbLeft--;
+		if(!nbLeft)
+		{
+			nbLeft = node.mCount/2;
+			while(c[nbLeft-1][axis]==c[nbLeft][axis])
+				nbLeft++;
+		}
+		const PxReal split = (c[nbLeft-1][axis] + c[nbLeft][axis])*0.5f;
+
+		RegionNode right;
+		right.mBounds				= node.mBounds;
+		right.mBounds.minimum[axis]	= split;
+		right.mStart				= node.mStart + nbLeft;
+		right.mCount				= node.mCount - nbLeft;
+		right.mFinal				= false;
+
+		node.mBounds.maximum[axis]	= split;
+		node.mCount					= nbLeft;
+
+		nodes.pushBack(right);	// PT: no reallocation here thanks to the initial reserve, so 'node' is still valid
+	}
+
+	const PxU32 nbRegions = nodes.size();
+	for(PxU32 i=0;i<nbRegions;i++)
+		regions[i] = nodes[i].mBounds;
+	return nbRegions;
+}
+
+PxU32 PxBroadPhaseExt::rebalanceRegions(PxScene& scene, PxU32 maxNbRegions, PxU32 maxObjectsPerRegion, PxU32 upAxis, PxReal margin)
+{
+	PX_CHECK_AND_RETURN_VAL(scene.getBroadPhaseType()==PxBroadPhaseType::eMBP, "PxBroadPhaseExt::rebalanceRegions(): scene does not use PxBroadPhaseType::eMBP!", 0);
+	PX_CHECK_AND_RETURN_VAL(upAxis<3, "PxBroadPhaseExt::rebalanceRegions(): invalid up-axis provided!", 0);
+	PX_CHECK_AND_RETURN_VAL(margin>=0.0f, "PxBroadPhaseExt::rebalanceRegions(): margin must be positive!", 0);
+
+	PxBroadPhaseCaps caps;
+	scene.getBroadPhaseCaps(caps);
+	maxNbRegions = PxMin(maxNbRegions, caps.mMaxNbRegions);
+
+	const PxActorTypeFlags types = PxActorTypeFlag::eRIGID_STATIC | PxActorTypeFlag::eRIGID_DYNAMIC;
+	const PxU32 nbActors = scene.getNbActors(types);
+	if(!nbActors || !maxNbRegions)
+		return 0;
+
+	PxBounds3 globalBounds = PxBounds3::empty();
+	PxArray<PxBounds3> objectBounds;
+	{
+		PxArray<PxActor*> actors(nbActors);
+		scene.getActors(types, actors.begin(), nbActors);
+
+		objectBounds.reserve(nbActors);
+		for(PxU32 i=0;i<nbActors;i++)
+		{
+			const PxBounds3 bounds = actors[i]->getWorldBounds(1.0f);
+			if(bounds.isEmpty())
+				continue;
+			objectBounds.pushBack(bounds);
+			globalBounds.include(bounds);
+		}
+	}
+	if(globalBounds.isEmpty())
+		return 0;
+	globalBounds.fattenFast(margin);
+	// PT: regions are not split along the up axis so there is no cost in making them unbounded along it. This way
+	// objects that jump or fall never leave the regions vertically.
+	globalBounds.minimum[upAxis] = -PX_MAX_BOUNDS_EXTENTS;
+	globalBounds.maximum[upAxis] = PX_MAX_BOUNDS_EXTENTS;
+
+	PxArray<PxBounds3> newRegions(maxNbRegions);
+	const PxU32 nbNewRegions = createRegionsFromObjectBounds(newRegions.begin(), maxNbRegions, globalBounds, objectBounds.begin(), objectBounds.size(), maxObjectsPerRegion, upAxis);
+
+	// PT: region handles are indices into the region array returned by getBroadPhaseRegions, which also contains removed (inactive) slots.
+	const PxU32 nbOldSlots = scene.getNbBroadPhaseRegions();
+	PxArray<PxU32> oldHandles;
+	{
+		PxArray<PxBroadPhaseRegionInfo> infos(nbOldSlots);
+		scene.getBroadPhaseRegions(infos.begin(), nbOldSlots);
+		for(PxU32 i=0;i<nbOldSlots;i++)
+		{
+			if(infos[i].mActive)
+				oldHandles.pushBack(i);
+		}
+	}
+
+	// PT: adding the new regions first lets the broadphase migrate objects region-to-region. Objects only go out-of-bounds
+	// if we have to remove the old regions first, because both sets do not fit within the broadphase's limit.
+	const bool removeFirst = oldHandles.size() + nbNewRegions > caps.mMaxNbRegions;
+	if(removeFirst)
+	{
+		for(PxU32 i=0;i<oldHandles.size();i++)
+			scene.removeBroadPhaseRegion(oldHandles[i]);
+	}
+
+	PxU32 nbAdded = 0;
+	for(PxU32 i=0;i<nbNewRegions;i++)
+	{
+		PxBroadPhaseRegion region;
+		region.mBounds		= newRegions[i];
+		region.mUserData	= NULL;
+		if(scene.addBroadPhaseRegion(region, true)!=0xffffffff)
+			nbAdded++;
+	}
+
+	if(!removeFirst)
+	{
+		for(PxU32 i=0;i<oldHandles.size();i++)
+			scene.removeBroadPhaseRegion(oldHandles[i]);
+	}
+	return nbAdded;
+}
@@ -0,0 +1,583 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxSceneQuerySystemExt.h"
+#include "extensions/PxShapeExt.h"
+#include "geometry/PxGeometryQuery.h"
+#include "geometry/PxBVH.h"
+#include "cooking/PxBVHDesc.h"
+#include "cooking/PxCooking.h"
+#include "PxRigidActor.h"
+#include "PxShape.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxBitMap.h"
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxHashSet.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxUserAllocated.h"
+
+// PT: this file implements a wrapper around an existing scene-query system, caching the closest (or any) blocking hit
+// of raycasts that are repeated bit for bit from one call to the next, e.g. ground probes under idle characters. The cache
+// is a direct-mapped table. Scene changes seen by the wrapper (shape additions, removals, updates and the bounds sync
+// of fetchResults) are recorded as dirty handles and dirty bounds, and applied to the cache lazily before the next lookup:
+// an entry is discarded if its hit shape is dirty, or if a dirty bounds crosses its segment up to the cached hit. Removed
+// shapes cannot create a closer hit, so only the hit shape needs to be checked for them.
+
+using namespace physx;
+
+namespace
+{
+	// PT: below this number of dirty bounds we don't build a BVH for them
+	#define CACHED_SQ_BVH_THRESHOLD	32
+
+	static PX_FORCE_INLINE PxU64 encodeHandle(PxU32 prunerIndex, PxSQPrunerHandle handle)
+	{
+		return (PxU64(prunerIndex)<<32) | PxU64(handle);
+	}
+
+	static bool intersectSegmentAABB(const PxVec3& origin, const PxVec3& dir, PxReal length, const PxBounds3& bounds)
+	{
+		PxReal tmin = 0.0f;
+		PxReal tmax = length;
+		for(PxU32 axis=0; axis<3; axis++)
+		{
+			if(PxAbs(dir[axis]) < 1e-9f)
+			{
+				if(origin[axis] < bounds.minimum[axis] || origin[axis] > bounds.maximum[axis])
+					return false;
+			}
+			else
+			{
+				const PxReal invDir = 1.0f / dir[axis];
+				PxReal t0 = (bounds.minimum[axis] - origin[axis]) * invDir;
+				PxReal t1 = (bounds.maximum[axis] - origin[axis]) * invDir;
+				if(t0 > t1)
+					PxSwap(t0, t1);
+				tmin = PxMax(tmin, t0);
+				tmax = PxMin(tmax, t1);
+				if(tmin > tmax)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	struct RaycastKey
+	{
+		PxVec3		mOrigin;
+		PxVec3		mDir;
+		PxReal		mDistance;
+		PxU32		mHitFlags;
+		PxU32		mQueryFlags;
+		PxU32		mGeomQueryFlags;
+		PxFilterData	mFilterData;
+
+		// PT: bitwise comparison on purpose, so that e.g. -0.0f and 0.0f are different keys and NaNs never match
+		PX_FORCE_INLINE	bool	operator==(const RaycastKey& other)	const
+		{
+			const PxU32* a = reinterpret_cast<const PxU32*>(this);
+			const PxU32* b = reinterpret_cast<const PxU32*>(&other);
+			for(PxU32 i=0; i<sizeof(RaycastKey)/sizeof(PxU32); i++)
+			{
+				if(a[i]!=b[i])
+					return false;
+			}
+			return true;
+		}
+
+		PX_FORCE_INLINE	PxU32	computeHash()	const
+		{
+			const PxU32* words = reinterpret_cast<const PxU32*>(this);
+			PxU32 hash = 0;
+			for(PxU32 i=0; i<sizeof(RaycastKey)/sizeof(PxU32); i++)
+				hash = PxComputeHash(hash ^ words[i]);
+			return hash;
+		}
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(RaycastKey)==sizeof(PxU32)*14);
+
+	struct CacheEntry
+	{
+		RaycastKey		mKey;
+		PxRaycastHit	mBlock;
+		PxU64			mHitHandle;			// Encoded pruner index & handle of the hit shape
+		PxU32			mStaticTimestamp;
+		bool			mValid;
+		bool			mHasBlock;
+
+		// PT: only the part of the segment up to the blocking hit needs to be free of new shapes
+		PX_FORCE_INLINE	PxReal	getLength()	const	{ return mHasBlock ? mBlock.distance : mKey.mDistance;	}
+	};
+
+	class CachedPxSQ : public PxCachedSceneQuerySystem, public PxUserAllocated
+	{
+		public:
+												CachedPxSQ(PxSceneQuerySystem& sq, PxU32 maxNbEntries);
+		virtual									~CachedPxSQ();
+
+		virtual	void							release();
+		virtual	void							acquireReference()	{ mRefCount++;	}
+
+		// PxCachedSceneQuerySystem
+		virtual	void							invalidateCache();
+		virtual	void							getCacheStatistics(PxU32& nbHits, PxU32& nbMisses, bool reset);
+		//~PxCachedSceneQuerySystem
+
+		virtual	void							preallocate(PxU32 prunerIndex, PxU32 nbShapes)									{ mSQ.preallocate(prunerIndex, nbShapes);					}
+		virtual	void							flushMemory()																	{ mSQ.flushMemory();										}
+		virtual	void							addSQShape(	const PxRigidActor& actor, const PxShape& shape, const PxBounds3& bounds,
+															const PxTransform& transform, const PxSQCompoundHandle* compoundHandle, bool hasPruningStructure);
+		virtual	void							removeSQShape(const PxRigidActor& actor, const PxShape& shape);
+		virtual	void							updateSQShape(const PxRigidActor& actor, const PxShape& shape, const PxTransform& transform);
+		virtual	PxSQCompoundHandle				addSQCompound(const PxRigidActor& actor, const PxShape** shapes, const PxBVH& bvh, const PxTransform* transforms);
+		virtual	void							removeSQCompound(PxSQCompoundHandle compoundHandle);
+		virtual	void							updateSQCompound(PxSQCompoundHandle compoundHandle, const PxTransform& compoundTransform);
+		virtual	void							shiftOrigin(const PxVec3& shift);
+		virtual	void							merge(const PxPruningStructure& pruningStructure);
+		virtual	void							sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
+													const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices);
+		virtual	void							beginSync()																		{ mSQ.beginSync();											}
+		virtual	void							finalizeUpdates()																{ mSQ.finalizeUpdates();									}
+		virtual	void							flushUpdates()																	{ mSQ.flushUpdates();										}
+		virtual	void							forceRebuildDynamicTree(PxU32 prunerIndex)										{ mSQ.forceRebuildDynamicTree(prunerIndex);					}
+		virtual	PxSQBuildStepHandle				prepareSceneQueryBuildStep(PxU32 prunerIndex)									{ return mSQ.prepareSceneQueryBuildStep(prunerIndex);		}
+		virtual	void							sceneQueryBuildStep(PxSQBuildStepHandle handle)									{ mSQ.sceneQueryBuildStep(handle);							}
+		virtual	void							setDynamicTreeRebuildRateHint(PxU32 dynamicTreeRebuildRateHint)					{ mSQ.setDynamicTreeRebuildRateHint(dynamicTreeRebuildRateHint);	}
+		virtual	PxU32							getDynamicTreeRebuildRateHint()							const					{ return mSQ.getDynamicTreeRebuildRateHint();				}
+		virtual	void							setUpdateMode(PxSceneQueryUpdateMode::Enum updateMode)							{ mSQ.setUpdateMode(updateMode);							}
+		virtual	PxSceneQueryUpdateMode::Enum	getUpdateMode()											const					{ return mSQ.getUpdateMode();								}
+		virtual	PxU32							getStaticTimestamp()									const					{ return mSQ.getStaticTimestamp();							}
+		virtual	void							visualize(PxU32 prunerIndex, PxRenderOutput& out)		const					{ mSQ.visualize(prunerIndex, out);							}
+		virtual	PxSQPrunerHandle				getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const	{ return mSQ.getHandle(actor, shape, prunerIndex);	}
+
+		virtual	bool							raycast(const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
+														PxRaycastCallback& hitCall, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	bool							sweep(	const PxGeometry& geometry, const PxTransform& pose,
+														const PxVec3& unitDir, const PxReal distance,
+														PxSweepCallback& hitCall, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, const PxReal inflation, PxGeometryQueryFlags flags)	const
+												{
+													return mSQ.sweep(geometry, pose, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, inflation, flags);
+												}
+		virtual	bool							overlap(const PxGeometry& geometry, const PxTransform& transform,
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const
+												{
+													return mSQ.overlap(geometry, transform, hitCall, filterData, filterCall, cache, flags);
+												}
+		virtual	bool							cull(PxU32 nbPlanes, const PxPlane* planes,
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const
+												{
+													return mSQ.cull(nbPlanes, planes, hitCall, filterData, filterCall, flags);
+												}
+		virtual	PxI32							overlapSpheres(PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,
+														PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const
+												{
+													return mSQ.overlapSpheres(nbSpheres, centers, radii, hits, maxNbHits, nbHitsPerQuery, filterData, filterCall, flags);
+												}
+		private:
+				void							addDirtyHandle(PxU32 prunerIndex, PxSQPrunerHandle handle);
+				void							addDirtyBounds(const PxBounds3& bounds);
+				void							flushAll();
+				void							applyInvalidations();
+
+				PxSceneQuerySystem&				mSQ;
+				CacheEntry*						mEntries;
+				PxU32							mMask;
+				PxU32							mRefCount;
+
+				// PT: everything below is protected by mMutex, since queries can run concurrently
+				PxMutex							mMutex;
+				PxArray<PxBounds3>				mDirtyBounds;
+				PxHashSet<PxU64>				mDirtyHandles;
+				PxU32							mNbValidEntries;
+				PxU32							mNbCompounds;
+				PxU32							mChangeStamp;	// Incremented for each recorded change, to reject results computed across a change
+				PxU32							mNbHits;
+				PxU32							mNbMisses;
+				bool							mFlushAll;
+	};
+
+	// PT: stops at the first dirty bounds crossed by the segment
+	struct DirtyBoundsCallback : PxBVH::RaycastCallback
+	{
+						DirtyBoundsCallback() : mHit(false)	{}
+
+		virtual bool	reportHit(PxU32, PxReal&)
+		{
+			mHit = true;
+			return false;
+		}
+
+		bool	mHit;
+	};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void addExternalSQ(PxSceneQuerySystem* added);
+void removeExternalSQ(PxSceneQuerySystem* removed);
+
+CachedPxSQ::CachedPxSQ(PxSceneQuerySystem& sq, PxU32 maxNbEntries) :
+	mSQ				(sq),
+	mRefCount		(1),
+	mNbValidEntries	(0),
+	mNbCompounds	(0),
+	mChangeStamp	(0),
+	mNbHits			(0),
+	mNbMisses		(0),
+	mFlushAll		(false)
+{
+	const PxU32 nbEntries = PxNextPowerOfTwo(PxMax(maxNbEntries, 1u) - 1);
+	mMask = nbEntries - 1;
+	mEntries = PX_ALLOCATE(CacheEntry, nbEntries, "CachedPxSQ entries");
+	for(PxU32 i=0; i<nbEntries; i++)
+		mEntries[i].mValid = false;
+}
+
+CachedPxSQ::~CachedPxSQ()
+{
+	PX_FREE(mEntries);
+	mSQ.release();
+}
+
+void CachedPxSQ::release()
+{
+	mRefCount--;
+	if(!mRefCount)
+	{
+		removeExternalSQ(this);
+		PX_DELETE_THIS;
+	}
+}
+
+void CachedPxSQ::invalidateCache()
+{
+	PxMutex::ScopedLock lock(mMutex);
+	flushAll();
+}
+
+void CachedPxSQ::getCacheStatistics(PxU32& nbHits, PxU32& nbMisses, bool reset)
+{
+	PxMutex::ScopedLock lock(mMutex);
+	nbHits = mNbHits;
+	nbMisses = mNbMisses;
+	if(reset)
+		mNbHits = mNbMisses = 0;
+}
+
+// PT: the following functions run with mMutex held
+
+void CachedPxSQ::addDirtyHandle(PxU32 prunerIndex, PxSQPrunerHandle handle)
+{
+	if(mNbValidEntries && !mFlushAll)
+		mDirtyHandles.insert(encodeHandle(prunerIndex, handle));
+	mChangeStamp++;
+}
+
+void CachedPxSQ::addDirtyBounds(const PxBounds3& bounds)
+{
+	if(mNbValidEntries && !mFlushAll)
+		mDirtyBounds.pushBack(bounds);
+	mChangeStamp++;
+}
+
+void CachedPxSQ::flushAll()
+{
+	mFlushAll = true;
+	mChangeStamp++;
+}
+
+void CachedPxSQ::applyInvalidations()
+{
+	const PxU32 nbEntries = mMask + 1;
+	if(mFlushAll)
+	{
+		for(PxU32 i=0; i<nbEntries; i++)
+			mEntries[i].mValid = false;
+		mNbValidEntries = 0;
+	}
+	else if(mNbValidEntries && (mDirtyHandles.size() || mDirtyBounds.size()))
+	{
+		const PxU32 nbDirtyBounds = mDirtyBounds.size();
+
+		PxBVH* bvh = NULL;
+		if(nbDirtyBounds >= CACHED_SQ_BVH_THRESHOLD)
+		{
+			PxBVHDesc bvhDesc;
+			bvhDesc.bounds.count = nbDirtyBounds;
+			bvhDesc.bounds.data = mDirtyBounds.begin();
+			bvhDesc.bounds.stride = sizeof(PxBounds3);
+			bvh = PxCreateBVH(bvhDesc);
+		}
+
+		for(PxU32 i=0; i<nbEntries; i++)
+		{
+			CacheEntry& entry = mEntries[i];
+			if(!entry.mValid)
+				continue;
+
+			bool invalid = entry.mHasBlock && mDirtyHandles.contains(entry.mHitHandle);
+			if(!invalid && nbDirtyBounds)
+			{
+				const PxReal length = entry.getLength();
+				if(bvh)
+				{
+					// PT: the BVH raycast rejects zero-length rays, which we get for initially overlapping hits
+					DirtyBoundsCallback cb;
+					bvh->raycast(entry.mKey.mOrigin, entry.mKey.mDir, PxMax(length, 1e-4f), cb);
+					invalid = cb.mHit;
+				}
+				else
+				{
+					for(PxU32 j=0; j<nbDirtyBounds && !invalid; j++)
+						invalid = intersectSegmentAABB(entry.mKey.mOrigin, entry.mKey.mDir, length, mDirtyBounds[j]);
+				}
+			}
+
+			if(invalid)
+			{
+				entry.mValid = false;
+				mNbValidEntries--;
+			}
+		}
+
+		if(bvh)
+			bvh->release();
+	}
+
+	mDirtyHandles.clear();
+	mDirtyBounds.clear();
+	mFlushAll = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CachedPxSQ::addSQShape(const PxRigidActor& actor, const PxShape& shape, const PxBounds3& bounds, const PxTransform& transform, const PxSQCompoundHandle* compoundHandle, bool hasPruningStructure)
+{
+	mSQ.addSQShape(actor, shape, bounds, transform, compoundHandle, hasPruningStructure);
+
+	PxMutex::ScopedLock lock(mMutex);
+	if(compoundHandle)
+		flushAll();
+	else
+		addDirtyBounds(bounds);
+}
+
+void CachedPxSQ::removeSQShape(const PxRigidActor& actor, const PxShape& shape)
+{
+	PxU32 prunerIndex;
+	const PxSQPrunerHandle handle = mSQ.getHandle(actor, shape, prunerIndex);
+
+	mSQ.removeSQShape(actor, shape);
+
+	PxMutex::ScopedLock lock(mMutex);
+	addDirtyHandle(prunerIndex, handle);
+}
+
+void CachedPxSQ::updateSQShape(const PxRigidActor& actor, const PxShape& shape, const PxTransform& transform)
+{
+	mSQ.updateSQShape(actor, shape, transform);
+
+	PxMutex::ScopedLock lock(mMutex);
+
+	// PT: the transform of a compound shape is relative to the compound, so we don't have its world bounds
+	if(mNbCompounds)
+	{
+		flushAll();
+		return;
+	}
+
+	PxU32 prunerIndex;
+	const PxSQPrunerHandle handle = mSQ.getHandle(actor, shape, prunerIndex);
+	addDirtyHandle(prunerIndex, handle);
+
+	PxBounds3 bounds;
+	PxGeometryQuery::computeGeomBounds(bounds, shape.getGeometry(), transform);
+	addDirtyBounds(bounds);
+}
+
+PxSQCompoundHandle CachedPxSQ::addSQCompound(const PxRigidActor& actor, const PxShape** shapes, const PxBVH& bvh, const PxTransform* transforms)
+{
+	const PxSQCompoundHandle handle = mSQ.addSQCompound(actor, shapes, bvh, transforms);
+
+	PxMutex::ScopedLock lock(mMutex);
+	mNbCompounds++;
+	flushAll();
+	return handle;
+}
+
+void CachedPxSQ::removeSQCompound(PxSQCompoundHandle compoundHandle)
+{
+	mSQ.removeSQCompound(compoundHandle);
+
+	PxMutex::ScopedLock lock(mMutex);
+	PX_ASSERT(mNbCompounds);
+	mNbCompounds--;
+	flushAll();
+}
+
+void CachedPxSQ::updateSQCompound(PxSQCompoundHandle compoundHandle, const PxTransform& compoundTransform)
+{
+	mSQ.updateSQCompound(compoundHandle, compoundTransform);
+
+	PxMutex::ScopedLock lock(mMutex);
+	flushAll();
+}
+
+void CachedPxSQ::shiftOrigin(const PxVec3& shift)
+{
+	mSQ.shiftOrigin(shift);
+
+	PxMutex::ScopedLock lock(mMutex);
+	flushAll();
+}
+
+void CachedPxSQ::merge(const PxPruningStructure& pruningStructure)
+{
+	mSQ.merge(pruningStructure);
+
+	PxMutex::ScopedLock lock(mMutex);
+	flushAll();
+}
+
+void CachedPxSQ::sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
+						const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices)
+{
+	mSQ.sync(prunerIndex, handles, indices, bounds, transforms, count, ignoredIndices);
+
+	PxMutex::ScopedLock lock(mMutex);
+	for(PxU32 i=0; i<count; i++)
+	{
+		if(ignoredIndices.boundedTest(indices[i]))
+			continue;
+
+		addDirtyHandle(prunerIndex, handles[i]);
+		addDirtyBounds(bounds[indices[i]]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool CachedPxSQ::raycast(	const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
+							PxRaycastCallback& hitCall, PxHitFlags hitFlags,
+							const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+							const PxQueryCache* cache, PxGeometryQueryFlags flags)	const
+{
+	// PT: we only cache queries whose result is fully described by a single blocking hit
+	if(hitCall.maxNbTouches || filterCall || cache)
+		return mSQ.raycast(origin, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, flags);
+
+	CachedPxSQ& self = const_cast<CachedPxSQ&>(*this);
+
+	RaycastKey key;
+	key.mOrigin			= origin;
+	key.mDir			= unitDir;
+	key.mDistance		= distance;
+	key.mHitFlags		= PxU32(hitFlags);
+	key.mQueryFlags		= PxU32(filterData.flags);
+	key.mGeomQueryFlags	= PxU32(flags);
+	key.mFilterData		= filterData.data;
+
+	const PxU32 staticTimestamp = mSQ.getStaticTimestamp();
+	CacheEntry& entry = mEntries[key.computeHash() & mMask];
+
+	PxU32 changeStamp;
+	bool cacheHit;
+	{
+		PxMutex::ScopedLock lock(self.mMutex);
+		self.applyInvalidations();
+
+		cacheHit = entry.mValid && entry.mStaticTimestamp==staticTimestamp && entry.mKey==key;
+		if(cacheHit)
+		{
+			self.mNbHits++;
+			hitCall.hasBlock = entry.mHasBlock;
+			if(entry.mHasBlock)
+				hitCall.block = entry.mBlock;
+			hitCall.nbTouches = 0;
+		}
+		else
+			self.mNbMisses++;
+		changeStamp = mChangeStamp;
+	}
+
+	// PT: user code in the callback could issue queries, so it runs outside of the lock
+	if(cacheHit)
+	{
+		hitCall.finalizeQuery();
+		return hitCall.hasBlock;
+	}
+
+	const bool status = mSQ.raycast(origin, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, flags);
+
+	PxU64 hitHandle = 0;
+	if(hitCall.hasBlock)
+	{
+		PxU32 prunerIndex;
+		const PxSQPrunerHandle handle = mSQ.getHandle(*hitCall.block.actor, *hitCall.block.shape, prunerIndex);
+		hitHandle = encodeHandle(prunerIndex, handle);
+	}
+
+	{
+		PxMutex::ScopedLock lock(self.mMutex);
+
+		// PT: don't store results computed while the scene was changing
+		if(changeStamp==mChangeStamp)
+		{
+			if(!entry.mValid)
+				self.mNbValidEntries++;
+			entry.mKey				= key;
+			entry.mBlock			= hitCall.block;
+			entry.mHitHandle		= hitHandle;
+			entry.mStaticTimestamp	= staticTimestamp;
+			entry.mHasBlock			= hitCall.hasBlock;
+			entry.mValid			= true;
+		}
+	}
+	return status;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxCachedSceneQuerySystem* physx::PxCreateCachedSceneQuerySystem(PxSceneQuerySystem& sqSystem, PxU32 maxNbEntries)
+{
+	CachedPxSQ* pxsq = PX_NEW(CachedPxSQ)(sqSystem, maxNbEntries);
+
+	// PT: the wrapper takes over the creation reference of the wrapped system, which is now released with the wrapper.
+	removeExternalSQ(&sqSystem);
+	addExternalSQ(pxsq);
+
+	return pxsq;
+}
@@ -0,0 +1,369 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxChromeTraceProfiler.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxIO.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxString.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxTime.h"
+#include "foundation/PxUserAllocated.h"
+
+using namespace physx;
+
+namespace
+{
+	struct EventType
+	{
+		enum Enum
+		{
+			eZONE_START,
+			eZONE_END,
+			eZONE_START_CROSS_THREAD,
+			eZONE_END_CROSS_THREAD,
+			eVALUE_INT,
+			eVALUE_FLOAT,
+			eFRAME
+		};
+	};
+
+	struct Event
+	{
+		PxU64		mTime;		// Tens of nanoseconds, see PxTime::getCurrentTimeInTensOfNanoSeconds()
+		PxU64		mContextId;
+		const char*	mName;		// Profiler names are static strings
+		PxU32		mType;
+		PxU32		mFrame;
+		union
+		{
+			PxI32	mIntValue;
+			PxF32	mFloatValue;
+		};
+	};
+
+	struct EventBuffer : public PxUserAllocated
+	{
+		EventBuffer(PxU32 capacity) : mNbEvents(0), mLastFrame(0)
+		{
+			mEvents = PX_ALLOCATE(Event, capacity, "EventBuffer");
+		}
+
+		~EventBuffer()
+		{
+			PX_FREE(mEvents);
+		}
+
+		Event*	mEvents;
+		PxU32	mNbEvents;
+		PxU32	mLastFrame;
+	};
+
+	// PT: only the owner thread writes to its buffers. The buffer list itself is only modified by the owner thread too,
+	// and read by writeTrace()/clear() which must not run concurrently with recording.
+	struct ThreadData : public PxUserAllocated
+	{
+		ThreadData(PxU64 threadId, PxU32 index) : mThreadId(threadId), mIndex(index)	{}
+
+		~ThreadData()
+		{
+			for(PxU32 i=0;i<mBuffers.size();i++)
+				PX_DELETE(mBuffers[i]);
+		}
+
+		PxArray<EventBuffer*>	mBuffers;	// Oldest first, the last one is being recorded
+		PxU64					mThreadId;
+		PxU32					mIndex;
+	};
+
+	class JsonWriter
+	{
+		public:
+							JsonWriter(PxOutputStream& stream) : mStream(stream), mNbEvents(0), mOk(true)	{}
+
+			void			write(const char* text)
+							{
+								const PxU32 length = PxU32(strlen(text));
+								if(mOk && mStream.write(text, length)!=length)
+									mOk = false;
+							}
+
+			// PT: events are separated by commas, the first one is not
+			void			beginEvent()
+							{
+								write(mNbEvents++ ? ",\n{" : "\n{");
+							}
+
+			void			writeName(const char* name)
+							{
+								write("\"name\":\"");
+								char escaped[256];
+								PxU32 i = 0;
+								for(const char* c = name ? name : ""; *c && i<sizeof(escaped)-2; c++)
+								{
+									if(*c=='"' || *c=='\\')
+										escaped[i++] = '\\';
+									escaped[i++] = *c;
+								}
+								escaped[i] = 0;
+								write(escaped);
+								write("\"");
+							}
+
+			bool			isOk()	const	{ return mOk;	}
+
+		private:
+			PxOutputStream&	mStream;
+			PxU32			mNbEvents;
+			bool			mOk;
+	};
+}
+
+namespace physx
+{
+namespace Ext
+{
+class ChromeTraceProfiler : public PxChromeTraceProfiler, public PxUserAllocated
+{
+	PX_NOCOPY(ChromeTraceProfiler)
+public:
+						ChromeTraceProfiler(PxU32 maxNbFrames, PxU32 nbEventsPerBuffer);
+	virtual				~ChromeTraceProfiler();
+
+	virtual void		release()	PX_OVERRIDE	{ PX_DELETE_THIS;	}
+	virtual bool		writeTrace(PxOutputStream& stream)	PX_OVERRIDE;
+	virtual void		clear()	PX_OVERRIDE;
+	virtual PxU32		getFrameIndex()	const	PX_OVERRIDE	{ return PxU32(mFrameIndex);	}
+
+	virtual void*		zoneStart(const char* eventName, bool detached, uint64_t contextId) PX_OVERRIDE;
+	virtual void		zoneEnd(void* profilerData, const char* eventName, bool detached, uint64_t contextId) PX_OVERRIDE;
+	virtual void		recordData(int32_t value, const char* valueName, uint64_t contextId) PX_OVERRIDE;
+	virtual void		recordData(float value, const char* valueName, uint64_t contextId) PX_OVERRIDE;
+	virtual void		recordFrame(const char* name, uint64_t contextId) PX_OVERRIDE;
+
+private:
+	ThreadData*			getThreadData();
+	Event&				writeEvent(const char* name, EventType::Enum type, PxU64 contextId);
+	PX_FORCE_INLINE	bool	isInWindow(PxU32 frame)	const	{ return !mMaxNbFrames || frame + mMaxNbFrames >= PxU32(mFrameIndex);	}
+
+	PxMutex					mMutex;
+	PxArray<ThreadData*>	mThreads;
+	PxU32					mTlsSlotId;
+	PxU32					mMaxNbFrames;
+	PxU32					mNbEventsPerBuffer;
+	volatile PxI32			mFrameIndex;
+};
+}
+}
+
+PxChromeTraceProfiler* physx::PxChromeTraceProfilerCreate(PxU32 maxNbFrames, PxU32 nbEventsPerBuffer)
+{
+	return PX_NEW(Ext::ChromeTraceProfiler)(maxNbFrames, nbEventsPerBuffer);
+}
+
+Ext::ChromeTraceProfiler::ChromeTraceProfiler(PxU32 maxNbFrames, PxU32 nbEventsPerBuffer) :
+	mMaxNbFrames		(maxNbFrames),
+	mNbEventsPerBuffer	(PxMax(nbEventsPerBuffer, 64u)),
+	mFrameIndex			(0)
+{
+	mTlsSlotId = PxTlsAlloc();
+}
+
+Ext::ChromeTraceProfiler::~ChromeTraceProfiler()
+{
+	for(PxU32 i=0;i<mThreads.size();i++)
+		PX_DELETE(mThreads[i]);
+	PxTlsFree(mTlsSlotId);
+}
+
+ThreadData* Ext::ChromeTraceProfiler::getThreadData()
+{
+	ThreadData* threadData = reinterpret_cast<ThreadData*>(PxTlsGet(mTlsSlotId));
+	if(!threadData)
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		threadData = PX_NEW(ThreadData)(PxU64(PxThread::getId()), mThreads.size());
+		mThreads.pushBack(threadData);
+		PxTlsSet(mTlsSlotId, threadData);
+	}
+	return threadData;
+}
+
+Event& Ext::ChromeTraceProfiler::writeEvent(const char* name, EventType::Enum type, PxU64 contextId)
+{
+	ThreadData* threadData = getThreadData();
+	const PxU32 frame = PxU32(mFrameIndex);
+
+	EventBuffer* buffer = threadData->mBuffers.size() ? threadData->mBuffers.back() : NULL;
+	if(!buffer || buffer->mNbEvents==mNbEventsPerBuffer)
+	{
+		// PT: in ring-buffer mode, the oldest buffer is recycled once all its events are out of the frame window
+		EventBuffer* oldest = threadData->mBuffers.size()>1 ? threadData->mBuffers[0] : NULL;
+		if(oldest && !isInWindow(oldest->mLastFrame))
+		{
+			threadData->mBuffers.remove(0);
+			oldest->mNbEvents = 0;
+			buffer = oldest;
+		}
+		else
+			buffer = PX_NEW(EventBuffer)(mNbEventsPerBuffer);
+		threadData->mBuffers.pushBack(buffer);
+	}
+
+	Event& event = buffer->mEvents[buffer->mNbEvents++];
+	buffer->mLastFrame = frame;
+	event.mTime			= PxTime::getCurrentTimeInTensOfNanoSeconds();
+	event.mContextId	= contextId;
+	event.mName			= name;
+	event.mType			= type;
+	event.mFrame		= frame;
+	return event;
+}
+
+void* Ext::ChromeTraceProfiler::zoneStart(const char* eventName, bool detached, uint64_t contextId)
+{
+	writeEvent(eventName, detached ? EventType::eZONE_START_CROSS_THREAD : EventType::eZONE_START, contextId);
+	return NULL;
+}
+
+void Ext::ChromeTraceProfiler::zoneEnd(void*, const char* eventName, bool detached, uint64_t contextId)
+{
+	writeEvent(eventName, detached ? EventType::eZONE_END_CROSS_THREAD : EventType::eZONE_END, contextId);
+}
+
+void Ext::ChromeTraceProfiler::recordData(int32_t value, const char* valueName, uint64_t contextId)
+{
+	writeEvent(valueName, EventType::eVALUE_INT, contextId).mIntValue = value;
+}
+
+void Ext::ChromeTraceProfiler::recordData(float value, const char* valueName, uint64_t contextId)
+{
+	writeEvent(valueName, EventType::eVALUE_FLOAT, contextId).mFloatValue = value;
+}
+
+void Ext::ChromeTraceProfiler::recordFrame(const char* name, uint64_t contextId)
+{
+	// PT: the marker belongs to the frame it starts
+	PxAtomicIncrement(&mFrameIndex);
+	writeEvent(name, EventType::eFRAME, contextId);
+}
+
+void Ext::ChromeTraceProfiler::clear()
+{
+	for(PxU32 i=0;i<mThreads.size();i++)
+	{
+		ThreadData* threadData = mThreads[i];
+		// PT: keep a single buffer per thread, as recording expects the last one to be the current one
+		while(threadData->mBuffers.size()>1)
+		{
+			PX_DELETE(threadData->mBuffers.back());
+			threadData->mBuffers.popBack();
+		}
+		if(threadData->mBuffers.size())
+			threadData->mBuffers[0]->mNbEvents = 0;
+	}
+}
+
+bool Ext::ChromeTraceProfiler::writeTrace(PxOutputStream& stream)
+{
+	JsonWriter writer(stream);
+	char text[256];
+
+	writer.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+	for(PxU32 t=0;t<mThreads.size();t++)
+	{
+		const ThreadData* threadData = mThreads[t];
+		const unsigned long long tid = threadData->mThreadId;
+
+		writer.beginEvent();
+		Pxsnprintf(text, sizeof(text), "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%llu,\"args\":{\"name\":\"Thread %u\"}}", tid, threadData->mIndex);
+		writer.write(text);
+
+		// PT: in ring-buffer mode the window can start in the middle of a zone. Ends without a recorded start are skipped
+		// so that the thread's zone stack stays balanced.
+		PxU32 depth = 0;
+		for(PxU32 b=0;b<threadData->mBuffers.size();b++)
+		{
+			const EventBuffer* buffer = threadData->mBuffers[b];
+			for(PxU32 e=0;e<buffer->mNbEvents;e++)
+			{
+				const Event& event = buffer->mEvents[e];
+				if(!isInWindow(event.mFrame))
+					continue;
+
+				const char* phase;
+				switch(event.mType)
+				{
+					case EventType::eZONE_START:				phase = "B";	depth++;	break;
+					case EventType::eZONE_END:
+						if(!depth)
+							continue;
+						phase = "E";
+						depth--;
+						break;
+					case EventType::eZONE_START_CROSS_THREAD:	phase = "b";	break;
+					case EventType::eZONE_END_CROSS_THREAD:		phase = "e";	break;
+					case EventType::eVALUE_INT:
+					case EventType::eVALUE_FLOAT:				phase = "C";	break;
+					default:									phase = "i";	break;
+				}
+
+				writer.beginEvent();
+				writer.writeName(event.mName);
+				Pxsnprintf(text, sizeof(text), ",\"ph\":\"%s\",\"ts\":%llu.%02llu,\"pid\":1,\"tid\":%llu", phase,
+					static_cast<unsigned long long>(event.mTime / 100), static_cast<unsigned long long>(event.mTime % 100), tid);
+				writer.write(text);
+
+				switch(event.mType)
+				{
+					case EventType::eZONE_START_CROSS_THREAD:
+					case EventType::eZONE_END_CROSS_THREAD:
+						Pxsnprintf(text, sizeof(text), ",\"cat\":\"crossThread\",\"id\":\"0x%llx\"}", static_cast<unsigned long long>(event.mContextId));
+						break;
+					case EventType::eVALUE_INT:
+						Pxsnprintf(text, sizeof(text), ",\"args\":{\"value\":%d}}", event.mIntValue);
+						break;
+					case EventType::eVALUE_FLOAT:
+						Pxsnprintf(text, sizeof(text), ",\"args\":{\"value\":%g}}", double(event.mFloatValue));
+						break;
+					case EventType::eFRAME:
+						Pxsnprintf(text, sizeof(text), ",\"s\":\"g\",\"args\":{\"frame\":%u}}", event.mFrame);
+						break;
+					default:
+						Pxsnprintf(text, sizeof(text), ",\"args\":{\"context\":%llu}}", static_cast<unsigned long long>(event.mContextId));
+						break;
+				}
+				writer.write(text);
+			}
+		}
+	}
+
+	writer.write("\n]}\n");
+	return writer.isOk();
+}
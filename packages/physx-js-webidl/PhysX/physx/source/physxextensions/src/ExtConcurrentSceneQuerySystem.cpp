@@ -0,0 +1,305 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxSceneQuerySystemExt.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxUserAllocated.h"
+
+// PT: this file implements a thin wrapper around an existing scene-query system, making it safe to run queries on
+// user threads while the owning scene simulates and fetches its results. The pruners are not modified during simulate()
+// (user updates are buffered by PxScene, and tree rebuilds happen in a separate tree), so queries running at that time
+// already see the previous frame. The only problem is the synchronization in fetchResults(), which updates the pruners
+// in place. The wrapper protects the pruners with a read-write lock, and treats the whole bounds sync done in
+// fetchResults() (from beginSync() to finalizeUpdates(), including the compound updates) as a single write, so that queries either see the
+// previous frame or the new one, but never a partially updated frame.
+
+using namespace physx;
+
+namespace
+{
+	class ConcurrentPxSQ : public PxSceneQuerySystem, public PxUserAllocated
+	{
+		public:
+												ConcurrentPxSQ(PxSceneQuerySystem& sq) : mSQ(sq), mSyncThread(0), mRefCount(1)	{}
+		virtual									~ConcurrentPxSQ()																{ mSQ.release();			}
+
+		virtual	void							release();
+		virtual	void							acquireReference()	{ mRefCount++;	}
+
+		// PT: mutations are single writes...
+		virtual	void							preallocate(PxU32 prunerIndex, PxU32 nbShapes)
+												{
+													WriteLock lock(*this);
+													mSQ.preallocate(prunerIndex, nbShapes);
+												}
+		virtual	void							flushMemory()
+												{
+													WriteLock lock(*this);
+													mSQ.flushMemory();
+												}
+		virtual	void							addSQShape(	const PxRigidActor& actor, const PxShape& shape, const PxBounds3& bounds,
+															const PxTransform& transform, const PxSQCompoundHandle* compoundHandle, bool hasPruningStructure)
+												{
+													WriteLock lock(*this);
+													mSQ.addSQShape(actor, shape, bounds, transform, compoundHandle, hasPruningStructure);
+												}
+		virtual	void							removeSQShape(const PxRigidActor& actor, const PxShape& shape)
+												{
+													WriteLock lock(*this);
+													mSQ.removeSQShape(actor, shape);
+												}
+		virtual	void							updateSQShape(const PxRigidActor& actor, const PxShape& shape, const PxTransform& transform)
+												{
+													WriteLock lock(*this);
+													mSQ.updateSQShape(actor, shape, transform);
+												}
+		virtual	PxSQCompoundHandle				addSQCompound(const PxRigidActor& actor, const PxShape** shapes, const PxBVH& bvh, const PxTransform* transforms)
+												{
+													WriteLock lock(*this);
+													return mSQ.addSQCompound(actor, shapes, bvh, transforms);
+												}
+		virtual	void							removeSQCompound(PxSQCompoundHandle compoundHandle)
+												{
+													WriteLock lock(*this);
+													mSQ.removeSQCompound(compoundHandle);
+												}
+		virtual	void							updateSQCompound(PxSQCompoundHandle compoundHandle, const PxTransform& compoundTransform)
+												{
+													WriteLock lock(*this);
+													mSQ.updateSQCompound(compoundHandle, compoundTransform);
+												}
+		virtual	void							shiftOrigin(const PxVec3& shift)
+												{
+													WriteLock lock(*this);
+													mSQ.shiftOrigin(shift);
+												}
+		virtual	void							merge(const PxPruningStructure& pruningStructure)
+												{
+													WriteLock lock(*this);
+													mSQ.merge(pruningStructure);
+												}
+		virtual	void							flushUpdates()
+												{
+													WriteLock lock(*this);
+													mSQ.flushUpdates();
+												}
+		virtual	void							forceRebuildDynamicTree(PxU32 prunerIndex)
+												{
+													WriteLock lock(*this);
+													mSQ.forceRebuildDynamicTree(prunerIndex);
+												}
+		virtual	PxSQBuildStepHandle				prepareSceneQueryBuildStep(PxU32 prunerIndex)
+												{
+													WriteLock lock(*this);
+													return mSQ.prepareSceneQueryBuildStep(prunerIndex);
+												}
+
+		// PT: ...except for the fetchResults() sync, which is a single write from beginSync() to finalizeUpdates(). The compound
+		// updates it makes go through updateSQCompound() above, whose WriteLock is a no-op while the sync thread owns the lock.
+		virtual	void							beginSync();
+		virtual	void							sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
+													const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices);
+		virtual	void							finalizeUpdates();
+
+		// PT: the build step only touches the pruner's new tree, queries can safely run concurrently with it.
+		virtual	void							sceneQueryBuildStep(PxSQBuildStepHandle handle)									{ mSQ.sceneQueryBuildStep(handle);							}
+
+		virtual	void							setDynamicTreeRebuildRateHint(PxU32 dynamicTreeRebuildRateHint)					{ mSQ.setDynamicTreeRebuildRateHint(dynamicTreeRebuildRateHint);	}
+		virtual	PxU32							getDynamicTreeRebuildRateHint()							const					{ return mSQ.getDynamicTreeRebuildRateHint();				}
+		virtual	void							setUpdateMode(PxSceneQueryUpdateMode::Enum updateMode)							{ mSQ.setUpdateMode(updateMode);							}
+		virtual	PxSceneQueryUpdateMode::Enum	getUpdateMode()											const					{ return mSQ.getUpdateMode();								}
+
+		// PT: reads
+		virtual	PxU32							getStaticTimestamp()									const
+												{
+													ReadLock lock(*this);
+													return mSQ.getStaticTimestamp();
+												}
+		virtual	void							visualize(PxU32 prunerIndex, PxRenderOutput& out)		const
+												{
+													ReadLock lock(*this);
+													mSQ.visualize(prunerIndex, out);
+												}
+		virtual	PxSQPrunerHandle				getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const
+												{
+													ReadLock lock(*this);
+													return mSQ.getHandle(actor, shape, prunerIndex);
+												}
+		virtual	bool							raycast(const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
+														PxRaycastCallback& hitCall, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const
+												{
+													ReadLock lock(*this);
+													return mSQ.raycast(origin, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, flags);
+												}
+		virtual	bool							sweep(	const PxGeometry& geometry, const PxTransform& pose,
+														const PxVec3& unitDir, const PxReal distance,
+														PxSweepCallback& hitCall, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, const PxReal inflation, PxGeometryQueryFlags flags)	const
+												{
+													ReadLock lock(*this);
+													return mSQ.sweep(geometry, pose, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, inflation, flags);
+												}
+		virtual	bool							overlap(const PxGeometry& geometry, const PxTransform& transform,
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const
+												{
+													ReadLock lock(*this);
+													return mSQ.overlap(geometry, transform, hitCall, filterData, filterCall, cache, flags);
+												}
+		virtual	bool							cull(PxU32 nbPlanes, const PxPlane* planes,
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const
+												{
+													ReadLock lock(*this);
+													return mSQ.cull(nbPlanes, planes, hitCall, filterData, filterCall, flags);
+												}
+		virtual	PxI32							overlapSpheres(PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,
+														PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const
+												{
+													ReadLock lock(*this);
+													return mSQ.overlapSpheres(nbSpheres, centers, radii, hits, maxNbHits, nbHitsPerQuery, filterData, filterCall, flags);
+												}
+		private:
+		struct ReadLock
+		{
+			PX_NOCOPY(ReadLock)
+			public:
+			PX_FORCE_INLINE	ReadLock(const ConcurrentPxSQ& owner) : mOwner(const_cast<ConcurrentPxSQ&>(owner))
+			{
+				// PT: queries issued by the scene itself while it owns the write lock (e.g. from a filter callback
+				// during the sync) must not wait for it.
+				mTakeLock = !owner.ownsSyncLock();
+				if(mTakeLock)
+					mOwner.mLock.lockReader(true);
+			}
+			PX_FORCE_INLINE	~ReadLock()
+			{
+				if(mTakeLock)
+					mOwner.mLock.unlockReader();
+			}
+			ConcurrentPxSQ&	mOwner;
+			bool			mTakeLock;
+		};
+
+		struct WriteLock
+		{
+			PX_NOCOPY(WriteLock)
+			public:
+			PX_FORCE_INLINE	WriteLock(ConcurrentPxSQ& owner) : mOwner(owner)
+			{
+				mTakeLock = !owner.ownsSyncLock();
+				if(mTakeLock)
+					mOwner.mLock.lockWriter();
+			}
+			PX_FORCE_INLINE	~WriteLock()
+			{
+				if(mTakeLock)
+					mOwner.mLock.unlockWriter();
+			}
+			ConcurrentPxSQ&	mOwner;
+			bool			mTakeLock;
+		};
+
+		PX_FORCE_INLINE	bool					ownsSyncLock()	const	{ return mSyncThread && mSyncThread==PxThread::getId();	}
+
+				PxSceneQuerySystem&				mSQ;
+				PxReadWriteLock					mLock;
+				volatile PxThread::Id			mSyncThread;	// Thread currently holding the write lock for the fetchResults() sync, or 0
+				PxU32							mRefCount;
+	};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void addExternalSQ(PxSceneQuerySystem* added);
+void removeExternalSQ(PxSceneQuerySystem* removed);
+
+void ConcurrentPxSQ::release()
+{
+	mRefCount--;
+	if(!mRefCount)
+	{
+		removeExternalSQ(this);
+		PX_DELETE_THIS;
+	}
+}
+
+void ConcurrentPxSQ::beginSync()
+{
+	// PT: the lock is released in finalizeUpdates(), which always ends the fetchResults() sync.
+	if(!ownsSyncLock())
+	{
+		mLock.lockWriter();
+		mSyncThread = PxThread::getId();
+	}
+	mSQ.beginSync();
+}
+
+void ConcurrentPxSQ::sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
+							const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices)
+{
+	// PT: the scene calls beginSync() first, this only covers users driving sync() directly.
+	if(!ownsSyncLock())
+	{
+		mLock.lockWriter();
+		mSyncThread = PxThread::getId();
+	}
+	mSQ.sync(prunerIndex, handles, indices, bounds, transforms, count, ignoredIndices);
+}
+
+void ConcurrentPxSQ::finalizeUpdates()
+{
+	if(ownsSyncLock())
+	{
+		mSQ.finalizeUpdates();
+		mSyncThread = 0;
+		mLock.unlockWriter();
+	}
+	else
+	{
+		WriteLock lock(*this);
+		mSQ.finalizeUpdates();
+	}
+}
+
+PxSceneQuerySystem* physx::PxCreateConcurrentSceneQuerySystem(PxSceneQuerySystem& sqSystem)
+{
+	ConcurrentPxSQ* pxsq = PX_NEW(ConcurrentPxSQ)(sqSystem);
+
+	// PT: the wrapper takes over the creation reference of the wrapped system, which is now released with the wrapper.
+	removeExternalSQ(&sqSystem);
+	addExternalSQ(pxsq);
+
+	return pxsq;
+}
@@ -0,0 +1,100 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxCooperativeCpuDispatcher.h"
+#include "common/PxProfileZone.h"
+#include "task/PxTask.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxTime.h"
+#include "foundation/PxUserAllocated.h"
+
+using namespace physx;
+
+namespace
+{
+	class CooperativeCpuDispatcher : public PxCooperativeCpuDispatcher, public PxUserAllocated
+	{
+												PX_NOCOPY(CooperativeCpuDispatcher)
+	public:
+												CooperativeCpuDispatcher()	{}
+	private:
+												~CooperativeCpuDispatcher()	{}
+	public:
+		// PxCpuDispatcher
+		virtual			void					submitTask(PxBaseTask& task)	PX_OVERRIDE
+												{
+													if(task.isHighPriority())
+														mHighPriorityTasks.pushBack(&task);
+													else
+														mTasks.pushBack(&task);
+												}
+		virtual			PxU32					getWorkerCount()	const		PX_OVERRIDE	{ return 0;	}
+		//~PxCpuDispatcher
+
+		// PxCooperativeCpuDispatcher
+		virtual			void					release()						PX_OVERRIDE	{ PX_DELETE_THIS;	}
+		virtual			bool					runSlice(PxU32 budgetMicroseconds)	PX_OVERRIDE;
+		virtual			PxU32					getNbPendingTasks()	const		PX_OVERRIDE	{ return mHighPriorityTasks.size() + mTasks.size();	}
+		//~PxCooperativeCpuDispatcher
+
+	private:
+		// PT: LIFO, i.e. depth-first like the inline execution of a 0-thread PxDefaultCpuDispatcher
+						PxArray<PxBaseTask*>	mHighPriorityTasks;
+						PxArray<PxBaseTask*>	mTasks;
+	};
+}
+
+bool CooperativeCpuDispatcher::runSlice(PxU32 budgetMicroseconds)
+{
+	const PxU64 startTime = PxTime::getCurrentTimeInTensOfNanoSeconds();
+	const PxU64 budget = PxU64(budgetMicroseconds) * 100;
+
+	for(;;)
+	{
+		PxBaseTask* task;
+		if(mHighPriorityTasks.size())
+			task = mHighPriorityTasks.popBack();
+		else if(mTasks.size())
+			task = mTasks.popBack();
+		else
+			return false;
+
+		{
+			PX_PROFILE_ZONE(task->getName(), task->getContextId());
+			task->run();
+		}
+		task->release();
+
+		if(PxTime::getCurrentTimeInTensOfNanoSeconds() - startTime >= budget)
+			break;
+	}
+	return getNbPendingTasks() != 0;
+}
+
+PxCooperativeCpuDispatcher* physx::PxCooperativeCpuDispatcherCreate()
+{
+	return PX_NEW(CooperativeCpuDispatcher)();
+}
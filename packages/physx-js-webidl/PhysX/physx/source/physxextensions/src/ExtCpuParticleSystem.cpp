@@ -0,0 +1,284 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxCpuParticleSystem.h"
+#include "extensions/PxParallelFor.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxUserAllocated.h"
+#include "geometry/PxSphereGeometry.h"
+#include "PxScene.h"
+#include "PxSceneLock.h"
+
+using namespace physx;
+
+// PT: number of particles per PxParallelFor chunk. Each particle runs a sweep so chunks don't need to be large.
+#define CPU_PARTICLES_GRAIN	256
+
+namespace
+{
+	enum ParticleState
+	{
+		eAWAKE,
+		eSLEEPING,
+		eEXPIRED
+	};
+}
+
+namespace physx
+{
+class CpuParticleSystemInternal : public PxParallelForCallback, public PxUserAllocated
+{
+	PX_NOCOPY(CpuParticleSystemInternal)
+	public:
+				CpuParticleSystemInternal(PxScene& scene, const PxCpuParticleSystemParams& params) :
+					mScene(scene), mParams(params), mDt(0.0f), mNbSleeping(0), mNbExpired(0)
+				{
+					mPositions.reserve(params.maxParticles);
+					mVelocities.reserve(params.maxParticles);
+					mAges.reserve(params.maxParticles);
+					mStates.reserve(params.maxParticles);
+				}
+		virtual	~CpuParticleSystemInternal()	{}
+
+		void	removeParticle(PxU32 index)
+		{
+			if(mStates[index] == eSLEEPING)
+				mNbSleeping--;
+			mPositions.replaceWithLast(index);
+			mVelocities.replaceWithLast(index);
+			mAges.replaceWithLast(index);
+			mStates.replaceWithLast(index);
+		}
+
+		// PxParallelForCallback
+		virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+		{
+			// PT: scene queries from several threads are fine as long as each one holds a read lock
+			PxSceneReadLock lock(mScene);
+
+			const PxCpuParticleSystemParams& params = mParams;
+			const PxReal dt = mDt;
+			const PxVec3 gravity = mGravity;
+			const PxReal dampingCoeff = PxMax(1.0f - params.damping * dt, 0.0f);
+			const PxReal sleepSpeed2 = params.sleepSpeed * params.sleepSpeed;
+			const PxSphereGeometry sphere(params.radius);
+
+			PxI32 nbSleeping = 0;
+			PxI32 nbExpired = 0;
+			for(PxU32 i=startIndex;i<endIndex;i++)
+			{
+				const PxReal age = mAges[i] + dt;
+				mAges[i] = age;
+				if(params.lifetime > 0.0f && age > params.lifetime)
+				{
+					if(mStates[i] == eSLEEPING)
+						nbSleeping--;
+					mStates[i] = PxU8(eEXPIRED);
+					nbExpired++;
+					continue;
+				}
+
+				if(mStates[i] == eSLEEPING)
+					continue;
+
+				// PT: position-based step: integrate the velocity, move to the predicted position, then derive the
+				// velocity from the collision response.
+				PxVec3 velocity = (mVelocities[i] + gravity * dt) * dampingCoeff;
+				PxVec3 position = mPositions[i];
+				const PxVec3 motion = velocity * dt;
+				const PxReal distance = motion.magnitude();
+				if(distance > 1e-6f)
+				{
+					const PxVec3 dir = motion / distance;
+					PxSweepBuffer hit;
+					if(mScene.sweep(sphere, PxTransform(position), dir, distance, hit, PxHitFlag::eNORMAL | PxHitFlag::eMTD, params.filterData) && hit.hasBlock)
+					{
+						const PxVec3 normal = hit.block.normal;
+						// PT: negative distances are initial overlaps, for which eMTD gives the depenetration
+						if(hit.block.distance < 0.0f)
+							position += normal * (-hit.block.distance);
+						else
+							position += dir * hit.block.distance;
+
+						const PxReal normalSpeed = velocity.dot(normal);
+						if(normalSpeed < 0.0f)
+						{
+							const PxVec3 tangentVelocity = velocity - normal * normalSpeed;
+							velocity = tangentVelocity * (1.0f - params.friction) - normal * (normalSpeed * params.restitution);
+						}
+
+						if(velocity.magnitudeSquared() < sleepSpeed2)
+						{
+							velocity = PxVec3(0.0f);
+							mStates[i] = PxU8(eSLEEPING);
+							nbSleeping++;
+						}
+					}
+					else
+					{
+						position += motion;
+					}
+				}
+				mPositions[i] = position;
+				mVelocities[i] = velocity;
+			}
+
+			if(nbSleeping)
+				PxAtomicAdd(&mNbSleeping, nbSleeping);
+			if(nbExpired)
+				PxAtomicAdd(&mNbExpired, nbExpired);
+		}
+		//~PxParallelForCallback
+
+		PxScene&					mScene;
+		const PxCpuParticleSystemParams	mParams;
+		PxVec3						mGravity;
+		PxReal						mDt;
+		volatile PxI32				mNbSleeping;
+		volatile PxI32				mNbExpired;
+		PxArray<PxVec3>				mPositions;
+		PxArray<PxVec3>				mVelocities;
+		PxArray<PxReal>				mAges;
+		PxArray<PxU8>				mStates;
+};
+}
+
+PxCpuParticleSystem::PxCpuParticleSystem(PxScene& scene, const PxCpuParticleSystemParams& params)
+{
+	PX_ASSERT(params.isValid());
+	mImpl = PX_NEW(CpuParticleSystemInternal)(scene, params);
+}
+
+PxCpuParticleSystem::~PxCpuParticleSystem()
+{
+	PX_DELETE(mImpl);
+}
+
+PxU32 PxCpuParticleSystem::addParticles(const PxVec3* positions, const PxVec3* velocities, PxU32 nb)
+{
+	CpuParticleSystemInternal& impl = *mImpl;
+	nb = PxMin(nb, impl.mParams.maxParticles - impl.mPositions.size());
+	for(PxU32 i=0;i<nb;i++)
+	{
+		impl.mPositions.pushBack(positions[i]);
+		impl.mVelocities.pushBack(velocities ? velocities[i] : PxVec3(0.0f));
+		impl.mAges.pushBack(0.0f);
+		impl.mStates.pushBack(PxU8(eAWAKE));
+	}
+	return nb;
+}
+
+void PxCpuParticleSystem::removeParticle(PxU32 index)
+{
+	PX_ASSERT(index < mImpl->mPositions.size());
+	mImpl->removeParticle(index);
+}
+
+void PxCpuParticleSystem::clear()
+{
+	mImpl->mPositions.clear();
+	mImpl->mVelocities.clear();
+	mImpl->mAges.clear();
+	mImpl->mStates.clear();
+	mImpl->mNbSleeping = 0;
+}
+
+PxU32 PxCpuParticleSystem::wakeParticles(const PxBounds3& bounds)
+{
+	CpuParticleSystemInternal& impl = *mImpl;
+	PxBounds3 inflated = bounds;
+	inflated.fattenFast(impl.mParams.radius);
+	PxU32 nbWoken = 0;
+	const PxU32 nb = impl.mPositions.size();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		if(impl.mStates[i] == eSLEEPING && inflated.contains(impl.mPositions[i]))
+		{
+			impl.mStates[i] = PxU8(eAWAKE);
+			nbWoken++;
+		}
+	}
+	impl.mNbSleeping -= PxI32(nbWoken);
+	return nbWoken;
+}
+
+void PxCpuParticleSystem::simulate(PxReal dt, PxCpuDispatcher* dispatcher)
+{
+	CpuParticleSystemInternal& impl = *mImpl;
+	if(dt <= 0.0f || impl.mPositions.empty())
+		return;
+
+	{
+		PxSceneReadLock lock(impl.mScene);
+		impl.mGravity = impl.mScene.getGravity();
+	}
+	impl.mDt = dt;
+	impl.mNbExpired = 0;
+
+	PxParallelFor(dispatcher, impl.mPositions.size(), CPU_PARTICLES_GRAIN, impl);
+
+	// PT: expired particles are removed serially, going backwards so that the particles moved into their slots have already been checked
+	if(impl.mNbExpired)
+	{
+		for(PxU32 i=impl.mPositions.size();i--;)
+		{
+			if(impl.mStates[i] == eEXPIRED)
+				impl.removeParticle(i);
+		}
+	}
+}
+
+PxU32 PxCpuParticleSystem::getNbParticles() const
+{
+	return mImpl->mPositions.size();
+}
+
+PxU32 PxCpuParticleSystem::getNbSleeping() const
+{
+	return PxU32(mImpl->mNbSleeping);
+}
+
+const PxVec3* PxCpuParticleSystem::getPositions() const
+{
+	return mImpl->mPositions.begin();
+}
+
+const PxVec3* PxCpuParticleSystem::getVelocities() const
+{
+	return mImpl->mVelocities.begin();
+}
+
+const PxReal* PxCpuParticleSystem::getAges() const
+{
+	return mImpl->mAges.begin();
+}
+
+const PxCpuParticleSystemParams& PxCpuParticleSystem::getParams() const
+{
+	return mImpl->mParams;
+}
@@ -30,10 +30,20 @@
 #include "ExtCpuWorkerThread.h"
 #include "ExtDefaultCpuDispatcher.h"
 #include "foundation/PxFPU.h"
+#include "foundation/PxFoundation.h"
 
 using namespace physx;
 
-Ext::CpuWorkerThread::CpuWorkerThread() : mOwner(NULL), mThreadId(0)
+#if PX_DEBUG || PX_CHECKED || PX_PROFILE
+	#define EXT_PROFILE_WORKERS	1
+#else
+	#define EXT_PROFILE_WORKERS	0
+#endif
+
+static const char* gIdleZoneName		= "PxDefaultCpuDispatcher.idle";
+static const char* gStolenTaskZoneName	= "PxDefaultCpuDispatcher.stolenTask";
+
+Ext::CpuWorkerThread::CpuWorkerThread() : mOwner(NULL), mThreadId(0), mRandomState(1), mSpinBudget(1), mIdleProfiler(NULL), mIdleProfilerData(NULL), mQueueDepthName(NULL)
 {
 }
 
@@ -52,26 +62,22 @@ void Ext::CpuWorkerThread::execute()
 
 	while(!quitIsSignalled())
     {
-		if(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == ownerWaitForWorkMode)
+		if(mOwner->usesWakeSignal())
 			mOwner->resetWakeSignal();
 
-		// PT: look for high priority tasks first, across threads
-		PxBaseTask* task = getJob<HighPriority>();
-		if(!task)
-			task = mOwner->fetchNextTask<HighPriority>();
-
-		// PT: then look for regular tasks
-		if(!task)
-			task = getJob<RegularPriority>();
-		if(!task)
-			task = mOwner->fetchNextTask<RegularPriority>();
+		bool stolen;
+		PxBaseTask* task = fetchTask(stolen);
 
 		if(task)
 		{
-			mOwner->runTask(*task);
-			task->release();
+			runTask(*task, stolen);
+			continue;
 		}
-		else if(PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == ownerWaitForWorkMode)
+
+		// PT: no work found, opens an idle zone that the next runTask() call closes
+		beginIdle();
+
+		if(PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == ownerWaitForWorkMode)
 		{
 			PxThread::yield();
 		}
@@ -81,6 +87,40 @@ void Ext::CpuWorkerThread::execute()
 			for(PxU32 j = 0; j < pauseCounter; j++)
 				PxThread::yieldProcesor();
 		}
+		else if(PxDefaultCpuDispatcherWaitForWorkMode::eADAPTIVE == ownerWaitForWorkMode)
+		{
+			// PT: spin for the learned budget while a step is running, then park. The budget doubles when spinning
+			// finds work and halves when it doesn't, so it tracks the typical gap between simulation stages.
+			const PxU32 maxSpinBudget = mOwner->getYieldProcessorCount();
+			PxU32 nbSpins = 0;
+			if(mOwner->isStepActive())
+			{
+				const PxU32 budget = mSpinBudget;
+				while(nbSpins < budget)
+				{
+					PxThread::yieldProcesor();
+					nbSpins++;
+					task = fetchTask(stolen);
+					if(task)
+						break;
+				}
+			}
+
+			if(task)
+			{
+				const PxU32 newBudget = nbSpins * 2;
+				if(newBudget > mSpinBudget)
+					mSpinBudget = newBudget < maxSpinBudget ? newBudget : maxSpinBudget;
+
+				runTask(*task, stolen);
+			}
+			else
+			{
+				if(nbSpins)
+					mSpinBudget = mSpinBudget > 1 ? mSpinBudget >> 1 : 1;
+				mOwner->waitForWork();
+			}
+		}
 		else
 		{
 			PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == ownerWaitForWorkMode);
@@ -88,5 +128,72 @@ void Ext::CpuWorkerThread::execute()
 		}
 	}
 
+	endIdle();
+
 	quit();
 }
+
+PxBaseTask* Ext::CpuWorkerThread::fetchTask(bool& stolen)
+{
+	stolen = false;
+
+	// PT: look for high priority tasks first, across threads
+	PxBaseTask* task = getJob<HighPriority>();
+	if(!task)
+		task = mOwner->fetchNextTask<HighPriority>(getRandom(), stolen);
+
+	// PT: then look for regular tasks
+	if(!task)
+		task = getJob<RegularPriority>();
+	if(!task)
+		task = mOwner->fetchNextTask<RegularPriority>(getRandom(), stolen);
+
+	return task;
+}
+
+void Ext::CpuWorkerThread::runTask(PxBaseTask& task, bool stolen)
+{
+#if EXT_PROFILE_WORKERS
+	if(mOwner->getRunProfiled())
+	{
+		endIdle();
+
+		PxProfilerCallback* profiler = PxGetProfilerCallback();
+		if(profiler && mQueueDepthName)
+			profiler->recordData(PxI32(mHighPriorityDeque.getApproxSize() + mDeque.getApproxSize()), mQueueDepthName, 0);
+
+		// PT: stolen tasks are wrapped in an extra zone so that steals show up on the worker's timeline
+		{
+			PxProfileScoped stolenZone(stolen ? profiler : NULL, gStolenTaskZoneName, false, task.getContextId());
+			mOwner->runTask(task);
+		}
+		task.release();
+		return;
+	}
+#endif
+	PX_UNUSED(stolen);
+	mOwner->runTask(task);
+	task.release();
+}
+
+void Ext::CpuWorkerThread::beginIdle()
+{
+#if EXT_PROFILE_WORKERS
+	if(!mIdleProfiler && mOwner->getRunProfiled())
+	{
+		mIdleProfiler = PxGetProfilerCallback();
+		if(mIdleProfiler)
+			mIdleProfilerData = mIdleProfiler->zoneStart(gIdleZoneName, false, 0);
+	}
+#endif
+}
+
+void Ext::CpuWorkerThread::endIdle()
+{
+	if(mIdleProfiler)
+	{
+		mIdleProfiler->zoneEnd(mIdleProfilerData, gIdleZoneName, false, 0);
+		mIdleProfiler = NULL;
+		mIdleProfilerData = NULL;
+	}
+}
@@ -30,8 +30,8 @@
 #define EXT_CPU_WORKER_THREAD_H
 
 #include "foundation/PxThread.h"
-#include "ExtTaskQueueHelper.h"
-#include "ExtSharedQueueEntryPool.h"
+#include "foundation/PxProfiler.h"
+#include "ExtWorkStealingDeque.h"
 
 namespace physx
 {
@@ -50,24 +50,58 @@ class DefaultCpuDispatcher;
 												CpuWorkerThread();
 												~CpuWorkerThread();
 		
-		PX_FORCE_INLINE	void					initialize(DefaultCpuDispatcher* ownerDispatcher)		{ mOwner = ownerDispatcher;				}
-		PX_FORCE_INLINE	PxThread::Id			getWorkerThreadId()								const	{ return mThreadId;						}
+		PX_FORCE_INLINE	void					initialize(DefaultCpuDispatcher* ownerDispatcher, PxU32 index)	{ mOwner = ownerDispatcher; mRandomState = index + 1;	}
+		PX_FORCE_INLINE	PxThread::Id			getWorkerThreadId()										const	{ return mThreadId;										}
+		PX_FORCE_INLINE	void					setQueueDepthName(const char* name)								{ mQueueDepthName = name;								}
 
+		// PT: owner thread only, LIFO
 		template<const bool highPriorityT>
-		PX_FORCE_INLINE	PxBaseTask*				getJob()	{ return mHelper.fetchTask<highPriorityT>();	}
+		PX_FORCE_INLINE	PxBaseTask*				getJob()	{ return highPriorityT ? mHighPriorityDeque.pop() : mDeque.pop();		}
+
+		// PT: other threads, FIFO
+		template<const bool highPriorityT>
+		PX_FORCE_INLINE	PxBaseTask*				stealJob()	{ return highPriorityT ? mHighPriorityDeque.steal() : mDeque.steal();	}
 
 						void					execute();
 
 		PX_FORCE_INLINE	bool					tryAcceptJobToLocalQueue(PxBaseTask& task, PxThread::Id taskSubmitionThread)
 												{
 													if(taskSubmitionThread == mThreadId)
-														return mHelper.tryAcceptJobToQueue(task);
+													{
+														if(task.isHighPriority() && mHighPriorityDeque.push(task))
+															return true;
+														return mDeque.push(task);
+													}
 													return false;
 												}
 	protected:
+						// PT: xorshift, used to pick the first victim when stealing
+		PX_FORCE_INLINE	PxU32					getRandom()
+												{
+													PxU32 x = mRandomState;
+													x ^= x << 13;
+													x ^= x >> 17;
+													x ^= x << 5;
+													mRandomState = x;
+													return x;
+												}
+
+						PxBaseTask*				fetchTask(bool& stolen);
+						void					runTask(PxBaseTask& task, bool stolen);
+
+						// PT: profiling of idle gaps, see runTask()
+						void					beginIdle();
+						void					endIdle();
+
+						WorkStealingDeque		mHighPriorityDeque;
+						WorkStealingDeque		mDeque;
 						DefaultCpuDispatcher*	mOwner;
-						TaskQueueHelper			mHelper;
 						PxThread::Id			mThreadId;
+						PxU32					mRandomState;
+						PxU32					mSpinBudget;	// PT: adaptive mode only, learned number of spins before parking
+						PxProfilerCallback*		mIdleProfiler;	// PT: non-NULL while an idle zone is open
+						void*					mIdleProfilerData;
+						const char*				mQueueDepthName;
 	};
 
 #if PX_VC
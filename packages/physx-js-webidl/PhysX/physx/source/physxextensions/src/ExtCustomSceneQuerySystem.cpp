@@ -61,6 +61,7 @@ static CompanionPrunerType getCompanionType(PxDynamicTreeSecondaryPruner::Enum t
 		case PxDynamicTreeSecondaryPruner::eBUCKET:			return COMPANION_PRUNER_BUCKET;
 		case PxDynamicTreeSecondaryPruner::eINCREMENTAL:	return COMPANION_PRUNER_INCREMENTAL;
 		case PxDynamicTreeSecondaryPruner::eBVH:			return COMPANION_PRUNER_AABB_TREE;
+		case PxDynamicTreeSecondaryPruner::eGRID:			return COMPANION_PRUNER_GRID;
 		case PxDynamicTreeSecondaryPruner::eLAST:			return COMPANION_PRUNER_NONE;
 	}
 	return COMPANION_PRUNER_NONE;
@@ -78,7 +79,7 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 	return BVH_SPLATTER_POINTS;
 }
 
-static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
+static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode, PxReal rebuildCostThreshold, bool quantizedTree)
 {
 //	if(0)
 //		return createIncrementalPruner(contextID);
@@ -90,8 +91,8 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 	switch(type)
 	{
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
-		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
-		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode, rebuildCostThreshold);		break;	}
+		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode, rebuildCostThreshold, quantizedTree);	break;	}
 		case PxPruningStructureType::eLAST:					break;
 	}
 	return pruner;
@@ -247,6 +248,14 @@ namespace
 														PxOverlapCallback& hitCall, 
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	bool							cull(PxU32 nbPlanes, const PxPlane* planes,
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const;
+		virtual	PxI32							overlapSpheres(PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,
+														PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const;
 		virtual	PxSQPrunerHandle				getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const;
 		virtual	void							sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
 													const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices);
@@ -255,6 +264,10 @@ namespace
 		virtual	PxU32							startCustomBuildstep();
 		virtual	void							customBuildstep(PxU32 index);
 		virtual	void							finishCustomBuildstep();
+		virtual	void							setQueryStatsEnabled(bool enabled)													{ SQ().setQueryStatsEnabled(enabled);							}
+		virtual	bool							getQueryStatsEnabled()									const						{ return SQ().getQueryStatsEnabled();							}
+		virtual	bool							getQueryStats(PxU32 prunerIndex, PxPrunerQueryStats& stats)	const;
+		virtual	void							resetQueryStats()																	{ SQ().resetQueryStats();										}
 
 		PX_FORCE_INLINE	ExtPrunerManager&		SQ()			{ return mQueries.mSQManager;	}
 		PX_FORCE_INLINE	const ExtPrunerManager&	SQ()	const	{ return mQueries.mSQManager;	}
@@ -457,6 +470,22 @@ bool CustomPxSQ::overlap(	const PxGeometry& geometry, const PxTransform& transfo
 	return mQueries._overlap( geometry, transform, hitCall, filterData, filterCall, cache, flags);
 }
 
+bool CustomPxSQ::cull(PxU32 nbPlanes, const PxPlane* planes,
+						PxOverlapCallback& hitCall,
+						const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+						PxGeometryQueryFlags flags) const
+{
+	return mQueries._cull(nbPlanes, planes, hitCall, filterData, filterCall, flags);
+}
+
+PxI32 CustomPxSQ::overlapSpheres(PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,
+								PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+								const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+								PxGeometryQueryFlags flags) const
+{
+	return mQueries._overlapSpheres(nbSpheres, centers, radii, hits, maxNbHits, nbHitsPerQuery, filterData, filterCall, flags);
+}
+
 PxSQPrunerHandle CustomPxSQ::getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex) const
 {
 	const PxU32 actorIndex = actor.getInternalActorIndex();
@@ -477,7 +506,7 @@ void CustomPxSQ::sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const
 
 PxU32 CustomPxSQ::addPruner(PxPruningStructureType::Enum primaryType, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxU32 preallocated)
 {
-	Pruner* pruner = create(primaryType, mQueries.getContextId(), secondaryType, PxBVHBuildStrategy::eFAST, 4);
+	Pruner* pruner = create(primaryType, mQueries.getContextId(), secondaryType, PxBVHBuildStrategy::eFAST, 4, 0.0f, false);
 	return mQueries.mSQManager.addPruner(pruner, preallocated);
 }
 
@@ -496,6 +525,17 @@ void CustomPxSQ::finishCustomBuildstep()
 	SQ().finishCustomBuildstep();
 }
 
+bool CustomPxSQ::getQueryStats(PxU32 prunerIndex, PxPrunerQueryStats& stats) const
+{
+	if(prunerIndex>=SQ().getNbPruners())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCustomSceneQuerySystem::getQueryStats: invalid pruner index");
+		return false;
+	}
+	stats = SQ().getAccumulatedQueryStats(prunerIndex);
+	return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 PxCustomSceneQuerySystem* physx::PxCreateCustomSceneQuerySystem(PxSceneQueryUpdateMode::Enum sceneQueryUpdateMode, PxU64 contextID, const PxCustomSceneQuerySystemAdapter& adapter, bool usesTreeOfPruners)
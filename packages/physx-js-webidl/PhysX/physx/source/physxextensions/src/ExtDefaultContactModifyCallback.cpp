@@ -0,0 +1,174 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxDefaultContactModifyCallback.h"
+#include "PxShape.h"
+#include "PxMaterial.h"
+
+#include "foundation/PxHashMap.h"
+
+using namespace physx;
+
+namespace physx
+{
+class DefaultContactModifyCallbackInternal
+{
+	PX_NOCOPY(DefaultContactModifyCallbackInternal)
+	public:
+				DefaultContactModifyCallbackInternal(PxContactModifyCallback* userCallback) : mUserCallback(userCallback)	{}
+				~DefaultContactModifyCallbackInternal()																		{}
+
+		void	modifyPair(PxContactModifyPair& pair)	const;
+
+		// PT: material pairs are stored with the smallest pointer first, so lookups don't depend on the shape order
+		typedef PxPair<const PxMaterial*, const PxMaterial*>	MaterialPair;
+
+		static PX_FORCE_INLINE MaterialPair	getMaterialPair(const PxMaterial* m0, const PxMaterial* m1)
+		{
+			return m0 < m1 ? MaterialPair(m0, m1) : MaterialPair(m1, m0);
+		}
+
+		struct MaterialOverride
+		{
+			PxReal	mStaticFriction;
+			PxReal	mDynamicFriction;
+			PxReal	mRestitution;
+		};
+
+		struct OneWayShape
+		{
+			PxVec3	mLocalDir;
+			PxReal	mCosAngle;
+		};
+
+		PxHashMap<MaterialPair, MaterialOverride>	mMaterialOverrides;
+		PxHashMap<const PxShape*, OneWayShape>		mOneWayShapes;
+		PxContactModifyCallback*					mUserCallback;
+};
+}
+
+static const PxMaterial* getContactMaterial(const PxShape* shape, PxU32 faceIndex)
+{
+	// PT: face indices are only available for shape 1, and only for meshes & heightfields with per-triangle materials
+	if(shape->getNbMaterials()>1 && faceIndex!=PXC_CONTACT_NO_FACE_INDEX)
+		return static_cast<const PxMaterial*>(shape->getMaterialFromInternalFaceIndex(faceIndex));
+
+	PxMaterial* material = NULL;
+	shape->getMaterials(&material, 1);
+	return material;
+}
+
+void DefaultContactModifyCallbackInternal::modifyPair(PxContactModifyPair& pair) const
+{
+	PxContactSet& contacts = pair.contacts;
+	const PxU32 nbContacts = contacts.size();
+
+	if(mMaterialOverrides.size())
+	{
+		const PxMaterial* material0 = getContactMaterial(pair.shape[0], PXC_CONTACT_NO_FACE_INDEX);
+		for(PxU32 i=0; i<nbContacts; i++)
+		{
+			const PxMaterial* material1 = getContactMaterial(pair.shape[1], contacts.getInternalFaceIndex1(i));
+			const PxHashMap<MaterialPair, MaterialOverride>::Entry* entry = mMaterialOverrides.find(getMaterialPair(material0, material1));
+			if(entry)
+			{
+				contacts.setStaticFriction(i, entry->second.mStaticFriction);
+				contacts.setDynamicFriction(i, entry->second.mDynamicFriction);
+				contacts.setRestitution(i, entry->second.mRestitution);
+			}
+		}
+	}
+
+	if(mOneWayShapes.size())
+	{
+		// PT: contact normals point from shape 1 to shape 0
+		for(PxU32 s=0; s<2; s++)
+		{
+			const PxHashMap<const PxShape*, OneWayShape>::Entry* entry = mOneWayShapes.find(pair.shape[s]);
+			if(!entry)
+				continue;
+
+			const PxVec3 worldDir = pair.transform[s].q.rotate(entry->second.mLocalDir);
+			const PxReal sign = s ? 1.0f : -1.0f;
+			const PxReal cosAngle = entry->second.mCosAngle;
+			for(PxU32 i=0; i<nbContacts; i++)
+			{
+				if(sign * contacts.getNormal(i).dot(worldDir) < cosAngle)
+					contacts.ignore(i);
+			}
+		}
+	}
+}
+
+PxDefaultContactModifyCallback::PxDefaultContactModifyCallback(PxContactModifyCallback* userCallback)
+{
+	mImpl = new DefaultContactModifyCallbackInternal(userCallback);
+}
+
+PxDefaultContactModifyCallback::~PxDefaultContactModifyCallback()
+{
+	delete mImpl;
+}
+
+void PxDefaultContactModifyCallback::setMaterialPairOverride(const PxMaterial& material0, const PxMaterial& material1, PxReal staticFriction, PxReal dynamicFriction, PxReal restitution)
+{
+	DefaultContactModifyCallbackInternal::MaterialOverride& data = mImpl->mMaterialOverrides[DefaultContactModifyCallbackInternal::getMaterialPair(&material0, &material1)];
+	data.mStaticFriction	= staticFriction;
+	data.mDynamicFriction	= dynamicFriction;
+	data.mRestitution		= restitution;
+}
+
+void PxDefaultContactModifyCallback::clearMaterialPairOverride(const PxMaterial& material0, const PxMaterial& material1)
+{
+	mImpl->mMaterialOverrides.erase(DefaultContactModifyCallbackInternal::getMaterialPair(&material0, &material1));
+}
+
+void PxDefaultContactModifyCallback::setOneWayShape(const PxShape& shape, const PxVec3& localDir, PxReal cosAngle)
+{
+	DefaultContactModifyCallbackInternal::OneWayShape& data = mImpl->mOneWayShapes[&shape];
+	data.mLocalDir	= localDir;
+	data.mCosAngle	= cosAngle;
+}
+
+void PxDefaultContactModifyCallback::clearOneWayShape(const PxShape& shape)
+{
+	mImpl->mOneWayShapes.erase(&shape);
+}
+
+void PxDefaultContactModifyCallback::setUserCallback(PxContactModifyCallback* userCallback)
+{
+	mImpl->mUserCallback = userCallback;
+}
+
+void PxDefaultContactModifyCallback::onContactModify(PxContactModifyPair* const pairs, PxU32 count)
+{
+	// PT: the tables are read-only during the simulation, so this can run concurrently from several narrowphase tasks
+	for(PxU32 i=0; i<count; i++)
+		mImpl->modifyPair(pairs[i]);
+
+	if(mImpl->mUserCallback)
+		mImpl->mUserCallback->onContactModify(pairs, count);
+}
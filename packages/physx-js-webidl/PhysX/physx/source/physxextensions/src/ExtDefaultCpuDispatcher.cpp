@@ -30,14 +30,63 @@
 #include "ExtCpuWorkerThread.h"
 #include "ExtTaskQueueHelper.h"
 #include "foundation/PxString.h"
+#include "foundation/PxAtomic.h"
 
 using namespace physx;
 
 PxDefaultCpuDispatcher* physx::PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherWaitForWorkMode::Enum mode, PxU32 yieldProcessorCount)
 {
+#if PX_EMSCRIPTEN && !defined(__EMSCRIPTEN_PTHREADS__)
+	// WebAssembly builds without -pthread cannot spawn workers, tasks are executed inline by the submitting thread.
+	if(numThreads)
+	{
+		PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "PxDefaultCpuDispatcherCreate: this build does not support threads, creating a dispatcher with 0 worker threads.");
+		numThreads = 0;
+	}
+#endif
 	return PX_NEW(Ext::DefaultCpuDispatcher)(numThreads, affinityMasks, mode, yieldProcessorCount);
 }
 
+PxU32 physx::PxDefaultCpuDispatcherComputeAffinityMasks(PxDefaultCpuDispatcherAffinityPolicy::Enum policy, PxU32 numThreads, PxU32 processorMask, PxU32 nbLogicalPerCore, PxU32* affinityMasks)
+{
+	// PT: gather candidate processors in placement order
+	PxU32 processors[32];
+	PxU32 nbProcessors = 0;
+	if(policy == PxDefaultCpuDispatcherAffinityPolicy::eSCATTER && nbLogicalPerCore > 1)
+	{
+		// PT: first logical processor of each core, then the second one, etc
+		for(PxU32 sibling=0; sibling<nbLogicalPerCore; sibling++)
+		{
+			for(PxU32 i=sibling; i<32; i+=nbLogicalPerCore)
+			{
+				if(processorMask & (1u<<i))
+					processors[nbProcessors++] = i;
+			}
+		}
+	}
+	else
+	{
+		for(PxU32 i=0; i<32; i++)
+		{
+			if(processorMask & (1u<<i))
+				processors[nbProcessors++] = i;
+		}
+	}
+
+	if(!nbProcessors)
+	{
+		// PT: no candidate, let the OS decide
+		for(PxU32 i=0; i<numThreads; i++)
+			affinityMasks[i] = 0;
+		return 0;
+	}
+
+	for(PxU32 i=0; i<numThreads; i++)
+		affinityMasks[i] = 1u<<processors[i % nbProcessors];
+
+	return numThreads < nbProcessors ? numThreads : nbProcessors;
+}
+
 #if !PX_SWITCH
 void Ext::DefaultCpuDispatcher::getAffinityMasks(PxU32* affinityMasks, PxU32 threadCount)
 {
@@ -54,10 +103,11 @@ Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinit
 #else
 	,mRunProfiled(false)
 #endif
+	, mStepActive(0)
 	, mWaitForWorkMode(mode)
 	, mYieldProcessorCount(yieldProcessorCount)
 {
-	PX_CHECK_MSG((((PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_PROCESSOR == mWaitForWorkMode) && (mYieldProcessorCount > 0)) ||
+	PX_CHECK_MSG((((PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_PROCESSOR == mWaitForWorkMode || PxDefaultCpuDispatcherWaitForWorkMode::eADAPTIVE == mWaitForWorkMode) && (mYieldProcessorCount > 0)) ||
 					(((PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == mWaitForWorkMode) || (PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)) && (0 == mYieldProcessorCount))), "Illegal yield processor count for chosen execute mode");
 
 	PxU32* defaultAffinityMasks = NULL;
@@ -73,23 +123,28 @@ Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinit
 
 	mWorkerThreads = PX_ALLOCATE(CpuWorkerThread, numThreads, "CpuWorkerThread");
 	const PxU32 nameLength = 32;
-	mThreadNames = PX_ALLOCATE(PxU8, nameLength * numThreads, "CpuWorkerThreadName");
+	mThreadNames = PX_ALLOCATE(PxU8, nameLength * 2 * numThreads, "CpuWorkerThreadName");
 
 	if (mWorkerThreads)
 	{
 		for(PxU32 i = 0; i < numThreads; ++i)
 		{
 			PX_PLACEMENT_NEW(mWorkerThreads+i, CpuWorkerThread)();
-			mWorkerThreads[i].initialize(this);
+			mWorkerThreads[i].initialize(this, i);
 		}
 
 		for(PxU32 i = 0; i < numThreads; ++i)
 		{
 			if (mThreadNames)
 			{
-				char* threadName = reinterpret_cast<char*>(mThreadNames + (i*nameLength));
+				char* threadName = reinterpret_cast<char*>(mThreadNames + (i*nameLength*2));
 				Pxsnprintf(threadName, nameLength, "PxWorker%02d", i);
 				mWorkerThreads[i].setName(threadName);
+
+				// PT: profiler names are keyed by pointer, so each worker needs its own persistent counter name
+				char* queueDepthName = threadName + nameLength;
+				Pxsnprintf(queueDepthName, nameLength, "PxWorker%02d.queueDepth", i);
+				mWorkerThreads[i].setQueueDepthName(queueDepthName);
 			}
 
 			mWorkerThreads[i].setAffinityMask(affinityMasks[i]);
@@ -110,7 +165,7 @@ Ext::DefaultCpuDispatcher::~DefaultCpuDispatcher()
 		mWorkerThreads[i].signalQuit();
 
 	mShuttingDown = true;
-	if(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)
+	if(usesWakeSignal())
 		mWorkReady.set();
 	for(PxU32 i = 0; i < mNumThreads; ++i)
 		mWorkerThreads[i].waitForQuit();
@@ -144,7 +199,7 @@ void Ext::DefaultCpuDispatcher::submitTask(PxBaseTask& task)
 	{
 		if(mWorkerThreads[i].tryAcceptJobToLocalQueue(task, currentThread))
 		{
-			if(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)
+			if(usesWakeSignal())
 				mWorkReady.set();
 			else
 				PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_PROCESSOR == mWaitForWorkMode || PxDefaultCpuDispatcherWaitForWorkMode::eYIELD_THREAD == mWaitForWorkMode);
@@ -154,14 +209,29 @@ void Ext::DefaultCpuDispatcher::submitTask(PxBaseTask& task)
 
 	if(mHelper.tryAcceptJobToQueue(task))
 	{
-		if(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode)
+		if(usesWakeSignal())
 			mWorkReady.set();
 	}
 }
 
+void Ext::DefaultCpuDispatcher::simulationStarting()
+{
+	PxAtomicExchange(&mStepActive, 1);
+
+	// PT: in adaptive mode, wake parked threads now so that they are already spinning when the first tasks arrive
+	if(PxDefaultCpuDispatcherWaitForWorkMode::eADAPTIVE == mWaitForWorkMode)
+		mWorkReady.set();
+}
+
+void Ext::DefaultCpuDispatcher::simulationFinished()
+{
+	// PT: threads finish their current spin and park until the next step or the next submitted task
+	PxAtomicExchange(&mStepActive, 0);
+}
+
 void Ext::DefaultCpuDispatcher::resetWakeSignal()
 {
-	PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode);
+	PX_ASSERT(usesWakeSignal());
 	mWorkReady.reset();
 	
 	// The code below is necessary to avoid deadlocks on shut down.
@@ -59,6 +59,8 @@ namespace Ext
 		// PxCpuDispatcher
 		virtual			void											submitTask(PxBaseTask& task)		PX_OVERRIDE;
 		virtual			PxU32											getWorkerCount()	const			PX_OVERRIDE	{ return mNumThreads;			}
+		virtual			void											simulationStarting()				PX_OVERRIDE;
+		virtual			void											simulationFinished()				PX_OVERRIDE;
 		//~PxCpuDispatcher
 
 		// PxDefaultCpuDispatcher
@@ -68,19 +70,28 @@ namespace Ext
 		//~PxDefaultCpuDispatcher
 
 		template<const bool highPriorityT>
-						PxBaseTask*										fetchNextTask()
+						PxBaseTask*										fetchNextTask(PxU32 random, bool& stolen)
 																		{
-																			// PT: get job from local list
+																			// PT: get job from the shared list, fed by non-worker threads
 																			PxBaseTask* task = mHelper.fetchTask<highPriorityT>();
+																			stolen = false;
 																			if(!task)
 																			{
-																				// PT: steal job from other threads
+																				// PT: steal job from other threads, starting from a random victim so that
+																				// idle workers don't all hammer the same deque
 																				const PxU32 nbThreads = mNumThreads;
+																				const PxU32 start = random % nbThreads;
 																				for(PxU32 i=0; i<nbThreads; ++i)
 																				{
-																					task = mWorkerThreads[i].getJob<highPriorityT>();
+																					PxU32 victim = start + i;
+																					if(victim >= nbThreads)
+																						victim -= nbThreads;
+																					task = mWorkerThreads[victim].stealJob<highPriorityT>();
 																					if(task)
+																					{
+																						stolen = true;
 																						return task;
+																					}
 																				}
 																			}
 																			return task;
@@ -97,22 +108,28 @@ namespace Ext
 																				task.run();
 																		}
 
-    					void											waitForWork()						{ PX_ASSERT(PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode); mWorkReady.wait(); }
+    					void											waitForWork()						{ PX_ASSERT(usesWakeSignal()); mWorkReady.wait(); }
 						void											resetWakeSignal();
 
 		static			void											getAffinityMasks(PxU32* affinityMasks, PxU32 threadCount);
 
 		PX_FORCE_INLINE	PxDefaultCpuDispatcherWaitForWorkMode::Enum		getWaitForWorkMode()		const	{ return mWaitForWorkMode;		}
 		PX_FORCE_INLINE	PxU32											getYieldProcessorCount()	const	{ return mYieldProcessorCount;	}
+		PX_FORCE_INLINE	bool											isStepActive()				const	{ return mStepActive != 0;		}
+		PX_FORCE_INLINE	bool											usesWakeSignal()			const
+																		{
+																			return PxDefaultCpuDispatcherWaitForWorkMode::eWAIT_FOR_WORK == mWaitForWorkMode || PxDefaultCpuDispatcherWaitForWorkMode::eADAPTIVE == mWaitForWorkMode;
+																		}
 
 	protected:
 						CpuWorkerThread*								mWorkerThreads;
 						TaskQueueHelper									mHelper;
 						PxSync											mWorkReady;
-						PxU8*											mThreadNames;
+						PxU8*											mThreadNames;		// PT: per thread, the thread name followed by its queue depth counter name
 						PxU32											mNumThreads;
 						bool											mShuttingDown;
 						bool											mRunProfiled;
+						volatile PxI32									mStepActive;	// PT: between simulationStarting() and simulationFinished()
 		const			PxDefaultCpuDispatcherWaitForWorkMode::Enum		mWaitForWorkMode;
 		const			PxU32											mYieldProcessorCount;
 	};
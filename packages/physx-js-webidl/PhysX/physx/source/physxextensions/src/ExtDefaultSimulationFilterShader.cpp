@@ -28,6 +28,7 @@
 
 
 #include "extensions/PxDefaultSimulationFilterShader.h"
+#include "extensions/PxLayerCollisionMatrix.h"
 #include "PxRigidActor.h"
 #include "PxShape.h"
 #include "PxDeformableSurface.h"
@@ -279,6 +280,35 @@ PxFilterFlags physx::PxDefaultSimulationFilterShader(
 	return PxFilterFlags();
 }
 
+PxFilterFlags physx::PxLayerMatrixFilterShader(
+	PxFilterObjectAttributes attributes0,
+	PxFilterData filterData0, 
+	PxFilterObjectAttributes attributes1,
+	PxFilterData filterData1,
+	PxPairFlags& pairFlags,
+	const void* constantBlock,
+	PxU32 constantBlockSize)
+{
+	// let triggers through
+	if(PxFilterObjectIsTrigger(attributes0) || PxFilterObjectIsTrigger(attributes1))
+	{
+		pairFlags = PxPairFlag::eTRIGGER_DEFAULT;
+		return PxFilterFlags();
+	}
+
+	// PT: the filter shader runs on simulation threads (or on the GPU), it cannot report errors about the block size
+	if(constantBlockSize == sizeof(PxLayerCollisionMatrix))
+	{
+		const PxLayerCollisionMatrix* matrix = reinterpret_cast<const PxLayerCollisionMatrix*>(constantBlock);
+		if(!matrix->collides(filterData0.word0, filterData1.word0))
+			return PxFilterFlag::eSUPPRESS;
+	}
+
+	pairFlags = PxPairFlag::eCONTACT_DEFAULT;
+
+	return PxFilterFlags();
+}
+
 bool physx::PxGetGroupCollisionFlag(const PxU16 group1, const PxU16 group2)
 {
 	PX_CHECK_AND_RETURN_NULL(group1 < 32 && group2 < 32, "Group must be less than 32");	
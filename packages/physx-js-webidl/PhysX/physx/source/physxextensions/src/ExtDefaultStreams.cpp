@@ -32,6 +32,7 @@
 #include "foundation/PxMemory.h"
 #include "foundation/PxBitUtils.h"
 #include "extensions/PxDefaultStreams.h"
+#include "extensions/PxDefaultCookingCacheStorage.h"
 
 #include "SnFile.h"
 #include "foundation/PxUtilities.h"
@@ -191,3 +192,47 @@ bool PxDefaultFileInputData::isValid() const
 {
 	return mFile != NULL;
 }
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxDefaultFileCookingCacheStorage::PxDefaultFileCookingCacheStorage(const char* directory)
+{
+	Pxstrlcpy(mDirectory, sizeof(mDirectory), directory ? directory : ".");
+}
+
+void PxDefaultFileCookingCacheStorage::getFileName(PxU64 key, char* fileName, PxU32 size) const
+{
+	Pxsnprintf(fileName, size, "%s/%08x%08x.pxcook", mDirectory, PxU32(key>>32), PxU32(key));
+}
+
+bool PxDefaultFileCookingCacheStorage::load(PxU64 key, PxOutputStream& stream)
+{
+	char fileName[512];
+	getFileName(key, fileName, sizeof(fileName));
+
+	PxDefaultFileInputData input(fileName);
+	if(!input.isValid())
+		return false;
+
+	PxU8 buffer[4096];
+	PxU32 remaining = input.getLength();
+	while(remaining)
+	{
+		const PxU32 count = input.read(buffer, PxMin(remaining, PxU32(sizeof(buffer))));
+		if(!count)
+			return false;
+		stream.write(buffer, count);
+		remaining -= count;
+	}
+	return true;
+}
+
+void PxDefaultFileCookingCacheStorage::store(PxU64 key, const void* data, PxU32 size)
+{
+	char fileName[512];
+	getFileName(key, fileName, sizeof(fileName));
+
+	PxDefaultFileOutputStream output(fileName);
+	if(output.isValid())
+		output.write(data, size);
+}
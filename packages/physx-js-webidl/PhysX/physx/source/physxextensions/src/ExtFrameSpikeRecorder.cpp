@@ -0,0 +1,430 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxFrameSpikeRecorder.h"
+#include "extensions/PxChromeTraceProfiler.h"
+#include "extensions/PxCollectionExt.h"
+#include "extensions/PxDefaultStreams.h"
+#include "extensions/PxSerialization.h"
+#include "foundation/PxAlignedMalloc.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxString.h"
+#include "foundation/PxTime.h"
+#include "common/PxCollection.h"
+#include "PxRigidDynamic.h"
+#include "PxScene.h"
+
+using namespace physx;
+
+namespace
+{
+	static const PxU32	gSpikeMagic = 0x53465850;	// 'PXFS'
+	static const PxU32	gSpikeVersion = 1;
+
+	struct ActorState
+	{
+		PxRigidDynamic*	actor;
+		PxTransform		pose;
+		PxVec3			linearVelocity;
+		PxVec3			angularVelocity;
+		bool			kinematic;
+	};
+
+	class StreamWriter
+	{
+		public:
+						StreamWriter(PxOutputStream& stream) : mStream(stream), mOk(true)	{}
+
+			void		writeU32(PxU32 value)	{ write(&value, sizeof(PxU32));	}
+			void		writeF32(PxReal value)	{ write(&value, sizeof(PxReal));	}
+			void		writeVec3(const PxVec3& v)
+						{
+							writeF32(v.x);
+							writeF32(v.y);
+							writeF32(v.z);
+						}
+			void		write(const void* data, PxU32 size)
+						{
+							if(mOk && mStream.write(data, size)!=size)
+								mOk = false;
+						}
+
+			bool		isOk()	const	{ return mOk;	}
+		private:
+			PxOutputStream&	mStream;
+			bool			mOk;
+	};
+
+	class StreamReader
+	{
+		public:
+						StreamReader(PxInputStream& stream) : mStream(stream), mOk(true)	{}
+
+			PxU32		readU32()
+						{
+							PxU32 value = 0;
+							read(&value, sizeof(PxU32));
+							return value;
+						}
+
+			PxReal		readF32()
+						{
+							PxReal value = 0.0f;
+							read(&value, sizeof(PxReal));
+							return value;
+						}
+
+			PxVec3		readVec3()
+						{
+							const PxReal x = readF32();
+							const PxReal y = readF32();
+							const PxReal z = readF32();
+							return PxVec3(x, y, z);
+						}
+
+			void		read(void* data, PxU32 size)
+						{
+							if(mOk && mStream.read(data, size)!=size)
+								mOk = false;
+						}
+
+			bool		isOk()	const	{ return mOk;	}
+		private:
+			PxInputStream&	mStream;
+			bool			mOk;
+	};
+
+	bool writeFile(const char* filename, const void* data, PxU32 size)
+	{
+		PxDefaultFileOutputStream stream(filename);
+		return stream.isValid() && stream.write(data, size)==size;
+	}
+}
+
+namespace physx
+{
+	class FrameSpikeRecorderInternal
+	{
+		PX_NOCOPY(FrameSpikeRecorderInternal)
+	public:
+		FrameSpikeRecorderInternal(PxScene& scene, PxSerializationRegistry& registry, const PxFrameSpikeRecorderDesc& desc) :
+			mScene		(scene),
+			mRegistry	(registry),
+			mDesc		(desc),
+			mFrameIndex	(0),
+			mNbSpikes	(0),
+			mRecording	(false)
+		{
+		}
+
+		bool	isFull()	const	{ return mDesc.maxNbSpikes && mNbSpikes>=mDesc.maxNbSpikes;	}
+
+		void	captureStates();
+		bool	writeReport(PxOutputStream& stream, const PxFrameSpikeInfo& info);
+		void	recordSpike(PxReal frameTime);
+
+		PxScene&					mScene;
+		PxSerializationRegistry&	mRegistry;
+		PxFrameSpikeRecorderDesc	mDesc;
+		PxArray<PxActor*>			mActors;
+		PxArray<ActorState>			mStates;
+		PxTime						mTimer;
+		PxU32						mFrameIndex;
+		PxU32						mNbSpikes;
+		bool						mRecording;
+	};
+}
+
+void FrameSpikeRecorderInternal::captureStates()
+{
+	const PxU32 nbActors = mScene.getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC);
+	mActors.resizeUninitialized(nbActors);
+	mScene.getActors(PxActorTypeFlag::eRIGID_DYNAMIC, mActors.begin(), nbActors);
+
+	mStates.resizeUninitialized(nbActors);
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		PxRigidDynamic* actor = static_cast<PxRigidDynamic*>(mActors[i]);
+		ActorState& state = mStates[i];
+		state.actor				= actor;
+		state.pose				= actor->getGlobalPose();
+		state.linearVelocity	= actor->getLinearVelocity();
+		state.angularVelocity	= actor->getAngularVelocity();
+		state.kinematic			= actor->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC;
+	}
+}
+
+bool FrameSpikeRecorderInternal::writeReport(PxOutputStream& stream, const PxFrameSpikeInfo& info)
+{
+	PxCollection* collection = PxCollectionExt::createCollection(mScene);
+	PxSerialization::complete(*collection, mRegistry);
+	PxSerialization::createSerialObjectIds(*collection, PxSerialObjectId(1));
+
+	PxDefaultMemoryOutputStream collectionData;
+	const bool serialized = PxSerialization::serializeCollectionToBinary(collectionData, *collection, mRegistry);
+
+	StreamWriter writer(stream);
+	writer.writeU32(gSpikeMagic);
+	writer.writeU32(gSpikeVersion);
+	writer.writeU32(info.frameIndex);
+	writer.writeF32(info.frameTime);
+	writer.writeF32(info.threshold);
+
+	writer.writeU32(PxSimulationStage::eCOUNT);
+	writer.writeF32(info.timings.totalTime);
+	for(PxU32 i=0;i<PxSimulationStage::eCOUNT;i++)
+	{
+		const PxSimulationStageTiming& timing = info.timings.stages[i];
+		writer.writeF32(timing.startTime);
+		writer.writeF32(timing.endTime);
+		writer.writeU32(timing.nbCalls);
+		writer.writeU32(timing.nbItems);
+	}
+
+	// PT: actors are identified by their serial ids. Actors released since beginFrame() are not in the collection anymore.
+	// The pointers are only used as keys here, they are not dereferenced.
+	PxU32 nbStates = 0;
+	for(PxU32 i=0;i<mStates.size();i++)
+	{
+		if(collection->contains(*mStates[i].actor))
+			nbStates++;
+	}
+
+	writer.writeU32(nbStates);
+	for(PxU32 i=0;i<mStates.size();i++)
+	{
+		const ActorState& state = mStates[i];
+		if(!collection->contains(*state.actor))
+			continue;
+
+		const PxU64 id = collection->getId(*state.actor);
+		writer.writeU32(PxU32(id));
+		writer.writeU32(PxU32(id>>32));
+		writer.writeU32(state.kinematic);
+		writer.writeVec3(state.pose.p);
+		writer.writeF32(state.pose.q.x);
+		writer.writeF32(state.pose.q.y);
+		writer.writeF32(state.pose.q.z);
+		writer.writeF32(state.pose.q.w);
+		writer.writeVec3(state.linearVelocity);
+		writer.writeVec3(state.angularVelocity);
+	}
+
+	writer.writeU32(serialized ? collectionData.getSize() : 0);
+	if(serialized)
+		writer.write(collectionData.getData(), collectionData.getSize());
+
+	collection->release();
+
+	if(!serialized)
+		return PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "PxFrameSpikeRecorder: the scene could not be serialized, the report only contains timings.");
+
+	return writer.isOk();
+}
+
+void FrameSpikeRecorderInternal::recordSpike(PxReal frameTime)
+{
+	PxFrameSpikeInfo info;
+	info.frameIndex	= mFrameIndex;
+	info.frameTime	= frameTime;
+	info.threshold	= mDesc.threshold;
+	mScene.getSimulationStageTimings(info.timings);
+
+	PxDefaultMemoryOutputStream report;
+	writeReport(report, info);
+
+	PxDefaultMemoryOutputStream trace;
+	if(mDesc.profiler)
+		mDesc.profiler->writeTrace(trace);
+
+	if(mDesc.filePrefix)
+	{
+		char filename[512];
+		Pxsnprintf(filename, sizeof(filename), "%s%u.pxspike", mDesc.filePrefix, mFrameIndex);
+		if(!writeFile(filename, report.getData(), report.getSize()))
+			PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "PxFrameSpikeRecorder: cannot write %s.", filename);
+
+		if(mDesc.profiler)
+		{
+			Pxsnprintf(filename, sizeof(filename), "%s%u.json", mDesc.filePrefix, mFrameIndex);
+			if(!writeFile(filename, trace.getData(), trace.getSize()))
+				PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "PxFrameSpikeRecorder: cannot write %s.", filename);
+		}
+	}
+
+	if(mDesc.callback)
+		mDesc.callback->onFrameSpike(info, report.getData(), report.getSize(), mDesc.profiler ? trace.getData() : NULL, trace.getSize());
+
+	mNbSpikes++;
+}
+
+PxFrameSpikeRecorder::PxFrameSpikeRecorder(PxScene& scene, PxSerializationRegistry& registry, const PxFrameSpikeRecorderDesc& desc)
+{
+	PX_ASSERT(desc.isValid());
+	mImpl = new FrameSpikeRecorderInternal(scene, registry, desc);
+}
+
+PxFrameSpikeRecorder::~PxFrameSpikeRecorder()
+{
+	delete mImpl;
+}
+
+void PxFrameSpikeRecorder::beginFrame()
+{
+	PX_CHECK_AND_RETURN(!mImpl->mRecording, "PxFrameSpikeRecorder::beginFrame: endFrame() has not been called for the previous frame");
+
+	mImpl->mRecording = true;
+	if(mImpl->isFull())
+		return;
+
+	mImpl->captureStates();
+
+	// PT: the timer is reset last, so that capturing the states is not included in the frame time
+	mImpl->mTimer.getElapsedSeconds();
+}
+
+bool PxFrameSpikeRecorder::endFrame()
+{
+	PX_CHECK_AND_RETURN_VAL(mImpl->mRecording, "PxFrameSpikeRecorder::endFrame: beginFrame() has not been called", false);
+
+	mImpl->mRecording = false;
+	bool recorded = false;
+	if(!mImpl->isFull())
+	{
+		const PxReal frameTime = PxReal(mImpl->mTimer.peekElapsedSeconds() * 1000.0);
+		if(frameTime>mImpl->mDesc.threshold)
+		{
+			mImpl->recordSpike(frameTime);
+			recorded = true;
+		}
+	}
+	mImpl->mFrameIndex++;
+	return recorded;
+}
+
+PxU32 PxFrameSpikeRecorder::getNbSpikes() const
+{
+	return mImpl->mNbSpikes;
+}
+
+PxCollection* PxFrameSpikeRecorder::load(PxInputStream& stream, PxSerializationRegistry& registry, void*& memory, PxFrameSpikeInfo* info)
+{
+	memory = NULL;
+
+	StreamReader reader(stream);
+	if(reader.readU32()!=gSpikeMagic || reader.readU32()!=gSpikeVersion)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxFrameSpikeRecorder::load: invalid report.");
+		return NULL;
+	}
+
+	PxFrameSpikeInfo spike;
+	spike.frameIndex	= reader.readU32();
+	spike.frameTime		= reader.readF32();
+	spike.threshold		= reader.readF32();
+
+	// PT: stages added by later versions of the SDK are skipped
+	const PxU32 nbStages = reader.readU32();
+	spike.timings.totalTime = reader.readF32();
+	for(PxU32 i=0;i<nbStages && reader.isOk();i++)
+	{
+		PxSimulationStageTiming timing;
+		timing.startTime	= reader.readF32();
+		timing.endTime		= reader.readF32();
+		timing.nbCalls		= reader.readU32();
+		timing.nbItems		= reader.readU32();
+		if(i<PxSimulationStage::eCOUNT)
+			spike.timings.stages[i] = timing;
+	}
+
+	PxArray<ActorState> states;
+	PxArray<PxSerialObjectId> ids;
+	const PxU32 nbStates = reader.readU32();
+	for(PxU32 i=0;i<nbStates && reader.isOk();i++)
+	{
+		const PxU32 idLow = reader.readU32();
+		const PxU32 idHigh = reader.readU32();
+		ids.pushBack(PxSerialObjectId(idLow) | (PxSerialObjectId(idHigh)<<32));
+
+		ActorState state;
+		state.actor			= NULL;
+		state.kinematic		= reader.readU32()!=0;
+		state.pose.p		= reader.readVec3();
+		state.pose.q.x		= reader.readF32();
+		state.pose.q.y		= reader.readF32();
+		state.pose.q.z		= reader.readF32();
+		state.pose.q.w		= reader.readF32();
+		state.linearVelocity	= reader.readVec3();
+		state.angularVelocity	= reader.readVec3();
+		states.pushBack(state);
+	}
+
+	const PxU32 collectionSize = reader.readU32();
+	if(!reader.isOk() || !collectionSize)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxFrameSpikeRecorder::load: the report does not contain a scene.");
+		return NULL;
+	}
+
+	// PT: binary collections must be deserialized from 128-byte aligned memory
+	void* block = PxAlignedAllocator<PX_SERIAL_FILE_ALIGN>().allocate(collectionSize, PX_FL);
+	reader.read(block, collectionSize);
+
+	PxCollection* collection = reader.isOk() ? PxSerialization::createCollectionFromBinary(block, registry) : NULL;
+	if(!collection)
+	{
+		PxAlignedAllocator<PX_SERIAL_FILE_ALIGN>().deallocate(block);
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxFrameSpikeRecorder::load: cannot deserialize the scene.");
+		return NULL;
+	}
+
+	for(PxU32 i=0;i<states.size();i++)
+	{
+		PxBase* object = collection->find(ids[i]);
+		PxRigidDynamic* actor = object ? object->is<PxRigidDynamic>() : NULL;
+		if(!actor)
+			continue;
+
+		const ActorState& state = states[i];
+		actor->setGlobalPose(state.pose, false);
+		if(!state.kinematic && !(actor->getActorFlags() & PxActorFlag::eDISABLE_SIMULATION))
+		{
+			actor->setLinearVelocity(state.linearVelocity, false);
+			actor->setAngularVelocity(state.angularVelocity, false);
+		}
+	}
+
+	if(info)
+		*info = spike;
+	memory = block;
+	return collection;
+}
+
+void PxFrameSpikeRecorder::releaseMemory(void* memory)
+{
+	if(memory)
+		PxAlignedAllocator<PX_SERIAL_FILE_ALIGN>().deallocate(memory);
+}
@@ -0,0 +1,140 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxHeightFieldExt.h"
+#include "geometry/PxHeightField.h"
+#include "geometry/PxHeightFieldDesc.h"
+#include "geometry/PxHeightFieldSample.h"
+#include "cooking/PxCooking.h"
+#include "foundation/PxAllocator.h"
+#include "foundation/PxMath.h"
+#include "PxPhysics.h"
+#include "PxShape.h"
+
+using namespace physx;
+
+static PX_FORCE_INLINE PxI16 quantizeHeight(PxReal height, PxReal invHeightScale)
+{
+	const PxReal h = PxClamp(height * invHeightScale, -32768.0f, 32767.0f);
+	return PxI16(h < 0.0f ? h - 0.5f : h + 0.5f);
+}
+
+PxReal PxHeightFieldExt::computeHeightScale(const PxReal* heights, PxU32 nbHeights, PxReal minHeightRange)
+{
+	PxReal maxAbs = PxAbs(minHeightRange);
+	for(PxU32 i=0; i<nbHeights; i++)
+		maxAbs = PxMax(maxAbs, PxAbs(heights[i]));
+
+	// PT: flat terrain still needs a valid (non-zero) scale
+	return maxAbs > 0.0f ? maxAbs / 32767.0f : 1.0f;
+}
+
+void PxHeightFieldExt::convertHeights(const PxReal* heights, PxU32 nbRows, PxU32 nbColumns, PxReal heightScale, PxHeightFieldSample* samples,
+										PxU8 materialIndex0, PxU8 materialIndex1)
+{
+	const PxReal invHeightScale = 1.0f / heightScale;
+	const PxU32 nbSamples = nbRows * nbColumns;
+	for(PxU32 i=0; i<nbSamples; i++)
+	{
+		PxHeightFieldSample& sample = samples[i];
+		sample.height = quantizeHeight(heights[i], invHeightScale);
+		sample.materialIndex0 = materialIndex0;
+		sample.materialIndex1 = materialIndex1;
+	}
+}
+
+PxHeightField* PxHeightFieldExt::createHeightField(PxPhysics& physics, const PxReal* heights, PxU32 nbRows, PxU32 nbColumns, PxReal heightScale,
+													PxU8 materialIndex0, PxU8 materialIndex1)
+{
+	PX_CHECK_AND_RETURN_NULL(heights, "PxHeightFieldExt::createHeightField: heights cannot be NULL");
+	PX_CHECK_AND_RETURN_NULL(nbRows>=2 && nbColumns>=2, "PxHeightFieldExt::createHeightField: the grid must have at least 2 rows and 2 columns");
+	PX_CHECK_AND_RETURN_NULL(heightScale>0.0f, "PxHeightFieldExt::createHeightField: heightScale must be positive");
+
+	PxHeightFieldSample* samples = PX_ALLOCATE(PxHeightFieldSample, nbRows * nbColumns, "PxHeightFieldSample");
+	if(!samples)
+		return NULL;
+
+	convertHeights(heights, nbRows, nbColumns, heightScale, samples, materialIndex0, materialIndex1);
+
+	PxHeightFieldDesc desc;
+	desc.format				= PxHeightFieldFormat::eS16_TM;
+	desc.nbRows				= nbRows;
+	desc.nbColumns			= nbColumns;
+	desc.samples.data		= samples;
+	desc.samples.stride		= sizeof(PxHeightFieldSample);
+
+	PxHeightField* heightField = PxCreateHeightField(desc, physics.getPhysicsInsertionCallback());
+
+	PX_FREE(samples);
+	return heightField;
+}
+
+bool PxHeightFieldExt::updateHeights(PxHeightField& heightField, PxU32 startRow, PxU32 startColumn, PxU32 nbRows, PxU32 nbColumns,
+										const PxReal* heights, PxReal heightScale, PxShape* const* shapes, PxU32 nbShapes)
+{
+	PX_CHECK_AND_RETURN_VAL(heights, "PxHeightFieldExt::updateHeights: heights cannot be NULL", false);
+	PX_CHECK_AND_RETURN_VAL(startRow + nbRows <= heightField.getNbRows() && startColumn + nbColumns <= heightField.getNbColumns(),
+							"PxHeightFieldExt::updateHeights: rectangle out of the height field's range", false);
+	PX_CHECK_AND_RETURN_VAL(heightScale>0.0f, "PxHeightFieldExt::updateHeights: heightScale must be positive", false);
+
+	if(!nbRows || !nbColumns)
+		return true;
+
+	PxHeightFieldSample* samples = PX_ALLOCATE(PxHeightFieldSample, nbRows * nbColumns, "PxHeightFieldSample");
+	if(!samples)
+		return false;
+
+	// PT: keep the materials & tessellation flags of the existing samples, only the heights change
+	const PxReal invHeightScale = 1.0f / heightScale;
+	for(PxU32 r=0; r<nbRows; r++)
+	{
+		for(PxU32 c=0; c<nbColumns; c++)
+		{
+			const PxU32 index = r * nbColumns + c;
+			samples[index] = heightField.getSample(startRow + r, startColumn + c);
+			samples[index].height = quantizeHeight(heights[index], invHeightScale);
+		}
+	}
+
+	PxHeightFieldDesc desc;
+	desc.format				= heightField.getFormat();
+	desc.nbRows				= nbRows;
+	desc.nbColumns			= nbColumns;
+	desc.samples.data		= samples;
+	desc.samples.stride		= sizeof(PxHeightFieldSample);
+
+	const bool status = heightField.modifySamples(PxI32(startColumn), PxI32(startRow), desc, true);
+
+	PX_FREE(samples);
+
+	if(status)
+	{
+		// PT: PhysX does not track the shapes referencing a height field, refresh them here to update their bounds
+		for(PxU32 i=0; i<nbShapes; i++)
+			shapes[i]->setGeometry(shapes[i]->getGeometry());
+	}
+	return status;
+}
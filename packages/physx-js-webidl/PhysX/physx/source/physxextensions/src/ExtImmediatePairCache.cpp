@@ -0,0 +1,440 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxImmediatePairCache.h"
+#include "PxImmediateMode.h"
+
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+
+using namespace physx;
+using namespace immediate;
+
+namespace
+{
+	// PT: linear allocator whose pages are kept and reused after a reset. The immediate mode API lets users decide where the
+	// contact caches, constraints and friction patches live, and this makes the cache allocation-free once the pages exist.
+	class PageAllocator
+	{
+		PX_NOCOPY(PageAllocator)
+		static const PxU32	PageSize = 32*1024;
+
+		struct Page
+		{
+			PxU8*	mData;
+			PxU32	mSize;
+		};
+
+		public:
+						PageAllocator() : mCurrentPage(0), mCurrentOffset(0)	{}
+						~PageAllocator()
+						{
+							const PxU32 nbPages = mPages.size();
+							for(PxU32 i=0;i<nbPages;i++)
+								PX_FREE(mPages[i].mData);
+						}
+
+			void		reset()
+						{
+							mCurrentPage = 0;
+							mCurrentOffset = 0;
+						}
+
+			PxU8*		allocate(PxU32 size)
+						{
+							size = (size + 15) & ~15;
+
+							while(mCurrentPage<mPages.size())
+							{
+								const Page& page = mPages[mCurrentPage];
+								if(mCurrentOffset + size <= page.mSize)
+								{
+									PxU8* data = page.mData + mCurrentOffset;
+									mCurrentOffset += size;
+									return data;
+								}
+								mCurrentPage++;
+								mCurrentOffset = 0;
+							}
+
+							Page page;
+							page.mSize = PxMax(size, PageSize);
+							page.mData = reinterpret_cast<PxU8*>(PX_ALLOC(page.mSize, "PxImmediatePairCache"));
+							mPages.pushBack(page);
+							mCurrentOffset = size;
+							return page.mData;
+						}
+		private:
+			PxArray<Page>	mPages;
+			PxU32			mCurrentPage;
+			PxU32			mCurrentOffset;
+	};
+
+	// PT: contact caches are double-buffered: the data written in a step is read back in the next step.
+	class CacheAllocator : public PxCacheAllocator
+	{
+		public:
+							CacheAllocator() : mIndex(0)	{}
+		virtual				~CacheAllocator()				{}
+
+		virtual	PxU8*		allocateCacheData(const PxU32 byteSize)	PX_OVERRIDE
+							{
+								return mPages[mIndex].allocate(byteSize);
+							}
+
+				void		flip()
+							{
+								mIndex = 1 - mIndex;
+								mPages[mIndex].reset();
+							}
+		private:
+				PageAllocator	mPages[2];
+				PxU32			mIndex;
+	};
+
+	// PT: constraints only live for one step, friction patches are double-buffered like the contact caches.
+	class ConstraintAllocator : public PxConstraintAllocator
+	{
+		public:
+							ConstraintAllocator() : mIndex(0)	{}
+		virtual				~ConstraintAllocator()				{}
+
+		virtual	PxU8*		reserveConstraintData(const PxU32 byteSize)	PX_OVERRIDE
+							{
+								return mConstraints.allocate(byteSize);
+							}
+
+		virtual	PxU8*		reserveFrictionData(const PxU32 byteSize)	PX_OVERRIDE
+							{
+								return mFrictions[mIndex].allocate(byteSize);
+							}
+
+				void		flip()
+							{
+								mConstraints.reset();
+								mIndex = 1 - mIndex;
+								mFrictions[mIndex].reset();
+							}
+		private:
+				PageAllocator	mConstraints;
+				PageAllocator	mFrictions[2];
+				PxU32			mIndex;
+	};
+
+	struct Friction
+	{
+		PxU8*	mPatches;
+		PxU32	mNbPatches;
+		PxU32	mFrame;		// Frame in which the patches have been allocated
+	};
+
+	struct PairState
+	{
+		PxU32	mLastAddedFrame;
+		PxU32	mLastGeneratedFrame;
+	};
+
+	static const PxU32 INVALID_FRAME = 0xffffffff;
+
+	PX_FORCE_INLINE PxU64 getPairKey(PxU32 id0, PxU32 id1)
+	{
+		if(id0>id1)
+			PxSwap(id0, id1);
+		return PxU64(id0)|(PxU64(id1)<<32);
+	}
+}
+
+namespace physx
+{
+class ImmediatePairCacheInternal : public PxContactRecorder
+{
+	PX_NOCOPY(ImmediatePairCacheInternal)
+	public:
+								ImmediatePairCacheInternal(PxU32 maxAge) : mMaxAge(maxAge), mFrame(0), mUserRecorder(NULL), mNbTouchingPairs(0)	{}
+	virtual						~ImmediatePairCacheInternal()	{}
+
+	// PxContactRecorder
+	virtual	bool				recordContacts(const PxContactPoint* contactPoints, PxU32 nbContacts, PxU32 index)	PX_OVERRIDE;
+	//~PxContactRecorder
+
+			void				beginFrame();
+			PxU32				addPair(PxU32 id0, PxU32 id1);
+			void				removePairAt(PxU32 pairIndex);
+			PxU32				generateContacts(const PxGeometry*const* geometries, const PxTransform* poses, PxContactRecorder& recorder,
+												PxReal contactDistance, PxReal meshContactMargin, PxReal toleranceLength);
+
+			const PxU32					mMaxAge;
+			PxU32						mFrame;
+
+			CacheAllocator				mCacheAllocator;
+			ConstraintAllocator			mConstraintAllocator;
+
+			// PT: parallel arrays, so that the contact caches can be passed as-is to PxGenerateContacts
+			PxHashMap<PxU64, PxU32>		mPairMap;
+			PxArray<PxImmediatePair>	mPairs;
+			PxArray<PxCache>			mCaches;
+			PxArray<Friction>			mFrictions;
+			PxArray<PairState>			mStates;
+
+			// PT: per-call buffers, kept to avoid reallocations
+			PxArray<const PxGeometry*>	mGeoms0;
+			PxArray<const PxGeometry*>	mGeoms1;
+			PxArray<PxTransform>		mPoses0;
+			PxArray<PxTransform>		mPoses1;
+			PxArray<bool>				mTouching;
+			PxContactRecorder*			mUserRecorder;
+			PxU32						mNbTouchingPairs;
+};
+}
+
+void ImmediatePairCacheInternal::beginFrame()
+{
+	mFrame++;
+	mCacheAllocator.flip();
+	mConstraintAllocator.flip();
+
+	if(mMaxAge==0xffffffff)
+		return;
+
+	PxU32 i = mPairs.size();
+	while(i--)
+	{
+		if(mFrame - mStates[i].mLastAddedFrame > mMaxAge)
+			removePairAt(i);
+	}
+}
+
+PxU32 ImmediatePairCacheInternal::addPair(PxU32 id0, PxU32 id1)
+{
+	const PxU64 key = getPairKey(id0, id1);
+	const PxHashMap<PxU64, PxU32>::Entry* entry = mPairMap.find(key);
+	if(entry)
+	{
+		mStates[entry->second].mLastAddedFrame = mFrame;
+		return entry->second;
+	}
+
+	const PxU32 pairIndex = mPairs.size();
+	mPairMap.insert(key, pairIndex);
+
+	PxImmediatePair& pair = mPairs.insert();
+	pair.id0 = id0;
+	pair.id1 = id1;
+
+	mCaches.pushBack(PxCache());
+
+	Friction& friction = mFrictions.insert();
+	friction.mPatches = NULL;
+	friction.mNbPatches = 0;
+	friction.mFrame = INVALID_FRAME;
+
+	PairState& state = mStates.insert();
+	state.mLastAddedFrame = mFrame;
+	state.mLastGeneratedFrame = INVALID_FRAME;
+
+	return pairIndex;
+}
+
+void ImmediatePairCacheInternal::removePairAt(PxU32 pairIndex)
+{
+	const PxImmediatePair& pair = mPairs[pairIndex];
+	mPairMap.erase(getPairKey(pair.id0, pair.id1));
+
+	const PxU32 last = mPairs.size() - 1;
+	if(pairIndex!=last)
+	{
+		const PxImmediatePair& lastPair = mPairs[last];
+		mPairMap[getPairKey(lastPair.id0, lastPair.id1)] = pairIndex;
+	}
+	mPairs.replaceWithLast(pairIndex);
+	mCaches.replaceWithLast(pairIndex);
+	mFrictions.replaceWithLast(pairIndex);
+	mStates.replaceWithLast(pairIndex);
+}
+
+bool ImmediatePairCacheInternal::recordContacts(const PxContactPoint* contactPoints, PxU32 nbContacts, PxU32 index)
+{
+	mTouching[index] = true;
+	mNbTouchingPairs++;
+	return mUserRecorder->recordContacts(contactPoints, nbContacts, index);
+}
+
+PxU32 ImmediatePairCacheInternal::generateContacts(const PxGeometry*const* geometries, const PxTransform* poses, PxContactRecorder& recorder,
+													PxReal contactDistance, PxReal meshContactMargin, PxReal toleranceLength)
+{
+	const PxU32 nbPairs = mPairs.size();
+
+	mGeoms0.resizeUninitialized(nbPairs);
+	mGeoms1.resizeUninitialized(nbPairs);
+	mPoses0.resizeUninitialized(nbPairs);
+	mPoses1.resizeUninitialized(nbPairs);
+	mTouching.resizeUninitialized(nbPairs);
+
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		const PxImmediatePair& pair = mPairs[i];
+		mGeoms0[i] = geometries[pair.id0];
+		mGeoms1[i] = geometries[pair.id1];
+		mPoses0[i] = poses[pair.id0];
+		mPoses1[i] = poses[pair.id1];
+		mTouching[i] = false;
+
+		// PT: the memory of caches written before the previous frame has been recycled
+		PairState& state = mStates[i];
+		if(state.mLastGeneratedFrame!=mFrame && state.mLastGeneratedFrame+1!=mFrame)
+			mCaches[i].reset();
+		state.mLastGeneratedFrame = mFrame;
+	}
+
+	mUserRecorder = &recorder;
+	mNbTouchingPairs = 0;
+
+	PxGenerateContacts(	mGeoms0.begin(), mGeoms1.begin(), mPoses0.begin(), mPoses1.begin(), mCaches.begin(), nbPairs, *this,
+						contactDistance, meshContactMargin, toleranceLength, mCacheAllocator);
+
+	mUserRecorder = NULL;
+
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		if(!mTouching[i])
+		{
+			Friction& friction = mFrictions[i];
+			friction.mPatches = NULL;
+			friction.mNbPatches = 0;
+			friction.mFrame = INVALID_FRAME;
+		}
+	}
+	return mNbTouchingPairs;
+}
+
+PxImmediatePairCache::PxImmediatePairCache(PxU32 maxAge)
+{
+	mImpl = new ImmediatePairCacheInternal(maxAge);
+}
+
+PxImmediatePairCache::~PxImmediatePairCache()
+{
+	delete mImpl;
+}
+
+void PxImmediatePairCache::beginFrame()
+{
+	mImpl->beginFrame();
+}
+
+PxU32 PxImmediatePairCache::addPair(PxU32 id0, PxU32 id1)
+{
+	return mImpl->addPair(id0, id1);
+}
+
+bool PxImmediatePairCache::removePair(PxU32 id0, PxU32 id1)
+{
+	const PxHashMap<PxU64, PxU32>::Entry* entry = mImpl->mPairMap.find(getPairKey(id0, id1));
+	if(!entry)
+		return false;
+	mImpl->removePairAt(entry->second);
+	return true;
+}
+
+PxU32 PxImmediatePairCache::removeObject(PxU32 id)
+{
+	PxU32 nbRemoved = 0;
+	PxU32 i = mImpl->mPairs.size();
+	while(i--)
+	{
+		const PxImmediatePair& pair = mImpl->mPairs[i];
+		if(pair.id0==id || pair.id1==id)
+		{
+			mImpl->removePairAt(i);
+			nbRemoved++;
+		}
+	}
+	return nbRemoved;
+}
+
+void PxImmediatePairCache::clear()
+{
+	mImpl->mPairMap.clear();
+	mImpl->mPairs.clear();
+	mImpl->mCaches.clear();
+	mImpl->mFrictions.clear();
+	mImpl->mStates.clear();
+}
+
+const PxImmediatePair* PxImmediatePairCache::getPairs(PxU32& nbPairs) const
+{
+	nbPairs = mImpl->mPairs.size();
+	return mImpl->mPairs.begin();
+}
+
+PxCache* PxImmediatePairCache::getCaches()
+{
+	return mImpl->mCaches.begin();
+}
+
+PxU32 PxImmediatePairCache::generateContacts(const PxGeometry*const* geometries, const PxTransform* poses, PxContactRecorder& recorder,
+											PxReal contactDistance, PxReal meshContactMargin, PxReal toleranceLength)
+{
+	return mImpl->generateContacts(geometries, poses, recorder, contactDistance, meshContactMargin, toleranceLength);
+}
+
+void PxImmediatePairCache::getFriction(PxU32 pairIndex, PxU8*& frictionPatches, PxU8& nbPatches) const
+{
+	PX_ASSERT(pairIndex<mImpl->mFrictions.size());
+	const Friction& friction = mImpl->mFrictions[pairIndex];
+
+	// PT: friction patches remain valid during the frame following their allocation
+	const PxU32 frame = mImpl->mFrame;
+	if(friction.mFrame==frame || friction.mFrame+1==frame)
+	{
+		frictionPatches = friction.mPatches;
+		nbPatches = PxU8(friction.mNbPatches);
+	}
+	else
+	{
+		frictionPatches = NULL;
+		nbPatches = 0;
+	}
+}
+
+void PxImmediatePairCache::setFriction(PxU32 pairIndex, PxU8* frictionPatches, PxU8 nbPatches)
+{
+	PX_ASSERT(pairIndex<mImpl->mFrictions.size());
+	Friction& friction = mImpl->mFrictions[pairIndex];
+	friction.mPatches = frictionPatches;
+	friction.mNbPatches = nbPatches;
+	friction.mFrame = mImpl->mFrame;
+}
+
+PxCacheAllocator& PxImmediatePairCache::getCacheAllocator()
+{
+	return mImpl->mCacheAllocator;
+}
+
+PxConstraintAllocator& PxImmediatePairCache::getConstraintAllocator()
+{
+	return mImpl->mConstraintAllocator;
+}
@@ -0,0 +1,635 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxImmediateWorld.h"
+#include "extensions/PxImmediatePairCache.h"
+#include "extensions/PxMassProperties.h"
+#include "geometry/PxGeometryHelpers.h"
+#include "geometry/PxGeometryQuery.h"
+#include "PxImmediateMode.h"
+#include "PxBroadPhase.h"
+
+#include "foundation/PxArray.h"
+#include "foundation/PxMathUtils.h"
+
+using namespace physx;
+using namespace immediate;
+
+namespace
+{
+	struct Body
+	{
+		PxGeometryHolder			mGeometry;
+		PxTransform					mBody2World;		// Center of mass frame
+		PxTransform					mBody2Actor;
+		PxTransform					mKinematicTarget;	// Actor pose
+		PxVec3						mLinearVelocity;
+		PxVec3						mAngularVelocity;
+		PxVec3						mInvInertia;
+		PxReal						mInvMass;
+		PxReal						mLinearDamping;
+		PxReal						mAngularDamping;
+		PxReal						mStaticFriction;
+		PxReal						mDynamicFriction;
+		PxReal						mRestitution;
+		PxU32						mSolverIndex;
+		PxImmediateBodyType::Enum	mType;
+		bool						mHasTarget;
+		bool						mInUse;
+
+		PX_FORCE_INLINE	PxTransform	getActorPose()	const
+		{
+			// PT:: tag: scalar transform*transform
+			return mBody2World * mBody2Actor.getInverse();
+		}
+	};
+
+	struct TouchingPair
+	{
+		PxU32	mPairIndex;
+		PxU32	mStartContact;
+		PxU32	mNbContacts;
+	};
+}
+
+namespace physx
+{
+class ImmediateWorldInternal : public PxContactRecorder
+{
+	PX_NOCOPY(ImmediateWorldInternal)
+	public:
+								ImmediateWorldInternal(const PxImmediateWorldDesc& desc);
+	virtual						~ImmediateWorldInternal();
+
+	// PxContactRecorder
+	virtual	bool				recordContacts(const PxContactPoint* contactPoints, PxU32 nbContacts, PxU32 index)	PX_OVERRIDE;
+	//~PxContactRecorder
+
+			PxU32				addBody(const PxGeometry& geometry, const PxImmediateBodyDesc& desc);
+			void				removeBody(PxU32 handle);
+			void				updateBounds(PxU32 handle);
+			void				step(PxReal dt);
+
+			void				addPair(PxU32 id0, PxU32 id1);
+			void				updateBroadPhase();
+			void				generateContacts();
+			void				solve(PxReal dt);
+
+	PX_FORCE_INLINE	bool		isValidHandle(PxU32 handle)	const	{ return handle<mBodies.size() && mBodies[handle].mInUse;	}
+
+			const PxImmediateWorldDesc	mDesc;
+
+			PxAABBManager*				mAABBManager;
+
+			// PT: pairs are created and lost by the incremental broadphase, so they never age out. Object indices are body handles.
+			// For each pair, the first body is always a dynamic body.
+			PxImmediatePairCache		mPairCache;
+
+			PxArray<Body>				mBodies;
+			PxArray<PxU32>				mFreeHandles;
+			PxArray<PxU32>				mRemovedHandles;	// Recycled after the next broadphase update
+
+			// PT: per-step buffers, kept to avoid reallocations
+			PxArray<const PxGeometry*>	mGeometries;	// Indexed by body handle
+			PxArray<PxTransform>		mPoses;			// Indexed by body handle
+			PxArray<PxContactPoint>		mContactPoints;
+			PxArray<PxReal>				mContactForces;
+			PxArray<TouchingPair>		mTouchingPairs;
+
+			PxArray<PxU32>						mSolverToHandle;
+			PxArray<PxRigidBodyData>			mRigidData;
+			PxArray<PxTGSSolverBodyVel>			mSolverBodies;
+			PxArray<PxTGSSolverBodyTxInertia>	mTxInertias;
+			PxArray<PxTGSSolverBodyData>		mSolverBodyData;
+			PxArray<PxTransform>				mGlobalPoses;
+			PxArray<PxSolverConstraintDesc>		mDescs;
+			PxArray<PxSolverConstraintDesc>		mOrderedDescs;
+			PxArray<PxConstraintBatchHeader>	mHeaders;
+};
+}
+
+ImmediateWorldInternal::ImmediateWorldInternal(const PxImmediateWorldDesc& desc) : mDesc(desc), mAABBManager(NULL), mPairCache(0xffffffff)
+{
+	PxBroadPhaseDesc bpDesc(PxBroadPhaseType::eABP);
+	bpDesc.mDiscardStaticVsKinematic = true;
+	bpDesc.mDiscardKinematicVsKinematic = true;
+	PxBroadPhase* bp = PxCreateBroadPhase(bpDesc);
+	if(bp)
+		mAABBManager = PxCreateAABBManager(*bp);
+}
+
+ImmediateWorldInternal::~ImmediateWorldInternal()
+{
+	if(mAABBManager)
+	{
+		PxBroadPhase* bp = &mAABBManager->getBroadPhase();
+		PX_RELEASE(mAABBManager);
+		PX_RELEASE(bp);
+	}
+}
+
+PxU32 ImmediateWorldInternal::addBody(const PxGeometry& geometry, const PxImmediateBodyDesc& desc)
+{
+	PxU32 handle;
+	if(mFreeHandles.size())
+		handle = mFreeHandles.popBack();
+	else
+	{
+		handle = mBodies.size();
+		mBodies.insert();
+	}
+
+	Body& body = mBodies[handle];
+	body.mGeometry.storeAny(geometry);
+	body.mType				= desc.type;
+	body.mLinearDamping		= desc.linearDamping;
+	body.mAngularDamping	= desc.angularDamping;
+	body.mStaticFriction	= desc.staticFriction;
+	body.mDynamicFriction	= desc.dynamicFriction;
+	body.mRestitution		= desc.restitution;
+	body.mSolverIndex		= 0;
+	body.mHasTarget			= false;
+	body.mInUse				= true;
+
+	if(desc.type==PxImmediateBodyType::eDYNAMIC)
+	{
+		PxMassProperties massProps(geometry);
+		massProps = massProps * desc.density;
+
+		PxQuat orient;
+		const PxVec3 inertia = PxMassProperties::getMassSpaceInertia(massProps.inertiaTensor, orient);
+
+		body.mBody2Actor		= PxTransform(massProps.centerOfMass, orient);
+		body.mInvMass			= massProps.mass > 0.0f ? 1.0f/massProps.mass : 0.0f;
+		body.mInvInertia		= PxVec3(	inertia.x > 0.0f ? 1.0f/inertia.x : 0.0f,
+											inertia.y > 0.0f ? 1.0f/inertia.y : 0.0f,
+											inertia.z > 0.0f ? 1.0f/inertia.z : 0.0f);
+		body.mLinearVelocity	= desc.linearVelocity;
+		body.mAngularVelocity	= desc.angularVelocity;
+	}
+	else
+	{
+		body.mBody2Actor		= PxTransform(PxIdentity);
+		body.mInvMass			= 0.0f;
+		body.mInvInertia		= PxVec3(0.0f);
+		body.mLinearVelocity	= PxVec3(0.0f);
+		body.mAngularVelocity	= PxVec3(0.0f);
+	}
+	// PT:: tag: scalar transform*transform
+	body.mBody2World		= desc.pose * body.mBody2Actor;
+	body.mKinematicTarget	= desc.pose;
+
+	PxBounds3 bounds;
+	PxGeometryQuery::computeGeomBounds(bounds, geometry, desc.pose, mDesc.contactDistance);
+
+	PxBpFilterGroup group;
+	if(desc.type==PxImmediateBodyType::eSTATIC)
+		group = PxGetBroadPhaseStaticFilterGroup();
+	else if(desc.type==PxImmediateBodyType::eKINEMATIC)
+		group = PxGetBroadPhaseKinematicFilterGroup(handle);
+	else
+		group = PxGetBroadPhaseDynamicFilterGroup(handle);
+	mAABBManager->addObject(handle, bounds, group);
+
+	return handle;
+}
+
+void ImmediateWorldInternal::removeBody(PxU32 handle)
+{
+	// PT: pairs are removed immediately, and the broadphase will report them as lost during the next update. The handle
+	// cannot be recycled before that, otherwise a new body could inherit the pairs of the removed one.
+	mPairCache.removeObject(handle);
+	mAABBManager->removeObject(handle);
+	mBodies[handle].mInUse = false;
+	mRemovedHandles.pushBack(handle);
+}
+
+void ImmediateWorldInternal::updateBounds(PxU32 handle)
+{
+	const Body& body = mBodies[handle];
+
+	PxBounds3 bounds;
+	PxGeometryQuery::computeGeomBounds(bounds, body.mGeometry.any(), body.getActorPose(), mDesc.contactDistance);
+	if(body.mHasTarget)
+	{
+		// PT: kinematic bodies are swept to their target, so that pairs exist before the bodies actually touch
+		PxBounds3 targetBounds;
+		PxGeometryQuery::computeGeomBounds(targetBounds, body.mGeometry.any(), body.mKinematicTarget, mDesc.contactDistance);
+		bounds.include(targetBounds);
+	}
+	mAABBManager->updateObject(handle, &bounds);
+}
+
+void ImmediateWorldInternal::addPair(PxU32 id0, PxU32 id1)
+{
+	if(mBodies[id0].mType!=PxImmediateBodyType::eDYNAMIC)
+		PxSwap(id0, id1);
+	PX_ASSERT(mBodies[id0].mType==PxImmediateBodyType::eDYNAMIC);
+
+	mPairCache.addPair(id0, id1);
+}
+
+void ImmediateWorldInternal::updateBroadPhase()
+{
+	const PxU32 nbBodies = mBodies.size();
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		const Body& body = mBodies[i];
+		if(body.mInUse && body.mType!=PxImmediateBodyType::eSTATIC)
+			updateBounds(i);
+	}
+
+	PxBroadPhaseResults results;
+	mAABBManager->updateAndFetchResults(results);
+
+	// PT: lost pairs first, in case the same pair is reported as lost and found in the same update
+	for(PxU32 i=0;i<results.mNbDeletedPairs;i++)
+		mPairCache.removePair(results.mDeletedPairs[i].mID0, results.mDeletedPairs[i].mID1);
+
+	for(PxU32 i=0;i<results.mNbCreatedPairs;i++)
+		addPair(results.mCreatedPairs[i].mID0, results.mCreatedPairs[i].mID1);
+
+	// PT: the lost pairs of removed bodies have now been reported, their handles can be recycled
+	const PxU32 nbRemoved = mRemovedHandles.size();
+	for(PxU32 i=0;i<nbRemoved;i++)
+		mFreeHandles.pushBack(mRemovedHandles[i]);
+	mRemovedHandles.clear();
+}
+
+bool ImmediateWorldInternal::recordContacts(const PxContactPoint* contactPoints, PxU32 nbContacts, PxU32 index)
+{
+	PxU32 nbPairs;
+	const PxImmediatePair& pair = mPairCache.getPairs(nbPairs)[index];
+	const Body& body0 = mBodies[pair.id0];
+	const Body& body1 = mBodies[pair.id1];
+
+	// PT: average combine mode, as for default PxMaterials
+	const PxReal staticFriction = (body0.mStaticFriction + body1.mStaticFriction)*0.5f;
+	const PxReal dynamicFriction = (body0.mDynamicFriction + body1.mDynamicFriction)*0.5f;
+	const PxReal restitution = (body0.mRestitution + body1.mRestitution)*0.5f;
+
+	TouchingPair touchingPair;
+	touchingPair.mPairIndex		= index;
+	touchingPair.mStartContact	= mContactPoints.size();
+	touchingPair.mNbContacts	= nbContacts;
+	mTouchingPairs.pushBack(touchingPair);
+
+	for(PxU32 i=0;i<nbContacts;i++)
+	{
+		PxContactPoint& point = mContactPoints.insert();
+		point = contactPoints[i];
+		point.maxImpulse		= PX_MAX_F32;
+		point.targetVel			= PxVec3(0.0f);
+		point.staticFriction	= staticFriction;
+		point.dynamicFriction	= dynamicFriction;
+		point.restitution		= restitution;
+		point.damping			= 0.0f;
+		point.materialFlags		= 0;
+	}
+	return true;
+}
+
+void ImmediateWorldInternal::generateContacts()
+{
+	const PxU32 nbBodies = mBodies.size();
+	mGeometries.resizeUninitialized(nbBodies);
+	mPoses.resizeUninitialized(nbBodies);
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		const Body& body = mBodies[i];
+		if(body.mInUse)
+		{
+			mGeometries[i] = &body.mGeometry.any();
+			mPoses[i] = body.getActorPose();
+		}
+		else
+		{
+			mGeometries[i] = NULL;
+			mPoses[i] = PxTransform(PxIdentity);
+		}
+	}
+
+	mContactPoints.clear();
+	mTouchingPairs.clear();
+
+	// PT: a single call for all pairs
+	mPairCache.generateContacts(mGeometries.begin(), mPoses.begin(), *this, mDesc.contactDistance, mDesc.meshContactMargin, mDesc.toleranceLength);
+}
+
+static void computeKinematicVelocity(const PxTransform& current, const PxTransform& target, PxReal invDt, PxVec3& linVel, PxVec3& angVel)
+{
+	linVel = (target.p - current.p) * invDt;
+
+	PxQuat dq = target.q * current.q.getConjugate();
+	if(dq.w<0.0f)
+		dq = -dq;
+	PxReal angle;
+	PxVec3 axis;
+	dq.toRadiansAndUnitAxis(angle, axis);
+	angVel = axis * (angle * invDt);
+}
+
+void ImmediateWorldInternal::solve(PxReal dt)
+{
+	const PxReal invDt = 1.0f/dt;
+	const PxReal stepDt = dt/PxReal(mDesc.nbPositionIterations);
+	const PxReal invStepDt = invDt*PxReal(mDesc.nbPositionIterations);
+
+	// PT: dynamic bodies go first. The solver treats bodies outside of [0, nbDynamics) as static or kinematic.
+	const PxU32 nbBodies = mBodies.size();
+	mSolverToHandle.clear();
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		Body& body = mBodies[i];
+		if(body.mInUse && body.mType==PxImmediateBodyType::eDYNAMIC)
+		{
+			body.mSolverIndex = mSolverToHandle.size();
+			mSolverToHandle.pushBack(i);
+		}
+	}
+	const PxU32 nbDynamics = mSolverToHandle.size();
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		Body& body = mBodies[i];
+		if(body.mInUse && body.mType!=PxImmediateBodyType::eDYNAMIC)
+		{
+			body.mSolverIndex = mSolverToHandle.size();
+			mSolverToHandle.pushBack(i);
+		}
+	}
+	const PxU32 nbSolverBodies = mSolverToHandle.size();
+
+	mRigidData.resizeUninitialized(nbSolverBodies);
+	mSolverBodies.resizeUninitialized(nbSolverBodies);
+	mTxInertias.resizeUninitialized(nbSolverBodies);
+	mSolverBodyData.resizeUninitialized(nbSolverBodies);
+	mGlobalPoses.resizeUninitialized(nbSolverBodies);
+
+	for(PxU32 i=0;i<nbSolverBodies;i++)
+	{
+		Body& body = mBodies[mSolverToHandle[i]];
+		mGlobalPoses[i] = body.mBody2World;
+
+		if(body.mType==PxImmediateBodyType::eSTATIC)
+		{
+			PxConstructStaticSolverBodyTGS(body.mBody2World, mSolverBodies[i], mTxInertias[i], mSolverBodyData[i]);
+			continue;
+		}
+
+		const bool isKinematic = body.mType==PxImmediateBodyType::eKINEMATIC;
+		if(isKinematic)
+		{
+			if(body.mHasTarget)
+				computeKinematicVelocity(body.mBody2World, body.mKinematicTarget * body.mBody2Actor, invDt, body.mLinearVelocity, body.mAngularVelocity);
+			else
+				body.mLinearVelocity = body.mAngularVelocity = PxVec3(0.0f);
+		}
+
+		PxRigidBodyData& data = mRigidData[i];
+		data.linearVelocity				= body.mLinearVelocity;
+		data.angularVelocity			= body.mAngularVelocity;
+		data.invMass					= body.mInvMass;
+		data.invInertia					= body.mInvInertia;
+		data.body2World					= body.mBody2World;
+		data.maxDepenetrationVelocity	= PX_MAX_F32;
+		data.maxContactImpulse			= PX_MAX_F32;
+		data.linearDamping				= isKinematic ? 0.0f : body.mLinearDamping;
+		data.angularDamping				= isKinematic ? 0.0f : body.mAngularDamping;
+		data.maxLinearVelocitySq		= PX_MAX_F32;
+		data.maxAngularVelocitySq		= isKinematic ? PX_MAX_F32 : 100.0f*100.0f;
+		data.pad						= 0;
+
+		// PT: dynamic bodies are constructed in one call below
+		if(isKinematic)
+			PxConstructSolverBodiesTGS(&data, &mSolverBodies[i], &mTxInertias[i], &mSolverBodyData[i], 1, PxVec3(0.0f), dt);
+	}
+	PxConstructSolverBodiesTGS(mRigidData.begin(), mSolverBodies.begin(), mTxInertias.begin(), mSolverBodyData.begin(), nbDynamics, mDesc.gravity, dt);
+
+	PxU32 nbPairs;
+	const PxImmediatePair* pairs = mPairCache.getPairs(nbPairs);
+
+	const PxU32 nbTouching = mTouchingPairs.size();
+	mContactForces.resizeUninitialized(mContactPoints.size());
+	mDescs.resizeUninitialized(nbTouching);
+	mOrderedDescs.resizeUninitialized(nbTouching);
+	mHeaders.resizeUninitialized(nbTouching);
+
+	for(PxU32 i=0;i<nbTouching;i++)
+	{
+		const PxImmediatePair& pair = pairs[mTouchingPairs[i].mPairIndex];
+		const PxU32 index0 = mBodies[pair.id0].mSolverIndex;
+		const PxU32 index1 = mBodies[pair.id1].mSolverIndex;
+
+		PxSolverConstraintDesc& desc = mDescs[i];
+		desc.tgsBodyA		= &mSolverBodies[index0];
+		desc.tgsBodyB		= &mSolverBodies[index1];
+		desc.bodyADataIndex	= index0;
+		desc.bodyBDataIndex	= index1;
+		desc.linkIndexA		= PxSolverConstraintDesc::RIGID_BODY;
+		desc.linkIndexB		= PxSolverConstraintDesc::RIGID_BODY;
+		// PT: the constraint pointer is ignored by the batching, we use it to find the pair back. It is overwritten when the constraint is created.
+		desc.constraint		= reinterpret_cast<PxU8*>(&mTouchingPairs[i]);
+		desc.constraintType	= PxSolverConstraintDesc::eCONTACT_CONSTRAINT;
+	}
+
+	const PxU32 nbHeaders = PxBatchConstraintsTGS(mDescs.begin(), nbTouching, mSolverBodies.begin(), nbDynamics, mHeaders.begin(), mOrderedDescs.begin());
+
+	for(PxU32 i=0;i<nbHeaders;i++)
+	{
+		PxConstraintBatchHeader& header = mHeaders[i];
+
+		PxTGSSolverContactDesc contactDescs[4];
+		PxU32 pairIndices[4];
+		for(PxU32 a=0;a<header.stride;a++)
+		{
+			PxSolverConstraintDesc& constraintDesc = mOrderedDescs[header.startIndex + a];
+			const TouchingPair& touchingPair = *reinterpret_cast<const TouchingPair*>(constraintDesc.constraint);
+			pairIndices[a] = touchingPair.mPairIndex;
+
+			const Body& body1 = mBodies[pairs[touchingPair.mPairIndex].id1];
+
+			PxTGSSolverContactDesc& contactDesc = contactDescs[a];
+			PxMemZero(&contactDesc, sizeof(contactDesc));
+			contactDesc.body0				= constraintDesc.tgsBodyA;
+			contactDesc.body1				= constraintDesc.tgsBodyB;
+			contactDesc.bodyData0			= &mSolverBodyData[constraintDesc.bodyADataIndex];
+			contactDesc.bodyData1			= &mSolverBodyData[constraintDesc.bodyBDataIndex];
+			contactDesc.body0TxI			= &mTxInertias[constraintDesc.bodyADataIndex];
+			contactDesc.body1TxI			= &mTxInertias[constraintDesc.bodyBDataIndex];
+			contactDesc.bodyFrame0			= mGlobalPoses[constraintDesc.bodyADataIndex];
+			contactDesc.bodyFrame1			= mGlobalPoses[constraintDesc.bodyBDataIndex];
+			contactDesc.contactForces		= &mContactForces[touchingPair.mStartContact];
+			contactDesc.contacts			= &mContactPoints[touchingPair.mStartContact];
+			contactDesc.numContacts			= touchingPair.mNbContacts;
+			mPairCache.getFriction(touchingPair.mPairIndex, contactDesc.frictionPtr, contactDesc.frictionCount);
+			contactDesc.maxCCDSeparation	= PX_MAX_F32;
+			contactDesc.bodyState0			= PxSolverConstraintPrepDescBase::eDYNAMIC_BODY;
+			contactDesc.bodyState1			= body1.mType==PxImmediateBodyType::eDYNAMIC ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY
+											: body1.mType==PxImmediateBodyType::eKINEMATIC ? PxSolverConstraintPrepDescBase::eKINEMATIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+			contactDesc.desc				= &constraintDesc;
+			contactDesc.invMassScales.angular0 = contactDesc.invMassScales.angular1 = contactDesc.invMassScales.linear0 = contactDesc.invMassScales.linear1 = 1.0f;
+		}
+
+		PxCreateContactConstraintsTGS(&header, 1, contactDescs, mPairCache.getConstraintAllocator(), invStepDt, invDt, -mDesc.bounceThreshold, mDesc.frictionOffsetThreshold, mDesc.correlationDistance);
+
+		// PT: keep the new friction patches for the next step
+		for(PxU32 a=0;a<header.stride;a++)
+			mPairCache.setFriction(pairIndices[a], contactDescs[a].frictionPtr, contactDescs[a].frictionCount);
+	}
+
+	PxSolveConstraintsTGS(mHeaders.begin(), nbHeaders, mOrderedDescs.begin(), mSolverBodies.begin(), mTxInertias.begin(), nbDynamics, mDesc.nbPositionIterations, mDesc.nbVelocityIterations, stepDt, invStepDt);
+
+	PxIntegrateSolverBodiesTGS(mSolverBodies.begin(), mTxInertias.begin(), mGlobalPoses.begin(), nbDynamics, dt);
+
+	for(PxU32 i=0;i<nbDynamics;i++)
+	{
+		Body& body = mBodies[mSolverToHandle[i]];
+		body.mLinearVelocity	= mSolverBodies[i].linearVelocity;
+		body.mAngularVelocity	= mSolverBodies[i].angularVelocity;
+		body.mBody2World		= mGlobalPoses[i];
+	}
+
+	for(PxU32 i=nbDynamics;i<nbSolverBodies;i++)
+	{
+		Body& body = mBodies[mSolverToHandle[i]];
+		if(body.mHasTarget)
+		{
+			// PT:: tag: scalar transform*transform
+			body.mBody2World = body.mKinematicTarget * body.mBody2Actor;
+			body.mHasTarget = false;
+		}
+	}
+}
+
+void ImmediateWorldInternal::step(PxReal dt)
+{
+	mPairCache.beginFrame();
+
+	updateBroadPhase();
+	generateContacts();
+	solve(dt);
+}
+
+PxImmediateWorld::PxImmediateWorld(const PxImmediateWorldDesc& desc)
+{
+	PX_ASSERT(desc.isValid());
+	mImpl = new ImmediateWorldInternal(desc);
+}
+
+PxImmediateWorld::~PxImmediateWorld()
+{
+	delete mImpl;
+}
+
+PxU32 PxImmediateWorld::addBody(const PxGeometry& geometry, const PxImmediateBodyDesc& desc)
+{
+	PX_CHECK_AND_RETURN_VAL(desc.isValid(), "PxImmediateWorld::addBody: invalid body descriptor", PX_INVALID_IMMEDIATE_BODY);
+	PX_CHECK_AND_RETURN_VAL(PxGeometryQuery::isValid(geometry), "PxImmediateWorld::addBody: invalid geometry", PX_INVALID_IMMEDIATE_BODY);
+
+	const PxGeometryType::Enum type = geometry.getType();
+	PX_CHECK_AND_RETURN_VAL(desc.type!=PxImmediateBodyType::eDYNAMIC || type==PxGeometryType::eSPHERE || type==PxGeometryType::eCAPSULE || type==PxGeometryType::eBOX || type==PxGeometryType::eCONVEXMESH,
+		"PxImmediateWorld::addBody: dynamic bodies must use a sphere, capsule, box or convex mesh geometry", PX_INVALID_IMMEDIATE_BODY);
+	PX_UNUSED(type);
+
+	return mImpl->addBody(geometry, desc);
+}
+
+void PxImmediateWorld::removeBody(PxU32 handle)
+{
+	PX_CHECK_AND_RETURN(mImpl->isValidHandle(handle), "PxImmediateWorld::removeBody: invalid handle");
+	mImpl->removeBody(handle);
+}
+
+void PxImmediateWorld::setPose(PxU32 handle, const PxTransform& pose)
+{
+	PX_CHECK_AND_RETURN(mImpl->isValidHandle(handle), "PxImmediateWorld::setPose: invalid handle");
+	PX_CHECK_AND_RETURN(pose.isValid(), "PxImmediateWorld::setPose: invalid pose");
+
+	Body& body = mImpl->mBodies[handle];
+	// PT:: tag: scalar transform*transform
+	body.mBody2World = pose * body.mBody2Actor;
+	body.mKinematicTarget = pose;
+	body.mHasTarget = false;
+
+	// PT: bounds of moving bodies are updated in each step anyway
+	if(body.mType==PxImmediateBodyType::eSTATIC)
+		mImpl->updateBounds(handle);
+}
+
+PxTransform PxImmediateWorld::getPose(PxU32 handle) const
+{
+	PX_CHECK_AND_RETURN_VAL(mImpl->isValidHandle(handle), "PxImmediateWorld::getPose: invalid handle", PxTransform(PxIdentity));
+	return mImpl->mBodies[handle].getActorPose();
+}
+
+void PxImmediateWorld::setVelocity(PxU32 handle, const PxVec3& linearVelocity, const PxVec3& angularVelocity)
+{
+	PX_CHECK_AND_RETURN(mImpl->isValidHandle(handle), "PxImmediateWorld::setVelocity: invalid handle");
+	PX_CHECK_AND_RETURN(linearVelocity.isFinite() && angularVelocity.isFinite(), "PxImmediateWorld::setVelocity: invalid velocity");
+
+	Body& body = mImpl->mBodies[handle];
+	PX_CHECK_AND_RETURN(body.mType==PxImmediateBodyType::eDYNAMIC, "PxImmediateWorld::setVelocity: body must be dynamic");
+	body.mLinearVelocity = linearVelocity;
+	body.mAngularVelocity = angularVelocity;
+}
+
+PxVec3 PxImmediateWorld::getLinearVelocity(PxU32 handle) const
+{
+	PX_CHECK_AND_RETURN_VAL(mImpl->isValidHandle(handle), "PxImmediateWorld::getLinearVelocity: invalid handle", PxVec3(0.0f));
+	return mImpl->mBodies[handle].mLinearVelocity;
+}
+
+PxVec3 PxImmediateWorld::getAngularVelocity(PxU32 handle) const
+{
+	PX_CHECK_AND_RETURN_VAL(mImpl->isValidHandle(handle), "PxImmediateWorld::getAngularVelocity: invalid handle", PxVec3(0.0f));
+	return mImpl->mBodies[handle].mAngularVelocity;
+}
+
+void PxImmediateWorld::setKinematicTarget(PxU32 handle, const PxTransform& target)
+{
+	PX_CHECK_AND_RETURN(mImpl->isValidHandle(handle), "PxImmediateWorld::setKinematicTarget: invalid handle");
+	PX_CHECK_AND_RETURN(target.isValid(), "PxImmediateWorld::setKinematicTarget: invalid target");
+
+	Body& body = mImpl->mBodies[handle];
+	PX_CHECK_AND_RETURN(body.mType==PxImmediateBodyType::eKINEMATIC, "PxImmediateWorld::setKinematicTarget: body must be kinematic");
+	body.mKinematicTarget = target;
+	body.mHasTarget = true;
+}
+
+void PxImmediateWorld::step(PxReal dt)
+{
+	PX_CHECK_AND_RETURN(dt>0.0f, "PxImmediateWorld::step: dt must be positive");
+	mImpl->step(dt);
+}
+
+PxU32 PxImmediateWorld::getNbPairs(PxU32& nbTouchingPairs) const
+{
+	nbTouchingPairs = mImpl->mTouchingPairs.size();
+
+	PxU32 nbPairs;
+	mImpl->mPairCache.getPairs(nbPairs);
+	return nbPairs;
+}
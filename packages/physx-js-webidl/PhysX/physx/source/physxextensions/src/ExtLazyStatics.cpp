@@ -0,0 +1,280 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxLazyStatics.h"
+#include "PxPhysics.h"
+#include "PxScene.h"
+#include "PxRigidStatic.h"
+#include "PxRigidDynamic.h"
+#include "geometry/PxBoxGeometry.h"
+#include "geometry/PxBVH.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+
+#include "cooking/PxBVHDesc.h"
+#include "cooking/PxCooking.h"
+
+using namespace physx;
+
+namespace physx
+{
+class LazyStaticsInternal
+{
+	PX_NOCOPY(LazyStaticsInternal)
+	public:
+				LazyStaticsInternal(PxScene& scene, PxReal margin);
+				~LazyStaticsInternal();
+
+		bool	addStatics(PxRigidStatic*const* actors, PxU32 nbActors);
+		void	removeStatic(PxRigidStatic& actor);
+		PxU32	update();
+		void	rebuildBVH();
+		bool	materialize(PxU32 boundsIndex);
+
+		struct LazyStatic
+		{
+			PxRigidStatic*	mActor;
+			bool			mMaterialized;
+		};
+
+		PxScene&								mScene;
+		const PxReal							mMargin;
+		PxArray<LazyStatic>						mStatics;
+		PxHashMap<const PxRigidStatic*, PxU32>	mStaticIndices;
+		PxBVH*									mBVH;
+		PxArray<PxU32>							mBVHToStatic;	// BVH bounds index => index in mStatics
+		PxArray<PxRigidDynamic*>				mDynamics;		// PT: scratch buffer for update()
+		PxU32									mNbMaterialized;
+		PxU32									mNbMaterializedInBVH;
+		bool									mBVHDirty;
+};
+}
+
+LazyStaticsInternal::LazyStaticsInternal(PxScene& scene, PxReal margin) :
+	mScene					(scene),
+	mMargin					(margin),
+	mBVH					(NULL),
+	mNbMaterialized			(0),
+	mNbMaterializedInBVH	(0),
+	mBVHDirty				(false)
+{
+}
+
+LazyStaticsInternal::~LazyStaticsInternal()
+{
+	PX_RELEASE(mBVH);
+}
+
+bool LazyStaticsInternal::addStatics(PxRigidStatic*const* actors, PxU32 nbActors)
+{
+	for(PxU32 i=0; i<nbActors; i++)
+	{
+		if(actors[i]->getScene())
+		{
+			PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxLazyStatics::addStatics(): actor already belongs to a scene!");
+			return false;
+		}
+	}
+
+	PxArray<PxActor*> sceneActors;
+	sceneActors.reserve(nbActors);
+	for(PxU32 i=0; i<nbActors; i++)
+	{
+		actors[i]->setActorFlag(PxActorFlag::eDISABLE_SIMULATION, true);
+		sceneActors.pushBack(actors[i]);
+	}
+
+	const bool status = mScene.addActors(sceneActors.begin(), nbActors);
+
+	// PT: addActors() stops at the first invalid actor, so we only track the ones that made it into the scene
+	for(PxU32 i=0; i<nbActors; i++)
+	{
+		if(actors[i]->getScene() != &mScene)
+			continue;
+
+		mStaticIndices[actors[i]] = mStatics.size();
+		LazyStatic& s = mStatics.insert();
+		s.mActor		= actors[i];
+		s.mMaterialized	= false;
+		mBVHDirty = true;
+	}
+	return status;
+}
+
+void LazyStaticsInternal::removeStatic(PxRigidStatic& actor)
+{
+	const PxHashMap<const PxRigidStatic*, PxU32>::Entry* entry = mStaticIndices.find(&actor);
+	if(!entry)
+		return;
+
+	const PxU32 index = entry->second;
+	if(mStatics[index].mMaterialized)
+		mNbMaterialized--;
+	mStaticIndices.erase(&actor);
+
+	mStatics.replaceWithLast(index);
+	if(index<mStatics.size())
+		mStaticIndices[mStatics[index].mActor] = index;
+
+	// PT: indices have changed, so we need a new BVH-to-static mapping
+	mBVHDirty = true;
+}
+
+void LazyStaticsInternal::rebuildBVH()
+{
+	PX_RELEASE(mBVH);
+	mBVHToStatic.clear();
+	mNbMaterializedInBVH = 0;
+	mBVHDirty = false;
+
+	PxArray<PxBounds3> bounds;
+	const PxU32 nbStatics = mStatics.size();
+	for(PxU32 i=0; i<nbStatics; i++)
+	{
+		if(mStatics[i].mMaterialized)
+			continue;
+
+		// PT: actors without shapes have empty bounds and never need to be simulated
+		const PxBounds3 b = mStatics[i].mActor->getWorldBounds();
+		if(b.isEmpty())
+			continue;
+
+		bounds.pushBack(b);
+		mBVHToStatic.pushBack(i);
+	}
+
+	if(!bounds.size())
+		return;
+
+	PxBVHDesc bvhDesc;
+	bvhDesc.bounds.count	= bounds.size();
+	bvhDesc.bounds.data		= bounds.begin();
+	bvhDesc.bounds.stride	= sizeof(PxBounds3);
+
+	mBVH = PxCreateBVH(bvhDesc, mScene.getPhysics().getPhysicsInsertionCallback());
+}
+
+bool LazyStaticsInternal::materialize(PxU32 boundsIndex)
+{
+	LazyStatic& s = mStatics[mBVHToStatic[boundsIndex]];
+	if(s.mMaterialized)
+		return false;
+
+	s.mActor->setActorFlag(PxActorFlag::eDISABLE_SIMULATION, false);
+	s.mMaterialized = true;
+	mNbMaterialized++;
+	mNbMaterializedInBVH++;
+	return true;
+}
+
+namespace
+{
+	struct MaterializeCallback : PxBVH::OverlapCallback
+	{
+		MaterializeCallback(LazyStaticsInternal& owner) : mOwner(owner), mNbMaterialized(0)	{}
+
+		virtual bool	reportHit(PxU32 boundsIndex)
+		{
+			if(mOwner.materialize(boundsIndex))
+				mNbMaterialized++;
+			return true;
+		}
+
+		LazyStaticsInternal&	mOwner;
+		PxU32					mNbMaterialized;
+
+		PX_NOCOPY(MaterializeCallback)
+	};
+}
+
+PxU32 LazyStaticsInternal::update()
+{
+	// PT: materialized statics stay in the BVH until enough of them accumulate to make a rebuild worth it
+	if(mBVHDirty || (mBVH && mNbMaterializedInBVH*2 > mBVH->getNbBounds()))
+		rebuildBVH();
+
+	if(!mBVH)
+		return 0;
+
+	const PxU32 nbDynamics = mScene.getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC);
+	mDynamics.resizeUninitialized(nbDynamics);
+	mScene.getActors(PxActorTypeFlag::eRIGID_DYNAMIC, reinterpret_cast<PxActor**>(mDynamics.begin()), nbDynamics);
+
+	MaterializeCallback cb(*this);
+	for(PxU32 i=0; i<nbDynamics; i++)
+	{
+		const PxRigidDynamic* actor = mDynamics[i];
+
+		// PT: sleeping actors don't move, so they cannot reach new statics
+		if(actor->getActorFlags().isSet(PxActorFlag::eDISABLE_SIMULATION) || actor->isSleeping())
+			continue;
+
+		PxBounds3 bounds = actor->getWorldBounds();
+		if(bounds.isEmpty())
+			continue;
+		bounds.fattenFast(mMargin);
+
+		mBVH->overlap(PxBoxGeometry(bounds.getExtents()), PxTransform(bounds.getCenter()), cb);
+	}
+	return cb.mNbMaterialized;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxLazyStatics::PxLazyStatics(PxScene& scene, PxReal margin)
+{
+	mImpl = new LazyStaticsInternal(scene, margin);
+}
+
+PxLazyStatics::~PxLazyStatics()
+{
+	delete mImpl;
+}
+
+bool PxLazyStatics::addStatics(PxRigidStatic*const* actors, PxU32 nbActors)
+{
+	return mImpl->addStatics(actors, nbActors);
+}
+
+void PxLazyStatics::removeStatic(PxRigidStatic& actor)
+{
+	mImpl->removeStatic(actor);
+}
+
+PxU32 PxLazyStatics::update()
+{
+	return mImpl->update();
+}
+
+PxU32 PxLazyStatics::getNbStatics() const
+{
+	return mImpl->mStatics.size();
+}
+
+PxU32 PxLazyStatics::getNbMaterialized() const
+{
+	return mImpl->mNbMaterialized;
+}
@@ -0,0 +1,261 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxMultiSceneScheduler.h"
+#include "PxScene.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxTime.h"
+
+using namespace physx;
+
+#define MAX_THROTTLE_INTERVAL	8	// PT: scenes over budget are simulated at least once every MAX_THROTTLE_INTERVAL steps
+
+namespace physx
+{
+class MultiSceneSchedulerInternal
+{
+	PX_NOCOPY(MultiSceneSchedulerInternal)
+	public:
+				MultiSceneSchedulerInternal(PxReal maxElapsedTime) : mMaxElapsedTime(maxElapsedTime)	{}
+
+		PxU32	findScene(const PxScene& scene)	const;
+		PxU32	step(PxReal elapsedTime, PxReal frameBudget);
+
+		struct SceneEntry
+		{
+			PxScene*	mScene;
+			PxU32		mPriority;
+			PxReal		mBudget;
+			PxReal		mAccumulatedTime;
+			PxReal		mLastStepTime;
+			PxU32		mInterval;		// Number of step() calls per simulation, from the budget
+			PxU32		mNbSkipped;		// Number of step() calls skipped because of mInterval
+			PxU32		mNbDeferred;	// Number of step() calls deferred because of the frame budget
+			PxU64		mStartTime;
+			bool		mRunning;
+
+			PX_FORCE_INLINE	PxU32	getEffectivePriority()	const	{ return mPriority + mNbDeferred;	}
+		};
+
+		struct PriorityPredicate
+		{
+			PriorityPredicate(const SceneEntry* entries) : mEntries(entries)	{}
+
+			PX_FORCE_INLINE bool operator()(PxU32 a, PxU32 b) const
+			{
+				return mEntries[a].getEffectivePriority() > mEntries[b].getEffectivePriority();
+			}
+
+			const SceneEntry*	mEntries;
+		};
+
+		const PxReal		mMaxElapsedTime;
+		PxArray<SceneEntry>	mEntries;
+		PxArray<PxU32>		mSelected;	// Scratch buffer for step()
+};
+}
+
+static PxReal getSecondsSince(PxU64 startTime)
+{
+	const PxU64 ticks = PxTime::getCurrentCounterValue() - startTime;
+	return PxReal(PxF64(PxTime::getBootCounterFrequency().toTensOfNanos(ticks)) / PxF64(PxTime::sNumTensOfNanoSecondsInASecond));
+}
+
+PxU32 MultiSceneSchedulerInternal::findScene(const PxScene& scene) const
+{
+	const PxU32 nbEntries = mEntries.size();
+	for(PxU32 i=0; i<nbEntries; i++)
+	{
+		if(mEntries[i].mScene == &scene)
+			return i;
+	}
+	return PX_INVALID_U32;
+}
+
+PxU32 MultiSceneSchedulerInternal::step(PxReal elapsedTime, PxReal frameBudget)
+{
+	const PxU32 nbEntries = mEntries.size();
+	SceneEntry* entries = mEntries.begin();
+
+	// PT: accumulate the elapsed time and skip the scenes throttled by their own budget
+	mSelected.clear();
+	for(PxU32 i=0; i<nbEntries; i++)
+	{
+		SceneEntry& entry = entries[i];
+		entry.mAccumulatedTime += elapsedTime;
+
+		if(entry.mNbSkipped + 1 < entry.mInterval)
+		{
+			entry.mNbSkipped++;
+			continue;
+		}
+		mSelected.pushBack(i);
+	}
+
+	// PT: high priority scenes first. They are selected first for the frame budget, and started first so that their
+	// tasks are queued before the others.
+	if(mSelected.size() > 1)
+		PxSort(mSelected.begin(), mSelected.size(), PriorityPredicate(entries));
+
+	PxU32 nbSelected = 0;
+	PxReal predictedTime = 0.0f;
+	for(PxU32 i=0; i<mSelected.size(); i++)
+	{
+		SceneEntry& entry = entries[mSelected[i]];
+
+		// PT: the first scene always runs, so that a single expensive scene cannot stall everything
+		if(frameBudget > 0.0f && nbSelected && predictedTime + entry.mLastStepTime > frameBudget)
+		{
+			entry.mNbDeferred++;
+			continue;
+		}
+
+		predictedTime += entry.mLastStepTime;
+		mSelected[nbSelected++] = mSelected[i];
+	}
+
+	// PT: start all selected scenes before waiting for any of them, so that their stages interleave on the workers
+	PxU32 nbRunning = 0;
+	for(PxU32 i=0; i<nbSelected; i++)
+	{
+		SceneEntry& entry = entries[mSelected[i]];
+
+		const PxReal dt = entry.mAccumulatedTime < mMaxElapsedTime ? entry.mAccumulatedTime : mMaxElapsedTime;
+		entry.mAccumulatedTime = 0.0f;
+		entry.mNbSkipped = 0;
+		entry.mNbDeferred = 0;
+		entry.mStartTime = PxTime::getCurrentCounterValue();
+		entry.mRunning = dt > 0.0f && entry.mScene->simulate(dt);
+		if(entry.mRunning)
+			nbRunning++;
+	}
+
+	// PT: fetch the results in completion order, rather than in a fixed order that would block on slow scenes
+	while(nbRunning)
+	{
+		bool progress = false;
+		for(PxU32 i=0; i<nbSelected; i++)
+		{
+			SceneEntry& entry = entries[mSelected[i]];
+			if(!entry.mRunning || !entry.mScene->checkResults(false))
+				continue;
+
+			entry.mScene->fetchResults(true);
+			entry.mRunning = false;
+			entry.mLastStepTime = getSecondsSince(entry.mStartTime);
+			nbRunning--;
+			progress = true;
+
+			PxU32 interval = 1;
+			if(entry.mBudget > 0.0f && entry.mLastStepTime > entry.mBudget)
+			{
+				const PxReal ratio = entry.mLastStepTime / entry.mBudget;
+				interval = ratio < PxReal(MAX_THROTTLE_INTERVAL) ? PxU32(ratio) + 1 : MAX_THROTTLE_INTERVAL;
+			}
+			entry.mInterval = interval;
+		}
+
+		if(!progress)
+			PxThread::yield();
+	}
+	return nbSelected;
+}
+
+PxMultiSceneScheduler::PxMultiSceneScheduler(PxReal maxElapsedTime)
+{
+	mImpl = new MultiSceneSchedulerInternal(maxElapsedTime);
+}
+
+PxMultiSceneScheduler::~PxMultiSceneScheduler()
+{
+	delete mImpl;
+}
+
+bool PxMultiSceneScheduler::addScene(PxScene& scene, PxU32 priority, PxReal budget)
+{
+	if(mImpl->findScene(scene) != PX_INVALID_U32)
+		return false;
+
+	MultiSceneSchedulerInternal::SceneEntry entry;
+	entry.mScene			= &scene;
+	entry.mPriority			= priority;
+	entry.mBudget			= budget;
+	entry.mAccumulatedTime	= 0.0f;
+	entry.mLastStepTime		= 0.0f;
+	entry.mInterval			= 1;
+	entry.mNbSkipped		= 0;
+	entry.mNbDeferred		= 0;
+	entry.mStartTime		= 0;
+	entry.mRunning			= false;
+	mImpl->mEntries.pushBack(entry);
+	return true;
+}
+
+bool PxMultiSceneScheduler::removeScene(PxScene& scene)
+{
+	const PxU32 index = mImpl->findScene(scene);
+	if(index == PX_INVALID_U32)
+		return false;
+
+	mImpl->mEntries.remove(index);
+	return true;
+}
+
+bool PxMultiSceneScheduler::setPriority(PxScene& scene, PxU32 priority)
+{
+	const PxU32 index = mImpl->findScene(scene);
+	if(index == PX_INVALID_U32)
+		return false;
+
+	mImpl->mEntries[index].mPriority = priority;
+	return true;
+}
+
+bool PxMultiSceneScheduler::setBudget(PxScene& scene, PxReal budget)
+{
+	const PxU32 index = mImpl->findScene(scene);
+	if(index == PX_INVALID_U32)
+		return false;
+
+	MultiSceneSchedulerInternal::SceneEntry& entry = mImpl->mEntries[index];
+	entry.mBudget = budget;
+	if(budget <= 0.0f)
+		entry.mInterval = 1;
+	return true;
+}
+
+PxU32 PxMultiSceneScheduler::step(PxReal elapsedTime, PxReal frameBudget)
+{
+	return mImpl->step(elapsedTime, frameBudget);
+}
+
+PxReal PxMultiSceneScheduler::getLastStepTime(const PxScene& scene) const
+{
+	const PxU32 index = mImpl->findScene(scene);
+	return index != PX_INVALID_U32 ? mImpl->mEntries[index].mLastStepTime : -1.0f;
+}
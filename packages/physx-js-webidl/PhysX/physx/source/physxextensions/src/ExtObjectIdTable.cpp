@@ -0,0 +1,185 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxObjectIdTable.h"
+#include "PxRigidActor.h"
+#include "PxShape.h"
+#include "PxQueryReport.h"
+#include "PxSimulationEventCallback.h"
+
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "CmIDPool.h"
+
+using namespace physx;
+
+namespace physx
+{
+class ObjectIdTableInternal
+{
+	PX_NOCOPY(ObjectIdTableInternal)
+	public:
+				ObjectIdTableInternal(bool storeIdsInUserData) : mStoreIdsInUserData(storeIdsInUserData)	{}
+				~ObjectIdTableInternal()																	{}
+
+		PX_FORCE_INLINE	PxU32	getId(const PxBase* object)	const
+		{
+			if(!object)
+				return PX_INVALID_U32;
+			const PxHashMap<const PxBase*, PxU32>::Entry* entry = mIds.find(object);
+			return entry ? entry->second : PX_INVALID_U32;
+		}
+
+		template<class HitType>
+		void	getHitIds(const HitType* hits, PxU32 nbHits, PxU32* ids)	const
+		{
+			for(PxU32 i=0;i<nbHits;i++)
+			{
+				ids[i*2+0] = getId(hits[i].actor);
+				ids[i*2+1] = getId(hits[i].shape);
+			}
+		}
+
+		void	setUserData(PxBase& object, void* userData)
+		{
+			if(PxActor* actor = object.is<PxActor>())
+				actor->userData = userData;
+			else if(PxShape* shape = object.is<PxShape>())
+				shape->userData = userData;
+		}
+
+		PxHashMap<const PxBase*, PxU32>	mIds;
+		PxArray<PxBase*>				mObjects;	// Indexed by id
+		Cm::DeferredIDPool				mIdPool;
+		const bool						mStoreIdsInUserData;
+};
+}
+
+PxObjectIdTable::PxObjectIdTable(bool storeIdsInUserData)
+{
+	mImpl = new ObjectIdTableInternal(storeIdsInUserData);
+}
+
+PxObjectIdTable::~PxObjectIdTable()
+{
+	delete mImpl;
+}
+
+PxU32 PxObjectIdTable::add(PxBase& object)
+{
+	const PxU32 existingId = mImpl->getId(&object);
+	if(existingId != PX_INVALID_U32)
+		return existingId;
+
+	const PxU32 id = mImpl->mIdPool.getNewID();
+	if(id >= mImpl->mObjects.size())
+		mImpl->mObjects.resize(id+1, NULL);
+	mImpl->mObjects[id] = &object;
+	mImpl->mIds.insert(&object, id);
+
+	if(mImpl->mStoreIdsInUserData)
+		mImpl->setUserData(object, reinterpret_cast<void*>(size_t(id)));
+	return id;
+}
+
+bool PxObjectIdTable::remove(PxBase& object)
+{
+	PxHashMap<const PxBase*, PxU32>::Entry entry;
+	if(!mImpl->mIds.erase(&object, entry))
+		return false;
+
+	// PT: the id is only recycled by processDeferredIds(), so that it cannot alias another object within the same frame
+	mImpl->mObjects[entry.second] = NULL;
+	mImpl->mIdPool.deferredFreeID(entry.second);
+
+	if(mImpl->mStoreIdsInUserData)
+		mImpl->setUserData(object, NULL);
+	return true;
+}
+
+void PxObjectIdTable::processDeferredIds()
+{
+	mImpl->mIdPool.processDeferredIds();
+}
+
+PxU32 PxObjectIdTable::getId(const PxBase* object) const
+{
+	return mImpl->getId(object);
+}
+
+PxBase* PxObjectIdTable::getObject(PxU32 id) const
+{
+	return id < mImpl->mObjects.size() ? mImpl->mObjects[id] : NULL;
+}
+
+PxU32 PxObjectIdTable::getNbObjects() const
+{
+	return mImpl->mIds.size();
+}
+
+PxU32 PxObjectIdTable::getMaxId() const
+{
+	return mImpl->mIdPool.getMaxID();
+}
+
+void PxObjectIdTable::getHitIds(const PxRaycastHit* hits, PxU32 nbHits, PxU32* ids) const
+{
+	mImpl->getHitIds(hits, nbHits, ids);
+}
+
+void PxObjectIdTable::getHitIds(const PxSweepHit* hits, PxU32 nbHits, PxU32* ids) const
+{
+	mImpl->getHitIds(hits, nbHits, ids);
+}
+
+void PxObjectIdTable::getHitIds(const PxOverlapHit* hits, PxU32 nbHits, PxU32* ids) const
+{
+	mImpl->getHitIds(hits, nbHits, ids);
+}
+
+void PxObjectIdTable::getContactPairIds(const PxContactPairHeader& pairHeader, const PxContactPair* pairs, PxU32 nbPairs, PxU32* ids) const
+{
+	const PxU32 actorId0 = mImpl->getId(pairHeader.actors[0]);
+	const PxU32 actorId1 = mImpl->getId(pairHeader.actors[1]);
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		ids[i*4+0] = actorId0;
+		ids[i*4+1] = actorId1;
+		ids[i*4+2] = mImpl->getId(pairs[i].shapes[0]);
+		ids[i*4+3] = mImpl->getId(pairs[i].shapes[1]);
+	}
+}
+
+void PxObjectIdTable::getTriggerPairIds(const PxTriggerPair* pairs, PxU32 nbPairs, PxU32* ids) const
+{
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		ids[i*4+0] = mImpl->getId(pairs[i].triggerActor);
+		ids[i*4+1] = mImpl->getId(pairs[i].triggerShape);
+		ids[i*4+2] = mImpl->getId(pairs[i].otherActor);
+		ids[i*4+3] = mImpl->getId(pairs[i].otherShape);
+	}
+}
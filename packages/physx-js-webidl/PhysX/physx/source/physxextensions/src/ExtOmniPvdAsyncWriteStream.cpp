@@ -0,0 +1,206 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxOmniPvdAsyncWriteStream.h"
+#include "foundation/PxAllocator.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxSync.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxUtilities.h"
+#include "../pvdruntime/include/OmniPvdWriteStream.h"
+
+using namespace physx;
+
+namespace physx
+{
+namespace Ext
+{
+	class OmniPvdAsyncWriteStream;
+
+	class OmniPvdWriterThread : public PxThread
+	{
+		PX_NOCOPY(OmniPvdWriterThread)
+	public:
+						OmniPvdWriterThread(OmniPvdAsyncWriteStream& owner) : mOwner(owner)	{}
+		virtual void	execute()	PX_OVERRIDE;
+	private:
+		OmniPvdAsyncWriteStream&	mOwner;
+	};
+
+	// PT: double buffering. The OmniPvd writer (serialized by PxOmniPvd's exclusive writer access) fills the front
+	// buffer, the background thread writes the back buffer. mBackSize is non-zero while the back buffer is pending.
+	class OmniPvdAsyncWriteStream : public PxOmniPvdAsyncWriteStream, public OmniPvdWriteStream, public PxUserAllocated
+	{
+		PX_NOCOPY(OmniPvdAsyncWriteStream)
+	public:
+								OmniPvdAsyncWriteStream(OmniPvdWriteStream& targetStream, PxU32 bufferSize);
+		virtual					~OmniPvdAsyncWriteStream();
+
+		// PxOmniPvdAsyncWriteStream
+		virtual OmniPvdWriteStream&	getStream()	PX_OVERRIDE	{ return *this;		}
+		virtual PxU32				getNbStalls()	const	PX_OVERRIDE	{ return mNbStalls;	}
+		virtual void				release()	PX_OVERRIDE	{ PX_DELETE_THIS;	}
+
+		// OmniPvdWriteStream
+		virtual uint64_t OMNI_PVD_CALL	writeBytes(const uint8_t* bytes, uint64_t nbrBytes)	PX_OVERRIDE;
+		virtual bool OMNI_PVD_CALL		flush()	PX_OVERRIDE;
+		virtual bool OMNI_PVD_CALL		openStream()	PX_OVERRIDE	{ return mTarget.openStream();	}
+		virtual bool OMNI_PVD_CALL		closeStream()	PX_OVERRIDE;
+
+				void			runWriter();
+	private:
+				void			submitFront();
+				void			waitForBack();
+
+		OmniPvdWriteStream&	mTarget;
+		OmniPvdWriterThread	mThread;
+		PxSync				mBufferReady;
+		PxSync				mBufferWritten;
+		PxU8*				mFront;
+		PxU8*				mBack;
+		PxU32				mCapacity;
+		PxU32				mFrontSize;
+		volatile PxI32		mBackSize;
+		PxU32				mNbStalls;
+	};
+}
+}
+
+void Ext::OmniPvdWriterThread::execute()
+{
+	mOwner.runWriter();
+	quit();
+}
+
+PxOmniPvdAsyncWriteStream* physx::PxOmniPvdAsyncWriteStreamCreate(OmniPvdWriteStream& targetStream, PxU32 bufferSize)
+{
+	PX_CHECK_AND_RETURN_NULL(bufferSize>0 && bufferSize<=0x7fffffff, "PxOmniPvdAsyncWriteStreamCreate: invalid buffer size");
+	return PX_NEW(Ext::OmniPvdAsyncWriteStream)(targetStream, bufferSize);
+}
+
+Ext::OmniPvdAsyncWriteStream::OmniPvdAsyncWriteStream(OmniPvdWriteStream& targetStream, PxU32 bufferSize) :
+	mTarget		(targetStream),
+	mThread		(*this),
+	mCapacity	(bufferSize),
+	mFrontSize	(0),
+	mBackSize	(0),
+	mNbStalls	(0)
+{
+	mFront = PX_ALLOCATE(PxU8, bufferSize, "OmniPvdAsyncWriteStream");
+	mBack = PX_ALLOCATE(PxU8, bufferSize, "OmniPvdAsyncWriteStream");
+	mThread.start();
+	mThread.setName("PxOmniPvdAsyncWriteStream");
+}
+
+Ext::OmniPvdAsyncWriteStream::~OmniPvdAsyncWriteStream()
+{
+	submitFront();
+	waitForBack();
+
+	mThread.signalQuit();
+	mBufferReady.set();
+	mThread.waitForQuit();
+
+	PX_FREE(mBack);
+	PX_FREE(mFront);
+}
+
+void Ext::OmniPvdAsyncWriteStream::runWriter()
+{
+	while(true)
+	{
+		mBufferReady.wait();
+		mBufferReady.reset();
+
+		if(mBackSize)
+		{
+			mTarget.writeBytes(mBack, uint64_t(mBackSize));
+			PxAtomicExchange(&mBackSize, 0);
+			mBufferWritten.set();
+		}
+
+		if(mThread.quitIsSignalled())
+			break;
+	}
+}
+
+void Ext::OmniPvdAsyncWriteStream::waitForBack()
+{
+	while(mBackSize)
+		mBufferWritten.wait();
+}
+
+void Ext::OmniPvdAsyncWriteStream::submitFront()
+{
+	if(!mFrontSize)
+		return;
+
+	waitForBack();
+
+	// PT: the writer thread is idle here, it cannot set mBufferWritten before the next submission
+	mBufferWritten.reset();
+	PxSwap(mFront, mBack);
+	PxAtomicExchange(&mBackSize, PxI32(mFrontSize));
+	mFrontSize = 0;
+	mBufferReady.set();
+}
+
+uint64_t Ext::OmniPvdAsyncWriteStream::writeBytes(const uint8_t* bytes, uint64_t nbrBytes)
+{
+	if(mFrontSize + nbrBytes > mCapacity)
+	{
+		if(mBackSize)
+			mNbStalls++;
+		submitFront();
+
+		// PT: large writes go to the target directly, once the previous data has been written to keep the order
+		if(nbrBytes > mCapacity)
+		{
+			waitForBack();
+			return mTarget.writeBytes(bytes, nbrBytes);
+		}
+	}
+
+	PxMemCopy(mFront + mFrontSize, bytes, PxU32(nbrBytes));
+	mFrontSize += PxU32(nbrBytes);
+	return nbrBytes;
+}
+
+bool Ext::OmniPvdAsyncWriteStream::flush()
+{
+	submitFront();
+	waitForBack();
+	return mTarget.flush();
+}
+
+bool Ext::OmniPvdAsyncWriteStream::closeStream()
+{
+	submitFront();
+	waitForBack();
+	return mTarget.closeStream();
+}
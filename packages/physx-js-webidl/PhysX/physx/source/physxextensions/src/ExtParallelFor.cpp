@@ -0,0 +1,154 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxParallelFor.h"
+#include "task/PxCpuDispatcher.h"
+#include "task/PxTask.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxUserAllocated.h"
+
+using namespace physx;
+
+namespace
+{
+	class ParallelForJob;
+
+	// PT: we don't use PxLightCpuTask here because it needs a PxTaskManager for its reference counting. These tasks are
+	// submitted directly to the dispatcher, which calls run() and then release().
+	class ParallelForTask : public PxBaseTask
+	{
+		public:
+									ParallelForTask() : mJob(NULL)	{}
+
+		virtual	void				run()							PX_OVERRIDE;
+		virtual	const char*			getName()				const	PX_OVERRIDE	{ return "PxParallelFor";	}
+		virtual	void				addReference()					PX_OVERRIDE	{}
+		virtual	void				removeReference()				PX_OVERRIDE	{}
+		virtual	int32_t				getReference()			const	PX_OVERRIDE	{ return 1;					}
+		virtual	void				release()						PX_OVERRIDE;
+
+				ParallelForJob*		mJob;
+	};
+
+	// PT: the job is heap-allocated and reference counted, because tasks can still be sitting in a dispatcher queue when
+	// PxParallelFor() returns (e.g. when all chunks got processed by the calling thread). Such late tasks find no chunk
+	// left and only drop their reference.
+	class ParallelForJob : public PxUserAllocated
+	{
+		public:
+								ParallelForJob(PxParallelForCallback& callback, PxU32 count, PxU32 grain, PxU32 nbTasks) :
+									mCallback		(callback),
+									mCount			(count),
+									mGrain			(grain),
+									mNbChunks		((count + grain - 1)/grain),
+									mNextChunk		(0),
+									mNbDoneChunks	(0),
+									mRefCount		(PxI32(nbTasks + 1))	// PT: +1 for the calling thread
+								{
+									mTasks.resize(nbTasks);
+									for(PxU32 i=0;i<nbTasks;i++)
+										mTasks[i].mJob = this;
+								}
+
+				void			processChunks()
+								{
+									for(;;)
+									{
+										const PxU32 chunk = PxU32(PxAtomicIncrement(&mNextChunk) - 1);
+										if(chunk >= mNbChunks)
+											break;
+
+										const PxU32 startIndex = chunk * mGrain;
+										const PxU32 endIndex = mCount - startIndex > mGrain ? startIndex + mGrain : mCount;
+										mCallback.process(startIndex, endIndex);
+
+										PxAtomicIncrement(&mNbDoneChunks);
+									}
+								}
+
+				void			releaseReference()
+								{
+									if(!PxAtomicDecrement(&mRefCount))
+										PX_DELETE_THIS;
+								}
+
+		PxParallelForCallback&	mCallback;
+		const PxU32				mCount;
+		const PxU32				mGrain;
+		const PxU32				mNbChunks;
+		volatile PxI32			mNextChunk;
+		volatile PxI32			mNbDoneChunks;
+		volatile PxI32			mRefCount;
+		PxArray<ParallelForTask>	mTasks;
+
+		PX_NOCOPY(ParallelForJob)
+	};
+
+	void ParallelForTask::run()
+	{
+		mJob->processChunks();
+	}
+
+	void ParallelForTask::release()
+	{
+		mJob->releaseReference();
+	}
+}
+
+void physx::PxParallelFor(PxCpuDispatcher* dispatcher, PxU32 count, PxU32 grain, PxParallelForCallback& callback)
+{
+	if(!count)
+		return;
+
+	if(!grain)
+		grain = 1;
+
+	const PxU32 nbChunks = (count + grain - 1)/grain;
+	const PxU32 nbWorkers = dispatcher ? dispatcher->getWorkerCount() : 0;
+
+	// PT: the calling thread takes a share of the work, so we need at most nbChunks-1 tasks
+	const PxU32 nbTasks = nbWorkers < nbChunks - 1 ? nbWorkers : nbChunks - 1;
+	if(!nbTasks)
+	{
+		callback.process(0, count);
+		return;
+	}
+
+	ParallelForJob* job = PX_NEW(ParallelForJob)(callback, count, grain, nbTasks);
+
+	for(PxU32 i=0;i<nbTasks;i++)
+		dispatcher->submitTask(job->mTasks[i]);
+
+	job->processChunks();
+
+	// PT: wait for the chunks picked up by other threads. We don't wait for the tasks themselves, see ParallelForJob.
+	while(PxU32(job->mNbDoneChunks) != nbChunks)
+		PxThread::yield();
+
+	job->releaseReference();
+}
@@ -0,0 +1,375 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxQueryTrace.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxIO.h"
+#include "PxScene.h"
+#include "PxQueryReport.h"
+
+using namespace physx;
+
+namespace
+{
+	static const PxU32	gTraceMagic = 0x54515850;	// 'PXQT'
+	static const PxU32	gTraceVersion = 1;
+	static const PxU32	gMaxNbReplayTouches = 64;
+
+	// PT: geometries are stored as their type followed by up to 3 parameters
+	static const PxU32	gNbGeomParams = 3;
+
+	PX_FORCE_INLINE bool isRecordable(const PxGeometry& geometry)
+	{
+		const PxGeometryType::Enum type = geometry.getType();
+		return type==PxGeometryType::eSPHERE || type==PxGeometryType::eCAPSULE || type==PxGeometryType::eBOX;
+	}
+
+	class StreamWriter
+	{
+		public:
+						StreamWriter(PxOutputStream& stream) : mStream(stream), mOk(true)	{}
+
+			void		writeU32(PxU32 value)	{ write(&value, sizeof(PxU32));	}
+			void		writeF32(PxReal value)	{ write(&value, sizeof(PxReal));	}
+			void		writeVec3(const PxVec3& v)
+						{
+							writeF32(v.x);
+							writeF32(v.y);
+							writeF32(v.z);
+						}
+
+			bool		isOk()	const	{ return mOk;	}
+		private:
+			void		write(const void* data, PxU32 size)
+						{
+							if(mOk && mStream.write(data, size)!=size)
+								mOk = false;
+						}
+
+			PxOutputStream&	mStream;
+			bool			mOk;
+	};
+
+	class StreamReader
+	{
+		public:
+						StreamReader(PxInputStream& stream) : mStream(stream), mOk(true)	{}
+
+			PxU32		readU32()
+						{
+							PxU32 value = 0;
+							read(&value, sizeof(PxU32));
+							return value;
+						}
+
+			PxReal		readF32()
+						{
+							PxReal value = 0.0f;
+							read(&value, sizeof(PxReal));
+							return value;
+						}
+
+			PxVec3		readVec3()
+						{
+							const PxReal x = readF32();
+							const PxReal y = readF32();
+							const PxReal z = readF32();
+							return PxVec3(x, y, z);
+						}
+
+			bool		isOk()	const	{ return mOk;	}
+		private:
+			void		read(void* data, PxU32 size)
+						{
+							if(mOk && mStream.read(data, size)!=size)
+								mOk = false;
+						}
+
+			PxInputStream&	mStream;
+			bool			mOk;
+	};
+}
+
+namespace physx
+{
+class QueryTraceInternal
+{
+	public:
+							QueryTraceInternal() : mNbDropped(0)	{}
+
+	PX_FORCE_INLINE	void	add(const PxQueryTraceEntry& entry)
+							{
+								PxMutex::ScopedLock lock(mMutex);
+								mEntries.pushBack(entry);
+							}
+
+	PX_FORCE_INLINE	void	drop()
+							{
+								PxMutex::ScopedLock lock(mMutex);
+								mNbDropped++;
+							}
+
+	PxMutex							mMutex;
+	PxArray<PxQueryTraceEntry>		mEntries;
+	PxU32							mNbDropped;
+};
+}
+
+PxQueryTrace::PxQueryTrace()
+{
+	mImpl = new QueryTraceInternal;
+}
+
+PxQueryTrace::~PxQueryTrace()
+{
+	delete mImpl;
+}
+
+void PxQueryTrace::recordRaycast(const PxVec3& origin, const PxVec3& unitDir, PxReal distance, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxU32 maxNbTouches)
+{
+	PxQueryTraceEntry entry;
+	entry.geometry.storeAny(PxSphereGeometry(0.0f));
+	entry.pose			= PxTransform(origin);
+	entry.unitDir		= unitDir;
+	entry.distance		= distance;
+	entry.inflation		= 0.0f;
+	entry.filterData	= filterData;
+	entry.hitFlags		= hitFlags;
+	entry.maxNbTouches	= maxNbTouches;
+	entry.type			= PxQueryTraceType::eRAYCAST;
+	mImpl->add(entry);
+}
+
+void PxQueryTrace::recordSweep(const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, PxReal distance, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxU32 maxNbTouches, PxReal inflation)
+{
+	if(!isRecordable(geometry))
+	{
+		mImpl->drop();
+		return;
+	}
+
+	PxQueryTraceEntry entry;
+	entry.geometry.storeAny(geometry);
+	entry.pose			= pose;
+	entry.unitDir		= unitDir;
+	entry.distance		= distance;
+	entry.inflation		= inflation;
+	entry.filterData	= filterData;
+	entry.hitFlags		= hitFlags;
+	entry.maxNbTouches	= maxNbTouches;
+	entry.type			= PxQueryTraceType::eSWEEP;
+	mImpl->add(entry);
+}
+
+void PxQueryTrace::recordOverlap(const PxGeometry& geometry, const PxTransform& pose, const PxQueryFilterData& filterData, PxU32 maxNbTouches)
+{
+	if(!isRecordable(geometry))
+	{
+		mImpl->drop();
+		return;
+	}
+
+	PxQueryTraceEntry entry;
+	entry.geometry.storeAny(geometry);
+	entry.pose			= pose;
+	entry.unitDir		= PxVec3(0.0f);
+	entry.distance		= 0.0f;
+	entry.inflation		= 0.0f;
+	entry.filterData	= filterData;
+	entry.hitFlags		= PxHitFlags(0);
+	entry.maxNbTouches	= maxNbTouches;
+	entry.type			= PxQueryTraceType::eOVERLAP;
+	mImpl->add(entry);
+}
+
+PxU32 PxQueryTrace::getNbEntries() const
+{
+	return mImpl->mEntries.size();
+}
+
+const PxQueryTraceEntry* PxQueryTrace::getEntries() const
+{
+	return mImpl->mEntries.begin();
+}
+
+PxU32 PxQueryTrace::getNbDroppedQueries() const
+{
+	return mImpl->mNbDropped;
+}
+
+void PxQueryTrace::clear()
+{
+	PxMutex::ScopedLock lock(mImpl->mMutex);
+	mImpl->mEntries.clear();
+	mImpl->mNbDropped = 0;
+}
+
+bool PxQueryTrace::save(PxOutputStream& stream) const
+{
+	PxMutex::ScopedLock lock(mImpl->mMutex);
+
+	StreamWriter writer(stream);
+	const PxU32 nbEntries = mImpl->mEntries.size();
+	writer.writeU32(gTraceMagic);
+	writer.writeU32(gTraceVersion);
+	writer.writeU32(nbEntries);
+
+	for(PxU32 i=0;i<nbEntries;i++)
+	{
+		const PxQueryTraceEntry& entry = mImpl->mEntries[i];
+		writer.writeU32(entry.type);
+
+		PxReal params[gNbGeomParams] = { 0.0f, 0.0f, 0.0f };
+		const PxGeometryType::Enum geomType = entry.geometry.getType();
+		if(geomType==PxGeometryType::eSPHERE)
+			params[0] = entry.geometry.sphere().radius;
+		else if(geomType==PxGeometryType::eCAPSULE)
+		{
+			params[0] = entry.geometry.capsule().radius;
+			params[1] = entry.geometry.capsule().halfHeight;
+		}
+		else if(geomType==PxGeometryType::eBOX)
+		{
+			params[0] = entry.geometry.box().halfExtents.x;
+			params[1] = entry.geometry.box().halfExtents.y;
+			params[2] = entry.geometry.box().halfExtents.z;
+		}
+		writer.writeU32(geomType);
+		for(PxU32 j=0;j<gNbGeomParams;j++)
+			writer.writeF32(params[j]);
+
+		writer.writeF32(entry.pose.q.x);
+		writer.writeF32(entry.pose.q.y);
+		writer.writeF32(entry.pose.q.z);
+		writer.writeF32(entry.pose.q.w);
+		writer.writeVec3(entry.pose.p);
+		writer.writeVec3(entry.unitDir);
+		writer.writeF32(entry.distance);
+		writer.writeF32(entry.inflation);
+		writer.writeU32(entry.filterData.data.word0);
+		writer.writeU32(entry.filterData.data.word1);
+		writer.writeU32(entry.filterData.data.word2);
+		writer.writeU32(entry.filterData.data.word3);
+		writer.writeU32(PxU32(entry.filterData.flags));
+		writer.writeU32(PxU32(entry.hitFlags));
+		writer.writeU32(entry.maxNbTouches);
+	}
+	return writer.isOk();
+}
+
+bool PxQueryTrace::load(PxInputStream& stream)
+{
+	clear();
+
+	StreamReader reader(stream);
+	if(reader.readU32()!=gTraceMagic || reader.readU32()!=gTraceVersion)
+		return false;
+
+	const PxU32 nbEntries = reader.readU32();
+	if(!reader.isOk())
+		return false;
+
+	PxMutex::ScopedLock lock(mImpl->mMutex);
+	for(PxU32 i=0;i<nbEntries;i++)
+	{
+		PxQueryTraceEntry entry;
+		const PxU32 type = reader.readU32();
+		const PxU32 geomType = reader.readU32();
+		PxReal params[gNbGeomParams];
+		for(PxU32 j=0;j<gNbGeomParams;j++)
+			params[j] = reader.readF32();
+
+		if(geomType==PxGeometryType::eSPHERE)
+			entry.geometry.storeAny(PxSphereGeometry(params[0]));
+		else if(geomType==PxGeometryType::eCAPSULE)
+			entry.geometry.storeAny(PxCapsuleGeometry(params[0], params[1]));
+		else if(geomType==PxGeometryType::eBOX)
+			entry.geometry.storeAny(PxBoxGeometry(params[0], params[1], params[2]));
+		else
+			break;
+
+		entry.pose.q.x	= reader.readF32();
+		entry.pose.q.y	= reader.readF32();
+		entry.pose.q.z	= reader.readF32();
+		entry.pose.q.w	= reader.readF32();
+		entry.pose.p	= reader.readVec3();
+		entry.unitDir	= reader.readVec3();
+		entry.distance	= reader.readF32();
+		entry.inflation	= reader.readF32();
+		entry.filterData.data.word0	= reader.readU32();
+		entry.filterData.data.word1	= reader.readU32();
+		entry.filterData.data.word2	= reader.readU32();
+		entry.filterData.data.word3	= reader.readU32();
+		entry.filterData.flags		= PxQueryFlags(PxU16(reader.readU32()));
+		entry.hitFlags				= PxHitFlags(PxU16(reader.readU32()));
+		entry.maxNbTouches			= reader.readU32();
+
+		if(!reader.isOk() || type>PxQueryTraceType::eOVERLAP)
+			break;
+		entry.type = PxQueryTraceType::Enum(type);
+		mImpl->mEntries.pushBack(entry);
+	}
+
+	if(mImpl->mEntries.size()!=nbEntries)
+	{
+		mImpl->mEntries.clear();
+		return false;
+	}
+	return true;
+}
+
+PxU32 PxQueryTrace::replay(const PxScene& scene, const PxQueryTraceEntry& entry)
+{
+	// PT: the recorded touch buffer size is capped, a zero size keeps the query blocking-only as in the original call
+	const PxU32 maxNbTouches = PxMin(entry.maxNbTouches, gMaxNbReplayTouches);
+
+	switch(entry.type)
+	{
+		case PxQueryTraceType::eRAYCAST:
+		{
+			PxRaycastHit touches[gMaxNbReplayTouches];
+			PxRaycastBuffer buffer(touches, maxNbTouches);
+			scene.raycast(entry.pose.p, entry.unitDir, entry.distance, buffer, entry.hitFlags, entry.filterData);
+			return buffer.getNbAnyHits();
+		}
+		case PxQueryTraceType::eSWEEP:
+		{
+			PxSweepHit touches[gMaxNbReplayTouches];
+			PxSweepBuffer buffer(touches, maxNbTouches);
+			scene.sweep(entry.geometry.any(), entry.pose, entry.unitDir, entry.distance, buffer, entry.hitFlags, entry.filterData, NULL, NULL, entry.inflation);
+			return buffer.getNbAnyHits();
+		}
+		case PxQueryTraceType::eOVERLAP:
+		{
+			PxOverlapHit touches[gMaxNbReplayTouches];
+			PxOverlapBuffer buffer(touches, maxNbTouches);
+			scene.overlap(entry.geometry.any(), entry.pose, buffer, entry.filterData);
+			return buffer.getNbAnyHits();
+		}
+	}
+	return 0;
+}
@@ -49,22 +49,32 @@ class RaycastCCDManagerInternal
 				RaycastCCDManagerInternal(PxScene* scene) : mScene(scene)	{}
 				~RaycastCCDManagerInternal(){}
 
-		bool	registerRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape);
+		bool	registerRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape, PxReal sweepRadius);
 		bool	unregisterRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape);
 
 		void	doRaycastCCD(bool doDynamicDynamicCCD);
 
 		struct CCDObject
 		{
-			PX_FORCE_INLINE	CCDObject(PxRigidDynamic* actor, PxShape* shape, const PxVec3& witness) : mActor(actor), mShape(shape), mWitness(witness)	{}
+			PX_FORCE_INLINE	CCDObject(PxRigidDynamic* actor, PxShape* shape, const PxVec3& witness, PxReal sweepRadius) : mActor(actor), mShape(shape), mWitness(witness), mSweepRadius(sweepRadius)	{}
 			PxRigidDynamic*	mActor;
 			PxShape*		mShape;
 			PxVec3			mWitness;
+			PxReal			mSweepRadius;
+		};
+
+		// PT: per-frame data for objects that moved since their last witness
+		struct CCDCandidate
+		{
+			PxTransform		mNewPose;
+			PxVec3			mNewShapeCenter;
+			PxU32			mObjectIndex;
 		};
 
 	private:
 		PxScene*						mScene;
 		physx::PxArray<CCDObject>	mObjects;
+		physx::PxArray<CCDCandidate>	mCandidates;
 };
 }
 
@@ -92,6 +102,17 @@ static PX_FORCE_INLINE PxVec3 getShapeCenter(PxRigidActor* actor, PxShape* shape
 	return getShapeCenter(shape, pose);
 }
 
+// PT: the internal radius is only measured along the motion direction, so the sweep radius is also limited by the
+// smallest half-extent of the shape's local bounds, to keep the swept sphere inside thin shapes moving along their long axis.
+// Otherwise the sphere would graze the ground or walls these shapes slide along, and block them.
+static PxReal computeSmallestHalfExtent(PxShape* shape)
+{
+	PxBounds3 localBounds;
+	PxGeometryQuery::computeGeomBounds(localBounds, shape->getGeometry(), PxTransform(PxIdentity));
+	const PxVec3 extents = localBounds.getExtents();
+	return PxMin(extents.x, PxMin(extents.y, extents.z));
+}
+
 static PxReal computeInternalRadius(PxRigidActor* actor, PxShape* shape, const PxVec3& dir)
 {
 	const PxBounds3 bounds = PxShapeExt::getWorldBounds(*shape, *actor);
@@ -171,16 +192,33 @@ public:
 	}
 };
 
-static bool CCDRaycast(PxScene* scene, PxRigidActor* actor, PxShape* shape, const PxVec3& origin, const PxVec3& unitDir, const PxReal distance, PxRaycastHit& hit, bool dyna_dyna)
+static bool CCDRaycast(PxScene* scene, PxRigidActor* actor, PxShape* shape, const PxVec3& origin, const PxVec3& unitDir, const PxReal distance, PxReal sweepRadius, PxReal& hitDistance, PxRigidActor*& hitActor, bool dyna_dyna)
 {
 	const PxQueryFlags qf(dyna_dyna ? PxQueryFlags(PxQueryFlag::eSTATIC|PxQueryFlag::eDYNAMIC|PxQueryFlag::ePREFILTER) : PxQueryFlags(PxQueryFlag::eSTATIC));
 	const PxQueryFilterData filterData(PxFilterData(), qf);
 
 	CCDRaycastFilterCallback CB(actor, shape);
 
+	if(sweepRadius!=0.0f)
+	{
+		// PT: sphere-cast version, for thin objects that could otherwise go through cracks between static triangles
+		PxSweepBuffer buf1;
+		scene->sweep(PxSphereGeometry(sweepRadius), PxTransform(origin), unitDir, distance, buf1, PxHitFlags(0), filterData, &CB);
+
+		// PT: an initially overlapping sphere, e.g. for an object sliding along a floor or a wall, reports a hit at distance 0
+		// that would block the object in place every frame. We ignore these hits and fall back to the raycast.
+		if(!buf1.hasBlock || !buf1.block.hadInitialOverlap())
+		{
+			hitDistance = buf1.block.distance;
+			hitActor = buf1.block.actor;
+			return buf1.hasBlock;
+		}
+	}
+
 	PxRaycastBuffer buf1;
 	scene->raycast(origin, unitDir, distance, buf1, PxHitFlags(0), filterData, &CB);
-	hit = buf1.block;
+	hitDistance = buf1.block.distance;
+	hitActor = buf1.block.actor;
 	return buf1.hasBlock;
 }
 
@@ -200,10 +238,13 @@ static PxRigidDynamic* canDoCCD(PxRigidActor& actor, PxShape* /*shape*/)
 	return dyna;
 }
 
-static bool doRaycastCCD(PxScene* scene, const RaycastCCDManagerInternal::CCDObject& object, PxTransform& newPose, PxVec3& newShapeCenter, bool dyna_dyna)
+// PT: returns true if the witness should be updated. When the object's pose has to be corrected, newPose is modified and
+// needsPoseUpdate is set, but the pose itself is written back later by the caller.
+static bool doRaycastCCD(PxScene* scene, const RaycastCCDManagerInternal::CCDObject& object, PxTransform& newPose, PxVec3& newShapeCenter, bool& needsPoseUpdate, bool dyna_dyna)
 {
-	PxRigidDynamic* dyna = canDoCCD(*object.mActor, object.mShape);
-	if(!dyna)
+	needsPoseUpdate = false;
+
+	if(!canDoCCD(*object.mActor, object.mShape))
 		return true;
 
 	bool updateCCDWitness = true;
@@ -220,40 +261,41 @@ static bool doRaycastCCD(PxScene* scene, const RaycastCCDManagerInternal::CCDObj
 
 		const PxReal internalRadius = computeInternalRadius(object.mActor, object.mShape, dir);
 
-		PxRaycastHit hit;
-		if(internalRadius!=0.0f && CCDRaycast(scene, object.mActor, object.mShape, origin, dir, length, hit, dyna_dyna))
+		// PT: the swept sphere must fit inside the shape, otherwise we would stop objects before they actually touch anything
+		const PxReal sweepRadius = PxMin(object.mSweepRadius, internalRadius * 0.5f);
+
+		PxReal hitDistance;
+		PxRigidActor* hitActor;
+		if(internalRadius!=0.0f && CCDRaycast(scene, object.mActor, object.mShape, origin, dir, length, sweepRadius, hitDistance, hitActor, dyna_dyna))
 		{
 			updateCCDWitness = false;
 
-			const PxReal radiusLimit = internalRadius * 0.75f;
-			if(hit.distance>radiusLimit)
+			const PxReal radiusLimit = internalRadius * 0.75f - sweepRadius;
+			if(hitDistance>radiusLimit)
 			{
-				newShapeCenter = origin + dir * (hit.distance - radiusLimit);
+				newShapeCenter = origin + dir * (hitDistance - radiusLimit);
 			}
 			else
 			{
-				if(hit.actor->getConcreteType()==PxConcreteType::eRIGID_DYNAMIC)
+				if(hitActor->getConcreteType()==PxConcreteType::eRIGID_DYNAMIC)
 					return true;
 
 				newShapeCenter = origin;
 			}
 
 			newPose.p = offset + newShapeCenter;
-			const PxTransform shapeLocalPose = object.mShape->getLocalPose();
-			const PxTransform inverseShapeLocalPose = shapeLocalPose.getInverse();
-			const PxTransform newGlobalPose = newPose * inverseShapeLocalPose;
-			dyna->setGlobalPose(newGlobalPose);
+			needsPoseUpdate = true;
 		}
 	}
 	return updateCCDWitness;
 }
 
-bool RaycastCCDManagerInternal::registerRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape)
+bool RaycastCCDManagerInternal::registerRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape, PxReal sweepRadius)
 {
-	if(!actor || !shape)
+	if(!actor || !shape || !(sweepRadius>=0.0f))
 		return false;
 
-	mObjects.pushBack(CCDObject(actor, shape, getShapeCenter(actor, shape)));
+	mObjects.pushBack(CCDObject(actor, shape, getShapeCenter(actor, shape), PxMin(sweepRadius, computeSmallestHalfExtent(shape) * 0.5f)));
 	return true;
 }
 
@@ -277,7 +319,13 @@ bool RaycastCCDManagerInternal::unregisterRaycastCCDObject(PxRigidDynamic* actor
 
 void RaycastCCDManagerInternal::doRaycastCCD(bool doDynamicDynamicCCD)
 {
+	// PT: the objects are processed in three passes. We first gather the objects that actually moved, then run all the
+	// queries, and finally write back the corrected poses. Interleaving setGlobalPose() calls with scene queries would
+	// otherwise force the scene-query system to sync its dynamic pruner before each query.
+	mCandidates.forceSize_Unsafe(0);
+
 	const PxU32 nbObjects = mObjects.size();
+	mCandidates.reserve(nbObjects);
 	for(PxU32 i=0;i<nbObjects;i++)
 	{
 		CCDObject& object = mObjects[i];
@@ -285,11 +333,43 @@ void RaycastCCDManagerInternal::doRaycastCCD(bool doDynamicDynamicCCD)
 		if(object.mActor->isSleeping())
 			continue;
 
-		PxTransform newPose = PxShapeExt::getGlobalPose(*object.mShape, *object.mActor);
-		PxVec3 newShapeCenter = getShapeCenter(object.mShape, newPose);
+		const PxTransform newPose = PxShapeExt::getGlobalPose(*object.mShape, *object.mActor);
+		const PxVec3 newShapeCenter = getShapeCenter(object.mShape, newPose);
 
-		if(::doRaycastCCD(mScene, object, newPose, newShapeCenter, doDynamicDynamicCCD))
-			object.mWitness = newShapeCenter;
+		// PT: objects that did not move do not need any query
+		if(newShapeCenter==object.mWitness)
+			continue;
+
+		CCDCandidate& candidate = mCandidates.insert();
+		candidate.mNewPose = newPose;
+		candidate.mNewShapeCenter = newShapeCenter;
+		candidate.mObjectIndex = i;
+	}
+
+	const PxU32 nbCandidates = mCandidates.size();
+	for(PxU32 i=0;i<nbCandidates;i++)
+	{
+		CCDCandidate& candidate = mCandidates[i];
+		CCDObject& object = mObjects[candidate.mObjectIndex];
+
+		bool needsPoseUpdate;
+		if(::doRaycastCCD(mScene, object, candidate.mNewPose, candidate.mNewShapeCenter, needsPoseUpdate, doDynamicDynamicCCD))
+			object.mWitness = candidate.mNewShapeCenter;
+
+		// PT: we reuse the object index to mark candidates whose pose must be written back
+		if(!needsPoseUpdate)
+			candidate.mObjectIndex = PX_INVALID_U32;
+	}
+
+	for(PxU32 i=0;i<nbCandidates;i++)
+	{
+		const CCDCandidate& candidate = mCandidates[i];
+		if(candidate.mObjectIndex==PX_INVALID_U32)
+			continue;
+
+		const CCDObject& object = mObjects[candidate.mObjectIndex];
+		const PxTransform inverseShapeLocalPose = object.mShape->getLocalPose().getInverse();
+		object.mActor->setGlobalPose(candidate.mNewPose * inverseShapeLocalPose);
 	}
 }
 
@@ -305,7 +385,12 @@ RaycastCCDManager::~RaycastCCDManager()
 
 bool RaycastCCDManager::registerRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape)
 {
-	return mImpl->registerRaycastCCDObject(actor, shape);
+	return mImpl->registerRaycastCCDObject(actor, shape, 0.0f);
+}
+
+bool RaycastCCDManager::registerRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape, PxReal sweepRadius)
+{
+	return mImpl->registerRaycastCCDObject(actor, shape, sweepRadius);
 }
 
 bool RaycastCCDManager::unregisterRaycastCCDObject(PxRigidDynamic* actor, PxShape* shape)
@@ -87,3 +87,21 @@ PxBVH* PxRigidActorExt::createBVHFromActor(PxPhysics& physics, const PxRigidActo
 	return bvh;
 }
 
+bool PxRigidActorExt::cookBVHFromActor(const PxRigidActor& actor, PxOutputStream& stream)
+{
+	PxU32 nbBounds = 0;
+	PxBounds3* bounds = PxRigidActorExt::getRigidActorShapeLocalBoundsList(actor, nbBounds);
+	if(!bounds)
+		return false;
+
+	PxBVHDesc bvhDesc;
+	bvhDesc.bounds.count	= nbBounds;
+	bvhDesc.bounds.data		= bounds;
+	bvhDesc.bounds.stride	= sizeof(PxBounds3);
+
+	const bool status = PxCookBVH(bvhDesc, stream);
+
+	PX_FREE(bounds);
+	return status;
+}
+
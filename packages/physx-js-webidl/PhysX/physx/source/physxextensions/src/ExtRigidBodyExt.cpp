@@ -47,6 +47,8 @@
 #include "ExtInertiaTensor.h"
 #include "foundation/PxAllocator.h"
 #include "foundation/PxSIMDHelpers.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxMemory.h"
 
 #include "CmUtils.h"
 
@@ -312,6 +314,154 @@ bool PxRigidBodyExt::updateMassAndInertia(PxRigidBody& body, PxReal density, con
 	return ::updateMassAndInertia(false, body, &density, 1, massLocalPose, includeNonSimShapes);
 }
 
+namespace
+{
+	// PT: what the mass properties of a shape depend on. Zeroed before being filled, so that keys can be hashed
+	// and compared as raw memory.
+	struct MassShapeKey
+	{
+		PxTransform	localPose;
+		PxMeshScale	scale;
+		PxVec3		params;
+		const void*	mesh;
+		PxU32		type;
+	};
+
+	// PT: mass properties computed for the first body of a given shape configuration
+	struct MassCacheEntry
+	{
+		PxU32		firstKey;
+		PxU32		nbKeys;
+		PxReal		mass;
+		PxVec3		diagTensor;
+		PxTransform	cmassLocalPose;
+		bool		success;
+	};
+}
+
+// PT: returns false for bodies whose shapes cannot be keyed. These are computed individually.
+static bool getMassShapeKeys(const PxRigidBody& body, bool includeNonSimShapes, PxArray<MassShapeKey>& keys)
+{
+	const PxU32 nbShapes = body.getNbShapes();
+	for(PxU32 i=0; i<nbShapes; i++)
+	{
+		PxShape* shape;
+		body.getShapes(&shape, 1, i);
+		if((!(shape->getFlags() & PxShapeFlag::eSIMULATION_SHAPE)) && (!includeNonSimShapes))
+			continue;
+
+		MassShapeKey key;
+		PxMemZero(&key, sizeof(MassShapeKey));
+		key.localPose = shape->getLocalPose();
+		key.scale.rotation = PxQuat(PxIdentity);
+
+		const PxGeometry& geom = shape->getGeometry();
+		key.type = PxU32(geom.getType());
+		switch(geom.getType())
+		{
+			case PxGeometryType::eSPHERE:
+				key.params.x = static_cast<const PxSphereGeometry&>(geom).radius;
+				break;
+			case PxGeometryType::eBOX:
+				key.params = static_cast<const PxBoxGeometry&>(geom).halfExtents;
+				break;
+			case PxGeometryType::eCAPSULE:
+				key.params.x = static_cast<const PxCapsuleGeometry&>(geom).radius;
+				key.params.y = static_cast<const PxCapsuleGeometry&>(geom).halfHeight;
+				break;
+			case PxGeometryType::eCONVEXMESH:
+				key.mesh = static_cast<const PxConvexMeshGeometry&>(geom).convexMesh;
+				key.scale = static_cast<const PxConvexMeshGeometry&>(geom).scale;
+				break;
+			case PxGeometryType::eTRIANGLEMESH:
+				key.mesh = static_cast<const PxTriangleMeshGeometry&>(geom).triangleMesh;
+				key.scale = static_cast<const PxTriangleMeshGeometry&>(geom).scale;
+				break;
+			default:
+				return false;
+		}
+		keys.pushBack(key);
+	}
+	return true;
+}
+
+static PxU32 hashMassShapeKeys(const MassShapeKey* keys, PxU32 nbKeys)
+{
+	const PxU32* data = reinterpret_cast<const PxU32*>(keys);
+	const PxU32 nbWords = nbKeys * sizeof(MassShapeKey) / sizeof(PxU32);
+	PxU32 hash = nbKeys;
+	for(PxU32 i=0; i<nbWords; i++)
+		hash = PxComputeHash(hash ^ data[i]) + i;
+	return hash;
+}
+
+bool PxRigidBodyExt::updateMassAndInertia(PxRigidBody* const* bodies, PxU32 nbBodies, PxReal density, const PxVec3* massLocalPose, bool includeNonSimShapes)
+{
+	PX_CHECK_AND_RETURN_VAL(bodies || !nbBodies, "PxRigidBodyExt::updateMassAndInertia: bodies must not be NULL", false);
+
+	// PT: bodies with the same shapes get the same mass properties for a given density, so they are only computed
+	// once per shape configuration and copied to the other bodies. Mesh mass properties themselves are computed at
+	// cooking time and stored in the meshes, what we save here is the per-shape scaling & transform work, the
+	// accumulation and the diagonalization.
+	PxArray<MassShapeKey> keys;
+	PxArray<MassCacheEntry> entries;
+	PxHashMap<PxU32, PxU32> entryMap;
+
+	bool success = true;
+	for(PxU32 i=0; i<nbBodies; i++)
+	{
+		PxRigidBody& body = *bodies[i];
+
+		const PxU32 firstKey = keys.size();
+		if(!getMassShapeKeys(body, includeNonSimShapes, keys))
+		{
+			keys.forceSize_Unsafe(firstKey);
+			success &= ::updateMassAndInertia(false, body, &density, 1, massLocalPose, includeNonSimShapes);
+			continue;
+		}
+
+		const PxU32 nbKeys = keys.size() - firstKey;
+		const PxU32 hash = hashMassShapeKeys(keys.begin() + firstKey, nbKeys);
+
+		const PxHashMap<PxU32, PxU32>::Entry* found = entryMap.find(hash);
+		if(found)
+		{
+			const MassCacheEntry& entry = entries[found->second];
+			if(entry.nbKeys==nbKeys && !memcmp(keys.begin() + entry.firstKey, keys.begin() + firstKey, nbKeys * sizeof(MassShapeKey)))
+			{
+				keys.forceSize_Unsafe(firstKey);
+
+				body.setMass(entry.mass);
+				body.setMassSpaceInertiaTensor(entry.diagTensor);
+				body.setCMassLocalPose(entry.cmassLocalPose);
+				success &= entry.success;
+				continue;
+			}
+		}
+
+		const bool status = ::updateMassAndInertia(false, body, &density, 1, massLocalPose, includeNonSimShapes);
+		success &= status;
+
+		// PT: on hash collisions the first configuration stays cached, the others are computed individually
+		if(found)
+		{
+			keys.forceSize_Unsafe(firstKey);
+			continue;
+		}
+
+		MassCacheEntry entry;
+		entry.firstKey			= firstKey;
+		entry.nbKeys			= nbKeys;
+		entry.mass				= body.getMass();
+		entry.diagTensor		= body.getMassSpaceInertiaTensor();
+		entry.cmassLocalPose	= body.getCMassLocalPose();
+		entry.success			= status;
+		entryMap.insert(hash, entries.size());
+		entries.pushBack(entry);
+	}
+	return success;
+}
+
 static bool setMassAndUpdateInertia(bool multipleMassOrDensity, PxRigidBody& body, const PxReal* masses, PxU32 massCount, const PxVec3* massLocalPose, bool includeNonSimShapes)
 {
 	bool success;
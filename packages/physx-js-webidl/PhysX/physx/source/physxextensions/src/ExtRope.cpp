@@ -0,0 +1,402 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxRope.h"
+#include "extensions/PxRigidBodyExt.h"
+#include "extensions/PxShapeExt.h"
+#include "geometry/PxCapsuleGeometry.h"
+#include "geometry/PxSphereGeometry.h"
+#include "geometry/PxGeometryQuery.h"
+#include "foundation/PxArray.h"
+#include "PxScene.h"
+#include "PxRigidDynamic.h"
+#include "PxShape.h"
+
+using namespace physx;
+
+namespace
+{
+	struct Attachment
+	{
+		PxRigidActor*	mActor;
+		PxVec3			mLocalPos;
+		PxVec3			mImpulse;	// PT: accumulated position corrections the node would have received, converted to a force
+		PxU32			mNode;
+	};
+
+	static const PxU32 MaxNbOverlaps = 32;
+}
+
+namespace physx
+{
+class RopeInternal
+{
+	PX_NOCOPY(RopeInternal)
+	public:
+								RopeInternal(PxScene& scene, const PxRopeDesc& desc);
+
+			void				attach(PxU32 node, PxRigidActor* actor, const PxVec3& localPos);
+			void				detach(PxU32 node);
+			void				detachActor(const PxRigidActor& actor);
+			void				simulate(PxReal dt);
+			PxReal				getLength()	const;
+
+	PX_FORCE_INLINE	bool		isAttachedActor(const PxRigidActor* actor)	const
+								{
+									const PxU32 nb = mAttachments.size();
+									for(PxU32 i=0;i<nb;i++)
+										if(mAttachments[i].mActor==actor)
+											return true;
+									return false;
+								}
+
+			PxScene&			mScene;
+			PxRopeDesc			mDesc;
+			PxReal				mSegmentLength;
+			PxArray<PxVec3>		mPositions;
+			PxArray<PxVec3>		mPrevPositions;
+			PxArray<PxReal>		mInvMasses;		// PT: 0 for attached nodes, 1 otherwise. All free nodes have the same mass.
+			PxArray<Attachment>	mAttachments;
+	private:
+			void				integrate(PxReal dt);
+			void				updateAttachments();
+			void				solveSegments();
+			void				collide();
+			void				applyTension(PxReal dt);
+};
+}
+
+RopeInternal::RopeInternal(PxScene& scene, const PxRopeDesc& desc) : mScene(scene), mDesc(desc)
+{
+	const PxU32 nbNodes = desc.nbNodes;
+	const PxReal coeff = 1.0f / PxReal(nbNodes - 1);
+	mSegmentLength = (desc.end - desc.start).magnitude() * coeff;
+
+	mPositions.resize(nbNodes);
+	mInvMasses.resize(nbNodes, 1.0f);
+	for(PxU32 i=0;i<nbNodes;i++)
+		mPositions[i] = desc.start + (desc.end - desc.start) * (PxReal(i) * coeff);
+	mPrevPositions = mPositions;
+}
+
+void RopeInternal::attach(PxU32 node, PxRigidActor* actor, const PxVec3& localPos)
+{
+	detach(node);
+
+	Attachment a;
+	a.mActor	= actor;
+	a.mLocalPos	= localPos;
+	a.mImpulse	= PxVec3(0.0f);
+	a.mNode		= node;
+	mAttachments.pushBack(a);
+	mInvMasses[node] = 0.0f;
+
+	const PxVec3 pos = actor ? actor->getGlobalPose().transform(localPos) : localPos;
+	mPositions[node] = mPrevPositions[node] = pos;
+}
+
+void RopeInternal::detach(PxU32 node)
+{
+	const PxU32 nb = mAttachments.size();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		if(mAttachments[i].mNode==node)
+		{
+			mAttachments.replaceWithLast(i);
+			mInvMasses[node] = 1.0f;
+			return;
+		}
+	}
+}
+
+void RopeInternal::detachActor(const PxRigidActor& actor)
+{
+	PxU32 i = 0;
+	while(i<mAttachments.size())
+	{
+		if(mAttachments[i].mActor==&actor)
+		{
+			mInvMasses[mAttachments[i].mNode] = 1.0f;
+			mAttachments.replaceWithLast(i);
+		}
+		else
+			i++;
+	}
+}
+
+// PT: Verlet integration, velocities are implicit in the previous positions
+void RopeInternal::integrate(PxReal dt)
+{
+	const PxU32 nbNodes = mPositions.size();
+	const PxVec3 gravityStep = mDesc.gravity * (dt * dt);
+	const PxReal keep = 1.0f - mDesc.damping;
+
+	PxVec3* PX_RESTRICT positions = mPositions.begin();
+	PxVec3* PX_RESTRICT prevPositions = mPrevPositions.begin();
+	const PxReal* PX_RESTRICT invMasses = mInvMasses.begin();
+	for(PxU32 i=0;i<nbNodes;i++)
+	{
+		const PxVec3 current = positions[i];
+		if(invMasses[i]!=0.0f)
+			positions[i] = current + (current - prevPositions[i]) * keep + gravityStep;
+		prevPositions[i] = current;
+	}
+}
+
+void RopeInternal::updateAttachments()
+{
+	const PxU32 nb = mAttachments.size();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		Attachment& a = mAttachments[i];
+		a.mImpulse = PxVec3(0.0f);
+		mPositions[a.mNode] = a.mActor ? a.mActor->getGlobalPose().transform(a.mLocalPos) : a.mLocalPos;
+	}
+}
+
+// PT: the whole chain is one constraint block. Segments are unilateral (a rope can be slack but not stretched) and are
+// solved with alternating forward/backward sweeps, which propagates corrections along long chains in fewer iterations
+// than a fixed ordering.
+void RopeInternal::solveSegments()
+{
+	const PxU32 nbSegments = mPositions.size() - 1;
+	const PxReal restLength = mSegmentLength;
+
+	PxVec3* PX_RESTRICT positions = mPositions.begin();
+	const PxReal* PX_RESTRICT invMasses = mInvMasses.begin();
+
+	for(PxU32 iter=0;iter<mDesc.nbIterations;iter++)
+	{
+		const bool forward = (iter & 1)==0;
+		for(PxU32 j=0;j<nbSegments;j++)
+		{
+			const PxU32 s = forward ? j : nbSegments - 1 - j;
+			const PxReal w0 = invMasses[s];
+			const PxReal w1 = invMasses[s+1];
+			const PxReal wSum = w0 + w1;
+			if(wSum==0.0f)
+				continue;
+
+			const PxVec3 delta = positions[s+1] - positions[s];
+			const PxReal length = delta.magnitude();
+			if(length<=restLength)
+				continue;
+
+			const PxVec3 correction = delta * ((length - restLength) / (length * wSum));
+			positions[s] += correction * w0;
+			positions[s+1] -= correction * w1;
+
+			// PT: an attached node doesn't move, the correction it would have received is the tension pulling its actor
+			if(w0==0.0f || w1==0.0f)
+			{
+				const PxU32 attachedNode = w0==0.0f ? s : s+1;
+				const PxVec3 impulse = w0==0.0f ? correction : -correction;
+				const PxU32 nb = mAttachments.size();
+				for(PxU32 i=0;i<nb;i++)
+				{
+					if(mAttachments[i].mNode==attachedNode)
+					{
+						mAttachments[i].mImpulse += impulse;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+// PT: each segment is a capsule (a sphere-swept segment). Penetrating segments are pushed out as a whole, which keeps
+// the chain from tunneling through thin geometry between two nodes.
+void RopeInternal::collide()
+{
+	if(!(mDesc.filterData.flags & (PxQueryFlag::eSTATIC|PxQueryFlag::eDYNAMIC)))
+		return;
+
+	PxQueryFilterData filterData = mDesc.filterData;
+	filterData.flags |= PxQueryFlag::eNO_BLOCK;
+
+	const PxU32 nbSegments = mPositions.size() - 1;
+	const PxReal radius = mDesc.radius;
+	PxVec3* PX_RESTRICT positions = mPositions.begin();
+	const PxReal* PX_RESTRICT invMasses = mInvMasses.begin();
+
+	for(PxU32 s=0;s<nbSegments;s++)
+	{
+		const PxReal w0 = invMasses[s];
+		const PxReal w1 = invMasses[s+1];
+		if(w0==0.0f && w1==0.0f)
+			continue;
+
+		const PxVec3 p0 = positions[s];
+		const PxVec3 p1 = positions[s+1];
+		const PxVec3 delta = p1 - p0;
+		const PxReal length = delta.magnitude();
+
+		const PxTransform segmentPose(	(p0 + p1) * 0.5f,
+										length>1e-6f ? PxShortestRotation(PxVec3(1.0f, 0.0f, 0.0f), delta / length) : PxQuat(PxIdentity));
+		const PxCapsuleGeometry capsule(radius, length * 0.5f);
+		const PxSphereGeometry sphere(radius);
+		const PxGeometry& segmentGeom = length>1e-6f ? static_cast<const PxGeometry&>(capsule) : static_cast<const PxGeometry&>(sphere);
+
+		PxOverlapBufferN<MaxNbOverlaps> buffer;
+		if(!mScene.overlap(segmentGeom, segmentPose, buffer, filterData))
+			continue;
+
+		PxVec3 push(0.0f);
+		const PxU32 nbHits = buffer.getNbTouches();
+		for(PxU32 i=0;i<nbHits;i++)
+		{
+			const PxOverlapHit& hit = buffer.getTouch(i);
+			if(isAttachedActor(hit.actor))
+				continue;
+
+			PxVec3 dir;
+			PxReal depth;
+			const PxTransform shapePose = PxShapeExt::getGlobalPose(*hit.shape, *hit.actor);
+			if(PxGeometryQuery::computePenetration(dir, depth, segmentGeom, PxTransform(segmentPose.p + push, segmentPose.q), hit.shape->getGeometry(), shapePose))
+				push += dir * depth;
+		}
+
+		if(w0!=0.0f)
+			positions[s] += push;
+		if(w1!=0.0f)
+			positions[s+1] += push;
+	}
+}
+
+void RopeInternal::applyTension(PxReal dt)
+{
+	const PxReal coeff = mDesc.nodeMass / (dt * dt);
+	const PxReal maxTension = mDesc.maxTension;
+
+	const PxU32 nb = mAttachments.size();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const Attachment& a = mAttachments[i];
+		if(!a.mActor)
+			continue;
+
+		PxRigidBody* body = a.mActor->is<PxRigidBody>();
+		if(!body || (body->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC))
+			continue;
+
+		// PT: the force pulls the actor towards the rope, i.e. along the correction the attached node did not receive
+		PxVec3 force = a.mImpulse * coeff;
+		const PxReal magnitude = force.magnitude();
+		if(magnitude==0.0f)
+			continue;
+		if(magnitude>maxTension)
+			force *= maxTension / magnitude;
+
+		PxRigidBodyExt::addForceAtPos(*body, force, mPositions[a.mNode], PxForceMode::eFORCE);
+	}
+}
+
+void RopeInternal::simulate(PxReal dt)
+{
+	integrate(dt);
+	updateAttachments();
+	solveSegments();
+	collide();
+	applyTension(dt);
+}
+
+PxReal RopeInternal::getLength() const
+{
+	PxReal length = 0.0f;
+	const PxU32 nbSegments = mPositions.size() - 1;
+	for(PxU32 i=0;i<nbSegments;i++)
+		length += (mPositions[i+1] - mPositions[i]).magnitude();
+	return length;
+}
+
+PxRope::PxRope(PxScene& scene, const PxRopeDesc& desc)
+{
+	PX_ASSERT(desc.isValid());
+	mImpl = new RopeInternal(scene, desc);
+}
+
+PxRope::~PxRope()
+{
+	delete mImpl;
+}
+
+void PxRope::attach(PxU32 node, PxRigidActor* actor, const PxVec3& localPos)
+{
+	PX_CHECK_AND_RETURN(node<mImpl->mPositions.size(), "PxRope::attach: invalid node index");
+	PX_CHECK_AND_RETURN(localPos.isFinite(), "PxRope::attach: invalid position");
+	mImpl->attach(node, actor, localPos);
+}
+
+void PxRope::detach(PxU32 node)
+{
+	PX_CHECK_AND_RETURN(node<mImpl->mPositions.size(), "PxRope::detach: invalid node index");
+	mImpl->detach(node);
+}
+
+void PxRope::detachActor(const PxRigidActor& actor)
+{
+	mImpl->detachActor(actor);
+}
+
+void PxRope::simulate(PxReal dt)
+{
+	PX_CHECK_AND_RETURN(dt>0.0f && PxIsFinite(dt), "PxRope::simulate: invalid time step");
+	mImpl->simulate(dt);
+}
+
+void PxRope::setNodePosition(PxU32 node, const PxVec3& pos)
+{
+	PX_CHECK_AND_RETURN(node<mImpl->mPositions.size(), "PxRope::setNodePosition: invalid node index");
+	PX_CHECK_AND_RETURN(pos.isFinite(), "PxRope::setNodePosition: invalid position");
+	mImpl->mPositions[node] = mImpl->mPrevPositions[node] = pos;
+}
+
+PxU32 PxRope::getNbNodes() const
+{
+	return mImpl->mPositions.size();
+}
+
+PxU32 PxRope::getNodePositions(PxVec3* buffer, PxU32 bufferSize, PxU32 startIndex) const
+{
+	const PxU32 nbNodes = mImpl->mPositions.size();
+	if(startIndex>=nbNodes)
+		return 0;
+
+	const PxU32 nb = PxMin(bufferSize, nbNodes - startIndex);
+	PxMemCopy(buffer, mImpl->mPositions.begin() + startIndex, sizeof(PxVec3)*nb);
+	return nb;
+}
+
+PxReal PxRope::getRestLength() const
+{
+	return mImpl->mSegmentLength * PxReal(mImpl->mPositions.size() - 1);
+}
+
+PxReal PxRope::getLength() const
+{
+	return mImpl->getLength();
+}
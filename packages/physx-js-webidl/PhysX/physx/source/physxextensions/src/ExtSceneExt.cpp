@@ -0,0 +1,209 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxSceneExt.h"
+#include "PxScene.h"
+#include "PxRigidActor.h"
+#include "PxSimulationEventCallback.h"
+#include "PxConstraint.h"
+#include "extensions/PxConstraintExt.h"
+#include "extensions/PxJoint.h"
+#include "extensions/PxRigidActorExt.h"
+#include "geometry/PxBVH.h"
+
+using namespace physx;
+
+PxU32 PxSceneExt::getNbActiveActors(PxScene& scene)
+{
+	PxU32 nbActors = 0;
+	PxActor** actors = scene.getActiveActors(nbActors);
+
+	// PT: only rigid actors are exported, see getActiveActorTransforms()
+	PxU32 nbRigidActors = 0;
+	for(PxU32 i=0; i<nbActors; i++)
+		nbRigidActors += actors[i]->is<PxRigidActor>() ? 1 : 0;
+	return nbRigidActors;
+}
+
+PxU32 PxSceneExt::getActiveActorTransforms(PxScene& scene, PxActiveActorTransform* buffer, PxU32 bufferSize, PxU32 startIndex)
+{
+	PX_CHECK_AND_RETURN_VAL(buffer || !bufferSize, "PxSceneExt::getActiveActorTransforms: buffer is NULL", 0);
+
+	PxU32 nbActors = 0;
+	PxActor** actors = scene.getActiveActors(nbActors);
+
+	// PT: non-rigid actors are filtered out before chunking, i.e. startIndex counts rigid actors only. That way the
+	// chunks line up with the returned counts and no entry is skipped or written twice.
+	PxU32 nbSkipped = 0;
+	PxU32 nbWritten = 0;
+	for(PxU32 i=0; i<nbActors && nbWritten<bufferSize; i++)
+	{
+		const PxActor* actor = actors[i];
+		const PxRigidActor* rigidActor = actor->is<PxRigidActor>();
+		if(!rigidActor)
+			continue;
+
+		if(nbSkipped<startIndex)
+		{
+			nbSkipped++;
+			continue;
+		}
+
+		const PxTransform pose = rigidActor->getGlobalPose();
+
+		PxActiveActorTransform& dst = buffer[nbWritten++];
+		dst.userIndex = PxU32(size_t(actor->userData));
+		dst.p = pose.p;
+		dst.q = pose.q;
+	}
+	return nbWritten;
+}
+
+PxU32 PxSceneExt::getNbContactReports(const PxContactPairHeader* pairHeaders, PxU32 nbPairHeaders)
+{
+	PxU32 nbPairs = 0;
+	for(PxU32 i=0; i<nbPairHeaders; i++)
+		nbPairs += pairHeaders[i].nbPairs;
+	return nbPairs;
+}
+
+static PX_FORCE_INLINE PxU32 getUserIndex(const PxContactPairHeader& header, PxU32 index)
+{
+	const PxContactPairHeaderFlag::Enum removedFlag = index ? PxContactPairHeaderFlag::eREMOVED_ACTOR_1 : PxContactPairHeaderFlag::eREMOVED_ACTOR_0;
+	// PT: removed actors can be deleted already, so we don't touch them
+	return (header.flags & removedFlag) ? PX_INVALID_U32 : PxU32(size_t(header.actors[index]->userData));
+}
+
+static void writeContactReport(PxContactReportRecord& dst, const PxContactPairHeader& header, const PxContactPair& pair)
+{
+	dst.userIndex0 = getUserIndex(header, 0);
+	dst.userIndex1 = getUserIndex(header, 1);
+	dst.events = PxU32(pair.events);
+	dst.nbContacts = pair.contactCount;
+	dst.impulse = PxVec3(0.0f);
+	dst.point = PxVec3(0.0f);
+
+	if(!pair.contactCount)
+		return;
+
+	// PT: same as PxContactPair::extractContacts() but without the per-point buffer
+	PxContactStreamIterator iter(pair.contactPatches, pair.contactPoints, pair.getInternalFaceIndices(), pair.patchCount, pair.contactCount);
+
+	const PxReal* impulses = (pair.flags & PxContactPairFlag::eINTERNAL_HAS_IMPULSES) ? pair.contactImpulses : NULL;
+
+	PxU32 nbContacts = 0;
+	while(iter.hasNextPatch())
+	{
+		iter.nextPatch();
+		while(iter.hasNextContact())
+		{
+			iter.nextContact();
+			if(!nbContacts)
+				dst.point = iter.getContactPoint();
+			if(impulses)
+				dst.impulse += iter.getContactNormal() * impulses[nbContacts];
+			nbContacts++;
+		}
+	}
+}
+
+PxU32 PxSceneExt::getContactReports(const PxContactPairHeader* pairHeaders, PxU32 nbPairHeaders, PxContactReportRecord* buffer, PxU32 bufferSize, PxU32 startIndex)
+{
+	PX_CHECK_AND_RETURN_VAL(pairHeaders || !nbPairHeaders, "PxSceneExt::getContactReports: pairHeaders is NULL", 0);
+	PX_CHECK_AND_RETURN_VAL(buffer || !bufferSize, "PxSceneExt::getContactReports: buffer is NULL", 0);
+
+	PxU32 nbWritten = 0;
+	PxU32 pairIndex = 0;
+	for(PxU32 i=0; i<nbPairHeaders && nbWritten<bufferSize; i++)
+	{
+		const PxContactPairHeader& header = pairHeaders[i];
+		const PxU32 nbPairs = header.nbPairs;
+
+		// PT: skip whole headers until we reach the first requested pair
+		if(pairIndex + nbPairs <= startIndex)
+		{
+			pairIndex += nbPairs;
+			continue;
+		}
+
+		for(PxU32 j=0; j<nbPairs && nbWritten<bufferSize; j++, pairIndex++)
+		{
+			if(pairIndex < startIndex)
+				continue;
+
+			writeContactReport(buffer[nbWritten++], header, header.pairs[j]);
+		}
+	}
+	return nbWritten;
+}
+
+static PX_FORCE_INLINE PxU32 getActorUserIndex(const PxRigidActor* actor)
+{
+	return actor ? PxU32(size_t(actor->userData)) : PX_INVALID_U32;
+}
+
+PxU32 PxSceneExt::getConstraintBreakReports(const PxConstraintInfo* constraints, PxU32 nbConstraints, PxConstraintBreakRecord* buffer, PxU32 bufferSize, PxU32 startIndex)
+{
+	PX_CHECK_AND_RETURN_VAL(constraints || !nbConstraints, "PxSceneExt::getConstraintBreakReports: constraints is NULL", 0);
+	PX_CHECK_AND_RETURN_VAL(buffer || !bufferSize, "PxSceneExt::getConstraintBreakReports: buffer is NULL", 0);
+
+	PxU32 nbWritten = 0;
+	for(PxU32 i=startIndex; i<nbConstraints && nbWritten<bufferSize; i++)
+	{
+		const PxConstraintInfo& info = constraints[i];
+		PxConstraintBreakRecord& dst = buffer[nbWritten++];
+
+		// PT: joints are the only external objects whose userData we know how to reach
+		dst.userIndex = (info.type == PxConstraintExtIDs::eJOINT && info.externalReference) ? PxU32(size_t(static_cast<const PxJoint*>(info.externalReference)->userData)) : PX_INVALID_U32;
+		dst.type = info.type;
+
+		PxRigidActor* actor0;
+		PxRigidActor* actor1;
+		info.constraint->getActors(actor0, actor1);
+		dst.userIndex0 = getActorUserIndex(actor0);
+		dst.userIndex1 = getActorUserIndex(actor1);
+
+		info.constraint->getForce(dst.force, dst.torque);
+	}
+	return nbWritten;
+}
+
+bool PxSceneExt::addRegion(PxScene& scene, PxRigidActor& actor, const PxBVH* bvh)
+{
+	if(bvh)
+		return scene.addActor(actor, bvh);
+
+	PxBVH* localBVH = PxRigidActorExt::createBVHFromActor(scene.getPhysics(), actor);
+	if(!localBVH)
+	{
+		// PT: actors without scene query shapes don't need a BVH
+		return scene.addActor(actor);
+	}
+
+	const bool status = scene.addActor(actor, localBVH);
+	localBVH->release();
+	return status;
+}
@@ -28,9 +28,17 @@
 
 #include "extensions/PxSceneQueryExt.h"
 #include "geometry/PxGeometryHelpers.h"
+#include "PxShape.h"
 #include "foundation/PxAllocatorCallback.h"
 #include "CmUtils.h"
+#include "CmRadixSort.h"
 #include "foundation/PxAllocator.h"
+#include "foundation/PxBounds3.h"
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxVecMath.h"
+#include "geometry/PxGeometryQuery.h"
+#include "extensions/PxShapeExt.h"
+#include "extensions/PxObjectIdTable.h"
 
 using namespace physx;
 
@@ -88,6 +96,194 @@ PxI32 PxSceneQueryExt::raycastMultiple(	const PxScene& scene,
 		return PxI32(buf.nbTouches);
 }
 
+// PT: interleaves the lower 10 bits of x, y, z
+static PX_FORCE_INLINE PxU32 expandBits10(PxU32 v)
+{
+	v = (v * 0x00010001u) & 0xFF0000FFu;
+	v = (v * 0x00000101u) & 0x0F00F00Fu;
+	v = (v * 0x00000011u) & 0xC30C30C3u;
+	v = (v * 0x00000005u) & 0x49249249u;
+	return v;
+}
+
+static PX_FORCE_INLINE PxU32 computeMortonCode(const PxVec3& p, const PxVec3& minimum, const PxVec3& scale)
+{
+	const PxVec3 n = (p - minimum).multiply(scale);
+	const PxU32 x = PxU32(PxClamp(n.x, 0.0f, 1023.0f));
+	const PxU32 y = PxU32(PxClamp(n.y, 0.0f, 1023.0f));
+	const PxU32 z = PxU32(PxClamp(n.z, 0.0f, 1023.0f));
+	return (expandBits10(x)<<2) | (expandBits10(y)<<1) | expandBits10(z);
+}
+
+// PT: below this number of rays sorting is not worth it
+#define RAYCAST_BATCH_SORT_THRESHOLD	32
+
+PxU32 PxSceneQueryExt::raycastBatch(const PxScene& scene, PxU32 nbRays,
+									const PxReal* origins, const PxReal* unitDirs, const PxReal* distances,
+									PxReal* hitPositions, PxReal* hitNormals, PxReal* hitDistances, PxU32* hitShapeIndices,
+									const PxSceneQueryFilterData& filterData, PxSceneQueryFilterCallback* filterCall)
+{
+	PX_CHECK_AND_RETURN_VAL(origins && unitDirs && distances, "PxSceneQueryExt::raycastBatch: input buffers cannot be NULL", 0);
+	if(!nbRays)
+		return 0;
+
+	const PxVec3* rayOrigins = reinterpret_cast<const PxVec3*>(origins);
+	const PxVec3* rayDirs = reinterpret_cast<const PxVec3*>(unitDirs);
+
+	// Sort rays along a Morton curve over their origins, so that consecutive rays traverse the same tree nodes.
+	Cm::RadixSortBuffered rs;
+	const PxU32* ranks = NULL;
+	PxU32* keys = NULL;
+	if(nbRays >= RAYCAST_BATCH_SORT_THRESHOLD)
+	{
+		PxBounds3 bounds = PxBounds3::empty();
+		for(PxU32 i=0; i<nbRays; i++)
+			bounds.include(rayOrigins[i]);
+
+		const PxVec3 extents = bounds.maximum - bounds.minimum;
+		const PxVec3 scale(	extents.x > 0.0f ? 1023.0f / extents.x : 0.0f,
+							extents.y > 0.0f ? 1023.0f / extents.y : 0.0f,
+							extents.z > 0.0f ? 1023.0f / extents.z : 0.0f);
+
+		keys = PX_ALLOCATE(PxU32, nbRays, "raycastBatch keys");
+		if(keys)
+		{
+			for(PxU32 i=0; i<nbRays; i++)
+				keys[i] = computeMortonCode(rayOrigins[i], bounds.minimum, scale);
+
+			ranks = rs.Sort(keys, nbRays, Cm::RADIX_UNSIGNED).GetRanks();
+		}
+	}
+
+	const PxHitFlags outputFlags = PxHitFlag::ePOSITION | PxHitFlag::eNORMAL;
+
+	PxU32 nbHits = 0;
+	for(PxU32 j=0; j<nbRays; j++)
+	{
+		const PxU32 i = ranks ? ranks[j] : j;
+
+		PxRaycastBuffer buf;
+		scene.raycast(rayOrigins[i], rayDirs[i], distances[i], buf, outputFlags, filterData, filterCall);
+
+		if(buf.hasBlock)
+		{
+			nbHits++;
+			const PxRaycastHit& hit = buf.block;
+			if(hitPositions)
+				reinterpret_cast<PxVec3*>(hitPositions)[i] = hit.position;
+			if(hitNormals)
+				reinterpret_cast<PxVec3*>(hitNormals)[i] = hit.normal;
+			if(hitDistances)
+				hitDistances[i] = hit.distance;
+			if(hitShapeIndices)
+				hitShapeIndices[i] = PxU32(size_t(hit.shape->userData));
+		}
+		else
+		{
+			if(hitDistances)
+				hitDistances[i] = -1.0f;
+			if(hitShapeIndices)
+				hitShapeIndices[i] = 0xffffffff;
+		}
+	}
+
+	PX_FREE(keys);
+	return nbHits;
+}
+
+namespace
+{
+	// PT: keeps shapes whose query filter word0 shares a bit with the layer mask. Hits are all blocking so that the
+	// query only tracks the closest one.
+	class LayerMaskFilterCallback : public PxQueryFilterCallback
+	{
+		public:
+		LayerMaskFilterCallback(PxU32 layerMask) : mLayerMask(layerMask)	{}
+
+		virtual PxQueryHitType::Enum preFilter(const PxFilterData&, const PxShape* shape, const PxRigidActor*, PxHitFlags&)
+		{
+			return (shape->getQueryFilterData().word0 & mLayerMask) ? PxQueryHitType::eBLOCK : PxQueryHitType::eNONE;
+		}
+
+		virtual PxQueryHitType::Enum postFilter(const PxFilterData&, const PxQueryHit&, const PxShape*, const PxRigidActor*)
+		{
+			return PxQueryHitType::eBLOCK;
+		}
+
+		const PxU32	mLayerMask;
+	};
+}
+
+bool PxSceneQueryExt::raycastClosest(	const PxScene& scene,
+										const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
+										PxU32 layerMask, PxReal* result, const PxObjectIdTable* idTable)
+{
+	PX_CHECK_AND_RETURN_VAL(result, "PxSceneQueryExt::raycastClosest: result cannot be NULL", false);
+
+	LayerMaskFilterCallback filterCall(layerMask);
+	const bool useFilter = layerMask != 0xffffffff;
+
+	PxQueryFilterData fd(PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC);
+	if(useFilter)
+		fd.flags |= PxQueryFlag::ePREFILTER;
+
+	PxRaycastBuffer buf;
+	scene.raycast(origin, unitDir, distance, buf, PxHitFlag::ePOSITION | PxHitFlag::eNORMAL, fd, useFilter ? &filterCall : NULL);
+
+	if(!buf.hasBlock)
+	{
+		result[PxRaycastClosestSlot::eACTOR_ID] = -1.0f;
+		result[PxRaycastClosestSlot::eDISTANCE] = -1.0f;
+		return false;
+	}
+
+	const PxRaycastHit& hit = buf.block;
+	const PxU32 id = idTable ? idTable->getId(hit.actor) : PxU32(size_t(hit.actor->userData));
+	result[PxRaycastClosestSlot::eACTOR_ID] = id == PX_INVALID_U32 ? -1.0f : PxReal(id);
+	result[PxRaycastClosestSlot::ePOSITION + 0] = hit.position.x;
+	result[PxRaycastClosestSlot::ePOSITION + 1] = hit.position.y;
+	result[PxRaycastClosestSlot::ePOSITION + 2] = hit.position.z;
+	result[PxRaycastClosestSlot::eNORMAL + 0] = hit.normal.x;
+	result[PxRaycastClosestSlot::eNORMAL + 1] = hit.normal.y;
+	result[PxRaycastClosestSlot::eNORMAL + 2] = hit.normal.z;
+	result[PxRaycastClosestSlot::eDISTANCE] = hit.distance;
+	return true;
+}
+
+bool PxSceneQueryExt::raycastOccluded(const PxScene& scene, const PxVolumetricOccluder* occluder,
+										const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
+										PxReal opacityThreshold, PxVolumetricRaycastHit& hit,
+										PxSceneQueryFlags outputFlags,
+										const PxSceneQueryFilterData& filterData,
+										PxSceneQueryFilterCallback* filterCall)
+{
+	PxRaycastBuffer buf;
+	PxQueryFilterData fd1 = filterData;
+	scene.raycast(origin, unitDir, distance, buf, outputFlags, fd1, filterCall);
+
+	hit.block = buf.block;
+	hit.hasBlock = buf.hasBlock;
+	hit.occluded = false;
+	hit.opacity = 0.0f;
+	hit.distance = buf.hasBlock ? buf.block.distance : distance;
+	if(!occluder || hit.distance <= 0.0f)
+		return hit.hasBlock;
+
+	// PT: opacity = 1 - exp(-depth), so the threshold maps to a maximum optical depth
+	const PxReal maxOpticalDepth = opacityThreshold < 1.0f ? -PxLog(1.0f - opacityThreshold) : PX_MAX_F32;
+
+	PxReal stopDistance = hit.distance;
+	const PxReal opticalDepth = occluder->integrate(origin, unitDir, hit.distance, maxOpticalDepth, stopDistance);
+	hit.opacity = 1.0f - PxExp(-opticalDepth);
+	if(opticalDepth >= maxOpticalDepth)
+	{
+		hit.occluded = true;
+		hit.hasBlock = false;
+		hit.distance = stopDistance;
+	}
+	return hit.hasBlock || hit.occluded;
+}
+
 bool PxSceneQueryExt::sweepAny(	const PxScene& scene,
 								const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, const PxReal distance,
 								PxSceneQueryFlags queryFlags,
@@ -221,6 +417,220 @@ namespace
 	};
 }
 
+// PT: max number of query volumes sharing one scene traversal. Must be a multiple of 4 for the SIMD culling.
+#define OVERLAP_BATCH_GROUP_SIZE	16
+// PT: a query joins the current group as long as the group bounds stay within this factor of the summed query bounds
+#define OVERLAP_BATCH_AREA_RATIO	4.0f
+
+static PX_FORCE_INLINE PxReal halfSurfaceArea(const PxBounds3& bounds)
+{
+	const PxVec3 e = bounds.maximum - bounds.minimum;
+	return e.x*e.y + e.y*e.z + e.z*e.x;
+}
+
+namespace
+{
+	// PT: SoA bounds of the query volumes of a group. Unused slots are empty boxes that never overlap anything.
+	struct OverlapBatchGroup
+	{
+		PX_ALIGN(16, PxReal	mMinX[OVERLAP_BATCH_GROUP_SIZE]);
+		PX_ALIGN(16, PxReal	mMinY[OVERLAP_BATCH_GROUP_SIZE]);
+		PX_ALIGN(16, PxReal	mMinZ[OVERLAP_BATCH_GROUP_SIZE]);
+		PX_ALIGN(16, PxReal	mMaxX[OVERLAP_BATCH_GROUP_SIZE]);
+		PX_ALIGN(16, PxReal	mMaxY[OVERLAP_BATCH_GROUP_SIZE]);
+		PX_ALIGN(16, PxReal	mMaxZ[OVERLAP_BATCH_GROUP_SIZE]);
+		PxU32				mQueries[OVERLAP_BATCH_GROUP_SIZE];
+		PxU32				mNbQueries;
+		PxBounds3			mBounds;
+		PxReal				mSumArea;
+
+		void	reset()
+		{
+			for(PxU32 i=0; i<OVERLAP_BATCH_GROUP_SIZE; i++)
+			{
+				mMinX[i] = mMinY[i] = mMinZ[i] = PX_MAX_F32;
+				mMaxX[i] = mMaxY[i] = mMaxZ[i] = -PX_MAX_F32;
+			}
+			mNbQueries = 0;
+			mBounds = PxBounds3::empty();
+			mSumArea = 0.0f;
+		}
+
+		bool	accepts(const PxBounds3& bounds)	const
+		{
+			if(!mNbQueries)
+				return true;
+			if(mNbQueries==OVERLAP_BATCH_GROUP_SIZE)
+				return false;
+			PxBounds3 merged = mBounds;
+			merged.include(bounds);
+			return halfSurfaceArea(merged) <= OVERLAP_BATCH_AREA_RATIO * (mSumArea + halfSurfaceArea(bounds));
+		}
+
+		void	add(PxU32 queryIndex, const PxBounds3& bounds)
+		{
+			const PxU32 i = mNbQueries++;
+			mMinX[i] = bounds.minimum.x;	mMinY[i] = bounds.minimum.y;	mMinZ[i] = bounds.minimum.z;
+			mMaxX[i] = bounds.maximum.x;	mMaxY[i] = bounds.maximum.y;	mMaxZ[i] = bounds.maximum.z;
+			mQueries[i] = queryIndex;
+			mBounds.include(bounds);
+			mSumArea += halfSurfaceArea(bounds);
+		}
+	};
+
+	// PT: the scene traversal runs with the group bounds and reports each candidate shape to the pre-filter, where it is
+	// culled against the group's query bounds and tested exactly. The pre-filter always returns eNONE so that the scene
+	// never runs its own exact test against the group box nor builds a hit.
+	class OverlapBatchFilter : public PxQueryFilterCallback
+	{
+		public:
+		OverlapBatchFilter(const OverlapBatchGroup& group, const PxGeometryHolder* geometries, const PxTransform* poses,
+							PxU32* pairs, PxU32 maxNbPairs, PxQueryFilterCallback* userFilter) :
+			mGroup(group), mGeometries(geometries), mPoses(poses), mPairs(pairs), mMaxNbPairs(maxNbPairs),
+			mUserFilter(userFilter), mNbPairs(0), mOverflow(false)	{}
+
+		virtual PxQueryHitType::Enum preFilter(const PxFilterData& filterData, const PxShape* shape, const PxRigidActor* actor, PxHitFlags& queryFlags)
+		{
+			if(mUserFilter && mUserFilter->preFilter(filterData, shape, actor, queryFlags)==PxQueryHitType::eNONE)
+				return PxQueryHitType::eNONE;
+
+			const PxGeometry& shapeGeom = shape->getGeometry();
+			const PxTransform shapePose = PxShapeExt::getGlobalPose(*shape, *actor);
+			PxBounds3 shapeBounds;
+			PxGeometryQuery::computeGeomBounds(shapeBounds, shapeGeom, shapePose);
+
+			using namespace aos;
+			const Vec4V sMinX = V4Load(shapeBounds.minimum.x);
+			const Vec4V sMinY = V4Load(shapeBounds.minimum.y);
+			const Vec4V sMinZ = V4Load(shapeBounds.minimum.z);
+			const Vec4V sMaxX = V4Load(shapeBounds.maximum.x);
+			const Vec4V sMaxY = V4Load(shapeBounds.maximum.y);
+			const Vec4V sMaxZ = V4Load(shapeBounds.maximum.z);
+
+			for(PxU32 i=0; i<mGroup.mNbQueries; i+=4)
+			{
+				const BoolV sepX = BOr(V4IsGrtr(V4LoadA(mGroup.mMinX + i), sMaxX), V4IsGrtr(sMinX, V4LoadA(mGroup.mMaxX + i)));
+				const BoolV sepY = BOr(V4IsGrtr(V4LoadA(mGroup.mMinY + i), sMaxY), V4IsGrtr(sMinY, V4LoadA(mGroup.mMaxY + i)));
+				const BoolV sepZ = BOr(V4IsGrtr(V4LoadA(mGroup.mMinZ + i), sMaxZ), V4IsGrtr(sMinZ, V4LoadA(mGroup.mMaxZ + i)));
+				PxU32 mask = ~BGetBitMask(BOr(BOr(sepX, sepY), sepZ)) & 0xf;
+				while(mask)
+				{
+					const PxU32 queryIndex = mGroup.mQueries[i + PxLowestSetBit(mask)];
+					mask &= mask - 1;
+
+					if(!PxGeometryQuery::overlap(mGeometries[queryIndex].any(), mPoses[queryIndex], shapeGeom, shapePose))
+						continue;
+
+					if(mNbPairs==mMaxNbPairs)
+					{
+						mOverflow = true;
+						continue;
+					}
+					mPairs[mNbPairs*2+0] = queryIndex;
+					mPairs[mNbPairs*2+1] = PxU32(size_t(shape->userData));
+					mNbPairs++;
+				}
+			}
+			return PxQueryHitType::eNONE;
+		}
+
+		virtual PxQueryHitType::Enum postFilter(const PxFilterData&, const PxQueryHit&, const PxShape*, const PxRigidActor*)
+		{
+			return PxQueryHitType::eNONE;
+		}
+
+		const OverlapBatchGroup&	mGroup;
+		const PxGeometryHolder*		mGeometries;
+		const PxTransform*			mPoses;
+		PxU32*						mPairs;
+		const PxU32					mMaxNbPairs;
+		PxQueryFilterCallback*		mUserFilter;
+		PxU32						mNbPairs;
+		bool						mOverflow;
+
+		PX_NOCOPY(OverlapBatchFilter)
+	};
+}
+
+static void overlapBatchGroup(const PxScene& scene, const PxQueryFilterData& filterData, OverlapBatchFilter& filter)
+{
+	const PxBounds3& bounds = filter.mGroup.mBounds;
+	const PxBoxGeometry groupBox(bounds.getExtents());
+	PxOverlapBuffer buf;
+	scene.overlap(groupBox, PxTransform(bounds.getCenter()), buf, filterData, &filter);
+}
+
+PxI32 PxSceneQueryExt::overlapBatch(const PxScene& scene, PxU32 nbQueries,
+									const PxGeometryHolder* geometries, const PxTransform* poses,
+									PxU32* pairs, PxU32 maxNbPairs,
+									const PxSceneQueryFilterData& filterData, PxSceneQueryFilterCallback* filterCall)
+{
+	PX_CHECK_AND_RETURN_VAL(geometries && poses, "PxSceneQueryExt::overlapBatch: input buffers cannot be NULL", 0);
+	PX_CHECK_AND_RETURN_VAL(pairs || !maxNbPairs, "PxSceneQueryExt::overlapBatch: pairs buffer cannot be NULL", 0);
+	if(!nbQueries)
+		return 0;
+
+	PxBounds3* bounds = PX_ALLOCATE(PxBounds3, nbQueries, "overlapBatch bounds");
+	if(!bounds)
+		return 0;
+
+	PxBounds3 globalBounds = PxBounds3::empty();
+	for(PxU32 i=0; i<nbQueries; i++)
+	{
+		PxGeometryQuery::computeGeomBounds(bounds[i], geometries[i].any(), poses[i]);
+		globalBounds.include(bounds[i]);
+	}
+
+	// Visit the queries along a Morton curve over their centers, so that consecutive queries end up in the same group.
+	Cm::RadixSortBuffered rs;
+	const PxU32* ranks = NULL;
+	PxU32* keys = NULL;
+	if(nbQueries >= RAYCAST_BATCH_SORT_THRESHOLD)
+	{
+		const PxVec3 extents = globalBounds.maximum - globalBounds.minimum;
+		const PxVec3 scale(	extents.x > 0.0f ? 1023.0f / extents.x : 0.0f,
+							extents.y > 0.0f ? 1023.0f / extents.y : 0.0f,
+							extents.z > 0.0f ? 1023.0f / extents.z : 0.0f);
+
+		keys = PX_ALLOCATE(PxU32, nbQueries, "overlapBatch keys");
+		if(keys)
+		{
+			for(PxU32 i=0; i<nbQueries; i++)
+				keys[i] = computeMortonCode(bounds[i].getCenter(), globalBounds.minimum, scale);
+
+			ranks = rs.Sort(keys, nbQueries, Cm::RADIX_UNSIGNED).GetRanks();
+		}
+	}
+
+	// The user pre-filter is called from ours, the post-filter is never needed since no hit is reported.
+	// PT: eANY_HIT lets us pass an empty hit buffer. It never terminates the traversal early since no hit is ever reported.
+	PxQueryFilterData fd = filterData;
+	if(!(fd.flags & PxQueryFlag::ePREFILTER))
+		filterCall = NULL;
+	fd.flags |= PxQueryFlag::ePREFILTER | PxQueryFlag::eNO_BLOCK | PxQueryFlag::eANY_HIT;
+	fd.flags &= ~PxQueryFlag::ePOSTFILTER;
+
+	OverlapBatchGroup group;
+	group.reset();
+	OverlapBatchFilter filter(group, geometries, poses, pairs, maxNbPairs, filterCall);
+
+	for(PxU32 j=0; j<nbQueries; j++)
+	{
+		const PxU32 i = ranks ? ranks[j] : j;
+		if(!group.accepts(bounds[i]))
+		{
+			overlapBatchGroup(scene, fd, filter);
+			group.reset();
+		}
+		group.add(i, bounds[i]);
+	}
+	overlapBatchGroup(scene, fd, filter);
+
+	PX_FREE(keys);
+	PX_FREE(bounds);
+	return filter.mOverflow ? -1 : PxI32(filter.mNbPairs);
+}
+
 template<typename HitType>
 struct NpOverflowBuffer : PxHitBuffer<HitType>
 {
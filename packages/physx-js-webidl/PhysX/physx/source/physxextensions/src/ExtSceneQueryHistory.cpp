@@ -0,0 +1,405 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxSceneQueryHistory.h"
+#include "extensions/PxShapeExt.h"
+#include "geometry/PxGeometryQuery.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashSet.h"
+#include "foundation/PxMathUtils.h"
+#include "PxRigidActor.h"
+#include "PxShape.h"
+
+using namespace physx;
+
+namespace
+{
+	// PT: a tracked shape. Slots of removed actors have a NULL actor and are reused by the next added shapes.
+	struct TrackedShape
+	{
+		PxRigidActor*	mActor;
+		PxShape*		mShape;
+	};
+
+	struct ShapeState
+	{
+		PxTransform		mPose;		// Global pose of the shape
+		PxBounds3		mBounds;	// World bounds of the shape at mPose
+		bool			mValid;
+	};
+
+	struct Frame
+	{
+		PxF64				mTimestamp;
+		PxArray<ShapeState>	mStates;	// Indexed by tracked shape slot
+	};
+
+	// PT: one shape as it was at the queried time
+	struct HistoricalShape
+	{
+		PxTransform		mPose;
+		PxBounds3		mBounds;	// Conservative bounds of the shape at mPose
+	};
+
+	PX_FORCE_INLINE bool passesFilter(const TrackedShape& tracked, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxHitFlags& hitFlags)
+	{
+		const PxFilterData& queryData = filterData.data;
+		if(queryData.word0 | queryData.word1 | queryData.word2 | queryData.word3)
+		{
+			const PxFilterData shapeData = tracked.mShape->getQueryFilterData();
+			if(!((queryData.word0 & shapeData.word0) | (queryData.word1 & shapeData.word1) | (queryData.word2 & shapeData.word2) | (queryData.word3 & shapeData.word3)))
+				return false;
+		}
+		return !filterCall || filterCall->preFilter(queryData, tracked.mShape, tracked.mActor, hitFlags)!=PxQueryHitType::eNONE;
+	}
+
+	PX_FORCE_INLINE bool rayTouchesBounds(const PxBounds3& bounds, const PxVec3& origin, const PxVec3& unitDir, PxReal distance)
+	{
+		PxReal tMin = 0.0f;
+		PxReal tMax = distance;
+		for(PxU32 axis=0;axis<3;axis++)
+		{
+			if(PxAbs(unitDir[axis])<1e-9f)
+			{
+				if(origin[axis]<bounds.minimum[axis] || origin[axis]>bounds.maximum[axis])
+					return false;
+			}
+			else
+			{
+				const PxReal oneOverDir = 1.0f / unitDir[axis];
+				PxReal t0 = (bounds.minimum[axis] - origin[axis]) * oneOverDir;
+				PxReal t1 = (bounds.maximum[axis] - origin[axis]) * oneOverDir;
+				if(t0>t1)
+					PxSwap(t0, t1);
+				tMin = PxMax(tMin, t0);
+				tMax = PxMin(tMax, t1);
+				if(tMin>tMax)
+					return false;
+			}
+		}
+		return true;
+	}
+}
+
+namespace physx
+{
+class SceneQueryHistoryInternal
+{
+	public:
+						SceneQueryHistoryInternal(PxU32 nbFrames) : mFirstFrame(0), mNbFrames(0)
+						{
+							mFrames.resize(PxMax(nbFrames, 1u));
+						}
+
+	PX_FORCE_INLINE	const Frame&	getFrame(PxU32 index)	const
+						{
+							PX_ASSERT(index<mNbFrames);
+							return mFrames[(mFirstFrame + index) % mFrames.size()];
+						}
+
+	// PT: finds the two frames surrounding a timestamp, clamped to the recorded range
+	bool				findFrames(PxF64 timestamp, const Frame*& frame0, const Frame*& frame1, PxReal& coeff)	const
+						{
+							if(!mNbFrames)
+								return false;
+
+							coeff = 0.0f;
+							const Frame& oldest = getFrame(0);
+							const Frame& newest = getFrame(mNbFrames-1);
+							if(timestamp<=oldest.mTimestamp)
+							{
+								frame0 = frame1 = &oldest;
+								return true;
+							}
+							if(timestamp>=newest.mTimestamp)
+							{
+								frame0 = frame1 = &newest;
+								return true;
+							}
+
+							// PT: binary search for the last frame at or before the timestamp
+							PxU32 lo = 0;
+							PxU32 hi = mNbFrames-1;
+							while(hi-lo>1)
+							{
+								const PxU32 mid = (lo + hi)/2;
+								if(getFrame(mid).mTimestamp<=timestamp)
+									lo = mid;
+								else
+									hi = mid;
+							}
+							frame0 = &getFrame(lo);
+							frame1 = &getFrame(hi);
+							coeff = PxReal((timestamp - frame0->mTimestamp) / (frame1->mTimestamp - frame0->mTimestamp));
+							return true;
+						}
+
+	// PT: interpolated pose and conservative bounds of a slot, false if the slot has no state in either frame
+	bool				getHistoricalShape(PxU32 slot, const Frame& frame0, const Frame& frame1, PxReal coeff, HistoricalShape& shape)	const
+						{
+							const ShapeState* state0 = slot<frame0.mStates.size() && frame0.mStates[slot].mValid ? &frame0.mStates[slot] : NULL;
+							const ShapeState* state1 = slot<frame1.mStates.size() && frame1.mStates[slot].mValid ? &frame1.mStates[slot] : NULL;
+							if(!state0 || !state1)
+							{
+								// PT: shape added or removed between the two frames, use the state we have
+								const ShapeState* state = state0 ? state0 : state1;
+								if(!state)
+									return false;
+								shape.mPose = state->mPose;
+								shape.mBounds = state->mBounds;
+								return true;
+							}
+
+							shape.mPose.p = state0->mPose.p + (state1->mPose.p - state0->mPose.p) * coeff;
+							shape.mPose.q = PxSlerp(coeff, state0->mPose.q, state1->mPose.q);
+
+							// PT: the union of both bounds misses the arc described by the rotating shape. Points at distance
+							// r from the rotation center stray at most r*(1-cos(angle/2)) from the chord, so we fatten by that.
+							shape.mBounds = state0->mBounds;
+							shape.mBounds.include(state1->mBounds);
+							const PxReal cosHalfAngle = PxMin(PxAbs(state0->mPose.q.dot(state1->mPose.q)), 1.0f);
+							const PxReal radius = (state0->mBounds.getCenter() - state0->mPose.p).magnitude() + state0->mBounds.getExtents().magnitude();
+							shape.mBounds.fattenFast(radius * (1.0f - cosHalfAngle));
+							return true;
+						}
+
+	PxArray<TrackedShape>				mShapes;
+	PxArray<PxU32>						mFreeSlots;
+	PxHashSet<const PxRigidActor*>		mActors;
+	PxArray<Frame>						mFrames;
+	PxU32								mFirstFrame;
+	PxU32								mNbFrames;
+};
+}
+
+PxSceneQueryHistory::PxSceneQueryHistory(PxU32 nbFrames)
+{
+	mImpl = new SceneQueryHistoryInternal(nbFrames);
+}
+
+PxSceneQueryHistory::~PxSceneQueryHistory()
+{
+	delete mImpl;
+}
+
+bool PxSceneQueryHistory::addActor(const PxRigidActor& actor)
+{
+	if(!mImpl->mActors.insert(&actor))
+		return false;
+
+	const PxU32 nbShapes = actor.getNbShapes();
+	PxArray<PxShape*> shapes(nbShapes);
+	actor.getShapes(shapes.begin(), nbShapes);
+
+	for(PxU32 i=0;i<nbShapes;i++)
+	{
+		if(!(shapes[i]->getFlags() & PxShapeFlag::eSCENE_QUERY_SHAPE))
+			continue;
+
+		TrackedShape tracked;
+		tracked.mActor = const_cast<PxRigidActor*>(&actor);
+		tracked.mShape = shapes[i];
+
+		if(mImpl->mFreeSlots.size())
+			mImpl->mShapes[mImpl->mFreeSlots.popBack()] = tracked;
+		else
+			mImpl->mShapes.pushBack(tracked);
+	}
+	return true;
+}
+
+bool PxSceneQueryHistory::removeActor(const PxRigidActor& actor)
+{
+	if(!mImpl->mActors.erase(&actor))
+		return false;
+
+	const PxU32 nbSlots = mImpl->mShapes.size();
+	for(PxU32 slot=0;slot<nbSlots;slot++)
+	{
+		TrackedShape& tracked = mImpl->mShapes[slot];
+		if(tracked.mActor!=&actor)
+			continue;
+
+		tracked.mActor = NULL;
+		tracked.mShape = NULL;
+		mImpl->mFreeSlots.pushBack(slot);
+
+		// PT: the slot can be reused by another shape, its past states must go
+		const PxU32 nbFrames = mImpl->mFrames.size();
+		for(PxU32 i=0;i<nbFrames;i++)
+		{
+			PxArray<ShapeState>& states = mImpl->mFrames[i].mStates;
+			if(slot<states.size())
+				states[slot].mValid = false;
+		}
+	}
+	return true;
+}
+
+PxU32 PxSceneQueryHistory::getNbActors() const
+{
+	return mImpl->mActors.size();
+}
+
+bool PxSceneQueryHistory::recordFrame(PxF64 timestamp)
+{
+	SceneQueryHistoryInternal& impl = *mImpl;
+	if(impl.mNbFrames && timestamp<=impl.getFrame(impl.mNbFrames-1).mTimestamp)
+		return false;
+
+	// PT: overwrite the oldest frame when the history is full
+	const PxU32 capacity = impl.mFrames.size();
+	Frame* frame;
+	if(impl.mNbFrames<capacity)
+		frame = &impl.mFrames[(impl.mFirstFrame + impl.mNbFrames++) % capacity];
+	else
+	{
+		frame = &impl.mFrames[impl.mFirstFrame];
+		impl.mFirstFrame = (impl.mFirstFrame + 1) % capacity;
+	}
+	frame->mTimestamp = timestamp;
+
+	const PxU32 nbSlots = impl.mShapes.size();
+	frame->mStates.resize(nbSlots);
+	for(PxU32 slot=0;slot<nbSlots;slot++)
+	{
+		const TrackedShape& tracked = impl.mShapes[slot];
+		ShapeState& state = frame->mStates[slot];
+		state.mValid = tracked.mActor!=NULL;
+		if(!state.mValid)
+			continue;
+
+		state.mPose = PxShapeExt::getGlobalPose(*tracked.mShape, *tracked.mActor);
+		PxGeometryQuery::computeGeomBounds(state.mBounds, tracked.mShape->getGeometry(), state.mPose);
+	}
+	return true;
+}
+
+void PxSceneQueryHistory::clear()
+{
+	mImpl->mFirstFrame = 0;
+	mImpl->mNbFrames = 0;
+}
+
+PxU32 PxSceneQueryHistory::getNbFrames() const
+{
+	return mImpl->mNbFrames;
+}
+
+bool PxSceneQueryHistory::getTimeRange(PxF64& oldest, PxF64& newest) const
+{
+	if(!mImpl->mNbFrames)
+		return false;
+	oldest = mImpl->getFrame(0).mTimestamp;
+	newest = mImpl->getFrame(mImpl->mNbFrames-1).mTimestamp;
+	return true;
+}
+
+bool PxSceneQueryHistory::raycast(	const PxVec3& origin, const PxVec3& unitDir, PxReal distance, PxF64 timestamp,
+									PxRaycastHit& hit, PxHitFlags hitFlags,
+									const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall) const
+{
+	const Frame* frame0;
+	const Frame* frame1;
+	PxReal coeff;
+	if(!mImpl->findFrames(timestamp, frame0, frame1, coeff))
+		return false;
+
+	bool status = false;
+	PxReal closest = distance;
+	const PxU32 nbSlots = mImpl->mShapes.size();
+	for(PxU32 slot=0;slot<nbSlots;slot++)
+	{
+		const TrackedShape& tracked = mImpl->mShapes[slot];
+		if(!tracked.mActor)
+			continue;
+
+		HistoricalShape shape;
+		if(!mImpl->getHistoricalShape(slot, *frame0, *frame1, coeff, shape) || !rayTouchesBounds(shape.mBounds, origin, unitDir, closest))
+			continue;
+
+		PxHitFlags shapeHitFlags = hitFlags;
+		if(!passesFilter(tracked, filterData, filterCall, shapeHitFlags))
+			continue;
+
+		PxGeomRaycastHit geomHit;
+		if(PxGeometryQuery::raycast(origin, unitDir, tracked.mShape->getGeometry(), shape.mPose, closest, shapeHitFlags, 1, &geomHit) && geomHit.distance<=closest)
+		{
+			static_cast<PxGeomRaycastHit&>(hit) = geomHit;
+			hit.actor = tracked.mActor;
+			hit.shape = tracked.mShape;
+			closest = geomHit.distance;
+			status = true;
+		}
+	}
+	return status;
+}
+
+bool PxSceneQueryHistory::sweep(const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, PxReal distance, PxF64 timestamp,
+								PxSweepHit& hit, PxHitFlags hitFlags,
+								const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxReal inflation) const
+{
+	const Frame* frame0;
+	const Frame* frame1;
+	PxReal coeff;
+	if(!mImpl->findFrames(timestamp, frame0, frame1, coeff))
+		return false;
+
+	// PT: bounds of the whole sweep, to reject shapes it cannot reach
+	PxBounds3 sweptBounds;
+	PxGeometryQuery::computeGeomBounds(sweptBounds, geometry, pose, inflation);
+	const PxVec3 motion = unitDir * distance;
+	sweptBounds.include(PxBounds3(sweptBounds.minimum + motion, sweptBounds.maximum + motion));
+
+	bool status = false;
+	PxReal closest = distance;
+	const PxU32 nbSlots = mImpl->mShapes.size();
+	for(PxU32 slot=0;slot<nbSlots;slot++)
+	{
+		const TrackedShape& tracked = mImpl->mShapes[slot];
+		if(!tracked.mActor)
+			continue;
+
+		HistoricalShape shape;
+		if(!mImpl->getHistoricalShape(slot, *frame0, *frame1, coeff, shape) || !sweptBounds.intersects(shape.mBounds))
+			continue;
+
+		PxHitFlags shapeHitFlags = hitFlags;
+		if(!passesFilter(tracked, filterData, filterCall, shapeHitFlags))
+			continue;
+
+		PxGeomSweepHit geomHit;
+		if(PxGeometryQuery::sweep(unitDir, closest, geometry, pose, tracked.mShape->getGeometry(), shape.mPose, geomHit, shapeHitFlags, inflation) && geomHit.distance<=closest)
+		{
+			static_cast<PxGeomSweepHit&>(hit) = geomHit;
+			hit.actor = tracked.mActor;
+			hit.shape = tracked.mShape;
+			closest = geomHit.distance;
+			status = true;
+		}
+	}
+	return status;
+}
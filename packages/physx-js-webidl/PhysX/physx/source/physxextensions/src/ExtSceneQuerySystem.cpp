@@ -188,6 +188,14 @@ namespace
 														PxOverlapCallback& hitCall, 
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	bool							cull(PxU32 nbPlanes, const PxPlane* planes,
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const;
+		virtual	PxI32							overlapSpheres(PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,
+														PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const;
 		virtual	PxSQPrunerHandle				getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const;
 		virtual	void							sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
 													const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices);
@@ -387,6 +395,22 @@ bool ExternalPxSQ::overlap(	const PxGeometry& geometry, const PxTransform& trans
 	return mQueries._overlap( geometry, transform, hitCall, filterData, filterCall, cache, flags);
 }
 
+bool ExternalPxSQ::cull(PxU32 nbPlanes, const PxPlane* planes,
+							PxOverlapCallback& hitCall,
+							const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+							PxGeometryQueryFlags flags) const
+{
+	return mQueries._cull(nbPlanes, planes, hitCall, filterData, filterCall, flags);
+}
+
+PxI32 ExternalPxSQ::overlapSpheres(PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,
+									PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+									const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+									PxGeometryQueryFlags flags) const
+{
+	return mQueries._overlapSpheres(nbSpheres, centers, radii, hits, maxNbHits, nbHitsPerQuery, filterData, filterCall, flags);
+}
+
 PxSQPrunerHandle ExternalPxSQ::getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex) const
 {
 	const PxU32 actorIndex = actor.getInternalActorIndex();
@@ -419,6 +443,7 @@ static CompanionPrunerType getCompanionType(PxDynamicTreeSecondaryPruner::Enum t
 		case PxDynamicTreeSecondaryPruner::eBUCKET:			return COMPANION_PRUNER_BUCKET;
 		case PxDynamicTreeSecondaryPruner::eINCREMENTAL:	return COMPANION_PRUNER_INCREMENTAL;
 		case PxDynamicTreeSecondaryPruner::eBVH:			return COMPANION_PRUNER_AABB_TREE;
+		case PxDynamicTreeSecondaryPruner::eGRID:			return COMPANION_PRUNER_GRID;
 		case PxDynamicTreeSecondaryPruner::eLAST:			return COMPANION_PRUNER_NONE;
 	}
 	return COMPANION_PRUNER_NONE;
@@ -436,7 +461,7 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 	return BVH_SPLATTER_POINTS;
 }
 
-static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
+static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode, PxReal rebuildCostThreshold, bool quantizedTree)
 {
 //	if(0)
 //		return createIncrementalPruner(contextID);
@@ -448,8 +473,8 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 	switch(type)
 	{
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
-		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
-		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode, rebuildCostThreshold);		break;	}
+		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode, rebuildCostThreshold, quantizedTree);	break;	}
 		case PxPruningStructureType::eLAST:					break;
 	}
 	return pruner;
@@ -458,8 +483,8 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 PxSceneQuerySystem* physx::PxCreateExternalSceneQuerySystem(const PxSceneQueryDesc& desc, PxU64 contextID)
 {
 	PVDCapture* pvd = NULL;
-	Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode);
-	Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode);
+	Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode, 0.0f, desc.staticQuantizedTree);
+	Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode, desc.dynamicTreeRebuildCostThreshold, false);
 
 	ExternalPxSQ* pxsq = PX_NEW(ExternalPxSQ)(pvd, contextID, staticPruner, dynamicPruner, desc.dynamicTreeRebuildRateHint, desc.sceneQueryUpdateMode, PxSceneLimits());
 
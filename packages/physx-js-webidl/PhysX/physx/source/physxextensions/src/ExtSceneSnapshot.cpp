@@ -0,0 +1,794 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxSceneSnapshot.h"
+#include "PxScene.h"
+#include "PxRigidDynamic.h"
+#include "PxConstraint.h"
+#include "PxArticulationReducedCoordinate.h"
+
+#include "foundation/PxArray.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxFoundation.h"
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxMathUtils.h"
+
+using namespace physx;
+
+// PT: snapshot format:
+//
+//	SnapshotHeader
+//	BodyState				x nbBodies
+//	ArticulationState		x nbArticulations, each followed by nbDofs joint positions and nbDofs joint velocities
+//	PxU32					x (nbConstraints+31)/32, one broken bit per constraint
+//
+// Everything is 4-byte aligned and pointer-free.
+
+static const PxU32 SNAPSHOT_MAGIC	= PxU32('S' | ('N'<<8) | ('A'<<16) | ('P'<<24));
+static const PxU32 SNAPSHOT_VERSION	= 1;
+
+namespace
+{
+	struct SnapshotHeader
+	{
+		PxU32	mMagic;
+		PxU32	mVersion;
+		PxU32	mNbBodies;
+		PxU32	mNbArticulations;
+		PxU32	mNbConstraints;
+		PxU32	mNbDofs;			// Total over all articulations
+	};
+
+	enum SnapshotFlag
+	{
+		eSLEEPING	= (1<<0),
+		ePOSE_ONLY	= (1<<1)		// Kinematic or simulation disabled, velocities & wake counter are not used
+	};
+
+	struct BodyState
+	{
+		PxTransform	mPose;
+		PxVec3		mLinVel;
+		PxVec3		mAngVel;
+		PxReal		mWakeCounter;
+		PxU32		mFlags;
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(BodyState) == 60);
+
+	struct ArticulationState
+	{
+		PxTransform	mRootPose;
+		PxVec3		mRootLinVel;
+		PxVec3		mRootAngVel;
+		PxReal		mWakeCounter;
+		PxU32		mFlags;
+		PxU32		mNbDofs;
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(ArticulationState) == 64);
+}
+
+static PX_FORCE_INLINE PxU32 computeSnapshotSize(PxU32 nbBodies, PxU32 nbArticulations, PxU32 nbConstraints, PxU32 nbDofs)
+{
+	return sizeof(SnapshotHeader)
+		+ nbBodies * sizeof(BodyState)
+		+ nbArticulations * sizeof(ArticulationState) + nbDofs * 2 * sizeof(PxReal)
+		+ ((nbConstraints+31)>>5) * sizeof(PxU32);
+}
+
+static const PxArticulationCacheFlags gCacheFlags = PxArticulationCacheFlag::eROOT_TRANSFORM | PxArticulationCacheFlag::eROOT_VELOCITIES
+												| PxArticulationCacheFlag::ePOSITION | PxArticulationCacheFlag::eVELOCITY;
+
+namespace physx
+{
+class SceneSnapshotInternal
+{
+	PX_NOCOPY(SceneSnapshotInternal)
+	public:
+				SceneSnapshotInternal(PxScene& scene) : mScene(scene)	{}
+				~SceneSnapshotInternal()								{ releaseCaches();	}
+
+		PxU32	capture();
+		bool	setData(const void* data, PxU32 size);
+		bool	restore();
+		PxU32	computeDiff(const PxArray<PxU8>& base, const PxSceneDiffParams& params);
+		bool	applyDiff(const void* diff, PxU32 size);
+
+		void	fetchObjects();
+		void	releaseCaches();
+		PxArticulationCache&	getCache(PxU32 index);
+
+		PxScene&								mScene;
+		PxArray<PxActor*>						mBodies;
+		PxArray<PxArticulationReducedCoordinate*>	mArticulations;
+		PxArray<PxConstraint*>					mConstraints;
+		// PT: caches are created per articulation and kept between calls. mCacheOwners tracks which articulation each cache was created for.
+		PxArray<PxArticulationCache*>			mCaches;
+		PxArray<PxArticulationReducedCoordinate*>	mCacheOwners;
+		PxArray<PxU8>							mData;
+		PxArray<PxU8>							mPreviousData;	// Previous capture, for captureDiff()
+		PxArray<PxU32>							mDiff;
+};
+}
+
+void SceneSnapshotInternal::fetchObjects()
+{
+	const PxU32 nbBodies = mScene.getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC);
+	mBodies.resizeUninitialized(nbBodies);
+	mScene.getActors(PxActorTypeFlag::eRIGID_DYNAMIC, mBodies.begin(), nbBodies);
+
+	const PxU32 nbArticulations = mScene.getNbArticulations();
+	mArticulations.resizeUninitialized(nbArticulations);
+	mScene.getArticulations(mArticulations.begin(), nbArticulations);
+
+	const PxU32 nbConstraints = mScene.getNbConstraints();
+	mConstraints.resizeUninitialized(nbConstraints);
+	mScene.getConstraints(mConstraints.begin(), nbConstraints);
+}
+
+void SceneSnapshotInternal::releaseCaches()
+{
+	const PxU32 nbCaches = mCaches.size();
+	for(PxU32 i=0;i<nbCaches;i++)
+	{
+		if(mCaches[i])
+			mCaches[i]->release();
+	}
+	mCaches.reset();
+	mCacheOwners.reset();
+}
+
+PxArticulationCache& SceneSnapshotInternal::getCache(PxU32 index)
+{
+	if(index >= mCaches.size())
+	{
+		mCaches.resize(index+1, NULL);
+		mCacheOwners.resize(index+1, NULL);
+	}
+
+	PxArticulationReducedCoordinate* articulation = mArticulations[index];
+	if(mCacheOwners[index] != articulation)
+	{
+		if(mCaches[index])
+			mCaches[index]->release();
+		mCaches[index] = articulation->createCache();
+		mCacheOwners[index] = articulation;
+	}
+	return *mCaches[index];
+}
+
+PxU32 SceneSnapshotInternal::capture()
+{
+	fetchObjects();
+
+	const PxU32 nbBodies = mBodies.size();
+	const PxU32 nbArticulations = mArticulations.size();
+	const PxU32 nbConstraints = mConstraints.size();
+
+	PxU32 nbDofs = 0;
+	for(PxU32 i=0;i<nbArticulations;i++)
+		nbDofs += mArticulations[i]->getDofs();
+
+	mData.resizeUninitialized(computeSnapshotSize(nbBodies, nbArticulations, nbConstraints, nbDofs));
+	PxU8* dst = mData.begin();
+
+	SnapshotHeader* header = reinterpret_cast<SnapshotHeader*>(dst);
+	header->mMagic				= SNAPSHOT_MAGIC;
+	header->mVersion			= SNAPSHOT_VERSION;
+	header->mNbBodies			= nbBodies;
+	header->mNbArticulations	= nbArticulations;
+	header->mNbConstraints		= nbConstraints;
+	header->mNbDofs				= nbDofs;
+	dst += sizeof(SnapshotHeader);
+
+	BodyState* bodyStates = reinterpret_cast<BodyState*>(dst);
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		const PxRigidDynamic* body = static_cast<const PxRigidDynamic*>(mBodies[i]);
+		BodyState& state = bodyStates[i];
+		state.mPose = body->getGlobalPose();
+		if((body->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC) || (body->getActorFlags() & PxActorFlag::eDISABLE_SIMULATION))
+		{
+			state.mLinVel		= PxVec3(0.0f);
+			state.mAngVel		= PxVec3(0.0f);
+			state.mWakeCounter	= 0.0f;
+			state.mFlags		= ePOSE_ONLY;
+		}
+		else
+		{
+			state.mLinVel		= body->getLinearVelocity();
+			state.mAngVel		= body->getAngularVelocity();
+			state.mWakeCounter	= body->getWakeCounter();
+			state.mFlags		= body->isSleeping() ? PxU32(eSLEEPING) : 0;
+		}
+	}
+	dst += nbBodies * sizeof(BodyState);
+
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		const PxArticulationReducedCoordinate* articulation = mArticulations[i];
+		PxArticulationCache& cache = getCache(i);
+		articulation->copyInternalStateToCache(cache, gCacheFlags);
+
+		const PxU32 dofs = articulation->getDofs();
+		ArticulationState* state = reinterpret_cast<ArticulationState*>(dst);
+		state->mRootPose	= cache.rootLinkData->transform;
+		state->mRootLinVel	= cache.rootLinkData->worldLinVel;
+		state->mRootAngVel	= cache.rootLinkData->worldAngVel;
+		state->mWakeCounter	= articulation->getWakeCounter();
+		state->mFlags		= articulation->isSleeping() ? PxU32(eSLEEPING) : 0;
+		state->mNbDofs		= dofs;
+		dst += sizeof(ArticulationState);
+
+		PxMemCopy(dst, cache.jointPosition, dofs * sizeof(PxReal));
+		dst += dofs * sizeof(PxReal);
+		PxMemCopy(dst, cache.jointVelocity, dofs * sizeof(PxReal));
+		dst += dofs * sizeof(PxReal);
+	}
+
+	PxU32* brokenBits = reinterpret_cast<PxU32*>(dst);
+	PxMemZero(brokenBits, ((nbConstraints+31)>>5) * sizeof(PxU32));
+	for(PxU32 i=0;i<nbConstraints;i++)
+	{
+		if(mConstraints[i]->getFlags() & PxConstraintFlag::eBROKEN)
+			brokenBits[i>>5] |= 1u<<(i&31);
+	}
+
+	return mData.size();
+}
+
+bool SceneSnapshotInternal::setData(const void* data, PxU32 size)
+{
+	if(!data || size < sizeof(SnapshotHeader))
+		return false;
+
+	const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(data);
+	if(header->mMagic != SNAPSHOT_MAGIC || header->mVersion != SNAPSHOT_VERSION)
+		return false;
+
+	// PT: 64-bit maths so that corrupted counts cannot overflow the size check
+	const PxU64 expectedSize = PxU64(sizeof(SnapshotHeader))
+							+ PxU64(header->mNbBodies) * sizeof(BodyState)
+							+ PxU64(header->mNbArticulations) * sizeof(ArticulationState) + PxU64(header->mNbDofs) * 2 * sizeof(PxReal)
+							+ PxU64((PxU64(header->mNbConstraints)+31)>>5) * sizeof(PxU32);
+	if(expectedSize != size)
+		return false;
+
+	mData.resizeUninitialized(size);
+	PxMemCopy(mData.begin(), data, size);
+	return true;
+}
+
+bool SceneSnapshotInternal::restore()
+{
+	if(!mData.size())
+		return false;
+
+	fetchObjects();
+
+	const PxU8* src = mData.begin();
+	const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(src);
+
+	const PxU32 nbBodies = mBodies.size();
+	const PxU32 nbArticulations = mArticulations.size();
+	const PxU32 nbConstraints = mConstraints.size();
+	if(header->mNbBodies != nbBodies || header->mNbArticulations != nbArticulations || header->mNbConstraints != nbConstraints)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PxSceneSnapshot::restore: snapshot does not match the objects in the scene.");
+
+	// PT: validate articulation DOFs before touching the scene, so that a mismatch leaves it unchanged
+	{
+		const PxU8* articulationData = src + sizeof(SnapshotHeader) + nbBodies * sizeof(BodyState);
+		for(PxU32 i=0;i<nbArticulations;i++)
+		{
+			const ArticulationState* state = reinterpret_cast<const ArticulationState*>(articulationData);
+			if(state->mNbDofs != mArticulations[i]->getDofs())
+				return PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PxSceneSnapshot::restore: snapshot does not match the objects in the scene.");
+			articulationData += sizeof(ArticulationState) + state->mNbDofs * 2 * sizeof(PxReal);
+		}
+	}
+	src += sizeof(SnapshotHeader);
+
+	const BodyState* bodyStates = reinterpret_cast<const BodyState*>(src);
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		PxRigidDynamic* body = static_cast<PxRigidDynamic*>(mBodies[i]);
+		const BodyState& state = bodyStates[i];
+		body->setGlobalPose(state.mPose, false);
+
+		if(state.mFlags & ePOSE_ONLY)
+			continue;
+
+		// PT: a body that is kinematic now but was not at capture time only gets its pose back
+		if((body->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC) || (body->getActorFlags() & PxActorFlag::eDISABLE_SIMULATION))
+			continue;
+
+		body->setLinearVelocity(state.mLinVel, false);
+		body->setAngularVelocity(state.mAngVel, false);
+		if(state.mFlags & eSLEEPING)
+		{
+			if(!body->isSleeping())
+				body->putToSleep();
+		}
+		else
+			body->setWakeCounter(state.mWakeCounter);
+	}
+	src += nbBodies * sizeof(BodyState);
+
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		PxArticulationReducedCoordinate* articulation = mArticulations[i];
+		PxArticulationCache& cache = getCache(i);
+
+		const ArticulationState* state = reinterpret_cast<const ArticulationState*>(src);
+		const PxU32 dofs = state->mNbDofs;
+		src += sizeof(ArticulationState);
+
+		cache.rootLinkData->transform	= state->mRootPose;
+		cache.rootLinkData->worldLinVel	= state->mRootLinVel;
+		cache.rootLinkData->worldAngVel	= state->mRootAngVel;
+		PxMemCopy(cache.jointPosition, src, dofs * sizeof(PxReal));
+		src += dofs * sizeof(PxReal);
+		PxMemCopy(cache.jointVelocity, src, dofs * sizeof(PxReal));
+		src += dofs * sizeof(PxReal);
+
+		articulation->applyCache(cache, gCacheFlags, false);
+		if(state->mFlags & eSLEEPING)
+		{
+			if(!articulation->isSleeping())
+				articulation->putToSleep();
+		}
+		else
+			articulation->setWakeCounter(state->mWakeCounter);
+	}
+
+	const PxU32* brokenBits = reinterpret_cast<const PxU32*>(src);
+	bool unrepairable = false;
+	for(PxU32 i=0;i<nbConstraints;i++)
+	{
+		const bool wasBroken = (brokenBits[i>>5] & (1u<<(i&31))) != 0;
+		if(!wasBroken && (mConstraints[i]->getFlags() & PxConstraintFlag::eBROKEN))
+			unrepairable = true;
+	}
+	if(unrepairable)
+		PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "PxSceneSnapshot::restore: some constraints broke after the snapshot was captured and cannot be repaired.");
+
+	return true;
+}
+
+// PT: diff format:
+//
+//	DiffHeader
+//	PxU32 x mNbWords, bitstream containing mNbChanged records:
+//		index			indexBits, see computeIndexBits()
+//		flags			2 bits (eSLEEPING, ePOSE_ONLY)
+//		position		3 x positionBits
+//		largest			2 bits, index of the dropped quaternion component
+//		rotation		3 x rotationBits
+//		velocities		6 x velocityBits, only if neither eSLEEPING nor ePOSE_ONLY is set
+//
+// Signed values are written as two's complement in the given number of bits. Bits are packed LSB first.
+
+static const PxU32 DIFF_MAGIC	= PxU32('S' | ('D'<<8) | ('I'<<16) | ('F'<<24));
+static const PxU32 DIFF_VERSION	= 1;
+
+namespace
+{
+	struct DiffHeader
+	{
+		PxU32	mMagic;
+		PxU32	mVersion;
+		PxU32	mNbBodies;			// Number of rigid dynamics in the source scene
+		PxU32	mNbChanged;
+		PxReal	mPositionPrecision;
+		PxU32	mPositionBits;
+		PxU32	mRotationBits;
+		PxReal	mVelocityPrecision;
+		PxU32	mVelocityBits;
+		PxU32	mNbWords;
+	};
+	PX_COMPILE_TIME_ASSERT((sizeof(DiffHeader)&3) == 0);
+
+	class BitWriter
+	{
+		public:
+			BitWriter(PxArray<PxU32>& words) : mWords(words), mAccumulator(0), mNbBits(0)	{}
+
+			PX_FORCE_INLINE	void	write(PxU32 value, PxU32 nbBits)
+			{
+				const PxU32 mask = nbBits==32 ? 0xffffffff : (1u<<nbBits)-1;
+				mAccumulator |= PxU64(value & mask) << mNbBits;
+				mNbBits += nbBits;
+				if(mNbBits>=32)
+				{
+					mWords.pushBack(PxU32(mAccumulator));
+					mAccumulator >>= 32;
+					mNbBits -= 32;
+				}
+			}
+
+			void	flush()
+			{
+				if(mNbBits)
+					mWords.pushBack(PxU32(mAccumulator));
+				mAccumulator = 0;
+				mNbBits = 0;
+			}
+
+		private:
+			PxArray<PxU32>&	mWords;
+			PxU64			mAccumulator;
+			PxU32			mNbBits;
+		PX_NOCOPY(BitWriter)
+	};
+
+	class BitReader
+	{
+		public:
+			BitReader(const PxU32* words, PxU32 nbWords) : mWords(words), mNbWords(nbWords), mIndex(0), mAccumulator(0), mNbBits(0), mOverrun(false)	{}
+
+			PX_FORCE_INLINE	PxU32	read(PxU32 nbBits)
+			{
+				if(mNbBits<nbBits)
+				{
+					if(mIndex==mNbWords)
+					{
+						mOverrun = true;
+						return 0;
+					}
+					mAccumulator |= PxU64(mWords[mIndex++]) << mNbBits;
+					mNbBits += 32;
+				}
+				const PxU32 mask = nbBits==32 ? 0xffffffff : (1u<<nbBits)-1;
+				const PxU32 value = PxU32(mAccumulator) & mask;
+				mAccumulator >>= nbBits;
+				mNbBits -= nbBits;
+				return value;
+			}
+
+			PX_FORCE_INLINE	PxI32	readSigned(PxU32 nbBits)
+			{
+				const PxU32 shift = 32 - nbBits;
+				return PxI32(read(nbBits) << shift) >> shift;
+			}
+
+			const PxU32*	mWords;
+			const PxU32		mNbWords;
+			PxU32			mIndex;
+			PxU64			mAccumulator;
+			PxU32			mNbBits;
+			bool			mOverrun;
+		PX_NOCOPY(BitReader)
+	};
+
+	struct QuantizedBody
+	{
+		PxU32	mFlags;
+		PxI32	mPosition[3];
+		PxU32	mLargest;
+		PxI32	mRotation[3];
+		PxI32	mVelocity[6];
+	};
+
+	// PT: inverse quantization steps, so that quantize/dequantize are a single mul
+	struct Quantizer
+	{
+		Quantizer(PxReal positionPrecision, PxU32 positionBits, PxU32 rotationBits, PxReal velocityPrecision, PxU32 velocityBits) :
+			mPositionScale	(1.0f/positionPrecision),
+			mRotationScale	(PxReal((1<<(rotationBits-1))-1) * PxSqrt2),	// Smallest-three components are in [-1/sqrt(2), 1/sqrt(2)]
+			mVelocityScale	(1.0f/velocityPrecision),
+			mPositionBits	(positionBits),
+			mRotationBits	(rotationBits),
+			mVelocityBits	(velocityBits)
+		{
+		}
+
+		const PxReal	mPositionScale;
+		const PxReal	mRotationScale;
+		const PxReal	mVelocityScale;
+		const PxU32		mPositionBits;
+		const PxU32		mRotationBits;
+		const PxU32		mVelocityBits;
+		PX_NOCOPY(Quantizer)
+	};
+}
+
+static PX_FORCE_INLINE PxI32 quantizeValue(PxReal value, PxReal scale, PxU32 nbBits)
+{
+	const PxReal maxValue = PxReal((1<<(nbBits-1))-1);
+	return PxI32(PxFloor(PxClamp(value * scale, -maxValue, maxValue) + 0.5f));
+}
+
+static void quantizeBody(QuantizedBody& q, const BodyState& state, const Quantizer& quantizer)
+{
+	q.mFlags = state.mFlags & (eSLEEPING|ePOSE_ONLY);
+
+	q.mPosition[0] = quantizeValue(state.mPose.p.x, quantizer.mPositionScale, quantizer.mPositionBits);
+	q.mPosition[1] = quantizeValue(state.mPose.p.y, quantizer.mPositionScale, quantizer.mPositionBits);
+	q.mPosition[2] = quantizeValue(state.mPose.p.z, quantizer.mPositionScale, quantizer.mPositionBits);
+
+	// PT: smallest-three. The largest component is made positive (q and -q are the same rotation) and dropped.
+	const PxQuat& rot = state.mPose.q;
+	const PxReal components[4] = { rot.x, rot.y, rot.z, rot.w };
+	PxU32 largest = 0;
+	for(PxU32 i=1;i<4;i++)
+	{
+		if(PxAbs(components[i]) > PxAbs(components[largest]))
+			largest = i;
+	}
+	const PxReal sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+	q.mLargest = largest;
+	for(PxU32 i=0, j=0;i<4;i++)
+	{
+		if(i!=largest)
+			q.mRotation[j++] = quantizeValue(components[i] * sign, quantizer.mRotationScale, quantizer.mRotationBits);
+	}
+
+	if(q.mFlags)
+	{
+		for(PxU32 i=0;i<6;i++)
+			q.mVelocity[i] = 0;
+	}
+	else
+	{
+		for(PxU32 i=0;i<3;i++)
+		{
+			q.mVelocity[i] = quantizeValue(state.mLinVel[i], quantizer.mVelocityScale, quantizer.mVelocityBits);
+			q.mVelocity[i+3] = quantizeValue(state.mAngVel[i], quantizer.mVelocityScale, quantizer.mVelocityBits);
+		}
+	}
+}
+
+static bool isEqual(const QuantizedBody& a, const QuantizedBody& b)
+{
+	if(a.mFlags != b.mFlags || a.mLargest != b.mLargest)
+		return false;
+	for(PxU32 i=0;i<3;i++)
+	{
+		if(a.mPosition[i] != b.mPosition[i] || a.mRotation[i] != b.mRotation[i])
+			return false;
+	}
+	for(PxU32 i=0;i<6;i++)
+	{
+		if(a.mVelocity[i] != b.mVelocity[i])
+			return false;
+	}
+	return true;
+}
+
+static PX_FORCE_INLINE PxU32 computeIndexBits(PxU32 nbBodies)
+{
+	return nbBodies>1 ? PxHighestSetBit(nbBodies-1) + 1 : 1;
+}
+
+PxU32 SceneSnapshotInternal::computeDiff(const PxArray<PxU8>& base, const PxSceneDiffParams& params)
+{
+	mDiff.clear();
+	if(!params.isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxSceneSnapshot::computeDiff: invalid parameters.");
+		return 0;
+	}
+	if(!mData.size())
+		return 0;
+
+	const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(mData.begin());
+	const BodyState* states = reinterpret_cast<const BodyState*>(mData.begin() + sizeof(SnapshotHeader));
+	const PxU32 nbBodies = header->mNbBodies;
+
+	// PT: without a matching base every body is sent
+	const BodyState* baseStates = NULL;
+	if(base.size())
+	{
+		const SnapshotHeader* baseHeader = reinterpret_cast<const SnapshotHeader*>(base.begin());
+		if(baseHeader->mNbBodies == nbBodies)
+			baseStates = reinterpret_cast<const BodyState*>(base.begin() + sizeof(SnapshotHeader));
+	}
+
+	const Quantizer quantizer(params.positionPrecision, params.positionBits, params.rotationBits, params.velocityPrecision, params.velocityBits);
+	const PxU32 indexBits = computeIndexBits(nbBodies);
+	const PxU32 nbHeaderWords = sizeof(DiffHeader)/sizeof(PxU32);
+	mDiff.resize(nbHeaderWords, 0);
+
+	BitWriter writer(mDiff);
+	PxU32 nbChanged = 0;
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		QuantizedBody q;
+		quantizeBody(q, states[i], quantizer);
+		if(baseStates)
+		{
+			QuantizedBody baseQ;
+			quantizeBody(baseQ, baseStates[i], quantizer);
+			if(isEqual(q, baseQ))
+				continue;
+		}
+
+		nbChanged++;
+		writer.write(i, indexBits);
+		writer.write(q.mFlags, 2);
+		for(PxU32 j=0;j<3;j++)
+			writer.write(PxU32(q.mPosition[j]), quantizer.mPositionBits);
+		writer.write(q.mLargest, 2);
+		for(PxU32 j=0;j<3;j++)
+			writer.write(PxU32(q.mRotation[j]), quantizer.mRotationBits);
+		if(!q.mFlags)
+		{
+			for(PxU32 j=0;j<6;j++)
+				writer.write(PxU32(q.mVelocity[j]), quantizer.mVelocityBits);
+		}
+	}
+	writer.flush();
+
+	DiffHeader* diffHeader = reinterpret_cast<DiffHeader*>(mDiff.begin());
+	diffHeader->mMagic				= DIFF_MAGIC;
+	diffHeader->mVersion			= DIFF_VERSION;
+	diffHeader->mNbBodies			= nbBodies;
+	diffHeader->mNbChanged			= nbChanged;
+	diffHeader->mPositionPrecision	= params.positionPrecision;
+	diffHeader->mPositionBits		= params.positionBits;
+	diffHeader->mRotationBits		= params.rotationBits;
+	diffHeader->mVelocityPrecision	= params.velocityPrecision;
+	diffHeader->mVelocityBits		= params.velocityBits;
+	diffHeader->mNbWords			= mDiff.size() - nbHeaderWords;
+
+	return mDiff.size() * sizeof(PxU32);
+}
+
+bool SceneSnapshotInternal::applyDiff(const void* diff, PxU32 size)
+{
+	if(!diff || size < sizeof(DiffHeader) || (size_t(diff)&3))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxSceneSnapshot::applyDiff: invalid or misaligned diff data.");
+
+	const DiffHeader* header = reinterpret_cast<const DiffHeader*>(diff);
+	PxSceneDiffParams params;
+	params.positionPrecision	= header->mPositionPrecision;
+	params.positionBits			= header->mPositionBits;
+	params.rotationBits			= header->mRotationBits;
+	params.velocityPrecision	= header->mVelocityPrecision;
+	params.velocityBits			= header->mVelocityBits;
+	if(header->mMagic != DIFF_MAGIC || header->mVersion != DIFF_VERSION || !params.isValid()
+		|| PxU64(header->mNbWords) * sizeof(PxU32) != PxU64(size - sizeof(DiffHeader)))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxSceneSnapshot::applyDiff: invalid diff data.");
+
+	fetchObjects();
+	const PxU32 nbBodies = mBodies.size();
+	if(header->mNbBodies != nbBodies)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PxSceneSnapshot::applyDiff: diff does not match the objects in the scene.");
+
+	const PxReal positionScale = params.positionPrecision;
+	const PxReal rotationScale = 1.0f / (PxReal((1<<(params.rotationBits-1))-1) * PxSqrt2);
+	const PxReal velocityScale = params.velocityPrecision;
+	const PxU32 indexBits = computeIndexBits(nbBodies);
+
+	BitReader reader(reinterpret_cast<const PxU32*>(header + 1), header->mNbWords);
+	const PxU32 nbChanged = header->mNbChanged;
+	for(PxU32 i=0;i<nbChanged;i++)
+	{
+		const PxU32 index = reader.read(indexBits);
+		const PxU32 flags = reader.read(2);
+
+		PxVec3 position;
+		for(PxU32 j=0;j<3;j++)
+			position[j] = PxReal(reader.readSigned(params.positionBits)) * positionScale;
+
+		const PxU32 largest = reader.read(2);
+		PxReal components[4];
+		PxReal sumSquares = 0.0f;
+		for(PxU32 j=0;j<4;j++)
+		{
+			if(j==largest)
+				continue;
+			components[j] = PxReal(reader.readSigned(params.rotationBits)) * rotationScale;
+			sumSquares += components[j] * components[j];
+		}
+		components[largest] = PxSqrt(PxMax(0.0f, 1.0f - sumSquares));
+		const PxQuat rotation = PxQuat(components[0], components[1], components[2], components[3]).getNormalized();
+
+		PxVec3 linVel(0.0f), angVel(0.0f);
+		if(!flags)
+		{
+			for(PxU32 j=0;j<3;j++)
+				linVel[j] = PxReal(reader.readSigned(params.velocityBits)) * velocityScale;
+			for(PxU32 j=0;j<3;j++)
+				angVel[j] = PxReal(reader.readSigned(params.velocityBits)) * velocityScale;
+		}
+
+		if(reader.mOverrun || index >= nbBodies)
+			return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxSceneSnapshot::applyDiff: invalid diff data.");
+
+		PxRigidDynamic* body = static_cast<PxRigidDynamic*>(mBodies[index]);
+		body->setGlobalPose(PxTransform(position, rotation), false);
+
+		if((flags & ePOSE_ONLY) || (body->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC) || (body->getActorFlags() & PxActorFlag::eDISABLE_SIMULATION))
+			continue;
+
+		if(flags & eSLEEPING)
+		{
+			if(!body->isSleeping())
+				body->putToSleep();
+		}
+		else
+		{
+			body->setLinearVelocity(linVel, false);
+			body->setAngularVelocity(angVel, false);
+			body->wakeUp();
+		}
+	}
+	return true;
+}
+
+PxSceneSnapshot::PxSceneSnapshot(PxScene& scene)
+{
+	mImpl = new SceneSnapshotInternal(scene);
+}
+
+PxSceneSnapshot::~PxSceneSnapshot()
+{
+	delete mImpl;
+}
+
+PxU32 PxSceneSnapshot::capture()
+{
+	return mImpl->capture();
+}
+
+const void* PxSceneSnapshot::getData(PxU32& size) const
+{
+	size = mImpl->mData.size();
+	return size ? mImpl->mData.begin() : NULL;
+}
+
+bool PxSceneSnapshot::setData(const void* data, PxU32 size)
+{
+	return mImpl->setData(data, size);
+}
+
+bool PxSceneSnapshot::restore()
+{
+	return mImpl->restore();
+}
+
+PxU32 PxSceneSnapshot::computeDiff(const PxSceneSnapshot& base, const PxSceneDiffParams& params)
+{
+	return mImpl->computeDiff(base.mImpl->mData, params);
+}
+
+PxU32 PxSceneSnapshot::captureDiff(const PxSceneDiffParams& params)
+{
+	mImpl->mPreviousData.swap(mImpl->mData);
+	mImpl->capture();
+	return mImpl->computeDiff(mImpl->mPreviousData, params);
+}
+
+const void* PxSceneSnapshot::getDiff(PxU32& size) const
+{
+	size = mImpl->mDiff.size() * sizeof(PxU32);
+	return size ? mImpl->mDiff.begin() : NULL;
+}
+
+bool PxSceneSnapshot::applyDiff(const void* diff, PxU32 size)
+{
+	return mImpl->applyDiff(diff, size);
+}
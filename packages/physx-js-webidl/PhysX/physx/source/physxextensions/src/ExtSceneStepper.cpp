@@ -0,0 +1,213 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxSceneStepper.h"
+#include "PxScene.h"
+#include "PxRigidActor.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMathUtils.h"
+
+using namespace physx;
+
+namespace physx
+{
+class SceneStepperInternal
+{
+	PX_NOCOPY(SceneStepperInternal)
+	public:
+				SceneStepperInternal(PxScene& scene, PxReal stepSize, PxU32 maxNbSubsteps) :
+					mScene(scene), mStepSize(stepSize), mMaxNbSubsteps(maxNbSubsteps), mAccumulator(0.0f), mStepIndex(0), mAdvanceIndex(0)	{}
+				~SceneStepperInternal()	{}
+
+		PxU32	advance(PxReal elapsedTime);
+		void	recordActiveActors();
+
+		struct ActorState
+		{
+			PxTransform	mPrevious;		// Pose at the end of the previous sub-step
+			PxTransform	mCurrent;		// Pose at the end of the last sub-step in which the actor was active
+			PxU32		mStepIndex;		// Last sub-step in which the actor was active, 0 if never seen
+			PxU32		mAdvanceIndex;	// Last advance() call in which the actor has been added to mMovedActors
+		};
+
+		PxScene&			mScene;
+		const PxReal		mStepSize;
+		const PxU32			mMaxNbSubsteps;
+		PxReal				mAccumulator;
+		PxU32				mStepIndex;
+		PxU32				mAdvanceIndex;
+		PxArray<ActorState>	mStates;		// Indexed by user index
+		PxArray<PxU32>		mMovedActors;	// User indices of actors to report for the last advance() call
+		PxArray<PxU32>		mLastStepActors;	// User indices of actors active in the last sub-step
+};
+}
+
+void SceneStepperInternal::recordActiveActors()
+{
+	mLastStepActors.forceSize_Unsafe(0);
+
+	PxU32 nbActors = 0;
+	PxActor** actors = mScene.getActiveActors(nbActors);
+	for(PxU32 i=0; i<nbActors; i++)
+	{
+		const PxRigidActor* rigidActor = actors[i]->is<PxRigidActor>();
+		if(!rigidActor)
+			continue;
+
+		const PxU32 userIndex = PxU32(size_t(rigidActor->userData));
+		if(userIndex >= mStates.size())
+		{
+			ActorState newState;
+			newState.mStepIndex = 0;
+			newState.mAdvanceIndex = 0;
+			mStates.resize(userIndex + 1, newState);
+		}
+
+		ActorState& state = mStates[userIndex];
+		const PxTransform pose = rigidActor->getGlobalPose();
+
+		// PT: if the actor was not active in the previous sub-step its pose did not change, so mCurrent is still valid
+		state.mPrevious = state.mStepIndex ? state.mCurrent : pose;
+		state.mCurrent = pose;
+		state.mStepIndex = mStepIndex;
+
+		if(state.mAdvanceIndex != mAdvanceIndex)
+		{
+			state.mAdvanceIndex = mAdvanceIndex;
+			mMovedActors.pushBack(userIndex);
+		}
+		mLastStepActors.pushBack(userIndex);
+	}
+}
+
+PxU32 SceneStepperInternal::advance(PxReal elapsedTime)
+{
+	mAccumulator += elapsedTime;
+
+	PxU32 nbSubsteps = PxU32(mAccumulator / mStepSize);
+	if(!nbSubsteps)
+		return 0;
+
+	if(nbSubsteps > mMaxNbSubsteps)
+	{
+		// PT: drop the time we can't simulate, but keep the fraction used for interpolation
+		mAccumulator -= PxFloor(mAccumulator / mStepSize) * mStepSize;
+		nbSubsteps = mMaxNbSubsteps;
+	}
+	else
+		mAccumulator -= PxReal(nbSubsteps) * mStepSize;
+
+	mAdvanceIndex++;
+	mMovedActors.forceSize_Unsafe(0);
+
+	// PT: actors that moved in the last sub-step of the previous call were reported with an interpolated pose. We
+	// report them again so that users get their final pose, even if they don't move anymore.
+	const PxU32 nbLastStepActors = mLastStepActors.size();
+	for(PxU32 i=0; i<nbLastStepActors; i++)
+	{
+		const PxU32 userIndex = mLastStepActors[i];
+		mStates[userIndex].mAdvanceIndex = mAdvanceIndex;
+		mMovedActors.pushBack(userIndex);
+	}
+
+	for(PxU32 i=0; i<nbSubsteps; i++)
+	{
+		mStepIndex++;
+		mScene.simulate(mStepSize);
+		mScene.fetchResults(true);
+		recordActiveActors();
+	}
+	return nbSubsteps;
+}
+
+PxSceneStepper::PxSceneStepper(PxScene& scene, PxReal stepSize, PxU32 maxNbSubsteps)
+{
+	PX_ASSERT(stepSize > 0.0f);
+	PX_ASSERT(maxNbSubsteps > 0);
+	mImpl = new SceneStepperInternal(scene, stepSize, maxNbSubsteps);
+}
+
+PxSceneStepper::~PxSceneStepper()
+{
+	delete mImpl;
+}
+
+PxU32 PxSceneStepper::advance(PxReal elapsedTime)
+{
+	PX_CHECK_AND_RETURN_VAL(elapsedTime >= 0.0f, "PxSceneStepper::advance: elapsedTime must be positive", 0);
+	return mImpl->advance(elapsedTime);
+}
+
+PxReal PxSceneStepper::getInterpolationFactor() const
+{
+	return PxMin(mImpl->mAccumulator / mImpl->mStepSize, 1.0f);
+}
+
+PxU32 PxSceneStepper::getNbMovedActors() const
+{
+	return mImpl->mMovedActors.size();
+}
+
+PxU32 PxSceneStepper::getTransforms(PxActiveActorTransform* simulated, PxActiveActorTransform* interpolated, PxU32 bufferSize, PxU32 startIndex) const
+{
+	const PxU32 nbMovedActors = mImpl->mMovedActors.size();
+	if(startIndex >= nbMovedActors)
+		return 0;
+
+	const PxReal t = getInterpolationFactor();
+	const PxU32 lastStepIndex = mImpl->mStepIndex;
+
+	const PxU32 nbToWrite = PxMin(nbMovedActors - startIndex, bufferSize);
+	for(PxU32 i=0; i<nbToWrite; i++)
+	{
+		const PxU32 userIndex = mImpl->mMovedActors[startIndex + i];
+		const SceneStepperInternal::ActorState& state = mImpl->mStates[userIndex];
+
+		if(simulated)
+		{
+			simulated[i].userIndex = userIndex;
+			simulated[i].p = state.mCurrent.p;
+			simulated[i].q = state.mCurrent.q;
+		}
+
+		if(interpolated)
+		{
+			interpolated[i].userIndex = userIndex;
+			if(state.mStepIndex == lastStepIndex)
+			{
+				interpolated[i].p = state.mPrevious.p + (state.mCurrent.p - state.mPrevious.p) * t;
+				interpolated[i].q = PxSlerp(t, state.mPrevious.q, state.mCurrent.q);
+			}
+			else
+			{
+				// PT: the actor did not move in the last sub-step
+				interpolated[i].p = state.mCurrent.p;
+				interpolated[i].q = state.mCurrent.q;
+			}
+		}
+	}
+	return nbToWrite;
+}
@@ -0,0 +1,287 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxShardedScene.h"
+#include "extensions/PxSimpleFactory.h"
+#include "PxPhysics.h"
+#include "PxScene.h"
+#include "PxSceneDesc.h"
+#include "PxRigidDynamic.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+
+using namespace physx;
+
+namespace physx
+{
+class ShardedSceneInternal
+{
+	PX_NOCOPY(ShardedSceneInternal)
+	public:
+				ShardedSceneInternal(PxPhysics& physics, const PxSceneDesc& desc, const PxBounds3* shardBounds, PxU32 nbShards, PxReal ghostMargin);
+				~ShardedSceneInternal();
+
+		bool	addActor(PxRigidDynamic& actor);
+		bool	removeActor(PxRigidDynamic& actor);
+		void	simulate(PxReal elapsedTime);
+
+		PxU32	findShard(const PxVec3& position, PxU32 defaultShard)	const;
+		void	updateActor(PxU32 index);
+		void	releaseGhost(PxU32 index, PxU32 shard);
+
+		struct ManagedActor
+		{
+			PxRigidDynamic*	mActor;
+			PxU32			mShard;
+		};
+
+		PxPhysics&							mPhysics;
+		PxArray<PxScene*>					mShards;
+		PxArray<PxBounds3>					mShardBounds;
+		const PxReal						mGhostMargin;
+		PxArray<ManagedActor>				mActors;
+		PxArray<PxRigidDynamic*>			mGhosts;		// mActors.size() * mShards.size() entries, NULL if the actor has no ghost in a shard
+		PxHashMap<const PxRigidDynamic*, PxU32>	mActorIndices;
+};
+}
+
+ShardedSceneInternal::ShardedSceneInternal(PxPhysics& physics, const PxSceneDesc& desc, const PxBounds3* shardBounds, PxU32 nbShards, PxReal ghostMargin) :
+	mPhysics		(physics),
+	mGhostMargin	(ghostMargin)
+{
+	mShards.reserve(nbShards);
+	mShardBounds.reserve(nbShards);
+	for(PxU32 i=0; i<nbShards; i++)
+	{
+		PxScene* scene = physics.createScene(desc);
+		if(!scene)
+			continue;
+		mShards.pushBack(scene);
+		mShardBounds.pushBack(shardBounds[i]);
+	}
+}
+
+ShardedSceneInternal::~ShardedSceneInternal()
+{
+	// PT: ghosts are owned by this object, managed actors are owned by the user
+	const PxU32 nbActors = mActors.size();
+	for(PxU32 i=0; i<nbActors; i++)
+	{
+		for(PxU32 j=0; j<mShards.size(); j++)
+			releaseGhost(i, j);
+		mShards[mActors[i].mShard]->removeActor(*mActors[i].mActor);
+	}
+
+	for(PxU32 i=0; i<mShards.size(); i++)
+		mShards[i]->release();
+}
+
+PxU32 ShardedSceneInternal::findShard(const PxVec3& position, PxU32 defaultShard) const
+{
+	// PT: most actors stay in their shard so we test it first
+	if(defaultShard < mShardBounds.size() && mShardBounds[defaultShard].contains(position))
+		return defaultShard;
+
+	const PxU32 nbShards = mShardBounds.size();
+	for(PxU32 i=0; i<nbShards; i++)
+	{
+		if(mShardBounds[i].contains(position))
+			return i;
+	}
+	return defaultShard;
+}
+
+void ShardedSceneInternal::releaseGhost(PxU32 index, PxU32 shard)
+{
+	PxRigidDynamic*& ghost = mGhosts[index * mShards.size() + shard];
+	if(ghost)
+	{
+		ghost->release();
+		ghost = NULL;
+	}
+}
+
+bool ShardedSceneInternal::addActor(PxRigidDynamic& actor)
+{
+	if(mShards.empty() || actor.getScene() || mActorIndices.find(&actor))
+		return false;
+
+	const PxU32 shard = findShard(actor.getGlobalPose().p, 0);
+	if(!mShards[shard]->addActor(actor))
+		return false;
+
+	const PxU32 index = mActors.size();
+	ManagedActor& managed = mActors.insert();
+	managed.mActor = &actor;
+	managed.mShard = shard;
+	mActorIndices.insert(&actor, index);
+
+	for(PxU32 i=0; i<mShards.size(); i++)
+		mGhosts.pushBack(NULL);
+
+	updateActor(index);
+	return true;
+}
+
+bool ShardedSceneInternal::removeActor(PxRigidDynamic& actor)
+{
+	const PxHashMap<const PxRigidDynamic*, PxU32>::Entry* entry = mActorIndices.find(&actor);
+	if(!entry)
+		return false;
+
+	const PxU32 index = entry->second;
+	const PxU32 nbShards = mShards.size();
+	for(PxU32 i=0; i<nbShards; i++)
+		releaseGhost(index, i);
+	mShards[mActors[index].mShard]->removeActor(actor);
+	mActorIndices.erase(&actor);
+
+	// PT: move the last actor and its ghosts to the free slot
+	const PxU32 lastIndex = mActors.size() - 1;
+	if(index != lastIndex)
+	{
+		mActors[index] = mActors[lastIndex];
+		for(PxU32 i=0; i<nbShards; i++)
+			mGhosts[index * nbShards + i] = mGhosts[lastIndex * nbShards + i];
+		mActorIndices[mActors[index].mActor] = index;
+	}
+	mActors.popBack();
+	mGhosts.forceSize_Unsafe(lastIndex * nbShards);
+	return true;
+}
+
+void ShardedSceneInternal::updateActor(PxU32 index)
+{
+	ManagedActor& managed = mActors[index];
+	PxRigidDynamic& actor = *managed.mActor;
+	const PxTransform pose = actor.getGlobalPose();
+	const PxU32 nbShards = mShards.size();
+
+	// Handoff
+	const PxU32 newShard = findShard(pose.p, managed.mShard);
+	if(newShard != managed.mShard)
+	{
+		// PT: the actor replaces its ghost in the new shard. Its velocities are kept through the remove/add sequence.
+		releaseGhost(index, newShard);
+		mShards[managed.mShard]->removeActor(actor, false);
+		mShards[newShard]->addActor(actor);
+		managed.mShard = newShard;
+	}
+
+	// Ghosts
+	if(actor.isSleeping())
+		return;
+
+	const PxBounds3 actorBounds = actor.getWorldBounds();
+	for(PxU32 i=0; i<nbShards; i++)
+	{
+		if(i == managed.mShard)
+			continue;
+
+		PxBounds3 ghostZone = mShardBounds[i];
+		ghostZone.fattenFast(mGhostMargin);
+
+		PxRigidDynamic*& ghost = mGhosts[index * nbShards + i];
+		if(!ghostZone.intersects(actorBounds))
+		{
+			releaseGhost(index, i);
+			continue;
+		}
+
+		if(!ghost)
+		{
+			ghost = PxCloneDynamic(mPhysics, pose, actor);
+			if(!ghost)
+				continue;
+			ghost->setRigidBodyFlag(PxRigidBodyFlag::eENABLE_CCD, false);
+			ghost->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, true);
+			ghost->userData = actor.userData;
+			mShards[i]->addActor(*ghost);
+		}
+		else
+		{
+			// PT: ghosts follow their owner with a one-step lag, since the owner's pose is only known after the step
+			ghost->setKinematicTarget(pose);
+		}
+	}
+}
+
+void ShardedSceneInternal::simulate(PxReal elapsedTime)
+{
+	// PT: all shards are started before waiting for any of them, so their tasks run concurrently on the dispatcher
+	const PxU32 nbShards = mShards.size();
+	for(PxU32 i=0; i<nbShards; i++)
+		mShards[i]->simulate(elapsedTime);
+
+	for(PxU32 i=0; i<nbShards; i++)
+		mShards[i]->fetchResults(true);
+
+	const PxU32 nbActors = mActors.size();
+	for(PxU32 i=0; i<nbActors; i++)
+		updateActor(i);
+}
+
+PxShardedScene::PxShardedScene(PxPhysics& physics, const PxSceneDesc& desc, const PxBounds3* shardBounds, PxU32 nbShards, PxReal ghostMargin)
+{
+	PX_ASSERT(shardBounds || !nbShards);
+	mImpl = new ShardedSceneInternal(physics, desc, shardBounds, nbShards, ghostMargin);
+}
+
+PxShardedScene::~PxShardedScene()
+{
+	delete mImpl;
+}
+
+PxU32 PxShardedScene::getNbShards() const
+{
+	return mImpl->mShards.size();
+}
+
+PxScene* PxShardedScene::getShard(PxU32 index) const
+{
+	return index < mImpl->mShards.size() ? mImpl->mShards[index] : NULL;
+}
+
+bool PxShardedScene::addActor(PxRigidDynamic& actor)
+{
+	return mImpl->addActor(actor);
+}
+
+bool PxShardedScene::removeActor(PxRigidDynamic& actor)
+{
+	return mImpl->removeActor(actor);
+}
+
+PxU32 PxShardedScene::getOwnerShard(const PxRigidDynamic& actor) const
+{
+	const PxHashMap<const PxRigidDynamic*, PxU32>::Entry* entry = mImpl->mActorIndices.find(&actor);
+	return entry ? mImpl->mActors[entry->second].mShard : PX_INVALID_U32;
+}
+
+void PxShardedScene::simulate(PxReal elapsedTime)
+{
+	mImpl->simulate(elapsedTime);
+}
@@ -0,0 +1,130 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxSimulationEventStream.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxUserAllocated.h"
+
+using namespace physx;
+
+namespace physx
+{
+	class SimulationEventStreamInternal : public PxUserAllocated
+	{
+		PX_NOCOPY(SimulationEventStreamInternal)
+		public:
+			SimulationEventStreamInternal(PxSimulationEventCallback* forward) : mForward(forward)	{}
+
+			PxSimulationEventCallback*			mForward;
+			PxArray<PxContactReportRecord>		mContacts;
+			PxArray<PxConstraintBreakRecord>	mConstraintBreaks;
+	};
+}
+
+PxSimulationEventStream::PxSimulationEventStream(PxSimulationEventCallback* forward)
+{
+	mImpl = PX_NEW(SimulationEventStreamInternal)(forward);
+}
+
+PxSimulationEventStream::~PxSimulationEventStream()
+{
+	PX_DELETE(mImpl);
+}
+
+const PxContactReportRecord* PxSimulationEventStream::getContactReports() const
+{
+	return mImpl->mContacts.begin();
+}
+
+PxU32 PxSimulationEventStream::getNbContactReports() const
+{
+	return mImpl->mContacts.size();
+}
+
+const PxConstraintBreakRecord* PxSimulationEventStream::getConstraintBreaks() const
+{
+	return mImpl->mConstraintBreaks.begin();
+}
+
+PxU32 PxSimulationEventStream::getNbConstraintBreaks() const
+{
+	return mImpl->mConstraintBreaks.size();
+}
+
+void PxSimulationEventStream::clear()
+{
+	mImpl->mContacts.clear();
+	mImpl->mConstraintBreaks.clear();
+}
+
+void PxSimulationEventStream::onConstraintBreak(PxConstraintInfo* constraints, PxU32 count)
+{
+	PxArray<PxConstraintBreakRecord>& records = mImpl->mConstraintBreaks;
+	const PxU32 offset = records.size();
+	records.resizeUninitialized(offset + count);
+	PxSceneExt::getConstraintBreakReports(constraints, count, records.begin() + offset, count);
+
+	if(mImpl->mForward)
+		mImpl->mForward->onConstraintBreak(constraints, count);
+}
+
+void PxSimulationEventStream::onContact(const PxContactPairHeader& pairHeader, const PxContactPair* pairs, PxU32 nbPairs)
+{
+	PX_UNUSED(pairs);
+	PX_ASSERT(pairHeader.pairs == pairs && pairHeader.nbPairs == nbPairs);
+
+	PxArray<PxContactReportRecord>& records = mImpl->mContacts;
+	const PxU32 offset = records.size();
+	records.resizeUninitialized(offset + nbPairs);
+	PxSceneExt::getContactReports(&pairHeader, 1, records.begin() + offset, nbPairs);
+
+	if(mImpl->mForward)
+		mImpl->mForward->onContact(pairHeader, pairs, nbPairs);
+}
+
+void PxSimulationEventStream::onWake(PxActor** actors, PxU32 count)
+{
+	if(mImpl->mForward)
+		mImpl->mForward->onWake(actors, count);
+}
+
+void PxSimulationEventStream::onSleep(PxActor** actors, PxU32 count)
+{
+	if(mImpl->mForward)
+		mImpl->mForward->onSleep(actors, count);
+}
+
+void PxSimulationEventStream::onTrigger(PxTriggerPair* pairs, PxU32 count)
+{
+	if(mImpl->mForward)
+		mImpl->mForward->onTrigger(pairs, count);
+}
+
+void PxSimulationEventStream::onAdvance(const PxRigidBody*const* bodyBuffer, const PxTransform* poseBuffer, const PxU32 count)
+{
+	if(mImpl->mForward)
+		mImpl->mForward->onAdvance(bodyBuffer, poseBuffer, count);
+}
@@ -58,7 +58,8 @@ ExtPrunerManager::ExtPrunerManager(PxU64 contextID, float inflation, const Adapt
 	mInflation				(inflation),
 	mPrunerNeedsUpdating	(false),
 	mTimestampNeedsUpdating	(false),
-	mUsesTreeOfPruners		(usesTreeOfPruners)
+	mUsesTreeOfPruners		(usesTreeOfPruners),
+	mQueryStatsEnabled		(false)
 {
 	mCompoundPrunerExt.mPruner = createCompoundPruner(contextID);
 }
@@ -83,9 +84,19 @@ PxU32 ExtPrunerManager::addPruner(Pruner* pruner, PxU32 preallocated)
 	if(preallocated)
 		pe->preallocate(preallocated);
 	mPrunerExt.pushBack(pe);
+
+	PxPrunerQueryStats stats;
+	PxMemZero(&stats, sizeof(PxPrunerQueryStats));
+	mQueryStats.pushBack(stats);
 	return index;
 }
 
+void ExtPrunerManager::resetQueryStats()
+{
+	if(mQueryStats.size())
+		PxMemZero(mQueryStats.begin(), sizeof(PxPrunerQueryStats)*mQueryStats.size());
+}
+
 void ExtPrunerManager::preallocate(PxU32 prunerIndex, PxU32 nbShapes)
 {
 	const bool preallocateCompoundPruner = prunerIndex==0xffffffff;
@@ -46,6 +46,7 @@ namespace Sq
 }
 
 #include "foundation/PxMutex.h"
+#include "extensions/PxCustomSceneQuerySystem.h"
 
 namespace physx
 {
@@ -81,6 +82,13 @@ namespace Sq
 		PX_FORCE_INLINE	const CompoundPruner*			getCompoundPruner()							const	{ return mCompoundPrunerExt.mPruner;	}
 		PX_FORCE_INLINE	PxU64							getContextId()								const	{ return mContextID;					}
 
+		// PT: per-pruner query statistics. Returns NULL when they are disabled, so that queries can skip the counting.
+		PX_FORCE_INLINE	PxPrunerQueryStats*				getQueryStats(PxU32 index)					const	{ return mQueryStatsEnabled ? &mQueryStats[index] : NULL;	}
+		PX_FORCE_INLINE	const PxPrunerQueryStats&		getAccumulatedQueryStats(PxU32 index)		const	{ return mQueryStats[index];			}
+		PX_FORCE_INLINE	void							setQueryStatsEnabled(bool enabled)					{ mQueryStatsEnabled = enabled;			}
+		PX_FORCE_INLINE	bool							getQueryStatsEnabled()						const	{ return mQueryStatsEnabled;			}
+						void							resetQueryStats();
+
 						void							preallocate(PxU32 prunerIndex, PxU32 nbShapes);
 
 						void							setDynamicTreeRebuildRateHint(PxU32 dynTreeRebuildRateHint);
@@ -113,6 +121,7 @@ namespace Sq
 	private:
 						const Adapter&					mAdapter;
 						PxArray<PrunerExt*>				mPrunerExt;
+		mutable			PxArray<PxPrunerQueryStats>		mQueryStats;	// One per pruner, written by (const) queries
 						CompoundPrunerExt				mCompoundPrunerExt;
 
 						Gu::BVH*						mTreeOfPruners;
@@ -127,6 +136,7 @@ namespace Sq
 						volatile bool					mPrunerNeedsUpdating;
 						volatile bool					mTimestampNeedsUpdating;
 						const bool						mUsesTreeOfPruners;
+						bool							mQueryStatsEnabled;
 
 						void							flushShapes();
 		PX_FORCE_INLINE void							invalidateStaticTimestamp()		{ mStaticTimestamp++;		}
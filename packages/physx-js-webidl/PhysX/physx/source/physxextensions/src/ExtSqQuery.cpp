@@ -33,10 +33,13 @@ using namespace Sq;
 
 #include "common/PxProfileZone.h"
 #include "foundation/PxFPU.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxInlineArray.h"
 #include "GuBounds.h"
 #include "GuIntersectionRayBox.h"
 #include "GuIntersectionRay.h"
 #include "GuBVH.h"
+#include "GuCallbackAdapter.h"
 #include "geometry/PxGeometryQuery.h"
 #include "geometry/PxSphereGeometry.h"
 #include "geometry/PxBoxGeometry.h"
@@ -141,6 +144,8 @@ namespace physx
 		const PxGeometry* geometry; // only valid for overlaps and sweeps
 		const PxTransform* pose; // only valid for overlaps and sweeps
 		PxReal inflation; // only valid for sweeps
+		const PxPlane* planes; // only valid for culling queries, which are overlaps without a geometry
+		PxU32 nbPlanes; // only valid for culling queries
 
 		// Raycast constructor
 		ExtMultiQueryInput(const PxVec3& aRayOrigin, const PxVec3& aUnitDir, PxReal aMaxDist)
@@ -151,6 +156,8 @@ namespace physx
 			geometry = NULL;
 			pose = NULL;
 			inflation = 0.0f;
+			planes = NULL;
+			nbPlanes = 0;
 		}
 
 		// Overlap constructor
@@ -160,6 +167,19 @@ namespace physx
 			pose = aPose;
 			inflation = 0.0f;
 			rayOrigin = unitDir = NULL;
+			planes = NULL;
+			nbPlanes = 0;
+		}
+
+		// Cull constructor
+		ExtMultiQueryInput(PxU32 aNbPlanes, const PxPlane* aPlanes)
+		{
+			geometry = NULL;
+			pose = NULL;
+			inflation = 0.0f;
+			rayOrigin = unitDir = NULL;
+			planes = aPlanes;
+			nbPlanes = aNbPlanes;
 		}
 
 		// Sweep constructor
@@ -173,6 +193,8 @@ namespace physx
 			geometry = aGeometry;
 			pose = aPose;
 			inflation = aInflation;
+			planes = NULL;
+			nbPlanes = 0;
 		}
 
 		PX_FORCE_INLINE const PxVec3& getDir() const { PX_ASSERT(unitDir); return *unitDir; }
@@ -438,6 +460,13 @@ struct ExtMultiQueryCallback : public PrunerRaycastCallback, public PrunerOverla
 	{
 	}
 
+	// PT: pruners call us either through the raycast or through the overlap interface, both share the same counters
+	PX_FORCE_INLINE	void	setQueryStats(PrunerQueryStats* stats)
+	{
+		PrunerRaycastCallback::mStats = stats;
+		PrunerOverlapCallback::mStats = stats;
+	}
+
 	bool processTouchHit(const HitType& hit, PxReal& aDist)
 #if PX_WINDOWS_FAMILY
 		PX_RESTRICT
@@ -571,10 +600,23 @@ struct ExtMultiQueryCallback : public PrunerRaycastCallback, public PrunerOverla
 		}
 
 		// call the geometry specific intersection template
-		const PxU32 nbSubHits = ExtGeomQueryAny<HitType>::geomHit(
-			mScene.mCachedFuncs, mInput, mShapeData, shapeGeom,
-			*shapeTransform, filteredHitFlags | mMeshAnyHitFlags,
-			maxSubHits1, subHits1, mShrunkDistance, mQueryShapeBounds, &mHitCall);
+		PxU32 nbSubHits;
+		if(HitTypeSupport<HitType>::IsOverlap && mInput.planes)
+		{
+			// PT: culling queries report the pruner-level results as-is, there is no exact per-shape test
+			subHits1[0].faceIndex = 0xffffffff;
+			nbSubHits = 1;
+		}
+		else
+		{
+			if(PrunerRaycastCallback::mStats)
+				PrunerRaycastCallback::mStats->mNbTests++;
+
+			nbSubHits = ExtGeomQueryAny<HitType>::geomHit(
+				mScene.mCachedFuncs, mInput, mShapeData, shapeGeom,
+				*shapeTransform, filteredHitFlags | mMeshAnyHitFlags,
+				maxSubHits1, subHits1, mShrunkDistance, mQueryShapeBounds, &mHitCall);
+		}
 
 		// ------------------------- iterate over geometry subhits -----------------------------------
 		for (PxU32 iSubHit = 0; iSubHit < nbSubHits; iSubHit++)
@@ -720,7 +762,7 @@ struct ExtCapturePvdOnReturn : public PxHitCallback<HitType>
 		// PT: TODO: why do we need reinterpret_casts below?
 		if(HitTypeSupport<HitType>::IsRaycast)
 			pvd->raycast(mInput.getOrigin(), mInput.getDir(), mInput.maxDistance, reinterpret_cast<PxRaycastHit*>(mAllHits.begin()), mAllHits.size(), mFilterData, this->maxNbTouches!=0);
-		else if(HitTypeSupport<HitType>::IsOverlap)
+		else if(HitTypeSupport<HitType>::IsOverlap && mInput.geometry)
 			pvd->overlap(*mInput.geometry, *mInput.pose, reinterpret_cast<PxOverlapHit*>(mAllHits.begin()), mAllHits.size(), mFilterData);
 		else if(HitTypeSupport<HitType>::IsSweep)
 			pvd->sweep	(*mInput.geometry, *mInput.pose, mInput.getDir(), mInput.maxDistance, reinterpret_cast<PxSweepHit*>(mAllHits.begin()), mAllHits.size(), mFilterData, this->maxNbTouches!=0);
@@ -793,6 +835,52 @@ static PX_FORCE_INLINE bool prunerFilter(const ExtQueryAdapter& adapter, PxU32 p
 }
 //~#MODIFIED
 
+static PX_FORCE_INLINE void atomicAdd(PxU32& counter, PxU32 value)
+{
+	if(value)
+		PxAtomicAdd(reinterpret_cast<volatile PxI32*>(&counter), PxI32(value));
+}
+
+// PT: gathers the traversal counters of a single pruner query, and adds them to the pruner's stats when the query is done.
+// Queries can run in parallel so the shared stats are updated with atomics, once per pruner query rather than once per node.
+template<typename HitType>
+struct ExtPrunerQueryRecorder
+{
+	PX_FORCE_INLINE	ExtPrunerQueryRecorder(const Sq::ExtPrunerManager& manager, PxU32 prunerIndex, ExtMultiQueryCallback<HitType>& pcb) :
+		mPCB		(pcb),
+		mCounters	(NULL)
+	{
+		PxPrunerQueryStats* stats = manager.getQueryStats(prunerIndex);
+		if(stats)
+		{
+			mCounters = HitTypeSupport<HitType>::IsRaycast ? &stats->raycasts : HitTypeSupport<HitType>::IsSweep ? &stats->sweeps : &stats->overlaps;
+			pcb.setQueryStats(&mStats);
+		}
+	}
+
+	PX_FORCE_INLINE	bool	finish(bool again)
+	{
+		if(mCounters)
+		{
+			mPCB.setQueryStats(NULL);
+			atomicAdd(mCounters->nbQueries, 1);
+			atomicAdd(mCounters->nbNodes, mStats.mNbNodes);
+			atomicAdd(mCounters->nbLeaves, mStats.mNbLeaves);
+			atomicAdd(mCounters->nbPrimitives, mStats.mNbPrims);
+			atomicAdd(mCounters->nbNarrowPhaseTests, mStats.mNbTests);
+			if(!again)
+				atomicAdd(mCounters->nbEarlyOuts, 1);
+		}
+		return again;
+	}
+
+	ExtMultiQueryCallback<HitType>&	mPCB;
+	PxPrunerQueryCounters*			mCounters;
+	PrunerQueryStats				mStats;
+
+	PX_NOCOPY(ExtPrunerQueryRecorder)
+};
+
 // PT: the following local callbacks are for the "tree of pruners"
 template<typename HitType>
 struct LocalBaseCallback
@@ -835,7 +923,8 @@ struct LocalRaycastCallback : LocalBaseCallback<HitType>, PxBVH::RaycastCallback
 		const Pruner* pruner = LocalBaseCallback<HitType>::filtering(boundsIndex);
 		if(!pruner)
 			return true;
-		return pruner->raycast(mInput.getOrigin(), mInput.getDir(), distance, this->mPCB);
+		ExtPrunerQueryRecorder<HitType> recorder(this->mSQManager, boundsIndex, this->mPCB);
+		return recorder.finish(pruner->raycast(mInput.getOrigin(), mInput.getDir(), distance, this->mPCB));
 	}
 
 	const ExtMultiQueryInput&	mInput;
@@ -854,7 +943,8 @@ struct LocalOverlapCallback : LocalBaseCallback<HitType>, PxBVH::OverlapCallback
 		const Pruner* pruner = LocalBaseCallback<HitType>::filtering(boundsIndex);
 		if(!pruner)
 			return true;
-		return pruner->overlap(mShapeData, this->mPCB);
+		ExtPrunerQueryRecorder<HitType> recorder(this->mSQManager, boundsIndex, this->mPCB);
+		return recorder.finish(pruner->overlap(mShapeData, this->mPCB));
 	}
 
 	const ShapeData&	mShapeData;
@@ -862,6 +952,26 @@ struct LocalOverlapCallback : LocalBaseCallback<HitType>, PxBVH::OverlapCallback
 	PX_NOCOPY(LocalOverlapCallback)
 };
 
+template<typename HitType>
+struct LocalCullCallback : LocalBaseCallback<HitType>, PxBVH::OverlapCallback
+{
+	LocalCullCallback(const ExtMultiQueryInput& input, ExtMultiQueryCallback<HitType>& pcb, const Sq::ExtPrunerManager& manager, const ExtQueryAdapter& adapter, PxHitCallback<HitType>& hits, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall) :
+		LocalBaseCallback<HitType>(pcb, manager, adapter, hits, filterData, filterCall), mInput(input)	{}
+
+	virtual bool	reportHit(PxU32 boundsIndex)
+	{
+		const Pruner* pruner = LocalBaseCallback<HitType>::filtering(boundsIndex);
+		if(!pruner)
+			return true;
+		ExtPrunerQueryRecorder<HitType> recorder(this->mSQManager, boundsIndex, this->mPCB);
+		return recorder.finish(pruner->cull(mInput.nbPlanes, mInput.planes, this->mPCB));
+	}
+
+	const ExtMultiQueryInput&	mInput;
+
+	PX_NOCOPY(LocalCullCallback)
+};
+
 template<typename HitType>
 struct LocalSweepCallback : LocalBaseCallback<HitType>, PxBVH::RaycastCallback
 {
@@ -873,7 +983,8 @@ struct LocalSweepCallback : LocalBaseCallback<HitType>, PxBVH::RaycastCallback
 		const Pruner* pruner = LocalBaseCallback<HitType>::filtering(boundsIndex);
 		if(!pruner)
 			return true;
-		return pruner->sweep(mShapeData, mDir, distance, this->mPCB);
+		ExtPrunerQueryRecorder<HitType> recorder(this->mSQManager, boundsIndex, this->mPCB);
+		return recorder.finish(pruner->sweep(mShapeData, mDir, distance, this->mPCB));
 	}
 
 	const ShapeData&	mShapeData;
@@ -890,12 +1001,12 @@ bool ExtSceneQueries::multiQuery(
 {
 	const bool anyHit = (filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT;
 
-	if(HitTypeSupport<HitType>::IsRaycast == 0)
+	if(HitTypeSupport<HitType>::IsRaycast == 0 && !input.planes)
 	{
 		PX_CHECK_AND_RETURN_VAL(input.pose != NULL, "NpSceneQueries::overlap/sweep pose is NULL.", 0);
 		PX_CHECK_AND_RETURN_VAL(input.pose->isValid(), "NpSceneQueries::overlap/sweep pose is not valid.", 0);
 	}
-	else
+	else if(HitTypeSupport<HitType>::IsRaycast)	// PT: culling queries have neither a pose nor a ray
 	{
 		PX_CHECK_AND_RETURN_VAL(input.getOrigin().isFinite(), "NpSceneQueries::raycast pose is not valid.", 0);
 	}
@@ -987,7 +1098,8 @@ bool ExtSceneQueries::multiQuery(
 				if(prunerFilter(adapter, i, &hits, filterData, filterCall))
 				{
 					const Pruner* pruner = mSQManager.getPruner(i);
-					again = pruner->raycast(input.getOrigin(), input.getDir(), pcb.mShrunkDistance, pcb);
+					ExtPrunerQueryRecorder<HitType> recorder(mSQManager, i, pcb);
+					again = recorder.finish(pruner->raycast(input.getOrigin(), input.getDir(), pcb.mShrunkDistance, pcb));
 					if(!again)
 					{
 						cbr.again = again; // update the status to avoid duplicate processTouches()
@@ -1004,6 +1116,43 @@ bool ExtSceneQueries::multiQuery(
 		cbr.again = again; // update the status to avoid duplicate processTouches()
 		return hits.hasAnyHits();
 	}
+	else if(HitTypeSupport<HitType>::IsOverlap && input.planes)
+	{
+		bool again = true;
+		if(treeOfPruners)
+		{
+			LocalCullCallback<HitType> prunerCullCB(input, pcb, mSQManager, adapter, hits, filterData, filterCall);
+			again = treeOfPruners->cull(input.nbPlanes, input.planes, prunerCullCB, PxGeometryQueryFlag::Enum(0));
+			if(!again)
+			{
+				cbr.again = again; // update the status to avoid duplicate processTouches()
+				return hits.hasAnyHits();
+			}
+		}
+		else
+		{
+			for(PxU32 i=0;i<nbPruners;i++)
+			{
+				if(prunerFilter(adapter, i, &hits, filterData, filterCall))
+				{
+					const Pruner* pruner = mSQManager.getPruner(i);
+					ExtPrunerQueryRecorder<HitType> recorder(mSQManager, i, pcb);
+					again = recorder.finish(pruner->cull(input.nbPlanes, input.planes, pcb));
+					if(!again)
+					{
+						cbr.again = again; // update the status to avoid duplicate processTouches()
+						return hits.hasAnyHits();
+					}
+				}
+			}
+		}
+
+		if(again && compoundPruner)
+			again = compoundPruner->cull(input.nbPlanes, input.planes, pcb, compoundPrunerQueryFlags);
+
+		cbr.again = again; // update the status to avoid duplicate processTouches()
+		return hits.hasAnyHits();
+	}
 	else if(HitTypeSupport<HitType>::IsOverlap)
 	{
 		PX_ASSERT(input.geometry);
@@ -1030,7 +1179,8 @@ bool ExtSceneQueries::multiQuery(
 				if(prunerFilter(adapter, i, &hits, filterData, filterCall))
 				{
 					const Pruner* pruner = mSQManager.getPruner(i);
-					again = pruner->overlap(sd, pcb);
+					ExtPrunerQueryRecorder<HitType> recorder(mSQManager, i, pcb);
+					again = recorder.finish(pruner->overlap(sd, pcb));
 					if(!again)
 					{
 						cbr.again = again; // update the status to avoid duplicate processTouches()
@@ -1075,7 +1225,8 @@ bool ExtSceneQueries::multiQuery(
 				if(prunerFilter(adapter, i, &hits, filterData, filterCall))
 				{
 					const Pruner* pruner = mSQManager.getPruner(i);
-					again = pruner->sweep(sd, input.getDir(), pcb.mShrunkDistance, pcb);
+					ExtPrunerQueryRecorder<HitType> recorder(mSQManager, i, pcb);
+					again = recorder.finish(pruner->sweep(sd, input.getDir(), pcb.mShrunkDistance, pcb));
 					if(!again)
 					{
 						cbr.again = again; // update the status to avoid duplicate processTouches()
@@ -1129,6 +1280,216 @@ bool ExtSceneQueries::_overlap(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool ExtSceneQueries::_cull(
+	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hits,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) const
+{
+	PX_PROFILE_ZONE("SceneQuery.cull", getContextId());
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	PX_CHECK_AND_RETURN_VAL(planes, "PxScene::cull(): planes is NULL.", false);
+	PX_CHECK_AND_RETURN_VAL(nbPlanes && nbPlanes<=32, "PxScene::cull(): nbPlanes must be between 1 and 32.", false);
+
+	ExtMultiQueryInput input(nbPlanes, planes);
+	return multiQuery<PxOverlapHit>(input, hits, PxHitFlags(), NULL, filterData, filterCall);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	// PT: inline storage for the per-call buffers, so that typical batches run without heap allocations
+	#define SPHERES_INLINE_SIZE	64
+	typedef PxInlineArray<PxVec4, SPHERES_INLINE_SIZE>	SphereArray;
+	typedef PxInlineArray<PxU32, 128>					QueryIndexArray;
+	typedef PxInlineArray<PxOverlapHit, 128>			OverlapHitArray;
+
+	// PT: collects the results of batched sphere queries. Pruners report (sphere, object) pairs whose bounds overlap,
+	// and this runs the filtering and the exact sphere-vs-shape test for each of them.
+	struct SpheresQueryCallback : public PrunerBatchOverlapCallback, public CompoundPrunerOverlapCallback
+	{
+		const ExtSceneQueries&			mScene;
+		const ExtQueryAdapter&			mAdapter;
+		const PxVec4*				mSpheres;
+		const PxQueryFilterData&	mFilterData;
+		PxQueryFilterCallback*		mFilterCall;
+		QueryIndexArray&			mQueryIndices;
+		OverlapHitArray&			mHits;
+		PxU32						mCurrentQuery;	// only used for compound pruners, which are queried one sphere at a time
+		PxTransform					mCompoundShapeTransform;
+
+		SpheresQueryCallback(const ExtSceneQueries& scene, const PxVec4* spheres, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+							QueryIndexArray& queryIndices, OverlapHitArray& hits) :
+			mScene			(scene),
+			mAdapter		(static_cast<const ExtQueryAdapter&>(scene.mSQManager.getAdapter())),
+			mSpheres		(spheres),
+			mFilterData		(filterData),
+			mFilterCall		(filterCall),
+			mQueryIndices	(queryIndices),
+			mHits			(hits),
+			mCurrentQuery	(0)
+		{
+		}
+
+		bool report(PxU32 queryIndex, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms, const PxTransform* compoundPose)
+		{
+			const PrunerPayload& payload = payloads[primIndex];
+
+			PxActorShape actorShape;
+			mAdapter.getActorShape(payload, actorShape);
+
+			PxQueryHitType::Enum shapeHitType = PxQueryHitType::eTOUCH;
+			PxHitFlags hitFlags;
+			if(!applyAllPreFiltersSQ(mAdapter, payload, actorShape, shapeHitType, mFilterData.flags, mFilterData, mFilterCall, hitFlags))
+				return true;
+
+			const PxTransform* shapeTransform = transforms + primIndex;
+			if(compoundPose)
+			{
+				computeCompoundShapeTransform(&mCompoundShapeTransform, compoundPose, transforms, primIndex);
+				shapeTransform = &mCompoundShapeTransform;
+			}
+
+			const PxVec4& sphere = mSpheres[queryIndex];
+			const PxSphereGeometry sphereGeom(sphere.w);
+			if(!Gu::overlap(sphereGeom, PxTransform(sphere.getXYZ()), mAdapter.getGeometry(payload), *shapeTransform, mScene.mCachedFuncs.mCachedOverlapFuncs, NULL))
+				return true;
+
+			PxOverlapHit hit;
+			hit.actor = actorShape.actor;
+			hit.shape = actorShape.shape;
+			hit.faceIndex = 0xffffffff;
+			mHits.pushBack(hit);
+			mQueryIndices.pushBack(queryIndex);
+			return true;
+		}
+
+		virtual bool invoke(PxU32 queryIndex, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms)
+		{
+			return report(queryIndex, primIndex, payloads, transforms, NULL);
+		}
+
+		virtual bool invoke(PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms, const PxTransform* compoundPose)
+		{
+			return report(mCurrentQuery, primIndex, payloads, transforms, compoundPose);
+		}
+
+		PX_NOCOPY(SpheresQueryCallback)
+	};
+}
+
+// PT: builds the BVH over the query spheres shared by all pruners. Returns false if the BVH could not be built.
+static bool buildSphereBatch(PrunerSphereBatch& batch, BVHData& tree, SphereArray& spheres, PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii)
+{
+	spheres.resizeUninitialized(nbSpheres);
+	PxInlineArray<PxBounds3, SPHERES_INLINE_SIZE> bounds;
+	bounds.resizeUninitialized(nbSpheres);
+	for(PxU32 i=0;i<nbSpheres;i++)
+	{
+		spheres[i] = PxVec4(centers[i], radii[i]);
+		bounds[i] = PxBounds3::centerExtents(centers[i], PxVec3(radii[i]));
+	}
+
+	if(!tree.build(nbSpheres, bounds.begin(), sizeof(PxBounds3), 0.0f, 1, BVH_SPLATTER_POINTS))
+		return false;
+
+	batch.mSpheres = spheres.begin();
+	batch.mNodes = tree.mNodes;
+	batch.mIndices = tree.mIndices;
+	batch.mNbSpheres = nbSpheres;
+	return true;
+}
+
+// PT: sorts the results by query index into the user buffer
+static PxI32 writeSpheresQueryResults(PxU32 nbSpheres, const QueryIndexArray& queryIndices, const OverlapHitArray& results, PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery)
+{
+	PxMemZero(nbHitsPerQuery, sizeof(PxU32)*nbSpheres);
+	const PxU32 nbResults = results.size();
+	for(PxU32 i=0;i<nbResults;i++)
+		nbHitsPerQuery[queryIndices[i]]++;
+
+	if(nbResults>maxNbHits)
+		return -1;
+
+	PxInlineArray<PxU32, SPHERES_INLINE_SIZE> offsets;
+	offsets.resizeUninitialized(nbSpheres);
+	PxU32 offset = 0;
+	for(PxU32 i=0;i<nbSpheres;i++)
+	{
+		offsets[i] = offset;
+		offset += nbHitsPerQuery[i];
+	}
+
+	for(PxU32 i=0;i<nbResults;i++)
+		hits[offsets[queryIndices[i]]++] = results[i];
+
+	return PxI32(nbResults);
+}
+
+PxI32 ExtSceneQueries::_overlapSpheres(
+	PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,
+	PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) const
+{
+	PX_PROFILE_ZONE("SceneQuery.overlapSpheres", getContextId());
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	if(!nbSpheres)
+		return 0;
+
+	PX_CHECK_AND_RETURN_VAL(centers && radii, "PxScene::overlapSpheres(): centers and radii cannot be NULL.", -1);
+	PX_CHECK_AND_RETURN_VAL(nbHitsPerQuery, "PxScene::overlapSpheres(): nbHitsPerQuery cannot be NULL.", -1);
+	PX_CHECK_AND_RETURN_VAL(hits || !maxNbHits, "PxScene::overlapSpheres(): hits cannot be NULL.", -1);
+#if PX_CHECKED
+	for(PxU32 i=0;i<nbSpheres;i++)
+	{
+		PX_CHECK_AND_RETURN_VAL(centers[i].isFinite(), "PxScene::overlapSpheres(): sphere center is not valid.", -1);
+		PX_CHECK_AND_RETURN_VAL(PxIsFinite(radii[i]) && radii[i]>=0.0f, "PxScene::overlapSpheres(): sphere radius must be finite and positive.", -1);
+	}
+#endif
+
+	// PT: same as in multiQuery, see comments there
+	const_cast<ExtSceneQueries*>(this)->mSQManager.flushUpdates();
+
+	SphereArray spheres;
+	BVHData tree;
+	PrunerSphereBatch batch;
+	if(!buildSphereBatch(batch, tree, spheres, nbSpheres, centers, radii))
+		return -1;
+
+	QueryIndexArray queryIndices;
+	OverlapHitArray results;
+	SpheresQueryCallback pcb(*this, batch.mSpheres, filterData, filterCall, queryIndices, results);
+
+	const ExtQueryAdapter& adapter = static_cast<const ExtQueryAdapter&>(mSQManager.getAdapter());
+	const PxU32 nbPruners = mSQManager.getNbPruners();
+	const CompoundPruner* compoundPruner = mSQManager.getCompoundPruner();
+
+	// PT: the static / dynamic filtering is done per object in applyAllPreFiltersSQ. The tree of pruners isn't used here,
+	// since the first step of each pruner's traversal already rejects the whole pruner when no sphere touches it.
+	for(PxU32 i=0;i<nbPruners;i++)
+	{
+		if(prunerFilter(adapter, i, NULL, filterData, filterCall))
+			mSQManager.getPruner(i)->overlapSpheres(batch, pcb);
+	}
+
+	if(compoundPruner)
+	{
+		// PT: compound pruners don't support batched queries, we query them one sphere at a time
+		const PxCompoundPrunerQueryFlags compoundPrunerQueryFlags = convertFlags(filterData.flags);
+		for(PxU32 i=0;i<nbSpheres;i++)
+		{
+			const ShapeData sd(PxSphereGeometry(radii[i]), PxTransform(centers[i]), 0.0f);
+			pcb.mCurrentQuery = i;
+			compoundPruner->overlap(sd, pcb, compoundPrunerQueryFlags);
+		}
+	}
+
+	return writeSpheresQueryResults(nbSpheres, queryIndices, results, hits, maxNbHits, nbHitsPerQuery);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool ExtSceneQueries::_sweep(
 	const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, const PxReal distance,
 	PxHitCallback<PxSweepHit>& hits, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
@@ -117,6 +117,18 @@ namespace Sq
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags) const;
 
+						bool						_cull(
+														PxU32 nbPlanes, const PxPlane* planes,	// Culling volume
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const;
+
+						PxI32						_overlapSpheres(
+														PxU32 nbSpheres, const PxVec3* centers, const PxReal* radii,	// Query spheres
+														PxOverlapHit* hits, PxU32 maxNbHits, PxU32* nbHitsPerQuery,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const;
+
 		PX_FORCE_INLINE	PxU64						getContextId()			const	{ return mSQManager.getContextId();	}
 						Sq::ExtPrunerManager		mSQManager;
 		public:
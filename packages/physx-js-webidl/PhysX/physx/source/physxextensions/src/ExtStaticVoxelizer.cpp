@@ -0,0 +1,418 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxStaticVoxelizer.h"
+#include "extensions/PxParallelFor.h"
+#include "extensions/PxShapeExt.h"
+#include "geometry/PxGeometryHelpers.h"
+#include "geometry/PxGeometryQuery.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxUserAllocated.h"
+#include "PxScene.h"
+#include "PxSceneLock.h"
+#include "PxRigidStatic.h"
+
+using namespace physx;
+
+// PT: maximum number of triangles a column ray can cross in a mesh, for the parity test of solid voxelization
+#define VOXELIZER_MAX_RAY_HITS	64
+
+namespace
+{
+	struct VoxelShape
+	{
+		PxGeometryHolder	mGeometry;
+		PxTransform			mPose;
+		PxBounds3			mBounds;
+	};
+
+	PX_FORCE_INLINE PxU32 getVoxelCoord(PxReal x, PxU32 maxCoord)
+	{
+		return x <= 0.0f ? 0 : (x >= PxReal(maxCoord) ? maxCoord : PxU32(x));
+	}
+
+	bool isSupported(PxGeometryType::Enum type)
+	{
+		switch(type)
+		{
+			case PxGeometryType::eSPHERE:
+			case PxGeometryType::ePLANE:
+			case PxGeometryType::eCAPSULE:
+			case PxGeometryType::eBOX:
+			case PxGeometryType::eCONVEXCORE:
+			case PxGeometryType::eCONVEXMESH:
+			case PxGeometryType::eTRIANGLEMESH:
+			case PxGeometryType::eHEIGHTFIELD:
+			case PxGeometryType::eCUSTOM:
+				return true;
+			default:
+				return false;
+		}
+	}
+}
+
+namespace physx
+{
+class StaticVoxelizerInternal : public PxParallelForCallback, public PxUserAllocated
+{
+	PX_NOCOPY(StaticVoxelizerInternal)
+	public:
+				StaticVoxelizerInternal() : mOrigin(0.0f), mVoxelSize(1.0f), mNbX(0), mNbY(0), mNbZ(0), mSolid(false)	{}
+		virtual	~StaticVoxelizerInternal()	{}
+
+		PX_FORCE_INLINE	PxU32	getColumnIndex(PxU32 x, PxU32 z)	const	{ return z * mNbX + x;	}
+
+		void	gatherShapes(PxScene& scene, const PxStaticVoxelizerParams& params)
+		{
+			mShapes.clear();
+
+			PxSceneReadLock lock(scene);
+			const PxU32 nbActors = scene.getNbActors(PxActorTypeFlag::eRIGID_STATIC);
+			mActorBuffer.resizeUninitialized(nbActors);
+			scene.getActors(PxActorTypeFlag::eRIGID_STATIC, mActorBuffer.begin(), nbActors);
+
+			for(PxU32 i=0;i<nbActors;i++)
+			{
+				const PxRigidStatic* actor = static_cast<const PxRigidStatic*>(mActorBuffer[i]);
+				const PxU32 nbShapes = actor->getNbShapes();
+				mShapeBuffer.resizeUninitialized(nbShapes);
+				actor->getShapes(mShapeBuffer.begin(), nbShapes);
+
+				for(PxU32 j=0;j<nbShapes;j++)
+				{
+					const PxShape* shape = mShapeBuffer[j];
+					if(!(shape->getFlags() & params.shapeFlags) || !isSupported(shape->getGeometry().getType()))
+						continue;
+
+					VoxelShape voxelShape;
+					voxelShape.mGeometry.storeAny(shape->getGeometry());
+					voxelShape.mPose = PxShapeExt::getGlobalPose(*shape, *actor);
+					PxGeometryQuery::computeGeomBounds(voxelShape.mBounds, voxelShape.mGeometry.any(), voxelShape.mPose);
+					if(voxelShape.mBounds.intersects(params.region))
+						mShapes.pushBack(voxelShape);
+				}
+			}
+		}
+
+		// PT: each shape is binned in the columns overlapped by its bounds
+		void	binShapes()
+		{
+			const PxU32 nbColumns = mNbX * mNbZ;
+			const PxReal invVoxelSize = 1.0f / mVoxelSize;
+
+			mColumnShapeOffsets.resize(nbColumns + 1);
+			PxMemZero(mColumnShapeOffsets.begin(), sizeof(PxU32) * (nbColumns + 1));
+
+			mShapeRanges.resizeUninitialized(mShapes.size() * 4);
+			for(PxU32 pass=0;pass<2;pass++)
+			{
+				for(PxU32 i=0;i<mShapes.size();i++)
+				{
+					PxU32* range = &mShapeRanges[i*4];
+					if(!pass)
+					{
+						const PxBounds3& bounds = mShapes[i].mBounds;
+						range[0] = getVoxelCoord((bounds.minimum.x - mOrigin.x) * invVoxelSize, mNbX - 1);
+						range[1] = getVoxelCoord((bounds.maximum.x - mOrigin.x) * invVoxelSize, mNbX - 1);
+						range[2] = getVoxelCoord((bounds.minimum.z - mOrigin.z) * invVoxelSize, mNbZ - 1);
+						range[3] = getVoxelCoord((bounds.maximum.z - mOrigin.z) * invVoxelSize, mNbZ - 1);
+					}
+
+					for(PxU32 z=range[2];z<=range[3];z++)
+					{
+						for(PxU32 x=range[0];x<=range[1];x++)
+						{
+							const PxU32 column = getColumnIndex(x, z);
+							if(!pass)
+								mColumnShapeOffsets[column + 1]++;
+							else
+								mColumnShapes[mColumnShapeOffsets[column]++] = i;
+						}
+					}
+				}
+
+				if(!pass)
+				{
+					for(PxU32 i=0;i<nbColumns;i++)
+						mColumnShapeOffsets[i + 1] += mColumnShapeOffsets[i];
+					mColumnShapes.resizeUninitialized(mColumnShapeOffsets[nbColumns]);
+				}
+				else
+				{
+					// PT: the second pass moved each offset to the start of the next column
+					for(PxU32 i=nbColumns;i>0;i--)
+						mColumnShapeOffsets[i] = mColumnShapeOffsets[i - 1];
+					mColumnShapeOffsets[0] = 0;
+				}
+			}
+		}
+
+		// PT: marks the voxels between the y coordinates of two crossings of the column
+		PX_FORCE_INLINE	void	fillRange(PxU8* solid, PxReal y0, PxReal y1)	const
+		{
+			const PxReal invVoxelSize = 1.0f / mVoxelSize;
+			// PT: voxels whose center is inside the range
+			const PxReal start = PxCeil((y0 - mOrigin.y) * invVoxelSize - 0.5f);
+			const PxReal end = PxFloor((y1 - mOrigin.y) * invVoxelSize - 0.5f);
+			if(end < 0.0f || start > PxReal(mNbY - 1) || start > end)
+				return;
+			const PxU32 yStart = getVoxelCoord(start, mNbY - 1);
+			const PxU32 yEnd = getVoxelCoord(end, mNbY - 1);
+			PxMemSet(solid + yStart, 1, yEnd - yStart + 1);
+		}
+
+		void	fillInterior(PxU8* solid, const VoxelShape& shape, const PxVec3& columnCenter, PxGeomRaycastHit* hits, PxReal* distances)	const
+		{
+			const PxGeometry& geom = shape.mGeometry.any();
+			const PxReal height = shape.mBounds.maximum.y - shape.mBounds.minimum.y + 2.0f * mVoxelSize;
+			if(geom.getType() == PxGeometryType::eHEIGHTFIELD)
+			{
+				// PT: everything below the surface of a heightfield is solid
+				const PxVec3 origin(columnCenter.x, shape.mBounds.maximum.y + mVoxelSize, columnCenter.z);
+				if(PxGeometryQuery::raycast(origin, PxVec3(0.0f, -1.0f, 0.0f), geom, shape.mPose, height, PxHitFlag::ePOSITION, 1, hits))
+					fillRange(solid, mOrigin.y, hits[0].position.y);
+			}
+			else if(geom.getType() == PxGeometryType::eTRIANGLEMESH)
+			{
+				// PT: parity test along the column, the voxels between an entry and the next exit are inside the mesh
+				const PxVec3 origin(columnCenter.x, shape.mBounds.minimum.y - mVoxelSize, columnCenter.z);
+				const PxU32 nbHits = PxGeometryQuery::raycast(origin, PxVec3(0.0f, 1.0f, 0.0f), geom, shape.mPose, height,
+					PxHitFlag::eMESH_MULTIPLE | PxHitFlag::eMESH_BOTH_SIDES, VOXELIZER_MAX_RAY_HITS, hits);
+				if(nbHits < 2)
+					return;
+
+				for(PxU32 i=0;i<nbHits;i++)
+					distances[i] = hits[i].distance;
+				PxSort(distances, nbHits);
+
+				// PT: a ray going through a shared edge or vertex hits several triangles at the same distance
+				PxU32 nbCrossings = 1;
+				for(PxU32 i=1;i<nbHits;i++)
+				{
+					if(distances[i] - distances[nbCrossings - 1] > 1e-5f)
+						distances[nbCrossings++] = distances[i];
+				}
+
+				for(PxU32 i=0;i+1<nbCrossings;i+=2)
+					fillRange(solid, origin.y + distances[i], origin.y + distances[i + 1]);
+			}
+		}
+
+		void	voxelizeColumn(PxU32 x, PxU32 z, PxU8* solid, PxGeomRaycastHit* hits, PxReal* distances)	const
+		{
+			PxMemZero(solid, mNbY);
+
+			const PxReal halfSize = mVoxelSize * 0.5f;
+			const PxReal invVoxelSize = 1.0f / mVoxelSize;
+			const PxBoxGeometry voxel(halfSize, halfSize, halfSize);
+			const PxVec3 columnCenter = mOrigin + PxVec3((PxReal(x) + 0.5f) * mVoxelSize, 0.0f, (PxReal(z) + 0.5f) * mVoxelSize);
+
+			const PxU32 column = getColumnIndex(x, z);
+			for(PxU32 i=mColumnShapeOffsets[column];i<mColumnShapeOffsets[column + 1];i++)
+			{
+				const VoxelShape& shape = mShapes[mColumnShapes[i]];
+				const PxGeometry& geom = shape.mGeometry.any();
+
+				const PxU32 yMin = getVoxelCoord((shape.mBounds.minimum.y - mOrigin.y) * invVoxelSize, mNbY - 1);
+				const PxU32 yMax = getVoxelCoord((shape.mBounds.maximum.y - mOrigin.y) * invVoxelSize, mNbY - 1);
+				for(PxU32 y=yMin;y<=yMax;y++)
+				{
+					if(solid[y])
+						continue;
+					const PxVec3 center(columnCenter.x, mOrigin.y + (PxReal(y) + 0.5f) * mVoxelSize, columnCenter.z);
+					if(PxGeometryQuery::overlap(voxel, PxTransform(center), geom, shape.mPose))
+						solid[y] = 1;
+				}
+
+				if(mSolid)
+					fillInterior(solid, shape, columnCenter, hits, distances);
+			}
+		}
+
+		// PxParallelForCallback
+		virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+		{
+			// PT: per-call scratch, the callback runs concurrently on several threads
+			PxArray<PxU8> solid(mNbY);
+			PxGeomRaycastHit hits[VOXELIZER_MAX_RAY_HITS];
+			PxReal distances[VOXELIZER_MAX_RAY_HITS];
+
+			for(PxU32 z=startIndex;z<endIndex;z++)
+			{
+				PxArray<PxVoxelSpan>& rowSpans = mRowSpans[z];
+				rowSpans.clear();
+				for(PxU32 x=0;x<mNbX;x++)
+				{
+					voxelizeColumn(x, z, solid.begin(), hits, distances);
+
+					const PxU32 nbSpans = rowSpans.size();
+					PxU32 y = 0;
+					while(y<mNbY)
+					{
+						if(!solid[y])
+						{
+							y++;
+							continue;
+						}
+						PxVoxelSpan span;
+						span.start = PxU16(y);
+						while(y<mNbY && solid[y])
+							y++;
+						span.end = PxU16(y);
+						rowSpans.pushBack(span);
+					}
+					mColumnCounts[getColumnIndex(x, z)] = rowSpans.size() - nbSpans;
+				}
+			}
+		}
+		//~PxParallelForCallback
+
+		PxVec3							mOrigin;
+		PxReal							mVoxelSize;
+		PxU32							mNbX;
+		PxU32							mNbY;
+		PxU32							mNbZ;
+		bool							mSolid;
+
+		PxArray<VoxelShape>				mShapes;
+		PxArray<PxU32>					mShapeRanges;
+		PxArray<PxU32>					mColumnShapeOffsets;	// CSR lists of the shapes overlapping each column
+		PxArray<PxU32>					mColumnShapes;
+		PxArray<PxArray<PxVoxelSpan> >	mRowSpans;				// spans of each row of columns, written in parallel
+		PxArray<PxU32>					mColumnCounts;
+
+		PxArray<PxU32>					mColumnOffsets;
+		PxArray<PxVoxelSpan>			mSpans;
+
+		PxArray<PxActor*>				mActorBuffer;
+		PxArray<PxShape*>				mShapeBuffer;
+};
+}
+
+PxStaticVoxelizer::PxStaticVoxelizer()
+{
+	mImpl = PX_NEW(StaticVoxelizerInternal);
+}
+
+PxStaticVoxelizer::~PxStaticVoxelizer()
+{
+	PX_DELETE(mImpl);
+}
+
+bool PxStaticVoxelizer::voxelize(PxScene& scene, const PxStaticVoxelizerParams& params, PxCpuDispatcher* dispatcher)
+{
+	if(!params.isValid())
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxStaticVoxelizer::voxelize(): invalid parameters.");
+
+	const PxVec3 dims = params.region.getDimensions() / params.voxelSize;
+	const PxU32 nbY = PxMax(PxU32(PxCeil(dims.y)), 1u);
+	if(nbY > 0xffff)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxStaticVoxelizer::voxelize(): more than 65535 voxels along Y.");
+
+	StaticVoxelizerInternal& impl = *mImpl;
+	impl.mOrigin = params.region.minimum;
+	impl.mVoxelSize = params.voxelSize;
+	impl.mNbX = PxMax(PxU32(PxCeil(dims.x)), 1u);
+	impl.mNbY = nbY;
+	impl.mNbZ = PxMax(PxU32(PxCeil(dims.z)), 1u);
+	impl.mSolid = params.solid;
+
+	impl.gatherShapes(scene, params);
+	impl.binShapes();
+
+	const PxU32 nbColumns = impl.mNbX * impl.mNbZ;
+	impl.mRowSpans.resize(impl.mNbZ);
+	impl.mColumnCounts.resizeUninitialized(nbColumns);
+
+	PxParallelFor(dispatcher, impl.mNbZ, 1, impl);
+
+	impl.mColumnOffsets.resizeUninitialized(nbColumns + 1);
+	impl.mColumnOffsets[0] = 0;
+	for(PxU32 i=0;i<nbColumns;i++)
+		impl.mColumnOffsets[i + 1] = impl.mColumnOffsets[i] + impl.mColumnCounts[i];
+
+	impl.mSpans.resizeUninitialized(impl.mColumnOffsets[nbColumns]);
+	PxU32 offset = 0;
+	for(PxU32 z=0;z<impl.mNbZ;z++)
+	{
+		const PxArray<PxVoxelSpan>& rowSpans = impl.mRowSpans[z];
+		if(rowSpans.size())
+			PxMemCopy(impl.mSpans.begin() + offset, rowSpans.begin(), sizeof(PxVoxelSpan) * rowSpans.size());
+		offset += rowSpans.size();
+	}
+	return true;
+}
+
+PxU32 PxStaticVoxelizer::getNbX() const
+{
+	return mImpl->mNbX;
+}
+
+PxU32 PxStaticVoxelizer::getNbY() const
+{
+	return mImpl->mNbY;
+}
+
+PxU32 PxStaticVoxelizer::getNbZ() const
+{
+	return mImpl->mNbZ;
+}
+
+const PxU32* PxStaticVoxelizer::getColumnOffsets() const
+{
+	return mImpl->mColumnOffsets.begin();
+}
+
+const PxVoxelSpan* PxStaticVoxelizer::getSpans() const
+{
+	return mImpl->mSpans.begin();
+}
+
+PxU32 PxStaticVoxelizer::getNbSpans() const
+{
+	return mImpl->mSpans.size();
+}
+
+bool PxStaticVoxelizer::isSolid(PxU32 x, PxU32 y, PxU32 z) const
+{
+	const StaticVoxelizerInternal& impl = *mImpl;
+	if(x >= impl.mNbX || y >= impl.mNbY || z >= impl.mNbZ || impl.mColumnOffsets.empty())
+		return false;
+
+	const PxU32 column = impl.getColumnIndex(x, z);
+	for(PxU32 i=impl.mColumnOffsets[column];i<impl.mColumnOffsets[column + 1];i++)
+	{
+		const PxVoxelSpan& span = impl.mSpans[i];
+		if(y < span.start)
+			return false;
+		if(y < span.end)
+			return true;
+	}
+	return false;
+}
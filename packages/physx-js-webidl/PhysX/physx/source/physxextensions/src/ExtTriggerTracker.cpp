@@ -0,0 +1,175 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "extensions/PxTriggerTracker.h"
+#include "PxSimulationEventCallback.h"
+#include "PxActor.h"
+
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+
+using namespace physx;
+
+namespace physx
+{
+class TriggerTrackerInternal
+{
+	PX_NOCOPY(TriggerTrackerInternal)
+	public:
+				TriggerTrackerInternal()	{}
+				~TriggerTrackerInternal()	{}
+
+		void	processTriggers(const PxTriggerPair* pairs, PxU32 count);
+		void	update();
+
+		// PT: actor pointers are only used as keys, they are never dereferenced once the actors have been removed
+		typedef PxPair<const PxActor*, const PxActor*>	ActorPair;
+
+		struct Occupant
+		{
+			PxTriggerDelta	mIndices;				// User indices, captured when the pair is created
+			PxU32			mNbShapePairs;			// Number of touching shape pairs
+			PxU32			mNbShapePairsAtUpdate;	// Number of touching shape pairs at the last update() call
+			bool			mDirty;					// True if the pair is in mDirtyPairs
+		};
+
+		typedef PxHashMap<ActorPair, Occupant>	OccupantMap;
+
+		OccupantMap						mOccupants;
+		PxArray<ActorPair>				mDirtyPairs;
+		PxArray<PxTriggerDelta>			mEntered;
+		PxArray<PxTriggerDelta>			mLeft;
+};
+}
+
+void TriggerTrackerInternal::processTriggers(const PxTriggerPair* pairs, PxU32 count)
+{
+	for(PxU32 i=0;i<count;i++)
+	{
+		const PxTriggerPair& pair = pairs[i];
+		const ActorPair key(pair.triggerActor, pair.otherActor);
+
+		Occupant* occupant;
+		if(pair.status & PxPairFlag::eNOTIFY_TOUCH_FOUND)
+		{
+			const OccupantMap::Entry* entry = mOccupants.find(key);
+			if(entry)
+				occupant = const_cast<Occupant*>(&entry->second);
+			else
+			{
+				occupant = &mOccupants[key];
+				occupant->mIndices.triggerIndex = PxU32(size_t(pair.triggerActor->userData));
+				occupant->mIndices.otherIndex = PxU32(size_t(pair.otherActor->userData));
+				occupant->mNbShapePairs = 0;
+				occupant->mNbShapePairsAtUpdate = 0;
+				occupant->mDirty = false;
+			}
+			occupant->mNbShapePairs++;
+		}
+		else if(pair.status & PxPairFlag::eNOTIFY_TOUCH_LOST)
+		{
+			const OccupantMap::Entry* entry = mOccupants.find(key);
+			if(!entry || !entry->second.mNbShapePairs)
+				continue;
+			occupant = const_cast<Occupant*>(&entry->second);
+			occupant->mNbShapePairs--;
+		}
+		else
+			continue;
+
+		if(!occupant->mDirty)
+		{
+			occupant->mDirty = true;
+			mDirtyPairs.pushBack(key);
+		}
+	}
+}
+
+void TriggerTrackerInternal::update()
+{
+	mEntered.forceSize_Unsafe(0);
+	mLeft.forceSize_Unsafe(0);
+
+	// PT: only the pairs touched since the last update are visited, and events that cancel each other produce no delta
+	const PxU32 nbDirtyPairs = mDirtyPairs.size();
+	for(PxU32 i=0;i<nbDirtyPairs;i++)
+	{
+		const ActorPair& key = mDirtyPairs[i];
+		Occupant& occupant = mOccupants[key];
+		occupant.mDirty = false;
+
+		const bool wasInside = occupant.mNbShapePairsAtUpdate!=0;
+		const bool isInside = occupant.mNbShapePairs!=0;
+		if(!wasInside && isInside)
+			mEntered.pushBack(occupant.mIndices);
+		else if(wasInside && !isInside)
+			mLeft.pushBack(occupant.mIndices);
+
+		if(isInside)
+			occupant.mNbShapePairsAtUpdate = occupant.mNbShapePairs;
+		else
+			mOccupants.erase(key);
+	}
+	mDirtyPairs.forceSize_Unsafe(0);
+}
+
+PxTriggerTracker::PxTriggerTracker()
+{
+	mImpl = new TriggerTrackerInternal;
+}
+
+PxTriggerTracker::~PxTriggerTracker()
+{
+	delete mImpl;
+}
+
+void PxTriggerTracker::processTriggers(const PxTriggerPair* pairs, PxU32 count)
+{
+	mImpl->processTriggers(pairs, count);
+}
+
+void PxTriggerTracker::update()
+{
+	mImpl->update();
+}
+
+const PxTriggerDelta* PxTriggerTracker::getEntered(PxU32& nbDeltas) const
+{
+	nbDeltas = mImpl->mEntered.size();
+	return mImpl->mEntered.begin();
+}
+
+const PxTriggerDelta* PxTriggerTracker::getLeft(PxU32& nbDeltas) const
+{
+	nbDeltas = mImpl->mLeft.size();
+	return mImpl->mLeft.begin();
+}
+
+bool PxTriggerTracker::isInside(const PxActor* triggerActor, const PxActor* otherActor) const
+{
+	const TriggerTrackerInternal::OccupantMap::Entry* entry = mImpl->mOccupants.find(TriggerTrackerInternal::ActorPair(triggerActor, otherActor));
+	return entry && entry->second.mNbShapePairsAtUpdate!=0;
+}
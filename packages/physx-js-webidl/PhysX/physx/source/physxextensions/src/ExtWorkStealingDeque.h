@@ -0,0 +1,118 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef EXT_WORK_STEALING_DEQUE_H
+#define EXT_WORK_STEALING_DEQUE_H
+
+#include "task/PxTask.h"
+#include "foundation/PxAtomic.h"
+
+namespace physx
+{
+
+#define EXT_WORK_STEALING_DEQUE_SIZE	1024	// PT: must be a power of two
+
+namespace Ext
+{
+	// PT: fixed-capacity Chase-Lev deque. The owner thread pushes and pops at the bottom (LIFO), other threads steal
+	// from the top (FIFO). Indices grow forever and are only compared through wrap-safe differences. Foundation
+	// atomics are full barriers, so they are also used as fences for the loads/stores that need ordering.
+	class WorkStealingDeque
+	{
+		volatile PxI32			mTop;
+		PxU8					mPad[64 - sizeof(PxI32)];	// PT: stealers and owner write to different cache lines
+		volatile PxI32			mBottom;
+		PxBaseTask* volatile	mTasks[EXT_WORK_STEALING_DEQUE_SIZE];
+
+		static PX_FORCE_INLINE	PxI32	getSize(PxI32 bottom, PxI32 top)	{ return PxI32(PxU32(bottom) - PxU32(top));	}
+
+	public:
+		WorkStealingDeque() : mTop(0), mBottom(0)	{}
+
+		// PT: owner thread only. Returns false if the deque is full.
+		PX_FORCE_INLINE	bool	push(PxBaseTask& task)
+		{
+			const PxI32 bottom = mBottom;
+			if(getSize(bottom, mTop) >= EXT_WORK_STEALING_DEQUE_SIZE)
+				return false;
+
+			mTasks[PxU32(bottom) & (EXT_WORK_STEALING_DEQUE_SIZE-1)] = &task;
+			PxAtomicExchange(&mBottom, PxI32(PxU32(bottom) + 1));	// PT: publishes the task before the new bottom
+			return true;
+		}
+
+		// PT: owner thread only
+		PX_FORCE_INLINE	PxBaseTask*	pop()
+		{
+			const PxI32 bottom = PxI32(PxU32(mBottom) - 1);
+			PxAtomicExchange(&mBottom, bottom);	// PT: the bottom store must be visible before we read the top
+			const PxI32 top = mTop;
+
+			const PxI32 size = getSize(bottom, top);
+			if(size < 0)
+			{
+				PxAtomicExchange(&mBottom, top);
+				return NULL;
+			}
+
+			PxBaseTask* task = mTasks[PxU32(bottom) & (EXT_WORK_STEALING_DEQUE_SIZE-1)];
+			if(size == 0)
+			{
+				// PT: last task, race against stealers for it
+				if(PxAtomicCompareExchange(&mTop, PxI32(PxU32(top) + 1), top) != top)
+					task = NULL;
+				PxAtomicExchange(&mBottom, PxI32(PxU32(top) + 1));
+			}
+			return task;
+		}
+
+		// PT: any thread
+		PX_FORCE_INLINE	PxBaseTask*	steal()
+		{
+			const PxI32 top = PxAtomicAdd(&mTop, 0);
+			const PxI32 bottom = PxAtomicAdd(&mBottom, 0);
+			if(getSize(bottom, top) <= 0)
+				return NULL;
+
+			PxBaseTask* task = mTasks[PxU32(top) & (EXT_WORK_STEALING_DEQUE_SIZE-1)];
+			if(PxAtomicCompareExchange(&mTop, PxI32(PxU32(top) + 1), top) != top)
+				return NULL;	// PT: lost the race against the owner or another stealer
+			return task;
+		}
+
+		// PT: approximate number of queued tasks, for profiling only
+		PX_FORCE_INLINE	PxU32	getApproxSize()	const
+		{
+			const PxI32 size = getSize(mBottom, mTop);
+			return size > 0 ? PxU32(size) : 0;
+		}
+	};
+
+} // namespace Ext
+
+}
+
+#endif
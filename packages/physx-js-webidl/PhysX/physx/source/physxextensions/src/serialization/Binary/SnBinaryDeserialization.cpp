@@ -31,6 +31,8 @@
 #include "foundation/PxHashMap.h"
 #include "foundation/PxString.h"
 #include "extensions/PxSerialization.h"
+#include "extensions/PxParallelFor.h"
+#include "geometry/PxTriangleMesh.h"
 #include "PxPhysics.h"
 #include "PxPhysicsSerialization.h"
 
@@ -124,10 +126,49 @@ namespace
 		}
 		return true;
 	}
-	
+
+	class MeshHashTask : public PxParallelForCallback
+	{
+	public:
+		MeshHashTask(PxBase* const* meshes, PxU64* hashes) : mMeshes(meshes), mHashes(hashes)	{}
+
+		virtual void process(PxU32 startIndex, PxU32 endIndex)
+		{
+			for(PxU32 i=startIndex;i<endIndex;i++)
+				mHashes[i] = SerializationRegistry::computeTriangleMeshHash(*mMeshes[i]);
+		}
+
+		PxBase* const*	mMeshes;
+		PxU64*			mHashes;
+
+		PX_NOCOPY(MeshHashTask)
+	};
+
+	// PT: hashes the pending triangle meshes in parallel, then shares them serially and in order, so that the
+	// results are the same with or without a dispatcher. The meshes are added to the collection here.
+	void sharePendingMeshes(PxArray<PxBase*>& meshes, PxArray<PxU64>& hashes, SerializationRegistry& sn, DeserializationContext& context,
+							Cm::Collection& collection, PxCpuDispatcher* dispatcher)
+	{
+		const PxU32 nb = meshes.size();
+		hashes.resizeUninitialized(nb);
+
+		MeshHashTask task(meshes.begin(), hashes.begin());
+		PxParallelFor(dispatcher, nb, 1, task);
+
+		for(PxU32 i=0;i<nb;i++)
+		{
+			PxBase* mesh = meshes[i];
+			PxBase* shared = sn.shareTriangleMesh(*mesh, hashes[i]);
+			// PT: the unused copy stays in the memory block, it doesn't own any other memory.
+			if(shared != mesh)
+				context.redirect(mesh, shared);
+			collection.internalAdd(shared);
+		}
+		meshes.clear();
+	}
 }
 
-PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* pxExternalRefs)
+PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* pxExternalRefs, PxCpuDispatcher* dispatcher)
 {
 	if(size_t(memBlock) & (PX_SERIAL_FILE_ALIGN-1))
 	{
@@ -234,6 +275,13 @@ PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSeri
 	PxU8* addressExtraData = alignPtr(addressObjectData + objectDataEndOffset);
 
 	DeserializationContext context(manifestTable, importReferences, addressObjectData, internalPtrReferencesMap, internalHandle16ReferencesMap, externalRefs, addressExtraData);
+	const bool shareTriangleMeshes = sn.getTriangleMeshSharing();
+
+	// PT: triangle meshes waiting to be shared. Meshes are sorted before the objects using them and don't reference
+	// other objects, so sharing a run of consecutive meshes can wait until the next non-mesh object is created. That
+	// way the content hashes of a run are computed in parallel, and redirecting still catches all references.
+	PxArray<PxBase*> pendingMeshes;
+	PxArray<PxU64> pendingHashes;
 	
 	// iterate over memory containing PxBase objects, create the instances, resolve the addresses, import the external data, add to collection.
 	{
@@ -250,17 +298,26 @@ PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSeri
 			const PxSerializer* serializer = sn.getSerializer(classType);
 			PX_ASSERT(serializer);
 
+			if(pendingMeshes.size() && classType != PxConcreteType::eTRIANGLE_MESH_BVH33 && classType != PxConcreteType::eTRIANGLE_MESH_BVH34)
+				sharePendingMeshes(pendingMeshes, pendingHashes, sn, context, *collection, dispatcher);
+
 			PxBase* instance = serializer->createObject(address, context);
 			if (!instance)
 			{
 				PxGetFoundation().error(physx::PxErrorCode::eINVALID_PARAMETER, PX_FL, 
 					"Cannot create class instance for concrete type %d.", classType);
+				sharePendingMeshes(pendingMeshes, pendingHashes, sn, context, *collection, NULL);
 				collection->release();
 				return NULL;
 			}
 
-			collection->internalAdd(instance);
+			if (shareTriangleMeshes && instance->is<PxTriangleMesh>())
+				pendingMeshes.pushBack(instance);
+			else
+				collection->internalAdd(instance);
 		}
+
+		sharePendingMeshes(pendingMeshes, pendingHashes, sn, context, *collection, dispatcher);
 	}
 
 	PX_ASSERT(nbObjectsInCollection == collection->internalGetNbObjects());
@@ -277,7 +334,7 @@ PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSeri
 
 			if (manifestIndex < nbManifestEntries)
 			{
-				PxBase* obj = reinterpret_cast<PxBase*>(addressObjectData + manifestTable[manifestIndex].offset);
+				PxBase* obj = context.getRedirected(reinterpret_cast<PxBase*>(addressObjectData + manifestTable[manifestIndex].offset));
 				collection->mIds.insertUnique(exportReferences[i].id, obj);
 				collection->mObjects[obj] = exportReferences[i].id;
 			}
@@ -298,3 +355,187 @@ PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSeri
 	PxAddCollectionToPhysics(*collection);
 	return collection;
 }
+
+namespace
+{
+	// Deserializer for the chunked format, see SnBinarySerialization.cpp
+	class BinaryChunkDeserializer : public PxBinaryChunkDeserializer, public PxUserAllocated
+	{
+	public:
+		BinaryChunkDeserializer(PxSerializationRegistry& sr, const PxCollection* externalRefs) :
+			mRegistry		(sr),
+			mReferences		(PxCreateCollection()),
+			mState			(eHEADER),
+			mFieldSize		(0),
+			mNbChunks		(0),
+			mChunkMemory	(NULL),
+			mChunkData		(NULL),
+			mChunkSize		(0),
+			mChunkReceived	(0)
+		{
+			if(externalRefs)
+				mReferences->add(const_cast<PxCollection&>(*externalRefs));
+		}
+
+		virtual ~BinaryChunkDeserializer()
+		{
+			for(PxU32 i=0;i<mCollections.size();i++)
+				mCollections[i]->release();
+			for(PxU32 i=0;i<mMemoryBlocks.size();i++)
+				PX_FREE(mMemoryBlocks[i]);
+			PX_FREE(mChunkMemory);
+			mReferences->release();
+		}
+
+		// PxBinaryChunkDeserializer
+		virtual	bool			addData(const void* data, PxU32 size);
+		virtual	bool			isComplete()				const	{ return mState == eCOMPLETE;	}
+		virtual	PxU32			getNbCollections()			const	{ return mCollections.size();	}
+		virtual	PxCollection*	getCollection(PxU32 index)	const	{ return index < mCollections.size() ? mCollections[index] : NULL;	}
+		virtual	void			release()							{ PX_DELETE_THIS;				}
+		//~PxBinaryChunkDeserializer
+
+	private:
+		enum State
+		{
+			eHEADER,		// waiting for the 3 header fields
+			eCHUNK_SIZE,	// waiting for the size of the next chunk
+			eCHUNK_DATA,	// receiving the current chunk
+			eCOMPLETE,
+			eERROR
+		};
+
+		// Stages a fixed size field, returns true when it is complete
+		bool	readField(const PxU8*& data, PxU32& size, PxU32 fieldSize)
+		{
+			const PxU32 nb = PxMin(fieldSize - mFieldSize, size);
+			PxMemCopy(mField + mFieldSize, data, nb);
+			mFieldSize += nb;
+			data += nb;
+			size -= nb;
+			if(mFieldSize != fieldSize)
+				return false;
+			mFieldSize = 0;
+			return true;
+		}
+
+		bool	setError(const char* msg)
+		{
+			mState = eERROR;
+			return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, msg);
+		}
+
+		void	nextChunk()
+		{
+			mState = mCollections.size() == mNbChunks ? eCOMPLETE : eCHUNK_SIZE;
+		}
+
+		bool	deserializeChunk();
+
+		PxSerializationRegistry&	mRegistry;
+		PxCollection*				mReferences;	// objects with ids of the deserialized chunks, and external references
+		PxArray<PxCollection*>		mCollections;
+		PxArray<void*>				mMemoryBlocks;	// memory of the deserialized chunks
+		State						mState;
+		PxU8						mField[3*sizeof(PxU32)];
+		PxU32						mFieldSize;
+		PxU32						mNbChunks;
+		void*						mChunkMemory;	// allocation for the current chunk
+		PxU8*						mChunkData;		// mChunkMemory aligned to PX_SERIAL_FILE_ALIGN
+		PxU32						mChunkSize;
+		PxU32						mChunkReceived;
+
+		PX_NOCOPY(BinaryChunkDeserializer)
+	};
+
+	bool BinaryChunkDeserializer::addData(const void* data_, PxU32 size)
+	{
+		const PxU8* data = reinterpret_cast<const PxU8*>(data_);
+		while(size)
+		{
+			switch(mState)
+			{
+				case eHEADER:
+				{
+					if(!readField(data, size, 3*sizeof(PxU32)))
+						break;
+
+					const PxU32* fields = reinterpret_cast<const PxU32*>(mField);
+					if(fields[0] != PX_MAKE_FOURCC('S','E','B','C'))
+						return setError("PxBinaryChunkDeserializer::addData: data has wrong header indicating invalid chunked binary data.");
+					if(fields[1] != 1)
+						return setError("PxBinaryChunkDeserializer::addData: unsupported chunked binary data version.");
+					mNbChunks = fields[2];
+					nextChunk();
+				}
+				break;
+
+				case eCHUNK_SIZE:
+				{
+					if(!readField(data, size, sizeof(PxU32)))
+						break;
+
+					mChunkSize = *reinterpret_cast<const PxU32*>(mField);
+					if(!mChunkSize)
+						return setError("PxBinaryChunkDeserializer::addData: invalid chunk size.");
+					mChunkReceived = 0;
+					mChunkMemory = PX_ALLOC(mChunkSize + PX_SERIAL_FILE_ALIGN - 1, "BinaryChunkDeserializer");
+					if(!mChunkMemory)
+						return setError("PxBinaryChunkDeserializer::addData: out of memory.");
+					mChunkData = alignPtr(reinterpret_cast<PxU8*>(mChunkMemory), PX_SERIAL_FILE_ALIGN);
+					mState = eCHUNK_DATA;
+				}
+				break;
+
+				case eCHUNK_DATA:
+				{
+					const PxU32 nb = PxMin(mChunkSize - mChunkReceived, size);
+					PxMemCopy(mChunkData + mChunkReceived, data, nb);
+					mChunkReceived += nb;
+					data += nb;
+					size -= nb;
+					if(mChunkReceived == mChunkSize && !deserializeChunk())
+						return false;
+				}
+				break;
+
+				case eCOMPLETE:
+					return setError("PxBinaryChunkDeserializer::addData: data received after the end of the stream.");
+
+				case eERROR:
+					return false;
+			}
+		}
+		return true;
+	}
+
+	bool BinaryChunkDeserializer::deserializeChunk()
+	{
+		PxCollection* collection = PxSerialization::createCollectionFromBinary(mChunkData, mRegistry, mReferences);
+		if(!collection)
+			return setError("PxBinaryChunkDeserializer::addData: failed to deserialize chunk.");
+
+		mCollections.pushBack(collection);
+		mMemoryBlocks.pushBack(mChunkMemory);
+		mChunkMemory = NULL;
+		mChunkData = NULL;
+
+		// later chunks reference objects of this one through their ids
+		const PxU32 nbIds = collection->getNbIds();
+		if(nbIds)
+		{
+			PxArray<PxSerialObjectId> ids(nbIds);
+			collection->getIds(ids.begin(), nbIds);
+			for(PxU32 i=0;i<nbIds;i++)
+				mReferences->add(*collection->find(ids[i]), ids[i]);
+		}
+
+		nextChunk();
+		return true;
+	}
+}
+
+PxBinaryChunkDeserializer* PxSerialization::createBinaryChunkDeserializer(PxSerializationRegistry& sr, const PxCollection* externalRefs)
+{
+	return PX_NEW(BinaryChunkDeserializer)(sr, externalRefs);
+}
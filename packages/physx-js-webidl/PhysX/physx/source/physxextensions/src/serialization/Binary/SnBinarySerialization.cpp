@@ -30,6 +30,8 @@
 #include "foundation/PxPhysicsVersion.h"
 #include "foundation/PxUtilities.h"
 #include "foundation/PxSort.h"
+#include "foundation/PxHashMap.h"
+#include "PxShape.h"
 #include "SnSerializationContext.h"
 #include "serialization/SnSerialUtils.h"
 #include "serialization/SnSerializationRegistry.h"
@@ -135,6 +137,21 @@ using namespace Sn;
 // extra data
 //
 //------------------------------------------------------------------------------------
+//
+//
+//------------------------------------------------------------------------------------
+//// Chunked binary format (serializeCollectionToBinaryChunks)
+//// a sequence of collections in the format above, each of them only referencing
+//// itself, earlier chunks and the user's external references (through ids)
+//------------------------------------------------------------------------------------
+// header SEBC
+// PxU32 chunk format version
+// PxU32 nbChunks
+// (PxU32 size, binary collection)*nbChunks
+//
+// Chunks are not aligned within the stream, the deserializer copies each of them
+// into its own aligned memory block.
+//------------------------------------------------------------------------------------
 
 namespace
 {
@@ -414,3 +431,225 @@ bool PxSerialization::serializeCollectionToBinary(PxOutputStream& outputStream,
 
 	return true;
 }
+
+namespace
+{
+	const PxU32 INVALID = 0xffffffff;
+
+	struct ChunkRequiresCallback : public PxProcessPxBaseCallback
+	{
+		ChunkRequiresCallback(PxArray<PxBase*>& required) : mRequired(required)	{}
+		virtual void process(PxBase& base)	{ mRequired.pushBack(&base);	}
+
+		PxArray<PxBase*>&	mRequired;
+		PX_NOCOPY(ChunkRequiresCallback)
+	};
+
+	// Objects which must be in the same chunk as the object requiring them
+	bool isOwnedObject(PxBase& object, const PxSerializationRegistry& sr)
+	{
+		const PxSerializer* serializer = sr.getSerializer(object.getConcreteType());
+		if(serializer && serializer->isSubordinate())
+			return true;
+		const PxShape* shape = object.is<PxShape>();
+		return shape && shape->isExclusive();
+	}
+
+	// Splits a collection into chunks. Objects are grouped with the objects they own (see isOwnedObject), and groups
+	// are sorted so that they come after the groups they require.
+	class ChunkBuilder
+	{
+	public:
+		ChunkBuilder(PxCollection& collection, const PxSerializationRegistry& sr) : mCollection(collection)
+		{
+			const PxU32 nb = collection.getNbObjects();
+			PxHashMap<const PxBase*, PxU32> objectIndices(nb*2);
+			for(PxU32 i=0;i<nb;i++)
+				objectIndices.insert(&collection.getObject(i), i);
+
+			// gather requirements within the collection, and owners
+			mRequiresStart.resize(nb + 1);
+			mOwners.resize(nb, INVALID);
+			PxArray<PxBase*> required;
+			for(PxU32 i=0;i<nb;i++)
+			{
+				mRequiresStart[i] = mRequires.size();
+
+				PxBase& object = collection.getObject(i);
+				required.clear();
+				ChunkRequiresCallback callback(required);
+				sr.getSerializer(object.getConcreteType())->requiresObjects(object, callback);
+				for(PxU32 j=0;j<required.size();j++)
+				{
+					const PxHashMap<const PxBase*, PxU32>::Entry* e = objectIndices.find(required[j]);
+					if(!e)
+						continue;	// external reference
+					mRequires.pushBack(e->second);
+					if(isOwnedObject(*required[j], sr))
+						mOwners[e->second] = i;
+				}
+			}
+			mRequiresStart[nb] = mRequires.size();
+
+			// group objects with their root owner
+			mGroups.resize(nb);
+			mRoots.resize(nb);
+			for(PxU32 i=0;i<nb;i++)
+			{
+				PxU32 root = i;
+				for(PxU32 j=0; j<nb && mOwners[root]!=INVALID; j++)	// PT: bounded in case of a cycle
+					root = mOwners[root];
+				mRoots[i] = root;
+				mGroups[root].pushBack(i);
+			}
+		}
+
+		void	build(PxU32 maxObjectsPerChunk)
+		{
+			const PxU32 nb = mCollection.getNbObjects();
+			mChunkOf.resize(nb, INVALID);
+			mChunks.clear();
+
+			PxArray<PxU8> states(nb, PxU8(0));
+			PxArray<PxU32> order;
+			for(PxU32 i=0;i<nb;i++)
+			{
+				if(mRoots[i] == i)
+					sortGroups(i, states, order);
+			}
+
+			PxArray<PxU32> current;
+			for(PxU32 i=0;i<order.size();i++)
+			{
+				const PxArray<PxU32>& group = mGroups[order[i]];
+				for(PxU32 j=0;j<group.size();j++)
+				{
+					mChunkOf[group[j]] = mChunks.size();
+					current.pushBack(group[j]);
+				}
+
+				if(current.size() >= maxObjectsPerChunk || i == order.size() - 1)
+				{
+					mChunks.pushBack(current);
+					current.clear();
+				}
+			}
+		}
+
+		// Objects referenced from another chunk need an id
+		void	markCrossChunkReferences(PxArray<bool>& referenced)	const
+		{
+			const PxU32 nb = mCollection.getNbObjects();
+			referenced.resize(nb, false);
+			for(PxU32 i=0;i<nb;i++)
+			{
+				for(PxU32 j=mRequiresStart[i];j<mRequiresStart[i+1];j++)
+				{
+					const PxU32 r = mRequires[j];
+					if(mChunkOf[r] != mChunkOf[i])
+						referenced[r] = true;
+				}
+			}
+		}
+
+		PxU32					getNbChunks()			const	{ return mChunks.size();	}
+		const PxArray<PxU32>&	getChunk(PxU32 index)	const	{ return mChunks[index];	}
+
+	private:
+		void	sortGroups(PxU32 root, PxArray<PxU8>& states, PxArray<PxU32>& order)
+		{
+			if(states[root])
+				return;	// done, or cycle
+			states[root] = 1;
+
+			const PxArray<PxU32>& group = mGroups[root];
+			for(PxU32 i=0;i<group.size();i++)
+			{
+				const PxU32 member = group[i];
+				for(PxU32 j=mRequiresStart[member];j<mRequiresStart[member+1];j++)
+				{
+					const PxU32 requiredRoot = mRoots[mRequires[j]];
+					if(requiredRoot != root)
+						sortGroups(requiredRoot, states, order);
+				}
+			}
+			order.pushBack(root);
+		}
+
+		PxCollection&				mCollection;
+		PxArray<PxU32>				mRequiresStart;
+		PxArray<PxU32>				mRequires;
+		PxArray<PxU32>				mOwners;
+		PxArray<PxU32>				mRoots;
+		PxArray<PxArray<PxU32> >	mGroups;
+		PxArray<PxU32>				mChunkOf;
+		PxArray<PxArray<PxU32> >	mChunks;
+
+		PX_NOCOPY(ChunkBuilder)
+	};
+}
+
+bool PxSerialization::serializeCollectionToBinaryChunks(PxOutputStream& outputStream, PxCollection& collection, PxSerializationRegistry& sr, PxU32 maxObjectsPerChunk, const PxCollection* externalRefs, bool exportNames)
+{
+	if(!PxSerialization::isSerializable(collection, sr, externalRefs))
+		return false;
+
+	ChunkBuilder builder(collection, sr);
+	builder.build(PxMax(maxObjectsPerChunk, 1u));
+
+	// assign ids to the objects referenced across chunks, avoiding the ids already used
+	const PxU32 nb = collection.getNbObjects();
+	PxArray<bool> referenced;
+	builder.markCrossChunkReferences(referenced);
+	PxArray<PxSerialObjectId> ids(nb);
+	PxSerialObjectId nextId = 1;
+	for(PxU32 i=0;i<nb;i++)
+	{
+		ids[i] = collection.getId(collection.getObject(i));
+		if(ids[i] == PX_SERIAL_OBJECT_ID_INVALID && referenced[i])
+		{
+			while(collection.find(nextId) || (externalRefs && externalRefs->find(nextId)))
+				nextId++;
+			ids[i] = nextId++;
+		}
+	}
+
+	const PxU32 header = PX_MAKE_FOURCC('S','E','B','C');
+	const PxU32 version = 1;
+	const PxU32 nbChunks = builder.getNbChunks();
+	outputStream.write(&header, sizeof(PxU32));
+	outputStream.write(&version, sizeof(PxU32));
+	outputStream.write(&nbChunks, sizeof(PxU32));
+
+	// objects of the previous chunks, and external references
+	PxCollection* references = PxCreateCollection();
+	if(externalRefs)
+		references->add(const_cast<PxCollection&>(*externalRefs));
+
+	bool status = true;
+	for(PxU32 c=0;c<nbChunks && status;c++)
+	{
+		const PxArray<PxU32>& chunk = builder.getChunk(c);
+		PxCollection* chunkCollection = PxCreateCollection();
+		for(PxU32 i=0;i<chunk.size();i++)
+			chunkCollection->add(collection.getObject(chunk[i]), ids[chunk[i]]);
+
+		PxDefaultMemoryOutputStream chunkStream;
+		status = serializeCollectionToBinary(chunkStream, *chunkCollection, sr, references, exportNames);
+		if(status)
+		{
+			const PxU32 size = chunkStream.getSize();
+			outputStream.write(&size, sizeof(PxU32));
+			outputStream.write(chunkStream.getData(), size);
+
+			for(PxU32 i=0;i<chunk.size();i++)
+			{
+				if(ids[chunk[i]] != PX_SERIAL_OBJECT_ID_INVALID)
+					references->add(collection.getObject(chunk[i]), ids[chunk[i]]);
+			}
+		}
+		chunkCollection->release();
+	}
+	references->release();
+	return status;
+}
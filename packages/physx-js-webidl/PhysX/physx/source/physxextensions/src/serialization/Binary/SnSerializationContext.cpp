@@ -63,7 +63,7 @@ PxBase* DeserializationContext::resolveReference(PxU32 kind, size_t reference) c
 	else
 	{
 		const ManifestEntry& entry = mManifestTable[index];
-		base = reinterpret_cast<PxBase*>(mObjectDataAddress + entry.offset);
+		base = getRedirected(reinterpret_cast<PxBase*>(mObjectDataAddress + entry.offset));
 	}
 	PX_ASSERT(base);
 	return base;
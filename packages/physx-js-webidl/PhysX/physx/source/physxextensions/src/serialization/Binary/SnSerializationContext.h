@@ -188,6 +188,14 @@ namespace physx
 
 			virtual	PxBase*	resolveReference(PxU32 kind, size_t reference) const;
 
+			// Makes references to a deserialized object resolve to another instance, see PxSerializationRegistry::setTriangleMeshSharing
+			void			redirect(PxBase* deserialized, PxBase* instance)	{ mRedirects.insert(deserialized, instance);	}
+			PxBase*			getRedirected(PxBase* base)	const
+			{
+				const PxHashMap<PxBase*, PxBase*>::Entry* entry = mRedirects.find(base);
+				return entry ? entry->second : base;
+			}
+
 		private:
 			//various pointers to deserialized data
 			const ManifestEntry* mManifestTable;
@@ -200,6 +208,8 @@ namespace physx
 
 			//external collection for resolving import references.
 			const Cm::Collection* mExternalRefs;
+
+			PxHashMap<PxBase*, PxBase*> mRedirects;
 			//const PxU32 mPhysXVersion;
 		};
 
@@ -71,6 +71,10 @@ namespace physx { namespace Sn {
 
 PxU32 getBinaryPlatformTag()
 {
+	// PT: the tag encodes the pointer size, which must match the architecture defines (e.g. emscripten wasm32 is
+	// "linux32" and wasm64 is "linux64")
+	PX_COMPILE_TIME_ASSERT(sizeof(void*) == (PX_P64_FAMILY ? 8 : 4));
+
 #if PX_WINDOWS && PX_X86
 	return sBinaryPlatformTags[0];
 #elif PX_WINDOWS && PX_X64
@@ -31,6 +31,7 @@
 #include "PxPhysics.h"
 #include "PxPhysicsSerialization.h"
 #include "PxArticulationLink.h"
+#include "geometry/PxTriangleMesh.h"
 
 #include "SnSerializationRegistry.h"
 #include "ExtSerialization.h"
@@ -146,6 +147,7 @@ namespace physx { namespace Sn {
 
 SerializationRegistry::SerializationRegistry(PxPhysics& physics)
 	: mPhysics(physics)
+	, mTriangleMeshSharing(false)
 {	
 	PxRegisterPhysicsSerializers(*this);
 	Ext::RegisterExtensionsSerializers(*this);
@@ -153,6 +155,8 @@ SerializationRegistry::SerializationRegistry(PxPhysics& physics)
 
 SerializationRegistry::~SerializationRegistry()
 {
+	setTriangleMeshSharing(false);
+
 	PxUnregisterPhysicsSerializers(*this);
 	Ext::UnregisterExtensionsSerializers(*this);
 
@@ -169,6 +173,124 @@ SerializationRegistry::~SerializationRegistry()
 	}
 }
 
+void SerializationRegistry::setTriangleMeshSharing(bool enabled)
+{
+	if(enabled == mTriangleMeshSharing)
+		return;
+
+	// PT: the deletion listener tells us when a shared mesh goes away, so that it's never returned after that
+	if(enabled)
+		mPhysics.registerDeletionListener(*this, PxDeletionEventFlag::eMEMORY_RELEASE);
+	else
+		mPhysics.unregisterDeletionListener(*this);
+
+	PxMutex::ScopedLock lock(mSharedMeshMutex);
+	mSharedMeshes.clear();
+	mSharedMeshHashes.clear();
+	mTriangleMeshSharing = enabled;
+}
+
+static PX_FORCE_INLINE void hashBytes(PxU64& hash, const void* data, PxU32 size)
+{
+	// PT: FNV-1a
+	const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+	for(PxU32 i=0;i<size;i++)
+		hash = (hash ^ bytes[i]) * 1099511628211ull;
+}
+
+static PxU32 getIndexSize(const PxTriangleMesh& mesh)
+{
+	return mesh.getTriangleMeshFlags() & PxTriangleMeshFlag::e16_BIT_INDICES ? sizeof(PxU16) : sizeof(PxU32);
+}
+
+static PxU64 computeMeshHash(const PxTriangleMesh& mesh)
+{
+	const PxType type = mesh.getConcreteType();
+	const PxU32 nbVerts = mesh.getNbVertices();
+	const PxU32 nbTris = mesh.getNbTriangles();
+	const PxU8 flags = PxU8(mesh.getTriangleMeshFlags());
+
+	PxU64 hash = 14695981039346656037ull;
+	hashBytes(hash, &type, sizeof(type));
+	hashBytes(hash, &nbVerts, sizeof(nbVerts));
+	hashBytes(hash, &nbTris, sizeof(nbTris));
+	hashBytes(hash, &flags, sizeof(flags));
+	hashBytes(hash, mesh.getVertices(), nbVerts * sizeof(PxVec3));
+	hashBytes(hash, mesh.getTriangles(), nbTris * 3 * getIndexSize(mesh));
+	return hash;
+}
+
+// PT: full comparison, so that hash collisions never merge different meshes
+static bool isSameMesh(const PxTriangleMesh& mesh0, const PxTriangleMesh& mesh1)
+{
+	if(mesh0.getConcreteType() != mesh1.getConcreteType()
+		|| mesh0.getNbVertices() != mesh1.getNbVertices()
+		|| mesh0.getNbTriangles() != mesh1.getNbTriangles()
+		|| mesh0.getTriangleMeshFlags() != mesh1.getTriangleMeshFlags()
+		|| (mesh0.getSDF() != NULL) != (mesh1.getSDF() != NULL))
+		return false;
+
+	const PxU32 nbTris = mesh0.getNbTriangles();
+	if(memcmp(mesh0.getVertices(), mesh1.getVertices(), mesh0.getNbVertices() * sizeof(PxVec3))
+		|| memcmp(mesh0.getTriangles(), mesh1.getTriangles(), nbTris * 3 * getIndexSize(mesh0)))
+		return false;
+
+	for(PxU32 i=0;i<nbTris;i++)
+	{
+		if(mesh0.getTriangleMaterialIndex(i) != mesh1.getTriangleMaterialIndex(i))
+			return false;
+	}
+	return true;
+}
+
+PxU64 SerializationRegistry::computeTriangleMeshHash(const PxBase& mesh)
+{
+	PX_ASSERT(mesh.is<PxTriangleMesh>());
+	return computeMeshHash(static_cast<const PxTriangleMesh&>(mesh));
+}
+
+PxBase* SerializationRegistry::shareTriangleMesh(PxBase& mesh)
+{
+	return shareTriangleMesh(mesh, computeTriangleMeshHash(mesh));
+}
+
+// PT: the hash doesn't need the lock, so that callers can compute it beforehand (and in parallel)
+PxBase* SerializationRegistry::shareTriangleMesh(PxBase& mesh, PxU64 hash)
+{
+	PX_ASSERT(mesh.is<PxTriangleMesh>());
+	PX_ASSERT(hash == computeTriangleMeshHash(mesh));
+	const PxTriangleMesh& triangleMesh = static_cast<const PxTriangleMesh&>(mesh);
+
+	PxMutex::ScopedLock lock(mSharedMeshMutex);
+	const SharedMeshMap::Entry* entry = mSharedMeshes.find(hash);
+	if(entry)
+	{
+		PxBase* shared = entry->second;
+		if(isSameMesh(triangleMesh, static_cast<const PxTriangleMesh&>(*shared)))
+		{
+			// PT: the reference owned by the new collection. Objects using the mesh take their own references when they are deserialized.
+			static_cast<PxTriangleMesh*>(shared)->acquireReference();
+			return shared;
+		}
+		return &mesh;	// PT: hash collision, the new mesh is not shared
+	}
+
+	mSharedMeshes.insert(hash, &mesh);
+	mSharedMeshHashes.insert(&mesh, hash);
+	return &mesh;
+}
+
+void SerializationRegistry::onRelease(const PxBase* observed, void*, PxDeletionEventFlag::Enum)
+{
+	PxMutex::ScopedLock lock(mSharedMeshMutex);
+	const SharedMeshHashMap::Entry* entry = mSharedMeshHashes.find(observed);
+	if(entry)
+	{
+		mSharedMeshes.erase(entry->second);
+		mSharedMeshHashes.erase(observed);
+	}
+}
+
 void SerializationRegistry::registerSerializer(PxType type, PxSerializer& serializer)
 {
 	if(mSerializers.find(type))
@@ -31,10 +31,12 @@
 
 #include "extensions/PxSerialization.h"
 #include "extensions/PxRepXSerializer.h"
+#include "PxDeletionListener.h"
 
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxHashMap.h"
 #include "foundation/PxArray.h"
+#include "foundation/PxMutex.h"
 
 
 namespace physx
@@ -44,7 +46,7 @@ namespace Cm { class Collection; }
 
 namespace Sn {
 	
-	class SerializationRegistry : public PxSerializationRegistry, public PxUserAllocated
+	class SerializationRegistry : public PxSerializationRegistry, public PxDeletionListener, public PxUserAllocated
 	{
 	public:
 		SerializationRegistry(PxPhysics& physics);					
@@ -65,6 +67,16 @@ namespace Sn {
 		void						registerRepXSerializer(PxType type, PxRepXSerializer& serializer);
 		PxRepXSerializer*			getRepXSerializer(const char* typeName) const;
 		PxRepXSerializer*           unregisterRepXSerializer(PxType type);
+		//mesh sharing
+		virtual void				setTriangleMeshSharing(bool enabled);
+		virtual bool				getTriangleMeshSharing() const	{ return mTriangleMeshSharing; }
+		PxBase*						shareTriangleMesh(PxBase& mesh);
+		PxBase*						shareTriangleMesh(PxBase& mesh, PxU64 hash);
+		static PxU64				computeTriangleMeshHash(const PxBase& mesh);
+
+		// PxDeletionListener
+		virtual void				onRelease(const PxBase* observed, void* userData, PxDeletionEventFlag::Enum deletionEvent);
+		//~PxDeletionListener
 	
 	protected:
 		SerializationRegistry &operator=(const SerializationRegistry &);
@@ -72,9 +84,17 @@ namespace Sn {
 		typedef PxCoalescedHashMap<PxType, PxSerializer*>		SerializerMap;
 		typedef PxHashMap<PxType, PxRepXSerializer*>	        RepXSerializerMap;
 
+		typedef PxHashMap<PxU64, PxBase*>				SharedMeshMap;
+		typedef PxHashMap<const PxBase*, PxU64>			SharedMeshHashMap;
+
 		PxPhysics&										mPhysics;
 		SerializerMap									mSerializers;
 		RepXSerializerMap								mRepXSerializers;
+		// PT: content hash => live deserialized triangle mesh, and the reverse map for deletion events
+		PxMutex											mSharedMeshMutex;
+		SharedMeshMap									mSharedMeshes;
+		SharedMeshHashMap								mSharedMeshHashes;
+		bool											mTriangleMeshSharing;
 	};
 
 	void  sortCollection(Cm::Collection& collection, SerializationRegistry& sr, bool isRepx);
@@ -314,6 +314,66 @@ namespace physx { namespace Sn {
 		XmlNodeReader& operator=(const XmlNodeReader&);
 	};
 
+	//Interns element and attribute names, which repeat for every object in a repx file.
+	//The strings live in the pool of the manager and are never released individually.
+	class XmlNameTable
+	{
+		typedef PxProfileHashMap<const char*, PxU32> TNameMap;
+		TMemoryPoolManager&	mManager;
+		TNameMap			mNames;
+	public:
+		XmlNameTable( TMemoryPoolManager& inManager )
+			: mManager( inManager )
+			, mNames( inManager.getWrapper() )
+		{
+		}
+
+		const char* intern( const char* inName )
+		{
+			if ( inName == NULL || *inName == 0 )
+				return "";
+			const TNameMap::Entry* existing( mNames.find( inName ) );
+			if ( existing )
+				return existing->first;
+			const char* theName = copyStr( &mManager, inName );
+			mNames.insert( theName, 0 );
+			return theName;
+		}
+	private:
+		XmlNameTable& operator=(const XmlNameTable&);
+	};
+
+	//Receives the top-level elements of a repx file as soon as they are closed, so that objects can be
+	//created while parsing instead of after the whole tree has been built.
+	class XmlObjectHandler
+	{
+	public:
+		enum Result
+		{
+			eKEEP,		//The node stays in the tree
+			eRELEASE,	//The node has been consumed and is released by the parser
+			eERROR		//Parsing stops
+		};
+		virtual ~XmlObjectHandler() {}
+		virtual Result handleObject( XmlNode& inNode, XmlMemoryAllocatorImpl& inAllocator ) = 0;
+	};
+
+	//Unlike releaseNodeAndChildren, this also releases the node data. Only valid for nodes created by an
+	//XmlParser with a name table: names are interned and the data is never shared.
+	static void releaseParsedNode( TMemoryPoolManager* inManager, XmlNode* inNode )
+	{
+		XmlNode* theChild( inNode->mFirstChild );
+		while( theChild )
+		{
+			XmlNode* theNext( theChild->mNextSibling );
+			releaseParsedNode( inManager, theChild );
+			theChild = theNext;
+		}
+		releaseStr( inManager, inNode->mData );
+		inNode->orphan();
+		release( inManager, inNode );
+	}
+
 	PX_INLINE void  freeNodeAndChildren( XmlNode* tempNode, TMemoryPoolManager& inManager )
 	{
 		for( XmlNode* theNode = tempNode->mFirstChild; theNode != NULL; theNode = theNode->mNextSibling )
@@ -329,13 +389,25 @@ namespace physx { namespace Sn {
 		XmlMemoryAllocatorImpl& mParseAllocator;
 		XmlNode* mCurrentNode;
 		XmlNode* mTopNode;
+		XmlNameTable mNameTable;
+		XmlObjectHandler* mObjectHandler;
+
+		XmlNode* allocateNode( const char* inName, const char* inData )
+		{
+			XmlNode* retval = mParseAllocator.mManager.allocate<XmlNode>();
+			retval->mName = mNameTable.intern( inName );
+			retval->mData = copyStr( &mParseAllocator.mManager, inData );
+			return retval;
+		}
 
 	public:
-		XmlParser( XmlParseArgs inArgs, XmlMemoryAllocatorImpl& inParseAllocator )
+		XmlParser( XmlParseArgs inArgs, XmlMemoryAllocatorImpl& inParseAllocator, XmlObjectHandler* inObjectHandler = NULL )
 			: mParseArgs( inArgs )
 			, mParseAllocator( inParseAllocator )
 			, mCurrentNode( NULL )
 			, mTopNode( NULL )
+			, mNameTable( inParseAllocator.mManager )
+			, mObjectHandler( inObjectHandler )
 		{
 		}
 
@@ -351,7 +423,20 @@ namespace physx { namespace Sn {
 		{
 			if (NULL != mCurrentNode)
 			{
+				XmlNode* theClosedNode = mCurrentNode;
 				mCurrentNode = mCurrentNode->mParent;
+				if ( mObjectHandler && mCurrentNode && mCurrentNode == mTopNode )
+				{
+					const XmlObjectHandler::Result theResult = mObjectHandler->handleObject( *theClosedNode, mParseAllocator );
+					if ( theResult == XmlObjectHandler::eERROR )
+					{
+						isError = true;
+						return false;
+					}
+					//Releasing consumed objects keeps the top node's child list, and peak memory, small.
+					if ( theResult == XmlObjectHandler::eRELEASE )
+						releaseParsedNode( &mParseAllocator.mManager, theClosedNode );
+				}
 				return true;
 			}
 			isError = true;
@@ -365,14 +450,14 @@ namespace physx { namespace Sn {
 			const shdfnd::FastXml::AttributePairs& attr,      // attributes
 			PxI32 /*lineno*/)
 		{
-			XmlNode* newNode = allocateRepXNode( &mParseAllocator.mManager, elementName, elementData );
+			XmlNode* newNode = allocateNode( elementName, elementData );
 			if ( mCurrentNode )
 				mCurrentNode->addChild( newNode );
 			mCurrentNode = newNode;
 			//Add the elements as children.
 			for( PxI32 item = 0; item < attr.getNbAttr(); item ++ )
 			{
-				XmlNode* node = allocateRepXNode( &mParseAllocator.mManager, attr.getKey(PxU32(item)), attr.getValue(PxU32(item)) );
+				XmlNode* node = allocateNode( attr.getKey(PxU32(item)), attr.getValue(PxU32(item)) );
 				mCurrentNode->addChild( node );
 			}
 			if ( mTopNode == NULL ) mTopNode = newNode;
@@ -614,10 +699,10 @@ namespace physx { namespace Sn {
 			}
 		}
 
-		void load( PxInputData& inFileBuf, SerializationRegistry& s )
+		void load( PxInputData& inFileBuf, SerializationRegistry& s, XmlObjectHandler* inObjectHandler )
 		{
 			inFileBuf.seek(0);
-			XmlParser theParser( XmlParseArgs( &mAllocator, &mCollection ), mAllocator );
+			XmlParser theParser( XmlParseArgs( &mAllocator, &mCollection ), mAllocator, inObjectHandler );
 			shdfnd::FastXml* theFastXml = shdfnd::createFastXml( &theParser );
 			theFastXml->processXml( inFileBuf );
 			XmlNode* theTopNode = theParser.getTopNode();
@@ -725,12 +810,88 @@ namespace physx { namespace Sn {
 		return PX_PLACEMENT_NEW((inAllocator.allocate(sizeof(RepXCollectionImpl), "RepXCollection::create", PX_FL)), RepXCollectionImpl) ( s, inAllocator, inCollection );
 	}
 
-	static RepXCollection* create(SerializationRegistry& s, PxInputData &data, PxAllocatorCallback& inAllocator, PxCollection& inCollection )
+	static RepXCollection* create(SerializationRegistry& s, PxInputData &data, PxAllocatorCallback& inAllocator, PxCollection& inCollection, XmlObjectHandler* inObjectHandler )
 	{			
 		RepXCollectionImpl* theCollection = static_cast<RepXCollectionImpl*>( create(s, inAllocator, inCollection ) );
-		theCollection->load( data, s );
+		theCollection->load( data, s, inObjectHandler );
 		return theCollection;
 	}
+
+	//Creates objects while the file is parsed, then releases their nodes. Only used for files written with the
+	//latest version: older files need the whole tree for RepXUpgrader, and are instantiated after parsing.
+	class XmlStreamingInstantiator : public XmlObjectHandler
+	{
+		enum Mode
+		{
+			eUNDECIDED,
+			eSTREAMING,
+			eTREE
+		};
+
+		PxSerializationRegistry&	mRegistry;
+		PxRepXInstantiationArgs&	mArgs;
+		PxCollection&				mCollection;
+		Mode						mMode;
+		bool						mFailed;
+
+	public:
+		XmlStreamingInstantiator( PxSerializationRegistry& inRegistry, PxRepXInstantiationArgs& inArgs, PxCollection& inCollection )
+			: mRegistry( inRegistry )
+			, mArgs( inArgs )
+			, mCollection( inCollection )
+			, mMode( eUNDECIDED )
+			, mFailed( false )
+		{
+		}
+
+		bool isStreaming() const { return mMode == eSTREAMING; }
+		bool hasFailed() const { return mFailed; }
+
+		virtual Result handleObject( XmlNode& inNode, XmlMemoryAllocatorImpl& inAllocator )
+		{
+			//The version is an attribute of the top node, i.e. one of its first children.
+			if ( mMode == eUNDECIDED )
+			{
+				const XmlNode* theVersion = inNode.mParent->findChildByName( "version" );
+				const bool isLatest = theVersion && theVersion->mData && Pxstrcmp( theVersion->mData, RepXCollection::getLatestVersion() ) == 0;
+				mMode = isLatest ? eSTREAMING : eTREE;
+			}
+
+			if ( mMode == eTREE
+				|| physx::Pxstricmp( inNode.mName, "scale" ) == 0
+				|| physx::Pxstricmp( inNode.mName, "version" ) == 0
+				|| physx::Pxstricmp( inNode.mName, "upvector" ) == 0 )
+				return eKEEP;
+
+			PxRepXSerializer* theSerializer = mRegistry.getRepXSerializer( inNode.mName );
+			if ( theSerializer == NULL )
+			{
+				PxGetFoundation().error(PxErrorCode::eINTERNAL_ERROR, PX_FL, 
+					"PxSerialization::createCollectionFromXml: "
+					"PxRepXSerializer missing for type %s", inNode.mName);
+				mFailed = true;
+				return eERROR;
+			}
+
+			XmlNodeReader theReader( &inNode, inAllocator.getAllocator(), inAllocator.mManager );
+			PxSerialObjectId theId = 0;
+			theReader.read( "Id", theId );
+
+			XmlMemoryAllocatorImpl instantiationAllocator( inAllocator.getAllocator() );
+			PxRepXObject theLiveObject = theSerializer->fileToObject( theReader, instantiationAllocator, mArgs, &mCollection );
+			if ( !theLiveObject.isValid() )
+			{
+				mFailed = true;
+				return eERROR;
+			}
+
+			const PxBase* s = reinterpret_cast<const PxBase*>( theLiveObject.serializable );
+			mCollection.add( *const_cast<PxBase*>(s), theId );
+			return eRELEASE;
+		}
+	private:
+		XmlStreamingInstantiator& operator=(const XmlStreamingInstantiator&);
+	};
 }
 
 	bool PxSerialization::serializeCollectionToXml( PxOutputStream& outputStream, PxCollection& collection, PxSerializationRegistry& sr, const PxCookingParams* params, const PxCollection* externalRefs, PxXmlMiscParameter* inArgs )
@@ -809,11 +970,18 @@ namespace physx { namespace Sn {
 			collection->add(*const_cast<PxCollection*>(externalRefs));
 
 		PxAllocatorCallback& allocator = *PxGetAllocatorCallback();
-		Sn::RepXCollection* theRepXCollection = Sn::create(sn, inputData, allocator, *collection);
-		theRepXCollection = &Sn::RepXUpgrader::upgradeCollection( *theRepXCollection );
-				
 		PxRepXInstantiationArgs args( sn.getPhysics(), &params, stringTable );  
-		if( !theRepXCollection->instantiateCollection(args, *collection) )
+		Sn::XmlStreamingInstantiator instantiator( sn, args, *collection );
+		Sn::RepXCollection* theRepXCollection = Sn::create(sn, inputData, allocator, *collection, &instantiator);
+
+		bool instantiated = !instantiator.hasFailed();
+		if( instantiated && !instantiator.isStreaming() )
+		{
+			theRepXCollection = &Sn::RepXUpgrader::upgradeCollection( *theRepXCollection );
+			instantiated = theRepXCollection->instantiateCollection(args, *collection);
+		}
+
+		if( !instantiated )
 		{
 			collection->release();
 			theRepXCollection->destroy();
@@ -40,6 +40,7 @@
 		{ "eSCENE_QUERY_SHAPE", static_cast<PxU32>( physx::PxShapeFlag::eSCENE_QUERY_SHAPE ) },
 		{ "eTRIGGER_SHAPE", static_cast<PxU32>( physx::PxShapeFlag::eTRIGGER_SHAPE ) },
 		{ "eVISUALIZATION", static_cast<PxU32>( physx::PxShapeFlag::eVISUALIZATION ) },
+		{ "eREDUCE_MESH_CONTACTS", static_cast<PxU32>( physx::PxShapeFlag::eREDUCE_MESH_CONTACTS ) },
 		{ NULL, 0 }
 	};
 
@@ -2488,6 +2489,9 @@ template<> struct PxEnumTraits< physx::PxPruningStructureType::Enum > { PxEnumTr
 		{ "eENABLE_DIRECT_GPU_API", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_DIRECT_GPU_API ) },
 		{ "eENABLE_BODY_ACCELERATIONS", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_BODY_ACCELERATIONS ) },
 		{ "eENABLE_SOLVER_RESIDUAL_REPORTING", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_SOLVER_RESIDUAL_REPORTING ) },
+		{ "eENABLE_FILTER_SHADER_CACHE", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_FILTER_SHADER_CACHE ) },
+		{ "eENABLE_BODY_STREAMS", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_BODY_STREAMS ) },
+		{ "eENABLE_QUANTIZED_CONTACTS", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_QUANTIZED_CONTACTS ) },
 		{ "eMUTABLE_FLAGS", static_cast<PxU32>( physx::PxSceneFlag::eMUTABLE_FLAGS ) },
 		{ NULL, 0 }
 	};
@@ -3234,6 +3238,7 @@ template<> struct PxEnumTraits< physx::PxArticulationDriveType::Enum > { PxEnumT
 		{ "eBUCKET", static_cast<PxU32>( physx::PxDynamicTreeSecondaryPruner::eBUCKET ) },
 		{ "eINCREMENTAL", static_cast<PxU32>( physx::PxDynamicTreeSecondaryPruner::eINCREMENTAL ) },
 		{ "eBVH", static_cast<PxU32>( physx::PxDynamicTreeSecondaryPruner::eBVH ) },
+		{ "eGRID", static_cast<PxU32>( physx::PxDynamicTreeSecondaryPruner::eGRID ) },
 		{ "eLAST", static_cast<PxU32>( physx::PxDynamicTreeSecondaryPruner::eLAST ) },
 		{ NULL, 0 }
 	};
@@ -0,0 +1,151 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "vehicle2/PxVehicleComponentSequence.h"
+
+#include "extensions/PxParallelFor.h"
+
+namespace physx
+{
+namespace vehicle2
+{
+
+namespace
+{
+	class ComponentSequencesUpdate : public PxParallelForCallback
+	{
+	public:
+		ComponentSequencesUpdate(PxVehicleComponentSequence* const* sequences, const PxReal dt, const PxVehicleSimulationContext& context)
+			: mSequences(sequences), mDt(dt), mContext(context)
+		{
+		}
+
+		virtual void process(PxU32 startIndex, PxU32 endIndex) PX_OVERRIDE
+		{
+			for (PxU32 i = startIndex; i < endIndex; i++)
+				mSequences[i]->update(mDt, mContext);
+		}
+
+		PxVehicleComponentSequence* const* mSequences;
+		const PxReal mDt;
+		const PxVehicleSimulationContext& mContext;
+
+	private:
+		ComponentSequencesUpdate& operator=(const ComponentSequencesUpdate&);
+	};
+
+	class ComponentBatchUpdate : public PxParallelForCallback
+	{
+	public:
+		ComponentBatchUpdate(PxVehicleComponentBatch& batch, const PxReal dt, const PxVehicleSimulationContext& context)
+			: mBatch(batch), mDt(dt), mContext(context)
+		{
+		}
+
+		virtual void process(PxU32 startIndex, PxU32 endIndex) PX_OVERRIDE
+		{
+			mBatch.updateVehicles(startIndex, endIndex, mDt, mContext);
+		}
+
+		PxVehicleComponentBatch& mBatch;
+		const PxReal mDt;
+		const PxVehicleSimulationContext& mContext;
+
+	private:
+		ComponentBatchUpdate& operator=(const ComponentBatchUpdate&);
+	};
+}
+
+void PxVehicleComponentBatch::updateVehicles
+(const PxU32 startVehicle, const PxU32 endVehicle, const PxReal dt, const PxVehicleSimulationContext& context)
+{
+	PX_ASSERT(endVehicle <= mNbVehicles);
+
+	for (PxU32 i = startVehicle; i < endVehicle; i++)
+		mAborted[i] = false;
+
+	PxU8 s = 0;
+	while (s < mNbStages)
+	{
+		//Find the range of stages that are updated with the same number of substeps.
+		const PxU8 subgroup = mStages[s].subgroup;
+		PxU8 end = PxU8(s + 1);
+		if (eINVALID_SUBSTEP_GROUP != subgroup)
+		{
+			while (end < mNbStages && mStages[end].subgroup == subgroup)
+				end++;
+		}
+		const PxU8 nbSteps = (eINVALID_SUBSTEP_GROUP != subgroup) ? mSubgroupNbSteps[subgroup] : PxU8(1);
+		const PxReal timestepForGroup = dt / PxReal(nbSteps);
+
+		//Run each stage over all vehicles of the range before moving to the next stage.
+		for (PxU8 k = 0; k < nbSteps; k++)
+		{
+			for (PxU8 j = s; j < end; j++)
+			{
+				PxVehicleComponent* const* components = mStages[j].components;
+				for (PxU32 i = startVehicle; i < endVehicle; i++)
+				{
+					PxVehicleComponent* c = components[i];
+					if (c && !mAborted[i] && !c->update(timestepForGroup, context))
+						mAborted[i] = true;
+				}
+			}
+		}
+
+		s = end;
+	}
+}
+
+void PxVehicleComponentBatch::update
+(const PxReal dt, const PxVehicleSimulationContext& context,
+ PxCpuDispatcher* dispatcher, const PxU32 grain)
+{
+	PX_ASSERT(eINVALID_SUBSTEP_GROUP == mActiveSubgroup);
+	PX_ASSERT(mAborted || !mNbVehicles);
+
+	if (dt <= 0.0f)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL,
+			"PxVehicleComponentBatch::update: The timestep must be positive!");
+		return;
+	}
+
+	ComponentBatchUpdate callback(*this, dt, context);
+	PxParallelFor(dispatcher, mNbVehicles, grain, callback);
+}
+
+void PxVehicleComponentSequencesUpdate
+(PxVehicleComponentSequence* const* sequences, const PxU32 nbSequences,
+ const PxReal dt, const PxVehicleSimulationContext& context,
+ PxCpuDispatcher* dispatcher, const PxU32 grain)
+{
+	ComponentSequencesUpdate callback(sequences, dt, context);
+	PxParallelFor(dispatcher, nbSequences, grain, callback);
+}
+
+} //namespace vehicle2
+} //namespace physx
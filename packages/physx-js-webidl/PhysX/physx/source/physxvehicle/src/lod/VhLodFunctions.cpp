@@ -0,0 +1,109 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxMath.h"
+#include "foundation/PxVec3.h"
+
+#include "vehicle2/PxVehicleParams.h"
+
+#include "vehicle2/lod/PxVehicleLodFunctions.h"
+#include "vehicle2/lod/PxVehicleLodStates.h"
+
+#include "vehicle2/rigidBody/PxVehicleRigidBodyStates.h"
+
+#include "vehicle2/wheel/PxVehicleWheelParams.h"
+#include "vehicle2/wheel/PxVehicleWheelStates.h"
+
+namespace physx
+{
+namespace vehicle2
+{
+
+bool PxVehicleLodUpdate
+(const PxVehicleLodParams& lodParams,
+ const PxVec3* observerPositions, const PxU32 nbObservers,
+ const PxVehicleRigidBodyState& rigidBodyState, const PxReal wheelRadius,
+ PxVehicleLodState& lodState)
+{
+	//Compute the squared distance to the closest observer.
+	PxReal minDist2 = PX_MAX_F32;
+	for(PxU32 i = 0; i < nbObservers; i++)
+		minDist2 = PxMin(minDist2, (observerPositions[i] - rigidBodyState.pose.p).magnitudeSquared());
+	lodState.observerDistance = (PX_MAX_F32 == minDist2) ? PX_MAX_F32 : PxSqrt(minDist2);
+
+	const PxVehicleLodLevel::Enum prevLevel = lodState.level;
+
+	//Apply the distance hysteresis.
+	const PxReal promoteDist = lodParams.simpleDistance - lodParams.hysteresis;
+	const PxReal demoteDist = lodParams.simpleDistance + lodParams.hysteresis;
+	if(PxVehicleLodLevel::eFULL == prevLevel)
+	{
+		if(lodState.observerDistance > demoteDist)
+			lodState.level = PxVehicleLodLevel::eSIMPLE;
+	}
+	else if(lodState.observerDistance < promoteDist)
+	{
+		lodState.level = PxVehicleLodLevel::eFULL;
+	}
+
+	//Reduced fidelity vehicles at rest go to sleep and wake up as soon as they move.
+	if(PxVehicleLodLevel::eFULL != lodState.level && lodParams.sleepSpeed > 0.0f)
+	{
+		const PxReal sleepSpeed2 = lodParams.sleepSpeed * lodParams.sleepSpeed;
+		const PxReal sleepAngularSpeed = wheelRadius > 0.0f ? lodParams.sleepSpeed / wheelRadius : lodParams.sleepSpeed;
+		const bool atRest =
+			rigidBodyState.linearVelocity.magnitudeSquared() < sleepSpeed2 &&
+			rigidBodyState.angularVelocity.magnitudeSquared() < sleepAngularSpeed * sleepAngularSpeed;
+		lodState.level = atRest ? PxVehicleLodLevel::eSLEEPING : PxVehicleLodLevel::eSIMPLE;
+	}
+
+	return PxVehicleLodLevel::eFULL != prevLevel && PxVehicleLodLevel::eFULL == lodState.level;
+}
+
+void PxVehicleLodSimpleWheelUpdate
+(const PxVehicleWheelParams& wheelParams, const PxVehicleRigidBodyState& rigidBodyState,
+ const PxVehicleFrame& frame, const PxReal dt,
+ PxVehicleWheelRigidBody1dState& wheelRigidBody1dState)
+{
+	//Roll without slip at the speed of the chassis.
+	const PxReal wheelOmega = rigidBodyState.getLongitudinalSpeed(frame) / wheelParams.radius;
+	wheelRigidBody1dState.rotationSpeed = wheelOmega;
+	wheelRigidBody1dState.correctedRotationSpeed = wheelOmega;
+
+	//Integrate angle.
+	PxF32 newRotAngle = wheelRigidBody1dState.rotationAngle + wheelOmega * dt;
+
+	//Clamp in range (-2*Pi,2*Pi)
+	newRotAngle = newRotAngle - (PxI32(newRotAngle / PxTwoPi) * PxTwoPi);
+
+	//Set the angle.
+	wheelRigidBody1dState.rotationAngle = newRotAngle;
+}
+
+} //namespace vehicle2
+} //namespace physx
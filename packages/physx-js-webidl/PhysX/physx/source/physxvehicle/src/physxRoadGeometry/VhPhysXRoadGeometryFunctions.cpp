@@ -47,6 +47,8 @@
 #include "geometry/PxConvexMeshGeometry.h"
 #include "geometry/PxGeometryQuery.h"
 
+#include "foundation/PxSort.h"
+
 namespace physx
 {
 namespace vehicle2
@@ -85,35 +87,119 @@ PX_FORCE_INLINE void copyHitInfo(const THitBuffer& hitBuffer, PxMaterial* hitMat
 	physxRoadGeometryState.hitPosition = hitBuffer.position;
 }
 
-void PxVehiclePhysXRoadGeometryQueryUpdate
-(const PxVehicleWheelParams& wheelParams, const PxVehicleSuspensionParams& suspParams,
- const PxVehiclePhysXRoadGeometryQueryType::Enum queryType, 
+//Returns the hit actor, or NULL if no road geometry was found under the wheel.
+static const PxRigidActor* raycastRoadGeometry
+(const PxVec3& v, const PxVec3& w, const PxF32 dist,
  PxQueryFilterCallback* filterCallback, const PxQueryFilterData& filterData,
  const PxVehiclePhysXMaterialFrictionParams& materialFrictionParams,
- const PxF32 steerAngle, const PxVehicleRigidBodyState& rigidBodyState, 
- const PxScene& scene, const PxConvexMesh* unitCylinderSweepMesh, 
- const PxVehicleFrame& frame,
+ const PxScene& scene,
  PxVehicleRoadGeometryState& roadGeomState,
  PxVehiclePhysXRoadGeometryQueryState* physxRoadGeometryState)
 {
-	if(PxVehiclePhysXRoadGeometryQueryType::eRAYCAST == queryType)
+	//Assume no hits until we know otherwise.
+	roadGeomState.setToDefault();
+
+	//Perform the raycast.
+	PxRaycastBuffer buff;
+	scene.raycast(v, w, dist, buff, PxHitFlag::eDEFAULT, filterData, filterCallback);
+
+	//Process the raycast result.
+	if(buff.hasBlock && buff.block.distance != 0.0f)
 	{
-		//Assume no hits until we know otherwise.
-		roadGeomState.setToDefault();
+		const PxPlane hitPlane(v + w * buff.block.distance, buff.block.normal);
+		roadGeomState.plane = hitPlane;
+		roadGeomState.hitState = true;
+		PxMaterial* hitMaterial;
+		roadGeomState.friction = computeMaterialFriction(buff.block.shape, buff.block.faceIndex, materialFrictionParams,
+			hitMaterial);
+		roadGeomState.velocity = computeVelocity(*buff.block.actor, buff.block.position);
 
-		//Compute the start pos, dir and length of raycast.
-		PxVec3 v, w;
-		PxF32 dist;
-		PxVehicleComputeSuspensionRaycast(frame, wheelParams, suspParams, steerAngle, rigidBodyState.pose, v, w, dist);
+		if (physxRoadGeometryState)
+		{
+			copyHitInfo(buff.block, hitMaterial, *physxRoadGeometryState);
+		}
+		return buff.block.actor;
+	}
+	else
+	{
+		if (physxRoadGeometryState)
+			physxRoadGeometryState->setToDefault();
+		return NULL;
+	}
+}
 
-		//Perform the raycast.
-		PxRaycastBuffer buff;
-		scene.raycast(v, w, dist, buff, PxHitFlag::eDEFAULT, filterData, filterCallback);
+//Returns the hit actor, or NULL if no road geometry was found under the wheel.
+static const PxRigidActor* sweepRoadGeometry
+(const PxTransform& T, const PxVec3& w, const PxF32 dist,
+ const PxVehicleWheelParams& wheelParams,
+ PxQueryFilterCallback* filterCallback, const PxQueryFilterData& filterData,
+ const PxVehiclePhysXMaterialFrictionParams& materialFrictionParams,
+ const PxScene& scene, const PxConvexMesh* unitCylinderSweepMesh,
+ const PxVehicleFrame& frame,
+ PxVehicleRoadGeometryState& roadGeomState,
+ PxVehiclePhysXRoadGeometryQueryState* physxRoadGeometryState)
+{
+	PX_ASSERT(unitCylinderSweepMesh);
 
-		//Process the raycast result.
-		if(buff.hasBlock && buff.block.distance != 0.0f)
+	//Assume no hits until we know otherwise.
+	roadGeomState.setToDefault();
+
+	//Scale the unit cylinder.
+	const PxVec3 scale = PxVehicleComputeTranslation(frame, wheelParams.radius, wheelParams.halfWidth, wheelParams.radius).abs();
+	const PxMeshScale meshScale(scale, PxQuat(PxIdentity));
+	const PxConvexMeshGeometry convMeshGeom(const_cast<PxConvexMesh*>(unitCylinderSweepMesh), meshScale);
+
+	//Perform the sweep.
+	PxSweepBuffer buff;
+	scene.sweep(convMeshGeom, T, w, dist, buff, PxHitFlag::eDEFAULT | PxHitFlag::eMTD, filterData, filterCallback);
+
+	//Process the sweep result.
+	if (buff.hasBlock && buff.block.distance >= 0.0f)
+	{
+		//Sweep started outside scene geometry.
+		const PxPlane hitPlane(buff.block.position, buff.block.normal);
+		roadGeomState.plane = hitPlane;
+		roadGeomState.hitState = true;
+		PxMaterial* hitMaterial;
+		roadGeomState.friction = computeMaterialFriction(buff.block.shape, buff.block.faceIndex, materialFrictionParams,
+			hitMaterial);
+		roadGeomState.velocity = computeVelocity(*buff.block.actor, buff.block.position);
+
+		if (physxRoadGeometryState)
 		{
-			const PxPlane hitPlane(v + w * buff.block.distance, buff.block.normal);
+			copyHitInfo(buff.block, hitMaterial, *physxRoadGeometryState);
+		}
+		return buff.block.actor;
+	}
+	else if (buff.hasBlock && buff.block.distance < 0.0f)
+	{
+		//The sweep started inside scene geometry.
+		//We want to have another go but this time starting outside the hit geometry because this is the most reliable 
+		//way to get a hit plane.
+		//-buff.block.distance is the distance we need to move along buff.block.normal to be outside the hit geometry.
+		//Note that buff.block.distance can be a vanishingly small number.  Moving along the normal by a vanishingly 
+		//small number might not push us out of overlap due to numeric precision of the overlap test.
+		//We want to move a numerically significant distance to guarantee that we change the overlap status
+		//at the start pose of the sweep.
+		//We achieve this by choosing a minimum translation that is numerically significant.
+		//Any number will do but we choose the wheel radius because this ought to be a numerically significant value.  
+		//We're only sweeping against the hit shape and not against the scene
+		//so we don't risk hitting other stuff by moving a numerically significant distance.
+		const PxVec3 unitDir = -buff.block.normal;
+		const PxF32 maxDist = PxMax(wheelParams.radius, -buff.block.distance);
+		const PxGeometry& geom0 = convMeshGeom;
+		const PxTransform pose0(T.p + buff.block.normal*(maxDist*1.01f), T.q);
+		const PxGeometry& geom1 = buff.block.shape->getGeometry();
+		const PxTransform pose1 = buff.block.actor->getGlobalPose()*buff.block.shape->getLocalPose();
+		PxGeomSweepHit buff2;
+		const bool b2 = PxGeometryQuery::sweep(
+			unitDir, maxDist*1.02f,
+			geom0, pose0, geom1, pose1, buff2, PxHitFlag::eDEFAULT | PxHitFlag::eMTD);
+
+		if (b2 && buff2.distance > 0.0f)
+		{
+			//Sweep started outside scene geometry.
+			const PxPlane hitPlane(buff2.position, buff2.normal);
 			roadGeomState.plane = hitPlane;
 			roadGeomState.hitState = true;
 			PxMaterial* hitMaterial;
@@ -125,106 +211,239 @@ void PxVehiclePhysXRoadGeometryQueryUpdate
 			{
 				copyHitInfo(buff.block, hitMaterial, *physxRoadGeometryState);
 			}
+			return buff.block.actor;
 		}
 		else
 		{
 			if (physxRoadGeometryState)
 				physxRoadGeometryState->setToDefault();
+			return NULL;
 		}
 	}
-	else if(PxVehiclePhysXRoadGeometryQueryType::eSWEEP == queryType)
+	else
 	{
-		PX_ASSERT(unitCylinderSweepMesh);
+		if (physxRoadGeometryState)
+			physxRoadGeometryState->setToDefault();
+		return NULL;
+	}
+}
 
-		//Assume no hits until we know otherwise.
-		roadGeomState.setToDefault();
+void PxVehiclePhysXRoadGeometryQueryUpdate
+(const PxVehicleWheelParams& wheelParams, const PxVehicleSuspensionParams& suspParams,
+ const PxVehiclePhysXRoadGeometryQueryType::Enum queryType, 
+ PxQueryFilterCallback* filterCallback, const PxQueryFilterData& filterData,
+ const PxVehiclePhysXMaterialFrictionParams& materialFrictionParams,
+ const PxF32 steerAngle, const PxVehicleRigidBodyState& rigidBodyState, 
+ const PxScene& scene, const PxConvexMesh* unitCylinderSweepMesh, 
+ const PxVehicleFrame& frame,
+ PxVehicleRoadGeometryState& roadGeomState,
+ PxVehiclePhysXRoadGeometryQueryState* physxRoadGeometryState)
+{
+	if(PxVehiclePhysXRoadGeometryQueryType::eRAYCAST == queryType)
+	{
+		//Compute the start pos, dir and length of raycast.
+		PxVec3 v, w;
+		PxF32 dist;
+		PxVehicleComputeSuspensionRaycast(frame, wheelParams, suspParams, steerAngle, rigidBodyState.pose, v, w, dist);
 
+		raycastRoadGeometry(v, w, dist, filterCallback, filterData, materialFrictionParams, scene,
+			roadGeomState, physxRoadGeometryState);
+	}
+	else if(PxVehiclePhysXRoadGeometryQueryType::eSWEEP == queryType)
+	{
 		//Compute the start pose, dir and length of sweep.
 		PxTransform T;
 		PxVec3 w;
 		PxF32 dist;
 		PxVehicleComputeSuspensionSweep(frame, suspParams, steerAngle, rigidBodyState.pose, T, w, dist);
 
-		//Scale the unit cylinder.
-		const PxVec3 scale = PxVehicleComputeTranslation(frame, wheelParams.radius, wheelParams.halfWidth, wheelParams.radius).abs();
-		const PxMeshScale meshScale(scale, PxQuat(PxIdentity));
-		const PxConvexMeshGeometry convMeshGeom(const_cast<PxConvexMesh*>(unitCylinderSweepMesh), meshScale);
+		sweepRoadGeometry(T, w, dist, wheelParams, filterCallback, filterData, materialFrictionParams,
+			scene, unitCylinderSweepMesh, frame, roadGeomState, physxRoadGeometryState);
+	}
+}
+
+//Compute the start pose, dir and length of the scene query of a wheel.
+//Raycasts only use the position of the start pose.
+static PX_FORCE_INLINE void computeBatchEntryQuery
+(const PxVehiclePhysXRoadGeometryQueryBatchEntry& entry, const PxVehiclePhysXRoadGeometryQueryType::Enum queryType,
+ const PxVehicleFrame& frame, PxTransform& start, PxVec3& dir, PxF32& dist)
+{
+	if(PxVehiclePhysXRoadGeometryQueryType::eRAYCAST == queryType)
+	{
+		start.q = PxQuat(PxIdentity);
+		PxVehicleComputeSuspensionRaycast(frame, *entry.wheelParams, *entry.suspensionParams, entry.steerAngle, entry.rigidBodyState->pose,
+			start.p, dir, dist);
+	}
+	else
+	{
+		PxVehicleComputeSuspensionSweep(frame, *entry.suspensionParams, entry.steerAngle, entry.rigidBodyState->pose,
+			start, dir, dist);
+	}
+}
+
+//A cached result can be reused if the query barely moved since it was computed.
+static PX_FORCE_INLINE bool isCacheValid
+(const PxVehiclePhysXRoadGeometryQueryCacheState& cache, const PxTransform& start, const PxVec3& dir, const PxF32 dist,
+ const PxReal cacheTolerance)
+{
+	const PxReal cosAngleTolerance = 0.9999f;
+	return cache.valid &&
+		(start.p - cache.queryStart.p).magnitudeSquared() <= cacheTolerance*cacheTolerance &&
+		PxAbs(start.q.dot(cache.queryStart.q)) >= cosAngleTolerance &&
+		dir.dot(cache.queryDir) >= cosAngleTolerance &&
+		PxAbs(dist - cache.queryDist) <= cacheTolerance;
+}
 
-		//Perform the sweep.
-		PxSweepBuffer buff;
-		scene.sweep(convMeshGeom, T, w, dist, buff, PxHitFlag::eDEFAULT | PxHitFlag::eMTD, filterData, filterCallback);
+//Interleave the bits of 3 10-bit coordinates.
+static PX_FORCE_INLINE PxU32 expandBits(PxU32 v)
+{
+	v = (v * 0x00010001u) & 0xFF0000FFu;
+	v = (v * 0x00000101u) & 0x0F00F00Fu;
+	v = (v * 0x00000011u) & 0xC30C30C3u;
+	v = (v * 0x00000005u) & 0x49249249u;
+	return v;
+}
 
-		//Process the sweep result.
-		if (buff.hasBlock && buff.block.distance >= 0.0f)
+static PX_FORCE_INLINE PxU32 computeMortonCode(const PxVec3& p, const PxVec3& minimum, const PxVec3& scale)
+{
+	const PxU32 x = PxU32(PxClamp((p.x - minimum.x) * scale.x, 0.0f, 1023.0f));
+	const PxU32 y = PxU32(PxClamp((p.y - minimum.y) * scale.y, 0.0f, 1023.0f));
+	const PxU32 z = PxU32(PxClamp((p.z - minimum.z) * scale.z, 0.0f, 1023.0f));
+	return (expandBits(x) << 2) | (expandBits(y) << 1) | expandBits(z);
+}
+
+namespace
+{
+	struct MortonKeyLess
+	{
+		MortonKeyLess(const PxU32* keys) : mKeys(keys) {}
+
+		PX_FORCE_INLINE bool operator()(const PxU32 a, const PxU32 b) const
 		{
-			//Sweep started outside scene geometry.
-			const PxPlane hitPlane(buff.block.position, buff.block.normal);
-			roadGeomState.plane = hitPlane;
-			roadGeomState.hitState = true;
-			PxMaterial* hitMaterial;
-			roadGeomState.friction = computeMaterialFriction(buff.block.shape, buff.block.faceIndex, materialFrictionParams,
-				hitMaterial);
-			roadGeomState.velocity = computeVelocity(*buff.block.actor, buff.block.position);
+			return mKeys[a] < mKeys[b];
+		}
 
-			if (physxRoadGeometryState)
-			{
-				copyHitInfo(buff.block, hitMaterial, *physxRoadGeometryState);
-			}
+		const PxU32* mKeys;
+	};
+}
+
+static void queryBatchEntry
+(const PxVehiclePhysXRoadGeometryQueryBatchEntry& entry, const PxTransform& start, const PxVec3& dir, const PxF32 dist,
+ const PxVehiclePhysXRoadGeometryQueryType::Enum queryType, PxQueryFilterCallback* filterCallback,
+ const PxScene& scene, const PxConvexMesh* unitCylinderSweepMesh, const PxVehicleFrame& frame)
+{
+	const PxQueryFilterData filterData = entry.filterData ? *entry.filterData : PxQueryFilterData();
+	PxVehiclePhysXRoadGeometryQueryCacheState* cache = entry.cacheState;
+	PxVehiclePhysXRoadGeometryQueryState* physxState = cache ? &cache->physxRoadGeomState : entry.physxRoadGeomState;
+
+	const PxRigidActor* hitActor;
+	if(PxVehiclePhysXRoadGeometryQueryType::eRAYCAST == queryType)
+	{
+		hitActor = raycastRoadGeometry(start.p, dir, dist, filterCallback, filterData, *entry.materialFrictionParams, scene,
+			*entry.roadGeomState, physxState);
+	}
+	else
+	{
+		hitActor = sweepRoadGeometry(start, dir, dist, *entry.wheelParams, filterCallback, filterData, *entry.materialFrictionParams,
+			scene, unitCylinderSweepMesh, frame, *entry.roadGeomState, physxState);
+	}
+
+	if(cache)
+	{
+		if(entry.physxRoadGeomState)
+			*entry.physxRoadGeomState = cache->physxRoadGeomState;
+
+		//Only hits against static actors are cached. Anything else can move independently of the wheel.
+		cache->valid = hitActor && hitActor->getConcreteType() == PxConcreteType::eRIGID_STATIC;
+		cache->queryStart = start;
+		cache->queryDir = dir;
+		cache->queryDist = dist;
+		cache->roadGeomState = *entry.roadGeomState;
+	}
+}
+
+void PxVehiclePhysXRoadGeometryQueryBatchUpdate
+(const PxVehiclePhysXRoadGeometryQueryBatchEntry* entries, const PxU32 nbEntries, PxU32* sortBuffer,
+ const PxVehiclePhysXRoadGeometryQueryType::Enum queryType, PxQueryFilterCallback* filterCallback,
+ const PxReal cacheTolerance,
+ const PxScene& scene, const PxConvexMesh* unitCylinderSweepMesh,
+ const PxVehicleFrame& frame)
+{
+	if(PxVehiclePhysXRoadGeometryQueryType::eNONE == queryType)
+		return;
+
+	//First pass: resolve the wheels that can reuse their cached result.
+	//Without a sort buffer, the other wheels are queried immediately in input order.
+	//With a sort buffer, their indices are gathered at the start of the buffer.
+	PxU32 nbToQuery = 0;
+	PxBounds3 bounds = PxBounds3::empty();
+	for(PxU32 i = 0; i < nbEntries; i++)
+	{
+		const PxVehiclePhysXRoadGeometryQueryBatchEntry& entry = entries[i];
+
+		PxTransform start;
+		PxVec3 dir;
+		PxF32 dist;
+		computeBatchEntryQuery(entry, queryType, frame, start, dir, dist);
+
+		if(entry.cacheState && cacheTolerance > 0.0f && isCacheValid(*entry.cacheState, start, dir, dist, cacheTolerance))
+		{
+			*entry.roadGeomState = entry.cacheState->roadGeomState;
+			if(entry.physxRoadGeomState)
+				*entry.physxRoadGeomState = entry.cacheState->physxRoadGeomState;
 		}
-		else if (buff.hasBlock && buff.block.distance < 0.0f)
+		else if(sortBuffer)
 		{
-			//The sweep started inside scene geometry.
-			//We want to have another go but this time starting outside the hit geometry because this is the most reliable 
-			//way to get a hit plane.
-			//-buff.block.distance is the distance we need to move along buff.block.normal to be outside the hit geometry.
-			//Note that buff.block.distance can be a vanishingly small number.  Moving along the normal by a vanishingly 
-			//small number might not push us out of overlap due to numeric precision of the overlap test.
-			//We want to move a numerically significant distance to guarantee that we change the overlap status
-			//at the start pose of the sweep.
-			//We achieve this by choosing a minimum translation that is numerically significant.
-			//Any number will do but we choose the wheel radius because this ought to be a numerically significant value.  
-			//We're only sweeping against the hit shape and not against the scene
-			//so we don't risk hitting other stuff by moving a numerically significant distance.
-			const PxVec3 unitDir = -buff.block.normal;
-			const PxF32 maxDist = PxMax(wheelParams.radius, -buff.block.distance);
-			const PxGeometry& geom0 = convMeshGeom;
-			const PxTransform pose0(T.p + buff.block.normal*(maxDist*1.01f), T.q);
-			const PxGeometry& geom1 = buff.block.shape->getGeometry();
-			const PxTransform pose1 = buff.block.actor->getGlobalPose()*buff.block.shape->getLocalPose();
-			PxGeomSweepHit buff2;
-			const bool b2 = PxGeometryQuery::sweep(
-				unitDir, maxDist*1.02f,
-				geom0, pose0, geom1, pose1, buff2, PxHitFlag::eDEFAULT | PxHitFlag::eMTD);
-
-			if (b2 && buff2.distance > 0.0f)
-			{
-				//Sweep started outside scene geometry.
-				const PxPlane hitPlane(buff2.position, buff2.normal);
-				roadGeomState.plane = hitPlane;
-				roadGeomState.hitState = true;
-				PxMaterial* hitMaterial;
-				roadGeomState.friction = computeMaterialFriction(buff.block.shape, buff.block.faceIndex, materialFrictionParams,
-					hitMaterial);
-				roadGeomState.velocity = computeVelocity(*buff.block.actor, buff.block.position);
-
-				if (physxRoadGeometryState)
-				{
-					copyHitInfo(buff.block, hitMaterial, *physxRoadGeometryState);
-				}
-			}
-			else
-			{
-				if (physxRoadGeometryState)
-					physxRoadGeometryState->setToDefault();
-			}
+			sortBuffer[nbToQuery++] = i;
+			bounds.include(start.p);
 		}
 		else
 		{
-			if (physxRoadGeometryState)
-				physxRoadGeometryState->setToDefault();
+			queryBatchEntry(entry, start, dir, dist, queryType, filterCallback, scene, unitCylinderSweepMesh, frame);
+		}
+	}
+
+	if(!nbToQuery)
+		return;
+
+	//Sort the remaining wheels along a Morton curve over their query start positions, so that
+	//consecutive queries traverse the same parts of the scene-query trees.
+	//The query of each wheel is recomputed rather than stored: it is cheap compared to the scene query.
+	if(nbToQuery > 1)
+	{
+		const PxVec3 extents = bounds.maximum - bounds.minimum;
+		const PxVec3 scale(
+			extents.x > 0.0f ? 1023.0f / extents.x : 0.0f,
+			extents.y > 0.0f ? 1023.0f / extents.y : 0.0f,
+			extents.z > 0.0f ? 1023.0f / extents.z : 0.0f);
+
+		//Keys are indexed by entry and stored after the wheel indices.
+		PxU32* keys = sortBuffer + nbEntries;
+		for(PxU32 j = 0; j < nbToQuery; j++)
+		{
+			const PxU32 i = sortBuffer[j];
+			PxTransform start;
+			PxVec3 dir;
+			PxF32 dist;
+			computeBatchEntryQuery(entries[i], queryType, frame, start, dir, dist);
+			keys[i] = computeMortonCode(start.p, bounds.minimum, scale);
 		}
+
+		PxSort(sortBuffer, nbToQuery, MortonKeyLess(keys));
 	}
 
+	//Second pass: perform the scene queries in sorted order.
+	for(PxU32 j = 0; j < nbToQuery; j++)
+	{
+		const PxVehiclePhysXRoadGeometryQueryBatchEntry& entry = entries[sortBuffer[j]];
+
+		PxTransform start;
+		PxVec3 dir;
+		PxF32 dist;
+		computeBatchEntryQuery(entry, queryType, frame, start, dir, dist);
+
+		queryBatchEntry(entry, start, dir, dist, queryType, filterCallback, scene, unitCylinderSweepMesh, frame);
+	}
 }
 
 } //namespace vehicle2
@@ -0,0 +1,206 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#include "PxPvdAsyncTransport.h"
+
+#include "foundation/PxAllocator.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxUtilities.h"
+
+namespace physx
+{
+namespace pvdsdk
+{
+void PvdAsyncTransportThread::execute()
+{
+	mOwner.runSender();
+	quit();
+}
+
+PvdAsyncTransport::PvdAsyncTransport(PxPvdTransport& target, uint32_t bufferSize)
+: mTarget(target)
+, mThread(*this)
+, mCapacity(bufferSize)
+, mFrontSize(0)
+, mBackSize(0)
+, mFailed(0)
+, mWrittenData(0)
+{
+	mFront = PX_ALLOCATE(uint8_t, bufferSize, "PvdAsyncTransport");
+	mBack = PX_ALLOCATE(uint8_t, bufferSize, "PvdAsyncTransport");
+	mThread.start();
+	mThread.setName("PxPvdAsyncTransport");
+}
+
+PvdAsyncTransport::~PvdAsyncTransport()
+{
+	submitFront();
+	waitForBack();
+
+	mThread.signalQuit();
+	mBufferReady.set();
+	mThread.waitForQuit();
+
+	PX_FREE(mBack);
+	PX_FREE(mFront);
+}
+
+void PvdAsyncTransport::runSender()
+{
+	while(true)
+	{
+		mBufferReady.wait();
+		mBufferReady.reset();
+
+		if(mBackSize)
+		{
+			// The target is only written from this thread while the sender runs, so it doesn't need its own lock.
+			// A failed write means the connection is dead, the next write() reports it to the PVD client.
+			if(!mTarget.write(mBack, uint32_t(mBackSize)))
+				PxAtomicExchange(&mFailed, 1);
+			mTarget.flush();
+			PxAtomicExchange(&mBackSize, 0);
+			mBufferWritten.set();
+		}
+
+		if(mThread.quitIsSignalled())
+			break;
+	}
+}
+
+void PvdAsyncTransport::waitForBack()
+{
+	while(mBackSize)
+		mBufferWritten.wait();
+}
+
+void PvdAsyncTransport::submitFront()
+{
+	if(!mFrontSize)
+		return;
+
+	waitForBack();
+
+	// The sender thread is idle here, it cannot set mBufferWritten before the next submission
+	mBufferWritten.reset();
+	PxSwap(mFront, mBack);
+	PxAtomicExchange(&mBackSize, int32_t(mFrontSize));
+	mFrontSize = 0;
+	mBufferReady.set();
+}
+
+bool PvdAsyncTransport::connect()
+{
+	mFailed = 0;
+	return mTarget.connect();
+}
+
+void PvdAsyncTransport::disconnect()
+{
+	mMutex.lock();
+	submitFront();
+	waitForBack();
+	mMutex.unlock();
+	mTarget.disconnect();
+}
+
+bool PvdAsyncTransport::isConnected()
+{
+	return !mFailed && mTarget.isConnected();
+}
+
+bool PvdAsyncTransport::write(const uint8_t* inBytes, uint32_t inLength)
+{
+	if(mFailed)
+		return false;
+
+	if(inLength == 0)
+		return true;
+
+	if(inLength > mCapacity - mFrontSize)
+	{
+		// Only blocks when the sender is still busy with the previous buffer, i.e. when bandwidth is short
+		submitFront();
+
+		// Large writes go to the target directly, once the previous data has been sent to keep the order
+		if(inLength > mCapacity)
+		{
+			waitForBack();
+			if(!mTarget.write(inBytes, inLength))
+				return false;
+			mWrittenData += inLength;
+			return true;
+		}
+	}
+
+	PxMemCopy(mFront + mFrontSize, inBytes, inLength);
+	mFrontSize += inLength;
+	mWrittenData += inLength;
+	return true;
+}
+
+PxPvdTransport& PvdAsyncTransport::lock()
+{
+	mMutex.lock();
+	return *this;
+}
+
+void PvdAsyncTransport::unlock()
+{
+	mMutex.unlock();
+}
+
+void PvdAsyncTransport::flush()
+{
+	// Unlike the socket transport we don't wait for the data to be on the wire: the pending data is handed to the
+	// sender thread if it is idle, otherwise it is kept and sent with the next buffer.
+	mMutex.lock();
+	if(!mBackSize)
+		submitFront();
+	mMutex.unlock();
+}
+
+uint64_t PvdAsyncTransport::getWrittenDataSize()
+{
+	return mWrittenData;
+}
+
+void PvdAsyncTransport::release()
+{
+	PX_DELETE_THIS;
+}
+
+} // namespace pvdsdk
+
+PxPvdTransport* PxPvdAsyncTransportCreate(PxPvdTransport& target, unsigned int bufferSize)
+{
+	if(!bufferSize || bufferSize > 0x7fffffff)
+		return NULL;
+	return PX_NEW(pvdsdk::PvdAsyncTransport)(target, bufferSize);
+}
+
+} // namespace physx
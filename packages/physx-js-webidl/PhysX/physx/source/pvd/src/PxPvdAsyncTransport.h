@@ -0,0 +1,103 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2025 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_PVD_ASYNC_TRANSPORT_H
+#define PX_PVD_ASYNC_TRANSPORT_H
+
+#include "pvd/PxPvdTransport.h"
+
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxSync.h"
+#include "foundation/PxThread.h"
+
+namespace physx
+{
+namespace pvdsdk
+{
+class PvdAsyncTransport;
+
+class PvdAsyncTransportThread : public PxThread
+{
+	PX_NOCOPY(PvdAsyncTransportThread)
+  public:
+	PvdAsyncTransportThread(PvdAsyncTransport& owner) : mOwner(owner)
+	{
+	}
+	virtual void execute();
+
+  private:
+	PvdAsyncTransport& mOwner;
+};
+
+// Double buffering: the PVD client fills the front buffer under the transport lock, the background thread writes the
+// back buffer to the target transport. mBackSize is non-zero while the back buffer is pending.
+class PvdAsyncTransport : public PxPvdTransport, public PxUserAllocated
+{
+	PX_NOCOPY(PvdAsyncTransport)
+  public:
+	PvdAsyncTransport(PxPvdTransport& target, uint32_t bufferSize);
+	virtual ~PvdAsyncTransport();
+
+	virtual bool connect();
+	virtual void disconnect();
+	virtual bool isConnected();
+
+	virtual bool write(const uint8_t* inBytes, uint32_t inLength);
+
+	virtual void flush();
+
+	virtual PxPvdTransport& lock();
+	virtual void unlock();
+
+	virtual uint64_t getWrittenDataSize();
+
+	virtual void release();
+
+	void runSender();
+
+  private:
+	void submitFront();
+	void waitForBack();
+
+	PxPvdTransport& mTarget;
+	PvdAsyncTransportThread mThread;
+	PxSync mBufferReady;
+	PxSync mBufferWritten;
+	PxMutex mMutex;
+	uint8_t* mFront;
+	uint8_t* mBack;
+	uint32_t mCapacity;
+	uint32_t mFrontSize;
+	volatile int32_t mBackSize;
+	volatile int32_t mFailed;
+	uint64_t mWrittenData;
+};
+
+} // pvdsdk
+} // physx
+
+#endif
@@ -104,7 +104,7 @@ namespace Sq
 
 						void					flushMemory();
 						void					preallocate(PxU32 nbShapes);
-						void					flushShapes(const Adapter& adapter, float inflation);
+						void					flushShapes(const Adapter& adapter, float inflation, PxCpuDispatcher* dispatcher = NULL);
 						void					addToDirtyList(PrunerCompoundId compoundId, Gu::PrunerHandle handle, const PxTransform& transform);
 						void					removeFromDirtyList(PrunerCompoundId compoundId, Gu::PrunerHandle handle);						
 
@@ -113,6 +113,9 @@ namespace Sq
 
 						CompoundPruner*			mPruner;						
 						CompoundPrunerSet		mDirtyList;
+						PxArray<CompoundPair>	mFlushPairs;
+						PxArray<PrunerCompoundId>	mFlushCompoundIds;
+						PxArray<Gu::PrunerHandle>	mFlushHandles;
 
 						PX_NOCOPY(CompoundPrunerExt)
 
@@ -172,6 +175,9 @@ namespace Sq
 						void							flushMemory();
 		PX_FORCE_INLINE PxU32							getStaticTimestamp()	const	{ return mStaticTimestamp;	}
 		PX_FORCE_INLINE const Adapter&					getAdapter()			const	{ return mAdapter;			}
+
+		// PT: dispatcher used to process compound updates in parallel in flushUpdates(), or NULL
+		PX_FORCE_INLINE	void							setCpuDispatcher(PxCpuDispatcher* dispatcher)	{ mDispatcher = dispatcher;	}
 	private:
 						const Adapter&					mAdapter;
 						PrunerExt						mPrunerExt[PruningIndex::eCOUNT];
@@ -181,6 +187,7 @@ namespace Sq
 						PxU32							mStaticTimestamp;
 						PxU32							mRebuildRateHint;
 						const float						mInflation;	// SQ_PRUNER_EPSILON
+						PxCpuDispatcher*				mDispatcher;
 
 						PxMutex							mSQLock;  // to make sure only one query updates the dirty pruner structure if multiple queries run in parallel
 
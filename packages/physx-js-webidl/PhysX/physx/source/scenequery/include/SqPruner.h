@@ -37,6 +37,8 @@
 
 namespace physx
 {	
+class PxCpuDispatcher;
+
 namespace Gu
 {
 	class BVH;
@@ -123,6 +125,16 @@ class CompoundPruner : public Gu::BasePruner
 	*/
 	virtual void					updateObjectAfterManualBoundsUpdates(PrunerCompoundId compoundId, const Gu::PrunerHandle handle) = 0;
 
+	/**
+	Updates objects after manually updating their bounds via "getPayload" calls. Compound trees are refit in parallel
+	and each compound's bounds are updated once, however many of its objects changed.
+	\param		compoundIds	[in]	compounds that the objects belong to, sorted so that objects of a compound are contiguous
+	\param		handles		[in]	the objects to update
+	\param		nbObjects	[in]	number of objects
+	\param		dispatcher	[in]	dispatcher used to refit compound trees in parallel, or NULL
+	*/
+	virtual void					updateObjectsAfterManualBoundsUpdates(const PrunerCompoundId* compoundIds, const Gu::PrunerHandle* handles, PxU32 nbObjects, PxCpuDispatcher* dispatcher) = 0;
+
 	/**
 	Removes object from compound pruner.
 	\param		compoundId	[in]	compound that the object belongs to	 
@@ -150,6 +162,7 @@ class CompoundPruner : public Gu::BasePruner
 	virtual	bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, CompoundPrunerRaycastCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
 	virtual	bool					overlap(const Gu::ShapeData& queryVolume, CompoundPrunerOverlapCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
 	virtual	bool					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, CompoundPrunerRaycastCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
+	virtual	bool					cull(PxU32 nbPlanes, const PxPlane* planes, CompoundPrunerOverlapCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
 
 	/**
 	\brief	Retrieves the object's payload and data associated with the handle.
@@ -41,6 +41,7 @@
 #include "common/PxRenderBuffer.h"
 #include "common/PxRenderOutput.h"
 #include "CmVisualization.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 using namespace Gu;
@@ -545,6 +546,56 @@ bool BVHCompoundPruner::overlap(const ShapeData& queryVolume, CompoundPrunerOver
 	return again;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// cull main tree callback
+struct MainTreeCullCompoundPrunerCallback : MainTreeCompoundPrunerCallback<CompoundPrunerOverlapCallback>
+{
+	MainTreeCullCompoundPrunerCallback(PxU32 nbPlanes, const PxPlane* planes, CompoundPrunerOverlapCallback& prunerCallback, PxCompoundPrunerQueryFlags flags, const CompoundTree* compoundTrees)
+		: MainTreeCompoundPrunerCallback(prunerCallback, flags, compoundTrees), mNbPlanes(nbPlanes), mPlanes(planes)
+	{
+	}
+
+	virtual ~MainTreeCullCompoundPrunerCallback() {}
+
+	bool invoke(PxU32 primIndex)
+	{
+		const CompoundTree& compoundTree = mCompoundTrees[primIndex];
+
+		if(filtering(compoundTree))
+			return true;
+
+		// transfer the planes to actor local space
+		PxPlane localPlanes[32];
+		for(PxU32 i=0;i<mNbPlanes;i++)
+			localPlanes[i] = mPlanes[i].inverseTransform(compoundTree.mGlobalPose);
+
+		// cull the compound local tree
+		CompoundCallbackOverlapAdapter pcb(mPrunerCallback, compoundTree);
+		return AABBTreeCull<true, IncrementalAABBTree, IncrementalAABBTreeNode, CompoundCallbackOverlapAdapter>()
+			(compoundTree.mPruningPool->getCurrentAABBTreeBounds(), *compoundTree.mTree, mNbPlanes, localPlanes, pcb);
+	}
+
+	PX_NOCOPY(MainTreeCullCompoundPrunerCallback)
+
+private:
+	const PxU32		mNbPlanes;
+	const PxPlane*	mPlanes;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// cull implementation
+bool BVHCompoundPruner::cull(PxU32 nbPlanes, const PxPlane* planes, CompoundPrunerOverlapCallback& prunerCallback, PxCompoundPrunerQueryFlags flags) const
+{
+	if(!mMainTree.getNodes())
+		return true;
+
+	PX_ASSERT(nbPlanes<=32);
+
+	MainTreeCullCompoundPrunerCallback pcb(nbPlanes, planes, prunerCallback, flags, mCompoundTreePool.getCompoundTrees());
+	return AABBTreeCull<true, IncrementalAABBTree, IncrementalAABBTreeNode, MainTreeCullCompoundPrunerCallback>()
+		(mCompoundTreePool.getCurrentAABBTreeBounds(), mMainTree, nbPlanes, planes, pcb);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 bool BVHCompoundPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, CompoundPrunerRaycastCallback& prunerCallback, PxCompoundPrunerQueryFlags flags) const
@@ -618,6 +669,72 @@ void BVHCompoundPruner::updateObjectAfterManualBoundsUpdates(PrunerCompoundId co
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	// PT: each compound has its own tree, pruning pool and update map, so different compounds can be refit concurrently
+	class CompoundRefitTask : public Cm::ParallelForCallback
+	{
+		PX_NOCOPY(CompoundRefitTask)
+		public:
+			CompoundRefitTask(CompoundTree* trees, const CompoundRefitRun* runs, const PrunerHandle* handles) :
+				mTrees(trees), mRuns(runs), mHandles(handles)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				for(PxU32 i=startIndex;i<endIndex;i++)
+				{
+					const CompoundRefitRun& run = mRuns[i];
+					CompoundTree& compoundTree = mTrees[run.mPoolIndex];
+					for(PxU32 j=run.mStart;j<run.mEnd;j++)
+						compoundTree.updateObjectAfterManualBoundsUpdates(mHandles[j]);
+				}
+			}
+
+			CompoundTree*			mTrees;
+			const CompoundRefitRun*	mRuns;
+			const PrunerHandle*		mHandles;
+	};
+}
+
+void BVHCompoundPruner::updateObjectsAfterManualBoundsUpdates(const PrunerCompoundId* compoundIds, const PrunerHandle* handles, PxU32 nbObjects, PxCpuDispatcher* dispatcher)
+{
+	mRefitRuns.clear();
+
+	PxU32 start = 0;
+	while(start<nbObjects)
+	{
+		const PrunerCompoundId compoundId = compoundIds[start];
+		PxU32 end = start + 1;
+		while(end<nbObjects && compoundIds[end]==compoundId)
+			end++;
+
+		const ActorIdPoolIndexMap::Entry* poolIndexEntry = mActorPoolMap.find(compoundId);
+		PX_ASSERT(poolIndexEntry);
+		if(poolIndexEntry)
+		{
+			CompoundRefitRun& run = mRefitRuns.insert();
+			run.mPoolIndex	= poolIndexEntry->second;
+			run.mStart		= start;
+			run.mEnd		= end;
+		}
+		start = end;
+	}
+
+	const PxU32 nbRuns = mRefitRuns.size();
+	CompoundRefitTask task(mCompoundTreePool.getCompoundTrees(), mRefitRuns.begin(), handles);
+	Cm::parallelFor(dispatcher, nbRuns, 1, task);
+
+	// PT: the main tree is shared, it is updated serially and only once per compound
+	for(PxU32 i=0;i<nbRuns;i++)
+		updateMainTreeNode(mRefitRuns[i].mPoolIndex);
+
+#if PARANOIA_CHECKS
+	test();
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
 void BVHCompoundPruner::removeObject(PrunerCompoundId compoundId, const PrunerHandle handle, PrunerPayloadRemovalCallback* removalCallback)
 {
 	const ActorIdPoolIndexMap::Entry* poolIndexEntry = mActorPoolMap.find(compoundId);
@@ -46,6 +46,14 @@ namespace Sq
 	typedef PxHashMap<PrunerCompoundId, Gu::PoolIndex>	ActorIdPoolIndexMap;
 	typedef PxArray<PrunerCompoundId>					PoolIndexActorIdMap;
 
+	// PT: objects [mStart, mEnd) of a batched update, all belonging to compound mPoolIndex
+	struct CompoundRefitRun
+	{
+		Gu::PoolIndex	mPoolIndex;
+		PxU32			mStart;
+		PxU32			mEnd;
+	};
+
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
 	class BVHCompoundPruner : public CompoundPruner
@@ -67,11 +75,13 @@ namespace Sq
 		virtual		bool						updateCompound(PrunerCompoundId compoundId, const PxTransform& transform);
 		// object level
 		virtual		void						updateObjectAfterManualBoundsUpdates(PrunerCompoundId compoundId, const Gu::PrunerHandle handle);
+		virtual		void						updateObjectsAfterManualBoundsUpdates(const PrunerCompoundId* compoundIds, const Gu::PrunerHandle* handles, PxU32 nbObjects, PxCpuDispatcher* dispatcher);
 		virtual		void						removeObject(PrunerCompoundId compoundId, const Gu::PrunerHandle handle, Gu::PrunerPayloadRemovalCallback* removalCallback);
 		virtual		bool						addObject(PrunerCompoundId compoundId, Gu::PrunerHandle& result, const PxBounds3& bounds, const Gu::PrunerPayload userData, const PxTransform& transform);
 		//queries
 		virtual		bool						raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, CompoundPrunerRaycastCallback&, PxCompoundPrunerQueryFlags flags) const;
 		virtual		bool						overlap(const Gu::ShapeData& queryVolume, CompoundPrunerOverlapCallback&, PxCompoundPrunerQueryFlags flags) const;
+		virtual		bool						cull(PxU32 nbPlanes, const PxPlane* planes, CompoundPrunerOverlapCallback&, PxCompoundPrunerQueryFlags flags) const;
 		virtual		bool						sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, CompoundPrunerRaycastCallback&, PxCompoundPrunerQueryFlags flags) const;
 		virtual		const Gu::PrunerPayload&	getPayloadData(Gu::PrunerHandle handle, PrunerCompoundId compoundId, Gu::PrunerPayloadData* data) const;
 		virtual		void						preallocate(PxU32 nbEntries);
@@ -93,6 +103,7 @@ namespace Sq
 					ActorIdPoolIndexMap			mActorPoolMap;
 					PoolIndexActorIdMap			mPoolActorMap;
 					Gu::NodeList				mChangedLeaves;
+					PxArray<CompoundRefitRun>	mRefitRuns;
 		mutable		bool						mDrawStatic;
 		mutable		bool						mDrawDynamic;
 	};
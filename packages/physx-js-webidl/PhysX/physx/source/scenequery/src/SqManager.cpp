@@ -33,6 +33,8 @@
 #include "SqManager.h"
 #include "GuSqInternal.h"
 #include "GuBounds.h"
+#include "CmParallelFor.h"
+#include "foundation/PxSort.h"
 
 using namespace physx;
 using namespace Sq;
@@ -68,7 +70,8 @@ void PrunerExt::flushMemory()
 
 	// PT: TODO: flush bitmap here
 
-	// PT: TODO: flush pruner here?
+	if(mPruner)
+		mPruner->shrinkMemory();
 }
 
 void PrunerExt::addToDirtyList(PrunerHandle handle, bool dynamic, const PxTransform& transform)
@@ -185,32 +188,81 @@ void CompoundPrunerExt::flushMemory()
 {
 	if(!mDirtyList.size())
 		mDirtyList.clear();
+
+	mFlushPairs.reset();
+	mFlushCompoundIds.reset();
+	mFlushHandles.reset();
 }
 
-void CompoundPrunerExt::flushShapes(const Adapter& adapter, float inflation)
+// PT: number of dirty compound objects per parallelFor chunk when computing their bounds
+#define SQ_COMPOUND_BOUNDS_GRAIN	64
+
+namespace
+{
+	struct CompoundPairSortPredicate
+	{
+		PX_FORCE_INLINE bool operator()(const CompoundPair& a, const CompoundPair& b) const
+		{
+			return a.first < b.first;
+		}
+	};
+
+	// PT: each object has its own bounds and transform in its compound's pruning pool, so they can be computed concurrently
+	class CompoundBoundsTask : public Cm::ParallelForCallback
+	{
+		PX_NOCOPY(CompoundBoundsTask)
+		public:
+			CompoundBoundsTask(const CompoundPruner& pruner, const Adapter& adapter, float inflation, const PrunerCompoundId* compoundIds, const PrunerHandle* handles) :
+				mPruner(pruner), mAdapter(adapter), mInflation(inflation), mCompoundIds(compoundIds), mHandles(handles)	{}
+
+			virtual	void	process(PxU32 startIndex, PxU32 endIndex)	PX_OVERRIDE
+			{
+				for(PxU32 i=startIndex;i<endIndex;i++)
+				{
+					// PT: we compute the new bounds and store them directly in the pruner structure to avoid copies
+					PrunerPayloadData ppd;
+					const PrunerPayload& pp = mPruner.getPayloadData(mHandles[i], mCompoundIds[i], &ppd);
+
+					computeBounds(*ppd.mBounds, mAdapter.getGeometry(pp), *ppd.mTransform, 0.0f, mInflation);
+				}
+			}
+
+			const CompoundPruner&	mPruner;
+			const Adapter&			mAdapter;
+			const float				mInflation;
+			const PrunerCompoundId*	mCompoundIds;
+			const PrunerHandle*		mHandles;
+	};
+}
+
+void CompoundPrunerExt::flushShapes(const Adapter& adapter, float inflation, PxCpuDispatcher* dispatcher)
 {
 	const PxU32 numDirtyList = mDirtyList.size();
 	if(!numDirtyList)
 		return;
 
+	// PT: dirty objects are grouped per compound, so that each compound tree is refit by a single thread and each
+	// compound's bounds are updated once in the main tree, instead of once per object.
 	const CompoundPair* const compoundPairs = mDirtyList.getEntries();
+	mFlushPairs.clear();
+	mFlushPairs.reserve(numDirtyList);
+	for(PxU32 i=0; i<numDirtyList; i++)
+		mFlushPairs.pushBack(compoundPairs[i]);
+	PxSort(mFlushPairs.begin(), numDirtyList, CompoundPairSortPredicate());
 
+	mFlushCompoundIds.resizeUninitialized(numDirtyList);
+	mFlushHandles.resizeUninitialized(numDirtyList);
 	for(PxU32 i=0; i<numDirtyList; i++)
 	{
-		const PrunerHandle handle = compoundPairs[i].second;
-		const PrunerCompoundId compoundId = compoundPairs[i].first;		
+		mFlushCompoundIds[i] = mFlushPairs[i].first;
+		mFlushHandles[i] = mFlushPairs[i].second;
+	}
 
-		// PT: we compute the new bounds and store them directly in the pruner structure to avoid copies. We delay the updateObjects() call
-		// to take advantage of batching.
-		PrunerPayloadData ppd;
-		const PrunerPayload& pp = mPruner->getPayloadData(handle, compoundId, &ppd);
+	CompoundBoundsTask task(*mPruner, adapter, inflation, mFlushCompoundIds.begin(), mFlushHandles.begin());
+	Cm::parallelFor(dispatcher, numDirtyList, SQ_COMPOUND_BOUNDS_GRAIN, task);
 
-		computeBounds(*ppd.mBounds, adapter.getGeometry(pp), *ppd.mTransform, 0.0f, inflation);
+	mPruner->updateObjectsAfterManualBoundsUpdates(mFlushCompoundIds.begin(), mFlushHandles.begin(), numDirtyList, dispatcher);
 
-		// A.B. not very effective, we might do better here
-		mPruner->updateObjectAfterManualBoundsUpdates(compoundId, handle);
-	}
-		
 	mDirtyList.clear();
 }
 
@@ -252,7 +304,8 @@ PrunerManager::PrunerManager(	PxU64 contextID, Pruner* staticPruner, Pruner* dyn
 	mAdapter			(adapter),
 	mContextID			(contextID),
 	mStaticTimestamp	(0),
-	mInflation			(inflation)
+	mInflation			(inflation),
+	mDispatcher			(NULL)
 {
 	mPrunerExt[PruningIndex::eSTATIC].init(staticPruner);
 	mPrunerExt[PruningIndex::eDYNAMIC].init(dynamicPruner);
@@ -413,7 +466,7 @@ void PrunerManager::flushShapes()
 	if(mustInvalidateStaticTimestamp)
 		invalidateStaticTimestamp();
 
-	mCompoundPrunerExt.flushShapes(mAdapter, inflation);
+	mCompoundPrunerExt.flushShapes(mAdapter, inflation, mDispatcher);
 }
 
 void PrunerManager::flushUpdates()
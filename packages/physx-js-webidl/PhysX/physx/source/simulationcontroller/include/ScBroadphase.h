@@ -30,6 +30,8 @@
 #define SC_BROADPHASE_H
 
 #include "PxvConfig.h"
+#include "PxBroadPhase.h"
+#include "PxFiltering.h"
 #include "foundation/PxArray.h"
 
 // PT: this class captures parts of the Sc::Scene that deals with broadphase matters.
@@ -61,8 +63,21 @@ namespace Sc
 
 							void					flush(Bp::AABBManagerBase* aabbManager);
 
+							// PT: recording of created/deleted pairs for PxScene::getBroadPhaseCreatedPairs() & co
+							void					setPairRecording(bool enable, const PxFilterData& groupMask);
+			PX_FORCE_INLINE	bool					isRecordingPairs()	const	{ return mRecordPairs;	}
+							void					resetRecordedPairs();
+							void					recordPairs(Bp::AABBManagerBase* aabbManager, PxU64 contextID);
+			PX_FORCE_INLINE	const PxArray<PxBroadPhaseShapePair>&	getRecordedCreatedPairs()	const	{ return mRecordedCreatedPairs;	}
+			PX_FORCE_INLINE	const PxArray<PxBroadPhaseShapePair>&	getRecordedDeletedPairs()	const	{ return mRecordedDeletedPairs;	}
+
 							PxBroadPhaseCallback*	mBroadPhaseCallback;
 							PxArray<PxU32>			mOutOfBoundsIDs;
+
+							PxArray<PxBroadPhaseShapePair>	mRecordedCreatedPairs;
+							PxArray<PxBroadPhaseShapePair>	mRecordedDeletedPairs;
+							PxFilterData			mRecordMask;
+							bool					mRecordPairs;
 	};
 
 }
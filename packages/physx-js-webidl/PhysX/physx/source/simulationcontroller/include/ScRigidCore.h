@@ -75,6 +75,9 @@ namespace Sc
 					RigidSim*	getSim() const;
 
 					PxU32		getRigidID() const;
+
+					// PT: returns 0xffffffff if the actor is not simulated in a scene
+					PxU32		getShapeTransformCacheID(const ShapeCore& shape) const;
 	protected:
 								RigidCore(const PxEMPTY) :	ActorCore(PxEmpty)	{}
 								RigidCore(PxActorType::Enum type);
@@ -39,6 +39,7 @@
 #include "CmFlushPool.h"
 #include "CmPreallocatingPool.h"
 #include "foundation/PxBitMap.h"
+#include "foundation/PxTime.h"
 #include "ScIterators.h"
 #include "PxsMaterialManager.h"
 #include "PxvManager.h"
@@ -236,6 +237,7 @@ namespace Sc
 												~Scene() {}	//use release() plz.
 
 					void						preAllocate(PxU32 nbStatics, PxU32 nbBodies, PxU32 nbStaticShapes, PxU32 nbDynamicShapes);
+					void						preAllocateBatchInsertion(PxU32 nbTotalStatics, PxU32 nbTotalBodies, PxU32 nbNewShapes);
 					void						release();
 
 	PX_FORCE_INLINE	PxsSimulationController*	getSimulationController()						{ return mSimulationController;	}
@@ -257,6 +259,12 @@ namespace Sc
 	PX_FORCE_INLINE	void						setGravity(const PxVec3& g)						{ mGravity = g;		}
 	PX_FORCE_INLINE	const PxVec3&				getGravity()							const	{ return mGravity;	}
 
+					PxU32						addFieldEffector(const PxFieldEffector& effector);
+					void						setFieldEffector(PxU32 id, const PxFieldEffector& effector);
+					void						removeFieldEffector(PxU32 id);
+	PX_FORCE_INLINE	bool						isFieldEffectorValid(PxU32 id)			const	{ return id < mFieldEffectors.size() && mFieldEffectorMap.boundedTest(id);	}
+	PX_FORCE_INLINE	PxU32						getNbFieldEffectors()					const	{ return mFieldEffectors.size() - mFreeFieldEffectorIds.size();		}
+
 	PX_FORCE_INLINE void						setElapsedTime(PxReal t)						{ mDt = t; mOneOverDt = t > 0.0f ? 1.0f/t : 0.0f;	}
 	PX_FORCE_INLINE	PxReal						getOneOverDt()							const	{ return mOneOverDt;								}
 //	PX_FORCE_INLINE	PxReal						getDt()									const	{ return mDt;										}
@@ -426,7 +434,10 @@ namespace Sc
 					void						advance(PxReal timeStep, PxBaseTask* continuation);
 					void						collide(PxReal timeStep, PxBaseTask* continuation);
 					void						endSimulation();
+					void						prepareFieldEffectors();
+					void						releaseOneShotFieldEffectors();
 					void						flush(bool sendPendingReports);
+					PxU32						compactMemory();
 					void						fireBrokenConstraintCallbacks();
 					void						fireTriggerCallbacks();
 					void						fireQueuedContactCallbacks();
@@ -448,9 +459,36 @@ namespace Sc
 
 // PX_ENABLE_SIM_STATS
 					void						getStats(PxSimulationStatistics& stats) const;
+					void						updateMemoryBudget();
 	PX_FORCE_INLINE	SimStats&					getStatsInternal() { return *mStats; }
 // PX_ENABLE_SIM_STATS
 
+					// PT: per-stage timings, always recorded. Stages of a given type never run concurrently (they are
+					// ordered by task dependencies), so there is no need for atomics here.
+					void						getStageTimings(PxSimulationStageTimings& timings) const;
+					void						resetStageTimings();
+	PX_FORCE_INLINE	void						startStage(PxSimulationStage::Enum stage)
+												{
+													StageTiming& t = mStageTimings[stage];
+													if(!t.mNbCalls)
+														t.mStart = PxTime::getCurrentCounterValue();
+													t.mNbCalls++;
+												}
+	PX_FORCE_INLINE	void						endStage(PxSimulationStage::Enum stage, PxU32 nbItems=0)
+												{
+													StageTiming& t = mStageTimings[stage];
+													t.mEnd = PxTime::getCurrentCounterValue();
+													t.mNbItems += nbItems;
+												}
+	PX_FORCE_INLINE	void						endStep()	{ mStepEndTime = PxTime::getCurrentCounterValue();	}
+
+					// PT: narrowphase attribution mode. The costs are recorded per pair by the low-level context and only
+					// aggregated on demand, when the user asks for them.
+					void						setNarrowPhaseAttribution(bool enabled);
+					bool						getNarrowPhaseAttribution()	const;
+					PxU32						getNarrowPhasePairCosts(PxNarrowPhasePairCost* userBuffer, PxU32 bufferSize)	const;
+					PxU32						getNarrowPhaseActorCosts(PxNarrowPhaseActorCost* userBuffer, PxU32 bufferSize)	const;
+
 					void						buildActiveActors();
 					void						buildActiveAndFrozenActors();
 					PxActor**					getActiveActors(PxU32& nbActorsOut);
@@ -458,6 +496,10 @@ namespace Sc
 
 					PxActor**					getFrozenActors(PxU32& nbActorsOut);
 
+					void						buildBodyStreams();
+					void						clearBodyStreams();
+					void						getBodyStreams(PxRigidBodyStreams& streams)	const;
+
 					void						finalizeContactStreamAndCreateHeader(PxContactPairHeader& header, 
 						const ActorPairReport& aPair, 
 						ContactStreamManager& cs, PxU32 removedShapeTestMask);
@@ -712,6 +754,14 @@ namespace Sc
 					PxsCCDContext*				mCCDContext;
 					PxI32						mNumFastMovingShapes;
 					PxU32						mCCDPass;
+					PxU32						mCCDMaxPasses;	// PT: user value, the CCD context gets a capped value under memory pressure
+
+					// PT: memory budget, see PxSceneDesc::simulationMemoryBudget
+					PxU32						mMemoryBudget;
+					PxU32						mMemoryBudgetPeak;		// peak bytes used in the previous step
+					PxU32						mNbDroppedContactReports;
+					PxU32						mNbCappedCCDPasses;
+					bool						mMemoryBudgetDegraded;
 
 					IG::SimpleIslandManager*	mSimpleIslandManager;
 
@@ -732,6 +782,12 @@ namespace Sc
 
 					PxVec3						mGravity;			//!< Gravity vector
 
+					PxArray<PxFieldEffector>	mFieldEffectors;		// PT: indexed by the ids returned to users
+					PxArray<PxU32>				mFreeFieldEffectorIds;
+					PxBitMap					mFieldEffectorMap;		// PT: set bits are the ids in use
+					PxArray<PxFieldEffector>	mActiveFieldEffectors;	// PT: packed copy read by the dynamics context during the step
+					bool						mFieldEffectorsDirty;
+
 					PxArray<PxContactPairHeader>
 												mQueuedContactPairHeaders;
 		//time:
@@ -796,6 +852,13 @@ namespace Sc
 						PxArray<PxActor*>				mActiveActors;
 						PxArray<PxActor*>				mFrozenActors;
 
+						// PT: SoA copy of the active bodies' poses and velocities, see PxSceneFlag::eENABLE_BODY_STREAMS
+						PxArray<PxRigidActor*>								mBodyStreamActors;
+						PxArray<PxVec4, PxAlignedAllocator<16> >			mBodyStreamPositions;
+						PxArray<PxQuat, PxAlignedAllocator<16> >			mBodyStreamOrientations;
+						PxArray<PxVec4, PxAlignedAllocator<16> >			mBodyStreamLinearVelocities;
+						PxArray<PxVec4, PxAlignedAllocator<16> >			mBodyStreamAngularVelocities;
+
 						PxArray<const PxRigidBody*>	mClientPosePreviewBodies;	// buffer for bodies that requested early report of the integrated pose (eENABLE_POSE_INTEGRATION_PREVIEW).
 																			// This buffer gets exposed to users. Is officially accessible from PxSimulationEventCallback::onAdvance()
 																			// until the next simulate()/advance().
@@ -805,6 +868,17 @@ namespace Sc
 						PxSimulationEventCallback*	mSimulationEventCallback;
 
 					SimStats*					mStats;
+
+					struct StageTiming
+					{
+						PxU64	mStart;
+						PxU64	mEnd;
+						PxU32	mNbCalls;
+						PxU32	mNbItems;
+					};
+					StageTiming					mStageTimings[PxSimulationStage::eCOUNT];
+					PxU64						mStepStartTime;
+					PxU64						mStepEndTime;
 					PxU32						mInternalFlags;	// PT: combination of ::SceneInternalFlag, looks like only 2 bits are needed
 					PxSceneFlags				mPublicFlags;	// Copy of PxSceneDesc::flags, of type PxSceneFlag
 
@@ -913,6 +987,9 @@ namespace Sc
 					Cm::DelegateTask<Scene, &Scene::finalizationPhase>			mFinalizationPhase;
 					Cm::DelegateTask<Scene, &Scene::updateCCDMultiPass>			mUpdateCCDMultiPass;
 
+					Cm::TaskChain												mAdvanceStepChain;			// recorded advanceStep() topology
+					PxU32														mAdvanceStepChainConfig;	// flags the chain was recorded with
+
 					//multi-pass ccd stuff
 					PxArray<Cm::DelegateTask<Scene, &Scene::updateCCDSinglePass> >			mUpdateCCDSinglePass;
 					PxArray<Cm::DelegateTask<Scene, &Scene::updateCCDSinglePassStage2> >	mUpdateCCDSinglePass2;
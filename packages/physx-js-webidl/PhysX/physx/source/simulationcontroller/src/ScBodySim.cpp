@@ -177,7 +177,7 @@ void BodySim::updateCached(PxBitMapPinned* shapeChangedMap)
 	}
 }
 
-void BodySim::updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& boundsArray)
+void BodySim::updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& boundsArray, Gu::BoundsBatch& batch)
 {
 	PX_ASSERT(!(mLLBody.mInternalFlags & PxsRigidBody::eFROZEN));	// PT: should not be called otherwise
 
@@ -186,7 +186,7 @@ void BodySim::updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& b
 	while (nbElems--)
 	{
 		ShapeSim* current = static_cast<ShapeSim*>(*elems++);
-		current->updateCached(transformCache, boundsArray);
+		current->updateCached(transformCache, boundsArray, batch);
 	}
 }
 
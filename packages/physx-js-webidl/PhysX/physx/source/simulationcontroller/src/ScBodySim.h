@@ -43,6 +43,10 @@ namespace physx
 namespace Bp
 {
 	class BoundsArray;
+}
+namespace Gu
+{
+	class BoundsBatch;
 }
 	struct PxsExternalAccelerationProvider;
 	class PxsTransformCache;
@@ -83,7 +87,7 @@ namespace Sc
 						void					clearSpatialVelocity(bool force, bool torque);
 
 						void					updateCached(PxBitMapPinned* shapeChangedMap);
-						void					updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& boundsArray);
+						void					updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& boundsArray, Gu::BoundsBatch& batch);
 						void					updateContactDistance(PxReal* contactDistance, PxReal dt, const Bp::BoundsArray& boundsArray);
 
 		// hooks for actions in body core when it's attached to a sim object. Generally
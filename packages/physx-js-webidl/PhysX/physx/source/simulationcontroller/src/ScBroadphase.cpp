@@ -38,8 +38,11 @@ using namespace Bp;
 ///////////////////////////////////////////////////////////////////////////////
 
 BroadphaseManager::BroadphaseManager() :
-	mBroadPhaseCallback	(NULL),
-	mOutOfBoundsIDs		("sceneOutOfBoundsIds")
+	mBroadPhaseCallback		(NULL),
+	mOutOfBoundsIDs			("sceneOutOfBoundsIds"),
+	mRecordedCreatedPairs	("sceneRecordedCreatedPairs"),
+	mRecordedDeletedPairs	("sceneRecordedDeletedPairs"),
+	mRecordPairs			(false)
 {
 }
 
@@ -136,4 +139,68 @@ bool BroadphaseManager::fireOutOfBoundsCallbacks(Bp::AABBManagerBase* aabbManage
 void BroadphaseManager::flush(Bp::AABBManagerBase* /*aabbManager*/)
 {
 	mOutOfBoundsIDs.reset();
+	mRecordedCreatedPairs.reset();
+	mRecordedDeletedPairs.reset();
+}
+
+void BroadphaseManager::setPairRecording(bool enable, const PxFilterData& groupMask)
+{
+	mRecordPairs = enable;
+	mRecordMask = groupMask;
+	if(!enable)
+	{
+		mRecordedCreatedPairs.reset();
+		mRecordedDeletedPairs.reset();
+	}
+}
+
+void BroadphaseManager::resetRecordedPairs()
+{
+	mRecordedCreatedPairs.forceSize_Unsafe(0);
+	mRecordedDeletedPairs.forceSize_Unsafe(0);
+}
+
+static PX_FORCE_INLINE bool passesRecordMask(const ShapeSimBase* sim, const PxFilterData& mask)
+{
+	const PxFilterData& fd = sim->getCore().getSimulationFilterData();
+	return ((fd.word0 & mask.word0) | (fd.word1 & mask.word1) | (fd.word2 & mask.word2) | (fd.word3 & mask.word3))!=0;
+}
+
+static void recordOverlaps(PxArray<PxBroadPhaseShapePair>& pairs, const AABBOverlap* PX_RESTRICT overlaps, PxU32 nbOverlaps, const PxFilterData& mask)
+{
+	for(PxU32 i=0;i<nbOverlaps;i++)
+	{
+		const ShapeSimBase* sim0 = static_cast<const ShapeSimBase*>(reinterpret_cast<const ElementSim*>(overlaps[i].mUserData0));
+		const ShapeSimBase* sim1 = static_cast<const ShapeSimBase*>(reinterpret_cast<const ElementSim*>(overlaps[i].mUserData1));
+
+		if(!passesRecordMask(sim0, mask) && !passesRecordMask(sim1, mask))
+			continue;
+
+		PxBroadPhaseShapePair& pair = pairs.insert();
+		pair.mShape0 = sim0->getPxShape();
+		pair.mActor0 = sim0->getActor().getPxActor();
+		pair.mShape1 = sim1->getPxShape();
+		pair.mActor1 = sim1->getActor().getPxActor();
+	}
+}
+
+// PT: must be called while the AABB manager's created & destroyed overlaps are available, i.e. before they are freed in finishBroadPhaseStage2.
+// This can be called multiple times per frame (CCD passes), the pairs are accumulated until the next resetRecordedPairs() call.
+void BroadphaseManager::recordPairs(Bp::AABBManagerBase* aabbManager, PxU64 contextID)
+{
+	PX_UNUSED(contextID);
+	if(!mRecordPairs)
+		return;
+
+	PX_PROFILE_ZONE("Sim.recordBroadPhasePairs", contextID);
+
+	for(PxU32 i=0; i<ElementType::eCOUNT; i++)
+	{
+		PxU32 nb;
+		const AABBOverlap* created = aabbManager->getCreatedOverlaps(ElementType::Enum(i), nb);
+		recordOverlaps(mRecordedCreatedPairs, created, nb, mRecordMask);
+
+		const AABBOverlap* deleted = aabbManager->getDestroyedOverlaps(ElementType::Enum(i), nb);
+		recordOverlaps(mRecordedDeletedPairs, deleted, nb, mRecordMask);
+	}
 }
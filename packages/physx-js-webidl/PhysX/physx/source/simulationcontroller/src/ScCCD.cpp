@@ -315,12 +315,13 @@ PxCCDContactModifyCallback* Sc::Scene::getCCDContactModifyCallback() const
 
 void Sc::Scene::setCCDMaxPasses(PxU32 ccdMaxPasses)
 {
+	mCCDMaxPasses = ccdMaxPasses;
 	mCCDContext->setCCDMaxPasses(ccdMaxPasses);
 }
 
 PxU32 Sc::Scene::getCCDMaxPasses() const
 {
-	return mCCDContext->getCCDMaxPasses();
+	return mCCDMaxPasses;
 }
 
 void Sc::Scene::setCCDThreshold(PxReal t)
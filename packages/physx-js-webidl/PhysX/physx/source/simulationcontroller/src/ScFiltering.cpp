@@ -175,6 +175,74 @@ static PX_INLINE PxPairFlags checkRbPairFlags(	const ShapeSimBase& s0, const Sha
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// PT: direct-mapped cache for the filter shader results, see PxSceneFlag::eENABLE_FILTER_SHADER_CACHE. It lives on the stack
+// of each overlap filter task, so it does not need any locking or invalidation. Pairs appearing at the same time (e.g. a
+// crowd entering a region) typically share a handful of filter data combinations.
+#define SC_FILTER_SHADER_CACHE_SIZE	64
+
+namespace physx
+{
+namespace Sc
+{
+	struct FilterShaderCache
+	{
+		struct Entry
+		{
+			PxFilterData				mFilterData0;
+			PxFilterData				mFilterData1;
+			PxFilterObjectAttributes	mAttributes0;
+			PxFilterObjectAttributes	mAttributes1;
+			PxPairFlags					mPairFlagsIn;
+			PxPairFlags					mPairFlagsOut;
+			PxFilterFlags				mFilterFlags;
+			bool						mValid;
+		};
+
+		FilterShaderCache()
+		{
+			for(PxU32 i=0;i<SC_FILTER_SHADER_CACHE_SIZE;i++)
+				mEntries[i].mValid = false;
+		}
+
+		static PX_FORCE_INLINE bool isSame(const PxFilterData& a, const PxFilterData& b)
+		{
+			return a.word0==b.word0 && a.word1==b.word1 && a.word2==b.word2 && a.word3==b.word3;
+		}
+
+		static PX_FORCE_INLINE PxU32 computeHash(PxFilterObjectAttributes fa0, const PxFilterData& fd0, PxFilterObjectAttributes fa1, const PxFilterData& fd1, PxPairFlags pairFlags)
+		{
+			PxU32 h = physx::PxComputeHash(fd0.word0 ^ (fd0.word1<<1) ^ (fd0.word2<<2) ^ (fd0.word3<<3));
+			h = physx::PxComputeHash(h ^ fd1.word0 ^ (fd1.word1<<1) ^ (fd1.word2<<2) ^ (fd1.word3<<3));
+			h = physx::PxComputeHash(h ^ fa0 ^ (fa1<<16) ^ (PxU32(pairFlags)<<8));
+			return h & (SC_FILTER_SHADER_CACHE_SIZE-1);
+		}
+
+		PxFilterFlags runFilterShader(const FilteringContext& context, PxFilterObjectAttributes fa0, const PxFilterData& fd0, PxFilterObjectAttributes fa1, const PxFilterData& fd1, PxPairFlags& pairFlags)
+		{
+			Entry& entry = mEntries[computeHash(fa0, fd0, fa1, fd1, pairFlags)];
+			if(entry.mValid && entry.mAttributes0==fa0 && entry.mAttributes1==fa1 && entry.mPairFlagsIn==pairFlags && isSame(entry.mFilterData0, fd0) && isSame(entry.mFilterData1, fd1))
+			{
+				pairFlags = entry.mPairFlagsOut;
+				return entry.mFilterFlags;
+			}
+
+			entry.mValid = true;
+			entry.mFilterData0 = fd0;
+			entry.mFilterData1 = fd1;
+			entry.mAttributes0 = fa0;
+			entry.mAttributes1 = fa1;
+			entry.mPairFlagsIn = pairFlags;
+
+			entry.mFilterFlags = context.mFilterShader(fa0, fd0, fa1, fd1, pairFlags, context.mFilterShaderData, context.mFilterShaderDataSize);
+			entry.mPairFlagsOut = pairFlags;
+			return entry.mFilterFlags;
+		}
+
+		Entry	mEntries[SC_FILTER_SHADER_CACHE_SIZE];
+	};
+}
+}
+
 static PX_FORCE_INLINE bool createFilterInfo(FilterInfo& filterInfo, const PxFilterFlags filterFlags)
 {
 	filterInfo = FilterInfo(filterFlags);
@@ -189,7 +257,10 @@ static void filterRbCollisionPairSecondStage(FilterInfo& filterInfo, const Filte
 	// Run filter shader
 	const PxFilterData& fd0 = s0.getCore().getSimulationFilterData();
 	const PxFilterData& fd1 = s1.getCore().getSimulationFilterData();
-	filterInfo.setFilterFlags(context.mFilterShader(fa0, fd0, fa1, fd1, filterInfo.mPairFlags, context.mFilterShaderData, context.mFilterShaderDataSize));
+	if(context.mFilterShaderCache)
+		filterInfo.setFilterFlags(context.mFilterShaderCache->runFilterShader(context, fa0, fd0, fa1, fd1, filterInfo.mPairFlags));
+	else
+		filterInfo.setFilterFlags(context.mFilterShader(fa0, fd0, fa1, fd1, filterInfo.mPairFlags, context.mFilterShaderData, context.mFilterShaderDataSize));
 
 	if(filterInfo.getFilterFlags() & PxFilterFlag::eCALLBACK)
 	{
@@ -557,7 +628,12 @@ void NPhaseCore::runOverlapFilters(	PxU32 nbToProcess, Bp::AABBOverlap* PX_RESTR
 
 	const PxU64 contextID = mOwnerScene.getContextId();
 
-	const FilteringContext context(mOwnerScene);
+	// PT: the cache is only constructed (which clears its entries) when the feature is enabled, the default path doesn't pay for it
+	PX_ALIGN(16, PxU8 filterShaderCacheBuffer[sizeof(FilterShaderCache)]);
+	FilterShaderCache* filterShaderCache = NULL;
+	if(mOwnerScene.getFlags() & PxSceneFlag::eENABLE_FILTER_SHADER_CACHE)
+		filterShaderCache = PX_PLACEMENT_NEW(filterShaderCacheBuffer, FilterShaderCache);
+	const FilteringContext context(mOwnerScene, filterShaderCache);
 
 	// PT: in this version we write out not just the filter info but also the pairs, and we skip the bitmap entirely. We just do
 	// a local compaction of surviving pairs, similar to what happens later in Scene::preallocateContactManagers(), but only for a single task.
@@ -848,7 +924,7 @@ void NPhaseCore::fireCustomFilteringCallbacks(PxsContactManagerOutputIterator& o
 		{
 			const PxU32 id0 = PxU32(pairID);
 			const PxU32 id1 = PxU32(pairID>>32);
-			const PxHashMap<ElementSimKey, ElementSimInteraction*>::Entry* pair = mElementSimMap.find(ElementSimKey(id0, id1));
+			const PxFlatHashMap<ElementSimKey, ElementSimInteraction*>::Entry* pair = mElementSimMap.find(ElementSimKey(id0, id1));
 			ElementSimInteraction* ei = pair ? pair->second : NULL;
 			PX_ASSERT(ei);
 			// Check if the user tries to update a pair even though he deleted it earlier in the same frame
@@ -304,6 +304,8 @@ public:
 
 	virtual void runInternal()
 	{
+		Gu::BoundsBatch batch(mBoundsArray.begin());
+
 		const PxU32 nb = mNbKinematics;
 		for(PxU32 a=0; a<nb; ++a)
 		{
@@ -311,8 +313,9 @@ public:
 			PX_ASSERT(b->getSim()->isKinematic());
 			PX_ASSERT(b->getSim()->isActive());
 
-			b->getSim()->updateCached(mCache, mBoundsArray);
+			b->getSim()->updateCached(mCache, mBoundsArray, batch);
 		}
+		batch.flush();
 	}
 
 	virtual const char* getName() const
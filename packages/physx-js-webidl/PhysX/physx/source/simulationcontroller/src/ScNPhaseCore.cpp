@@ -70,9 +70,20 @@ PxU32 NPhaseCore::getDefaultContactReportStreamBufferSize() const
 	return mContactReportBuffer.getDefaultBufferSize();
 }
 
+PxU32 NPhaseCore::compactMemory()
+{
+	PxU32 nbReleased = mActorPairPool.releaseEmptySlabs();
+	nbReleased += mActorPairReportPool.releaseEmptySlabs();
+	nbReleased += mShapeInteractionPool.releaseEmptySlabs();
+	nbReleased += mTriggerInteractionPool.releaseEmptySlabs();
+	nbReleased += mActorPairContactReportDataPool.releaseEmptySlabs();
+	nbReleased += mInteractionMarkerPool.releaseEmptySlabs();
+	return nbReleased;
+}
+
 ElementSimInteraction* NPhaseCore::findInteraction(const ElementSim* element0, const ElementSim* element1) const
 {
-	const PxHashMap<ElementSimKey, ElementSimInteraction*>::Entry* pair = mElementSimMap.find(ElementSimKey(element0->getElementID(), element1->getElementID()));
+	const PxFlatHashMap<ElementSimKey, ElementSimInteraction*>::Entry* pair = mElementSimMap.find(ElementSimKey(element0->getElementID(), element1->getElementID()));
 	return pair ? pair->second : NULL;
 }
 
@@ -833,13 +844,14 @@ void NPhaseCore::concludeTriggerInteractionProcessing(PxBaseTask*)
 	mTriggerProcessingContext.deinitialize(mOwnerScene.getLowLevelContext()->getScratchAllocator());
 }
 
-void NPhaseCore::processPersistentContactEvents(PxsContactManagerOutputIterator& outputs)
+PxU32 NPhaseCore::processPersistentContactEvents(PxsContactManagerOutputIterator& outputs, bool dropReports)
 {
 	PX_PROFILE_ZONE("Sc::NPhaseCore::processPersistentContactEvents", mOwnerScene.getContextId());
 	
 	// Go through ShapeInteractions which requested persistent contact event reports. This is necessary since there are no low level events for persistent contact.
 	ShapeInteraction*const* persistentEventPairs = getCurrentPersistentContactEventPairs();
 	PxU32 size = getCurrentPersistentContactEventPairCount();
+	PxU32 nbDropped = 0;
 	while (size--)
 	{
 		ShapeInteraction* pair = *persistentEventPairs++;
@@ -866,9 +878,16 @@ void NPhaseCore::processPersistentContactEvents(PxsContactManagerOutputIterator&
 			const ActorSim& actorSim1 = pair->getActor1();
 
 			if (actorSim0.isActive() || ((!actorSim1.isStaticRigid()) && actorSim1.isActive()))
-				pair->processUserNotification(PxPairFlag::eNOTIFY_TOUCH_PERSISTS, 0, false, 0, false, outputs);
+			{
+				// PT: persistent touch reports are the first thing to go when the scene runs over its memory budget
+				if(dropReports)
+					nbDropped++;
+				else
+					pair->processUserNotification(PxPairFlag::eNOTIFY_TOUCH_PERSISTS, 0, false, 0, false, outputs);
+			}
 		}
 	}
+	return nbDropped;
 }
 
 void NPhaseCore::addToDirtyInteractionList(Interaction* pair)
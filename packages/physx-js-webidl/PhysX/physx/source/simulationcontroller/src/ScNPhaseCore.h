@@ -34,6 +34,7 @@
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxHashSet.h"
 #include "foundation/PxHashMap.h"
+#include "foundation/PxFlatHashMap.h"
 #include "foundation/PxMutex.h"
 #include "foundation/PxAtomic.h"
 #include "PxPhysXConfig.h"
@@ -72,6 +73,8 @@ namespace Sc
 
 	class TriggerContactTask;
 
+	struct FilterShaderCache;
+
 	struct PairReleaseFlag
 	{
 		enum Enum
@@ -267,7 +270,7 @@ namespace Sc
 		void concludeTriggerInteractionProcessing(PxBaseTask* continuation);
 
 		// Check candidates for persistent touch contact events and create those events if necessary.
-		void processPersistentContactEvents(PxsContactManagerOutputIterator& outputs);
+		PxU32 processPersistentContactEvents(PxsContactManagerOutputIterator& outputs, bool dropReports);	// returns the number of dropped reports
 
 		PX_FORCE_INLINE void addToContactReportActorPairSet(ActorPairReport* pair) { mContactReportActorPairSet.pushBack(pair); }
 		void clearContactReportActorPairs(bool shrinkToZero);
@@ -300,6 +303,9 @@ namespace Sc
 		PX_FORCE_INLINE void clearContactReportStream() { mContactReportBuffer.reset(); }  // Do not free memory at all
 		PX_FORCE_INLINE void freeContactReportStreamMemory() { mContactReportBuffer.flush(); }
 
+		// Releases empty pool slabs. Returns the number of released bytes.
+		PxU32	compactMemory();
+
 		ActorPairContactReportData* createActorPairContactReportData();
 
 		void registerInteraction(ElementSimInteraction* interaction);
@@ -367,9 +373,9 @@ namespace Sc
 
 		Cm::DelegateTask<NPhaseCore, &NPhaseCore::concludeTriggerInteractionProcessing> mConcludeTriggerInteractionProcessingTask;
 		TriggerProcessingContext					mTriggerProcessingContext;
-		PxHashMap<BodyPairKey, ActorPair*>			mActorPairMap; 
+		PxFlatHashMap<BodyPairKey, ActorPair*>		mActorPairMap; 
 
-		PxHashMap<ElementSimKey, ElementSimInteraction*> mElementSimMap;
+		PxFlatHashMap<ElementSimKey, ElementSimInteraction*> mElementSimMap;
 
 		PxMutex										mBufferAllocLock;
 		PxMutex										mReportAllocLock;
@@ -382,14 +388,15 @@ namespace Sc
 	{
 		PX_NOCOPY(FilteringContext)
 	public:
-		FilteringContext(const Scene& scene) :
+		FilteringContext(const Scene& scene, FilterShaderCache* filterShaderCache = NULL) :
 			mFilterShader			(scene.getFilterShaderFast()),
 			mFilterShaderData		(scene.getFilterShaderDataFast()),
 			mFilterShaderDataSize	(scene.getFilterShaderDataSizeFast()),
 			mFilterCallback			(scene.getFilterCallbackFast()),
 			mKineKineFilteringMode	(scene.getKineKineFilteringMode()),
 			mStaticKineFilteringMode(scene.getStaticKineFilteringMode()),
-			mIsDirectGPU			(scene.getFlags() & PxSceneFlag::eENABLE_DIRECT_GPU_API)
+			mIsDirectGPU			(scene.getFlags() & PxSceneFlag::eENABLE_DIRECT_GPU_API),
+			mFilterShaderCache		(filterShaderCache)
 		{
 		}
 
@@ -400,6 +407,7 @@ namespace Sc
 		const PxPairFilteringMode::Enum		mKineKineFilteringMode;
 		const PxPairFilteringMode::Enum		mStaticKineFilteringMode;
 		const bool 							mIsDirectGPU;
+		FilterShaderCache*					mFilterShaderCache;	// Optional, see PxSceneFlag::eENABLE_FILTER_SHADER_CACHE
 	};
 
 } // namespace Sc
@@ -82,11 +82,15 @@ void Sc::Scene::stepSetupCollide(PxBaseTask* continuation)
 {
 	PX_PROFILE_ZONE("Sim.stepSetupCollide", mContextId);
 
+	resetStageTimings();
+
 	{
 		PX_PROFILE_ZONE("Sim.prepareCollide", mContextId);
 		mReportShapePairTimeStamp++;	// deleted actors/shapes should get separate pair entries in contact reports
 		mContactReportsNeedPostSolverVelocity = false;
 
+		mBroadphaseManager.resetRecordedPairs();
+
 		getRenderBuffer().clear();
 
 		// Clear broken constraint list:
@@ -95,6 +99,8 @@ void Sc::Scene::stepSetupCollide(PxBaseTask* continuation)
 		visualizeStartStep();
 	
 		PxcClearContactCacheStats();
+
+		updateMemoryBudget();
 	}
 
 	kinematicsSetup(continuation);
@@ -111,6 +117,7 @@ void Sc::Scene::simulate(PxReal timeStep, PxBaseTask* continuation)
 	{
 		setElapsedTime(timeStep);
 		mDynamicsContext->setDt(timeStep);
+		prepareFieldEffectors();
 
 		mAdvanceStep.setContinuation(continuation);
 
@@ -129,6 +136,7 @@ void Sc::Scene::collideStep(PxBaseTask* continuation)
 {
 	PX_PROFILE_ZONE("Sim.collideQueueTasks", mContextId);
 	PX_PROFILE_START_CROSSTHREAD("Basic.collision", mContextId);
+	startStage(PxSimulationStage::eCOLLISION);
 
 	mStats->simStart();
 	mLLContext->beginUpdate();
@@ -180,8 +188,10 @@ public:
 
 	virtual void runInternal() 
 	{
+		Gu::BoundsBatch batch(mBoundsArray.begin());
 		for (PxU32 a = 0; a < mNbShapes; ++a)
-			mShapes[a]->updateCached(mCache, mBoundsArray);
+			mShapes[a]->updateCached(mCache, mBoundsArray, batch);
+		batch.flush();
 	}
 
 	virtual const char* getName() const { return "DirtyShapeUpdatesTask";  }
@@ -269,6 +279,7 @@ void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 void Sc::Scene::rigidBodyNarrowPhase(PxBaseTask* continuation)
 {
 	PX_PROFILE_START_CROSSTHREAD("Basic.narrowPhase", mContextId);
+	startStage(PxSimulationStage::eNARROW_PHASE);
 
 	mCCDPass = 0;
 
@@ -332,6 +343,7 @@ void Sc::Scene::setupBroadPhaseFirstAndSecondPassTasks(PxBaseTask* continuation)
 void Sc::Scene::broadPhase(PxBaseTask* continuation)
 {
 	PX_PROFILE_START_CROSSTHREAD("Basic.broadPhase", mContextId);
+	startStage(PxSimulationStage::eBROAD_PHASE);
 
 #if PX_SUPPORT_GPU_PHYSX
 	gpu_updateBounds();
@@ -347,6 +359,7 @@ void Sc::Scene::broadPhase(PxBaseTask* continuation)
 void Sc::Scene::broadPhaseFirstPass(PxBaseTask* continuation)
 {
 	PX_PROFILE_ZONE("Basic.broadPhaseFirstPass", mContextId);
+	startStage(PxSimulationStage::eBROAD_PHASE_FIRST_PASS);
 	const PxU32 numCpuTasks = continuation->getTaskManager()->getCpuDispatcher()->getWorkerCount();
 	mAABBManager->updateBPFirstPass(numCpuTasks, mLLContext->getTaskPool(), mHasContactDistanceChanged, continuation);
 	
@@ -356,6 +369,7 @@ void Sc::Scene::broadPhaseFirstPass(PxBaseTask* continuation)
 	{
 		mSimulationController->mergeChangedAABBMgHandle();
 	}
+	endStage(PxSimulationStage::eBROAD_PHASE_FIRST_PASS);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -390,9 +404,17 @@ void Sc::Scene::preIntegrate(PxBaseTask* continuation)
 void Sc::Scene::updateBroadPhase(PxBaseTask* continuation)
 {
 	PX_PROFILE_ZONE("Basic.updateBroadPhase", mContextId);
+	startStage(PxSimulationStage::eBROAD_PHASE_SECOND_PASS);
 
 	PxBaseTask* rigidBodyNPhaseUnlock = mCCDPass ? NULL : &mRigidBodyNPhaseUnlock;
 
+#if PX_ENABLE_SIM_STATS
+	if(!mCCDPass)
+		mLLContext->getSimStats().mNbBroadPhaseUpdatedBounds = mAABBManager->getNbUpdatedHandles();
+#else
+	PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
+#endif
+
 	mAABBManager->updateBPSecondPass(&mLLContext->getScratchAllocator(), continuation);
 
 	// PT: decoupling: I moved this back from updateBPSecondPass
@@ -402,6 +424,8 @@ void Sc::Scene::updateBroadPhase(PxBaseTask* continuation)
 
 	if(!mCCDBp && isUsingGpuDynamicsOrBp())
 		mSimulationController->updateParticleSystemsAndSoftBodies();
+
+	endStage(PxSimulationStage::eBROAD_PHASE_SECOND_PASS);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -419,6 +443,7 @@ void Sc::Scene::unblockNarrowPhase(PxBaseTask*)
 void Sc::Scene::postBroadPhase(PxBaseTask* continuation)
 {
 	PX_PROFILE_START_CROSSTHREAD("Basic.postBroadPhase", mContextId);
+	startStage(PxSimulationStage::ePOST_BROAD_PHASE);
 
 	//Notify narrow phase that broad phase has completed
 	mLLContext->getNphaseImplementationContext()->postBroadPhaseUpdateContactManager(continuation);
@@ -984,6 +1009,8 @@ namespace
 
 void Sc::Scene::postBroadPhaseStage2(PxBaseTask* continuation)
 {
+	startStage(PxSimulationStage::ePOST_BROAD_PHASE_STAGE2);
+
 	// PT: TODO: can we overlap this with something?
 	// - Wakes actors that lost touch if appropriate
 	processLostTouchPairs();
@@ -1015,10 +1042,10 @@ void Sc::Scene::postBroadPhaseStage2(PxBaseTask* continuation)
 		mRegisterSceneInteractions.removeReference();
 	}
 
+	PxU32 totalNbShapeInteractions = 0;
 	{
 		PX_PROFILE_ZONE("mIslandInsertion prep", mContextId);
 		// PT: TODO: maybe replace this loop with atomics in overlap created tasks
-		PxU32 totalNbShapeInteractions = 0;
 		{
 			OnOverlapCreatedTask* task = mOverlapCreatedTaskHead;
 			while(task)
@@ -1110,6 +1137,8 @@ void Sc::Scene::postBroadPhaseStage2(PxBaseTask* continuation)
 			}
 		}
 	}
+
+	endStage(PxSimulationStage::ePOST_BROAD_PHASE_STAGE2, totalNbShapeInteractions);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1280,6 +1309,8 @@ void Sc::Scene::finishBroadPhaseStage2(PxU32 ccdPass)
 
 	AABBManagerBase* aabbMgr = mAABBManager;
 
+	mBroadphaseManager.recordPairs(aabbMgr, mContextId);
+
 	PxU32 nbLostPairs = 0;
 	for(PxU32 i=0; i<ElementType::eCOUNT; i++)
 	{
@@ -1372,6 +1403,8 @@ void Sc::Scene::postBroadPhaseStage3(PxBaseTask* /*continuation*/)
 
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.postBroadPhase", mContextId);
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.broadPhase", mContextId);
+	endStage(PxSimulationStage::ePOST_BROAD_PHASE);
+	endStage(PxSimulationStage::eBROAD_PHASE);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1382,64 +1415,38 @@ void Sc::Scene::advanceStep(PxBaseTask* continuation)
 
 	if(mDt != 0.0f)
 	{
-		mFinalizationPhase.setContinuation(continuation);
-
-		if(mPublicFlags & PxSceneFlag::eENABLE_CCD)
-		{
-			mUpdateCCDMultiPass.setContinuation(&mFinalizationPhase);
-			mAfterIntegration.setContinuation(&mUpdateCCDMultiPass);
-			mUpdateCCDMultiPass.removeReference();
-		}
-		else
-		{
-			mAfterIntegration.setContinuation(&mFinalizationPhase);
-		}
-
+		const bool useCCD = mPublicFlags.isSet(PxSceneFlag::eENABLE_CCD);
 		const bool useGpu = isUsingGpuDynamicsOrBp();
 
-		mPostSolver.setContinuation(&mAfterIntegration);
-		if(useGpu)
-		{
-			mUpdateSimulationController.setContinuation(&mPostSolver);
-			mUpdateDynamicsPostPartitioning.setContinuation(&mUpdateSimulationController);
-			mUpdateDynamics.setContinuation(&mUpdateDynamicsPostPartitioning);
-
-			mUpdateBodies.setContinuation(&mUpdateDynamics);
-			mSolver.setContinuation(&mUpdateBodies);
-		}
-		else
-		{
-			mUpdateDynamics.setContinuation(&mPostSolver);
-
-			mSolver.setContinuation(&mUpdateDynamics);
-		}
-#if USE_SPLIT_SECOND_PASS_ISLAND_GEN
-		mIslandGen.setContinuation(&mSolver);
-#else
-		mPostIslandGen.setContinuation(&mSolver);
-		mIslandGen.setContinuation(&mPostIslandGen);
-#endif
-		mPostNarrowPhase.setContinuation(&mIslandGen);
-		mSecondPassNarrowPhase.setContinuation(&mPostNarrowPhase);
-
-		mFinalizationPhase.removeReference();
-		mAfterIntegration.removeReference();
-		mPostSolver.removeReference();
-		if(useGpu)
+		// PT: the topology of this stage only depends on these flags, so we record it once and replay it each frame
+		const PxU32 config = (useCCD ? 1u : 0u) | (useGpu ? 2u : 0u);
+		if(!mAdvanceStepChain.size() || config != mAdvanceStepChainConfig)
 		{
-			mUpdateSimulationController.removeReference();
-			mUpdateDynamicsPostPartitioning.removeReference();
-		}
-		mUpdateDynamics.removeReference();
-		if(useGpu)
-			mUpdateBodies.removeReference();
-		mSolver.removeReference();
+			mAdvanceStepChainConfig = config;
+			mAdvanceStepChain.reset();
+			mAdvanceStepChain.record(mSecondPassNarrowPhase);
+			mAdvanceStepChain.record(mPostNarrowPhase);
+			mAdvanceStepChain.record(mIslandGen);
 #if !USE_SPLIT_SECOND_PASS_ISLAND_GEN
-		mPostIslandGen.removeReference();
+			mAdvanceStepChain.record(mPostIslandGen);
 #endif
-		mIslandGen.removeReference();
-		mPostNarrowPhase.removeReference();
-		mSecondPassNarrowPhase.removeReference();
+			mAdvanceStepChain.record(mSolver);
+			if(useGpu)
+				mAdvanceStepChain.record(mUpdateBodies);
+			mAdvanceStepChain.record(mUpdateDynamics);
+			if(useGpu)
+			{
+				mAdvanceStepChain.record(mUpdateDynamicsPostPartitioning);
+				mAdvanceStepChain.record(mUpdateSimulationController);
+			}
+			mAdvanceStepChain.record(mPostSolver);
+			mAdvanceStepChain.record(mAfterIntegration);
+			if(useCCD)
+				mAdvanceStepChain.record(mUpdateCCDMultiPass);
+			mAdvanceStepChain.record(mFinalizationPhase);
+		}
+
+		mAdvanceStepChain.launch(continuation);
 	}
 }
 
@@ -1534,10 +1541,19 @@ void Sc::Scene::postNarrowPhase(PxBaseTask* /*continuation*/)
 	if(!mCCDBp && isUsingGpuDynamicsOrBp())
 		mSimulationController->sortContacts();
 
+#if PX_ENABLE_SIM_STATS
+	// PT: must be done before releaseConstraints(), which can flip the contact buffers
+	mLLContext->getSimStats().mPeakContactBlockAllocations = mLLContext->getNpMemBlockPool().getContactBlockCount();
+#else
+	PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
+#endif
+
 	releaseConstraints(false);
 
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.narrowPhase", mContextId);
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.collision", mContextId);
+	endStage(PxSimulationStage::eNARROW_PHASE, getNbActiveInteractions(InteractionType::eOVERLAP));
+	endStage(PxSimulationStage::eCOLLISION);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1545,6 +1561,7 @@ void Sc::Scene::postNarrowPhase(PxBaseTask* /*continuation*/)
 void Sc::Scene::islandGen(PxBaseTask* continuation)
 {
 	PX_PROFILE_ZONE("Sc::Scene::islandGen", mContextId);
+	startStage(PxSimulationStage::eISLAND_GEN);
 
 	//mLLContext->runModifiableContactManagers(); //KS - moved here so that we can get up-to-date touch found/lost events in IG
 
@@ -1559,6 +1576,8 @@ void Sc::Scene::islandGen(PxBaseTask* continuation)
 	// PT: in this version we run postIslandGen directly here in parallel with "islandGen" tasks (rather than just after them).
 	postIslandGen(&mSolver);
 #endif
+
+	endStage(PxSimulationStage::eISLAND_GEN, mSimpleIslandManager->getAccurateIslandSim().getNbActiveNodes(IG::Node::eRIGID_BODY_TYPE));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1767,6 +1786,7 @@ void Sc::Scene::setEdgesConnected(PxBaseTask*)
 void Sc::Scene::solver(PxBaseTask* continuation)
 {
 	PX_PROFILE_START_CROSSTHREAD("Basic.rigidBodySolver", mContextId);
+	startStage(PxSimulationStage::eSOLVER);
 
 #if USE_SPLIT_SECOND_PASS_ISLAND_GEN
 	// PT: we run here the last part of Sc::Scene::setEdgesConnected()
@@ -2055,6 +2075,7 @@ void Sc::Scene::updateBodies(PxBaseTask* continuation)
 void Sc::Scene::updateDynamics(PxBaseTask* /*continuation*/)
 {
 	PX_PROFILE_START_CROSSTHREAD("Basic.dynamics", mContextId);
+	startStage(PxSimulationStage::eUPDATE_DYNAMICS);
 
 	//Allow processLostContactsTask to run until after 2nd pass of solver completes (update bodies, run sleeping logic etc.)
 	mProcessLostContactsTask3.setContinuation(&mPostSolver);
@@ -2488,7 +2509,7 @@ void Sc::Scene::postThirdPassIslandGen(PxBaseTask* /*continuation*/)
 
 	PxvNphaseImplementationContext*	implCtx = mLLContext->getNphaseImplementationContext();
 	PxsContactManagerOutputIterator outputs = implCtx->getContactManagerOutputs();
-	mNPhaseCore->processPersistentContactEvents(outputs);
+	mNbDroppedContactReports += mNPhaseCore->processPersistentContactEvents(outputs, mMemoryBudgetDegraded);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2615,6 +2636,7 @@ void Sc::Scene::checkForceThresholdContactEvents(PxU32 ccdPass)
 void Sc::Scene::afterIntegration(PxBaseTask* continuation)
 {
 	PX_PROFILE_ZONE("Sc::Scene::afterIntegration", mContextId);
+	startStage(PxSimulationStage::eAFTER_INTEGRATION);
 
 	mLLContext->getTransformCache().resetChangedState(); //Reset the changed state. If anything outside of the GPU kernels updates any shape's transforms, this will be raised again
 	getBoundsArray().resetChangedState();
@@ -2729,8 +2751,11 @@ void Sc::Scene::afterIntegration(PxBaseTask* continuation)
 	//}
 
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.dynamics", mContextId);
+	endStage(PxSimulationStage::eUPDATE_DYNAMICS, mSimpleIslandManager->getAccurateIslandSim().getNbActiveNodes(IG::Node::eRIGID_BODY_TYPE));
 
 	checkForceThresholdContactEvents(0); 		
+
+	endStage(PxSimulationStage::eAFTER_INTEGRATION);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2804,6 +2829,8 @@ void Sc::Scene::finalizationPhase(PxBaseTask* /*continuation*/)
 		collectSolverResidual();
 
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.rigidBodySolver", mContextId);
+	endStage(PxSimulationStage::eSOLVER, mSimpleIslandManager->getAccurateIslandSim().getNbActiveNodes(IG::Node::eRIGID_BODY_TYPE));
+	endStep();
 
 	mTaskPool.clear();
 
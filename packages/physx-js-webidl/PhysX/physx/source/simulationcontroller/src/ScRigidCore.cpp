@@ -165,3 +165,13 @@ PxU32 RigidCore::getRigidID() const
 	return static_cast<RigidSim*>(ActorCore::getSim())->getActorID();
 }
 
+PxU32 RigidCore::getShapeTransformCacheID(const ShapeCore& shape) const
+{
+	const RigidSim* sim = getSim();
+	if(!sim)
+		return 0xffffffff;
+
+	const ShapeSim* s = getSimForShape(shape, *sim);
+	return s ? s->getTransformCacheID() : 0xffffffff;
+}
+
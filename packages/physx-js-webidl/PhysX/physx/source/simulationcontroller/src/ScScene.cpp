@@ -61,6 +61,7 @@
 #include "PxsMemoryManager.h"
 
 #include "ScShapeInteraction.h"
+#include "foundation/PxSort.h"
 
 #if PX_SUPPORT_GPU_PHYSX
 	#include "PxDeformableSurface.h"
@@ -159,6 +160,7 @@ namespace
 			IG::SimpleIslandManager& manager = *mScene.getSimpleIslandManager();
 			const IG::IslandSim& islandSim = manager.getAccurateIslandSim();
 			Bp::BoundsArray& boundsArray = mScene.getBoundsArray();
+			Gu::BoundsBatch boundsBatch(boundsArray.begin());
 
 			Sc::BodySim* frozen[MaxTasks], * unfrozen[MaxTasks];
 			PxU32 nbFrozen = 0, nbUnfrozen = 0;
@@ -183,7 +185,7 @@ namespace
 
 					// PT: TODO: remove duplicate "isFrozen" test inside updateCached
 	//				bodySim->updateCached(NULL);
-					bodySim->updateCached(mCache, boundsArray);
+					bodySim->updateCached(mCache, boundsArray, boundsBatch);
 				}
 
 				if(llBody.isFreezeThisFrame() && isFrozen)
@@ -205,6 +207,8 @@ namespace
 				}
 				llBody.clearAllFrameFlags();
 			}
+			boundsBatch.flush();
+
 			if(nbBpUpdates)
 			{
 				mCache.setChangedState();
@@ -585,9 +589,11 @@ namespace
 
 static Bp::AABBManagerBase* createAABBManagerCPU(const PxSceneDesc& desc, Bp::BroadPhase* broadPhase, Bp::BoundsArray* boundsArray, PxFloatArrayPinned* contactDistances, PxVirtualAllocator& allocator, PxU64 contextID)
 {
-	return PX_NEW(Bp::AABBManager)(*broadPhase, *boundsArray, *contactDistances,
+	Bp::AABBManager* manager = PX_NEW(Bp::AABBManager)(*broadPhase, *boundsArray, *contactDistances,
 		desc.limits.maxNbAggregates, desc.limits.maxNbStaticShapes + desc.limits.maxNbDynamicShapes, allocator, contextID,
 		desc.kineKineFilteringMode, desc.staticKineFilteringMode);
+	manager->setBoundsCoherence(desc.broadPhaseCoherenceMargin, desc.broadPhaseCoherencePrediction);
+	return manager;
 }
 
 #if PX_SUPPORT_GPU_PHYSX
@@ -621,6 +627,12 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mCCDContext						(NULL),
 	mNumFastMovingShapes			(0),
 	mCCDPass						(0),
+	mCCDMaxPasses					(1),
+	mMemoryBudget					(desc.simulationMemoryBudget),
+	mMemoryBudgetPeak				(0),
+	mNbDroppedContactReports		(0),
+	mNbCappedCCDPasses				(0),
+	mMemoryBudgetDegraded			(false),
 	mSimpleIslandManager			(NULL),
 	mDynamicsContext				(NULL),
 	mMemoryManager					(NULL),
@@ -631,6 +643,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mSimulationController			(NULL),
 	mSimulationControllerCallback	(NULL),
 	mGravity						(PxVec3(0.0f)),
+	mFieldEffectorsDirty			(false),
 	mDt								(0),
 	mOneOverDt						(0),
 	mTimeStamp						(1),		// PT: has to start to 1 to fix determinism bug. I don't know why yet but it works.
@@ -671,6 +684,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mPostNarrowPhase				(contextID, this, "ScScene.postNarrowPhase"),
 	mFinalizationPhase				(contextID, this, "ScScene.finalizationPhase"),
 	mUpdateCCDMultiPass				(contextID, this, "ScScene.updateCCDMultiPass"),
+	mAdvanceStepChainConfig			(0),
 	mAfterIntegration				(contextID, this, "ScScene.afterIntegration"),
 	mPostSolver						(contextID, this, "ScScene.postSolver"),
 	mSolver							(contextID, this, "ScScene.rigidBodySolver"),
@@ -751,6 +765,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 		mActiveInteractionCount[i] = 0;
 
 	mStats						= PX_NEW(SimStats);
+	resetStageTimings();
 	mConstraintIDTracker		= PX_NEW(ObjectIDTracker);
 	mActorIDTracker				= PX_NEW(ObjectIDTracker);
 	mElementIDPool				= PX_NEW(ObjectIDTracker);
@@ -988,6 +1003,8 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mDynamicsContext->setFrictionOffsetThreshold(desc.frictionOffsetThreshold);
 	mDynamicsContext->setCCDSeparationThreshold(desc.ccdMaxSeparation);
 	mDynamicsContext->setCorrelationDistance(desc.frictionCorrelationDistance);
+	mDynamicsContext->setSolverResidualTolerance(desc.solverResidualTolerance);
+	mDynamicsContext->setSolverMinIterations(desc.solverMinIterations);
 
 	const PxTolerancesScale& scale = Physics::getInstance().getTolerancesScale();
 	mLLContext->setMeshContactMargin(0.01f * scale.length);
@@ -1176,6 +1193,24 @@ void Sc::Scene::preAllocate(PxU32 nbStatics, PxU32 nbBodies, PxU32 nbStaticShape
 	mShapeSimPool->preAllocate(nbStaticShapes + nbDynamicShapes);
 }
 
+void Sc::Scene::preAllocateBatchInsertion(PxU32 nbTotalStatics, PxU32 nbTotalBodies, PxU32 nbNewShapes)
+{
+	// PT: used by addActors() to do one allocation per array for the whole batch, instead of letting each
+	// shape grow them one power-of-two at a time. Pool sizes are total capacities, not additional ones.
+	mStaticSimPool->preAllocate(nbTotalStatics);
+	mBodySimPool->preAllocate(nbTotalBodies);
+
+	if(!nbNewShapes)
+		return;
+
+	// PT: element IDs are recycled so the current max ID plus the new shapes is an upper bound for the indices we'll see
+	const PxU32 nbTotalElements = mElementIDPool->getMaxID() + nbNewShapes;
+	mShapeSimPool->preAllocate(nbTotalElements);
+	mBoundsArray->reserve(nbTotalElements);
+	mLLContext->getTransformCache().reserve(nbTotalElements);
+	mAABBManager->reserveSpaceForBatch(nbTotalElements);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void Sc::Scene::addDirtyArticulationSim(Sc::ArticulationSim* artiSim)
@@ -1535,6 +1570,7 @@ void Sc::Scene::advance(PxReal timeStep, PxBaseTask* continuation)
 	if(timeStep != 0.0f)
 	{
 		setElapsedTime(timeStep);
+		prepareFieldEffectors();
 
 		mAdvanceStep.setContinuation(continuation);
 
@@ -1570,6 +1606,8 @@ void Sc::Scene::endSimulation()
 
 	mNPhaseCore->preparePersistentContactEventListForNextFrame();
 
+	releaseOneShotFieldEffectors();
+
 	mSimulationController->releaseDeferredArticulationIds();
 
 #if PX_SUPPORT_GPU_PHYSX
@@ -1595,6 +1633,80 @@ void Sc::Scene::endSimulation()
 	PxcDisplayContactCacheStats();
 }
 
+PxU32 Sc::Scene::addFieldEffector(const PxFieldEffector& effector)
+{
+	PxU32 id;
+	if(mFreeFieldEffectorIds.size())
+	{
+		id = mFreeFieldEffectorIds.popBack();
+		mFieldEffectors[id] = effector;
+	}
+	else
+	{
+		id = mFieldEffectors.size();
+		mFieldEffectors.pushBack(effector);
+	}
+	mFieldEffectorMap.growAndSet(id);
+	mFieldEffectorsDirty = true;
+	return id;
+}
+
+void Sc::Scene::setFieldEffector(PxU32 id, const PxFieldEffector& effector)
+{
+	PX_ASSERT(isFieldEffectorValid(id));
+	mFieldEffectors[id] = effector;
+	mFieldEffectorsDirty = true;
+}
+
+void Sc::Scene::removeFieldEffector(PxU32 id)
+{
+	PX_ASSERT(isFieldEffectorValid(id));
+	mFieldEffectorMap.reset(id);
+	mFreeFieldEffectorIds.pushBack(id);
+	mFieldEffectorsDirty = true;
+}
+
+void Sc::Scene::prepareFieldEffectors()
+{
+	// PT: effectors are only edited between steps, so the packed array is rebuilt here and stays untouched until endSimulation()
+	if(mFieldEffectorsDirty)
+	{
+		mFieldEffectorsDirty = false;
+		mActiveFieldEffectors.forceSize_Unsafe(0);
+
+		PxBitMap::Iterator it(mFieldEffectorMap);
+		PxU32 id;
+		while((id = it.getNext()) != PxBitMap::Iterator::DONE)
+			mActiveFieldEffectors.pushBack(mFieldEffectors[id]);
+	}
+	mDynamicsContext->setFieldEffectors(mActiveFieldEffectors.begin(), mActiveFieldEffectors.size());
+}
+
+void Sc::Scene::releaseOneShotFieldEffectors()
+{
+	mDynamicsContext->setFieldEffectors(NULL, 0);
+
+	bool hasOneShot = false;
+	for(PxU32 i=0; i<mActiveFieldEffectors.size(); i++)
+	{
+		if(mActiveFieldEffectors[i].type == PxFieldEffectorType::eRADIAL_EXPLOSION)
+		{
+			hasOneShot = true;
+			break;
+		}
+	}
+	if(!hasOneShot)
+		return;
+
+	PxBitMap::Iterator it(mFieldEffectorMap);
+	PxU32 id;
+	while((id = it.getNext()) != PxBitMap::Iterator::DONE)
+	{
+		if(mFieldEffectors[id].type == PxFieldEffectorType::eRADIAL_EXPLOSION)
+			removeFieldEffector(id);
+	}
+}
+
 void Sc::Scene::flush(bool sendPendingReports)
 {
 	if (sendPendingReports)
@@ -1641,6 +1753,37 @@ void Sc::Scene::flush(bool sendPendingReports)
 	mLLContext->getNpMemBlockPool().releaseUnusedBlocks();
 }
 
+// PT: unlike flush() this keeps all the simulation state and pending reports. It only gives back the memory
+// that pools kept around after their peak usage, e.g. after a large number of objects has been removed.
+PxU32 Sc::Scene::compactMemory()
+{
+	PxU32 nbReleased = mNPhaseCore->compactMemory();
+
+	nbReleased += mShapeSimPool->releaseEmptyRegions();
+	nbReleased += mStaticSimPool->releaseEmptyRegions();
+	nbReleased += mBodySimPool->releaseEmptyRegions();
+	nbReleased += mConstraintSimPool.releaseEmptySlabs();
+	nbReleased += mArticulationJointSimPool.releaseEmptySlabs();
+	nbReleased += mConstraintInteractionPool.releaseEmptySlabs();
+	nbReleased += mSimStateDataPool->releaseEmptySlabs();
+
+	nbReleased += mPointerBlock8Pool.releaseEmptySlabs();
+	nbReleased += mPointerBlock16Pool.releaseEmptySlabs();
+	nbReleased += mPointerBlock32Pool.releaseEmptySlabs();
+	nbReleased += mMemBlock128Pool.releaseEmptySlabs();
+	nbReleased += mMemBlock256Pool.releaseEmptySlabs();
+	nbReleased += mMemBlock384Pool.releaseEmptySlabs();
+	nbReleased += mMemBlock512Pool.releaseEmptySlabs();
+
+	nbReleased += mLLContext->compactMemory();
+
+	mActiveBodies.shrink();
+	for(PxU32 i=0; i < InteractionType::eTRACKED_IN_SCENE_COUNT; i++)
+		mInteractions[i].shrink();
+
+	return nbReleased;
+}
+
 // User callbacks
 
 void Sc::Scene::setSimulationEventCallback(PxSimulationEventCallback* callback)
@@ -2194,6 +2337,146 @@ void Sc::Scene::postCallbacksPreSync()
 	releaseConstraints(true); //release constraint blocks at the end of the frame, so user can retrieve the blocks
 }
 
+void Sc::Scene::resetStageTimings()
+{
+	PxMemZero(mStageTimings, sizeof(mStageTimings));
+	mStepStartTime = mStepEndTime = PxTime::getCurrentCounterValue();
+}
+
+void Sc::Scene::getStageTimings(PxSimulationStageTimings& timings) const
+{
+	const PxCounterFrequencyToTensOfNanos& freq = PxTime::getBootCounterFrequency();
+	const PxReal tensOfNanosToMs = 1e-5f;
+
+	for(PxU32 i=0; i<PxSimulationStage::eCOUNT; i++)
+	{
+		const StageTiming& src = mStageTimings[i];
+		PxSimulationStageTiming& dst = timings.stages[i];
+		dst.nbCalls = src.mNbCalls;
+		dst.nbItems = src.mNbItems;
+		if(src.mNbCalls)
+		{
+			dst.startTime	= PxReal(freq.toTensOfNanos(src.mStart - mStepStartTime)) * tensOfNanosToMs;
+			dst.endTime		= PxReal(freq.toTensOfNanos(src.mEnd - mStepStartTime)) * tensOfNanosToMs;
+		}
+		else
+		{
+			dst.startTime = dst.endTime = 0.0f;
+		}
+	}
+	timings.totalTime = PxReal(freq.toTensOfNanos(mStepEndTime - mStepStartTime)) * tensOfNanosToMs;
+}
+
+void Sc::Scene::setNarrowPhaseAttribution(bool enabled)
+{
+	mLLContext->setNarrowPhaseAttribution(enabled);
+}
+
+bool Sc::Scene::getNarrowPhaseAttribution() const
+{
+	return mLLContext->getNarrowPhaseAttribution();
+}
+
+namespace
+{
+	struct PairCostGreater
+	{
+		PX_FORCE_INLINE bool operator()(const PxcNpPairCost& a, const PxcNpPairCost& b) const	{ return a.mTicks > b.mTicks;	}
+	};
+
+	struct ActorCost
+	{
+		const PxActor*	mActor;
+		PxU64			mTicks;
+		PxU32			mNbPairs;
+	};
+
+	struct ActorCostGreater
+	{
+		PX_FORCE_INLINE bool operator()(const ActorCost& a, const ActorCost& b) const	{ return a.mTicks > b.mTicks;	}
+	};
+
+	PX_FORCE_INLINE PxReal ticksToMicroseconds(PxU64 ticks)
+	{
+		return PxReal(PxTime::getBootCounterFrequency().toTensOfNanos(ticks)) * 0.01f;
+	}
+
+	void addActorCost(PxArray<ActorCost>& costs, PxHashMap<const PxActor*, PxU32>& map, const PxActor* actor, PxU64 ticks)
+	{
+		const PxHashMap<const PxActor*, PxU32>::Entry* entry = map.find(actor);
+		if(entry)
+		{
+			ActorCost& cost = costs[entry->second];
+			cost.mTicks += ticks;
+			cost.mNbPairs++;
+		}
+		else
+		{
+			map.insert(actor, costs.size());
+			ActorCost& cost = costs.insert();
+			cost.mActor = actor;
+			cost.mTicks = ticks;
+			cost.mNbPairs = 1;
+		}
+	}
+}
+
+PxU32 Sc::Scene::getNarrowPhasePairCosts(PxNarrowPhasePairCost* userBuffer, PxU32 bufferSize) const
+{
+	const PxArray<PxcNpPairCost>& pairCosts = mLLContext->getNarrowPhasePairCosts();
+	const PxU32 nbPairs = pairCosts.size();
+	if(!nbPairs || !bufferSize)
+		return 0;
+
+	// PT: work on a copy since the user can ask for the same data several times
+	PxArray<PxcNpPairCost> sorted(pairCosts);
+	PxSort(sorted.begin(), nbPairs, PairCostGreater());
+
+	const PxU32 nb = PxMin(nbPairs, bufferSize);
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxcNpPairCost& src = sorted[i];
+		PxNarrowPhasePairCost& dst = userBuffer[i];
+		dst.shapes[0] = src.mShape0;
+		dst.shapes[1] = src.mShape1;
+		dst.actors[0] = src.mActor0;
+		dst.actors[1] = src.mActor1;
+		dst.time = ticksToMicroseconds(src.mTicks);
+	}
+	return nb;
+}
+
+PxU32 Sc::Scene::getNarrowPhaseActorCosts(PxNarrowPhaseActorCost* userBuffer, PxU32 bufferSize) const
+{
+	const PxArray<PxcNpPairCost>& pairCosts = mLLContext->getNarrowPhasePairCosts();
+	const PxU32 nbPairs = pairCosts.size();
+	if(!nbPairs || !bufferSize)
+		return 0;
+
+	PxArray<ActorCost> actorCosts;
+	PxHashMap<const PxActor*, PxU32> map;
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		const PxcNpPairCost& pairCost = pairCosts[i];
+		addActorCost(actorCosts, map, pairCost.mActor0, pairCost.mTicks);
+		addActorCost(actorCosts, map, pairCost.mActor1, pairCost.mTicks);
+	}
+
+	const PxU32 nbActors = actorCosts.size();
+	PxSort(actorCosts.begin(), nbActors, ActorCostGreater());
+
+	const PxU32 nb = PxMin(nbActors, bufferSize);
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const ActorCost& src = actorCosts[i];
+		PxNarrowPhaseActorCost& dst = userBuffer[i];
+		dst.actor = src.mActor;
+		dst.time = ticksToMicroseconds(src.mTicks);
+		dst.nbPairs = src.mNbPairs;
+	}
+	return nb;
+}
+
 void Sc::Scene::getStats(PxSimulationStatistics& s) const
 {
 	mStats->readOut(s, mLLContext->getSimStats());
@@ -2206,6 +2489,37 @@ void Sc::Scene::getStats(PxSimulationStatistics& s) const
 	for(PxU32 i=0; i<PxGeometryType::eGEOMETRY_COUNT; i++)
 		s.nbShapes[i] = mNbGeometries[i];
 
+	s.budgetedMemoryPeak = mMemoryBudgetPeak;
+	s.nbDroppedContactReports = mNbDroppedContactReports;
+	s.nbCappedCCDPasses = mNbCappedCCDPasses;
+
+	const PxcScratchAllocator& scratchAllocator = mLLContext->getScratchAllocator();
+	s.peakScratchMemory = scratchAllocator.getPeakUsage();
+	s.scratchHeapFallbackMemory = scratchAllocator.getHeapFallbackSize();
+
+	// PT: the island stats are computed here rather than during the simulation, so they cost nothing when not queried
+	{
+		const IG::IslandSim& islandSim = mSimpleIslandManager->getAccurateIslandSim();
+		const PxU32 nbIslands = islandSim.getNbActiveIslands();
+		const IG::IslandId* islandIds = islandSim.getActiveIslands();
+		s.nbActiveIslands = nbIslands;
+		for(PxU32 i=0; i<nbIslands; i++)
+		{
+			const IG::Island& island = islandSim.getIsland(islandIds[i]);
+			PxU32 nbNodes = 0;
+			for(PxU32 j=0; j<IG::Node::eTYPE_COUNT; j++)
+				nbNodes += island.mNodeCount[j];
+
+			PxU32 bucket = 0;
+			while(nbNodes>1 && bucket<PxSimulationStatistics::eISLAND_SIZE_BUCKET_COUNT-1)
+			{
+				nbNodes >>= 1;
+				bucket++;
+			}
+			s.islandSizeHistogram[bucket]++;
+		}
+	}
+
 #if PX_SUPPORT_GPU_PHYSX
 	if (mHeapMemoryAllocationManager)
 	{
@@ -2253,6 +2567,24 @@ void Sc::Scene::getStats(PxSimulationStatistics& s) const
 	}
 }
 
+// PT: decides once per step, from the peak block usage of the previous step, whether the scene runs degraded.
+// We do not react within a step because the contact, friction and constraint blocks are acquired concurrently
+// by the narrow phase and solver tasks.
+void Sc::Scene::updateMemoryBudget()
+{
+	PxcNpMemBlockPool& blockPool = mLLContext->getNpMemBlockPool();
+
+	mMemoryBudgetPeak = blockPool.getMaxUsedBlockCountSinceReset() * PxU32(PxcNpMemBlock::SIZE);
+	blockPool.resetMaxUsedBlockCountSinceReset();
+
+	mNbDroppedContactReports = 0;
+	mMemoryBudgetDegraded = mMemoryBudget && PxU64(mMemoryBudgetPeak)*4 >= PxU64(mMemoryBudget)*3;
+
+	const PxU32 ccdMaxPasses = mMemoryBudgetDegraded ? 1 : mCCDMaxPasses;
+	mNbCappedCCDPasses = mCCDMaxPasses - ccdMaxPasses;
+	mCCDContext->setCCDMaxPasses(ccdMaxPasses);
+}
+
 void Sc::Scene::addShapes(NpShape *const* shapes, PxU32 nbShapes, size_t ptrOffset, RigidSim& bodySim, PxBounds3* outBounds)
 {
 	const PxNodeIndex nodeIndex = bodySim.getNodeIndex();
@@ -2673,6 +3005,84 @@ PxActor** Sc::Scene::getFrozenActors(PxU32& nbActorsOut)
 	return mFrozenActors.begin();
 }
 
+void Sc::Scene::buildBodyStreams()
+{
+	PxU32 numActiveBodies;
+	BodyCore*const* PX_RESTRICT activeBodies;
+	if(!(getFlags() & PxSceneFlag::eEXCLUDE_KINEMATICS_FROM_ACTIVE_ACTORS))
+	{
+		numActiveBodies = getNumActiveBodies();
+		activeBodies = getActiveBodiesArray();
+	}
+	else
+	{
+		numActiveBodies = getActiveDynamicBodiesCount();
+		activeBodies = getActiveDynamicBodies();
+	}
+
+	// PT: sized for all active bodies, frozen ones are skipped below
+	mBodyStreamActors.resizeUninitialized(numActiveBodies);
+	mBodyStreamPositions.resizeUninitialized(numActiveBodies);
+	mBodyStreamOrientations.resizeUninitialized(numActiveBodies);
+	mBodyStreamLinearVelocities.resizeUninitialized(numActiveBodies);
+	mBodyStreamAngularVelocities.resizeUninitialized(numActiveBodies);
+
+	PxRigidActor** PX_RESTRICT actors = mBodyStreamActors.begin();
+	PxVec4* PX_RESTRICT positions = mBodyStreamPositions.begin();
+	PxQuat* PX_RESTRICT orientations = mBodyStreamOrientations.begin();
+	PxVec4* PX_RESTRICT linVels = mBodyStreamLinearVelocities.begin();
+	PxVec4* PX_RESTRICT angVels = mBodyStreamAngularVelocities.begin();
+
+	PxU32 nb = 0;
+	for(PxU32 i=0;i<numActiveBodies;i++)
+	{
+		const BodyCore* body = activeBodies[i];
+		if(i+1<numActiveBodies)
+			PxPrefetchLine(activeBodies[i+1]);
+
+		if(body->isFrozen())
+			continue;
+
+		// PT: same as NpRigidDynamic::getGlobalPoseFast()
+		// PT:: tag: scalar transform*transform
+		const PxTransform globalPose = body->getBody2World() * body->getBody2Actor().getInverse();
+		const PxVec3& linVel = body->getLinearVelocity();
+		const PxVec3& angVel = body->getAngularVelocity();
+
+		actors[nb] = static_cast<PxRigidActor*>(body->getPxActor());
+		positions[nb] = PxVec4(globalPose.p, 0.0f);
+		orientations[nb] = globalPose.q;
+		linVels[nb] = PxVec4(linVel, 0.0f);
+		angVels[nb] = PxVec4(angVel, 0.0f);
+		nb++;
+	}
+
+	mBodyStreamActors.forceSize_Unsafe(nb);
+	mBodyStreamPositions.forceSize_Unsafe(nb);
+	mBodyStreamOrientations.forceSize_Unsafe(nb);
+	mBodyStreamLinearVelocities.forceSize_Unsafe(nb);
+	mBodyStreamAngularVelocities.forceSize_Unsafe(nb);
+}
+
+void Sc::Scene::clearBodyStreams()
+{
+	mBodyStreamActors.forceSize_Unsafe(0);
+	mBodyStreamPositions.forceSize_Unsafe(0);
+	mBodyStreamOrientations.forceSize_Unsafe(0);
+	mBodyStreamLinearVelocities.forceSize_Unsafe(0);
+	mBodyStreamAngularVelocities.forceSize_Unsafe(0);
+}
+
+void Sc::Scene::getBodyStreams(PxRigidBodyStreams& streams) const
+{
+	streams.actors				= mBodyStreamActors.begin();
+	streams.positions			= mBodyStreamPositions.begin();
+	streams.orientations		= mBodyStreamOrientations.begin();
+	streams.linearVelocities	= mBodyStreamLinearVelocities.begin();
+	streams.angularVelocities	= mBodyStreamAngularVelocities.begin();
+	streams.nbBodies			= mBodyStreamActors.size();
+}
+
 void Sc::Scene::reserveTriggerReportBufferSpace(const PxU32 pairCount, PxTriggerPair*& triggerPairBuffer, TriggerPairExtraData*& triggerPairExtraBuffer)
 {
 	const PxU32 oldSize = mTriggerBufferAPI.size();
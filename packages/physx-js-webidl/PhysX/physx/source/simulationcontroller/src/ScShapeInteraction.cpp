@@ -470,7 +470,7 @@ void Sc::ShapeInteraction::processUserNotificationAsync(PxU32 contactEvent, PxU1
 				PX_ASSERT(0==(reinterpret_cast<const uintptr_t>(output->contactPatches) & 0x0f));  // check 16Byte alignment
 				contactPatchData =  output->contactPatches;
 				contactPointData = output->contactPoints;
-				cDataSize = sizeof(PxContactPatch)*output->nbPatches + sizeof(PxContact)*output->nbContacts;
+				cDataSize = sizeof(PxContactPatch)*output->nbPatches + output->getContactPointsSize();
 				alignedContactDataSize = (cDataSize + 0xf) & 0xfffffff0;
 				impulses = output->contactForces;
 			}
@@ -602,7 +602,7 @@ PxU32 Sc::ShapeInteraction::getContactPointData(const void*& contactPatches, con
 				{
 					contactPatches = output->contactPatches;
 					contactPoints = output->contactPoints;
-					contactDataSize = sizeof(PxContactPatch) * output->nbPatches + sizeof(PxContact) * output->nbContacts;
+					contactDataSize = sizeof(PxContactPatch) * output->nbPatches + output->getContactPointsSize();
 					contactPointCount = output->nbContacts;
 					numPatches = output->nbPatches;
 					impulses = output->contactForces;
@@ -967,6 +967,10 @@ bool Sc::ShapeInteraction::onDeactivate()
 				raiseFlag(HAS_NO_TOUCH);
 			}
 
+			// PT: give the solver a chance to keep this pair's friction patches, they're used to warm-start it on wake-up
+			if(mEdgeIndex != IG_INVALID_EDGE && mManager->getTouchStatus())
+				scene.getDynamicsContext()->retainSleepingFrictionPatches(mEdgeIndex, mManager->getWorkUnit());
+
 			destroyManager();	
 			if(mEdgeIndex != IG_INVALID_EDGE)
 				islandManager->clearEdgeRigidCM(mEdgeIndex);
@@ -318,7 +318,7 @@ void ShapeSimBase::updateCached(PxU32 transformCacheFlags, PxBitMapPinned* shape
 		shapeChangedMap->growAndSet(index);
 }
 
-void ShapeSimBase::updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& boundsArray)
+void ShapeSimBase::updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& boundsArray, Gu::BoundsBatch& batch)
 {
 	const PxU32 index = getElementID();
 
@@ -329,8 +329,10 @@ void ShapeSimBase::updateCached(PxsTransformCache& transformCache, Bp::BoundsArr
 
 	ct.flags = 0;
 
-	PxBounds3& b = boundsArray.begin()[index];
-	Gu::computeBounds(b, getCore().getGeometryUnion().getGeometry(), ct.transform, 0.0f, 1.0f);
+	// PT: the batch computes simple shapes 4 at a time, others go through the regular per-shape codepath
+	const PxGeometry& geom = getCore().getGeometryUnion().getGeometry();
+	if(!batch.add(index, geom, ct.transform))
+		Gu::computeBounds(boundsArray.begin()[index], geom, ct.transform, 0.0f, 1.0f);
 }
 
 void ShapeSimBase::updateBPGroup()
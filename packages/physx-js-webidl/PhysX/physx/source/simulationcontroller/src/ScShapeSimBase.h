@@ -33,6 +33,11 @@
 
 namespace physx
 {
+	namespace Gu
+	{
+		class BoundsBatch;
+	}
+
 	namespace Sc
 	{
 		PX_FORCE_INLINE PxU32 isBroadPhase(PxShapeFlags flags) { return PxU32(flags) & PxU32(PxShapeFlag::eTRIGGER_SHAPE | PxShapeFlag::eSIMULATION_SHAPE); }
@@ -97,7 +102,7 @@ namespace physx
 							void					destroySqBounds();
 
 							void					updateCached(PxU32 transformCacheFlags, PxBitMapPinned* shapeChangedMap);
-							void					updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& boundsArray);
+							void					updateCached(PxsTransformCache& transformCache, Bp::BoundsArray& boundsArray, Gu::BoundsBatch& batch);
 							void					updateBPGroup();
 		protected:
 
@@ -27,6 +27,7 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "foundation/PxMemory.h"
+#include "foundation/PxUtilities.h"
 #include "ScSimStats.h"
 #include "PxvSimStats.h"
 #include "PxsHeapMemoryAllocator.h"
@@ -125,6 +126,7 @@ void Sc::SimStats::readOut(PxSimulationStatistics& s, const PxvSimStats& simStat
 	s.nbAxisSolverConstraints = simStats.mNbAxisSolverConstraints;
 
 	s.peakConstraintMemory = simStats.mPeakConstraintBlockAllocations * 16 * 1024;
+	s.peakContactStreamMemory = simStats.mPeakContactBlockAllocations * 16 * 1024;
 	s.compressedContactSize = simStats.mTotalCompressedContactSize;
 	s.requiredContactConstraintMemory = simStats.mTotalConstraintSize;
 	s.nbNewPairs = simStats.mNbNewPairs;
@@ -132,6 +134,10 @@ void Sc::SimStats::readOut(PxSimulationStatistics& s, const PxvSimStats& simStat
 	s.nbNewTouches = simStats.mNbNewTouches;
 	s.nbLostTouches = simStats.mNbLostTouches;
 	s.nbPartitions = simStats.mNbPartitions;
+	s.nbBroadPhaseUpdatedBounds = simStats.mNbBroadPhaseUpdatedBounds;
+	PX_COMPILE_TIME_ASSERT(PxSimulationStatistics::eSOLVER_BATCH_WIDTH_COUNT == PX_ARRAY_SIZE(simStats.mNbSolverBatches));
+	for(PxU32 i=0; i < PxSimulationStatistics::eSOLVER_BATCH_WIDTH_COUNT; i++)
+		s.nbSolverBatches[i] = simStats.mNbSolverBatches[i];
 
 	s.gpuDynamicsMemoryConfigStatistics.tempBufferCapacity = simStats.mGpuDynamicsTempBufferCapacity;
 	s.gpuDynamicsMemoryConfigStatistics.rigidContactCount = simStats.mGpuDynamicsRigidContactCount;
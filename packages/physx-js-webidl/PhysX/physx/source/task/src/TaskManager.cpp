@@ -26,6 +26,8 @@
 
 #include "task/PxTask.h"
 #include "foundation/PxErrors.h"
+#include "foundation/PxFoundation.h"
+#include "foundation/PxMemory.h"
 #include "foundation/PxHashMap.h"
 #include "foundation/PxAllocator.h"
 #include "foundation/PxAtomic.h"
@@ -41,43 +43,155 @@ namespace physx
     const int EOL = -1;
 	typedef PxHashMap<const char *, PxTaskID> PxTaskNameToIDMap;
 
+	const uint32_t INVALID_ROW = 0xffffffff;
+
+	/*
+	 * Append-only table made of fixed-size chunks. Rows never move once allocated, so they can be
+	 * read and updated without a lock while other threads append new rows. Chunks are kept across
+	 * frames, clear() only resets the size.
+	 *
+	 * Chunks are reached through a two-level directory: a fixed array of block pointers, each block
+	 * holding BLOCK_SIZE chunk pointers. Blocks are allocated on demand like chunks, so the table
+	 * grows up to the 2^31 rows addressable by mSize while only the top level is stored inline.
+	 */
+	template<class T>
+	class PxTaskChunkedTable
+	{
+		PX_NOCOPY(PxTaskChunkedTable)
+
+		enum
+		{
+			CHUNK_SHIFT	= 8,
+			CHUNK_SIZE	= 1<<CHUNK_SHIFT,
+			BLOCK_SHIFT	= 13,
+			BLOCK_SIZE	= 1<<BLOCK_SHIFT,
+			MAX_BLOCKS	= 1<<(31-CHUNK_SHIFT-BLOCK_SHIFT)
+		};
+
+		volatile void*		mBlocks[MAX_BLOCKS];	// volatile void*[BLOCK_SIZE], typed for PxAtomicCompareExchangePointer
+		volatile int32_t	mSize;
+		const char*			mName;
+
+		PX_FORCE_INLINE	volatile void**	getBlock(uint32_t i)	const	{ return reinterpret_cast<volatile void**>(const_cast<void*>(mBlocks[i]));	}
+
+		// Returns the array stored in 'slot', allocating 'size' bytes first if it is still NULL. Threads reaching
+		// an empty slot at the same time each allocate an array and race the CAS, the losers free theirs.
+		static void*	getOrAllocate(volatile void*& slot, uint32_t size, bool zero, const char* name)
+		{
+			PX_UNUSED(name);
+			void* ptr = const_cast<void*>(slot);
+			if(!ptr)
+			{
+				void* newPtr = PX_ALLOC(size, name);
+				if(zero)
+					PxMemZero(newPtr, size);
+				ptr = PxAtomicCompareExchangePointer(&slot, newPtr, NULL);
+				if(ptr)
+				{
+					PX_FREE(newPtr);	// another thread allocated it first
+				}
+				else
+					ptr = newPtr;
+			}
+			return ptr;
+		}
+
+	public:
+		PxTaskChunkedTable(const char* name) : mSize(0), mName(name)
+		{
+			for(uint32_t i=0; i<MAX_BLOCKS; i++)
+				mBlocks[i] = NULL;
+		}
+
+		~PxTaskChunkedTable()
+		{
+			for(uint32_t i=0; i<MAX_BLOCKS; i++)
+			{
+				volatile void** block = getBlock(i);
+				if(!block)
+					continue;
+				for(uint32_t j=0; j<BLOCK_SIZE; j++)
+				{
+					void* chunk = const_cast<void*>(block[j]);
+					PX_FREE(chunk);
+				}
+				PX_FREE(block);
+			}
+		}
+
+		PX_FORCE_INLINE	T*			getChunk(uint32_t i)	const	{ return reinterpret_cast<T*>(const_cast<void*>(getBlock(i>>BLOCK_SHIFT)[i&(BLOCK_SIZE-1)]));	}
+		PX_FORCE_INLINE	T&			operator[](uint32_t i)			{ return getChunk(i>>CHUNK_SHIFT)[i&(CHUNK_SIZE-1)];			}
+		PX_FORCE_INLINE	const T&	operator[](uint32_t i)	const	{ return getChunk(i>>CHUNK_SHIFT)[i&(CHUNK_SIZE-1)];			}
+		PX_FORCE_INLINE	uint32_t	size()					const	{ return uint32_t(mSize);							}
+		PX_FORCE_INLINE	void		clear()							{ mSize = 0;										}
+
+		// Reserving a row is a single atomic increment. Only the rows that land on a chunk or block nobody
+		// allocated yet take the slower path in getOrAllocate(). Returns INVALID_ROW when the table is full.
+		uint32_t	allocateRow()
+		{
+			const uint32_t index = uint32_t(PxAtomicIncrement(&mSize)) - 1;
+			const uint32_t chunkIndex = index>>CHUNK_SHIFT;
+			const uint32_t blockIndex = chunkIndex>>BLOCK_SHIFT;
+			if(blockIndex >= MAX_BLOCKS)
+			{
+				PxAtomicDecrement(&mSize);
+				PxGetFoundation().error(PxErrorCode::eOUT_OF_MEMORY, PX_FL, "PxTaskManager: %s is full, row allocation failed.", mName);
+				return INVALID_ROW;
+			}
+
+			volatile void** block = reinterpret_cast<volatile void**>(getOrAllocate(mBlocks[blockIndex], sizeof(void*)*BLOCK_SIZE, true, mName));
+			getOrAllocate(block[chunkIndex&(BLOCK_SIZE-1)], sizeof(T)*CHUNK_SIZE, false, mName);
+			return index;
+		}
+	};
+
 	struct PxTaskDepTableRow
 	{
-		PxTaskID	mTaskID;
-		int			mNextDep;
+		PxTaskID			mTaskID;
+		volatile int32_t	mNextDep;
 	};
-	typedef PxArray<PxTaskDepTableRow> PxTaskDepTable;
+	typedef PxTaskChunkedTable<PxTaskDepTableRow> PxTaskDepTable;
 
 	class PxTaskTableRow
 	{
 	public:
-		PxTaskTableRow() : mRefCount( 1 ), mStartDep(EOL), mLastDep(EOL) {}
-		void addDependency( PxTaskDepTable& depTable, PxTaskID taskID )
+		void init( PxTask* task, PxTaskType::Enum type )
 		{
-			int newDep = int(depTable.size());
-			PxTaskDepTableRow row;
+			mTask = task;
+			mRefCount = 1;
+			mType = int32_t(type);
+			mStartDep = EOL;
+			mLastDep = EOL;
+		}
+
+		// Dependents are appended at the tail without a lock, so they are still dispatched in registration order.
+		// The tail is claimed with an atomic exchange, then the previous tail (or the list head) is linked to the
+		// new row. Dependencies are all registered before the task completes, so resolveRow() sees a complete list.
+		bool addDependency( PxTaskDepTable& depTable, PxTaskID taskID )
+		{
+			const uint32_t newDep = depTable.allocateRow();
+			if(newDep == INVALID_ROW)
+				return false;
+
+			PxTaskDepTableRow& row = depTable[ newDep ];
 			row.mTaskID = taskID;
 			row.mNextDep = EOL;
-			depTable.pushBack( row );
 
-			if( mLastDep == EOL )
-			{
-				mStartDep = mLastDep = newDep;
-			}
+			const int32_t prevDep = PxAtomicExchange( &mLastDep, int32_t(newDep) );
+			if( prevDep == EOL )
+				mStartDep = int32_t(newDep);
 			else
-			{
-				depTable[ uint32_t(mLastDep) ].mNextDep = newDep;
-				mLastDep = newDep;
-			}
+				depTable[ uint32_t(prevDep) ].mNextDep = int32_t(newDep);
+			return true;
 		}
 
 		PxTask *    mTask;
 		volatile int mRefCount;
-		PxTaskType::Enum mType;
-		int       mStartDep;
-		int       mLastDep;
+		volatile int32_t mType;		// PxTaskType::Enum, swapped atomically to eCOMPLETED on dispatch
+		volatile int32_t mStartDep;
+		volatile int32_t mLastDep;
 	};
-	typedef PxArray<PxTaskTableRow> PxTaskTable;
+	typedef PxTaskChunkedTable<PxTaskTableRow> PxTaskTable;
 
 
 /* Implementation of PxTaskManager abstract API */
@@ -127,7 +241,7 @@ public:
 	PxCpuDispatcher*	mCpuDispatcher;
 	PxTaskNameToIDMap	mName2IDmap;
 	volatile int		mPendingTasks;
-    PxMutex				mMutex;
+    PxMutex				mMutex;				// only protects mName2IDmap
 
 	PxTaskDepTable		mDepTable;
 	PxTaskTable			mTaskTable;
@@ -233,25 +347,19 @@ void PxTaskMgr::stopSimulation()
 
 PxTaskID PxTaskMgr::getNamedTask( const char *name )
 {
-	const PxTaskNameToIDMap::Entry *ret;
     {
         LOCK();
-		ret = mName2IDmap.find( name );
+		const PxTaskNameToIDMap::Entry *ret = mName2IDmap.find( name );
+		if( ret )
+			return ret->second;
     }
-    if( ret )
-	{
-        return ret->second;
-	}
-    else
-	{
-        // create named entry in task table, without a task
-        return submitNamedTask( NULL, name, PxTaskType::eNOT_PRESENT );
-	}
+
+	// create named entry in task table, without a task
+	return submitNamedTask( NULL, name, PxTaskType::eNOT_PRESENT );
 }
 
 PxTask* PxTaskMgr::getTaskFromID( PxTaskID id )
 {
-	LOCK(); // todo: reader lock necessary?
 	return mTaskTable[ id ].mTask;
 }
 
@@ -276,24 +384,23 @@ PxTaskID PxTaskMgr::submitNamedTask( PxTask *task, const char *name, PxTaskType:
 			PX_ASSERT( !mTaskTable[ prereg ].mTask );
 			PX_ASSERT( mTaskTable[ prereg ].mType == PxTaskType::eNOT_PRESENT );
 			mTaskTable[ prereg ].mTask = task;
-			mTaskTable[ prereg ].mType = type;
+			mTaskTable[ prereg ].mType = int32_t(type);
 			task->mTaskID = prereg;
 		}
 		return prereg;
     }
     else
     {
+        const PxTaskID id = static_cast<PxTaskID>(mTaskTable.allocateRow());
+        if( id == INVALID_ROW )
+            return id;
         PxAtomicIncrement(&mPendingTasks);
-        PxTaskID id = static_cast<PxTaskID>(mTaskTable.size());
+        mTaskTable[ id ].init( task, type );
         mName2IDmap[ name ] = id;
         if( task )
 		{
             task->mTaskID = id;
 		}
-        PxTaskTableRow r;
-        r.mTask = task;
-        r.mType = type;
-		mTaskTable.pushBack(r);
         return id;
     }
 }
@@ -303,18 +410,17 @@ PxTaskID PxTaskMgr::submitNamedTask( PxTask *task, const char *name, PxTaskType:
  */
 PxTaskID PxTaskMgr::submitUnnamedTask( PxTask& task, PxTaskType::Enum type )
 {
-    PxAtomicIncrement(&mPendingTasks);
-
 	task.mTm = this;
     task.submitted();
-    
-	LOCK();
-    task.mTaskID = static_cast<PxTaskID>(mTaskTable.size());
-    PxTaskTableRow r;
-    r.mTask = &task;
-    r.mType = type;
-    mTaskTable.pushBack(r);
-    return task.mTaskID;
+
+	// Rows never move, so reserving one is enough and no lock is needed
+	const PxTaskID id = static_cast<PxTaskID>(mTaskTable.allocateRow());
+	if( id == INVALID_ROW )
+		return id;
+    PxAtomicIncrement(&mPendingTasks);
+	mTaskTable[ id ].init( &task, type );
+    task.mTaskID = id;
+    return id;
 }
 
 /* Called by worker threads (or cooperating application threads) when a
@@ -324,7 +430,6 @@ PxTaskID PxTaskMgr::submitUnnamedTask( PxTask& task, PxTaskType::Enum type )
  */
 void PxTaskMgr::taskCompleted( PxTask& task )
 {
-    LOCK();
 	resolveRow(task.mTaskID);
 }
 
@@ -336,11 +441,10 @@ void PxTaskMgr::taskCompleted( PxTask& task )
  */
 void PxTaskMgr::finishBefore( PxTask& task, PxTaskID taskID )
 {
-    LOCK();
 	PX_ASSERT( mTaskTable[ taskID ].mType != PxTaskType::eCOMPLETED );
 
-    mTaskTable[ task.mTaskID ].addDependency( mDepTable, taskID );
-	PxAtomicIncrement( &mTaskTable[ taskID ].mRefCount );
+    if( mTaskTable[ task.mTaskID ].addDependency( mDepTable, taskID ) )
+		PxAtomicIncrement( &mTaskTable[ taskID ].mRefCount );
 }
 
 /*
@@ -349,16 +453,14 @@ void PxTaskMgr::finishBefore( PxTask& task, PxTaskID taskID )
  */
 void PxTaskMgr::startAfter( PxTask& task, PxTaskID taskID )
 {
-    LOCK();
 	PX_ASSERT( mTaskTable[ taskID ].mType != PxTaskType::eCOMPLETED );
 
-    mTaskTable[ taskID ].addDependency( mDepTable, task.mTaskID );
-	PxAtomicIncrement( &mTaskTable[ task.mTaskID ].mRefCount );
+    if( mTaskTable[ taskID ].addDependency( mDepTable, task.mTaskID ) )
+		PxAtomicIncrement( &mTaskTable[ task.mTaskID ].mRefCount );
 }
 
 void PxTaskMgr::addReference( PxTaskID taskID )
 {
-    LOCK();
     PxAtomicIncrement( &mTaskTable[ taskID ].mRefCount );
 }
 
@@ -367,8 +469,6 @@ void PxTaskMgr::addReference( PxTaskID taskID )
  */
 void PxTaskMgr::decrReference( PxTaskID taskID )
 {
-    LOCK();
-
     if( !PxAtomicDecrement( &mTaskTable[ taskID ].mRefCount ) )
     {
 		dispatchTask(taskID);
@@ -410,17 +510,17 @@ void PxTaskMgr::resolveRow( PxTaskID taskID )
  */
 void PxTaskMgr::dispatchTask( PxTaskID taskID )
 {
-	LOCK(); // todo: reader lock necessary?
     PxTaskTableRow& tt = mTaskTable[ taskID ];
 
-	// prevent re-submission
-    if( tt.mType == PxTaskType::eCOMPLETED )
+	// prevent re-submission, the type is swapped atomically so only one thread can dispatch a task
+	const PxTaskType::Enum type = PxTaskType::Enum( PxAtomicExchange( &tt.mType, int32_t(PxTaskType::eCOMPLETED) ) );
+    if( type == PxTaskType::eCOMPLETED )
     {		
 		mErrorCallback.reportError(PxErrorCode::eDEBUG_WARNING, "PxTask dispatched twice", PX_FL);
 		return;
     }
 
-    switch ( tt.mType )
+    switch ( type )
     {
     case PxTaskType::eCPU:
         mCpuDispatcher->submitTask( *tt.mTask );
@@ -437,8 +537,6 @@ void PxTaskMgr::dispatchTask( PxTaskID taskID )
         resolveRow( taskID );
         break;
     }
-
-    tt.mType = PxTaskType::eCOMPLETED;
 }
 
 }// end physx namespace
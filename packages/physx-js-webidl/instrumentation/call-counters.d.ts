@@ -0,0 +1,38 @@
+/** Calls and estimated marshalled bytes of a single bound method, accessor or constructor. */
+export interface CallCounterEntry {
+  /** "Class.method", "Class.attribute (get)", "Class.attribute (set)" or "Class.constructor". */
+  name: string;
+  calls: number;
+  bytes: number;
+}
+
+export interface CallCounterReport {
+  /** Total number of JS -> WASM calls. */
+  calls: number;
+  /** Estimated number of bytes marshalled across the boundary (arguments and return values). */
+  bytes: number;
+  /** Per-method counters, sorted by decreasing call count. Methods that were not called are omitted. */
+  methods: CallCounterEntry[];
+}
+
+export interface CallCounterFrameReport extends CallCounterReport {
+  /** Index of the frame, starting at 0 after installation or reset(). */
+  frame: number;
+}
+
+export interface CallCounters {
+  /** Closes the current frame and returns its report. */
+  endFrame(maxEntries?: number): CallCounterFrameReport;
+  /** Returns the cumulative report since installation or the last reset(). */
+  getTotals(maxEntries?: number): CallCounterReport;
+  /** Clears all counters. */
+  reset(): void;
+  /** Restores the original glue. Objects created while instrumented remain valid. */
+  uninstall(): void;
+}
+
+/**
+ * Instruments a loaded PhysX module in place, counting calls per bound method and the bytes marshalled across the
+ * JS/WASM boundary. Installing twice returns the existing counters.
+ */
+export function installCallCounters(physx: object): CallCounters;
@@ -0,0 +1,198 @@
+// Boundary-crossing counters for the PhysX WebIDL bindings.
+//
+// Wraps every bound method, property accessor and constructor of a loaded PhysX module so that each JS -> WASM call is
+// counted per method, together with an estimate of the bytes marshalled across the boundary. Works with any build
+// (release, simd, mt, profile); it only touches the JS glue objects, not the wasm binary.
+//
+// Usage:
+//   import { installCallCounters } from "@hyperscape/physx-js-webidl/call-counters";
+//   const counters = installCallCounters(PHYSX);
+//   ...
+//   const frame = counters.endFrame(); // once per simulation frame
+//   console.table(frame.methods.slice(0, 20));
+//
+// The byte counts are estimates: numbers, booleans and wrapped objects (pointers) count as 4 bytes, strings as their
+// UTF-8 size plus the terminator, typed arrays as their byteLength and plain arrays as 4 bytes per element.
+
+const POINTER_SIZE = 4;
+
+// Properties of the glue prototypes that are not bound methods
+const SKIPPED_PROPERTIES = new Set(["constructor", "__class__"]);
+
+const textEncoder = new TextEncoder();
+
+function estimateSize(value) {
+  switch (typeof value) {
+    case "number":
+    case "boolean":
+      return 4;
+    case "bigint":
+      return 8;
+    case "string":
+      return textEncoder.encode(value).length + 1;
+    case "object":
+      if (value === null) return POINTER_SIZE;
+      if (ArrayBuffer.isView(value)) return value.byteLength;
+      if (Array.isArray(value)) return value.length * 4;
+      return POINTER_SIZE;
+    default:
+      return 0;
+  }
+}
+
+function estimateArgsSize(args) {
+  let size = 0;
+  for (let i = 0; i < args.length; i++) size += estimateSize(args[i]);
+  return size;
+}
+
+// A bound interface is a function whose prototype was set up by the WebIDL binder (prototype.__class__ points back to it)
+function isBoundClass(value) {
+  return (
+    typeof value === "function" &&
+    value.prototype !== undefined &&
+    Object.prototype.hasOwnProperty.call(value.prototype, "__class__")
+  );
+}
+
+function createStats(name) {
+  return { name, calls: 0, bytes: 0, frameCalls: 0, frameBytes: 0 };
+}
+
+function toEntries(statsList, frame, maxEntries) {
+  const entries = [];
+  for (const stats of statsList) {
+    const calls = frame ? stats.frameCalls : stats.calls;
+    if (!calls) continue;
+    entries.push({ name: stats.name, calls, bytes: frame ? stats.frameBytes : stats.bytes });
+  }
+  entries.sort((a, b) => b.calls - a.calls || b.bytes - a.bytes);
+  return maxEntries !== undefined ? entries.slice(0, maxEntries) : entries;
+}
+
+function makeReport(statsList, frame, maxEntries) {
+  let calls = 0;
+  let bytes = 0;
+  for (const stats of statsList) {
+    calls += frame ? stats.frameCalls : stats.calls;
+    bytes += frame ? stats.frameBytes : stats.bytes;
+  }
+  return { calls, bytes, methods: toEntries(statsList, frame, maxEntries) };
+}
+
+/**
+ * Instruments a loaded PhysX module in place. Call uninstall() on the returned object to restore the original glue.
+ *
+ * @param {object} physx The module returned by the PhysX() factory (e.g. the PHYSX global).
+ */
+export function installCallCounters(physx) {
+  if (physx.__callCounters__) return physx.__callCounters__;
+
+  const statsList = [];
+  const restorers = [];
+  let frameIndex = 0;
+
+  const wrapFunction = (fn, name) => {
+    const stats = createStats(name);
+    statsList.push(stats);
+    return function () {
+      const result = fn.apply(this, arguments);
+      const bytes = estimateArgsSize(arguments) + (result !== undefined ? estimateSize(result) : 0);
+      stats.calls++;
+      stats.frameCalls++;
+      stats.bytes += bytes;
+      stats.frameBytes += bytes;
+      return result;
+    };
+  };
+
+  const instrumentPrototype = (className, proto) => {
+    for (const key of Object.getOwnPropertyNames(proto)) {
+      if (SKIPPED_PROPERTIES.has(key)) continue;
+      const descriptor = Object.getOwnPropertyDescriptor(proto, key);
+      if (!descriptor.configurable) continue;
+      const wrapped = { ...descriptor };
+      if (typeof descriptor.value === "function") {
+        wrapped.value = wrapFunction(descriptor.value, `${className}.${key}`);
+      } else if (descriptor.get || descriptor.set) {
+        // WebIDL attributes are exposed both as get_x/set_x methods and as accessors bound to the same glue functions
+        if (descriptor.get) wrapped.get = wrapFunction(descriptor.get, `${className}.${key} (get)`);
+        if (descriptor.set) wrapped.set = wrapFunction(descriptor.set, `${className}.${key} (set)`);
+      } else {
+        continue;
+      }
+      Object.defineProperty(proto, key, wrapped);
+      restorers.push(() => Object.defineProperty(proto, key, descriptor));
+    }
+  };
+
+  const instrumentConstructor = (className, ctor) => {
+    const stats = createStats(`${className}.constructor`);
+    statsList.push(stats);
+    const wrapped = function () {
+      const bytes = estimateArgsSize(arguments) + POINTER_SIZE;
+      stats.calls++;
+      stats.frameCalls++;
+      stats.bytes += bytes;
+      stats.frameBytes += bytes;
+      return Reflect.construct(ctor, arguments, new.target || wrapped);
+    };
+    // Share the prototype and the wrapper cache, so that instanceof, wrapPointer() and castObject() keep working
+    wrapped.prototype = ctor.prototype;
+    for (const key of Object.keys(ctor)) wrapped[key] = ctor[key];
+    wrapped.__cache__ = ctor.__cache__;
+    physx[className] = wrapped;
+    restorers.push(() => {
+      physx[className] = ctor;
+    });
+  };
+
+  for (const className of Object.keys(physx)) {
+    const value = physx[className];
+    if (!isBoundClass(value)) continue;
+    instrumentPrototype(className, value.prototype);
+    instrumentConstructor(className, value);
+  }
+
+  const counters = {
+    /**
+     * Closes the current frame and returns its report, sorted by decreasing call count.
+     * @param {number} [maxEntries] Maximum number of methods to report.
+     */
+    endFrame(maxEntries) {
+      const report = makeReport(statsList, true, maxEntries);
+      report.frame = frameIndex++;
+      for (const stats of statsList) {
+        stats.frameCalls = 0;
+        stats.frameBytes = 0;
+      }
+      return report;
+    },
+
+    /**
+     * Returns the cumulative report since installation or the last reset(), sorted by decreasing call count.
+     * @param {number} [maxEntries] Maximum number of methods to report.
+     */
+    getTotals(maxEntries) {
+      return makeReport(statsList, false, maxEntries);
+    },
+
+    /** Clears all counters. */
+    reset() {
+      for (const stats of statsList) {
+        stats.calls = stats.bytes = 0;
+        stats.frameCalls = stats.frameBytes = 0;
+      }
+      frameIndex = 0;
+    },
+
+    /** Restores the original glue. Objects created while instrumented remain valid. */
+    uninstall() {
+      for (let i = restorers.length - 1; i >= 0; i--) restorers[i]();
+      delete physx.__callCounters__;
+    },
+  };
+
+  Object.defineProperty(physx, "__callCounters__", { value: counters, configurable: true });
+  return counters;
+}
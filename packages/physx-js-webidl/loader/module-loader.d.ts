@@ -0,0 +1,31 @@
+/**
+ * Compiles the PhysX wasm once per source. URLs are compiled while streaming when possible; buffers are compiled
+ * asynchronously. Repeated calls with the same URL return the same promise.
+ */
+export function compilePhysXModule(
+  source: string | URL | ArrayBuffer | ArrayBufferView | Response | Promise<Response>,
+): Promise<WebAssembly.Module>;
+
+/**
+ * Returns factory options that instantiate the given compiled module instead of fetching and compiling the wasm. The
+ * module can come from another thread (it is structured-cloneable), in which case it is not compiled again.
+ */
+export function createPhysXModuleOptions<T extends object>(
+  wasmModule: WebAssembly.Module,
+  options?: T,
+): T & {
+  instantiateWasm(
+    imports: WebAssembly.Imports,
+    receiveInstance: (instance: WebAssembly.Instance, module: WebAssembly.Module) => void,
+  ): object;
+};
+
+/**
+ * Runs the PhysX factory on the given compiled module. The returned promise rejects when the instantiation fails or
+ * the module aborts, with the error thrown by `options.onAbort` if it throws one.
+ */
+export function loadPhysXModule<M, T extends object>(
+  factory: (options: T) => Promise<M>,
+  wasmModule: WebAssembly.Module,
+  options?: T,
+): Promise<M>;
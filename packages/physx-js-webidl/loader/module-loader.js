@@ -0,0 +1,124 @@
+// Compiled WebAssembly.Module loader for the PhysX bindings.
+//
+// Emscripten's default loader compiles the .wasm every time the factory runs, and when it is given `wasmBinary` the
+// compilation starts only once the whole file has been read. This loader compiles the module once, with
+// WebAssembly.compileStreaming() when the source is a URL (compilation overlaps the download, and browsers keep the
+// compiled code in their HTTP code cache), and hands the compiled module to the factory through `instantiateWasm`.
+//
+// A compiled module can be posted to worker threads (worker_threads or Web Workers) and passed to
+// createPhysXModuleOptions() there, so that every thread instantiates the same code without compiling it again.
+//
+// Usage:
+//   import PhysX from "@hyperscape/physx-js-webidl";
+//   import { compilePhysXModule, loadPhysXModule } from "@hyperscape/physx-js-webidl/module-loader";
+//   const wasmModule = await compilePhysXModule(new URL("./physx-js-webidl.wasm", import.meta.url));
+//   const PHYSX = await loadPhysXModule(PhysX, wasmModule);
+
+// Compilations in flight or done, per source URL, so that concurrent loads in one thread share a single compile
+const compiledModules = new Map();
+
+function isStreamable(response) {
+  const contentType = response.headers.get("Content-Type") || "";
+  return contentType.split(";")[0].trim() === "application/wasm";
+}
+
+const isNode = typeof process !== "undefined" && process.versions != null && process.versions.node != null;
+
+async function compileFromUrl(url) {
+  if (isNode && !/^(https?|blob|data):/.test(url)) {
+    // Local file on Node: read it, the compile itself still runs on V8's background threads
+    const { readFile } = await import(/* @vite-ignore */ "node:fs/promises");
+    const { fileURLToPath } = await import(/* @vite-ignore */ "node:url");
+    return WebAssembly.compile(await readFile(url.startsWith("file:") ? fileURLToPath(url) : url));
+  }
+  const response = await fetch(url);
+  if (!response.ok) throw new Error(`Failed to fetch ${url}: ${response.status} ${response.statusText}`);
+  // compileStreaming() requires the application/wasm content type, fall back to a buffered compile otherwise
+  if (typeof WebAssembly.compileStreaming === "function" && isStreamable(response)) {
+    return WebAssembly.compileStreaming(response);
+  }
+  return WebAssembly.compile(await response.arrayBuffer());
+}
+
+/**
+ * Compiles the PhysX wasm once per source. URLs are compiled while streaming when possible; buffers are compiled
+ * asynchronously. Repeated calls with the same URL return the same promise.
+ *
+ * @param {string | URL | ArrayBuffer | ArrayBufferView | Response | Promise<Response>} source
+ * @returns {Promise<WebAssembly.Module>}
+ */
+export function compilePhysXModule(source) {
+  if (source instanceof ArrayBuffer || ArrayBuffer.isView(source)) {
+    return WebAssembly.compile(source);
+  }
+  if (typeof Response !== "undefined" && (source instanceof Response || source instanceof Promise)) {
+    return WebAssembly.compileStreaming(source);
+  }
+  const url = String(source);
+  let compiled = compiledModules.get(url);
+  if (!compiled) {
+    compiled = compileFromUrl(url);
+    compiledModules.set(url, compiled);
+    // Let a failed compile be retried
+    compiled.catch(() => compiledModules.delete(url));
+  }
+  return compiled;
+}
+
+/**
+ * Returns factory options that instantiate the given compiled module instead of fetching and compiling the wasm.
+ *
+ * Emscripten cannot be told about an asynchronous instantiation failure, so the error goes to `options.onAbort`
+ * (as with emscripten's own aborts) and the factory promise stays pending. Use loadPhysXModule() to get a promise
+ * that rejects instead.
+ *
+ * @param {WebAssembly.Module} wasmModule
+ * @param {object} [options] Other factory options, merged into the result.
+ */
+export function createPhysXModuleOptions(wasmModule, options) {
+  return {
+    ...options,
+    instantiateWasm(imports, receiveInstance) {
+      WebAssembly.instantiate(wasmModule, imports).then(
+        (instance) => receiveInstance(instance, wasmModule),
+        (error) => {
+          // Rethrowing here would only be an unhandled rejection
+          try {
+            if (options && options.onAbort) options.onAbort(error);
+            else console.error("PhysX wasm instantiation failed:", error);
+          } catch (abortError) {
+            console.error("PhysX wasm instantiation failed:", abortError);
+          }
+        },
+      );
+      // Tells emscripten that instantiation is asynchronous
+      return {};
+    },
+  };
+}
+
+/**
+ * Runs the PhysX factory on the given compiled module. The returned promise rejects when the instantiation fails or
+ * the module aborts, with the error thrown by `options.onAbort` if it throws one.
+ *
+ * @param {(options: object) => Promise<object>} factory The PhysX factory, the default export of the bindings.
+ * @param {WebAssembly.Module} wasmModule
+ * @param {object} [options] Other factory options.
+ * @returns {Promise<object>} The PhysX module.
+ */
+export function loadPhysXModule(factory, wasmModule, options) {
+  return new Promise((resolve, reject) => {
+    const onAbort = (what) => {
+      let error = what instanceof Error ? what : new Error(`PhysX aborted: ${what}`);
+      if (options && options.onAbort) {
+        try {
+          options.onAbort(what);
+        } catch (abortError) {
+          error = abortError;
+        }
+      }
+      reject(error);
+    };
+    factory(createPhysXModuleOptions(wasmModule, { ...options, onAbort })).then(resolve, reject);
+  });
+}
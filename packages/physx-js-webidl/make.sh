@@ -2,10 +2,40 @@
 
 # Unified build script for PhysX WebIDL bindings
 # Supports multiple build types and generates TypeScript definitions
-# Usage: ./make.sh [release|debug|profile|all] (default: release)
+# Usage: ./make.sh [release|release-simd|release-mt|release-wasm64|debug|profile|all] [features] (default: release full)
 
 BUILD_TYPE=${1:-release}
 
+# Feature-sliced builds: "full" (default) links every SDK module into the bindings. Otherwise the features are a
+# "+"-separated list starting with "rigid" (rigid bodies, joints, articulations, scene queries), optionally followed by
+# "cct" (PhysXCharacterKinematic), "cooking" (PhysXCooking) and "vehicle" (PhysXVehicle2), e.g. "rigid+cct+cooking".
+# Sliced builds are written with the features in their name, e.g. dist/physx-js-webidl.rigid-cct-cooking.wasm.
+FEATURES=${2:-full}
+FEATURE_SWITCHES=""
+FEATURE_SUFFIX=""
+if [ "$FEATURES" != "full" ]; then
+    FEATURE_SUFFIX=$(echo "$FEATURES" | tr '+' '-')
+    for feature in $(echo "$FEATURES" | tr '+' ' '); do
+        case $feature in
+            rigid|cct|cooking|vehicle) ;;
+            *) echo "Unknown feature: $feature (expected rigid, cct, cooking or vehicle)"; exit 1 ;;
+        esac
+    done
+    for module in cct cooking vehicle; do
+        case "+$FEATURES+" in
+            *"+$module+"*) enabled=TRUE ;;
+            *) enabled=FALSE ;;
+        esac
+        case $module in
+            cct) FEATURE_SWITCHES="$FEATURE_SWITCHES -DPX_BUILD_CHARACTERKINEMATIC=$enabled" ;;
+            cooking) FEATURE_SWITCHES="$FEATURE_SWITCHES -DPX_BUILD_COOKING=$enabled" ;;
+            vehicle) FEATURE_SWITCHES="$FEATURE_SWITCHES -DPX_BUILD_VEHICLE=$enabled" ;;
+        esac
+    done
+    # The bindings project selects the matching sections of the IDL from this list
+    FEATURE_SWITCHES="$FEATURE_SWITCHES -DPX_WEBIDL_FEATURES=$FEATURES"
+fi
+
 # Auto-detect EMSDK if not set
 if [ -z "$EMSDK" ]; then
     # Try common locations
@@ -27,12 +57,30 @@ if [ -z "$EMSDK" ]; then
     echo "Auto-detected EMSDK at: $EMSDK"
 fi
 
+# WebAssembly SIMD128 flags. PhysX compiles its SSE2 vector math path through emscripten's
+# SSE translation headers and uses native wasm_simd128.h intrinsics where available (PX_WASM_SIMD).
+SIMD_FLAGS="-msimd128 -msse2"
+
+# Multithreaded (pthreads) flags. Worker threads are preallocated so that PxDefaultCpuDispatcher threads are
+# available synchronously when the dispatcher is created. Override the pool size with PHYSX_PTHREAD_POOL_SIZE.
+PTHREAD_POOL_SIZE=${PHYSX_PTHREAD_POOL_SIZE:-8}
+MT_COMPILE_FLAGS="-pthread"
+MT_LINK_FLAGS="-pthread -s PTHREAD_POOL_SIZE=$PTHREAD_POOL_SIZE"
+
+# wasm64 (memory64) flags for server worlds that outgrow the 4GB wasm32 address space. PhysX treats wasm64 as a
+# 64-bit target (PX_P64_FAMILY), so serialized collections use the 64-bit layout. Requires a runtime with memory64
+# support (Node 24+ or --experimental-wasm-memory64). Override the memory cap with PHYSX_MAXIMUM_MEMORY.
+WASM64_COMPILE_FLAGS="-sMEMORY64=1"
+WASM64_LINK_FLAGS="-sMEMORY64=1 -sMAXIMUM_MEMORY=${PHYSX_MAXIMUM_MEMORY:-16GB}"
+
 # Function to generate project files
+# Optional argument: extra compiler flags baked into the generated projects
 generate_projects() {
+    local compile_flags=$1
     echo "Generating PhysX project files..."
     cd ./PhysX/physx
     rm -rf compiler/emscripten-*
-    ./generate_projects.sh emscripten
+    PHYSX_CMAKE_SWITCHES="$FEATURE_SWITCHES" CFLAGS="$compile_flags" CXXFLAGS="$compile_flags" ./generate_projects.sh emscripten
     cd ../..
 }
 
@@ -52,6 +100,10 @@ build_config() {
     local config=$1
     local output_suffix=$2
     local emcc_flags=$3
+
+    if [ -n "$FEATURE_SUFFIX" ]; then
+        output_suffix=${output_suffix:+$output_suffix.}$FEATURE_SUFFIX
+    fi
     
     echo "Building $config configuration..."
     cd PhysX/physx/compiler/emscripten-$config/
@@ -79,6 +131,10 @@ build_config() {
             cp sdk_source_bin/physx-js-webidl.js ../../../../dist/physx-js-webidl.$output_suffix.js
             cp sdk_source_bin/physx-js-webidl.wasm ../../../../dist/physx-js-webidl.$output_suffix.wasm
         fi
+        # pthreads builds also emit a worker bootstrap script
+        if [ -f "sdk_source_bin/physx-js-webidl.worker.js" ]; then
+            cp sdk_source_bin/physx-js-webidl.worker.js ../../../../dist/physx-js-webidl.$output_suffix.worker.js
+        fi
         echo "Build artifacts copied to dist/"
     else
         echo "Error: Build artifacts not found in sdk_source_bin/"
@@ -92,10 +148,19 @@ build_config() {
 echo "PhysX WebIDL Build Script"
 echo "========================="
 echo "Build type: $BUILD_TYPE"
+echo "Features: $FEATURES"
 echo ""
 
-# Always generate projects first
-generate_projects
+# Always generate projects first (SIMD builds need the SIMD flags at compile time, not only at link time)
+if [ "$BUILD_TYPE" = "release-simd" ]; then
+    generate_projects "$SIMD_FLAGS"
+elif [ "$BUILD_TYPE" = "release-mt" ]; then
+    generate_projects "$MT_COMPILE_FLAGS"
+elif [ "$BUILD_TYPE" = "release-wasm64" ]; then
+    generate_projects "$WASM64_COMPILE_FLAGS"
+else
+    generate_projects
+fi
 
 # Always generate types
 generate_types
@@ -111,9 +176,25 @@ else
     echo "Warning: TypeScript definitions not found"
 fi
 
+# Copy the JS<->WASM call counters (usable with every build, see README)
+mkdir -p dist/
+cp instrumentation/call-counters.js instrumentation/call-counters.d.ts dist/
+
+# Copy the worker host (runs the simulation in a web worker, see README)
+cp worker/worker-host.js worker/worker-host.d.ts worker/physics-worker.js worker/state-channel.js dist/
+
+# Copy the compiled module loader (streaming compile, module sharing across threads, see README)
+cp loader/module-loader.js loader/module-loader.d.ts dist/
+
 # Base flags for all builds - supports web, worker, and node environments
 BASE_FLAGS="-s ENVIRONMENT='web,worker,node' -s EXPORT_ES6=1 -s MODULARIZE=1 -s USE_ES6_IMPORT_META=0 -s ALLOW_MEMORY_GROWTH=1"
 
+# Pre-reserved memory: PHYSX_INITIAL_MEMORY (e.g. 1GB) sizes the heap up front for worlds whose footprint is known,
+# so startup doesn't pay for repeated grow-and-copy steps. Growth stays enabled and doubles the heap when it is hit.
+if [ -n "$PHYSX_INITIAL_MEMORY" ]; then
+    BASE_FLAGS="$BASE_FLAGS -sINITIAL_MEMORY=$PHYSX_INITIAL_MEMORY -sMEMORY_GROWTH_GEOMETRIC_STEP=1.0 -sMEMORY_GROWTH_GEOMETRIC_CAP=0"
+fi
+
 # Build based on requested type
 case $BUILD_TYPE in
     debug)
@@ -125,15 +206,33 @@ case $BUILD_TYPE in
     release)
         build_config "release" "" "$BASE_FLAGS -O3"
         ;;
+    release-simd)
+        build_config "release" "simd" "$BASE_FLAGS -O3 $SIMD_FLAGS"
+        ;;
+    release-mt)
+        build_config "release" "mt" "$BASE_FLAGS -O3 $MT_LINK_FLAGS"
+        ;;
+    release-wasm64)
+        build_config "release" "wasm64" "$BASE_FLAGS -O3 $WASM64_LINK_FLAGS"
+        ;;
     all)
         # Build all configurations
         build_config "release" "" "$BASE_FLAGS -O3"
         build_config "debug" "debug" "$BASE_FLAGS -g3 -O0 -s ASSERTIONS=2 -s SAFE_HEAP=1 -s STACK_OVERFLOW_CHECK=1"
         build_config "profile" "profile" "$BASE_FLAGS -O2 --profiling-funcs -g2"
+        # SIMD build needs its own project files
+        generate_projects "$SIMD_FLAGS"
+        build_config "release" "simd" "$BASE_FLAGS -O3 $SIMD_FLAGS"
+        # Multithreaded build needs its own project files
+        generate_projects "$MT_COMPILE_FLAGS"
+        build_config "release" "mt" "$BASE_FLAGS -O3 $MT_LINK_FLAGS"
+        # wasm64 build needs its own project files
+        generate_projects "$WASM64_COMPILE_FLAGS"
+        build_config "release" "wasm64" "$BASE_FLAGS -O3 $WASM64_LINK_FLAGS"
         ;;
     *)
         echo "Unknown build type: $BUILD_TYPE"
-        echo "Usage: $0 [release|debug|profile|all]"
+        echo "Usage: $0 [release|release-simd|release-mt|release-wasm64|debug|profile|all] [full|rigid[+cct][+cooking][+vehicle]]"
         exit 1
         ;;
 esac
@@ -10,6 +10,9 @@ const rootDir = join(__dirname, "..");
 const distDir = join(rootDir, "dist");
 const sourceDir = join(rootDir, "..", "client", "public");
 const typesDir = join(rootDir, "types");
+const instrumentationDir = join(rootDir, "instrumentation");
+const workerDir = join(rootDir, "worker");
+const loaderDir = join(rootDir, "loader");
 
 // Files to copy
 const files = [
@@ -25,6 +28,22 @@ const files = [
     src: join(typesDir, "physx-js-webidl.d.ts"),
     dest: join(distDir, "physx-js-webidl.d.ts"),
   },
+  {
+    src: join(instrumentationDir, "call-counters.js"),
+    dest: join(distDir, "call-counters.js"),
+  },
+  {
+    src: join(instrumentationDir, "call-counters.d.ts"),
+    dest: join(distDir, "call-counters.d.ts"),
+  },
+  ...["worker-host.js", "worker-host.d.ts", "physics-worker.js", "state-channel.js", "state-channel.d.ts"].map((name) => ({
+    src: join(workerDir, name),
+    dest: join(distDir, name),
+  })),
+  ...["module-loader.js", "module-loader.d.ts"].map((name) => ({
+    src: join(loaderDir, name),
+    dest: join(distDir, name),
+  })),
 ];
 
 // Check if dist files already exist
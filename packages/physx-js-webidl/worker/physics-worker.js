@@ -0,0 +1,258 @@
+// Physics worker entry point, started by createPhysicsWorkerHost() (see worker-host.js).
+//
+// Owns the PhysX module, scene and bodies. Each tick it drains the command ring, advances the scene with a fixed time
+// step and publishes the transforms of all bodies through the transform triple buffer. The main thread never waits for
+// it: it only posts commands and reads the most recent published transforms.
+
+import {
+  BodyState,
+  CommandOp,
+  CommandRing,
+  FLOATS_PER_BODY,
+  MotionType,
+  ShapeType,
+  TransformBuffer,
+} from "./state-channel.js";
+
+let PHYSX = null;
+let physics = null;
+let scene = null;
+let material = null;
+let shapeFlags = null;
+let filterData = null;
+
+let commands = null;
+let transforms = null;
+
+// Indexed by body id, ids are allocated by the host
+const bodies = [];
+let bodyCount = 0;
+
+let fixedTimeStep = 1 / 60;
+let maxSubSteps = 4;
+let frame = 0;
+let simulatedTime = 0;
+let lastTickTime = 0;
+let accumulator = 0;
+let timer = null;
+
+// Scratch objects, reused for every command to keep the glue from allocating
+let tmpVec = null;
+let tmpVec2 = null;
+let tmpQuat = null;
+let tmpTransform = null;
+
+async function init(options) {
+  const module = await import(/* @vite-ignore */ options.moduleUrl);
+  const PhysXFactory = module.default || self.PhysX;
+  const moduleOptions = {};
+  if (options.wasmUrl) {
+    moduleOptions.locateFile = (fileName) => (fileName.endsWith(".wasm") ? options.wasmUrl : fileName);
+  }
+  PHYSX = await PhysXFactory(moduleOptions);
+
+  const version = PHYSX.PHYSICS_VERSION;
+  const allocator = new PHYSX.PxDefaultAllocator();
+  const errorCb = new PHYSX.PxDefaultErrorCallback();
+  const foundation = PHYSX.CreateFoundation(version, allocator, errorCb);
+  const tolerances = new PHYSX.PxTolerancesScale();
+  physics = PHYSX.CreatePhysics(version, foundation, tolerances);
+
+  const sceneDesc = new PHYSX.PxSceneDesc(tolerances);
+  const gravity = options.gravity || [0, -9.81, 0];
+  sceneDesc.gravity = new PHYSX.PxVec3(gravity[0], gravity[1], gravity[2]);
+  sceneDesc.cpuDispatcher = PHYSX.DefaultCpuDispatcherCreate(0);
+  sceneDesc.filterShader = PHYSX.DefaultFilterShader();
+  scene = physics.createScene(sceneDesc);
+  PHYSX.destroy(sceneDesc);
+
+  material = physics.createMaterial(0.5, 0.5, 0.1);
+  shapeFlags = new PHYSX.PxShapeFlags(
+    PHYSX.PxShapeFlagEnum.eSCENE_QUERY_SHAPE | PHYSX.PxShapeFlagEnum.eSIMULATION_SHAPE,
+  );
+  // The bindings' default filter shader only lets shapes collide when their group (word0) matches the other's mask
+  // (word1), and shapes start with all-zero filter data: put every body in one group that collides with everything
+  filterData = new PHYSX.PxFilterData(1, 0xffffffff, 0, 0);
+
+  tmpVec = new PHYSX.PxVec3(0, 0, 0);
+  tmpVec2 = new PHYSX.PxVec3(0, 0, 0);
+  tmpQuat = new PHYSX.PxQuat(0, 0, 0, 1);
+  tmpTransform = new PHYSX.PxTransform(tmpVec, tmpQuat);
+
+  commands = new CommandRing(options.commandBuffer);
+  transforms = new TransformBuffer(options.transformBuffer, true);
+  fixedTimeStep = options.fixedTimeStep || fixedTimeStep;
+  maxSubSteps = options.maxSubSteps || maxSubSteps;
+
+  lastTickTime = performance.now();
+  timer = setInterval(tick, (fixedTimeStep * 1000) / 2);
+}
+
+function setTransform(floats, offset) {
+  tmpTransform.p.x = floats[offset];
+  tmpTransform.p.y = floats[offset + 1];
+  tmpTransform.p.z = floats[offset + 2];
+  tmpTransform.q.x = floats[offset + 3];
+  tmpTransform.q.y = floats[offset + 4];
+  tmpTransform.q.z = floats[offset + 5];
+  tmpTransform.q.w = floats[offset + 6];
+  return tmpTransform;
+}
+
+function createGeometry(shapeType, floats, offset) {
+  switch (shapeType) {
+    case ShapeType.SPHERE:
+      return new PHYSX.PxSphereGeometry(floats[offset]);
+    case ShapeType.CAPSULE:
+      return new PHYSX.PxCapsuleGeometry(floats[offset], floats[offset + 1]);
+    default:
+      return new PHYSX.PxBoxGeometry(floats[offset], floats[offset + 1], floats[offset + 2]);
+  }
+}
+
+// SPAWN record: op, id, shape type, motion type, position (3), rotation (4), size (3), mass
+function spawn(ints, floats, offset) {
+  const id = ints[offset + 1];
+  const shapeType = ints[offset + 2];
+  const motion = ints[offset + 3];
+  const pose = setTransform(floats, offset + 4);
+
+  const actor = motion === MotionType.STATIC ? physics.createRigidStatic(pose) : physics.createRigidDynamic(pose);
+  const geometry = createGeometry(shapeType, floats, offset + 11);
+  // The bindings expose the static Px*Ext helpers as prototype methods
+  const shape = PHYSX.PxRigidActorExt.prototype.createExclusiveShape(actor, geometry, material, shapeFlags);
+  shape.setSimulationFilterData(filterData);
+  shape.setQueryFilterData(filterData);
+  PHYSX.destroy(geometry);
+
+  if (motion !== MotionType.STATIC) {
+    if (motion === MotionType.KINEMATIC) actor.setRigidBodyFlag(PHYSX.PxRigidBodyFlagEnum.eKINEMATIC, true);
+    PHYSX.PxRigidBodyExt.prototype.setMassAndUpdateInertia(actor, floats[offset + 14] || 1);
+  }
+  scene.addActor(actor);
+
+  bodies[id] = { actor, motion };
+  if (id >= bodyCount) bodyCount = id + 1;
+}
+
+function remove(id) {
+  const body = bodies[id];
+  if (!body) return;
+  scene.removeActor(body.actor);
+  body.actor.release();
+  bodies[id] = undefined;
+  while (bodyCount > 0 && !bodies[bodyCount - 1]) bodyCount--;
+}
+
+function processCommands() {
+  const ints = commands.ints;
+  const floats = commands.floats;
+  let offset;
+  while ((offset = commands.peek()) !== -1) {
+    const op = ints[offset];
+    const id = ints[offset + 1];
+    const body = bodies[id];
+    switch (op) {
+      case CommandOp.SPAWN:
+        spawn(ints, floats, offset);
+        break;
+      case CommandOp.REMOVE:
+        remove(id);
+        break;
+      case CommandOp.ADD_IMPULSE:
+        if (body && body.motion === MotionType.DYNAMIC) {
+          tmpVec.x = floats[offset + 2];
+          tmpVec.y = floats[offset + 3];
+          tmpVec.z = floats[offset + 4];
+          body.actor.addForce(tmpVec, PHYSX.PxForceModeEnum.eIMPULSE, true);
+        }
+        break;
+      case CommandOp.SET_KINEMATIC_TARGET:
+        if (body && body.motion === MotionType.KINEMATIC) body.actor.setKinematicTarget(setTransform(floats, offset + 2));
+        break;
+      case CommandOp.SET_VELOCITY:
+        if (body && body.motion === MotionType.DYNAMIC) {
+          tmpVec.x = floats[offset + 2];
+          tmpVec.y = floats[offset + 3];
+          tmpVec.z = floats[offset + 4];
+          tmpVec2.x = floats[offset + 5];
+          tmpVec2.y = floats[offset + 6];
+          tmpVec2.z = floats[offset + 7];
+          body.actor.setLinearVelocity(tmpVec, true);
+          body.actor.setAngularVelocity(tmpVec2, true);
+        }
+        break;
+    }
+    commands.consume();
+  }
+}
+
+function publishTransforms() {
+  const data = transforms.backSlot().data;
+  for (let id = 0; id < bodyCount; id++) {
+    const offset = id * FLOATS_PER_BODY;
+    const body = bodies[id];
+    if (!body) {
+      data[offset + 7] = BodyState.UNUSED;
+      continue;
+    }
+    const pose = body.actor.getGlobalPose();
+    data[offset] = pose.p.x;
+    data[offset + 1] = pose.p.y;
+    data[offset + 2] = pose.p.z;
+    data[offset + 3] = pose.q.x;
+    data[offset + 4] = pose.q.y;
+    data[offset + 5] = pose.q.z;
+    data[offset + 6] = pose.q.w;
+    data[offset + 7] =
+      body.motion !== MotionType.STATIC && body.actor.isSleeping() ? BodyState.SLEEPING : BodyState.AWAKE;
+  }
+  transforms.publish(frame, bodyCount, simulatedTime);
+}
+
+function tick() {
+  const now = performance.now();
+  accumulator += (now - lastTickTime) / 1000;
+  lastTickTime = now;
+
+  processCommands();
+
+  let steps = 0;
+  while (accumulator >= fixedTimeStep && steps < maxSubSteps) {
+    scene.simulate(fixedTimeStep);
+    scene.fetchResults(true);
+    accumulator -= fixedTimeStep;
+    simulatedTime += fixedTimeStep;
+    steps++;
+  }
+  // Drop the backlog rather than spiralling when the worker cannot keep up
+  if (steps === maxSubSteps) accumulator = 0;
+
+  if (steps) {
+    frame++;
+    publishTransforms();
+  }
+}
+
+function shutdown() {
+  if (timer !== null) clearInterval(timer);
+  timer = null;
+  if (scene) {
+    for (let id = 0; id < bodyCount; id++) remove(id);
+    scene.release();
+    scene = null;
+  }
+  self.close();
+}
+
+self.onmessage = (event) => {
+  const message = event.data;
+  if (message.type === "init") {
+    init(message).then(
+      () => self.postMessage({ type: "ready" }),
+      (error) => self.postMessage({ type: "error", message: String(error && error.message ? error.message : error) }),
+    );
+  } else if (message.type === "terminate") {
+    shutdown();
+  }
+};
@@ -0,0 +1,74 @@
+/** Floats per body in a transform slot: position (3), rotation quaternion (4), state (1, see BodyState). */
+export const FLOATS_PER_BODY: 8;
+
+/** Value of the last float of each body in a transform slot. */
+export const BodyState: Readonly<{
+  UNUSED: 0;
+  AWAKE: 1;
+  SLEEPING: 2;
+}>;
+
+/** Command opcodes, first word of each CommandRing record. */
+export const CommandOp: Readonly<{
+  SPAWN: 1;
+  REMOVE: 2;
+  ADD_IMPULSE: 3;
+  SET_KINEMATIC_TARGET: 4;
+  SET_VELOCITY: 5;
+}>;
+
+/** Shape types of SPAWN commands. */
+export const ShapeType: Readonly<{
+  BOX: 0;
+  SPHERE: 1;
+  CAPSULE: 2;
+}>;
+
+/** Motion types of SPAWN commands. */
+export const MotionType: Readonly<{
+  STATIC: 0;
+  DYNAMIC: 1;
+  KINEMATIC: 2;
+}>;
+
+/** 32-bit words per CommandRing record. */
+export const COMMAND_WORDS: 16;
+
+export interface TransformSlot {
+  /** frame, body count, simulated time (as float bits), unused */
+  header: Int32Array;
+  time: Float32Array;
+  data: Float32Array;
+}
+
+/** Single-producer / single-consumer triple buffer of body transforms over a SharedArrayBuffer. */
+export class TransformBuffer {
+  /** Allocates the shared memory of a triple buffer able to hold maxBodies transforms per slot. */
+  static allocate(maxBodies: number): SharedArrayBuffer;
+  constructor(buffer: SharedArrayBuffer, writer: boolean);
+  readonly maxBodies: number;
+  /** Producer: the slot to fill before calling publish(). */
+  backSlot(): TransformSlot;
+  /** Producer: makes the back slot the most recent one and takes over the previous middle slot. */
+  publish(frame: number, bodyCount: number, time: number): void;
+  /** Consumer: returns the most recently published slot, swapping it in if the producer published since the last call. */
+  frontSlot(): TransformSlot;
+}
+
+/** Single-producer / single-consumer ring of fixed-size command records over a SharedArrayBuffer. */
+export class CommandRing {
+  /** Allocates the shared memory of a ring of `capacity` records, rounded up to a power of two. */
+  static allocate(capacity: number): SharedArrayBuffer;
+  constructor(buffer: SharedArrayBuffer);
+  readonly ints: Int32Array;
+  readonly floats: Float32Array;
+  readonly capacity: number;
+  /** Producer: returns the word offset of a free record, or -1 if the ring is full. */
+  reserve(): number;
+  /** Producer: publishes the record returned by the last reserve(). */
+  commit(): void;
+  /** Consumer: returns the word offset of the oldest pending record, or -1 if the ring is empty. */
+  peek(): number;
+  /** Consumer: releases the record returned by the last peek(). */
+  consume(): void;
+}
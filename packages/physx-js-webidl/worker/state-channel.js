@@ -0,0 +1,165 @@
+// Shared memory channels between the main thread and the physics worker.
+//
+// TransformBuffer is a single-producer / single-consumer triple buffer: the worker writes body transforms into its back
+// slot and publishes it with one atomic exchange, the main thread picks up the most recent published slot without ever
+// waiting for the worker. CommandRing is a single-producer / single-consumer ring of fixed-size records carrying mutation
+// commands from the main thread to the worker. Both only rely on Atomics load/store/exchange, no locks and no waits.
+//
+// Both classes wrap a SharedArrayBuffer, so each side constructs its own instance over the same buffer.
+
+/** Floats per body in a transform slot: position (3), rotation quaternion (4), state (1, see BodyState). */
+export const FLOATS_PER_BODY = 8;
+
+/** Value of the last float of each body in a transform slot. */
+export const BodyState = Object.freeze({
+  UNUSED: 0,
+  AWAKE: 1,
+  SLEEPING: 2,
+});
+
+/** Command opcodes, first word of each CommandRing record. */
+export const CommandOp = Object.freeze({
+  SPAWN: 1,
+  REMOVE: 2,
+  ADD_IMPULSE: 3,
+  SET_KINEMATIC_TARGET: 4,
+  SET_VELOCITY: 5,
+});
+
+/** Shape types of SPAWN commands. */
+export const ShapeType = Object.freeze({
+  BOX: 0,
+  SPHERE: 1,
+  CAPSULE: 2,
+});
+
+/** Motion types of SPAWN commands. */
+export const MotionType = Object.freeze({
+  STATIC: 0,
+  DYNAMIC: 1,
+  KINEMATIC: 2,
+});
+
+/** 32-bit words per CommandRing record. */
+export const COMMAND_WORDS = 16;
+
+const CONTROL_WORDS = 4; // [0] = index of the middle slot | FRESH_BIT
+const SLOT_HEADER_WORDS = 4; // frame, body count, simulated time (float), unused
+const FRESH_BIT = 4;
+
+const RING_HEADER_WORDS = 4; // [0] = write count, [1] = read count
+
+function requireSharedArrayBuffer() {
+  if (typeof SharedArrayBuffer === "undefined") {
+    throw new Error(
+      "SharedArrayBuffer is not available, the page must be cross-origin isolated (COOP/COEP headers)",
+    );
+  }
+}
+
+export class TransformBuffer {
+  /**
+   * Allocates the shared memory of a triple buffer able to hold maxBodies transforms per slot.
+   * @param {number} maxBodies
+   */
+  static allocate(maxBodies) {
+    requireSharedArrayBuffer();
+    const slotWords = SLOT_HEADER_WORDS + maxBodies * FLOATS_PER_BODY;
+    const buffer = new SharedArrayBuffer((CONTROL_WORDS + 3 * slotWords) * 4);
+    // The writer starts on slot 0, the middle slot is 1 and the reader starts on slot 2
+    new Int32Array(buffer, 0, CONTROL_WORDS)[0] = 1;
+    return buffer;
+  }
+
+  /**
+   * @param {SharedArrayBuffer} buffer Memory returned by TransformBuffer.allocate()
+   * @param {boolean} writer True on the producer (worker) side
+   */
+  constructor(buffer, writer) {
+    this.control = new Int32Array(buffer, 0, CONTROL_WORDS);
+    const slotWords = (buffer.byteLength / 4 - CONTROL_WORDS) / 3;
+    this.maxBodies = (slotWords - SLOT_HEADER_WORDS) / FLOATS_PER_BODY;
+    this.slots = [];
+    for (let i = 0; i < 3; i++) {
+      const byteOffset = (CONTROL_WORDS + i * slotWords) * 4;
+      this.slots.push({
+        header: new Int32Array(buffer, byteOffset, SLOT_HEADER_WORDS),
+        time: new Float32Array(buffer, byteOffset + 8, 1),
+        data: new Float32Array(buffer, byteOffset + SLOT_HEADER_WORDS * 4, this.maxBodies * FLOATS_PER_BODY),
+      });
+    }
+    this.index = writer ? 0 : 2;
+  }
+
+  /** Producer: the slot to fill before calling publish(). */
+  backSlot() {
+    return this.slots[this.index];
+  }
+
+  /** Producer: makes the back slot the most recent one and takes over the previous middle slot. */
+  publish(frame, bodyCount, time) {
+    const slot = this.slots[this.index];
+    slot.header[0] = frame;
+    slot.header[1] = bodyCount;
+    slot.time[0] = time;
+    this.index = Atomics.exchange(this.control, 0, this.index | FRESH_BIT) & 3;
+  }
+
+  /** Consumer: returns the most recently published slot, swapping it in if the producer published since the last call. */
+  frontSlot() {
+    if (Atomics.load(this.control, 0) & FRESH_BIT) {
+      this.index = Atomics.exchange(this.control, 0, this.index) & 3;
+    }
+    return this.slots[this.index];
+  }
+}
+
+export class CommandRing {
+  /**
+   * Allocates the shared memory of a ring of `capacity` records, rounded up to a power of two.
+   * @param {number} capacity
+   */
+  static allocate(capacity) {
+    requireSharedArrayBuffer();
+    let size = 1;
+    while (size < capacity) size <<= 1;
+    return new SharedArrayBuffer((RING_HEADER_WORDS + size * COMMAND_WORDS) * 4);
+  }
+
+  /** @param {SharedArrayBuffer} buffer Memory returned by CommandRing.allocate() */
+  constructor(buffer) {
+    this.header = new Int32Array(buffer, 0, RING_HEADER_WORDS);
+    this.ints = new Int32Array(buffer, RING_HEADER_WORDS * 4);
+    this.floats = new Float32Array(buffer, RING_HEADER_WORDS * 4);
+    this.capacity = this.ints.length / COMMAND_WORDS;
+    this.mask = this.capacity - 1;
+  }
+
+  /**
+   * Producer: returns the word offset of a free record, or -1 if the ring is full. The record becomes visible to the
+   * consumer on commit().
+   */
+  reserve() {
+    const head = Atomics.load(this.header, 0);
+    const tail = Atomics.load(this.header, 1);
+    if (((head - tail) | 0) >= this.capacity) return -1;
+    return (head & this.mask) * COMMAND_WORDS;
+  }
+
+  /** Producer: publishes the record returned by the last reserve(). */
+  commit() {
+    Atomics.store(this.header, 0, (this.header[0] + 1) | 0);
+  }
+
+  /** Consumer: returns the word offset of the oldest pending record, or -1 if the ring is empty. */
+  peek() {
+    const tail = Atomics.load(this.header, 1);
+    if (tail === Atomics.load(this.header, 0)) return -1;
+    return (tail & this.mask) * COMMAND_WORDS;
+  }
+
+  /** Consumer: releases the record returned by the last peek(). */
+  consume() {
+    Atomics.store(this.header, 1, (this.header[1] + 1) | 0);
+  }
+}
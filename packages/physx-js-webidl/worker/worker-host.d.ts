@@ -0,0 +1,83 @@
+/** Floats per body in PhysicsWorkerTransforms.data: position (3), rotation quaternion (4), state (1). */
+export const FLOATS_PER_BODY: 8;
+
+/** Value of the last float of each body in PhysicsWorkerTransforms.data. */
+export const BodyState: Readonly<{
+  UNUSED: 0;
+  AWAKE: 1;
+  SLEEPING: 2;
+}>;
+
+export interface PhysicsWorkerHostOptions {
+  /** URL of the PhysX module (physx-js-webidl.js or one of its build variants), imported by the worker. */
+  moduleUrl: string | URL;
+  /** URL of the matching .wasm file. Defaults to the file next to the module. */
+  wasmUrl?: string | URL;
+  /** URL of physics-worker.js. Defaults to the file next to worker-host.js. */
+  workerUrl?: string | URL;
+  /** Maximum number of bodies alive at once. Default 4096. */
+  maxBodies?: number;
+  /** Number of command records in the ring, rounded up to a power of two. Default 1024. */
+  commandCapacity?: number;
+  /** Scene gravity. Default [0, -9.81, 0]. */
+  gravity?: [number, number, number];
+  /** Simulation step, in seconds. Default 1/60. */
+  fixedTimeStep?: number;
+  /** Maximum number of steps per worker tick before the backlog is dropped. Default 4. */
+  maxSubSteps?: number;
+}
+
+export interface PhysicsWorkerBodyDesc {
+  /** Default "box". */
+  shape?: "box" | "sphere" | "capsule";
+  /** Half extents (box), [radius] (sphere) or [radius, halfHeight] (capsule, along the local x axis). */
+  size: number[];
+  position?: [number, number, number];
+  /** Quaternion [x, y, z, w]. */
+  rotation?: [number, number, number, number];
+  /** Default "dynamic". */
+  motion?: "static" | "dynamic" | "kinematic";
+  /** Mass of dynamic and kinematic bodies. Default 1. */
+  mass?: number;
+}
+
+export interface PhysicsWorkerTransforms {
+  /** Number of published frames, 0 until the first step completes. */
+  frame: number;
+  /** Upper bound of the body ids present in data. */
+  bodyCount: number;
+  /** Simulated time, in seconds. */
+  time: number;
+  /**
+   * Shared view of the most recent transforms, FLOATS_PER_BODY floats per body id. Only valid until the next call to
+   * readTransforms().
+   */
+  data: Float32Array;
+}
+
+export interface PhysicsWorkerHost {
+  /** Resolves once the worker has loaded PhysX and created the scene. Commands sent before are queued. */
+  readonly ready: Promise<void>;
+  readonly maxBodies: number;
+  /** Creates a body and returns its id. The id is usable immediately, the body appears in the transforms once spawned. */
+  spawn(desc: PhysicsWorkerBodyDesc): number;
+  /** Releases a body. Its id may be returned by a later spawn(). */
+  remove(id: number): void;
+  /** Applies an impulse, in world space, to a dynamic body. */
+  addImpulse(id: number, x: number, y: number, z: number): void;
+  /** Moves a kinematic body to the given pose during the next step. */
+  setKinematicTarget(id: number, position: [number, number, number], rotation?: [number, number, number, number]): void;
+  /** Sets the linear and angular velocities of a dynamic body. */
+  setVelocity(id: number, linear: [number, number, number], angular?: [number, number, number]): void;
+  /** Returns the most recent transforms published by the worker, without waiting. */
+  readTransforms(): PhysicsWorkerTransforms;
+  /** Releases the scene and stops the worker. */
+  terminate(): void;
+}
+
+/**
+ * Runs the PhysX simulation in a dedicated module worker. Transforms are published through a SharedArrayBuffer triple
+ * buffer and commands are sent through a lock-free ring buffer, so the main thread never blocks on physics. Requires a
+ * cross-origin isolated page.
+ */
+export function createPhysicsWorkerHost(options: PhysicsWorkerHostOptions): PhysicsWorkerHost;
@@ -0,0 +1,138 @@
+// Main-thread side of the physics worker.
+//
+// Usage:
+//   import { createPhysicsWorkerHost } from "@hyperscape/physx-js-webidl/worker-host";
+//   const host = createPhysicsWorkerHost({ moduleUrl: "/physx-js-webidl.js" });
+//   await host.ready;
+//   const box = host.spawn({ shape: "box", size: [0.5, 0.5, 0.5], position: [0, 5, 0] });
+//   host.addImpulse(box, 0, 10, 0);
+//   ...
+//   const state = host.readTransforms(); // once per rendered frame, never blocks
+//   const offset = box * FLOATS_PER_BODY; // state.data[offset..offset+6] = position, rotation
+//
+// Requires a cross-origin isolated page (SharedArrayBuffer) and module workers.
+
+import {
+  BodyState,
+  CommandOp,
+  CommandRing,
+  FLOATS_PER_BODY,
+  MotionType,
+  ShapeType,
+  TransformBuffer,
+} from "./state-channel.js";
+
+export { BodyState, FLOATS_PER_BODY };
+
+const SHAPE_TYPES = { box: ShapeType.BOX, sphere: ShapeType.SPHERE, capsule: ShapeType.CAPSULE };
+const MOTION_TYPES = { static: MotionType.STATIC, dynamic: MotionType.DYNAMIC, kinematic: MotionType.KINEMATIC };
+
+/**
+ * Starts a physics worker and returns the handle used to drive it from the main thread.
+ *
+ * @param {object} options See PhysicsWorkerHostOptions in worker-host.d.ts.
+ */
+export function createPhysicsWorkerHost(options) {
+  const maxBodies = options.maxBodies || 4096;
+  const transformBuffer = TransformBuffer.allocate(maxBodies);
+  const commandBuffer = CommandRing.allocate(options.commandCapacity || 1024);
+  const transforms = new TransformBuffer(transformBuffer, false);
+  const ring = new CommandRing(commandBuffer);
+
+  const workerUrl = options.workerUrl || new URL("./physics-worker.js", import.meta.url);
+  const worker = new Worker(workerUrl, { type: "module" });
+
+  // Commands that did not fit in the ring, retried before any new command so that ordering is preserved
+  const overflow = [];
+  const freeIds = [];
+  let nextId = 0;
+
+  const ready = new Promise((resolve, reject) => {
+    worker.onmessage = (event) => {
+      if (event.data.type === "ready") resolve();
+      else if (event.data.type === "error") reject(new Error(`Physics worker failed to start: ${event.data.message}`));
+    };
+    worker.onerror = (event) => reject(new Error(`Physics worker failed to start: ${event.message}`));
+  });
+
+  worker.postMessage({
+    type: "init",
+    moduleUrl: String(options.moduleUrl),
+    wasmUrl: options.wasmUrl ? String(options.wasmUrl) : undefined,
+    gravity: options.gravity,
+    fixedTimeStep: options.fixedTimeStep,
+    maxSubSteps: options.maxSubSteps,
+    transformBuffer,
+    commandBuffer,
+  });
+
+  // The first intWords words of a command (opcode, body id, ...) are written as integers, the rest as floats
+  const tryWrite = (words, intWords) => {
+    const offset = ring.reserve();
+    if (offset === -1) return false;
+    for (let i = 0; i < intWords; i++) ring.ints[offset + i] = words[i];
+    for (let i = intWords; i < words.length; i++) ring.floats[offset + i] = words[i];
+    ring.commit();
+    return true;
+  };
+
+  const flush = () => {
+    let i = 0;
+    while (i < overflow.length && tryWrite(overflow[i].words, overflow[i].intWords)) i++;
+    if (i) overflow.splice(0, i);
+    return overflow.length === 0;
+  };
+
+  const send = (words, intWords = 2) => {
+    if (!flush() || !tryWrite(words, intWords)) overflow.push({ words, intWords });
+  };
+
+  return {
+    ready,
+    maxBodies,
+
+    spawn(desc) {
+      const id = freeIds.length ? freeIds.pop() : nextId++;
+      if (id >= maxBodies) throw new Error(`Physics worker body limit reached (${maxBodies})`);
+      const size = desc.size;
+      const p = desc.position || [0, 0, 0];
+      const q = desc.rotation || [0, 0, 0, 1];
+      // prettier-ignore
+      send([
+        CommandOp.SPAWN, id, SHAPE_TYPES[desc.shape || "box"], MOTION_TYPES[desc.motion || "dynamic"],
+        p[0], p[1], p[2], q[0], q[1], q[2], q[3],
+        size[0], size[1] || 0, size[2] || 0, desc.mass || 1,
+      ], 4);
+      return id;
+    },
+
+    remove(id) {
+      send([CommandOp.REMOVE, id]);
+      freeIds.push(id);
+    },
+
+    addImpulse(id, x, y, z) {
+      send([CommandOp.ADD_IMPULSE, id, x, y, z]);
+    },
+
+    setKinematicTarget(id, position, rotation) {
+      const q = rotation || [0, 0, 0, 1];
+      send([CommandOp.SET_KINEMATIC_TARGET, id, position[0], position[1], position[2], q[0], q[1], q[2], q[3]]);
+    },
+
+    setVelocity(id, linear, angular) {
+      const a = angular || [0, 0, 0];
+      send([CommandOp.SET_VELOCITY, id, linear[0], linear[1], linear[2], a[0], a[1], a[2]]);
+    },
+
+    readTransforms() {
+      if (overflow.length) flush();
+      const slot = transforms.frontSlot();
+      return { frame: slot.header[0], bodyCount: slot.header[1], time: slot.time[0], data: slot.data };
+    },
+
+    terminate() {
+      worker.postMessage({ type: "terminate" });
+    },
+  };
+}
@@ -28,8 +28,12 @@
  *
  * **Memory Management:**
  * - Uses PhysX heap (HEAPF32, HEAPU16, HEAPU32)
- * - Allocates temp buffers with _webidl_malloc
- * - Frees buffers after cooking with _webidl_free
+ * - Vertex and index data are bulk-copied into a scratch buffer that is
+ *   allocated once with _webidl_malloc and grown on demand, instead of a
+ *   malloc/free pair per cooked mesh
+ * - Interleaved position attributes are copied as-is and read by the cooker
+ *   through the descriptor stride, without deinterleaving in JS
+ * - releaseMeshCookingScratch() frees the scratch buffer
  *
  * **Referenced by:** Collider nodes, terrain collision, static world geometry
  */
@@ -61,6 +65,35 @@ declare const PHYSX:
 
 const cache = new Map<string, CacheItem>(); // id -> { id, pmesh, refs }
 
+// Scratch buffer in the PhysX heap, shared by all cooking calls
+let scratchPtr = 0;
+let scratchSize = 0;
+
+/**
+ * Returns a pointer to at least `bytes` bytes of scratch memory in the PhysX heap.
+ * The buffer grows geometrically so that loading many chunks does not reallocate each time.
+ * Note: _webidl_malloc can grow the wasm memory, so heap views must be read after this call.
+ */
+function getScratch(
+  physx: NonNullable<typeof PHYSX>,
+  bytes: number,
+): number {
+  if (bytes > scratchSize) {
+    if (scratchPtr) physx._webidl_free(scratchPtr);
+    scratchSize = Math.max(bytes, Math.ceil(scratchSize * 1.5), 64 * 1024);
+    scratchPtr = physx._webidl_malloc(scratchSize);
+  }
+  return scratchPtr;
+}
+
+/** Frees the scratch buffer used for cooking. It is reallocated by the next cooked mesh. */
+export function releaseMeshCookingScratch() {
+  if (!PHYSX || !scratchPtr) return;
+  PHYSX._webidl_free(scratchPtr);
+  scratchPtr = 0;
+  scratchSize = 0;
+}
+
 export class PMeshHandle {
   value: PhysXMesh | null;
   item: CacheItem;
@@ -123,13 +156,31 @@ export function geometryToPxMesh(
   // geometry = geometry.toNonIndexed()
   // geometry.computeVertexNormals()
 
-  let position = geometry.attributes.position;
+  const position = geometry.attributes.position;
   const index = geometry.index;
 
-  if (
+  // Layout of the positions in the source array, in floats. Interleaved Float32 buffers are
+  // passed to the cooker with their stride, other layouts are deinterleaved below.
+  let positionStride = 3;
+  let positionOffset = 0;
+  let positionCount = position.count;
+  let source = position.array as Float32Array;
+
+  const interleaved =
     "isInterleavedBufferAttribute" in position &&
     position.isInterleavedBufferAttribute
+      ? (position as THREE.InterleavedBufferAttribute)
+      : null;
+
+  if (
+    interleaved &&
+    interleaved.itemSize === 3 &&
+    interleaved.data.array instanceof Float32Array
   ) {
+    source = interleaved.data.array as Float32Array;
+    positionStride = interleaved.data.stride;
+    positionOffset = interleaved.offset;
+  } else if (interleaved) {
     // deinterleave!
     interface InterleavedAttributeWithGetComponent
       extends THREE.InterleavedBufferAttribute {
@@ -162,54 +213,62 @@ export function geometryToPxMesh(
       }
     }
 
-    position = new THREE.BufferAttribute(array, itemSize, false);
+    source = array;
+    positionStride = itemSize;
+    positionCount = count;
+  }
+
+  // Only the range of the source array that holds the positions is copied
+  const floatCount =
+    positionCount > 0
+      ? (positionCount - 1) * positionStride + positionOffset + 3
+      : 0;
+  const floatBytes = floatCount * 4;
+
+  // for some reason i'm seeing Uint8Arrays in some glbs, specifically the vipe rooms.
+  // so we just coerce these up to u16
+  let indices: Uint16Array | Uint32Array | null = null;
+  if (!convex) {
+    const indexArray = index!.array;
+    indices =
+      indexArray instanceof Uint8Array
+        ? new Uint16Array(indexArray)
+        : (indexArray as Uint16Array | Uint32Array);
   }
+  const indexBytes = indices ? indices.length * indices.BYTES_PER_ELEMENT : 0;
 
-  const positions = position.array as Float32Array;
-  const floatBytes = positions.length * positions.BYTES_PER_ELEMENT;
-  const pointsPtr = physx._webidl_malloc(floatBytes);
-  physx.HEAPF32.set(positions, pointsPtr >> 2);
+  // Points first, then indices at a 4-byte aligned offset, in a single scratch buffer
+  const indexOffset = (floatBytes + 3) & ~3;
+  const pointsPtr = getScratch(physx, indexOffset + indexBytes);
+  const indexPtr = pointsPtr + indexOffset;
+  physx.HEAPF32.set(source.subarray(0, floatCount), pointsPtr >> 2);
 
   let desc;
   let pmesh;
 
   if (convex) {
     desc = new physx.PxConvexMeshDesc();
-    desc.points.count = positions.length / 3;
-    desc.points.stride = 12; // size of PhysX.PxVec3 in bytes
-    desc.points.data = pointsPtr;
+    desc.points.count = positionCount;
+    desc.points.stride = positionStride * 4;
+    desc.points.data = pointsPtr + positionOffset * 4;
     desc.flags.raise(physx.PxConvexFlagEnum.eCOMPUTE_CONVEX); // eCHECK_ZERO_AREA_TRIANGLES
     pmesh = physx.CreateConvexMesh(cookingParams, desc);
   } else {
     desc = new physx.PxTriangleMeshDesc();
 
-    desc.points.count = positions.length / 3;
-    desc.points.stride = 12;
-    desc.points.data = pointsPtr;
-
-    let indices = index!.array; // Uint16Array or Uint32Array
-
-    // for some reason i'm seeing Uint8Arrays in some glbs, specifically the vipe rooms.
-    // so we just coerce these up to u16
-    if (indices instanceof Uint8Array) {
-      indices = new Uint16Array(index!.array.length);
-      for (let i = 0; i < index!.array.length; i++) {
-        indices[i] = index!.array[i];
-      }
-    }
+    desc.points.count = positionCount;
+    desc.points.stride = positionStride * 4;
+    desc.points.data = pointsPtr + positionOffset * 4;
 
-    const indexBytes = indices.length * indices.BYTES_PER_ELEMENT;
-    const indexPtr = physx._webidl_malloc(indexBytes);
     if (indices instanceof Uint16Array) {
       physx.HEAPU16.set(indices, indexPtr >> 1);
       desc.triangles.stride = 6; // 3 × 2 bytes per triangle
       desc.flags.raise(physx.PxTriangleMeshFlagEnum.e16_BIT_INDICES);
     } else {
-      // note: this is here for brevity but no longer used as we force everything to 16 bit
-      physx.HEAPU32.set(indices as Uint32Array, indexPtr >> 2);
+      physx.HEAPU32.set(indices!, indexPtr >> 2);
       desc.triangles.stride = 12; // 3 × 4 bytes per triangle
     }
-    desc.triangles.count = indices.length / 3;
+    desc.triangles.count = indices!.length / 3;
     desc.triangles.data = indexPtr;
 
     // if (!desc.isValid()) {
@@ -217,10 +276,8 @@ export function geometryToPxMesh(
     // }
 
     pmesh = physx.CreateTriangleMesh(cookingParams, desc);
-    physx._webidl_free(indexPtr);
   }
 
-  physx._webidl_free(pointsPtr);
   physx.destroy(desc);
 
   if (!pmesh) return null;
@@ -13,7 +13,8 @@
  * Loading Strategy:
  * 1. Try loading from local assets/web/ directory (workspace root)
  * 2. Fall back to fetching from CDN and caching to temp directory
- * 3. Provides buffer to PhysX via wasmBinary option (bypasses locateFile)
+ * 3. Compiles the buffer once per process (compilePhysXWasmForNode) and hands the
+ *    compiled module to PhysX via instantiateWasm, so worker threads can reuse it
  *
  * Referenced by: PhysXManager.loadPhysXInternal() in Node.js environments only
  */
@@ -101,3 +102,42 @@ export async function loadPhysXWasmForNode(): Promise<Buffer> {
 
   return wasmBuffer;
 }
+
+/** Compiled module shared by every load in this thread */
+let compiledModule: Promise<WebAssembly.Module> | null = null;
+
+/**
+ * Compile PhysX WASM Module for Node.js
+ *
+ * Compiles the binary returned by loadPhysXWasmForNode() asynchronously, so the
+ * compile runs on V8's background threads instead of blocking startup, and
+ * memoizes the result for the lifetime of the thread.
+ *
+ * The returned module is structured-cloneable: post it to worker threads and
+ * pass it to setPhysXWasmModule() there to skip compilation entirely.
+ *
+ * @returns Compiled physx-js-webidl.wasm module
+ */
+export function compilePhysXWasmForNode(): Promise<WebAssembly.Module> {
+  if (!compiledModule) {
+    compiledModule = loadPhysXWasmForNode().then((wasmBuffer) =>
+      WebAssembly.compile(wasmBuffer),
+    );
+    compiledModule.catch(() => {
+      compiledModule = null;
+    });
+  }
+  return compiledModule;
+}
+
+/**
+ * Provide a Compiled PhysX Module
+ *
+ * Use in worker threads with a module compiled by the parent thread, before
+ * loadPhysX() is called.
+ *
+ * @param module - Module received from compilePhysXWasmForNode() on another thread
+ */
+export function setPhysXWasmModule(module: WebAssembly.Module): void {
+  compiledModule = Promise.resolve(module);
+}
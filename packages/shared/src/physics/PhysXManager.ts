@@ -27,14 +27,20 @@
  * Environment-Specific Loading:
  * - Browser: Loads via script tag from CDN at /web/physx-js-webidl.js
  * - Node.js: Loads WASM binary from assets/web/ or fetches from CDN with caching
+ * - Both compile the WASM once and instantiate the compiled module (streaming
+ *   compile in browsers, shareable with worker threads on Node.js)
  *
  * Referenced by: Physics system, Node-based colliders, Character controllers
  */
 
 import { EventEmitter } from "eventemitter3";
+import type {
+  PhysicsWorkerHost,
+  PhysicsWorkerHostOptions,
+} from "@hyperscape/physx-js-webidl/worker-host";
 import type { PhysXInfo, PhysXModule } from "../types/systems/physics";
 import THREE from "../extras/three/three";
-import loadPhysXScript from "./physx-script-loader";
+import { loadPhysXFactory } from "./physx-script-loader";
 
 /**
  * PhysX Loading States
@@ -284,12 +290,13 @@ class PhysXManager extends EventEmitter {
    * Browser Environment:
    * - Loads physx-js-webidl.js script tag from CDN
    * - Uses locateFile to find .wasm at CDN/web/physx-js-webidl.wasm
+   * - Compiles it while streaming and instantiates the compiled module
    *
    * Node.js/Server Environment:
    * - Dynamically imports PhysXManager.server.ts (to avoid bundling Node modules)
    * - First tries loading WASM from local assets/web/ directory
    * - Falls back to fetching from CDN and caching to temp directory
-   * - Provides binary directly to PhysX via wasmBinary option
+   * - Compiles it once and provides the module to PhysX via instantiateWasm
    *
    * After loading, creates:
    * - PxFoundation (memory allocator and error callback)
@@ -332,6 +339,9 @@ class PhysXManager extends EventEmitter {
       },
     };
 
+    // Use appropriate loader based on environment (use isBrowser defined at the top of function)
+    let PHYSX: PhysXModule;
+
     // In Node.js environments, we need to handle WASM loading differently
     if (isServer || isTest) {
       // Dynamically import server-specific loading utilities
@@ -343,10 +353,24 @@ class PhysXManager extends EventEmitter {
       // Vite's dynamic import warnings.
       const serverPath = "./PhysXManager.server";
       const serverModule = await import(/* @vite-ignore */ serverPath);
-      const wasmBuffer = await serverModule.loadPhysXWasmForNode();
 
-      // Provide the WASM module directly
-      moduleOptions.wasmBinary = wasmBuffer;
+      // Compile the wasm while the bindings are imported, then instantiate the compiled module
+      // directly (no per-start synchronous compile)
+      const [wasmModule, physxModule, { loadPhysXModule }] = await Promise.all([
+        serverModule.compilePhysXWasmForNode() as Promise<WebAssembly.Module>,
+        import("@hyperscape/physx-js-webidl"),
+        import("@hyperscape/physx-js-webidl/module-loader"),
+      ]);
+      const PhysXLoader = physxModule.default || physxModule;
+
+      // Strong type assumption - PhysXLoader is a function that returns PhysXModule
+      PHYSX = await loadPhysXModule(
+        PhysXLoader as (
+          options: Record<string, unknown>,
+        ) => Promise<PhysXModule>,
+        wasmModule,
+        moduleOptions,
+      );
     } else if (isBrowser) {
       // For browser, always use absolute CDN URL (no Vite proxy)
       moduleOptions.locateFile = (wasmFileName: string) => {
@@ -361,16 +385,28 @@ class PhysXManager extends EventEmitter {
         }
         return wasmFileName;
       };
-    }
 
-    // Use appropriate loader based on environment (use isBrowser defined at the top of function)
-    let PHYSX: PhysXModule;
+      const windowWithCdn = window as Window & { __CDN_URL?: string };
+      const cdnBaseUrl = windowWithCdn.__CDN_URL || "http://localhost:8080";
+      const { compilePhysXModule, loadPhysXModule } = await import(
+        "@hyperscape/physx-js-webidl/module-loader"
+      );
 
-    if (isBrowser) {
-      // Browser environment - use script loader
-      PHYSX = await loadPhysXScript(moduleOptions);
+      // Compile while downloading (the browser keeps the compiled code in its cache) and
+      // load the script at the same time
+      const [wasmModule, PhysXFactory] = await Promise.all([
+        compilePhysXModule(`${cdnBaseUrl}/web/physx-js-webidl.wasm?v=1.0.0`),
+        loadPhysXFactory(),
+      ]);
+      PHYSX = await loadPhysXModule(
+        PhysXFactory as unknown as (
+          options: Record<string, unknown>,
+        ) => Promise<PhysXModule>,
+        wasmModule,
+        moduleOptions,
+      );
     } else {
-      // Node.js/server environment - use dynamic import for ESM compatibility
+      // Other environments - use dynamic import for ESM compatibility, emscripten fetches the wasm
       const physxModule = await import("@hyperscape/physx-js-webidl");
       const PhysXLoader = physxModule.default || physxModule;
 
@@ -503,3 +539,37 @@ export function getPhysX(): PhysXModule | null {
 export function isPhysXReady(): boolean {
   return physxManager.isReady();
 }
+
+/**
+ * Start PhysX in a Web Worker (Browser Only)
+ *
+ * Alternative to loadPhysX() for simulations that should not run on the main
+ * thread. The worker loads its own PhysX instance from the same CDN location
+ * as the script loader, steps the scene with a fixed time step and publishes
+ * transforms through shared memory, so the main thread never blocks on physics.
+ *
+ * Requires a cross-origin isolated page (SharedArrayBuffer).
+ *
+ * @param options - Worker host options; module and WASM URLs default to the CDN
+ * @returns Handle used to send commands and read transforms
+ */
+export async function startPhysXWorker(
+  options: Partial<PhysicsWorkerHostOptions> = {},
+): Promise<PhysicsWorkerHost> {
+  // The URLs only default to the CDN in a browser, other hosts (tests, Node) pass them in options
+  const windowWithCdn =
+    typeof window !== "undefined"
+      ? (window as Window & { __CDN_URL?: string })
+      : undefined;
+  const cdnUrl = windowWithCdn?.__CDN_URL || "http://localhost:8080";
+  const { createPhysicsWorkerHost } = await import(
+    "@hyperscape/physx-js-webidl/worker-host"
+  );
+  const host = createPhysicsWorkerHost({
+    moduleUrl: `${cdnUrl}/physx-js-webidl.js?v=1.0.0`,
+    wasmUrl: `${cdnUrl}/web/physx-js-webidl.wasm?v=1.0.0`,
+    ...options,
+  });
+  await host.ready;
+  return host;
+}
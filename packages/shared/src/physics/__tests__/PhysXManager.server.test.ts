@@ -0,0 +1,81 @@
+/**
+ * Tests for the Node.js PhysX loading path
+ *
+ * compilePhysXWasmForNode() / setPhysXWasmModule() and loadPhysX() loading the
+ * real bindings from a precompiled WebAssembly.Module.
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from "vitest";
+import {
+  compilePhysXWasmForNode,
+  loadPhysXWasmForNode,
+  setPhysXWasmModule,
+} from "../PhysXManager.server";
+import { getPhysX, loadPhysX, physxManager } from "../PhysXManager";
+
+describe("PhysXManager.server", () => {
+  let wasmBytes: Buffer;
+
+  beforeAll(async () => {
+    wasmBytes = await loadPhysXWasmForNode();
+  });
+
+  afterAll(() => {
+    physxManager.reset();
+  });
+
+  it("loads the PhysX wasm binary", () => {
+    // "\0asm" magic number
+    expect([...wasmBytes.subarray(0, 4)]).toEqual([0x00, 0x61, 0x73, 0x6d]);
+  });
+
+  it("compiles the binary once per thread", async () => {
+    const first = compilePhysXWasmForNode();
+    const second = compilePhysXWasmForNode();
+    expect(second).toBe(first);
+    expect(await first).toBeInstanceOf(WebAssembly.Module);
+  });
+
+  it("uses the module given to setPhysXWasmModule", async () => {
+    const wasmModule = await WebAssembly.compile(wasmBytes);
+    expect(await compilePhysXWasmForNode()).not.toBe(wasmModule);
+
+    setPhysXWasmModule(wasmModule);
+    expect(await compilePhysXWasmForNode()).toBe(wasmModule);
+  });
+
+  it("loads PhysX from the precompiled module", async () => {
+    const wasmModule = await WebAssembly.compile(wasmBytes);
+    setPhysXWasmModule(wasmModule);
+    physxManager.reset();
+
+    const info = await loadPhysX();
+    expect(info.version).toBeGreaterThan(0);
+    expect(info.physics).toBeDefined();
+    // Loading did not compile the binary again
+    expect(await compilePhysXWasmForNode()).toBe(wasmModule);
+
+    // The loaded module simulates: a body falls under gravity
+    const PHYSX = getPhysX()!;
+    const tolerances = new PHYSX.PxTolerancesScale();
+    const sceneDesc = new PHYSX.PxSceneDesc(tolerances);
+    sceneDesc.gravity = new PHYSX.PxVec3(0, -9.81, 0);
+    sceneDesc.cpuDispatcher = PHYSX.DefaultCpuDispatcherCreate(0);
+    sceneDesc.filterShader = PHYSX.DefaultFilterShader();
+    const scene = info.physics.createScene(sceneDesc);
+
+    const pose = new PHYSX.PxTransform(
+      new PHYSX.PxVec3(0, 5, 0),
+      new PHYSX.PxQuat(0, 0, 0, 1),
+    );
+    const body = info.physics.createRigidDynamic(pose);
+    scene.addActor(body);
+    for (let i = 0; i < 30; i++) {
+      scene.simulate(1 / 60);
+      scene.fetchResults(true);
+    }
+    expect(body.getGlobalPose().p.y).toBeLessThan(4);
+
+    scene.release();
+  });
+});
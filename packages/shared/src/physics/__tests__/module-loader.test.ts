@@ -0,0 +1,177 @@
+/**
+ * Tests for @hyperscape/physx-js-webidl/module-loader
+ *
+ * Loads the real PhysX bindings from compiled WebAssembly.Module objects, in
+ * this thread and in a worker_threads thread that receives the module.
+ */
+
+import { describe, it, expect, beforeAll } from "vitest";
+import { Worker as ThreadWorker } from "node:worker_threads";
+import { readFile } from "node:fs/promises";
+import { createRequire } from "node:module";
+import { dirname, join } from "node:path";
+import { pathToFileURL } from "node:url";
+import {
+  compilePhysXModule,
+  createPhysXModuleOptions,
+  loadPhysXModule,
+} from "@hyperscape/physx-js-webidl/module-loader";
+
+const require = createRequire(import.meta.url);
+const physxModulePath = require.resolve("@hyperscape/physx-js-webidl");
+const physxWasmPath = join(dirname(physxModulePath), "physx-js-webidl.wasm");
+const moduleLoaderPath = require.resolve(
+  "@hyperscape/physx-js-webidl/module-loader",
+);
+
+type PhysXInstance = { PHYSICS_VERSION: number };
+type PhysXFactory = (options: object) => Promise<PhysXInstance>;
+
+// Smallest module that cannot be instantiated with the PhysX imports: it imports
+// a function that the bindings do not provide
+// prettier-ignore
+const UNLINKABLE_WASM = new Uint8Array([
+  0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+  // type section: one () -> () signature
+  0x01, 0x04, 0x01, 0x60, 0x00, 0x00,
+  // import section: env.zz_missing, function of type 0
+  0x02, 0x12, 0x01, 0x03, 0x65, 0x6e, 0x76, 0x0a,
+  0x7a, 0x7a, 0x5f, 0x6d, 0x69, 0x73, 0x73, 0x69, 0x6e, 0x67, 0x00, 0x00,
+]);
+
+describe("module-loader", () => {
+  let PhysX: PhysXFactory;
+  let wasmBytes: Buffer;
+
+  beforeAll(async () => {
+    const physxModule = await import("@hyperscape/physx-js-webidl");
+    PhysX = (physxModule.default || physxModule) as unknown as PhysXFactory;
+    wasmBytes = await readFile(physxWasmPath);
+  });
+
+  describe("compilePhysXModule", () => {
+    it("compiles buffers", async () => {
+      const wasmModule = await compilePhysXModule(wasmBytes);
+      expect(wasmModule).toBeInstanceOf(WebAssembly.Module);
+      const exportNames = WebAssembly.Module.exports(wasmModule).map(
+        (entry) => entry.name,
+      );
+      expect(exportNames).toContain("memory");
+    });
+
+    it("compiles a file once per path", async () => {
+      const first = compilePhysXModule(physxWasmPath);
+      const second = compilePhysXModule(physxWasmPath);
+      expect(second).toBe(first);
+      expect(await first).toBeInstanceOf(WebAssembly.Module);
+    });
+
+    it("accepts file URLs", async () => {
+      const wasmModule = await compilePhysXModule(pathToFileURL(physxWasmPath));
+      expect(wasmModule).toBeInstanceOf(WebAssembly.Module);
+    });
+
+    it("lets a failed compile be retried", async () => {
+      const missingPath = join(dirname(physxWasmPath), "missing.wasm");
+      const failed = compilePhysXModule(missingPath);
+      await expect(failed).rejects.toThrow();
+      expect(compilePhysXModule(missingPath)).not.toBe(failed);
+      await expect(compilePhysXModule(missingPath)).rejects.toThrow();
+    });
+  });
+
+  describe("loadPhysXModule", () => {
+    it("instantiates PhysX from a compiled module", async () => {
+      const wasmModule = await compilePhysXModule(physxWasmPath);
+      const PHYSX = await loadPhysXModule(PhysX, wasmModule);
+      expect(PHYSX.PHYSICS_VERSION).toBeGreaterThan(0);
+    });
+
+    it("instantiates the same compiled module more than once", async () => {
+      const wasmModule = await compilePhysXModule(physxWasmPath);
+      const [a, b] = await Promise.all([
+        loadPhysXModule(PhysX, wasmModule),
+        loadPhysXModule(PhysX, wasmModule),
+      ]);
+      expect(a).not.toBe(b);
+      expect(a.PHYSICS_VERSION).toBe(b.PHYSICS_VERSION);
+    });
+
+    it("rejects when the module cannot be instantiated", async () => {
+      const badModule = await WebAssembly.compile(UNLINKABLE_WASM);
+      await expect(loadPhysXModule(PhysX, badModule)).rejects.toBeInstanceOf(
+        WebAssembly.LinkError,
+      );
+    });
+
+    it("rejects with the error thrown by onAbort", async () => {
+      const badModule = await WebAssembly.compile(UNLINKABLE_WASM);
+      const aborts: unknown[] = [];
+      const loading = loadPhysXModule(PhysX, badModule, {
+        onAbort: (what: unknown) => {
+          aborts.push(what);
+          throw new Error("PhysX WASM aborted");
+        },
+      });
+      await expect(loading).rejects.toThrow("PhysX WASM aborted");
+      expect(aborts).toHaveLength(1);
+      expect(aborts[0]).toBeInstanceOf(WebAssembly.LinkError);
+    });
+
+    it("loads PhysX in a worker thread from a posted module", async () => {
+      const wasmModule = await compilePhysXModule(physxWasmPath);
+      const thread = new ThreadWorker(
+        `
+const { parentPort, workerData } = require("node:worker_threads");
+(async () => {
+  const { loadPhysXModule } = await import(workerData.loaderUrl);
+  const physxModule = await import(workerData.physxUrl);
+  const PHYSX = await loadPhysXModule(physxModule.default || physxModule, workerData.wasmModule);
+  parentPort.postMessage({ version: PHYSX.PHYSICS_VERSION });
+})().catch((error) => parentPort.postMessage({ error: String(error) }));
+`,
+        {
+          eval: true,
+          workerData: {
+            wasmModule,
+            loaderUrl: pathToFileURL(moduleLoaderPath).href,
+            physxUrl: pathToFileURL(physxModulePath).href,
+          },
+        },
+      );
+      const result = await new Promise<{ version?: number; error?: string }>(
+        (resolve, reject) => {
+          thread.once("message", resolve);
+          thread.once("error", reject);
+        },
+      );
+      await thread.terminate();
+
+      expect(result.error).toBeUndefined();
+      const PHYSX = await loadPhysXModule(PhysX, wasmModule);
+      expect(result.version).toBe(PHYSX.PHYSICS_VERSION);
+    });
+  });
+
+  describe("createPhysXModuleOptions", () => {
+    it("keeps the other factory options", async () => {
+      const wasmModule = await compilePhysXModule(physxWasmPath);
+      const print = () => {};
+      const options = createPhysXModuleOptions(wasmModule, { print });
+      expect(options.print).toBe(print);
+      expect(typeof options.instantiateWasm).toBe("function");
+
+      const PHYSX = await PhysX(options);
+      expect(PHYSX.PHYSICS_VERSION).toBeGreaterThan(0);
+    });
+
+    it("routes instantiation errors to onAbort", async () => {
+      const badModule = await WebAssembly.compile(UNLINKABLE_WASM);
+      const aborted = new Promise<unknown>((resolve) => {
+        // The factory promise stays pending, the error only reaches onAbort
+        void PhysX(createPhysXModuleOptions(badModule, { onAbort: resolve }));
+      });
+      expect(await aborted).toBeInstanceOf(WebAssembly.LinkError);
+    });
+  });
+});
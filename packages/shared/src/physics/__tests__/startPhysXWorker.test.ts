@@ -0,0 +1,261 @@
+/**
+ * Tests for startPhysXWorker() and the physics worker host
+ *
+ * The worker host expects the Web Worker API, which Node does not provide. The
+ * ThreadBackedWorker below runs the real physics-worker.js in a real
+ * worker_threads thread and forwards messages both ways; the SharedArrayBuffers
+ * posted by the host are shared with that thread, so these tests drive the real
+ * PhysX worker and read its transforms through the real triple buffer.
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from "vitest";
+import { Worker as ThreadWorker } from "node:worker_threads";
+import { createRequire } from "node:module";
+import { dirname, join } from "node:path";
+import { pathToFileURL } from "node:url";
+import type { PhysicsWorkerHost } from "@hyperscape/physx-js-webidl/worker-host";
+import {
+  BodyState,
+  FLOATS_PER_BODY,
+} from "@hyperscape/physx-js-webidl/worker-host";
+import {
+  CommandRing,
+  TransformBuffer,
+} from "@hyperscape/physx-js-webidl/state-channel";
+import { startPhysXWorker } from "../PhysXManager";
+
+const require = createRequire(import.meta.url);
+const physxModulePath = require.resolve("@hyperscape/physx-js-webidl");
+const physxWasmPath = join(dirname(physxModulePath), "physx-js-webidl.wasm");
+
+// Worker-side shim: exposes the worker_threads port as the Web Worker `self`
+// API and holds messages back until the worker script has installed onmessage
+const BOOTSTRAP = `
+const { parentPort, workerData } = require("node:worker_threads");
+globalThis.self = globalThis;
+self.postMessage = (message) => parentPort.postMessage(message);
+self.close = () => process.exit(0);
+const pending = [];
+let started = false;
+parentPort.on("message", (data) => (started ? self.onmessage({ data }) : pending.push(data)));
+import(workerData.url).then(
+  () => {
+    started = true;
+    for (const data of pending.splice(0)) self.onmessage({ data });
+  },
+  (error) => parentPort.postMessage({ type: "error", message: String(error) }),
+);
+`;
+
+const threads: ThreadWorker[] = [];
+
+class ThreadBackedWorker {
+  onmessage: ((event: { data: unknown }) => void) | null = null;
+  onerror: ((event: { message: string }) => void) | null = null;
+  private thread: ThreadWorker;
+
+  constructor(url: string | URL) {
+    this.thread = new ThreadWorker(BOOTSTRAP, {
+      eval: true,
+      workerData: { url: String(url) },
+    });
+    this.thread.on("message", (data) => this.onmessage?.({ data }));
+    this.thread.on("error", (error) =>
+      this.onerror?.({ message: error.message }),
+    );
+    threads.push(this.thread);
+  }
+
+  postMessage(message: unknown): void {
+    this.thread.postMessage(message);
+  }
+
+  terminate(): void {
+    void this.thread.terminate();
+  }
+}
+
+async function waitFor(
+  condition: () => boolean,
+  timeoutMs = 10000,
+): Promise<void> {
+  const start = Date.now();
+  while (!condition()) {
+    if (Date.now() - start > timeoutMs) {
+      throw new Error(`Condition not met within ${timeoutMs}ms`);
+    }
+    await new Promise((resolve) => setTimeout(resolve, 10));
+  }
+}
+
+function bodyY(host: PhysicsWorkerHost, id: number): number {
+  return host.readTransforms().data[id * FLOATS_PER_BODY + 1];
+}
+
+function bodyState(host: PhysicsWorkerHost, id: number): number {
+  return host.readTransforms().data[id * FLOATS_PER_BODY + 7];
+}
+
+describe("TransformBuffer", () => {
+  it("hands the reader the most recently published slot", () => {
+    const buffer = TransformBuffer.allocate(2);
+    const writer = new TransformBuffer(buffer, true);
+    const reader = new TransformBuffer(buffer, false);
+
+    expect(reader.frontSlot().header[0]).toBe(0);
+
+    for (const frame of [1, 2, 3]) {
+      writer.backSlot().data[0] = frame * 10;
+      writer.publish(frame, 1, frame / 60);
+    }
+
+    const slot = reader.frontSlot();
+    expect(slot.header[0]).toBe(3);
+    expect(slot.header[1]).toBe(1);
+    expect(slot.time[0]).toBeCloseTo(3 / 60);
+    expect(slot.data[0]).toBe(30);
+  });
+
+  it("never lets the writer fill the slot the reader holds", () => {
+    const buffer = TransformBuffer.allocate(1);
+    const writer = new TransformBuffer(buffer, true);
+    const reader = new TransformBuffer(buffer, false);
+
+    for (let frame = 1; frame <= 10; frame++) {
+      writer.publish(frame, 0, 0);
+      const front = reader.frontSlot();
+      expect(writer.backSlot()).not.toBe(front);
+      expect(front.header[0]).toBe(frame);
+      // Reading again without a new publish keeps the same slot
+      expect(reader.frontSlot()).toBe(front);
+    }
+  });
+});
+
+describe("CommandRing", () => {
+  it("delivers records in order and reports a full ring", () => {
+    const buffer = CommandRing.allocate(3);
+    const producer = new CommandRing(buffer);
+    const consumer = new CommandRing(buffer);
+    expect(producer.capacity).toBe(4);
+
+    for (let i = 0; i < 4; i++) {
+      const offset = producer.reserve();
+      expect(offset).not.toBe(-1);
+      producer.ints[offset] = i;
+      producer.commit();
+    }
+    expect(producer.reserve()).toBe(-1);
+
+    for (let i = 0; i < 4; i++) {
+      const offset = consumer.peek();
+      expect(consumer.ints[offset]).toBe(i);
+      consumer.consume();
+    }
+    expect(consumer.peek()).toBe(-1);
+    expect(producer.reserve()).not.toBe(-1);
+  });
+});
+
+describe("startPhysXWorker", () => {
+  let host: PhysicsWorkerHost;
+  const globals = globalThis as { Worker?: unknown };
+  const previousWorker = globals.Worker;
+
+  beforeAll(async () => {
+    globals.Worker = ThreadBackedWorker;
+    host = await startPhysXWorker({
+      moduleUrl: pathToFileURL(physxModulePath),
+      wasmUrl: physxWasmPath,
+      maxBodies: 16,
+    });
+  });
+
+  afterAll(async () => {
+    host?.terminate();
+    await Promise.all(threads.map((thread) => thread.terminate()));
+    globals.Worker = previousWorker;
+  });
+
+  it("publishes frames with simulated time", async () => {
+    await waitFor(() => host.readTransforms().frame > 0);
+    const first = host.readTransforms();
+    expect(first.time).toBeGreaterThan(0);
+
+    await waitFor(() => host.readTransforms().frame > first.frame);
+    expect(host.readTransforms().time).toBeGreaterThan(first.time);
+  });
+
+  it("drops a spawned sphere onto a static ground and lets it sleep", async () => {
+    const ground = host.spawn({
+      shape: "box",
+      size: [50, 0.5, 50],
+      position: [0, -0.5, 0],
+      motion: "static",
+    });
+    const sphere = host.spawn({
+      shape: "sphere",
+      size: [0.5],
+      position: [0, 5, 0],
+    });
+
+    await waitFor(() => host.readTransforms().bodyCount > sphere);
+    expect(bodyState(host, ground)).toBe(BodyState.AWAKE);
+    expect(bodyY(host, ground)).toBeCloseTo(-0.5);
+
+    await waitFor(() => bodyY(host, sphere) < 4.5);
+    await waitFor(() => bodyState(host, sphere) === BodyState.SLEEPING);
+    expect(bodyY(host, sphere)).toBeCloseTo(0.5, 1);
+
+    host.remove(sphere);
+    host.remove(ground);
+  });
+
+  it("applies impulses and velocities to dynamic bodies", async () => {
+    const box = host.spawn({
+      shape: "box",
+      size: [0.5, 0.5, 0.5],
+      position: [10, 20, 0],
+    });
+    await waitFor(() => host.readTransforms().bodyCount > box);
+
+    host.addImpulse(box, 0, 50, 0);
+    await waitFor(() => bodyY(host, box) > 21);
+
+    host.setVelocity(box, [5, 0, 0]);
+    await waitFor(
+      () => host.readTransforms().data[box * FLOATS_PER_BODY] > 10.5,
+    );
+
+    host.remove(box);
+  });
+
+  it("moves kinematic bodies to their targets", async () => {
+    const platform = host.spawn({
+      shape: "box",
+      size: [1, 0.1, 1],
+      position: [-10, 2, 0],
+      motion: "kinematic",
+    });
+    await waitFor(() => host.readTransforms().bodyCount > platform);
+
+    host.setKinematicTarget(platform, [-10, 3, 0]);
+    await waitFor(() => Math.abs(bodyY(host, platform) - 3) < 1e-3);
+
+    host.remove(platform);
+  });
+
+  it("marks removed bodies unused and reuses their ids", async () => {
+    const a = host.spawn({ size: [0.5, 0.5, 0.5], position: [20, 0, 0] });
+    const b = host.spawn({ size: [0.5, 0.5, 0.5], position: [22, 0, 0] });
+    await waitFor(() => host.readTransforms().bodyCount > b);
+
+    host.remove(a);
+    await waitFor(() => bodyState(host, a) === BodyState.UNUSED);
+    expect(bodyState(host, b)).not.toBe(BodyState.UNUSED);
+
+    expect(host.spawn({ size: [0.5, 0.5, 0.5], position: [24, 0, 0] })).toBe(
+      a,
+    );
+  });
+});
@@ -7,6 +7,7 @@ export {
   waitForPhysX,
   getPhysX,
   isPhysXReady,
+  startPhysXWorker,
 } from "./PhysXManager";
 
 export * from "./Layers";
@@ -7,23 +7,26 @@ import type PhysX from "@hyperscape/physx-js-webidl";
 import type { PhysXModule } from "../types/systems/physics";
 
 type PhysXInitOptions = Parameters<typeof PhysX>[0];
+export type PhysXFactory = typeof PhysX;
 interface PhysXWindow extends Window {
-  PhysX?: typeof PhysX;
+  PhysX?: PhysXFactory;
 }
 
-export async function loadPhysXScript(
-  options?: PhysXInitOptions,
-): Promise<PhysXModule> {
+/**
+ * Injects the physx-js-webidl.js script tag (once) and resolves with the PhysX factory it defines.
+ * The factory is not called, so the caller can load the script while the wasm is still compiling.
+ */
+export async function loadPhysXFactory(): Promise<PhysXFactory> {
   // Check if PhysX is already loaded
   const w = window as PhysXWindow;
   if (w.PhysX) {
-    return w.PhysX!(options);
+    return w.PhysX;
   }
 
   return new Promise((resolve, reject) => {
     // Check again in case it was loaded while we were waiting
     if (w.PhysX) {
-      w.PhysX!(options).then(resolve).catch(reject);
+      resolve(w.PhysX);
       return;
     }
 
@@ -44,18 +47,7 @@ export async function loadPhysXScript(
       setTimeout(() => {
         const w2 = window as PhysXWindow;
         if (w2.PhysX) {
-          const PhysXFn = w2.PhysX!;
-          PhysXFn(options)
-            .then((physx) => {
-              resolve(physx);
-            })
-            .catch((error) => {
-              console.error(
-                "[physx-script-loader] PhysX initialization failed:",
-                error,
-              );
-              reject(error);
-            });
+          resolve(w2.PhysX);
         } else {
           console.error(
             "[physx-script-loader] PhysX function not found after script load",
@@ -79,4 +71,14 @@ export async function loadPhysXScript(
   });
 }
 
+export async function loadPhysXScript(
+  options?: PhysXInitOptions,
+): Promise<PhysXModule> {
+  const PhysXFn = await loadPhysXFactory();
+  return PhysXFn(options).catch((error: unknown) => {
+    console.error("[physx-script-loader] PhysX initialization failed:", error);
+    throw error;
+  });
+}
+
 export default loadPhysXScript;